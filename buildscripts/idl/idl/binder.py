@@ -256,6 +256,24 @@ def _get_struct_qualified_cpp_name(struct):
                                    common.title_case(struct.cpp_name or struct.name))
 
 
+def _bind_unowned_string_field(ast_field):
+    # type: (ast.Field) -> None
+    """
+    Store a string field of an 'unowned_strings' struct as a StringData view.
+
+    The view points into the BSON the struct was parsed from instead of copying it into a
+    std::string, so that BSON must outlive the struct. Only plain, non-array string fields are
+    changed; any field with a custom deserializer keeps its own type.
+    """
+    if ast_field.type is None or ast_field.type.is_array:
+        return
+
+    if (ast_field.type.cpp_type == 'std::string'
+            and ast_field.type.deserializer == 'mongo::BSONElement::str'):
+        ast_field.type.cpp_type = 'mongo::StringData'
+        ast_field.type.deserializer = 'mongo::BSONElement::valueStringData'
+
+
 def _bind_struct_common(ctxt, parsed_spec, struct, ast_struct):
     # type: (errors.ParserContext, syntax.IDLSpec, syntax.Struct, ast.Struct) -> None
     # pylint: disable=too-many-branches
@@ -270,6 +288,7 @@ def _bind_struct_common(ctxt, parsed_spec, struct, ast_struct):
     ast_struct.qualified_cpp_name = _get_struct_qualified_cpp_name(struct)
     ast_struct.allow_global_collection_name = struct.allow_global_collection_name
     ast_struct.non_const_getter = struct.non_const_getter
+    ast_struct.unowned_strings = struct.unowned_strings
 
     # Validate naming restrictions
     if ast_struct.name.startswith("array<"):
@@ -303,6 +322,9 @@ def _bind_struct_common(ctxt, parsed_spec, struct, ast_struct):
                 ctxt.add_bad_field_non_const_getter_in_immutable_struct_error(
                     ast_struct, ast_struct.name, ast_field.name)
 
+            if ast_struct.unowned_strings:
+                _bind_unowned_string_field(ast_field)
+
             if not _is_duplicate_field(ctxt, ast_struct.name, ast_struct.fields, ast_field):
                 ast_struct.fields.append(ast_field)
 
@@ -526,6 +526,7 @@ def _parse_struct(ctxt, spec, name, node):
             "immutable": _RuleDesc('bool_scalar'),
             "generate_comparison_operators": _RuleDesc("bool_scalar"),
             "non_const_getter": _RuleDesc('bool_scalar'),
+            "unowned_strings": _RuleDesc('bool_scalar'),
         })
 
     # PyLint has difficulty with some iterables: https://github.com/PyCQA/pylint/issues/3105
@@ -789,6 +790,7 @@ def _parse_command(ctxt, spec, name, node):
             "generate_comparison_operators": _RuleDesc("bool_scalar"),
             "allow_global_collection_name": _RuleDesc('bool_scalar'),
             "non_const_getter": _RuleDesc('bool_scalar'),
+            "unowned_strings": _RuleDesc('bool_scalar'),
             "access_check": _RuleDesc('mapping', mapping_parser_func=_parse_access_checks),
         })
 
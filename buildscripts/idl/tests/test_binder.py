@@ -561,6 +561,29 @@ class TestBinder(testcase.IDLTestcase):
                         foo: array<int>
             """))
 
+        # Test unowned_strings rewrites std::string fields to StringData views
+        spec = self.assert_bind(
+            textwrap.dedent("""
+            types:
+                string:
+                    description: foo
+                    cpp_type: std::string
+                    bson_serialization_type: string
+                    deserializer: mongo::BSONElement::str
+            structs:
+                foo:
+                    description: foo
+                    strict: true
+                    unowned_strings: true
+                    fields:
+                        foo: string
+                        bar: array<string>
+            """))
+        fields = spec.structs[0].fields
+        self.assertEqual(fields[0].type.cpp_type, 'mongo::StringData')
+        self.assertEqual(fields[0].type.deserializer, 'mongo::BSONElement::valueStringData')
+        self.assertEqual(fields[1].type.cpp_type, 'std::string')
+
     def test_struct_negative(self):
         # type: () -> None
         """Negative struct tests."""
@@ -365,4 +365,27 @@ results =
         }])
         .toArray();
 assert.eq(results, expectedResults);
+
+// Filters which compare each element to a constant, over elements of mixed types. Elements of
+// other types are ordered by their type, and NaN sorts below every other number.
+coll.drop();
+assert.commandWorked(coll.insert({
+    _id: 0,
+    a: [NaN, -1, 2, NumberLong(3), 4.5, NumberDecimal("5"), "str", null, [1], {x: 1}, MinKey,
+        MaxKey]
+}));
+
+const compareToConstant = (op, constant) =>
+    coll.aggregate([{
+            $project: {_id: 0, b: {$filter: {input: '$a', cond: {[op]: ['$$this', constant]}}}}
+        }])
+        .toArray()[0]
+        .b;
+
+assert.eq(compareToConstant('$gt', 2),
+          [NumberLong(3), 4.5, NumberDecimal("5"), "str", [1], {x: 1}, MaxKey]);
+assert.eq(compareToConstant('$lte', 3), [NaN, -1, 2, NumberLong(3), null, MinKey]);
+assert.eq(compareToConstant('$eq', 5), [NumberDecimal("5")]);
+assert.eq(compareToConstant('$ne', NaN).length, 11);
+assert.eq(compareToConstant('$lt', NaN), [null, MinKey]);
 }());
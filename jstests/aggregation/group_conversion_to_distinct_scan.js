@@ -318,8 +318,7 @@ assert.neq(null, getAggPlanStage(explain, "FETCH"));
 assert.eq(null, getAggPlanStage(explain, "SORT"));
 
 //
-// Verify that we _do not_ attempt a DISTINCT_SCAN because "mkB" is multikey, and we don't use
-// DISTINCT_SCAN for a compound group key.
+// Verify that we _do not_ attempt a DISTINCT_SCAN for a compound group key when "mkB" is multikey.
 //
 pipeline = [{$sort: {aa: 1, mkB: 1}}, {$group: {_id: {aa: "$aa", mkB: "$mkB"}}}];
 assertResultsMatchWithAndWithoutHintandIndexes(
@@ -557,6 +556,44 @@ assert.neq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), explain);
 assert.eq({a: 1, b: 1, c: 1}, getAggPlanStage(explain, "DISTINCT_SCAN").keyPattern);
 assert.eq(null, getAggPlanStage(explain, "SORT"), explain);
 
+//
+// Verify that a $group on several fields can use DISTINCT_SCAN when those fields lead the index and
+// the $match excludes null values of each of them.
+//
+pipeline = [
+    {$match: {a: {$gt: 0}, b: {$gt: 0}}},
+    {$sort: {a: 1, b: 1, c: 1}},
+    {$group: {_id: {x: "$a", y: "$b"}, accum: {$first: "$c"}}}
+];
+assertResultsMatchWithAndWithoutHintandIndexes(pipeline, [
+    {_id: {x: 1, y: 1}, accum: 1},
+    {_id: {x: 1, y: 2}, accum: 2},
+    {_id: {x: 1, y: 3}, accum: 2},
+    {_id: {x: 2, y: 2}, accum: 2}
+]);
+explain = coll.explain().aggregate(pipeline);
+assert.neq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), explain);
+assert.eq({a: 1, b: 1, c: 1}, getAggPlanStage(explain, "DISTINCT_SCAN").keyPattern);
+assert.eq(null, getAggPlanStage(explain, "SORT"), explain);
+
+//
+// Verify that a $group on several fields _does not_ use DISTINCT_SCAN when null values may be
+// scanned, because a missing field and a null one fall into different groups but share an index
+// key.
+//
+pipeline = [{$sort: {a: 1, b: 1}}, {$group: {_id: {x: "$a", y: "$b"}}}];
+assertResultsMatchWithAndWithoutHintandIndexes(pipeline, [
+    {_id: {}},
+    {_id: {y: 1}},
+    {_id: {x: null, y: 1}},
+    {_id: {x: 1, y: 1}},
+    {_id: {x: 1, y: 2}},
+    {_id: {x: 1, y: 3}},
+    {_id: {x: 2, y: 2}}
+]);
+explain = coll.explain().aggregate(pipeline);
+assert.eq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), explain);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // We execute all the collation-related tests three times with three different configurations
 // (no index, index without collation, index with collation).
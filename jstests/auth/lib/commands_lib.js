@@ -307,6 +307,31 @@ var authCommandsLib = {
           }]
         },
 
+        {
+          testname: "analyze",
+          command: {analyze: "x", key: "a"},
+          skipSharded: true,
+          setup: function(db) {
+              assert.writeOK(db.x.save({a: 1}));
+          },
+          teardown: function(db) {
+              db.x.drop();
+          },
+          testcases: [
+              {
+                runOnDb: firstDbName,
+                roles: roles_dbAdmin,
+                privileges:
+                    [{resource: {db: firstDbName, collection: "x"}, actions: ["planCacheWrite"]}],
+              },
+              {
+                runOnDb: secondDbName,
+                roles: roles_dbAdminAny,
+                privileges:
+                    [{resource: {db: secondDbName, collection: "x"}, actions: ["planCacheWrite"]}],
+              },
+          ]
+        },
         {
           testname: "applyOps_empty",
           command: {applyOps: []},
@@ -2187,6 +2212,34 @@ var authCommandsLib = {
               {runOnDb: secondDbName, roles: roles_all, privileges: []}
           ]
         },
+        {
+          testname: "bulkWrite",
+          command: {
+              bulkWrite: 1,
+              ops: [
+                  {insert: "foo", documents: [{data: 5}]},
+                  {insert: "bar", documents: [{data: 5}]}
+              ]
+          },
+          testcases: [
+              {
+                runOnDb: firstDbName,
+                roles: roles_write,
+                privileges: [
+                    {resource: {db: firstDbName, collection: "foo"}, actions: ["insert"]},
+                    {resource: {db: firstDbName, collection: "bar"}, actions: ["insert"]}
+                ],
+              },
+              {
+                runOnDb: secondDbName,
+                roles: {"readWriteAnyDatabase": 1, "root": 1, "__system": 1, "restore": 1},
+                privileges: [
+                    {resource: {db: secondDbName, collection: "foo"}, actions: ["insert"]},
+                    {resource: {db: secondDbName, collection: "bar"}, actions: ["insert"]}
+                ],
+              }
+          ]
+        },
         {
           testname: "checkShardingIndex_firstDb",
           command: {checkShardingIndex: firstDbName + ".x", keyPattern: {_id: 1}},
@@ -6189,6 +6242,31 @@ var authCommandsLib = {
               },
             ]
         },
+        {
+          testname: "aggregate_query_shape_stats",
+          command: {
+              aggregate: 1,
+              pipeline: [{$queryShapeStats: {}}],
+              cursor: {}
+          },
+          testcases: [
+              {
+                runOnDb: adminDbName,
+                roles: roles_monitoring,
+                privileges: [
+                    {resource: {cluster: true}, actions: ["serverStatus"]},
+                ],
+              },
+              {
+                runOnDb: firstDbName,
+                roles: roles_monitoring,
+                privileges: [
+                    {resource: {cluster: true}, actions: ["serverStatus"]},
+                ],
+                expectFail: true,
+              },
+            ]
+        },
         {
           testname: "validate_db_metadata_command_specific_db",
           command: {
@@ -73,12 +73,25 @@ winningPlan = getWinningPlan(explain.queryPlanner);
 assert(planHasStage(db, winningPlan, "PROJECTION_COVERED"));
 assert(planHasStage(db, winningPlan, "DISTINCT_SCAN"));
 
-// Test distinct over a trailing multikey field.
+// Test distinct over a trailing multikey field. Since the predicate does not constrain 'b' and
+// 'b' is the only multikey field, a DISTINCT_SCAN reaches a document containing each value of 'b',
+// and the values are extracted from the fetched documents.
 result = coll.distinct("b", {a: {$gte: 2}});
 assert.eq([3, 4, 5], result.sort());
 explain = coll.explain("queryPlanner").distinct("b", {a: {$gte: 2}});
 winningPlan = getWinningPlan(explain.queryPlanner);
 assert(planHasStage(db, winningPlan, "FETCH"));
+assert(planHasStage(db, winningPlan, "DISTINCT_SCAN"));
+
+// Test that the distinct scan is not used over a trailing multikey field when a leading field is
+// also multikey, since a document's keys then need not pair each leading value with every value of
+// the distinct field.
+assert.commandWorked(coll.insert({a: [7, 8], b: [6]}));
+result = coll.distinct("b", {a: {$gte: 2}});
+assert.eq([3, 4, 5, 6], result.sort());
+explain = coll.explain("queryPlanner").distinct("b", {a: {$gte: 2}});
+winningPlan = getWinningPlan(explain.queryPlanner);
+assert(planHasStage(db, winningPlan, "FETCH"));
 assert(planHasStage(db, winningPlan, "IXSCAN"));
 
 // Test distinct over a trailing non-multikey field, where the leading field is multikey.
@@ -114,6 +114,7 @@ let viewsCommandTests = {
     _configsvrShardCollection:
         {skip: isAnInternalCommand},  // TODO SERVER-58843: Remove once 6.0 becomes last LTS
     _configsvrUpdateZoneKeyRange: {skip: isAnInternalCommand},
+    _configsvrWaitForRoutingChange: {skip: isAnInternalCommand},
     _flushDatabaseCacheUpdates: {skip: isUnrelated},
     _flushDatabaseCacheUpdatesWithWriteConcern: {skip: isUnrelated},
     _flushReshardingStateChange: {skip: isUnrelated},
@@ -158,6 +159,7 @@ let viewsCommandTests = {
     addShard: {skip: isUnrelated},
     addShardToZone: {skip: isUnrelated},
     aggregate: {command: {aggregate: "view", pipeline: [{$match: {}}], cursor: {}}},
+    analyze: {command: {analyze: "view", key: "x"}, expectFailure: true, skipSharded: true},
     appendOplogNote: {skip: isUnrelated},
     applyOps: {
         command: {applyOps: [{op: "i", o: {_id: 1}, ns: "test.view"}]},
@@ -180,6 +182,7 @@ let viewsCommandTests = {
     balancerStatus: {skip: isUnrelated},
     balancerStop: {skip: isUnrelated},
     buildInfo: {skip: isUnrelated},
+    bulkWrite: {skip: "runs insert, update and delete commands, which are tested separately"},
     captrunc: {
         command: {captrunc: "view", n: 2, inc: false},
         expectFailure: true,
@@ -0,0 +1,78 @@
+/**
+ * Tests that with adaptive batch sizing enabled, find and getMore batches without a batchSize are
+ * sized by their time and byte budgets, and that an explicit batchSize is still honored.
+ * @tags: [requires_scripting]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryEnableAdaptiveBatchSizing: true}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.adaptive_batch_sizing;
+
+const kNumDocs = 1000;
+const docs = [];
+for (let i = 0; i < kNumDocs; i++) {
+    docs.push({_id: i, pad: "x".repeat(1000)});
+}
+assert.commandWorked(coll.insert(docs));
+
+function setParam(name, value) {
+    assert.commandWorked(db.adminCommand({setParameter: 1, [name]: value}));
+}
+
+function idleCursor(cursorId) {
+    const res = db.getSiblingDB("admin")
+                    .aggregate([
+                        {$currentOp: {idleCursors: true}},
+                        {$match: {type: "idleCursor", "cursor.cursorId": cursorId}}
+                    ])
+                    .toArray();
+    assert.eq(1, res.length, res);
+    return res[0].cursor;
+}
+
+// A cheap plan fills the first batch well past the default of 101 documents.
+let res = assert.commandWorked(db.runCommand({find: coll.getName()}));
+assert.gt(res.cursor.firstBatch.length, 101, res.cursor.id);
+
+// An explicit batchSize is honored.
+res = assert.commandWorked(db.runCommand({find: coll.getName(), batchSize: 10}));
+assert.eq(10, res.cursor.firstBatch.length);
+assert.eq(10, idleCursor(res.cursor.id).nDocsReturnedLastBatch);
+res = assert.commandWorked(
+    db.runCommand({getMore: res.cursor.id, collection: coll.getName(), batchSize: 7}));
+assert.eq(7, res.cursor.nextBatch.length);
+assert.eq(7, idleCursor(res.cursor.id).nDocsReturnedLastBatch);
+
+// The byte budget ends batches of large documents early.
+setParam("internalQueryAdaptiveBatchTargetBytes", 20 * 1024);
+res = assert.commandWorked(db.runCommand({find: coll.getName()}));
+assert.lt(res.cursor.firstBatch.length, 30, res.cursor.id);
+assert.gt(res.cursor.firstBatch.length, 1, res.cursor.id);
+res = assert.commandWorked(db.runCommand({getMore: res.cursor.id, collection: coll.getName()}));
+assert.lt(res.cursor.nextBatch.length, 30, res.cursor.id);
+assert.gt(res.cursor.nextBatch.length, 1, res.cursor.id);
+assert.eq(res.cursor.nextBatch.length, idleCursor(res.cursor.id).nDocsReturnedLastBatch);
+assert.commandWorked(db.runCommand({killCursors: coll.getName(), cursors: [res.cursor.id]}));
+setParam("internalQueryAdaptiveBatchTargetBytes", 4 * 1024 * 1024);
+
+// The time budget ends batches of expensive documents early.
+setParam("internalQueryAdaptiveBatchTargetMillis", 100);
+const slowFilter = {$where: "sleep(20); return true;"};
+res = assert.commandWorked(db.runCommand({find: coll.getName(), filter: slowFilter}));
+assert.lt(res.cursor.firstBatch.length, 50, res.cursor.id);
+assert.gte(res.cursor.firstBatch.length, 1, res.cursor.id);
+res = assert.commandWorked(db.runCommand({getMore: res.cursor.id, collection: coll.getName()}));
+assert.lt(res.cursor.nextBatch.length, 50, res.cursor.id);
+assert.gte(res.cursor.nextBatch.length, 1, res.cursor.id);
+assert.commandWorked(db.runCommand({killCursors: coll.getName(), cursors: [res.cursor.id]}));
+
+// Without adaptive sizing the default first batch size applies again.
+setParam("internalQueryEnableAdaptiveBatchSizing", false);
+res = assert.commandWorked(db.runCommand({find: coll.getName()}));
+assert.eq(101, res.cursor.firstBatch.length);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,84 @@
+/**
+ * Tests that the histograms built by the 'analyze' command let the planner pick the most selective
+ * index scan without multi-planning, and that such plans are not added to the plan cache.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getWinningPlan, getPlanStage and hasRejectedPlans.
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+
+const coll = db.analyze_histogram_plan_selection;
+coll.drop();
+
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1000; ++i) {
+    bulk.insert({_id: i, a: i, b: i % 2});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+
+const query = {
+    a: {$in: [5, 7]},
+    b: 1
+};
+
+function assertResults() {
+    assert.sameMembers([{_id: 5}, {_id: 7}], coll.find(query, {_id: 1}).toArray());
+}
+
+// Without statistics both index scans are multi-planned.
+let explain = coll.find(query).explain();
+assert(hasRejectedPlans(explain), explain);
+assertResults();
+
+// Bad arguments are rejected.
+assert.commandFailedWithCode(db.runCommand({analyze: coll.getName()}), 6000139);
+assert.commandFailedWithCode(db.runCommand({analyze: coll.getName(), key: "a", numBuckets: 0}),
+                             6000138);
+assert.commandFailedWithCode(db.runCommand({analyze: "nonexistent", key: "a"}),
+                             ErrorCodes.NamespaceNotFound);
+
+// Statistics for a single field are not enough to estimate both candidates.
+let res = assert.commandWorked(db.runCommand({analyze: coll.getName(), key: "a"}));
+assert.eq(1000, res.numDocsSampled, res);
+assert.eq(1000, res.numRecords, res);
+assert.eq(1000, res.histogram.totalCount, res);
+assert.eq(1000, res.histogram.distinctCount, res);
+assert.lte(res.histogram.buckets.length, 100, res);
+
+explain = coll.find(query).explain();
+assert(hasRejectedPlans(explain), explain);
+
+res = assert.commandWorked(db.runCommand({analyze: coll.getName(), key: "b", numBuckets: 10}));
+assert.eq(2, res.histogram.distinctCount, res);
+
+// With statistics for both fields the index on 'a' is picked without a trial period.
+coll.getPlanCache().clear();
+explain = coll.find(query).explain();
+assert(!hasRejectedPlans(explain), explain);
+const ixscan = getPlanStage(getWinningPlan(explain.queryPlanner), "IXSCAN");
+assert.neq(null, ixscan, explain);
+assert.eq("a_1", ixscan.indexName, explain);
+assertResults();
+assert.eq(0, coll.getPlanCache().list().length, coll.getPlanCache().list());
+
+// Candidates which are not estimated clearly apart are still multi-planned.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryHistogramPlanSelectionMinRatio: 1000}));
+explain = coll.find(query).explain();
+assert(hasRejectedPlans(explain), explain);
+
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryHistogramPlanSelectionMinRatio: 4}));
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryUseHistogramsForPlanSelection: false}));
+explain = coll.find(query).explain();
+assert(hasRejectedPlans(explain), explain);
+
+MongoRunner.stopMongod(conn);
+}());
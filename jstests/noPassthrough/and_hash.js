@@ -4,6 +4,7 @@
 
 load("jstests/aggregation/extras/utils.js");  // For assertArrayEq.
 load("jstests/libs/analyze_plan.js");  // For planHasStage helper to analyze explain() output.
+load("jstests/libs/sbe_util.js");      // For checkSBEEnabled.
 
 const conn = MongoRunner.runMongod();
 const db = conn.getDB("test");
@@ -41,6 +42,10 @@ assert.commandWorked(coll.insertMany([
     {_id: 15, a: 1, e: [7, 8, 9], f: [-1, -2, -3]},
 ]));
 
+// The stage which performs the hash-based intersection. The classic engine replaces the fetch of
+// an AND_HASH over index scans with an AND_BITMAP stage unless this is disabled.
+let andHashStage = "AND_HASH";
+
 // Helper to check the result returned by the query and to check whether the
 // query solution correctly did or did not use an AND_HASH for index
 // intersection.
@@ -49,92 +54,108 @@ function assertAndHashUsed({query, expectedResult, shouldUseAndHash} = {}) {
     const expl = queryResult.explain();
 
     assertArrayEq({actual: queryResult.toArray(), expected: expectedResult});
-    assert.eq(shouldUseAndHash, planHasStage(db, getWinningPlan(expl.queryPlanner), "AND_HASH"));
+    assert.eq(shouldUseAndHash, planHasStage(db, getWinningPlan(expl.queryPlanner), andHashStage));
+}
+
+function runTests() {
+    // Test basic index intersection where we expect AND_HASH to be used.
+    assertAndHashUsed({
+        query: {a: {$gt: 1}, c: null},
+        expectedResult: [{_id: 3, a: 2, b: 2, c: null}],
+        shouldUseAndHash: true
+    });
+    assertAndHashUsed({
+        query: {a: {$gt: 3}, c: {x: 1, y: 2}},
+        expectedResult: [
+            {_id: 9, a: 4, b: "a", c: {x: 1, y: 2}, d: "field"},
+            {_id: 12, a: 4, b: "a", c: {x: 1, y: 2}, d: "field", e: [1, 2, 3]}
+        ],
+        shouldUseAndHash: true
+    });
+    assertAndHashUsed({
+        query: {a: {$lt: 5}, b: {$in: ["A", "abc"]}},
+        expectedResult: [
+            {_id: 0, a: 1, b: "A", c: 22, d: "field"},
+            {_id: 7, a: 3, b: "abc", c: 22, d: 23},
+            {_id: 8, a: 3, b: "A", c: 22, d: "field"},
+        ],
+        shouldUseAndHash: true
+    });
+    assertAndHashUsed({
+        query: {a: {$gt: 1}, e: {$elemMatch: {$lt: 7}}},
+        expectedResult: [
+            {_id: 12, a: 4, b: "a", c: {x: 1, y: 2}, d: "field", e: [1, 2, 3]},
+            {_id: 13, a: 5, b: "ABC", d: 22, c: "field", e: [4, 5, 6]},
+        ],
+        shouldUseAndHash: true
+    });
+    assertAndHashUsed(
+        {query: {a: {$gt: 5}, c: {$lt: 3}}, expectedResult: [], shouldUseAndHash: true});
+    assertAndHashUsed({query: {a: {$gt: 5}, c: null}, expectedResult: [], shouldUseAndHash: true});
+    assertAndHashUsed(
+        {query: {a: {$gt: 1}, c: {$lt: 3}}, expectedResult: [], shouldUseAndHash: true});
+
+    // Test queries that should not use AND_HASH.
+    assertAndHashUsed({
+        query: {a: 6},
+        expectedResult: [
+            {_id: 11, a: 6, b: "ABC", d: 22, c: "field"},
+            {_id: 14, a: 6, b: "ABC", d: 22, c: "field", e: [7, 8, 9]}
+        ],
+        shouldUseAndHash: false
+    });
+    assertAndHashUsed({query: {fieldDoesNotExist: 1}, expectedResult: [], shouldUseAndHash: false});
+    assertAndHashUsed({
+        query: {$or: [{a: 6}, {fieldDoesNotExist: 1}]},
+        expectedResult: [
+            {_id: 11, a: 6, b: "ABC", d: 22, c: "field"},
+            {_id: 14, a: 6, b: "ABC", d: 22, c: "field", e: [7, 8, 9]}
+        ],
+        shouldUseAndHash: false
+    });
+    assertAndHashUsed(
+        {query: {$or: [{a: 7}, {a: 8}]}, expectedResult: [], shouldUseAndHash: false});
+
+    // Test intersection with a compound index.
+    assert.commandWorked(coll.createIndex({c: 1, d: -1}));
+    assertAndHashUsed({
+        query: {a: {$gt: 1}, c: {$gt: 0}, d: {$gt: 90}},
+        expectedResult: [{_id: 5, a: 2, b: "E", c: 22, d: 99}],
+        shouldUseAndHash: true
+    });
+    // The query on only 'd' field should not be able to use the index and thus the intersection
+    // since it is not using a prefix of the compound index {c:1, d:-1}.
+    assertAndHashUsed({
+        query: {a: {$gt: 1}, d: {$gt: 90}},
+        expectedResult: [{_id: 5, a: 2, b: "E", c: 22, d: 99}],
+        shouldUseAndHash: false
+    });
+
+    // Test that deduplication is correctly performed on top of the index scans that comprise the
+    // hash join -- predicate matching multiple elements of array should not return the same
+    // document more than once.
+    assertAndHashUsed({
+        query: {e: {$gt: 0}, a: 6},
+        expectedResult: [{_id: 14, a: 6, b: "ABC", d: 22, c: "field", e: [7, 8, 9]}],
+        shouldUseAndHash: true
+    });
+    assertAndHashUsed({
+        query: {e: {$gt: 0}, f: {$lt: 0}},
+        expectedResult: [{_id: 15, a: 1, e: [7, 8, 9], f: [-1, -2, -3]}],
+        shouldUseAndHash: true
+    });
+
+    assert.commandWorked(coll.dropIndex({c: 1, d: -1}));
 }
 
-// Test basic index intersection where we expect AND_HASH to be used.
-assertAndHashUsed({
-    query: {a: {$gt: 1}, c: null},
-    expectedResult: [{_id: 3, a: 2, b: 2, c: null}],
-    shouldUseAndHash: true
-});
-assertAndHashUsed({
-    query: {a: {$gt: 3}, c: {x: 1, y: 2}},
-    expectedResult: [
-        {_id: 9, a: 4, b: "a", c: {x: 1, y: 2}, d: "field"},
-        {_id: 12, a: 4, b: "a", c: {x: 1, y: 2}, d: "field", e: [1, 2, 3]}
-    ],
-    shouldUseAndHash: true
-});
-assertAndHashUsed({
-    query: {a: {$lt: 5}, b: {$in: ["A", "abc"]}},
-    expectedResult: [
-        {_id: 0, a: 1, b: "A", c: 22, d: "field"},
-        {_id: 7, a: 3, b: "abc", c: 22, d: 23},
-        {_id: 8, a: 3, b: "A", c: 22, d: "field"},
-    ],
-    shouldUseAndHash: true
-});
-assertAndHashUsed({
-    query: {a: {$gt: 1}, e: {$elemMatch: {$lt: 7}}},
-    expectedResult: [
-        {_id: 12, a: 4, b: "a", c: {x: 1, y: 2}, d: "field", e: [1, 2, 3]},
-        {_id: 13, a: 5, b: "ABC", d: 22, c: "field", e: [4, 5, 6]},
-    ],
-    shouldUseAndHash: true
-});
-assertAndHashUsed({query: {a: {$gt: 5}, c: {$lt: 3}}, expectedResult: [], shouldUseAndHash: true});
-assertAndHashUsed({query: {a: {$gt: 5}, c: null}, expectedResult: [], shouldUseAndHash: true});
-assertAndHashUsed({query: {a: {$gt: 1}, c: {$lt: 3}}, expectedResult: [], shouldUseAndHash: true});
-
-// Test queries that should not use AND_HASH.
-assertAndHashUsed({
-    query: {a: 6},
-    expectedResult: [
-        {_id: 11, a: 6, b: "ABC", d: 22, c: "field"},
-        {_id: 14, a: 6, b: "ABC", d: 22, c: "field", e: [7, 8, 9]}
-    ],
-    shouldUseAndHash: false
-});
-assertAndHashUsed({query: {fieldDoesNotExist: 1}, expectedResult: [], shouldUseAndHash: false});
-assertAndHashUsed({
-    query: {$or: [{a: 6}, {fieldDoesNotExist: 1}]},
-    expectedResult: [
-        {_id: 11, a: 6, b: "ABC", d: 22, c: "field"},
-        {_id: 14, a: 6, b: "ABC", d: 22, c: "field", e: [7, 8, 9]}
-    ],
-    shouldUseAndHash: false
-});
-assertAndHashUsed({query: {$or: [{a: 7}, {a: 8}]}, expectedResult: [], shouldUseAndHash: false});
-
-// Test intersection with a compound index.
-assert.commandWorked(coll.createIndex({c: 1, d: -1}));
-assertAndHashUsed({
-    query: {a: {$gt: 1}, c: {$gt: 0}, d: {$gt: 90}},
-    expectedResult: [{_id: 5, a: 2, b: "E", c: 22, d: 99}],
-    shouldUseAndHash: true
-});
-// The query on only 'd' field should not be able to use the index and thus the intersection
-// since it is not using a prefix of the compound index {c:1, d:-1}.
-assertAndHashUsed({
-    query: {a: {$gt: 1}, d: {$gt: 90}},
-    expectedResult: [{_id: 5, a: 2, b: "E", c: 22, d: 99}],
-    shouldUseAndHash: false
-});
-
-// Test that deduplication is correctly performed on top of the index scans that comprise the
-// hash join -- predicate matching multiple elements of array should not return the same
-// document more than once.
-assertAndHashUsed({
-    query: {e: {$gt: 0}, a: 6},
-    expectedResult: [{_id: 14, a: 6, b: "ABC", d: 22, c: "field", e: [7, 8, 9]}],
-    shouldUseAndHash: true
-});
-assertAndHashUsed({
-    query: {e: {$gt: 0}, f: {$lt: 0}},
-    expectedResult: [{_id: 15, a: 1, e: [7, 8, 9], f: [-1, -2, -3]}],
-    shouldUseAndHash: true
-});
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryExecUseBitmapIntersection: false}));
+runTests();
+
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryExecUseBitmapIntersection: true}));
+andHashStage = checkSBEEnabled(db) ? "AND_HASH" : "AND_BITMAP";
+runTests();
 
 MongoRunner.stopMongod(conn);
 })();
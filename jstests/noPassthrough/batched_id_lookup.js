@@ -0,0 +1,85 @@
+/**
+ * Tests that an unsorted query for many _id values fetches the documents in record id order with a
+ * BATCHED_ID_LOOKUP stage, in both the classic and the slot-based execution engines.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getWinningPlan and planHasStage.
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+
+const coll = db.batched_id_lookup;
+coll.drop();
+
+// Insert the documents in descending _id order, so that record id order is the reverse of _id
+// order.
+const kNumDocs = 2000;
+const bulk = coll.initializeOrderedBulkOp();
+for (let i = kNumDocs - 1; i >= 0; --i) {
+    bulk.insert({_id: i, a: i % 10});
+}
+assert.commandWorked(bulk.execute());
+
+const ids = [];
+for (let i = 0; i < 1500; ++i) {
+    ids.push(i);
+}
+// Values without a document are looked up too.
+ids.push(kNumDocs, kNumDocs + 1);
+
+function assertBatchedLookup(query, expectedIds) {
+    const explain = coll.find(query).explain("executionStats");
+    const winningPlan = getWinningPlan(explain.queryPlanner);
+    assert(planHasStage(db, winningPlan, "BATCHED_ID_LOOKUP"), explain);
+    assert(!planHasStage(db, winningPlan, "FETCH"), explain);
+    assert.eq(expectedIds.length, explain.executionStats.nReturned, explain);
+
+    // The documents come back in record id order.
+    assert.eq(expectedIds, coll.find(query).toArray().map(doc => doc._id));
+}
+
+function runTests() {
+    const allIds = ids.filter(id => id < kNumDocs).reverse();
+    assertBatchedLookup({_id: {$in: ids}}, allIds);
+
+    // A residual predicate is applied to the fetched documents.
+    assertBatchedLookup({_id: {$in: ids}, a: 3}, allIds.filter(id => id % 10 === 3));
+
+    // A limit and a projection are applied above the lookup.
+    assert.eq(allIds.slice(0, 5),
+              coll.find({_id: {$in: ids}}, {a: 1}).limit(5).toArray().map(doc => doc._id));
+
+    // With a sort on _id, the documents are still fetched in _id order.
+    let explain = coll.find({_id: {$in: ids}}).sort({_id: 1}).explain();
+    assert(!planHasStage(db, getWinningPlan(explain.queryPlanner), "BATCHED_ID_LOOKUP"), explain);
+    assert.eq(ids.filter(id => id < kNumDocs),
+              coll.find({_id: {$in: ids}}).sort({_id: 1}).toArray().map(doc => doc._id));
+
+    // A smaller $in does not use the stage.
+    explain = coll.find({_id: {$in: ids.slice(0, 10)}}).explain();
+    assert(!planHasStage(db, getWinningPlan(explain.queryPlanner), "BATCHED_ID_LOOKUP"), explain);
+    assert.eq(10, coll.find({_id: {$in: ids.slice(0, 10)}}).itcount());
+
+    // Setting the threshold to 0 turns the stage off.
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryBatchedIdLookupMinKeys: 0}));
+    coll.getPlanCache().clear();
+    explain = coll.find({_id: {$in: ids}}).explain();
+    assert(!planHasStage(db, getWinningPlan(explain.queryPlanner), "BATCHED_ID_LOOKUP"), explain);
+    assert.eq(allIds.length, coll.find({_id: {$in: ids}}).itcount());
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryBatchedIdLookupMinKeys: 1000}));
+    coll.getPlanCache().clear();
+}
+
+for (let useSbe of [false, true]) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryEnableSlotBasedExecutionEngine: useSbe}));
+    runTests();
+}
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,82 @@
+/**
+ * Tests the bulkWrite command, which executes insert, update and delete commands on several
+ * collections of a database as a single command, on a replica set and through mongos, including
+ * retries of retryable bulkWrite commands.
+ * @tags: [requires_replication, requires_sharding]
+ */
+(function() {
+"use strict";
+
+function runTests(conn) {
+    const db = conn.getDB("test");
+    db.dropDatabase();
+
+    const res = assert.commandWorked(db.runCommand({
+        bulkWrite: 1,
+        ops: [
+            {insert: "a", documents: [{_id: 0, x: 0}, {_id: 1, x: 1}]},
+            {insert: "b", documents: [{_id: 0}]},
+            {update: "a", updates: [{q: {_id: 1}, u: {$inc: {x: 1}}}]},
+            {update: "b", updates: [{q: {_id: 1}, u: {$set: {y: 1}}, upsert: true}]},
+            {delete: "a", deletes: [{q: {_id: 0}, limit: 1}]},
+        ]
+    }));
+    assert.eq(5, res.results.length, res);
+    assert.eq(2, res.results[0].n, res);
+    assert.eq(1, res.results[2].nModified, res);
+    assert.eq(1, res.results[3].upserted.length, res);
+    assert.eq(1, res.results[4].n, res);
+    assert.eq([{_id: 1, x: 2}], db.a.find().toArray());
+    assert.eq([{_id: 0}, {_id: 1, y: 1}], db.b.find().sort({_id: 1}).toArray());
+
+    // An ordered bulkWrite stops after the first write command with write errors. An unordered
+    // one runs all of them.
+    const ops = [{insert: "a", documents: [{_id: 1}]}, {insert: "b", documents: [{_id: 2}]}];
+    let failedRes = assert.commandWorked(db.runCommand({bulkWrite: 1, ops: ops}));
+    assert.eq(1, failedRes.results.length, failedRes);
+    assert.eq(ErrorCodes.DuplicateKey, failedRes.results[0].writeErrors[0].code, failedRes);
+    assert.eq(2, db.b.find().itcount());
+    failedRes = assert.commandWorked(db.runCommand({bulkWrite: 1, ops: ops, ordered: false}));
+    assert.eq(2, failedRes.results.length, failedRes);
+    assert.eq(3, db.b.find().itcount());
+
+    // Only insert, update and delete commands are accepted, and they may not carry statement ids.
+    assert.commandFailedWithCode(db.runCommand({bulkWrite: 1, ops: [{find: "a"}]}),
+                                 ErrorCodes.FailedToParse);
+    assert.commandFailedWithCode(
+        db.runCommand({bulkWrite: 1, ops: [{insert: "a", documents: [{}], stmtId: 5}]}),
+        ErrorCodes.InvalidOptions);
+    assert.commandFailedWithCode(db.runCommand({bulkWrite: 1, ops: []}), ErrorCodes.InvalidLength);
+
+    // Retrying a retryable bulkWrite does not apply its statements again.
+    const session = conn.startSession();
+    const sessionDb = session.getDatabase("test");
+    const retryableCmd = {
+        bulkWrite: 1,
+        ops: [
+            {insert: "a", documents: [{_id: 10}, {_id: 11}]},
+            {update: "b", updates: [{q: {_id: 0}, u: {$inc: {count: 1}}}]},
+            {insert: "b", documents: [{_id: 10}]},
+        ],
+        lsid: session.getSessionId(),
+        txnNumber: NumberLong(0),
+    };
+    const firstRes = assert.commandWorked(sessionDb.runCommand(retryableCmd));
+    const retryRes = assert.commandWorked(sessionDb.runCommand(retryableCmd));
+    assert.eq(firstRes.results.map(result => result.n), retryRes.results.map(result => result.n));
+    assert.eq(1, db.b.findOne({_id: 0}).count);
+    assert.eq(3, db.a.find().itcount());
+    assert.eq(4, db.b.find().itcount());
+    session.endSession();
+}
+
+const rst = new ReplSetTest({nodes: 1});
+rst.startSet();
+rst.initiate();
+runTests(rst.getPrimary());
+rst.stopSet();
+
+const st = new ShardingTest({shards: 2, mongos: 1});
+runTests(st.s);
+st.stop();
+}());
@@ -0,0 +1,85 @@
+/**
+ * Tests that with SBE enabled the oplog scan of a change stream runs in SBE, with the filter
+ * rewritten from the stream's $match compiled into the scan, and that it returns the same events
+ * and resume tokens as the classic engine.
+ * @tags: [
+ *   requires_replication,
+ *   uses_change_streams,
+ * ]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({
+    nodes: 1,
+    nodeOptions: {setParameter: {internalQueryEnableSlotBasedExecutionEngine: true}}
+});
+rst.startSet();
+rst.initiate();
+
+const db = rst.getPrimary().getDB(jsTestName());
+const coll = db.coll;
+assert.commandWorked(db.createCollection(coll.getName()));
+
+const pipeline = [{$changeStream: {}}, {$match: {"fullDocument.x": {$gte: 5}}}];
+
+function setSbeOplogScan(enabled) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryEnableSBEChangeStreamOplogScan: enabled}));
+}
+
+function usesSbe() {
+    const explain = assert.commandWorked(coll.explain().aggregate(pipeline));
+    const cursorStage = explain.stages[0].$cursor;
+    assert(cursorStage, explain);
+    return cursorStage.queryPlanner.winningPlan.hasOwnProperty("slotBasedPlan");
+}
+
+function collectEvents(startAtOperationTime, numExpected) {
+    const cursor = coll.watch(pipeline.slice(1), {startAtOperationTime: startAtOperationTime});
+    const events = [];
+    assert.soon(() => {
+        while (cursor.hasNext()) {
+            const event = cursor.next();
+            events.push({op: event.operationType, doc: event.fullDocument, id: event._id});
+        }
+        return events.length >= numExpected;
+    });
+    cursor.close();
+    return events;
+}
+
+const startTime =
+    assert.commandWorked(db.runCommand({insert: coll.getName(), documents: [{_id: 0, x: 0}]}))
+        .operationTime;
+for (let i = 1; i < 10; i++) {
+    assert.commandWorked(coll.insert({_id: i, x: i}));
+}
+assert.commandWorked(coll.update({_id: 7}, {$set: {y: 1}}));
+
+setSbeOplogScan(false);
+assert(!usesSbe());
+const classicEvents = collectEvents(startTime, 5);
+
+setSbeOplogScan(true);
+assert(usesSbe());
+const sbeEvents = collectEvents(startTime, 5);
+assert.eq(classicEvents, sbeEvents);
+assert.eq([5, 6, 7, 8, 9], sbeEvents.map(event => event.doc._id), sbeEvents);
+
+// Entries which do not match the filter still advance the postBatchResumeToken.
+const cursor = coll.watch(pipeline.slice(1));
+assert(!cursor.hasNext());
+const tokenBefore = cursor.getResumeToken();
+assert.commandWorked(coll.insert({_id: 100, x: 0}));
+assert.soon(() => {
+    assert(!cursor.hasNext());
+    return bsonWoCompare(cursor.getResumeToken(), tokenBefore) > 0;
+});
+assert.commandWorked(coll.insert({_id: 101, x: 50}));
+assert.soon(() => cursor.hasNext());
+assert.eq(101, cursor.next().fullDocument._id);
+cursor.close();
+
+rst.stopSet();
+}());
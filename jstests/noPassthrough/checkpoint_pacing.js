@@ -0,0 +1,41 @@
+/**
+ * Tests that checkpoint pacing takes a checkpoint early once enough modified data has accumulated,
+ * and that checkpoint statistics are reported in serverStatus.
+ * @tags: [requires_persistence, requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    syncdelay: 3600,
+    setParameter: {
+        checkpointPacingDirtyMB: 1,
+        checkpointPacingMinIntervalSecs: 1,
+        wiredTigerCheckpointMaxWriteMBPerSec: 100,
+    },
+});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+
+// With a syncdelay of an hour, any checkpoint taken during the test was triggered by pacing.
+const pad = "x".repeat(1024);
+let batch = 0;
+assert.soon(() => {
+    const docs = [];
+    for (let i = 0; i < 1000; i++) {
+        docs.push({batch: batch, i: i, pad: pad});
+    }
+    assert.commandWorked(db.checkpoint_pacing.insert(docs));
+    batch++;
+    return db.serverStatus().checkpointer.pacedCheckpoints > 0;
+}, () => tojson(db.serverStatus().checkpointer));
+
+const stats = db.serverStatus().checkpointer;
+assert.gte(stats.checkpoints, stats.pacedCheckpoints, stats);
+assert.gt(stats.durationMillis.ops, 0, stats);
+
+// Pacing can be disabled at runtime.
+assert.commandWorked(db.adminCommand({setParameter: 1, checkpointPacingDirtyMB: 0}));
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,61 @@
+/**
+ * Tests that collStats reports how many documents were checked against the collection's
+ * validator, and that wide documents validate the same way as narrow ones.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+
+const kNumProperties = 100;
+const properties = {};
+const required = [];
+for (let i = 0; i < kNumProperties; ++i) {
+    properties["f" + i] = {bsonType: "int"};
+    if (i % 10 === 0) {
+        required.push("f" + i);
+    }
+}
+
+assert.commandWorked(db.createCollection(
+    "collstats_document_validation", {validator: {$jsonSchema: {properties, required}}}));
+const coll = db.collstats_document_validation;
+
+function makeDoc(id) {
+    const doc = {_id: id};
+    for (let i = 0; i < kNumProperties; ++i) {
+        doc["f" + i] = NumberInt(i);
+    }
+    return doc;
+}
+
+assert.commandWorked(coll.insert(makeDoc(0)));
+assert.commandWorked(coll.insert(makeDoc(1)));
+
+// A wide document with a property of the wrong type is rejected.
+const badDoc = makeDoc(2);
+badDoc.f57 = "not an int";
+assert.writeErrorWithCode(coll.insert(badDoc), ErrorCodes.DocumentValidationFailure);
+
+// So is a wide document missing a required property.
+const missingDoc = makeDoc(3);
+delete missingDoc.f50;
+assert.writeErrorWithCode(coll.insert(missingDoc), ErrorCodes.DocumentValidationFailure);
+
+// A narrow document is validated too.
+assert.writeErrorWithCode(coll.insert({_id: 4, f0: NumberInt(0)}),
+                          ErrorCodes.DocumentValidationFailure);
+
+const stats = assert.commandWorked(coll.stats()).documentValidation;
+assert.eq(5, stats.validations, stats);
+assert.eq(3, stats.failures, stats);
+assert.gte(stats.validationMicros, 0, stats);
+
+// Collections without a validator do not report any validation statistics.
+assert.commandWorked(db.plain.insert({_id: 0}));
+assert.eq(undefined, assert.commandWorked(db.plain.stats()).documentValidation);
+
+MongoRunner.stopMongod(conn);
+}());
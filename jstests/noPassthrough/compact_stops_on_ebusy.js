@@ -21,5 +21,10 @@ for (const failPoint of failPoints) {
     assert.commandWorked(db.adminCommand({configureFailPoint: failPoint, mode: "off"}));
 }
 
+// Without an interruption, compaction runs to completion and reports the reclaimable space.
+const res = assert.commandWorked(db.runCommand({compact: jsTest.name()}));
+assert.eq(true, res.complete, res);
+assert.gte(res.bytesReclaimable, 0, res);
+
 MongoRunner.stopMongod(conn);
 }());
@@ -0,0 +1,78 @@
+/**
+ * Tests that find cursors whose next batch is prefetched in the background return the same results
+ * as without prefetching, and that errors and kills during a prefetch are reported to the client.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {cursorPrefetchThreads: 2}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.cursor_prefetch;
+
+const kNumDocs = 1000;
+const docs = [];
+for (let i = 0; i < kNumDocs; i++) {
+    docs.push({_id: i, a: i % 10, pad: "x".repeat(100)});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: 1}));
+
+function prefetchMetrics() {
+    return db.serverStatus().metrics.cursor.prefetch;
+}
+
+// Iterates the cursor with getMores of 'batchSize' documents and returns all documents.
+function drainCursor(findCmd, batchSize) {
+    let res = assert.commandWorked(db.runCommand(findCmd));
+    let results = res.cursor.firstBatch;
+    while (res.cursor.id != 0) {
+        res = assert.commandWorked(db.runCommand(
+            {getMore: res.cursor.id, collection: coll.getName(), batchSize: batchSize}));
+        results = results.concat(res.cursor.nextBatch);
+    }
+    return results;
+}
+
+// Results must match the order and contents of a plain iteration, with and without sorts and
+// across index and collection scans.
+const before = prefetchMetrics();
+for (let findCmd of [{find: coll.getName(), batchSize: 7},
+                     {find: coll.getName(), filter: {a: {$gte: 5}}, sort: {a: 1, _id: -1}},
+                     {find: coll.getName(), filter: {a: 3}, projection: {pad: 0}, batchSize: 11},
+                     {find: coll.getName(), skip: 5, limit: 300, batchSize: 50}]) {
+    const expected = coll.aggregate([{$match: findCmd.filter || {}},
+                                     {$sort: findCmd.sort || {_id: 1}},
+                                     {$skip: findCmd.skip || 0},
+                                     {$limit: findCmd.limit || kNumDocs},
+                                     {$project: findCmd.projection || {_id: 1, a: 1, pad: 1}}])
+                         .toArray();
+    assert.eq(expected, drainCursor(findCmd, findCmd.batchSize || 13), tojson(findCmd));
+}
+const after = prefetchMetrics();
+assert.gt(after.scheduled, before.scheduled, tojson(after));
+assert.gt(after.documents, before.documents, tojson(after));
+
+// Nothing stays buffered once every cursor is exhausted.
+assert.soon(() => prefetchMetrics().bufferedBytes == 0, () => tojson(prefetchMetrics()));
+
+// Killing a cursor whose next batch may be in flight deletes it.
+let res = assert.commandWorked(db.runCommand({find: coll.getName(), batchSize: 2}));
+assert.commandWorked(db.runCommand({killCursors: coll.getName(), cursors: [res.cursor.id]}));
+assert.commandFailedWithCode(
+    db.runCommand({getMore: res.cursor.id, collection: coll.getName()}),
+    ErrorCodes.CursorNotFound);
+
+// A cursor whose collection is dropped fails once its prefetched documents run out.
+res = assert.commandWorked(db.runCommand({find: coll.getName(), batchSize: 2}));
+coll.drop();
+let getMoreRes;
+assert.soon(() => {
+    getMoreRes = db.runCommand({getMore: res.cursor.id, collection: coll.getName(), batchSize: 2});
+    return !getMoreRes.ok || getMoreRes.cursor.id == 0;
+});
+assert.commandFailedWithCode(getMoreRes, ErrorCodes.QueryPlanKilled);
+assert.soon(() => prefetchMetrics().bufferedBytes == 0, () => tojson(prefetchMetrics()));
+
+MongoRunner.stopMongod(conn);
+}());
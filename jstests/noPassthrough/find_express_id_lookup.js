@@ -0,0 +1,77 @@
+/**
+ * Tests that finds by _id which are answered by a direct _id index lookup return the same results
+ * as the regular find path, and that other finds are not affected.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.find_express_id_lookup;
+const collatedColl = db.find_express_id_lookup_collated;
+
+assert.commandWorked(db.setProfilingLevel(2));
+
+assert.commandWorked(coll.insert([
+    {_id: 1, a: 1, b: {c: 1}, d: [1, 2]},
+    {_id: "str", a: 2},
+    {_id: {x: 1, y: 2}, a: 3},
+]));
+assert.commandWorked(
+    db.createCollection(collatedColl.getName(), {collation: {locale: "en_US", strength: 2}}));
+assert.commandWorked(collatedColl.insert({_id: "foo", a: 1}));
+
+function setExpressEnabled(enabled) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryEnableExpressIdLookup: enabled}));
+}
+
+function runFind(collection, filter, projection) {
+    return collection.find(filter, projection).toArray();
+}
+
+const cases = [
+    {coll: coll, filter: {_id: 1}},
+    {coll: coll, filter: {_id: 2}},
+    {coll: coll, filter: {_id: "str"}},
+    {coll: coll, filter: {_id: {x: 1, y: 2}}},
+    {coll: coll, filter: {_id: {y: 2, x: 1}}},
+    {coll: coll, filter: {_id: 1}, projection: {a: 1}},
+    {coll: coll, filter: {_id: 1}, projection: {a: 1, _id: 0}},
+    {coll: coll, filter: {_id: 1}, projection: {a: true, missing: 1}},
+    {coll: coll, filter: {_id: 1}, projection: {_id: 1}},
+    {coll: coll, filter: {_id: 1}, projection: {_id: 0}},
+    {coll: coll, filter: {_id: 1}, projection: {"b.c": 1}},
+    {coll: coll, filter: {_id: 1}, projection: {a: 0}},
+    {coll: coll, filter: {_id: 1}, projection: {d: {$slice: 1}}},
+    {coll: collatedColl, filter: {_id: "FOO"}},
+    {coll: collatedColl, filter: {_id: "foo"}, projection: {a: 1}},
+];
+
+for (let testCase of cases) {
+    setExpressEnabled(false);
+    const expected = runFind(testCase.coll, testCase.filter, testCase.projection);
+    setExpressEnabled(true);
+    const actual = runFind(testCase.coll, testCase.filter, testCase.projection);
+    assert.eq(expected, actual, testCase);
+}
+
+// The express path reports the same plan summary and metrics as the IDHACK plan.
+assert.eq(1, coll.find({_id: 1}).comment("express_id_lookup").itcount());
+let profileObj = db.system.profile.find({"command.comment": "express_id_lookup"}).next();
+assert.eq("IDHACK", profileObj.planSummary, profileObj);
+assert.eq(1, profileObj.keysExamined, profileObj);
+assert.eq(1, profileObj.docsExamined, profileObj);
+assert.eq(1, profileObj.nreturned, profileObj);
+assert(profileObj.cursorExhausted, profileObj);
+
+// A batchSize of 0 still opens a cursor.
+const res = assert.commandWorked(
+    db.runCommand({find: coll.getName(), filter: {_id: 1}, batchSize: 0}));
+assert.neq(0, res.cursor.id, res);
+assert.eq(0, res.cursor.firstBatch.length, res);
+assert.eq(1, new DBCommandCursor(db, res).itcount());
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,55 @@
+/*
+ * Tests that building several indexes at once, with their external sorters finalized on multiple
+ * threads and forced to spill, produces the same valid indexes as finalizing them serially.
+ */
+(function() {
+
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        // Spill to disk so that finalizing each sorter has to merge several ranges.
+        maxIndexBuildMemoryUsageMegabytes: 50,
+        logComponentVerbosity: tojson({index: 1}),
+    }
+});
+const testDB = conn.getDB(jsTestName());
+
+const numDocs = 20 * 1000;
+const bigStr = "x".repeat(1024);
+const specs = [{a: 1}, {b: -1}, {c: 1, a: 1}, {s: 1}, {arr: 1}];
+
+function populate(coll) {
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < numDocs; i++) {
+        bulk.insert({a: i, b: numDocs - i, c: i % 7, s: bigStr + i, arr: [i, -i]});
+    }
+    assert.commandWorked(bulk.execute());
+}
+
+function buildAndValidate(collName, numThreads) {
+    assert.commandWorked(
+        testDB.adminCommand({setParameter: 1, maxIndexBuildSorterThreads: numThreads}));
+
+    const coll = testDB.getCollection(collName);
+    populate(coll);
+    assert.commandWorked(coll.createIndexes(specs));
+
+    const res = assert.commandWorked(coll.validate({full: true}));
+    assert(res.valid, tojson(res));
+    for (let spec of specs) {
+        assert.eq(numDocs, coll.find().hint(spec).itcount(), tojson(spec));
+    }
+    return res;
+}
+
+const serial = buildAndValidate("serial", 1);
+const parallel = buildAndValidate("parallel", 4);
+
+// "Index build: finalizing external sorters".
+checkLog.containsJson(conn, 6000131, {numIndexes: specs.length, numThreads: 4});
+
+assert.eq(serial.keysPerIndex, parallel.keysPerIndex);
+
+MongoRunner.stopMongod(conn);
+})();
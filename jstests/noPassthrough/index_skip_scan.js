@@ -0,0 +1,53 @@
+/**
+ * Tests that when 'internalQueryPlannerEnableSkipScan' is set, a query which does not constrain
+ * the leading field of a compound index can scan it by skipping from one value of the leading
+ * field to the next, and that such plans are answered correctly from the plan cache.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getWinningPlan and getPlanStage.
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryPlannerEnableSkipScan: true}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+
+const coll = db.index_skip_scan;
+coll.drop();
+
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 10000; ++i) {
+    bulk.insert({_id: i, a: i % 5, b: i});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({a: 1, b: 1}));
+
+// An equality on the trailing field seeks once for each of the five values of 'a'.
+let explain = coll.find({b: 1234}).explain("executionStats");
+let ixscan = getPlanStage(getWinningPlan(explain.queryPlanner), "IXSCAN");
+assert.neq(null, ixscan, explain);
+assert.eq({a: 1, b: 1}, ixscan.keyPattern, explain);
+assert.eq(1, explain.executionStats.nReturned, explain);
+assert.lte(explain.executionStats.totalKeysExamined, 20, explain);
+
+// Ranges on the trailing field work the same way.
+explain = coll.find({b: {$gte: 100, $lt: 110}}).explain("executionStats");
+assert.neq(null, getPlanStage(getWinningPlan(explain.queryPlanner), "IXSCAN"), explain);
+assert.eq(10, explain.executionStats.nReturned, explain);
+assert.lte(explain.executionStats.totalKeysExamined, 30, explain);
+
+// Run the same query shape repeatedly so that it is answered from the plan cache, which must
+// rebuild the bounds from each query.
+for (let b of [10, 20, 30, 40, 50]) {
+    assert.eq([{_id: b}], coll.find({b: b}, {_id: 1}).toArray());
+}
+assert.eq([], coll.find({b: -1}).toArray());
+
+// Turning the parameter off falls back to a collection scan.
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryPlannerEnableSkipScan: false}));
+coll.getPlanCache().clear();
+explain = coll.find({b: 1234}).explain();
+assert(isCollscan(db, getWinningPlan(explain.queryPlanner)), explain);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,54 @@
+/**
+ * Tests that multi-document inserts that write each index's keys in key order leave the indexes
+ * consistent with the documents, including multikey state and unique index violations.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getWinningPlan and getPlanStage.
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {internalInsertIndexKeysInKeyOrderMinBatchSize: 10}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+
+const coll = db.insert_index_keys_in_key_order;
+coll.drop();
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+assert.commandWorked(coll.createIndex({u: 1}, {unique: true}));
+assert.commandWorked(coll.createIndex({"$**": 1}));
+assert.commandWorked(coll.createIndex({a: 1, p: 1}, {partialFilterExpression: {p: {$gt: 50}}}));
+
+// Insert documents whose key order differs from their insertion order.
+const kNumDocs = 100;
+let docs = [];
+for (let i = 0; i < kNumDocs; ++i) {
+    docs.push({_id: i, a: (i * 37) % kNumDocs, b: i % 7, u: kNumDocs - i, p: i});
+}
+// Only the 'b' values of the last document make the 'b' index multikey.
+docs[kNumDocs - 1].b = [1, 2];
+assert.commandWorked(coll.insert(docs));
+
+assert.eq(kNumDocs, coll.find({a: {$gte: 0}}).hint({a: 1}).itcount());
+assert.eq(kNumDocs, coll.find({u: {$gte: 0}}).hint({u: 1}).itcount());
+assert.eq(49, coll.find({a: {$gte: 0}, p: {$gt: 50}}).hint({a: 1, p: 1}).itcount());
+assert.eq(docs.filter(doc => doc.b === 2).length + 1, coll.find({b: 2}).hint({b: 1}).itcount());
+
+const explain = coll.find({b: 1}).hint({b: 1}).explain();
+const ixscan = getPlanStage(getWinningPlan(explain.queryPlanner), "IXSCAN");
+assert(ixscan.isMultiKey, explain);
+
+// A batch containing a duplicate key fails on that document only.
+docs = [];
+for (let i = kNumDocs; i < 2 * kNumDocs; ++i) {
+    docs.push({_id: i, a: i, b: i, u: i === kNumDocs + 20 ? 1 : i});
+}
+assert.writeErrorWithCode(coll.insert(docs, {ordered: false}), ErrorCodes.DuplicateKey);
+assert.eq(2 * kNumDocs - 1, coll.find().itcount());
+
+const validateRes = assert.commandWorked(coll.validate({full: true}));
+assert(validateRes.valid, validateRes);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,46 @@
+/**
+ * Tests that concurrent {j: true} writes are grouped into shared journal flushes and that the
+ * JournalFlusher reports its group commit statistics in serverStatus.
+ *
+ * @tags: [
+ *   requires_journaling,
+ *   requires_persistence,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/parallel_shell_helpers.js");
+
+const conn = MongoRunner.runMongod({setParameter: {journalGroupCommitMaxDelayMicros: 5000}});
+const db = conn.getDB(jsTestName());
+const coll = db.test;
+
+function runJournaledInserts(dbName, shellId) {
+    const coll = db.getSiblingDB(dbName).test;
+    for (let i = 0; i < 200; ++i) {
+        assert.commandWorked(coll.insert({shell: shellId, i: i}, {writeConcern: {j: true}}));
+    }
+}
+
+const shells = [];
+for (let i = 0; i < 4; ++i) {
+    shells.push(startParallelShell(funWithArgs(runJournaledInserts, db.getName(), i), conn.port));
+}
+shells.forEach((join) => join());
+assert.eq(800, coll.find().itcount());
+
+const stats = assert.commandWorked(db.adminCommand({serverStatus: 1})).journalFlusher;
+jsTestLog("JournalFlusher stats: " + tojson(stats));
+assert.gt(stats.avgFlushMicros, 0, tojson(stats));
+assert.gte(stats.waitMicros.ops, 800, tojson(stats));
+assert.gt(stats.batchSize.ops, 0, tojson(stats));
+// Only flushes that had at least one waiter are counted in the batch size histogram.
+assert.gte(stats.batchSize.sum, stats.batchSize.ops, tojson(stats));
+
+// Disabling grouping at runtime is honored.
+assert.commandWorked(db.adminCommand({setParameter: 1, journalGroupCommitMaxDelayMicros: 0}));
+assert.commandWorked(coll.insert({after: true}, {writeConcern: {j: true}}));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,41 @@
+/**
+ * Tests that with internalQueryJavaScriptReuseScopes enabled, aggregations using $function still
+ * return the right results, and that global variables set by one database's JavaScript are not
+ * visible to another database's.
+ * @tags: [requires_scripting]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryJavaScriptReuseScopes: true}});
+assert.neq(null, conn, "mongod was unable to start up");
+
+const dbA = conn.getDB("js_function_scope_reuse_a");
+const dbB = conn.getDB("js_function_scope_reuse_b");
+for (let db of [dbA, dbB]) {
+    assert.commandWorked(db.coll.insert([{_id: 0, x: 1}, {_id: 1, x: 2}]));
+}
+
+function runFunction(db, body) {
+    return db.coll
+        .aggregate([
+            {$sort: {_id: 1}},
+            {$project: {_id: 0, result: {$function: {body: body, args: ["$x"], lang: "js"}}}}
+        ])
+        .toArray()
+        .map(doc => doc.result);
+}
+
+for (let i = 0; i < 3; ++i) {
+    assert.eq([2, 4], runFunction(dbA, "function(x) { leakedGlobal = x; return 2 * x; }"));
+    assert.eq(["undefined", "undefined"],
+              runFunction(dbB, "function(x) { return typeof leakedGlobal; }"));
+}
+
+// The knob can be turned off at runtime.
+assert.commandWorked(
+    conn.adminCommand({setParameter: 1, internalQueryJavaScriptReuseScopes: false}));
+assert.eq([3, 6], runFunction(dbA, "function(x) { return 3 * x; }"));
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,60 @@
+/**
+ * Tests that $out builds the indexes of its temporary collection after writing all documents to it,
+ * that the indexes replicate, and that index constraints are still enforced.
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: 2});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const db = primary.getDB("test");
+const source = db.out_source;
+const target = db.out_target;
+
+const docs = [];
+for (let i = 0; i < 1000; i++) {
+    docs.push({_id: i, a: i, b: i % 10});
+}
+assert.commandWorked(source.insert(docs));
+assert.commandWorked(target.createIndex({a: 1}, {unique: true}));
+assert.commandWorked(target.createIndex({b: 1, a: -1}));
+
+function indexNames(coll) {
+    return coll.getIndexes().map(spec => spec.name).sort();
+}
+const expectedIndexes = indexNames(target);
+
+function runOut(buildIndexesAfterLoad) {
+    assert.commandWorked(db.adminCommand(
+        {setParameter: 1, internalQueryOutBuildIndexesAfterLoad: buildIndexesAfterLoad}));
+    source.aggregate([{$out: target.getName()}]);
+    assert.eq(1000, target.find().itcount());
+    assert.eq(expectedIndexes, indexNames(target));
+    assert.eq(10, target.find({b: 3}).hint({b: 1, a: -1}).itcount());
+}
+
+runOut(true);
+runOut(false);
+
+// The indexes of the temporary collection were built on the secondary too.
+rst.awaitReplication();
+const secondaryTarget = rst.getSecondary().getDB("test").out_target;
+assert.eq(1000, secondaryTarget.find().itcount());
+assert.eq(expectedIndexes, indexNames(secondaryTarget));
+
+// A unique index violation fails the $out, leaves the target alone and drops the temp collection.
+assert.commandWorked(db.adminCommand(
+    {setParameter: 1, internalQueryOutBuildIndexesAfterLoad: true}));
+assert.commandWorked(source.insert({_id: 1000, a: 0}));
+assert.commandFailedWithCode(
+    db.runCommand({aggregate: source.getName(), pipeline: [{$out: target.getName()}], cursor: {}}),
+    ErrorCodes.DuplicateKey);
+assert.eq(1000, target.find().itcount());
+assert.eq(0, db.getCollectionNames().filter(name => name.startsWith("tmp.agg_out")).length);
+
+rst.stopSet();
+}());
@@ -0,0 +1,88 @@
+/**
+ * Tests that an aggregation whose leading stages end in a $group runs those stages on several
+ * threads when internalQueryParallelAggregationThreads is greater than one, and that it returns the
+ * same results as running on a single thread.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        internalQueryParallelAggregationThreads: 4,
+        internalQueryParallelAggregationMinDocuments: 100,
+    }
+});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.parallel_local_aggregation;
+
+const kNumDocs = 2000;
+const docs = [];
+for (let i = 0; i < kNumDocs; i++) {
+    docs.push({_id: i, g: i % 7, x: i, s: "s" + i});
+}
+assert.commandWorked(coll.insert(docs));
+// Leave gaps in the RecordIds so that the range boundaries fall on deleted records.
+assert.commandWorked(coll.remove({_id: {$mod: [13, 0]}}));
+
+function setThreads(n) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryParallelAggregationThreads: n}));
+}
+
+function parallelAggregations() {
+    return db.serverStatus().metrics.query.parallelAggregations;
+}
+
+function runBoth(pipeline, expectParallel) {
+    setThreads(1);
+    const expected = coll.aggregate(pipeline).toArray();
+
+    setThreads(4);
+    const before = parallelAggregations();
+    const actual = coll.aggregate(pipeline).toArray();
+    assert.eq(before + (expectParallel ? 1 : 0), parallelAggregations(), tojson(pipeline));
+    assert.eq(expected, actual, tojson(pipeline));
+}
+
+runBoth([{$group: {_id: "$g", n: {$sum: 1}, total: {$sum: "$x"}}}, {$sort: {_id: 1}}], true);
+runBoth([{$group: {_id: null, avg: {$avg: "$x"}, lo: {$min: "$x"}, hi: {$max: "$x"}}}], true);
+runBoth(
+    [
+        {$match: {x: {$gte: 100}}},
+        {$project: {g: 1, x: 1}},
+        {$group: {_id: "$g", n: {$sum: 1}}},
+        {$sort: {_id: 1}}
+    ],
+    true);
+
+// Order-sensitive accumulators see the documents in collection scan order.
+runBoth([{$group: {_id: "$g", first: {$first: "$x"}, last: {$last: "$s"}}}, {$sort: {_id: 1}}],
+        true);
+
+// Pipelines with other stages before the $group, or an explain, run on a single thread.
+runBoth([{$sort: {x: -1}}, {$group: {_id: "$g", first: {$first: "$x"}}}, {$sort: {_id: 1}}],
+        false);
+runBoth([{$limit: 10}, {$group: {_id: null, n: {$sum: 1}}}], false);
+runBoth([{$match: {_id: {$lt: 10}}}, {$group: {_id: null, n: {$sum: 1}}}], false);
+let before = parallelAggregations();
+assert.commandWorked(coll.explain().aggregate([{$group: {_id: "$g"}}]));
+assert.eq(before, parallelAggregations());
+
+// A $match is left to the query planner when the collection has an index it could use.
+assert.commandWorked(coll.createIndex({x: 1}));
+runBoth([{$match: {x: {$gte: 100}}}, {$group: {_id: "$g", n: {$sum: 1}}}, {$sort: {_id: 1}}],
+        false);
+
+// Small collections are not worth splitting.
+const small = db.parallel_local_aggregation_small;
+assert.commandWorked(small.insert([{g: 1}, {g: 2}]));
+before = parallelAggregations();
+assert.eq(2, small.aggregate([{$group: {_id: "$g"}}]).itcount());
+assert.eq(before, parallelAggregations());
+
+// Results larger than one batch are returned through getMore.
+runBoth([{$group: {_id: "$x"}}, {$sort: {_id: 1}}], true);
+
+MongoRunner.stopMongod(conn);
+}());
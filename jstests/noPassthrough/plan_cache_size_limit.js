@@ -0,0 +1,77 @@
+/**
+ * Test that the plan cache of a collection is bounded by the estimated size of its entries, that
+ * frequently used entries survive a stream of query shapes which are only run once, and that the
+ * related serverStatus metrics are reported.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {internalQueryCacheMaxSizeBytesPerCollection: 64 * 1024}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.plan_cache_size_limit;
+coll.drop();
+
+for (let i = 0; i < 100; i++) {
+    assert.commandWorked(coll.insert({a: i, b: -1, c: 1}));
+}
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+
+function getPlanCacheMetrics() {
+    return assert.commandWorked(db.serverStatus()).metrics.query.planCache;
+}
+
+function getCachedQueryHashes() {
+    return coll.aggregate([{$planCacheStats: {}}]).toArray().map(entry => entry.queryHash);
+}
+
+function makeFilter(fieldName) {
+    return {a: {$gte: 99}, b: -1, [fieldName]: {$ne: 0}};
+}
+
+function runShape(fieldName) {
+    assert.eq(1, coll.find(makeFilter(fieldName)).itcount());
+}
+
+function queryHashOf(fieldName) {
+    return coll.find(makeFilter(fieldName)).explain().queryPlanner.queryHash;
+}
+
+const metricsBefore = getPlanCacheMetrics();
+
+// Make one query shape popular.
+for (let i = 0; i < 20; i++) {
+    runShape("hot");
+}
+const hotQueryHash = queryHashOf("hot");
+assert.contains(hotQueryHash, getCachedQueryHashes());
+
+// Run many more shapes than fit in the cache, once each.
+const kNumColdShapes = 200;
+for (let i = 0; i < kNumColdShapes; i++) {
+    runShape("cold" + i);
+}
+
+const cached = getCachedQueryHashes();
+assert.lt(cached.length, kNumColdShapes + 1, cached);
+assert.contains(hotQueryHash, cached);
+
+const metricsAfter = getPlanCacheMetrics();
+assert.gt(metricsAfter.evictions, metricsBefore.evictions, metricsAfter);
+
+// Running a shape whose entry was evicted again is reported as a miss caused by an eviction.
+const evictedShape = Array.from({length: kNumColdShapes}, (_, i) => "cold" + i)
+                         .find(fieldName => !cached.includes(queryHashOf(fieldName)));
+assert.neq(undefined, evictedShape);
+runShape(evictedShape);
+assert.gt(getPlanCacheMetrics().missesAfterEviction, metricsAfter.missesAfterEviction);
+
+// The size distribution accounts for every entry currently in the cache.
+const entrySizes = getPlanCacheMetrics().entrySizes;
+const numEntries = Object.values(entrySizes).reduce((total, count) => total + count, 0);
+assert.gte(numEntries, cached.length, entrySizes);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,50 @@
+/**
+ * Tests that the sharding connection pools of mongos establish connections to every member of a
+ * shard replica set as soon as the set is discovered when prewarming is enabled, and that
+ * connection acquisition wait times are reported by connPoolStats.
+ *
+ * @tags: [
+ *   requires_sharding,
+ *   sets_replica_set_matching_strategy,
+ * ]
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({
+    mongos: 1,
+    shards: 1,
+    rs: {nodes: 2},
+    mongosOptions: {
+        setParameter: {
+            ShardingTaskExecutorPoolPrewarmConnections: true,
+            ShardingTaskExecutorPoolReplicaSetMatching: "disabled",
+        },
+    },
+});
+const mongos = st.s;
+const secondary = st.rs0.getSecondary();
+
+// Without matching, nothing but prewarming brings up connections to the secondary, which is never
+// targeted by the commands below.
+assert.commandWorked(mongos.getDB("test").coll.insert({x: 1}));
+
+assert.soon(() => {
+    const stats = assert.commandWorked(mongos.adminCommand({connPoolStats: 1}));
+    const hostStats = stats.hosts[secondary.host];
+    jsTestLog("Connection stats for " + secondary.host + ": " + tojson(hostStats));
+    return hostStats && hostStats.available + hostStats.inUse > 0;
+}, "Connections to the secondary were not prewarmed");
+
+const stats = assert.commandWorked(mongos.adminCommand({connPoolStats: 1}));
+const primaryStats = stats.hosts[st.rs0.getPrimary().host];
+assert(primaryStats, tojson(stats));
+assert("acquisitionWaitTimes" in primaryStats, tojson(primaryStats));
+assert("0-1ms" in primaryStats.acquisitionWaitTimes, tojson(primaryStats));
+assert("1000ms+" in primaryStats.acquisitionWaitTimes, tojson(primaryStats));
+for (let pool of Object.values(stats.pools)) {
+    assert("acquisitionWaitTimes" in pool, tojson(pool));
+}
+
+st.stop();
+})();
@@ -17,6 +17,7 @@ const expectedParamDefaults = {
     internalQueryCacheMaxEntriesPerCollection: 5000,
     // This is a deprecated alias for "internalQueryCacheMaxEntriesPerCollection".
     internalQueryCacheSize: 5000,
+    internalQueryCacheMaxSizeBytesPerCollection: 32 * 1024 * 1024,
     internalQueryCacheEvictionRatio: 10.0,
     internalQueryCacheWorksGrowthCoefficient: 2.0,
     internalQueryCacheDisableInactiveEntries: false,
@@ -46,7 +47,8 @@ const expectedParamDefaults = {
     internalQueryPlannerGenerateCoveredWholeIndexScans: false,
     internalQueryIgnoreUnknownJSONSchemaKeywords: false,
     internalQueryProhibitBlockingMergeOnMongoS: false,
-    internalQuerySlotBasedExecutionMaxStaticIndexScanIntervals: 1000
+    internalQuerySlotBasedExecutionMaxStaticIndexScanIntervals: 1000,
+    internalQuerySlotBasedExecutionParallelScanDegree: 1
 };
 
 function assertDefaultParameterValues() {
@@ -100,6 +102,11 @@ assertSetParameterFails("internalQueryPlanEvaluationMaxResults", -1);
 assertSetParameterSucceeds("internalQueryCacheMaxEntriesPerCollection", 1);
 assertSetParameterSucceeds("internalQueryCacheMaxEntriesPerCollection", 0);
 assertSetParameterFails("internalQueryCacheMaxEntriesPerCollection", -1);
+
+assertSetParameterSucceeds("internalQueryCacheMaxSizeBytesPerCollection", 1);
+assertSetParameterSucceeds("internalQueryCacheMaxSizeBytesPerCollection", 0);
+assertSetParameterFails("internalQueryCacheMaxSizeBytesPerCollection", -1);
+
 // "internalQueryCacheSize" is a deprecated alias for "internalQueryCacheMaxEntriesPerCollection".
 assertSetParameterSucceeds("internalQueryCacheSize", 1);
 assertSetParameterSucceeds("internalQueryCacheSize", 0);
@@ -198,6 +205,10 @@ assertSetParameterSucceeds("internalQuerySlotBasedExecutionMaxStaticIndexScanInt
 assertSetParameterFails("internalQuerySlotBasedExecutionMaxStaticIndexScanIntervals", 0);
 assertSetParameterFails("internalQuerySlotBasedExecutionMaxStaticIndexScanIntervals", -1);
 
+assertSetParameterSucceeds("internalQuerySlotBasedExecutionParallelScanDegree", 8);
+assertSetParameterFails("internalQuerySlotBasedExecutionParallelScanDegree", 0);
+assertSetParameterFails("internalQuerySlotBasedExecutionParallelScanDegree", 129);
+
 assertSetParameterSucceeds("internalQueryEnableSlotBasedExecutionEngine", true);
 assertSetParameterSucceeds("internalQueryEnableSlotBasedExecutionEngine", false);
 
@@ -0,0 +1,79 @@
+/**
+ * Tests that find results on the namespaces listed in 'queryResultCacheNamespaces' are served from
+ * the query result cache, and that any write to such a namespace invalidates its results.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {queryResultCacheNamespaces: "test.cached"}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.cached;
+const uncachedColl = db.uncached;
+
+function getCacheStats() {
+    return assert.commandWorked(db.adminCommand({serverStatus: 1})).queryResultCache;
+}
+
+function findIds(collection, filter) {
+    return collection.find(filter).sort({_id: 1}).toArray().map(doc => doc._id);
+}
+
+assert.commandWorked(coll.insert([{_id: 1, a: 1}, {_id: 2, a: 1}, {_id: 3, a: 2}]));
+assert.commandWorked(uncachedColl.insert([{_id: 1, a: 1}]));
+
+// The first find populates the cache, the second is answered from it.
+let stats = getCacheStats();
+assert.eq([1, 2], findIds(coll, {a: 1}));
+assert.eq([1, 2], findIds(coll, {a: 1}));
+let newStats = getCacheStats();
+assert.eq(stats.misses + 1, newStats.misses, newStats);
+assert.eq(stats.hits + 1, newStats.hits, newStats);
+assert.eq(stats.inserts + 1, newStats.inserts, newStats);
+assert.eq(1, newStats.entries, newStats);
+
+// Results which do not fit in the first batch are not cached.
+stats = getCacheStats();
+assert.eq(3, coll.find().batchSize(1).itcount());
+assert.eq(stats.inserts, getCacheStats().inserts);
+
+// Finds on other namespaces do not use the cache.
+stats = getCacheStats();
+assert.eq([1], findIds(uncachedColl, {a: 1}));
+newStats = getCacheStats();
+assert.eq(stats.hits, newStats.hits, newStats);
+assert.eq(stats.misses, newStats.misses, newStats);
+
+// Each kind of write invalidates the results of the namespace.
+assert.commandWorked(coll.insert({_id: 4, a: 1}));
+assert.eq([1, 2, 4], findIds(coll, {a: 1}));
+assert.eq([1, 2, 4], findIds(coll, {a: 1}));
+
+assert.commandWorked(coll.update({_id: 4}, {$set: {a: 2}}));
+assert.eq([1, 2], findIds(coll, {a: 1}));
+assert.eq([1, 2], findIds(coll, {a: 1}));
+
+assert.commandWorked(coll.remove({_id: 2}));
+assert.eq([1], findIds(coll, {a: 1}));
+assert.eq([1], findIds(coll, {a: 1}));
+
+assert(coll.drop());
+assert.eq([], findIds(coll, {a: 1}));
+assert.gt(getCacheStats().invalidations, 0);
+
+assert.commandWorked(coll.insert([{_id: 1, a: 1}]));
+assert.eq([1], findIds(coll, {a: 1}));
+assert.eq([1], findIds(coll, {a: 1}));
+
+// Changing the list of namespaces clears the cache.
+assert.commandWorked(db.adminCommand({setParameter: 1, queryResultCacheNamespaces: ""}));
+assert.eq(0, getCacheStats().entries);
+stats = getCacheStats();
+assert.eq([1], findIds(coll, {a: 1}));
+assert.eq(stats.misses, getCacheStats().misses);
+
+assert.commandFailedWithCode(
+    db.adminCommand({setParameter: 1, queryResultCacheNamespaces: "test"}), ErrorCodes.BadValue);
+
+MongoRunner.stopMongod(conn);
+})();
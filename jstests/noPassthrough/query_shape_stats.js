@@ -0,0 +1,65 @@
+/**
+ * Tests that execution statistics are aggregated per query shape and are returned by the
+ * $queryShapeStats aggregation stage.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryShapeStatsMaxEntries: 2}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const adminDB = conn.getDB("admin");
+const coll = db.query_shape_stats;
+
+assert.commandWorked(coll.insert([{a: 1, b: 1}, {a: 2, b: 2}, {a: 3, b: 3}]));
+
+function getShapeStats() {
+    return adminDB.aggregate([{$queryShapeStats: {}}]).toArray();
+}
+
+function getQueryHash(filter) {
+    return coll.explain().find(filter).finish().queryPlanner.queryHash;
+}
+
+// Different constants in the same shape accumulate into a single entry.
+assert.eq(1, coll.find({a: 1}).itcount());
+assert.eq(1, coll.find({a: 2}).itcount());
+const findHash = getQueryHash({a: 1});
+
+let entries = getShapeStats().filter(entry => entry.queryHash === findHash);
+assert.eq(1, entries.length, getShapeStats());
+assert.eq(entries[0].ns, coll.getFullName(), entries);
+assert.eq(entries[0].command, "find", entries);
+assert.eq(entries[0].execCount, 2, entries);
+assert.eq(entries[0].docsExamined, 6, entries);
+assert.eq(entries[0].nreturned, 2, entries);
+assert.eq(entries[0].latencies.reads.ops, 2, entries);
+assert.gt(entries[0].latencies.reads.histogram.length, 0, entries);
+
+// Aggregations are recorded under the shape of the query pushed down to the find layer.
+assert.eq(1, coll.aggregate([{$match: {b: 1}}]).itcount());
+entries = getShapeStats();
+assert.eq(2, entries.length, entries);
+assert.eq("aggregate", entries[0].command, entries);
+
+// The least recently executed shape is evicted once the store is full.
+assert.eq(1, coll.find({a: 1, b: 1}).itcount());
+entries = getShapeStats();
+assert.eq(2, entries.length, entries);
+assert.eq(0, entries.filter(entry => entry.queryHash === findHash).length, entries);
+
+const totals = assert.commandWorked(adminDB.runCommand({serverStatus: 1})).queryShapeStats;
+assert.eq(2, totals.maxEntries, totals);
+assert.eq(2, totals.numEntries, totals);
+assert.eq(1, totals.numEvicted, totals);
+
+// The stage may only run as the first stage of a collectionless aggregate on 'admin'.
+assert.commandFailedWithCode(
+    db.runCommand({aggregate: 1, pipeline: [{$queryShapeStats: {}}], cursor: {}}),
+    ErrorCodes.InvalidNamespace);
+assert.commandFailedWithCode(
+    adminDB.runCommand({aggregate: 1, pipeline: [{$queryShapeStats: {foo: 1}}], cursor: {}}),
+    ErrorCodes.BadValue);
+
+MongoRunner.stopMongod(conn);
+}());
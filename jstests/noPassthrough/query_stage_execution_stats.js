@@ -0,0 +1,58 @@
+/**
+ * Tests that, with 'internalQueryCollectStageExecutionStats' enabled, explain reports per stage
+ * execution time in nanoseconds and the peak memory of blocking stages, and that the slow query
+ * log includes a per stage summary, for both the classic and the slot based execution engines.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {internalQueryCollectStageExecutionStats: true}, slowms: 0});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.query_stage_execution_stats;
+
+assert.commandWorked(coll.insert(Array.from({length: 100}, (_, i) => ({_id: i, a: i % 10}))));
+
+// Returns every stage of an explain executionStages tree, whichever field holds the children.
+function collectStages(stage) {
+    let stages = [stage];
+    for (let field in stage) {
+        const value = stage[field];
+        const children = Array.isArray(value) ? value : [value];
+        for (let child of children) {
+            if (child && typeof child === "object" && child.hasOwnProperty("stage")) {
+                stages = stages.concat(collectStages(child));
+            }
+        }
+    }
+    return stages;
+}
+
+for (let sbe of [false, true]) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryEnableSlotBasedExecutionEngine: sbe}));
+
+    const explain = assert.commandWorked(
+        coll.find({a: {$gte: 5}}).sort({a: -1}).explain("executionStats"));
+    const stages = collectStages(explain.executionStats.executionStages);
+    for (let stage of stages) {
+        assert(stage.hasOwnProperty("executionTimeNanos"), tojson(stage));
+        assert.gte(stage.executionTimeNanos, 0, tojson(stage));
+    }
+    if (!sbe) {
+        const sortStage = stages.find(stage => stage.stage === "SORT");
+        assert(sortStage, tojson(explain));
+        assert.gt(sortStage.peakTrackedMemBytes, 0, tojson(sortStage));
+    }
+
+    const comment = "query_stage_execution_stats_" + sbe;
+    assert.eq(50, coll.find({a: {$gte: 5}}).comment(comment).itcount());
+    checkLog.containsJson(conn, 51803, {
+        command: (cmd) => cmd && cmd.comment === comment,
+        stageStats: (summary) => /^[^:,]+:[0-9]+ns/.test(summary),
+    });
+}
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,86 @@
+/**
+ * Tests that SBE queries whose plan comes from the plan cache reuse the plan tree compiled for an
+ * identical query, and that a reused plan returns the same results as a newly built one.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/sbe_util.js");  // For checkSBEEnabled.
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+
+if (!checkSBEEnabled(db)) {
+    jsTestLog("Skipping test because SBE is disabled");
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+const coll = db.sbe_compiled_plan_cache;
+coll.drop();
+
+const bulk = coll.initializeOrderedBulkOp();
+for (let i = 0; i < 1000; ++i) {
+    bulk.insert({_id: i, a: i % 10, b: i % 7, c: i});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+
+function getCompiledPlanCacheMetrics() {
+    return db.serverStatus().metrics.query.sbeCompiledPlanCache;
+}
+
+function runQuery(a, b) {
+    return coll.find({a: a, b: b}, {_id: 0, c: 1}).sort({c: 1}).toArray().map(doc => doc.c);
+}
+
+function expectedResults(a, b) {
+    let results = [];
+    for (let i = 0; i < 1000; ++i) {
+        if (i % 10 === a && i % 7 === b) {
+            results.push(i);
+        }
+    }
+    return results;
+}
+
+// Run the query enough times for its plan cache entry to become active.
+for (let i = 0; i < 3; ++i) {
+    assert.eq(expectedResults(3, 4), runQuery(3, 4));
+}
+
+// Every further run uses the plan cache, and all but the first of them reuse the compiled plan.
+let before = getCompiledPlanCacheMetrics();
+for (let i = 0; i < 5; ++i) {
+    assert.eq(expectedResults(3, 4), runQuery(3, 4));
+}
+let after = getCompiledPlanCacheMetrics();
+assert.gte(after.hits - before.hits, 4, {before: before, after: after});
+
+// A query with the same shape but different literals must not reuse the compiled plan.
+before = getCompiledPlanCacheMetrics();
+assert.eq(expectedResults(5, 2), runQuery(5, 2));
+after = getCompiledPlanCacheMetrics();
+assert.eq(after.hits, before.hits, {before: before, after: after});
+assert.eq(expectedResults(5, 2), runQuery(5, 2));
+assert.eq(expectedResults(3, 4), runQuery(3, 4));
+
+// Builtin variables are bound anew when a compiled plan is reused.
+const nowQuery = {a: 3, b: 4, $expr: {$lt: ["$c", {$toLong: "$$NOW"}]}};
+for (let i = 0; i < 6; ++i) {
+    assert.eq(expectedResults(3, 4).length, coll.find(nowQuery).itcount());
+}
+
+// Dropping an index clears the plan cache, so that the compiled plans built against the old
+// indexes are not reused.
+assert.commandWorked(coll.dropIndex({b: 1}));
+for (let i = 0; i < 5; ++i) {
+    assert.eq(expectedResults(3, 4), runQuery(3, 4));
+}
+assert.commandWorked(coll.dropIndex({a: 1}));
+assert.eq(expectedResults(3, 4), runQuery(3, 4));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,66 @@
+/**
+ * Tests that a collection scan split across the producers of an SBE exchange returns the same
+ * documents as a single-threaded scan.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/sbe_util.js");  // For checkSBEEnabled.
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+
+if (!checkSBEEnabled(db)) {
+    jsTestLog("Skipping test because SBE is disabled");
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+const coll = db.sbe_parallel_collscan;
+coll.drop();
+
+// Insert enough documents for the scan to be split into several RecordId ranges.
+const nDocs = 50 * 1000;
+const bulk = coll.initializeOrderedBulkOp();
+for (let i = 0; i < nDocs; ++i) {
+    bulk.insert({_id: i, a: i % 13, b: "x".repeat(i % 7)});
+}
+assert.commandWorked(bulk.execute());
+
+function runQueries() {
+    return {
+        all: coll.find().toArray().map(doc => doc._id).sort((x, y) => x - y),
+        filtered: coll.find({a: {$lt: 4}}, {_id: 1}).itcount(),
+        grouped: coll.aggregate([{$group: {_id: "$a", n: {$sum: 1}}}, {$sort: {_id: 1}}])
+                     .toArray(),
+    };
+}
+
+const expected = runQueries();
+assert.eq(nDocs, expected.all.length);
+
+for (let degree of [2, 4, 16]) {
+    assert.commandWorked(db.adminCommand(
+        {setParameter: 1, internalQuerySlotBasedExecutionParallelScanDegree: degree}));
+    assert.eq(expected, runQueries(), "degree: " + degree);
+
+    // Scans which must preserve the natural order stay single-threaded.
+    assert.eq(expected.all, coll.find().sort({$natural: 1}).toArray().map(doc => doc._id));
+}
+
+// Producers yield their own locks. Yielding after every document does not change the results.
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryExecYieldIterations: 1}));
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQuerySlotBasedExecutionParallelScanDegree: 4}));
+assert.eq(expected, runQueries());
+
+// A query running a parallel scan still honours its time limit.
+assert.commandWorked(
+    db.adminCommand({configureFailPoint: "maxTimeAlwaysTimeOut", mode: "alwaysOn"}));
+assert.commandFailedWithCode(db.runCommand({find: coll.getName(), maxTimeMS: 60 * 1000}),
+                             ErrorCodes.MaxTimeMSExpired);
+assert.commandWorked(db.adminCommand({configureFailPoint: "maxTimeAlwaysTimeOut", mode: "off"}));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -49,6 +49,8 @@ const clearCollection = function() {
     expectedStats.numBucketsClosedDueToTimeForward = 0;
     expectedStats.numBucketsClosedDueToTimeBackward = 0;
     expectedStats.numBucketsClosedDueToMemoryThreshold = 0;
+    expectedStats.numBucketsArchived = 0;
+    expectedStats.numBucketsReopened = 0;
     expectedStats.numCommits = 0;
     expectedStats.numWaits = 0;
     expectedStats.numMeasurementsCommitted = 0;
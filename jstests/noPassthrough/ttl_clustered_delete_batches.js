@@ -0,0 +1,57 @@
+/**
+ * Tests that the TTL monitor deletes expired data from collections clustered by _id in contiguous
+ * ranges bounded by 'ttlClusteredDeleteBatchSpanSecs'.
+ *
+ * @tags: [
+ *   requires_fcv_51,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/core/timeseries/libs/timeseries.js");
+
+// Run TTL monitor constantly to speed up this test.
+const conn = MongoRunner.runMongod(
+    {setParameter: {ttlMonitorSleepSecs: 1, ttlClusteredDeleteBatchSpanSecs: 3600}});
+
+if (!TimeseriesTest.timeseriesCollectionsEnabled(conn)) {
+    jsTestLog("Skipping test because the time-series collection feature flag is disabled");
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+const testDB = conn.getDB(jsTestName());
+const coll = testDB.getCollection('ts');
+const bucketsColl = testDB.getCollection('system.buckets.' + coll.getName());
+
+const getTTLMetrics = () => testDB.serverStatus().metrics.ttl;
+
+// Stop the TTL monitor from deleting anything until all the data is in place.
+assert.commandWorked(testDB.adminCommand({setParameter: 1, ttlMonitorEnabled: false}));
+assert.commandWorked(testDB.createCollection(
+    coll.getName(), {timeseries: {timeField: 'time', metaField: 'host'}, expireAfterSeconds: 60}));
+
+// Each measurement is days apart from the others, so it lands in its own bucket and its own
+// delete range.
+const dayMillis = 24 * 60 * 60 * 1000;
+const now = new Date();
+for (const daysAgo of [10, 5, 2]) {
+    assert.commandWorked(
+        coll.insert({time: new Date(now.getTime() - daysAgo * dayMillis), host: 'localhost'}));
+}
+assert.commandWorked(coll.insert({time: now, host: 'localhost'}));
+assert.eq(4, bucketsColl.find().itcount());
+
+const batchesBefore = getTTLMetrics().clusteredDeleteBatches;
+assert.commandWorked(testDB.adminCommand({setParameter: 1, ttlMonitorEnabled: true}));
+
+// Only the bucket holding the current measurement survives.
+assert.soon(() => bucketsColl.find().itcount() === 1);
+assert.eq(1, coll.find().itcount());
+
+// Every expired bucket was deleted by a range of its own.
+assert.gte(getTTLMetrics().clusteredDeleteBatches, batchesBefore + 3, getTTLMetrics());
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,59 @@
+/**
+ * Tests that the in-memory key filters of unique and _id indexes never hide existing keys, are
+ * rebuilt when the node restarts, and report their statistics in $indexStats.
+ *
+ * @tags: [
+ *   requires_persistence,
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+"use strict";
+
+const options = {setParameter: {wiredTigerUniqueIndexKeyFilterSizeMB: 1}};
+let conn = MongoRunner.runMongod(options);
+let coll = conn.getDB(jsTestName()).test;
+
+assert.commandWorked(coll.createIndex({a: 1}, {unique: true}));
+assert.commandWorked(coll.insert([{_id: 0, a: 0}, {_id: 1, a: 1}]));
+
+function getKeyFilterStats(indexName) {
+    const stats = coll.aggregate([{$indexStats: {}}, {$match: {name: indexName}}]).toArray();
+    assert.eq(1, stats.length, tojson(stats));
+    assert(stats[0].hasOwnProperty("keyFilter"), tojson(stats[0]));
+    return stats[0].keyFilter;
+}
+
+function checkLookups() {
+    // Duplicates of existing keys are still rejected.
+    assert.commandFailedWithCode(coll.insert({_id: 2, a: 1}), ErrorCodes.DuplicateKey);
+    assert.commandFailedWithCode(coll.insert({_id: 1, a: 2}), ErrorCodes.DuplicateKey);
+
+    // Point lookups find existing keys and return nothing for missing ones.
+    assert.eq(1, coll.find({_id: 1}).itcount());
+    assert.eq(0, coll.find({_id: 1000}).itcount());
+
+    const filterStats = getKeyFilterStats("a_1");
+    assert(filterStats.usable, tojson(filterStats));
+    assert.gt(filterStats.lookups, 0, tojson(filterStats));
+    assert.gt(filterStats.negatives, 0, tojson(filterStats));
+    assert.gt(getKeyFilterStats("_id_").negatives, 0);
+}
+
+checkLookups();
+
+// Indexes without a key filter do not report one.
+assert.commandWorked(coll.createIndex({b: 1}));
+const stats = coll.aggregate([{$indexStats: {}}, {$match: {name: "b_1"}}]).toArray();
+assert.eq(1, stats.length, tojson(stats));
+assert(!stats[0].hasOwnProperty("keyFilter"), tojson(stats[0]));
+
+// The filters are rebuilt from the existing keys on startup.
+MongoRunner.stopMongod(conn);
+conn = MongoRunner.runMongod(Object.assign({restart: true, dbpath: conn.dbpath}, options));
+coll = conn.getDB(jsTestName()).test;
+assert.eq(2, getKeyFilterStats("a_1").keys);
+checkLookups();
+
+MongoRunner.stopMongod(conn);
+})();
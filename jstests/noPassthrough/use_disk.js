@@ -44,6 +44,7 @@ resetCollection();
 coll.aggregate([{$match: {a: {$gte: 2}}}, {$sort: {a: 1}}], {allowDiskUse: true});
 profileObj = getLatestProfilerEntry(testDB);
 assert(!profileObj.hasOwnProperty("usedDisk"), tojson(profileObj));
+assert(!profileObj.hasOwnProperty("spilledBytes"), tojson(profileObj));
 assert.eq(profileObj.hasSortStage, true, tojson(profileObj));
 
 assert.commandWorked(
@@ -53,6 +54,8 @@ assert.eq(
 profileObj = getLatestProfilerEntry(testDB);
 
 assert.eq(profileObj.usedDisk, true, tojson(profileObj));
+assert.gt(profileObj.spilledBytes, 0, tojson(profileObj));
+assert.gte(profileObj.spillTimeMicros, 0, tojson(profileObj));
 assert.eq(profileObj.hasSortStage, true, tojson(profileObj));
 
 //
@@ -0,0 +1,50 @@
+/**
+ * Tests that the hottest collections are recorded to the working set file while the server runs,
+ * and that they are read back on the next startup when prewarming is enabled.
+ * @tags: [requires_persistence]
+ */
+(function() {
+"use strict";
+
+let conn = MongoRunner.runMongod({setParameter: {workingSetRecordIntervalSecs: 1}});
+assert.neq(null, conn, "mongod was unable to start up");
+let db = conn.getDB("test");
+
+const docs = [];
+for (let i = 0; i < 1000; i++) {
+    docs.push({_id: i, a: i, pad: "x".repeat(100)});
+}
+assert.commandWorked(db.hot.insert(docs));
+assert.commandWorked(db.hot.createIndex({a: 1}));
+assert.commandWorked(db.cold.insert({_id: 0}));
+for (let i = 0; i < 20; i++) {
+    assert.eq(1, db.hot.find({a: i}).itcount());
+}
+
+// Wait for a recording that includes the queries above.
+const start = new Date();
+assert.soon(() => {
+    const status = db.serverStatus().workingSetPrewarm;
+    return status.lastRecorded && status.lastRecorded > start;
+}, () => tojson(db.serverStatus().workingSetPrewarm));
+MongoRunner.stopMongod(conn);
+
+conn = MongoRunner.runMongod({
+    dbpath: conn.dbpath,
+    noCleanData: true,
+    setParameter: {workingSetPrewarmOnStartup: true},
+});
+assert.neq(null, conn, "mongod was unable to restart");
+db = conn.getDB("test");
+
+let status;
+assert.soon(() => {
+    status = db.serverStatus().workingSetPrewarm;
+    return !status.inProgress && status.collectionsWarmed > 0;
+}, () => tojson(db.serverStatus().workingSetPrewarm));
+assert.eq(status.collectionsWarmed, status.collectionsTotal, status);
+assert.gt(status.bytesRead, 1000 * 100, status);
+assert.eq(1000, db.hot.find().itcount());
+
+MongoRunner.stopMongod(conn);
+}());
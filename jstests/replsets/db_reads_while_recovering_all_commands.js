@@ -52,6 +52,7 @@ const allCommands = {
     _configsvrReshardCollection: {skip: isPrimaryOnly},
     _configsvrSetAllowMigrations: {skip: isPrimaryOnly},
     _configsvrUpdateZoneKeyRange: {skip: isPrimaryOnly},
+    _configsvrWaitForRoutingChange: {skip: isPrimaryOnly},
     _flushDatabaseCacheUpdates: {skip: isPrimaryOnly},
     _flushDatabaseCacheUpdatesWithWriteConcern: {skip: isPrimaryOnly},
     _flushReshardingStateChange: {skip: isPrimaryOnly},
@@ -95,11 +96,17 @@ const allCommands = {
         expectFailure: true,
         expectedErrorCode: ErrorCodes.NotPrimaryOrSecondary,
     },
+    analyze: {
+        command: {analyze: collName, key: "x"},
+        expectFailure: true,
+        expectedErrorCode: ErrorCodes.NotPrimaryOrSecondary,
+    },
     appendOplogNote: {skip: isPrimaryOnly},
     applyOps: {skip: isPrimaryOnly},
     authenticate: {skip: isNotAUserDataRead},
     availableQueryOptions: {skip: isNotAUserDataRead},
     buildInfo: {skip: isNotAUserDataRead},
+    bulkWrite: {skip: isPrimaryOnly},
     captrunc: {skip: isPrimaryOnly},
     checkShardingIndex: {skip: isPrimaryOnly},
     cleanupOrphaned: {skip: isPrimaryOnly},
@@ -199,6 +199,37 @@ function concurrentTestConsistent() {
 simpleTestConsistent();
 concurrentTestConsistent();
 
+// A database-wide check of several collections at once is as consistent as a sequential one.
+function parallelTestConsistent() {
+    let primary = replSet.getPrimary();
+    let db = primary.getDB(dbName);
+    clearLog();
+
+    const parallelCollNames = ["dbcheck-parallel-a", "dbcheck-parallel-b", "dbcheck-parallel-c"];
+    parallelCollNames.forEach(name => addEnoughForMultipleBatches(db[name]));
+    replSet.awaitReplication();
+
+    assert.commandWorked(db.adminCommand({setParameter: 1, dbCheckCollectionConcurrency: 2}));
+    assert.commandWorked(db.runCommand({dbCheck: 1}));
+    awaitDbCheckCompletion(db);
+    assert.commandWorked(db.adminCommand({setParameter: 1, dbCheckCollectionConcurrency: 1}));
+
+    forEachNode(function(node) {
+        checkLogAllConsistent(node);
+        const nodeDb = node.getDB(dbName);
+        const totalDocs =
+            nodeDb.getCollectionNames().reduce((total, name) => total + nodeDb[name].count(), 0);
+        assert.eq(healthLogCounts(node.getDB("local").system.healthlog).totalDocs,
+                  totalDocs,
+                  "dbCheck batches do not count all documents");
+    });
+
+    parallelCollNames.forEach(name => db[name].drop());
+    clearLog();
+}
+
+parallelTestConsistent();
+
 // Test the various other parameters.
 function testDbCheckParameters() {
     let primary = replSet.getPrimary();
@@ -0,0 +1,29 @@
+/**
+ * Tests the values accepted by the 'initialSyncMethod' server parameter, and that a node asked for
+ * file copy based initial sync while it is not enabled falls back to logical initial sync.
+ */
+(function() {
+"use strict";
+
+// An unknown initial sync method is rejected at startup.
+assert.throws(() => MongoRunner.runMongod({setParameter: {initialSyncMethod: "fileCopy"}}));
+
+const rst = new ReplSetTest({nodes: 1});
+rst.startSet();
+rst.initiate();
+
+const primaryDb = rst.getPrimary().getDB("test");
+assert.commandWorked(primaryDb.coll.insert([{_id: 0}, {_id: 1}]));
+
+const secondary = rst.add({
+    rsConfig: {priority: 0, votes: 0},
+    setParameter: {initialSyncMethod: "fileCopyBased", featureFlagFileCopyBasedInitialSync: false}
+});
+rst.reInitiate();
+rst.awaitSecondaryNodes();
+
+checkLog.containsJson(secondary, 6000149, {initialSyncMethod: "fileCopyBased"});
+assert.eq(2, secondary.getDB("test").coll.find().itcount());
+
+rst.stopSet();
+}());
@@ -0,0 +1,41 @@
+/**
+ * Tests that replSetGetStatus reports the oplog fetching and application metrics of a secondary.
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: [{}, {rsConfig: {priority: 0}}]});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const secondary = rst.getSecondary();
+
+function getMetrics(node) {
+    const status = assert.commandWorked(node.adminCommand({replSetGetStatus: 1}));
+    assert(status.hasOwnProperty("oplogPipelineMetrics"), status);
+    return status.oplogPipelineMetrics;
+}
+
+const before = getMetrics(secondary);
+
+const kNumDocs = 100;
+const coll = primary.getDB("test").oplog_pipeline_metrics;
+for (let i = 0; i < kNumDocs; ++i) {
+    assert.commandWorked(coll.insert({_id: i, padding: "x".repeat(100)}));
+}
+rst.awaitReplication();
+
+const after = getMetrics(secondary);
+jsTestLog("Oplog pipeline metrics before: " + tojson(before) + ", after: " + tojson(after));
+
+assert.gt(after.numFetchedBatches, before.numFetchedBatches, after);
+assert.gte(after.numFetchedOps - before.numFetchedOps, kNumDocs, after);
+assert.gt(after.fetchedBytes, before.fetchedBytes + kNumDocs * 100, after);
+assert.gt(after.numAppliedBatches, before.numAppliedBatches, after);
+assert.gte(after.numAppliedOps - before.numAppliedOps, kNumDocs, after);
+assert.gte(after.applyMillis, before.applyMillis, after);
+assert.gte(after.numWaitsForBufferSpace, before.numWaitsForBufferSpace, after);
+
+rst.stopSet();
+}());
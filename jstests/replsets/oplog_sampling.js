@@ -6,9 +6,15 @@
 (function() {
 "use strict";
 
-// Force oplog sampling to occur on start up for small numbers of oplog inserts.
-const replSet = new ReplSetTest(
-    {nodes: 1, nodeOptions: {setParameter: {"maxOplogTruncationPointsDuringStartup": 10}}});
+// Force oplog sampling to occur on start up for small numbers of oplog inserts, rather than the
+// truncation points being loaded from the previous run.
+const replSet = new ReplSetTest({
+    nodes: 1,
+    nodeOptions: {
+        setParameter:
+            {"maxOplogTruncationPointsDuringStartup": 10, "persistOplogTruncationPoints": false}
+    }
+});
 replSet.startSet();
 replSet.initiate();
 
@@ -0,0 +1,36 @@
+/**
+ * Ensure that the oplog truncation points are persisted on clean shutdown and loaded on the next
+ * startup instead of being recomputed by scanning or sampling the oplog.
+ * @tags: [requires_wiredtiger, requires_persistence]
+ */
+(function() {
+"use strict";
+
+const replSet = new ReplSetTest({nodes: 1});
+replSet.startSet();
+replSet.initiate();
+
+function getOplogTruncationStatus() {
+    const res = assert.commandWorked(replSet.getPrimary().getDB("test").serverStatus());
+    return res.oplogTruncation;
+}
+
+// The oplog is created empty, so there is nothing to load.
+assert.eq(getOplogTruncationStatus().processingMethod, "scanning");
+
+const coll = replSet.getPrimary().getDB("test").getCollection("testcoll");
+for (let i = 0; i < 100; i++) {
+    assert.commandWorked(coll.insert({m: i}));
+}
+
+replSet.restart(0);
+let status = getOplogTruncationStatus();
+assert.eq(status.processingMethod, "persisted", tojson(status));
+
+// Without persistence, the truncation points are recomputed from the oplog.
+replSet.restart(0, {setParameter: {persistOplogTruncationPoints: false}});
+status = getOplogTruncationStatus();
+assert.eq(status.processingMethod, "scanning", tojson(status));
+
+replSet.stopSet();
+})();
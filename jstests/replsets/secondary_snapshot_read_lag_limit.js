@@ -0,0 +1,83 @@
+/**
+ * Tests that maxSecondarySnapshotReadLagSecs fails snapshot reads on a secondary whose read
+ * timestamp trails lastApplied by more than the limit, and that serverStatus counts them.
+ *
+ * @tags: [
+ *   requires_majority_read_concern,
+ *   requires_persistence,
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+"use strict";
+
+const kMaxLagSecs = 2;
+const replSet = new ReplSetTest({
+    nodes: [{}, {rsConfig: {priority: 0}}],
+    nodeOptions: {
+        setParameter: {
+            minSnapshotHistoryWindowInSeconds: 600,
+            maxSecondarySnapshotReadLagSecs: kMaxLagSecs
+        }
+    }
+});
+replSet.startSet();
+replSet.initiate();
+
+const primaryDB = replSet.getPrimary().getDB("test");
+const secondaryDB = replSet.getSecondary().getDB("test");
+const collName = "coll";
+
+function numReadsOverLagLimit() {
+    return assert.commandWorked(secondaryDB.adminCommand({serverStatus: 1}))
+        .metrics.snapshotReads.secondaryLagLimitExceeded;
+}
+
+function advanceLastAppliedPastLimit() {
+    sleep((kMaxLagSecs + 1) * 1000);
+    assert.commandWorked(primaryDB[collName].insert({_id: "advance"}, {writeConcern: {w: 2}}));
+    assert.commandWorked(primaryDB[collName].remove({_id: "advance"}, {writeConcern: {w: 2}}));
+}
+
+const res = assert.commandWorked(primaryDB.runCommand(
+    {insert: collName, documents: [{_id: 0}, {_id: 1}, {_id: 2}], writeConcern: {w: 2}}));
+const atClusterTime = res.operationTime;
+replSet.awaitLastOpCommitted();
+
+// A read at a recent timestamp is within the limit, and its cursor stays open.
+const cursorRes = assert.commandWorked(secondaryDB.runCommand({
+    find: collName,
+    batchSize: 1,
+    readConcern: {level: "snapshot", atClusterTime: atClusterTime}
+}));
+assert.eq(1, cursorRes.cursor.firstBatch.length);
+assert.eq(0, numReadsOverLagLimit());
+
+const history = assert.commandWorked(secondaryDB.adminCommand({serverStatus: 1}))
+                    .wiredTiger["snapshot-window-settings"];
+assert(history.hasOwnProperty("min pinned timestamp"), tojson(history));
+
+// Once lastApplied has moved past the limit, the next batch of the cursor and new reads at the
+// same timestamp fail.
+advanceLastAppliedPastLimit();
+assert.commandFailedWithCode(
+    secondaryDB.runCommand({getMore: cursorRes.cursor.id, collection: collName, batchSize: 1}),
+    ErrorCodes.SnapshotTooOld);
+assert.commandFailedWithCode(
+    secondaryDB.runCommand(
+        {find: collName, readConcern: {level: "snapshot", atClusterTime: atClusterTime}}),
+    ErrorCodes.SnapshotTooOld);
+assert.eq(2, numReadsOverLagLimit());
+
+// The primary does not apply the limit.
+assert.commandWorked(primaryDB.runCommand(
+    {find: collName, readConcern: {level: "snapshot", atClusterTime: atClusterTime}}));
+
+// Disabling the limit lets the read through again.
+assert.commandWorked(
+    secondaryDB.adminCommand({setParameter: 1, maxSecondarySnapshotReadLagSecs: 0}));
+assert.commandWorked(secondaryDB.runCommand(
+    {find: collName, readConcern: {level: "snapshot", atClusterTime: atClusterTime}}));
+
+replSet.stopSet();
+})();
@@ -501,6 +501,7 @@ const testCases = {
     _configsvrRemoveShard: {skip: isNotRunOnUserDatabase},
     _configsvrRemoveShardFromZone: {skip: isNotRunOnUserDatabase},
     _configsvrUpdateZoneKeyRange: {skip: isNotRunOnUserDatabase},
+    _configsvrWaitForRoutingChange: {skip: isNotRunOnUserDatabase},
     _flushDatabaseCacheUpdates: {skip: isNotRunOnUserDatabase},
     _flushDatabaseCacheUpdatesWithWriteConcern: {skip: isNotRunOnUserDatabase},
     _flushReshardingStateChange: {skip: isNotRunOnUserDatabase},
@@ -545,6 +546,7 @@ const testCases = {
             assert(!collectionExists(db, collName + "Out"));
         }
     },
+    analyze: {skip: isNotWriteCommand},
     appendOplogNote: {skip: isNotRunOnUserDatabase},
     applyOps: {skip: isNotSupportedInServerless},
     authenticate: {skip: isAuthCommand},
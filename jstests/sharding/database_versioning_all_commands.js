@@ -275,6 +275,14 @@ let testCases = {
     balancerStatus: {skip: "not on a user database"},
     balancerStop: {skip: "not on a user database"},
     buildInfo: {skip: "executes locally on mongos (not sent to any remote node)"},
+    bulkWrite: {
+        run: {
+            sendsDbVersion: true,
+            command: function(dbName, collName) {
+                return {bulkWrite: 1, ops: [{insert: collName, documents: [{_id: 1}]}]};
+            },
+        }
+    },
     cleanupReshardCollection: {skip: "always targets the config server"},
     clearJumboFlag: {skip: "does not forward command to primary shard"},
     clearLog: {skip: "executes locally on mongos (not sent to any remote node)"},
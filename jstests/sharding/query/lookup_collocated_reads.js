@@ -0,0 +1,103 @@
+/**
+ * Tests that with internalQueryEnableCollocatedSubPipelineReads, a shard runs $lookup
+ * sub-pipelines against its own data when the foreign collection is unsharded on this shard or is
+ * sharded with the same layout as the local collection, and that it still targets other shards
+ * once a migration has moved the data.
+ *
+ * @tags: [requires_fcv_51, featureFlagShardedLookup]
+ */
+
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // For arrayEq.
+load("jstests/libs/profiler.js");             // For profilerHas*OrThrow helper functions.
+
+const st = new ShardingTest({
+    shards: 2,
+    mongos: 1,
+    other: {shardOptions: {setParameter: {internalQueryEnableCollocatedSubPipelineReads: true}}}
+});
+const testName = "lookup_collocated_reads";
+
+const mongosDB = st.s0.getDB(testName);
+const shardList = [st.shard0.getDB(testName), st.shard1.getDB(testName)];
+
+assert.commandWorked(mongosDB.adminCommand({enableSharding: mongosDB.getName()}));
+st.ensurePrimaryShard(mongosDB.getName(), st.shard0.shardName);
+
+for (const shardDB of shardList) {
+    assert.commandWorked(shardDB.setProfilingLevel(2));
+}
+
+const ordersColl = mongosDB.orders;
+const reviewsColl = mongosDB.reviews;
+const customersColl = mongosDB.customers;
+
+// Shard the local and the foreign collection with the same key and chunk layout: customers before
+// "M" live on shard0, and the others on shard1.
+for (const coll of [ordersColl, reviewsColl]) {
+    st.shardColl(coll, {customer: 1}, {customer: "M"}, {customer: "M"}, mongosDB.getName());
+}
+
+assert.commandWorked(ordersColl.insert([
+    {_id: 0, customer: "Alice", item: "hat"},
+    {_id: 1, customer: "Barbara", item: "bowl"},
+    {_id: 2, customer: "Zoe", item: "shirt"},
+]));
+assert.commandWorked(reviewsColl.insert([
+    {_id: 0, customer: "Alice", stars: 5},
+    {_id: 1, customer: "Barbara", stars: 2},
+    {_id: 2, customer: "Zoe", stars: 4},
+    {_id: 3, customer: "Zoe", stars: 3},
+]));
+assert.commandWorked(customersColl.insert([
+    {_id: "Alice", city: "Lyon"},
+    {_id: "Barbara", city: "Oslo"},
+    {_id: "Zoe", city: "Lima"},
+]));
+
+function numSubPipelineCommands(shardDB, collName, comment) {
+    return shardDB.system.profile.find({"command.aggregate": collName, "command.comment": comment})
+        .itcount();
+}
+
+function runLookup(from, localField, foreignField, comment) {
+    return ordersColl
+        .aggregate(
+            [
+                {$lookup: {from: from, localField: localField, foreignField: foreignField, as: "j"}},
+                {$project: {_id: 1, n: {$size: "$j"}}}
+            ],
+            {comment: comment})
+        .toArray();
+}
+
+// Each order only joins reviews on its own shard, so no sub-pipeline is dispatched.
+let comment = "collocated_sharded_foreign";
+assert(arrayEq([{_id: 0, n: 1}, {_id: 1, n: 1}, {_id: 2, n: 2}],
+               runLookup("reviews", "customer", "customer", comment)));
+for (const shardDB of shardList) {
+    assert.eq(0, numSubPipelineCommands(shardDB, reviewsColl.getName(), comment));
+}
+
+// The unsharded foreign collection lives on the primary shard, so only shard1 dispatches its
+// sub-pipeline to shard0.
+comment = "unsharded_foreign";
+assert(arrayEq([{_id: 0, n: 1}, {_id: 1, n: 1}, {_id: 2, n: 1}],
+               runLookup("customers", "customer", "_id", comment)));
+assert.eq(1, numSubPipelineCommands(shardList[0], customersColl.getName(), comment));
+assert.eq(0, numSubPipelineCommands(shardList[1], customersColl.getName(), comment));
+
+// Once the reviews of "Zoe" have moved to shard0, the orders on shard1 no longer join local data
+// and their sub-pipelines are targeted at shard0 instead.
+assert.commandWorked(mongosDB.adminCommand(
+    {moveChunk: reviewsColl.getFullName(), find: {customer: "Zoe"}, to: st.shard0.shardName}));
+comment = "after_migration";
+assert(arrayEq([{_id: 0, n: 1}, {_id: 1, n: 1}, {_id: 2, n: 2}],
+               runLookup("reviews", "customer", "customer", comment)));
+assert.eq(1, numSubPipelineCommands(shardList[0], reviewsColl.getName(), comment));
+assert.eq(0, numSubPipelineCommands(shardList[1], reviewsColl.getName(), comment));
+
+st.stop();
+}());
@@ -34,6 +34,7 @@
 #include <benchmark/benchmark.h>
 
 #include "mongo/bson/bson_validate.h"
+#include "mongo/bson/bson_validate_old.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/logv2/log.h"
 
@@ -112,8 +113,84 @@ void BM_validate(benchmark::State& state) {
     state.SetBytesProcessed(totalSize);
 }
 
+// Validates a batch of state.range(0) flat documents with many short field names, as commonly
+// found in inserts, using either the current or the previous validator.
+template <Status (*validate)(const char*, uint64_t)>
+void validateFlatDocuments(benchmark::State& state) {
+    BSONArrayBuilder builder;
+    for (auto j = 0; j < state.range(0); j++) {
+        BSONObjBuilder doc(builder.subobjStart());
+        doc.append("_id", j);
+        for (auto field = 0; field < 20; field++)
+            doc.append(fmt::format("field{}", field), j * field);
+        doc.append("description", fmt::format("{:a<40s}", ""));
+    }
+    BSONObj array = builder.done();
+    invariant(validate(array.objdata(), array.objsize()).isOK());
+
+    size_t totalSize = 0;
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(validate(array.objdata(), array.objsize()));
+        totalSize += array.objsize();
+    }
+    state.SetBytesProcessed(totalSize);
+}
+
+void BM_validateFlat(benchmark::State& state) {
+    validateFlatDocuments<validateBSON>(state);
+}
+
+void BM_validateFlatOld(benchmark::State& state) {
+    validateFlatDocuments<fuzzerOnly::validateBSON>(state);
+}
+
+void BM_validateOld(benchmark::State& state) {
+    BSONArrayBuilder builder;
+    auto len = state.range(0);
+    size_t totalSize = 0;
+    for (auto j = 0; j < len; j++)
+        builder.append(buildSampleObj(j));
+    BSONObj array = builder.done();
+
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(fuzzerOnly::validateBSON(array.objdata(), array.objsize()));
+        totalSize += array.objsize();
+    }
+    state.SetBytesProcessed(totalSize);
+}
+
+// Builds a reply-sized object of state.range(0) bytes, starting from the default buffer size.
+void BM_bufBuilderDefaultSize(benchmark::State& state) {
+    const std::string value(state.range(0), 'x');
+    for (auto _ : state) {
+        BSONObjBuilder bob;
+        bob.append("value", value);
+        benchmark::DoNotOptimize(bob.done());
+    }
+}
+
+// Same as above but with the buffer sized from a BufBuilderSizeHint, as reply builders do.
+void BM_bufBuilderSizeHint(benchmark::State& state) {
+    const std::string value(state.range(0), 'x');
+    BufBuilderSizeHint hint;
+    for (auto _ : state) {
+        BufBuilder buf(hint.get());
+        BSONObjBuilder bob(buf);
+        bob.append("value", value);
+        benchmark::DoNotOptimize(bob.done());
+        hint.record(buf.len());
+    }
+}
+
 BENCHMARK(BM_arrayBuilder)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_arrayLookup)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_validate)->Ranges({{{1}, {1'000}}});
+BENCHMARK(BM_validateOld)->Ranges({{{1}, {1'000}}});
+BENCHMARK(BM_validateFlat)->Ranges({{{1}, {1'000}}});
+BENCHMARK(BM_validateFlatOld)->Ranges({{{1}, {1'000}}});
+BENCHMARK(BM_bufBuilderDefaultSize)->Range(256, 32 * 1024);
+BENCHMARK(BM_bufBuilderSizeHint)->Range(256, 32 * 1024);
 
 }  // namespace mongo
@@ -419,6 +419,24 @@ TEST(BSONValidateFast, ValidCodeWScope) {
     ASSERT_OK(validateBSON(obj.objdata(), obj.objsize()));
 }
 
+TEST(BSONValidateFast, FieldNamesOfAllLengths) {
+    // Field names are scanned a word at a time, so cover names ending at every offset within a
+    // word, both in the middle of an object and right before its end.
+    for (size_t nameLen = 1; nameLen <= 24; ++nameLen) {
+        const std::string name(nameLen, 'a');
+        for (auto obj : {BSON(name << 1 << "b" << 1), BSON("b" << 1 << name << BSONNULL)}) {
+            ASSERT_OK(validateBSON(obj.objdata(), obj.objsize()));
+
+            // Turning the NUL ending the name into a regular character runs the name into the
+            // next element, which must be rejected.
+            BSONObj copy = obj.copy();
+            auto writable = const_cast<char*>(copy[name].fieldName());
+            writable[nameLen] = 'x';
+            ASSERT_NOT_OK(validateBSON(copy.objdata(), copy.objsize()));
+        }
+    }
+}
+
 BSONObj nest(int nesting) {
     return nesting < 1 ? BSON("i" << nesting) : BSON("i" << nesting << "o" << nest(nesting - 1));
 }
@@ -27,4 +27,372 @@
  *    it in the license file.
  */
 
+
 #include "mongo/bson/util/bsoncolumn.h"
+
+#include "mongo/base/data_view.h"
+#include "mongo/bson/util/simple8b_type_util.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+constexpr uint8_t kCountMask = 0x0F;
+constexpr uint8_t kControlMask = 0xF0;
+constexpr uint8_t kNoScaleControl = 0x80;
+
+// Control bytes for the Simple-8b scale indexes, this must match the encoding in
+// BSONColumnBuilder.
+constexpr std::array<uint8_t, Simple8bTypeUtil::kMemoryAsInteger + 1> kControlByteForScaleIndex = {
+    0x90, 0xA0, 0xB0, 0xC0, 0xD0, 0x80};
+
+// Size of the type byte and the empty field name null terminator that precede the value of every
+// decompressed element.
+constexpr int kElementValueOffset = 2;
+
+int64_t expandDelta(int64_t prev, int64_t delta) {
+    // Do the addition as unsigned and cast back to signed to get overflow defined to wrapped around
+    // instead of undefined behavior.
+    return static_cast<int64_t>(static_cast<uint64_t>(prev) + static_cast<uint64_t>(delta));
+}
+
+int128_t expandDelta(int128_t prev, int128_t delta) {
+    return static_cast<int128_t>(static_cast<uint128_t>(prev) + static_cast<uint128_t>(delta));
+}
+
+bool isSimple8bControl(uint8_t control) {
+    auto bits = control & kControlMask;
+    return bits >= kNoScaleControl && bits <= kControlByteForScaleIndex[4];
+}
+
+uint8_t scaleIndexForControlByte(uint8_t control) {
+    auto bits = control & kControlMask;
+    for (uint8_t i = 0; i < kControlByteForScaleIndex.size(); ++i) {
+        if (kControlByteForScaleIndex[i] == bits) {
+            return i;
+        }
+    }
+    MONGO_UNREACHABLE;
+}
+
+bool usesDeltaOfDelta(BSONType type) {
+    return type == bsonTimestamp || type == Date;
+}
+}  // namespace
+
+char* BSONColumn::ElementStorage::allocate(int bytes) {
+    if (_pos + bytes > _capacity) {
+        _capacity = std::max(static_cast<int>(kBlockSize), bytes);
+        _blocks.push_back(std::make_unique<char[]>(_capacity));
+        _pos = 0;
+    }
+
+    char* ptr = _blocks.back().get() + _pos;
+    _pos += bytes;
+    return ptr;
+}
+
+BSONColumn::Iterator::Iterator(BSONColumn& column, const char* pos, const char* end)
+    : _column(&column), _control(pos), _end(end) {
+    _loadControl();
+}
+
+BSONColumn::Iterator& BSONColumn::Iterator::operator++() {
+    ++_index;
+
+    // Continue with the next value in the current Simple-8b blocks if there is one.
+    if (_it64) {
+        if (++(*_it64) != _decoder64->end()) {
+            _loadDelta();
+            return *this;
+        }
+        _it64 = boost::none;
+        _decoder64 = boost::none;
+    } else if (_it128) {
+        if (++(*_it128) != _decoder128->end()) {
+            _loadDelta128();
+            return *this;
+        }
+        _it128 = boost::none;
+        _decoder128 = boost::none;
+    }
+
+    if (!_nextControl) {
+        // Incrementing past the end is a no-op.
+        return *this;
+    }
+
+    _control = _nextControl;
+    _nextControl = nullptr;
+    _loadControl();
+    return *this;
+}
+
+bool BSONColumn::Iterator::operator==(const Iterator& rhs) const {
+    return _control == rhs._control && (_control == _end || _index == rhs._index);
+}
+
+bool BSONColumn::Iterator::operator!=(const Iterator& rhs) const {
+    return !operator==(rhs);
+}
+
+void BSONColumn::Iterator::_loadControl() {
+    uassert(6000100, "Invalid BSON Column encoding", _control < _end || *_control == EOO);
+
+    uint8_t control = *_control;
+    if (control == EOO) {
+        // Reached the end of the column, normalize the position so we compare equal to end().
+        _control = _end;
+        _current = BSONElement();
+        return;
+    }
+
+    if (!isSimple8bControl(control)) {
+        // Uncompressed literal. It is stored as a BSONElement with an empty field name which we
+        // can reference directly in the binary.
+        uassert(6000101,
+                "Invalid BSON Column encoding",
+                _control + kElementValueOffset <= _end && _control[1] == '\0');
+        BSONElement literal(_control, 1, -1, BSONElement::CachedSizeTag{});
+        uassert(6000110, "Invalid BSON Column encoding", _control + literal.size() <= _end);
+        _storeLastValue(literal);
+        _current = literal;
+        _nextControl = _control + literal.size();
+        return;
+    }
+
+    // Simple-8b blocks following the control byte.
+    uint8_t blocks = (control & kCountMask) + 1;
+    const char* data = _control + 1;
+    int size = blocks * sizeof(uint64_t);
+    uassert(6000102, "Invalid BSON Column encoding", data + size <= _end);
+    _nextControl = data + size;
+
+    _scaleIndex = scaleIndexForControlByte(control);
+    auto type = _lastValue.type();
+    if (type == NumberDouble) {
+        // The deltas in these blocks are expressed using the scale of this control byte, so
+        // re-encode the last value with it.
+        auto encoded = Simple8bTypeUtil::encodeDouble(_lastValue._numberDouble(), _scaleIndex);
+        uassert(6000103, "Invalid double encoding in BSON Column", encoded);
+        _lastEncodedValue64 = *encoded;
+    } else {
+        uassert(6000104,
+                "Invalid scale factor for non-double type in BSON Column",
+                _scaleIndex == Simple8bTypeUtil::kMemoryAsInteger);
+    }
+
+    if (type == NumberDecimal) {
+        _decoder128.emplace(data, size, _lastSimple8bValue128);
+        _it128 = _decoder128->begin();
+        if (*_it128 == _decoder128->end()) {
+            _it128 = boost::none;
+            _decoder128 = boost::none;
+            _control = _nextControl;
+            _nextControl = nullptr;
+            _loadControl();
+            return;
+        }
+        _loadDelta128();
+    } else {
+        _decoder64.emplace(data, size, _lastSimple8bValue64);
+        _it64 = _decoder64->begin();
+        if (*_it64 == _decoder64->end()) {
+            _it64 = boost::none;
+            _decoder64 = boost::none;
+            _control = _nextControl;
+            _nextControl = nullptr;
+            _loadControl();
+            return;
+        }
+        _loadDelta();
+    }
+}
+
+void BSONColumn::Iterator::_loadDelta() {
+    const auto& delta = **_it64;
+    _lastSimple8bValue64 = delta;
+
+    // Missing value
+    if (!delta) {
+        _current = BSONElement();
+        return;
+    }
+
+    auto type = _lastValue.type();
+    uassert(6000105, "Delta without a previous value in BSON Column", !_lastValue.eoo());
+
+    // A zero delta means the value is repeated, except for types using delta of delta where it
+    // means that the delta is repeated.
+    if (*delta == 0 && !usesDeltaOfDelta(type)) {
+        _current = _lastValue;
+        return;
+    }
+
+    char* value = nullptr;
+    int valueSize = 0;
+    switch (type) {
+        case NumberInt:
+            _lastEncodedValue64 =
+                expandDelta(_lastEncodedValue64, Simple8bTypeUtil::decodeInt64(*delta));
+            valueSize = sizeof(int32_t);
+            value = _allocateElement(type, valueSize);
+            DataView(value).write<LittleEndian<int32_t>>(_lastEncodedValue64);
+            break;
+        case NumberLong:
+            _lastEncodedValue64 =
+                expandDelta(_lastEncodedValue64, Simple8bTypeUtil::decodeInt64(*delta));
+            valueSize = sizeof(int64_t);
+            value = _allocateElement(type, valueSize);
+            DataView(value).write<LittleEndian<int64_t>>(_lastEncodedValue64);
+            break;
+        case NumberDouble:
+            _lastEncodedValue64 =
+                expandDelta(_lastEncodedValue64, Simple8bTypeUtil::decodeInt64(*delta));
+            valueSize = sizeof(double);
+            value = _allocateElement(type, valueSize);
+            DataView(value).write<LittleEndian<double>>(
+                Simple8bTypeUtil::decodeDouble(_lastEncodedValue64, _scaleIndex));
+            break;
+        case jstOID: {
+            _lastEncodedValue64 =
+                expandDelta(_lastEncodedValue64, Simple8bTypeUtil::decodeInt64(*delta));
+            valueSize = OID::kOIDSize;
+            value = _allocateElement(type, valueSize);
+            auto oid = Simple8bTypeUtil::decodeObjectId(_lastEncodedValue64,
+                                                        _lastValue.OID().getInstanceUnique());
+            std::memcpy(value, oid.view().view(), OID::kOIDSize);
+            break;
+        }
+        case bsonTimestamp:
+        case Date:
+            _lastEncodedValueForDeltaOfDelta = expandDelta(_lastEncodedValueForDeltaOfDelta,
+                                                           Simple8bTypeUtil::decodeInt64(*delta));
+            _lastEncodedValue64 = expandDelta(_lastEncodedValue64, _lastEncodedValueForDeltaOfDelta);
+            valueSize = sizeof(int64_t);
+            value = _allocateElement(type, valueSize);
+            DataView(value).write<LittleEndian<int64_t>>(_lastEncodedValue64);
+            break;
+        default:
+            uasserted(6000106, "Invalid delta for type in BSON Column");
+    }
+
+    _lastValue = _current = BSONElement(value - kElementValueOffset,
+                                        1,
+                                        valueSize + kElementValueOffset,
+                                        BSONElement::CachedSizeTag{});
+}
+
+void BSONColumn::Iterator::_loadDelta128() {
+    const auto& delta = **_it128;
+    _lastSimple8bValue128 = delta;
+
+    // Missing value
+    if (!delta) {
+        _current = BSONElement();
+        return;
+    }
+
+    uassert(6000107,
+            "Invalid delta for type in BSON Column",
+            _lastValue.type() == NumberDecimal);
+
+    if (*delta == 0) {
+        _current = _lastValue;
+        return;
+    }
+
+    _lastEncodedValue128 =
+        expandDelta(_lastEncodedValue128, Simple8bTypeUtil::decodeInt128(*delta));
+    Decimal128 dec = Simple8bTypeUtil::decodeDecimal128(_lastEncodedValue128);
+    char* value = _allocateElement(NumberDecimal, sizeof(Decimal128::Value));
+    Decimal128::Value dec128 = dec.getValue();
+    DataView(value).write<LittleEndian<uint64_t>>(dec128.low64);
+    DataView(value + sizeof(uint64_t)).write<LittleEndian<uint64_t>>(dec128.high64);
+
+    _lastValue = _current = BSONElement(value - kElementValueOffset,
+                                        1,
+                                        sizeof(Decimal128::Value) + kElementValueOffset,
+                                        BSONElement::CachedSizeTag{});
+}
+
+void BSONColumn::Iterator::_storeLastValue(BSONElement elem) {
+    _lastValue = elem;
+    _lastEncodedValueForDeltaOfDelta = 0;
+
+    switch (elem.type()) {
+        case NumberInt:
+            _lastEncodedValue64 = elem._numberInt();
+            break;
+        case NumberLong:
+            _lastEncodedValue64 = elem._numberLong();
+            break;
+        case jstOID:
+            _lastEncodedValue64 = Simple8bTypeUtil::encodeObjectId(elem.OID());
+            break;
+        case bsonTimestamp:
+            _lastEncodedValue64 = elem.timestamp().asULL();
+            break;
+        case Date:
+            _lastEncodedValue64 = elem.date().toMillisSinceEpoch();
+            break;
+        case NumberDecimal:
+            _lastEncodedValue128 = Simple8bTypeUtil::encodeDecimal128(elem._numberDecimal());
+            break;
+        default:
+            // Doubles are encoded when the scale factor is known, at the control byte. Other types
+            // only support zero deltas.
+            break;
+    }
+}
+
+char* BSONColumn::Iterator::_allocateElement(BSONType type, int valueSize) {
+    char* elem = _column->_elementStorage.allocate(valueSize + kElementValueOffset);
+    elem[0] = type;
+    elem[1] = '\0';
+    return elem + kElementValueOffset;
+}
+
+BSONColumn::BSONColumn(BSONElement bin) {
+    tassert(6000108,
+            "Invalid BSON type for column",
+            bin.type() == BSONType::BinData && bin.binDataType() == BinDataType::Column);
+
+    _binary = bin.binData(_size);
+    uassert(6000109, "Invalid BSON Column encoding", _size > 0 && _binary[_size - 1] == EOO);
+    _name = bin.fieldNameStringData();
+}
+
+BSONColumn::Iterator BSONColumn::begin() {
+    return {*this, _binary, _binary + _size - 1};
+}
+
+BSONColumn::Iterator BSONColumn::end() {
+    const char* end = _binary + _size - 1;
+    return {*this, end, end};
+}
+
+BSONElement BSONColumn::operator[](size_t index) {
+    _decompressAll();
+    if (index >= _decompressed.size()) {
+        return BSONElement();
+    }
+    return _decompressed[index];
+}
+
+size_t BSONColumn::size() {
+    _decompressAll();
+    return _decompressed.size();
+}
+
+void BSONColumn::_decompressAll() {
+    if (_fullyDecompressed) {
+        return;
+    }
+
+    for (auto it = begin(), e = end(); it != e; ++it) {
+        _decompressed.push_back(*it);
+    }
+    _fullyDecompressed = true;
+}
+
+}  // namespace mongo
@@ -27,4 +27,202 @@
  *    it in the license file.
  */
 
+
 #pragma once
+
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/util/simple8b.h"
+#include "mongo/platform/int128.h"
+
+#include <memory>
+#include <vector>
+
+namespace mongo {
+
+/**
+ * The BSONColumn class represents a reference to a BSONElement of BinDataType 7, which can
+ * efficiently store any BSONArray and also allows for missing values. At a high level, two
+ * optimizations are applied:
+ *   - implied field names: do not store decimal keys representing index keys.
+ *   - delta compression using Simple-8b: store difference between adjacent scalars of the same
+ *     type, and use bit packing to store these differences.
+ *
+ * The BSONColumn is decompressed lazily while iterating. Decompressed values are owned by the
+ * BSONColumn and remain valid for as long as the BSONColumn is in scope. BSONColumn is not
+ * thread-safe.
+ */
+class BSONColumn {
+public:
+    BSONColumn(BSONElement bin);
+    BSONColumn(const BSONColumn&) = delete;
+    BSONColumn& operator=(const BSONColumn&) = delete;
+
+    /**
+     * Forward iterator type to access BSONElement from BSONColumn.
+     *
+     * Default-constructed BSONElement (EOO type) represent missing value.
+     * Returned BSONElement are owned by BSONColumn instance and should not be kept after the
+     * BSONColumn instance goes out of scope.
+     */
+    class Iterator {
+    public:
+        friend class BSONColumn;
+
+        // typedefs expected in iterators
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = ptrdiff_t;
+        using value_type = BSONElement;
+        using pointer = const BSONElement*;
+        using reference = const BSONElement&;
+
+        reference operator*() const {
+            return _current;
+        }
+        pointer operator->() const {
+            return &_current;
+        }
+
+        // pre-increment operator
+        Iterator& operator++();
+
+        bool operator==(const Iterator& rhs) const;
+        bool operator!=(const Iterator& rhs) const;
+
+        /**
+         * Returns the position of the current value in the column.
+         */
+        size_t index() const {
+            return _index;
+        }
+
+    private:
+        Iterator(BSONColumn& column, const char* pos, const char* end);
+
+        // Loads the value at the current control position, either a literal or the first value of
+        // a series of Simple-8b blocks.
+        void _loadControl();
+
+        // Applies the delta at the current Simple-8b position to the last value.
+        void _loadDelta();
+        void _loadDelta128();
+
+        // Stores the last known value for delta calculations.
+        void _storeLastValue(BSONElement elem);
+
+        // Allocates storage for a decompressed element of 'type' with a value of 'valueSize' bytes
+        // and returns a pointer to where the value should be written.
+        char* _allocateElement(BSONType type, int valueSize);
+
+        // Column this iterator is decompressing.
+        BSONColumn* _column;
+
+        // Current control byte position and end of the binary (pointing at the EOO terminator).
+        const char* _control;
+        const char* _end;
+
+        // Position of the next control byte, after the current literal or the Simple-8b blocks
+        // belonging to the current control byte. Null when positioned at the end.
+        const char* _nextControl = nullptr;
+
+        // Current decompressed value, EOO if missing.
+        BSONElement _current;
+
+        // Last non-missing value, used as the base for deltas.
+        BSONElement _lastValue;
+
+        // Previous encoded value and delta, used to expand the next delta.
+        int64_t _lastEncodedValue64 = 0;
+        int64_t _lastEncodedValueForDeltaOfDelta = 0;
+        int128_t _lastEncodedValue128 = 0;
+
+        // Last Simple-8b value read, repeated by a RLE block at the start of the next control.
+        boost::optional<uint64_t> _lastSimple8bValue64 = 0;
+        boost::optional<uint128_t> _lastSimple8bValue128 = uint128_t(0);
+
+        // Scale index of the current control byte, used for doubles.
+        uint8_t _scaleIndex = 0;
+
+        // Simple-8b decoders for the blocks following the current control byte.
+        boost::optional<Simple8b<uint64_t>> _decoder64;
+        boost::optional<Simple8b<uint64_t>::Iterator> _it64;
+        boost::optional<Simple8b<uint128_t>> _decoder128;
+        boost::optional<Simple8b<uint128_t>::Iterator> _it128;
+
+        // Position of the current value in the column.
+        size_t _index = 0;
+    };
+
+    /**
+     * Forward iterator access.
+     *
+     * Iterator value is EOO when element is skipped.
+     *
+     * Iterators materialize compressed BSONElement as they iterate over the compressed binary.
+     * It is NOT safe to do this from multiple threads concurrently.
+     *
+     * Throws if invalid encoding is encountered.
+     */
+    Iterator begin();
+    Iterator end();
+
+    /**
+     * Element lookup by index
+     *
+     * Returns EOO if index represent skipped element or if index is out of bounds.
+     * O(1) time complexity if element has been previously accessed, O(N) otherwise.
+     *
+     * Throws if invalid encoding is encountered.
+     */
+    BSONElement operator[](size_t index);
+
+    /**
+     * Number of elements stored in this BSONColumn, including skipped elements.
+     *
+     * O(1) time complexity if the BSONColumn is fully decompressed (iteration reached end),
+     * O(N) otherwise.
+     *
+     * Throws if invalid encoding is encountered.
+     */
+    size_t size();
+
+    /**
+     * Field name that this BSONColumn represents.
+     *
+     * O(1) time complexity
+     */
+    StringData name() const {
+        return _name;
+    }
+
+private:
+    /**
+     * Simple bump allocator for decompressed elements. Memory is never released until the
+     * BSONColumn goes out of scope.
+     */
+    class ElementStorage {
+    public:
+        char* allocate(int bytes);
+
+    private:
+        static constexpr int kBlockSize = 4096;
+
+        std::vector<std::unique_ptr<char[]>> _blocks;
+        int _pos = 0;
+        int _capacity = 0;
+    };
+
+    // Decompresses the full column into '_decompressed' if not already done.
+    void _decompressAll();
+
+    const char* _binary;
+    int _size;
+    StringData _name;
+
+    ElementStorage _elementStorage;
+
+    // Fully decompressed column, only populated when random access or the size is requested.
+    std::vector<BSONElement> _decompressed;
+    bool _fullyDecompressed = false;
+};
+
+}  // namespace mongo
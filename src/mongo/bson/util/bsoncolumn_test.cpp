@@ -27,6 +27,7 @@
  *    it in the license file.
  */
 
+#include "mongo/bson/util/bsoncolumn.h"
 #include "mongo/bson/util/bsoncolumnbuilder.h"
 #include "mongo/bson/util/simple8b_type_util.h"
 
@@ -237,6 +238,39 @@ public:
         ASSERT_EQ(memcmp(columnBinary.data, buf, columnBinary.length), 0);
     }
 
+    static void verifyDecompression(const BufBuilder& columnBinary,
+                                    const std::vector<BSONElement>& expected) {
+        BSONObjBuilder obj;
+        obj.appendBinData(""_sd, columnBinary.len(), BinDataType::Column, columnBinary.buf());
+        BSONElement columnElement = obj.done().firstElement();
+
+        // Verify that we can traverse BSONColumn twice and extract values on the second pass
+        {
+            BSONColumn col(columnElement);
+            ASSERT_EQ(std::distance(col.begin(), col.end()), expected.size());
+
+            auto it = col.begin();
+            for (auto elem : expected) {
+                BSONElement other = *it;
+                ASSERT_EQ(elem.type(), other.type());
+                ASSERT(elem.binaryEqualValues(other));
+                ++it;
+            }
+            ASSERT(it == col.end());
+        }
+
+        // Verify that we can access elements by index and that the size is correct
+        {
+            BSONColumn col(columnElement);
+            for (size_t i = 0; i < expected.size(); ++i) {
+                ASSERT_EQ(expected[i].type(), col[i].type());
+                ASSERT(expected[i].binaryEqualValues(col[i]));
+            }
+            ASSERT_EQ(col.size(), expected.size());
+            ASSERT(col[expected.size()].eoo());
+        }
+    }
+
 private:
     std::forward_list<BSONObj> _elementMemory;
 };
@@ -255,6 +289,7 @@ TEST_F(BSONColumnTest, BasicValue) {
     appendEOO(expected);
 
     verifyBinary(cb.finalize(), expected);
+    verifyDecompression(expected, {elem, elem});
 }
 
 TEST_F(BSONColumnTest, BasicSkip) {
@@ -271,6 +306,7 @@ TEST_F(BSONColumnTest, BasicSkip) {
     appendEOO(expected);
 
     verifyBinary(cb.finalize(), expected);
+    verifyDecompression(expected, {elem, BSONElement()});
 }
 
 TEST_F(BSONColumnTest, OnlySkip) {
@@ -284,6 +320,7 @@ TEST_F(BSONColumnTest, OnlySkip) {
     appendEOO(expected);
 
     verifyBinary(cb.finalize(), expected);
+    verifyDecompression(expected, {BSONElement()});
 }
 
 TEST_F(BSONColumnTest, ValueAfterSkip) {
@@ -300,6 +337,7 @@ TEST_F(BSONColumnTest, ValueAfterSkip) {
     appendEOO(expected);
 
     verifyBinary(cb.finalize(), expected);
+    verifyDecompression(expected, {BSONElement(), elem});
 }
 
 
@@ -318,6 +356,7 @@ TEST_F(BSONColumnTest, LargeDeltaIsLiteral) {
     appendEOO(expected);
 
     verifyBinary(cb.finalize(), expected);
+    verifyDecompression(expected, {first, second});
 }
 
 TEST_F(BSONColumnTest, LargeDeltaIsLiteralAfterSimple8b) {
@@ -341,6 +380,7 @@ TEST_F(BSONColumnTest, LargeDeltaIsLiteralAfterSimple8b) {
     appendEOO(expected);
 
     verifyBinary(cb.finalize(), expected);
+    verifyDecompression(expected, {zero, zero, large, large});
 }
 
 TEST_F(BSONColumnTest, OverBlockCount) {
@@ -372,6 +412,7 @@ TEST_F(BSONColumnTest, OverBlockCount) {
     appendEOO(expected);
 
     verifyBinary(cb.finalize(), expected);
+    verifyDecompression(expected, elems);
 }
 
 TEST_F(BSONColumnTest, TypeChangeAfterLiteral) {
@@ -389,6 +430,7 @@ TEST_F(BSONColumnTest, TypeChangeAfterLiteral) {
     appendEOO(expected);
 
     verifyBinary(cb.finalize(), expected);
+    verifyDecompression(expected, {elemInt32, elemInt64});
 }
 
 TEST_F(BSONColumnTest, TypeChangeAfterSimple8b) {
@@ -409,6 +451,7 @@ TEST_F(BSONColumnTest, TypeChangeAfterSimple8b) {
     appendEOO(expected);
 
     verifyBinary(cb.finalize(), expected);
+    verifyDecompression(expected, {elemInt32, elemInt32, elemInt64});
 }
 
 TEST_F(BSONColumnTest, Simple8bAfterTypeChange) {
@@ -429,6 +472,7 @@ TEST_F(BSONColumnTest, Simple8bAfterTypeChange) {
     appendEOO(expected);
 
     verifyBinary(cb.finalize(), expected);
+    verifyDecompression(expected, {elemInt32, elemInt64, elemInt64});
 }
 
 TEST_F(BSONColumnTest, Decimal128Base) {
@@ -443,6 +487,7 @@ TEST_F(BSONColumnTest, Decimal128Base) {
     appendEOO(expected);
 
     verifyBinary(cb.finalize(), expected);
+    verifyDecompression(expected, {elemDec128});
 }
 
 TEST_F(BSONColumnTest, Decimal128Delta) {
@@ -460,6 +505,7 @@ TEST_F(BSONColumnTest, Decimal128Delta) {
     appendEOO(expected);
 
     verifyBinary(cb.finalize(), expected);
+    verifyDecompression(expected, {elemDec128, elemDec128});
 }
 
 TEST_F(BSONColumnTest, BasicDouble) {
@@ -477,6 +523,7 @@ TEST_F(BSONColumnTest, BasicDouble) {
     appendEOO(expected);
 
     verifyBinary(cb.finalize(), expected);
+    verifyDecompression(expected, {d1, d2});
 }
 
 TEST_F(BSONColumnTest, DoubleSameScale) {
@@ -499,6 +546,7 @@ TEST_F(BSONColumnTest, DoubleSameScale) {
     appendEOO(expected);
 
     verifyBinary(cb.finalize(), expected);
+    verifyDecompression(expected, elems);
 }
 
 TEST_F(BSONColumnTest, DoubleIncreaseScaleFromLiteral) {
@@ -516,6 +564,7 @@ TEST_F(BSONColumnTest, DoubleIncreaseScaleFromLiteral) {
     appendEOO(expected);
 
     verifyBinary(cb.finalize(), expected);
+    verifyDecompression(expected, {d1, d2});
 }
 
 TEST_F(BSONColumnTest, DoubleLiteralAndScaleAfterSkip) {
@@ -1107,6 +1156,7 @@ TEST_F(BSONColumnTest, LargeDeltaOfDeltaTimestamp) {
     appendEOO(expected);
 
     verifyBinary(cb.finalize(), expected);
+    verifyDecompression(expected, {first, second});
 }
 
 TEST_F(BSONColumnTest, LargeDeltaOfDeltaIsLiteralAfterSimple8bTimestamp) {
@@ -1136,6 +1186,53 @@ TEST_F(BSONColumnTest, LargeDeltaOfDeltaIsLiteralAfterSimple8bTimestamp) {
     appendEOO(expected);
 
     verifyBinary(cb.finalize(), expected);
+    verifyDecompression(expected, {zero, zero, large, large, semiLarge});
+}
+
+TEST_F(BSONColumnTest, NonNumericTypes) {
+    BSONColumnBuilder cb("test"_sd);
+
+    auto str = _createElement("a"_sd);
+    auto obj = _createElement(BSON("x" << 1));
+    cb.append(str);
+    cb.append(str);
+    cb.skip();
+    cb.append(obj);
+    cb.append(obj);
+
+    BufBuilder expected;
+    appendLiteral(expected, str);
+    appendSimple8bControl(expected, 0b1000, 0b0000);
+    appendSimple8bBlocks64(expected, {0, boost::none}, 1);
+    appendLiteral(expected, obj);
+    appendSimple8bControl(expected, 0b1000, 0b0000);
+    appendSimple8bBlock64(expected, 0);
+    appendEOO(expected);
+
+    verifyBinary(cb.finalize(), expected);
+    verifyDecompression(expected, {str, str, BSONElement(), obj, obj});
+}
+
+TEST_F(BSONColumnTest, InvalidEncoding) {
+    // The last byte of the literal must not be zero, or it would be read as the EOO terminator.
+    BufBuilder missingEOO;
+    appendLiteral(missingEOO, createElementInt32(-1));
+
+    BSONObjBuilder obj;
+    obj.appendBinData(""_sd, missingEOO.len(), BinDataType::Column, missingEOO.buf());
+    ASSERT_THROWS_CODE(BSONColumn(obj.done().firstElement()), DBException, 6000109);
+}
+
+TEST_F(BSONColumnTest, InvalidControlByte) {
+    BufBuilder invalid;
+    appendSimple8bControl(invalid, 0b1000, 0b0001);
+    appendSimple8bBlock64(invalid, 0);
+    appendEOO(invalid);
+
+    BSONObjBuilder obj;
+    obj.appendBinData(""_sd, invalid.len(), BinDataType::Column, invalid.buf());
+    BSONColumn col(obj.done().firstElement());
+    ASSERT_THROWS(col.size(), DBException);
 }
 
 }  // namespace
@@ -31,6 +31,7 @@
 
 #include "mongo/bson/util/simple8b_type_util.h"
 
+#include <algorithm>
 #include <memory>
 
 namespace mongo {
@@ -144,9 +145,18 @@ BSONColumnBuilder& BSONColumnBuilder::append(BSONElement elem) {
                     _prevDelta = currTimestampDelta;
                     break;
                 }
+                case Date: {
+                    int64_t currDateDelta = calcDelta(elem.date().toMillisSinceEpoch(),
+                                                      previous.date().toMillisSinceEpoch());
+                    value = calcDelta(currDateDelta, _prevDelta);
+                    _prevDelta = currDateDelta;
+                    break;
+                }
                 default:
-                    // Nothing else is implemented yet
-                    invariant(false);
+                    // Delta encoding is not implemented for this type, so differing values are
+                    // stored as uncompressed literals.
+                    encodingPossible = false;
+                    break;
             };
             if (encodingPossible) {
                 compressed = _simple8bBuilder64.append(Simple8bTypeUtil::encodeInt64(value));
@@ -182,6 +192,7 @@ boost::optional<Simple8bBuilder<uint64_t>> BSONColumnBuilder::_tryRescalePending
     // adding the new values then rescaling is less optimal than flushing with the current scale. So
     // we just record if this happens in our write callback.
     Simple8bBuilder<uint64_t> builder([&possible](uint64_t block) { possible = false; });
+    builder.setLastForRLE(_lastValueInPrevBlock64);
 
     // Iterate over our pending values, decode them back into double, rescale and append to our new
     // Simple8b builder
@@ -270,12 +281,14 @@ bool BSONColumnBuilder::_appendDouble(double value, double previous) {
         auto prevScale = _scaleIndex;
         std::tie(_prevEncoded, _scaleIndex) = scaleAndEncodeDouble(_lastValueInPrevBlock, 0);
 
-        // Create a new Simple8bBuilder.
+        // Create a new Simple8bBuilder continuing after the blocks that were just written.
         Simple8bBuilder<uint64_t> builder(_createBufferWriter());
+        builder.setLastForRLE(_lastValueInPrevBlock64);
         std::swap(_simple8bBuilder64, builder);
 
         // Iterate over previous pending values and re-add them recursively. That will increase the
-        // scale factor as needed.
+        // scale factor as needed. The pending values include the value we just appended so the
+        // recursive calls also set '_prevEncoded' using the new scale factor.
         auto prev = _lastValueInPrevBlock;
         auto prevEncoded = *Simple8bTypeUtil::encodeDouble(prev, prevScale);
         for (const auto& pending : builder) {
@@ -288,6 +301,7 @@ bool BSONColumnBuilder::_appendDouble(double value, double previous) {
                 _simple8bBuilder64.skip();
             }
         }
+        return true;
     }
 
     _prevEncoded = encoded;
@@ -301,8 +315,12 @@ BSONColumnBuilder& BSONColumnBuilder::skip() {
     } else {
         _simple8bBuilder64.skip();
     }
-    // Rescale previous known value if this skip caused Simple-8b blocks to be written
-    if (before != _bufBuilder.len() && _previous().type() == NumberDouble) {
+    // Rescale previous known value if this skip caused Simple-8b blocks to be written. This is only
+    // possible if no pending values are encoded with the current scale factor.
+    if (before != _bufBuilder.len() && _previous().type() == NumberDouble &&
+        std::none_of(_simple8bBuilder64.begin(),
+                     _simple8bBuilder64.end(),
+                     [](const auto& pending) { return pending.has_value(); })) {
         std::tie(_prevEncoded, _scaleIndex) = scaleAndEncodeDouble(_lastValueInPrevBlock, 0);
     }
     return *this;
@@ -344,7 +362,7 @@ void BSONColumnBuilder::_writeLiteralFromPrevious() {
     // appending next value.
     _bufBuilder.appendBuf(_prev.get(), _prevSize);
     _controlByteOffset = 0;
-    // There is no previous timestamp delta. Set to default.
+    // There is no previous timestamp or date delta. Set to default.
     _prevDelta = 0;
 
     // Set scale factor for this literal and values needed to append values
@@ -395,10 +413,27 @@ Simple8bWriteFn BSONColumnBuilder::_createBufferWriter() {
 
         // Write Simple-8b block in little endian byte order
         _bufBuilder.appendNum(block);
+        if (_storeWith128) {
+            return true;
+        }
 
-        auto previous = _previous();
-        if (previous.type() == NumberDouble) {
-            _lastValueInPrevBlock = previous._numberDouble();
+        // Decode the written block to know the last value it contains. Pending values may remain
+        // in the Simple8bBuilder so this is not necessarily the last appended value.
+        Simple8b<uint64_t> written(
+            _bufBuilder.buf() + _bufBuilder.len() - sizeof(uint64_t), sizeof(uint64_t),
+            _lastValueInPrevBlock64);
+        boost::optional<int64_t> encoded;
+        if (_previous().type() == NumberDouble) {
+            encoded = Simple8bTypeUtil::encodeDouble(_lastValueInPrevBlock, _scaleIndex);
+        }
+        for (const auto& value : written) {
+            _lastValueInPrevBlock64 = value;
+            if (value && encoded) {
+                encoded = expandDelta(*encoded, Simple8bTypeUtil::decodeInt64(*value));
+            }
+        }
+        if (encoded) {
+            _lastValueInPrevBlock = Simple8bTypeUtil::decodeDouble(*encoded, _scaleIndex);
         }
 
         return true;
@@ -406,7 +441,7 @@ Simple8bWriteFn BSONColumnBuilder::_createBufferWriter() {
 }
 
 bool BSONColumnBuilder::_usesDeltaOfDelta(BSONType type) {
-    return type == bsonTimestamp;
+    return type == bsonTimestamp || type == Date;
 }
 
 bool BSONColumnBuilder::_objectIdDeltaPossible(BSONElement elem, BSONElement prev) {
@@ -113,6 +113,9 @@ private:
     double _lastValueInPrevBlock = 0;
     uint8_t _scaleIndex;
 
+    // Last value in the last written 64bit Simple-8b block, repeated by a following RLE block.
+    boost::optional<uint64_t> _lastValueInPrevBlock64 = 0;
+
     // Buffer for the BSON Column binary
     BufBuilder _bufBuilder;
 
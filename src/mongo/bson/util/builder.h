@@ -487,6 +487,47 @@ public:
         return _buf.release();
     }
 };
+
+/**
+ * Remembers how large the buffers built for one purpose (for example, command replies) turn out
+ * to be, so that later builders can be created with that capacity up front instead of regrowing
+ * from BufBuilder::kDefaultInitSizeBytes. The hint is kept as a power of two to match the sizes
+ * grow() reallocates to. It rises as soon as a larger buffer is recorded and only halves after
+ * kShrinkAfter consecutive buffers that would have fit in half of it.
+ *
+ * Not thread-safe; callers are expected to keep one instance per thread.
+ */
+class BufBuilderSizeHint {
+public:
+    // Buffers larger than this are rare enough that reserving for them up front would waste
+    // more memory than the regrowth it avoids.
+    static constexpr size_t kMaxHintBytes = 64 * 1024;
+    static constexpr int kShrinkAfter = 16;
+
+    size_t get() const {
+        return _hint;
+    }
+
+    void record(size_t size) {
+        if (size > _hint) {
+            while (_hint < size && _hint < kMaxHintBytes)
+                _hint *= 2;
+            _smallerCount = 0;
+        } else if (size <= _hint / 2 && _hint > BufBuilder::kDefaultInitSizeBytes) {
+            if (++_smallerCount >= kShrinkAfter) {
+                _hint /= 2;
+                _smallerCount = 0;
+            }
+        } else {
+            _smallerCount = 0;
+        }
+    }
+
+private:
+    size_t _hint = BufBuilder::kDefaultInitSizeBytes;
+    int _smallerCount = 0;
+};
+
 class PooledFragmentBuilder : public BasicBufBuilder<SharedBufferFragmentAllocator> {
 public:
     PooledFragmentBuilder(SharedBufferFragmentBuilder& fragmentBuilder)
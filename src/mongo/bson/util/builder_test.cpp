@@ -124,4 +124,43 @@ TEST(Builder, AppendUnsignedLongLong) {
 TEST(Builder, AppendShort) {
     testStringBuilderIntegral<short>();
 }
+
+TEST(Builder, SizeHintGrowsToRecordedSize) {
+    BufBuilderSizeHint hint;
+    ASSERT_EQ(hint.get(), BufBuilder::kDefaultInitSizeBytes);
+
+    hint.record(3000);
+    ASSERT_EQ(hint.get(), 4096u);
+
+    // A buffer built with the hint does not need to regrow.
+    BufBuilder bb(hint.get());
+    bb.skip(3000);
+    ASSERT_EQ(bb.capacity(), 4096);
+
+    hint.record(BufBuilderSizeHint::kMaxHintBytes * 4);
+    ASSERT_EQ(hint.get(), BufBuilderSizeHint::kMaxHintBytes);
+}
+
+TEST(Builder, SizeHintShrinksAfterConsecutiveSmallerSizes) {
+    BufBuilderSizeHint hint;
+    hint.record(4096);
+
+    for (int i = 0; i < BufBuilderSizeHint::kShrinkAfter - 1; ++i)
+        hint.record(100);
+    ASSERT_EQ(hint.get(), 4096u);
+
+    // A size that still needs the current hint restarts the count.
+    hint.record(3000);
+    for (int i = 0; i < BufBuilderSizeHint::kShrinkAfter - 1; ++i)
+        hint.record(100);
+    ASSERT_EQ(hint.get(), 4096u);
+
+    hint.record(100);
+    ASSERT_EQ(hint.get(), 2048u);
+
+    // The hint never drops below the default initial size.
+    for (int i = 0; i < 10 * BufBuilderSizeHint::kShrinkAfter; ++i)
+        hint.record(1);
+    ASSERT_EQ(hint.get(), BufBuilder::kDefaultInitSizeBytes);
+}
 }  // namespace mongo
@@ -31,6 +31,7 @@
 
 #include "mongo/base/data_type_endian.h"
 #include "mongo/platform/bits.h"
+#include "mongo/util/assert_util.h"
 
 #include <algorithm>
 #include <array>
@@ -426,6 +427,10 @@ void Simple8bBuilder<T>::flush() {
             _writeFn(simple8bWord);
         } while (!_pendingValues.empty());
 
+        // Reset the selector state so subsequent appends start from an empty word.
+        isSelectorPossible = {true, true, true, true};
+        _lastValidExtensionType = kBaseSelector;
+
         // There are no more words in _pendingValues and RLE is possible.
         // However the _rleCount is 0 because we have not read any of the values in the next word.
         _rleCount = 0;
@@ -479,13 +484,15 @@ bool Simple8bBuilder<T>::_appendValue(T value, bool tryRle) {
                                         trailingZerosStoredInCountEightLarge};
 
     // Check if the amount of bits needed is more than we can store using all selector combinations.
-    // Check in order of most feasible to least feasible with or for efficiency. Add 3 to
-    // eightSelectors as they are using a nibble shift which can encode 3 more zeros in the actual
-    // value.
+    // Check in order of most feasible to least feasible with or for efficiency. The extended
+    // selectors need room for the trailing zero count next to the meaningful bits.
     if ((bitCountWithoutLeadingZeros > kMaxDataBits[kBaseSelector]) &&
-        (meaningfulValueBitsStoredWithSeven > kMaxDataBits[kSevenSelector]) &&
-        (meaningfulValueBitsStoredWithEightSmall > kMaxDataBits[kEightSelectorSmall]) &&
-        (meaningfulValueBitsStoredWithEightLarge > kMaxDataBits[kEightSelectorLarge]))
+        (meaningfulValueBitsStoredWithSeven + kTrailingZeroBitSize[kSevenSelector] >
+         kMaxDataBits[kSevenSelector]) &&
+        (meaningfulValueBitsStoredWithEightSmall + kTrailingZeroBitSize[kEightSelectorSmall] >
+         kMaxDataBits[kEightSelectorSmall]) &&
+        (meaningfulValueBitsStoredWithEightLarge + kTrailingZeroBitSize[kEightSelectorLarge] >
+         kMaxDataBits[kEightSelectorLarge]))
         return false;
 
 
@@ -717,8 +724,16 @@ void Simple8bBuilder<T>::setWriteCallback(Simple8bWriteFn writer) {
 }
 
 template <typename T>
-Simple8b<T>::Iterator::Iterator(const uint64_t* pos, const uint64_t* end)
-    : _pos(pos), _end(end), _value(0), _rleRemaining(0), _shift(0) {
+void Simple8bBuilder<T>::setLastForRLE(boost::optional<T> val) {
+    invariant(_pendingValues.empty() && _rleCount == 0);
+    _lastValueInPrevWord.val = val;
+}
+
+template <typename T>
+Simple8b<T>::Iterator::Iterator(const uint64_t* pos,
+                                const uint64_t* end,
+                                const boost::optional<T>& previous)
+    : _pos(pos), _end(end), _value(previous), _rleRemaining(0), _shift(0) {
     if (pos != end) {
         _loadBlock();
     }
@@ -839,18 +854,21 @@ bool Simple8b<T>::Iterator::operator!=(const Simple8b::Iterator& rhs) const {
 }
 
 template <typename T>
-Simple8b<T>::Simple8b(const char* buffer, int size) : _buffer(buffer), _size(size) {}
+Simple8b<T>::Simple8b(const char* buffer, int size, boost::optional<T> previous)
+    : _buffer(buffer), _size(size), _previous(previous) {}
 
 template <typename T>
 typename Simple8b<T>::Iterator Simple8b<T>::begin() const {
     return {reinterpret_cast<const uint64_t*>(_buffer),
-            reinterpret_cast<const uint64_t*>(_buffer + _size)};
+            reinterpret_cast<const uint64_t*>(_buffer + _size),
+            _previous};
 }
 
 template <typename T>
 typename Simple8b<T>::Iterator Simple8b<T>::end() const {
     return {reinterpret_cast<const uint64_t*>(_buffer + _size),
-            reinterpret_cast<const uint64_t*>(_buffer + _size)};
+            reinterpret_cast<const uint64_t*>(_buffer + _size),
+            _previous};
 }
 
 template class Simple8b<uint64_t>;
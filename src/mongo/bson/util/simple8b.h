@@ -127,6 +127,13 @@ public:
      */
     void setWriteCallback(Simple8bWriteFn writer);
 
+    /**
+     * Sets the value that a RLE block written as the first block by this builder would repeat. Used
+     * when a new builder continues a stream of Simple8b blocks written by another builder. Must be
+     * called before any value is appended.
+     */
+    void setLastForRLE(boost::optional<T> val);
+
 private:
     // Number of different type of selectors and their extensions available
     static constexpr uint8_t kNumOfSelectorTypes = 4;
@@ -322,7 +329,7 @@ public:
         bool operator!=(const Iterator& rhs) const;
 
     private:
-        Iterator(const uint64_t* pos, const uint64_t* end);
+        Iterator(const uint64_t* pos, const uint64_t* end, const boost::optional<T>& previous);
 
         /**
          * Loads the current Simple8b block into the iterator
@@ -375,8 +382,11 @@ public:
 
     /**
      * Does not take ownership of buffer, must remain valid during the lifetime of this class.
+     *
+     * 'previous' is the last value of the Simple8b block preceding this buffer. It is repeated by a
+     * RLE block at the start of the buffer.
      */
-    Simple8b(const char* buffer, int size);
+    Simple8b(const char* buffer, int size, boost::optional<T> previous = T{});
 
     /**
      * Forward iterators to read decompressed values
@@ -387,6 +397,7 @@ public:
 private:
     const char* _buffer;
     int _size;
+    boost::optional<T> _previous;
 };
 
 }  // namespace mongo
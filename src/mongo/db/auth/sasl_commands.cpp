@@ -52,7 +52,10 @@
 #include "mongo/db/server_options.h"
 #include "mongo/logv2/attribute_storage.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/util/base64.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/sequence_util.h"
 #include "mongo/util/str.h"
 
@@ -130,6 +133,45 @@ public:
     }
 } cmdSaslContinue;
 
+/**
+ * Admission control for SASL steps, bounded by 'saslMaxConcurrentSteps'. When many clients
+ * reconnect at once, for example after a failover, this lets a bounded number of handshakes run
+ * to completion instead of all of them competing for CPU and timing out together.
+ */
+class SaslStepAdmission {
+public:
+    /**
+     * Waits for a slot if a limit is configured. Returns whether a slot was taken, in which case
+     * release() must be called.
+     */
+    bool acquire(OperationContext* opCtx) {
+        if (gSaslMaxConcurrentSteps.load() <= 0) {
+            return false;
+        }
+
+        stdx::unique_lock<Latch> lk(_mutex);
+        opCtx->waitForConditionOrInterrupt(_cv, lk, [&] {
+            auto limit = gSaslMaxConcurrentSteps.load();
+            return limit <= 0 || _active < limit;
+        });
+        ++_active;
+        return true;
+    }
+
+    void release() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        --_active;
+        _cv.notify_one();
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("SaslStepAdmission::_mutex");
+    stdx::condition_variable _cv;
+    int _active = 0;
+};
+
+SaslStepAdmission saslStepAdmission;
+
 SaslReply doSaslStep(OperationContext* opCtx,
                      const SaslPayload& payload,
                      AuthenticationSession* session) {
@@ -138,7 +180,15 @@ SaslReply doSaslStep(OperationContext* opCtx,
     auto& mechanism = *mechanismPtr;
 
     // Passing in a payload and extracting a responsePayload
-    StatusWith<std::string> swResponse = mechanism.step(opCtx, payload.get());
+    StatusWith<std::string> swResponse = [&] {
+        const bool admitted = saslStepAdmission.acquire(opCtx);
+        ON_BLOCK_EXIT([&] {
+            if (admitted) {
+                saslStepAdmission.release();
+            }
+        });
+        return mechanism.step(opCtx, payload.get());
+    }();
 
     auto makeLogAttributes = [&]() {
         logv2::DynamicAttributes attrs;
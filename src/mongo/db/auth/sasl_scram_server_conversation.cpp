@@ -47,10 +47,19 @@
 #include "mongo/platform/random.h"
 #include "mongo/util/base64.h"
 #include "mongo/util/sequence_util.h"
+#include "mongo/util/static_immortal.h"
 #include "mongo/util/str.h"
+#include "mongo/util/synchronized_value.h"
 #include "mongo/util/text.h"
 
 namespace mongo {
+namespace {
+
+// Shared by all conversations. A SecureRandom refills a 4KB buffer from the system entropy source
+// on first use, which is wasted work when a fresh one is built for each 24-byte nonce.
+StaticImmortal<synchronized_value<SecureRandom>> nonceGen;
+
+}  // namespace
 
 template <typename Policy>
 StatusWith<std::tuple<bool, std::string>> SaslSCRAMServerMechanism<Policy>::stepImpl(
@@ -251,7 +260,7 @@ StatusWith<std::tuple<bool, std::string>> SaslSCRAMServerMechanism<Policy>::_fir
     const int nonceLenQWords = 3;
     uint64_t binaryNonce[nonceLenQWords];
 
-    SecureRandom().fill(binaryNonce, sizeof(binaryNonce));
+    (*nonceGen)->fill(binaryNonce, sizeof(binaryNonce));
 
     _nonce = clientNonce +
         base64::encode(StringData(reinterpret_cast<char*>(binaryNonce), sizeof(binaryNonce)));
@@ -251,11 +251,11 @@ public:
                 case UncommittedCatalogUpdates::Entry::Action::kWritable:
                     writeJobs.push_back(
                         [collection = std::move(entry.collection)](CollectionCatalog& catalog) {
-                            catalog._collections[collection->ns()] = collection;
-                            catalog._catalog[collection->uuid()] = collection;
+                            catalog._collections.insert_or_assign(collection->ns(), collection);
+                            catalog._catalog.insert_or_assign(collection->uuid(), collection);
                             auto dbIdPair = std::make_pair(collection->ns().db().toString(),
                                                            collection->uuid());
-                            catalog._orderedCollections[dbIdPair] = collection;
+                            catalog._orderedCollections.insert_or_assign(dbIdPair, collection);
                         });
                     break;
                 case UncommittedCatalogUpdates::Entry::Action::kRenamed:
@@ -575,8 +575,9 @@ void CollectionCatalog::onCloseCatalog(OperationContext* opCtx) {
     invariant(opCtx->lockState()->isW());
     invariant(!_shadowCatalog);
     _shadowCatalog.emplace();
-    for (auto& entry : _catalog)
-        _shadowCatalog->insert({entry.first, entry.second->ns()});
+    _catalog.forEach([&](const CollectionUUID& uuid, const std::shared_ptr<Collection>& coll) {
+        _shadowCatalog->insert({uuid, coll->ns()});
+    });
 }
 
 void CollectionCatalog::onOpenCatalog(OperationContext* opCtx) {
@@ -666,8 +667,8 @@ bool CollectionCatalog::isCollectionAwaitingVisibility(CollectionUUID uuid) cons
 }
 
 std::shared_ptr<Collection> CollectionCatalog::_lookupCollectionByUUID(CollectionUUID uuid) const {
-    auto foundIt = _catalog.find(uuid);
-    return foundIt == _catalog.end() ? nullptr : foundIt->second;
+    auto coll = _catalog.find(uuid);
+    return coll ? *coll : nullptr;
 }
 
 std::shared_ptr<const Collection> CollectionCatalog::lookupCollectionByNamespaceForRead(
@@ -676,8 +677,8 @@ std::shared_ptr<const Collection> CollectionCatalog::lookupCollectionByNamespace
         return coll;
     }
 
-    auto it = _collections.find(nss);
-    auto coll = (it == _collections.end() ? nullptr : it->second);
+    auto found = _collections.find(nss);
+    auto coll = found ? *found : nullptr;
     return (coll && coll->isCommitted()) ? coll : nullptr;
 }
 
@@ -707,8 +708,8 @@ Collection* CollectionCatalog::lookupCollectionByNamespaceForMetadataWrite(
         return nullptr;
     }
 
-    auto it = _collections.find(nss);
-    auto coll = (it == _collections.end() ? nullptr : it->second);
+    auto found = _collections.find(nss);
+    auto coll = found ? *found : nullptr;
 
     if (!coll || !coll->isCommitted())
         return nullptr;
@@ -744,8 +745,8 @@ CollectionPtr CollectionCatalog::lookupCollectionByNamespace(OperationContext* o
         return nullptr;
     }
 
-    auto it = _collections.find(nss);
-    auto coll = (it == _collections.end() ? nullptr : it->second);
+    auto found = _collections.find(nss);
+    auto coll = found ? *found : nullptr;
     return (coll && coll->isCommitted())
         ? CollectionPtr(opCtx, coll.get(), LookupCollectionForYieldRestore())
         : nullptr;
@@ -768,11 +769,10 @@ boost::optional<NamespaceString> CollectionCatalog::lookupNSSByUUID(OperationCon
         return coll->ns();
     }
 
-    auto foundIt = _catalog.find(uuid);
-    if (foundIt != _catalog.end()) {
-        boost::optional<NamespaceString> ns = foundIt->second->ns();
+    if (auto coll = _catalog.find(uuid)) {
+        boost::optional<NamespaceString> ns = (*coll)->ns();
         invariant(!ns.get().isEmpty());
-        return _collections.find(ns.get())->second->isCommitted() ? ns : boost::none;
+        return (*_collections.find(ns.get()))->isCommitted() ? ns : boost::none;
     }
 
     // Only in the case that the catalog is closed and a UUID is currently unknown, resolve it
@@ -802,10 +802,9 @@ boost::optional<CollectionUUID> CollectionCatalog::lookupUUIDByNSS(
         return boost::none;
     }
 
-    auto it = _collections.find(nss);
-    if (it != _collections.end()) {
-        boost::optional<CollectionUUID> uuid = it->second->uuid();
-        return it->second->isCommitted() ? uuid : boost::none;
+    if (auto coll = _collections.find(nss)) {
+        boost::optional<CollectionUUID> uuid = (*coll)->uuid();
+        return (*coll)->isCommitted() ? uuid : boost::none;
     }
     return boost::none;
 }
@@ -938,7 +937,7 @@ void CollectionCatalog::registerCollection(OperationContext* opCtx,
                 str::stream() << "View already exists. NS: " << ns,
                 !it->second.contains(ns));
     }
-    if (_collections.find(ns) != _collections.end()) {
+    if (_collections.contains(ns)) {
         auto& uncommittedCatalogUpdates = getUncommittedCatalogUpdates(opCtx);
         auto [found, uncommittedPtr] = uncommittedCatalogUpdates.lookup(ns);
         // If we have an uncommitted drop of this collection we can defer the creation, the register
@@ -966,12 +965,12 @@ void CollectionCatalog::registerCollection(OperationContext* opCtx,
     auto dbIdPair = std::make_pair(dbName, uuid);
 
     // Make sure no entry related to this uuid.
-    invariant(_catalog.find(uuid) == _catalog.end());
-    invariant(_orderedCollections.find(dbIdPair) == _orderedCollections.end());
+    invariant(!_catalog.contains(uuid));
+    invariant(!_orderedCollections.contains(dbIdPair));
 
-    _catalog[uuid] = coll;
-    _collections[ns] = coll;
-    _orderedCollections[dbIdPair] = coll;
+    _catalog.insert_or_assign(uuid, coll);
+    _collections.insert_or_assign(ns, coll);
+    _orderedCollections.insert_or_assign(dbIdPair, coll);
 
     if (!ns.isOnInternalDb() && !ns.isSystem()) {
         _stats.userCollections += 1;
@@ -993,9 +992,10 @@ void CollectionCatalog::registerCollection(OperationContext* opCtx,
 
 std::shared_ptr<Collection> CollectionCatalog::deregisterCollection(OperationContext* opCtx,
                                                                     CollectionUUID uuid) {
-    invariant(_catalog.find(uuid) != _catalog.end());
+    auto found = _catalog.find(uuid);
+    invariant(found);
 
-    auto coll = std::move(_catalog[uuid]);
+    auto coll = *found;
     auto ns = coll->ns();
     auto dbName = ns.db().toString();
     auto dbIdPair = std::make_pair(dbName, uuid);
@@ -1003,8 +1003,8 @@ std::shared_ptr<Collection> CollectionCatalog::deregisterCollection(OperationCon
     LOGV2_DEBUG(20281, 1, "Deregistering collection", "namespace"_attr = ns, "uuid"_attr = uuid);
 
     // Make sure collection object exists.
-    invariant(_collections.find(ns) != _collections.end());
-    invariant(_orderedCollections.find(dbIdPair) != _orderedCollections.end());
+    invariant(_collections.contains(ns));
+    invariant(_orderedCollections.contains(dbIdPair));
 
     _orderedCollections.erase(dbIdPair);
     _collections.erase(ns);
@@ -1031,17 +1031,13 @@ std::shared_ptr<Collection> CollectionCatalog::deregisterCollection(OperationCon
 
 void CollectionCatalog::deregisterAllCollectionsAndViews() {
     LOGV2(20282, "Deregistering all the collections");
-    for (auto& entry : _catalog) {
-        auto uuid = entry.first;
-        auto ns = entry.second->ns();
-        auto dbName = ns.db().toString();
-        auto dbIdPair = std::make_pair(dbName, uuid);
-
-        LOGV2_DEBUG(
-            20283, 1, "Deregistering collection", "namespace"_attr = ns, "uuid"_attr = uuid);
-
-        entry.second.reset();
-    }
+    _catalog.forEach([](const CollectionUUID& uuid, const std::shared_ptr<Collection>& coll) {
+        LOGV2_DEBUG(20283,
+                    1,
+                    "Deregistering collection",
+                    "namespace"_attr = coll->ns(),
+                    "uuid"_attr = uuid);
+    });
 
     _collections.clear();
     _orderedCollections.clear();
@@ -1094,11 +1090,11 @@ boost::optional<std::string> CollectionCatalog::lookupResourceName(const Resourc
     invariant(rid.getType() == RESOURCE_DATABASE || rid.getType() == RESOURCE_COLLECTION);
 
     auto search = _resourceInformation.find(rid);
-    if (search == _resourceInformation.end()) {
+    if (!search) {
         return boost::none;
     }
 
-    const std::set<std::string>& namespaces = search->second;
+    const std::set<std::string>& namespaces = *search;
 
     // When there are multiple namespaces mapped to the same ResourceId, return boost::none as the
     // ResourceId does not identify a single namespace.
@@ -1113,35 +1109,37 @@ void CollectionCatalog::removeResource(const ResourceId& rid, const std::string&
     invariant(rid.getType() == RESOURCE_DATABASE || rid.getType() == RESOURCE_COLLECTION);
 
     auto search = _resourceInformation.find(rid);
-    if (search == _resourceInformation.end()) {
+    if (!search || !search->count(entry)) {
         return;
     }
 
-    std::set<std::string>& namespaces = search->second;
-    namespaces.erase(entry);
-
     // Remove the map entry if this is the last namespace in the set for the ResourceId.
-    if (namespaces.size() == 0) {
-        _resourceInformation.erase(search);
+    if (search->size() == 1) {
+        _resourceInformation.erase(rid);
+        return;
     }
+
+    auto namespaces = *search;
+    namespaces.erase(entry);
+    _resourceInformation.insert_or_assign(rid, std::move(namespaces));
 }
 
 void CollectionCatalog::addResource(const ResourceId& rid, const std::string& entry) {
     invariant(rid.getType() == RESOURCE_DATABASE || rid.getType() == RESOURCE_COLLECTION);
 
     auto search = _resourceInformation.find(rid);
-    if (search == _resourceInformation.end()) {
-        std::set<std::string> newSet = {entry};
-        _resourceInformation.insert(std::make_pair(rid, newSet));
+    if (!search) {
+        _resourceInformation.insert_or_assign(rid, {entry});
         return;
     }
 
-    std::set<std::string>& namespaces = search->second;
-    if (namespaces.count(entry) > 0) {
+    if (search->count(entry) > 0) {
         return;
     }
 
+    auto namespaces = *search;
     namespaces.insert(entry);
+    _resourceInformation.insert_or_assign(rid, std::move(namespaces));
 }
 
 CollectionCatalogStasher::CollectionCatalogStasher(OperationContext* opCtx)
@@ -37,6 +37,7 @@
 #include "mongo/db/profile_filter.h"
 #include "mongo/db/service_context.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/util/structurally_shared_map.h"
 #include "mongo/util/uuid.h"
 
 namespace mongo {
@@ -75,8 +76,8 @@ public:
 
         iterator(OperationContext* opCtx, StringData dbName, const CollectionCatalog& catalog);
         iterator(OperationContext* opCtx,
-                 std::map<std::pair<std::string, CollectionUUID>,
-                          std::shared_ptr<Collection>>::const_iterator mapIter,
+                 StructurallySharedOrderedMap<std::pair<std::string, CollectionUUID>,
+                                              std::shared_ptr<Collection>>::const_iterator mapIter,
                  const CollectionCatalog& catalog);
         value_type operator*();
         iterator operator++();
@@ -98,8 +99,8 @@ public:
         OperationContext* _opCtx;
         std::string _dbName;
         boost::optional<CollectionUUID> _uuid;
-        std::map<std::pair<std::string, CollectionUUID>,
-                 std::shared_ptr<Collection>>::const_iterator _mapIter;
+        StructurallySharedOrderedMap<std::pair<std::string, CollectionUUID>,
+                                     std::shared_ptr<Collection>>::const_iterator _mapIter;
         const CollectionCatalog* _catalog;
     };
 
@@ -423,12 +424,16 @@ private:
         mongo::stdx::unordered_map<CollectionUUID, NamespaceString, CollectionUUID::Hash>>
         _shadowCatalog;
 
-    using CollectionCatalogMap =
-        stdx::unordered_map<CollectionUUID, std::shared_ptr<Collection>, CollectionUUID::Hash>;
+    // The maps below can hold an entry per collection. They share storage between copies of the
+    // catalog, so that the copy made for each catalog write only duplicates the parts it changes.
+    using CollectionCatalogMap = StructurallySharedHashMap<CollectionUUID,
+                                                           std::shared_ptr<Collection>,
+                                                           CollectionUUID::Hash>;
     using OrderedCollectionMap =
-        std::map<std::pair<std::string, CollectionUUID>, std::shared_ptr<Collection>>;
+        StructurallySharedOrderedMap<std::pair<std::string, CollectionUUID>,
+                                     std::shared_ptr<Collection>>;
     using NamespaceCollectionMap =
-        stdx::unordered_map<NamespaceString, std::shared_ptr<Collection>>;
+        StructurallySharedHashMap<NamespaceString, std::shared_ptr<Collection>>;
     using DatabaseProfileSettingsMap = StringMap<ProfileSettings>;
 
     CollectionCatalogMap _catalog;
@@ -451,7 +456,7 @@ private:
     uint64_t _epoch = 0;
 
     // Mapping from ResourceId to a set of strings that contains collection and database namespaces.
-    std::map<ResourceId, std::set<std::string>> _resourceInformation;
+    StructurallySharedHashMap<ResourceId, std::set<std::string>> _resourceInformation;
 
     /**
      * Contains non-default database profile settings. New collections, current collections and
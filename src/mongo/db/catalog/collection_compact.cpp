@@ -70,8 +70,8 @@ CollectionPtr getCollectionForCompact(OperationContext* opCtx,
 
 }  // namespace
 
-StatusWith<int64_t> compactCollection(OperationContext* opCtx,
-                                      const NamespaceString& collectionNss) {
+StatusWith<CompactStats> compactCollection(OperationContext* opCtx,
+                                           const NamespaceString& collectionNss) {
     AutoGetDb autoDb(opCtx, collectionNss.db(), MODE_IX);
     Database* database = autoDb.getDb();
     uassert(ErrorCodes::NamespaceNotFound, "database does not exist", database);
@@ -112,23 +112,48 @@ StatusWith<int64_t> compactCollection(OperationContext* opCtx,
     auto oldTotalSize = recordStore->storageSize(opCtx) + collection->getIndexSize(opCtx);
     auto indexCatalog = collection->getIndexCatalog();
 
-    Status status = recordStore->compact(opCtx);
+    CompactStats stats;
+    stats.bytesReclaimable = recordStore->freeStorageSize(opCtx);
+    {
+        std::unique_ptr<IndexCatalog::IndexIterator> it =
+            indexCatalog->getIndexIterator(opCtx, /*includeUnfinishedIndexes=*/false);
+        while (it->more()) {
+            stats.bytesReclaimable += it->next()->accessMethod()->getFreeStorageBytes(opCtx);
+        }
+    }
+
+    // A time slice that runs out leaves the collection partially compacted, which is not an error.
+    auto recordTimeSlice = [&](const Status& status) {
+        if (status == ErrorCodes::ExceededTimeLimit) {
+            LOGV2(5910902,
+                  "Compaction stopped at the end of its time slice",
+                  "namespace"_attr = collectionNss,
+                  "reason"_attr = status);
+            stats.complete = false;
+            return Status::OK();
+        }
+        return status;
+    };
+
+    Status status = recordTimeSlice(recordStore->compact(opCtx));
     if (!status.isOK())
         return status;
 
     // Compact all indexes (not including unfinished indexes)
-    status = indexCatalog->compactIndexes(opCtx);
+    status = recordTimeSlice(indexCatalog->compactIndexes(opCtx));
     if (!status.isOK())
         return status;
 
-    auto totalSizeDiff =
+    stats.bytesFreed =
         oldTotalSize - recordStore->storageSize(opCtx) - collection->getIndexSize(opCtx);
     LOGV2(20286,
           "compact {namespace} end, bytes freed: {freedBytes}",
           "Compact end",
           "namespace"_attr = collectionNss,
-          "freedBytes"_attr = totalSizeDiff);
-    return totalSizeDiff;
+          "freedBytes"_attr = stats.bytesFreed,
+          "reclaimableBytes"_attr = stats.bytesReclaimable,
+          "complete"_attr = stats.complete);
+    return stats;
 }
 
 }  // namespace mongo
@@ -34,13 +34,23 @@
 
 namespace mongo {
 
+struct CompactStats {
+    // The number of bytes of stable storage and index size that were freed. If the total size
+    // decreased, this is positive. Otherwise, it is negative.
+    int64_t bytesFreed = 0;
+
+    // The number of bytes the storage engine reported as reclaimable before compacting.
+    int64_t bytesReclaimable = 0;
+
+    // False if compaction of the collection or one of its indexes stopped at the end of its time
+    // slice. Compacting the collection again continues from where it left off.
+    bool complete = true;
+};
+
 /**
  * Compacts collection.
- *
- * Returns the number of bytes of stable storage and index size that were freed. If the total
- * size decreased, the return value is positive. Otherwise, the return value is negative.
  */
-StatusWith<int64_t> compactCollection(OperationContext* opCtx,
-                                      const NamespaceString& collectionNss);
+StatusWith<CompactStats> compactCollection(OperationContext* opCtx,
+                                           const NamespaceString& collectionNss);
 
 }  // namespace mongo
@@ -58,6 +58,7 @@
 #include "mongo/db/matcher/doc_validation_error.h"
 #include "mongo/db/matcher/expression_always_boolean.h"
 #include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/matchable.h"
 #include "mongo/db/op_observer.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/ops/update_request.h"
@@ -75,6 +76,7 @@
 #include "mongo/db/storage/durable_catalog.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/db/ttl_collection_cache.h"
 #include "mongo/db/update/update_driver.h"
@@ -83,6 +85,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/object_check.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -116,6 +119,10 @@ MONGO_FAIL_POINT_DEFINE(corruptDocumentOnInsert);
 
 MONGO_FAIL_POINT_DEFINE(skipCappedDeletes);
 
+// Documents with at least this many top-level fields are validated against an index of their
+// fields, so that each path in the validator does not have to scan the document.
+constexpr int kMinFieldsForIndexedValidation = 32;
+
 /**
  * Checks the 'failCollectionInserts' fail point at the beginning of an insert operation to see if
  * the insert should fail. Returns Status::OK if The function should proceed with the insertion.
@@ -282,7 +289,8 @@ CollectionImpl::SharedState::SharedState(CollectionImpl* collection,
       _recordStore(std::move(recordStore)),
       _cappedNotifier(_recordStore && options.capped ? std::make_shared<CappedInsertNotifier>()
                                                      : nullptr),
-      _needCappedLock(options.capped && collection->ns().db() != "local"),
+      _needCappedLock(options.capped && collection->ns().db() != "local" &&
+                      !gCappedCollectionConcurrentInserts),
       _isCapped(options.capped),
       _cappedMaxDocs(options.cappedMaxDocs) {
     if (_cappedNotifier) {
@@ -539,13 +547,27 @@ Status CollectionImpl::checkValidation(OperationContext* opCtx, const BSONObj& d
         return status;
     }
 
+    auto& validationStats = DocumentValidationStats::get(getSharedDecorations());
+    Timer validationTimer;
+
+    // Only a document which fails validation pays for generating the detailed error.
     try {
-        if (validatorMatchExpr->matchesBSON(document))
+        bool matches;
+        if (document.nFields() >= kMinFieldsForIndexedValidation) {
+            IndexedBSONMatchableDocument indexedDocument(document);
+            matches = validatorMatchExpr->matches(&indexedDocument);
+        } else {
+            matches = validatorMatchExpr->matchesBSON(document);
+        }
+        if (matches) {
+            validationStats.recordValidation(validationTimer.micros(), false /* failed */);
             return Status::OK();
+        }
     } catch (DBException&) {
     };
 
     BSONObj generatedError = doc_validation_error::generateError(*validatorMatchExpr, document);
+    validationStats.recordValidation(validationTimer.micros(), true /* failed */);
 
     if (validationActionOrDefault(_metadata->options.validationAction) ==
         ValidationActionEnum::warn) {
@@ -938,7 +960,16 @@ void CollectionImpl::_cappedDeleteAsNeeded(OperationContext* opCtx,
     } else {
         // Capped deletes not performed under the capped lock need the '_cappedFirstRecordMutex'
         // mutex.
-        cappedFirstRecordMutex.lock();
+        if (gCappedCollectionConcurrentInserts && _ns.db() != "local") {
+            // Inserts into this collection run concurrently. Leave the deletes to the insert
+            // already performing them rather than queueing up behind it: the collection may exceed
+            // its cap until the next insert, which then deletes the remaining excess.
+            if (!cappedFirstRecordMutex.try_lock()) {
+                return;
+            }
+        } else {
+            cappedFirstRecordMutex.lock();
+        }
     }
 
     boost::optional<CappedDeleteSideTxn> cappedDeleteSideTxn;
@@ -554,7 +554,8 @@ private:
 
         // For capped deletes performed on collections where '_needCappedLock' is false, the mutex
         // below protects '_cappedFirstRecord'. Otherwise, when '_needCappedLock' is true, the
-        // exclusive metadata resource protects '_cappedFirstRecord'.
+        // exclusive metadata resource protects '_cappedFirstRecord'. With
+        // 'cappedCollectionConcurrentInserts', inserts which find it locked skip their deletes.
         mutable Mutex _cappedFirstRecordMutex =
             MONGO_MAKE_LATCH("CollectionImpl::SharedState::_cappedFirstRecordMutex");
         RecordId _cappedFirstRecord;
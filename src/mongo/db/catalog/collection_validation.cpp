@@ -292,6 +292,13 @@ void _reportValidationResults(OperationContext* opCtx,
     output->append("nIndexes", static_cast<int>(validateState->getIndexes().size()));
     output->append("keysPerIndex", keysPerIndex.done());
     output->append("indexDetails", indexDetails.done());
+
+    // Tell the caller where to resume when an incremental validation did not reach the end of the
+    // record store.
+    if (const auto& nextResumeAfter = validateState->getNextResumeAfter();
+        !nextResumeAfter.isNull()) {
+        nextResumeAfter.serializeToken("nextResumeAfter", output);
+    }
 }
 
 void _reportInvalidResults(OperationContext* opCtx,
@@ -433,12 +440,13 @@ Status validate(OperationContext* opCtx,
                 RepairMode repairMode,
                 ValidateResults* results,
                 BSONObjBuilder* output,
-                bool turnOnExtraLoggingForTest) {
+                bool turnOnExtraLoggingForTest,
+                const boost::optional<ValidateRange>& range) {
     invariant(!opCtx->lockState()->isLocked() || storageGlobalParams.repair);
 
     // This is deliberately outside of the try-catch block, so that any errors thrown in the
     // constructor fail the cmd, as opposed to returning OK with valid:false.
-    ValidateState validateState(opCtx, nss, mode, repairMode, turnOnExtraLoggingForTest);
+    ValidateState validateState(opCtx, nss, mode, repairMode, turnOnExtraLoggingForTest, range);
 
     const auto replCoord = repl::ReplicationCoordinator::get(opCtx);
     // Check whether we are allowed to read from this node after acquiring our locks. If we are
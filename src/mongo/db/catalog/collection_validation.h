@@ -29,8 +29,11 @@
 
 #pragma once
 
+#include <limits>
+
 #include "mongo/db/catalog/validate_results.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/record_id.h"
 
 namespace mongo {
 
@@ -81,6 +84,21 @@ enum class RepairMode {
     kAdjustMultikey,
 };
 
+/**
+ * Restricts a validation run to a slice of the collection so that a large collection can be
+ * validated incrementally over several runs. The record store is traversed from the first record
+ * after 'resumeAfter', or from the beginning if it is null, for at most 'maxRecords' records. Only
+ * the index entries that point into the traversed slice are checked against it. When the slice ends
+ * before the end of the record store, the result contains a 'nextResumeAfter' token to start the
+ * next run from.
+ *
+ * A ValidateRange is incompatible with full validation and with any RepairMode other than kNone.
+ */
+struct ValidateRange {
+    RecordId resumeAfter;
+    long long maxRecords = std::numeric_limits<long long>::max();
+};
+
 /**
  * Expects the caller to hold no locks.
  *
@@ -98,7 +116,8 @@ Status validate(OperationContext* opCtx,
                 RepairMode repairMode,
                 ValidateResults* results,
                 BSONObjBuilder* output,
-                bool turnOnExtraLoggingForTest = false);
+                bool turnOnExtraLoggingForTest = false,
+                const boost::optional<ValidateRange>& range = boost::none);
 
 /**
  * Checks whether a failpoint has been hit in the above validate() code..
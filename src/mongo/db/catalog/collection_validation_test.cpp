@@ -316,5 +316,47 @@ TEST_F(BackgroundCollectionValidationTest, BackgroundValidateRunsConcurrentlyWit
                        0);
 }
 
+// Verify that incremental validation covers the collection in slices, each checked against the
+// index entries of its own records.
+TEST_F(CollectionValidationTest, ValidateIncrementally) {
+    auto opCtx = operationContext();
+    insertDataRange(opCtx, 0, 10);
+
+    CollectionValidation::ValidateRange range;
+    range.maxRecords = 4;
+
+    std::vector<int> sliceSizes;
+    while (true) {
+        ValidateResults validateResults;
+        BSONObjBuilder output;
+        ASSERT_OK(CollectionValidation::validate(opCtx,
+                                                 kNss,
+                                                 CollectionValidation::ValidateMode::kForeground,
+                                                 CollectionValidation::RepairMode::kNone,
+                                                 &validateResults,
+                                                 &output,
+                                                 /*turnOnExtraLoggingForTest=*/false,
+                                                 range));
+        ASSERT_TRUE(validateResults.valid);
+        ASSERT_EQ(validateResults.errors.size(), 0U);
+
+        BSONObj obj = output.obj();
+        sliceSizes.push_back(obj.getIntField("nrecords"));
+        if (!obj.hasField("nextResumeAfter")) {
+            break;
+        }
+        range.resumeAfter = RecordId::deserializeToken(obj["nextResumeAfter"]);
+    }
+
+    ASSERT_EQ(sliceSizes.size(), 3U);
+    ASSERT_EQ(sliceSizes[0], 4);
+    ASSERT_EQ(sliceSizes[1], 4);
+    ASSERT_EQ(sliceSizes[2], 2);
+
+    // The fast count is left untouched by a partial traversal.
+    AutoGetCollection coll(opCtx, kNss, MODE_IS);
+    ASSERT_EQ(coll->numRecords(opCtx), 10);
+}
+
 }  // namespace
 }  // namespace mongo
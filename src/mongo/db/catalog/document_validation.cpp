@@ -31,7 +31,26 @@
 
 #include "mongo/db/catalog/document_validation.h"
 
+#include "mongo/db/catalog/collection.h"
+
 namespace mongo {
+namespace {
+
+const auto getDocumentValidationStats =
+    SharedCollectionDecorations::declareDecoration<DocumentValidationStats>();
+
+}  // namespace
+
 const OperationContext::Decoration<DocumentValidationSettings> DocumentValidationSettings::get =
     OperationContext::declareDecoration<DocumentValidationSettings>();
+
+DocumentValidationStats& DocumentValidationStats::get(SharedCollectionDecorations* decorations) {
+    return getDocumentValidationStats(decorations);
+}
+
+void DocumentValidationStats::append(BSONObjBuilder* builder) const {
+    builder->append("validations", _validations.load());
+    builder->append("failures", _failures.load());
+    builder->append("validationMicros", _validationMicros.load());
+}
 }  // namespace mongo
@@ -31,6 +31,7 @@
 
 #include "mongo/base/string_data.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 
@@ -100,6 +101,33 @@ private:
     Flags _flags = kEnableValidation;
 };
 
+class SharedCollectionDecorations;
+
+/**
+ * Counts the documents checked against a collection's validator and the time spent doing so. It
+ * decorates the object that all Collection instances for the same collection hold in shared
+ * ownership, so the counts survive catalog updates to the collection. Reported by collStats.
+ */
+class DocumentValidationStats {
+public:
+    static DocumentValidationStats& get(SharedCollectionDecorations* decorations);
+
+    void recordValidation(long long micros, bool failed) {
+        _validations.fetchAndAddRelaxed(1);
+        _validationMicros.fetchAndAddRelaxed(micros);
+        if (failed) {
+            _failures.fetchAndAddRelaxed(1);
+        }
+    }
+
+    void append(BSONObjBuilder* builder) const;
+
+private:
+    AtomicWord<long long> _validations{0};
+    AtomicWord<long long> _failures{0};
+    AtomicWord<long long> _validationMicros{0};
+};
+
 /**
  * Disables document validation on a single OperationContext while in scope.
  * Resets to original value when leaving scope so they are safe to nest.
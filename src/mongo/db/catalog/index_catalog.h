@@ -477,7 +477,9 @@ public:
 
     /*
      * Attempt compaction on all ready indexes to regain disk space, if the storage engine's index
-     * supports compaction in-place.
+     * supports compaction in-place. Indexes are compacted in decreasing order of their reclaimable
+     * bytes. If compaction of an index stops at the end of its time slice, the remaining indexes
+     * are still compacted and ExceededTimeLimit is returned.
      */
     virtual Status compactIndexes(OperationContext* opCtx) const = 0;
 
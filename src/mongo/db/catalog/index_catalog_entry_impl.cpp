@@ -208,6 +208,13 @@ void IndexCatalogEntryImpl::setMultikey(OperationContext* opCtx,
 
     MultikeyPaths paths = indexTracksMultikeyPathsInCatalog ? multikeyPaths : MultikeyPaths{};
 
+    // Planners may cache the multikey paths recorded by metadata keys, so let them know of the new
+    // paths before the keys that record them can become visible.
+    if (!multikeyMetadataKeys.empty()) {
+        CollectionQueryInfo::get(collection)
+            .noteWildcardMultikeyMetadataKeys(*this, multikeyMetadataKeys);
+    }
+
     // On a primary, we can simply assign this write the same timestamp as the index creation,
     // insert, or update that caused this index to become multikey. This is because if two
     // operations concurrently try to change the index to be multikey, they will conflict and the
@@ -33,6 +33,7 @@
 
 #include "mongo/db/catalog/index_catalog_impl.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/base/init.h"
@@ -58,6 +59,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/matcher/expression.h"
+#include "mongo/db/multi_key_path_tracker.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/ops/delete.h"
 #include "mongo/db/query/collation/collation_spec.h"
@@ -1371,6 +1373,19 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     InsertDeleteOptions options;
     prepareInsertDeleteOptions(opCtx, coll->ns(), index->descriptor(), &options);
 
+    // For a large batch, inserting every document's keys into the index before moving on to the
+    // next document writes all over the index. Inserting the batch's keys in key order instead
+    // keeps consecutive writes on the same or neighbouring pages.
+    const auto minKeyOrderBatchSize = gInsertIndexKeysInKeyOrderMinBatchSize.load();
+    if (minKeyOrderBatchSize > 0 && bsonRecords.size() >= size_t(minKeyOrderBatchSize) &&
+        !index->isHybridBuilding() &&
+        std::all_of(bsonRecords.begin(), bsonRecords.end(), [&](const BsonRecord& bsonRecord) {
+            return bsonRecord.ts == bsonRecords.front().ts;
+        })) {
+        return _indexFilteredRecordsInKeyOrder(
+            opCtx, coll, index, bsonRecords, options, keysInsertedOut);
+    }
+
     for (auto bsonRecord : bsonRecords) {
         invariant(bsonRecord.id != RecordId());
 
@@ -1414,6 +1429,97 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status IndexCatalogImpl::_indexFilteredRecordsInKeyOrder(
+    OperationContext* opCtx,
+    const CollectionPtr& coll,
+    const IndexCatalogEntry* index,
+    const std::vector<BsonRecord>& bsonRecords,
+    const InsertDeleteOptions& options,
+    int64_t* keysInsertedOut) const {
+    invariant(!index->isHybridBuilding());
+    invariant(!bsonRecords.empty());
+
+    // All of the records share a timestamp, so it only needs to be set once.
+    if (!bsonRecords.front().ts.isNull()) {
+        Status status = opCtx->recoveryUnit()->setTimestamp(bsonRecords.front().ts);
+        if (!status.isOK())
+            return status;
+    }
+
+    auto& executionCtx = StorageExecutionContext::get(opCtx);
+    auto accessMethod = index->accessMethod();
+
+    // Every key embeds its document's RecordId, so the keys of the whole batch can be inserted
+    // together. The per-document multikey information is merged, since marking the index multikey
+    // with the union of what each document would have marked is equivalent.
+    KeyStringSet::sequence_type allKeys;
+    KeyStringSet::sequence_type allMultikeyMetadataKeys;
+    MultikeyPaths allMultikeyPaths;
+    bool isMultikey = false;
+    for (const auto& bsonRecord : bsonRecords) {
+        invariant(bsonRecord.id != RecordId());
+
+        auto keys = executionCtx.keys();
+        auto multikeyMetadataKeys = executionCtx.multikeyMetadataKeys();
+        auto multikeyPaths = executionCtx.multikeyPaths();
+
+        accessMethod->getKeys(opCtx,
+                              coll,
+                              executionCtx.pooledBufferBuilder(),
+                              *bsonRecord.docPtr,
+                              options.getKeysMode,
+                              IndexAccessMethod::GetKeysContext::kAddingKeys,
+                              keys.get(),
+                              multikeyMetadataKeys.get(),
+                              multikeyPaths.get(),
+                              bsonRecord.id,
+                              IndexAccessMethod::kNoopOnSuppressedErrorFn);
+
+        if (accessMethod->shouldMarkIndexAsMultikey(
+                keys->size(), *multikeyMetadataKeys, *multikeyPaths)) {
+            isMultikey = true;
+            auto metadataKeys = multikeyMetadataKeys->extract_sequence();
+            allMultikeyMetadataKeys.insert(allMultikeyMetadataKeys.end(),
+                                           std::make_move_iterator(metadataKeys.begin()),
+                                           std::make_move_iterator(metadataKeys.end()));
+            if (allMultikeyPaths.empty()) {
+                allMultikeyPaths = *multikeyPaths;
+            } else if (!multikeyPaths->empty()) {
+                MultikeyPathTracker::mergeMultikeyPaths(&allMultikeyPaths, *multikeyPaths);
+            }
+        }
+
+        auto docKeys = keys->extract_sequence();
+        allKeys.insert(allKeys.end(),
+                       std::make_move_iterator(docKeys.begin()),
+                       std::make_move_iterator(docKeys.end()));
+    }
+
+    // Sorts the keys.
+    KeyStringSet sortedKeys;
+    sortedKeys.adopt_sequence(std::move(allKeys));
+
+    int64_t numInserted;
+    Status status = accessMethod->insertKeys(
+        opCtx, coll, sortedKeys, RecordId(), options, nullptr, &numInserted);
+    if (!status.isOK())
+        return status;
+    if (keysInsertedOut) {
+        *keysInsertedOut += numInserted;
+    }
+
+    if (isMultikey) {
+        KeyStringSet multikeyMetadataKeys;
+        multikeyMetadataKeys.adopt_sequence(std::move(allMultikeyMetadataKeys));
+        index->setMultikey(opCtx, coll, multikeyMetadataKeys, allMultikeyPaths);
+        if (keysInsertedOut) {
+            *keysInsertedOut += multikeyMetadataKeys.size();
+        }
+    }
+
+    return Status::OK();
+}
+
 Status IndexCatalogImpl::_indexRecords(OperationContext* opCtx,
                                        const CollectionPtr& coll,
                                        const IndexCatalogEntry* index,
@@ -1669,16 +1775,35 @@ void IndexCatalogImpl::unindexRecord(OperationContext* opCtx,
 }
 
 Status IndexCatalogImpl::compactIndexes(OperationContext* opCtx) const {
+    // Compact the indexes with the most reclaimable space first, so that the space is regained
+    // early even if compaction is cut short.
+    std::vector<std::pair<long long, IndexCatalogEntry*>> entries;
     for (IndexCatalogEntryContainer::const_iterator it = _readyIndexes.begin();
          it != _readyIndexes.end();
          ++it) {
         IndexCatalogEntry* entry = it->get();
+        entries.emplace_back(entry->accessMethod()->getFreeStorageBytes(opCtx), entry);
+    }
+    std::stable_sort(entries.begin(), entries.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first > rhs.first;
+    });
 
+    Status timeSliceStatus = Status::OK();
+    for (const auto& [reclaimableBytes, entry] : entries) {
         LOGV2_DEBUG(20363,
                     1,
                     "compacting index: {entry_descriptor}",
-                    "entry_descriptor"_attr = *(entry->descriptor()));
+                    "entry_descriptor"_attr = *(entry->descriptor()),
+                    "reclaimableBytes"_attr = reclaimableBytes);
         Status status = entry->accessMethod()->compact(opCtx);
+        if (status == ErrorCodes::ExceededTimeLimit) {
+            LOGV2(5910901,
+                  "Compaction of index stopped at the end of its time slice",
+                  "index"_attr = *(entry->descriptor()),
+                  "error"_attr = status);
+            timeSliceStatus = status;
+            continue;
+        }
         if (!status.isOK()) {
             LOGV2_ERROR(20377,
                         "Failed to compact index",
@@ -1687,7 +1812,7 @@ Status IndexCatalogImpl::compactIndexes(OperationContext* opCtx) const {
             return status;
         }
     }
-    return Status::OK();
+    return timeSliceStatus;
 }
 
 std::string::size_type IndexCatalogImpl::getLongestIndexNameLength(OperationContext* opCtx) const {
@@ -336,6 +336,19 @@ private:
                                  const std::vector<BsonRecord>& bsonRecords,
                                  int64_t* keysInsertedOut) const;
 
+    /**
+     * Like _indexFilteredRecords(), but generates the keys of all of 'bsonRecords' before inserting
+     * any of them, and then inserts them in key order. Cannot be used for an index that is being
+     * built with a side-writes table, or for records that must be written at different
+     * timestamps.
+     */
+    Status _indexFilteredRecordsInKeyOrder(OperationContext* opCtx,
+                                           const CollectionPtr& coll,
+                                           const IndexCatalogEntry* index,
+                                           const std::vector<BsonRecord>& bsonRecords,
+                                           const InsertDeleteOptions& options,
+                                           int64_t* keysInsertedOut) const;
+
     Status _indexRecords(OperationContext* opCtx,
                          const CollectionPtr& coll,
                          const IndexCatalogEntry* index,
@@ -41,6 +41,7 @@
 #include "mongo/base/status.h"
 #include "mongo/base/status_with.h"
 #include "mongo/db/field_ref.h"
+#include "mongo/db/hasher.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/wildcard_key_generator.h"
 #include "mongo/db/index_names.h"
@@ -48,7 +49,9 @@
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
+#include "mongo/db/query/query_feature_flags_gen.h"
 #include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/server_options.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/fail_point.h"
@@ -80,6 +83,7 @@ static std::set<StringData> allowedFieldNames = {
     IndexDescriptor::kDefaultLanguageFieldName,
     IndexDescriptor::kDropDuplicatesFieldName,
     IndexDescriptor::kExpireAfterSecondsFieldName,
+    IndexDescriptor::kHashVersionFieldName,
     IndexDescriptor::kHiddenFieldName,
     IndexDescriptor::kIndexNameFieldName,
     IndexDescriptor::kIndexVersionFieldName,
@@ -474,6 +478,37 @@ StatusWith<BSONObj> validateIndexSpec(OperationContext* opCtx, const BSONObj& in
                 return ex.toStatus(str::stream() << "Failed to parse: "
                                                  << IndexDescriptor::kPathProjectionFieldName);
             }
+        } else if (IndexDescriptor::kHashVersionFieldName == indexSpecElemFieldName) {
+            const auto key = indexSpec.getObjectField(IndexDescriptor::kKeyPatternFieldName);
+            if (IndexNames::findPluginName(key) != IndexNames::HASHED) {
+                return {ErrorCodes::BadValue,
+                        str::stream()
+                            << "The field '" << IndexDescriptor::kHashVersionFieldName
+                            << "' is only allowed in an '" << IndexNames::HASHED << "' index"};
+            }
+            if (!indexSpecElem.isNumber()) {
+                return {ErrorCodes::TypeMismatch,
+                        str::stream() << "The field '" << IndexDescriptor::kHashVersionFieldName
+                                      << "' must be a number, but got "
+                                      << typeName(indexSpecElem.type())};
+            }
+            auto hashVersion = representAs<int>(indexSpecElem.number());
+            if (!hashVersion || !BSONElementHasher::isValidHashVersion(*hashVersion)) {
+                return {ErrorCodes::BadValue,
+                        str::stream() << "Invalid value for '"
+                                      << IndexDescriptor::kHashVersionFieldName
+                                      << "': " << indexSpecElem.toString(false, false)};
+            }
+            if (*hashVersion != static_cast<int>(HashVersion::kMD5) &&
+                !feature_flags::gFeatureFlagHashedIndexMurmur3.isEnabled(
+                    serverGlobalParams.featureCompatibility)) {
+                return {ErrorCodes::InvalidOptions,
+                        str::stream() << "'" << IndexDescriptor::kHashVersionFieldName << "' "
+                                      << *hashVersion
+                                      << " requires the hashed index MurmurHash3 feature to be "
+                                         "enabled and the feature compatibility version to "
+                                         "support it"};
+            }
         } else if (IndexDescriptor::kWeightsFieldName == indexSpecElemFieldName) {
             if (!indexSpecElem.isABSONObj() && indexSpecElem.type() != String) {
                 return {ErrorCodes::TypeMismatch,
@@ -43,6 +43,7 @@
 #include "mongo/db/catalog/uncommitted_collections.h"
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/index/index_access_method_gen.h"
 #include "mongo/db/index/multikey_paths.h"
 #include "mongo/db/multi_key_path_tracker.h"
 #include "mongo/db/op_observer.h"
@@ -54,6 +55,7 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log_and_backoff.h"
@@ -698,6 +700,10 @@ Status MultiIndexBlock::dumpInsertsFromBulk(
     const int32_t kYieldIterations =
         isBackgroundBuilding() ? internalIndexBuildBulkLoadYieldIterations.load() : 0;
 
+    if (auto status = _prepareSortersForBulkLoad(); !status.isOK()) {
+        return status;
+    }
+
     for (size_t i = 0; i < _indexes.size(); i++) {
         // When onDuplicateRecord is passed, 'dupsAllowed' should be passed to reflect whether or
         // not the index is unique.
@@ -751,6 +757,60 @@ Status MultiIndexBlock::dumpInsertsFromBulk(
     return Status::OK();
 }
 
+Status MultiIndexBlock::_prepareSortersForBulkLoad() {
+    const size_t numThreads =
+        std::min(_indexes.size(), static_cast<size_t>(maxIndexBuildSorterThreads.load()));
+    if (numThreads <= 1) {
+        // Each sorter is finalized inline by commitBulk().
+        return Status::OK();
+    }
+
+    LOGV2_DEBUG(6000131,
+                1,
+                "Index build: finalizing external sorters",
+                "numIndexes"_attr = _indexes.size(),
+                "numThreads"_attr = numThreads,
+                "buildUUID"_attr = _buildUUID);
+
+    // Sorting and setting up the merge of spilled ranges is CPU and file bound and independent
+    // for each index, unlike the insertion into the storage engine that follows it.
+    std::vector<Status> statuses(_indexes.size(), Status::OK());
+    AtomicWord<size_t> nextIndex{0};
+    auto prepareSorters = [&] {
+        for (size_t i = nextIndex.fetchAndAdd(1); i < _indexes.size();
+             i = nextIndex.fetchAndAdd(1)) {
+            try {
+                _indexes[i].bulk->prepareDone();
+            } catch (...) {
+                statuses[i] = exceptionToStatus();
+            }
+        }
+    };
+
+    std::vector<stdx::thread> threads;
+    ON_BLOCK_EXIT([&] {
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+    for (size_t i = 1; i < numThreads; ++i) {
+        threads.emplace_back(prepareSorters);
+    }
+    prepareSorters();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+
+    for (auto& status : statuses) {
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+    return Status::OK();
+}
+
 Status MultiIndexBlock::drainBackgroundWrites(
     OperationContext* opCtx,
     RecoveryUnit::ReadSource readSource,
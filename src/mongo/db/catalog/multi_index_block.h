@@ -337,6 +337,13 @@ private:
                            boost::optional<RecordId> resumeAfterRecordId,
                            ProgressMeterHolder* progress);
 
+    /**
+     * Finalizes the external sorters of all indexes being built on up to
+     * 'maxIndexBuildSorterThreads' threads, so that the serial bulk load in dumpInsertsFromBulk()
+     * only has to stream already-sorted keys into each index.
+     */
+    Status _prepareSortersForBulkLoad();
+
     // Is set during init() and ensures subsequent function calls act on the same Collection.
     boost::optional<UUID> _collectionUUID;
 
@@ -321,6 +321,9 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
         bool isMetadataKey = indexEntry->loc == kWildcardMultikeyMetadataRecordId;
         if (descriptor->getIndexType() == IndexType::INDEX_WILDCARD && isMetadataKey) {
             _indexConsistency->removeMultikeyMetadataPath(indexEntry->keyString, &indexInfo);
+        } else if (!_validateState->isInRange(indexEntry->loc)) {
+            // Incremental validation only accounts for the index entries of the records in the
+            // validated slice of the record store. The key order is still checked above.
         } else {
             try {
                 _indexConsistency->addIndexKey(
@@ -562,6 +565,13 @@ void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
 
         prevRecordId = record->id;
 
+        // Incremental validation stops once the slice holds the requested number of records. The
+        // next run resumes after the last record of this slice.
+        if (_numRecords >= _validateState->getMaxRecords()) {
+            _validateState->setLastRecordIdInRange(record->id);
+            break;
+        }
+
         if (_numRecords % kInterruptIntervalNumRecords == 0 ||
             interruptIntervalNumBytes >= kInterruptIntervalNumBytes) {
             // Periodically checks for interrupts and yields.
@@ -589,8 +599,9 @@ void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
     }
 
     // Do not update the record store stats if we're in the background as we've validated a
-    // checkpoint and it may not have the most up-to-date changes.
-    if (results->valid && !_validateState->isBackground()) {
+    // checkpoint and it may not have the most up-to-date changes, or if we've only validated a slice
+    // of the record store.
+    if (results->valid && !_validateState->isBackground() && !_validateState->isIncremental()) {
         _validateState->getCollection()->getRecordStore()->updateStatsAfterRepair(
             opCtx, _numRecords, dataSizeTotal);
     }
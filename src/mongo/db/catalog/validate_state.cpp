@@ -54,10 +54,12 @@ ValidateState::ValidateState(OperationContext* opCtx,
                              const NamespaceString& nss,
                              ValidateMode mode,
                              RepairMode repairMode,
-                             bool turnOnExtraLoggingForTest)
+                             bool turnOnExtraLoggingForTest,
+                             const boost::optional<ValidateRange>& range)
     : _nss(nss),
       _mode(mode),
       _repairMode(repairMode),
+      _range(range),
       _dataThrottle(opCtx),
       _extraLoggingForTest(turnOnExtraLoggingForTest) {
 
@@ -99,6 +101,14 @@ ValidateState::ValidateState(OperationContext* opCtx,
         invariant(!isBackground());
     }
 
+    // Full validation checks whole structures and repairs rely on seeing every record, so neither
+    // can be restricted to a slice of the collection.
+    if (isIncremental()) {
+        invariant(!isFullIndexValidation());
+        invariant(!adjustMultikey());
+        invariant(_range->maxRecords > 0);
+    }
+
     _uuid = _collection->uuid();
     _catalogGeneration = opCtx->getServiceContext()->getCatalogGeneration();
 }
@@ -278,7 +288,17 @@ void ValidateState::initializeCursors(OperationContext* opCtx) {
     // use cursor->next() to get subsequent Records. However, if the Record Store is empty,
     // there is no first record. In this case, we set the first Record Id to an invalid RecordId
     // (RecordId()), which will halt iteration at the initialization step.
-    const boost::optional<Record> record = _traverseRecordStoreCursor->next(opCtx);
+    //
+    // Incremental validation starts with the first record after the RecordId it resumes after.
+    boost::optional<Record> record;
+    if (_range && !_range->resumeAfter.isNull()) {
+        record = _traverseRecordStoreCursor->seekNear(opCtx, _range->resumeAfter);
+        if (record && record->id <= _range->resumeAfter) {
+            record = _traverseRecordStoreCursor->next(opCtx);
+        }
+    } else {
+        record = _traverseRecordStoreCursor->next(opCtx);
+    }
     _firstRecordId = record ? record->id : RecordId();
 }
 
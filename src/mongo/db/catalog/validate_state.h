@@ -63,7 +63,8 @@ public:
                   const NamespaceString& nss,
                   ValidateMode mode,
                   RepairMode repairMode,
-                  bool turnOnExtraLoggingForTest = false);
+                  bool turnOnExtraLoggingForTest = false,
+                  const boost::optional<ValidateRange>& range = boost::none);
 
     const NamespaceString& nss() const {
         return _nss;
@@ -84,6 +85,51 @@ public:
         return isFullValidation() || _mode == ValidateMode::kForegroundFullIndexOnly;
     }
 
+    /**
+     * Returns true if only a slice of the collection is validated. See ValidateRange.
+     */
+    bool isIncremental() const {
+        return _range.has_value();
+    }
+
+    /**
+     * The maximum number of records to traverse in the record store.
+     */
+    long long getMaxRecords() const {
+        return _range ? _range->maxRecords : std::numeric_limits<long long>::max();
+    }
+
+    /**
+     * Records the last RecordId of the validated slice when the record store traversal stopped
+     * before reaching the end of the record store.
+     */
+    void setLastRecordIdInRange(const RecordId& id) {
+        invariant(isIncremental());
+        _lastRecordIdInRange = id;
+    }
+
+    /**
+     * The RecordId the next incremental validation run should resume after, or a null RecordId if
+     * this run reached the end of the record store.
+     */
+    const RecordId& getNextResumeAfter() const {
+        return _lastRecordIdInRange;
+    }
+
+    /**
+     * Returns true if 'id' belongs to the slice of the record store being validated. Always true
+     * when validating the whole collection.
+     */
+    bool isInRange(const RecordId& id) const {
+        if (!_range) {
+            return true;
+        }
+        if (!_range->resumeAfter.isNull() && id <= _range->resumeAfter) {
+            return false;
+        }
+        return _lastRecordIdInRange.isNull() || id <= _lastRecordIdInRange;
+    }
+
     bool isCollectionSchemaViolated() const {
         return _collectionSchemaViolated;
     }
@@ -233,6 +279,11 @@ private:
 
     RecordId _firstRecordId;
 
+    // Set for incremental validation. '_lastRecordIdInRange' is only set once the record store
+    // traversal stops before the end of the record store.
+    boost::optional<ValidateRange> _range;
+    RecordId _lastRecordIdInRange;
+
     DataThrottle _dataThrottle;
 
     // Used to detect when the catalog is re-opened while yielding locks.
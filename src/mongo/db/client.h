@@ -231,6 +231,17 @@ public:
      */
     bool hasAnyActiveCurrentOp() const;
 
+    /**
+     * Returns false if this client had no OperationContext the last time one was set or cleared.
+     * May be called without holding the client lock, which makes it useful to skip idle clients
+     * cheaply when scanning all clients, but since the answer may be stale by the time it is
+     * used, callers must recheck with hasAnyActiveCurrentOp() under the client lock when it
+     * returns true.
+     */
+    bool mayHaveActiveCurrentOp() const {
+        return _hasOperationContext.loadRelaxed();
+    }
+
     /**
      * Signal the client's OperationContext that it has been killed.
      * Any future OperationContext on this client will also receive a kill signal.
@@ -272,6 +283,7 @@ private:
      */
     void _setOperationContext(OperationContext* opCtx) {
         _opCtx = opCtx;
+        _hasOperationContext.store(opCtx != nullptr);
     }
 
     ServiceContext* const _serviceContext;
@@ -292,6 +304,9 @@ private:
     // If != NULL, then contains the currently active OperationContext
     OperationContext* _opCtx = nullptr;
 
+    // Mirrors whether '_opCtx' is set, readable without the client lock
+    AtomicWord<bool> _hasOperationContext{false};
+
     // If the active system client operation is allowed to be killed.
     bool _systemOperationKillable = false;
 
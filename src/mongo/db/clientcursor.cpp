@@ -52,6 +52,7 @@
 #include "mongo/db/query/explain.h"
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/repl/speculative_majority_read_info.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/exit.h"
@@ -67,6 +68,7 @@ static Counter64 cursorStatsOpenNoTimeout;  // gauge
 static Counter64 cursorStatsTimedOut;
 static Counter64 cursorStatsTotalOpened;
 static Counter64 cursorStatsMoreThanOneBatch;
+static Counter64 cursorStatsPrefetchedBytes;  // gauge
 
 static ServerStatusMetricField<Counter64> dCursorStatsOpen("cursor.open.total", &cursorStatsOpen);
 static ServerStatusMetricField<Counter64> dCursorStatsOpenPinned("cursor.open.pinned",
@@ -79,6 +81,8 @@ static ServerStatusMetricField<Counter64> dCursorStatsTotalOpened("cursor.totalO
                                                                   &cursorStatsTotalOpened);
 static ServerStatusMetricField<Counter64> dCursorStatsMoreThanOneBatch(
     "cursor.moreThanOneBatch", &cursorStatsMoreThanOneBatch);
+static ServerStatusMetricField<Counter64> dCursorStatsPrefetchedBytes(
+    "cursor.prefetch.bufferedBytes", &cursorStatsPrefetchedBytes);
 
 ClientCursor::ClientCursor(ClientCursorParams params,
                            CursorId cursorId,
@@ -126,6 +130,8 @@ ClientCursor::~ClientCursor() {
 
     if (_nBatchesReturned > 1)
         cursorStatsMoreThanOneBatch.increment();
+
+    cursorStatsPrefetchedBytes.decrement(_prefetchedBytes);
 }
 
 void ClientCursor::markAsKilled(Status killStatus) {
@@ -154,6 +160,7 @@ GenericCursor ClientCursor::toGenericCursor() const {
     gc.setLastAccessDate(getLastUseDate());
     gc.setCreatedDate(getCreatedDate());
     gc.setNBatchesReturned(getNBatches());
+    gc.setNDocsReturnedLastBatch(getNReturnedLastBatch());
     gc.setPlanSummary(getPlanSummary());
     if (auto opCtx = _operationUsingCursor) {
         gc.setOperationUsingCursorId(opCtx->getOpID());
@@ -162,6 +169,33 @@ GenericCursor ClientCursor::toGenericCursor() const {
     return gc;
 }
 
+BSONObj ClientCursor::popPrefetchedResult() {
+    invariant(!_prefetchedResults.empty());
+    BSONObj obj = std::move(_prefetchedResults.front());
+    _prefetchedResults.pop_front();
+
+    _prefetchedBytes -= obj.objsize();
+    cursorStatsPrefetchedBytes.decrement(obj.objsize());
+    return obj;
+}
+
+void ClientCursor::returnPrefetchedResult(BSONObj obj) {
+    _prefetchedBytes += obj.objsize();
+    cursorStatsPrefetchedBytes.increment(obj.objsize());
+    _prefetchedResults.push_front(std::move(obj));
+}
+
+void ClientCursor::appendPrefetchedResult(BSONObj obj) {
+    invariant(obj.isOwned());
+    _prefetchedBytes += obj.objsize();
+    cursorStatsPrefetchedBytes.increment(obj.objsize());
+    _prefetchedResults.push_back(std::move(obj));
+}
+
+long long ClientCursor::getTotalPrefetchedBytes() {
+    return cursorStatsPrefetchedBytes.get();
+}
+
 //
 // Pin methods
 //
@@ -312,4 +346,48 @@ void startClientCursorMonitor() {
     getClientCursorMonitor(getGlobalServiceContext()).go();
 }
 
+void applyCursorReadConcern(OperationContext* opCtx, repl::ReadConcernArgs rcArgs) {
+    const auto replicationMode = repl::ReplicationCoordinator::get(opCtx)->getReplicationMode();
+
+    // Select the appropriate read source. If we are in a transaction with read concern majority,
+    // this will already be set to kNoTimestamp, so don't set it again.
+    if (replicationMode == repl::ReplicationCoordinator::modeReplSet &&
+        rcArgs.getLevel() == repl::ReadConcernLevel::kMajorityReadConcern &&
+        !opCtx->inMultiDocumentTransaction()) {
+        switch (rcArgs.getMajorityReadMechanism()) {
+            case repl::ReadConcernArgs::MajorityReadMechanism::kMajoritySnapshot: {
+                // Make sure we read from the majority snapshot.
+                opCtx->recoveryUnit()->setTimestampReadSource(
+                    RecoveryUnit::ReadSource::kMajorityCommitted);
+                uassertStatusOK(opCtx->recoveryUnit()->majorityCommittedSnapshotAvailable());
+                break;
+            }
+            case repl::ReadConcernArgs::MajorityReadMechanism::kSpeculative: {
+                // Mark the operation as speculative and select the correct read source.
+                repl::SpeculativeMajorityReadInfo::get(opCtx).setIsSpeculativeRead();
+                opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kNoOverlap);
+                break;
+            }
+        }
+    }
+
+    if (replicationMode == repl::ReplicationCoordinator::modeReplSet &&
+        rcArgs.getLevel() == repl::ReadConcernLevel::kSnapshotReadConcern &&
+        !opCtx->inMultiDocumentTransaction()) {
+        auto atClusterTime = rcArgs.getArgsAtClusterTime();
+        invariant(atClusterTime && *atClusterTime != LogicalTime::kUninitialized);
+        opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kProvided,
+                                                      atClusterTime->asTimestamp());
+    }
+
+    // For cursor commands that take locks internally, the read concern on the
+    // OperationContext may affect the timestamp read source selected by the storage engine.
+    // We place the cursor read concern onto the OperationContext so the lock acquisition
+    // respects the cursor's read concern.
+    {
+        stdx::lock_guard<Client> lk(*opCtx->getClient());
+        repl::ReadConcernArgs::get(opCtx) = rcArgs;
+    }
+}
+
 }  // namespace mongo
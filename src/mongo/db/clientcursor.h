@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <deque>
 #include <functional>
 
 #include "mongo/db/api_parameters.h"
@@ -40,6 +41,7 @@
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/query/plan_executor.h"
 #include "mongo/db/record_id.h"
+#include "mongo/db/repl/read_concern_args.h"
 #include "mongo/db/repl/read_concern_level.h"
 
 namespace mongo {
@@ -231,6 +233,17 @@ public:
         ++_nBatchesReturned;
     }
 
+    /**
+     * Returns the number of results in the most recent batch returned by this cursor.
+     */
+    std::uint64_t getNReturnedLastBatch() const {
+        return _nReturnedLastBatch;
+    }
+
+    void setNReturnedLastBatch(std::uint64_t n) {
+        _nReturnedLastBatch = n;
+    }
+
     Date_t getLastUseDate() const {
         return _lastUseDate;
     }
@@ -295,6 +308,37 @@ public:
         return _opKey;
     }
 
+    /**
+     * Returns true if documents produced ahead of time by the CursorPrefetcher are waiting to be
+     * returned by the next getMore. The caller must have this cursor pinned, as for the methods
+     * below.
+     */
+    bool hasPrefetchedResults() const {
+        return !_prefetchedResults.empty();
+    }
+
+    /**
+     * Removes and returns the oldest prefetched document.
+     */
+    BSONObj popPrefetchedResult();
+
+    /**
+     * Puts back a document obtained from popPrefetchedResult() which did not fit in the current
+     * batch, so that it is the first one returned by the next getMore.
+     */
+    void returnPrefetchedResult(BSONObj obj);
+
+    /**
+     * Appends a document produced by the CursorPrefetcher. 'obj' must be owned.
+     */
+    void appendPrefetchedResult(BSONObj obj);
+
+    /**
+     * Returns the total size of the documents currently held in prefetched batches across all
+     * cursors.
+     */
+    static long long getTotalPrefetchedBytes();
+
 private:
     friend class CursorManager;
     friend class ClientCursorPin;
@@ -377,6 +421,9 @@ private:
     // Tracks the number of batches returned by this cursor so far.
     std::uint64_t _nBatchesReturned = 0;
 
+    // The number of results in the most recent batch returned by this cursor.
+    std::uint64_t _nReturnedLastBatch = 0;
+
     // Holds an owned copy of the command specification received from the client.
     const BSONObj _originatingCommand;
 
@@ -421,6 +468,11 @@ private:
 
     // The client OperationKey associated with this cursor.
     boost::optional<OperationKey> _opKey;
+
+    // Results produced by the CursorPrefetcher which have not yet been returned to the client, and
+    // their total size.
+    std::deque<BSONObj> _prefetchedResults;
+    std::uint64_t _prefetchedBytes = 0;
 };
 
 /**
@@ -511,4 +563,10 @@ private:
 
 void startClientCursorMonitor();
 
+/**
+ * Applies the read concern of the command which created a cursor to 'opCtx', so that the next batch
+ * of results is read from the appropriate snapshot.
+ */
+void applyCursorReadConcern(OperationContext* opCtx, repl::ReadConcernArgs rcArgs);
+
 }  // namespace mongo
@@ -117,6 +117,7 @@ bool checkAuthorizationImplPreParse(OperationContext* opCtx,
 // The command names that are allowed in a multi-document transaction.
 const StringMap<int> txnCmdAllowlist = {{"abortTransaction", 1},
                                         {"aggregate", 1},
+                                        {"bulkWrite", 1},
                                         {"commitTransaction", 1},
                                         {"coordinateCommitTransaction", 1},
                                         {"create", 1},
@@ -0,0 +1,225 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kCommand
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/query/cardinality_estimator.h"
+#include "mongo/logv2/log.h"
+
+namespace mongo {
+namespace {
+
+constexpr long long kDefaultSampleSize = 10000;
+constexpr long long kMaxSampleSize = 1000000;
+constexpr long long kDefaultNumBuckets = 100;
+constexpr long long kMaxNumBuckets = 1000;
+
+long long parsePositiveLong(const BSONObj& cmdObj,
+                            StringData fieldName,
+                            long long defaultValue,
+                            long long maxValue) {
+    auto elem = cmdObj[fieldName];
+    if (elem.eoo()) {
+        return defaultValue;
+    }
+    uassert(6000137,
+            str::stream() << "'" << fieldName << "' must be a number",
+            elem.isNumber());
+    auto value = elem.safeNumberLong();
+    uassert(6000138,
+            str::stream() << "'" << fieldName << "' must be between 1 and " << maxValue,
+            value > 0 && value <= maxValue);
+    return value;
+}
+
+/**
+ * Samples up to 'sampleSize' documents of 'collection' and builds a histogram of the values of
+ * 'path' in them. Values are extracted the way index keys are, so that each element of an array
+ * is a separate value and a missing field is null.
+ */
+FieldStatistics buildFieldStatistics(OperationContext* opCtx,
+                                     const CollectionPtr& collection,
+                                     StringData path,
+                                     long long sampleSize,
+                                     long long numBuckets) {
+    FieldStatistics stats;
+    stats.numRecords = collection->numRecords(opCtx);
+    stats.builtAt = Date_t::now();
+
+    // Prefer a random sample. Storage engines without random cursors get the first documents of
+    // the collection instead.
+    std::unique_ptr<RecordCursor> cursor = collection->getRecordStore()->getRandomCursor(opCtx);
+    const bool isRandom = static_cast<bool>(cursor);
+    if (!isRandom) {
+        cursor = collection->getCursor(opCtx);
+    }
+
+    // Each sampled value is copied into its own buffer, since the documents do not outlive the
+    // iteration.
+    const auto nullValue = BSON("" << BSONNULL);
+    std::vector<BSONObj> ownedValues;
+    std::vector<BSONElement> values;
+    const auto numDocsToSample = isRandom ? std::min(sampleSize, stats.numRecords) : sampleSize;
+    while (stats.numDocsSampled < numDocsToSample) {
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+        ++stats.numDocsSampled;
+
+        BSONElementSet elements;
+        dotted_path_support::extractAllElementsAlongPath(record->data.toBson(), path, elements);
+        if (elements.empty()) {
+            values.push_back(nullValue.firstElement());
+            continue;
+        }
+        for (auto&& elem : elements) {
+            ownedValues.push_back(elem.wrap(""));
+            values.push_back(ownedValues.back().firstElement());
+        }
+    }
+
+    stats.histogram = Histogram::make(std::move(values), numBuckets);
+    return stats;
+}
+
+/**
+ * The 'analyze' command samples the documents of a collection and builds a histogram of the
+ * values of a field, which the query planner then uses to pick between index scans without
+ * running a trial period:
+ *
+ *    {
+ *        analyze: <collection>,
+ *        key: <field path>,
+ *        sampleSize: <number of documents to sample, default 10000>,
+ *        numBuckets: <maximum number of histogram buckets, default 100>
+ *    }
+ *
+ * The statistics are only kept in memory on the node which ran the command, and are replaced by
+ * running the command again for the same field.
+ */
+class AnalyzeCommand final : public BasicCommand {
+public:
+    AnalyzeCommand() : BasicCommand("analyze") {}
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override;
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kOptIn;
+    }
+
+    bool maintenanceOk() const override {
+        return false;
+    }
+
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) const override;
+
+    std::string help() const override {
+        return "Builds a histogram of the values of a field, used for query plan selection.";
+    }
+} analyzeCommand;
+
+Status AnalyzeCommand::checkAuthForCommand(Client* client,
+                                           const std::string& dbname,
+                                           const BSONObj& cmdObj) const {
+    AuthorizationSession* authzSession = AuthorizationSession::get(client);
+    ResourcePattern pattern = parseResourcePattern(dbname, cmdObj);
+
+    if (authzSession->isAuthorizedForActionsOnResource(pattern, ActionType::planCacheWrite)) {
+        return Status::OK();
+    }
+
+    return Status(ErrorCodes::Unauthorized, "unauthorized");
+}
+
+bool AnalyzeCommand::run(OperationContext* opCtx,
+                         const std::string& dbname,
+                         const BSONObj& cmdObj,
+                         BSONObjBuilder& result) {
+    const NamespaceString nss(CommandHelpers::parseNsCollectionRequired(dbname, cmdObj));
+
+    auto keyElem = cmdObj["key"];
+    uassert(6000139,
+            "'key' must be a non-empty field path",
+            keyElem.type() == String && !keyElem.valueStringData().empty());
+    const auto path = keyElem.String();
+    const auto sampleSize =
+        parsePositiveLong(cmdObj, "sampleSize", kDefaultSampleSize, kMaxSampleSize);
+    const auto numBuckets =
+        parsePositiveLong(cmdObj, "numBuckets", kDefaultNumBuckets, kMaxNumBuckets);
+
+    AutoGetCollectionForReadCommand ctx(opCtx, nss);
+    const auto& collection = ctx.getCollection();
+    uassert(ErrorCodes::NamespaceNotFound,
+            str::stream() << "Collection " << nss << " does not exist",
+            collection);
+
+    auto stats = std::make_shared<FieldStatistics>(
+        buildFieldStatistics(opCtx, collection, path, sampleSize, numBuckets));
+
+    result.append("key", path);
+    result.append("numDocsSampled", stats->numDocsSampled);
+    result.append("numRecords", stats->numRecords);
+    result.append("histogram", stats->histogram.toBSON());
+
+    LOGV2_DEBUG(6000140,
+                1,
+                "Built field statistics",
+                "namespace"_attr = nss,
+                "key"_attr = path,
+                "numDocsSampled"_attr = stats->numDocsSampled,
+                "numBuckets"_attr = stats->histogram.getBuckets().size());
+
+    CollectionStatistics::get(collection->getSharedDecorations())
+        .setFieldStatistics(path, std::move(stats));
+    return true;
+}
+
+}  // namespace
+}  // namespace mongo
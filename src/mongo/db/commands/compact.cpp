@@ -96,10 +96,10 @@ public:
             return false;
         }
 
-        StatusWith<int64_t> status = compactCollection(opCtx, nss);
+        StatusWith<CompactStats> status = compactCollection(opCtx, nss);
         uassertStatusOK(status.getStatus());
 
-        int64_t bytesFreed = status.getValue();
+        int64_t bytesFreed = status.getValue().bytesFreed;
         if (bytesFreed < 0) {
             // When compacting a collection that is actively being written to, it is possible that
             // the collection is larger at the completion of compaction than when it started.
@@ -107,6 +107,9 @@ public:
         }
 
         result.appendNumber("bytesFreed", static_cast<long long>(bytesFreed));
+        result.appendNumber("bytesReclaimable",
+                            static_cast<long long>(status.getValue().bytesReclaimable));
+        result.appendBool("complete", status.getValue().complete);
 
         return true;
     }
@@ -45,7 +45,9 @@
 #include "mongo/db/repl/dbcheck.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/optime.h"
+#include "mongo/db/storage/storage_engine.h"
 #include "mongo/idl/command_generic_argument.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/background.h"
 
 #include "mongo/logv2/log.h"
@@ -189,7 +191,7 @@ std::unique_ptr<DbCheckRun> getRun(OperationContext* opCtx,
 class DbCheckJob : public BackgroundJob {
 public:
     DbCheckJob(const StringData& dbName, std::unique_ptr<DbCheckRun> run)
-        : BackgroundJob(true), _done(false), _dbName(dbName.toString()), _run(std::move(run)) {}
+        : BackgroundJob(true), _dbName(dbName.toString()), _run(std::move(run)) {}
 
 protected:
     virtual std::string name() const override {
@@ -197,34 +199,81 @@ protected:
     }
 
     virtual void run() override {
-        // Every dbCheck runs in its own client.
-        ThreadClient tc(name(), getGlobalServiceContext());
+        const auto numWorkers =
+            std::min(static_cast<size_t>(gDbCheckCollectionConcurrency.load()), _run->size());
+        if (numWorkers <= 1) {
+            // Every dbCheck runs in its own client.
+            ThreadClient tc(name(), getGlobalServiceContext());
+            _checkCollections();
+            return;
+        }
+
+        // Database-wide checks may check several collections at once, each on its own client.
+        std::vector<stdx::thread> workers;
+        for (size_t i = 0; i < numWorkers; ++i) {
+            workers.emplace_back([this] {
+                ThreadClient tc(name(), getGlobalServiceContext());
+                _checkCollections();
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
 
-        for (const auto& coll : *_run) {
+private:
+    /**
+     * Checks collections of the run until there are none left, a check fails, or the node steps
+     * down.
+     */
+    void _checkCollections() {
+        while (!_failed.load()) {
+            const auto index = _nextCollection.fetchAndAdd(1);
+            if (index >= _run->size()) {
+                return;
+            }
+
+            const auto& coll = (*_run)[index];
             try {
                 _doCollection(coll);
             } catch (const DBException& e) {
                 auto logEntry = dbCheckErrorHealthLogEntry(
                     coll.nss, "dbCheck failed", OplogEntriesEnum::Batch, e.toStatus());
                 HealthLog::get(Client::getCurrent()->getServiceContext()).log(*logEntry);
+                _failed.store(true);
                 return;
             }
 
-            if (_done) {
+            if (_done.load()) {
                 LOGV2(20451, "dbCheck terminated due to stepdown");
+                _failed.store(true);
                 return;
             }
         }
     }
 
-private:
+    /**
+     * Waits, for at most 'dbCheckMaxCachePressureWaitMillis', while the storage engine's cache is
+     * under pressure, so the check does not compete with user operations for cache space.
+     */
+    void _waitForCachePressureToSubside() {
+        auto storageEngine = getGlobalServiceContext()->getStorageEngine();
+        const auto deadline =
+            Date_t::now() + Milliseconds(gDbCheckMaxCachePressureWaitMillis.load());
+        for (auto now = Date_t::now();
+             now < deadline && !_done.load() && storageEngine->isCacheUnderPressure();
+             now = Date_t::now()) {
+            sleepFor(std::min(deadline - now, Milliseconds(100)));
+        }
+    }
+
     void _doCollection(const DbCheckCollectionInfo& info) {
         // If we can't find the collection, abort the check.
         if (!_getCollectionMetadata(info)) {
             return;
         }
 
-        if (_done) {
+        if (_done.load()) {
             return;
         }
 
@@ -252,7 +301,7 @@ private:
 
             auto result = _runBatch(info, start, kBatchDocs, kBatchBytes);
 
-            if (_done) {
+            if (_done.load()) {
                 return;
             }
 
@@ -298,6 +347,10 @@ private:
 
                 stdx::this_thread::sleep_for(timesExceeded * 1s - (Clock::now() - lastStart));
             }
+
+            if (!reachedEnd) {
+                _waitForCachePressureToSubside();
+            }
         } while (!reachedEnd);
     }
 
@@ -313,7 +366,14 @@ private:
     };
 
     // Set if the job cannot proceed.
-    bool _done;
+    AtomicWord<bool> _done{false};
+
+    // Set once no more collections should be checked, because the job cannot proceed or a check
+    // failed.
+    AtomicWord<bool> _failed{false};
+
+    // Index into '_run' of the next collection to check.
+    AtomicWord<size_t> _nextCollection{0};
     std::string _dbName;
     std::unique_ptr<DbCheckRun> _run;
 
@@ -326,7 +386,7 @@ private:
         AutoGetDbForDbCheck agd(opCtx, info.nss);
 
         if (_stepdownHasOccurred(opCtx, info.nss)) {
-            _done = true;
+            _done.store(true);
             return true;
         }
 
@@ -391,7 +451,7 @@ private:
         AutoGetCollectionForDbCheck agc(opCtx, info.nss, OplogEntriesEnum::Batch);
 
         if (_stepdownHasOccurred(opCtx, info.nss)) {
-            _done = true;
+            _done.store(true);
             return Status(ErrorCodes::PrimarySteppedDown, "dbCheck terminated due to stepdown");
         }
 
@@ -33,14 +33,18 @@
 
 #include "mongo/db/auth/authorization_checks.h"
 #include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/catalog/collection_query_info.h"
 #include "mongo/db/client.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/commands/run_aggregate.h"
 #include "mongo/db/commands/test_commands_enabled.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/cursor_manager.h"
+#include "mongo/db/cursor_prefetcher.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/index/index_access_method.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/pipeline/aggregation_request_helper.h"
 #include "mongo/db/pipeline/variables.h"
@@ -50,7 +54,11 @@
 #include "mongo/db/query/find.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_result_cache.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
@@ -176,6 +184,67 @@ void beginQueryOp(OperationContext* opCtx, const NamespaceString& nss, const BSO
     curOp->setNS_inlock(nss.ns());
 }
 
+/**
+ * Returns true if 'projection' is empty or only includes top-level fields, optionally excluding
+ * _id. Such a projection can be applied to a document without parsing it into a projection AST.
+ */
+bool isSimpleInclusionProjection(const BSONObj& projection) {
+    bool hasInclusion = projection.isEmpty();
+    for (auto&& elem : projection) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (fieldName.empty() || fieldName[0] == '$' || fieldName.find('.') != std::string::npos) {
+            return false;
+        }
+        if (!elem.isNumber() && elem.type() != Bool) {
+            return false;
+        }
+        if (elem.trueValue()) {
+            hasInclusion = true;
+        } else if (fieldName != "_id"_sd) {
+            return false;
+        }
+    }
+    return hasInclusion;
+}
+
+BSONObj applySimpleInclusionProjection(const BSONObj& doc, const BSONObj& projection) {
+    if (projection.isEmpty()) {
+        return doc;
+    }
+
+    const auto idElem = projection["_id"];
+    const bool includeId = !idElem || idElem.trueValue();
+    BSONObjBuilder bob(doc.objsize());
+    for (auto&& elem : doc) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (fieldName == "_id"_sd ? includeId : projection.hasField(fieldName)) {
+            bob.append(elem);
+        }
+    }
+    return bob.obj();
+}
+
+/**
+ * Returns true if 'findCommand' is a point read of a single _id value which can be answered by
+ * looking the value up in the _id index, without a CanonicalQuery or a PlanExecutor. Anything
+ * which affects the result beyond an equality on _id and a simple inclusion projection is left to
+ * the regular find path.
+ */
+bool isExpressIdLookupEligible(OperationContext* opCtx, const FindCommandRequest& findCommand) {
+    return internalQueryEnableExpressIdLookup.load() &&
+        CanonicalQuery::isSimpleIdQuery(findCommand.getFilter()) &&
+        isSimpleInclusionProjection(findCommand.getProjection()) &&
+        findCommand.getSort().isEmpty() && findCommand.getHint().isEmpty() &&
+        findCommand.getCollation().isEmpty() && !findCommand.getSkip() &&
+        findCommand.getBatchSize().value_or(1) != 0 && findCommand.getMin().isEmpty() &&
+        findCommand.getMax().isEmpty() && !findCommand.getReturnKey() &&
+        !findCommand.getShowRecordId() && !findCommand.getTailable() &&
+        !findCommand.getAwaitData() && !findCommand.getLet() && !findCommand.getTerm() &&
+        !findCommand.getReadOnce() && !findCommand.getAllowSpeculativeMajorityRead() &&
+        !findCommand.getRequestResumeToken() && findCommand.getResumeAfter().isEmpty() &&
+        !OperationShardingState::isOperationVersioned(opCtx);
+}
+
 /**
  * A command for running .find() queries.
  */
@@ -431,6 +500,13 @@ public:
                 opCtx->lockState()->skipAcquireTicket();
             }
 
+            // Decide whether the query result cache may be used before the storage snapshot is
+            // opened, so that any write which is not visible to this find invalidates its result.
+            boost::optional<QueryResultCache::Lookup> cacheLookup;
+            if (auto cacheNss = findCommand->getNamespaceOrUUID().nss()) {
+                cacheLookup = QueryResultCache::get(opCtx).prepare(opCtx, *cacheNss, cmdObj);
+            }
+
             // Acquire locks. If the query is on a view, we release our locks and convert the query
             // request into an aggregation command.
             boost::optional<AutoGetCollectionForReadCommandMaybeLockFree> ctx;
@@ -489,6 +565,22 @@ public:
                 return;
             }
 
+            // Capped collections are excluded because capped deletes are not observed.
+            if (cacheLookup && (!ctx->getCollection() || ctx->getCollection()->isCapped())) {
+                cacheLookup.reset();
+            }
+            if (cacheLookup) {
+                if (auto cachedBatch = QueryResultCache::get(opCtx).find(opCtx, *cacheLookup)) {
+                    _replyFromQueryResultCache(opCtx, nss, *cachedBatch, result);
+                    return;
+                }
+            }
+
+            if (isExpressIdLookupEligible(opCtx, *findCommand) &&
+                _runExpressIdLookup(opCtx, nss, ctx->getCollection(), *findCommand, result)) {
+                return;
+            }
+
             auto expCtx = makeExpressionContext(
                 opCtx, *findCommand, boost::none /* verbosity */, false /* isView */);
             // Finish the parsing step by using the FindCommandRequest to create a CanonicalQuery.
@@ -546,9 +638,14 @@ public:
             std::uint64_t numResults = 0;
             bool stashedResult = false;
             ResourceConsumption::DocumentUnitCounter docUnitsReturned;
+            auto adaptiveBatch = AdaptiveBatchSizer::make(originalFC.getBatchSize());
+            auto enoughForFirstBatch = [&] {
+                return adaptiveBatch ? adaptiveBatch->enough(numResults, firstBatch.bytesUsed())
+                                     : FindCommon::enoughForFirstBatch(originalFC, numResults);
+            };
 
             try {
-                while (!FindCommon::enoughForFirstBatch(originalFC, numResults) &&
+                while (!enoughForFirstBatch() &&
                        PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr))) {
                     // If we can't fit this result inside the current batch, then we stash it for
                     // later.
@@ -565,6 +662,13 @@ public:
                     firstBatch.append(obj);
                     numResults++;
                     docUnitsReturned.observeOne(obj.objsize());
+
+                    // Once the size of the documents is known, grow the reply for the whole batch
+                    // at once rather than copying it every time the buffer fills up.
+                    if (numResults == 1) {
+                        firstBatch.reserveBytes(
+                            FindCommon::estimateRemainingFirstBatchBytes(originalFC, obj));
+                    }
                 }
             } catch (DBException& exception) {
                 firstBatch.abandon();
@@ -593,6 +697,7 @@ public:
 
             // Set up the cursor for getMore.
             CursorId cursorId = 0;
+            boost::optional<long long> prefetchBatchSize;
             if (shouldSaveCursor(opCtx, collection, state, exec.get())) {
                 ClientCursorPin pinnedCursor = CursorManager::get(opCtx)->registerCursor(
                     opCtx,
@@ -622,16 +727,33 @@ public:
                 }
                 pinnedCursor.getCursor()->setNReturnedSoFar(numResults);
                 pinnedCursor.getCursor()->incNBatches();
+                pinnedCursor.getCursor()->setNReturnedLastBatch(numResults);
 
                 // Fill out curop based on the results.
                 endQueryOp(opCtx, collection, *cursorExec, numResults, cursorId);
+
+                if (CursorPrefetcher::canPrefetch(opCtx, *pinnedCursor.getCursor())) {
+                    prefetchBatchSize = originalFC.getBatchSize().value_or(0);
+                }
             } else {
                 endQueryOp(opCtx, collection, *exec, numResults, cursorId);
             }
 
+            // Start producing the first getMore batch now that the cursor is no longer pinned.
+            if (prefetchBatchSize) {
+                CursorPrefetcher::get(opCtx)->schedule(cursorId, *prefetchBatchSize);
+            }
+
             // Generate the response object to send to the client.
             firstBatch.done(cursorId, nss.ns());
 
+            if (cacheLookup && cursorId == 0) {
+                QueryResultCache::get(opCtx).insert(
+                    opCtx,
+                    *cacheLookup,
+                    result->getBodyBuilder().asTempObj()["cursor"]["firstBatch"].Obj());
+            }
+
             // Increment this metric once we have generated a response and we know it will return
             // documents.
             auto& metricsCollector = ResourceConsumption::MetricsCollector::get(opCtx);
@@ -664,6 +786,106 @@ public:
         }
 
     private:
+        /**
+         * Answers an _id point read, for which isExpressIdLookupEligible() returned true, with a
+         * single lookup in the _id index. Returns false, having generated no reply, if the
+         * collection cannot be read this way and the regular find path must be used.
+         */
+        bool _runExpressIdLookup(OperationContext* opCtx,
+                                 const NamespaceString& nss,
+                                 const CollectionPtr& collection,
+                                 const FindCommandRequest& findCommand,
+                                 rpc::ReplyBuilderInterface* result) {
+            if (!collection) {
+                return false;
+            }
+            const auto indexCatalog = collection->getIndexCatalog();
+            const auto idIndex = indexCatalog->findIdIndex(opCtx);
+            if (!idIndex) {
+                return false;
+            }
+
+            FindCommon::waitInFindBeforeMakingBatch(opCtx, nss, findCommand.getFilter());
+
+            Snapshotted<BSONObj> doc;
+            bool found = false;
+            try {
+                const auto recordId = indexCatalog->getEntry(idIndex)->accessMethod()->findSingle(
+                    opCtx, collection, findCommand.getFilter()["_id"].wrap());
+                found = !recordId.isNull() && collection->findDoc(opCtx, recordId, &doc);
+            } catch (const WriteConflictException&) {
+                // The regular path yields and retries on write conflicts.
+                return false;
+            }
+
+            CursorResponseBuilder::Options options;
+            options.isInitialResponse = true;
+            if (!opCtx->inMultiDocumentTransaction()) {
+                options.atClusterTime = repl::ReadConcernArgs::get(opCtx).getArgsAtClusterTime();
+            }
+            CursorResponseBuilder firstBatch(result, options);
+            ResourceConsumption::DocumentUnitCounter docUnitsReturned;
+            if (found) {
+                auto obj = applySimpleInclusionProjection(doc.value(), findCommand.getProjection());
+                firstBatch.append(obj);
+                docUnitsReturned.observeOne(obj.objsize());
+            }
+
+            PlanSummaryStats summaryStats;
+            summaryStats.nReturned = found ? 1 : 0;
+            summaryStats.totalKeysExamined = found ? 1 : 0;
+            summaryStats.totalDocsExamined = found ? 1 : 0;
+            summaryStats.indexesUsed.insert(idIndex->indexName());
+
+            auto curOp = CurOp::get(opCtx);
+            {
+                stdx::lock_guard<Client> lk(*opCtx->getClient());
+                curOp->setPlanSummary_inlock("IDHACK"_sd);
+            }
+            curOp->debug().nreturned = summaryStats.nReturned;
+            curOp->debug().cursorid = -1;
+            curOp->debug().cursorExhausted = true;
+            curOp->debug().setPlanSummaryMetrics(summaryStats);
+            CollectionQueryInfo::get(collection).notifyOfQuery(opCtx, collection, summaryStats);
+
+            firstBatch.done(0, nss.ns());
+
+            ResourceConsumption::MetricsCollector::get(opCtx).incrementDocUnitsReturned(
+                docUnitsReturned);
+            return true;
+        }
+
+        /**
+         * Replies with a complete first batch taken from the query result cache, filling out curop
+         * as if the query had been executed.
+         */
+        void _replyFromQueryResultCache(OperationContext* opCtx,
+                                        const NamespaceString& nss,
+                                        const BSONObj& cachedBatch,
+                                        rpc::ReplyBuilderInterface* result) {
+            long long numResults = 0;
+            ResourceConsumption::DocumentUnitCounter docUnitsReturned;
+            for (auto&& doc : cachedBatch) {
+                docUnitsReturned.observeOne(doc.embeddedObject().objsize());
+                numResults++;
+            }
+
+            auto curOp = CurOp::get(opCtx);
+            {
+                stdx::lock_guard<Client> lk(*opCtx->getClient());
+                curOp->setPlanSummary_inlock("QUERY_RESULT_CACHE"_sd);
+            }
+            curOp->debug().nreturned = numResults;
+            curOp->debug().cursorid = -1;
+            curOp->debug().cursorExhausted = true;
+
+            auto bodyBuilder = result->getBodyBuilder();
+            appendCursorResponseObject(0, nss.ns(), BSONArray(cachedBatch), &bodyBuilder);
+
+            ResourceConsumption::MetricsCollector::get(opCtx).incrementDocUnitsReturned(
+                docUnitsReturned);
+        }
+
         const OpMsgRequest _request;
         const StringData _dbName;
     };
@@ -47,6 +47,7 @@
 #include "mongo/db/curop.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/cursor_manager.h"
+#include "mongo/db/cursor_prefetcher.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/pipeline/change_stream_invalidation_info.h"
@@ -59,7 +60,6 @@
 #include "mongo/db/read_concern.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/replication_coordinator.h"
-#include "mongo/db/repl/speculative_majority_read_info.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
@@ -142,53 +142,6 @@ void validateTxnNumber(OperationContext* opCtx, int64_t cursorId, ClientCursor*
                 (*opCtx->getTxnNumber() == *cursor->getTxnNumber()));
 }
 
-/**
- * Apply the read concern from the cursor to this operation.
- */
-void applyCursorReadConcern(OperationContext* opCtx, repl::ReadConcernArgs rcArgs) {
-    const auto replicationMode = repl::ReplicationCoordinator::get(opCtx)->getReplicationMode();
-
-    // Select the appropriate read source. If we are in a transaction with read concern majority,
-    // this will already be set to kNoTimestamp, so don't set it again.
-    if (replicationMode == repl::ReplicationCoordinator::modeReplSet &&
-        rcArgs.getLevel() == repl::ReadConcernLevel::kMajorityReadConcern &&
-        !opCtx->inMultiDocumentTransaction()) {
-        switch (rcArgs.getMajorityReadMechanism()) {
-            case repl::ReadConcernArgs::MajorityReadMechanism::kMajoritySnapshot: {
-                // Make sure we read from the majority snapshot.
-                opCtx->recoveryUnit()->setTimestampReadSource(
-                    RecoveryUnit::ReadSource::kMajorityCommitted);
-                uassertStatusOK(opCtx->recoveryUnit()->majorityCommittedSnapshotAvailable());
-                break;
-            }
-            case repl::ReadConcernArgs::MajorityReadMechanism::kSpeculative: {
-                // Mark the operation as speculative and select the correct read source.
-                repl::SpeculativeMajorityReadInfo::get(opCtx).setIsSpeculativeRead();
-                opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kNoOverlap);
-                break;
-            }
-        }
-    }
-
-    if (replicationMode == repl::ReplicationCoordinator::modeReplSet &&
-        rcArgs.getLevel() == repl::ReadConcernLevel::kSnapshotReadConcern &&
-        !opCtx->inMultiDocumentTransaction()) {
-        auto atClusterTime = rcArgs.getArgsAtClusterTime();
-        invariant(atClusterTime && *atClusterTime != LogicalTime::kUninitialized);
-        opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kProvided,
-                                                      atClusterTime->asTimestamp());
-    }
-
-    // For cursor commands that take locks internally, the read concern on the
-    // OperationContext may affect the timestamp read source selected by the storage engine.
-    // We place the cursor read concern onto the OperationContext so the lock acquisition
-    // respects the cursor's read concern.
-    {
-        stdx::lock_guard<Client> lk(*opCtx->getClient());
-        repl::ReadConcernArgs::get(opCtx) = rcArgs;
-    }
-}
-
 /**
  * Sets a deadline on the operation if the originating command had a maxTimeMS specified or if this
  * is a tailable, awaitData cursor.
@@ -327,9 +280,29 @@ public:
             // an interrupt point, we just continue as normal and return rather than reporting a
             // timeout to the user.
             BSONObj obj;
-            PlanExecutor::ExecState state;
+            PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
+            auto adaptiveBatch = AdaptiveBatchSizer::make(cmd.getBatchSize());
+            auto enoughForGetMore = [&] {
+                return adaptiveBatch
+                    ? adaptiveBatch->enough(*numResults, nextBatch->bytesUsed())
+                    : FindCommon::enoughForGetMore(cmd.getBatchSize().value_or(0), *numResults);
+            };
             try {
-                while (!FindCommon::enoughForGetMore(cmd.getBatchSize().value_or(0), *numResults) &&
+                // Hand out the results prefetched since the previous batch before resuming the
+                // executor. A prefetched result which does not fit is kept for the next getMore.
+                while (cursor->hasPrefetchedResults() && !enoughForGetMore()) {
+                    obj = cursor->popPrefetchedResult();
+                    if (!FindCommon::haveSpaceForNext(obj, *numResults, nextBatch->bytesUsed())) {
+                        cursor->returnPrefetchedResult(std::move(obj));
+                        break;
+                    }
+
+                    nextBatch->append(obj);
+                    (*numResults)++;
+                    docUnitsReturned->observeOne(obj.objsize());
+                }
+
+                while (!cursor->hasPrefetchedResults() && !enoughForGetMore() &&
                        PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr))) {
                     // If adding this object will cause us to exceed the message size limit, then we
                     // stash it for later.
@@ -386,7 +359,7 @@ public:
                 nextBatch->setPostBatchResumeToken(exec->getPostBatchResumeToken());
             }
 
-            return shouldSaveCursorGetMore(exec, isTailable);
+            return cursor->hasPrefetchedResults() || shouldSaveCursorGetMore(exec, isTailable);
         }
 
         void acquireLocksAndIterateCursor(OperationContext* opCtx,
@@ -689,6 +662,7 @@ public:
             metricsCollector.incrementDocUnitsReturned(docUnitsReturned);
             cursorPin->incNReturnedSoFar(numResults);
             cursorPin->incNBatches();
+            cursorPin->setNReturnedLastBatch(numResults);
 
             // Ensure log and profiler include the number of results returned in this getMore's
             // response batch.
@@ -696,6 +670,7 @@ public:
 
             if (respondWithId) {
                 cursorFreer.dismiss();
+                _prefetchNextBatch = CursorPrefetcher::canPrefetch(opCtx, *cursorPin.getCursor());
 
                 if (opCtx->isExhaust()) {
                     // Indicate that an exhaust message should be generated and the previous BSONObj
@@ -733,6 +708,9 @@ public:
                 opCtx->lockState()->skipAcquireTicket();
             }
 
+            // A prefetch of this batch holds the cursor pinned until it completes.
+            CursorPrefetcher::get(opCtx)->waitForPrefetch(opCtx, cursorId);
+
             auto cursorManager = CursorManager::get(opCtx);
             auto cursorPin = uassertStatusOK(cursorManager->pinCursor(opCtx, cursorId));
 
@@ -770,6 +748,13 @@ public:
                     "waitBeforeUnpinningOrDeletingCursorAfterGetMoreBatch");
             }
 
+            // Start producing the next batch while the client consumes this one. This requires the
+            // cursor to be unpinned first.
+            if (_prefetchNextBatch) {
+                cursorPin.release();
+                CursorPrefetcher::get(opCtx)->schedule(cursorId, _cmd.getBatchSize().value_or(0));
+            }
+
             if (getTestCommandsEnabled()) {
                 validateResult(reply);
             }
@@ -781,6 +766,9 @@ public:
         }
 
         const GetMoreCommandRequest _cmd;
+
+        // Whether the next batch of the cursor should be prefetched once it is unpinned.
+        bool _prefetchNextBatch = false;
     };
 
     bool maintenanceOk() const override {
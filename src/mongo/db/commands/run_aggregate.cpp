@@ -55,6 +55,7 @@
 #include "mongo/db/pipeline/document_source_geo_near.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/parallel_pipeline_prefix.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/pipeline_d.h"
 #include "mongo/db/pipeline/plan_executor_pipeline.h"
@@ -789,60 +790,76 @@ Status runAggregate(OperationContext* opCtx,
         auto hasGeoNearStage = !pipeline->getSources().empty() &&
             dynamic_cast<DocumentSourceGeoNear*>(pipeline->peekFront());
 
-        // Prepare a PlanExecutor to provide input into the pipeline, if needed.
-        std::pair<PipelineD::AttachExecutorCallback,
-                  std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>>
-            attachExecutorCallback;
-        if (liteParsedPipeline.hasChangeStream()) {
-            // If we are using a change stream, the cursor stage should have a simple collation,
-            // regardless of what the user's collation was.
-            std::unique_ptr<CollatorInterface> collatorForCursor = nullptr;
-            auto collatorStash = expCtx->temporarilyChangeCollator(std::move(collatorForCursor));
-            attachExecutorCallback =
-                PipelineD::buildInnerQueryExecutor(collection, nss, &request, pipeline.get());
-        } else {
-            attachExecutorCallback =
-                PipelineD::buildInnerQueryExecutor(collection, nss, &request, pipeline.get());
-        }
-
-        if (canOptimizeAwayPipeline(pipeline.get(),
-                                    attachExecutorCallback.second.get(),
-                                    request,
-                                    hasGeoNearStage,
-                                    liteParsedPipeline.hasChangeStream())) {
-            // This pipeline is currently empty, but once completed it will have only one source,
-            // which is a DocumentSourceCursor. Instead of creating a whole pipeline to do nothing
-            // more than forward the results of its cursor document source, we can use the
-            // PlanExecutor by itself. The resulting cursor will look like what the client would
-            // have gotten from find command.
-            execs.emplace_back(std::move(attachExecutorCallback.second));
+        // Run the leading stages of the pipeline on several threads over ranges of the collection,
+        // if the pipeline allows it, so that only its merging half remains to run here.
+        auto parallelPrefix =
+            ParallelPipelinePrefix::splitIfEligible(opCtx, collection, request, pipeline.get());
+        if (parallelPrefix) {
+            // The workers take their own collection locks.
+            ctx.reset();
+            pipeline->addInitialSource(parallelPrefix->run(opCtx));
+            execs.emplace_back(plan_executor_factory::make(
+                expCtx,
+                std::move(pipeline),
+                aggregation_request_helper::getResumableScanType(request, false)));
         } else {
-            // Complete creation of the initial $cursor stage, if needed.
-            PipelineD::attachInnerQueryExecutorToPipeline(collection,
-                                                          attachExecutorCallback.first,
-                                                          std::move(attachExecutorCallback.second),
-                                                          pipeline.get());
-
-            auto pipelines =
-                createExchangePipelinesIfNeeded(opCtx, expCtx, request, std::move(pipeline), uuid);
-            for (auto&& pipelineIt : pipelines) {
-                // There are separate ExpressionContexts for each exchange pipeline, so make sure to
-                // pass the pipeline's ExpressionContext to the plan executor factory.
-                auto pipelineExpCtx = pipelineIt->getContext();
-
-                execs.emplace_back(plan_executor_factory::make(
-                    std::move(pipelineExpCtx),
-                    std::move(pipelineIt),
-                    aggregation_request_helper::getResumableScanType(
-                        request, liteParsedPipeline.hasChangeStream())));
+            // Prepare a PlanExecutor to provide input into the pipeline, if needed.
+            std::pair<PipelineD::AttachExecutorCallback,
+                      std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>>
+                attachExecutorCallback;
+            if (liteParsedPipeline.hasChangeStream()) {
+                // If we are using a change stream, the cursor stage should have a simple
+                // collation, regardless of what the user's collation was.
+                std::unique_ptr<CollatorInterface> collatorForCursor = nullptr;
+                auto collatorStash =
+                    expCtx->temporarilyChangeCollator(std::move(collatorForCursor));
+                attachExecutorCallback =
+                    PipelineD::buildInnerQueryExecutor(collection, nss, &request, pipeline.get());
+            } else {
+                attachExecutorCallback =
+                    PipelineD::buildInnerQueryExecutor(collection, nss, &request, pipeline.get());
             }
 
-            // With the pipelines created, we can relinquish locks as they will manage the locks
-            // internally further on. We still need to keep the lock for an optimized away pipeline
-            // though, as we will be changing its lock policy to 'kLockExternally' (see details
-            // below), and in order to execute the initial getNext() call in 'handleCursorCommand',
-            // we need to hold the collection lock.
-            ctx.reset();
+            if (canOptimizeAwayPipeline(pipeline.get(),
+                                        attachExecutorCallback.second.get(),
+                                        request,
+                                        hasGeoNearStage,
+                                        liteParsedPipeline.hasChangeStream())) {
+                // This pipeline is currently empty, but once completed it will have only one
+                // source, which is a DocumentSourceCursor. Instead of creating a whole pipeline to
+                // do nothing more than forward the results of its cursor document source, we can
+                // use the PlanExecutor by itself. The resulting cursor will look like what the
+                // client would have gotten from find command.
+                execs.emplace_back(std::move(attachExecutorCallback.second));
+            } else {
+                // Complete creation of the initial $cursor stage, if needed.
+                PipelineD::attachInnerQueryExecutorToPipeline(
+                    collection,
+                    attachExecutorCallback.first,
+                    std::move(attachExecutorCallback.second),
+                    pipeline.get());
+
+                auto pipelines = createExchangePipelinesIfNeeded(
+                    opCtx, expCtx, request, std::move(pipeline), uuid);
+                for (auto&& pipelineIt : pipelines) {
+                    // There are separate ExpressionContexts for each exchange pipeline, so make
+                    // sure to pass the pipeline's ExpressionContext to the plan executor factory.
+                    auto pipelineExpCtx = pipelineIt->getContext();
+
+                    execs.emplace_back(plan_executor_factory::make(
+                        std::move(pipelineExpCtx),
+                        std::move(pipelineIt),
+                        aggregation_request_helper::getResumableScanType(
+                            request, liteParsedPipeline.hasChangeStream())));
+                }
+
+                // With the pipelines created, we can relinquish locks as they will manage the
+                // locks internally further on. We still need to keep the lock for an optimized
+                // away pipeline though, as we will be changing its lock policy to
+                // 'kLockExternally' (see details below), and in order to execute the initial
+                // getNext() call in 'handleCursorCommand', we need to hold the collection lock.
+                ctx.reset();
+            }
         }
 
         {
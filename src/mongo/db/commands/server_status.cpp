@@ -40,6 +40,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/util/net/http_client.h"
 #include "mongo/util/net/socket_utils.h"
+#include "mongo/util/periodic_runner.h"
 #include "mongo/util/version.h"
 
 namespace mongo {
@@ -124,7 +125,7 @@ public:
                 continue;
             }
 
-            section->appendSection(opCtx, elem, &result);
+            section->appendSectionWithCaching(opCtx, elem, &result);
             timeBuilder.appendNumber(
                 static_cast<string>(str::stream() << "after " << section->getSectionName()),
                 durationCount<Milliseconds>(clock->now() - runStart));
@@ -201,6 +202,28 @@ ServerStatusSection::ServerStatusSection(const string& sectionName) : _sectionNa
     CmdServerStatusInstantiator::getInstance().addSection(this);
 }
 
+void ServerStatusSection::appendSectionWithCaching(OperationContext* opCtx,
+                                                   const BSONElement& configElement,
+                                                   BSONObjBuilder* result) const {
+    const auto maxStaleness = getMaxStaleness();
+
+    // Options given for the section may change its contents, so only the default form is reused.
+    if (maxStaleness <= Milliseconds(0) || configElement.isABSONObj()) {
+        appendSection(opCtx, configElement, result);
+        return;
+    }
+
+    const auto clock = opCtx->getServiceContext()->getFastClockSource();
+    stdx::lock_guard<Latch> lk(_cacheMutex);
+    if (clock->now() - _cachedAt > maxStaleness) {
+        BSONObjBuilder fields;
+        appendSection(opCtx, configElement, &fields);
+        _cachedFields = fields.obj();
+        _cachedAt = clock->now();
+    }
+    result->appendElements(_cachedFields);
+}
+
 OpCounterServerStatusSection::OpCounterServerStatusSection(const string& sectionName,
                                                            OpCounters* counters)
     : ServerStatusSection(sectionName), _counters(counters) {}
@@ -295,6 +318,24 @@ public:
     }
 } httpClientServerStatus;
 
+class PeriodicJobsServerStatus : public ServerStatusSection {
+public:
+    PeriodicJobsServerStatus() : ServerStatusSection("periodicJobs") {}
+
+    bool includeByDefault() const final {
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const final {
+        BSONObjBuilder bob;
+        if (auto runner = opCtx->getServiceContext()->getPeriodicRunner()) {
+            runner->appendStats(&bob);
+        }
+        return bob.obj();
+    }
+} periodicJobsServerStatus;
+
 }  // namespace
 
 }  // namespace mongo
@@ -33,6 +33,8 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/duration.h"
 #include <string>
 
 namespace mongo {
@@ -103,8 +105,31 @@ public:
         result->append(getSectionName(), ret);
     }
 
+    /**
+     * How old a previously generated copy of this section may be when it is requested without
+     * section-specific options. Sections that are expensive to generate can return a positive
+     * duration so that serverStatus callers arriving close together, such as FTDC and monitoring
+     * agents, share one copy. The default of zero generates the section on every call.
+     */
+    virtual Milliseconds getMaxStaleness() const {
+        return Milliseconds(0);
+    }
+
+    /**
+     * Appends the section through appendSection(), or from the copy generated by an earlier call
+     * if getMaxStaleness() allows it. Concurrent callers wait for a single generation.
+     */
+    void appendSectionWithCaching(OperationContext* opCtx,
+                                  const BSONElement& configElement,
+                                  BSONObjBuilder* result) const;
+
 private:
     const std::string _sectionName;
+
+    // The fields appended by the most recent generation, when getMaxStaleness() is positive.
+    mutable Mutex _cacheMutex = MONGO_MAKE_LATCH("ServerStatusSection::_cacheMutex");
+    mutable BSONObj _cachedFields;
+    mutable Date_t _cachedAt;
 };
 
 class OpCounterServerStatusSection : public ServerStatusSection {
@@ -40,6 +40,12 @@
 #include "mongo/util/net/socket_utils.h"
 #include "mongo/util/net/ssl_manager.h"
 
+#include <fstream>
+
+#if MONGO_CONFIG_SSL_PROVIDER == MONGO_CONFIG_SSL_PROVIDER_OPENSSL
+#include <openssl/opensslv.h>
+#endif
+
 namespace mongo {
 
 using std::endl;
@@ -108,6 +114,41 @@ public:
 
 } network;
 
+#ifdef MONGO_CONFIG_SSL
+/**
+ * Reports whether this host could offload TLS record encryption to the kernel (kTLS): the kernel
+ * must expose the "tls" TCP upper-layer protocol and the TLS library must be built with kTLS.
+ * Sessions do not currently use the offload, since the ASIO TLS engine exchanges records with
+ * OpenSSL through a memory BIO pair rather than handing it the socket.
+ */
+void appendKernelTLSSupport(BSONObjBuilder* builder) {
+    static const bool kernelSupport = [] {
+#ifdef __linux__
+        std::ifstream ulps("/proc/sys/net/ipv4/tcp_available_ulp");
+        std::string ulp;
+        while (ulps >> ulp) {
+            if (ulp == "tls")
+                return true;
+        }
+#endif
+        return false;
+    }();
+
+    constexpr bool librarySupport =
+#if MONGO_CONFIG_SSL_PROVIDER == MONGO_CONFIG_SSL_PROVIDER_OPENSSL && \
+    OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(OPENSSL_NO_KTLS)
+        true;
+#else
+        false;
+#endif
+
+    BSONObjBuilder kernelTLS(builder->subobjStart("kernelTLS"));
+    kernelTLS.append("kernelSupport", kernelSupport);
+    kernelTLS.append("librarySupport", librarySupport);
+    kernelTLS.append("offloadActive", false);
+}
+#endif
+
 class Security : public ServerStatusSection {
 public:
     Security() : ServerStatusSection("security") {}
@@ -131,6 +172,7 @@ public:
                 ->getSSLConfiguration()
                 .getServerStatusBSON(&result);
         }
+        appendKernelTLSSupport(&result);
 #endif
 
         return result.obj();
@@ -69,6 +69,9 @@ stdx::condition_variable _validationNotifier;
  *       validate: "collectionNameWithoutTheDBPart",
  *       full: <bool>  // If true, a more thorough (and slower) collection validation is performed.
  *       background: <bool>  // If true, performs validation on the checkpoint of the collection.
+ *       maxRecords: <number>  // If set, validates at most this many records and their index keys.
+ *       resumeAfter: <token>  // If set, validates the records after the 'nextResumeAfter' token
+ *                             // returned by a previous incremental validation.
  *   }
  */
 class ValidateCmd : public BasicCommand {
@@ -85,6 +88,9 @@ public:
                              << "\tAdd {full: true} option to do a more thorough check.\n"
                              << "\tAdd {background: true} to validate in the background.\n"
                              << "\tAdd {repair: true} to run repair mode.\n"
+                             << "\tAdd {maxRecords: <n>} to validate a slice of the collection, "
+                             << "and {resumeAfter: <nextResumeAfter>} to continue from the end of "
+                             << "the previous slice.\n"
                              << "Cannot specify both {full: true, background: true}.";
     }
 
@@ -159,6 +165,32 @@ public:
                           << "Running the validate command with both {enforceFastCount: true }"
                           << " and { repair: true } is not supported.");
         }
+
+        boost::optional<CollectionValidation::ValidateRange> range;
+        if (cmdObj.hasField("maxRecords") || cmdObj.hasField("resumeAfter")) {
+            if (fullValidate || enforceFastCount || repair) {
+                uasserted(ErrorCodes::CommandNotSupported,
+                          str::stream() << "Running the validate command with { maxRecords } or "
+                                        << "{ resumeAfter } is not supported together with "
+                                        << "{ full: true }, { enforceFastCount: true } or "
+                                        << "{ repair: true }.");
+            }
+
+            range.emplace();
+            if (auto maxRecords = cmdObj["maxRecords"]) {
+                uassert(ErrorCodes::TypeMismatch,
+                        "The 'maxRecords' option must be a number",
+                        maxRecords.isNumber());
+                uassert(ErrorCodes::BadValue,
+                        "The 'maxRecords' option must be positive",
+                        maxRecords.safeNumberLong() > 0);
+                range->maxRecords = maxRecords.safeNumberLong();
+            }
+            if (auto resumeAfter = cmdObj["resumeAfter"]) {
+                range->resumeAfter = RecordId::deserializeToken(resumeAfter);
+            }
+        }
+
         repl::ReplicationCoordinator* replCoord = repl::ReplicationCoordinator::get(opCtx);
         if (repair && replCoord->isReplEnabled()) {
             uasserted(ErrorCodes::CommandNotSupported,
@@ -174,7 +206,8 @@ public:
                   "background"_attr = background,
                   "full"_attr = fullValidate,
                   "enforceFastCount"_attr = enforceFastCount,
-                  "repair"_attr = repair);
+                  "repair"_attr = repair,
+                  "incremental"_attr = range.has_value());
         }
 
         // Only one validation per collection can be in progress, the rest wait.
@@ -212,6 +245,11 @@ public:
         }();
 
         auto repairMode = [&] {
+            // Multikey adjustments depend on seeing every document, so incremental validation
+            // never repairs.
+            if (range) {
+                return CollectionValidation::RepairMode::kNone;
+            }
             switch (mode) {
                 case CollectionValidation::ValidateMode::kForeground:
                 case CollectionValidation::ValidateMode::kForegroundFull:
@@ -238,7 +276,14 @@ public:
 
         ValidateResults validateResults;
         Status status =
-            CollectionValidation::validate(opCtx, nss, mode, repairMode, &validateResults, &result);
+            CollectionValidation::validate(opCtx,
+                                           nss,
+                                           mode,
+                                           repairMode,
+                                           &validateResults,
+                                           &result,
+                                           /*turnOnExtraLoggingForTest=*/false,
+                                           range);
         if (!status.isOK()) {
             return CommandHelpers::appendCommandStatusNoThrow(result, status);
         }
@@ -27,6 +27,8 @@
  *    it in the license file.
  */
 
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
 #include "mongo/base/checked_cast.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/mutable/document.h"
@@ -40,6 +42,7 @@
 #include "mongo/db/commands/write_commands_common.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/dbhelpers.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/doc_validation_error.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
@@ -65,15 +68,19 @@
 #include "mongo/db/storage/duplicate_key_error_info.h"
 #include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/timeseries/bucket_catalog.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
 #include "mongo/db/timeseries/timeseries_index_schema_conversion_functions.h"
 #include "mongo/db/timeseries/timeseries_update_delete_util.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/db/write_concern.h"
+#include "mongo/logv2/log.h"
 #include "mongo/logv2/redaction.h"
 #include "mongo/s/stale_exception.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/string_map.h"
+#include "mongo/util/visit_helper.h"
 
 namespace mongo {
 namespace {
@@ -123,9 +130,6 @@ bool isTimeseries(OperationContext* opCtx, const NamespaceString& ns) {
         .get();
 }
 
-// Default for control.version in time-series bucket collection.
-const int kTimeseriesControlVersion = 1;
-
 /**
  * Transforms a single time-series insert to an update request on an existing bucket.
  */
@@ -222,7 +226,8 @@ BSONObj makeTimeseriesInsertDocument(std::shared_ptr<BucketCatalog::WriteBatch>
     builder.append("_id", batch->bucket()->id());
     {
         BSONObjBuilder bucketControlBuilder(builder.subobjStart("control"));
-        bucketControlBuilder.append("version", kTimeseriesControlVersion);
+        bucketControlBuilder.append(timeseries::kBucketControlVersionFieldName,
+                                    timeseries::kTimeseriesControlDefaultVersion);
         bucketControlBuilder.append("min", batch->min());
         bucketControlBuilder.append("max", batch->max());
     }
@@ -239,6 +244,78 @@ BSONObj makeTimeseriesInsertDocument(std::shared_ptr<BucketCatalog::WriteBatch>
     return builder.obj();
 }
 
+/**
+ * Replaces a closed bucket with its compressed version. The replacement is performed on a separate
+ * client so that it does not take part in the retryable write or transaction of the insert that
+ * closed the bucket. Compression is best-effort, the bucket is left uncompressed on failure.
+ */
+void compressClosedBucket(OperationContext* opCtx,
+                          const NamespaceString& bucketsNs,
+                          const BucketCatalog::ClosedBucket& closedBucket) {
+    if (!feature_flags::gTimeseriesBucketCompression.isEnabled(
+            serverGlobalParams.featureCompatibility)) {
+        return;
+    }
+
+    auto client = opCtx->getServiceContext()->makeClient("timeseries-bucket-compression");
+    AlternativeClientRegion acr(client);
+    auto compressionOpCtx = cc().makeOperationContext();
+
+    try {
+        BSONObj bucketDoc;
+        {
+            AutoGetCollectionForRead coll(compressionOpCtx.get(), bucketsNs);
+            if (!coll) {
+                return;
+            }
+            auto rid = Helpers::findById(compressionOpCtx.get(),
+                                         coll.getCollection(),
+                                         BSON(timeseries::kBucketIdFieldName
+                                              << closedBucket.bucketId));
+            if (rid.isNull()) {
+                return;
+            }
+            bucketDoc = coll->docFor(compressionOpCtx.get(), rid).value().getOwned();
+        }
+
+        auto compressed = timeseries::compressBucket(bucketDoc, closedBucket.timeField);
+        if (!compressed) {
+            return;
+        }
+
+        // Only replace the bucket if it was not modified since it was read, so that concurrent
+        // updates to the bucket are not lost.
+        BSONObjBuilder queryBuilder;
+        queryBuilder.append(bucketDoc[timeseries::kBucketIdFieldName]);
+        queryBuilder.append(bucketDoc[timeseries::kBucketControlFieldName]);
+        if (auto meta = bucketDoc[timeseries::kBucketMetaFieldName]) {
+            queryBuilder.append(meta);
+        }
+
+        write_ops::UpdateCommandRequest op(
+            bucketsNs,
+            {write_ops::UpdateOpEntry(
+                queryBuilder.obj(),
+                write_ops::UpdateModification::parseFromClassicUpdate(*compressed))});
+        write_ops::WriteCommandRequestBase base;
+        base.setBypassDocumentValidation(true);
+        op.setWriteCommandRequestBase(std::move(base));
+
+        auto result = write_ops_exec::performUpdates(
+            compressionOpCtx.get(), op, OperationSource::kTimeseriesInsert);
+        for (auto&& singleResult : result.results) {
+            uassertStatusOK(singleResult.getStatus());
+        }
+    } catch (const DBException& ex) {
+        LOGV2_DEBUG(6100007,
+                    1,
+                    "Failed to compress closed time-series bucket",
+                    "bucketId"_attr = closedBucket.bucketId,
+                    "namespace"_attr = bucketsNs,
+                    "error"_attr = redact(ex.toStatus()));
+    }
+}
+
 /**
  * Returns true if the time-series write is retryable.
  */
@@ -689,8 +766,13 @@ public:
 
             getOpTimeAndElectionId(opCtx, opTime, electionId);
 
-            bucketCatalog.finish(batch, BucketCatalog::CommitInfo{*opTime, *electionId});
+            auto closedBucket =
+                bucketCatalog.finish(batch, BucketCatalog::CommitInfo{*opTime, *electionId});
             batchGuard.dismiss();
+
+            if (closedBucket) {
+                compressClosedBucket(opCtx, ns().makeTimeseriesBucketsNamespace(), *closedBucket);
+            }
         }
 
         bool _commitTimeseriesBucketsAtomically(OperationContext* opCtx,
@@ -754,8 +836,14 @@ public:
             getOpTimeAndElectionId(opCtx, opTime, electionId);
 
             for (auto batch : batchesToCommit) {
-                bucketCatalog.finish(batch, BucketCatalog::CommitInfo{*opTime, *electionId});
+                auto closedBucket =
+                    bucketCatalog.finish(batch, BucketCatalog::CommitInfo{*opTime, *electionId});
                 batch.get().reset();
+
+                if (closedBucket) {
+                    compressClosedBucket(
+                        opCtx, ns().makeTimeseriesBucketsNamespace(), *closedBucket);
+                }
             }
 
             return true;
@@ -812,11 +900,15 @@ public:
                     errors->push_back(*error);
                     return false;
                 } else {
-                    const auto& batch = result.getValue();
+                    const auto& batch = result.getValue().batch;
                     batches.emplace_back(batch, index);
                     if (isTimeseriesWriteRetryable(opCtx)) {
                         stmtIds[batch->bucket()].push_back(stmtId);
                     }
+
+                    for (auto&& closedBucket : result.getValue().closedBuckets) {
+                        compressClosedBucket(opCtx, bucketsNs, closedBucket);
+                    }
                 }
 
                 return true;
@@ -1395,5 +1487,160 @@ public:
     };
 } cmdDelete;
 
+/**
+ * Executes a sequence of insert, update and delete commands, each of which may target a different
+ * collection in the database, as a single command:
+ *   {
+ *       bulkWrite: 1,
+ *       ops: [{insert: <coll>, documents: [...]}, {update: <coll>, updates: [...]}, ...],
+ *       ordered: <bool>
+ *   }
+ * The reply holds the reply of each write command executed, in order.
+ */
+class CmdBulkWrite final : public TypedCommand<CmdBulkWrite> {
+public:
+    using Request = write_ops::BulkWriteCommandRequest;
+    using Reply = write_ops::BulkWriteCommandReply;
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const final {
+        return AllowedOnSecondary::kNever;
+    }
+
+    void snipForLogging(mutablebson::Document* cmdObj) const final {
+        redactTooLongLog(cmdObj, "ops");
+    }
+
+    std::string help() const final {
+        return "execute insert, update and delete commands on one or more collections";
+    }
+
+    ReadWriteType getReadWriteType() const final {
+        return Command::ReadWriteType::kWrite;
+    }
+
+    bool collectsResourceConsumptionMetrics() const final {
+        return true;
+    }
+
+    class Invocation final : public InvocationBase {
+    public:
+        Invocation(OperationContext* opCtx,
+                   const Command* command,
+                   const OpMsgRequest& opMsgRequest)
+            : InvocationBase(opCtx, command, opMsgRequest),
+              _writeCommands(BulkWriteOp::parse(request(), opCtx->getTxnNumber().has_value())) {}
+
+        bool supportsWriteConcern() const final {
+            return true;
+        }
+
+        NamespaceString ns() const final {
+            return NamespaceString(request().getDbName());
+        }
+
+        Reply typedRun(OperationContext* opCtx) try {
+            std::vector<BSONObj> results;
+            for (const auto& writeCommand : _writeCommands) {
+                auto result = stdx::visit([&](const auto& op) { return _runWrite(opCtx, op); },
+                                          writeCommand);
+                const bool hasWriteErrors = result.hasField("writeErrors");
+                results.push_back(std::move(result));
+                if (hasWriteErrors && request().getOrdered()) {
+                    break;
+                }
+            }
+
+            Reply reply;
+            reply.setResults(std::move(results));
+            return reply;
+        } catch (const DBException& ex) {
+            NotPrimaryErrorTracker::get(opCtx->getClient()).recordError(ex.code());
+            throw;
+        }
+
+    private:
+        void doCheckAuthorization(OperationContext* opCtx) const final try {
+            auto authSession = AuthorizationSession::get(opCtx->getClient());
+            for (const auto& writeCommand : _writeCommands) {
+                stdx::visit(
+                    visit_helper::Overloaded{
+                        [&](const write_ops::InsertCommandRequest& op) {
+                            auth::checkAuthForInsertCommand(
+                                authSession, op.getBypassDocumentValidation(), op);
+                        },
+                        [&](const write_ops::UpdateCommandRequest& op) {
+                            auth::checkAuthForUpdateCommand(
+                                authSession, op.getBypassDocumentValidation(), op);
+                        },
+                        [&](const write_ops::DeleteCommandRequest& op) {
+                            auth::checkAuthForDeleteCommand(
+                                authSession, op.getBypassDocumentValidation(), op);
+                        }},
+                    writeCommand);
+            }
+        } catch (const DBException& ex) {
+            NotPrimaryErrorTracker::get(opCtx->getClient()).recordError(ex.code());
+            throw;
+        }
+
+        template <typename WriteCommandRequest>
+        void _checkNamespace(OperationContext* opCtx, const WriteCommandRequest& op) {
+            transactionChecks(opCtx, op.getNamespace());
+            uassert(6000148,
+                    str::stream() << "bulkWrite does not support writes to time-series collection "
+                                  << op.getNamespace(),
+                    !isTimeseries(opCtx, op.getNamespace()));
+        }
+
+        BSONObj _runWrite(OperationContext* opCtx, const write_ops::InsertCommandRequest& op) {
+            _checkNamespace(opCtx, op);
+            write_ops::InsertCommandReply insertReply;
+            populateReply(opCtx,
+                          !op.getWriteCommandRequestBase().getOrdered(),
+                          op.getDocuments().size(),
+                          write_ops_exec::performInserts(opCtx, op),
+                          &insertReply);
+            return insertReply.toBSON();
+        }
+
+        BSONObj _runWrite(OperationContext* opCtx, const write_ops::UpdateCommandRequest& op) {
+            _checkNamespace(opCtx, op);
+            write_ops::UpdateCommandReply updateReply;
+            long long nModified = 0;
+            std::vector<write_ops::Upserted> upsertedInfoVec;
+            auto singleWriteHandler = [&](const SingleWriteResult& opResult, int index) {
+                nModified += opResult.getNModified();
+                if (auto idElement = opResult.getUpsertedId().firstElement())
+                    upsertedInfoVec.emplace_back(write_ops::Upserted(index, idElement));
+            };
+            auto postProcessHandler = [&]() {
+                updateReply.setNModified(nModified);
+                if (!upsertedInfoVec.empty())
+                    updateReply.setUpserted(std::move(upsertedInfoVec));
+            };
+            populateReply(opCtx,
+                          !op.getWriteCommandRequestBase().getOrdered(),
+                          op.getUpdates().size(),
+                          write_ops_exec::performUpdates(opCtx, op),
+                          &updateReply,
+                          PopulateReplyHooks{singleWriteHandler, postProcessHandler});
+            return updateReply.toBSON();
+        }
+
+        BSONObj _runWrite(OperationContext* opCtx, const write_ops::DeleteCommandRequest& op) {
+            _checkNamespace(opCtx, op);
+            write_ops::DeleteCommandReply deleteReply;
+            populateReply(opCtx,
+                          !op.getWriteCommandRequestBase().getOrdered(),
+                          op.getDeletes().size(),
+                          write_ops_exec::performDeletes(opCtx, op),
+                          &deleteReply);
+            return deleteReply.toBSON();
+        }
+
+        const std::vector<BulkWriteOp::WriteCommandRequest> _writeCommands;
+    };
+} cmdBulkWrite;
+
 }  // namespace
 }  // namespace mongo
@@ -32,6 +32,10 @@
 #include <benchmark/benchmark.h>
 
 #include "mongo/base/string_data.h"
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/operation_context_gen.h"
+#include "mongo/db/service_context.h"
 #include "mongo/idl/command_generic_argument.h"
 
 namespace mongo {
@@ -70,9 +74,52 @@ void BM_IsReplyStripArgument(benchmark::State& state) {
     }
 }
 
+void BM_CheckForInterrupt(benchmark::State& state) {
+    const auto originalInterval = gOperationInterruptCheckInterval.load();
+    gOperationInterruptCheckInterval.store(state.range());
+
+    auto service = ServiceContext::make();
+    auto client = service->makeClient("BM_CheckForInterrupt");
+    auto opCtx = client->makeOperationContext();
+    opCtx->setDeadlineAfterNowBy(Hours{1}, ErrorCodes::ExceededTimeLimit);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(opCtx->checkForInterruptNoAssert());
+    }
+    state.counters["fullChecks"] = benchmark::Counter(opCtx->getNumFullInterruptChecks(),
+                                                      benchmark::Counter::kAvgIterations);
+
+    gOperationInterruptCheckInterval.store(originalInterval);
+}
+
+// Measures the per-operation cost of creating and destroying an OperationContext, which is
+// dominated by constructing its decorations.
+void BM_MakeOperationContext(benchmark::State& state) {
+    auto service = ServiceContext::make();
+    auto client = service->makeClient("BM_MakeOperationContext");
+
+    for (auto _ : state) {
+        auto opCtx = client->makeOperationContext();
+        benchmark::DoNotOptimize(opCtx.get());
+    }
+}
+
+// Measures the cost of creating and destroying a Client along with its decorations.
+void BM_MakeClient(benchmark::State& state) {
+    auto service = ServiceContext::make();
+
+    for (auto _ : state) {
+        auto client = service->makeClient("BM_MakeClient");
+        benchmark::DoNotOptimize(client.get());
+    }
+}
+
 BENCHMARK(BM_IsGeneric)->DenseRange(0, keys.size() - 1);
 BENCHMARK(BM_IsRequestStripArgument)->DenseRange(0, keys.size() - 1);
 BENCHMARK(BM_IsReplyStripArgument)->DenseRange(0, keys.size() - 1);
+BENCHMARK(BM_CheckForInterrupt)->Arg(1)->Arg(16)->Arg(128);
+BENCHMARK(BM_MakeOperationContext);
+BENCHMARK(BM_MakeClient);
 
 }  // namespace
 }  // namespace mongo
@@ -46,6 +46,7 @@
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/decorable.h"
 #include "mongo/util/str.h"
@@ -416,9 +417,24 @@ void LockHead::migratePartitionedLockHeads() {
 // Have more buckets than CPUs to reduce contention on lock and caches
 const unsigned LockManager::_numLockBuckets(128);
 
-// Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
+namespace {
+
+// Balance scalability of intent locks against potential added cost of conflicting locks. Only
+// partitions that actually hold requests for a resource are visited when its intent locks are
+// migrated, so extra partitions mostly cost memory. The count should be a power of two.
+const unsigned kMinPartitions = 32;
+const unsigned kMaxPartitions = 1024;
+
+unsigned numPartitionsForHardware() {
+    unsigned wanted = 2 * stdx::thread::hardware_concurrency();
+    unsigned numPartitions = kMinPartitions;
+    while (numPartitions < wanted && numPartitions < kMaxPartitions) {
+        numPartitions *= 2;
+    }
+    return numPartitions;
+}
+
+}  // namespace
 
 // static
 LockManager* LockManager::get(ServiceContext* service) {
@@ -462,7 +478,7 @@ std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serv
     return lockToClientMap;
 }
 
-LockManager::LockManager() {
+LockManager::LockManager() : _numPartitions(numPartitionsForHardware()) {
     _lockBuckets = new LockBucket[_numLockBuckets];
     _partitions = new Partition[_numPartitions];
 }
@@ -707,6 +723,17 @@ void LockManager::downgrade(LockRequest* request, LockMode newMode) {
     _onLockModeChanged(lock, true);
 }
 
+bool LockManager::hasWaiters(ResourceId resId) const {
+    LockBucket* bucket = _getBucket(resId);
+    stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
+
+    auto it = bucket->data.find(resId);
+    if (it == bucket->data.end()) {
+        return false;
+    }
+    return it->second->conflictModes || it->second->conversionsCount;
+}
+
 void LockManager::cleanupUnusedLocks() {
     for (unsigned i = 0; i < _numLockBuckets; i++) {
         LockBucket* bucket = &_lockBuckets[i];
@@ -317,6 +317,31 @@ TEST(LockManager, Conflict) {
     ASSERT(request2.numNotifies == 1);
 }
 
+TEST(LockManager, HasWaiters) {
+    LockManager lockMgr;
+    const ResourceId resId(RESOURCE_COLLECTION, std::string("TestDB.collection"));
+
+    LockerImpl locker1;
+    LockerImpl locker2;
+
+    LockRequestCombo request1(&locker1);
+    LockRequestCombo request2(&locker2);
+
+    ASSERT_FALSE(lockMgr.hasWaiters(resId));
+
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &request1, MODE_S));
+    ASSERT_FALSE(lockMgr.hasWaiters(resId));
+
+    ASSERT(LOCK_WAITING == lockMgr.lock(resId, &request2, MODE_X));
+    ASSERT_TRUE(lockMgr.hasWaiters(resId));
+
+    lockMgr.unlock(&request1);
+    ASSERT_FALSE(lockMgr.hasWaiters(resId));
+
+    lockMgr.unlock(&request2);
+    ASSERT_FALSE(lockMgr.hasWaiters(resId));
+}
+
 TEST(LockManager, MultipleConflict) {
     LockManager lockMgr;
     const ResourceId resId(RESOURCE_COLLECTION, std::string("TestDB.collection"));
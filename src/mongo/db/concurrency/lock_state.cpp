@@ -37,6 +37,7 @@
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/json.h"
+#include "mongo/db/client.h"
 #include "mongo/db/concurrency/flow_control_ticketholder.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/service_context.h"
@@ -44,6 +45,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/platform/compiler.h"
 #include "mongo/stdx/new.h"
+#include "mongo/transport/session.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/ticketholder.h"
 #include "mongo/util/debug_util.h"
@@ -279,6 +281,38 @@ void CondVarLockGrantNotification::notify(ResourceId resId, LockResult result) {
 
 namespace {
 TicketHolder* ticketHolders[LockModesCount] = {};
+
+AtomicWord<bool> deprioritizeLongRunningOperations{false};
+
+// An operation which has already acquired a ticket this many times, because it keeps yielding, is
+// considered long-running.
+constexpr int kLongRunningTicketAcquisitions = 10;
+
+/**
+ * Operations run by internal threads, such as oplog application, and operations received from
+ * other members of the cluster queue for tickets ahead of user operations, so they are never stuck
+ * behind user queries when the ticket pool is exhausted. While long-running operations are
+ * deprioritized, user operations which have yielded many times queue behind all others.
+ */
+TicketHolder::Priority getTicketPriority(OperationContext* opCtx, int numTicketAcquisitions) {
+    if (!opCtx || !opCtx->getClient()) {
+        return TicketHolder::Priority::kNormal;
+    }
+
+    auto client = opCtx->getClient();
+    if (client->isFromSystemConnection()) {
+        return TicketHolder::Priority::kHigh;
+    }
+    if (const auto& session = client->session();
+        session && (session->getTags() & transport::Session::kInternalClient)) {
+        return TicketHolder::Priority::kHigh;
+    }
+    if (numTicketAcquisitions >= kLongRunningTicketAcquisitions &&
+        deprioritizeLongRunningOperations.load()) {
+        return TicketHolder::Priority::kLow;
+    }
+    return TicketHolder::Priority::kNormal;
+}
 }  // namespace
 
 
@@ -293,6 +327,21 @@ void Locker::setGlobalThrottling(class TicketHolder* reading, class TicketHolder
     ticketHolders[MODE_IX] = writing;
 }
 
+/* static */
+void Locker::setDeprioritizeLongRunningOperations(bool deprioritize) {
+    deprioritizeLongRunningOperations.store(deprioritize);
+}
+
+/* static */
+TicketHolder* Locker::getGlobalReadThrottling() {
+    return ticketHolders[MODE_S];
+}
+
+/* static */
+TicketHolder* Locker::getGlobalWriteThrottling() {
+    return ticketHolders[MODE_IX];
+}
+
 LockerImpl::LockerImpl()
     : _id(idCounter.addAndFetch(1)), _wuowNestingLevel(0), _threadId(stdx::this_thread::get_id()) {}
 
@@ -376,9 +425,10 @@ bool LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Date_t d
             invariant(!opCtx->recoveryUnit()->isTimestamped());
 
         OperationContext* interruptible = _uninterruptibleLocksRequested ? nullptr : opCtx;
+        const auto priority = getTicketPriority(opCtx, _numTicketAcquisitions++);
         if (deadline == Date_t::max()) {
-            holder->waitForTicket(interruptible);
-        } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
+            holder->waitForTicket(interruptible, priority);
+        } else if (!holder->waitForTicketUntil(interruptible, deadline, priority)) {
             return false;
         }
         restoreStateOnErrorGuard.dismiss();
@@ -1101,6 +1151,22 @@ bool LockerImpl::isGlobalLockedRecursively() {
     return !globalLockRequest.finished() && globalLockRequest->recursiveCount > 1;
 }
 
+bool LockerImpl::hasWaitersForHeldResources() const {
+    if (_modeForTicket != MODE_NONE && shouldAcquireTicket()) {
+        auto holder = ticketHolders[_modeForTicket];
+        if (holder && holder->available() <= 0) {
+            return true;
+        }
+    }
+
+    for (auto it = _requests.begin(); !it.finished(); it.next()) {
+        if (getGlobalLockManager()->hasWaiters(it.key())) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void LockerImpl::_setWaitingResource(ResourceId resId) {
     scoped_spinlock scopedLock(_lock);
 
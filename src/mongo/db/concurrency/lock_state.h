@@ -351,6 +351,9 @@ private:
     // Mode for which the Locker acquired a ticket, or MODE_NONE if no ticket was acquired.
     LockMode _modeForTicket = MODE_NONE;
 
+    // Number of times this locker has acquired a ticket, including reacquisitions after yielding.
+    int _numTicketAcquisitions = 0;
+
     // Indicates whether the client is active reader/writer or is queued.
     AtomicWord<ClientState> _clientState{kInactive};
 
@@ -401,6 +404,8 @@ public:
 
     bool isGlobalLockedRecursively() override;
 
+    bool hasWaitersForHeldResources() const override;
+
     virtual bool hasLockPending() const {
         return getWaitingResource().isValid();
     }
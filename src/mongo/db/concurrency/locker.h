@@ -76,6 +76,18 @@ public:
      */
     static void setGlobalThrottling(class TicketHolder* reading, class TicketHolder* writing);
 
+    /**
+     * Return the ticket holders installed by setGlobalThrottling(), or nullptr if there are none.
+     */
+    static class TicketHolder* getGlobalReadThrottling();
+    static class TicketHolder* getGlobalWriteThrottling();
+
+    /**
+     * While set, long-running user operations, recognized by how often they have reacquired a
+     * ticket after yielding, queue for tickets behind every other operation.
+     */
+    static void setDeprioritizeLongRunningOperations(bool deprioritize);
+
     /**
      * State for reporting the number of active and queued reader and writer clients.
      */
@@ -457,6 +469,12 @@ public:
 
     virtual bool isGlobalLockedRecursively() = 0;
 
+    /**
+     * Returns true if another operation is queued for a lock held by this locker, or for the kind
+     * of ticket it holds, such that releasing them at a yield point would let it make progress.
+     */
+    virtual bool hasWaitersForHeldResources() const = 0;
+
     /**
      * Pending means we are currently trying to get a lock (could be the parallel batch writer
      * lock).
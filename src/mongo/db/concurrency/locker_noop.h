@@ -247,6 +247,10 @@ public:
     bool isGlobalLockedRecursively() override {
         return false;
     }
+
+    bool hasWaitersForHeldResources() const override {
+        return false;
+    }
 };
 
 }  // namespace mongo
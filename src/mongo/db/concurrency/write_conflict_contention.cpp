@@ -0,0 +1,217 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/concurrency/write_conflict_contention.h"
+
+#include <algorithm>
+
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/concurrency/write_conflict_exception_gen.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace {
+
+const auto getContentionManager =
+    ServiceContext::declareDecoration<WriteConflictContentionManager>();
+
+const auto waitingForRetrySlot = OperationContext::declareDecoration<AtomicWord<bool>>();
+
+// Beyond this many tracked namespaces, idle ones are forgotten before tracking a new one.
+constexpr size_t kMaxTrackedNamespaces = 1024;
+
+constexpr Seconds kWindow{1};
+
+class WriteConflictContentionSSM final : public ServerStatusMetric {
+public:
+    WriteConflictContentionSSM() : ServerStatusMetric("operation.writeConflictContention") {}
+
+    void appendAtLeaf(BSONObjBuilder& b) const final {
+        BSONObjBuilder contentionBob(b.subobjStart(_leafName));
+        WriteConflictContentionManager::get(getGlobalServiceContext())
+            ->appendStats(&contentionBob);
+    }
+} writeConflictContentionSSM;
+
+}  // namespace
+
+WriteConflictContentionManager* WriteConflictContentionManager::get(ServiceContext* service) {
+    return &getContentionManager(service);
+}
+
+bool WriteConflictContentionManager::isWaitingForRetrySlot(OperationContext* opCtx) {
+    return waitingForRetrySlot(opCtx).load();
+}
+
+WriteConflictContentionManager::RetrySlot WriteConflictContentionManager::onWriteConflict(
+    OperationContext* opCtx, StringData ns) {
+    auto service = opCtx->getServiceContext();
+    if (!service) {
+        return {};
+    }
+    return get(service)->_onWriteConflict(opCtx, ns);
+}
+
+WriteConflictContentionManager::RetrySlot WriteConflictContentionManager::_onWriteConflict(
+    OperationContext* opCtx, StringData ns) {
+    _conflicts.fetchAndAddRelaxed(1);
+
+    const auto threshold = gWriteConflictHotNamespaceThreshold.load();
+    if (threshold <= 0 || ns.empty()) {
+        return {};
+    }
+
+    const auto now = opCtx->getServiceContext()->getFastClockSource()->now();
+    stdx::unique_lock<Latch> lk(_mutex);
+
+    auto it = _namespaces.find(ns);
+    if (it == _namespaces.end()) {
+        if (_namespaces.size() >= kMaxTrackedNamespaces) {
+            _pruneIdle(lk, now);
+        }
+        auto state = std::make_shared<NamespaceState>();
+        state->windowStart = now;
+        it = _namespaces.emplace(ns.toString(), std::move(state)).first;
+    }
+
+    auto state = it->second;
+    _advanceWindow(state.get(), now);
+    ++state->conflictsInWindow;
+    if (std::max(state->conflictsInWindow, state->conflictsInLastWindow) < threshold) {
+        return {};
+    }
+
+    _queuedRetries.fetchAndAddRelaxed(1);
+    ++state->waiters;
+    waitingForRetrySlot(opCtx).store(true);
+    ON_BLOCK_EXIT([&] {
+        --state->waiters;
+        waitingForRetrySlot(opCtx).store(false);
+    });
+
+    Timer waitTimer;
+    const auto deadline =
+        Date_t::now() + Milliseconds(gWriteConflictHotNamespaceMaxQueueWaitMillis.load());
+    const bool acquired = opCtx->waitForConditionOrInterruptUntil(
+        state->cv, lk, deadline, [&] { return !state->slotHeld; });
+    _queueWaitMicros.fetchAndAddRelaxed(waitTimer.micros());
+
+    if (!acquired) {
+        _queueTimeouts.fetchAndAddRelaxed(1);
+        return {};
+    }
+
+    state->slotHeld = true;
+    return RetrySlot(this, std::move(state));
+}
+
+void WriteConflictContentionManager::appendStats(BSONObjBuilder* builder) const {
+    builder->append("conflicts", _conflicts.load());
+    builder->append("queuedRetries", _queuedRetries.load());
+    builder->append("queueTimeouts", _queueTimeouts.load());
+    builder->append("queueWaitMicros", _queueWaitMicros.load());
+
+    const auto threshold = gWriteConflictHotNamespaceThreshold.load();
+    BSONArrayBuilder hotNamespaces(builder->subarrayStart("hotNamespaces"));
+    if (threshold > 0) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (auto&& [ns, state] : _namespaces) {
+            const auto conflictsPerSecond =
+                std::max(state->conflictsInWindow, state->conflictsInLastWindow);
+            if (conflictsPerSecond < threshold) {
+                continue;
+            }
+            hotNamespaces.append(BSON("ns" << ns << "conflictsPerSecond" << conflictsPerSecond
+                                           << "queued" << state->waiters));
+        }
+    }
+}
+
+void WriteConflictContentionManager::_advanceWindow(NamespaceState* state, Date_t now) {
+    const auto elapsed = now - state->windowStart;
+    if (elapsed < kWindow) {
+        return;
+    }
+    state->conflictsInLastWindow = elapsed < 2 * kWindow ? state->conflictsInWindow : 0;
+    state->conflictsInWindow = 0;
+    state->windowStart = now;
+}
+
+void WriteConflictContentionManager::_pruneIdle(WithLock, Date_t now) {
+    for (auto it = _namespaces.begin(); it != _namespaces.end();) {
+        const auto& state = *it->second;
+        if (!state.slotHeld && state.waiters == 0 && now - state.windowStart >= 2 * kWindow) {
+            _namespaces.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void WriteConflictContentionManager::_releaseSlot(NamespaceState* state) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    invariant(state->slotHeld);
+    state->slotHeld = false;
+    state->cv.notify_one();
+}
+
+WriteConflictContentionManager::RetrySlot::RetrySlot(RetrySlot&& other)
+    : _manager(other._manager), _state(std::move(other._state)) {
+    other._manager = nullptr;
+}
+
+WriteConflictContentionManager::RetrySlot& WriteConflictContentionManager::RetrySlot::operator=(
+    RetrySlot&& other) {
+    if (this != &other) {
+        _release();
+        _manager = other._manager;
+        _state = std::move(other._state);
+        other._manager = nullptr;
+    }
+    return *this;
+}
+
+WriteConflictContentionManager::RetrySlot::~RetrySlot() {
+    _release();
+}
+
+void WriteConflictContentionManager::RetrySlot::_release() {
+    if (_state) {
+        _manager->_releaseSlot(_state.get());
+        _state.reset();
+        _manager = nullptr;
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,137 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Detects namespaces on which write conflicts happen at a high rate, for example when many writers
+ * update the same counter document, and makes the writers conflicting on them retry one at a time.
+ *
+ * Left alone, conflicting writers back off and retry at roughly the same time, so most retries
+ * conflict again and abort their storage transactions. Once a namespace sees more than
+ * 'writeConflictHotNamespaceThreshold' conflicts per second, an operation retrying a conflict on it
+ * first waits for the namespace's retry slot. The wait is bounded by
+ * 'writeConflictHotNamespaceMaxQueueWaitMillis', since the waiter may hold locks the slot holder
+ * ends up needing.
+ */
+class WriteConflictContentionManager {
+public:
+    class RetrySlot;
+
+    static WriteConflictContentionManager* get(ServiceContext* service);
+
+    /**
+     * Returns true if 'opCtx' is waiting for its turn to retry a write conflict.
+     */
+    static bool isWaitingForRetrySlot(OperationContext* opCtx);
+
+    /**
+     * Records a write conflict on 'ns' with the manager of the operation's service context. If 'ns'
+     * is hot, waits for the namespace's retry slot and returns it, to be held for the duration of
+     * the retry. Otherwise, or if the wait times out, returns an empty slot. Throws if 'opCtx' is
+     * interrupted while waiting.
+     */
+    static RetrySlot onWriteConflict(OperationContext* opCtx, StringData ns);
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    struct NamespaceState {
+        // Conflicts counted in the current one second window, and in the window before it.
+        Date_t windowStart;
+        long long conflictsInWindow{0};
+        long long conflictsInLastWindow{0};
+
+        bool slotHeld{false};
+        int waiters{0};
+        stdx::condition_variable cv;
+    };
+
+    RetrySlot _onWriteConflict(OperationContext* opCtx, StringData ns);
+
+    // Rolls 'state' over to the window containing 'now'.
+    static void _advanceWindow(NamespaceState* state, Date_t now);
+
+    // Forgets namespaces which have not conflicted recently and have no queued operations.
+    void _pruneIdle(WithLock, Date_t now);
+
+    void _releaseSlot(NamespaceState* state);
+
+    AtomicWord<long long> _conflicts{0};
+    AtomicWord<long long> _queuedRetries{0};
+    AtomicWord<long long> _queueTimeouts{0};
+    AtomicWord<long long> _queueWaitMicros{0};
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("WriteConflictContentionManager::_mutex");
+    StringMap<std::shared_ptr<NamespaceState>> _namespaces;
+};
+
+/**
+ * The right of an operation to retry a write conflict on a hot namespace. Released on destruction.
+ */
+class WriteConflictContentionManager::RetrySlot {
+public:
+    RetrySlot() = default;
+    RetrySlot(RetrySlot&& other);
+    RetrySlot& operator=(RetrySlot&& other);
+    ~RetrySlot();
+
+    explicit operator bool() const {
+        return bool(_state);
+    }
+
+private:
+    friend class WriteConflictContentionManager;
+
+    RetrySlot(WriteConflictContentionManager* manager, std::shared_ptr<NamespaceState> state)
+        : _manager(manager), _state(std::move(state)) {}
+
+    void _release();
+
+    WriteConflictContentionManager* _manager{nullptr};
+    std::shared_ptr<NamespaceState> _state;
+};
+
+}  // namespace mongo
@@ -0,0 +1,101 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/concurrency/write_conflict_contention.h"
+
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class WriteConflictContentionTest : public ServiceContextTest {
+protected:
+    BSONObj stats() {
+        BSONObjBuilder bob;
+        WriteConflictContentionManager::get(getServiceContext())->appendStats(&bob);
+        return bob.obj();
+    }
+};
+
+TEST_F(WriteConflictContentionTest, NoRetrySlotWhenDisabled) {
+    RAIIServerParameterControllerForTest threshold{"writeConflictHotNamespaceThreshold", 0};
+    auto opCtx = makeOperationContext();
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_FALSE(WriteConflictContentionManager::onWriteConflict(opCtx.get(), "test.coll"));
+    }
+    ASSERT_EQ(10, stats()["conflicts"].numberLong());
+    ASSERT_EQ(0, stats()["queuedRetries"].numberLong());
+}
+
+TEST_F(WriteConflictContentionTest, RetrySlotOnceNamespaceIsHot) {
+    RAIIServerParameterControllerForTest threshold{"writeConflictHotNamespaceThreshold", 3};
+    auto opCtx = makeOperationContext();
+
+    ASSERT_FALSE(WriteConflictContentionManager::onWriteConflict(opCtx.get(), "test.coll"));
+    ASSERT_FALSE(WriteConflictContentionManager::onWriteConflict(opCtx.get(), "test.coll"));
+    ASSERT_TRUE(WriteConflictContentionManager::onWriteConflict(opCtx.get(), "test.coll"));
+
+    // Conflicts are counted per namespace.
+    ASSERT_FALSE(WriteConflictContentionManager::onWriteConflict(opCtx.get(), "test.other"));
+
+    auto hotNamespaces = stats()["hotNamespaces"].Array();
+    ASSERT_EQ(1U, hotNamespaces.size());
+    ASSERT_EQ("test.coll", hotNamespaces[0]["ns"].str());
+    ASSERT_EQ(3, hotNamespaces[0]["conflictsPerSecond"].numberLong());
+}
+
+TEST_F(WriteConflictContentionTest, RetriesOnHotNamespaceTakeTurns) {
+    RAIIServerParameterControllerForTest threshold{"writeConflictHotNamespaceThreshold", 1};
+    RAIIServerParameterControllerForTest maxWait{"writeConflictHotNamespaceMaxQueueWaitMillis", 0};
+    auto opCtx = makeOperationContext();
+    auto otherClient = getServiceContext()->makeClient("other");
+    auto otherOpCtx = otherClient->makeOperationContext();
+
+    auto slot = WriteConflictContentionManager::onWriteConflict(opCtx.get(), "test.coll");
+    ASSERT_TRUE(slot);
+
+    // The slot is held, so the other operation times out waiting for it and retries anyway.
+    ASSERT_FALSE(WriteConflictContentionManager::onWriteConflict(otherOpCtx.get(), "test.coll"));
+    ASSERT_EQ(1, stats()["queueTimeouts"].numberLong());
+    ASSERT_FALSE(WriteConflictContentionManager::isWaitingForRetrySlot(otherOpCtx.get()));
+
+    // Once released, the slot can be taken again.
+    slot = {};
+    ASSERT_TRUE(WriteConflictContentionManager::onWriteConflict(otherOpCtx.get(), "test.coll"));
+    ASSERT_EQ(3, stats()["queuedRetries"].numberLong());
+    ASSERT_EQ(1, stats()["queueTimeouts"].numberLong());
+}
+
+}  // namespace
+}  // namespace mongo
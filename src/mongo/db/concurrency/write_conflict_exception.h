@@ -32,6 +32,7 @@
 #include <exception>
 
 #include "mongo/base/string_data.h"
+#include "mongo/db/concurrency/write_conflict_contention.h"
 #include "mongo/db/curop.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point.h"
@@ -70,8 +71,10 @@ private:
 /**
  * Runs the argument function f as many times as needed for f to complete or throw an exception
  * other than WriteConflictException.  For each time f throws a WriteConflictException, logs the
- * error, waits a spell, cleans up, and then tries f again.  Imposes no upper limit on the number
- * of times to re-try f, so any required timeout behavior must be enforced within f.
+ * error, waits a spell, cleans up, and then tries f again.  On a namespace with many conflicts,
+ * waiting a spell means waiting for a turn to retry; see WriteConflictContentionManager.  Imposes
+ * no upper limit on the number of times to re-try f, so any required timeout behavior must be
+ * enforced within f.
  *
  * If we are already in a WriteUnitOfWork, we assume that we are being called within a
  * WriteConflictException retry loop up the call stack. Hence, this retry loop is reduced to an
@@ -93,14 +96,21 @@ auto writeConflictRetry(OperationContext* opCtx, StringData opStr, StringData ns
     }
 
     int attempts = 0;
+    WriteConflictContentionManager::RetrySlot retrySlot;
     while (true) {
         try {
             return f();
         } catch (WriteConflictException const&) {
             CurOp::get(opCtx)->debug().additiveMetrics.incrementWriteConflicts(1);
-            WriteConflictException::logAndBackoff(attempts, opStr, ns);
-            ++attempts;
             opCtx->recoveryUnit()->abandonSnapshot();
+
+            // Retries on a hot namespace take turns rather than backing off.
+            retrySlot = {};
+            retrySlot = WriteConflictContentionManager::onWriteConflict(opCtx, ns);
+            if (!retrySlot) {
+                WriteConflictException::logAndBackoff(attempts, opStr, ns);
+            }
+            ++attempts;
         }
     }
 }
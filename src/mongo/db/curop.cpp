@@ -45,10 +45,12 @@
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/locker.h"
+#include "mongo/db/concurrency/write_conflict_contention.h"
 #include "mongo/db/json.h"
 #include "mongo/db/prepare_conflict_tracker.h"
 #include "mongo/db/profile_filter.h"
 #include "mongo/db/query/getmore_command_gen.h"
+#include "mongo/db/query/operation_memory_usage_tracker.h"
 #include "mongo/db/query/plan_summary_stats.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/metadata/client_metadata.h"
@@ -92,11 +94,16 @@ public:
      * Returns the top of the CurOp stack.
      */
     CurOp* top() const {
-        return _top;
+        return _top.load();
     }
 
     /**
      * Adds "curOp" to the top of the CurOp stack for a client. Called by CurOp's constructor.
+     *
+     * Pushing does not take the client lock: 'curOp' is fully linked to its parent before it is
+     * published as the new top, and pushing never invalidates a CurOp which a concurrent reader
+     * holding the client lock may be looking at. Popping, which precedes the destruction of the
+     * popped CurOp, still has to exclude such readers.
      */
     void push(OperationContext* opCtx, CurOp* curOp) {
         invariant(opCtx);
@@ -105,14 +112,13 @@ public:
         } else {
             _opCtx = opCtx;
         }
-        stdx::lock_guard<Client> lk(*_opCtx->getClient());
         push_nolock(curOp);
     }
 
     void push_nolock(CurOp* curOp) {
         invariant(!curOp->_parent);
-        curOp->_parent = _top;
-        _top = curOp;
+        curOp->_parent = _top.load();
+        _top.store(curOp);
     }
 
     /**
@@ -127,14 +133,14 @@ public:
         // item is popped in the destructor of the stack, and that destructor runs during
         // destruction of the owning client, it is not safe to access other member variables of
         // the client during the final pop.
-        const bool shouldLock = _top->_parent;
+        CurOp* retval = _top.load();
+        invariant(retval);
+        const bool shouldLock = retval->_parent;
         if (shouldLock) {
             invariant(_opCtx);
             _opCtx->getClient()->lock();
         }
-        invariant(_top);
-        CurOp* retval = _top;
-        _top = _top->_parent;
+        _top.store(retval->_parent);
         if (shouldLock) {
             _opCtx->getClient()->unlock();
         }
@@ -148,8 +154,8 @@ public:
 private:
     OperationContext* _opCtx = nullptr;
 
-    // Top of the stack of CurOps for a Client.
-    CurOp* _top = nullptr;
+    // Top of the stack of CurOps for a Client. Atomic since it is pushed without the client lock.
+    AtomicWord<CurOp*> _top{nullptr};
 
     // The bottom-most CurOp for a client.
     const CurOp _base;
@@ -367,6 +373,13 @@ TickSource::Tick CurOp::startTime() {
     // that writes to '_start' never race.
     TickSource::Tick unassignedStart = 0;
     invariant(_start.compare_exchange_strong(unassignedStart, _tickSource->getTicks()));
+
+    // Nested CurOps share their operation's counters, which only start once.
+    if (auto opCtx = _stack->opCtx()) {
+        if (auto counters = OperationPerfCounters::get(opCtx)) {
+            counters->start();
+        }
+    }
     return _start.load();
 }
 
@@ -419,6 +432,10 @@ bool CurOp::completeAndLogOperation(OperationContext* opCtx,
     done();
     _debug.executionTime = duration_cast<Microseconds>(elapsedTimeExcludingPauses());
 
+    if (auto counters = OperationPerfCounters::get(opCtx)) {
+        _debug.perfCounters = counters->getElapsed();
+    }
+
     const auto executionTimeMillis = durationCount<Milliseconds>(_debug.executionTime);
 
     if (_debug.isReplOplogGetMore) {
@@ -701,9 +718,15 @@ void CurOp::reportState(OperationContext* opCtx, BSONObjBuilder* builder, bool t
     if (auto n = _debug.additiveMetrics.prepareReadConflicts.load(); n > 0) {
         builder->append("prepareReadConflicts", n);
     }
+    if (PrepareConflictTracker::get(opCtx).isWaitingOnPrepareConflict()) {
+        builder->append("waitingForPrepareConflict", true);
+    }
     if (auto n = _debug.additiveMetrics.writeConflicts.load(); n > 0) {
         builder->append("writeConflicts", n);
     }
+    if (WriteConflictContentionManager::isWaitingForRetrySlot(opCtx)) {
+        builder->append("waitingForWriteConflictRetry", true);
+    }
 
     builder->append("numYields", _numYields.load());
 
@@ -714,6 +737,12 @@ void CurOp::reportState(OperationContext* opCtx, BSONObjBuilder* builder, bool t
     if (_debug.dataThroughputAverage) {
         builder->append("dataThroughputAverage", *_debug.dataThroughputAverage);
     }
+
+    const auto& memoryTracker = OperationMemoryUsageTracker::get(opCtx);
+    if (auto peakMemoryBytes = memoryTracker.peakMemoryBytes()) {
+        builder->append("memoryBytes", memoryTracker.currentMemoryBytes());
+        builder->append("peakMemoryBytes", peakMemoryBytes);
+    }
 }
 
 namespace {
@@ -819,6 +848,10 @@ void OpDebug::report(OperationContext* opCtx,
         pAttrs->add("dataThroughputAverageMBPerSec", *dataThroughputAverage);
     }
 
+    if (auto peakMemoryBytes = OperationMemoryUsageTracker::get(opCtx).peakMemoryBytes()) {
+        pAttrs->add("peakMemoryBytes", peakMemoryBytes);
+    }
+
     if (!resolvedViews.empty()) {
         pAttrs->add("resolvedViews", getResolvedViewsInfo());
     }
@@ -834,12 +867,17 @@ void OpDebug::report(OperationContext* opCtx,
     OPDEBUG_TOATTR_HELP_OPTIONAL("docsExamined", additiveMetrics.docsExamined);
     OPDEBUG_TOATTR_HELP_BOOL(hasSortStage);
     OPDEBUG_TOATTR_HELP_BOOL(usedDisk);
+    OPDEBUG_TOATTR_HELP_OPTIONAL("spilledBytes", spilledBytes);
+    OPDEBUG_TOATTR_HELP_OPTIONAL("spillTimeMicros", spillTimeMicros);
     OPDEBUG_TOATTR_HELP_BOOL(fromMultiPlanner);
     if (replanReason) {
         bool replanned = true;
         OPDEBUG_TOATTR_HELP_BOOL(replanned);
         pAttrs->add("replanReason", redact(*replanReason));
     }
+    if (!stageExecutionSummary.empty()) {
+        pAttrs->add("stageStats", stageExecutionSummary);
+    }
     OPDEBUG_TOATTR_HELP_OPTIONAL("nMatched", additiveMetrics.nMatched);
     OPDEBUG_TOATTR_HELP_OPTIONAL("nModified", additiveMetrics.nModified);
     OPDEBUG_TOATTR_HELP_OPTIONAL("ninserted", additiveMetrics.ninserted);
@@ -909,6 +947,12 @@ void OpDebug::report(OperationContext* opCtx,
         pAttrs->add("storage", storageStats->toBSON());
     }
 
+    if (perfCounters) {
+        BSONObjBuilder builder;
+        perfCounters->append(&builder);
+        pAttrs->add("perfCounters", builder.obj());
+    }
+
     if (operationMetrics) {
         BSONObjBuilder builder;
         operationMetrics->toBsonNonZeroFields(&builder);
@@ -981,12 +1025,17 @@ void OpDebug::append(OperationContext* opCtx,
     OPDEBUG_APPEND_OPTIONAL(b, "docsExamined", additiveMetrics.docsExamined);
     OPDEBUG_APPEND_BOOL(b, hasSortStage);
     OPDEBUG_APPEND_BOOL(b, usedDisk);
+    OPDEBUG_APPEND_OPTIONAL(b, "spilledBytes", spilledBytes);
+    OPDEBUG_APPEND_OPTIONAL(b, "spillTimeMicros", spillTimeMicros);
     OPDEBUG_APPEND_BOOL(b, fromMultiPlanner);
     if (replanReason) {
         bool replanned = true;
         OPDEBUG_APPEND_BOOL(b, replanned);
         b.append("replanReason", *replanReason);
     }
+    if (!stageExecutionSummary.empty()) {
+        b.append("stageStats", stageExecutionSummary);
+    }
     OPDEBUG_APPEND_OPTIONAL(b, "nMatched", additiveMetrics.nMatched);
     OPDEBUG_APPEND_OPTIONAL(b, "nModified", additiveMetrics.nModified);
     OPDEBUG_APPEND_OPTIONAL(b, "ninserted", additiveMetrics.ninserted);
@@ -1002,6 +1051,10 @@ void OpDebug::append(OperationContext* opCtx,
     OPDEBUG_APPEND_OPTIONAL(b, "dataThroughputLastSecond", dataThroughputLastSecond);
     OPDEBUG_APPEND_OPTIONAL(b, "dataThroughputAverage", dataThroughputAverage);
 
+    if (auto peakMemoryBytes = OperationMemoryUsageTracker::get(opCtx).peakMemoryBytes()) {
+        b.appendNumber("peakMemoryBytes", peakMemoryBytes);
+    }
+
     b.appendNumber("numYield", curop.numYields());
     OPDEBUG_APPEND_NUMBER(b, nreturned);
 
@@ -1047,6 +1100,11 @@ void OpDebug::append(OperationContext* opCtx,
         b.append("storage", storageStats->toBSON());
     }
 
+    if (perfCounters) {
+        BSONObjBuilder perfCountersBuilder(b.subobjStart("perfCounters"));
+        perfCounters->append(&perfCountersBuilder);
+    }
+
     if (!errInfo.isOK()) {
         b.appendNumber("ok", 0.0);
         if (!errInfo.reason().empty()) {
@@ -1206,6 +1264,12 @@ std::function<BSONObj(ProfileFilter::Args)> OpDebug::appendStaged(StringSet requ
     addIfNeeded("usedDisk", [](auto field, auto args, auto& b) {
         OPDEBUG_APPEND_BOOL2(b, field, args.op.usedDisk);
     });
+    addIfNeeded("spilledBytes", [](auto field, auto args, auto& b) {
+        OPDEBUG_APPEND_OPTIONAL(b, field, args.op.spilledBytes);
+    });
+    addIfNeeded("spillTimeMicros", [](auto field, auto args, auto& b) {
+        OPDEBUG_APPEND_OPTIONAL(b, field, args.op.spillTimeMicros);
+    });
     addIfNeeded("fromMultiPlanner", [](auto field, auto args, auto& b) {
         OPDEBUG_APPEND_BOOL2(b, field, args.op.fromMultiPlanner);
     });
@@ -1219,6 +1283,11 @@ std::function<BSONObj(ProfileFilter::Args)> OpDebug::appendStaged(StringSet requ
             b.append(field, *args.op.replanReason);
         }
     });
+    addIfNeeded("stageStats", [](auto field, auto args, auto& b) {
+        if (!args.op.stageExecutionSummary.empty()) {
+            b.append(field, args.op.stageExecutionSummary);
+        }
+    });
     addIfNeeded("nMatched", [](auto field, auto args, auto& b) {
         OPDEBUG_APPEND_OPTIONAL(b, field, args.op.additiveMetrics.nMatched);
     });
@@ -1312,6 +1381,13 @@ std::function<BSONObj(ProfileFilter::Args)> OpDebug::appendStaged(StringSet requ
         }
     });
 
+    addIfNeeded("perfCounters", [](auto field, auto args, auto& b) {
+        if (args.op.perfCounters) {
+            BSONObjBuilder perfCountersBuilder(b.subobjStart(field));
+            args.op.perfCounters->append(&perfCountersBuilder);
+        }
+    });
+
     // Don't short-circuit: call needs() for every supported field, so that at the end we can
     // uassert that no unsupported fields were requested.
     bool needsOk = needs("ok");
@@ -1402,8 +1478,13 @@ void OpDebug::setPlanSummaryMetrics(const PlanSummaryStats& planSummaryStats) {
     additiveMetrics.docsExamined = planSummaryStats.totalDocsExamined;
     hasSortStage = planSummaryStats.hasSortStage;
     usedDisk = planSummaryStats.usedDisk;
+    if (usedDisk) {
+        spilledBytes = static_cast<long long>(planSummaryStats.spilledBytes);
+        spillTimeMicros = static_cast<long long>(planSummaryStats.spillTimeMicros);
+    }
     fromMultiPlanner = planSummaryStats.fromMultiPlanner;
     replanReason = planSummaryStats.replanReason;
+    stageExecutionSummary = planSummaryStats.stageExecutionSummary;
 }
 
 BSONObj OpDebug::makeFlowControlObject(FlowControlTicketholder::CurOp stats) {
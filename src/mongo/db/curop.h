@@ -38,6 +38,7 @@
 #include "mongo/db/commands.h"
 #include "mongo/db/cursor_id.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/operation_perf_counters.h"
 #include "mongo/db/profile_filter.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
@@ -234,6 +235,11 @@ public:
 
     bool usedDisk{false};  // true if the given query used disk
 
+    // Bytes spilled to disk by the blocking stages of the query, and the time spent writing them.
+    // Only set if the query used disk.
+    boost::optional<long long> spilledBytes;
+    boost::optional<long long> spillTimeMicros;
+
     // True if the plan came from the multi-planner (not from the plan cache and not a query with a
     // single solution).
     bool fromMultiPlanner{false};
@@ -241,6 +247,10 @@ public:
     // True if a replan was triggered during the execution of this operation.
     std::optional<std::string> replanReason;
 
+    // Compact per stage time and peak memory of the query plan. Only set when
+    // 'internalQueryCollectStageExecutionStats' is enabled.
+    std::string stageExecutionSummary;
+
     bool cursorExhausted{
         false};  // true if the cursor has been closed at end a find/getMore operation
 
@@ -279,6 +289,9 @@ public:
     // Stores storage statistics.
     std::shared_ptr<StorageStats> storageStats;
 
+    // Hardware performance counters consumed by the operation, when enabled and supported.
+    boost::optional<PerfCounterValues> perfCounters;
+
     bool waitingForFlowControl{false};
 
     // Records the WC that was waited on during the operation. (The WC in opCtx can't be used
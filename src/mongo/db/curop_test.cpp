@@ -269,5 +269,29 @@ TEST(CurOpTest, ElapsedTimeReflectsTickSource) {
     ASSERT_EQ(Milliseconds{20}, duration_cast<Milliseconds>(curop->elapsedTimeTotal()));
 }
 
+TEST(CurOpTest, NestedCurOpIsPushedAndPopped) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+
+    auto base = CurOp::get(*opCtx);
+    {
+        CurOp nested(opCtx.get());
+        ASSERT_EQ(&nested, CurOp::get(*opCtx));
+        ASSERT_EQ(base, nested.parent());
+    }
+    ASSERT_EQ(base, CurOp::get(*opCtx));
+}
+
+TEST(CurOpTest, ClientMayHaveActiveCurrentOpTracksOperationContext) {
+    QueryTestServiceContext serviceContext;
+    auto client = serviceContext.getClient();
+    ASSERT_FALSE(client->mayHaveActiveCurrentOp());
+    {
+        auto opCtx = serviceContext.makeOperationContext();
+        ASSERT_TRUE(client->mayHaveActiveCurrentOp());
+    }
+    ASSERT_FALSE(client->mayHaveActiveCurrentOp());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,271 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/cursor_prefetcher.h"
+
+#include "mongo/base/counter.h"
+#include "mongo/db/client.h"
+#include "mongo/db/clientcursor.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/curop.h"
+#include "mongo/db/cursor_manager.h"
+#include "mongo/db/cursor_server_params.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/find_common.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+const auto getCursorPrefetcher = ServiceContext::declareDecoration<CursorPrefetcher>();
+
+Counter64 prefetchStatsScheduled;
+Counter64 prefetchStatsDocuments;
+Counter64 prefetchStatsWaits;
+Counter64 prefetchStatsFailed;
+
+ServerStatusMetricField<Counter64> displayPrefetchScheduled("cursor.prefetch.scheduled",
+                                                            &prefetchStatsScheduled);
+ServerStatusMetricField<Counter64> displayPrefetchDocuments("cursor.prefetch.documents",
+                                                            &prefetchStatsDocuments);
+ServerStatusMetricField<Counter64> displayPrefetchWaits("cursor.prefetch.waits",
+                                                        &prefetchStatsWaits);
+ServerStatusMetricField<Counter64> displayPrefetchFailed("cursor.prefetch.failed",
+                                                         &prefetchStatsFailed);
+
+bool prefetchBudgetExhausted() {
+    return ClientCursor::getTotalPrefetchedBytes() >= getCursorPrefetchMaxBufferedBytes();
+}
+
+}  // namespace
+
+CursorPrefetcher* CursorPrefetcher::get(ServiceContext* serviceContext) {
+    return &getCursorPrefetcher(serviceContext);
+}
+
+CursorPrefetcher* CursorPrefetcher::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+bool CursorPrefetcher::canPrefetch(OperationContext* opCtx, const ClientCursor& cursor) {
+    if (getCursorPrefetchThreads() == 0 || opCtx->getClient()->isInDirectClient() ||
+        opCtx->isExhaust()) {
+        return false;
+    }
+
+    if (cursor.isTailable() || cursor.getTxnNumber() || cursor.nss().isOplog()) {
+        return false;
+    }
+
+    // A linearizable or speculative majority read must wait for its results to be majority
+    // committed on the getMore which returns them.
+    const auto readConcernArgs = cursor.getReadConcernArgs();
+    if (readConcernArgs.getLevel() == repl::ReadConcernLevel::kLinearizableReadConcern ||
+        readConcernArgs.getMajorityReadMechanism() ==
+            repl::ReadConcernArgs::MajorityReadMechanism::kSpeculative) {
+        return false;
+    }
+
+    const auto* exec = cursor.getExecutor();
+    if (exec->lockPolicy() != PlanExecutor::LockPolicy::kLockExternally) {
+        return false;
+    }
+
+    // The postBatchResumeToken must describe the last document of each batch, which requires the
+    // batch to be produced by the getMore itself.
+    const auto* cq = exec->getCanonicalQuery();
+    return !cq || !cq->getFindCommandRequest().getRequestResumeToken();
+}
+
+void CursorPrefetcher::schedule(CursorId cursorId, long long batchSize) {
+    if (getCursorPrefetchThreads() == 0 || prefetchBudgetExhausted()) {
+        return;
+    }
+
+    ThreadPool* pool;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_inShutdown || !_inFlight.insert(cursorId).second) {
+            return;
+        }
+
+        if (!_pool) {
+            ThreadPool::Options options;
+            options.poolName = "CursorPrefetcher";
+            options.minThreads = 0;
+            options.maxThreads = getCursorPrefetchThreads();
+            options.onCreateThread = [](const std::string& threadName) {
+                Client::initThread(threadName);
+            };
+            _pool = std::make_unique<ThreadPool>(std::move(options));
+            _pool->startup();
+        }
+        pool = _pool.get();
+    }
+
+    prefetchStatsScheduled.increment();
+    pool->schedule([this, cursorId, batchSize](Status status) {
+        ON_BLOCK_EXIT([&] {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _inFlight.erase(cursorId);
+            _prefetchFinished.notify_all();
+        });
+
+        if (!status.isOK()) {
+            return;
+        }
+
+        auto opCtx = cc().makeOperationContext();
+        _prefetch(opCtx.get(), cursorId, batchSize);
+    });
+}
+
+void CursorPrefetcher::waitForPrefetch(OperationContext* opCtx, CursorId cursorId) {
+    stdx::unique_lock<Latch> lk(_mutex);
+    if (!_inFlight.count(cursorId)) {
+        return;
+    }
+
+    prefetchStatsWaits.increment();
+    opCtx->waitForConditionOrInterrupt(
+        _prefetchFinished, lk, [&] { return !_inFlight.count(cursorId); });
+}
+
+void CursorPrefetcher::shutdown() {
+    ThreadPool* pool;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _inShutdown = true;
+        pool = _pool.get();
+    }
+
+    if (pool) {
+        pool->shutdown();
+        pool->join();
+    }
+}
+
+void CursorPrefetcher::_prefetch(OperationContext* opCtx, CursorId cursorId, long long batchSize) {
+    boost::optional<ClientCursorPin> pin;
+    try {
+        auto swPin = CursorManager::get(opCtx)->pinCursor(
+            opCtx, cursorId, CursorManager::kNoCheckSession);
+        if (!swPin.isOK()) {
+            // The cursor was killed or timed out since the previous batch.
+            return;
+        }
+        pin.emplace(std::move(swPin.getValue()));
+    } catch (const ExceptionFor<ErrorCodes::CursorInUse>&) {
+        // Another getMore picked up the cursor first.
+        return;
+    }
+
+    ClientCursor* cursor = pin->getCursor();
+    PlanExecutor* exec = cursor->getExecutor();
+    boost::optional<AutoGetCollectionForReadMaybeLockFree> readLock;
+    bool attached = false;
+    try {
+        // Read with the same snapshot and time budget as a getMore on this cursor would.
+        applyCursorReadConcern(opCtx, cursor->getReadConcernArgs());
+        if (cursor->getLeftoverMaxTimeMicros() < Microseconds::max()) {
+            opCtx->setDeadlineAfterNowBy(cursor->getLeftoverMaxTimeMicros(),
+                                         ErrorCodes::MaxTimeMSExpired);
+        }
+        {
+            stdx::lock_guard<Client> lk(*opCtx->getClient());
+            CurOp::get(opCtx)->setNS_inlock(cursor->nss().ns());
+        }
+
+        readLock.emplace(opCtx, exec->nss());
+        uassertStatusOK(repl::ReplicationCoordinator::get(opCtx)->checkCanServeReadsFor(
+            opCtx, cursor->nss(), true));
+
+        const auto* cq = exec->getCanonicalQuery();
+        if (cq && cq->getFindCommandRequest().getReadOnce()) {
+            opCtx->recoveryUnit()->setReadOnce(true);
+        }
+        exec->reattachToOperationContext(opCtx);
+        attached = true;
+        exec->restoreState(&readLock->getCollection());
+
+        // Stop where the getMore would have stopped, or earlier if the prefetched documents of all
+        // cursors have reached their budget.
+        long long numResults = 0;
+        int bytesBuffered = 0;
+        auto adaptiveBatch = AdaptiveBatchSizer::make(batchSize);
+        auto enoughForGetMore = [&] {
+            return adaptiveBatch ? adaptiveBatch->enough(numResults, bytesBuffered)
+                                 : FindCommon::enoughForGetMore(batchSize, numResults);
+        };
+        BSONObj obj;
+        while (!enoughForGetMore() &&
+               bytesBuffered < FindCommon::kMaxBytesToReturnToClientAtOnce &&
+               !prefetchBudgetExhausted() &&
+               PlanExecutor::ADVANCED == exec->getNext(&obj, nullptr)) {
+            bytesBuffered += obj.objsize();
+            cursor->appendPrefetchedResult(obj.getOwned());
+            ++numResults;
+        }
+        prefetchStatsDocuments.increment(numResults);
+
+        exec->saveState();
+        exec->detachFromOperationContext();
+        attached = false;
+        cursor->setLeftoverMaxTimeMicros(opCtx->getRemainingMaxTimeMicros());
+    } catch (const DBException& ex) {
+        prefetchStatsFailed.increment();
+        LOGV2_DEBUG(5910904,
+                    1,
+                    "Failed to prefetch the next cursor batch",
+                    "cursorId"_attr = cursorId,
+                    "error"_attr = ex.toStatus());
+
+        // Kill the executor with the error so that the next getMore reports it, as it would have
+        // if it had produced the batch itself.
+        cursor->markAsKilled(ex.toStatus().withContext("Executor error during getMore"));
+        if (attached) {
+            try {
+                exec->saveState();
+                exec->detachFromOperationContext();
+            } catch (const DBException&) {
+                // The executor cannot be resumed by a later operation, so dispose of it now.
+                pin->deleteUnderlying();
+            }
+        }
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,110 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/db/cursor_id.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/unordered_set.h"
+#include "mongo/util/concurrency/thread_pool.h"
+
+namespace mongo {
+
+class ClientCursor;
+
+/**
+ * Executes the next batch of an idle find cursor on a bounded pool of background threads while the
+ * client is still consuming the previous batch. The produced documents are buffered on the
+ * ClientCursor and handed out by the next getMore before it resumes the PlanExecutor.
+ *
+ * A prefetch pins the cursor for its whole duration, so a getMore must call waitForPrefetch()
+ * before pinning the cursor itself. Prefetching is disabled unless the 'cursorPrefetchThreads'
+ * server parameter is positive, and the documents buffered across all cursors are bounded by
+ * 'cursorPrefetchMaxBufferedBytes'.
+ */
+class CursorPrefetcher {
+    CursorPrefetcher(const CursorPrefetcher&) = delete;
+    CursorPrefetcher& operator=(const CursorPrefetcher&) = delete;
+
+public:
+    CursorPrefetcher() = default;
+
+    static CursorPrefetcher* get(ServiceContext* serviceContext);
+    static CursorPrefetcher* get(OperationContext* opCtx);
+
+    /**
+     * Returns true if the next batch of 'cursor' may be produced in the background once 'opCtx'
+     * has released it. The cursor must be pinned by 'opCtx'.
+     *
+     * Only non-tailable cursors which lock externally and were not opened in a multi-document
+     * transaction are eligible, since their next batch depends on nothing but the PlanExecutor
+     * and the cursor's read concern.
+     */
+    static bool canPrefetch(OperationContext* opCtx, const ClientCursor& cursor);
+
+    /**
+     * Schedules the production of the next batch of at most 'batchSize' documents for 'cursorId',
+     * where zero means no limit other than the reply size. 'cursorId' must no longer be pinned. Does nothing if prefetching is disabled, if the buffered bytes budget is
+     * exhausted or if a prefetch is already in flight for this cursor.
+     */
+    void schedule(CursorId cursorId, long long batchSize);
+
+    /**
+     * Blocks until no prefetch is in flight for 'cursorId'. Throws if 'opCtx' is interrupted.
+     */
+    void waitForPrefetch(OperationContext* opCtx, CursorId cursorId);
+
+    /**
+     * Stops accepting new prefetches and waits for the running ones to finish. Running prefetches
+     * are expected to have been interrupted beforehand.
+     */
+    void shutdown();
+
+private:
+    void _prefetch(OperationContext* opCtx, CursorId cursorId, long long batchSize);
+
+    Mutex _mutex = MONGO_MAKE_LATCH("CursorPrefetcher::_mutex");
+
+    // Signalled whenever a prefetch finishes.
+    stdx::condition_variable _prefetchFinished;
+
+    // The cursors which currently have a prefetch scheduled or running.
+    stdx::unordered_set<CursorId> _inFlight;
+
+    // Created on the first call to schedule() when prefetching is enabled.
+    std::unique_ptr<ThreadPool> _pool;
+
+    bool _inShutdown = false;
+};
+
+}  // namespace mongo
@@ -47,4 +47,12 @@ Milliseconds getDefaultCursorTimeoutMillis() {
     return Milliseconds(kCursorTimeoutMillisDefault);
 }
 
+int getCursorPrefetchThreads() {
+    return gCursorPrefetchThreads;
+}
+
+long long getCursorPrefetchMaxBufferedBytes() {
+    return gCursorPrefetchMaxBufferedBytes.load();
+}
+
 }  // namespace mongo
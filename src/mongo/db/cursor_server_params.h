@@ -41,4 +41,12 @@ long long getCursorTimeoutMillis();
 
 Milliseconds getDefaultCursorTimeoutMillis();
 
+// Number of threads prefetching cursor batches in the background. Zero disables prefetching.
+// Configurable at startup with server parameter "cursorPrefetchThreads".
+int getCursorPrefetchThreads();
+
+// Upper bound on the bytes held in prefetched cursor batches. Configurable with server parameter
+// "cursorPrefetchMaxBufferedBytes".
+long long getCursorPrefetchMaxBufferedBytes();
+
 }  // namespace mongo
@@ -33,12 +33,15 @@
 
 #include "mongo/db/db_raii.h"
 
+#include "mongo/base/counter.h"
 #include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/database_sharding_state.h"
+#include "mongo/db/snapshot_window_options_gen.h"
 #include "mongo/db/storage/snapshot_helper.h"
 #include "mongo/logv2/log.h"
 
@@ -52,6 +55,44 @@ const boost::optional<int> kDoNotChangeProfilingLevel = boost::none;
 const auto allowSecondaryReadsDuringBatchApplication_DONT_USE =
     OperationContext::declareDecoration<boost::optional<bool>>();
 
+// Number of user reads at a point in time on secondaries which failed because their read timestamp
+// trailed lastApplied by more than 'maxSecondarySnapshotReadLagSecs'.
+Counter64 secondarySnapshotReadsOverLagLimit;
+ServerStatusMetricField<Counter64> displaySecondarySnapshotReadsOverLagLimit(
+    "snapshotReads.secondaryLagLimitExceeded", &secondarySnapshotReadsOverLagLimit);
+
+/**
+ * Throws SnapshotTooOld if this node is a secondary and 'readTimestamp', the point in time a user
+ * operation reads at, trails lastApplied by more than 'maxSecondarySnapshotReadLagSecs'. Such a
+ * read keeps the storage engine from discarding the history it needs while oplog application
+ * moves on, so the limit bounds how much history a long-running read can pin between batches.
+ */
+void checkSecondarySnapshotReadLag(OperationContext* opCtx, const Timestamp& readTimestamp) {
+    const long long maxLagSecs = maxSecondarySnapshotReadLagSecs.load();
+    if (maxLagSecs == 0 || !opCtx->getClient()->isFromUserConnection()) {
+        return;
+    }
+
+    auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+    if (!replCoord->getMemberState().secondary()) {
+        return;
+    }
+
+    const auto lastApplied = replCoord->getMyLastAppliedOpTime().getTimestamp();
+    const long long lagSecs = static_cast<long long>(lastApplied.getSecs()) -
+        static_cast<long long>(readTimestamp.getSecs());
+    if (lagSecs <= maxLagSecs) {
+        return;
+    }
+
+    secondarySnapshotReadsOverLagLimit.increment();
+    uasserted(ErrorCodes::SnapshotTooOld,
+              str::stream() << "Read timestamp " << readTimestamp.toString()
+                            << " trails lastApplied " << lastApplied.toString() << " by "
+                            << lagSecs << " seconds, more than maxSecondarySnapshotReadLagSecs ("
+                            << maxLagSecs << ")");
+}
+
 /**
  * Performs some checks to determine whether the operation is compatible with a lock-free read.
  * Multi-doc transactions are not supported, nor are operations holding an exclusive lock.
@@ -308,6 +349,10 @@ AutoGetCollectionForReadBase<AutoGetCollectionType, EmplaceAutoCollFunc>::
                                     << afterClusterTime->asTimestamp().toString());
         }
 
+        if (readTimestamp && readSource == RecoveryUnit::ReadSource::kProvided) {
+            checkSecondarySnapshotReadLag(opCtx, *readTimestamp);
+        }
+
         // This assertion protects operations from reading inconsistent data on secondaries when
         // using the default ReadSource of kNoTimestamp.
 
@@ -256,6 +256,10 @@ void AddFieldsProjectionExecutor::parse(const BSONObj& spec) {
 }
 
 Document AddFieldsProjectionExecutor::applyProjection(const Document& inputDoc) const {
+    if (_sharedSubexpressions) {
+        _sharedSubexpressions->newDocument();
+    }
+
     // The output doc is the same as the input doc, with the added fields.
     MutableDocument output(inputDoc);
     _root->applyExpressions(inputDoc, &output);
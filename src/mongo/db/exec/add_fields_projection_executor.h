@@ -97,6 +97,7 @@ public:
      */
     void optimize() final {
         _root->optimize();
+        _sharedSubexpressions = _root->shareCommonSubexpressions();
     }
 
     DepsTracker::State addDependencies(DepsTracker* deps) const final {
@@ -161,5 +162,8 @@ private:
 
     // The InclusionNode tree does most of the execution work once constructed.
     std::unique_ptr<InclusionNode> _root;
+
+    // Set by optimize() if some subexpressions are shared across the computed fields of '_root'.
+    std::shared_ptr<ExpressionSharedSubexpression::Scope> _sharedSubexpressions;
 };
 }  // namespace mongo::projection_executor
@@ -583,6 +583,57 @@ TEST(AddFieldsProjectionExecutorExecutionTest, AddsNestedAddedFieldsInOrderSpeci
     ASSERT_DOCUMENT_EQ(result, expectedResult);
 }
 
+// Verify that a subexpression repeated across the computed fields is shared, and is still
+// evaluated against each new document.
+TEST(AddFieldsProjectionExecutorOptimize, ShouldShareRepeatedSubexpressions) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    AddFieldsProjectionExecutor addition(expCtx);
+    addition.parse(fromjson("{a: {$multiply: [{$add: ['$x', 1]}, 2]}, 'b.c': {$add: ['$x', 1]}}"));
+    addition.optimize();
+
+    auto sharedExpr = addition.getRoot().getExpressionForPath(FieldPath("b.c"));
+    ASSERT(dynamic_cast<ExpressionSharedSubexpression*>(sharedExpr.get()));
+    auto multiplyExpr = addition.getRoot().getExpressionForPath(FieldPath("a"));
+    ASSERT_EQ(sharedExpr, multiplyExpr->getChildren()[0]);
+
+    // Sharing does not show up in the serialization.
+    ASSERT_DOCUMENT_EQ(
+        Document(fromjson("{a: {$multiply: [{$add: ['$x', {$const: 1}]}, {$const: 2}]}, "
+                          "b: {c: {$add: ['$x', {$const: 1}]}}}")),
+        addition.serializeTransformation(boost::none));
+
+    ASSERT_DOCUMENT_EQ(addition.applyProjection(Document{{"x", 1}}),
+                       Document(fromjson("{x: 1, a: 4, b: {c: 2}}")));
+    ASSERT_DOCUMENT_EQ(addition.applyProjection(Document{{"x", 5}}),
+                       Document(fromjson("{x: 5, a: 12, b: {c: 6}}")));
+
+    // Optimizing again shares the same subexpression again.
+    addition.optimize();
+    sharedExpr = addition.getRoot().getExpressionForPath(FieldPath("b.c"));
+    ASSERT(dynamic_cast<ExpressionSharedSubexpression*>(sharedExpr.get()));
+    ASSERT(!dynamic_cast<ExpressionSharedSubexpression*>(sharedExpr->getChildren()[0].get()));
+    ASSERT_DOCUMENT_EQ(addition.applyProjection(Document{{"x", 2}}),
+                       Document(fromjson("{x: 2, a: 6, b: {c: 3}}")));
+}
+
+TEST(AddFieldsProjectionExecutorOptimize, ShouldNotShareSubexpressionsThatCanDifferPerEvaluation) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    AddFieldsProjectionExecutor addition(expCtx);
+    addition.parse(
+        fromjson("{a: {$rand: {}}, b: {$rand: {}}, "
+                 "c: {$map: {input: '$arr', in: {$add: ['$$this', 1]}}}, "
+                 "d: {$map: {input: '$arr2', in: {$add: ['$$this', 1]}}}}"));
+    addition.optimize();
+
+    for (auto&& field : {"a", "b", "c", "d"}) {
+        auto expr = addition.getRoot().getExpressionForPath(FieldPath(field));
+        ASSERT(!dynamic_cast<ExpressionSharedSubexpression*>(expr.get()));
+        for (auto&& child : expr->getChildren()) {
+            ASSERT(!dynamic_cast<ExpressionSharedSubexpression*>(child.get()));
+        }
+    }
+}
+
 //
 // Misc/Metadata.
 //
@@ -0,0 +1,286 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/and_bitmap.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/exec/filter.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/storage/execution_context.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+// Upper limit for buffered data.
+// Stage execution will fail once size of all buffered data exceeds this threshold.
+const size_t kDefaultMaxMemUsageBytes = 32 * 1024 * 1024;
+
+// How many record ids are added to a bitmap between two checks of the memory usage.
+const size_t kMemoryCheckInterval = 4096;
+
+}  // namespace
+
+// static
+const char* AndBitmapStage::kStageType = "AND_BITMAP";
+
+AndBitmapStage::AndBitmapStage(ExpressionContext* expCtx,
+                               WorkingSet* ws,
+                               const MatchExpression* filter,
+                               const CollectionPtr& collection)
+    : RequiresCollectionStage(kStageType, expCtx, collection),
+      _ws(ws),
+      _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr) {}
+
+void AndBitmapStage::addChild(std::unique_ptr<PlanStage> child, ChildIndexScan indexScan) {
+    _children.emplace_back(std::move(child));
+    _indexScans.push_back(std::move(indexScan));
+}
+
+bool AndBitmapStage::isEOF() {
+    return _currentChild == _children.size() && _nextSurvivor == _survivors.size();
+}
+
+PlanStage::StageState AndBitmapStage::doWork(WorkingSetID* out) {
+    if (isEOF()) {
+        return PlanStage::IS_EOF;
+    }
+
+    if (_currentChild < _children.size()) {
+        return readChild(out);
+    }
+    return fetchNext(out);
+}
+
+PlanStage::StageState AndBitmapStage::readChild(WorkingSetID* out) {
+    WorkingSetID id = WorkingSet::INVALID_ID;
+    StageState childStatus = _children[_currentChild]->work(&id);
+
+    if (PlanStage::ADVANCED == childStatus) {
+        WorkingSetMember* member = _ws->get(id);
+        invariant(member->hasRecordId());
+
+        const auto snapshotId = opCtx()->recoveryUnit()->getSnapshotId();
+        if (_collectedInSnapshot == SnapshotId()) {
+            _collectedInSnapshot = snapshotId;
+        } else if (_collectedInSnapshot != snapshotId) {
+            _collectedAcrossSnapshots = true;
+        }
+
+        // Only the record id is needed. For every child but the first, record ids which are not
+        // in the intersection of the previous children can be dropped right away.
+        const auto recordId = member->recordId.getLong();
+        if (_currentChild == 0 || _intersection.contains(recordId)) {
+            _currentChildIds.add(recordId);
+        }
+        _ws->free(id);
+
+        if (_children[_currentChild]->getCommonStats()->advanced % kMemoryCheckInterval == 0) {
+            checkMemoryUsage();
+        }
+        return PlanStage::NEED_TIME;
+    } else if (PlanStage::IS_EOF == childStatus) {
+        if (_currentChild == 0) {
+            _intersection = std::move(_currentChildIds);
+        } else {
+            _intersection.intersectWith(_currentChildIds);
+        }
+        _currentChildIds = RecordIdBitmap();
+        _specificStats.bitmapAfterChild.push_back(_intersection.size());
+
+        // If the intersection is already empty, the remaining children cannot add to it.
+        ++_currentChild;
+        if (_intersection.empty()) {
+            _currentChild = _children.size();
+        }
+
+        if (_currentChild == _children.size()) {
+            _survivors = _intersection.toVector();
+            _intersection = RecordIdBitmap();
+        }
+        checkMemoryUsage();
+        return PlanStage::NEED_TIME;
+    } else if (PlanStage::NEED_YIELD == childStatus) {
+        *out = id;
+    }
+
+    return childStatus;
+}
+
+PlanStage::StageState AndBitmapStage::fetchNext(WorkingSetID* out) {
+    const RecordId recordId(_survivors[_nextSurvivor]);
+
+    boost::optional<Record> record;
+    try {
+        const auto& coll = collection();
+        if (!_cursor) {
+            _cursor = coll->getCursor(opCtx());
+        }
+        record = _cursor->seekExact(recordId);
+    } catch (const WriteConflictException&) {
+        // The same record id is fetched again after yielding.
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+    ++_nextSurvivor;
+
+    if (!record) {
+        // The document was deleted while the query yielded.
+        return PlanStage::NEED_TIME;
+    }
+
+    const auto snapshotId = opCtx()->recoveryUnit()->getSnapshotId();
+    WorkingSetID id = _ws->allocate();
+    WorkingSetMember* member = _ws->get(id);
+    member->recordId = recordId;
+    member->resetDocument(snapshotId, record->data.releaseToBson());
+    _ws->transitionToRecordIdAndObj(id);
+
+    ++_specificStats.docsExamined;
+
+    // The document may have changed since its record id was produced by the index scans.
+    if (_collectedAcrossSnapshots || snapshotId != _collectedInSnapshot) {
+        if (!isWithinBoundsOfAllScans(member)) {
+            ++_specificStats.docsFailedRevalidation;
+            _ws->free(id);
+            return PlanStage::NEED_TIME;
+        }
+    }
+
+    if (Filter::passes(member, _filter)) {
+        *out = id;
+        return PlanStage::ADVANCED;
+    }
+
+    _ws->free(id);
+    return PlanStage::NEED_TIME;
+}
+
+bool AndBitmapStage::isWithinBoundsOfAllScans(WorkingSetMember* member) {
+    auto& executionCtx = StorageExecutionContext::get(opCtx());
+    const auto doc = member->doc.value().toBson();
+    for (auto&& indexScan : _indexScans) {
+        auto iam = indexScan.descriptor->getEntry()->accessMethod();
+        auto keys = executionCtx.keys();
+        // There's no need to compute the prefixes of the indexed fields that cause the index to be
+        // multikey when ensuring the document is still within the bounds.
+        KeyStringSet* multikeyMetadataKeys = nullptr;
+        MultikeyPaths* multikeyPaths = nullptr;
+        iam->getKeys(opCtx(),
+                     collection(),
+                     executionCtx.pooledBufferBuilder(),
+                     doc,
+                     IndexAccessMethod::GetKeysMode::kEnforceConstraints,
+                     IndexAccessMethod::GetKeysContext::kValidatingKeys,
+                     keys.get(),
+                     multikeyMetadataKeys,
+                     multikeyPaths,
+                     member->recordId,
+                     IndexAccessMethod::kNoopOnSuppressedErrorFn);
+
+        const auto ordering = iam->getSortedDataInterface()->getOrdering();
+        IndexBoundsChecker checker(
+            &indexScan.bounds, indexScan.descriptor->keyPattern(), indexScan.direction);
+        if (std::none_of(keys->begin(), keys->end(), [&](const KeyString::Value& key) {
+                return checker.isValidKey(KeyString::toBson(key, ordering));
+            })) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void AndBitmapStage::checkMemoryUsage() {
+    _memUsage = _intersection.memUsageBytes() + _currentChildIds.memUsageBytes() +
+        _survivors.capacity() * sizeof(int64_t);
+    if (_memUsage > kDefaultMaxMemUsageBytes) {
+        uasserted(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
+                  str::stream() << "bitmap AND stage buffered data usage of " << _memUsage
+                                << " bytes exceeds internal limit of " << kDefaultMaxMemUsageBytes
+                                << " bytes");
+    }
+}
+
+void AndBitmapStage::doSaveStateRequiresCollection() {
+    if (_cursor) {
+        _cursor->saveUnpositioned();
+    }
+}
+
+void AndBitmapStage::doRestoreStateRequiresCollection() {
+    if (_cursor) {
+        const bool couldRestore = _cursor->restore();
+        uassert(6000141, "could not restore cursor for AND_BITMAP stage", couldRestore);
+    }
+}
+
+void AndBitmapStage::doDetachFromOperationContext() {
+    if (_cursor)
+        _cursor->detachFromOperationContext();
+}
+
+void AndBitmapStage::doReattachToOperationContext() {
+    if (_cursor)
+        _cursor->reattachToOperationContext(opCtx());
+}
+
+std::unique_ptr<PlanStageStats> AndBitmapStage::getStats() {
+    _commonStats.isEOF = isEOF();
+
+    // Add a BSON representation of the filter to the stats tree, if there is one.
+    if (nullptr != _filter) {
+        BSONObjBuilder bob;
+        _filter->serialize(&bob);
+        _commonStats.filter = bob.obj();
+    }
+
+    _specificStats.memLimit = kDefaultMaxMemUsageBytes;
+    _specificStats.memUsage = _memUsage;
+
+    auto ret = std::make_unique<PlanStageStats>(_commonStats, STAGE_AND_BITMAP);
+    ret->specific = std::make_unique<AndBitmapStats>(_specificStats);
+    for (auto&& child : _children) {
+        ret->children.emplace_back(child->getStats());
+    }
+    return ret;
+}
+
+const SpecificStats* AndBitmapStage::getSpecificStats() const {
+    return &_specificStats;
+}
+
+}  // namespace mongo
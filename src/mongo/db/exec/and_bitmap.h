@@ -0,0 +1,145 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/db/exec/plan_stats.h"
+#include "mongo/db/exec/record_id_bitmap.h"
+#include "mongo/db/exec/requires_collection_stage.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/query/index_bounds.h"
+#include "mongo/db/storage/snapshot.h"
+
+namespace mongo {
+
+class IndexDescriptor;
+class SeekableRecordCursor;
+
+/**
+ * Reads from N index scan children and intersects the record ids they produce using compressed
+ * bitmaps, then fetches the document of each record id produced by all of them, in record id
+ * order. Unlike AND_HASH, the stage does not keep a WorkingSetMember per candidate: each child is
+ * read to completion into a bitmap which is intersected with the result of the previous children,
+ * and members are only allocated for the documents that are returned.
+ *
+ * Since the index keys are not kept, a document fetched in a different storage snapshot than the
+ * one its record id was collected in is checked against the bounds of every index scan again.
+ *
+ * In WorkingSetMember terms, this stage outputs RID_AND_OBJ members which pass 'filter'.
+ *
+ * Preconditions: More than one child, each of which is an index scan over a collection with
+ * integer record ids.
+ */
+class AndBitmapStage final : public RequiresCollectionStage {
+public:
+    /**
+     * The index scanned by a child, along with the bounds and direction of the scan.
+     */
+    struct ChildIndexScan {
+        const IndexDescriptor* descriptor;
+        IndexBounds bounds;
+        int direction;
+    };
+
+    AndBitmapStage(ExpressionContext* expCtx,
+                   WorkingSet* ws,
+                   const MatchExpression* filter,
+                   const CollectionPtr& collection);
+
+    void addChild(std::unique_ptr<PlanStage> child, ChildIndexScan indexScan);
+
+    StageState doWork(WorkingSetID* out) final;
+    bool isEOF() final;
+
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+
+    StageType stageType() const final {
+        return STAGE_AND_BITMAP;
+    }
+
+    std::unique_ptr<PlanStageStats> getStats() final;
+
+    const SpecificStats* getSpecificStats() const final;
+
+    static const char* kStageType;
+
+protected:
+    void doSaveStateRequiresCollection() final;
+
+    void doRestoreStateRequiresCollection() final;
+
+private:
+    StageState readChild(WorkingSetID* out);
+    StageState fetchNext(WorkingSetID* out);
+
+    /**
+     * Returns true if the document of 'member' still has a key within the bounds of every index
+     * scan.
+     */
+    bool isWithinBoundsOfAllScans(WorkingSetMember* member);
+
+    void checkMemoryUsage();
+
+    // Not owned by us.
+    WorkingSet* _ws;
+
+    // The filter is not owned by us.
+    const MatchExpression* _filter;
+
+    std::vector<ChildIndexScan> _indexScans;
+
+    // The intersection of the record ids produced by the children read so far, and the record ids
+    // produced so far by the child being read.
+    RecordIdBitmap _intersection;
+    RecordIdBitmap _currentChildIds;
+
+    // Which child are we currently reading? Equal to the number of children once all of them have
+    // been read.
+    size_t _currentChild = 0;
+
+    // The snapshot the record ids were collected in, unless they were collected across several.
+    SnapshotId _collectedInSnapshot;
+    bool _collectedAcrossSnapshots = false;
+
+    // The record ids left after intersecting all children, and the next one to fetch.
+    std::vector<int64_t> _survivors;
+    size_t _nextSurvivor = 0;
+
+    std::unique_ptr<SeekableRecordCursor> _cursor;
+
+    size_t _memUsage = 0;
+
+    AndBitmapStats _specificStats;
+};
+
+}  // namespace mongo
@@ -0,0 +1,180 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/batched_id_lookup.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/exec/filter.h"
+#include "mongo/db/exec/working_set.h"
+
+namespace mongo {
+
+// static
+const char* BatchedIdLookupStage::kStageType = "BATCHED_ID_LOOKUP";
+
+BatchedIdLookupStage::BatchedIdLookupStage(ExpressionContext* expCtx,
+                                           WorkingSet* ws,
+                                           std::unique_ptr<PlanStage> child,
+                                           const MatchExpression* filter,
+                                           const CollectionPtr& collection)
+    : RequiresCollectionStage(kStageType, expCtx, collection),
+      _ws(ws),
+      _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr) {
+    _children.emplace_back(std::move(child));
+}
+
+bool BatchedIdLookupStage::isEOF() {
+    return _childDone && _nextRecordId == _recordIds.size();
+}
+
+PlanStage::StageState BatchedIdLookupStage::doWork(WorkingSetID* out) {
+    if (isEOF()) {
+        return PlanStage::IS_EOF;
+    }
+
+    if (!_childDone) {
+        return readChild(out);
+    }
+    return fetchNext(out);
+}
+
+PlanStage::StageState BatchedIdLookupStage::readChild(WorkingSetID* out) {
+    WorkingSetID id = WorkingSet::INVALID_ID;
+    StageState childStatus = child()->work(&id);
+
+    if (PlanStage::ADVANCED == childStatus) {
+        WorkingSetMember* member = _ws->get(id);
+        invariant(member->hasRecordId());
+
+        // Only the record id is needed, the _id key can be read back from the document.
+        _recordIds.push_back(std::move(member->recordId));
+        _ws->free(id);
+        return PlanStage::NEED_TIME;
+    } else if (PlanStage::IS_EOF == childStatus) {
+        std::sort(_recordIds.begin(), _recordIds.end());
+        _specificStats.recordIdsBuffered = _recordIds.size();
+        _childDone = true;
+        return PlanStage::NEED_TIME;
+    } else if (PlanStage::NEED_YIELD == childStatus) {
+        *out = id;
+    }
+
+    return childStatus;
+}
+
+PlanStage::StageState BatchedIdLookupStage::fetchNext(WorkingSetID* out) {
+    const RecordId& recordId = _recordIds[_nextRecordId];
+
+    boost::optional<Record> record;
+    try {
+        const auto& coll = collection();
+        if (!_cursor) {
+            _cursor = coll->getCursor(opCtx());
+        }
+        record = _cursor->seekExact(recordId);
+    } catch (const WriteConflictException&) {
+        // The same record id is fetched again after yielding.
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+    ++_nextRecordId;
+
+    if (!record) {
+        // The document was deleted while the query yielded.
+        return PlanStage::NEED_TIME;
+    }
+
+    WorkingSetID id = _ws->allocate();
+    WorkingSetMember* member = _ws->get(id);
+    member->recordId = recordId;
+    member->resetDocument(opCtx()->recoveryUnit()->getSnapshotId(),
+                          record->data.releaseToBson());
+    _ws->transitionToRecordIdAndObj(id);
+
+    ++_specificStats.docsExamined;
+
+    if (Filter::passes(member, _filter)) {
+        *out = id;
+        return PlanStage::ADVANCED;
+    }
+
+    _ws->free(id);
+    return PlanStage::NEED_TIME;
+}
+
+void BatchedIdLookupStage::doSaveStateRequiresCollection() {
+    if (_cursor) {
+        _cursor->saveUnpositioned();
+    }
+}
+
+void BatchedIdLookupStage::doRestoreStateRequiresCollection() {
+    if (_cursor) {
+        const bool couldRestore = _cursor->restore();
+        uassert(6000143, "could not restore cursor for BATCHED_ID_LOOKUP stage", couldRestore);
+    }
+}
+
+void BatchedIdLookupStage::doDetachFromOperationContext() {
+    if (_cursor)
+        _cursor->detachFromOperationContext();
+}
+
+void BatchedIdLookupStage::doReattachToOperationContext() {
+    if (_cursor)
+        _cursor->reattachToOperationContext(opCtx());
+}
+
+std::unique_ptr<PlanStageStats> BatchedIdLookupStage::getStats() {
+    _commonStats.isEOF = isEOF();
+
+    // Add a BSON representation of the filter to the stats tree, if there is one.
+    if (nullptr != _filter) {
+        BSONObjBuilder bob;
+        _filter->serialize(&bob);
+        _commonStats.filter = bob.obj();
+    }
+
+    auto ret = std::make_unique<PlanStageStats>(_commonStats, STAGE_BATCHED_ID_LOOKUP);
+    ret->specific = std::make_unique<BatchedIdLookupStats>(_specificStats);
+    ret->children.emplace_back(child()->getStats());
+    return ret;
+}
+
+const SpecificStats* BatchedIdLookupStage::getSpecificStats() const {
+    return &_specificStats;
+}
+
+}  // namespace mongo
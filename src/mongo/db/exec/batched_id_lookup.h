@@ -0,0 +1,109 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/db/exec/plan_stats.h"
+#include "mongo/db/exec/requires_collection_stage.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/record_id.h"
+
+namespace mongo {
+
+class SeekableRecordCursor;
+
+/**
+ * Fetches the documents for a large set of _id values. The child is an index scan over the point
+ * bounds of the _id index, which probes the index for the values in key order with a single
+ * cursor. The stage reads every record id produced by the child and sorts them before fetching
+ * the first document, so that the record store is read in record id order rather than in _id
+ * order.
+ *
+ * Since the _id of a document cannot change, the index keys are not kept and the fetched documents
+ * do not need to be checked against the index bounds again, even if the query yielded in between.
+ *
+ * In WorkingSetMember terms, this stage outputs RID_AND_OBJ members which pass 'filter'.
+ *
+ * Preconditions: The child is an index scan over the _id index.
+ */
+class BatchedIdLookupStage final : public RequiresCollectionStage {
+public:
+    BatchedIdLookupStage(ExpressionContext* expCtx,
+                         WorkingSet* ws,
+                         std::unique_ptr<PlanStage> child,
+                         const MatchExpression* filter,
+                         const CollectionPtr& collection);
+
+    StageState doWork(WorkingSetID* out) final;
+    bool isEOF() final;
+
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+
+    StageType stageType() const final {
+        return STAGE_BATCHED_ID_LOOKUP;
+    }
+
+    std::unique_ptr<PlanStageStats> getStats() final;
+
+    const SpecificStats* getSpecificStats() const final;
+
+    static const char* kStageType;
+
+protected:
+    void doSaveStateRequiresCollection() final;
+
+    void doRestoreStateRequiresCollection() final;
+
+private:
+    StageState readChild(WorkingSetID* out);
+    StageState fetchNext(WorkingSetID* out);
+
+    // Not owned by us.
+    WorkingSet* _ws;
+
+    // The filter is not owned by us.
+    const MatchExpression* _filter;
+
+    // Set once the child has been read to EOF and '_recordIds' has been sorted.
+    bool _childDone = false;
+
+    // The record ids produced by the child, and the next one to fetch.
+    std::vector<RecordId> _recordIds;
+    size_t _nextRecordId = 0;
+
+    std::unique_ptr<SeekableRecordCursor> _cursor;
+
+    BatchedIdLookupStats _specificStats;
+};
+
+}  // namespace mongo
@@ -0,0 +1,135 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/batched_random_record_cursor.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace mongo {
+
+BatchedRandomRecordCursor::BatchedRandomRecordCursor(
+    std::unique_ptr<RecordCursor> randomCursor,
+    std::unique_ptr<SeekableRecordCursor> forwardCursor,
+    size_t batchSize,
+    size_t rangesPerRound,
+    int64_t seed)
+    : _randomCursor(std::move(randomCursor)),
+      _forwardCursor(std::move(forwardCursor)),
+      _batchSize(batchSize),
+      _rangesPerRound(rangesPerRound),
+      _prng(seed) {
+    invariant(_randomCursor);
+    invariant(_forwardCursor);
+    invariant(_batchSize > 0);
+    invariant(_rangesPerRound > 0);
+}
+
+boost::optional<Record> BatchedRandomRecordCursor::next() {
+    if (_buffer.empty()) {
+        _fillBuffer();
+        if (_buffer.empty()) {
+            return boost::none;
+        }
+    }
+
+    auto record = std::move(_buffer.back());
+    _buffer.pop_back();
+    return record;
+}
+
+void BatchedRandomRecordCursor::_fillBuffer() {
+    if (_nextRange == _rangeStarts.size()) {
+        std::vector<RecordId> rangeStarts;
+        rangeStarts.reserve(_rangesPerRound);
+        for (size_t i = 0; i < _rangesPerRound; ++i) {
+            auto record = _randomCursor->next();
+            if (!record) {
+                break;
+            }
+            rangeStarts.push_back(std::move(record->id));
+        }
+        std::sort(rangeStarts.begin(), rangeStarts.end());
+        rangeStarts.erase(std::unique(rangeStarts.begin(), rangeStarts.end()), rangeStarts.end());
+
+        _rangeStarts = std::move(rangeStarts);
+        _nextRange = 0;
+    }
+
+    // Each range is read in full before any of its records is kept, so that a write conflict
+    // part way through only causes the range to be read again.
+    for (; _nextRange < _rangeStarts.size(); ++_nextRange) {
+        const auto* end =
+            _nextRange + 1 < _rangeStarts.size() ? &_rangeStarts[_nextRange + 1] : nullptr;
+        auto records = _readRange(_rangeStarts[_nextRange], end);
+        std::move(records.begin(), records.end(), std::back_inserter(_buffer));
+    }
+
+    std::shuffle(_buffer.begin(), _buffer.end(), _prng.urbg());
+}
+
+std::vector<Record> BatchedRandomRecordCursor::_readRange(const RecordId& start,
+                                                          const RecordId* end) {
+    std::vector<Record> records;
+    for (auto record = _forwardCursor->seekExact(start); record && (!end || record->id < *end);
+         record = _forwardCursor->next()) {
+        record->data.makeOwned();
+        records.push_back(std::move(*record));
+        if (records.size() == _batchSize) {
+            break;
+        }
+    }
+    return records;
+}
+
+void BatchedRandomRecordCursor::save() {
+    _buffer.clear();
+    _rangeStarts.clear();
+    _nextRange = 0;
+    _randomCursor->save();
+    _forwardCursor->saveUnpositioned();
+}
+
+bool BatchedRandomRecordCursor::restore() {
+    return _randomCursor->restore() && _forwardCursor->restore();
+}
+
+void BatchedRandomRecordCursor::detachFromOperationContext() {
+    _randomCursor->detachFromOperationContext();
+    _forwardCursor->detachFromOperationContext();
+}
+
+void BatchedRandomRecordCursor::reattachToOperationContext(OperationContext* opCtx) {
+    _randomCursor->reattachToOperationContext(opCtx);
+    _forwardCursor->reattachToOperationContext(opCtx);
+}
+
+}  // namespace mongo
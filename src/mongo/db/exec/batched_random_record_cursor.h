@@ -0,0 +1,104 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/db/storage/record_store.h"
+#include "mongo/platform/random.h"
+
+namespace mongo {
+
+/**
+ * A RecordCursor which samples a collection in rounds of sequential micro-batches, rather than
+ * one random record at a time, to turn most of the random I/O of a large sample into sequential
+ * reads.
+ *
+ * Each round draws up to 'rangesPerRound' records from a random cursor, sorts them by RecordId
+ * and uses them to split the collection into ranges. From the start of each range it reads up to
+ * 'batchSize' consecutive records with a forward cursor, stopping early at the start of the next
+ * range so that ranges of a round never overlap. The records of a round are then returned in a
+ * random order.
+ *
+ * As long as the random cursor picks its records uniformly, each record is returned by a round
+ * with the same probability, about 'batchSize' times that of being picked by the random cursor,
+ * except for the first 'batchSize' - 1 records of the collection, which can only be reached from
+ * fewer starting points. Unlike with a plain random cursor the records of a round are not
+ * independent: records which are close in RecordId order tend to be returned together. Records
+ * may be returned more than once across rounds, so callers must de-duplicate as they would with
+ * a random cursor.
+ *
+ * Records buffered for the current round are dropped on save(), so that no record is returned
+ * from a snapshot older than the one the caller restores to.
+ */
+class BatchedRandomRecordCursor final : public RecordCursor {
+public:
+    BatchedRandomRecordCursor(std::unique_ptr<RecordCursor> randomCursor,
+                              std::unique_ptr<SeekableRecordCursor> forwardCursor,
+                              size_t batchSize,
+                              size_t rangesPerRound,
+                              int64_t seed);
+
+    boost::optional<Record> next() final;
+
+    void save() final;
+    bool restore() final;
+    void detachFromOperationContext() final;
+    void reattachToOperationContext(OperationContext* opCtx) final;
+
+private:
+    /**
+     * Reads the records of the next round into '_buffer'. Leaves '_buffer' empty if the
+     * collection is empty. If this throws, the round is restarted by the next call.
+     */
+    void _fillBuffer();
+
+    /**
+     * Returns the records starting at 'start' and before 'end', if any, up to '_batchSize' of
+     * them. Returns no records if 'start' no longer exists.
+     */
+    std::vector<Record> _readRange(const RecordId& start, const RecordId* end);
+
+    std::unique_ptr<RecordCursor> _randomCursor;
+    std::unique_ptr<SeekableRecordCursor> _forwardCursor;
+    const size_t _batchSize;
+    const size_t _rangesPerRound;
+    PseudoRandom _prng;
+
+    // The starts of the ranges of the current round, in RecordId order, and the next one to read.
+    std::vector<RecordId> _rangeStarts;
+    size_t _nextRange = 0;
+
+    // The owned records of the current round which have not been returned yet.
+    std::vector<Record> _buffer;
+};
+
+}  // namespace mongo
@@ -0,0 +1,184 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/batched_random_record_cursor.h"
+
+#include <map>
+#include <set>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using Records = std::map<RecordId, BSONObj>;
+
+Records makeRecords(long long n) {
+    Records records;
+    for (long long i = 1; i <= n; ++i) {
+        records.emplace(RecordId(i), BSON("_id" << i));
+    }
+    return records;
+}
+
+Record toRecord(const Records::const_iterator& it) {
+    return {it->first, RecordData(it->second.objdata(), it->second.objsize())};
+}
+
+/**
+ * Returns the records with the given ids in order, cycling through them like a random cursor which
+ * never reaches EOF on a non-empty collection.
+ */
+class ScriptedRandomCursor final : public RecordCursor {
+public:
+    ScriptedRandomCursor(const Records& records, std::vector<long long> ids)
+        : _records(records), _ids(std::move(ids)) {}
+
+    boost::optional<Record> next() final {
+        if (_records.empty()) {
+            return boost::none;
+        }
+        return toRecord(_records.find(RecordId(_ids[_next++ % _ids.size()])));
+    }
+
+    void save() final {}
+    bool restore() final {
+        return true;
+    }
+    void detachFromOperationContext() final {}
+    void reattachToOperationContext(OperationContext* opCtx) final {}
+
+private:
+    const Records& _records;
+    const std::vector<long long> _ids;
+    size_t _next = 0;
+};
+
+class ForwardCursor final : public SeekableRecordCursor {
+public:
+    explicit ForwardCursor(const Records& records) : _records(records), _it(_records.end()) {}
+
+    boost::optional<Record> next() final {
+        if (_it == _records.end() || ++_it == _records.end()) {
+            return boost::none;
+        }
+        return toRecord(_it);
+    }
+
+    boost::optional<Record> seekExact(const RecordId& id) final {
+        _it = _records.find(id);
+        if (_it == _records.end()) {
+            return boost::none;
+        }
+        return toRecord(_it);
+    }
+
+    boost::optional<Record> seekNear(const RecordId& start) final {
+        MONGO_UNREACHABLE;
+    }
+
+    void save() final {}
+    bool restore() final {
+        return true;
+    }
+    void detachFromOperationContext() final {}
+    void reattachToOperationContext(OperationContext* opCtx) final {}
+
+private:
+    const Records& _records;
+    Records::const_iterator _it;
+};
+
+std::unique_ptr<BatchedRandomRecordCursor> makeCursor(const Records& records,
+                                                      std::vector<long long> randomIds,
+                                                      size_t batchSize,
+                                                      size_t rangesPerRound) {
+    return std::make_unique<BatchedRandomRecordCursor>(
+        std::make_unique<ScriptedRandomCursor>(records, std::move(randomIds)),
+        std::make_unique<ForwardCursor>(records),
+        batchSize,
+        rangesPerRound,
+        0 /* seed */);
+}
+
+std::multiset<long long> nextIds(RecordCursor* cursor, size_t n) {
+    std::multiset<long long> ids;
+    for (size_t i = 0; i < n; ++i) {
+        auto record = cursor->next();
+        ASSERT(record);
+        ASSERT_EQ(record->id.getLong(), record->data.toBson()["_id"].numberLong());
+        ids.insert(record->id.getLong());
+    }
+    return ids;
+}
+
+TEST(BatchedRandomRecordCursorTest, ReadsABatchFromEachRandomRecord) {
+    const auto records = makeRecords(100);
+    auto cursor = makeCursor(records, {50, 10, 90}, 4, 3);
+    ASSERT(nextIds(cursor.get(), 12) ==
+           std::multiset<long long>({10, 11, 12, 13, 50, 51, 52, 53, 90, 91, 92, 93}));
+}
+
+TEST(BatchedRandomRecordCursorTest, RangesOfARoundDoNotOverlap) {
+    const auto records = makeRecords(100);
+    auto cursor = makeCursor(records, {12, 10, 10, 99}, 4, 4);
+    ASSERT(nextIds(cursor.get(), 8) ==
+           std::multiset<long long>({10, 11, 12, 13, 14, 15, 99, 100}));
+}
+
+TEST(BatchedRandomRecordCursorTest, BatchesStopAtTheEndOfTheCollection) {
+    const auto records = makeRecords(100);
+    auto cursor = makeCursor(records, {99}, 4, 1);
+    ASSERT(nextIds(cursor.get(), 2) == std::multiset<long long>({99, 100}));
+    // The next round starts over from the random cursor.
+    ASSERT(nextIds(cursor.get(), 2) == std::multiset<long long>({99, 100}));
+}
+
+TEST(BatchedRandomRecordCursorTest, EmptyCollectionReturnsEOF) {
+    const Records records;
+    auto cursor = makeCursor(records, {1}, 4, 2);
+    ASSERT_FALSE(cursor->next());
+}
+
+TEST(BatchedRandomRecordCursorTest, SaveDropsTheCurrentRound) {
+    const auto records = makeRecords(100);
+    auto cursor = makeCursor(records, {10, 50}, 4, 1);
+    const auto first = *nextIds(cursor.get(), 1).begin();
+    ASSERT_GTE(first, 10);
+    ASSERT_LTE(first, 13);
+    cursor->save();
+    ASSERT(cursor->restore());
+    ASSERT(nextIds(cursor.get(), 4) == std::multiset<long long>({50, 51, 52, 53}));
+}
+
+}  // namespace
+}  // namespace mongo
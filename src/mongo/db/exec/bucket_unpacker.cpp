@@ -30,6 +30,9 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/exec/bucket_unpacker.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/matcher/expression.h"
 #include "mongo/db/timeseries/timeseries_constants.h"
 
 namespace mongo {
@@ -87,7 +90,12 @@ int BucketUnpacker::computeMeasurementCount(int targetTimestampObjSize) {
 
 void BucketUnpacker::reset(BSONObj&& bucket) {
     _fieldIters.clear();
+    _compressedFieldIters.clear();
+    _filterOnlyFieldIters.clear();
+    _filterOnlyCompressedFieldIters.clear();
+    _fieldReferencedByFilter.clear();
     _timeFieldIter = boost::none;
+    _timeColumn = boost::none;
 
     _bucket = std::move(bucket);
     uassert(5346510, "An empty bucket cannot be unpacked", !_bucket.isEmpty());
@@ -104,7 +112,14 @@ void BucketUnpacker::reset(BSONObj&& bucket) {
             "The $_internalUnpackBucket stage requires the data region to have a timeField object",
             timeFieldElem);
 
-    _timeFieldIter = BSONObjIterator{timeFieldElem.Obj()};
+    // Compressed buckets store every column as a BSONColumn binary which is decompressed while
+    // unpacking.
+    bool compressed = timeFieldElem.type() == BSONType::BinData;
+    if (compressed) {
+        _timeColumn.emplace(_spec.timeField, timeFieldElem);
+    } else {
+        _timeFieldIter = BSONObjIterator{timeFieldElem.Obj()};
+    }
 
     _metaValue = _bucket[timeseries::kBucketMetaFieldName];
     if (_spec.metaField) {
@@ -135,9 +150,27 @@ void BucketUnpacker::reset(BSONObj&& bucket) {
         }
 
         // Includes a field when '_unpackerBehavior' is 'kInclude' and it's found in 'fieldSet' or
-        // _unpackerBehavior is 'kExclude' and it's not found in 'fieldSet'.
-        if (determineIncludeField(colName, _unpackerBehavior, _spec)) {
-            _fieldIters.emplace_back(colName.toString(), BSONObjIterator{elem.Obj()});
+        // _unpackerBehavior is 'kExclude' and it's not found in 'fieldSet'. Columns referenced by
+        // the event filter are unpacked regardless, but only materialized if included.
+        const bool include = determineIncludeField(colName, _unpackerBehavior, _spec);
+        const bool referenced =
+            !_eventFilterFields.empty() && _eventFilterFields.count(colName.toString());
+        if (!include && !referenced) {
+            continue;
+        }
+
+        if (compressed) {
+            uassert(6000111,
+                    "Every column of a compressed bucket must be a BSONColumn binary",
+                    elem.type() == BSONType::BinData);
+            (include ? _compressedFieldIters : _filterOnlyCompressedFieldIters)
+                .emplace_back(colName.toString(), elem);
+        } else {
+            (include ? _fieldIters : _filterOnlyFieldIters)
+                .emplace_back(colName.toString(), BSONObjIterator{elem.Obj()});
+        }
+        if (include) {
+            _fieldReferencedByFilter.push_back(referenced);
         }
     }
 
@@ -148,8 +181,16 @@ void BucketUnpacker::reset(BSONObj&& bucket) {
         }
     }
 
-    // Save the measurement count for the bucket.
-    _numberOfMeasurements = computeMeasurementCount(timeFieldElem.objsize());
+    // Save the measurement count for the bucket. Compressed buckets record it in the control
+    // region, otherwise it is estimated from the size of the timestamp region.
+    if (compressed) {
+        auto count = _bucket[timeseries::kBucketControlFieldName]
+                            [timeseries::kBucketControlCountFieldName];
+        _numberOfMeasurements =
+            count.isNumber() ? count.numberInt() : static_cast<int32_t>(_timeColumn->column->size());
+    } else {
+        _numberOfMeasurements = computeMeasurementCount(timeFieldElem.objsize());
+    }
 }
 
 void BucketUnpacker::setBucketSpecAndBehavior(BucketSpec&& bucketSpec, Behavior behavior) {
@@ -182,10 +223,100 @@ Document BucketUnpacker::getNext() {
     tassert(5521503, "'getNext()' requires the bucket to be owned", _bucket.isOwned());
     tassert(5422100, "'getNext()' was called after the bucket has been exhausted", hasNext());
 
+    _readNextRow();
+    return _materializeRow();
+}
+
+boost::optional<Document> BucketUnpacker::getNextMatching(const MatchExpression& filter) {
+    tassert(6100000, "'getNextMatching()' requires the bucket to be owned", _bucket.isOwned());
+
+    while (hasNext()) {
+        _readNextRow();
+        if (_rowMatches(filter)) {
+            return _materializeRow();
+        }
+    }
+    return boost::none;
+}
+
+void BucketUnpacker::_readNextRow() {
+    if (_timeColumn) {
+        _rowTime = *_timeColumn->it;
+        _rowIndex = _timeColumn->it.index();
+        ++_timeColumn->it;
+    } else {
+        _rowTime = _timeFieldIter->next();
+    }
+
+    auto& currentIdx = _rowTime.fieldNameStringData();
+    auto readColumns = [&](auto& fieldIters, auto& compressedFieldIters, auto& values) {
+        values.clear();
+        for (auto&& [colName, colIter] : fieldIters) {
+            BSONElement value;
+            if (auto&& elem = *colIter;
+                colIter.more() && elem.fieldNameStringData() == currentIdx) {
+                value = elem;
+                colIter.advance(elem);
+            }
+            values.push_back(value);
+        }
+
+        // Compressed columns are positioned at the current row, a missing value is stored as EOO.
+        // Trailing missing values are not stored so a column may be exhausted before the
+        // timestamps.
+        for (auto&& column : compressedFieldIters) {
+            BSONElement value;
+            if (column.it != column.end) {
+                value = *column.it;
+                ++column.it;
+            }
+            values.push_back(value);
+        }
+    };
+    readColumns(_fieldIters, _compressedFieldIters, _rowValues);
+    readColumns(_filterOnlyFieldIters, _filterOnlyCompressedFieldIters, _filterOnlyRowValues);
+}
+
+bool BucketUnpacker::_rowMatches(const MatchExpression& filter) const {
+    BSONObjBuilder bob;
+    if (_eventFilterFields.count(_spec.timeField)) {
+        bob.appendAs(_rowTime, _spec.timeField);
+    }
+    if (_spec.metaField && _metaValue && _eventFilterFields.count(*_spec.metaField)) {
+        bob.appendAs(_metaValue, *_spec.metaField);
+    }
+
+    auto appendColumns = [&](auto& fieldIters,
+                             auto& compressedFieldIters,
+                             auto& values,
+                             auto isReferenced) {
+        size_t i = 0;
+        for (auto&& column : fieldIters) {
+            if (auto& value = values[i]; isReferenced(i++) && !value.eoo()) {
+                bob.appendAs(value, column.first);
+            }
+        }
+        for (auto&& column : compressedFieldIters) {
+            if (auto& value = values[i]; isReferenced(i++) && !value.eoo()) {
+                bob.appendAs(value, column.name);
+            }
+        }
+    };
+    appendColumns(_fieldIters, _compressedFieldIters, _rowValues, [&](size_t i) {
+        return _fieldReferencedByFilter[i];
+    });
+    appendColumns(_filterOnlyFieldIters,
+                  _filterOnlyCompressedFieldIters,
+                  _filterOnlyRowValues,
+                  [](size_t) { return true; });
+
+    return filter.matchesBSON(bob.done());
+}
+
+Document BucketUnpacker::_materializeRow() const {
     auto measurement = MutableDocument{};
-    auto&& timeElem = _timeFieldIter->next();
     if (_includeTimeField) {
-        measurement.addField(_spec.timeField, Value{timeElem});
+        measurement.addField(_spec.timeField, Value{_rowTime});
     }
 
     // Includes metaField when we're instructed to do so and metaField value exists.
@@ -193,25 +324,31 @@ Document BucketUnpacker::getNext() {
         measurement.addField(*_spec.metaField, Value{_metaValue});
     }
 
-    auto& currentIdx = timeElem.fieldNameStringData();
-    for (auto&& [colName, colIter] : _fieldIters) {
-        if (auto&& elem = *colIter; colIter.more() && elem.fieldNameStringData() == currentIdx) {
-            measurement.addField(colName, Value{elem});
-            colIter.advance(elem);
+    size_t i = 0;
+    for (auto&& column : _fieldIters) {
+        if (auto& value = _rowValues[i++]; !value.eoo()) {
+            measurement.addField(column.first, Value{value});
+        }
+    }
+    for (auto&& column : _compressedFieldIters) {
+        if (auto& value = _rowValues[i++]; !value.eoo()) {
+            measurement.addField(column.name, Value{value});
         }
     }
 
     // Add computed meta projections.
     for (auto&& name : _spec.computedMetaProjFields) {
-        measurement.addField(name, Value{_computedMetaProjections[name]});
+        measurement.addField(name, Value{_computedMetaProjections.at(name)});
     }
 
     if (_spec.includeBucketIdAndRowIndex) {
         MutableDocument nestedMeasurement{};
         nestedMeasurement.addField("bucketId", Value{_bucket[timeseries::kBucketIdFieldName]});
-        int rowIndex;
-        uassertStatusOK(NumberParser()(currentIdx, &rowIndex));
-        nestedMeasurement.addField("rowIndex", Value{rowIndex});
+        auto rowIndex = _rowIndex;
+        if (!_timeColumn) {
+            uassertStatusOK(NumberParser()(_rowTime.fieldNameStringData(), &rowIndex));
+        }
+        nestedMeasurement.addField("rowIndex", Value{static_cast<int>(rowIndex)});
         nestedMeasurement.addField("rowData", measurement.freezeToValue());
         return nestedMeasurement.freeze();
     }
@@ -234,12 +371,26 @@ Document BucketUnpacker::extractSingleMeasurement(int j) {
         measurement.addField(*_spec.metaField, Value{_metaValue});
     }
 
+    auto compressedColumn = _compressedFieldIters.begin();
     for (auto&& dataElem : dataRegion) {
         auto colName = dataElem.fieldNameStringData();
         if (!determineIncludeField(colName, _unpackerBehavior, _spec)) {
             continue;
         }
-        auto value = dataElem[targetIdx];
+
+        BSONElement value;
+        if (!_timeColumn) {
+            value = dataElem[targetIdx];
+        } else if (colName == _spec.timeField) {
+            value = (*_timeColumn->column)[j];
+        } else {
+            // The compressed columns were set up in the order of the data region on reset.
+            tassert(6000112,
+                    "Compressed column does not match the data region of the bucket",
+                    compressedColumn != _compressedFieldIters.end() &&
+                        compressedColumn->name == colName);
+            value = (*(compressedColumn++)->column)[j];
+        }
         if (value) {
             measurement.addField(dataElem.fieldNameStringData(), Value{value});
         }
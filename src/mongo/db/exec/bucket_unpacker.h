@@ -33,9 +33,13 @@
 #include <set>
 
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/util/bsoncolumn.h"
 #include "mongo/db/exec/document_value/document.h"
 
 namespace mongo {
+
+class MatchExpression;
+
 /**
  * Carries parameters for unpacking a bucket.
  */
@@ -105,6 +109,14 @@ public:
      */
     Document getNext();
 
+    /**
+     * Skips the measurements which do not match 'filter' and materializes the first one which
+     * does, or returns boost::none if the bucket is exhausted first. The filter is evaluated
+     * against an object built directly from the raw column values of the fields set with
+     * 'setEventFilterFields()', so a Document is only materialized for matching measurements.
+     */
+    boost::optional<Document> getNextMatching(const MatchExpression& filter);
+
     /**
      * This method will extract the j-th measurement from the bucket. A precondition of this method
      * is that j >= 0 && j <= the number of measurements within the underlying bucket.
@@ -112,6 +124,9 @@ public:
     Document extractSingleMeasurement(int j);
 
     bool hasNext() const {
+        if (_timeColumn) {
+            return _timeColumn->it != _timeColumn->end;
+        }
         return _timeFieldIter && _timeFieldIter->more();
     }
 
@@ -146,16 +161,65 @@ public:
 
     void setBucketSpecAndBehavior(BucketSpec&& bucketSpec, Behavior behavior);
 
+    /**
+     * Sets the top-level fields referenced by the filter passed to 'getNextMatching()'. Columns
+     * for these fields are unpacked even if they are not part of the materialized measurements.
+     * Takes effect on the next call to 'reset()'.
+     */
+    void setEventFilterFields(std::set<std::string> fields) {
+        _eventFilterFields = std::move(fields);
+    }
+
     // Add computed meta projection names to the bucket specification.
     void addComputedMetaProjFields(const std::vector<StringData>& computedFieldNames);
 
 private:
+    /**
+     * A column of a compressed bucket stored as a BSONColumn binary, along with the position of
+     * the next measurement. Decompressed values are owned by the BSONColumn, which is shared when
+     * the unpacker is copied.
+     */
+    struct CompressedColumn {
+        CompressedColumn(std::string name, BSONElement binary)
+            : name(std::move(name)),
+              column(std::make_shared<BSONColumn>(binary)),
+              it(column->begin()),
+              end(column->end()) {}
+
+        std::string name;
+        std::shared_ptr<BSONColumn> column;
+        BSONColumn::Iterator it;
+        BSONColumn::Iterator end;
+    };
+
+    /**
+     * Advances every column to the next measurement, saving its values into '_rowTime',
+     * '_rowValues' and '_filterOnlyRowValues'.
+     */
+    void _readNextRow();
+
+    /**
+     * Returns whether the measurement last read by '_readNextRow()' matches 'filter'.
+     */
+    bool _rowMatches(const MatchExpression& filter) const;
+
+    /**
+     * Builds the measurement last read by '_readNextRow()'.
+     */
+    Document _materializeRow() const;
+
     BucketSpec _spec;
     Behavior _unpackerBehavior;
 
+    // Top-level fields referenced by the filter passed to 'getNextMatching()'.
+    std::set<std::string> _eventFilterFields;
+
     // Iterates the timestamp section of the bucket to drive the unpacking iteration.
     boost::optional<BSONObjIterator> _timeFieldIter;
 
+    // Drives the unpacking iteration instead of '_timeFieldIter' when the bucket is compressed.
+    boost::optional<CompressedColumn> _timeColumn;
+
     // A flag used to mark that the timestamp value should be materialized in measurements.
     bool _includeTimeField;
 
@@ -174,6 +238,27 @@ private:
     // phase according to the provided 'Behavior' and 'BucketSpec'.
     std::vector<std::pair<std::string, BSONObjIterator>> _fieldIters;
 
+    // Same as '_fieldIters' when the bucket is compressed. Values are decompressed directly from
+    // the BSONColumn binaries, in the same order as the timestamp column.
+    std::vector<CompressedColumn> _compressedFieldIters;
+
+    // Same as '_fieldIters' and '_compressedFieldIters' for columns which are only unpacked to
+    // evaluate the filter passed to 'getNextMatching()' and are not part of the measurements.
+    std::vector<std::pair<std::string, BSONObjIterator>> _filterOnlyFieldIters;
+    std::vector<CompressedColumn> _filterOnlyCompressedFieldIters;
+
+    // Whether each column of '_fieldIters' or '_compressedFieldIters' (whichever is in use) is
+    // referenced by the filter passed to 'getNextMatching()'.
+    std::vector<bool> _fieldReferencedByFilter;
+
+    // The values of the measurement last read by '_readNextRow()'. '_rowValues' is parallel to
+    // '_fieldIters' or '_compressedFieldIters' and '_filterOnlyRowValues' to their filter-only
+    // counterparts. Missing values are EOO.
+    BSONElement _rowTime;
+    size_t _rowIndex = 0;
+    std::vector<BSONElement> _rowValues;
+    std::vector<BSONElement> _filterOnlyRowValues;
+
     // Map <name, BSONElement> for the computed meta field projections. Updated for
     // every bucket upon reset().
     stdx::unordered_map<std::string, BSONElement> _computedMetaProjections;
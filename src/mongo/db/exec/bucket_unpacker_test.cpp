@@ -32,6 +32,8 @@
 #include "mongo/bson/json.h"
 #include "mongo/db/exec/bucket_unpacker.h"
 #include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/timeseries/bucket_compression.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -646,6 +648,138 @@ TEST_F(BucketUnpackerTest, ExtractSingleMeasurementSparseIncludeBucketIdRowIndex
     ASSERT_DOCUMENT_EQ(next, expected);
 }
 
+TEST_F(BucketUnpackerTest, UnpackCompressedBucket) {
+    std::set<std::string> fields{};
+
+    auto bucket = fromjson(
+        "{_id: 0, control: {version: 1}, meta: {'m1': 999, 'm2': 9999}, data: {_id: {'0':1, "
+        "'1':2, '2':3}, time: {'0':1, '1':2, '2':3}, a:{'0':1, '2':3}, b:{'1':1}}}");
+    auto compressed = timeseries::compressBucket(bucket, kUserDefinedTimeName);
+    ASSERT(compressed);
+
+    auto spec = BucketSpec{
+        kUserDefinedTimeName.toString(), kUserDefinedMetaName.toString(), std::move(fields)};
+    spec.includeBucketIdAndRowIndex = true;
+    BucketUnpacker unpacker{std::move(spec), BucketUnpacker::Behavior::kExclude};
+    unpacker.reset(std::move(*compressed));
+    ASSERT_EQ(unpacker.numberOfMeasurements(), 3);
+
+    ASSERT_TRUE(unpacker.hasNext());
+    assertGetNext(unpacker,
+                  Document{fromjson("{bucketId: 0, rowIndex: 0, rowData: {time: 1, myMeta: {m1: "
+                                    "999, m2: 9999}, _id: 1, a: 1}}")});
+    ASSERT_TRUE(unpacker.hasNext());
+    assertGetNext(unpacker,
+                  Document{fromjson("{bucketId: 0, rowIndex: 1, rowData: {time: 2, myMeta: {m1: "
+                                    "999, m2: 9999}, _id: 2, b: 1}}")});
+    ASSERT_TRUE(unpacker.hasNext());
+    assertGetNext(unpacker,
+                  Document{fromjson("{bucketId: 0, rowIndex: 2, rowData: {time: 3, myMeta: {m1: "
+                                    "999, m2: 9999}, _id: 3, a: 3}}")});
+    ASSERT_FALSE(unpacker.hasNext());
+}
+
+TEST_F(BucketUnpackerTest, UnpackCompressedBucketIncludeSingleField) {
+    std::set<std::string> fields{"b"};
+
+    auto bucket = fromjson(
+        "{control: {version: 1}, data: {time: {'0':1, '1':2}, a:{'0':1, '1':2}, b:{'1':1}}}");
+    auto compressed = timeseries::compressBucket(bucket, kUserDefinedTimeName);
+    ASSERT(compressed);
+
+    auto unpacker = makeBucketUnpacker(
+        std::move(fields), BucketUnpacker::Behavior::kInclude, std::move(*compressed));
+    ASSERT_TRUE(unpacker.hasNext());
+    assertGetNext(unpacker, Document{});
+    ASSERT_TRUE(unpacker.hasNext());
+    assertGetNext(unpacker, Document{fromjson("{b: 1}")});
+    ASSERT_FALSE(unpacker.hasNext());
+}
+
+TEST_F(BucketUnpackerTest, ExtractSingleMeasurementFromCompressedBucket) {
+    std::set<std::string> fields{
+        "_id", kUserDefinedMetaName.toString(), kUserDefinedTimeName.toString(), "a", "b"};
+    auto spec = BucketSpec{
+        kUserDefinedTimeName.toString(), kUserDefinedMetaName.toString(), std::move(fields)};
+    auto unpacker = BucketUnpacker{std::move(spec), BucketUnpacker::Behavior::kInclude};
+
+    auto d1 = dateFromISOString("2020-02-17T00:00:00.000Z").getValue();
+    auto d2 = dateFromISOString("2020-02-17T01:00:00.000Z").getValue();
+    auto bucket = BSON("control" << BSON("version" << 1) << "meta"
+                                 << BSON("m1" << 999 << "m2" << 9999) << "data"
+                                 << BSON("_id" << BSON("0" << 1 << "1" << 2) << "time"
+                                               << BSON("0" << d1 << "1" << d2) << "a"
+                                               << BSON("0" << 1) << "b" << BSON("1" << 1)));
+    auto compressed = timeseries::compressBucket(bucket, kUserDefinedTimeName);
+    ASSERT(compressed);
+
+    unpacker.reset(std::move(*compressed));
+    ASSERT_EQ(unpacker.numberOfMeasurements(), 2);
+
+    auto next = unpacker.extractSingleMeasurement(1);
+    auto expected = Document{
+        {"myMeta", Document{{"m1", 999}, {"m2", 9999}}}, {"_id", 2}, {"time", d2}, {"b", 1}};
+    ASSERT_DOCUMENT_EQ(next, expected);
+
+    next = unpacker.extractSingleMeasurement(0);
+    expected = Document{
+        {"myMeta", Document{{"m1", 999}, {"m2", 9999}}}, {"_id", 1}, {"time", d1}, {"a", 1}};
+    ASSERT_DOCUMENT_EQ(next, expected);
+
+    // Random access does not interfere with iteration.
+    ASSERT_TRUE(unpacker.hasNext());
+    assertGetNext(unpacker,
+                  Document{{"time", d1},
+                           {"myMeta", Document{{"m1", 999}, {"m2", 9999}}},
+                           {"_id", 1},
+                           {"a", 1}});
+}
+
+TEST_F(BucketUnpackerTest, GetNextMatchingSkipsMeasurementsWhichDoNotMatch) {
+    std::set<std::string> fields{};
+
+    auto bucket = fromjson(
+        "{meta: {'m1': 999, 'm2': 9999}, data: {_id: {'0':1, '1':2, '2':3}, time: {'0':1, '1':2, "
+        "'2':3}, a:{'0':1, '2':3}, b:{'1':1}}}");
+
+    auto spec = BucketSpec{
+        kUserDefinedTimeName.toString(), kUserDefinedMetaName.toString(), std::move(fields)};
+    BucketUnpacker unpacker{std::move(spec), BucketUnpacker::Behavior::kExclude};
+    unpacker.setEventFilterFields({"a"});
+    unpacker.reset(std::move(bucket));
+
+    GTMatchExpression filter("a"_sd, Value(1));
+    auto measurement = unpacker.getNextMatching(filter);
+    ASSERT(measurement);
+    ASSERT_DOCUMENT_EQ(*measurement,
+                       Document{fromjson("{time: 3, myMeta: {m1: 999, m2: 9999}, _id: 3, a: 3}")});
+    ASSERT_FALSE(unpacker.hasNext());
+    ASSERT_FALSE(unpacker.getNextMatching(filter));
+}
+
+TEST_F(BucketUnpackerTest, GetNextMatchingEvaluatesFilterOnExcludedColumns) {
+    std::set<std::string> fields{"a"};
+
+    auto bucket = fromjson(
+        "{control: {version: 1}, data: {time: {'0':1, '1':2, '2':3}, a:{'0':1, '1':2, '2':3}, "
+        "b:{'1':1}}}");
+    auto compressed = timeseries::compressBucket(bucket, kUserDefinedTimeName);
+    ASSERT(compressed);
+
+    // The filter references 'b', which is not part of the materialized measurements.
+    auto spec = BucketSpec{kUserDefinedTimeName.toString(), boost::none, std::move(fields)};
+    BucketUnpacker unpacker{std::move(spec), BucketUnpacker::Behavior::kInclude};
+    unpacker.setEventFilterFields({"b"});
+    unpacker.reset(std::move(*compressed));
+
+    EqualityMatchExpression filter("b"_sd, Value(1));
+    auto measurement = unpacker.getNextMatching(filter);
+    ASSERT(measurement);
+    ASSERT_DOCUMENT_EQ(*measurement, Document{fromjson("{a: 2}")});
+    ASSERT_TRUE(unpacker.hasNext());
+    ASSERT_FALSE(unpacker.getNextMatching(filter));
+}
+
 TEST_F(BucketUnpackerTest, ComputeMeasurementCountLowerBoundsAreCorrect) {
     // The last table entry is a sentinel for an upper bound on the interval that covers measurement
     // counts up to 16 MB.
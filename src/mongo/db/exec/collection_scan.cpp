@@ -70,12 +70,14 @@ CollectionScan::CollectionScan(ExpressionContext* expCtx,
     _specificStats.tailable = params.tailable;
     if (params.minRecord || params.maxRecord) {
         // The 'minRecord' and 'maxRecord' parameters are used for a special optimization that
-        // applies only to forwards scans of the oplog and scans on collections clustered by _id.
+        // applies only to forwards scans of the oplog and scans on collections clustered by _id,
+        // and to split forward scans of other collections into RecordId ranges.
         invariant(!params.resumeAfterRecordId);
         if (collection->ns().isOplog()) {
             invariant(params.direction == CollectionScanParams::FORWARD);
         } else {
-            invariant(collection->isClustered());
+            invariant(collection->isClustered() ||
+                      params.direction == CollectionScanParams::FORWARD);
         }
     }
     LOGV2_DEBUG(5400802,
@@ -252,6 +254,15 @@ void CollectionScan::assertTsHasNotFallenOffOplog(const Record& record) {
 }
 
 namespace {
+bool beforeStartOfRangeInclusive(const CollectionScanParams& params,
+                                 const WorkingSetMember& member) {
+    if (params.direction == CollectionScanParams::FORWARD) {
+        return params.minRecord && member.recordId < *params.minRecord;
+    } else {
+        return params.maxRecord && member.recordId > *params.maxRecord;
+    }
+}
+
 bool atEndOfRangeInclusive(const CollectionScanParams& params, const WorkingSetMember& member) {
     if (params.direction == CollectionScanParams::FORWARD) {
         return params.maxRecord && member.recordId > *params.maxRecord;
@@ -275,6 +286,12 @@ PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
         return PlanStage::IS_EOF;
     }
 
+    // The initial seekNear() may position the cursor on the record just outside the range.
+    if (beforeStartOfRangeInclusive(_params, *member)) {
+        _workingSet->free(memberID);
+        return PlanStage::NEED_TIME;
+    }
+
     if (Filter::passes(member, _filter)) {
         if (_params.stopApplyingFilterAfterFirstMatch) {
             _filter = nullptr;
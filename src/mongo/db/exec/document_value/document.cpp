@@ -46,6 +46,85 @@ using std::vector;
 
 const DocumentStorage DocumentStorage::kEmptyDoc;
 
+namespace {
+
+/**
+ * Per-thread free lists of DocumentStorage buffers, one per power-of-two size up to
+ * kMaxPooledBufferSize. A pipeline builds and destroys documents of the same few shapes for every
+ * input document, so most buffers can be handed out again without going through the allocator. A
+ * buffer freed on another thread than the one which allocated it goes to the free list of the
+ * freeing thread. The state is trivially destructible, so that buffers freed by thread-local or
+ * static Documents destroyed after ~BufferPoolReleaser() simply go back to the allocator.
+ */
+constexpr size_t kMinPooledBufferSize = 128;
+constexpr size_t kMaxPooledBufferSize = 2048;
+constexpr size_t kNumBufferSizeClasses = 5;
+constexpr size_t kMaxPooledBuffersPerSizeClass = 16;
+
+struct BufferPool {
+    char* buffers[kNumBufferSizeClasses][kMaxPooledBuffersPerSizeClass];
+    size_t numBuffers[kNumBufferSizeClasses];
+    bool released;
+    uint64_t numAllocations;
+};
+
+thread_local BufferPool bufferPool;
+
+// Returns the buffers of the pool to the allocator when the thread exits.
+struct BufferPoolReleaser {
+    ~BufferPoolReleaser() {
+        for (size_t sizeClass = 0; sizeClass < kNumBufferSizeClasses; ++sizeClass) {
+            while (bufferPool.numBuffers[sizeClass] > 0) {
+                delete[] bufferPool.buffers[sizeClass][--bufferPool.numBuffers[sizeClass]];
+            }
+        }
+        bufferPool.released = true;
+    }
+};
+
+thread_local BufferPoolReleaser bufferPoolReleaser;
+
+// Returns the free list for buffers of 'size' bytes, or -1 if they are not pooled.
+int bufferSizeClass(size_t size) {
+    if (size < kMinPooledBufferSize || size > kMaxPooledBufferSize || (size & (size - 1)) != 0) {
+        return -1;
+    }
+    int sizeClass = 0;
+    for (size_t classSize = kMinPooledBufferSize; classSize < size; classSize *= 2) {
+        ++sizeClass;
+    }
+    return sizeClass;
+}
+
+}  // namespace
+
+char* DocumentStorage::allocateBuffer(size_t size) {
+    const int sizeClass = bufferSizeClass(size);
+    if (sizeClass >= 0 && bufferPool.numBuffers[sizeClass] > 0) {
+        return bufferPool.buffers[sizeClass][--bufferPool.numBuffers[sizeClass]];
+    }
+
+    ++bufferPool.numAllocations;
+    return new char[size];
+}
+
+void DocumentStorage::freeBuffer(char* buffer, size_t size) {
+    const int sizeClass = bufferSizeClass(size);
+    if (sizeClass >= 0 && !bufferPool.released &&
+        bufferPool.numBuffers[sizeClass] < kMaxPooledBuffersPerSizeClass) {
+        // Touch the releaser, so that it is constructed and runs at thread exit.
+        (void)&bufferPoolReleaser;
+        bufferPool.buffers[sizeClass][bufferPool.numBuffers[sizeClass]++] = buffer;
+        return;
+    }
+
+    delete[] buffer;
+}
+
+uint64_t DocumentStorage::numBufferAllocations() {
+    return bufferPool.numAllocations;
+}
+
 const StringDataSet Document::allMetadataFieldNames{Document::metaFieldTextScore,
                                                     Document::metaFieldRandVal,
                                                     Document::metaFieldSortKey,
@@ -246,6 +325,7 @@ void DocumentStorage::alloc(unsigned newSize) {
     const bool firstAlloc = !_cache;
     const bool doingRehash = needRehash();
     const size_t oldCapacity = _cacheEnd - _cache;
+    const size_t oldAllocatedBytes = allocatedBytes();
 
     // make new bucket count big enough
     while (needRehash() || hashTabBuckets() < HASH_TAB_INIT_SIZE)
@@ -258,13 +338,13 @@ void DocumentStorage::alloc(unsigned newSize) {
 
     uassert(16490, "Tried to make oversized document", capacity <= size_t(BufferMaxSize));
 
-    std::unique_ptr<char[]> oldBuf(_cache);
-    _cache = new char[capacity];
+    char* oldBuf = _cache;
+    _cache = allocateBuffer(capacity);
     _cacheEnd = _cache + capacity - hashTabBytes();
 
     if (!firstAlloc) {
         // This just copies the elements
-        memcpy(_cache, oldBuf.get(), _usedBytes);
+        memcpy(_cache, oldBuf, _usedBytes);
 
         if (_numFields >= HASH_TAB_MIN) {
             // if we were hashing, deal with the hash table
@@ -272,9 +352,11 @@ void DocumentStorage::alloc(unsigned newSize) {
                 rehash();
             } else {
                 // no rehash needed so just slide table down to new position
-                memcpy(_hashTab, oldBuf.get() + oldCapacity, hashTabBytes());
+                memcpy(_hashTab, oldBuf + oldCapacity, hashTabBytes());
             }
         }
+
+        freeBuffer(oldBuf, oldAllocatedBytes);
     }
 }
 
@@ -291,7 +373,7 @@ void DocumentStorage::reserveFields(size_t expectedFields) {
 
     uassert(16491, "Tried to make oversized document", newSize <= size_t(BufferMaxSize));
 
-    _cache = new char[newSize + hashTabBytes()];
+    _cache = allocateBuffer(newSize + hashTabBytes());
     _cacheEnd = _cache + newSize;
 }
 
@@ -303,7 +385,7 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
         // Make a copy of the buffer with the fields.
         // It is very important that the positions of each field are the same after cloning.
         const size_t bufferBytes = allocatedBytes();
-        out->_cache = new char[bufferBytes];
+        out->_cache = allocateBuffer(bufferBytes);
         out->_cacheEnd = out->_cache + (_cacheEnd - _cache);
         memcpy(out->_cache, _cache, bufferBytes);
 
@@ -335,11 +417,13 @@ size_t DocumentStorage::getMetadataApproximateSize() const {
 }
 
 DocumentStorage::~DocumentStorage() {
-    std::unique_ptr<char[]> deleteBufferAtScopeEnd(_cache);
-
     for (auto it = iteratorCacheOnly(); !it.atEnd(); it.advance()) {
         it->val.~Value();  // explicit destructor call
     }
+
+    if (_cache) {
+        freeBuffer(_cache, allocatedBytes());
+    }
 }
 
 void DocumentStorage::reset(const BSONObj& bson, bool stripMetadata) {
@@ -348,12 +432,17 @@ void DocumentStorage::reset(const BSONObj& bson, bool stripMetadata) {
     _stripMetadata = stripMetadata;
     _modified = false;
 
-    // Clean cache.
+    // Clean cache. The buffer goes back to the pool, from which the next field added is likely to
+    // get it again.
     for (auto it = iteratorCacheOnly(); !it.atEnd(); it.advance()) {
         it->val.~Value();  // explicit destructor call
     }
 
-    _cacheEnd = _cache;
+    if (_cache) {
+        freeBuffer(_cache, allocatedBytes());
+    }
+    _cache = nullptr;
+    _cacheEnd = nullptr;
     _usedBytes = 0;
     _numFields = 0;
     _hashTabMask = 0;
@@ -517,7 +517,18 @@ public:
         return _bson;
     }
 
+    /**
+     * Returns the number of buffers which DocumentStorage instances on the current thread got from
+     * the allocator rather than by reusing the buffer of a destroyed or reset one. Used by
+     * benchmarks and tests.
+     */
+    static uint64_t numBufferAllocations();
+
 private:
+    /// Allocates and frees the buffers backing '_cache', recycling them through a per-thread pool.
+    static char* allocateBuffer(size_t size);
+    static void freeBuffer(char* buffer, size_t size);
+
     /// Returns the position of the named field in the cache or Position()
     Position findFieldInCache(StringData name) const;
 
@@ -137,6 +137,46 @@ TEST(DocumentConstruction, FromBsonReset) {
     ASSERT_BSONOBJ_EQ(bson, toBson(newDocument));
 }
 
+Document makeDocumentWithTenFields() {
+    MutableDocument md;
+    for (int i = 0; i < 10; ++i) {
+        md.addField("field" + std::to_string(i), Value(i));
+    }
+    return md.freeze();
+}
+
+TEST(DocumentStorageBuffers, BuffersOfDestroyedDocumentsAreReused) {
+    auto buildAndCloneDocument = [] {
+        auto document = makeDocumentWithTenFields();
+        ASSERT_EQ(document.computeSize(), 10ULL);
+        ASSERT_VALUE_EQ(document["field9"], Value(9));
+
+        // A clone gets its own buffer of the same size.
+        auto clone = document.clone();
+        ASSERT_DOCUMENT_EQ(document, clone);
+    };
+
+    // The first round leaves a buffer of every size the documents went through in the pool.
+    buildAndCloneDocument();
+
+    const auto numAllocations = DocumentStorage::numBufferAllocations();
+    for (int i = 0; i < 10; ++i) {
+        buildAndCloneDocument();
+    }
+    ASSERT_EQ(numAllocations, DocumentStorage::numBufferAllocations());
+}
+
+TEST(DocumentStorageBuffers, BufferOfResetDocumentIsReused) {
+    MutableDocument md(makeDocumentWithTenFields());
+    md.reset(BSON("a" << 1), false);
+    ASSERT_BSONOBJ_EQ(md.peek().toBson(), BSON("a" << 1));
+
+    const auto numAllocations = DocumentStorage::numBufferAllocations();
+    md.addField("b", Value(2));
+    ASSERT_EQ(numAllocations, DocumentStorage::numBufferAllocations());
+    ASSERT_DOCUMENT_EQ(md.freeze(), (Document{{"a", 1}, {"b", 2}}));
+}
+
 /**
  * Appends to 'builder' an object nested 'depth' levels deep.
  */
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <absl/container/flat_hash_map.h>
 #include <map>
 #include <set>
 
@@ -200,6 +201,17 @@ public:
         return stdx::unordered_map<Value, T, Hasher, EqualTo>(0, Hasher(this), EqualTo(this));
     }
 
+    /**
+     * Like makeUnorderedValueMap(), but the entries are stored inline in the hash table rather than
+     * in a node each. References to entries are invalidated when the table grows.
+     */
+    template <typename T>
+    absl::flat_hash_map<Value, T, EnsureTrustedHasher<Hasher, Value>, EqualTo>
+    makeFlatUnorderedValueMap() const {
+        return absl::flat_hash_map<Value, T, EnsureTrustedHasher<Hasher, Value>, EqualTo>(
+            0, Hasher(this), EqualTo(this));
+    }
+
 private:
     const StringData::ComparatorInterface* _stringComparator = nullptr;
 };
@@ -224,4 +236,11 @@ template <typename T>
 using ValueUnorderedMap =
     stdx::unordered_map<Value, T, ValueComparator::Hasher, ValueComparator::EqualTo>;
 
+template <typename T>
+using ValueFlatUnorderedMap =
+    absl::flat_hash_map<Value,
+                        T,
+                        EnsureTrustedHasher<ValueComparator::Hasher, Value>,
+                        ValueComparator::EqualTo>;
+
 }  // namespace mongo
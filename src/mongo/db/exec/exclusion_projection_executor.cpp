@@ -32,6 +32,88 @@
 #include "mongo/db/exec/exclusion_projection_executor.h"
 
 namespace mongo::projection_executor {
+Document FastPathEligibleExclusionNode::applyToDocument(const Document& inputDoc) const {
+    // A fast-path exclusion projection supports exclusion-only fields, so make sure we have no
+    // $meta expressions in the specification.
+    invariant(!_subtreeContainsComputedFields);
+
+    // If we can get the backing BSON object off the input document without allocating an owned
+    // copy, then we can apply a fast-path BSON-to-BSON exclusion projection.
+    if (auto bson = inputDoc.toBsonIfTriviallyConvertible()) {
+        BSONObjBuilder bob;
+        _applyProjections(*bson, &bob);
+
+        Document outputDoc{bob.obj()};
+        // Make sure that we always pass through any metadata present in the input doc.
+        if (inputDoc.metadata()) {
+            MutableDocument md{std::move(outputDoc)};
+            md.copyMetaDataFrom(inputDoc);
+            return md.freeze();
+        }
+        return outputDoc;
+    }
+
+    // A fast-path projection is not feasible, fall back to default implementation.
+    return ExclusionNode::applyToDocument(inputDoc);
+}
+
+void FastPathEligibleExclusionNode::_applyProjections(BSONObj bson, BSONObjBuilder* bob) const {
+    auto nFieldsToVisit = _projectedFields.size() + _children.size();
+
+    BSONObjIterator it{bson};
+    while (it.more()) {
+        const auto bsonElement{it.next()};
+
+        // Once every excluded field and child has been seen, the rest of the input is copied over.
+        if (nFieldsToVisit == 0) {
+            bob->append(bsonElement);
+            continue;
+        }
+
+        const auto fieldName{bsonElement.fieldNameStringData()};
+        if (_projectedFields.find(fieldName) != _projectedFields.end()) {
+            --nFieldsToVisit;
+        } else if (auto childIt = _children.find(fieldName); childIt != _children.end()) {
+            auto child = static_cast<FastPathEligibleExclusionNode*>(childIt->second.get());
+
+            if (bsonElement.type() == BSONType::Object) {
+                BSONObjBuilder subBob{bob->subobjStart(fieldName)};
+                child->_applyProjections(bsonElement.embeddedObject(), &subBob);
+            } else if (bsonElement.type() == BSONType::Array) {
+                BSONArrayBuilder subBab{bob->subarrayStart(fieldName)};
+                child->_applyProjectionsToArray(bsonElement.embeddedObject(), &subBab);
+            } else {
+                // There is nothing to exclude underneath a scalar, so it is retained as is.
+                bob->append(bsonElement);
+            }
+            --nFieldsToVisit;
+        } else {
+            bob->append(bsonElement);
+        }
+    }
+}
+
+void FastPathEligibleExclusionNode::_applyProjectionsToArray(BSONObj array,
+                                                             BSONArrayBuilder* bab) const {
+    BSONObjIterator it{array};
+
+    while (it.more()) {
+        const auto bsonElement{it.next()};
+
+        if (bsonElement.type() == BSONType::Object) {
+            BSONObjBuilder subBob{bab->subobjStart()};
+            _applyProjections(bsonElement.embeddedObject(), &subBob);
+        } else if (bsonElement.type() == BSONType::Array &&
+                   _policies.arrayRecursionPolicy !=
+                       ProjectionPolicies::ArrayRecursionPolicy::kDoNotRecurseNestedArrays) {
+            BSONArrayBuilder subBab{bab->subarrayStart()};
+            _applyProjectionsToArray(bsonElement.embeddedObject(), &subBab);
+        } else {
+            // Scalars, and nested arrays we are not allowed to recurse into, are retained as is.
+            bab->append(bsonElement);
+        }
+    }
+}
 
 std::pair<BSONObj, bool> ExclusionNode::extractProjectOnFieldAndRename(const StringData& oldName,
                                                                        const StringData& newName) {
@@ -42,7 +42,7 @@ namespace mongo::projection_executor {
  * represents one 'level' of the parsed specification. The root ExclusionNode represents all top
  * level exclusions, with any child ExclusionNodes representing dotted or nested exclusions.
  */
-class ExclusionNode final : public ProjectionNode {
+class ExclusionNode : public ProjectionNode {
 public:
     ExclusionNode(ProjectionPolicies policies, std::string pathToNode = "")
         : ProjectionNode(policies, std::move(pathToNode)) {}
@@ -73,7 +73,7 @@ public:
                                                             const StringData& newName);
 
 protected:
-    std::unique_ptr<ProjectionNode> makeChild(const std::string& fieldName) const final {
+    std::unique_ptr<ProjectionNode> makeChild(const std::string& fieldName) const override {
         return std::make_unique<ExclusionNode>(
             _policies, FieldPath::getFullyQualifiedPath(_pathToNode, fieldName));
     }
@@ -88,6 +88,32 @@ protected:
     }
 };
 
+/**
+ * A fast-path exclusion projection implementation which applies a BSON-to-BSON transformation
+ * rather than constructing an output document using the Document/Value API. It is used for
+ * exclusion-only projections, that is projections without $meta expressions or find-only
+ * expressions ($slice and $elemMatch). Every field which is not excluded is copied to the output
+ * as a raw BSON element. On a document-by-document basis, if the fast-path projection cannot be
+ * applied to the input document, it will fall back to the default implementation.
+ */
+class FastPathEligibleExclusionNode final : public ExclusionNode {
+public:
+    FastPathEligibleExclusionNode(ProjectionPolicies policies, std::string pathToNode = "")
+        : ExclusionNode(policies, std::move(pathToNode)) {}
+
+    Document applyToDocument(const Document& inputDoc) const final;
+
+protected:
+    std::unique_ptr<ProjectionNode> makeChild(const std::string& fieldName) const final {
+        return std::make_unique<FastPathEligibleExclusionNode>(
+            _policies, FieldPath::getFullyQualifiedPath(_pathToNode, fieldName));
+    }
+
+private:
+    void _applyProjections(BSONObj bson, BSONObjBuilder* bob) const;
+    void _applyProjectionsToArray(BSONObj array, BSONArrayBuilder* bab) const;
+};
+
 /**
  * A ExclusionProjectionExecutor represents an execution tree for an exclusion projection.
  *
@@ -99,7 +125,9 @@ public:
     ExclusionProjectionExecutor(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                 ProjectionPolicies policies,
                                 bool allowFastPath = false)
-        : ProjectionExecutor(expCtx, policies), _root(new ExclusionNode(_policies)) {}
+        : ProjectionExecutor(expCtx, policies),
+          _root(allowFastPath ? std::make_unique<FastPathEligibleExclusionNode>(_policies)
+                              : std::make_unique<ExclusionNode>(_policies)) {}
 
     TransformerType getType() const final {
         return TransformerType::kExclusionProjection;
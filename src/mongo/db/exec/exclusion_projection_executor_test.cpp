@@ -37,11 +37,13 @@
 
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/base/exact_cast.h"
 #include "mongo/bson/json.h"
 #include "mongo/bson/unordered_fields_bsonobj_comparator.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/exec/exclusion_projection_executor.h"
 #include "mongo/db/exec/projection_executor.h"
 #include "mongo/db/exec/projection_executor_builder.h"
 #include "mongo/db/pipeline/dependencies.h"
@@ -54,11 +56,15 @@ namespace mongo::projection_executor {
 namespace {
 using std::vector;
 
-auto createProjectionExecutor(const BSONObj& spec, const ProjectionPolicies& policies) {
+auto createProjectionExecutor(const BSONObj& spec,
+                              const ProjectionPolicies& policies,
+                              bool allowFastPath = false) {
     const boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
     auto projection = projection_ast::parseAndAnalyze(expCtx, spec, policies);
     auto builderParams = BuilderParamsBitSet{kDefaultBuilderParams};
-    builderParams.reset(kAllowFastPath);
+    if (!allowFastPath) {
+        builderParams.reset(kAllowFastPath);
+    }
     auto executor = buildProjectionExecutor(expCtx, &projection, policies, builderParams);
     invariant(executor->getType() == TransformerInterface::TransformerType::kExclusionProjection);
     return executor;
@@ -615,5 +621,72 @@ TEST(ExclusionProjectionExecutionTest, ShouldNotExtractWhenFieldIsNotPresent) {
     ASSERT_BSONOBJ_EQ(fromjson("{a: {b: false}, _id: true}"),
                       exclusion->serializeTransformation(boost::none).toBson());
 }
+
+//
+// Fast-path tests.
+//
+const FastPathEligibleExclusionNode* getFastPathRoot(const ProjectionExecutor& executor) {
+    return exact_pointer_cast<const FastPathEligibleExclusionNode*>(
+        static_cast<const ExclusionProjectionExecutor&>(executor).getRoot());
+}
+
+TEST(ExclusionProjectionExecutionTest, ShouldChooseFastPathForExclusionOnlyProjection) {
+    auto exclusion = createProjectionExecutor(fromjson("{a: 0, 'b.c': 0}"), {}, true);
+    ASSERT(getFastPathRoot(*exclusion));
+
+    exclusion = createProjectionExecutor(fromjson("{a: 0, 'b.c': 0}"), {}, false);
+    ASSERT_FALSE(getFastPathRoot(*exclusion));
+}
+
+TEST(ExclusionProjectionExecutionTest, ShouldNotChooseFastPathWithMetaExpressions) {
+    auto exclusion =
+        createProjectionExecutor(fromjson("{a: 0, b: {$meta: 'textScore'}}"), {}, true);
+    ASSERT_FALSE(getFastPathRoot(*exclusion));
+}
+
+TEST(ExclusionProjectionExecutionTest, FastPathShouldMatchDefaultImplementation) {
+    const std::vector<BSONObj> specs{fromjson("{a: 0}"),
+                                     fromjson("{_id: 0, c: 0}"),
+                                     fromjson("{'a.b': 0, d: 0}"),
+                                     fromjson("{'a.b.c': 0, 'a.d': 0}"),
+                                     fromjson("{'_id.x': 0}")};
+    const std::vector<BSONObj> docs{
+        fromjson("{_id: 1, a: 1, b: 2, c: 3, d: 4}"),
+        fromjson("{_id: {x: 1, y: 2}, a: {b: 1, c: 2, d: 3}, c: 'str', d: null}"),
+        fromjson("{a: [1, {b: 2, c: 3}, [{b: 4, c: 5}, 6], {d: 7}], e: 8}"),
+        fromjson("{a: {b: {c: 1, d: 2}, d: [{c: 3}]}, b: {c: 4}}"),
+        fromjson("{e: 1, d: 2, c: 3, b: 4, a: 5, _id: 6}"),
+        fromjson("{}")};
+
+    for (auto&& policies :
+         {ProjectionPolicies{},
+          ProjectionPolicies{ProjectionPolicies::kDefaultIdPolicyDefault,
+                             ProjectionPolicies::ArrayRecursionPolicy::kDoNotRecurseNestedArrays,
+                             ProjectionPolicies::kComputedFieldsPolicyDefault}}) {
+        for (auto&& spec : specs) {
+            auto fastPath = createProjectionExecutor(spec, policies, true);
+            auto defaultPath = createProjectionExecutor(spec, policies, false);
+            ASSERT(getFastPathRoot(*fastPath));
+            for (auto&& doc : docs) {
+                ASSERT_BSONOBJ_EQ(defaultPath->applyTransformation(Document{doc}).toBson(),
+                                  fastPath->applyTransformation(Document{doc}).toBson());
+            }
+        }
+    }
+}
+
+TEST(ExclusionProjectionExecutionTest, FastPathShouldKeepMetadataFromOriginalDoc) {
+    auto exclusion = createProjectionExecutor(BSON("a" << false), {}, true);
+
+    MutableDocument inputDocBuilder(Document{fromjson("{_id: 'ID', a: 1}")});
+    inputDocBuilder.metadata().setTextScore(10.0);
+    Document inputDoc = inputDocBuilder.freeze();
+
+    auto result = exclusion->applyTransformation(inputDoc);
+
+    MutableDocument expectedDoc(Document{{"_id", "ID"_sd}});
+    expectedDoc.copyMetaDataFrom(inputDoc);
+    ASSERT_DOCUMENT_EQ(result, expectedDoc.freeze());
+}
 }  // namespace
 }  // namespace mongo::projection_executor
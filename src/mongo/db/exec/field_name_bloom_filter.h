@@ -0,0 +1,76 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "mongo/base/string_data.h"
+
+namespace mongo {
+
+/**
+ * A 64-bit Bloom filter over a small set of top-level field names. Scans that only need a few
+ * fields of wide documents consult it before looking a field name up in their hash table, which
+ * lets them skip most fields of a document without hashing their names.
+ *
+ * May report false positives, never false negatives.
+ */
+class FieldNameBloomFilter {
+public:
+    void insert(StringData fieldName) {
+        _bits |= _maskFor(fieldName);
+    }
+
+    bool maybeContains(StringData fieldName) const {
+        const auto mask = _maskFor(fieldName);
+        return (_bits & mask) == mask;
+    }
+
+private:
+    /**
+     * Sets two bits derived from a hash of the length of the name and its last few characters,
+     * which is much cheaper to compute than a hash of the whole name.
+     */
+    static uint64_t _maskFor(StringData fieldName) {
+        const auto size = fieldName.size();
+        uint32_t hash = 2166136261U ^ static_cast<uint32_t>(size);
+        const size_t begin = size > kHashedSuffixLength ? size - kHashedSuffixLength : 0;
+        for (size_t i = begin; i < size; ++i) {
+            hash = (hash ^ static_cast<unsigned char>(fieldName[i])) * 16777619U;
+        }
+        return (uint64_t{1} << (hash % 64)) | (uint64_t{1} << ((hash >> 6) % 64));
+    }
+
+    static constexpr size_t kHashedSuffixLength = 4;
+
+    uint64_t _bits = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,76 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/field_name_bloom_filter.h"
+
+#include <string>
+#include <vector>
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(FieldNameBloomFilterTest, EmptyFilterRejectsEverything) {
+    FieldNameBloomFilter filter;
+    ASSERT_FALSE(filter.maybeContains("a"));
+    ASSERT_FALSE(filter.maybeContains(""));
+    ASSERT_FALSE(filter.maybeContains("someLongerFieldName"));
+}
+
+TEST(FieldNameBloomFilterTest, NoFalseNegatives) {
+    FieldNameBloomFilter filter;
+    const std::vector<std::string> names{"", "a", "_id", "ts", "field12", "x.y", "veryLongName"};
+    for (const auto& name : names) {
+        filter.insert(name);
+    }
+    for (const auto& name : names) {
+        ASSERT_TRUE(filter.maybeContains(name)) << name;
+    }
+}
+
+TEST(FieldNameBloomFilterTest, RejectsMostOtherFieldsOfAWideDocument) {
+    FieldNameBloomFilter filter;
+    filter.insert("field7");
+    filter.insert("field123");
+
+    int falsePositives = 0;
+    for (int i = 0; i < 200; ++i) {
+        const auto name = "field" + std::to_string(i);
+        if (i != 7 && i != 123 && filter.maybeContains(name)) {
+            ++falsePositives;
+        }
+    }
+    ASSERT_LT(falsePositives, 20);
+}
+
+}  // namespace
+}  // namespace mongo
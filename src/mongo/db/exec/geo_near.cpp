@@ -51,6 +51,7 @@
 #include "mongo/db/query/expression_index_knobs_gen.h"
 
 #include <algorithm>
+#include <cmath>
 
 namespace mongo {
 
@@ -703,6 +704,32 @@ S2Region* buildS2Region(const R2Annulus& sphereBounds) {
     // Takes ownership of caps
     return new S2RegionIntersection(&regions);
 }
+
+// The number of results that the width of each search interval aims for.
+const double kTargetResultsPerInterval = 450;
+
+/**
+ * Returns the width of the search interval that follows 'lastBounds', given that 'numResults'
+ * results were returned from 'lastBounds'. Assuming that the points are spread evenly around the
+ * search point, the density of the points in the last interval tells how wide the next one must be
+ * to hold kTargetResultsPerInterval points. The width grows or shrinks by a factor of 4 at most
+ * between two intervals, and doubles after an interval that returned nothing.
+ */
+double nextBoundsIncrement(const R2Annulus& lastBounds, long long numResults) {
+    const double inner = std::max(lastBounds.getInner(), 0.0);
+    const double outer = lastBounds.getOuter();
+    const double lastIncrement = outer - inner;
+    if (numResults == 0) {
+        return 2 * lastIncrement;
+    }
+
+    // The areas are computed as if the annuli were flat, and without the common factor of pi.
+    // That is close enough for sizing the intervals, which does not affect which points match.
+    const double targetArea =
+        (outer * outer - inner * inner) * kTargetResultsPerInterval / numResults;
+    const double increment = std::sqrt(outer * outer + targetArea) - outer;
+    return std::max(lastIncrement / 4, std::min(increment, lastIncrement * 4));
+}
 }  // namespace
 
 GeoNear2DSphereStage::DensityEstimator::DensityEstimator(const CollectionPtr& collection,
@@ -874,12 +901,7 @@ std::unique_ptr<NearStage::CoveredInterval> GeoNear2DSphereStage::nextInterval(
 
     if (!_specificStats.intervalStats.empty()) {
         const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
-
-        // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
-            _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
-            _boundsIncrement /= 2;
+        _boundsIncrement = nextBoundsIncrement(_currBounds, lastIntervalStats.numResultsReturned);
     }
 
     invariant(_boundsIncrement > 0.0);
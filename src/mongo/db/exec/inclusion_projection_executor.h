@@ -220,6 +220,7 @@ public:
     void optimize() final {
         ProjectionExecutor::optimize();
         _root->optimize();
+        _sharedSubexpressions = _root->shareCommonSubexpressions();
     }
 
     DepsTracker::State addDependencies(DepsTracker* deps) const final {
@@ -259,6 +260,9 @@ public:
      * each element in the array.
      */
     Document applyProjection(const Document& inputDoc) const final {
+        if (_sharedSubexpressions) {
+            _sharedSubexpressions->newDocument();
+        }
         return _root->applyToDocument(inputDoc);
     }
 
@@ -287,5 +291,8 @@ public:
 private:
     // The InclusionNode tree does most of the execution work once constructed.
     std::unique_ptr<InclusionNode> _root;
+
+    // Set by optimize() if some subexpressions are shared across the computed fields of '_root'.
+    std::shared_ptr<ExpressionSharedSubexpression::Scope> _sharedSubexpressions;
 };
 }  // namespace mongo::projection_executor
@@ -81,4 +81,8 @@ ClockSource* PlanStage::getClock() const {
     return _opCtx->getServiceContext()->getFastClockSource();
 }
 
+TickSource* PlanStage::getTickSource() const {
+    return _opCtx->getServiceContext()->getTickSource();
+}
+
 }  // namespace mongo
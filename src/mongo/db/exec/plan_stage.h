@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -36,6 +37,7 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/restore_context.h"
 
 namespace mongo {
@@ -113,10 +115,11 @@ public:
     PlanStage(const char* typeName, ExpressionContext* expCtx)
         : _commonStats(typeName), _opCtx(expCtx->opCtx), _expCtx(expCtx) {
         invariant(expCtx);
-        if (expCtx->explain || expCtx->mayDbProfile) {
+        if (expCtx->explain || expCtx->mayDbProfile ||
+            internalQueryCollectStageExecutionStats.load()) {
             // Populating the field for execution time indicates that this stage should time each
             // call to work().
-            _commonStats.executionTimeMillis.emplace(0);
+            markShouldCollectTimingInfo();
         }
     }
 
@@ -351,6 +354,9 @@ public:
     void markShouldCollectTimingInfo() {
         invariant(!_commonStats.executionTimeMillis || *_commonStats.executionTimeMillis == 0);
         _commonStats.executionTimeMillis.emplace(0);
+        if (internalQueryCollectStageExecutionStats.load()) {
+            _commonStats.executionTimeNanos.emplace(0);
+        }
     }
 
 protected:
@@ -390,6 +396,8 @@ protected:
 
     ClockSource* getClock() const;
 
+    TickSource* getTickSource() const;
+
     OperationContext* opCtx() const {
         return _opCtx;
     }
@@ -404,12 +412,26 @@ protected:
      */
     boost::optional<ScopedTimer> getOptTimer() {
         if (_commonStats.executionTimeMillis) {
-            return {{getClock(), _commonStats.executionTimeMillis.get_ptr()}};
+            return {{getClock(),
+                     _commonStats.executionTimeMillis.get_ptr(),
+                     getTickSource(),
+                     _commonStats.executionTimeNanos.get_ptr()}};
         }
 
         return boost::none;
     }
 
+    /**
+     * Records 'bytes' as the amount of memory this stage currently holds, keeping the peak in the
+     * stage stats. Does nothing unless stage execution stats are being collected.
+     */
+    void trackMemoryUsage(uint64_t bytes) {
+        if (_commonStats.executionTimeNanos) {
+            _commonStats.peakTrackedMemBytes =
+                std::max(_commonStats.peakTrackedMemBytes.value_or(0), bytes);
+        }
+    }
+
     Children _children;
     CommonStats _commonStats;
 
@@ -103,6 +103,13 @@ struct CommonStats {
     // cache.
     boost::optional<long long> executionTimeMillis;
 
+    // Time elapsed while working inside this stage, in nanoseconds, and the largest number of bytes
+    // this stage estimated it was holding at once. Only populated alongside 'executionTimeMillis'
+    // when 'internalQueryCollectStageExecutionStats' is enabled, and the memory figure only by
+    // stages that track their memory use.
+    boost::optional<long long> executionTimeNanos;
+    boost::optional<uint64_t> peakTrackedMemBytes;
+
     // TODO: have some way of tracking WSM sizes (or really any series of #s).  We can measure
     // the size of our inputs and the size of our outputs.  We can do a lot with the WS here.
 
@@ -197,6 +204,37 @@ struct AndHashStats : public SpecificStats {
     size_t memLimit = 0u;
 };
 
+struct AndBitmapStats : public SpecificStats {
+    AndBitmapStats() = default;
+
+    std::unique_ptr<SpecificStats> clone() const final {
+        return std::make_unique<AndBitmapStats>(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const {
+        return container_size_helper::estimateObjectSizeInBytes(bitmapAfterChild) +
+            sizeof(*this);
+    }
+
+    // How many record ids are left in the intersection after each child? Child 'i' produced
+    // children[i].common.advanced record ids, of which bitmapAfterChild[i] were also produced by
+    // every child before it.
+    std::vector<size_t> bitmapAfterChild;
+
+    // The number of documents fetched for the record ids left after the last child.
+    size_t docsExamined = 0u;
+
+    // The number of fetched documents which no longer matched the bounds of every index scan
+    // because they were modified while the query yielded.
+    size_t docsFailedRevalidation = 0u;
+
+    // What's our current memory usage?
+    size_t memUsage = 0u;
+
+    // What's our memory limit?
+    size_t memLimit = 0u;
+};
+
 struct AndSortedStats : public SpecificStats {
     AndSortedStats() = default;
 
@@ -212,6 +250,24 @@ struct AndSortedStats : public SpecificStats {
     std::vector<size_t> failedAnd;
 };
 
+struct BatchedIdLookupStats : public SpecificStats {
+    BatchedIdLookupStats() = default;
+
+    std::unique_ptr<SpecificStats> clone() const final {
+        return std::make_unique<BatchedIdLookupStats>(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const {
+        return sizeof(*this);
+    }
+
+    // The number of record ids read from the _id index scan and sorted before fetching.
+    size_t recordIdsBuffered = 0u;
+
+    // The total number of full documents fetched by the stage.
+    size_t docsExamined = 0u;
+};
+
 struct CachedPlanStats : public SpecificStats {
     CachedPlanStats() = default;
 
@@ -604,6 +660,8 @@ struct SortStats : public SpecificStats {
     void accumulate(PlanSummaryStats& summary) const final {
         summary.hasSortStage = true;
         summary.usedDisk = summary.usedDisk || spills > 0;
+        summary.spilledBytes += spilledBytes;
+        summary.spillTimeMicros += spillTimeMicros;
     }
 
     // The pattern according to which we are sorting.
@@ -627,6 +685,10 @@ struct SortStats : public SpecificStats {
 
     // The number of times that we spilled data to disk during the execution of this query.
     uint64_t spills = 0u;
+
+    // The number of bytes written to disk when spilling, and the time spent writing them.
+    uint64_t spilledBytes = 0u;
+    uint64_t spillTimeMicros = 0u;
 };
 
 struct MergeSortStats : public SpecificStats {
@@ -802,6 +864,8 @@ struct GroupStats : public SpecificStats {
 
     void accumulate(PlanSummaryStats& summary) const final {
         summary.usedDisk = summary.usedDisk || spills > 0;
+        summary.spilledBytes += spilledBytes;
+        summary.spillTimeMicros += spillTimeMicros;
     }
 
     // Tracks an estimate of the total size of all documents output by the group stage in bytes.
@@ -809,6 +873,10 @@ struct GroupStats : public SpecificStats {
 
     // The number of times that we spilled data to disk while grouping the data.
     uint64_t spills = 0u;
+
+    // The number of bytes written to disk when spilling, and the time spent writing them.
+    uint64_t spilledBytes = 0u;
+    uint64_t spillTimeMicros = 0u;
 };
 
 struct DocumentSourceCursorStats : public SpecificStats {
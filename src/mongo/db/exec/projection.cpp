@@ -277,6 +277,9 @@ ProjectionStageSimple::ProjectionStageSimple(ExpressionContext* expCtx,
     invariant(projection->isSimple());
     _includedFields = {projection->getRequiredFields().begin(),
                        projection->getRequiredFields().end()};
+    for (auto&& field : _includedFields) {
+        _includedFieldsFilter.insert(field);
+    }
 }
 
 void ProjectionStageSimple::transform(WorkingSetMember* member) const {
@@ -291,6 +294,9 @@ void ProjectionStageSimple::transform(WorkingSetMember* member) const {
     auto nFieldsNeeded = _includedFields.size();
     for (auto&& elt : objToProject) {
         auto fieldName{elt.fieldNameStringData()};
+        if (!_includedFieldsFilter.maybeContains(fieldName)) {
+            continue;
+        }
         absl::string_view fieldNameKey{fieldName.rawData(), fieldName.size()};
         if (auto fieldIt = _includedFields.find(fieldNameKey); _includedFields.end() != fieldIt) {
             bob.append(elt);
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/db/exec/field_name_bloom_filter.h"
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/exec/projection_executor.h"
 #include "mongo/db/jsobj.h"
@@ -171,6 +172,9 @@ private:
 
     // Has the field names present in the simple projection.
     stdx::unordered_set<std::string> _includedFields;
+
+    // Prefilter over '_includedFields', checked before the hash lookup.
+    FieldNameBloomFilter _includedFieldsFilter;
 };
 
 }  // namespace mongo
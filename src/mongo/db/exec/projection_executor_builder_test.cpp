@@ -32,6 +32,7 @@
 
 #include "mongo/base/exact_cast.h"
 #include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/exec/exclusion_projection_executor.h"
 #include "mongo/db/exec/inclusion_projection_executor.h"
 #include "mongo/db/exec/projection_executor.h"
 #include "mongo/db/exec/projection_executor_builder.h"
@@ -49,7 +50,7 @@ namespace {
  * one when it's not.
  *
  * The 'AllowFallBackToDefault' parameter should be set to 'true', if the executor is allowed to
- * fall back to the default inclusion projection implementation if the fast-path projection cannot
+ * fall back to the default projection implementation if the fast-path projection cannot
  * be used for a specific test. If set to 'false', an invariant will be triggered if fast-path
  * projection was expected to be chosen, but the default one has been picked instead.
  */
@@ -120,12 +121,24 @@ protected:
             } else {
                 ASSERT_FALSE(fastPathRootNode);
             }
+        } else if (executor->getType() ==
+                   TransformerInterface::TransformerType::kExclusionProjection) {
+            auto exclusionExecutor =
+                static_cast<projection_executor::ExclusionProjectionExecutor*>(executor.get());
+            auto fastPathRootNode =
+                exact_pointer_cast<projection_executor::FastPathEligibleExclusionNode*>(
+                    exclusionExecutor->getRoot());
+            if (_allowFastPath) {
+                ASSERT_TRUE(fastPathRootNode || AllowFallBackToDefault);
+            } else {
+                ASSERT_FALSE(fastPathRootNode);
+            }
         }
         return executor;
     }
 
-    // True, if the projection executor is allowed to use the fast-path inclusion projection
-    // implementation.
+    // True, if the projection executor is allowed to use the fast-path inclusion or exclusion
+    // projection implementation.
     bool _allowFastPath{true};
 };
 
@@ -177,7 +190,7 @@ TEST_F(ProjectionExecutorTestWithFallBackToDefault, CanProjectExpressionWithComm
                        executor->applyTransformation(Document{fromjson("{a: {b: {e: 4}, p: 2}}")}));
 }
 
-TEST_F(ProjectionExecutorTestWithFallBackToDefault, CanProjectExclusionWithIdPath) {
+TEST_F(ProjectionExecutorTestWithoutFallBackToDefault, CanProjectExclusionWithIdPath) {
     auto projWithoutId = parseWithDefaultPolicies(fromjson("{a: 0, _id: 0}"));
     auto executor = createProjectionExecutor(projWithoutId);
     ASSERT_DOCUMENT_EQ(Document{fromjson("{b: 'def', c: 'ghi'}")},
@@ -185,7 +198,7 @@ TEST_F(ProjectionExecutorTestWithFallBackToDefault, CanProjectExclusionWithIdPat
                            Document{fromjson("{_id: 123, a: 'abc', b: 'def', c: 'ghi'}")}));
 }
 
-TEST_F(ProjectionExecutorTestWithFallBackToDefault, CanProjectExclusionUndottedPath) {
+TEST_F(ProjectionExecutorTestWithoutFallBackToDefault, CanProjectExclusionUndottedPath) {
     auto proj = parseWithDefaultPolicies(fromjson("{a: 0, b: 0}"));
     auto executor = createProjectionExecutor(proj);
     ASSERT_DOCUMENT_EQ(
@@ -193,7 +206,7 @@ TEST_F(ProjectionExecutorTestWithFallBackToDefault, CanProjectExclusionUndottedP
         executor->applyTransformation(Document{fromjson("{a: 'abc', b: 'def', c: 'ghi'}")}));
 }
 
-TEST_F(ProjectionExecutorTestWithFallBackToDefault, CanProjectExclusionDottedPath) {
+TEST_F(ProjectionExecutorTestWithoutFallBackToDefault, CanProjectExclusionDottedPath) {
     auto proj = parseWithDefaultPolicies(fromjson("{'a.b': 0, 'a.d': 0}"));
     auto executor = createProjectionExecutor(proj);
     ASSERT_DOCUMENT_EQ(
@@ -268,6 +268,22 @@ void ProjectionNode::optimize() {
     _maxFieldsToProject = maxFieldsToProject();
 }
 
+std::shared_ptr<ExpressionSharedSubexpression::Scope> ProjectionNode::shareCommonSubexpressions() {
+    std::vector<boost::intrusive_ptr<Expression>*> expressions;
+    gatherExpressions(&expressions);
+    return ExpressionSharedSubexpression::shareCommonSubexpressions(expressions);
+}
+
+void ProjectionNode::gatherExpressions(
+    std::vector<boost::intrusive_ptr<Expression>*>* expressions) {
+    for (auto&& expressionIt : _expressions) {
+        expressions->push_back(&expressionIt.second);
+    }
+    for (auto&& childPair : _children) {
+        childPair.second->gatherExpressions(expressions);
+    }
+}
+
 Document ProjectionNode::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
     MutableDocument outputDoc;
     serialize(explain, &outputDoc);
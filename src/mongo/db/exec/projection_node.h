@@ -128,6 +128,14 @@ public:
 
     void optimize();
 
+    /**
+     * Shares the subexpressions that are repeated across the computed fields of this tree, so that
+     * each of them is evaluated once per document. Returns the scope which must be told about each
+     * new document before the tree is applied to it, or nullptr if nothing was shared. Can only be
+     * called from the root of the tree.
+     */
+    std::shared_ptr<ExpressionSharedSubexpression::Scope> shareCommonSubexpressions();
+
     Document serialize(boost::optional<ExplainOptions::Verbosity> explain) const;
 
     void serialize(boost::optional<ExplainOptions::Verbosity> explain,
@@ -197,6 +205,9 @@ private:
     Value applyExpressionsToValue(const Document& root, Value inputVal) const;
     Value applyProjectionsToValue(Value inputVal) const;
 
+    // Appends the location of every computed field's expression in this subtree to 'expressions'.
+    void gatherExpressions(std::vector<boost::intrusive_ptr<Expression>*>* expressions);
+
     // Adds a new ProjectionNode as a child. 'field' cannot be dotted.
     ProjectionNode* addChild(const std::string& field);
 
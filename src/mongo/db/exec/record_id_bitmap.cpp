@@ -0,0 +1,219 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bitmap.h"
+
+#include <algorithm>
+#include <bitset>
+
+#include "mongo/platform/bits.h"
+
+namespace mongo {
+namespace {
+
+// Maps signed ids to unsigned values of the same order.
+uint64_t encode(int64_t id) {
+    return static_cast<uint64_t>(id) ^ (uint64_t{1} << 63);
+}
+
+int64_t decode(uint64_t value) {
+    return static_cast<int64_t>(value ^ (uint64_t{1} << 63));
+}
+
+size_t countBits(uint64_t word) {
+    return std::bitset<64>(word).count();
+}
+
+}  // namespace
+
+bool RecordIdBitmap::Container::contains(uint16_t low) const {
+    if (isBitmap()) {
+        return bitmap[low / 64] & (uint64_t{1} << (low % 64));
+    }
+    return std::binary_search(array.begin(), array.end(), low);
+}
+
+bool RecordIdBitmap::Container::add(uint16_t low) {
+    if (isBitmap()) {
+        auto& word = bitmap[low / 64];
+        const auto bit = uint64_t{1} << (low % 64);
+        if (word & bit) {
+            return false;
+        }
+        word |= bit;
+        ++cardinality;
+        return true;
+    }
+
+    auto it = std::lower_bound(array.begin(), array.end(), low);
+    if (it != array.end() && *it == low) {
+        return false;
+    }
+    array.insert(it, low);
+    ++cardinality;
+    if (cardinality > kMaxArrayContainerSize) {
+        convertToBitmap();
+    }
+    return true;
+}
+
+void RecordIdBitmap::Container::convertToBitmap() {
+    bitmap.assign(kBitmapContainerWords, 0);
+    for (auto low : array) {
+        bitmap[low / 64] |= uint64_t{1} << (low % 64);
+    }
+    std::vector<uint16_t>().swap(array);
+}
+
+void RecordIdBitmap::Container::convertToArray() {
+    std::vector<uint16_t> values;
+    values.reserve(cardinality);
+    for (size_t i = 0; i < kBitmapContainerWords; ++i) {
+        for (auto word = bitmap[i]; word; word &= word - 1) {
+            values.push_back(i * 64 + countTrailingZerosNonZero64(word));
+        }
+    }
+    array = std::move(values);
+    std::vector<uint64_t>().swap(bitmap);
+}
+
+void RecordIdBitmap::Container::intersectWith(const Container& other) {
+    if (isBitmap() && other.isBitmap()) {
+        // Kept free of branches so that the compiler can vectorize it.
+        size_t count = 0;
+        for (size_t i = 0; i < kBitmapContainerWords; ++i) {
+            bitmap[i] &= other.bitmap[i];
+            count += countBits(bitmap[i]);
+        }
+        cardinality = count;
+        if (cardinality <= kMaxArrayContainerSize) {
+            convertToArray();
+        }
+        return;
+    }
+
+    if (isBitmap()) {
+        // The result is no larger than the array of 'other'.
+        std::vector<uint16_t> values;
+        std::copy_if(other.array.begin(),
+                     other.array.end(),
+                     std::back_inserter(values),
+                     [&](uint16_t low) { return contains(low); });
+        array = std::move(values);
+        std::vector<uint64_t>().swap(bitmap);
+    } else if (other.isBitmap()) {
+        array.erase(std::remove_if(array.begin(),
+                                   array.end(),
+                                   [&](uint16_t low) { return !other.contains(low); }),
+                    array.end());
+    } else {
+        array.erase(std::set_intersection(array.begin(),
+                                          array.end(),
+                                          other.array.begin(),
+                                          other.array.end(),
+                                          array.begin()),
+                    array.end());
+    }
+    cardinality = array.size();
+}
+
+void RecordIdBitmap::add(int64_t id) {
+    const auto value = encode(id);
+    _containers[value >> 16].add(static_cast<uint16_t>(value));
+}
+
+bool RecordIdBitmap::contains(int64_t id) const {
+    const auto value = encode(id);
+    auto it = _containers.find(value >> 16);
+    return it != _containers.end() && it->second.contains(static_cast<uint16_t>(value));
+}
+
+void RecordIdBitmap::intersectWith(const RecordIdBitmap& other) {
+    auto it = _containers.begin();
+    auto otherIt = other._containers.begin();
+    while (it != _containers.end()) {
+        while (otherIt != other._containers.end() && otherIt->first < it->first) {
+            ++otherIt;
+        }
+        if (otherIt == other._containers.end() || otherIt->first != it->first) {
+            it = _containers.erase(it);
+            continue;
+        }
+
+        it->second.intersectWith(otherIt->second);
+        if (it->second.cardinality == 0) {
+            it = _containers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+size_t RecordIdBitmap::size() const {
+    size_t count = 0;
+    for (auto&& [key, container] : _containers) {
+        count += container.cardinality;
+    }
+    return count;
+}
+
+size_t RecordIdBitmap::memUsageBytes() const {
+    // Also account for the node of each container in the map.
+    size_t bytes = sizeof(*this);
+    for (auto&& [key, container] : _containers) {
+        bytes += sizeof(key) + sizeof(container) + 4 * sizeof(void*) +
+            container.array.capacity() * sizeof(uint16_t) +
+            container.bitmap.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
+
+std::vector<int64_t> RecordIdBitmap::toVector() const {
+    std::vector<int64_t> ids;
+    ids.reserve(size());
+    for (auto&& [key, container] : _containers) {
+        const uint64_t high = key << 16;
+        if (container.isBitmap()) {
+            for (size_t i = 0; i < kBitmapContainerWords; ++i) {
+                for (auto word = container.bitmap[i]; word; word &= word - 1) {
+                    ids.push_back(decode(high | (i * 64 + countTrailingZerosNonZero64(word))));
+                }
+            }
+        } else {
+            for (auto low : container.array) {
+                ids.push_back(decode(high | low));
+            }
+        }
+    }
+    return ids;
+}
+
+}  // namespace mongo
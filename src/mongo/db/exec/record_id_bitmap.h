@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace mongo {
+
+/**
+ * A compressed set of integer record ids, organized the way Roaring bitmaps are: ids are grouped
+ * by their high 48 bits into containers which each hold up to 2^16 ids. A container stores the
+ * low 16 bits of its ids either as a sorted array while it is sparse, or as a 2^16 bit bitmap once
+ * it holds more than 'kMaxArrayContainerSize' ids. Densely allocated record ids thus cost about
+ * one bit each, and intersecting two dense containers is a word-wise AND.
+ */
+class RecordIdBitmap {
+public:
+    static constexpr size_t kMaxArrayContainerSize = 4096;
+    static constexpr size_t kBitmapContainerWords = (1 << 16) / 64;
+
+    void add(int64_t id);
+
+    bool contains(int64_t id) const;
+
+    /**
+     * Removes the ids which are not also in 'other'.
+     */
+    void intersectWith(const RecordIdBitmap& other);
+
+    bool empty() const {
+        return _containers.empty();
+    }
+
+    /**
+     * Returns the number of ids in the set.
+     */
+    size_t size() const;
+
+    /**
+     * Returns an approximation of the memory used by the set, in bytes.
+     */
+    size_t memUsageBytes() const;
+
+    /**
+     * Returns all the ids in the set in ascending order.
+     */
+    std::vector<int64_t> toVector() const;
+
+private:
+    struct Container {
+        bool isBitmap() const {
+            return !bitmap.empty();
+        }
+
+        bool contains(uint16_t low) const;
+
+        // Adds 'low' and returns true if it wasn't already in the container.
+        bool add(uint16_t low);
+
+        void intersectWith(const Container& other);
+
+        // Switches the representation if the cardinality crossed 'kMaxArrayContainerSize'.
+        void convertToBitmap();
+        void convertToArray();
+
+        // Exactly one of these is non-empty for a container that holds at least one id.
+        std::vector<uint16_t> array;
+        std::vector<uint64_t> bitmap;
+
+        size_t cardinality = 0;
+    };
+
+    // The containers, keyed by the high 48 bits of the order-preserving unsigned encoding of the
+    // ids they hold.
+    std::map<uint64_t, Container> _containers;
+};
+
+}  // namespace mongo
@@ -0,0 +1,157 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bitmap.h"
+
+#include <set>
+
+#include "mongo/platform/random.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::vector<int64_t> toVector(const std::set<int64_t>& ids) {
+    return {ids.begin(), ids.end()};
+}
+
+TEST(RecordIdBitmapTest, Empty) {
+    RecordIdBitmap bitmap;
+    ASSERT_TRUE(bitmap.empty());
+    ASSERT_EQ(bitmap.size(), 0U);
+    ASSERT_FALSE(bitmap.contains(1));
+    ASSERT_TRUE(bitmap.toVector().empty());
+}
+
+TEST(RecordIdBitmapTest, AddIgnoresDuplicates) {
+    RecordIdBitmap bitmap;
+    for (int64_t id : {5, 3, 5, 1, 3}) {
+        bitmap.add(id);
+    }
+    ASSERT_EQ(bitmap.size(), 3U);
+    ASSERT_TRUE(bitmap.contains(1));
+    ASSERT_FALSE(bitmap.contains(2));
+    ASSERT_TRUE(bitmap.toVector() == std::vector<int64_t>({1, 3, 5}));
+}
+
+TEST(RecordIdBitmapTest, IdsAreReturnedInOrderAcrossContainers) {
+    std::set<int64_t> expected{-(int64_t{1} << 40), -1, 0, 1, 65535, 65536, int64_t{1} << 62};
+    RecordIdBitmap bitmap;
+    for (auto it = expected.rbegin(); it != expected.rend(); ++it) {
+        bitmap.add(*it);
+    }
+    ASSERT_EQ(bitmap.size(), expected.size());
+    ASSERT_TRUE(bitmap.toVector() == toVector(expected));
+}
+
+TEST(RecordIdBitmapTest, DenseContainerUsesLessMemory) {
+    RecordIdBitmap dense;
+    for (int64_t id = 0; id < 60000; ++id) {
+        dense.add(id);
+    }
+    ASSERT_EQ(dense.size(), 60000U);
+    ASSERT_LT(dense.memUsageBytes(), 60000U / 8 + 1024);
+    ASSERT_TRUE(dense.contains(59999));
+    ASSERT_FALSE(dense.contains(60000));
+}
+
+TEST(RecordIdBitmapTest, IntersectionMatchesSetIntersection) {
+    PseudoRandom random(42);
+    for (int64_t range : {int64_t{5000}, int64_t{100000}, int64_t{10000000}}) {
+        std::set<int64_t> left;
+        std::set<int64_t> right;
+        RecordIdBitmap leftBitmap;
+        RecordIdBitmap rightBitmap;
+        for (int i = 0; i < 20000; ++i) {
+            auto id = random.nextInt64(range);
+            left.insert(id);
+            leftBitmap.add(id);
+        }
+        for (int i = 0; i < 2000; ++i) {
+            auto id = random.nextInt64(range);
+            right.insert(id);
+            rightBitmap.add(id);
+        }
+
+        std::set<int64_t> expected;
+        std::set_intersection(left.begin(),
+                              left.end(),
+                              right.begin(),
+                              right.end(),
+                              std::inserter(expected, expected.begin()));
+
+        RecordIdBitmap leftThenRight = leftBitmap;
+        leftThenRight.intersectWith(rightBitmap);
+        ASSERT_EQ(leftThenRight.size(), expected.size());
+        ASSERT_TRUE(leftThenRight.toVector() == toVector(expected));
+
+        rightBitmap.intersectWith(leftBitmap);
+        ASSERT_TRUE(rightBitmap.toVector() == toVector(expected));
+    }
+}
+
+TEST(RecordIdBitmapTest, IntersectionOfDenseContainers) {
+    RecordIdBitmap evens;
+    RecordIdBitmap multiplesOfThree;
+    for (int64_t id = 0; id < 200000; ++id) {
+        if (id % 2 == 0) {
+            evens.add(id);
+        }
+        if (id % 3 == 0) {
+            multiplesOfThree.add(id);
+        }
+    }
+    evens.intersectWith(multiplesOfThree);
+    ASSERT_EQ(evens.size(), 33334U);
+    ASSERT_TRUE(evens.contains(6));
+    ASSERT_FALSE(evens.contains(4));
+    ASSERT_FALSE(evens.contains(9));
+
+    auto ids = evens.toVector();
+    ASSERT_EQ(ids.size(), 33334U);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        ASSERT_EQ(ids[i], static_cast<int64_t>(i) * 6);
+    }
+}
+
+TEST(RecordIdBitmapTest, DisjointIntersectionIsEmpty) {
+    RecordIdBitmap left;
+    RecordIdBitmap right;
+    for (int64_t id = 0; id < 10000; ++id) {
+        left.add(id);
+        right.add(id + 10000000);
+    }
+    left.intersectWith(right);
+    ASSERT_TRUE(left.empty());
+}
+
+}  // namespace
+}  // namespace mongo
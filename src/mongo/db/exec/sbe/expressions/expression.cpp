@@ -464,6 +464,13 @@ static stdx::unordered_map<std::string, BuiltinFn> kBuiltinFunctions = {
      BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::generateSortKey, false}},
     {"tsSecond", BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::tsSecond, false}},
     {"tsIncrement", BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::tsIncrement, false}},
+    {"blockLt", BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::blockLt, false}},
+    {"blockLte", BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::blockLte, false}},
+    {"blockGt", BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::blockGt, false}},
+    {"blockGte", BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::blockGte, false}},
+    {"blockEq", BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::blockEq, false}},
+    {"blockNeq", BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::blockNeq, false}},
+    {"blockFilter", BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::blockFilter, false}},
 };
 
 /**
@@ -536,6 +543,40 @@ static stdx::unordered_map<std::string, InstrFn> kInstrFunctions = {
 };
 }  // namespace
 
+std::unique_ptr<vm::CodeFragment> EFunction::compileWithImmediate(CompileCtx& ctx) const {
+    auto constant = _nodes.size() == 2 ? dynamic_cast<const EConstant*>(_nodes[1].get()) : nullptr;
+    if (!constant) {
+        return nullptr;
+    }
+
+    auto [tag, val] = constant->getConstant();
+    if (_name == "getField" && value::isString(tag)) {
+        auto fieldName = value::getStringView(tag, val);
+        if (fieldName.size() > vm::Instruction::kMaxImmFieldNameSize) {
+            return nullptr;
+        }
+
+        auto code = std::make_unique<vm::CodeFragment>();
+        code->append(_nodes[0]->compile(ctx));
+        code->appendGetField(fieldName);
+        return code;
+    }
+
+    if (_name == "fillEmpty" &&
+        (tag == value::TypeTags::Null || tag == value::TypeTags::Boolean)) {
+        auto k = tag == value::TypeTags::Null
+            ? vm::Instruction::Null
+            : (value::bitcastTo<bool>(val) ? vm::Instruction::True : vm::Instruction::False);
+
+        auto code = std::make_unique<vm::CodeFragment>();
+        code->append(_nodes[0]->compile(ctx));
+        code->appendFillEmpty(k);
+        return code;
+    }
+
+    return nullptr;
+}
+
 std::unique_ptr<vm::CodeFragment> EFunction::compile(CompileCtx& ctx) const {
     if (auto it = kBuiltinFunctions.find(_name); it != kBuiltinFunctions.end()) {
         auto arity = _nodes.size();
@@ -570,6 +611,11 @@ std::unique_ptr<vm::CodeFragment> EFunction::compile(CompileCtx& ctx) const {
                       str::stream()
                           << "function call: " << _name << " has wrong arity: " << _nodes.size());
         }
+
+        if (auto code = compileWithImmediate(ctx)) {
+            return code;
+        }
+
         auto code = std::make_unique<vm::CodeFragment>();
 
         if (it->second.aggregate) {
@@ -950,6 +996,24 @@ std::unique_ptr<RuntimeEnvironment> RuntimeEnvironment::makeCopy(bool isSmp) {
     return std::unique_ptr<RuntimeEnvironment>(new RuntimeEnvironment(*this));
 }
 
+std::unique_ptr<RuntimeEnvironment> RuntimeEnvironment::makeDeepCopy() const {
+    auto env = std::make_unique<RuntimeEnvironment>();
+
+    env->_state->namedSlots = _state->namedSlots;
+    for (auto&& [slot, index] : _state->slots) {
+        env->emplaceAccessor(slot, env->_state->pushSlot(slot));
+
+        auto tag = _state->typeTags[index];
+        auto val = _state->vals[index];
+        if (_state->owned[index]) {
+            std::tie(tag, val) = value::copyValue(tag, val);
+        }
+        env->_accessors.at(slot).reset(_state->owned[index], tag, val);
+    }
+
+    return env;
+}
+
 void RuntimeEnvironment::debugString(StringBuilder* builder) {
     using namespace std::literals;
 
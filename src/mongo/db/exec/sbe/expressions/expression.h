@@ -165,6 +165,13 @@ public:
      */
     std::unique_ptr<RuntimeEnvironment> makeCopy(bool isSmp);
 
+    /**
+     * Make a copy of this environment which does not share any data with it. Owned slot values are
+     * copied, unowned values are shared by reference, as they are in this environment. The new
+     * environment is always a serial environment.
+     */
+    std::unique_ptr<RuntimeEnvironment> makeDeepCopy() const;
+
     /**
      * Dumps all the slots currently defined in this environment into the given string builder.
      */
@@ -353,6 +360,10 @@ public:
 
     std::vector<DebugPrinter::Block> debugPrint() const override;
 
+    std::pair<value::TypeTags, value::Value> getConstant() const {
+        return {_tag, _val};
+    }
+
 private:
     value::TypeTags _tag;
     value::Value _val;
@@ -487,6 +498,13 @@ public:
     std::vector<DebugPrinter::Block> debugPrint() const override;
 
 private:
+    /**
+     * Compiles calls whose last argument is a constant that can be encoded directly in the
+     * instruction (e.g. the field name of 'getField'), which saves pushing and popping the constant
+     * on every evaluation. Returns nullptr if the call has no such form.
+     */
+    std::unique_ptr<vm::CodeFragment> compileWithImmediate(CompileCtx& ctx) const;
+
     std::string _name;
 };
 
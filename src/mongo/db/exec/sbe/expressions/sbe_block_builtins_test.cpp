@@ -0,0 +1,161 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/expression_test_base.h"
+#include "mongo/db/exec/sbe/values/bson.h"
+
+namespace mongo::sbe {
+
+class SBEBlockBuiltinsTest : public EExpressionTestFixture {
+protected:
+    using TypedValue = std::pair<value::TypeTags, value::Value>;
+
+    /**
+     * Assert that result of 'fnName(block, arg)' is equal to 'expected'.
+     * NOTE: Values behind arguments and the return value of this function are owned by the caller.
+     */
+    void runAndAssertExpression(StringData fnName,
+                                TypedValue block,
+                                TypedValue arg,
+                                TypedValue expected) {
+        value::ViewOfValueAccessor blockSlotAccessor;
+        auto blockSlot = bindAccessor(&blockSlotAccessor);
+        blockSlotAccessor.reset(block.first, block.second);
+
+        value::ViewOfValueAccessor argSlotAccessor;
+        auto argSlot = bindAccessor(&argSlotAccessor);
+        argSlotAccessor.reset(arg.first, arg.second);
+
+        auto expr = makeE<EFunction>(
+            fnName, makeEs(makeE<EVariable>(blockSlot), makeE<EVariable>(argSlot)));
+        auto compiledExpr = compileExpression(*expr);
+
+        auto actual = runCompiledExpression(compiledExpr.get());
+        value::ValueGuard actualGuard{actual};
+
+        auto [compareTag, compareValue] =
+            value::compareValue(actual.first, actual.second, expected.first, expected.second);
+        ASSERT_EQ(compareTag, value::TypeTags::NumberInt32);
+        ASSERT_EQ(compareValue, 0);
+    }
+};
+
+TEST_F(SBEBlockBuiltinsTest, CompareHomogeneousBlock) {
+    for (auto makeArrayFn : {makeBsonArray, makeArray}) {
+        auto block = makeArrayFn(BSON_ARRAY(1 << 5 << 3 << 7));
+        value::ValueGuard blockGuard{block};
+
+        auto expectedLt = makeArray(BSON_ARRAY(true << false << true << false));
+        value::ValueGuard expectedLtGuard{expectedLt};
+        runAndAssertExpression("blockLt", block, makeInt32(5), expectedLt);
+
+        auto expectedGte = makeArray(BSON_ARRAY(false << true << false << true));
+        value::ValueGuard expectedGteGuard{expectedGte};
+        runAndAssertExpression("blockGte", block, makeInt32(5), expectedGte);
+
+        auto expectedEq = makeArray(BSON_ARRAY(false << true << false << false));
+        value::ValueGuard expectedEqGuard{expectedEq};
+        runAndAssertExpression("blockEq", block, makeInt32(5), expectedEq);
+    }
+}
+
+TEST_F(SBEBlockBuiltinsTest, CompareMixedBlock) {
+    auto block = makeArray(BSON_ARRAY(1 << 2.5 << 4LL << 3.5));
+    value::ValueGuard blockGuard{block};
+
+    auto expected = makeArray(BSON_ARRAY(false << false << true << true));
+    value::ValueGuard expectedGuard{expected};
+    runAndAssertExpression("blockGt", block, makeDouble(3.0), expected);
+}
+
+TEST_F(SBEBlockBuiltinsTest, CompareOrdersMixedTypesByType) {
+    auto block = makeArray(BSON_ARRAY(1 << "abc" << BSONNULL << 3));
+    value::ValueGuard blockGuard{block};
+
+    auto expected = makeArray(BSON_ARRAY(true << false << true << false));
+    value::ValueGuard expectedGuard{expected};
+    runAndAssertExpression("blockLte", block, makeInt32(2), expected);
+}
+
+TEST_F(SBEBlockBuiltinsTest, CompareOrdersNaNBelowNumbers) {
+    for (auto makeArrayFn : {makeBsonArray, makeArray}) {
+        auto block = makeArrayFn(BSON_ARRAY(std::numeric_limits<double>::quiet_NaN() << 1.5));
+        value::ValueGuard blockGuard{block};
+
+        auto expectedLt = makeArray(BSON_ARRAY(true << false));
+        value::ValueGuard expectedLtGuard{expectedLt};
+        runAndAssertExpression("blockLt", block, makeDouble(0.0), expectedLt);
+
+        auto expectedEq = makeArray(BSON_ARRAY(true << false));
+        value::ValueGuard expectedEqGuard{expectedEq};
+        runAndAssertExpression(
+            "blockEq", block, makeDouble(std::numeric_limits<double>::quiet_NaN()), expectedEq);
+    }
+}
+
+TEST_F(SBEBlockBuiltinsTest, Filter) {
+    for (auto makeArrayFn : {makeBsonArray, makeArray}) {
+        auto block = makeArrayFn(BSON_ARRAY(10 << "a" << 30 << 40));
+        value::ValueGuard blockGuard{block};
+
+        auto mask = makeArrayFn(BSON_ARRAY(true << true << false << BSONNULL));
+        value::ValueGuard maskGuard{mask};
+
+        auto expected = makeArray(BSON_ARRAY(10 << "a"));
+        value::ValueGuard expectedGuard{expected};
+        runAndAssertExpression("blockFilter", block, mask, expected);
+    }
+}
+
+TEST_F(SBEBlockBuiltinsTest, FilterMaskSizeMismatch) {
+    auto block = makeArray(BSON_ARRAY(10 << 20 << 30));
+    value::ValueGuard blockGuard{block};
+
+    auto shortMask = makeArray(BSON_ARRAY(true << false));
+    value::ValueGuard shortMaskGuard{shortMask};
+    ASSERT_THROWS_CODE(runAndAssertExpression("blockFilter", block, shortMask, makeNothing()),
+                       DBException,
+                       6100008);
+
+    auto longMask = makeArray(BSON_ARRAY(true << false << true << true));
+    value::ValueGuard longMaskGuard{longMask};
+    ASSERT_THROWS_CODE(runAndAssertExpression("blockFilter", block, longMask, makeNothing()),
+                       DBException,
+                       6100009);
+}
+
+TEST_F(SBEBlockBuiltinsTest, NotBlock) {
+    runAndAssertExpression("blockLt", makeNothing(), makeInt32(1), makeNothing());
+    runAndAssertExpression("blockFilter", makeInt32(123), makeInt32(1), makeNothing());
+}
+
+}  // namespace mongo::sbe
@@ -0,0 +1,134 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include <string>
+
+#include "mongo/db/exec/sbe/expression_test_base.h"
+
+namespace mongo::sbe {
+
+class SBEGetFieldFillEmptyTest : public EExpressionTestFixture {
+protected:
+    /**
+     * Compiles and runs 'getField(obj, fieldName)' against 'obj' and returns its result, which is
+     * owned by the caller. The field name is either a constant, which is encoded in the
+     * instruction when short enough, or read from a slot.
+     */
+    std::pair<value::TypeTags, value::Value> runGetField(const BSONObj& obj,
+                                                        StringData fieldName,
+                                                        bool constantFieldName) {
+        value::ViewOfValueAccessor objAccessor;
+        objAccessor.reset(value::TypeTags::bsonObject,
+                          value::bitcastFrom<const char*>(obj.objdata()));
+        auto objExpr = makeE<EVariable>(bindAccessor(&objAccessor));
+
+        auto [nameTag, nameVal] = value::makeNewString(fieldName);
+        value::OwnedValueAccessor nameAccessor;
+        nameAccessor.reset(true, nameTag, nameVal);
+        auto nameExpr = constantFieldName ? makeE<EConstant>(fieldName)
+                                          : makeE<EVariable>(bindAccessor(&nameAccessor));
+
+        auto expr = makeE<EFunction>("getField", makeEs(std::move(objExpr), std::move(nameExpr)));
+        auto compiledExpr = compileExpression(*expr);
+        return runCompiledExpression(compiledExpr.get());
+    }
+
+    /**
+     * Compiles and runs 'fillEmpty(arg, constant)' and returns its result, which is owned by the
+     * caller.
+     */
+    std::pair<value::TypeTags, value::Value> runFillEmpty(
+        std::pair<value::TypeTags, value::Value> arg,
+        std::pair<value::TypeTags, value::Value> constant) {
+        auto expr = makeE<EFunction>(
+            "fillEmpty",
+            makeEs(makeE<EConstant>(arg.first, arg.second),
+                   makeE<EConstant>(constant.first, constant.second)));
+        auto compiledExpr = compileExpression(*expr);
+        return runCompiledExpression(compiledExpr.get());
+    }
+};
+
+TEST_F(SBEGetFieldFillEmptyTest, GetFieldWithConstantAndVariableFieldName) {
+    const std::string longName(vm::Instruction::kMaxImmFieldNameSize + 1, 'x');
+    auto obj = BSON("a" << 1 << "b"
+                        << "str" << longName << 2);
+
+    for (bool constantFieldName : {true, false}) {
+        {
+            auto [tag, val] = runGetField(obj, "a", constantFieldName);
+            value::ValueGuard guard(tag, val);
+            ASSERT_EQ(tag, value::TypeTags::NumberInt32);
+            ASSERT_EQ(value::bitcastTo<int32_t>(val), 1);
+        }
+        {
+            auto [tag, val] = runGetField(obj, "b", constantFieldName);
+            value::ValueGuard guard(tag, val);
+            ASSERT(value::isString(tag));
+            ASSERT_EQ(value::getStringView(tag, val), "str");
+        }
+        {
+            auto [tag, val] = runGetField(obj, longName, constantFieldName);
+            value::ValueGuard guard(tag, val);
+            ASSERT_EQ(tag, value::TypeTags::NumberInt32);
+            ASSERT_EQ(value::bitcastTo<int32_t>(val), 2);
+        }
+        {
+            auto [tag, val] = runGetField(obj, "missing", constantFieldName);
+            value::ValueGuard guard(tag, val);
+            ASSERT_EQ(tag, value::TypeTags::Nothing);
+        }
+    }
+}
+
+TEST_F(SBEGetFieldFillEmptyTest, FillEmptyWithConstant) {
+    const auto nothing = std::make_pair(value::TypeTags::Nothing, value::Value{0});
+    const auto null = std::make_pair(value::TypeTags::Null, value::Value{0});
+    const auto trueValue =
+        std::make_pair(value::TypeTags::Boolean, value::bitcastFrom<bool>(true));
+    const auto falseValue =
+        std::make_pair(value::TypeTags::Boolean, value::bitcastFrom<bool>(false));
+    const auto five = std::make_pair(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(5));
+
+    for (auto constant : {null, trueValue, falseValue, five}) {
+        auto [tag, val] = runFillEmpty(nothing, constant);
+        value::ValueGuard guard(tag, val);
+        ASSERT_EQ(tag, constant.first);
+        ASSERT_EQ(val, constant.second);
+    }
+
+    for (auto constant : {null, trueValue, five}) {
+        auto [tag, val] = runFillEmpty(falseValue, constant);
+        value::ValueGuard guard(tag, val);
+        ASSERT_EQ(tag, value::TypeTags::Boolean);
+        ASSERT_FALSE(value::bitcastTo<bool>(val));
+    }
+}
+
+}  // namespace mongo::sbe
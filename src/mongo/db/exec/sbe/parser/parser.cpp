@@ -1151,6 +1151,8 @@ void Parser::walkGroup(AstQuery& ast) {
         true,
         collatorSlotPos ? lookupSlot(std::move(ast.nodes[collatorSlotPos]->identifier))
                         : boost::none,
+        false /* allowDiskUse */,
+        makeEM() /* mergingExprs */,
         getCurrentPlanNodeId());
 }
 
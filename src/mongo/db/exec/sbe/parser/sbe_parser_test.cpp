@@ -360,7 +360,9 @@ protected:
                                 "max", sbe::makeE<sbe::EVariable>(sbe::value::SlotId{1}))),
                 sbe::makeSV(),
                 true,
-                boost::none, /* optional collator slot */
+                boost::none,   /* optional collator slot */
+                false,         /* allowDiskUse */
+                sbe::makeEM(), /* mergingExprs */
                 planNodeId),
             // GROUP with a collator slot.
             sbe::makeS<sbe::HashAggStage>(
@@ -375,6 +377,8 @@ protected:
                 sbe::makeSV(),
                 true,
                 sbe::value::SlotId{4}, /* optional collator slot */
+                false,                 /* allowDiskUse */
+                sbe::makeEM(),         /* mergingExprs */
                 planNodeId),
             // LIMIT
             sbe::makeS<sbe::LimitSkipStage>(
@@ -37,6 +37,10 @@
 #include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo::sbe {
 
@@ -84,6 +88,8 @@ TEST_F(HashAggStageTest, HashAggMinMaxTest) {
             makeSV(),
             true,
             boost::none,
+            false,
+            makeEM(),
             kEmptyPlanNodeId);
 
         auto outSlot = generateSlotId();
@@ -140,6 +146,8 @@ TEST_F(HashAggStageTest, HashAggAddToSetTest) {
             makeSV(),
             true,
             boost::none,
+            false,
+            makeEM(),
             kEmptyPlanNodeId);
 
         return std::make_pair(hashAggSlot, std::move(hashAggStage));
@@ -226,6 +234,8 @@ TEST_F(HashAggStageTest, HashAggCollationTest) {
                                     makeSV(),
                                     true,
                                     boost::optional<value::SlotId>{useCollator, collatorSlot},
+                                    false,
+                                    makeEM(),
                                     kEmptyPlanNodeId);
 
             return std::make_pair(countsSlot, std::move(hashAggStage));
@@ -317,6 +327,8 @@ TEST_F(HashAggStageTest, HashAggSeekKeysTest) {
             makeSV(seekSlot),
             true,
             boost::none,
+            false,
+            makeEM(),
             kEmptyPlanNodeId);
 
         return std::make_pair(countsSlot, std::move(hashAggStage));
@@ -356,4 +368,62 @@ TEST_F(HashAggStageTest, HashAggSeekKeysTest) {
     stage->close();
 }
 
+TEST_F(HashAggStageTest, HashAggSpillsToDiskAndMergesPartialAggregates) {
+    unittest::TempDir tempDir("HashAggStageTest");
+    auto originalDbPath = storageGlobalParams.dbpath;
+    storageGlobalParams.dbpath = tempDir.path();
+    ON_BLOCK_EXIT([&] { storageGlobalParams.dbpath = originalDbPath; });
+
+    // Force the hash table to be spilled every time its size is checked.
+    RAIIServerParameterControllerForTest controller(
+        "internalQuerySBEAggApproxMemoryUseInBytesBeforeSpill", 1);
+
+    // Build a scan of 1000 values cycling through [0, 7).
+    BSONArrayBuilder bab;
+    for (int i = 0; i < 1000; ++i) {
+        bab.append(i % 7);
+    }
+    auto [inputTag, inputVal] = stage_builder::makeValue(bab.arr());
+    auto [scanSlot, scanStage] = generateVirtualScan(inputTag, inputVal);
+
+    // Group by the scanned value and count the occurrences, summing the partial counts of the
+    // spilled runs.
+    auto countsSlot = generateSlotId();
+    auto stage = makeS<HashAggStage>(
+        std::move(scanStage),
+        makeSV(scanSlot),
+        makeEM(countsSlot,
+               stage_builder::makeFunction("sum",
+                                           makeE<EConstant>(value::TypeTags::NumberInt64,
+                                                            value::bitcastFrom<int64_t>(1)))),
+        makeSV(),
+        true,
+        boost::none,
+        true,
+        makeEM(countsSlot, stage_builder::makeFunction("sum", makeE<EVariable>(countsSlot))),
+        kEmptyPlanNodeId);
+
+    auto ctx = makeCompileCtx();
+    auto resultAccessors = prepareTree(ctx.get(), stage.get(), makeSV(scanSlot, countsSlot));
+
+    // The groups are read back from the spilled runs in key order.
+    for (int key = 0; key < 7; ++key) {
+        ASSERT_TRUE(stage->getNext() == PlanState::ADVANCED);
+        auto [keyTag, keyVal] = resultAccessors[0]->getViewOfValue();
+        assertValuesEqual(
+            keyTag, keyVal, value::TypeTags::NumberInt32, value::bitcastFrom<int>(key));
+        auto [countTag, countVal] = resultAccessors[1]->getViewOfValue();
+        assertValuesEqual(countTag,
+                          countVal,
+                          value::TypeTags::NumberInt32,
+                          value::bitcastFrom<int>(key < 6 ? 143 : 142));
+    }
+    ASSERT_TRUE(stage->getNext() == PlanState::IS_EOF);
+
+    auto stats = static_cast<const HashAggStats*>(stage->getSpecificStats());
+    ASSERT_GT(stats->spills, 1U);
+
+    stage->close();
+}
+
 }  // namespace mongo::sbe
@@ -27,6 +27,7 @@
  *    it in the license file.
  */
 
+#include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/values/bson.h"
 #include "mongo/db/exec/sbe/values/value.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
@@ -466,4 +467,36 @@ TEST(SBESmallString, Length) {
         ASSERT_EQ(length, value::getStringLength(tag, val));
     }
 }
+
+TEST(SBERuntimeEnvironment, DeepCopyDoesNotShareSlotValues) {
+    value::SlotIdGenerator slotIdGenerator;
+    RuntimeEnvironment env;
+
+    auto [strTag, strVal] = value::makeNewString("a string which is too long to be small"_sd);
+    auto strSlot = env.registerSlot("str"_sd, strTag, strVal, true, &slotIdGenerator);
+    auto intSlot = env.registerSlot(value::TypeTags::NumberInt32,
+                                    value::bitcastFrom<int32_t>(42),
+                                    false,
+                                    &slotIdGenerator);
+
+    auto copy = env.makeDeepCopy();
+    ASSERT_EQ(copy->getSlot("str"_sd), strSlot);
+
+    // The owned string is copied rather than shared.
+    auto [copyTag, copyVal] = copy->getAccessor(strSlot)->getViewOfValue();
+    ASSERT_EQ(copyTag, strTag);
+    ASSERT_NE(copyVal, strVal);
+    ASSERT_EQ(value::getStringView(copyTag, copyVal), value::getStringView(strTag, strVal));
+
+    // Changing a slot of the copy does not affect the original environment.
+    copy->resetSlot(intSlot, value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(7), false);
+    auto [origTag, origVal] = env.getAccessor(intSlot)->getViewOfValue();
+    ASSERT_EQ(origTag, value::TypeTags::NumberInt32);
+    ASSERT_EQ(value::bitcastTo<int32_t>(origVal), 42);
+
+    copy.reset();
+    auto [strTagAfter, strValAfter] = env.getAccessor(strSlot)->getViewOfValue();
+    ASSERT_EQ(value::getStringView(strTagAfter, strValAfter),
+              "a string which is too long to be small"_sd);
+}
 }  // namespace mongo::sbe
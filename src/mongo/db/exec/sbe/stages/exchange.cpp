@@ -33,8 +33,39 @@
 
 #include "mongo/base/init.h"
 #include "mongo/db/client.h"
+#include "mongo/db/query/plan_yield_policy.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo::sbe {
+namespace {
+/**
+ * The yield policy of an exchange producer. Producers run on their own operation contexts, so
+ * each one yields its own locks and storage engine snapshot, independently of the query.
+ */
+class ExchangeProducerYieldPolicy final : public PlanYieldPolicy {
+public:
+    ExchangeProducerYieldPolicy(OperationContext* opCtx, PlanStage* root)
+        : PlanYieldPolicy(YieldPolicy::YIELD_AUTO,
+                          opCtx->getServiceContext()->getFastClockSource(),
+                          internalQueryExecYieldIterations.load(),
+                          Milliseconds{internalQueryExecYieldPeriodMS.load()},
+                          nullptr /* yieldable */,
+                          nullptr /* callbacks */),
+          _root(root) {}
+
+private:
+    void saveState(OperationContext* opCtx) override {
+        _root->saveState();
+    }
+
+    void restoreState(OperationContext* opCtx, const Yieldable* yieldable) override {
+        _root->restoreState();
+    }
+
+    PlanStage* const _root;
+};
+}  // namespace
+
 std::unique_ptr<ThreadPool> s_globalThreadPool;
 MONGO_INITIALIZER(s_globalThreadPool)(InitializerContext* context) {
     ThreadPool::Options options;
@@ -82,10 +113,11 @@ std::unique_ptr<ExchangeBuffer> ExchangePipe::getEmptyBuffer() {
     return std::move(_emptyBuffers[_emptyCount]);
 }
 
-std::unique_ptr<ExchangeBuffer> ExchangePipe::getFullBuffer() {
+std::unique_ptr<ExchangeBuffer> ExchangePipe::getFullBuffer(OperationContext* opCtx) {
     stdx::unique_lock lock(_mutex);
 
-    _cond.wait(lock, [this]() { return _closed || _fullCount != _fullPosition; });
+    opCtx->waitForConditionOrInterrupt(
+        _cond, lock, [this]() { return _closed || _fullCount != _fullPosition; });
 
     if (_closed) {
         return nullptr;
@@ -137,7 +169,7 @@ ExchangeBuffer* ExchangeConsumer::getBuffer(size_t producerId) {
         return _fullBuffers[producerId].get();
     }
 
-    _fullBuffers[producerId] = _pipes[producerId]->getFullBuffer();
+    _fullBuffers[producerId] = _pipes[producerId]->getFullBuffer(_opCtx);
 
     return _fullBuffers[producerId].get();
 }
@@ -260,15 +292,37 @@ void ExchangeConsumer::open(bool reOpen) {
                 }
             }
 
+            // Producers read from their own recovery units. When this operation reads at a point
+            // in time, make them read at the same timestamp so that all of them observe the data
+            // this operation would have observed.
+            auto readTimestamp = _opCtx->recoveryUnit()->getPointInTimeReadTimestamp(_opCtx);
+
+            // Producers also inherit the time limit of this operation. Its other interrupts are
+            // passed on to them by cancelling the exchange when this consumer closes.
+            auto deadline = _opCtx->getDeadline();
+            auto timeoutError = _opCtx->getTimeoutError();
+
             // Start n producers.
             invariant(_state->producerCompileCtxs().size() == _state->numOfProducers());
             for (size_t idx = 0; idx < _state->numOfProducers(); ++idx) {
                 auto pf = makePromiseFuture<void>();
                 s_globalThreadPool->schedule(
-                    [this, idx, promise = std::move(pf.promise)](auto status) mutable {
+                    [this,
+                     idx,
+                     readTimestamp,
+                     deadline,
+                     timeoutError,
+                     promise = std::move(pf.promise)](auto status) mutable {
                         invariant(status);
 
                         auto opCtx = cc().makeOperationContext();
+                        if (deadline != Date_t::max()) {
+                            opCtx->setDeadlineByDate(deadline, timeoutError);
+                        }
+                        if (readTimestamp) {
+                            opCtx->recoveryUnit()->setTimestampReadSource(
+                                RecoveryUnit::ReadSource::kProvided, *readTimestamp);
+                        }
 
                         promise.setWith([&] {
                             ExchangeProducer::start(opCtx.get(),
@@ -345,6 +399,7 @@ void ExchangeConsumer::close() {
         ++_state->consumerClose();
 
         // Signal early out.
+        _state->cancel();
         for (auto& p : _pipes) {
             p->close();
         }
@@ -481,6 +536,11 @@ void ExchangeProducer::start(OperationContext* opCtx,
 
     p->attachToOperationContext(opCtx);
 
+    // The producer's stages were built with the query's yield policy, which belongs to another
+    // operation context. Give them one that yields this producer's locks instead.
+    ExchangeProducerYieldPolicy yieldPolicy(opCtx, p);
+    p->attachNewYieldPolicy(&yieldPolicy);
+
     try {
         p->prepare(ctx);
         p->open(false);
@@ -544,7 +604,7 @@ bool ExchangeProducer::appendData(size_t consumerId) {
 PlanState ExchangeProducer::getNext() {
     auto optTimer(getOptTimer(_opCtx));
 
-    while (_children[0]->getNext() == PlanState::ADVANCED) {
+    while (!_state->isCancelled() && _children[0]->getNext() == PlanState::ADVANCED) {
         // Push to the correct pipe.
         switch (_state->policy()) {
             case ExchangePolicy::broadcast: {
@@ -33,6 +33,7 @@
 
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/future.h"
 #include "mongo/util/concurrency/thread_pool.h"
@@ -123,7 +124,11 @@ public:
 
     void close();
     std::unique_ptr<ExchangeBuffer> getEmptyBuffer();
-    std::unique_ptr<ExchangeBuffer> getFullBuffer();
+
+    /**
+     * Waits for a full buffer. The wait is interrupted, and throws, if 'opCtx' is killed.
+     */
+    std::unique_ptr<ExchangeBuffer> getFullBuffer(OperationContext* opCtx);
     void putEmptyBuffer(std::unique_ptr<ExchangeBuffer>);
     void putFullBuffer(std::unique_ptr<ExchangeBuffer>);
 
@@ -222,6 +227,17 @@ public:
 
     ExchangePipe* pipe(size_t consumerTid, size_t producerTid);
 
+    /**
+     * Tells the producers to stop producing. Producers check for this before fetching every row,
+     * as they run on their own operation contexts and do not observe the consumers' interrupts.
+     */
+    void cancel() {
+        _cancelled.store(true);
+    }
+    bool isCancelled() const {
+        return _cancelled.load();
+    }
+
 private:
     const ExchangePolicy _policy;
     const size_t _numOfProducers;
@@ -249,6 +265,8 @@ private:
     mongo::Mutex _consumerCloseMutex;
     stdx::condition_variable _consumerCloseCond;
     size_t _consumerClose{0};
+
+    AtomicWord<bool> _cancelled{false};
 };
 
 class ExchangeConsumer final : public PlanStage {
@@ -31,28 +31,74 @@
 
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
 
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/stats/resource_consumption_metrics.h"
+#include "mongo/db/storage/storage_options.h"
 #include "mongo/util/str.h"
 
+namespace {
+std::string nextFileName() {
+    static mongo::AtomicWord<unsigned> hashAggFileCounter;
+    return "extsort-hash-agg-sbe." + std::to_string(hashAggFileCounter.fetchAndAdd(1));
+}
+}  // namespace
+
+#include "mongo/db/sorter/sorter.cpp"
+
 namespace mongo {
 namespace sbe {
+namespace {
+// Estimating the size of a group is not free, so only one out of this many input rows is sampled.
+constexpr size_t kMemoryCheckFrequency = 100;
+
+int compareGroupKeys(const value::MaterializedRow& lhs,
+                     const value::MaterializedRow& rhs,
+                     const CollatorInterface* collator) {
+    for (size_t idx = 0; idx < lhs.size(); ++idx) {
+        auto [lhsTag, lhsVal] = lhs.getViewOfValue(idx);
+        auto [rhsTag, rhsVal] = rhs.getViewOfValue(idx);
+        auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal, collator);
+
+        auto result = value::bitcastTo<int32_t>(val);
+        if (result) {
+            return result;
+        }
+    }
+
+    return 0;
+}
+}  // namespace
+
 HashAggStage::HashAggStage(std::unique_ptr<PlanStage> input,
                            value::SlotVector gbs,
                            value::SlotMap<std::unique_ptr<EExpression>> aggs,
                            value::SlotVector seekKeysSlots,
                            bool optimizedClose,
                            boost::optional<value::SlotId> collatorSlot,
+                           bool allowDiskUse,
+                           value::SlotMap<std::unique_ptr<EExpression>> mergingExprs,
                            PlanNodeId planNodeId)
     : PlanStage("group"_sd, planNodeId),
       _gbs(std::move(gbs)),
       _aggs(std::move(aggs)),
       _collatorSlot(collatorSlot),
       _seekKeysSlots(std::move(seekKeysSlots)),
-      _optimizedClose(optimizedClose) {
+      _optimizedClose(optimizedClose),
+      _allowDiskUse(allowDiskUse),
+      _mergingExprs(std::move(mergingExprs)) {
     _children.emplace_back(std::move(input));
     invariant(_seekKeysSlots.empty() || _seekKeysSlots.size() == _gbs.size());
     tassert(5843100,
             "HashAgg stage was given optimizedClose=false and seek keys",
             _seekKeysSlots.empty() || _optimizedClose);
+    tassert(6000121,
+            "HashAgg stage was given allowDiskUse=true and seek keys",
+            !_allowDiskUse || _seekKeysSlots.empty());
+    tassert(6000122,
+            "HashAgg stage which allows spilling needs a merging expression for each aggregate",
+            !_allowDiskUse || std::all_of(_aggs.begin(), _aggs.end(), [&](auto&& agg) {
+                return _mergingExprs.count(agg.first) > 0;
+            }));
 }
 
 std::unique_ptr<PlanStage> HashAggStage::clone() const {
@@ -60,12 +106,18 @@ std::unique_ptr<PlanStage> HashAggStage::clone() const {
     for (auto& [k, v] : _aggs) {
         aggs.emplace(k, v->clone());
     }
+    value::SlotMap<std::unique_ptr<EExpression>> mergingExprs;
+    for (auto& [k, v] : _mergingExprs) {
+        mergingExprs.emplace(k, v->clone());
+    }
     return std::make_unique<HashAggStage>(_children[0]->clone(),
                                           _gbs,
                                           std::move(aggs),
                                           _seekKeysSlots,
                                           _optimizedClose,
                                           _collatorSlot,
+                                          _allowDiskUse,
+                                          std::move(mergingExprs),
                                           _commonStats.nodeId);
 }
 
@@ -87,8 +139,13 @@ void HashAggStage::prepare(CompileCtx& ctx) {
         uassert(4822827, str::stream() << "duplicate field: " << slot, inserted);
 
         _inKeyAccessors.emplace_back(_children[0]->getAccessor(ctx, slot));
-        _outKeyAccessors.emplace_back(std::make_unique<HashKeyAccessor>(_htIt, counter++));
-        _outAccessors[slot] = _outKeyAccessors.back().get();
+        _outKeyAccessors.emplace_back(std::make_unique<HashKeyAccessor>(_htIt, counter));
+        _outSpilledKeyAccessors.emplace_back(
+            std::make_unique<value::MaterializedSingleRowAccessor>(_outKeyRow, counter++));
+        _outSwitchAccessors.emplace_back(std::make_unique<value::SwitchAccessor>(
+            std::vector<value::SlotAccessor*>{_outKeyAccessors.back().get(),
+                                              _outSpilledKeyAccessors.back().get()}));
+        _outAccessors[slot] = _outSwitchAccessors.back().get();
     }
 
     // Process seek keys (if any). The keys must come from outside of the subtree (by definition) so
@@ -106,14 +163,30 @@ void HashAggStage::prepare(CompileCtx& ctx) {
         const auto slotId = slot;
         uassert(4822828, str::stream() << "duplicate field: " << slotId, inserted);
 
-        _outAggAccessors.emplace_back(std::make_unique<HashAggAccessor>(_htIt, counter++));
-        _outAccessors[slot] = _outAggAccessors.back().get();
+        _outAggAccessors.emplace_back(std::make_unique<HashAggAccessor>(_htIt, counter));
+        _outSpilledAggAccessors.emplace_back(
+            std::make_unique<value::MaterializedSingleRowAccessor>(_outAggRow, counter));
+        _spilledAggAccessors.emplace_back(
+            std::make_unique<value::MaterializedSingleRowAccessor>(_spilledAggRow, counter++));
+        _outSwitchAccessors.emplace_back(std::make_unique<value::SwitchAccessor>(
+            std::vector<value::SlotAccessor*>{_outAggAccessors.back().get(),
+                                              _outSpilledAggAccessors.back().get()}));
+        _outAccessors[slot] = _outSwitchAccessors.back().get();
 
         ctx.root = this;
         ctx.aggExpression = true;
         ctx.accumulator = _outAggAccessors.back().get();
 
         _aggCodes.emplace_back(expr->compile(ctx));
+
+        if (_allowDiskUse) {
+            // The merging expression reads the partial aggregate of a spilled run through the
+            // aggregate's own slot.
+            ctx.accumulator = _outSpilledAggAccessors.back().get();
+            ctx.pushCorrelated(slot, _spilledAggAccessors.back().get());
+            _mergingCodes.emplace_back(_mergingExprs.at(slot)->compile(ctx));
+            ctx.popCorrelated();
+        }
         ctx.aggExpression = false;
     }
     _compiled = true;
@@ -139,6 +212,7 @@ void HashAggStage::open(bool reOpen) {
     if (!reOpen || _seekKeysAccessors.empty()) {
         _children[0]->open(_childOpened);
         _childOpened = true;
+        resetSpillState();
 
         if (_collatorAccessor) {
             auto [tag, collatorVal] = _collatorAccessor->getViewOfValue();
@@ -148,8 +222,10 @@ void HashAggStage::open(bool reOpen) {
             const value::MaterializedRowHasher hasher(collatorView);
             const value::MaterializedRowEq equator(collatorView);
             _ht.emplace(0, hasher, equator);
+            _collator = collatorView;
         } else {
             _ht.emplace();
+            _collator = nullptr;
         }
 
         _seekKeys.resize(_seekKeysAccessors.size());
@@ -165,8 +241,18 @@ void HashAggStage::open(bool reOpen) {
 
             auto [it, inserted] = _ht->try_emplace(std::move(key), value::MaterializedRow{0});
             if (inserted) {
-                // Copy keys.
-                const_cast<value::MaterializedRow&>(it->first).makeOwned();
+                // Take ownership of the keys. Unless the table can be spilled, which frees the
+                // keys while the input slots may still view them, values owned by the input slots
+                // are moved rather than deep copied.
+                auto& ownedKey = const_cast<value::MaterializedRow&>(it->first);
+                if (_allowDiskUse) {
+                    ownedKey.makeOwned();
+                } else {
+                    for (size_t keyIdx = 0; keyIdx < _inKeyAccessors.size(); ++keyIdx) {
+                        auto [tag, val] = _inKeyAccessors[keyIdx]->copyOrMoveValue();
+                        ownedKey.reset(keyIdx, true, tag, val);
+                    }
+                }
                 // Initialize accumulators.
                 it->second.resize(_outAggAccessors.size());
             }
@@ -177,12 +263,32 @@ void HashAggStage::open(bool reOpen) {
                 auto [owned, tag, val] = _bytecode.run(_aggCodes[idx].get());
                 _outAggAccessors[idx]->reset(owned, tag, val);
             }
+
+            if (_allowDiskUse) {
+                checkMemoryUsageAndSpillIfNecessary();
+            }
         }
 
         if (_optimizedClose) {
             _children[0]->close();
             _childOpened = false;
         }
+
+        if (!_spilledRuns.empty()) {
+            // Spill what is left in the table so that all the groups can be read back in key
+            // order from the merged runs.
+            if (!_ht->empty()) {
+                spill();
+            }
+
+            auto comp = [collator = _collator](const SpilledRow& lhs, const SpilledRow& rhs) {
+                return compareGroupKeys(lhs.first, rhs.first, collator);
+            };
+            _spillIt.reset(SpillIterator::merge(_spilledRuns, SortOptions(), comp));
+            for (auto& accessor : _outSwitchAccessors) {
+                accessor->setIndex(1);
+            }
+        }
     }
 
     if (!_seekKeysAccessors.empty()) {
@@ -197,9 +303,110 @@ void HashAggStage::open(bool reOpen) {
     _htIt = _ht->end();
 }
 
+void HashAggStage::checkMemoryUsageAndSpillIfNecessary() {
+    if (_memoryCheckCounter++ % kMemoryCheckFrequency != 0) {
+        return;
+    }
+
+    // The aggregates may grow with every update (e.g. for addToSet), so the size of the table is
+    // estimated from the average size of the sampled groups rather than tracked exactly.
+    _sampledGroupsBytes += _htIt->first.memUsageForSorter() + _htIt->second.memUsageForSorter();
+    ++_sampledGroups;
+
+    auto estimatedTableBytes = _sampledGroupsBytes / _sampledGroups * _ht->size();
+    trackMemoryUsage(estimatedTableBytes);
+    if (estimatedTableBytes >
+        static_cast<size_t>(internalQuerySBEAggApproxMemoryUseInBytesBeforeSpill.load())) {
+        spill();
+    }
+}
+
+void HashAggStage::spill() {
+    if (!_spillFile) {
+        _spillFile = std::make_shared<Sorter<value::MaterializedRow, value::MaterializedRow>::File>(
+            storageGlobalParams.dbpath + "/_tmp/" + nextFileName());
+    }
+
+    std::vector<TableType::iterator> groups;
+    groups.reserve(_ht->size());
+    for (auto it = _ht->begin(); it != _ht->end(); ++it) {
+        groups.push_back(it);
+    }
+    std::sort(groups.begin(), groups.end(), [&](const auto& lhs, const auto& rhs) {
+        return compareGroupKeys(lhs->first, rhs->first, _collator) < 0;
+    });
+
+    SortedFileWriter<value::MaterializedRow, value::MaterializedRow> writer(
+        SortOptions().TempDir(storageGlobalParams.dbpath + "/_tmp"), _spillFile);
+    for (auto& it : groups) {
+        writer.addAlreadySorted(it->first, it->second);
+    }
+    _spilledRuns.emplace_back(writer.done());
+
+    _specificStats.spills++;
+    _specificStats.spilledRecords += groups.size();
+    // The spill file is shared by all runs of this stage, so its statistics are cumulative.
+    _specificStats.spilledBytes = _spillFile->stats().bytesWritten.load();
+    _specificStats.spillTimeMicros = _spillFile->stats().spillMicros.load();
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
+    metricsCollector.incrementKeysSorted(groups.size());
+    metricsCollector.incrementSorterSpills(1);
+
+    _ht->clear();
+    _htIt = _ht->end();
+}
+
+bool HashAggStage::getNextSpilledGroup() {
+    if (!_nextSpilledRow) {
+        if (!_spillIt->more()) {
+            return false;
+        }
+        _nextSpilledRow = _spillIt->next();
+    }
+
+    _outKeyRow = std::move(_nextSpilledRow->first);
+    _outAggRow = std::move(_nextSpilledRow->second);
+    _nextSpilledRow = boost::none;
+
+    // Each run holds a key at most once, so the partial aggregates of the current key come from the
+    // following rows of the merge, in the order in which the runs were spilled.
+    while (_spillIt->more()) {
+        auto row = _spillIt->next();
+        if (compareGroupKeys(row.first, _outKeyRow, _collator) != 0) {
+            _nextSpilledRow = std::move(row);
+            break;
+        }
+
+        _spilledAggRow = std::move(row.second);
+        for (size_t idx = 0; idx < _mergingCodes.size(); ++idx) {
+            auto [owned, tag, val] = _bytecode.run(_mergingCodes[idx].get());
+            _outSpilledAggAccessors[idx]->reset(owned, tag, val);
+        }
+    }
+
+    return true;
+}
+
+void HashAggStage::resetSpillState() {
+    _spillIt.reset();
+    _spilledRuns.clear();
+    _spillFile.reset();
+    _nextSpilledRow = boost::none;
+    _memoryCheckCounter = 0;
+    _sampledGroupsBytes = 0;
+    _sampledGroups = 0;
+    for (auto& accessor : _outSwitchAccessors) {
+        accessor->setIndex(0);
+    }
+}
+
 PlanState HashAggStage::getNext() {
     auto optTimer(getOptTimer(_opCtx));
 
+    if (_spillIt) {
+        return trackPlanState(getNextSpilledGroup() ? PlanState::ADVANCED : PlanState::IS_EOF);
+    }
+
     if (_htIt == _ht->end()) {
         // First invocation of getNext() after open().
         if (!_seekKeysAccessors.empty()) {
@@ -224,6 +431,7 @@ PlanState HashAggStage::getNext() {
 
 std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashAggStats>(_specificStats);
 
     if (includeDebugInfo) {
         DebugPrinter printer;
@@ -235,6 +443,18 @@ std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) co
                 childrenBob.append(str::stream() << slot, printer.print(expr->debugPrint()));
             }
         }
+        if (_allowDiskUse) {
+            bob.appendBool("usedDisk", _specificStats.spills > 0);
+            bob.appendNumber("spills", static_cast<long long>(_specificStats.spills));
+            bob.appendNumber("spilledRecords",
+                             static_cast<long long>(_specificStats.spilledRecords));
+            if (_specificStats.spills > 0) {
+                bob.appendNumber("spilledBytes",
+                                 static_cast<long long>(_specificStats.spilledBytes));
+                bob.appendNumber("spillTimeMicros",
+                                 static_cast<long long>(_specificStats.spillTimeMicros));
+            }
+        }
         ret->debugInfo = bob.obj();
     }
 
@@ -243,7 +463,7 @@ std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) co
 }
 
 const SpecificStats* HashAggStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 void HashAggStage::close() {
@@ -251,6 +471,7 @@ void HashAggStage::close() {
 
     trackClose();
     _ht = boost::none;
+    resetSpillState();
 
     if (_childOpened) {
         _children[0]->close();
@@ -305,6 +526,23 @@ std::vector<DebugPrinter::Block> HashAggStage::debugPrint() const {
         DebugPrinter::addIdentifier(ret, *_collatorSlot);
     }
 
+    if (_allowDiskUse) {
+        ret.emplace_back("spill");
+        ret.emplace_back("[`");
+        bool first = true;
+        value::orderedSlotMapTraverse(_mergingExprs, [&](auto slot, auto&& expr) {
+            if (!first) {
+                ret.emplace_back(DebugPrinter::Block("`,"));
+            }
+
+            DebugPrinter::addIdentifier(ret, slot);
+            ret.emplace_back("=");
+            DebugPrinter::addBlocks(ret, expr->debugPrint());
+            first = false;
+        });
+        ret.emplace_back("`]");
+    }
+
     DebugPrinter::addNewLine(ret);
     DebugPrinter::addBlocks(ret, _children[0]->debugPrint());
 
@@ -32,8 +32,10 @@
 #include <unordered_map>
 
 #include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/stages/plan_stats.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
+#include "mongo/db/sorter/sorter.h"
 #include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
@@ -59,10 +61,17 @@ namespace sbe {
  * determining whether two group-by keys are equal. For instance, the plan may require us to do a
  * case-insensitive group on a string field.
  *
+ * If 'allowDiskUse' is true, the hash table is written to disk, sorted by the group-by keys,
+ * whenever its estimated size exceeds 'internalQuerySBEAggApproxMemoryUseInBytesBeforeSpill'. Once
+ * the input is exhausted the spilled runs are merged, and the partial aggregates of each key are
+ * combined using 'mergingExprs'. This map must hold an aggregate expression for every slot of
+ * 'aggs', which reads a partial aggregate from that same slot and folds it into the accumulator,
+ * e.g. "min(s1)" for "s1 = min(s0)". Spilling is not supported together with seek keys.
+ *
  * Debug string representation:
  *
  *  group [<group by slots>] [slot_1 = expr_1, ..., slot_n = expr_n] [<seek slots>]? reopen?
- * collatorSlot? childStage
+ * collatorSlot? (spill [slot_1 = merge_expr_1, ..., slot_n = merge_expr_n])? childStage
  */
 class HashAggStage final : public PlanStage {
 public:
@@ -72,6 +81,8 @@ public:
                  value::SlotVector seekKeysSlots,
                  bool optimizedClose,
                  boost::optional<value::SlotId> collatorSlot,
+                 bool allowDiskUse,
+                 value::SlotMap<std::unique_ptr<EExpression>> mergingExprs,
                  PlanNodeId planNodeId);
 
     std::unique_ptr<PlanStage> clone() const final;
@@ -95,6 +106,30 @@ private:
     using HashKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
     using HashAggAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
 
+    using SpilledRow = std::pair<value::MaterializedRow, value::MaterializedRow>;
+    using SpillIterator = SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
+
+    /**
+     * Estimates the size of the hash table from a sample of the groups updated by the input and
+     * spills the table if it is over the memory limit.
+     */
+    void checkMemoryUsageAndSpillIfNecessary();
+
+    /**
+     * Writes the contents of the hash table to disk as a run sorted by the group-by keys and
+     * clears the table.
+     */
+    void spill();
+
+    /**
+     * Reads the next group from the merged spilled runs into '_outKeyRow' and '_outAggRow',
+     * combining the partial aggregates of all runs which hold the same key. Returns false once
+     * all spilled groups have been returned.
+     */
+    bool getNextSpilledGroup();
+
+    void resetSpillState();
+
     const value::SlotVector _gbs;
     const value::SlotMap<std::unique_ptr<EExpression>> _aggs;
     const boost::optional<value::SlotId> _collatorSlot;
@@ -102,10 +137,15 @@ private:
     // When this operator does not expect to be reopened (almost always) then it can close the child
     // early.
     const bool _optimizedClose{true};
+    const bool _allowDiskUse;
+    const value::SlotMap<std::unique_ptr<EExpression>> _mergingExprs;
 
     value::SlotAccessorMap _outAccessors;
     std::vector<value::SlotAccessor*> _inKeyAccessors;
     std::vector<std::unique_ptr<HashKeyAccessor>> _outKeyAccessors;
+    // The output accessors switch from the hash table to '_outKeyRow' and '_outAggRow' when the
+    // results are read back from the spilled runs.
+    std::vector<std::unique_ptr<value::SwitchAccessor>> _outSwitchAccessors;
 
     std::vector<value::SlotAccessor*> _seekKeysAccessors;
     value::MaterializedRow _seekKeys;
@@ -113,16 +153,42 @@ private:
     std::vector<std::unique_ptr<HashAggAccessor>> _outAggAccessors;
     std::vector<std::unique_ptr<vm::CodeFragment>> _aggCodes;
 
+    // Accessors and code used to combine the partial aggregates of a spilled key.
+    std::vector<std::unique_ptr<value::MaterializedSingleRowAccessor>> _outSpilledKeyAccessors;
+    std::vector<std::unique_ptr<value::MaterializedSingleRowAccessor>> _outSpilledAggAccessors;
+    std::vector<std::unique_ptr<value::MaterializedSingleRowAccessor>> _spilledAggAccessors;
+    std::vector<std::unique_ptr<vm::CodeFragment>> _mergingCodes;
+
     // Only set if collator slot provided on construction.
     value::SlotAccessor* _collatorAccessor = nullptr;
 
     boost::optional<TableType> _ht;
     TableType::iterator _htIt;
 
+    // State of the spilled runs. '_spillIt' is only set once the input has been exhausted after
+    // at least one spill, in which case the results are read from it rather than from '_ht'.
+    std::shared_ptr<Sorter<value::MaterializedRow, value::MaterializedRow>::File> _spillFile;
+    std::vector<std::shared_ptr<SpillIterator>> _spilledRuns;
+    std::unique_ptr<SpillIterator> _spillIt;
+    boost::optional<SpilledRow> _nextSpilledRow;
+    value::MaterializedRow _outKeyRow;
+    value::MaterializedRow _outAggRow;
+    value::MaterializedRow _spilledAggRow;
+
+    // Running totals of the sampled group sizes used to estimate the size of the hash table.
+    size_t _memoryCheckCounter{0};
+    size_t _sampledGroupsBytes{0};
+    size_t _sampledGroups{0};
+
+    // Collator used to compare the group-by keys, read from '_collatorAccessor' on open.
+    const CollatorInterface* _collator = nullptr;
+
     vm::ByteCode _bytecode;
 
     bool _compiled{false};
     bool _childOpened{false};
+
+    HashAggStats _specificStats;
 };
 }  // namespace sbe
 }  // namespace mongo
@@ -60,6 +60,10 @@ struct CommonStats {
     // cache.
     boost::optional<long long> executionTimeMillis;
 
+    // Same as the fields of the same names in the classic engine's CommonStats.
+    boost::optional<long long> executionTimeNanos;
+    boost::optional<uint64_t> peakTrackedMemBytes;
+
     size_t advances{0};
     size_t opens{0};
     size_t closes{0};
@@ -196,6 +200,27 @@ struct TraverseStats : public SpecificStats {
     size_t innerCloses{0};
 };
 
+struct HashAggStats final : public SpecificStats {
+    std::unique_ptr<SpecificStats> clone() const final {
+        return std::make_unique<HashAggStats>(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
+    void accumulate(PlanSummaryStats& stats) const final {
+        stats.usedDisk = stats.usedDisk || spills > 0;
+        stats.spilledBytes += spilledBytes;
+        stats.spillTimeMicros += spillTimeMicros;
+    }
+
+    size_t spills{0};
+    size_t spilledRecords{0};
+    uint64_t spilledBytes{0};
+    uint64_t spillTimeMicros{0};
+};
+
 /**
  * Calculates the total number of physical reads in the given plan stats tree. If a stage can do
  * a physical read (e.g. COLLSCAN or IXSCAN), then its 'numReads' stats is added to the total.
@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/sbe/stages/scan.h"
 
+#include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/trial_run_tracker.h"
 #include "mongo/db/index/index_access_method.h"
@@ -108,6 +109,7 @@ void ScanStage::prepare(CompileCtx& ctx) {
         auto [it, inserted] =
             _fieldAccessors.emplace(_fields[idx], std::make_unique<value::OwnedValueAccessor>());
         uassert(4822814, str::stream() << "duplicate field: " << _fields[idx], inserted);
+        _fieldNameFilter.insert(_fields[idx]);
         auto [itRename, insertedRename] = _varAccessors.emplace(_vars[idx], it->second.get());
         uassert(4822815, str::stream() << "duplicate field: " << _vars[idx], insertedRename);
     }
@@ -334,6 +336,10 @@ PlanState ScanStage::getNext() {
         }
         while (*be != 0) {
             auto sv = bson::fieldNameView(be);
+            if (!_fieldNameFilter.maybeContains(sv)) {
+                be = bson::advance(be, sv.size());
+                continue;
+            }
             if (auto it = _fieldAccessors.find(sv); it != _fieldAccessors.end()) {
                 // Found the field so convert it to Value.
                 auto [tag, val] = bson::convertFrom<true>(be, end, sv.size());
@@ -568,6 +574,7 @@ void ParallelScanStage::prepare(CompileCtx& ctx) {
         auto [it, inserted] =
             _fieldAccessors.emplace(_fields[idx], std::make_unique<value::OwnedValueAccessor>());
         uassert(4822816, str::stream() << "duplicate field: " << _fields[idx], inserted);
+        _fieldNameFilter.insert(_fields[idx]);
         auto [itRename, insertedRename] = _varAccessors.emplace(_vars[idx], it->second.get());
         uassert(4822817, str::stream() << "duplicate field: " << _vars[idx], insertedRename);
     }
@@ -589,9 +596,21 @@ void ParallelScanStage::prepare(CompileCtx& ctx) {
     }
 
     tassert(5709601, "'_coll' should not be initialized prior to 'acquireCollection()'", !_coll);
+    if (auto nss = CollectionCatalog::get(_opCtx)->lookupNSSByUUID(_opCtx, _collUuid)) {
+        lockCollectionIfNeeded(*nss);
+    }
     std::tie(_coll, _collName, _catalogEpoch) = acquireCollection(_opCtx, _collUuid);
 }
 
+void ParallelScanStage::lockCollectionIfNeeded(const NamespaceString& nss) {
+    if (_collLock || _opCtx->lockState()->isCollectionLockedForMode(nss, MODE_IS)) {
+        return;
+    }
+
+    _dbLock.emplace(_opCtx, nss.db(), MODE_IS);
+    _collLock.emplace(_opCtx, nss, MODE_IS);
+}
+
 value::SlotAccessor* ParallelScanStage::getAccessor(CompileCtx& ctx, value::SlotId slot) {
     if (_recordSlot && *_recordSlot == slot) {
         return _recordAccessor.get();
@@ -673,6 +692,7 @@ void ParallelScanStage::open(bool reOpen) {
         tassert(5071013, "ParallelScanStage is not open but have _cursor", !_cursor);
         tassert(5777403, "Collection name should be initialized", _collName);
         tassert(5777404, "Catalog epoch should be initialized", _catalogEpoch);
+        lockCollectionIfNeeded(*_collName);
         _coll = restoreCollection(_opCtx, *_collName, _collUuid, *_catalogEpoch);
     }
 
@@ -801,6 +821,10 @@ PlanState ParallelScanStage::getNext() {
         }
         while (*be != 0) {
             auto sv = bson::fieldNameView(be);
+            if (!_fieldNameFilter.maybeContains(sv)) {
+                be = bson::advance(be, sv.size());
+                continue;
+            }
             if (auto it = _fieldAccessors.find(sv); it != _fieldAccessors.end()) {
                 // Found the field so convert it to Value.
                 auto [tag, val] = bson::convertFrom<true>(be, end, sv.size());
@@ -826,6 +850,8 @@ void ParallelScanStage::close() {
     trackClose();
     _cursor.reset();
     _coll.reset();
+    _collLock.reset();
+    _dbLock.reset();
     _open = false;
 }
 
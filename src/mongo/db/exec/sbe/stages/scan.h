@@ -32,6 +32,8 @@
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/stages/collection_helpers.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/exec/field_name_bloom_filter.h"
 #include "mongo/db/exec/sbe/values/bson.h"
 #include "mongo/db/storage/record_store.h"
 
@@ -166,6 +168,8 @@ private:
     RuntimeEnvironment::Accessor* _oplogTsAccessor{nullptr};
 
     value::FieldAccessorMap _fieldAccessors;
+    // Prefilter over the keys of '_fieldAccessors', checked before the hash lookup.
+    FieldNameBloomFilter _fieldNameFilter;
     value::SlotAccessorMap _varAccessors;
     value::SlotAccessor* _seekKeyAccessor{nullptr};
 
@@ -237,6 +241,13 @@ protected:
 
 private:
     boost::optional<Record> nextRange();
+
+    /**
+     * Takes intent shared locks on the scanned collection unless the operation already holds
+     * them. This is the case for the producer threads of an exchange, whose operation contexts
+     * do not share the locks of the query that spawned them.
+     */
+    void lockCollectionIfNeeded(const NamespaceString& nss);
     bool needsRange() const {
         return _currentRange == std::numeric_limits<std::size_t>::max();
     }
@@ -261,6 +272,10 @@ private:
 
     CollectionPtr _coll;
 
+    // Locks taken by 'lockCollectionIfNeeded()', held until 'close()'.
+    boost::optional<Lock::DBLock> _dbLock;
+    boost::optional<Lock::CollectionLock> _collLock;
+
     std::shared_ptr<ParallelState> _state;
 
     const ScanCallbacks _scanCallbacks;
@@ -273,6 +288,8 @@ private:
     value::SlotAccessor* _indexKeyPatternAccessor{nullptr};
 
     value::FieldAccessorMap _fieldAccessors;
+    // Prefilter over the keys of '_fieldAccessors', checked before the hash lookup.
+    FieldNameBloomFilter _fieldNameFilter;
     value::SlotAccessorMap _varAccessors;
 
     size_t _currentRange{std::numeric_limits<std::size_t>::max()};
@@ -166,22 +166,34 @@ void SortStage::open(bool reOpen) {
 
     makeSorter();
 
+    // Values owned by the input slots, e.g. objects built by a child project stage, can be moved
+    // into the sorter instead of being deep copied, as long as the sorter keeps every row in memory
+    // until the input is exhausted. Spilling or discarding rows beyond the limit would free values
+    // that the input slots still view, and that a yield would then try to copy.
+    const bool moveInputs =
+        !_allowDiskUse && _specificStats.limit == std::numeric_limits<size_t>::max();
+    auto takeValue = [moveInputs](value::SlotAccessor* accessor) {
+        if (moveInputs) {
+            return accessor->copyOrMoveValue();
+        }
+        auto [tag, val] = accessor->getViewOfValue();
+        return copyValue(tag, val);
+    };
+
     while (_children[0]->getNext() == PlanState::ADVANCED) {
         value::MaterializedRow keys{_inKeyAccessors.size()};
         value::MaterializedRow vals{_inValueAccessors.size()};
 
         size_t idx = 0;
         for (auto accessor : _inKeyAccessors) {
-            auto [tag, val] = accessor->getViewOfValue();
-            auto [cTag, cVal] = copyValue(tag, val);
-            keys.reset(idx++, true, cTag, cVal);
+            auto [tag, val] = takeValue(accessor);
+            keys.reset(idx++, true, tag, val);
         }
 
         idx = 0;
         for (auto accessor : _inValueAccessors) {
-            auto [tag, val] = accessor->getViewOfValue();
-            auto [cTag, cVal] = copyValue(tag, val);
-            vals.reset(idx++, true, cTag, cVal);
+            auto [tag, val] = takeValue(accessor);
+            vals.reset(idx++, true, tag, val);
         }
 
         _sorter->emplace(std::move(keys), std::move(vals));
@@ -205,6 +217,10 @@ void SortStage::open(bool reOpen) {
     _mergeIt.reset(_sorter->done());
     _specificStats.spills += _sorter->numSpills();
     _specificStats.keysSorted += _sorter->numSorted();
+    if (auto fileStats = _sorter->fileStats()) {
+        _specificStats.spilledBytes += fileStats->bytesWritten.load();
+        _specificStats.spillTimeMicros += fileStats->spillMicros.load();
+    }
     auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
     metricsCollector.incrementKeysSorted(_sorter->numSorted());
     metricsCollector.incrementSorterSpills(_sorter->numSpills());
@@ -244,6 +260,11 @@ std::unique_ptr<PlanStageStats> SortStage::getStats(bool includeDebugInfo) const
                          static_cast<long long>(_specificStats.totalDataSizeBytes));
         bob.appendBool("usedDisk", _specificStats.spills > 0);
         bob.appendNumber("spills", static_cast<long long>(_specificStats.spills));
+        if (_specificStats.spills > 0) {
+            bob.appendNumber("spilledBytes", static_cast<long long>(_specificStats.spilledBytes));
+            bob.appendNumber("spillTimeMicros",
+                             static_cast<long long>(_specificStats.spillTimeMicros));
+        }
 
         BSONObjBuilder childrenBob(bob.subobjStart("orderBySlots"));
         for (size_t idx = 0; idx < _obs.size(); ++idx) {
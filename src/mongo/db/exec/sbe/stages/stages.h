@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "mongo/db/exec/sbe/stages/plan_stats.h"
 #include "mongo/db/exec/sbe/util/debug_print.h"
 #include "mongo/db/exec/sbe/values/slot.h"
@@ -37,6 +39,7 @@
 #include "mongo/db/exec/trial_run_tracker.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/plan_yield_policy.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -204,12 +207,19 @@ public:
      * Populates plan 'summary' object by walking through the entire PlanStage tree and for each
      * node whose plan node ID equals to the given 'nodeId', or if 'nodeId' is 'kEmptyPlanNodeId',
      * invoking 'accumulate(summary)' on the SpecificStats instance obtained by calling
-     * 'getSpecificStats()'.
+     * 'getSpecificStats()'. Stages that collected execution stats are also added to the summary's
+     * per stage execution summary.
      */
     void accumulate(PlanNodeId nodeId, PlanSummaryStats& summary) const {
-        if (auto stats = getSpecificStats();
-            stats && (nodeId == kEmptyPlanNodeId || _commonStats.nodeId == nodeId)) {
-            stats->accumulate(summary);
+        if (nodeId == kEmptyPlanNodeId || _commonStats.nodeId == nodeId) {
+            if (auto stats = getSpecificStats()) {
+                stats->accumulate(summary);
+            }
+            if (_commonStats.executionTimeNanos) {
+                summary.appendStageExecutionStats(_commonStats.stageType,
+                                                  *_commonStats.executionTimeNanos,
+                                                  _commonStats.peakTrackedMemBytes);
+            }
         }
 
         auto stage = static_cast<const T*>(this);
@@ -243,6 +253,9 @@ public:
     void markShouldCollectTimingInfo() {
         invariant(!_commonStats.executionTimeMillis || *_commonStats.executionTimeMillis == 0);
         _commonStats.executionTimeMillis.emplace(0);
+        if (internalQueryCollectStageExecutionStats.load()) {
+            _commonStats.executionTimeNanos.emplace(0);
+        }
 
         auto stage = static_cast<T*>(this);
         for (auto&& child : stage->_children) {
@@ -290,12 +303,25 @@ protected:
     boost::optional<ScopedTimer> getOptTimer(OperationContext* opCtx) {
         if (_commonStats.executionTimeMillis && opCtx) {
             return {{opCtx->getServiceContext()->getFastClockSource(),
-                     _commonStats.executionTimeMillis.get_ptr()}};
+                     _commonStats.executionTimeMillis.get_ptr(),
+                     opCtx->getServiceContext()->getTickSource(),
+                     _commonStats.executionTimeNanos.get_ptr()}};
         }
 
         return boost::none;
     }
 
+    /**
+     * Records 'bytes' as the amount of memory this stage currently holds, keeping the peak in the
+     * stage stats. Does nothing unless stage execution stats are being collected.
+     */
+    void trackMemoryUsage(uint64_t bytes) {
+        if (_commonStats.executionTimeNanos) {
+            _commonStats.peakTrackedMemBytes =
+                std::max(_commonStats.peakTrackedMemBytes.value_or(0), bytes);
+        }
+    }
+
     CommonStats _commonStats;
 
 private:
@@ -343,7 +369,7 @@ public:
     }
 
 protected:
-    PlanYieldPolicy* const _yieldPolicy{nullptr};
+    PlanYieldPolicy* _yieldPolicy{nullptr};
 
 private:
     static const int kInterruptCheckPeriod = 128;
@@ -405,6 +431,21 @@ public:
      */
     virtual void close() = 0;
 
+    /**
+     * Makes every stage of this tree which was configured to yield use 'yieldPolicy' instead of
+     * the policy it was built with. Stages with yielding disabled are left untouched. This is
+     * needed when a tree is cloned in order to be executed by a different operation.
+     */
+    void attachNewYieldPolicy(PlanYieldPolicy* yieldPolicy) {
+        for (auto&& child : _children) {
+            child->attachNewYieldPolicy(yieldPolicy);
+        }
+
+        if (_yieldPolicy) {
+            _yieldPolicy = yieldPolicy;
+        }
+    }
+
     virtual std::vector<DebugPrinter::Block> debugPrint() const {
         auto stats = getCommonStats();
         std::string str = str::stream() << '[' << stats->nodeId << "] " << stats->stageType;
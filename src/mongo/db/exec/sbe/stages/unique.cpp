@@ -76,7 +76,13 @@ PlanState UniqueStage::getNext() {
         ++_specificStats.dupsTested;
         auto [it, inserted] = _seen.emplace(std::move(key));
         if (inserted) {
-            const_cast<value::MaterializedRow&>(*it).makeOwned();
+            // The set outlives the current row, so the keys owned by the input slots can be moved
+            // into it rather than deep copied. The slots keep a view of them.
+            auto& ownedKey = const_cast<value::MaterializedRow&>(*it);
+            for (size_t keyIdx = 0; keyIdx < _inKeyAccessors.size(); ++keyIdx) {
+                auto [tag, val] = _inKeyAccessors[keyIdx]->copyOrMoveValue();
+                ownedKey.reset(keyIdx, true, tag, val);
+            }
             return trackPlanState(PlanState::ADVANCED);
         } else {
             // This row has been seen already, so we skip it.
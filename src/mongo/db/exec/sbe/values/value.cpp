@@ -31,6 +31,8 @@
 
 #include "mongo/db/exec/sbe/values/value.h"
 
+#include <string_view>
+
 #include "mongo/base/compare_numbers.h"
 #include "mongo/db/exec/js_function.h"
 #include "mongo/db/exec/sbe/values/bson.h"
@@ -148,11 +150,28 @@ void PcreRegex::_compile() {
     int eoffset;
     _pcrePtr = pcre_compile(_pattern.c_str(), pcreOptions, &compile_error, &eoffset, nullptr);
     uassert(5073402, str::stream() << "Invalid Regex: " << compile_error, _pcrePtr != nullptr);
+
+    // Studying fails only when out of memory, in which case the pattern is matched without it.
+    const char* studyError;
+    _pcreExtra = pcre_study(_pcrePtr, 0, &studyError);
+    _requiredLiteral = regex_util::getRequiredLiteral(_pattern, _options);
+}
+
+void PcreRegex::_free() {
+    pcre_free_study(_pcreExtra);
+    (*pcre_free)(_pcrePtr);
+    _pcreExtra = nullptr;
+    _pcrePtr = nullptr;
 }
 
 int PcreRegex::execute(StringData stringView, int startPos, std::vector<int>& buf) {
+    if (!_requiredLiteral.empty() && static_cast<size_t>(startPos) <= stringView.size() &&
+        std::string_view(stringView.rawData(), stringView.size())
+                .find(_requiredLiteral, startPos) == std::string_view::npos) {
+        return PCRE_ERROR_NOMATCH;
+    }
     return pcre_exec(_pcrePtr,
-                     nullptr,
+                     _pcreExtra,
                      stringView.rawData(),
                      stringView.size(),
                      startPos,
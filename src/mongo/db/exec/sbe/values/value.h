@@ -35,6 +35,7 @@
 #include <bitset>
 #include <boost/predef/hardware/simd.h>
 #include <cstdint>
+#include <memory>
 #include <ostream>
 #include <pcre.h>
 #include <string>
@@ -66,6 +67,8 @@ class TimeZoneDatabase;
 
 class JsFunction;
 
+class InListLookup;
+
 namespace sbe {
 using FrameId = int64_t;
 using SpoolId = int64_t;
@@ -582,7 +585,8 @@ public:
         : _values(0, ValueHash(collator), ValueEq(collator)) {}
 
     ArraySet(const ArraySet& other)
-        : _values(0, other._values.hash_function(), other._values.key_eq()) {
+        : _values(0, other._values.hash_function(), other._values.key_eq()),
+          _lookup(other._lookup) {
         reserve(other._values.size());
         for (const auto& p : other._values) {
             const auto copy = copyValue(p.first, p.second);
@@ -619,8 +623,22 @@ public:
         return _values.key_eq().getCollator();
     }
 
+    /**
+     * Attaches a lookup which tests membership in this set without hashing values, such as the one
+     * of the $in the set was built from. The lookup must hold exactly the values of the set.
+     */
+    void setLookup(std::shared_ptr<const InListLookup> lookup) {
+        _lookup = std::move(lookup);
+    }
+
+    const InListLookup* getLookup() const {
+        return _lookup.get();
+    }
+
 private:
     ValueSetType _values;
+
+    std::shared_ptr<const InListLookup> _lookup;
 };
 
 /**
@@ -639,7 +657,7 @@ public:
 
     PcreRegex& operator=(const PcreRegex& other) {
         if (this != &other) {
-            (*pcre_free)(_pcrePtr);
+            _free();
             _pattern = other._pattern;
             _options = other._options;
             _compile();
@@ -648,7 +666,7 @@ public:
     }
 
     ~PcreRegex() {
-        (*pcre_free)(_pcrePtr);
+        _free();
     }
 
     const std::string& pattern() const {
@@ -676,11 +694,19 @@ public:
 
 private:
     void _compile();
+    void _free();
 
     std::string _pattern;
     std::string _options;
 
     pcre* _pcrePtr = nullptr;
+
+    // Data from studying the compiled pattern, which speeds up unanchored matching.
+    pcre_extra* _pcreExtra = nullptr;
+
+    // A literal which every match contains, or empty if there is none. Inputs without it are
+    // rejected without running pcre_exec().
+    std::string _requiredLiteral;
 };
 
 constexpr size_t kSmallStringMaxLength = 7;
@@ -37,6 +37,7 @@
 #include <boost/algorithm/string.hpp>
 #include <pcre.h>
 
+#include "mongo/base/compare_numbers.h"
 #include "mongo/bson/oid.h"
 #include "mongo/db/client.h"
 #include "mongo/db/exec/js_function.h"
@@ -46,6 +47,7 @@
 #include "mongo/db/exec/sbe/vm/datetime.h"
 #include "mongo/db/hasher.h"
 #include "mongo/db/index/btree_key_generator.h"
+#include "mongo/db/matcher/in_list_lookup.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/datetime/date_time_support.h"
 #include "mongo/db/storage/key_string.h"
@@ -102,7 +104,9 @@ int Instruction::stackOffset[Instruction::Tags::lastInstruction] = {
     -2,  // collCmp3w
 
     -1,  // fillEmpty
+    0,   // fillEmptyImm
     -1,  // getField
+    0,   // getFieldImm
     -1,  // getElement
     -1,  // collComparisonKey
     -1,  // getFieldOrElement
@@ -336,10 +340,36 @@ void CodeFragment::appendSimpleInstruction(Instruction::Tags tag) {
     offset += writeToMemory(offset, i);
 }
 
+void CodeFragment::appendFillEmpty(Instruction::Constants k) {
+    Instruction i;
+    i.tag = Instruction::fillEmptyImm;
+    adjustStackSimple(i);
+
+    auto offset = allocateSpace(sizeof(Instruction) + sizeof(k));
+
+    offset += writeToMemory(offset, i);
+    offset += writeToMemory(offset, k);
+}
+
 void CodeFragment::appendGetField() {
     appendSimpleInstruction(Instruction::getField);
 }
 
+void CodeFragment::appendGetField(StringData fieldName) {
+    invariant(fieldName.size() <= Instruction::kMaxImmFieldNameSize);
+
+    Instruction i;
+    i.tag = Instruction::getFieldImm;
+    adjustStackSimple(i);
+
+    auto size = static_cast<uint8_t>(fieldName.size());
+    auto offset = allocateSpace(sizeof(Instruction) + sizeof(size) + size);
+
+    offset += writeToMemory(offset, i);
+    offset += writeToMemory(offset, size);
+    memcpy(offset, fieldName.rawData(), size);
+}
+
 void CodeFragment::appendGetElement() {
     appendSimpleInstruction(Instruction::getElement);
 }
@@ -510,8 +540,12 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::getField(value::TypeTa
         return {false, value::TypeTags::Nothing, 0};
     }
 
-    auto fieldStr = value::getStringView(fieldTag, fieldValue);
+    return getField(objTag, objValue, value::getStringView(fieldTag, fieldValue));
+}
 
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::getField(value::TypeTags objTag,
+                                                                   value::Value objValue,
+                                                                   StringData fieldStr) {
     if (MONGO_unlikely(failOnPoisonedFieldLookup.shouldFail())) {
         uassert(4623399, "Lookup of $POISON", fieldStr != "POISON");
     }
@@ -2314,6 +2348,36 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinConcat(ArityTyp
     return {true, strTag, strValue};
 }
 
+namespace {
+/**
+ * Looks up the value 'tag'/'val' in 'lookup'. Values of a type which has no direct equivalent in
+ * the lookup give InListLookup::Result::kUnknown.
+ */
+InListLookup::Result lookupValue(const InListLookup& lookup,
+                                 value::TypeTags tag,
+                                 value::Value val) {
+    switch (tag) {
+        case value::TypeTags::NumberInt32:
+            return lookup.lookupInt64(value::bitcastTo<int32_t>(val));
+        case value::TypeTags::NumberInt64:
+            return lookup.lookupInt64(value::bitcastTo<int64_t>(val));
+        case value::TypeTags::NumberDouble:
+            return lookup.lookupDouble(value::bitcastTo<double>(val));
+        case value::TypeTags::StringSmall:
+        case value::TypeTags::StringBig:
+        case value::TypeTags::bsonString:
+            return lookup.lookupString(value::getStringView(tag, val));
+        case value::TypeTags::ObjectId:
+            return lookup.lookupObjectId(
+                reinterpret_cast<const char*>(value::getObjectIdView(val)->data()));
+        case value::TypeTags::bsonObjectId:
+            return lookup.lookupObjectId(value::getRawPointerView(val));
+        default:
+            return InListLookup::Result::kUnknown;
+    }
+}
+}  // namespace
+
 std::pair<value::TypeTags, value::Value> ByteCode::genericIsMember(value::TypeTags lhsTag,
                                                                    value::Value lhsVal,
                                                                    value::TypeTags rhsTag,
@@ -2326,6 +2390,18 @@ std::pair<value::TypeTags, value::Value> ByteCode::genericIsMember(value::TypeTa
     if (rhsTag == value::TypeTags::ArraySet) {
         auto arrSet = value::getArraySetView(rhsVal);
 
+        // A lookup over values which do not depend on the collation applies with any collator.
+        auto lookup = arrSet->getLookup();
+        if (lookup &&
+            (!lookup->isCollationSensitive() ||
+             CollatorInterface::collatorsMatch(collator, arrSet->getCollator()))) {
+            auto result = lookupValue(*lookup, lhsTag, lhsVal);
+            if (result != InListLookup::Result::kUnknown) {
+                return {value::TypeTags::Boolean,
+                        value::bitcastFrom<bool>(result == InListLookup::Result::kMatch)};
+            }
+        }
+
         if (CollatorInterface::collatorsMatch(collator, arrSet->getCollator())) {
             auto& values = arrSet->values();
             return {value::TypeTags::Boolean,
@@ -3394,6 +3470,155 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinReverseArray(Ar
     }
 }
 
+namespace {
+/**
+ * Invokes 'fn' on every element of the block 'blockTag'/'blockVal' in order. The elements passed
+ * to 'fn' are views owned by the block.
+ */
+template <typename Fn>
+void forEachInBlock(value::TypeTags blockTag, value::Value blockVal, Fn&& fn) {
+    if (blockTag == value::TypeTags::Array) {
+        auto blockView = value::getArrayView(blockVal);
+        for (size_t i = 0; i < blockView->size(); ++i) {
+            auto [tag, val] = blockView->getAt(i);
+            fn(tag, val);
+        }
+    } else {
+        for (value::ArrayEnumerator enumerator{blockTag, blockVal}; !enumerator.atEnd();
+             enumerator.advance()) {
+            auto [tag, val] = enumerator.getViewOfValue();
+            fn(tag, val);
+        }
+    }
+}
+
+/**
+ * Returns true if every element of 'block' has the type 'tag'. Arrays of measurements are usually
+ * homogeneous, which allows the block builtins to skip the per element type dispatch.
+ */
+bool isHomogeneousBlock(const value::Array* block, value::TypeTags tag) {
+    for (size_t i = 0; i < block->size(); ++i) {
+        if (block->getAt(i).first != tag) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T, typename Cmp3w, typename Op>
+void compareHomogeneousBlock(
+    const value::Array* block, T rhs, value::Array* result, Cmp3w cmp3w, Op op) {
+    for (size_t i = 0; i < block->size(); ++i) {
+        auto cmp = op(cmp3w(value::bitcastTo<T>(block->getAt(i).second), rhs), 0);
+        result->push_back(value::TypeTags::Boolean, value::bitcastFrom<bool>(cmp));
+    }
+}
+
+template <typename T>
+int compareIntegral(T lhs, T rhs) {
+    return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+}
+}  // namespace
+
+template <typename Op>
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinBlockCompare(ArityType arity) {
+    invariant(arity == 2);
+    auto [blockOwned, blockTag, blockVal] = getFromStack(0);
+    auto [rhsOwned, rhsTag, rhsVal] = getFromStack(1);
+
+    if (!value::isArray(blockTag) || rhsTag == value::TypeTags::Nothing) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    auto [resultTag, resultVal] = value::makeNewArray();
+    value::ValueGuard resultGuard{resultTag, resultVal};
+    auto resultView = value::getArrayView(resultVal);
+
+    Op op{};
+    if (blockTag == value::TypeTags::Array) {
+        auto blockView = value::getArrayView(blockVal);
+        resultView->reserve(blockView->size());
+
+        if (isHomogeneousBlock(blockView, rhsTag)) {
+            switch (rhsTag) {
+                case value::TypeTags::NumberInt32:
+                    compareHomogeneousBlock(blockView,
+                                            value::bitcastTo<int32_t>(rhsVal),
+                                            resultView,
+                                            compareIntegral<int32_t>,
+                                            op);
+                    resultGuard.reset();
+                    return {true, resultTag, resultVal};
+                case value::TypeTags::NumberInt64:
+                case value::TypeTags::Date:
+                    compareHomogeneousBlock(blockView,
+                                            value::bitcastTo<int64_t>(rhsVal),
+                                            resultView,
+                                            compareIntegral<int64_t>,
+                                            op);
+                    resultGuard.reset();
+                    return {true, resultTag, resultVal};
+                case value::TypeTags::NumberDouble:
+                    // 'compareDoubles' orders NaN below every other number, as MQL does.
+                    compareHomogeneousBlock(blockView,
+                                            value::bitcastTo<double>(rhsVal),
+                                            resultView,
+                                            compareDoubles,
+                                            op);
+                    resultGuard.reset();
+                    return {true, resultTag, resultVal};
+                default:
+                    break;
+            }
+        }
+    }
+
+    forEachInBlock(blockTag, blockVal, [&](value::TypeTags tag, value::Value val) {
+        auto [cmpTag, cmpVal] = value::compareValue(tag, val, rhsTag, rhsVal);
+        invariant(cmpTag == value::TypeTags::NumberInt32);
+        auto cmp = op(value::bitcastTo<int32_t>(cmpVal), 0);
+        resultView->push_back(value::TypeTags::Boolean, value::bitcastFrom<bool>(cmp));
+    });
+
+    resultGuard.reset();
+    return {true, resultTag, resultVal};
+}
+
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinBlockFilter(ArityType arity) {
+    invariant(arity == 2);
+    auto [blockOwned, blockTag, blockVal] = getFromStack(0);
+    auto [maskOwned, maskTag, maskVal] = getFromStack(1);
+
+    if (!value::isArray(blockTag) || !value::isArray(maskTag)) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    // Materialize the mask first so that the block can be walked with a single enumerator
+    // regardless of its representation.
+    std::vector<bool> mask;
+    forEachInBlock(maskTag, maskVal, [&](value::TypeTags tag, value::Value val) {
+        mask.push_back(tag == value::TypeTags::Boolean && value::bitcastTo<bool>(val));
+    });
+
+    auto [resultTag, resultVal] = value::makeNewArray();
+    value::ValueGuard resultGuard{resultTag, resultVal};
+    auto resultView = value::getArrayView(resultVal);
+
+    size_t idx = 0;
+    forEachInBlock(blockTag, blockVal, [&](value::TypeTags tag, value::Value val) {
+        tassert(6100008, "blockFilter mask is shorter than the block", idx < mask.size());
+        if (mask[idx]) {
+            auto [copyTag, copyVal] = value::copyValue(tag, val);
+            resultView->push_back(copyTag, copyVal);
+        }
+        ++idx;
+    });
+    tassert(6100009, "blockFilter mask is longer than the block", idx == mask.size());
+
+    resultGuard.reset();
+    return {true, resultTag, resultVal};
+}
+
 std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinDateAdd(ArityType arity) {
     invariant(arity == 5);
 
@@ -3670,6 +3895,20 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::dispatchBuiltin(Builti
             return builtinTsSecond(arity);
         case Builtin::tsIncrement:
             return builtinTsIncrement(arity);
+        case Builtin::blockLt:
+            return builtinBlockCompare<std::less<>>(arity);
+        case Builtin::blockLte:
+            return builtinBlockCompare<std::less_equal<>>(arity);
+        case Builtin::blockGt:
+            return builtinBlockCompare<std::greater<>>(arity);
+        case Builtin::blockGte:
+            return builtinBlockCompare<std::greater_equal<>>(arity);
+        case Builtin::blockEq:
+            return builtinBlockCompare<std::equal_to<>>(arity);
+        case Builtin::blockNeq:
+            return builtinBlockCompare<std::not_equal_to<>>(arity);
+        case Builtin::blockFilter:
+            return builtinBlockFilter(arity);
     }
 
     MONGO_UNREACHABLE;
@@ -4241,6 +4480,30 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     }
                     break;
                 }
+                case Instruction::fillEmptyImm: {
+                    auto k = readFromMemory<Instruction::Constants>(pcPointer);
+                    pcPointer += sizeof(k);
+
+                    auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
+                    if (lhsTag == value::TypeTags::Nothing) {
+                        switch (k) {
+                            case Instruction::Null:
+                                topStack(false, value::TypeTags::Null, 0);
+                                break;
+                            case Instruction::True:
+                                topStack(false,
+                                         value::TypeTags::Boolean,
+                                         value::bitcastFrom<bool>(true));
+                                break;
+                            case Instruction::False:
+                                topStack(false,
+                                         value::TypeTags::Boolean,
+                                         value::bitcastFrom<bool>(false));
+                                break;
+                        }
+                    }
+                    break;
+                }
                 case Instruction::getField: {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
@@ -4258,6 +4521,23 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     }
                     break;
                 }
+                case Instruction::getFieldImm: {
+                    auto size = readFromMemory<uint8_t>(pcPointer);
+                    pcPointer += sizeof(size);
+                    StringData fieldName(reinterpret_cast<const char*>(pcPointer), size);
+                    pcPointer += size;
+
+                    auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
+
+                    auto [owned, tag, val] = getField(lhsTag, lhsVal, fieldName);
+
+                    topStack(owned, tag, val);
+
+                    if (lhsOwned) {
+                        value::releaseValue(lhsTag, lhsVal);
+                    }
+                    break;
+                }
                 case Instruction::getElement: {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -237,7 +238,9 @@ struct Instruction {
         collCmp3w,
 
         fillEmpty,
+        fillEmptyImm,  // fillEmpty with a constant from 'Constants' encoded in the instruction
         getField,
+        getFieldImm,  // getField with the field name encoded in the instruction
         getElement,
         collComparisonKey,
         getFieldOrElement,
@@ -284,6 +287,18 @@ struct Instruction {
         lastInstruction  // this is just a marker used to calculate number of instructions
     };
 
+    /**
+     * Constants that can be encoded directly in an instruction, see 'fillEmptyImm'.
+     */
+    enum Constants : uint8_t {
+        Null,
+        False,
+        True,
+    };
+
+    // The longest field name that 'getFieldImm' can encode in the instruction.
+    static constexpr size_t kMaxImmFieldNameSize = std::numeric_limits<uint8_t>::max();
+
     // Make sure that values in this arrays are always in-sync with the enum.
     static int stackOffset[];
 
@@ -377,6 +392,17 @@ enum class Builtin : uint8_t {
     generateSortKey,
     tsSecond,
     tsIncrement,
+
+    // Block builtins operate on an entire array of values ("block") at once. The comparisons
+    // return a block of booleans of the same size, using MQL comparison semantics, and
+    // 'blockFilter' keeps the elements whose entry in such a mask is true.
+    blockLt,
+    blockLte,
+    blockGt,
+    blockGte,
+    blockEq,
+    blockNeq,
+    blockFilter,
 };
 
 using SmallArityType = uint8_t;
@@ -462,7 +488,9 @@ public:
     void appendFillEmpty() {
         appendSimpleInstruction(Instruction::fillEmpty);
     }
+    void appendFillEmpty(Instruction::Constants k);
     void appendGetField();
+    void appendGetField(StringData fieldName);
     void appendGetElement();
     void appendCollComparisonKey();
     void appendGetFieldOrElement();
@@ -638,6 +666,9 @@ private:
                                                              value::Value objValue,
                                                              value::TypeTags fieldTag,
                                                              value::Value fieldValue);
+    std::tuple<bool, value::TypeTags, value::Value> getField(value::TypeTags objTag,
+                                                             value::Value objValue,
+                                                             StringData fieldStr);
 
     std::tuple<bool, value::TypeTags, value::Value> getElement(value::TypeTags objTag,
                                                                value::Value objValue,
@@ -836,6 +867,9 @@ private:
     std::tuple<bool, value::TypeTags, value::Value> builtinGenerateSortKey(ArityType arity);
     std::tuple<bool, value::TypeTags, value::Value> builtinTsSecond(ArityType arity);
     std::tuple<bool, value::TypeTags, value::Value> builtinTsIncrement(ArityType arity);
+    template <typename Op>
+    std::tuple<bool, value::TypeTags, value::Value> builtinBlockCompare(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinBlockFilter(ArityType arity);
 
     std::tuple<bool, value::TypeTags, value::Value> dispatchBuiltin(Builtin f, ArityType arity);
 
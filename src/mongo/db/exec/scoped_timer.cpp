@@ -34,12 +34,25 @@
 
 namespace mongo {
 
-ScopedTimer::ScopedTimer(ClockSource* cs, long long* counter)
-    : _clock(cs), _counter(counter), _start(cs->now()) {}
+ScopedTimer::ScopedTimer(ClockSource* cs,
+                         long long* counter,
+                         TickSource* tickSource,
+                         long long* nanosCounter)
+    : _clock(cs),
+      _counter(counter),
+      _start(cs->now()),
+      _tickSource(nanosCounter ? tickSource : nullptr),
+      _nanosCounter(nanosCounter),
+      _startTicks(_tickSource ? _tickSource->getTicks() : 0) {}
 
 ScopedTimer::~ScopedTimer() {
     long long elapsed = durationCount<Milliseconds>(_clock->now() - _start);
     *_counter += elapsed;
+
+    if (_tickSource) {
+        *_nanosCounter += durationCount<Nanoseconds>(
+            _tickSource->ticksTo<Nanoseconds>(_tickSource->getTicks() - _startTicks));
+    }
 }
 
 }  // namespace mongo
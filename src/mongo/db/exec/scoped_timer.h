@@ -30,6 +30,7 @@
 #pragma once
 
 
+#include "mongo/util/tick_source.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -39,6 +40,9 @@ class ClockSource;
 /**
  * This class increments a counter by a rough estimate of the time elapsed since its
  * construction when it goes out of scope.
+ *
+ * If a TickSource and a second counter are also given, the second counter is incremented by the
+ * elapsed time in nanoseconds as measured by the TickSource.
  */
 class ScopedTimer {
     ScopedTimer(const ScopedTimer&) = delete;
@@ -46,7 +50,10 @@ class ScopedTimer {
 
 public:
     ScopedTimer(ScopedTimer&& other) = default;
-    ScopedTimer(ClockSource* cs, long long* counter);
+    ScopedTimer(ClockSource* cs,
+                long long* counter,
+                TickSource* tickSource = nullptr,
+                long long* nanosCounter = nullptr);
 
     ~ScopedTimer();
 
@@ -57,6 +64,11 @@ private:
 
     // Time at which the timer was constructed.
     const Date_t _start;
+
+    // Optional high resolution source and the counter it increments with the elapsed nanoseconds.
+    TickSource* const _tickSource;
+    long long* _nanosCounter;
+    const TickSource::Tick _startTicks;
 };
 
 }  // namespace mongo
@@ -31,10 +31,18 @@
 
 #include "mongo/db/exec/shard_filterer_impl.h"
 
+#include <algorithm>
+
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/matcher/matchable.h"
 
 namespace mongo {
+namespace {
+
+// Number of lookups after which the ranges owned by the shard are flattened
+constexpr size_t kLookupsBeforeBuildingOwnedRanges = 128;
+
+}  // namespace
 
 std::unique_ptr<ShardFilterer> ShardFiltererImpl::clone() const {
     return std::make_unique<ShardFiltererImpl>(_collectionFilter);
@@ -46,6 +54,55 @@ ShardFiltererImpl::ShardFiltererImpl(ScopedCollectionFilter cf) : _collectionFil
     }
 }
 
+bool ShardFiltererImpl::keyBelongsToMe(const BSONObj& shardKey) const {
+    if (!_ownedRanges) {
+        if (++_numLookups <= kLookupsBeforeBuildingOwnedRanges) {
+            return _collectionFilter.keyBelongsToMe(shardKey);
+        }
+        _buildOwnedRanges();
+    }
+
+    if (_ownedRanges->empty() || shardKey.isEmpty()) {
+        return false;
+    }
+
+    const auto keyString = ShardKeyPattern::toKeyString(shardKey);
+    const auto contains = [&](size_t idx) {
+        const auto& range = (*_ownedRanges)[idx];
+        return range.first <= keyString && keyString < range.second;
+    };
+
+    if (contains(_lastRangeIdx)) {
+        return true;
+    }
+
+    // Find the first range which ends after the key, which is the only one which can contain it
+    const auto it = std::upper_bound(
+        _ownedRanges->begin(),
+        _ownedRanges->end(),
+        keyString,
+        [](const std::string& key, const auto& range) { return key < range.second; });
+    if (it == _ownedRanges->end()) {
+        return false;
+    }
+
+    const size_t idx = std::distance(_ownedRanges->begin(), it);
+    if (!contains(idx)) {
+        return false;
+    }
+
+    _lastRangeIdx = idx;
+    return true;
+}
+
+void ShardFiltererImpl::_buildOwnedRanges() const {
+    _ownedRanges.emplace();
+    for (const auto& range : _collectionFilter.getOwnedRanges()) {
+        _ownedRanges->emplace_back(ShardKeyPattern::toKeyString(range.getMin()),
+                                   ShardKeyPattern::toKeyString(range.getMax()));
+    }
+}
+
 ShardFilterer::DocumentBelongsResult ShardFiltererImpl::keyBelongsToMeHelper(
     const BSONObj& shardKey) const {
     if (shardKey.isEmpty()) {
@@ -29,6 +29,10 @@
 
 #pragma once
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "mongo/db/exec/shard_filterer.h"
 #include "mongo/db/matcher/matchable.h"
 #include "mongo/db/s/scoped_collection_metadata.h"
@@ -44,9 +48,7 @@ public:
     DocumentBelongsResult documentBelongsToMe(const BSONObj& doc) const override;
     DocumentBelongsResult documentBelongsToMe(const WorkingSetMember& wsm) const;
 
-    bool keyBelongsToMe(const BSONObj& shardKey) const override {
-        return _collectionFilter.keyBelongsToMe(shardKey);
-    };
+    bool keyBelongsToMe(const BSONObj& shardKey) const override;
 
     bool isCollectionSharded() const override {
         return _collectionFilter.isSharded();
@@ -57,7 +59,25 @@ public:
 private:
     DocumentBelongsResult keyBelongsToMeHelper(const BSONObj& doc) const;
 
+    /**
+     * Flattens the ranges owned by this shard into '_ownedRanges'.
+     */
+    void _buildOwnedRanges() const;
+
     ScopedCollectionFilter _collectionFilter;
     boost::optional<ShardKeyPattern> _keyPattern;
+
+    // Number of keys looked up through the collection filter, until there are enough of them to
+    // justify building '_ownedRanges'
+    mutable size_t _numLookups{0};
+
+    // The [min, max) ranges owned by this shard as KeyStrings, sorted and with contiguous chunks
+    // merged, so that a lookup is one binary search over plain strings instead of a routing table
+    // search. Built lazily since flattening costs as much as one lookup per owned chunk.
+    mutable boost::optional<std::vector<std::pair<std::string, std::string>>> _ownedRanges;
+
+    // Index in '_ownedRanges' of the range which contained the last key looked up. Keys usually
+    // arrive in shard key order when scanning the shard key index, so it is checked first.
+    mutable size_t _lastRangeIdx{0};
 };
 }  // namespace mongo
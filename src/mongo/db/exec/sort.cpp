@@ -79,6 +79,7 @@ PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
 }
 
 void SortStageDefault::loadingDone() {
+    trackMemoryUsage(_sortExecutor.peakMemoryUsageBytes());
     _sortExecutor.loadingDone();
     auto& metricsCollector = ResourceConsumption::MetricsCollector::get(expCtx()->opCtx);
     metricsCollector.incrementKeysSorted(_sortExecutor.stats().keysSorted);
@@ -86,6 +87,7 @@ void SortStageDefault::loadingDone() {
 }
 
 void SortStageSimple::loadingDone() {
+    trackMemoryUsage(_sortExecutor.peakMemoryUsageBytes());
     _sortExecutor.loadingDone();
     auto& metricsCollector = ResourceConsumption::MetricsCollector::get(expCtx()->opCtx);
     metricsCollector.incrementKeysSorted(_sortExecutor.stats().keysSorted);
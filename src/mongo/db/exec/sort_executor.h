@@ -29,9 +29,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/exec/sort_key_comparator.h"
+#include "mongo/db/exec/sort_key_encoder.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/query/sort_pattern.h"
@@ -47,6 +51,15 @@ namespace mongo {
  * The template parameter is the type of data being sorted. In DocumentSource execution, we sort
  * Document objects directly, but in the PlanStage layer we may sort WorkingSetMembers. The type of
  * the sort key, on the other hand, is always Value.
+ *
+ * As long as the data fits in memory, the executor sorts it itself rather than through a Sorter.
+ * Without a limit, each sort key is encoded once as a KeyString, and the data is ordered by memcmp
+ * of the encoded keys instead of field by field Value comparisons. With a limit, the best
+ * documents seen so far are kept in a binary heap of at most 'limit' entries, whose slots are
+ * reused as better documents replace worse ones; most documents are rejected after a single
+ * comparison against the worst kept one, so their keys are not worth encoding. Once the data
+ * outgrows the memory limit, or a sort key cannot be encoded, everything added so far is handed to
+ * a Sorter, which performs the rest of the sort.
  */
 template <typename T>
 class SortExecutor {
@@ -74,7 +87,9 @@ public:
                  bool allowDiskUse)
         : _sortPattern(std::move(sortPattern)),
           _tempDir(std::move(tempDir)),
-          _diskUseAllowed(allowDiskUse) {
+          _diskUseAllowed(allowDiskUse),
+          _encoder(_sortPattern),
+          _sortKeyComparator(_sortPattern) {
         _stats.sortPattern =
             _sortPattern.serialize(SortPattern::SortKeySerialization::kForExplain).toBson();
         _stats.limit = limit;
@@ -118,11 +133,41 @@ public:
         return _stats;
     }
 
+    /**
+     * Returns the largest amount of memory, in bytes, that the documents sorted in memory have
+     * held so far.
+     */
+    uint64_t peakMemoryUsageBytes() const {
+        return _peakMemUsed;
+    }
+
     /**
      * Add data item to be sorted of type T with sort key specified by Value to the sort executor.
      * Should only be called before 'loadingDone()' is called.
      */
     void add(const Value& sortKey, const T& data) {
+        if (_sortingInMemory) {
+            boost::optional<StringData> encodedKey;
+            if (hasLimit()) {
+                addToHeap(sortKey, data);
+            } else if ((encodedKey = _encoder.encode(sortKey))) {
+                addToBuffer(*encodedKey, sortKey, data);
+            }
+
+            // Past the memory limit, the Sorter decides whether to spill or to fail the sort.
+            if (hasLimit() || encodedKey) {
+                _peakMemUsed = std::max(_peakMemUsed, _memUsed);
+                if (_memUsed > _stats.maxMemoryUsageBytes) {
+                    transferToSorter();
+                }
+                return;
+            }
+
+            // The sort key cannot be encoded, so the rest of the sort compares the sort keys as
+            // Values.
+            transferToSorter();
+        }
+
         if (!_sorter) {
             _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
         }
@@ -133,14 +178,23 @@ public:
      * Signals to the sort executor that there will be no more input documents.
      */
     void loadingDone() {
+        if (_sortingInMemory) {
+            sortInMemory();
+            return;
+        }
+
         // This conditional should only pass if no documents were added to the sorter.
         if (!_sorter) {
             _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
         }
         _output.reset(_sorter->done());
-        _stats.keysSorted += _sorter->numSorted();
+        _stats.keysSorted += _keysSortedInMemory + _sorter->numSorted();
         _stats.spills += _sorter->numSpills();
-        _stats.totalDataSizeBytes += _sorter->totalDataSizeSorted();
+        _stats.totalDataSizeBytes += _dataSizeSortedInMemory + _sorter->totalDataSizeSorted();
+        if (auto fileStats = _sorter->fileStats()) {
+            _stats.spilledBytes += fileStats->bytesWritten.load();
+            _stats.spillTimeMicros += fileStats->spillMicros.load();
+        }
         _sorter.reset();
     }
 
@@ -153,6 +207,17 @@ public:
             return false;
         }
 
+        if (_sortingInMemory) {
+            if (_nextOutput == (hasLimit() ? _heap.size() : _order.size())) {
+                _order.clear();
+                _buffer.clear();
+                _heap.clear();
+                _isEOF = true;
+                return false;
+            }
+            return true;
+        }
+
         if (!_output->more()) {
             _output.reset();
             _isEOF = true;
@@ -168,10 +233,162 @@ public:
      * end-of-stream must be detected with 'hasNext()'.
      */
     std::pair<Value, T> getNext() {
+        if (_sortingInMemory && hasLimit()) {
+            auto& item = _heap[_nextOutput++];
+            return {std::move(item.sortKey), std::move(item.data)};
+        } else if (_sortingInMemory) {
+            auto& item = _buffer[_order[_nextOutput++].index];
+            return {std::move(item.sortKey), std::move(item.data)};
+        }
         return _output->next();
     }
 
 private:
+    // A document buffered by a sort without a limit. Its encoded sort key is stored in
+    // '_encodedKeys' at 'keyOffset'.
+    struct BufferedItem {
+        Value sortKey;
+        T data;
+        size_t keyOffset;
+        size_t keySize;
+    };
+
+    // The sort order of '_buffer' is computed over these entries rather than over the items
+    // themselves, so that most comparisons only read the inline key prefix.
+    struct OrderEntry {
+        uint64_t keyPrefix;
+        size_t index;
+    };
+
+    // A document kept by a sort with a limit. 'sequence' is the position of the document in the
+    // input, which breaks ties between equal sort keys in favour of the earlier document.
+    struct HeapItem {
+        Value sortKey;
+        T data;
+        uint64_t sequence;
+    };
+
+    bool heapLess(const HeapItem& lhs, const HeapItem& rhs) const {
+        const int cmp = _sortKeyComparator(lhs.sortKey, rhs.sortKey);
+        return cmp < 0 || (cmp == 0 && lhs.sequence < rhs.sequence);
+    }
+
+    static size_t dataSize(const Value& sortKey, const T& data) {
+        return sortKey.memUsageForSorter() + data.memUsageForSorter();
+    }
+
+    StringData bufferedKey(size_t index) const {
+        const auto& item = _buffer[index];
+        return {_encodedKeys.data() + item.keyOffset, item.keySize};
+    }
+
+    void addToBuffer(StringData encodedKey, const Value& sortKey, const T& data) {
+        const auto size = dataSize(sortKey, data);
+        _keysSortedInMemory += 1;
+        _dataSizeSortedInMemory += size;
+        _memUsed += size + encodedKey.size() + sizeof(OrderEntry);
+
+        _order.push_back({SortKeyEncoder::prefix(encodedKey), _buffer.size()});
+        _buffer.push_back(
+            {sortKey.getOwned(), data.getOwned(), _encodedKeys.size(), encodedKey.size()});
+        _encodedKeys.insert(_encodedKeys.end(), encodedKey.begin(), encodedKey.end());
+    }
+
+    void addToHeap(const Value& sortKey, const T& data) {
+        _keysSortedInMemory += 1;
+        const auto sequence = _nextSequence++;
+        auto less = [this](const HeapItem& lhs, const HeapItem& rhs) {
+            return heapLess(lhs, rhs);
+        };
+
+        if (_heap.size() < _stats.limit) {
+            const auto size = dataSize(sortKey, data);
+            _dataSizeSortedInMemory += size;
+            _memUsed += size;
+
+            _heap.push_back({sortKey.getOwned(), data.getOwned(), sequence});
+            std::push_heap(_heap.begin(), _heap.end(), less);
+            return;
+        }
+
+        // The front of the heap is the worst document kept so far. On a tie, the document already
+        // kept wins, since it came first.
+        if (_sortKeyComparator(sortKey, _heap.front().sortKey) >= 0) {
+            return;
+        }
+
+        // The new document takes over the slot of the worst one.
+        std::pop_heap(_heap.begin(), _heap.end(), less);
+        auto& slot = _heap.back();
+        _memUsed -= dataSize(slot.sortKey, slot.data);
+
+        const auto size = dataSize(sortKey, data);
+        _dataSizeSortedInMemory += size;
+        _memUsed += size;
+
+        slot.sortKey = sortKey.getOwned();
+        slot.data = data.getOwned();
+        slot.sequence = sequence;
+        std::push_heap(_heap.begin(), _heap.end(), less);
+    }
+
+    void sortInMemory() {
+        _stats.keysSorted += _keysSortedInMemory;
+        _stats.totalDataSizeBytes += _dataSizeSortedInMemory;
+
+        if (hasLimit()) {
+            std::sort_heap(_heap.begin(), _heap.end(), [this](const auto& lhs, const auto& rhs) {
+                return heapLess(lhs, rhs);
+            });
+            return;
+        }
+
+        // Ties are broken by input position, which keeps the sort stable.
+        std::sort(
+            _order.begin(), _order.end(), [this](const OrderEntry& lhs, const OrderEntry& rhs) {
+                if (lhs.keyPrefix != rhs.keyPrefix) {
+                    return lhs.keyPrefix < rhs.keyPrefix;
+                }
+                const int cmp = bufferedKey(lhs.index).compare(bufferedKey(rhs.index));
+                return cmp < 0 || (cmp == 0 && lhs.index < rhs.index);
+            });
+        std::vector<char>().swap(_encodedKeys);
+    }
+
+    /**
+     * Stops sorting in memory and adds the documents buffered so far to a Sorter, in their input
+     * order. The Sorter accounts for these documents in the stats from then on, while the counts
+     * kept for the in-memory sort still cover the documents a top-k heap has discarded.
+     */
+    void transferToSorter() {
+        _sortingInMemory = false;
+        _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
+
+        auto transfer = [&](Value& sortKey, T& data) {
+            _keysSortedInMemory -= 1;
+            _dataSizeSortedInMemory -= dataSize(sortKey, data);
+            _sorter->emplace(std::move(sortKey), std::move(data));
+        };
+        if (hasLimit()) {
+            std::sort(_heap.begin(), _heap.end(), [](const HeapItem& lhs, const HeapItem& rhs) {
+                return lhs.sequence < rhs.sequence;
+            });
+            for (auto&& item : _heap) {
+                transfer(item.sortKey, item.data);
+            }
+        } else {
+            for (auto&& item : _buffer) {
+                transfer(item.sortKey, item.data);
+            }
+        }
+
+        std::vector<BufferedItem>().swap(_buffer);
+        std::vector<OrderEntry>().swap(_order);
+        std::vector<char>().swap(_encodedKeys);
+        std::vector<HeapItem>().swap(_heap);
+        _memUsed = 0;
+    }
+
     SortOptions makeSortOptions() const {
         SortOptions opts;
         if (_stats.limit) {
@@ -182,6 +399,7 @@ private:
         if (_diskUseAllowed) {
             opts.extSortAllowed = true;
             opts.tempDir = _tempDir;
+            opts.asyncSpillWrites = true;
         }
 
         return opts;
@@ -191,6 +409,34 @@ private:
     const std::string _tempDir;
     const bool _diskUseAllowed;
 
+    SortKeyEncoder _encoder;
+    const SortKeyComparator _sortKeyComparator;
+
+    // Whether the documents are sorted by the executor itself rather than by a Sorter.
+    bool _sortingInMemory = true;
+
+    // Approximate memory used by the documents sorted in memory, and its largest value so far.
+    size_t _memUsed = 0;
+    size_t _peakMemUsed = 0;
+
+    // Stats of the in-memory sort, which are added to '_stats' once loading is done.
+    uint64_t _keysSortedInMemory = 0;
+    uint64_t _dataSizeSortedInMemory = 0;
+
+    // Documents of a sort without a limit, in input order, along with their sort order and the
+    // concatenation of their encoded sort keys.
+    std::vector<BufferedItem> _buffer;
+    std::vector<OrderEntry> _order;
+    std::vector<char> _encodedKeys;
+
+    // Documents kept by a sort with a limit. A binary heap with the worst document at the front
+    // while loading, and sorted once loading is done.
+    std::vector<HeapItem> _heap;
+    uint64_t _nextSequence = 0;
+
+    // Position of the next document to return out of the in-memory sort order.
+    size_t _nextOutput = 0;
+
     std::unique_ptr<DocumentSorter> _sorter;
     std::unique_ptr<typename DocumentSorter::Iterator> _output;
 
@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sort_key_encoder.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "mongo/base/data_view.h"
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+
+SortKeyEncoder::SortKeyEncoder(const SortPattern& sortPattern)
+    : _numComponents(sortPattern.size()), _keyString(KeyString::Version::V1) {
+    if (_numComponents == 0 || _numComponents > Ordering::kMaxCompoundIndexKeys)
+        return;
+
+    BSONObjBuilder directions;
+    for (auto&& part : sortPattern) {
+        directions.append(""_sd, part.isAscending ? 1 : -1);
+    }
+    _ordering = Ordering::make(directions.obj());
+}
+
+boost::optional<StringData> SortKeyEncoder::encode(const Value& sortKey) {
+    if (!canEncode())
+        return boost::none;
+
+    _keyString.resetToEmpty(*_ordering);
+    if (_numComponents == 1) {
+        if (!_appendComponent(sortKey))
+            return boost::none;
+    } else {
+        // A compound sort key is an array with one element per component of the sort pattern.
+        if (!sortKey.isArray() || sortKey.getArrayLength() != _numComponents)
+            return boost::none;
+        for (auto&& component : sortKey.getArray()) {
+            if (!_appendComponent(component))
+                return boost::none;
+        }
+    }
+
+    // The end byte keeps memcmp order correct for descending components, when the encoding of one
+    // key is a prefix of the encoding of another, such as for strings with embedded null bytes.
+    _keyString.appendDiscriminator(KeyString::Discriminator::kInclusive);
+    return StringData(_keyString.getBuffer(), _keyString.getSize());
+}
+
+bool SortKeyEncoder::_appendComponent(const Value& component) {
+    // Numbers are encoded by value, so an int can be appended the same way as a long.
+    switch (component.getType()) {
+        case EOO:
+            return false;
+        case jstNULL:
+            _keyString.appendNull();
+            return true;
+        case NumberInt:
+            _keyString.appendNumberLong(component.getInt());
+            return true;
+        case NumberLong:
+            _keyString.appendNumberLong(component.getLong());
+            return true;
+        case NumberDouble:
+            _keyString.appendNumberDouble(component.getDouble());
+            return true;
+        case String:
+            _keyString.appendString(component.getStringData());
+            return true;
+        default:
+            break;
+    }
+
+    // Other types are serialized to BSON first, in a buffer which is reused for every component.
+    _bsonBuffer.reset();
+    BSONObjBuilder bob(_bsonBuffer);
+    component.addToBsonObj(&bob, ""_sd);
+    _keyString.appendBSONElement(bob.done().firstElement());
+    return true;
+}
+
+uint64_t SortKeyEncoder::prefix(StringData encodedKey) {
+    char bytes[sizeof(uint64_t)] = {};
+    std::memcpy(bytes, encodedKey.rawData(), std::min(encodedKey.size(), sizeof(bytes)));
+    return ConstDataView(bytes).read<BigEndian<uint64_t>>();
+}
+
+}  // namespace mongo
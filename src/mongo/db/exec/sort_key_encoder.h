@@ -0,0 +1,93 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <cstdint>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/ordering.h"
+#include "mongo/bson/util/builder.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/query/sort_pattern.h"
+#include "mongo/db/storage/key_string.h"
+
+namespace mongo {
+
+/**
+ * Encodes sort keys as KeyStrings, whose bytes compare with memcmp in the same order as a
+ * SortKeyComparator for the same sort pattern orders the sort keys themselves. The string
+ * components of a sort key are already collation comparison keys, so the encoding does not need a
+ * collator.
+ *
+ * Not thread safe: every call to encode() reuses the same buffers.
+ */
+class SortKeyEncoder {
+public:
+    explicit SortKeyEncoder(const SortPattern& sortPattern);
+
+    /**
+     * Returns whether sort keys can be encoded for the sort pattern. This is false when the pattern
+     * has more components than a KeyString Ordering can describe.
+     */
+    bool canEncode() const {
+        return _ordering.has_value();
+    }
+
+    /**
+     * Encodes 'sortKey' and returns a view of the encoding which stays valid until the next call.
+     * Returns boost::none if the key cannot be encoded, because a component of it is missing or
+     * because the sort pattern cannot be encoded.
+     */
+    boost::optional<StringData> encode(const Value& sortKey);
+
+    /**
+     * Returns the first eight bytes of 'encodedKey' as a big-endian integer, padded with zero
+     * bytes. When the prefixes of two encoded keys differ, the keys compare in the same order as
+     * their prefixes.
+     */
+    static uint64_t prefix(StringData encodedKey);
+
+private:
+    // Appends one component of a sort key to '_keyString'. Returns false if it is missing.
+    bool _appendComponent(const Value& component);
+
+    const size_t _numComponents;
+
+    // Direction of each component of the sort pattern. Not set if the pattern cannot be encoded.
+    boost::optional<Ordering> _ordering;
+
+    // Holds the BSON form of a sort key component which is not appended to '_keyString' directly.
+    BufBuilder _bsonBuffer;
+
+    KeyString::Builder _keyString;
+};
+
+}  // namespace mongo
@@ -0,0 +1,177 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <limits>
+#include <vector>
+
+#include "mongo/bson/oid.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/sort_key_comparator.h"
+#include "mongo/db/exec/sort_key_encoder.h"
+#include "mongo/platform/decimal128.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+SortPattern makeSortPattern(const std::vector<bool>& ascending) {
+    std::vector<SortPattern::SortPatternPart> parts;
+    for (size_t i = 0; i < ascending.size(); ++i) {
+        SortPattern::SortPatternPart part;
+        part.isAscending = ascending[i];
+        part.fieldPath = FieldPath("f" + std::to_string(i));
+        parts.push_back(std::move(part));
+    }
+    return SortPattern(std::move(parts));
+}
+
+int sign(int cmp) {
+    return cmp < 0 ? -1 : (cmp > 0 ? 1 : 0);
+}
+
+/**
+ * Values of many types, in no particular order, including values which compare equal across
+ * numeric types.
+ */
+std::vector<Value> makeSortKeyComponents() {
+    return {Value(MINKEY),
+            Value(BSONNULL),
+            Value(1),
+            Value(1LL),
+            Value(1.0),
+            Value(-0.0),
+            Value(0),
+            Value(2.5),
+            Value(-7),
+            Value(std::numeric_limits<double>::quiet_NaN()),
+            Value(std::numeric_limits<double>::infinity()),
+            Value(Decimal128("2.5")),
+            Value(9007199254740993LL),
+            Value(9007199254740992.0),
+            Value(""_sd),
+            Value("a"_sd),
+            Value("ab"_sd),
+            Value(StringData("a\0b", 3)),
+            Value("b"_sd),
+            Value(Document{{"a", 1}}),
+            Value(Document{{"a", 1}, {"b", 2}}),
+            Value(Document{{"b", 1}}),
+            Value(Document{{"a", "x"_sd}}),
+            Value(std::vector<Value>{}),
+            Value(std::vector<Value>{Value(1), Value(2)}),
+            Value(std::vector<Value>{Value(1)}),
+            Value(OID("000000000000000000000001")),
+            Value(OID("000000000000000000000002")),
+            Value(false),
+            Value(true),
+            Value(Date_t::fromMillisSinceEpoch(-1)),
+            Value(Date_t::fromMillisSinceEpoch(1000)),
+            Value(Timestamp(1, 1)),
+            Value(MAXKEY)};
+}
+
+void assertEncodingOrdersLikeComparator(const std::vector<bool>& ascending,
+                                        const std::vector<Value>& sortKeys) {
+    const auto sortPattern = makeSortPattern(ascending);
+    SortKeyEncoder encoder(sortPattern);
+    ASSERT(encoder.canEncode());
+    SortKeyComparator comparator(sortPattern);
+
+    std::vector<std::string> encodedKeys;
+    for (auto&& sortKey : sortKeys) {
+        auto encodedKey = encoder.encode(sortKey);
+        ASSERT(encodedKey);
+        encodedKeys.push_back(encodedKey->toString());
+    }
+
+    for (size_t i = 0; i < sortKeys.size(); ++i) {
+        for (size_t j = 0; j < sortKeys.size(); ++j) {
+            const StringData lhs(encodedKeys[i]);
+            const StringData rhs(encodedKeys[j]);
+            ASSERT_EQ(sign(comparator(sortKeys[i], sortKeys[j])), sign(lhs.compare(rhs)))
+                << sortKeys[i].toString() << " vs " << sortKeys[j].toString();
+
+            const auto lhsPrefix = SortKeyEncoder::prefix(lhs);
+            const auto rhsPrefix = SortKeyEncoder::prefix(rhs);
+            if (lhsPrefix != rhsPrefix) {
+                ASSERT_EQ(lhsPrefix < rhsPrefix, lhs.compare(rhs) < 0);
+            }
+        }
+    }
+}
+
+TEST(SortKeyEncoderTest, SingleComponentEncodingOrdersLikeComparator) {
+    const auto sortKeys = makeSortKeyComponents();
+    assertEncodingOrdersLikeComparator({true}, sortKeys);
+    assertEncodingOrdersLikeComparator({false}, sortKeys);
+}
+
+TEST(SortKeyEncoderTest, CompoundEncodingOrdersLikeComparator) {
+    const auto components = makeSortKeyComponents();
+    std::vector<Value> sortKeys;
+    for (size_t i = 0; i < components.size(); i += 3) {
+        for (size_t j = 0; j < components.size(); j += 4) {
+            sortKeys.push_back(Value(std::vector<Value>{components[i], components[j]}));
+        }
+    }
+    assertEncodingOrdersLikeComparator({true, true}, sortKeys);
+    assertEncodingOrdersLikeComparator({true, false}, sortKeys);
+    assertEncodingOrdersLikeComparator({false, true}, sortKeys);
+}
+
+TEST(SortKeyEncoderTest, MissingComponentsAreNotEncoded) {
+    SortKeyEncoder single(makeSortPattern({true}));
+    ASSERT_FALSE(single.encode(Value()));
+
+    SortKeyEncoder compound(makeSortPattern({true, false}));
+    ASSERT_FALSE(compound.encode(Value(std::vector<Value>{Value(1), Value()})));
+    ASSERT_FALSE(compound.encode(Value(std::vector<Value>{Value(1)})));
+    ASSERT_FALSE(compound.encode(Value(1)));
+    ASSERT(compound.encode(Value(std::vector<Value>{Value(1), Value(BSONNULL)})));
+}
+
+TEST(SortKeyEncoderTest, PatternWithTooManyComponentsCannotBeEncoded) {
+    const size_t maxComponents = Ordering::kMaxCompoundIndexKeys;
+    ASSERT(SortKeyEncoder(makeSortPattern(std::vector<bool>(maxComponents, false))).canEncode());
+    ASSERT_FALSE(
+        SortKeyEncoder(makeSortPattern(std::vector<bool>(maxComponents + 1, true))).canEncode());
+}
+
+TEST(SortKeyEncoderTest, EncodingIsValidUntilNextCall) {
+    SortKeyEncoder encoder(makeSortPattern({true}));
+    const auto first = encoder.encode(Value("first"_sd))->toString();
+    const auto second = encoder.encode(Value("second"_sd))->toString();
+    ASSERT_NE(first, second);
+    ASSERT_EQ(first, encoder.encode(Value("first"_sd))->toString());
+}
+
+}  // namespace
+}  // namespace mongo
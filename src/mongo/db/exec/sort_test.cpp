@@ -304,4 +304,69 @@ TEST_F(SortStageDefaultTest, SortDescendingWithCollation) {
              "{input: [{a: 'ba'}, {a: 'aa'}, {a: 'ab'}]}",
              "{output: [{a: 'ab'}, {a: 'ba'}, {a: 'aa'}]}");
 }
+
+TEST_F(SortStageDefaultTest, SortCompoundWithMixedDirectionsAndTypes) {
+    testWork("{a: 1, b: -1}",
+             nullptr,
+             0,
+             "{input: [{a: 'x', b: 1}, {a: 2, b: 'y'}, {a: 2.0, b: 3}, {a: null, b: 1}, {b: 2},"
+             " {a: 'x', b: 'x\\u0000'}, {a: 'x', b: 'x'}]}",
+             "{output: [{b: 2}, {a: null, b: 1}, {a: 2, b: 'y'}, {a: 2.0, b: 3},"
+             " {a: 'x', b: 'x\\u0000'}, {a: 'x', b: 'x'}, {a: 'x', b: 1}]}");
+}
+
+TEST_F(SortStageDefaultTest, SortKeepsInputOrderOfEqualKeys) {
+    testWork("{a: 1}",
+             nullptr,
+             0,
+             "{input: [{a: 1, b: 1}, {a: 0, b: 2}, {a: 1.0, b: 3}, {a: 1, b: 4}]}",
+             "{output: [{a: 0, b: 2}, {a: 1, b: 1}, {a: 1.0, b: 3}, {a: 1, b: 4}]}");
+    testWork("{a: -1}",
+             nullptr,
+             2,
+             "{input: [{a: 1, b: 1}, {a: 0, b: 2}, {a: 1.0, b: 3}, {a: 1, b: 4}]}",
+             "{output: [{a: 1, b: 1}, {a: 1.0, b: 3}]}");
+}
+
+TEST_F(SortStageDefaultTest, SortManyDocumentsWithAndWithoutLimit) {
+    // The sort keys cycle through a set of values which are not in order, so that the top-k heap
+    // replaces documents it has already kept.
+    str::stream input;
+    input << "{input: [";
+    for (int i = 0; i < 1000; ++i) {
+        input << (i ? ", " : "") << "{a: " << (i * 7919) % 1000 << "}";
+    }
+    input << "]}";
+
+    str::stream allOutput;
+    str::stream limitOutput;
+    allOutput << "{output: [";
+    limitOutput << "{output: [";
+    for (int i = 999; i >= 0; --i) {
+        allOutput << (i != 999 ? ", " : "") << "{a: " << i << "}";
+        if (i >= 990) {
+            limitOutput << (i != 999 ? ", " : "") << "{a: " << i << "}";
+        }
+    }
+    allOutput << "]}";
+    limitOutput << "]}";
+
+    testWork("{a: -1}", nullptr, 0, std::string(input).c_str(), std::string(allOutput).c_str());
+    testWork("{a: -1}", nullptr, 10, std::string(input).c_str(), std::string(limitOutput).c_str());
+}
+
+TEST_F(SortStageDefaultTest, SortExceedingMemoryLimitWithoutDiskUseFails) {
+    // Each document is about 10KB, so that the documents outgrow the memory limit of the stage.
+    const std::string padding(10 * 1024, 'x');
+    str::stream input;
+    input << "{input: [";
+    for (int i = 0; i < 200; ++i) {
+        input << (i ? ", " : "") << "{a: " << i << ", padding: '" << padding << "'}";
+    }
+    input << "]}";
+
+    ASSERT_THROWS_CODE(testWork("{a: 1}", nullptr, 0, std::string(input).c_str(), "{output: []}"),
+                       DBException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
 }  // namespace
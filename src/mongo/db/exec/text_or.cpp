@@ -61,8 +61,7 @@ TextOrStage::TextOrStage(ExpressionContext* expCtx,
       _keyPrefixSize(keyPrefixSize),
       _ws(ws),
       _scoreIterator(_scores.end()),
-      _filter(filter),
-      _idRetrying(WorkingSet::INVALID_ID) {}
+      _filter(filter) {}
 
 void TextOrStage::addChild(unique_ptr<PlanStage> child) {
     _children.push_back(std::move(child));
@@ -170,19 +169,11 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
     }
     invariant(_currentChild < _children.size());
 
-    // Either retry the last WSM we worked on or get a new one from our current child.
     WorkingSetID id;
-    StageState childState;
-    if (_idRetrying == WorkingSet::INVALID_ID) {
-        childState = _children[_currentChild]->work(&id);
-    } else {
-        childState = ADVANCED;
-        id = _idRetrying;
-        _idRetrying = WorkingSet::INVALID_ID;
-    }
+    StageState childState = _children[_currentChild]->work(&id);
 
     if (PlanStage::ADVANCED == childState) {
-        return addTerm(id, out);
+        return addTerm(id);
     } else if (PlanStage::IS_EOF == childState) {
         // Done with this child.
         ++_currentChild;
@@ -211,76 +202,74 @@ PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
     }
 
     // Retrieve the record that contains the text score.
-    TextRecordData textRecordData = _scoreIterator->second;
-    ++_scoreIterator;
+    const auto& textRecordData = _scoreIterator->second;
 
     // Ignore non-matched documents.
     if (textRecordData.score < 0) {
-        invariant(textRecordData.wsid == WorkingSet::INVALID_ID);
+        invariant(!textRecordData.keyDatum);
+        ++_scoreIterator;
         return PlanStage::NEED_TIME;
     }
 
-    WorkingSetMember* wsm = _ws->get(textRecordData.wsid);
+    // Our parent expects RID_AND_OBJ members, so we fetch the document now. Fetching checks that
+    // the document still generates the index key it was found with, in case we yielded since.
+    WorkingSetID wsid = _ws->allocate();
+    WorkingSetMember* wsm = _ws->get(wsid);
+    wsm->recordId = _scoreIterator->first;
+    wsm->keyData.push_back(*textRecordData.keyDatum);
+    _ws->transitionToRecordIdAndIdx(wsid);
+    try {
+        if (!WorkingSetCommon::fetch(
+                opCtx(), _ws, wsid, _recordCursor.get(), collection(), collection()->ns())) {
+            _ws->free(wsid);
+            ++_scoreIterator;
+            return PlanStage::NEED_TIME;
+        }
+        ++_specificStats.fetches;
+    } catch (const WriteConflictException&) {
+        // Leave '_scoreIterator' in place so that this document is fetched again after the yield.
+        _ws->free(wsid);
+        *out = WorkingSet::INVALID_ID;
+        return PlanStage::NEED_YIELD;
+    }
 
     // Populate the working set member with the text score metadata and return it.
     wsm->metadata().setTextScore(textRecordData.score);
-    *out = textRecordData.wsid;
+    ++_scoreIterator;
+    *out = wsid;
     return PlanStage::ADVANCED;
 }
 
-PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out) {
+PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid) {
     WorkingSetMember* wsm = _ws->get(wsid);
     invariant(wsm->getState() == WorkingSetMember::RID_AND_IDX);
     invariant(1 == wsm->keyData.size());
     const IndexKeyDatum newKeyData = wsm->keyData.back();  // copy to keep it around.
     TextRecordData* textRecordData = &_scores[wsm->recordId];
 
+    // We only need the index key to score the document, since the document is fetched when it
+    // is returned.
+    _ws->free(wsid);
+
     if (textRecordData->score < 0) {
         // We have already rejected this document for not matching the filter.
-        invariant(WorkingSet::INVALID_ID == textRecordData->wsid);
-        _ws->free(wsid);
+        invariant(!textRecordData->keyDatum);
         return NEED_TIME;
     }
 
-    if (WorkingSet::INVALID_ID == textRecordData->wsid) {
+    if (!textRecordData->keyDatum) {
         // We haven't seen this RecordId before.
         invariant(textRecordData->score == 0);
 
         if (!Filter::passes(newKeyData.keyData, newKeyData.indexKeyPattern, _filter)) {
-            _ws->free(wsid);
             textRecordData->score = -1;
             return NEED_TIME;
         }
 
-        // Our parent expects RID_AND_OBJ members, so we fetch the document here if we haven't
-        // already.
-        try {
-            if (!WorkingSetCommon::fetch(
-                    opCtx(), _ws, wsid, _recordCursor.get(), collection(), collection()->ns())) {
-                _ws->free(wsid);
-                textRecordData->score = -1;
-                return NEED_TIME;
-            }
-            ++_specificStats.fetches;
-        } catch (const WriteConflictException&) {
-            wsm->makeObjOwnedIfNeeded();
-            _idRetrying = wsid;
-            *out = WorkingSet::INVALID_ID;
-            return NEED_YIELD;
-        }
-
-        textRecordData->wsid = wsid;
-
-        // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
-        wsm->makeObjOwnedIfNeeded();
-    } else {
-        // We already have a working set member for this RecordId. Free the new WSM and retrieve the
-        // old one. Note that since we don't keep all index keys, we could get a score that doesn't
-        // match the document, but this has always been a problem.
-        // TODO something to improve the situation.
-        invariant(wsid != textRecordData->wsid);
-        _ws->free(wsid);
-        wsm = _ws->get(textRecordData->wsid);
+        // Keep the key so that the fetch can check the document still matches it. Note that since
+        // we don't keep all index keys, we could get a score that doesn't match the document, but
+        // this has always been a problem.
+        textRecordData->keyDatum = newKeyData;
     }
 
     // Locate score within possibly compound key: {prefix,term,score,suffix}.
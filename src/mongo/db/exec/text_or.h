@@ -116,10 +116,11 @@ private:
      * Helper called from readFromChildren to update aggregate score with a newfound (term, score)
      * pair for this document.
      */
-    StageState addTerm(WorkingSetID wsid, WorkingSetID* out);
+    StageState addTerm(WorkingSetID wsid);
 
     /**
-     * Worker for kReturningResults. Returns a wsm with RecordID and Score.
+     * Worker for kReturningResults. Fetches the next scored document and returns a wsm with its
+     * RecordID, document and Score.
      */
     StageState returnResults(WorkingSetID* out);
 
@@ -137,12 +138,14 @@ private:
 
     /**
      *  Temporary score data filled out by children.
-     *  Maps from RecordID -> (aggregate score for doc, wsid).
-     *  Map each buffered record id to this data.
+     *  Maps from RecordID -> (aggregate score for doc, first index key seen for doc).
+     *  Map each buffered record id to this data. The documents themselves are only fetched once
+     *  they are returned, so that the stage does not hold on to every matching document while it
+     *  reads the terms.
      */
     struct TextRecordData {
-        TextRecordData() : wsid(WorkingSet::INVALID_ID), score(0.0) {}
-        WorkingSetID wsid;
+        TextRecordData() : score(0.0) {}
+        boost::optional<IndexKeyDatum> keyDatum;
         double score;
     };
 
@@ -154,7 +157,6 @@ private:
 
     // Members needed only for using the TextMatchableDocument.
     const MatchExpression* _filter;
-    WorkingSetID _idRetrying;
     std::unique_ptr<SeekableRecordCursor> _recordCursor;
 };
 }  // namespace mongo
@@ -86,11 +86,17 @@ void WorkingSet::free(WorkingSetID i) {
 }
 
 void WorkingSet::clear() {
-    _data.clear();
-
-    // Since working set is now empty, the free list pointer should
-    // point to nothing.
+    // Rebuild the free list over every member, in increasing id order so that the members are
+    // handed out again from the start of '_data'.
     _freeList = INVALID_ID;
+    for (WorkingSetID i = _data.size(); i-- > 0;) {
+        MemberHolder& holder = _data[i];
+        if (holder.nextFreeOrSelf == i) {
+            holder.member.clear();
+        }
+        holder.nextFreeOrSelf = _freeList;
+        _freeList = i;
+    }
 }
 
 void WorkingSet::transitionToRecordIdAndIdx(WorkingSetID id) {
@@ -127,6 +133,13 @@ WorkingSetID WorkingSet::emplace(WorkingSetMember&& wsm) {
 
 void WorkingSetMember::clear() {
     _metadata = DocumentMetadataFields{};
+    if (!keyData.empty() && keyData.back().keyData.isOwned()) {
+        // Keep the buffer of the last index key if this member was its only user.
+        auto buffer = keyData.back().keyData.releaseSharedBuffer();
+        if (!buffer.isShared()) {
+            _indexKeyBuffer = std::move(buffer).constCast();
+        }
+    }
     keyData.clear();
     if (doc.value().hasExclusivelyOwnedStorage()) {
         // Reset the document to point to an empty BSON, which will preserve its underlying
@@ -217,6 +230,19 @@ void WorkingSetMember::resetDocument(SnapshotId snapshot, const BSONObj& obj) {
     doc.value() = md.freeze();
 }
 
+BSONObj WorkingSetMember::makeIndexKeyOwned(const BSONObj& key) {
+    if (key.isOwned()) {
+        return key;
+    }
+
+    const size_t size = key.objsize();
+    if (!_indexKeyBuffer || _indexKeyBuffer.capacity() < size) {
+        _indexKeyBuffer = SharedBuffer::allocate(size);
+    }
+    memcpy(_indexKeyBuffer.get(), key.objdata(), size);
+    return BSONObj(std::move(_indexKeyBuffer));
+}
+
 void WorkingSetMember::serialize(BufBuilder& buf) const {
     // It is not legal to serialize a Document which has metadata attached to it. Any metadata must
     // reside directly in the WorkingSetMember.
@@ -222,6 +222,14 @@ public:
      */
     void resetDocument(SnapshotId snapshot, const BSONObj& obj);
 
+    /**
+     * Returns an owned version of 'key', an index key about to be added to 'keyData'. If 'key' is
+     * unowned, it is copied into the buffer of an index key which this member held before it was
+     * last cleared, as long as nothing else refers to that buffer. This avoids an allocation per
+     * index key for the members which a WorkingSet hands out again and again.
+     */
+    BSONObj makeIndexKeyOwned(const BSONObj& key);
+
     void serialize(BufBuilder& buf) const;
 
 private:
@@ -230,6 +238,9 @@ private:
     MemberState _state = WorkingSetMember::INVALID;
 
     DocumentMetadataFields _metadata;
+
+    // The buffer of an index key released by clear(), for reuse by makeIndexKeyOwned().
+    SharedBuffer _indexKeyBuffer;
 };
 
 /**
@@ -345,7 +356,9 @@ public:
     void free(WorkingSetID i);
 
     /**
-     * Removes and deallocates all members of this working set.
+     * Frees all members of this working set at once. The members are cleared and put back on the
+     * free list rather than destroyed, so the storage they hold on to is reused by the members
+     * allocated after the reset.
      */
     void clear();
 
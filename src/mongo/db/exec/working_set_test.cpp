@@ -330,4 +330,62 @@ TEST_F(WorkingSetFixture, WsmCanBeExtractedAndReinserted) {
     ASSERT_FALSE(emplacedWsm->metadata());
 }
 
+TEST_F(WorkingSetFixture, IndexKeyBufferIsReusedOnceMemberIsFreed) {
+    BSONObj ownedKey = BSON("" << 1 << "" << 2);
+    BSONObj key(ownedKey.objdata());
+    ASSERT_FALSE(key.isOwned());
+
+    // An owned key is used as it is.
+    member->keyData.push_back(
+        IndexKeyDatum(BSON("a" << 1 << "b" << 1), member->makeIndexKeyOwned(ownedKey), 0, {}));
+    ASSERT_EQ(member->keyData.back().keyData.objdata(), ownedKey.objdata());
+    ws->free(id);
+
+    // An unowned key is copied.
+    ASSERT_EQ(ws->allocate(), id);
+    member->keyData.push_back(
+        IndexKeyDatum(BSON("a" << 1 << "b" << 1), member->makeIndexKeyOwned(key), 0, {}));
+    const char* keyBuffer = member->keyData.back().keyData.objdata();
+    ASSERT_NE(keyBuffer, key.objdata());
+    ws->free(id);
+
+    // The next key of the member is copied into the buffer of the previous one.
+    ASSERT_EQ(ws->allocate(), id);
+    BSONObj nextKey = member->makeIndexKeyOwned(BSONObj(BSON("" << 3 << "" << 4).objdata()));
+    ASSERT_EQ(nextKey.objdata(), keyBuffer);
+    ASSERT_BSONOBJ_EQ(nextKey, BSON("" << 3 << "" << 4));
+}
+
+TEST_F(WorkingSetFixture, IndexKeyBufferIsNotReusedWhileStillReferenced) {
+    BSONObj ownedKey = BSON("" << 1);
+    member->keyData.push_back(IndexKeyDatum(
+        BSON("a" << 1), member->makeIndexKeyOwned(BSONObj(ownedKey.objdata())), 0, {}));
+    BSONObj heldKey = member->keyData.back().keyData;
+    ws->free(id);
+
+    ASSERT_EQ(ws->allocate(), id);
+    BSONObj nextKey = member->makeIndexKeyOwned(BSONObj(BSON("" << 2).objdata()));
+    ASSERT_NE(nextKey.objdata(), heldKey.objdata());
+    ASSERT_BSONOBJ_EQ(heldKey, BSON("" << 1));
+}
+
+TEST_F(WorkingSetFixture, ClearFreesAllMembersForReuse) {
+    std::vector<WorkingSetID> ids{id, ws->allocate(), ws->allocate()};
+    ws->free(ids[1]);
+    ws->get(ids[2])->doc = {SnapshotId(), Document{BSON("x" << 1)}};
+    ws->transitionToOwnedObj(ids[2]);
+
+    ws->clear();
+    for (auto&& memberId : ids) {
+        ASSERT_TRUE(ws->isFree(memberId));
+    }
+
+    // The members are handed out again in id order, in their initial state.
+    for (auto&& memberId : ids) {
+        ASSERT_EQ(ws->allocate(), memberId);
+        ASSERT_EQ(ws->get(memberId)->getState(), WorkingSetMember::INVALID);
+    }
+    ASSERT_EQ(ws->allocate(), ids.size());
+}
+
 }  // namespace mongo
@@ -33,6 +33,7 @@
 
 #include "mongo/db/ftdc/controller.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/client.h"
@@ -49,6 +50,35 @@
 
 namespace mongo {
 
+namespace {
+
+/**
+ * Reports the samples taken by an FTDCHighFrequencySampler since the previous collection, as many
+ * as fit in one FTDC period.
+ */
+class FTDCHighFrequencyCollector : public FTDCCollectorInterface {
+public:
+    FTDCHighFrequencyCollector(FTDCHighFrequencySampler* sampler, const FTDCConfig* config)
+        : _sampler(sampler), _config(config) {}
+
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) final {
+        // '_config' is only modified by the collection thread, which is the one calling us.
+        auto count =
+            std::max<long long>(1, _config->period.count() / _sampler->getPeriod().count());
+        _sampler->appendSamples(builder, count);
+    }
+
+    std::string name() const final {
+        return "highFrequency";
+    }
+
+private:
+    FTDCHighFrequencySampler* const _sampler;
+    const FTDCConfig* const _config;
+};
+
+}  // namespace
+
 Status FTDCController::setEnabled(bool enabled) {
     stdx::lock_guard<Latch> lock(_mutex);
 
@@ -129,6 +159,25 @@ void FTDCController::addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface
     }
 }
 
+void FTDCController::enableHighFrequencySampling(Milliseconds period) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    invariant(_state == State::kNotStarted);
+    invariant(!_highFrequencySampler);
+
+    _highFrequencySampler = std::make_unique<FTDCHighFrequencySampler>(period);
+    _periodicCollectors.add(
+        std::make_unique<FTDCHighFrequencyCollector>(_highFrequencySampler.get(), &_config));
+}
+
+void FTDCController::addHighFrequencyProbe(StringData name,
+                                           FTDCHighFrequencySampler::Probe probe) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    invariant(_state == State::kNotStarted);
+
+    if (_highFrequencySampler)
+        _highFrequencySampler->addProbe(name, std::move(probe));
+}
+
 BSONObj FTDCController::getMostRecentPeriodicDocument() {
     {
         stdx::lock_guard<Latch> lock(_mutex);
@@ -144,6 +193,9 @@ void FTDCController::start() {
     // Start the thread
     _thread = stdx::thread([this] { doLoop(); });
 
+    if (_highFrequencySampler)
+        _highFrequencySampler->start();
+
     {
         stdx::lock_guard<Latch> lock(_mutex);
 
@@ -176,6 +228,9 @@ void FTDCController::stop() {
 
     _thread.join();
 
+    if (_highFrequencySampler)
+        _highFrequencySampler->stop();
+
     _state = State::kDone;
 
     if (_mgr) {
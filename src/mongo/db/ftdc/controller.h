@@ -36,6 +36,7 @@
 #include "mongo/db/ftdc/collector.h"
 #include "mongo/db/ftdc/config.h"
 #include "mongo/db/ftdc/file_manager.h"
+#include "mongo/db/ftdc/sampler.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
@@ -118,6 +119,19 @@ public:
      */
     void addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface> collector);
 
+    /**
+     * Sample the probes added with addHighFrequencyProbe() every 'period' on a separate thread.
+     * The samples are reported, one array per probe, by a periodic collector named
+     * "highFrequency". Must be called before start().
+     */
+    void enableHighFrequencySampling(Milliseconds period);
+
+    /**
+     * Add a cheap, non-blocking counter to sample at a high frequency. Ignored unless
+     * enableHighFrequencySampling() has been called.
+     */
+    void addHighFrequencyProbe(StringData name, FTDCHighFrequencySampler::Probe probe);
+
     /**
      * Start the controller.
      *
@@ -210,6 +224,9 @@ private:
     // File manager that manages file rotation, and logging
     std::unique_ptr<FTDCFileManager> _mgr;
 
+    // Samples latency-critical counters between periodic collections, if enabled
+    std::unique_ptr<FTDCHighFrequencySampler> _highFrequencySampler;
+
     // Background collection and writing thread
     stdx::thread _thread;
 };
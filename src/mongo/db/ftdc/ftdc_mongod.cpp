@@ -33,16 +33,36 @@
 
 #include <boost/filesystem.hpp>
 
+#include "mongo/db/concurrency/locker.h"
 #include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/controller.h"
 #include "mongo/db/ftdc/ftdc_server.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/util/concurrency/ticketholder.h"
 
 namespace mongo {
 
 namespace {
+void addTicketProbes(FTDCController* controller, StringData prefix, TicketHolder* holder) {
+    if (!holder)
+        return;
+
+    controller->addHighFrequencyProbe(prefix.toString() + "TicketsUsed", [holder] {
+        return static_cast<long long>(holder->used());
+    });
+    controller->addHighFrequencyProbe(prefix.toString() + "TicketsQueued", [holder] {
+        return static_cast<long long>(holder->queued(TicketHolder::Priority::kLow) +
+                                      holder->queued(TicketHolder::Priority::kNormal) +
+                                      holder->queued(TicketHolder::Priority::kHigh));
+    });
+}
+
 void registerMongoDCollectors(FTDCController* controller) {
+    // The ticket holders have static lifetimes, so they can be sampled until shutdown.
+    addTicketProbes(controller, "read", Locker::getGlobalReadThrottling());
+    addTicketProbes(controller, "write", Locker::getGlobalWriteThrottling());
+
     // These metrics are only collected if replication is enabled
     if (repl::ReplicationCoordinator::get(getGlobalServiceContext())->getReplicationMode() !=
         repl::ReplicationCoordinator::modeNone) {
@@ -46,6 +46,8 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/mirror_maestro.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/stats/counters.h"
+#include "mongo/transport/service_entry_point.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/util/synchronized_value.h"
 
@@ -268,6 +270,30 @@ private:
     bool _serverShuttingDown;
 };
 
+namespace {
+
+/**
+ * Install the high frequency probes common to mongod and mongos. These only read atomic counters.
+ */
+void installHighFrequencyProbes(FTDCController* controller) {
+    auto addOpCounter = [&](StringData name, const AtomicWord<long long>* counter) {
+        controller->addHighFrequencyProbe(name, [counter] { return counter->load(); });
+    };
+    addOpCounter("opcountersInsert", globalOpCounters.getInsert());
+    addOpCounter("opcountersQuery", globalOpCounters.getQuery());
+    addOpCounter("opcountersUpdate", globalOpCounters.getUpdate());
+    addOpCounter("opcountersDelete", globalOpCounters.getDelete());
+    addOpCounter("opcountersGetmore", globalOpCounters.getGetMore());
+    addOpCounter("opcountersCommand", globalOpCounters.getCommand());
+
+    controller->addHighFrequencyProbe("connectionsCurrent", [] {
+        auto sep = getGlobalServiceContext()->getServiceEntryPoint();
+        return sep ? static_cast<long long>(sep->numOpenSessions()) : 0LL;
+    });
+}
+
+}  // namespace
+
 // Register the FTDC system
 // Note: This must be run before the server parameters are parsed during startup
 // so that the FTDCController is initialized.
@@ -293,6 +319,11 @@ void startFTDC(boost::filesystem::path& path,
 
     auto controller = std::make_unique<FTDCController>(path, config);
 
+    if (auto period = gDiagnosticDataCollectionHighFrequencyPeriodMillis; period > 0) {
+        controller->enableHighFrequencySampling(Milliseconds(period));
+        installHighFrequencyProbes(controller.get());
+    }
+
     // Install periodic collectors
     // These are collected on the period interval in FTDCConfig.
     // NOTE: For each command here, there must be an equivalent privilege check in
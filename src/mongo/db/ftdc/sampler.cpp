@@ -0,0 +1,130 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/ftdc/sampler.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_name.h"
+
+namespace mongo {
+
+FTDCHighFrequencySampler::~FTDCHighFrequencySampler() {
+    stop();
+}
+
+void FTDCHighFrequencySampler::addProbe(StringData name, Probe probe) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    invariant(!_started);
+    _probes.push_back({name.toString(), std::move(probe)});
+}
+
+void FTDCHighFrequencySampler::start() {
+    stdx::lock_guard<Latch> lock(_mutex);
+    invariant(!_started);
+    _started = true;
+    _thread = stdx::thread([this] { _run(); });
+}
+
+void FTDCHighFrequencySampler::stop() {
+    {
+        stdx::lock_guard<Latch> lock(_mutex);
+        if (!_started || _stopRequested)
+            return;
+        _stopRequested = true;
+        _condvar.notify_one();
+    }
+    _thread.join();
+}
+
+void FTDCHighFrequencySampler::sample() {
+    // The probe list is fixed once sampling starts, so the probes can be read without the mutex.
+    std::vector<long long> values;
+    values.reserve(_probes.size());
+    for (auto& probe : _probes)
+        values.push_back(probe.probe());
+
+    stdx::lock_guard<Latch> lock(_mutex);
+    for (size_t i = 0; i < _probes.size(); ++i) {
+        auto& samples = _probes[i].samples;
+        if (samples.size() == kMaxBufferedSamples)
+            samples.pop_front();
+        samples.push_back(values[i]);
+    }
+}
+
+void FTDCHighFrequencySampler::appendSamples(BSONObjBuilder& builder, size_t count) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    for (auto& probe : _probes) {
+        auto& samples = probe.samples;
+        if (samples.size() > count)
+            samples.erase(samples.begin(), samples.end() - count);
+
+        BSONArrayBuilder array(builder.subarrayStart(probe.name));
+        for (size_t i = samples.size(); i < count; ++i)
+            array.append(probe.lastReported);
+        for (auto value : samples)
+            array.append(value);
+
+        if (!samples.empty())
+            probe.lastReported = samples.back();
+        samples.clear();
+    }
+}
+
+void FTDCHighFrequencySampler::_run() {
+    setThreadName("ftdcHighFrequencySampler");
+
+    stdx::unique_lock<Latch> lock(_mutex);
+    auto next = Date_t::now();
+    while (!_stopRequested) {
+        next += _period;
+        {
+            MONGO_IDLE_THREAD_BLOCK;
+            if (_condvar.wait_until(
+                    lock, next.toSystemTimePoint(), [&] { return _stopRequested; })) {
+                break;
+            }
+        }
+
+        // Skip the periods we missed rather than sampling in a burst to catch up.
+        auto now = Date_t::now();
+        if (now - next >= _period)
+            next = now;
+
+        lock.unlock();
+        sample();
+        lock.lock();
+    }
+}
+
+}  // namespace mongo
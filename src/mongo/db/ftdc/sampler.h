@@ -0,0 +1,123 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * Samples a small set of cheap counters much more often than the periodic FTDC collectors run, so
+ * that stalls shorter than the FTDC period are visible in the diagnostic data.
+ *
+ * A background thread reads every probe once per sample period. Each FTDC collection then reports
+ * the samples taken since the previous one as an array per probe. The arrays always have the
+ * requested length so that the schema of the FTDC document, and with it the compression of the
+ * metric chunks, stays stable.
+ *
+ * Probes must be added before start() and must be safe to call from any thread without blocking.
+ */
+class FTDCHighFrequencySampler {
+    FTDCHighFrequencySampler(const FTDCHighFrequencySampler&) = delete;
+    FTDCHighFrequencySampler& operator=(const FTDCHighFrequencySampler&) = delete;
+
+public:
+    using Probe = std::function<long long()>;
+
+    // Samples kept per probe when nothing collects them, for example while FTDC is disabled.
+    static constexpr size_t kMaxBufferedSamples = 1000;
+
+    explicit FTDCHighFrequencySampler(Milliseconds period) : _period(period) {}
+
+    ~FTDCHighFrequencySampler();
+
+    void addProbe(StringData name, Probe probe);
+
+    /**
+     * Start sampling on a background thread.
+     */
+    void start();
+
+    /**
+     * Stop sampling. Safe to call if start() was never called.
+     */
+    void stop();
+
+    Milliseconds getPeriod() const {
+        return _period;
+    }
+
+    /**
+     * Read every probe once. Called by the background thread.
+     */
+    void sample();
+
+    /**
+     * Append one array of exactly 'count' samples per probe, oldest first, and discard them.
+     * Missing samples are filled in with the last value reported before them; if more samples
+     * were taken, only the most recent 'count' are reported.
+     */
+    void appendSamples(BSONObjBuilder& builder, size_t count);
+
+private:
+    void _run();
+
+    struct ProbeState {
+        std::string name;
+        Probe probe;
+        std::deque<long long> samples;
+        long long lastReported = 0;
+    };
+
+    const Milliseconds _period;
+
+    // Protects everything below.
+    Mutex _mutex = MONGO_MAKE_LATCH("FTDCHighFrequencySampler::_mutex");
+    stdx::condition_variable _condvar;
+
+    std::vector<ProbeState> _probes;
+    bool _started = false;
+    bool _stopRequested = false;
+
+    stdx::thread _thread;
+};
+
+}  // namespace mongo
@@ -0,0 +1,98 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/ftdc/sampler.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace {
+
+TEST(FTDCHighFrequencySamplerTest, ReportsFixedNumberOfSamplesPerProbe) {
+    FTDCHighFrequencySampler sampler(Milliseconds(10));
+    long long counter = 0;
+    sampler.addProbe("counter", [&] { return ++counter; });
+    sampler.addProbe("constant", [] { return 7LL; });
+
+    // Exactly as many samples as requested.
+    for (int i = 0; i < 3; ++i)
+        sampler.sample();
+    {
+        BSONObjBuilder builder;
+        sampler.appendSamples(builder, 3);
+        ASSERT_BSONOBJ_EQ(builder.obj(),
+                          BSON("counter" << BSON_ARRAY(1 << 2 << 3) << "constant"
+                                         << BSON_ARRAY(7 << 7 << 7)));
+    }
+
+    // Too few samples are padded in front with the last reported value.
+    sampler.sample();
+    {
+        BSONObjBuilder builder;
+        sampler.appendSamples(builder, 3);
+        ASSERT_BSONOBJ_EQ(builder.obj(),
+                          BSON("counter" << BSON_ARRAY(3 << 3 << 4) << "constant"
+                                         << BSON_ARRAY(7 << 7 << 7)));
+    }
+
+    // Too many samples only report the most recent ones.
+    for (int i = 0; i < 5; ++i)
+        sampler.sample();
+    {
+        BSONObjBuilder builder;
+        sampler.appendSamples(builder, 3);
+        ASSERT_BSONOBJ_EQ(builder.obj(),
+                          BSON("counter" << BSON_ARRAY(7 << 8 << 9) << "constant"
+                                         << BSON_ARRAY(7 << 7 << 7)));
+    }
+}
+
+TEST(FTDCHighFrequencySamplerTest, BackgroundThreadSamples) {
+    FTDCHighFrequencySampler sampler(Milliseconds(1));
+    AtomicWord<long long> calls{0};
+    sampler.addProbe("calls", [&] { return calls.addAndFetch(1); });
+
+    sampler.start();
+    while (calls.load() < 5)
+        sleepmillis(1);
+    sampler.stop();
+
+    BSONObjBuilder builder;
+    sampler.appendSamples(builder, 2);
+    auto samples = builder.obj()["calls"].Array();
+    ASSERT_EQ(samples.size(), 2u);
+    ASSERT_GT(samples[1].numberLong(), samples[0].numberLong());
+}
+
+}  // namespace
+}  // namespace mongo
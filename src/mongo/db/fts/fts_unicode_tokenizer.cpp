@@ -38,6 +38,7 @@
 #include "mongo/db/fts/stemmer.h"
 #include "mongo/db/fts/stop_words.h"
 #include "mongo/db/fts/tokenizer.h"
+#include "mongo/db/fts/unicode/byte_vector.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -45,6 +46,51 @@ namespace fts {
 
 using std::string;
 
+namespace {
+
+/**
+ * For each ASCII character, whether it delimits tokens in the given delimiter list language.
+ */
+class AsciiDelimiters {
+public:
+    explicit AsciiDelimiters(unicode::DelimiterListLanguage language) {
+        for (char32_t c = 0; c < 128; ++c) {
+            _isDelimiter[c] = unicode::codepointIsDelimiter(c, language);
+        }
+    }
+
+    bool isDelimiter(char c) const {
+        return _isDelimiter[static_cast<unsigned char>(c)];
+    }
+
+private:
+    bool _isDelimiter[128];
+};
+
+const AsciiDelimiters& asciiDelimiters(unicode::DelimiterListLanguage language) {
+    static const AsciiDelimiters english(unicode::DelimiterListLanguage::kEnglish);
+    static const AsciiDelimiters notEnglish(unicode::DelimiterListLanguage::kNotEnglish);
+    return language == unicode::DelimiterListLanguage::kEnglish ? english : notEnglish;
+}
+
+bool isAscii(StringData str) {
+    auto it = str.begin();
+    const auto end = str.end();
+#ifdef MONGO_HAVE_FAST_BYTE_VECTOR
+    for (; size_t(end - it) >= unicode::ByteVector::size; it += unicode::ByteVector::size) {
+        if (unicode::ByteVector::load(&*it).maskHigh())
+            return false;
+    }
+#endif
+    for (; it != end; ++it) {
+        if (static_cast<unsigned char>(*it) > 0x7f)
+            return false;
+    }
+    return true;
+}
+
+}  // namespace
+
 UnicodeFTSTokenizer::UnicodeFTSTokenizer(const FTSLanguage* language)
     : _language(language),
       _stemmer(language),
@@ -58,23 +104,28 @@ UnicodeFTSTokenizer::UnicodeFTSTokenizer(const FTSLanguage* language)
 void UnicodeFTSTokenizer::reset(StringData document, Options options) {
     _options = options;
     _pos = 0;
-    _document.resetData(document);  // Validates that document is valid UTF8.
+    _isAscii = isAscii(document);
+    if (_isAscii) {
+        _asciiDocument.assign(document.rawData(), document.size());
+    } else {
+        _document.resetData(document);  // Validates that document is valid UTF8.
+    }
 
     // Skip any leading delimiters (and handle the case where the document is entirely delimiters).
     _skipDelimiters();
 }
 
 bool UnicodeFTSTokenizer::moveNext() {
+    const size_t documentSize = _isAscii ? _asciiDocument.size() : _document.size();
     while (true) {
-        if (_pos >= _document.size()) {
+        if (_pos >= documentSize) {
             _word = "";
             return false;
         }
 
         // Traverse through non-delimiters and build the next token.
         size_t start = _pos++;
-        while (_pos < _document.size() &&
-               (!unicode::codepointIsDelimiter(_document[_pos], _delimListLanguage))) {
+        while (_pos < documentSize && !_isDelimiter(_pos)) {
             ++_pos;
         }
         const size_t len = _pos - start;
@@ -84,14 +135,23 @@ bool UnicodeFTSTokenizer::moveNext() {
 
         // Stop words are case-sensitive and diacritic sensitive, so we need them to be lower cased
         // but with diacritics not removed to check against the stop word list.
-        _word = _document.toLowerToBuf(&_wordBuf, _caseFoldMode, start, len);
+        if (_isAscii) {
+            _word = unicode::String::caseFoldAndStripDiacritics(
+                &_wordBuf,
+                StringData(_asciiDocument).substr(start, len),
+                unicode::String::kDiacriticSensitive,
+                _caseFoldMode);
+        } else {
+            _word = _document.toLowerToBuf(&_wordBuf, _caseFoldMode, start, len);
+        }
 
         if ((_options & kFilterStopWords) && _stopWords->isStopWord(_word)) {
             continue;
         }
 
         if (_options & kGenerateCaseSensitiveTokens) {
-            _word = _document.substrToBuf(&_wordBuf, start, len);
+            _word = _isAscii ? StringData(_asciiDocument).substr(start, len)
+                             : _document.substrToBuf(&_wordBuf, start, len);
         }
 
         // The stemmer is diacritic sensitive, so stem the word before removing diacritics.
@@ -112,11 +172,18 @@ StringData UnicodeFTSTokenizer::get() const {
 }
 
 void UnicodeFTSTokenizer::_skipDelimiters() {
-    while (_pos < _document.size() &&
-           unicode::codepointIsDelimiter(_document[_pos], _delimListLanguage)) {
+    const size_t documentSize = _isAscii ? _asciiDocument.size() : _document.size();
+    while (_pos < documentSize && _isDelimiter(_pos)) {
         ++_pos;
     }
 }
 
+bool UnicodeFTSTokenizer::_isDelimiter(size_t pos) const {
+    if (_isAscii) {
+        return asciiDelimiters(_delimListLanguage).isDelimiter(_asciiDocument[pos]);
+    }
+    return unicode::codepointIsDelimiter(_document[pos], _delimListLanguage);
+}
+
 }  // namespace fts
 }  // namespace mongo
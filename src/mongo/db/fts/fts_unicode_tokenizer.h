@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "mongo/base/string_data.h"
 #include "mongo/db/fts/fts_tokenizer.h"
 #include "mongo/db/fts/stemmer.h"
@@ -53,6 +55,9 @@ class StopWords;
  *
  * For each word returns a stem version of a word optimized for full text indexing.
  * Optionally supports returning case sensitive search terms.
+ *
+ * Documents made entirely of ASCII, which are detected a vector at a time, are tokenized straight
+ * off their UTF-8 bytes instead of being decoded to UTF-32 first.
  */
 class UnicodeFTSTokenizer final : public FTSTokenizer {
     UnicodeFTSTokenizer(const UnicodeFTSTokenizer&) = delete;
@@ -74,13 +79,19 @@ private:
      */
     void _skipDelimiters();
 
+    bool _isDelimiter(size_t pos) const;
+
     const FTSLanguage* const _language;
     const Stemmer _stemmer;
     const StopWords* const _stopWords;
     const unicode::DelimiterListLanguage _delimListLanguage;
     const unicode::CaseFoldMode _caseFoldMode;
 
+    // Only one of these holds the current document, depending on whether it is entirely ASCII.
     unicode::String _document;
+    std::string _asciiDocument;
+    bool _isAscii = false;
+
     size_t _pos;
     StringData _word;
     Options _options;
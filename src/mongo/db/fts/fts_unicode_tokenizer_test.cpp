@@ -81,6 +81,33 @@ TEST(FtsUnicodeTokenizer, EnglishLeadingAndTrailingDelimiters) {
     ASSERT_EQUALS("run", terms[5]);
 }
 
+// Ensure that documents made entirely of ASCII, which skip decoding to UTF-32, are tokenized like
+// the same text followed by a non-ASCII word.
+TEST(FtsUnicodeTokenizer, AsciiMatchesUnicode) {
+    const char* ascii = "  Do you see Mark's dog RUNNING? ^caret` It's 10:30, e-mail_me!";
+    const std::string unicode = std::string(ascii) + " caf\xc3\xa9";
+
+    const std::vector<FTSTokenizer::Options> allOptions{
+        FTSTokenizer::kNone,
+        FTSTokenizer::kFilterStopWords,
+        FTSTokenizer::kGenerateCaseSensitiveTokens,
+        FTSTokenizer::kGenerateDiacriticSensitiveTokens,
+        FTSTokenizer::kGenerateCaseSensitiveTokens |
+            FTSTokenizer::kGenerateDiacriticSensitiveTokens};
+
+    for (auto language : {"english", "french", "turkish"}) {
+        for (auto options : allOptions) {
+            auto asciiTerms = tokenizeString(ascii, language, options);
+            auto unicodeTerms = tokenizeString(unicode.c_str(), language, options);
+
+            ASSERT_FALSE(asciiTerms.empty());
+            ASSERT_EQUALS(asciiTerms.size() + 1, unicodeTerms.size());
+            unicodeTerms.pop_back();
+            ASSERT(asciiTerms == unicodeTerms) << language << " " << static_cast<int>(options);
+        }
+    }
+}
+
 // Ensure that strings containing only delimiters are properly handled.
 TEST(FtsUnicodeTokenizer, OnlyDelimiters) {
     std::vector<std::string> terms = tokenizeString("   ", "english", FTSTokenizer::kNone);
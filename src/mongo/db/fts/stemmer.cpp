@@ -30,17 +30,28 @@
 #include <cstdlib>
 
 #include "mongo/db/fts/stemmer.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/str.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
 namespace fts {
 
-Stemmer::Stemmer(const FTSLanguage* language) {
-    _stemmer = nullptr;
-    if (language->str() != "none")
-        _stemmer = sb_stemmer_new(language->str().c_str(), "UTF_8");
-}
+namespace {
+
+// Bound on the number of words whose stems each thread remembers for each language.
+constexpr size_t kMaxCachedStemsPerLanguage = 10 * 1000;
+
+// Longer words are rarely repeated, so they are not worth a cache entry.
+constexpr size_t kMaxCachedWordSize = 64;
+
+thread_local stdx::unordered_map<const FTSLanguage*, StringMap<std::string>> stemCaches;
+
+}  // namespace
+
+Stemmer::Stemmer(const FTSLanguage* language)
+    : _language(language), _enabled(language->str() != "none") {}
 
 Stemmer::~Stemmer() {
     if (_stemmer) {
@@ -50,9 +61,32 @@ Stemmer::~Stemmer() {
 }
 
 StringData Stemmer::stem(StringData word) const {
-    if (!_stemmer)
+    if (!_enabled)
         return word;
 
+    if (word.size() > kMaxCachedWordSize)
+        return _stemUncached(word);
+
+    auto& cache = stemCaches[_language];
+    auto it = cache.find(word);
+    if (it == cache.end()) {
+        if (cache.size() >= kMaxCachedStemsPerLanguage)
+            cache.clear();
+        it = cache.emplace(word.toString(), _stemUncached(word).toString()).first;
+    }
+
+    // The cache may rehash or be cleared by any other Stemmer on this thread, so hand out a copy.
+    _cachedStem = it->second;
+    return _cachedStem;
+}
+
+StringData Stemmer::_stemUncached(StringData word) const {
+    if (!_stemmer) {
+        _stemmer = sb_stemmer_new(_language->str().c_str(), "UTF_8");
+        if (!_stemmer)
+            return word;
+    }
+
     const sb_symbol* sb_sym =
         sb_stemmer_stem(_stemmer, (const sb_symbol*)word.rawData(), word.size());
 
@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "mongo/base/string_data.h"
 #include "mongo/db/fts/fts_language.h"
 #include "third_party/libstemmer_c/include/libstemmer.h"
@@ -42,6 +44,10 @@ namespace fts {
  * maintains case
  * but works
  * running/Running -> run/Run
+ *
+ * Stems are remembered in a bounded per-thread, per-language cache, so a word which has been seen
+ * before on the same thread is not run through the Snowball stemmer again. The Snowball stemmer
+ * itself is only created on the first cache miss.
  */
 class Stemmer {
     Stemmer(const Stemmer&) = delete;
@@ -61,7 +67,15 @@ public:
     StringData stem(StringData word) const;
 
 private:
-    struct sb_stemmer* _stemmer;
+    StringData _stemUncached(StringData word) const;
+
+    const FTSLanguage* const _language;
+    const bool _enabled;
+
+    mutable struct sb_stemmer* _stemmer = nullptr;
+
+    // Holds the last stem returned from the cache.
+    mutable std::string _cachedStem;
 };
 }  // namespace fts
 }  // namespace mongo
@@ -32,6 +32,7 @@
 
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/fts/stemmer.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 namespace fts {
@@ -56,5 +57,30 @@ TEST(English, Caps) {
     ASSERT_EQUALS("unit", s.stem("united"));
     ASSERT_EQUALS("Unite", s.stem("United"));
 }
+TEST(English, CachedStems) {
+    Stemmer s(languageEnglishV2());
+    ASSERT_EQUALS("run", s.stem("running"));
+
+    // A second stemmer on the same thread is served from the cache.
+    Stemmer other(languageEnglishV2());
+    ASSERT_EQUALS("run", other.stem("running"));
+    ASSERT_EQUALS("run", s.stem("running"));
+
+    // Stems stay correct once the cache has been filled and cleared.
+    for (int i = 0; i < 25 * 1000; ++i) {
+        const std::string stem = str::stream() << "word" << i;
+        ASSERT_EQUALS(stem, s.stem(stem + "s"));
+    }
+    ASSERT_EQUALS("unit", s.stem("united"));
+    ASSERT_EQUALS("Run", other.stem("Running"));
+}
+
+TEST(English, LongWordsAreNotCached) {
+    Stemmer s(languageEnglishV2());
+    const std::string longWord = std::string(100, 'x') + "ing";
+    ASSERT_EQUALS(std::string(100, 'x'), s.stem(longWord));
+    ASSERT_EQUALS(std::string(100, 'x'), s.stem(longWord));
+}
+
 }  // namespace fts
 }  // namespace mongo
@@ -108,6 +108,14 @@ public:
      */
     bool contains(const GeometryContainer& otherContainer) const;
 
+    /**
+     * Equivalent to contains() on a GeometryContainer holding the spherical point 'point', without
+     * having to build one.
+     */
+    bool contains(const S2Point& point) const {
+        return contains(S2Cell(point), point);
+    }
+
     /**
      * To check intersection, we iterate over the otherContainer's geometries, checking each
      * geometry to see if we intersect it.  If we intersect one geometry, we intersect the
@@ -404,6 +404,32 @@ Status GeoParser::parseQueryPoint(const BSONElement& elem, PointWithCRS* out) {
     return parsePoint(elem, out, false);
 }
 
+bool GeoParser::parseStoredSpherePoint(const BSONElement& elem, S2Point* out) {
+    if (!elem.isABSONObj())
+        return false;
+
+    // Mirrors GeometryContainer::parseFromStorage followed by a projection to SPHERE, for the
+    // two point formats which cannot carry a "crs".
+    BSONElement coordinates = elem;
+    const BSONObj obj = elem.Obj();
+    if (Array != elem.type() && !obj.firstElement().isNumber()) {
+        const BSONElement type = obj[GEOJSON_TYPE];
+        if (obj.nFields() != 2 || String != type.type() ||
+            type.valueStringData() != GEOJSON_TYPE_POINT) {
+            return false;
+        }
+        coordinates = obj[GEOJSON_COORDINATES];
+    }
+
+    Point point;
+    if (!parseFlatPoint(coordinates, &point, true).isOK() || !isValidLngLat(point.x, point.y))
+        return false;
+
+    // Note that it's (lat, lng) for S2 but (lng, lat) for MongoDB.
+    *out = S2LatLng::FromDegrees(point.y, point.x).Normalized().ToPoint();
+    return true;
+}
+
 Status GeoParser::parseLegacyBox(const BSONObj& obj, BoxWithCRS* out) {
     Point ptA, ptB;
     Status status = Status::OK();
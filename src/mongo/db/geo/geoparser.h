@@ -118,6 +118,12 @@ public:
     // For geo near
     static Status parseQueryPoint(const BSONElement& elem, PointWithCRS* out);
     static Status parseStoredPoint(const BSONElement& elem, PointWithCRS* out);
+
+    // Parses a stored legacy point or a GeoJSON point holding only "type" and "coordinates"
+    // straight into its spherical representation, without building a PointWithCRS. Returns
+    // false for anything else, including points which are out of bounds, in which case the
+    // element must go through GeometryContainer::parseFromStorage.
+    static bool parseStoredSpherePoint(const BSONElement& elem, S2Point* out);
     static bool parsePointWithMaxDistance(const BSONObj& obj, PointWithCRS* out, double* maxOut);
 };
 
@@ -96,6 +96,39 @@ TEST(GeoParser, parseGeoJSONPoint) {
         fromjson("{'type':'Point', 'coordinates': [0, -90.1]}"), &point));
 }
 
+TEST(GeoParser, parseStoredSpherePoint) {
+    S2Point expected;
+    {
+        PointWithCRS point;
+        ASSERT_OK(GeoParser::parseStoredPoint(BSON_ELT(BSON_ARRAY(40 << 5)), &point));
+        ShapeProjection::projectInto(&point, SPHERE);
+        expected = point.point;
+    }
+
+    S2Point point;
+    ASSERT_TRUE(GeoParser::parseStoredSpherePoint(BSON_ELT(BSON_ARRAY(40 << 5)), &point));
+    ASSERT(expected == point);
+    ASSERT_TRUE(GeoParser::parseStoredSpherePoint(BSON_ELT(BSON_ARRAY(40 << 5 << 7)), &point));
+    ASSERT(expected == point);
+    ASSERT_TRUE(GeoParser::parseStoredSpherePoint(BSON_ELT(fromjson("{x: 40, y: 5}")), &point));
+    ASSERT(expected == point);
+    ASSERT_TRUE(GeoParser::parseStoredSpherePoint(
+        BSON_ELT(fromjson("{'type':'Point', 'coordinates': [40, 5]}")), &point));
+    ASSERT(expected == point);
+
+    // Anything which needs the general parser is left to it.
+    ASSERT_FALSE(GeoParser::parseStoredSpherePoint(
+        BSON_ELT(fromjson("{'type':'Point', 'coordinates': [40, 5], "
+                          "'crs': {'type': 'name', 'properties': {'name': 'EPSG:4326'}}}")),
+        &point));
+    ASSERT_FALSE(GeoParser::parseStoredSpherePoint(
+        BSON_ELT(fromjson("{'type':'LineString', 'coordinates': [[40, 5], [41, 5]]}")), &point));
+    ASSERT_FALSE(GeoParser::parseStoredSpherePoint(
+        BSON_ELT(fromjson("{'type':'Point', 'coordhats': [40, 5]}")), &point));
+    ASSERT_FALSE(GeoParser::parseStoredSpherePoint(BSON_ELT(BSON_ARRAY(400 << 5)), &point));
+    ASSERT_FALSE(GeoParser::parseStoredSpherePoint(BSON_ELT(BSON_ARRAY("40" << 5)), &point));
+}
+
 TEST(GeoParser, parseGeoJSONLine) {
     LineWithCRS polyline;
 
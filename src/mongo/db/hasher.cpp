@@ -34,6 +34,9 @@
 #include "mongo/db/hasher.h"
 
 
+#include <third_party/murmurhash3/MurmurHash3.h>
+
+#include "mongo/bson/util/builder.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/util/md5.hpp"
 
@@ -50,7 +53,7 @@ class Hasher {
     Hasher& operator=(const Hasher&) = delete;
 
 public:
-    explicit Hasher(HashSeed seed);
+    Hasher(HashSeed seed, HashVersion version);
     ~Hasher(){};
 
     // pointer to next part of input key, length in bytes to read
@@ -69,6 +72,10 @@ public:
     // only call this once per Hasher
     void finish(HashDigest out);
 
+    // finish computing the hash and return its first 8 bytes as a little endian number
+    // only call this once per Hasher
+    long long int finish64();
+
 private:
     // Convert 'number' to little endian and then append it to the digest input. The number of bytes
     // appended is determined by the input type, so ensure that type T has a well defined size that
@@ -78,15 +85,25 @@ private:
 
     md5_state_t _md5State;
     HashSeed _seed;
+    HashVersion _version;
+
+    // MurmurHash3 has no incremental interface, so the input is buffered until finish().
+    StackBufBuilder _buffer;
 };
 
-Hasher::Hasher(HashSeed seed) : _seed(seed) {
-    md5_init(&_md5State);
-    addSeed(seed);
+Hasher::Hasher(HashSeed seed, HashVersion version) : _seed(seed), _version(version) {
+    if (_version == HashVersion::kMD5) {
+        md5_init(&_md5State);
+        addSeed(seed);
+    }
 }
 
 void Hasher::addData(const void* keyData, size_t numBytes) {
-    md5_append(&_md5State, static_cast<const md5_byte_t*>(keyData), numBytes);
+    if (_version == HashVersion::kMD5) {
+        md5_append(&_md5State, static_cast<const md5_byte_t*>(keyData), numBytes);
+    } else {
+        _buffer.appendBuf(keyData, numBytes);
+    }
 }
 
 template <typename T>
@@ -96,7 +113,19 @@ void Hasher::addIntegerData(T number) {
 }
 
 void Hasher::finish(HashDigest out) {
-    md5_finish(&_md5State, out);
+    if (_version == HashVersion::kMD5) {
+        md5_finish(&_md5State, out);
+    } else {
+        MurmurHash3_x64_128(_buffer.buf(), _buffer.len(), static_cast<uint32_t>(_seed), out);
+    }
+}
+
+long long int Hasher::finish64() {
+    HashDigest d;
+    finish(d);
+    // HashDigest is actually 16 bytes, but we just read 8 bytes
+    ConstDataView digestView(reinterpret_cast<const char*>(d));
+    return digestView.read<LittleEndian<long long int>>();
 }
 
 void recursiveHash(Hasher* h, const BSONElement& e, bool includeFieldName) {
@@ -138,14 +167,12 @@ void recursiveHash(Hasher* h, const BSONElement& e, bool includeFieldName) {
 
 }  // namespace
 
-long long int BSONElementHasher::hash64(const BSONElement& e, HashSeed seed) {
-    Hasher h(seed);
+long long int BSONElementHasher::hash64(const BSONElement& e,
+                                        HashSeed seed,
+                                        HashVersion version) {
+    Hasher h(seed, version);
     recursiveHash(&h, e, false);
-    HashDigest d;
-    h.finish(d);
-    // HashDigest is actually 16 bytes, but we just read 8 bytes
-    ConstDataView digestView(reinterpret_cast<const char*>(d));
-    return digestView.read<LittleEndian<long long int>>();
+    return h.finish64();
 }
 
 }  // namespace mongo
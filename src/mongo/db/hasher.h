@@ -40,6 +40,20 @@ namespace mongo {
 
 typedef int32_t HashSeed;
 
+/**
+ * Identifies the hash function used by hash64(). Stored as "hashVersion" in hashed index specs,
+ * so existing values must never change meaning.
+ *
+ *  - kMD5: the first 8 bytes of the MD5 digest of the hash input. This is the default, and the
+ *    only version hashed shard keys use.
+ *  - kMurmur3: the first 8 bytes of MurmurHash3_x64_128 over the same hash input, which is
+ *    several times cheaper to compute than MD5.
+ */
+enum class HashVersion : int {
+    kMD5 = 0,
+    kMurmur3 = 1,
+};
+
 class BSONElementHasher {
     BSONElementHasher(const BSONElementHasher&) = delete;
     BSONElementHasher& operator=(const BSONElementHasher&) = delete;
@@ -66,7 +80,17 @@ public:
      * the associated "getKeys" and "makeSingleKey" method in the
      * hashindex type is changed accordingly.
      */
-    static long long int hash64(const BSONElement& e, HashSeed seed);
+    static long long int hash64(const BSONElement& e,
+                                HashSeed seed,
+                                HashVersion version = HashVersion::kMD5);
+
+    /**
+     * Returns whether 'version' is the number of a known hash version.
+     */
+    static bool isValidHashVersion(int version) {
+        return version == static_cast<int>(HashVersion::kMD5) ||
+            version == static_cast<int>(HashVersion::kMurmur3);
+    }
 
 private:
     BSONElementHasher();
@@ -372,5 +372,29 @@ TEST(BSONElementHasher, HashWithNonZeroSeed) {
     ASSERT_EQUALS(hashIt(o, seed), -9222615859251096151LL);
 }
 
+TEST(BSONElementHasher, Murmur3HashWithNonZeroSeed) {
+    HashSeed seed = 40513;
+
+    BSONObj o = BSON("check" << 42);
+    ASSERT_EQUALS(BSONElementHasher::hash64(o.firstElement(), seed, HashVersion::kMurmur3),
+                  -9105968502257625488LL);
+
+    o = BSON("check" << BSON_ARRAY("sunflower"
+                                   << "sesame"
+                                   << "mustard"));
+    ASSERT_EQUALS(BSONElementHasher::hash64(o.firstElement(), seed, HashVersion::kMurmur3),
+                  -8852581749062997333LL);
+}
+
+TEST(BSONElementHasher, Murmur3HashSquashesNumericTypes) {
+    auto hashMurmur3 = [](const BSONObj& o) {
+        return BSONElementHasher::hash64(o.firstElement(), 0, HashVersion::kMurmur3);
+    };
+    ASSERT_EQUALS(hashMurmur3(BSON("a" << 3)), hashMurmur3(BSON("a" << 3LL)));
+    ASSERT_EQUALS(hashMurmur3(BSON("a" << 3)), hashMurmur3(BSON("a" << 3.1)));
+    ASSERT_NOT_EQUALS(hashMurmur3(BSON("a" << 3)), hashMurmur3(BSON("a" << 4)));
+    ASSERT_NOT_EQUALS(hashMurmur3(BSON("a" << 3)), hashIt(BSON("a" << 3)));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -29,6 +29,7 @@
 
 #include "mongo/db/index/btree_key_generator.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
 #include <memory>
 
@@ -170,7 +171,7 @@ void BtreeKeyGenerator::_getKeysArrEltFixed(const std::vector<const char*>& fiel
                                             KeyStringSet::sequence_type* keys,
                                             unsigned numNotFound,
                                             const BSONElement& arrObjElt,
-                                            const std::set<size_t>& arrIdxs,
+                                            const ArrayFieldIndexes& arrIdxs,
                                             bool mayExpandArrayUnembedded,
                                             const std::vector<PositionalPathInfo>& positionalInfo,
                                             MultikeyPaths* multikeyPaths,
@@ -320,9 +321,9 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
                                           boost::optional<RecordId> id) const {
     BSONElement arrElt;
 
-    // A set containing the position of any indexed fields in the key pattern that traverse through
-    // the 'arrElt' array value.
-    std::set<size_t> arrIdxs;
+    // The positions of any indexed fields in the key pattern that traverse through the 'arrElt'
+    // array value.
+    ArrayFieldIndexes arrIdxs;
 
     // A vector with size equal to the number of elements in the index key pattern. Each element in
     // the vector, if initialized, refers to the component within the indexed field that traverses
@@ -344,7 +345,8 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
     // path "a.b" causes the index to be multikey, but the key pattern "a.b.0" only indexes the
     // first element of the array, so we'd have a
     // std::vector<boost::optional<size_t>>{{1U}, boost::none}.
-    std::vector<boost::optional<size_t>> arrComponents(fieldNames->size());
+    boost::container::small_vector<boost::optional<size_t>, kFewCompoundIndexFields> arrComponents(
+        fieldNames->size());
 
     bool mayExpandArrayUnembedded = true;
     for (size_t i = 0; i < fieldNames->size(); ++i) {
@@ -364,7 +366,7 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
             (*fieldNames)[i] = "";
             numNotFound++;
         } else if (e.type() == Array) {
-            arrIdxs.insert(i);
+            arrIdxs.push_back(i);
             if (arrElt.eoo()) {
                 // we only expand arrays on a single path -- track the path here
                 arrElt = e;
@@ -443,7 +445,7 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
         // array element).
         std::vector<PositionalPathInfo> subPositionalInfo(fixed->size());
         for (size_t i = 0; i < fieldNames->size(); ++i) {
-            const bool fieldIsArray = arrIdxs.find(i) != arrIdxs.end();
+            const bool fieldIsArray = std::find(arrIdxs.begin(), arrIdxs.end(), i) != arrIdxs.end();
 
             if (*(*fieldNames)[i] == '\0') {
                 // We've reached the end of the path.
@@ -29,8 +29,8 @@
 
 #pragma once
 
+#include <boost/container/small_vector.hpp>
 #include <memory>
-#include <set>
 #include <vector>
 
 #include "mongo/bson/bsonobj_comparator_interface.h"
@@ -192,6 +192,11 @@ private:
      *   set '*field' to "". Similarly, it will return elemtn 99 and set '*field' to "" for
      *   the second array element.
      */
+    // The positions, in increasing order, of the indexed fields which traverse through the array
+    // being expanded. This is built once per array element, so it is kept inline for the common
+    // case of a handful of indexed fields.
+    using ArrayFieldIndexes = boost::container::small_vector<size_t, kFewCompoundIndexFields>;
+
     BSONElement _extractNextElement(const BSONObj& obj,
                                     const PositionalPathInfo& positionalInfo,
                                     const char** field,
@@ -213,7 +218,7 @@ private:
                              KeyStringSet::sequence_type* keys,
                              unsigned numNotFound,
                              const BSONElement& arrObjElt,
-                             const std::set<size_t>& arrIdxs,
+                             const ArrayFieldIndexes& arrIdxs,
                              bool mayExpandArrayUnembedded,
                              const std::vector<PositionalPathInfo>& positionalInfo,
                              MultikeyPaths* multikeyPaths,
@@ -0,0 +1,120 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/column_key_generator.h"
+
+#include <map>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+using CellMap = std::map<std::string, ColumnKeyGenerator::Cell>;
+
+void addValue(CellMap* cells, const std::string& path, BSONElement elem, bool arrayOnPath) {
+    auto& cell = (*cells)[path];
+    cell.values.push_back(elem);
+    cell.arrayOnPath = cell.arrayOnPath || arrayOnPath;
+}
+
+void visitElement(CellMap* cells, const std::string& path, BSONElement elem, bool arrayOnPath);
+
+void visitObject(CellMap* cells, const std::string& prefix, const BSONObj& obj, bool arrayOnPath) {
+    for (auto&& elem : obj) {
+        auto path = prefix.empty() ? elem.fieldName() : prefix + '.' + elem.fieldNameStringData();
+        visitElement(cells, path, elem, arrayOnPath);
+    }
+}
+
+void visitElement(CellMap* cells, const std::string& path, BSONElement elem, bool arrayOnPath) {
+    if (elem.type() == Object && !elem.Obj().isEmpty()) {
+        visitObject(cells, path, elem.Obj(), arrayOnPath);
+        return;
+    }
+
+    if (elem.type() == Array && !elem.Obj().isEmpty()) {
+        // Objects within the array continue the path, other elements are values of this path.
+        // Nested arrays are kept as values.
+        for (auto&& arrayElem : elem.Obj()) {
+            if (arrayElem.type() == Object && !arrayElem.Obj().isEmpty()) {
+                visitObject(cells, path, arrayElem.Obj(), true);
+            } else {
+                addValue(cells, path, arrayElem, true);
+            }
+        }
+        return;
+    }
+
+    addValue(cells, path, elem, arrayOnPath);
+}
+
+}  // namespace
+
+void ColumnKeyGenerator::visitCells(const BSONObj& doc, const CellVisitor& visitor) {
+    CellMap cells;
+    visitObject(&cells, "", doc, false);
+    for (auto&& [path, cell] : cells) {
+        visitor(path, cell);
+    }
+}
+
+ColumnRunBuilder::ColumnRunBuilder(std::string path)
+    : _path(std::move(path)), _rids(kRecordIdsFieldName), _values(kValuesFieldName) {}
+
+void ColumnRunBuilder::append(const RecordId& rid, const ColumnKeyGenerator::Cell& cell) {
+    tassert(6100003, "Column runs require long RecordIds", rid.isLong());
+    tassert(6100004,
+            str::stream() << "Column run for '" << _path << "' appended out of RecordId order",
+            !_lastRid || *_lastRid <= rid);
+    _lastRid = rid;
+
+    BSONObjBuilder ridBuilder;
+    ridBuilder.append("", rid.getLong());
+    auto ridObj = ridBuilder.obj();
+    for (auto&& value : cell.values) {
+        _rids.append(ridObj.firstElement());
+        _values.append(value);
+        ++_count;
+    }
+}
+
+BSONObj ColumnRunBuilder::finalize() {
+    BSONObjBuilder builder;
+    builder.append(kPathFieldName, _path);
+    builder.append(kCountFieldName, _count);
+    builder.append(kRecordIdsFieldName, _rids.finalize());
+    builder.append(kValuesFieldName, _values.finalize());
+    return builder.obj();
+}
+
+}  // namespace mongo
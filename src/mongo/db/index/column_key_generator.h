@@ -0,0 +1,110 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/util/bsoncolumnbuilder.h"
+#include "mongo/db/record_id.h"
+
+namespace mongo {
+
+/**
+ * Generates the cells of a columnstore index for a document. A columnstore index stores the values
+ * of each path separately, so instead of keys the generator produces one cell per leaf path in the
+ * document. Paths are dotted field names without array positions: the values of all array
+ * elements reached through the same path are collected into a single cell.
+ */
+class ColumnKeyGenerator {
+public:
+    struct Cell {
+        // All values found at the path, in document order.
+        std::vector<BSONElement> values;
+
+        // Whether an array was traversed to reach any of the values.
+        bool arrayOnPath = false;
+    };
+
+    using CellVisitor = std::function<void(StringData path, const Cell& cell)>;
+
+    /**
+     * Calls 'visitor' once for each leaf path in 'doc', in lexicographic path order. The elements
+     * in the cells point into 'doc' and are only valid for the duration of the callback.
+     */
+    static void visitCells(const BSONObj& doc, const CellVisitor& visitor);
+};
+
+/**
+ * Accumulates the cells of a single path for a sequence of records in RecordId order, and encodes
+ * them as a column run: the values and the RecordIds they belong to are each stored as a
+ * BSONColumn, so that runs of similar values and increasing RecordIds compress well.
+ *
+ * The finalized run has the format:
+ *     {path: <string>, count: <int>, rids: <BSONColumn of long>, values: <BSONColumn>}
+ */
+class ColumnRunBuilder {
+public:
+    static constexpr StringData kPathFieldName = "path"_sd;
+    static constexpr StringData kCountFieldName = "count"_sd;
+    static constexpr StringData kRecordIdsFieldName = "rids"_sd;
+    static constexpr StringData kValuesFieldName = "values"_sd;
+
+    explicit ColumnRunBuilder(std::string path);
+
+    /**
+     * Appends the values of 'cell' for the record 'rid'. RecordIds must be long and appended in
+     * non-decreasing order.
+     */
+    void append(const RecordId& rid, const ColumnKeyGenerator::Cell& cell);
+
+    /**
+     * Number of values appended so far.
+     */
+    int count() const {
+        return _count;
+    }
+
+    /**
+     * Encodes the run. The builder must not be appended to afterwards.
+     */
+    BSONObj finalize();
+
+private:
+    std::string _path;
+    BSONColumnBuilder _rids;
+    BSONColumnBuilder _values;
+    boost::optional<RecordId> _lastRid;
+    int _count = 0;
+};
+
+}  // namespace mongo
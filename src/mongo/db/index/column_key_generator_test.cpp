@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <map>
+
+#include "mongo/bson/json.h"
+#include "mongo/bson/util/bsoncolumn.h"
+#include "mongo/db/index/column_key_generator.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using Cells = std::map<std::string, std::pair<BSONArray, bool>>;
+
+Cells generateCells(const BSONObj& doc) {
+    Cells cells;
+    ColumnKeyGenerator::visitCells(doc, [&](StringData path, const ColumnKeyGenerator::Cell& cell) {
+        BSONArrayBuilder values;
+        for (auto&& value : cell.values) {
+            values.append(value);
+        }
+        cells.emplace(path.toString(), std::make_pair(values.arr(), cell.arrayOnPath));
+    });
+    return cells;
+}
+
+void assertCell(const Cells& cells, StringData path, const BSONArray& values, bool arrayOnPath) {
+    auto it = cells.find(path.toString());
+    ASSERT(it != cells.end()) << path;
+    ASSERT_BSONOBJ_EQ(it->second.first, values);
+    ASSERT_EQ(it->second.second, arrayOnPath) << path;
+}
+
+TEST(ColumnKeyGeneratorTest, ScalarAndNestedFields) {
+    auto cells = generateCells(fromjson("{a: 1, b: {c: 'x', d: {}}, e: null}"));
+    ASSERT_EQ(cells.size(), 4U);
+    assertCell(cells, "a", BSON_ARRAY(1), false);
+    assertCell(cells, "b.c", BSON_ARRAY("x"), false);
+    assertCell(cells, "b.d", BSON_ARRAY(BSONObj()), false);
+    assertCell(cells, "e", BSON_ARRAY(BSONNULL), false);
+}
+
+TEST(ColumnKeyGeneratorTest, ArraysAreFlattenedIntoOneCellPerPath) {
+    auto cells = generateCells(fromjson("{a: [1, 2, [3]], b: [{c: 1}, {c: 2, d: 3}, 4], e: []}"));
+    ASSERT_EQ(cells.size(), 5U);
+    assertCell(cells, "a", BSON_ARRAY(1 << 2 << BSON_ARRAY(3)), true);
+    assertCell(cells, "b", BSON_ARRAY(4), true);
+    assertCell(cells, "b.c", BSON_ARRAY(1 << 2), true);
+    assertCell(cells, "b.d", BSON_ARRAY(3), true);
+    assertCell(cells, "e", BSON_ARRAY(BSONArray()), false);
+}
+
+TEST(ColumnRunBuilderTest, EncodesValuesAndRecordIdsAsColumns) {
+    ColumnRunBuilder builder("a");
+    for (int64_t i = 1; i <= 3; ++i) {
+        auto doc = BSON("a" << BSON_ARRAY(i * 10 << i * 10 + 1));
+        ColumnKeyGenerator::visitCells(doc, [&](StringData, const ColumnKeyGenerator::Cell& cell) {
+            builder.append(RecordId(i), cell);
+        });
+    }
+    ASSERT_EQ(builder.count(), 6);
+
+    auto run = builder.finalize();
+    ASSERT_EQ(run[ColumnRunBuilder::kPathFieldName].str(), "a");
+    ASSERT_EQ(run[ColumnRunBuilder::kCountFieldName].numberInt(), 6);
+
+    BSONColumn rids(run[ColumnRunBuilder::kRecordIdsFieldName]);
+    BSONColumn values(run[ColumnRunBuilder::kValuesFieldName]);
+    ASSERT_EQ(rids.size(), 6U);
+    ASSERT_EQ(values.size(), 6U);
+    for (size_t i = 0; i < 6; ++i) {
+        auto rid = static_cast<long long>(i / 2 + 1);
+        ASSERT_EQ(rids[i].numberLong(), rid);
+        ASSERT_EQ(values[i].numberLong(), rid * 10 + static_cast<long long>(i % 2));
+    }
+}
+
+TEST(ColumnRunBuilderTest, RecordIdsMustBeAppendedInOrder) {
+    ColumnRunBuilder builder("a");
+    ColumnKeyGenerator::Cell cell;
+    auto doc = BSON("a" << 1);
+    cell.values.push_back(doc.firstElement());
+    builder.append(RecordId(2), cell);
+    ASSERT_THROWS_CODE(builder.append(RecordId(1), cell), DBException, 6100004);
+}
+
+}  // namespace
+}  // namespace mongo
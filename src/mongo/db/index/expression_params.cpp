@@ -33,6 +33,7 @@
 #include "mongo/db/geo/geoconstants.h"
 #include "mongo/db/hasher.h"
 #include "mongo/db/index/2d_common.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/s2_common.h"
 #include "mongo/db/index_names.h"
 #include "mongo/util/str.h"
@@ -83,11 +84,10 @@ void ExpressionParams::parseHashParams(const BSONObj& infoObj,
         *seedOut = infoObj["seed"].numberInt();
     }
 
-    // In case we have hashed indexes based on other hash functions in the future, we store
-    // a hashVersion number. If hashVersion changes, "makeSingleHashKey" will need to change
-    // accordingly.  Defaults to 0 if "hashVersion" is not included in the index spec or if
-    // the value of "hashversion" is not a number
-    *versionOut = infoObj["hashVersion"].numberInt();
+    // The hashVersion number selects the hash function, see HashVersion. Defaults to 0 (MD5) if
+    // "hashVersion" is not included in the index spec or if the value of "hashVersion" is not a
+    // number.
+    *versionOut = infoObj[IndexDescriptor::kHashVersionFieldName].numberInt();
 
     // Extract and validate the index key pattern
     int numHashFields = 0;
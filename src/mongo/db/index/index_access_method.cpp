@@ -43,6 +43,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
+#include "mongo/db/index/index_access_method_gen.h"
 #include "mongo/db/index/index_build_interceptor.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/jsobj.h"
@@ -87,6 +88,8 @@ SortOptions makeSortOptions(size_t maxMemoryUsageBytes, StringData dbName) {
         .TempDir(storageGlobalParams.dbpath + "/_tmp")
         .ExtSortAllowed()
         .MaxMemoryUsageBytes(maxMemoryUsageBytes)
+        .NumSortThreads(maxIndexBuildSorterThreads.load())
+        .AsyncSpillWrites()
         .DBName(dbName.toString());
 }
 
@@ -515,6 +518,8 @@ public:
      */
     Sorter::Iterator* done() final;
 
+    void prepareDone() final;
+
     int64_t getKeysInserted() const final;
 
     Sorter::PersistedState persistDataForShutdown() final;
@@ -534,6 +539,9 @@ private:
     std::unique_ptr<Sorter> _sorter;
     int64_t _keysInserted = 0;
 
+    // Iterator produced by prepareDone(), returned by the following call to done().
+    std::unique_ptr<Sorter::Iterator> _preparedIterator;
+
     // Set to true if any document added to the BulkBuilder causes the index to become multikey.
     bool _isMultiKey = false;
 
@@ -657,10 +665,19 @@ bool AbstractIndexAccessMethod::BulkBuilderImpl::isMultikey() const {
 
 IndexAccessMethod::BulkBuilder::Sorter::Iterator*
 AbstractIndexAccessMethod::BulkBuilderImpl::done() {
+    if (_preparedIterator) {
+        return _preparedIterator.release();
+    }
     _insertMultikeyMetadataKeysIntoSorter();
     return _sorter->done();
 }
 
+void AbstractIndexAccessMethod::BulkBuilderImpl::prepareDone() {
+    invariant(!_preparedIterator);
+    _insertMultikeyMetadataKeysIntoSorter();
+    _preparedIterator.reset(_sorter->done());
+}
+
 int64_t AbstractIndexAccessMethod::BulkBuilderImpl::getKeysInserted() const {
     return _keysInserted;
 }
@@ -269,6 +269,14 @@ public:
          */
         virtual Sorter::Iterator* done() = 0;
 
+        /**
+         * Performs the work of done() ahead of time and caches the resulting iterator, which is
+         * then handed out by the next call to done(). This only touches the Sorter and not the
+         * storage engine, so it may be called concurrently for the BulkBuilders of different
+         * indexes and from a thread without an OperationContext.
+         */
+        virtual void prepareDone() = 0;
+
         /**
          * Returns number of keys inserted using this BulkBuilder.
          */
@@ -33,6 +33,7 @@
 
 #include "mongo/db/index/index_build_interceptor.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/bson/bsonobj.h"
@@ -179,6 +180,9 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
         // table matters.
         std::vector<RecordId> recordsAddedToIndex;
 
+        // The writes in this batch, in the order they were recorded in the side table.
+        std::vector<SideWrite> writes;
+
         auto record = cursor->next();
         while (record) {
             opCtx->checkForInterrupt();
@@ -200,16 +204,7 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
             batchSize += 1;
             batchSizeBytes += objSize;
 
-            if (auto status = _applyWrite(opCtx,
-                                          coll,
-                                          unownedDoc,
-                                          options,
-                                          trackDuplicates,
-                                          &totalInserted,
-                                          &totalDeleted);
-                !status.isOK()) {
-                return status;
-            }
+            writes.push_back(_decodeWrite(unownedDoc));
 
             // Save the record ids of the documents inserted into the index for deletion later.
             // We can't delete records while holding a positioned cursor.
@@ -223,6 +218,26 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
             record = cursor->next();
         }
 
+        // Apply the batch in key order so that the index is written sequentially rather than at
+        // the random positions the side writes were recorded in. Each key string ends with its
+        // RecordId, so only writes to the same index entry compare equal, and the stable sort keeps
+        // those in the order they were recorded. Writes to different entries are independent.
+        std::stable_sort(writes.begin(), writes.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.keyString.compare(rhs.keyString) < 0;
+        });
+        for (const auto& write : writes) {
+            if (auto status = _applyWrite(opCtx,
+                                          coll,
+                                          write,
+                                          options,
+                                          trackDuplicates,
+                                          &totalInserted,
+                                          &totalDeleted);
+                !status.isOK()) {
+                return status;
+            }
+        }
+
         // Delete documents from the side table as soon as they have been inserted into the index.
         // This ensures that no key is ever inserted twice and no keys are skipped.
         for (const auto& recordId : recordsAddedToIndex) {
@@ -280,23 +295,33 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
     return Status::OK();
 }
 
-Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
-                                          const CollectionPtr& coll,
-                                          const BSONObj& operation,
-                                          const InsertDeleteOptions& options,
-                                          TrackDuplicates trackDups,
-                                          int64_t* const keysInserted,
-                                          int64_t* const keysDeleted) {
+IndexBuildInterceptor::SideWrite IndexBuildInterceptor::_decodeWrite(
+    const BSONObj& operation) const {
     // Deserialize the encoded KeyString::Value.
     int keyLen;
     const char* binKey = operation["key"].binData(keyLen);
     BufReader reader(binKey, keyLen);
-    const KeyString::Value keyString = KeyString::Value::deserialize(
+    auto keyString = KeyString::Value::deserialize(
         reader,
         _indexCatalogEntry->accessMethod()->getSortedDataInterface()->getKeyStringVersion());
 
     const Op opType =
         (strcmp(operation.getStringField("op"), "i") == 0) ? Op::kInsert : Op::kDelete;
+    if (kDebugBuild && opType == Op::kDelete)
+        invariant(strcmp(operation.getStringField("op"), "d") == 0);
+
+    return {std::move(keyString), opType};
+}
+
+Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
+                                          const CollectionPtr& coll,
+                                          const SideWrite& write,
+                                          const InsertDeleteOptions& options,
+                                          TrackDuplicates trackDups,
+                                          int64_t* const keysInserted,
+                                          int64_t* const keysDeleted) {
+    const KeyString::Value& keyString = write.keyString;
+    const Op opType = write.opType;
 
     const KeyStringSet keySet{keyString};
     const RecordId opRecordId = [&]() {
@@ -335,8 +360,6 @@ Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
             [keysInserted, numInserted] { *keysInserted -= numInserted; });
     } else {
         invariant(opType == Op::kDelete);
-        if (kDebugBuild)
-            invariant(strcmp(operation.getStringField("op"), "d") == 0);
 
         int64_t numDeleted;
         Status s = accessMethod->removeKeys(
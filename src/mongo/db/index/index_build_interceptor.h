@@ -181,10 +181,19 @@ public:
 private:
     using SideWriteRecord = std::pair<RecordId, BSONObj>;
 
+    /**
+     * A side write decoded from its side table document.
+     */
+    struct SideWrite {
+        KeyString::Value keyString;
+        Op opType;
+    };
+
+    SideWrite _decodeWrite(const BSONObj& operation) const;
 
     Status _applyWrite(OperationContext* opCtx,
                        const CollectionPtr& coll,
-                       const BSONObj& doc,
+                       const SideWrite& write,
                        const InsertDeleteOptions& options,
                        TrackDuplicates trackDups,
                        int64_t* keysInserted,
@@ -89,19 +89,30 @@ Value SortKeyGenerator::computeSortKeyFromIndexKey(const WorkingSetMember& membe
     invariant(member.getState() == WorkingSetMember::RID_AND_IDX);
     invariant(!_sortHasMeta);
 
-    BSONObjBuilder objBuilder;
-    for (auto&& elem : _sortSpecWithoutMeta) {
+    // Index keys never contain arrays, so each component of the sort key is the value of the
+    // corresponding index key element. Build the sort key directly from those rather than
+    // serializing them to BSON first.
+    auto extractKeyPart = [&](const SortPattern::SortPatternPart& part) {
         BSONElement sortKeyElt;
-        invariant(elem.isNumber());
-        invariant(member.getFieldDotted(elem.fieldName(), &sortKeyElt));
-        // If we were to call 'collationAwareIndexKeyAppend' with a non-simple collation and a
-        // 'sortKeyElt' representing a collated index key we would incorrectly encode for the
-        // collation twice. This is not currently possible as the query planner will ensure that
-        // the plan fetches the data before sort key generation in the case where the index has a
-        // non-simple collation.
-        CollationIndexKey::collationAwareIndexKeyAppend(sortKeyElt, _collator, &objBuilder);
+        invariant(part.fieldPath);
+        invariant(member.getFieldDotted(part.fieldPath->fullPath(), &sortKeyElt));
+        // If we were to compute the comparison key of a 'sortKeyElt' representing a collated index
+        // key under a non-simple collation we would incorrectly encode for the collation twice.
+        // This is not currently possible as the query planner will ensure that the plan fetches the
+        // data before sort key generation in the case where the index has a non-simple collation.
+        return getCollationComparisonKey(Value(sortKeyElt));
+    };
+
+    if (isSingleElementKey()) {
+        return extractKeyPart(_sortPattern[0]);
     }
-    return DocumentMetadataFields::deserializeSortKey(isSingleElementKey(), objBuilder.obj());
+
+    std::vector<Value> keys;
+    keys.reserve(_sortPattern.size());
+    for (auto&& part : _sortPattern) {
+        keys.push_back(extractKeyPart(part));
+    }
+    return Value{std::move(keys)};
 }
 
 BSONObj SortKeyGenerator::computeSortKeyFromDocument(const BSONObj& obj,
@@ -187,9 +198,10 @@ StatusWith<BSONObj> SortKeyGenerator::computeSortKeyFromDocumentWithoutMetadata(
     return KeyString::toBson(*keys.begin(), Ordering::make(_sortSpecWithoutMeta));
 }
 
-Value SortKeyGenerator::getCollationComparisonKey(const Value& val) const {
+Value SortKeyGenerator::getCollationComparisonKey(const Value& val,
+                                                  const CollatorInterface* collator) {
     // If the collation is the simple collation, the value itself is the comparison key.
-    if (!_collator) {
+    if (!collator) {
         return val;
     }
 
@@ -200,7 +212,7 @@ Value SortKeyGenerator::getCollationComparisonKey(const Value& val) const {
 
     // If 'val' is a string, directly use the collator to obtain a comparison key.
     if (val.getType() == BSONType::String) {
-        auto compKey = _collator->getComparisonKey(val.getString());
+        auto compKey = collator->getComparisonKey(val.getString());
         return Value(compKey.getKeyData());
     }
 
@@ -210,7 +222,7 @@ Value SortKeyGenerator::getCollationComparisonKey(const Value& val) const {
     val.addToBsonObj(&input, ""_sd);
 
     BSONObjBuilder output;
-    CollationIndexKey::collationAwareIndexKeyAppend(input.obj().firstElement(), _collator, &output);
+    CollationIndexKey::collationAwareIndexKeyAppend(input.obj().firstElement(), collator, &output);
     return Value(output.obj().firstElement());
 }
 
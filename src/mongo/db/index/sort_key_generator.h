@@ -75,6 +75,13 @@ public:
         return _sortPattern.isSingleElementKey();
     }
 
+    /**
+     * Returns the comparison key of 'val' under 'collator', or 'val' itself if 'collator' is null.
+     * Two values are equal under 'collator' if and only if their comparison keys are equal under
+     * the simple collation.
+     */
+    static Value getCollationComparisonKey(const Value& val, const CollatorInterface* collator);
+
 private:
     // Returns the sort key for the input 'doc' as a Value.
     //
@@ -129,7 +136,9 @@ private:
 
     // Returns the comparison key used to sort 'val' with collation. Note that these comparison keys
     // should always be sorted with the simple (i.e. binary) collation.
-    Value getCollationComparisonKey(const Value& val) const;
+    Value getCollationComparisonKey(const Value& val) const {
+        return getCollationComparisonKey(val, _collator);
+    }
 
     const CollatorInterface* _collator = nullptr;
 
@@ -340,6 +340,30 @@ TEST_F(SortKeyGeneratorWorkingSetTest, CanGenerateSortKeyFromWSMInIndexKeyStateW
     ASSERT_VALUE_EQ(Value("1gnirts"_sd), sortKey);
 }
 
+TEST_F(SortKeyGeneratorWorkingSetTest, CanGenerateCompoundSortKeyFromWSMInIndexKeyState) {
+    auto sortKeyGen = makeSortKeyGen(BSON("c" << -1 << "a.b" << 1), nullptr);
+    setRecordIdAndIdx(BSON("a.b" << 1 << "x" << 1 << "c" << -1),
+                      BSON("" << 2 << "" << 3 << "" << BSONNULL));
+    auto sortKey = sortKeyGen->computeSortKey(member());
+    ASSERT_VALUE_EQ(Value({Value(BSONNULL), Value(2)}), sortKey);
+}
+
+TEST_F(SortKeyGeneratorWorkingSetTest,
+       CanGenerateCompoundSortKeyFromWSMInIndexKeyStateWithCollator) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    auto sortKeyGen = makeSortKeyGen(BSON("a" << 1 << "b" << 1), &collator);
+    setRecordIdAndIdx(BSON("a" << 1 << "b" << 1),
+                      BSON("" << BSON("c"
+                                      << "string1")
+                              << ""
+                              << "string2"));
+    auto sortKey = sortKeyGen->computeSortKey(member());
+    ASSERT_VALUE_EQ(Value({Value(BSON("c"
+                                      << "1gnirts")),
+                           Value("2gnirts"_sd)}),
+                    sortKey);
+}
+
 DEATH_TEST_REGEX_F(SortKeyGeneratorWorkingSetTest,
                    DeathOnAttemptToGetSortKeyFromIndexKeyWithMetadata,
                    "Invariant failure.*!_sortHasMeta") {
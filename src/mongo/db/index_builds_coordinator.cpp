@@ -1541,6 +1541,14 @@ void IndexBuildsCoordinator::createIndex(OperationContext* opCtx,
                                          const BSONObj& spec,
                                          IndexBuildsManager::IndexConstraints indexConstraints,
                                          bool fromMigrate) {
+    createIndexes(opCtx, collectionUUID, {spec}, indexConstraints, fromMigrate);
+}
+
+void IndexBuildsCoordinator::createIndexes(OperationContext* opCtx,
+                                           UUID collectionUUID,
+                                           const std::vector<BSONObj>& specs,
+                                           IndexBuildsManager::IndexConstraints indexConstraints,
+                                           bool fromMigrate) {
     CollectionWriter collection(opCtx, collectionUUID);
 
     invariant(collection,
@@ -1559,7 +1567,7 @@ void IndexBuildsCoordinator::createIndex(OperationContext* opCtx,
         IndexBuildsManager::SetupOptions options;
         options.indexConstraints = indexConstraints;
         uassertStatusOK(_indexBuildsManager.setUpIndexBuild(
-            opCtx, collection, {spec}, buildUUID, onInitFn, options));
+            opCtx, collection, specs, buildUUID, onInitFn, options));
     } catch (DBException& ex) {
         const auto& status = ex.toStatus();
         if (status == ErrorCodes::IndexAlreadyExists ||
@@ -1572,7 +1580,7 @@ void IndexBuildsCoordinator::createIndex(OperationContext* opCtx,
                         "error"_attr = redact(status),
                         "namespace"_attr = nss,
                         "collectionUUID"_attr = collectionUUID,
-                        "spec"_attr = spec);
+                        "specs"_attr = specs);
             return;
         }
         throw;
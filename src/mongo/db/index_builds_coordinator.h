@@ -408,6 +408,17 @@ public:
                      IndexBuildsManager::IndexConstraints indexConstraints,
                      bool fromMigrate);
 
+    /**
+     * Same as createIndex(), but builds all of 'specs' with a single scan of the collection.
+     * Callers should filter out indexes which already exist, since with relaxed constraints an
+     * existing index turns the whole call into a no-op.
+     */
+    void createIndexes(OperationContext* opCtx,
+                       UUID collectionUUID,
+                       const std::vector<BSONObj>& specs,
+                       IndexBuildsManager::IndexConstraints indexConstraints,
+                       bool fromMigrate);
+
     /**
      * Creates indexes on an empty collection.
      * Assumes we are enclosed in a WriteUnitOfWork and caller has necessary locks.
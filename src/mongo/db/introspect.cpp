@@ -43,6 +43,7 @@
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/profile_buffer.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/metadata/client_metadata.h"
@@ -92,6 +93,13 @@ void profile(OperationContext* opCtx, NetworkOp op) {
 
     const string dbName(nsToDatabase(CurOp::get(opCtx)->getNS()));
 
+    // When the in-memory profiler is enabled, record the entry there and skip the write to
+    // system.profile along with the locking it requires.
+    if (auto capacity = ProfileBuffer::configuredCapacity()) {
+        ProfileBuffer::get(opCtx->getServiceContext()).append(dbName, p, capacity);
+        return;
+    }
+
     auto origFlowControl = opCtx->shouldParticipateInFlowControl();
 
     // The system.profile collection is non-replicated, so writes to it do not cause
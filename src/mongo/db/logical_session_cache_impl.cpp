@@ -33,6 +33,9 @@
 
 #include "mongo/db/logical_session_cache_impl.h"
 
+#include <algorithm>
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/internal_transactions_feature_flag_gen.h"
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/logical_session_id_helpers.h"
@@ -57,6 +60,50 @@ void clearShardingOperationFailedStatus(OperationContext* opCtx) {
     OperationShardingState::get(opCtx).resetShardingOperationFailedStatus();
 }
 
+/**
+ * Refreshes 'records' in batches of 'logicalSessionRefreshBatchSize' records. The records are
+ * sorted by session id first, so that against a sharded sessions collection each batch only
+ * targets the shards owning a narrow range of ids rather than fanning out to all of them. When
+ * 'pace' is true, the batches are spread evenly over half of the refresh interval, so that a large
+ * number of active sessions does not turn into a write burst at every refresh.
+ */
+void refreshSessionsInBatches(OperationContext* opCtx,
+                              SessionsCollection& sessionsColl,
+                              const LogicalSessionRecordSet& records,
+                              bool pace) {
+    const auto batchSize = size_t(logicalSessionRefreshBatchSize.load());
+    if (batchSize == 0 || records.size() <= batchSize) {
+        sessionsColl.refreshSessions(opCtx, records);
+        return;
+    }
+
+    std::vector<std::pair<BSONObj, const LogicalSessionRecord*>> sorted;
+    sorted.reserve(records.size());
+    for (const auto& record : records) {
+        sorted.emplace_back(record.getId().toBSON(), &record);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) {
+        return SimpleBSONObjComparator::kInstance.evaluate(lhs.first < rhs.first);
+    });
+
+    const auto numBatches = static_cast<int64_t>((sorted.size() + batchSize - 1) / batchSize);
+    const auto delay = pace ? Milliseconds(logicalSessionRefreshMillis / 2) / numBatches
+                            : Milliseconds(0);
+
+    for (size_t begin = 0; begin < sorted.size(); begin += batchSize) {
+        if (begin > 0 && delay > Milliseconds(0)) {
+            opCtx->sleepFor(delay);
+        }
+
+        LogicalSessionRecordSet batch;
+        const auto end = std::min(begin + batchSize, sorted.size());
+        for (auto i = begin; i < end; ++i) {
+            batch.insert(*sorted[i].second);
+        }
+        sessionsColl.refreshSessions(opCtx, batch);
+    }
+}
+
 }  // namespace
 
 LogicalSessionCacheImpl::LogicalSessionCacheImpl(std::unique_ptr<ServiceLiaison> service,
@@ -116,7 +163,7 @@ Status LogicalSessionCacheImpl::vivify(OperationContext* opCtx, const LogicalSes
 
 Status LogicalSessionCacheImpl::refreshNow(OperationContext* opCtx) {
     try {
-        _refresh(opCtx->getClient());
+        _refresh(opCtx->getClient(), false /* paceRefreshBatches */);
     } catch (...) {
         return exceptionToStatus();
     }
@@ -134,7 +181,7 @@ size_t LogicalSessionCacheImpl::size() {
 
 void LogicalSessionCacheImpl::_periodicRefresh(Client* client) {
     try {
-        _refresh(client);
+        _refresh(client, true /* paceRefreshBatches */);
     } catch (const DBException& ex) {
         LOGV2(
             20710,
@@ -223,7 +270,7 @@ Status LogicalSessionCacheImpl::_reap(Client* client) {
     return Status::OK();
 }
 
-void LogicalSessionCacheImpl::_refresh(Client* client) {
+void LogicalSessionCacheImpl::_refresh(Client* client, bool paceRefreshBatches) {
     // get or make an opCtx
     boost::optional<ServiceContext::UniqueOperationContext> uniqueCtx;
     auto* const opCtx = [&client, &uniqueCtx] {
@@ -325,7 +372,7 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
     }
 
     // Refresh the active sessions in the sessions collection.
-    _sessionsColl->refreshSessions(opCtx, activeSessionRecords);
+    refreshSessionsInBatches(opCtx, *_sessionsColl, activeSessionRecords, paceRefreshBatches);
     activeSessionsBackSwapper.dismiss();
     {
         stdx::lock_guard<Latch> lk(_mutex);
@@ -91,7 +91,13 @@ public:
 
 private:
     void _periodicRefresh(Client* client);
-    void _refresh(Client* client);
+
+    /**
+     * Upserts the active sessions and removes the ended sessions from the sessions collection.
+     * If 'paceRefreshBatches' is true and 'logicalSessionRefreshBatchSize' is set, the upsert
+     * batches are spread over half of the refresh interval.
+     */
+    void _refresh(Client* client, bool paceRefreshBatches);
 
     void _periodicReap(Client* client);
     Status _reap(Client* client);
@@ -321,6 +321,32 @@ TEST_F(LogicalSessionCacheTest, ManySignedLsidsInCacheRefresh) {
     ASSERT_OK(cache()->refreshNow(opCtx()));
 }
 
+// Test that the refresh is split into batches when a refresh batch size is configured
+TEST_F(LogicalSessionCacheTest, RefreshInBatches) {
+    RAIIServerParameterControllerForTest batchSize{"logicalSessionRefreshBatchSize", 100};
+
+    int count = 1050;
+    for (int i = 0; i < count; i++) {
+        auto record = makeLogicalSessionRecordForTest();
+        ASSERT_OK(cache()->startSession(opCtx(), record));
+    }
+
+    size_t numBatches = 0;
+    LogicalSessionIdSet refreshed;
+    sessions()->setRefreshHook([&](const LogicalSessionRecordSet& sessions) {
+        ASSERT_LTE(sessions.size(), 100UL);
+        ++numBatches;
+        for (const auto& record : sessions) {
+            ASSERT(refreshed.insert(record.getId()).second);
+        }
+    });
+
+    service()->fastForward(kForceRefresh);
+    ASSERT_OK(cache()->refreshNow(opCtx()));
+    ASSERT_EQ(11UL, numBatches);
+    ASSERT_EQ(size_t(count), refreshed.size());
+}
+
 //
 TEST_F(LogicalSessionCacheTest, RefreshMatrixSessionState) {
     const std::vector<std::vector<std::string>> stateNames = {
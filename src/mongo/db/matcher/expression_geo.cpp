@@ -37,9 +37,18 @@
 #include "mongo/logv2/log.h"
 #include "mongo/platform/basic.h"
 #include "mongo/util/str.h"
+#include "third_party/s2/s2regioncoverer.h"
 
 namespace mongo {
 
+namespace {
+
+// A $geoWithin which only ever sees a few points is not worth covering.
+constexpr long long kPointsTestedBeforeInteriorCovering = 1000;
+constexpr int kInteriorCoveringMaxCells = 128;
+
+}  // namespace
+
 //
 // GeoExpression
 //
@@ -364,6 +373,15 @@ bool GeoMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetails
     if (!e.isABSONObj())
         return false;
 
+    // Plain points tested against a spherical $geoWithin skip building a GeometryContainer.
+    if (GeoExpression::WITHIN == _query->getPred() &&
+        SPHERE == _query->getGeometry().getNativeCRS()) {
+        S2Point point;
+        if (GeoParser::parseStoredSpherePoint(e, &point)) {
+            return _withinSpherePoint(point);
+        }
+    }
+
     GeometryContainer geometry;
 
     if (!geometry.parseFromStorage(e, _canSkipValidation).isOK())
@@ -387,6 +405,26 @@ bool GeoMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetails
     }
 }
 
+bool GeoMatchExpression::_withinSpherePoint(const S2Point& point) const {
+    const auto& queryGeometry = _query->getGeometry();
+
+    auto interiorCovering = _publishedInteriorCovering.load();
+    if (!interiorCovering && queryGeometry.hasS2Region() &&
+        _numPointsTested.addAndFetch(1) == kPointsTestedBeforeInteriorCovering) {
+        S2RegionCoverer coverer;
+        coverer.set_max_cells(kInteriorCoveringMaxCells);
+        _interiorCovering = std::make_unique<S2CellUnion>();
+        coverer.GetInteriorCellUnion(queryGeometry.getS2Region(), _interiorCovering.get());
+        interiorCovering = _interiorCovering.get();
+        _publishedInteriorCovering.store(interiorCovering);
+    }
+
+    if (interiorCovering && interiorCovering->Contains(point)) {
+        return true;
+    }
+    return queryGeometry.contains(point);
+}
+
 void GeoMatchExpression::debugString(StringBuilder& debug, int indentationLevel) const {
     _debugAddSpace(debug, indentationLevel);
 
@@ -35,6 +35,8 @@
 #include "mongo/db/geo/geoparser.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/platform/atomic_word.h"
+#include "third_party/s2/s2cellunion.h"
 
 namespace mongo {
 
@@ -125,12 +127,23 @@ private:
         return [](std::unique_ptr<MatchExpression> expression) { return expression; };
     }
 
+    bool _withinSpherePoint(const S2Point& point) const;
+
     // The original geo specification provided by the user.
     BSONObj _rawObj;
 
     // Share ownership of our query with all of our clones
     std::shared_ptr<const GeoExpression> _query;
     bool _canSkipValidation;
+
+    // Cells lying entirely within the query geometry, built once enough points have been tested
+    // against a spherical $geoWithin for the exact containment test to dominate. Points falling
+    // in one of them match without testing them against the edges of the geometry. Validators
+    // share one expression between threads, so the covering is built by the single thread which
+    // reaches the threshold and published through '_publishedInteriorCovering'.
+    mutable AtomicWord<long long> _numPointsTested{0};
+    mutable std::unique_ptr<S2CellUnion> _interiorCovering;
+    mutable AtomicWord<const S2CellUnion*> _publishedInteriorCovering{nullptr};
 };
 
 
@@ -55,6 +55,62 @@ TEST(ExpressionGeoTest, Geo1) {
     ASSERT(ge.matchesBSON(fromjson("{a: {x: 5, y:5.1}}")));
 }
 
+TEST(ExpressionGeoTest, GeoWithinSpherePolygonMatchesPointFormats) {
+    BSONObj query = fromjson(
+        "{loc: {$geoWithin: {$geometry: {type: 'Polygon', "
+        "coordinates: [[[0, 0], [10, 0], [10, 10], [0, 10], [0, 0]]]}}}}");
+
+    std::unique_ptr<GeoExpression> gq(new GeoExpression);
+    ASSERT_OK(gq->parseFrom(query["loc"].Obj()));
+
+    GeoMatchExpression ge("a", gq.release(), query);
+
+    ASSERT(ge.matchesBSON(fromjson("{a: [5, 5]}")));
+    ASSERT(ge.matchesBSON(fromjson("{a: [5, 5, 100]}")));
+    ASSERT(ge.matchesBSON(fromjson("{a: {x: 5, y: 5}}")));
+    ASSERT(ge.matchesBSON(fromjson("{a: {type: 'Point', coordinates: [5, 5]}}")));
+    ASSERT(ge.matchesBSON(fromjson("{a: {coordinates: [5, 5], type: 'Point'}}")));
+    ASSERT(ge.matchesBSON(fromjson(
+        "{a: {type: 'Point', coordinates: [5, 5], "
+        "crs: {type: 'name', properties: {name: 'EPSG:4326'}}}}")));
+
+    ASSERT(!ge.matchesBSON(fromjson("{a: [15, 5]}")));
+    ASSERT(!ge.matchesBSON(fromjson("{a: {type: 'Point', coordinates: [5, 15]}}")));
+    ASSERT(!ge.matchesBSON(fromjson("{a: [500, 5]}")));
+    ASSERT(!ge.matchesBSON(fromjson("{a: {type: 'Point', coordinates: ['5', 5]}}")));
+    ASSERT(!ge.matchesBSON(fromjson("{a: {type: 'LineString', coordinates: [5, 5]}}")));
+}
+
+TEST(ExpressionGeoTest, GeoWithinSpherePolygonAgreesWithGeometryContainerAfterCovering) {
+    BSONObj query = fromjson(
+        "{loc: {$geoWithin: {$geometry: {type: 'Polygon', "
+        "coordinates: [[[0, 0], [10, 0], [10, 10], [5, 2], [0, 10], [0, 0]]]}}}}");
+
+    std::unique_ptr<GeoExpression> gq(new GeoExpression);
+    ASSERT_OK(gq->parseFrom(query["loc"].Obj()));
+    const auto& queryGeometry = gq->getGeometry();
+
+    GeoMatchExpression ge("a", gq.release(), query);
+
+    // Enough points to cross the threshold at which the interior covering is built, so that
+    // points are checked both with and without it.
+    size_t numMatched = 0;
+    for (int i = 0; i < 60; ++i) {
+        for (int j = 0; j < 60; ++j) {
+            const auto doc = BSON("a" << BSON_ARRAY(-2 + i * 0.25 << -2 + j * 0.25));
+
+            GeometryContainer point;
+            ASSERT_OK(point.parseFromStorage(doc["a"]));
+            point.projectInto(SPHERE);
+
+            const bool expected = queryGeometry.contains(point);
+            ASSERT_EQ(expected, ge.matchesBSON(doc)) << doc;
+            numMatched += expected;
+        }
+    }
+    ASSERT_GT(numMatched, 0U);
+}
+
 TEST(ExpressionGeoTest, GeoNear1) {
     BSONObj query = fromjson(
         "{loc:{$near:{$maxDistance:100, "
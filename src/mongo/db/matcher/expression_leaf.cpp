@@ -31,9 +31,12 @@
 
 #include "mongo/db/matcher/expression_leaf.h"
 
+#include <cctype>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <pcrecpp.h>
+#include <string_view>
 
 #include "mongo/bson/bsonelement_comparator.h"
 #include "mongo/bson/bsonmisc.h"
@@ -44,7 +47,11 @@
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/matcher/path.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/stats/counters.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
 #include "mongo/util/regex_util.h"
+#include "mongo/util/static_immortal.h"
 #include "mongo/util/represent_as.h"
 #include "mongo/util/str.h"
 
@@ -207,6 +214,80 @@ constexpr StringData LTEMatchExpression::kName;
 constexpr StringData GTMatchExpression::kName;
 constexpr StringData GTEMatchExpression::kName;
 
+namespace {
+/**
+ * If 'regex' only matches the strings equal to some literal, optionally followed by a newline,
+ * returns that literal. This is the case for a pattern anchored with '^' and '$' whose other
+ * characters are all literal or escaped punctuation, under flags that do not change the meaning
+ * of the anchors.
+ */
+boost::optional<std::string> getExactLiteral(const std::string& regex, const std::string& flags) {
+    if (flags.find_first_of("imx") != std::string::npos || regex.size() < 2 ||
+        regex.front() != '^' || regex.back() != '$') {
+        return boost::none;
+    }
+
+    std::string literal;
+    for (size_t i = 1; i < regex.size() - 1; ++i) {
+        char c = regex[i];
+        if (c == '\\') {
+            // An escaped punctuation character is that character, but an escaped alphanumeric
+            // character is a character class, an assertion or a back reference.
+            if (i + 1 == regex.size() - 1) {
+                return boost::none;
+            }
+            c = regex[++i];
+            auto uc = static_cast<unsigned char>(c);
+            if (std::isalnum(uc) || uc >= 0x80) {
+                return boost::none;
+            }
+        } else if (std::strchr("^$.|?*+()[]{}", c)) {
+            return boost::none;
+        }
+        literal.push_back(c);
+    }
+    return literal;
+}
+
+/**
+ * Compiled regexes, shared by the match expressions with the same pattern and flags. The copies of
+ * a filter made while planning a query, and the same filter run by many operations, compile their
+ * regexes once. A compiled pcrecpp::RE can be used by several threads at the same time.
+ */
+class CompiledRegexCache {
+public:
+    std::shared_ptr<const pcrecpp::RE> get(const std::string& regex, const std::string& flags) {
+        // Flags are validated, and never contain a NUL byte.
+        const auto options = regex_util::flagsToPcreOptions(flags);
+        const auto key = flags + '\0' + regex;
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            auto it = _cache.find(key);
+            if (it != _cache.end()) {
+                regexCounters.compileCacheHits.increment();
+                return it->second;
+            }
+        }
+
+        auto re = std::make_shared<const pcrecpp::RE>(regex.c_str(), options);
+        stdx::lock_guard<Latch> lk(_mutex);
+        _cache.add(key, re);
+        return re;
+    }
+
+private:
+    static constexpr std::size_t kMaxSize = 1000;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("CompiledRegexCache::_mutex");
+    LRUCache<std::string, std::shared_ptr<const pcrecpp::RE>> _cache{kMaxSize};
+};
+
+CompiledRegexCache& getCompiledRegexCache() {
+    static StaticImmortal<CompiledRegexCache> cache;
+    return *cache;
+}
+}  // namespace
+
 const std::set<char> RegexMatchExpression::kValidRegexFlags = {'i', 'm', 's', 'x'};
 
 std::unique_ptr<pcrecpp::RE> RegexMatchExpression::makeRegex(const std::string& regex,
@@ -221,7 +302,7 @@ RegexMatchExpression::RegexMatchExpression(StringData path,
     : LeafMatchExpression(REGEX, path, std::move(annotation)),
       _regex(regex.toString()),
       _flags(options.toString()),
-      _re(new pcrecpp::RE(_regex.c_str(), regex_util::flagsToPcreOptions(_flags))) {
+      _re(getCompiledRegexCache().get(_regex, _flags)) {
 
     uassert(ErrorCodes::BadValue,
             "Regular expression cannot contain an embedded null byte",
@@ -230,9 +311,18 @@ RegexMatchExpression::RegexMatchExpression(StringData path,
     uassert(51091,
             str::stream() << "Regular expression is invalid: " << _re->error(),
             _re->error().empty());
+
+    _exactLiteral = getExactLiteral(_regex, _flags);
+    if (!_exactLiteral) {
+        _requiredLiteral = regex_util::getRequiredLiteral(_regex, _flags);
+    }
 }
 
-RegexMatchExpression::~RegexMatchExpression() {}
+RegexMatchExpression::~RegexMatchExpression() {
+    if (auto rejections = _prefilterRejections.load()) {
+        regexCounters.prefilterRejected.increment(rejections);
+    }
+}
 
 bool RegexMatchExpression::equivalent(const MatchExpression* other) const {
     if (matchType() != other->matchType())
@@ -251,6 +341,19 @@ bool RegexMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetai
             // pcrecpp::StringPiece instance using the full length of the string to avoid truncating
             // 'data' early.
             pcrecpp::StringPiece data(e.valuestr(), e.valuestrsize() - 1);
+            if (_exactLiteral) {
+                // Like the regex engine, allow the '$' anchor to match before a final newline.
+                StringData str(data.data(), data.size());
+                return str == *_exactLiteral ||
+                    (str.size() == _exactLiteral->size() + 1 && str.endsWith("\n") &&
+                     str.startsWith(*_exactLiteral));
+            }
+            if (!_requiredLiteral.empty() &&
+                std::string_view(data.data(), data.size()).find(_requiredLiteral) ==
+                    std::string_view::npos) {
+                _prefilterRejections.fetchAndAddRelaxed(1);
+                return false;
+            }
             return _re->PartialMatch(data);
         }
         case RegEx:
@@ -415,6 +518,7 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
     next->_hasNull = _hasNull;
     next->_hasEmptyArray = _hasEmptyArray;
     next->_equalitySet = _equalitySet;
+    next->_lookup = _lookup;
     next->_originalEqualityVector = _originalEqualityVector;
     next->_equalityStorage = _equalityStorage;
     for (auto&& regex : _regexes) {
@@ -426,6 +530,16 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
 }
 
 bool InMatchExpression::contains(const BSONElement& e) const {
+    if (_lookup) {
+        switch (_lookup->lookup(e)) {
+            case InListLookup::Result::kMatch:
+                return true;
+            case InListLookup::Result::kNoMatch:
+                return false;
+            case InListLookup::Result::kUnknown:
+                break;
+        }
+    }
     return std::binary_search(_equalitySet.begin(), _equalitySet.end(), e, _eltCmp.makeLessThan());
 }
 
@@ -539,6 +653,12 @@ void InMatchExpression::_doSetCollator(const CollatorInterface* collator) {
                      _originalEqualityVector.end(),
                      std::back_inserter(_equalitySet),
                      _eltCmp.makeEqualTo());
+
+    // The collation only changes which strings are equal, so a lookup over other kinds of values
+    // is still valid.
+    if (!_lookup || _lookup->isCollationSensitive()) {
+        _lookup = InListLookup::make(_equalitySet, _collator);
+    }
 }
 
 Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
@@ -572,6 +692,7 @@ Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
                      _originalEqualityVector.end(),
                      std::back_inserter(_equalitySet),
                      _eltCmp.makeEqualTo());
+    _lookup = InListLookup::make(_equalitySet, _collator);
 
     return Status::OK();
 }
@@ -38,7 +38,9 @@
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_path.h"
+#include "mongo/db/matcher/in_list_lookup.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/unordered_map.h"
 
 namespace pcrecpp {
@@ -466,7 +468,22 @@ private:
 
     std::string _regex;
     std::string _flags;
-    std::unique_ptr<pcrecpp::RE> _re;
+
+    // Shared with every other expression using the same pattern and flags.
+    std::shared_ptr<const pcrecpp::RE> _re;
+
+    // Set when '_regex' has the form /^literal$/, which can be matched against a string by
+    // comparing it to 'literal' instead of running the regex engine. Change stream oplog filters
+    // use this form for the namespace of every entry they examine.
+    boost::optional<std::string> _exactLiteral;
+
+    // A literal which every match of '_regex' contains, or empty if there is none. Strings without
+    // it are rejected without running the regex engine.
+    std::string _requiredLiteral;
+
+    // The number of strings rejected because they did not contain '_requiredLiteral'. Added to the
+    // global counter when the expression is destroyed.
+    mutable AtomicWord<long long> _prefilterRejections{0};
 };
 
 class ModMatchExpression : public LeafMatchExpression {
@@ -587,6 +604,14 @@ public:
 
     bool contains(const BSONElement& e) const;
 
+    /**
+     * Returns the lookup used to test membership in the equalities, or nullptr if the equalities
+     * are not all of a kind an InListLookup supports.
+     */
+    const std::shared_ptr<const InListLookup>& getLookup() const {
+        return _lookup;
+    }
+
     const std::vector<std::unique_ptr<RegexMatchExpression>>& getRegexes() const {
         return _regexes;
     }
@@ -641,6 +666,10 @@ private:
     // called "many" times.
     std::vector<BSONElement> _equalitySet;
 
+    // Tests membership in '_equalitySet' without BSON comparisons when its elements are all of one
+    // kind, such as all integers. Shared with the SBE plans built from this expression.
+    std::shared_ptr<const InListLookup> _lookup;
+
     // Container of regex elements this object owns.
     std::vector<std::unique_ptr<RegexMatchExpression>> _regexes;
 
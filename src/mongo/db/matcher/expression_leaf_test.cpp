@@ -38,6 +38,7 @@
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/unittest/death_test.h"
+#include "mongo/util/regex_util.h"
 
 namespace mongo {
 
@@ -717,11 +718,86 @@ TEST(RegexMatchExpression, MatchesElementExact) {
     ASSERT(!regex.matchesSingleElement(notMatch.firstElement()));
 }
 
+TEST(RegexMatchExpression, MatchesElementAnchoredLiteral) {
+    RegexMatchExpression regex("", "^db\\.coll\\$x$", "");
+    ASSERT(regex.matchesSingleElement(BSON("a"
+                                           << "db.coll$x")
+                                          .firstElement()));
+    // The '$' anchor also matches before a final newline.
+    ASSERT(regex.matchesSingleElement(BSON("a"
+                                           << "db.coll$x\n")
+                                          .firstElement()));
+    ASSERT(!regex.matchesSingleElement(BSON("a"
+                                            << "db.coll$x\n\n")
+                                           .firstElement()));
+    ASSERT(!regex.matchesSingleElement(BSON("a"
+                                            << "db.coll$xy")
+                                           .firstElement()));
+    ASSERT(!regex.matchesSingleElement(BSON("a"
+                                            << "db_coll$x")
+                                           .firstElement()));
+
+    // Patterns that are not literal still go to the regex engine.
+    RegexMatchExpression dotRegex("", "^db.coll$", "");
+    ASSERT(dotRegex.matchesSingleElement(BSON("a"
+                                              << "db_coll")
+                                             .firstElement()));
+    RegexMatchExpression escapedDollar("", "^db\\$", "");
+    ASSERT(escapedDollar.matchesSingleElement(BSON("a"
+                                                   << "db$")
+                                                  .firstElement()));
+    ASSERT(!escapedDollar.matchesSingleElement(BSON("a"
+                                                    << "db")
+                                                   .firstElement()));
+    RegexMatchExpression caseInsensitive("", "^db$", "i");
+    ASSERT(caseInsensitive.matchesSingleElement(BSON("a"
+                                                     << "DB")
+                                                    .firstElement()));
+}
+
 TEST(RegexMatchExpression, TooLargePattern) {
     string tooLargePattern(50 * 1000, 'z');
     ASSERT_THROWS_CODE(RegexMatchExpression("a", tooLargePattern, ""), AssertionException, 51091);
 }
 
+TEST(RegexMatchExpression, RequiredLiteral) {
+    using regex_util::getRequiredLiteral;
+    ASSERT_EQ("timeout", getRequiredLiteral("error.*timeout", ""));
+    ASSERT_EQ("timeout", getRequiredLiteral("error.*timeout", "ms"));
+    ASSERT_EQ("db.coll", getRequiredLiteral("^db\\.coll", ""));
+    ASSERT_EQ("abcd", getRequiredLiteral("x?abcdy*z", ""));
+    ASSERT_EQ("abc", getRequiredLiteral("abc+def{2}", ""));
+    ASSERT_EQ("xyz", getRequiredLiteral("ab[cd)]+xyz(ef|gh)", ""));
+    ASSERT_EQ("", getRequiredLiteral("error|timeout", ""));
+    ASSERT_EQ("", getRequiredLiteral("error", "i"));
+    ASSERT_EQ("", getRequiredLiteral("error", "x"));
+    ASSERT_EQ("", getRequiredLiteral("(?i)error", ""));
+    ASSERT_EQ("", getRequiredLiteral("error\\d+", ""));
+    ASSERT_EQ("", getRequiredLiteral("[[:alpha:]]error", ""));
+    ASSERT_EQ("", getRequiredLiteral(".*", ""));
+}
+
+TEST(RegexMatchExpression, MatchesElementWithRequiredLiteral) {
+    RegexMatchExpression regex("", "error.*timeout", "");
+    ASSERT(regex.matchesSingleElement(BSON("a"
+                                           << "error: read timeout")
+                                          .firstElement()));
+    ASSERT(!regex.matchesSingleElement(BSON("a"
+                                            << "error: connection refused")
+                                           .firstElement()));
+    ASSERT(!regex.matchesSingleElement(BSON("a"
+                                            << "timeout before error")
+                                           .firstElement()));
+
+    // Copies of an expression match like the original.
+    RegexMatchExpression pathRegex("a", "error.*timeout", "");
+    auto clone = pathRegex.shallowClone();
+    ASSERT(clone->matchesBSON(BSON("a"
+                                   << "error, then timeout")));
+    ASSERT(!clone->matchesBSON(BSON("a"
+                                    << "no problem")));
+}
+
 TEST(RegexMatchExpression, MatchesElementSimplePrefix) {
     BSONObj match = BSON("x"
                          << "abc");
@@ -1372,6 +1448,48 @@ TEST(InMatchExpression, ChangingCollationAfterAddingEqualitiesPreservesEqualitie
     ASSERT(in.contains(obj2.firstElement()));
 }
 
+TEST(InMatchExpression, MatchesLargeListOfIntegers) {
+    BSONArrayBuilder bab;
+    for (int i = 0; i < 1000; ++i) {
+        bab.append(i * 2);
+    }
+    BSONArray operand = bab.arr();
+    InMatchExpression in("");
+    std::vector<BSONElement> equalities;
+    for (auto&& elem : operand) {
+        equalities.push_back(elem);
+    }
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+    ASSERT(in.getLookup());
+
+    BSONObj values = BSON("a" << 10 << "b" << 10.0 << "c" << 11LL << "d" << Decimal128(10) << "e"
+                              << 10.5 << "f"
+                              << "10");
+    ASSERT(in.matchesSingleElement(values["a"]));
+    ASSERT(in.matchesSingleElement(values["b"]));
+    ASSERT(!in.matchesSingleElement(values["c"]));
+    ASSERT(in.matchesSingleElement(values["d"]));
+    ASSERT(!in.matchesSingleElement(values["e"]));
+    ASSERT(!in.matchesSingleElement(values["f"]));
+}
+
+TEST(InMatchExpression, SettingCollatorDropsLookupOverStrings) {
+    BSONArray operand = BSON_ARRAY("abc"
+                                   << "def");
+    BSONObj match = BSON("a"
+                         << "cba");
+    InMatchExpression in("");
+    std::vector<BSONElement> equalities{operand[0], operand[1]};
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+    ASSERT(in.getLookup());
+    ASSERT(!in.matchesSingleElement(match["a"]));
+
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    in.setCollator(&collator);
+    ASSERT(!in.getLookup());
+    ASSERT(in.matchesSingleElement(match["a"]));
+}
+
 std::vector<uint32_t> bsonArrayToBitPositions(const BSONArray& ba) {
     std::vector<uint32_t> bitPositions;
 
@@ -0,0 +1,279 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/in_list_lookup.h"
+
+#include <absl/hash/hash.h>
+#include <boost/optional.hpp>
+#include <cmath>
+#include <cstring>
+#include <functional>
+
+namespace mongo {
+namespace {
+
+struct IntegerHash {
+    size_t operator()(int64_t value) const {
+        return absl::Hash<int64_t>{}(value);
+    }
+};
+
+struct StringHash {
+    size_t operator()(StringData value) const {
+        return absl::Hash<absl::string_view>{}(absl::string_view(value.rawData(), value.size()));
+    }
+};
+
+// The key type is deduced, since it is private to InListLookup.
+struct ObjectIdHash {
+    template <typename Key>
+    size_t operator()(const Key& value) const {
+        return absl::Hash<absl::string_view>{}(absl::string_view(value.data(), value.size()));
+    }
+};
+
+/**
+ * Returns the integer equal to 'value', if there is one.
+ */
+boost::optional<int64_t> toExactInt64(double value) {
+    // The upper bound is 2^63, which is the smallest double that does not fit in an int64_t.
+    if (!(value >= -9223372036854775808.0 && value < 9223372036854775808.0) ||
+        std::trunc(value) != value) {
+        return boost::none;
+    }
+    return static_cast<int64_t>(value);
+}
+
+/**
+ * Returns the integer equal to the numeric element 'elem', if there is one. Decimals are not
+ * converted.
+ */
+boost::optional<int64_t> toExactInt64(const BSONElement& elem) {
+    switch (elem.type()) {
+        case NumberInt:
+            return elem._numberInt();
+        case NumberLong:
+            return elem._numberLong();
+        case NumberDouble:
+            return toExactInt64(elem._numberDouble());
+        default:
+            return boost::none;
+    }
+}
+
+/**
+ * Lays out the distinct 'keys' into 'slots'. At most 'kMaxLinearScanSize' keys are kept in order
+ * as a flat array. More keys are placed in a hash table with at least twice as many slots as there
+ * are keys, in which case 'occupied' records which slots are in use.
+ */
+template <typename Key, typename Hash>
+void buildSlots(std::vector<Key> keys,
+                std::vector<Key>* slots,
+                std::vector<uint8_t>* occupied,
+                Hash hash) {
+    if (keys.size() <= InListLookup::kMaxLinearScanSize) {
+        *slots = std::move(keys);
+        return;
+    }
+
+    size_t numSlots = 1;
+    while (numSlots < 2 * keys.size()) {
+        numSlots <<= 1;
+    }
+    slots->assign(numSlots, Key{});
+    occupied->assign(numSlots, 0);
+
+    const size_t mask = numSlots - 1;
+    for (auto&& key : keys) {
+        size_t slot = hash(key) & mask;
+        while ((*occupied)[slot]) {
+            slot = (slot + 1) & mask;
+        }
+        (*slots)[slot] = std::move(key);
+        (*occupied)[slot] = 1;
+    }
+}
+
+template <typename Key, typename Hash, typename Eq>
+InListLookup::Result findInSlots(const std::vector<Key>& slots,
+                                 const std::vector<uint8_t>& occupied,
+                                 const Key& key,
+                                 Hash hash,
+                                 Eq eq) {
+    if (occupied.empty()) {
+        // Compare against every key without stopping at the first match, which keeps the loop
+        // free of branches.
+        bool found = false;
+        for (auto&& slot : slots) {
+            found |= eq(slot, key);
+        }
+        return found ? InListLookup::Result::kMatch : InListLookup::Result::kNoMatch;
+    }
+
+    const size_t mask = slots.size() - 1;
+    for (size_t slot = hash(key) & mask; occupied[slot]; slot = (slot + 1) & mask) {
+        if (eq(slots[slot], key)) {
+            return InListLookup::Result::kMatch;
+        }
+    }
+    return InListLookup::Result::kNoMatch;
+}
+
+}  // namespace
+
+std::shared_ptr<const InListLookup> InListLookup::make(const std::vector<BSONElement>& equalities,
+                                                       const CollatorInterface* collator) {
+    if (equalities.empty()) {
+        return nullptr;
+    }
+
+    const auto firstType = equalities.front().type();
+    if (firstType == NumberInt || firstType == NumberLong || firstType == NumberDouble) {
+        std::vector<int64_t> keys;
+        keys.reserve(equalities.size());
+        for (auto&& equality : equalities) {
+            auto key = toExactInt64(equality);
+            if (!key) {
+                return nullptr;
+            }
+            keys.push_back(*key);
+        }
+
+        std::shared_ptr<InListLookup> lookup(new InListLookup(Kind::kInteger));
+        lookup->_size = keys.size();
+        buildSlots(std::move(keys), &lookup->_integers, &lookup->_occupied, IntegerHash{});
+        return lookup;
+    } else if (firstType == String) {
+        if (collator) {
+            return nullptr;
+        }
+
+        size_t totalSize = 0;
+        for (auto&& equality : equalities) {
+            if (equality.type() != String) {
+                return nullptr;
+            }
+            totalSize += equality.valuestrsize() - 1;
+        }
+
+        std::shared_ptr<InListLookup> lookup(new InListLookup(Kind::kString));
+        lookup->_stringStorage = std::make_unique<char[]>(totalSize ? totalSize : 1);
+
+        std::vector<StringData> keys;
+        keys.reserve(equalities.size());
+        char* storage = lookup->_stringStorage.get();
+        for (auto&& equality : equalities) {
+            const size_t size = equality.valuestrsize() - 1;
+            std::memcpy(storage, equality.valuestr(), size);
+            keys.emplace_back(storage, size);
+            storage += size;
+        }
+
+        lookup->_size = keys.size();
+        buildSlots(std::move(keys), &lookup->_strings, &lookup->_occupied, StringHash{});
+        return lookup;
+    } else if (firstType == jstOID) {
+        std::vector<ObjectIdKey> keys;
+        keys.reserve(equalities.size());
+        for (auto&& equality : equalities) {
+            if (equality.type() != jstOID) {
+                return nullptr;
+            }
+            keys.emplace_back();
+            std::memcpy(keys.back().data(), equality.value(), OID::kOIDSize);
+        }
+
+        std::shared_ptr<InListLookup> lookup(new InListLookup(Kind::kObjectId));
+        lookup->_size = keys.size();
+        buildSlots(std::move(keys), &lookup->_objectIds, &lookup->_occupied, ObjectIdHash{});
+        return lookup;
+    }
+
+    return nullptr;
+}
+
+InListLookup::Result InListLookup::lookup(const BSONElement& elem) const {
+    switch (elem.type()) {
+        case NumberInt:
+            return lookupInt64(elem._numberInt());
+        case NumberLong:
+            return lookupInt64(elem._numberLong());
+        case NumberDouble:
+            return lookupDouble(elem._numberDouble());
+        case NumberDecimal:
+            // A decimal may be equal to an integer of the list.
+            return _kind == Kind::kInteger ? Result::kUnknown : Result::kNoMatch;
+        case String:
+        case Symbol:
+            return lookupString(StringData(elem.valuestr(), elem.valuestrsize() - 1));
+        case jstOID:
+            return lookupObjectId(elem.value());
+        default:
+            // The list only holds values of a different canonical type.
+            return Result::kNoMatch;
+    }
+}
+
+InListLookup::Result InListLookup::lookupInt64(int64_t value) const {
+    if (_kind != Kind::kInteger) {
+        return Result::kNoMatch;
+    }
+    return findInSlots(_integers, _occupied, value, IntegerHash{}, std::equal_to<int64_t>{});
+}
+
+InListLookup::Result InListLookup::lookupDouble(double value) const {
+    auto integer = toExactInt64(value);
+    if (!integer) {
+        // A double that is not integral, or is NaN or infinite, cannot be equal to an integer.
+        return Result::kNoMatch;
+    }
+    return lookupInt64(*integer);
+}
+
+InListLookup::Result InListLookup::lookupString(StringData value) const {
+    if (_kind != Kind::kString) {
+        return Result::kNoMatch;
+    }
+    return findInSlots(_strings, _occupied, value, StringHash{}, [](StringData lhs, StringData rhs) {
+        return lhs == rhs;
+    });
+}
+
+InListLookup::Result InListLookup::lookupObjectId(const char* value) const {
+    if (_kind != Kind::kObjectId) {
+        return Result::kNoMatch;
+    }
+    ObjectIdKey key;
+    std::memcpy(key.data(), value, OID::kOIDSize);
+    return findInSlots(_objectIds, _occupied, key, ObjectIdHash{}, std::equal_to<ObjectIdKey>{});
+}
+
+}  // namespace mongo
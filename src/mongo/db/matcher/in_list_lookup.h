@@ -0,0 +1,128 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/oid.h"
+
+namespace mongo {
+
+class CollatorInterface;
+
+/**
+ * A membership test over the equalities of an $in whose values are all of one kind: all numbers
+ * with an integral value, all strings compared without a collation, or all ObjectIds. Checking a
+ * value against such a list only needs a comparison of plain integers or bytes, rather than a
+ * binary search with BSON comparisons. The classic InMatchExpression and the SBE 'isMember'
+ * builtin share an InListLookup for the same $in.
+ *
+ * Lists of up to 'kMaxLinearScanSize' values are kept in a flat array which is compared in full
+ * against every value looked up, a loop without branches which the compiler can vectorize. Larger
+ * lists are kept in an open addressing hash table with linear probing.
+ *
+ * The lookup keeps copies of the values, so it may outlive the BSON it was built from.
+ */
+class InListLookup {
+public:
+    enum class Result {
+        kMatch,
+        kNoMatch,
+
+        // The value cannot be looked up, such as a decimal compared against a list of integers.
+        // The caller must compare it against the list itself.
+        kUnknown,
+    };
+
+    // Lists larger than this are kept in a hash table.
+    static constexpr size_t kMaxLinearScanSize = 16;
+
+    /**
+     * Returns a lookup over 'equalities', which must not contain duplicates according to
+     * 'collator', or nullptr if the values are not all of one supported kind. Strings are only
+     * supported when 'collator' is null.
+     */
+    static std::shared_ptr<const InListLookup> make(const std::vector<BSONElement>& equalities,
+                                                    const CollatorInterface* collator);
+
+    InListLookup(const InListLookup&) = delete;
+    InListLookup& operator=(const InListLookup&) = delete;
+
+    Result lookup(const BSONElement& elem) const;
+
+    Result lookupInt64(int64_t value) const;
+    Result lookupDouble(double value) const;
+    Result lookupString(StringData value) const;
+    Result lookupObjectId(const char* value) const;
+
+    /**
+     * Returns true if the result of a lookup depends on the collation, in which case the lookup
+     * only applies to comparisons without a collator.
+     */
+    bool isCollationSensitive() const {
+        return _kind == Kind::kString;
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+private:
+    enum class Kind { kInteger, kString, kObjectId };
+
+    using ObjectIdKey = std::array<char, OID::kOIDSize>;
+
+    explicit InListLookup(Kind kind) : _kind(kind) {}
+
+    const Kind _kind;
+
+    // The number of distinct values in the list.
+    size_t _size = 0;
+
+    // The values of the list, as a flat array when there are at most 'kMaxLinearScanSize' of them,
+    // or otherwise as the slots of a hash table whose size is a power of two. Only the array
+    // matching '_kind' is used.
+    std::vector<int64_t> _integers;
+    std::vector<StringData> _strings;
+    std::vector<ObjectIdKey> _objectIds;
+
+    // Which slots of the hash table are in use. Empty when the values are kept as a flat array.
+    std::vector<uint8_t> _occupied;
+
+    // Owns the bytes of the strings in '_strings'.
+    std::unique_ptr<char[]> _stringStorage;
+};
+
+}  // namespace mongo
@@ -0,0 +1,204 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <limits>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/matcher/in_list_lookup.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using Result = InListLookup::Result;
+
+std::vector<BSONElement> toElements(const BSONObj& obj) {
+    std::vector<BSONElement> elements;
+    for (auto&& elem : obj) {
+        elements.push_back(elem);
+    }
+    return elements;
+}
+
+BSONArray makeIntegerArray(int count, int stride) {
+    BSONArrayBuilder bab;
+    for (int i = 0; i < count; ++i) {
+        bab.append(static_cast<long long>(i) * stride);
+    }
+    return bab.arr();
+}
+
+TEST(InListLookup, IntegersMatchAcrossNumericTypes) {
+    BSONArray operand = BSON_ARRAY(1 << 2LL << 3.0);
+    auto lookup = InListLookup::make(toElements(operand), nullptr);
+    ASSERT(lookup);
+    ASSERT_EQ(3U, lookup->size());
+    ASSERT_FALSE(lookup->isCollationSensitive());
+
+    BSONObj values = BSON("a" << 1.0 << "b" << 2 << "c" << 3LL << "d" << 4);
+    ASSERT(lookup->lookup(values["a"]) == Result::kMatch);
+    ASSERT(lookup->lookup(values["b"]) == Result::kMatch);
+    ASSERT(lookup->lookup(values["c"]) == Result::kMatch);
+    ASSERT(lookup->lookup(values["d"]) == Result::kNoMatch);
+}
+
+TEST(InListLookup, DoublesWithoutAnIntegralValueDoNotMatchIntegers) {
+    BSONArray operand = BSON_ARRAY(1 << 2);
+    auto lookup = InListLookup::make(toElements(operand), nullptr);
+    ASSERT(lookup);
+    ASSERT(lookup->lookupDouble(2.0) == Result::kMatch);
+    ASSERT(lookup->lookupDouble(1.5) == Result::kNoMatch);
+    ASSERT(lookup->lookupDouble(std::numeric_limits<double>::quiet_NaN()) == Result::kNoMatch);
+    ASSERT(lookup->lookupDouble(std::numeric_limits<double>::infinity()) == Result::kNoMatch);
+    ASSERT(lookup->lookupDouble(9.3e18) == Result::kNoMatch);
+}
+
+TEST(InListLookup, DecimalsCannotBeLookedUpInIntegers) {
+    BSONArray operand = BSON_ARRAY(1 << 2);
+    auto lookup = InListLookup::make(toElements(operand), nullptr);
+    ASSERT(lookup);
+    BSONObj value = BSON("a" << Decimal128(1));
+    ASSERT(lookup->lookup(value["a"]) == Result::kUnknown);
+}
+
+TEST(InListLookup, LargeListOfIntegersUsesHashTable) {
+    BSONArray operand = makeIntegerArray(1000, 7);
+    auto lookup = InListLookup::make(toElements(operand), nullptr);
+    ASSERT(lookup);
+    ASSERT_EQ(1000U, lookup->size());
+    for (int64_t i = -7; i < 7007; ++i) {
+        auto expected = (i >= 0 && i < 7000 && i % 7 == 0) ? Result::kMatch : Result::kNoMatch;
+        ASSERT(lookup->lookupInt64(i) == expected);
+        ASSERT(lookup->lookupDouble(static_cast<double>(i)) == expected);
+    }
+}
+
+TEST(InListLookup, ListsWithUnsupportedValuesHaveNoLookup) {
+    ASSERT_FALSE(InListLookup::make(toElements(BSON_ARRAY(1 << 1.5)), nullptr));
+    ASSERT_FALSE(InListLookup::make(toElements(BSON_ARRAY(1 << Decimal128(2))), nullptr));
+    ASSERT_FALSE(InListLookup::make(toElements(BSON_ARRAY(1 << "a")), nullptr));
+    ASSERT_FALSE(InListLookup::make(toElements(BSON_ARRAY(1 << BSONNULL)), nullptr));
+    ASSERT_FALSE(InListLookup::make(toElements(BSON_ARRAY(OID::gen() << "a")), nullptr));
+}
+
+TEST(InListLookup, StringsMatchWithoutCollator) {
+    BSONArray operand = BSON_ARRAY("a"
+                                   << "bb"
+                                   << "");
+    auto lookup = InListLookup::make(toElements(operand), nullptr);
+    ASSERT(lookup);
+    ASSERT(lookup->isCollationSensitive());
+    ASSERT(lookup->lookupString("a") == Result::kMatch);
+    ASSERT(lookup->lookupString("bb") == Result::kMatch);
+    ASSERT(lookup->lookupString("") == Result::kMatch);
+    ASSERT(lookup->lookupString("b") == Result::kNoMatch);
+    ASSERT(lookup->lookupString("A") == Result::kNoMatch);
+
+    BSONObjBuilder bob;
+    bob.appendSymbol("sym", "bb");
+    bob.append("num", 1);
+    BSONObj values = bob.obj();
+    ASSERT(lookup->lookup(values["sym"]) == Result::kMatch);
+    ASSERT(lookup->lookup(values["num"]) == Result::kNoMatch);
+}
+
+TEST(InListLookup, StringsWithCollatorHaveNoLookup) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    BSONArray operand = BSON_ARRAY("a"
+                                   << "b");
+    ASSERT_FALSE(InListLookup::make(toElements(operand), &collator));
+
+    // A collator does not affect the comparison of numbers.
+    ASSERT(InListLookup::make(toElements(BSON_ARRAY(1 << 2)), &collator));
+}
+
+TEST(InListLookup, LargeListOfStringsUsesHashTable) {
+    BSONArrayBuilder bab;
+    for (int i = 0; i < 500; ++i) {
+        bab.append("str" + std::to_string(i));
+    }
+    BSONArray operand = bab.arr();
+    auto lookup = InListLookup::make(toElements(operand), nullptr);
+    ASSERT(lookup);
+    ASSERT_EQ(500U, lookup->size());
+    for (int i = 0; i < 1000; ++i) {
+        auto expected = i < 500 ? Result::kMatch : Result::kNoMatch;
+        ASSERT(lookup->lookupString("str" + std::to_string(i)) == expected);
+    }
+}
+
+TEST(InListLookup, ObjectIdsMatch) {
+    std::vector<OID> oids;
+    BSONArrayBuilder small;
+    BSONArrayBuilder large;
+    for (int i = 0; i < 100; ++i) {
+        oids.push_back(OID::gen());
+        if (i < 5) {
+            small.append(oids.back());
+        }
+        large.append(oids.back());
+    }
+    BSONArray smallOperand = small.arr();
+    BSONArray largeOperand = large.arr();
+    auto smallLookup = InListLookup::make(toElements(smallOperand), nullptr);
+    auto largeLookup = InListLookup::make(toElements(largeOperand), nullptr);
+    ASSERT(smallLookup);
+    ASSERT(largeLookup);
+    for (int i = 0; i < 100; ++i) {
+        BSONObj value = BSON("a" << oids[i]);
+        ASSERT(smallLookup->lookup(value["a"]) == (i < 5 ? Result::kMatch : Result::kNoMatch));
+        ASSERT(largeLookup->lookup(value["a"]) == Result::kMatch);
+    }
+    BSONObj other = BSON("a" << OID::gen() << "b"
+                             << "str");
+    ASSERT(largeLookup->lookup(other["a"]) == Result::kNoMatch);
+    ASSERT(largeLookup->lookup(other["b"]) == Result::kNoMatch);
+}
+
+TEST(InListLookup, LookupOutlivesOperand) {
+    std::shared_ptr<const InListLookup> lookup;
+    {
+        BSONArrayBuilder bab;
+        for (int i = 0; i < 50; ++i) {
+            bab.append(std::string(i + 1, 'x'));
+        }
+        BSONArray operand = bab.arr();
+        lookup = InListLookup::make(toElements(operand), nullptr);
+    }
+    ASSERT(lookup);
+    ASSERT(lookup->lookupString(std::string(20, 'x')) == Result::kMatch);
+    ASSERT(lookup->lookupString(std::string(51, 'x')) == Result::kNoMatch);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -33,6 +33,7 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/field_ref.h"
 #include "mongo/db/matcher/path.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -148,4 +149,63 @@ private:
     mutable BSONElementIterator _iterator;
     mutable bool _iteratorUsed;
 };
+
+/**
+ * A MatchableDocument over a BSONObj which indexes its top-level fields up front, so that each
+ * path lookup finds its first component with a hash lookup instead of a scan over the object. This
+ * is worthwhile when many paths are evaluated against a wide document, as is the case for a
+ * $jsonSchema validator with many properties. Like BSONObj::getField(), the first occurrence of a
+ * duplicated field name wins.
+ */
+class IndexedBSONMatchableDocument : public MatchableDocument {
+public:
+    IndexedBSONMatchableDocument(const BSONObj& obj) : _obj(obj), _iteratorUsed(false) {
+        _fields.reserve(obj.nFields());
+        for (auto&& elem : obj) {
+            _fields.emplace(elem.fieldNameStringData(), elem);
+        }
+    }
+
+    BSONObj toBSON() const override {
+        return _obj;
+    }
+
+    ElementIterator* allocateIterator(const ElementPath* path) const override {
+        if (path->fieldRef().numParts() == 0) {
+            if (_iteratorUsed)
+                return new BSONElementIterator(path, _obj);
+            _iteratorUsed = true;
+            _iterator.reset(path, _obj);
+            return &_iterator;
+        }
+
+        // Resolve the first field of the path from the index and traverse the rest of the path
+        // from there.
+        const size_t suffixIndex = 1;
+        BSONElement first;
+        if (auto it = _fields.find(path->fieldRef().getPart(0)); it != _fields.end()) {
+            first = it->second;
+        }
+
+        if (_iteratorUsed)
+            return new BSONElementIterator(path, suffixIndex, first);
+        _iteratorUsed = true;
+        _iterator.reset(path, suffixIndex, first);
+        return &_iterator;
+    }
+
+    void releaseIterator(ElementIterator* iterator) const override {
+        if (iterator == &_iterator) {
+            _iteratorUsed = false;
+        } else {
+            delete iterator;
+        }
+    }
+
+private:
+    BSONObj _obj;
+    StringMap<BSONElement> _fields;
+    mutable BSONElementIterator _iterator;
+    mutable bool _iteratorUsed;
+};
 }  // namespace mongo
@@ -31,6 +31,7 @@
 
 #include "mongo/db/jsobj.h"
 #include "mongo/db/json.h"
+#include "mongo/db/matcher/matchable.h"
 #include "mongo/db/matcher/path.h"
 
 namespace mongo {
@@ -593,4 +594,56 @@ TEST(SingleElementElementIterator, Simple1) {
 
     ASSERT(!i.more());
 }
+namespace {
+/**
+ * Returns every element found for 'path' in 'doc', along with the array offset it was found at.
+ */
+std::vector<BSONObj> iterateAll(const MatchableDocument& doc, const ElementPath& path) {
+    std::vector<BSONObj> found;
+    MatchableDocument::IteratorHolder cursor(&doc, &path);
+    while (cursor->more()) {
+        auto e = cursor->next();
+        BSONObjBuilder bob;
+        if (!e.element().eoo()) {
+            bob.append(e.element());
+        }
+        if (!e.arrayOffset().eoo()) {
+            bob.appendAs(e.arrayOffset(), "offset");
+        }
+        found.push_back(bob.obj());
+    }
+    return found;
+}
+}  // namespace
+
+TEST(IndexedBSONMatchableDocument, FindsTheSameElementsAsBSONMatchableDocument) {
+    const std::vector<BSONObj> docs{
+        fromjson("{}"),
+        fromjson("{a: 1, b: 2, a: 3}"),
+        fromjson("{a: {b: {c: 1}}, x: [1, 2]}"),
+        fromjson("{a: [{b: 1}, {b: [2, 3]}, 4], b: null}"),
+        fromjson("{a: [[1, {b: 2}]], '0': 5}"),
+        fromjson("{a: {'0': {b: 1}}, c: [{d: {e: [1]}}]}"),
+    };
+    const std::vector<std::string> paths{"a", "b", "a.b", "a.b.c", "a.0", "a.0.b", "x.1", "c.d.e",
+                                         "0", "missing", "missing.a"};
+
+    for (auto&& doc : docs) {
+        BSONMatchableDocument plainDoc(doc);
+        IndexedBSONMatchableDocument indexedDoc(doc);
+        for (auto&& pathStr : paths) {
+            for (auto behavior : {ElementPath::LeafArrayBehavior::kTraverse,
+                                  ElementPath::LeafArrayBehavior::kNoTraversal,
+                                  ElementPath::LeafArrayBehavior::kTraverseOmitArray}) {
+                ElementPath path{pathStr, behavior};
+                auto expected = iterateAll(plainDoc, path);
+                auto actual = iterateAll(indexedDoc, path);
+                ASSERT_EQ(expected.size(), actual.size()) << doc << " " << pathStr;
+                for (size_t i = 0; i < expected.size(); ++i) {
+                    ASSERT_BSONOBJ_EQ(expected[i], actual[i]);
+                }
+            }
+        }
+    }
+}
 }  // namespace mongo
@@ -1153,7 +1153,9 @@ std::vector<repl::ReplOperation>::iterator packTransactionStatementsForApplyOps(
              (opsArray.len() + DurableOplogEntry::getDurableReplOperationSize(stmt) >
               BSONObjMaxUserSize)))
             break;
-        opsArray.append(stmt.toBSON());
+        // Serialize the statement directly into the array rather than through a temporary object.
+        BSONObjBuilder stmtBuilder(opsArray.subobjStart());
+        stmt.serialize(&stmtBuilder);
     }
     try {
         // BSONArrayBuilder will throw a BSONObjectTooLarge exception if we exceeded the max BSON
@@ -34,6 +34,7 @@
 #include "mongo/db/operation_context.h"
 
 #include "mongo/db/client.h"
+#include "mongo/db/operation_context_gen.h"
 #include "mongo/db/operation_key_manager.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
@@ -98,6 +99,7 @@ void OperationContext::setDeadlineAndMaxTime(Date_t when,
     _deadline = when;
     _maxTime = maxTime;
     _timeoutError = timeoutError;
+    _interruptCheckCountdown = 0;
 }
 
 Microseconds OperationContext::computeMaxTimeFromDeadline(Date_t when) {
@@ -218,6 +220,14 @@ bool opShouldFail(Client* client, const BSONObj& failPointInfo) {
 }  // namespace
 
 Status OperationContext::checkForInterruptNoAssert() noexcept {
+    ++_numInterruptChecks;
+    if (_interruptCheckCountdown > 0 && !isKillPending()) {
+        --_interruptCheckCountdown;
+        return Status::OK();
+    }
+    _interruptCheckCountdown = gOperationInterruptCheckInterval.load() - 1;
+    ++_numFullInterruptChecks;
+
     // TODO: Remove the MONGO_likely(hasClientAndServiceContext) once all operation contexts are
     // constructed with clients.
     const auto hasClientAndServiceContext = getClient() && getServiceContext();
@@ -164,9 +164,23 @@ public:
 
     /**
      * Returns Status::OK() unless this operation is in a killed state.
+     *
+     * Only every 'operationInterruptCheckInterval'th call checks the deadline, the client and the
+     * checkForInterruptFail fail point; the calls in between only check the kill status.
      */
     Status checkForInterruptNoAssert() noexcept override;
 
+    /**
+     * Returns how many times checkForInterruptNoAssert() has been called on this operation, and
+     * how many of those calls ran the full set of checks.
+     */
+    long long getNumInterruptChecks() const {
+        return _numInterruptChecks;
+    }
+    long long getNumFullInterruptChecks() const {
+        return _numFullInterruptChecks;
+    }
+
     /**
      * Returns the service context under which this operation context runs, or nullptr if there is
      * no such service context.
@@ -688,6 +702,11 @@ private:
     Date_t _lastClientCheck;
     bool _isExecutingShutdown = false;
 
+    // Number of calls to checkForInterruptNoAssert() left before the next full check.
+    int _interruptCheckCountdown = 0;
+    long long _numInterruptChecks = 0;
+    long long _numFullInterruptChecks = 0;
+
     // Max operation time requested by the user or by the cursor in the case of a getMore with no
     // user-specified maxTimeMS. This is tracked with microsecond granularity for the purpose of
     // assigning unused execution time back to a cursor at the end of an operation, only. The
@@ -41,6 +41,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/operation_context_group.h"
 #include "mongo/db/service_context.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/future.h"
 #include "mongo/stdx/thread.h"
@@ -329,6 +330,45 @@ TEST_F(OperationDeadlineTests, OperationDeadlineExpiration) {
     ASSERT_EQ(ErrorCodes::ExceededTimeLimit, opCtx->checkForInterruptNoAssert());
 }
 
+TEST_F(OperationDeadlineTests, AmortizedInterruptChecks) {
+    RAIIServerParameterControllerForTest interval{"operationInterruptCheckInterval", 4};
+    auto opCtx = client->makeOperationContext();
+    opCtx->setDeadlineAfterNowBy(Seconds{1}, ErrorCodes::ExceededTimeLimit);
+
+    for (int i = 0; i < 6; ++i) {
+        ASSERT_OK(opCtx->checkForInterruptNoAssert());
+    }
+    ASSERT_EQ(6, opCtx->getNumInterruptChecks());
+    ASSERT_EQ(2, opCtx->getNumFullInterruptChecks());
+
+    // An expired deadline is only noticed by the next full check.
+    mockClock->advance(Seconds{2});
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_OK(opCtx->checkForInterruptNoAssert());
+    }
+    ASSERT_EQ(ErrorCodes::ExceededTimeLimit, opCtx->checkForInterruptNoAssert());
+    ASSERT_EQ(3, opCtx->getNumFullInterruptChecks());
+}
+
+TEST_F(OperationDeadlineTests, AmortizedInterruptChecksSeeKillImmediately) {
+    RAIIServerParameterControllerForTest interval{"operationInterruptCheckInterval", 100};
+    auto opCtx = client->makeOperationContext();
+    ASSERT_OK(opCtx->checkForInterruptNoAssert());
+    ASSERT_OK(opCtx->checkForInterruptNoAssert());
+
+    opCtx->markKilled();
+    ASSERT_EQ(ErrorCodes::Interrupted, opCtx->checkForInterruptNoAssert());
+}
+
+TEST_F(OperationDeadlineTests, SettingDeadlineForcesFullInterruptCheck) {
+    RAIIServerParameterControllerForTest interval{"operationInterruptCheckInterval", 100};
+    auto opCtx = client->makeOperationContext();
+    ASSERT_OK(opCtx->checkForInterruptNoAssert());
+
+    opCtx->setDeadlineByDate(mockClock->now(), ErrorCodes::ExceededTimeLimit);
+    ASSERT_EQ(ErrorCodes::ExceededTimeLimit, opCtx->checkForInterruptNoAssert());
+}
+
 TEST_F(OperationDeadlineTests, CancellationTokenIsCanceledAfterDeadlineExpires) {
     auto opCtx = client->makeOperationContext();
     const Seconds timeout{1};
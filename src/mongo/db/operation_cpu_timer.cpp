@@ -155,7 +155,8 @@ Nanoseconds PosixTimer::_getThreadTime() const try {
     LOGV2_FATAL(4744601, "Failed to read the CPU time for the current thread", "error"_attr = ex);
 }
 
-static auto getCPUTimer = OperationContext::declareDecoration<PosixTimer>();
+// Lazy, since only operations which collect resource consumption metrics use the timer.
+static auto getCPUTimer = OperationContext::declareLazyDecoration<PosixTimer>();
 
 }  // namespace
 
@@ -0,0 +1,244 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
+
+#include "mongo/platform/basic.h"
+
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  // defined(__linux__)
+
+#include "mongo/db/operation_perf_counters.h"
+
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/operation_perf_counters_gen.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/errno_util.h"
+
+namespace mongo {
+
+void PerfCounterValues::append(BSONObjBuilder* builder) const {
+    builder->appendNumber("cycles", cycles);
+    builder->appendNumber("instructions", instructions);
+    builder->appendNumber("llcMisses", llcMisses);
+}
+
+#if defined(__linux__)
+
+namespace {
+
+/**
+ * A group of hardware counters measuring the user-space activity of the owning thread. The
+ * counters are opened on first use and closed when the thread exits.
+ */
+class ThreadPerfCounters {
+public:
+    ~ThreadPerfCounters() {
+        for (auto fd : _fds) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    /**
+     * Reads the current counter values. Returns false if the counters could not be opened for
+     * this thread or the read failed.
+     */
+    bool read(PerfCounterValues* out) {
+        if (!_opened) {
+            _opened = true;
+            _open();
+        }
+        if (_fds[0] < 0) {
+            return false;
+        }
+
+        // With PERF_FORMAT_GROUP the leader returns the number of counters followed by each
+        // counter's value, in the order the counters were added to the group.
+        uint64_t buf[1 + kNumCounters];
+        if (::read(_fds[0], buf, sizeof(buf)) != static_cast<ssize_t>(sizeof(buf)) ||
+            buf[0] != kNumCounters) {
+            return false;
+        }
+        out->cycles = static_cast<long long>(buf[1]);
+        out->instructions = static_cast<long long>(buf[2]);
+        out->llcMisses = static_cast<long long>(buf[3]);
+        return true;
+    }
+
+private:
+    static constexpr size_t kNumCounters = 3;
+
+    static int _openCounter(uint64_t config, int groupFd) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        // A pid of 0 and a cpu of -1 count the calling thread on whichever CPU it runs.
+        return syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC);
+    }
+
+    void _open() {
+        const uint64_t configs[kNumCounters] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+
+        for (size_t i = 0; i < kNumCounters; ++i) {
+            _fds[i] = _openCounter(configs[i], i == 0 ? -1 : _fds[0]);
+            if (_fds[i] < 0) {
+                int ec = errno;
+                _logOpenFailureOnce(ec);
+                for (size_t j = 0; j < i; ++j) {
+                    close(_fds[j]);
+                    _fds[j] = -1;
+                }
+                return;
+            }
+        }
+    }
+
+    static void _logOpenFailureOnce(int ec) {
+        static AtomicWord<bool> logged{false};
+        if (!logged.swap(true)) {
+            LOGV2_WARNING(5910800,
+                          "Unable to open hardware performance counters; per-operation counters "
+                          "will not be reported",
+                          "error"_attr = errnoWithDescription(ec));
+        }
+    }
+
+    bool _opened = false;
+    int _fds[kNumCounters] = {-1, -1, -1};
+};
+
+thread_local ThreadPerfCounters threadPerfCounters;
+
+class LinuxPerfCounters final : public OperationPerfCounters {
+public:
+    void start() override {
+        if (_started) {
+            return;
+        }
+        _started = true;
+        _resume();
+    }
+
+    boost::optional<PerfCounterValues> getElapsed() override {
+        if (!_counted) {
+            return boost::none;
+        }
+
+        auto elapsed = _accumulated;
+        PerfCounterValues now;
+        if (_isAttachedToCurrentThread() && threadPerfCounters.read(&now)) {
+            elapsed += now - _baseline;
+        }
+        return elapsed;
+    }
+
+    void onThreadAttach() override {
+        if (_started) {
+            _resume();
+        }
+    }
+
+    void onThreadDetach() override {
+        if (!_started) {
+            return;
+        }
+
+        PerfCounterValues now;
+        if (_isAttachedToCurrentThread() && threadPerfCounters.read(&now)) {
+            _accumulated += now - _baseline;
+        }
+        _threadId.reset();
+    }
+
+private:
+    // Takes a new baseline from the current thread's counters. If they cannot be read, nothing
+    // is counted until the operation moves to a thread where they can.
+    void _resume() {
+        if (threadPerfCounters.read(&_baseline)) {
+            _threadId = stdx::this_thread::get_id();
+            _counted = true;
+        } else {
+            _threadId.reset();
+        }
+    }
+
+    bool _isAttachedToCurrentThread() const {
+        return _threadId && *_threadId == stdx::this_thread::get_id();
+    }
+
+    bool _started = false;
+
+    // Whether the counters could be read on any thread since the operation started.
+    bool _counted = false;
+
+    // Counts from the threads the operation has already been detached from.
+    PerfCounterValues _accumulated;
+
+    // The counter values of the thread identified by '_threadId' when the operation started or
+    // was last attached to it.
+    PerfCounterValues _baseline;
+    boost::optional<stdx::thread::id> _threadId;
+};
+
+// Lazy, since the counters are only used while operationPerfCountersEnabled is set.
+const auto getPerfCounters = OperationContext::declareLazyDecoration<LinuxPerfCounters>();
+
+}  // namespace
+
+OperationPerfCounters* OperationPerfCounters::get(OperationContext* opCtx) {
+    if (!gOperationPerfCountersEnabled.load()) {
+        return nullptr;
+    }
+    return &getPerfCounters(opCtx);
+}
+
+#else  // not defined(__linux__)
+
+OperationPerfCounters* OperationPerfCounters::get(OperationContext*) {
+    return nullptr;
+}
+
+#endif  // defined(__linux__)
+
+}  // namespace mongo
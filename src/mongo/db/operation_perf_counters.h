@@ -0,0 +1,99 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Hardware event counts attributed to an operation.
+ */
+struct PerfCounterValues {
+    long long cycles = 0;
+    long long instructions = 0;
+    long long llcMisses = 0;
+
+    PerfCounterValues& operator+=(const PerfCounterValues& other) {
+        cycles += other.cycles;
+        instructions += other.instructions;
+        llcMisses += other.llcMisses;
+        return *this;
+    }
+
+    PerfCounterValues operator-(const PerfCounterValues& other) const {
+        return {cycles - other.cycles,
+                instructions - other.instructions,
+                llcMisses - other.llcMisses};
+    }
+
+    void append(BSONObjBuilder* builder) const;
+};
+
+/**
+ * Counts CPU cycles, retired instructions and last-level cache misses consumed by an operation,
+ * using per-thread hardware performance counters. This is only available on Linux, when the
+ * 'operationPerfCountersEnabled' server parameter is set and the kernel permits perf_event_open()
+ * for the process. The same threading rules as OperationCPUTimer apply:
+ *
+ * All methods may only be invoked on the thread associated with the operation.
+ *
+ * The counters are paused when the operation's client is detached from the current thread, and
+ * resume against the new thread's counters when the client is reattached.
+ */
+class OperationPerfCounters {
+public:
+    /**
+     * Returns `nullptr` if the counters are disabled or not supported on this platform.
+     */
+    static OperationPerfCounters* get(OperationContext*);
+
+    virtual ~OperationPerfCounters() = default;
+
+    /**
+     * Starts counting. Has no effect if the counters are already running.
+     */
+    virtual void start() = 0;
+
+    /**
+     * Returns the counts accumulated since start(), or boost::none if start() was never called or
+     * the counters could not be read.
+     */
+    virtual boost::optional<PerfCounterValues> getElapsed() = 0;
+
+    virtual void onThreadAttach() = 0;
+    virtual void onThreadDetach() = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/operation_perf_counters.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class OperationPerfCountersTest : public ServiceContextTest {
+public:
+    void setUp() {
+        _opCtx = getGlobalServiceContext()->makeOperationContext(Client::getCurrent());
+    }
+
+    auto getCounters() const {
+        return OperationPerfCounters::get(_opCtx.get());
+    }
+
+private:
+    ServiceContext::UniqueOperationContext _opCtx;
+};
+
+TEST_F(OperationPerfCountersTest, DisabledByDefault) {
+    ASSERT(!getCounters());
+}
+
+#if defined(__linux__)
+
+TEST_F(OperationPerfCountersTest, CountsWorkAfterStart) {
+    RAIIServerParameterControllerForTest enabled("operationPerfCountersEnabled", true);
+    auto counters = getCounters();
+    ASSERT(counters);
+    ASSERT(!counters->getElapsed());
+
+    counters->start();
+    volatile long long sum = 0;
+    for (int i = 0; i < 1000 * 1000; ++i) {
+        sum = sum + i;
+    }
+
+    auto elapsed = counters->getElapsed();
+    if (!elapsed) {
+        // The kernel does not permit hardware counters here, for example inside a container.
+        return;
+    }
+    ASSERT_GT(elapsed->instructions, 1000 * 1000);
+    ASSERT_GT(elapsed->cycles, 0);
+    ASSERT_GTE(elapsed->llcMisses, 0);
+}
+
+#endif  // defined(__linux__)
+
+TEST(PerfCounterValuesTest, Arithmetic) {
+    PerfCounterValues a{10, 20, 3};
+    PerfCounterValues b{4, 5, 1};
+
+    auto diff = a - b;
+    ASSERT_EQ(diff.cycles, 6);
+    ASSERT_EQ(diff.instructions, 15);
+    ASSERT_EQ(diff.llcMisses, 2);
+
+    diff += b;
+    ASSERT_EQ(diff.cycles, a.cycles);
+    ASSERT_EQ(diff.instructions, a.instructions);
+    ASSERT_EQ(diff.llcMisses, a.llcMisses);
+
+    BSONObjBuilder builder;
+    a.append(&builder);
+    ASSERT_BSONOBJ_EQ(builder.obj(),
+                      BSON("cycles" << 10LL << "instructions" << 20LL << "llcMisses" << 3LL));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -210,6 +210,57 @@ void DeleteOp::validate(const DeleteCommandRequest& deleteOp) {
     checkOpCountForCommand(deleteOp, deleteOp.getDeletes().size());
 }
 
+std::vector<BulkWriteOp::WriteCommandRequest> BulkWriteOp::parse(
+    const write_ops::BulkWriteCommandRequest& request, bool assignStmtIds) {
+    const auto& ops = request.getOps();
+    uassert(ErrorCodes::InvalidLength,
+            str::stream() << "bulkWrite must contain between 1 and "
+                          << write_ops::kMaxWriteBatchSize << " write commands. Got "
+                          << ops.size() << " write commands.",
+            !ops.empty() && ops.size() <= write_ops::kMaxWriteBatchSize);
+
+    std::vector<WriteCommandRequest> writeCommands;
+    writeCommands.reserve(ops.size());
+
+    int32_t nextStmtId = 0;
+    for (const auto& op : ops) {
+        const auto opMsgRequest = OpMsgRequest::fromDBAndBody(request.getDbName(), op);
+        const auto cmdName = op.firstElementFieldNameStringData();
+
+        auto setStmtIds = [&](auto& writeCommand, size_t numStatements) {
+            auto& writeCommandBase = writeCommand.getWriteCommandRequestBase();
+            uassert(ErrorCodes::InvalidOptions,
+                    "The write commands of a bulkWrite command may not specify statement ids",
+                    !writeCommandBase.getStmtId() && !writeCommandBase.getStmtIds());
+            if (assignStmtIds) {
+                writeCommandBase.setStmtId(nextStmtId);
+                nextStmtId += numStatements;
+            }
+        };
+
+        if (cmdName == write_ops::InsertCommandRequest::kCommandName) {
+            auto insertOp = InsertOp::parse(opMsgRequest);
+            setStmtIds(insertOp, insertOp.getDocuments().size());
+            writeCommands.emplace_back(std::move(insertOp));
+        } else if (cmdName == write_ops::UpdateCommandRequest::kCommandName) {
+            auto updateOp = UpdateOp::parse(opMsgRequest);
+            setStmtIds(updateOp, updateOp.getUpdates().size());
+            writeCommands.emplace_back(std::move(updateOp));
+        } else if (cmdName == write_ops::DeleteCommandRequest::kCommandName) {
+            auto deleteOp = DeleteOp::parse(opMsgRequest);
+            setStmtIds(deleteOp, deleteOp.getDeletes().size());
+            writeCommands.emplace_back(std::move(deleteOp));
+        } else {
+            uasserted(ErrorCodes::FailedToParse,
+                      str::stream() << "bulkWrite only supports insert, update and delete write "
+                                       "commands. Got: "
+                                    << cmdName);
+        }
+    }
+
+    return writeCommands;
+}
+
 write_ops::UpdateModification write_ops::UpdateModification::parseFromOplogEntry(
     const BSONObj& oField, const DiffOptions& options) {
     BSONElement vField = oField[kUpdateOplogEntryVersionFieldName];
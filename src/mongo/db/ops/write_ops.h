@@ -32,6 +32,7 @@
 #include "mongo/db/ops/write_ops_gen.h"
 #include "mongo/rpc/message.h"
 #include "mongo/rpc/op_msg.h"
+#include "mongo/stdx/variant.h"
 
 namespace mongo {
 
@@ -65,6 +66,22 @@ public:
     static write_ops::FindAndModifyCommandReply parseResponse(const BSONObj& obj);
 };
 
+class BulkWriteOp {
+public:
+    using WriteCommandRequest = stdx::variant<write_ops::InsertCommandRequest,
+                                              write_ops::UpdateCommandRequest,
+                                              write_ops::DeleteCommandRequest>;
+
+    /**
+     * Parses each entry of the 'ops' array of 'request' as an insert, update or delete command on
+     * the bulkWrite command's database. If 'assignStmtIds' is true, each write command is given
+     * the statement ids following those of the write command before it, so that the statements of
+     * a retried bulkWrite command are recognized regardless of which write command they are in.
+     */
+    static std::vector<WriteCommandRequest> parse(const write_ops::BulkWriteCommandRequest& request,
+                                                  bool assignStmtIds);
+};
+
 namespace write_ops {
 
 // Limit of the number of operations that can be included in a single write command. This is an
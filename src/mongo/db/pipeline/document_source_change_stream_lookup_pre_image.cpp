@@ -113,19 +113,22 @@ DocumentSource::GetNextResult DocumentSourceChangeStreamAddPreImage::doGetNext()
 }
 
 boost::optional<Document> DocumentSourceChangeStreamAddPreImage::lookupPreImage(
-    const Document& inputDoc, const repl::OpTime& opTime) const {
+    const Document& inputDoc, const repl::OpTime& opTime) {
     // We need the oplog's UUID for lookup, so obtain the collection info via MongoProcessInterface.
-    auto localOplogInfo = pExpCtx->mongoProcessInterface->getCollectionOptions(
-        pExpCtx->opCtx, NamespaceString::kRsOplogNamespace);
+    if (!_oplogUUID) {
+        auto localOplogInfo = pExpCtx->mongoProcessInterface->getCollectionOptions(
+            pExpCtx->opCtx, NamespaceString::kRsOplogNamespace);
 
-    // Extract the UUID from the collection information. We should always have a valid uuid here.
-    auto oplogUUID = invariantStatusOK(UUID::parse(localOplogInfo["uuid"]));
+        // Extract the UUID from the collection information. We should always have a valid uuid
+        // here.
+        _oplogUUID = invariantStatusOK(UUID::parse(localOplogInfo["uuid"]));
+    }
 
     // Look up the pre-image oplog entry using the opTime as the query filter.
     auto lookedUpDoc =
         pExpCtx->mongoProcessInterface->lookupSingleDocument(pExpCtx,
                                                              NamespaceString::kRsOplogNamespace,
-                                                             oplogUUID,
+                                                             *_oplogUUID,
                                                              Document{opTime.asQuery()},
                                                              boost::none);
 
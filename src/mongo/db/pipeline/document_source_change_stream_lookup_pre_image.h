@@ -123,8 +123,7 @@ private:
      * pre-image mode is "kRequired" and no entry was found. Invariants that if an oplog entry with
      * the given opTime is found, it is a no-op entry with a valid non-empty pre-image document.
      */
-    boost::optional<Document> lookupPreImage(const Document& inputDoc,
-                                             const repl::OpTime& opTime) const;
+    boost::optional<Document> lookupPreImage(const Document& inputDoc, const repl::OpTime& opTime);
 
     Value serializeLegacy(boost::optional<ExplainOptions::Verbosity> explain) const final;
     Value serializeLatest(boost::optional<ExplainOptions::Verbosity> explain) const final;
@@ -132,6 +131,10 @@ private:
     // Determines whether pre-images are strictly required or may be included only when available.
     FullDocumentBeforeChangeModeEnum _fullDocumentBeforeChangeMode =
         FullDocumentBeforeChangeModeEnum::kOff;
+
+    // The UUID of the oplog, which is fetched from the catalog by the first lookup. The oplog is
+    // never recreated while the node is running, so it does not need to be fetched again.
+    boost::optional<UUID> _oplogUUID;
 };
 
 }  // namespace mongo
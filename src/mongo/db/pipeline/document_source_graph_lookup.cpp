@@ -239,7 +239,7 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
         // Check whether each key in the frontier exists in the cache or needs to be queried.
         auto cached = pExpCtx->getDocumentComparator().makeUnorderedDocumentSet();
-        auto matchStage = makeMatchStageFromFrontier(&cached);
+        auto matchStages = makeMatchStagesFromFrontier(&cached);
 
         ValueUnorderedSet queried = pExpCtx->getValueComparator().makeUnorderedValueSet();
         _frontier.swap(queried);
@@ -254,12 +254,11 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
             checkMemoryUsage();
         }
 
-        if (matchStage) {
-            // Query for all keys that were in the frontier and not in the cache, populating
-            // '_frontier' for the next iteration of search.
-
+        // Query for all keys that were in the frontier and not in the cache, populating
+        // '_frontier' for the next iteration of search.
+        for (auto&& matchStage : matchStages) {
             // We've already allocated space for the trailing $match stage in '_fromPipeline'.
-            _fromPipeline.back() = *matchStage;
+            _fromPipeline.back() = std::move(matchStage);
             MakePipelineOptions pipelineOpts;
             pipelineOpts.optimize = true;
             pipelineOpts.attachCursorSource = true;
@@ -379,7 +378,7 @@ void DocumentSourceGraphLookUp::addToCache(const Document& result,
         });
 }
 
-boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
+std::vector<BSONObj> DocumentSourceGraphLookUp::makeMatchStagesFromFrontier(
     DocumentUnorderedSet* cached) {
     // Add any cached values to 'cached' and remove them from '_frontier'.
     for (auto it = _frontier.begin(); it != _frontier.end();) {
@@ -397,6 +396,27 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
         }
     }
 
+    // Split the remaining values into batches, so that each query stays well below the maximum
+    // BSON object size no matter how wide the frontier is.
+    const int maxBatchBytes = BSONObjMaxUserSize / 2;
+    const int maxBatchValues = internalDocumentSourceGraphLookupFrontierBatchSize.load();
+
+    std::vector<BSONObj> matchStages;
+    for (auto it = _frontier.begin(); it != _frontier.end();) {
+        BSONArrayBuilder in;
+        int numValues = 0;
+        do {
+            in << *it;
+            ++it;
+            ++numValues;
+        } while (it != _frontier.end() && in.len() < maxBatchBytes &&
+                 (maxBatchValues == 0 || numValues < maxBatchValues));
+        matchStages.push_back(makeMatchStage(in.arr()));
+    }
+    return matchStages;
+}
+
+BSONObj DocumentSourceGraphLookUp::makeMatchStage(const BSONArray& values) const {
     // Create a query of the form {$and: [_additionalFilter, {_connectToField: {$in: [...]}}]}.
     //
     // We wrap the query in a $match so that it can be parsed into a DocumentSourceMatch when
@@ -414,18 +434,12 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
                 BSONObjBuilder connectToObj(andObj.subobjStart());
                 {
                     BSONObjBuilder subObj(connectToObj.subobjStart(_connectToField.fullPath()));
-                    {
-                        BSONArrayBuilder in(subObj.subarrayStart("$in"));
-                        for (auto&& value : _frontier) {
-                            in << value;
-                        }
-                    }
+                    subObj.append("$in", values);
                 }
             }
         }
     }
-
-    return _frontier.empty() ? boost::none : boost::optional<BSONObj>(match.obj());
+    return match.obj();
 }
 
 void DocumentSourceGraphLookUp::performSearch() {
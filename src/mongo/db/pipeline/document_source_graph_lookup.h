@@ -176,15 +176,22 @@ private:
     }
 
     /**
-     * Prepares the query to execute on the 'from' collection wrapped in a $match by using the
-     * contents of '_frontier'.
+     * Prepares the queries to execute on the 'from' collection wrapped in a $match by using the
+     * contents of '_frontier'. A large frontier is split across several queries, each bounded in
+     * size and in number of values.
      *
      * Fills 'cached' with any values that were retrieved from the cache.
      *
-     * Returns boost::none if no query is necessary, i.e., all values were retrieved from the cache.
-     * Otherwise, returns a query object.
+     * Returns an empty vector if no query is necessary, i.e., all values were retrieved from the
+     * cache.
      */
-    boost::optional<BSONObj> makeMatchStageFromFrontier(DocumentUnorderedSet* cached);
+    std::vector<BSONObj> makeMatchStagesFromFrontier(DocumentUnorderedSet* cached);
+
+    /**
+     * Returns a $match stage selecting the documents of the 'from' collection whose
+     * 'connectToField' is one of 'values' and which pass the 'restrictSearchWithMatch' filter.
+     */
+    BSONObj makeMatchStage(const BSONArray& values) const;
 
     /**
      * If we have internalized a $unwind, getNext() dispatches to this function.
@@ -34,6 +34,7 @@
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/exec/document_value/value_comparator.h"
+#include "mongo/db/index/sort_key_generator.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source_group.h"
@@ -115,9 +116,9 @@ DocumentSource::GetModPathsReturn GroupFromFirstDocumentTransformation::getModif
 
 std::unique_ptr<GroupFromFirstDocumentTransformation> GroupFromFirstDocumentTransformation::create(
     const intrusive_ptr<ExpressionContext>& expCtx,
-    const std::string& groupId,
+    std::vector<std::string> groupIds,
     vector<pair<std::string, intrusive_ptr<Expression>>> accumulatorExprs) {
-    return std::make_unique<GroupFromFirstDocumentTransformation>(groupId,
+    return std::make_unique<GroupFromFirstDocumentTransformation>(std::move(groupIds),
                                                                   std::move(accumulatorExprs));
 }
 
@@ -133,36 +134,60 @@ const char* DocumentSourceGroup::getSourceName() const {
 }
 
 bool DocumentSourceGroup::shouldSpillWithAttemptToSaveMemory() {
-    if (!_memoryTracker._allowDiskUse &&
-        (_memoryTracker.currentMemoryBytes() >
-         static_cast<long long>(_memoryTracker._maxAllowedMemoryUsageBytes))) {
+    // The operation or the node being over its memory limit counts as this stage being over its
+    // own limit.
+    auto exceedsMemoryLimit = [&] {
+        return _memoryTracker.currentMemoryBytes() >
+            static_cast<long long>(_memoryTracker._maxAllowedMemoryUsageBytes) ||
+            _memoryTracker.operationMemoryLimitExceeded();
+    };
+
+    if (!_memoryTracker._allowDiskUse && exceedsMemoryLimit()) {
         freeMemory();
     }
 
-    if (_memoryTracker.currentMemoryBytes() >
-        static_cast<long long>(_memoryTracker._maxAllowedMemoryUsageBytes)) {
+    if (exceedsMemoryLimit()) {
         uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
                 "Exceeded memory limit for $group, but didn't allow external sort."
                 " Pass allowDiskUse:true to opt in.",
                 _memoryTracker._allowDiskUse);
         _memoryTracker.resetCurrent();
+        _groupsMemoryBytesTracked = 0;
         return true;
     }
     return false;
 }
 
+void DocumentSourceGroup::updateGroupsMemoryUsage() {
+    // Every slot of the table holds an entry inline, plus one control byte.
+    const long long tableBytes = _groups->capacity() * (sizeof(GroupsMap::value_type) + 1);
+    const long long groupsMemoryBytes = _groupsMemoryBytes + tableBytes;
+    _memoryTracker.set(_memoryTracker.currentMemoryBytes() + groupsMemoryBytes -
+                       _groupsMemoryBytesTracked);
+    _groupsMemoryBytesTracked = groupsMemoryBytes;
+}
+
+void DocumentSourceGroup::detachFromOperationContext() {
+    _memoryTracker.setOperationTracker(nullptr);
+}
+
+void DocumentSourceGroup::reattachToOperationContext(OperationContext* opCtx) {
+    _memoryTracker.setOperationTracker(&OperationMemoryUsageTracker::get(opCtx));
+}
+
 void DocumentSourceGroup::freeMemory() {
     invariant(_groups);
     for (auto&& group : *_groups) {
-        for (size_t i = 0; i < group.second.size(); i++) {
+        auto& accumulators = group.second.accumulators;
+        for (size_t i = 0; i < accumulators.size(); i++) {
             // Subtract the current usage.
             _memoryTracker.update(_accumulatedFields[i].fieldName,
-                                  -1 * group.second[i]->getMemUsage());
+                                  -1 * accumulators[i]->getMemUsage());
 
-            group.second[i]->reduceMemoryConsumptionIfAble();
+            accumulators[i]->reduceMemoryConsumptionIfAble();
 
             // Update the memory usage for this AccumulationStatement.
-            _memoryTracker.update(_accumulatedFields[i].fieldName, group.second[i]->getMemUsage());
+            _memoryTracker.update(_accumulatedFields[i].fieldName, accumulators[i]->getMemUsage());
         }
     }
 }
@@ -237,7 +262,8 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
     if (_groups->empty())
         return GetNextResult::makeEOF();
 
-    Document out = makeDocument(groupsIterator->first, groupsIterator->second, pExpCtx->needsMerge);
+    Document out = makeDocument(
+        groupId(*groupsIterator), groupsIterator->second.accumulators, pExpCtx->needsMerge);
 
     if (++groupsIterator == _groups->end())
         dispose();
@@ -247,11 +273,15 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
 
 void DocumentSourceGroup::doDispose() {
     // Free our resources.
-    _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+    _groups = makeGroupsMap();
+    _groupsMemoryBytes = 0;
+    updateGroupsMemoryUsage();
     _sorterIterator.reset();
 
     // Make us look done.
     groupsIterator = _groups->end();
+
+    _memoryTracker.setOperationTracker(nullptr);
 }
 
 intrusive_ptr<DocumentSource> DocumentSourceGroup::optimize() {
@@ -318,6 +348,10 @@ Value DocumentSourceGroup::serialize(boost::optional<ExplainOptions::Verbosity>
             Value(static_cast<long long>(_stats.totalOutputDataSizeBytes));
         out["usedDisk"] = Value(_stats.spills > 0);
         out["spills"] = Value(static_cast<long long>(_stats.spills));
+        if (_stats.spills > 0) {
+            out["spilledBytes"] = Value(static_cast<long long>(_stats.spilledBytes));
+            out["spillTimeMicros"] = Value(static_cast<long long>(_stats.spillTimeMicros));
+        }
     }
 
     return Value(out.freezeToValue());
@@ -405,8 +439,12 @@ DocumentSourceGroup::DocumentSourceGroup(const intrusive_ptr<ExpressionContext>&
               ? std::make_shared<Sorter<Value, Value>::File>(expCtx->tempDir + "/" + nextFileName())
               : nullptr),
       _initialized(false),
-      _groups(expCtx->getValueComparator().makeUnorderedValueMap<Accumulators>()),
-      _spilled(false) {}
+      _groups(makeGroupsMap()),
+      _spilled(false) {
+    if (expCtx->opCtx) {
+        _memoryTracker.setOperationTracker(&OperationMemoryUsageTracker::get(expCtx->opCtx));
+    }
+}
 
 void DocumentSourceGroup::addAccumulator(AccumulationStatement accumulationStatement) {
     _accumulatedFields.push_back(accumulationStatement);
@@ -519,7 +557,8 @@ public:
     SpillSTLComparator(ValueComparator valueComparator) : _valueComparator(valueComparator) {}
 
     bool operator()(const GroupsMap::value_type* lhs, const GroupsMap::value_type* rhs) const {
-        return _valueComparator.evaluate(lhs->first < rhs->first);
+        return _valueComparator.evaluate(DocumentSourceGroup::groupId(*lhs) <
+                                         DocumentSourceGroup::groupId(*rhs));
     }
 
 private:
@@ -542,17 +581,22 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
         // iteration. Not releasing could lead to an array copy when this group follows an unwind.
         auto rootDocument = input.releaseDocument();
         Value id = computeId(rootDocument);
+        const auto collator = pExpCtx->getCollator();
 
         // Look for the _id value in the map. If it's not there, add a new entry with a blank
-        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
-        // looking it up in '_groups' multiple times.
-        const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<AccumulatorState>>& group = (*_groups)[id];
-        const bool inserted = _groups->size() != oldSize;
+        // accumulator. The reference to the entry is only valid until the next insertion.
+        auto [groupIt, inserted] =
+            _groups->try_emplace(SortKeyGenerator::getCollationComparisonKey(id, collator));
+        Accumulators& group = groupIt->second.accumulators;
 
-        vector<uint64_t> oldAccumMemUsage(numAccumulators, 0);
         if (inserted) {
-            _memoryTracker.set(_memoryTracker.currentMemoryBytes() + id.getApproximateSize());
+            _groupsMemoryBytes += groupIt->first.getApproximateSize() +
+                numAccumulators * sizeof(Accumulators::value_type);
+            if (collator) {
+                _groupsMemoryBytes += id.getApproximateSize();
+                groupIt->second.id = id;
+            }
+            updateGroupsMemoryUsage();
 
             // Initialize and add the accumulators
             Value expandedId = expandId(id);
@@ -613,7 +657,9 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
                 }
 
                 // We won't be using groups again so free its memory.
-                _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+                _groups = makeGroupsMap();
+                _groupsMemoryBytes = 0;
+                updateGroupsMemoryUsage();
 
                 _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
                     _sortedFiles, SortOptions(), SorterComparator(pExpCtx->getValueComparator())));
@@ -652,27 +698,28 @@ shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
     stable_sort(ptrs.begin(), ptrs.end(), SpillSTLComparator(pExpCtx->getValueComparator()));
 
     SortedFileWriter<Value, Value> writer(SortOptions().TempDir(pExpCtx->tempDir), _file);
-    switch (_accumulatedFields.size()) {  // same as ptrs[i]->second.size() for all i.
+    switch (_accumulatedFields.size()) {  // same as each group's accumulators.size().
         case 0:                           // no values, essentially a distinct
             for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first, Value());
+                writer.addAlreadySorted(groupId(*ptrs[i]), Value());
             }
             break;
 
         case 1:  // just one value, use optimized serialization as single Value
             for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first,
-                                        ptrs[i]->second[0]->getValue(/*toBeMerged=*/true));
+                writer.addAlreadySorted(
+                    groupId(*ptrs[i]),
+                    ptrs[i]->second.accumulators[0]->getValue(/*toBeMerged=*/true));
             }
             break;
 
         default:  // multiple values, serialize as array-typed Value
             for (size_t i = 0; i < ptrs.size(); i++) {
                 vector<Value> accums;
-                for (size_t j = 0; j < ptrs[i]->second.size(); j++) {
-                    accums.push_back(ptrs[i]->second[j]->getValue(/*toBeMerged=*/true));
+                for (auto&& accumulator : ptrs[i]->second.accumulators) {
+                    accums.push_back(accumulator->getValue(/*toBeMerged=*/true));
                 }
-                writer.addAlreadySorted(ptrs[i]->first, Value(std::move(accums)));
+                writer.addAlreadySorted(groupId(*ptrs[i]), Value(std::move(accums)));
             }
             break;
     }
@@ -683,15 +730,24 @@ shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
 
     _groups->clear();
     // Zero out the current per-accumulation statement memory consumption, as the memory has been
-    // freed by spilling.
+    // freed by spilling. The table itself may keep its slots for the next groups.
     for (auto accum : _accumulatedFields) {
         _memoryTracker.set(accum.fieldName, 0);
     }
+    _groupsMemoryBytes = 0;
+    updateGroupsMemoryUsage();
 
     Sorter<Value, Value>::Iterator* iteratorPtr = writer.done();
+    // The spill file is shared by all runs of this stage, so its statistics are cumulative.
+    _stats.spilledBytes = _file->stats().bytesWritten.load();
+    _stats.spillTimeMicros = _file->stats().spillMicros.load();
     return shared_ptr<Sorter<Value, Value>::Iterator>(iteratorPtr);
 }
 
+DocumentSourceGroup::GroupsMap DocumentSourceGroup::makeGroupsMap() {
+    return ValueComparator().makeFlatUnorderedValueMap<Group>();
+}
+
 Value DocumentSourceGroup::computeId(const Document& root) {
     // If only one expression, return result directly
     if (_idExpressions.size() == 1) {
@@ -813,27 +869,38 @@ bool DocumentSourceGroup::canRunInParallelBeforeWriteStage(
 
 std::unique_ptr<GroupFromFirstDocumentTransformation>
 DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
-    if (_idExpressions.size() != 1) {
-        // This transformation is only intended for $group stages that group on a single field.
+    // This transformation is only intended for $group stages that group on a single field, or on
+    // an object whose every field is a field path, such as {_id: {a: "$a", b: "$b"}}.
+    if (_idExpressions.size() != 1 && _idFieldNames.empty()) {
         return nullptr;
     }
 
-    auto fieldPathExpr = dynamic_cast<ExpressionFieldPath*>(_idExpressions.front().get());
-    if (!fieldPathExpr || fieldPathExpr->isVariableReference()) {
-        return nullptr;
-    }
+    std::vector<std::string> groupIds;
+    for (auto&& idExpression : _idExpressions) {
+        auto fieldPathExpr = dynamic_cast<ExpressionFieldPath*>(idExpression.get());
+        if (!fieldPathExpr || fieldPathExpr->isVariableReference()) {
+            return nullptr;
+        }
 
-    const auto fieldPath = fieldPathExpr->getFieldPath();
-    if (fieldPath.getPathLength() == 1) {
-        // The path is $$CURRENT or $$ROOT. This isn't really a sensible value to group by (since
-        // each document has a unique _id, it will just return the entire collection). We only
-        // apply the rewrite when grouping by a single field, so we cannot apply it in this case,
-        // where we are grouping by the entire document.
-        invariant(fieldPath.getFieldName(0) == "CURRENT" || fieldPath.getFieldName(0) == "ROOT");
-        return nullptr;
-    }
+        const auto fieldPath = fieldPathExpr->getFieldPath();
+        if (fieldPath.getPathLength() == 1) {
+            // The path is $$CURRENT or $$ROOT. This isn't really a sensible value to group by
+            // (since each document has a unique _id, it will just return the entire collection).
+            // We only apply the rewrite when grouping by fields, so we cannot apply it in this
+            // case, where we are grouping by the entire document.
+            invariant(fieldPath.getFieldName(0) == "CURRENT" ||
+                      fieldPath.getFieldName(0) == "ROOT");
+            return nullptr;
+        }
 
-    const auto groupId = fieldPath.tail().fullPath();
+        auto groupId = fieldPath.tail().fullPath();
+        if (std::find(groupIds.begin(), groupIds.end(), groupId) != groupIds.end()) {
+            // The same field appears twice in the _id, e.g. {_id: {x: "$a", y: "$a"}}. Grouping
+            // by it once is equivalent, but keep the rewrite to the simple cases.
+            return nullptr;
+        }
+        groupIds.push_back(std::move(groupId));
+    }
 
     // We can't do this transformation if there are any non-$first accumulators.
     for (auto&& accumulator : _accumulatedFields) {
@@ -846,14 +913,17 @@ DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
     std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> fields;
 
     boost::intrusive_ptr<Expression> idField;
-    // The _id field can be specified either as a fieldpath (ex. _id: "$a") or as a singleton
-    // object (ex. _id: {v: "$a"}).
+    // The _id field can be specified either as a fieldpath (ex. _id: "$a") or as an object of
+    // fieldpaths (ex. _id: {v: "$a", w: "$b"}).
     if (_idFieldNames.empty()) {
-        idField = ExpressionFieldPath::deprecatedCreate(pExpCtx.get(), groupId);
+        idField = ExpressionFieldPath::deprecatedCreate(pExpCtx.get(), groupIds.front());
     } else {
-        invariant(_idFieldNames.size() == 1);
-        idField = ExpressionObject::create(pExpCtx.get(),
-                                           {{_idFieldNames.front(), _idExpressions.front()}});
+        invariant(_idFieldNames.size() == _idExpressions.size());
+        std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> idFields;
+        for (size_t i = 0; i < _idFieldNames.size(); ++i) {
+            idFields.emplace_back(_idFieldNames[i], _idExpressions[i]);
+        }
+        idField = ExpressionObject::create(pExpCtx.get(), std::move(idFields));
     }
     fields.push_back(std::make_pair("_id", idField));
 
@@ -864,7 +934,8 @@ DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
         // the initializer should always be trivial.
     }
 
-    return GroupFromFirstDocumentTransformation::create(pExpCtx, groupId, std::move(fields));
+    return GroupFromFirstDocumentTransformation::create(
+        pExpCtx, std::move(groupIds), std::move(fields));
 }
 
 size_t DocumentSourceGroup::getMaxMemoryUsageBytes() const {
@@ -50,20 +50,21 @@ namespace mongo {
 class GroupFromFirstDocumentTransformation final : public TransformerInterface {
 public:
     GroupFromFirstDocumentTransformation(
-        const std::string& groupId,
+        std::vector<std::string> groupIds,
         std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> accumulatorExprs)
-        : _accumulatorExprs(std::move(accumulatorExprs)), _groupId(groupId) {}
+        : _accumulatorExprs(std::move(accumulatorExprs)), _groupIds(std::move(groupIds)) {}
 
     TransformerType getType() const final {
         return TransformerType::kGroupFromFirstDocument;
     }
 
     /**
-     * The path of the field that we are grouping on: i.e., the field in the input document that we
-     * will use to create the _id field of the ouptut document.
+     * The paths of the fields that we are grouping on: i.e., the fields in the input document that
+     * we will use to create the _id field of the ouptut document. There is more than one only when
+     * grouping by an object such as {_id: {a: "$a", b: "$b"}}.
      */
-    const std::string& groupId() const {
-        return _groupId;
+    const std::vector<std::string>& groupIds() const {
+        return _groupIds;
     }
 
     Document applyTransformation(const Document& input) final;
@@ -79,18 +80,35 @@ public:
 
     static std::unique_ptr<GroupFromFirstDocumentTransformation> create(
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
-        const std::string& groupId,
+        std::vector<std::string> groupIds,
         std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> accumulatorExprs);
 
 private:
     std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> _accumulatorExprs;
-    std::string _groupId;
+    std::vector<std::string> _groupIds;
 };
 
 class DocumentSourceGroup final : public DocumentSource {
 public:
     using Accumulators = std::vector<boost::intrusive_ptr<AccumulatorState>>;
-    using GroupsMap = ValueUnorderedMap<Accumulators>;
+
+    /**
+     * A group in '_groups'. Groups are keyed by the collation comparison key of their _id, so that
+     * looking up a group compares keys bytewise instead of running the collator. 'id' holds the
+     * first _id value seen for the group, and is only set when the stage has a collator.
+     */
+    struct Group {
+        Value id;
+        Accumulators accumulators;
+    };
+    using GroupsMap = ValueFlatUnorderedMap<Group>;
+
+    /**
+     * Returns the _id of a group in '_groups'.
+     */
+    static const Value& groupId(const GroupsMap::value_type& group) {
+        return group.second.id.missing() ? group.first : group.second.id;
+    }
 
     static constexpr StringData kStageName = "$group"_sd;
 
@@ -189,6 +207,9 @@ public:
      */
     size_t getMaxMemoryUsageBytes() const;
 
+    void detachFromOperationContext() final;
+    void reattachToOperationContext(OperationContext* opCtx) final;
+
 protected:
     GetNextResult doGetNext() final;
     void doDispose() final;
@@ -237,6 +258,11 @@ private:
      */
     Value computeId(const Document& root);
 
+    /**
+     * Returns an empty table for '_groups'.
+     */
+    static GroupsMap makeGroupsMap();
+
     /**
      * Converts the internal representation of the group key to the _id shape specified by the
      * user.
@@ -256,6 +282,13 @@ private:
      */
     bool shouldSpillWithAttemptToSaveMemory();
 
+    /**
+     * Brings the part of the tracked memory usage which is not owned by the accumulators up to date
+     * with the group keys and accumulator vectors in '_groupsMemoryBytes' and the size of the
+     * table of '_groups'.
+     */
+    void updateGroupsMemoryUsage();
+
     std::vector<AccumulationStatement> _accumulatedFields;
 
     bool _doingMerge;
@@ -274,11 +307,15 @@ private:
     Value _currentId;
     Accumulators _currentAccumulators;
 
-    // We use boost::optional to defer initialization until the ExpressionContext containing the
-    // correct comparator is injected, since the groups must be built using the comparator's
-    // definition of equality.
+    // Keyed by the collation comparison keys of the group _ids, which are compared with the simple
+    // collation.
     boost::optional<GroupsMap> _groups;
 
+    // The memory used by the group keys and the accumulator vectors of '_groups', and the part of
+    // the tracked memory usage currently accounting for them and for the table itself.
+    long long _groupsMemoryBytes = 0;
+    long long _groupsMemoryBytesTracked = 0;
+
     std::vector<std::shared_ptr<Sorter<Value, Value>::Iterator>> _sortedFiles;
     bool _spilled;
 
@@ -50,6 +50,7 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/unordered_set.h"
@@ -207,6 +208,65 @@ TEST_F(DocumentSourceGroupTest, ShouldCorrectlyTrackMemoryUsageBetweenPauses) {
         group->getNext(), AssertionException, ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
 }
 
+TEST_F(DocumentSourceGroupTest, ShouldCountGroupTableTowardsMemoryLimit) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+                              // This is the only way to do this in a debug build.
+
+    // Without accumulators, the memory is used by the group keys and by the table holding them.
+    // The keys alone are 200 * sizeof(Value) bytes, well under the limit.
+    const size_t maxMemoryUsageBytes = 4 * 1024;
+    auto groupByExpression =
+        ExpressionFieldPath::parse(expCtx.get(), "$_id", expCtx->variablesParseState);
+    auto group = DocumentSourceGroup::create(expCtx, groupByExpression, {}, maxMemoryUsageBytes);
+
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < 200; ++i) {
+        inputs.emplace_back(Document{{"_id", i}});
+    }
+    auto mock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+    group->setSource(mock.get());
+
+    ASSERT_THROWS_CODE(
+        group->getNext(), AssertionException, ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldGroupByCollationAndReturnFirstSeenId) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+                              // This is the only way to do this in a debug build.
+    expCtx->setCollator(
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kToLowerString));
+
+    auto&& parser = AccumulationStatement::getParser("$sum", boost::none);
+    auto accumulatorArg = BSON("" << "$n");
+    auto accExpr = parser(expCtx.get(), accumulatorArg.firstElement(), expCtx->variablesParseState);
+    AccumulationStatement sumStatement{"sum", accExpr};
+    auto groupByExpression =
+        ExpressionFieldPath::parse(expCtx.get(), "$_id", expCtx->variablesParseState);
+    auto group = DocumentSourceGroup::create(expCtx, groupByExpression, {sumStatement});
+    auto mock = DocumentSourceMock::createForTest({"{_id: 'abc', n: 1}",
+                                                   "{_id: 'ABC', n: 2}",
+                                                   "{_id: 'b', n: 4}",
+                                                   "{_id: ['X', {a: 'Y'}], n: 8}",
+                                                   "{_id: ['x', {a: 'y'}], n: 16}"},
+                                                  expCtx);
+    group->setSource(mock.get());
+
+    std::vector<Document> results;
+    for (auto next = group->getNext(); next.isAdvanced(); next = group->getNext()) {
+        results.push_back(next.releaseDocument());
+    }
+    std::sort(results.begin(), results.end(), [](const Document& lhs, const Document& rhs) {
+        return lhs["sum"].getInt() < rhs["sum"].getInt();
+    });
+
+    ASSERT_EQ(3U, results.size());
+    ASSERT_DOCUMENT_EQ(results[0], (Document{{"_id", "abc"_sd}, {"sum", 3}}));
+    ASSERT_DOCUMENT_EQ(results[1], (Document{{"_id", "b"_sd}, {"sum", 4}}));
+    ASSERT_DOCUMENT_EQ(results[2], Document(fromjson("{_id: ['X', {a: 'Y'}], sum: 24}")));
+}
+
 TEST_F(DocumentSourceGroupTest, ShouldReportSingleFieldGroupKeyAsARename) {
     auto expCtx = getExpCtx();
     VariablesParseState vps = expCtx->variablesParseState;
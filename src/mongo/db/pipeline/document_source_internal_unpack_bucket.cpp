@@ -42,6 +42,8 @@
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/matcher/expression_internal_expr_comparison.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/pipeline/document_source_add_fields.h"
 #include "mongo/db/pipeline/document_source_geo_near.h"
 #include "mongo/db/pipeline/document_source_group.h"
@@ -52,6 +54,7 @@
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/util/make_data_structure.h"
 #include "mongo/db/timeseries/timeseries_constants.h"
 #include "mongo/logv2/log.h"
@@ -296,6 +299,7 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createF
     auto hasBucketMaxSpanSeconds = false;
     auto bucketMaxSpanSeconds = 0;
     std::vector<std::string> computedMetaProjFields;
+    BSONObj eventFilter;
     for (auto&& elem : specElem.embeddedObject()) {
         auto fieldName = elem.fieldNameStringData();
         if (fieldName == kInclude || fieldName == kExclude) {
@@ -372,6 +376,11 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createF
                                   << elem.type(),
                     elem.type() == BSONType::Bool);
             bucketSpec.includeBucketIdAndRowIndex = elem.boolean();
+        } else if (fieldName == kEventFilter) {
+            uassert(6100001,
+                    str::stream() << "eventFilter field must be an object, got: " << elem.type(),
+                    elem.type() == BSONType::Object);
+            eventFilter = elem.embeddedObject();
         } else {
             uasserted(5346506,
                       str::stream()
@@ -386,8 +395,12 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createF
             "The $_internalUnpackBucket stage requires a bucketMaxSpanSeconds parameter",
             hasBucketMaxSpanSeconds);
 
-    return make_intrusive<DocumentSourceInternalUnpackBucket>(
+    auto stage = make_intrusive<DocumentSourceInternalUnpackBucket>(
         expCtx, BucketUnpacker{std::move(bucketSpec), unpackerBehavior}, bucketMaxSpanSeconds);
+    if (!eventFilter.isEmpty()) {
+        stage->setEventFilter(eventFilter);
+    }
+    return stage;
 }
 
 boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createFromBsonExternal(
@@ -469,6 +482,10 @@ void DocumentSourceInternalUnpackBucket::serializeToArray(
                          return compFields;
                      }()});
 
+    if (_eventFilter) {
+        out.addField(kEventFilter, Value{_eventFilterBson});
+    }
+
     if (!explain) {
         array.push_back(Value(DOC(getSourceName() << out.freeze())));
         if (_sampleSize) {
@@ -488,13 +505,22 @@ DocumentSource::GetNextResult DocumentSourceInternalUnpackBucket::doGetNext() {
     tassert(5521502, "calling doGetNext() when '_sampleSize' is set is disallowed", !_sampleSize);
 
     // Otherwise, fallback to unpacking every measurement in all buckets until the child stage is
-    // exhausted.
-    if (_bucketUnpacker.hasNext()) {
-        return _bucketUnpacker.getNext();
-    }
+    // exhausted. With an event filter, a bucket may be exhausted without producing a measurement.
+    while (true) {
+        if (_bucketUnpacker.hasNext()) {
+            if (!_eventFilter) {
+                return _bucketUnpacker.getNext();
+            }
+            if (auto measurement = _bucketUnpacker.getNextMatching(*_eventFilter)) {
+                return std::move(*measurement);
+            }
+        }
+
+        auto nextResult = pSource->getNext();
+        if (!nextResult.isAdvanced()) {
+            return nextResult;
+        }
 
-    auto nextResult = pSource->getNext();
-    if (nextResult.isAdvanced()) {
         auto bucket = nextResult.getDocument().toBson();
         _bucketUnpacker.reset(std::move(bucket));
         uassert(5346509,
@@ -502,10 +528,52 @@ DocumentSource::GetNextResult DocumentSourceInternalUnpackBucket::doGetNext() {
                               << _bucketUnpacker.bucket()[timeseries::kBucketIdFieldName].toString()
                               << " contains an empty data region",
                 _bucketUnpacker.hasNext());
-        return _bucketUnpacker.getNext();
+    }
+}
+
+void DocumentSourceInternalUnpackBucket::setEventFilter(BSONObj filter) {
+    _eventFilterBson = filter.getOwned();
+    _eventFilter = MatchExpression::optimize(uassertStatusOK(MatchExpressionParser::parse(
+        _eventFilterBson, pExpCtx, ExtensionsCallbackNoop(), Pipeline::kAllowedMatcherFeatures)));
+
+    DepsTracker deps;
+    _eventFilter->addDependencies(&deps);
+    uassert(6100002,
+            "The eventFilter of $_internalUnpackBucket must only depend on measurement fields",
+            !deps.needWholeDocument && !deps.getNeedsAnyMetadata());
+
+    _eventFilterFields.clear();
+    for (auto&& path : deps.fields) {
+        _eventFilterFields.emplace(FieldPath(path).front());
+    }
+    _bucketUnpacker.setEventFilterFields(_eventFilterFields);
+}
+
+bool DocumentSourceInternalUnpackBucket::tryAbsorbEventFilter(const DocumentSourceMatch& match) {
+    if (_eventFilter || _sampleSize || match.isTextQuery()) {
+        return false;
+    }
+
+    DepsTracker deps;
+    match.getDependencies(&deps);
+    if (deps.needWholeDocument || deps.getNeedsAnyMetadata()) {
+        return false;
     }
 
-    return nextResult;
+    // A filter on computed meta projections would see the bucket columns instead of the computed
+    // values, since the projections are only added to the materialized measurements.
+    auto&& spec = _bucketUnpacker.bucketSpec();
+    for (auto&& path : deps.fields) {
+        auto field = FieldPath(path).front();
+        if (std::find(spec.computedMetaProjFields.begin(),
+                      spec.computedMetaProjFields.end(),
+                      field) != spec.computedMetaProjFields.end()) {
+            return false;
+        }
+    }
+
+    setEventFilter(match.getQuery());
+    return true;
 }
 
 bool DocumentSourceInternalUnpackBucket::pushDownComputedMetaProjection(
@@ -759,6 +827,30 @@ std::pair<BSONObj, bool> DocumentSourceInternalUnpackBucket::extractProjectForPu
     return {BSONObj{}, false};
 }
 
+boost::intrusive_ptr<Expression> DocumentSourceInternalUnpackBucket::makeBucketCountExpression(
+    const Value& multiplier) const {
+    // Compressed buckets record their number of measurements in the control field, otherwise it is
+    // the number of entries in the time column.
+    const std::string controlCountPath = str::stream()
+        << "$" << timeseries::kBucketControlFieldName << "."
+        << timeseries::kBucketControlCountFieldName;
+    const std::string timeColumnPath = str::stream()
+        << "$" << timeseries::kBucketDataFieldName << "." << _bucketUnpacker.bucketSpec().timeField;
+    const auto countObj =
+        BSON("$ifNull" << BSON_ARRAY(controlCountPath << BSON(
+                                         "$size" << BSON("$objectToArray" << timeColumnPath))));
+
+    if (multiplier.getType() == NumberInt && multiplier.getInt() == 1) {
+        return Expression::parseExpression(pExpCtx.get(), countObj, pExpCtx->variablesParseState);
+    }
+
+    BSONArrayBuilder args;
+    multiplier.addToBsonArray(&args);
+    args.append(countObj);
+    return Expression::parseExpression(
+        pExpCtx.get(), BSON("$multiply" << args.arr()), pExpCtx->variablesParseState);
+}
+
 std::pair<bool, Pipeline::SourceContainer::iterator>
 DocumentSourceInternalUnpackBucket::rewriteGroupByMinMax(Pipeline::SourceContainer::iterator itr,
                                                          Pipeline::SourceContainer* container) {
@@ -768,19 +860,32 @@ DocumentSourceInternalUnpackBucket::rewriteGroupByMinMax(Pipeline::SourceContain
     }
 
     const auto& idFields = groupPtr->getIdFields();
-    if (idFields.size() != 1 || !_bucketUnpacker.bucketSpec().metaField.has_value()) {
+    if (idFields.size() != 1) {
         return {};
     }
 
+    // The group key must be the same for every measurement of a bucket: either a constant, as for
+    // $count, or a path on the metaField.
+    const auto& metaField = _bucketUnpacker.bucketSpec().metaField;
     const auto& exprId = idFields.cbegin()->second;
-    const auto* exprIdPath = dynamic_cast<const ExpressionFieldPath*>(exprId.get());
-    if (exprIdPath == nullptr) {
-        return {};
-    }
+    boost::intrusive_ptr<Expression> newExprId;
+    if (const auto* exprIdConst = dynamic_cast<const ExpressionConstant*>(exprId.get())) {
+        newExprId = ExpressionConstant::create(pExpCtx.get(), exprIdConst->getValue());
+    } else if (const auto* exprIdPath = dynamic_cast<const ExpressionFieldPath*>(exprId.get())) {
+        const auto& idPath = exprIdPath->getFieldPath();
+        if (!metaField || idPath.getPathLength() < 2 ||
+            idPath.getFieldName(1) != metaField.get()) {
+            return {};
+        }
 
-    const auto& idPath = exprIdPath->getFieldPath();
-    if (idPath.getPathLength() < 2 ||
-        idPath.getFieldName(1) != _bucketUnpacker.bucketSpec().metaField.get()) {
+        std::ostringstream os;
+        os << timeseries::kBucketMetaFieldName;
+        for (size_t index = 2; index < idPath.getPathLength(); index++) {
+            os << "." << idPath.getFieldName(index);
+        }
+        newExprId = ExpressionFieldPath::createPathFromString(
+            pExpCtx.get(), os.str(), pExpCtx->variablesParseState);
+    } else {
         return {};
     }
 
@@ -790,59 +895,69 @@ DocumentSourceInternalUnpackBucket::rewriteGroupByMinMax(Pipeline::SourceContain
         const auto op = stmt.expr.name;
         const bool isMin = op == "$min";
         const bool isMax = op == "$max";
-
-        // Rewrite is valid only for min and max aggregates.
-        if (!isMin && !isMax) {
-            suitable = false;
-            break;
-        }
-
         const auto* exprArg = stmt.expr.argument.get();
-        if (const auto* exprArgPath = dynamic_cast<const ExpressionFieldPath*>(exprArg)) {
-            const auto& path = exprArgPath->getFieldPath();
-            if (path.getPathLength() <= 1 ||
-                path.getFieldName(1) == _bucketUnpacker.bucketSpec().timeField) {
-                // Rewrite not valid for time field. We want to eliminate the bucket
-                // unpack stage here.
+
+        // A $sum of a constant, which includes the $count accumulator, is that constant times the
+        // number of measurements in each bucket.
+        if (op == "$sum") {
+            const auto* exprArgConst = dynamic_cast<const ExpressionConstant*>(exprArg);
+            if (!exprArgConst || !exprArgConst->getValue().numeric()) {
                 suitable = false;
                 break;
             }
 
-            // Update aggregates to reference the control field.
-            std::ostringstream os;
-            if (isMin) {
-                os << timeseries::kControlMinFieldNamePrefix;
-            } else {
-                os << timeseries::kControlMaxFieldNamePrefix;
-            }
+            AccumulationExpression accExpr = stmt.expr;
+            accExpr.argument = makeBucketCountExpression(exprArgConst->getValue());
+            accumulationStatements.emplace_back(stmt.fieldName, std::move(accExpr));
+            continue;
+        }
 
-            for (size_t index = 1; index < path.getPathLength(); index++) {
-                if (index > 1) {
-                    os << ".";
-                }
-                os << path.getFieldName(index);
-            }
+        // Otherwise, rewrite is valid only for min and max aggregates.
+        if (!isMin && !isMax) {
+            suitable = false;
+            break;
+        }
 
-            const auto& newExpr = ExpressionFieldPath::createPathFromString(
-                pExpCtx.get(), os.str(), pExpCtx->variablesParseState);
+        const auto* exprArgPath = dynamic_cast<const ExpressionFieldPath*>(exprArg);
+        if (!exprArgPath) {
+            suitable = false;
+            break;
+        }
 
-            AccumulationExpression accExpr = stmt.expr;
-            accExpr.argument = newExpr;
-            accumulationStatements.emplace_back(stmt.fieldName, std::move(accExpr));
+        const auto& path = exprArgPath->getFieldPath();
+        if (path.getPathLength() <= 1 ||
+            path.getFieldName(1) == _bucketUnpacker.bucketSpec().timeField) {
+            // Rewrite not valid for time field. We want to eliminate the bucket
+            // unpack stage here.
+            suitable = false;
+            break;
         }
-    }
 
-    if (suitable) {
+        // Update aggregates to reference the control field, or the bucket's metadata which is
+        // the same for all of its measurements.
         std::ostringstream os;
-        os << timeseries::kBucketMetaFieldName;
-        for (size_t index = 2; index < idPath.getPathLength(); index++) {
-            os << "." << idPath.getFieldName(index);
+        if (metaField && path.getFieldName(1) == metaField.get()) {
+            os << timeseries::kBucketMetaFieldName;
+        } else {
+            os << (isMin ? timeseries::kControlMinFieldNamePrefix
+                         : timeseries::kControlMaxFieldNamePrefix);
+            os << path.getFieldName(1);
         }
-        auto exprId1 = ExpressionFieldPath::createPathFromString(
+        for (size_t index = 2; index < path.getPathLength(); index++) {
+            os << "." << path.getFieldName(index);
+        }
+
+        const auto& newExpr = ExpressionFieldPath::createPathFromString(
             pExpCtx.get(), os.str(), pExpCtx->variablesParseState);
 
+        AccumulationExpression accExpr = stmt.expr;
+        accExpr.argument = newExpr;
+        accumulationStatements.emplace_back(stmt.fieldName, std::move(accExpr));
+    }
+
+    if (suitable) {
         auto newGroup = DocumentSourceGroup::create(pExpCtx,
-                                                    std::move(exprId1),
+                                                    std::move(newExprId),
                                                     std::move(accumulationStatements),
                                                     groupPtr->getMaxMemoryUsageBytes());
 
@@ -909,8 +1024,9 @@ Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimi
             return container->end();
         }
     }
-    {
-        // Check if we can avoid unpacking if we have a group stage with min/max aggregates.
+    // Check if we can avoid unpacking if we have a group stage with min/max aggregates. The bucket
+    // level min/max values cannot be used once an event filter drops some of the measurements.
+    if (!_eventFilter) {
         auto [success, result] = rewriteGroupByMinMax(itr, container);
         if (success) {
             return result;
@@ -1002,8 +1118,11 @@ Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimi
         }
     }
 
-    // Attempt to push down a $project on the metaField past $_internalUnpackBucket.
-    if (!haveComputedMetaField) {
+    // Attempt to push down a $project on the metaField past $_internalUnpackBucket. This is not
+    // possible if the event filter reads the metaField, since the filter is applied after it.
+    const bool eventFilterReadsMeta = _bucketUnpacker.bucketSpec().metaField &&
+        _eventFilterFields.count(*_bucketUnpacker.bucketSpec().metaField);
+    if (!haveComputedMetaField && !eventFilterReadsMeta) {
         if (auto [metaProject, deleteRemainder] = extractProjectForPushDown(std::next(itr)->get());
             !metaProject.isEmpty()) {
             container->insert(itr,
@@ -1041,6 +1160,15 @@ Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimi
         }
     }
 
+    // Absorb a remaining $match on the measurements as the event filter, so that measurements
+    // which do not match are never materialized. This is done last so that the $match has already
+    // taken part in the bucket level predicate and projection rewrites above.
+    if (auto nextMatch = dynamic_cast<DocumentSourceMatch*>(std::next(itr)->get()); nextMatch &&
+        internalQueryTimeseriesPushdownEventFilter.load() && tryAbsorbEventFilter(*nextMatch)) {
+        container->erase(std::next(itr));
+        return itr;
+    }
+
     return container->end();
 }
 }  // namespace mongo
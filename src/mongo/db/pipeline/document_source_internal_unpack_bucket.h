@@ -44,6 +44,7 @@ public:
     static constexpr StringData kInclude = "include"_sd;
     static constexpr StringData kExclude = "exclude"_sd;
     static constexpr StringData kBucketMaxSpanSeconds = "bucketMaxSpanSeconds"_sd;
+    static constexpr StringData kEventFilter = "eventFilter"_sd;
 
     static boost::intrusive_ptr<DocumentSource> createFromBsonInternal(
         BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
@@ -175,6 +176,24 @@ public:
         return _sampleSize;
     }
 
+    /**
+     * Sets a filter on the unpacked measurements, which is evaluated against the raw values of the
+     * bucket columns it references before a measurement is materialized. Measurements which do not
+     * match are skipped without ever being built into a Document.
+     */
+    void setEventFilter(BSONObj filter);
+
+    const MatchExpression* eventFilter() const {
+        return _eventFilter.get();
+    }
+
+    /**
+     * Attempts to absorb the $match 'match' which immediately follows this stage as its event
+     * filter. Returns false if 'match' cannot be evaluated against the bucket columns, for example
+     * because it needs the whole measurement.
+     */
+    bool tryAbsorbEventFilter(const DocumentSourceMatch& match);
+
     /**
      * If the stage after $_internalUnpackBucket is $project, $addFields, or $set, try to extract
      * from it computed meta projections and push them pass the current stage. Return true if the
@@ -192,13 +211,21 @@ public:
     std::pair<BSONObj, bool> extractProjectForPushDown(DocumentSource* src) const;
 
     /**
-     * Helper method which checks if we can avoid unpacking if we have a group stage with min/max
-     * aggregates. If a rewrite is possible, 'container' is modified, and we returns result value
-     * for 'doOptimizeAt'.
+     * Helper method which checks if we can avoid unpacking if we have a group stage whose key is
+     * constant or on the metaField, with only min/max aggregates on measurement or meta fields and
+     * sums of constants (such as $count). Such a group is answered per bucket from the control
+     * and meta fields. If a rewrite is possible, 'container' is modified, and we returns result
+     * value for 'doOptimizeAt'.
      */
     std::pair<bool, Pipeline::SourceContainer::iterator> rewriteGroupByMinMax(
         Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container);
 
+    /**
+     * Returns an expression evaluating to 'multiplier' times the number of measurements in a
+     * bucket.
+     */
+    boost::intrusive_ptr<Expression> makeBucketCountExpression(const Value& multiplier) const;
+
 private:
     GetNextResult doGetNext() final;
 
@@ -208,6 +235,12 @@ private:
     int _bucketMaxCount = 0;
     boost::optional<long long> _sampleSize;
 
+    // A filter on the unpacked measurements absorbed from a following $match, along with its BSON
+    // form for serialization and the top-level fields it references.
+    BSONObj _eventFilterBson;
+    std::unique_ptr<MatchExpression> _eventFilter;
+    std::set<std::string> _eventFilterFields;
+
     // Used to avoid infinite loops after we step backwards to optimize a $match on bucket level
     // fields, otherwise we may do an infinite number of $match pushdowns.
     bool _triedBucketLevelFieldsPredicatesPushdown = false;
@@ -29,7 +29,10 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/query/util/make_data_structure.h"
 
 namespace mongo {
@@ -47,13 +50,11 @@ TEST_F(InternalUnpackBucketGroupReorder, OptimizeForCount) {
     pipeline->optimizePipeline();
 
     auto serialized = pipeline->serializeToBson();
-    // $count gets rewritten to $group + $project.
-    ASSERT_EQ(3, serialized.size());
-
-    auto optimized = fromjson(
-        "{$_internalUnpackBucket: { include: [], timeField: 't', metaField: 'meta', "
-        "bucketMaxSpanSeconds: 3600}}");
-    ASSERT_BSONOBJ_EQ(optimized, serialized[0]);
+    // $count gets rewritten to $group + $project, and the $group is answered from the buckets
+    // without unpacking them.
+    ASSERT_EQ(2, serialized.size());
+    ASSERT_EQ("$group"_sd, serialized[0].firstElementFieldNameStringData());
+    ASSERT_EQ("$project"_sd, serialized[1].firstElementFieldNameStringData());
 }
 
 TEST_F(InternalUnpackBucketGroupReorder, OptimizeForCountNegative) {
@@ -126,5 +127,56 @@ TEST_F(InternalUnpackBucketGroupReorder, MinMaxGroupOnMetadataNegative1) {
     ASSERT_BSONOBJ_EQ(groupSpecObj, serialized[1]);
 }
 
+TEST_F(InternalUnpackBucketGroupReorder, CountAndMinMaxGroupOnMetadataUsesControlFields) {
+    auto unpackSpecObj = fromjson(
+        "{$_internalUnpackBucket: { exclude: [], metaField: 'tags', timeField: 't', "
+        "bucketMaxSpanSeconds: 3600}}");
+    auto groupSpecObj = fromjson(
+        "{$group: {_id: '$tags.host', n: {$sum: 1}, w: {$sum: 2}, maxA: {$max: '$a'}, "
+        "minHost: {$min: '$tags.host'}}}");
+
+    auto pipeline = Pipeline::parse(makeVector(unpackSpecObj, groupSpecObj), getExpCtx());
+    pipeline->optimizePipeline();
+
+    auto serialized = pipeline->serializeToBson();
+    ASSERT_EQ(1, serialized.size());
+    ASSERT_EQ("$group"_sd, serialized[0].firstElementFieldNameStringData());
+
+    // The first bucket is counted from its time column, the second from 'control.count'.
+    auto source = DocumentSourceMock::createForTest(
+        {"{control: {max: {a: 4}}, meta: {host: 'a'}, data: {t: {'0': 1, '1': 2}, a: {'0': 3, "
+         "'1': 4}}}",
+         "{control: {count: 3, max: {a: 7}}, meta: {host: 'a'}, data: {t: {'0': 1}}}",
+         "{control: {max: {a: 1}}, meta: {host: 'b'}, data: {t: {'0': 1}, a: {'0': 1}}}"},
+        getExpCtx());
+    pipeline->addInitialSource(source);
+
+    std::map<std::string, Document> results;
+    while (auto next = pipeline->getNext()) {
+        results.emplace(next->getField("_id").getString(), *next);
+    }
+    ASSERT_EQ(2, results.size());
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{_id: 'a', n: 5, w: 10, maxA: 7, minHost: 'a'}")),
+                       results["a"]);
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{_id: 'b', n: 1, w: 2, maxA: 1, minHost: 'b'}")),
+                       results["b"]);
+}
+
+TEST_F(InternalUnpackBucketGroupReorder, SumOfFieldGroupOnMetadataNegative) {
+    auto unpackSpecObj = fromjson(
+        "{$_internalUnpackBucket: { include: ['a', 'b', 'c'], timeField: 't', metaField: 'meta', "
+        "bucketMaxSpanSeconds: 3600}}");
+    auto groupSpecObj = fromjson("{$group: {_id: '$meta', accmax: {$max: '$b'}, s: {$sum: '$c'}}}");
+
+    auto pipeline = Pipeline::parse(makeVector(unpackSpecObj, groupSpecObj), getExpCtx());
+    pipeline->optimizePipeline();
+
+    // A $sum of a measurement field cannot be answered from the control fields.
+    auto serialized = pipeline->serializeToBson();
+    ASSERT_EQ(2, serialized.size());
+    ASSERT_BSONOBJ_EQ(unpackSpecObj, serialized[0]);
+    ASSERT_BSONOBJ_EQ(groupSpecObj, serialized[1]);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -34,6 +34,7 @@
 #include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/query/util/make_data_structure.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/bson_test_util.h"
 
 namespace mongo {
@@ -65,6 +66,32 @@ TEST_F(OptimizePipeline, MixedMatchPushedDown) {
     ASSERT_BSONOBJ_EQ(fromjson("{$match: {a: {$lte: 4}}}"), stages[2].getDocument().toBson());
 }
 
+TEST_F(OptimizePipeline, RemainingMatchAbsorbedAsEventFilter) {
+    RAIIServerParameterControllerForTest controller{"internalQueryTimeseriesPushdownEventFilter",
+                                                    true};
+    auto unpack = fromjson(
+        "{$_internalUnpackBucket: { exclude: [], timeField: 'time', metaField: 'myMeta', "
+        "bucketMaxSpanSeconds: 3600}}");
+    auto pipeline = Pipeline::parse(
+        makeVector(unpack, fromjson("{$match: {myMeta: {$gte: 0, $lte: 5}, a: {$lte: 4}}}")),
+        getExpCtx());
+    ASSERT_EQ(2u, pipeline->getSources().size());
+
+    pipeline->optimizePipeline();
+
+    // The bucket level predicates are still derived from the $match, after which what remains of
+    // it is evaluated by $_internalUnpackBucket itself.
+    auto stages = pipeline->writeExplainOps(ExplainOptions::Verbosity::kQueryPlanner);
+    ASSERT_EQ(2u, stages.size());
+    ASSERT_BSONOBJ_EQ(fromjson("{$match: {$and: [{'control.min.a': {$_internalExprLte: 4}}, {meta: "
+                               "{$gte: 0}}, {meta: {$lte: 5}}]}}"),
+                      stages[0].getDocument().toBson());
+    ASSERT_BSONOBJ_EQ(fromjson("{$_internalUnpackBucket: { exclude: [], timeField: 'time', "
+                               "metaField: 'myMeta', bucketMaxSpanSeconds: 3600, eventFilter: {a: "
+                               "{$lte: 4}}}}"),
+                      stages[1].getDocument().toBson());
+}
+
 TEST_F(OptimizePipeline, MetaMatchPushedDown) {
     auto unpack = fromjson(
         "{$_internalUnpackBucket: { exclude: [], timeField: 'foo', metaField: 'myMeta', "
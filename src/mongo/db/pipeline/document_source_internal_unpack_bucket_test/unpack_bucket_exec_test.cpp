@@ -90,6 +90,46 @@ TEST_F(InternalUnpackBucketExecTest, UnpackBasicIncludeAllMeasurementFields) {
     ASSERT_TRUE(next.isEOF());
 }
 
+TEST_F(InternalUnpackBucketExecTest, UnpackWithEventFilterOnlyReturnsMatchingMeasurements) {
+    auto expCtx = getExpCtx();
+
+    // The event filter reads 'b' and the metaField, neither of which is materialized.
+    auto spec = BSON(DocumentSourceInternalUnpackBucket::kStageNameInternal << BSON(
+                         DocumentSourceInternalUnpackBucket::kInclude
+                         << BSON_ARRAY("_id" << kUserDefinedTimeName << "a")
+                         << timeseries::kTimeFieldName << kUserDefinedTimeName
+                         << timeseries::kMetaFieldName << kUserDefinedMetaName
+                         << DocumentSourceInternalUnpackBucket::kBucketMaxSpanSeconds << 3600
+                         << DocumentSourceInternalUnpackBucket::kEventFilter
+                         << fromjson("{$or: [{b: 1}, {'myMeta.m3': 9}]}")));
+    auto unpack =
+        DocumentSourceInternalUnpackBucket::createFromBsonInternal(spec.firstElement(), expCtx);
+    auto source = DocumentSourceMock::createForTest(
+        {"{meta: {'m1': 999, 'm2': 9999}, data: {_id: {'0':1, '1':2}, time: {'0':1, '1':2}, "
+         "a:{'0':1, '1':2}, b:{'1':1}}}",
+         "{meta: {'m1': 999, 'm2': 9999}, data: {_id: {'0':5}, time: {'0':5}, a:{'0':5}}}",
+         "{meta: {'m1': 9, 'm2': 9, 'm3': 9}, data: {_id: {'0':3, '1':4}, time: {'0':3, '1':4}, "
+         "a:{'0':1, '1':2}, b:{'1':1}}}"},
+        expCtx);
+    unpack->setSource(source.get());
+
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(), Document(fromjson("{time: 2, _id: 2, a: 2}")));
+
+    // The second bucket has no matching measurement and is skipped entirely.
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(), Document(fromjson("{time: 3, _id: 3, a: 1}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(), Document(fromjson("{time: 4, _id: 4, a: 2}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isEOF());
+}
+
 TEST_F(InternalUnpackBucketExecTest, UnpackIncludeBucketIdRowIndexInvalidRowIndex) {
     auto expCtx = getExpCtx();
 
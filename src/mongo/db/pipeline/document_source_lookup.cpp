@@ -80,6 +80,47 @@ BSONObj buildEqualityOrQuery(const std::string& fieldName, const BSONArray& valu
     return orBuilder.obj();
 }
 
+/**
+ * Returns true if 'value' can be joined by DocumentSourceLookUp::lookUpBatch(). A foreign document
+ * matches such a value exactly when its foreign field, or one of the elements of its foreign field,
+ * compares equal to it. Null and missing values, arrays, objects, regular expressions and the other
+ * types with special matching rules are looked up on their own instead.
+ */
+bool isBatchableLookupValue(const Value& value) {
+    switch (value.getType()) {
+        case NumberInt:
+        case NumberLong:
+        case NumberDouble:
+        case NumberDecimal:
+        case String:
+        case jstOID:
+        case Bool:
+        case Date:
+        case bsonTimestamp:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Adds 'resultSize' to '*objsize', the total size of the foreign documents joined to one input
+ * document so far, and throws if the total already exceeds the limit on that size.
+ */
+void addToLookupResultsSize(const NamespaceString& fromNs,
+                            long long resultSize,
+                            long long* objsize) {
+    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+    long long safeSum = 0;
+    bool hasOverflowed = overflow::add(*objsize, resultSize, &safeSum);
+    uassert(4568,
+            str::stream() << "Total size of documents in " << fromNs.coll()
+                          << " matching pipeline's $lookup stage exceeds " << maxBytes << " bytes",
+
+            !hasOverflowed && *objsize <= maxBytes);
+    *objsize = safeSum;
+}
+
 void lookupPipeValidator(const Pipeline& pipeline) {
     const auto& sources = pipeline.getSources();
     std::for_each(sources.begin(), sources.end(), [](auto& src) {
@@ -167,6 +208,7 @@ DocumentSourceLookUp::DocumentSourceLookUp(
         _fromExpCtx->setCollator(std::move(fromCollator.get()));
         _hasExplicitCollation = true;
     }
+    _batchSize = internalDocumentSourceLookupBatchSize.load();
 }
 
 DocumentSourceLookUp::DocumentSourceLookUp(
@@ -354,13 +396,19 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         return unwindResult();
     }
 
+    if (canBatchLookups()) {
+        return batchedResult();
+    }
+
     auto nextInput = pSource->getNext();
     if (!nextInput.isAdvanced()) {
         return nextInput;
     }
 
-    auto inputDoc = nextInput.releaseDocument();
+    return lookUpSingle(nextInput.releaseDocument());
+}
 
+Document DocumentSourceLookUp::lookUpSingle(Document inputDoc) {
     // If we have not absorbed a $unwind, we cannot absorb a $match. If we have absorbed a $unwind,
     // '_unwindSrc' would be non-null, and we would not have made it here.
     invariant(!_matchSrc);
@@ -372,9 +420,159 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         _resolvedPipeline[*_fieldMatchPipelineIdx] = matchStage;
     }
 
-    std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
+    auto pipeline = buildJoinPipeline(inputDoc);
+
+    std::vector<Value> results;
+    long long objsize = 0;
+    while (auto result = pipeline->getNext()) {
+        addToLookupResultsSize(_fromNs, result->getApproximateSize(), &objsize);
+        results.emplace_back(std::move(*result));
+    }
+
+    recordPlanSummaryStats(*pipeline);
+    MutableDocument output(std::move(inputDoc));
+    output.setNestedField(_as, Value(std::move(results)));
+    return output.freeze();
+}
+
+bool DocumentSourceLookUp::canBatchLookups() const {
+    // The foreign field must be a top-level field, so that the values it matches are the field
+    // itself and, if it's an array, its elements.
+    return _batchSize > 1 && hasLocalFieldForeignFieldJoin() && !hasPipeline() && !_unwindSrc &&
+        !_matchSrc && !_additionalFilter && _foreignField->getPathLength() == 1;
+}
+
+DocumentSource::GetNextResult DocumentSourceLookUp::batchedResult() {
+    if (_batchedOutput.empty()) {
+        if (_batchedInputEnd) {
+            auto inputEnd = std::move(*_batchedInputEnd);
+            _batchedInputEnd.reset();
+            return inputEnd;
+        }
+
+        std::vector<Document> inputs;
+        inputs.reserve(_batchSize);
+        while (inputs.size() < _batchSize) {
+            auto nextInput = pSource->getNext();
+            if (!nextInput.isAdvanced()) {
+                if (inputs.empty()) {
+                    return nextInput;
+                }
+                // Return the documents already pulled before propagating the pause or EOF.
+                _batchedInputEnd = std::move(nextInput);
+                break;
+            }
+            inputs.push_back(nextInput.releaseDocument());
+        }
+        lookUpBatch(std::move(inputs));
+    }
+
+    auto output = std::move(_batchedOutput.front());
+    _batchedOutput.pop_front();
+    return output;
+}
+
+void DocumentSourceLookUp::lookUpBatch(std::vector<Document> inputs) {
+    invariant(!inputs.empty());
+
+    // Maps each local value to the positions in 'inputs' of the documents that have it. The
+    // comparisons must follow the collation the foreign query is run with.
+    auto localPositions =
+        _fromExpCtx->getValueComparator().makeUnorderedValueMap<std::vector<size_t>>();
+    std::vector<bool> isBatched(inputs.size(), false);
+    BSONArrayBuilder localValues;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        std::vector<Value> values;
+        bool batchable = true;
+        document_path_support::visitAllValuesAtPath(
+            inputs[i], *_localField, [&](const Value& nextValue) {
+                batchable = batchable && isBatchableLookupValue(nextValue);
+                values.push_back(nextValue);
+            });
+        // Leave enough room in the query for the values of the documents already batched.
+        if (!batchable || values.empty() || localValues.len() > BSONObjMaxUserSize / 2) {
+            continue;
+        }
+
+        isBatched[i] = true;
+        for (auto&& value : values) {
+            auto& positions = localPositions[value];
+            if (positions.empty()) {
+                localValues << value;
+            }
+            if (positions.empty() || positions.back() != i) {
+                positions.push_back(i);
+            }
+        }
+    }
+
+    std::vector<std::vector<Value>> results(inputs.size());
+    if (!localPositions.empty()) {
+        const auto& foreignFieldName = _foreignField->fullPath();
+        _resolvedPipeline[*_fieldMatchPipelineIdx] =
+            BSON("$match" << BSON(foreignFieldName << BSON("$in" << localValues.arr())));
+        auto pipeline = buildJoinPipeline(inputs.front());
+
+        // Several values of a foreign document can match the same input document, which must
+        // still see the foreign document only once.
+        std::vector<long long> lastMatch(inputs.size(), -1);
+        std::vector<long long> objsizes(inputs.size(), 0);
+        long long batchBytes = 0;
+        long long foreignIdx = 0;
+        const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+        while (auto result = pipeline->getNext()) {
+            const auto resultSize = static_cast<long long>(result->getApproximateSize());
+            batchBytes += resultSize;
+            if (batchBytes > maxBytes) {
+                // Don't hold on to more foreign documents than a single lookup may. Run the
+                // queries one input document at a time instead.
+                std::fill(isBatched.begin(), isBatched.end(), false);
+                break;
+            }
+
+            auto foreignValue = result->getField(foreignFieldName);
+            Value foreignDoc(std::move(*result));
+            auto joinOn = [&](const Value& value) {
+                auto it = localPositions.find(value);
+                if (it == localPositions.end()) {
+                    return;
+                }
+                for (auto i : it->second) {
+                    if (lastMatch[i] == foreignIdx) {
+                        continue;
+                    }
+                    addToLookupResultsSize(_fromNs, resultSize, &objsizes[i]);
+                    results[i].push_back(foreignDoc);
+                    lastMatch[i] = foreignIdx;
+                }
+            };
+            if (foreignValue.isArray()) {
+                for (auto&& element : foreignValue.getArray()) {
+                    joinOn(element);
+                }
+            } else if (!foreignValue.missing()) {
+                joinOn(foreignValue);
+            }
+            ++foreignIdx;
+        }
+        recordPlanSummaryStats(*pipeline);
+    }
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (!isBatched[i]) {
+            _batchedOutput.push_back(lookUpSingle(std::move(inputs[i])));
+            continue;
+        }
+        MutableDocument output(std::move(inputs[i]));
+        output.setNestedField(_as, Value(std::move(results[i])));
+        _batchedOutput.push_back(output.freeze());
+    }
+}
+
+std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildJoinPipeline(
+    const Document& inputDoc) {
     try {
-        pipeline = buildPipeline(inputDoc);
+        return buildPipeline(inputDoc);
     } catch (const ExceptionForCat<ErrorCategory::StaleShardVersionError>& ex) {
         // If lookup on a sharded collection is disallowed and the foreign collection is sharded,
         // throw a custom exception.
@@ -392,28 +590,6 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         }
         throw;
     }
-
-    std::vector<Value> results;
-    long long objsize = 0;
-    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
-
-    while (auto result = pipeline->getNext()) {
-        long long safeSum = 0;
-        bool hasOverflowed = overflow::add(objsize, result->getApproximateSize(), &safeSum);
-        uassert(4568,
-                str::stream() << "Total size of documents in " << _fromNs.coll()
-                              << " matching pipeline's $lookup stage exceeds " << maxBytes
-                              << " bytes",
-
-                !hasOverflowed && objsize <= maxBytes);
-        objsize = safeSum;
-        results.emplace_back(std::move(*result));
-    }
-
-    recordPlanSummaryStats(*pipeline);
-    MutableDocument output(std::move(inputDoc));
-    output.setNestedField(_as, Value(std::move(results)));
-    return output.freeze();
 }
 
 std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipelineFromViewDefinition(
@@ -725,6 +901,8 @@ bool DocumentSourceLookUp::usedDisk() {
 }
 
 void DocumentSourceLookUp::doDispose() {
+    _batchedOutput.clear();
+    _batchedInputEnd.reset();
     if (_pipeline) {
         recordPlanSummaryStats(*_pipeline);
         _pipeline->dispose(pExpCtx->opCtx);
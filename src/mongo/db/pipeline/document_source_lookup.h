@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <deque>
 
 #include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/pipeline/document_source.h"
@@ -271,6 +272,39 @@ private:
 
     GetNextResult unwindResult();
 
+    /**
+     * Returns true if input documents can be joined with the foreign collection several at a
+     * time, using a single query per batch. See lookUpBatch().
+     */
+    bool canBatchLookups() const;
+
+    /**
+     * Returns the next output document when lookups are batched, pulling the next batch of input
+     * documents from the source once the previous one has been returned.
+     */
+    GetNextResult batchedResult();
+
+    /**
+     * Joins 'inputs' with the foreign collection using a single {<foreignField>: {$in: [...]}}
+     * query, and appends the output documents to '_batchedOutput' in the order of 'inputs'. Each
+     * foreign document is then matched to the input documents through a hash table keyed on the
+     * local values. Input documents whose local values don't have plain equality semantics (e.g.
+     * null, arrays or regular expressions) are looked up on their own.
+     */
+    void lookUpBatch(std::vector<Document> inputs);
+
+    /**
+     * Joins 'inputDoc' with the foreign collection by running a query for it alone, and returns
+     * the output document.
+     */
+    Document lookUpSingle(Document inputDoc);
+
+    /**
+     * Wraps buildPipeline(), converting a stale shard version error on a sharded foreign
+     * collection into an error explaining why $lookup can't target it.
+     */
+    std::unique_ptr<Pipeline, PipelineDeleter> buildJoinPipeline(const Document& inputDoc);
+
     /**
      * Resolves let defined variables against 'localDoc' and stores the results in 'variables'.
      */
@@ -380,6 +414,16 @@ private:
     std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
     boost::optional<Document> _input;
     boost::optional<Document> _nextValue;
+
+    // The number of input documents joined together by lookUpBatch(), read from the
+    // 'internalDocumentSourceLookupBatchSize' knob when the stage is created.
+    size_t _batchSize = 0;
+
+    // The following members are used to hold onto state across getNext() calls when lookups are
+    // batched. '_batchedInputEnd' holds a pause or EOF returned by the source in the middle of a
+    // batch, to propagate once the output of the documents before it has been returned.
+    std::deque<Document> _batchedOutput;
+    boost::optional<GetNextResult> _batchedInputEnd;
 };
 
 }  // namespace mongo
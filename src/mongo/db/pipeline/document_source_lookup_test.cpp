@@ -46,10 +46,12 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/process_interface/stub_mongo_process_interface.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/server_options.h"
+#include "mongo/idl/server_parameter_test_util.h"
 
 namespace mongo {
 namespace {
@@ -893,6 +895,94 @@ TEST_F(DocumentSourceLookUpTest, ShouldPropagatePauses) {
     lookup->dispose();
 }
 
+TEST_F(DocumentSourceLookUpTest, ShouldJoinBatchesOfInputDocumentsInOrder) {
+    RAIIServerParameterControllerForTest controller("internalDocumentSourceLookupBatchSize", 3);
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    // The first three documents are joined with a single query. The document with a missing local
+    // field is looked up on its own, and the pause cuts the following batch short.
+    auto mockLocalSource = DocumentSourceMock::createForTest(
+        {Document(fromjson("{_id: 'a', key: 0}")),
+         Document(fromjson("{_id: 'b', key: [1, 0]}")),
+         Document(fromjson("{_id: 'c', key: [2, 1]}")),
+         Document(fromjson("{_id: 'd'}")),
+         DocumentSource::GetNextResult::makePauseExecution(),
+         Document(fromjson("{_id: 'e', key: 1}"))},
+        expCtx);
+
+    // Mock out the foreign collection. The mock applies the $match of each query.
+    deque<DocumentSource::GetNextResult> mockForeignContents{
+        Document(fromjson("{_id: 0, key: 0}")),
+        Document(fromjson("{_id: 1, key: [1, 2]}")),
+        Document(fromjson("{_id: 2}"))};
+    expCtx->mongoProcessInterface =
+        std::make_shared<MockMongoInterface>(std::move(mockForeignContents));
+
+    auto lookupSpec = fromjson(
+        "{$lookup: {from: 'foreign', localField: 'key', foreignField: 'key', as: 'foreignDocs'}}");
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+    lookup->setSource(mockLocalSource.get());
+
+    auto assertNextIs = [&](const char* expected) {
+        auto next = lookup->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.releaseDocument(), Document(fromjson(expected)));
+    };
+    assertNextIs("{_id: 'a', key: 0, foreignDocs: [{_id: 0, key: 0}]}");
+    assertNextIs(
+        "{_id: 'b', key: [1, 0], foreignDocs: [{_id: 0, key: 0}, {_id: 1, key: [1, 2]}]}");
+    // A foreign document matching several local values is only joined once.
+    assertNextIs("{_id: 'c', key: [2, 1], foreignDocs: [{_id: 1, key: [1, 2]}]}");
+    assertNextIs("{_id: 'd', foreignDocs: [{_id: 2}]}");
+    ASSERT_TRUE(lookup->getNext().isPaused());
+    assertNextIs("{_id: 'e', key: 1, foreignDocs: [{_id: 1, key: [1, 2]}]}");
+
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    lookup->dispose();
+}
+
+TEST_F(DocumentSourceLookUpTest, BatchedLookupShouldRespectCollation) {
+    RAIIServerParameterControllerForTest controller("internalDocumentSourceLookupBatchSize", 10);
+    auto expCtx = getExpCtx();
+    expCtx->setCollator(
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kToLowerString));
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    auto mockLocalSource = DocumentSourceMock::createForTest(
+        {Document(fromjson("{_id: 0, key: 'ABC'}")), Document(fromjson("{_id: 1, key: 'xyz'}"))},
+        expCtx);
+    deque<DocumentSource::GetNextResult> mockForeignContents{
+        Document(fromjson("{_id: 0, key: 'abc'}")), Document(fromjson("{_id: 1, key: 'XYZ'}"))};
+    expCtx->mongoProcessInterface =
+        std::make_shared<MockMongoInterface>(std::move(mockForeignContents));
+
+    auto lookupSpec = fromjson(
+        "{$lookup: {from: 'foreign', localField: 'key', foreignField: 'key', as: 'foreignDocs'}}");
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+    lookup->setSource(mockLocalSource.get());
+
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.releaseDocument(),
+        Document(fromjson("{_id: 0, key: 'ABC', foreignDocs: [{_id: 0, key: 'abc'}]}")));
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.releaseDocument(),
+        Document(fromjson("{_id: 1, key: 'xyz', foreignDocs: [{_id: 1, key: 'XYZ'}]}")));
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    lookup->dispose();
+}
+
 TEST_F(DocumentSourceLookUpTest, ShouldPropagatePausesWhileUnwinding) {
     auto expCtx = getExpCtx();
     NamespaceString fromNs("test", "foreign");
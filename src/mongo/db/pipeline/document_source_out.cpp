@@ -38,6 +38,7 @@
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/pipeline/document_path_support.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/util/destructor_guard.h"
@@ -151,6 +152,14 @@ void DocumentSourceOut::initialize() {
         return;
     }
 
+    // Nobody else can write to the temp collection, so its indexes can be built in one pass once
+    // it holds all of the documents, which is much cheaper than maintaining them on every insert.
+    if (internalQueryOutBuildIndexesAfterLoad.load() &&
+        pExpCtx->mongoProcessInterface->canCreateIndexesAfterLoad(pExpCtx->opCtx, _tempNs)) {
+        _buildIndexesAfterLoad = true;
+        return;
+    }
+
     // Copy the indexes of the output collection to the temp collection.
     try {
         std::vector<BSONObj> tempNsIndexes = {std::begin(_originalIndexes),
@@ -167,6 +176,19 @@ void DocumentSourceOut::finalize() {
     DocumentSourceWriteBlock writeBlock(pExpCtx->opCtx);
 
     const auto& outputNs = getOutputNs();
+
+    if (_buildIndexesAfterLoad) {
+        try {
+            std::vector<BSONObj> tempNsIndexes = {std::begin(_originalIndexes),
+                                                  std::end(_originalIndexes)};
+            pExpCtx->mongoProcessInterface->createIndexesAfterLoad(
+                pExpCtx->opCtx, _tempNs, tempNsIndexes);
+        } catch (DBException& ex) {
+            ex.addContext("Copying indexes for $out failed");
+            throw;
+        }
+    }
+
     auto renameCommandObj =
         BSON("renameCollection" << _tempNs.ns() << "to" << outputNs.ns() << "dropTarget" << true);
 
@@ -142,6 +142,10 @@ private:
 
     // The temporary namespace for the $out writes.
     NamespaceString _tempNs;
+
+    // Whether the secondary indexes of the temporary collection are built once all documents have
+    // been written to it, rather than created up front and maintained on every insert.
+    bool _buildIndexesAfterLoad = false;
 };
 
 }  // namespace mongo
@@ -296,6 +296,10 @@ Value DocumentSourceInternalSetWindowFields::serialize(
         out["maxTotalMemoryUsageBytes"] =
             Value(static_cast<long long>(_memoryTracker.maxMemoryBytes()));
         out["usedDisk"] = Value(_iterator.usedDisk());
+        if (_iterator.usedDisk()) {
+            out["spilledBytes"] = Value(static_cast<long long>(_iterator.spilledBytes()));
+            out["spillTimeMicros"] = Value(static_cast<long long>(_iterator.spillTimeMicros()));
+        }
     }
 
     return Value(out.freezeToValue());
@@ -457,8 +461,11 @@ DocumentSource::GetNextResult DocumentSourceInternalSetWindowFields::doGetNext()
             throw;
         }
 
-        if (_memoryTracker.currentMemoryBytes() >=
-                static_cast<long long>(_memoryTracker._maxAllowedMemoryUsageBytes) &&
+        // The operation or the node being over its memory limit counts as this stage being over
+        // its own limit.
+        if ((_memoryTracker.currentMemoryBytes() >=
+                 static_cast<long long>(_memoryTracker._maxAllowedMemoryUsageBytes) ||
+             _memoryTracker.operationMemoryLimitExceeded()) &&
             _memoryTracker._allowDiskUse) {
             // Attempt to spill where possible.
             _iterator.spillToDisk();
@@ -113,7 +113,11 @@ public:
           _sortBy(std::move(sortBy)),
           _outputFields(std::move(outputFields)),
           _memoryTracker{expCtx->allowDiskUse, maxMemoryBytes},
-          _iterator(expCtx.get(), pSource, &_memoryTracker, std::move(partitionBy), _sortBy){};
+          _iterator(expCtx.get(), pSource, &_memoryTracker, std::move(partitionBy), _sortBy) {
+        if (expCtx->opCtx) {
+            _memoryTracker.setOperationTracker(&OperationMemoryUsageTracker::get(expCtx->opCtx));
+        }
+    }
 
     GetModPathsReturn getModifiedPaths() const final {
         std::set<std::string> outputPaths;
@@ -179,6 +183,23 @@ public:
         return _iterator.usedDisk();
     };
 
+    const PartitionIterator& getPartitionIterator() const {
+        return _iterator;
+    }
+
+    void detachFromOperationContext() final {
+        _memoryTracker.setOperationTracker(nullptr);
+    }
+
+    void reattachToOperationContext(OperationContext* opCtx) final {
+        _memoryTracker.setOperationTracker(&OperationMemoryUsageTracker::get(opCtx));
+    }
+
+protected:
+    void doDispose() final {
+        _memoryTracker.setOperationTracker(nullptr);
+    }
+
 private:
     void initialize();
 
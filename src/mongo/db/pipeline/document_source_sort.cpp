@@ -124,6 +124,10 @@ void DocumentSourceSort::serializeToArray(
             Value(static_cast<long long>(stats.totalDataSizeBytes));
         mutDoc["usedDisk"] = Value(stats.spills > 0);
         mutDoc["spills"] = Value(static_cast<long long>(stats.spills));
+        if (stats.spills > 0) {
+            mutDoc["spilledBytes"] = Value(static_cast<long long>(stats.spilledBytes));
+            mutDoc["spillTimeMicros"] = Value(static_cast<long long>(stats.spillTimeMicros));
+        }
     }
 
     array.push_back(Value(mutDoc.freeze()));
@@ -38,8 +38,10 @@
 #include "mongo/db/pipeline/document_source_single_document_transformation.h"
 #include "mongo/db/pipeline/document_source_union_with.h"
 #include "mongo/db/pipeline/document_source_union_with_gen.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/views/resolved_view.h"
 #include "mongo/logv2/log.h"
+#include "mongo/s/query/document_source_merge_cursors.h"
 
 namespace mongo {
 
@@ -186,6 +188,14 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
     }
 
     if (_executionState == ExecutionProgress::kIteratingSource) {
+        if (!_subPipelineAttached && shouldPrefetchSubPipeline()) {
+            attachCursorSourceToSubPipeline();
+            if (auto mergeCursors =
+                    dynamic_cast<DocumentSourceMergeCursors*>(_pipeline->peekFront())) {
+                mergeCursors->prefetch();
+            }
+        }
+
         auto nextInput = pSource->getNext();
         if (!nextInput.isEOF()) {
             return nextInput;
@@ -196,20 +206,10 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
     }
 
     if (_executionState == ExecutionProgress::kStartingSubPipeline) {
-        auto serializedPipe = _pipeline->serializeToBson();
-        logStartingSubPipeline(serializedPipe);
-        try {
-            _pipeline =
-                pExpCtx->mongoProcessInterface->attachCursorSourceToPipeline(_pipeline.release());
-            _executionState = ExecutionProgress::kIteratingSubPipeline;
-        } catch (const ExceptionFor<ErrorCodes::CommandOnShardedViewNotSupportedOnMongod>& e) {
-            _pipeline = buildPipelineFromViewDefinition(
-                pExpCtx,
-                ExpressionContext::ResolvedNamespace{e->getNamespace(), e->getPipeline()},
-                serializedPipe);
-            logShardedViewFound(e);
-            return doGetNext();
+        if (!_subPipelineAttached) {
+            attachCursorSourceToSubPipeline();
         }
+        _executionState = ExecutionProgress::kIteratingSubPipeline;
     }
 
     auto res = _pipeline->getNext();
@@ -223,6 +223,28 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
     return GetNextResult::makeEOF();
 }
 
+void DocumentSourceUnionWith::attachCursorSourceToSubPipeline() {
+    auto serializedPipe = _pipeline->serializeToBson();
+    logStartingSubPipeline(serializedPipe);
+    try {
+        _pipeline =
+            pExpCtx->mongoProcessInterface->attachCursorSourceToPipeline(_pipeline.release());
+        _subPipelineAttached = true;
+    } catch (const ExceptionFor<ErrorCodes::CommandOnShardedViewNotSupportedOnMongod>& e) {
+        _pipeline = buildPipelineFromViewDefinition(
+            pExpCtx,
+            ExpressionContext::ResolvedNamespace{e->getNamespace(), e->getPipeline()},
+            serializedPipe);
+        logShardedViewFound(e);
+        attachCursorSourceToSubPipeline();
+    }
+}
+
+bool DocumentSourceUnionWith::shouldPrefetchSubPipeline() const {
+    // Explain relies on the sub-pipeline being attached only once it is read from.
+    return !pExpCtx->explain && internalQueryUnionWithPrefetchSubPipeline.load();
+}
+
 // The use of these logging macros is done in separate NOINLINE functions to reduce the stack space
 // used on the hot getNext() path. This is done to avoid stack overflows.
 MONGO_COMPILER_NOINLINE void DocumentSourceUnionWith::logStartingSubPipeline(
@@ -149,7 +149,7 @@ private:
         kIteratingSource,
 
         // We finished iterating 'pSource', but haven't started on the sub pipeline and need to do
-        // some setup first.
+        // some setup first, unless the sub pipeline was already attached for prefetching.
         kStartingSubPipeline,
 
         // We finished iterating 'pSource' and are now iterating '_pipeline', but haven't finished
@@ -166,6 +166,18 @@ private:
 
     void recordPlanSummaryStats(const Pipeline& pipeline);
 
+    /**
+     * Replaces '_pipeline' with the sub-pipeline attached to its cursor source, resolving the view
+     * definition if the foreign namespace turns out to be a sharded view.
+     */
+    void attachCursorSourceToSubPipeline();
+
+    /**
+     * Whether to attach the sub-pipeline while the outer pipeline is still being iterated, so that
+     * its remote cursors, if any, fetch results in the background.
+     */
+    bool shouldPrefetchSubPipeline() const;
+
     void logStartingSubPipeline(const std::vector<BSONObj>& serializedPipeline);
     void logShardedViewFound(
         const ExceptionFor<ErrorCodes::CommandOnShardedViewNotSupportedOnMongod>& e);
@@ -173,6 +185,9 @@ private:
     std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
     Pipeline::SourceContainer _cachedPipeline;
     ExecutionProgress _executionState = ExecutionProgress::kIteratingSource;
+
+    // Whether '_pipeline' has been attached to its cursor source.
+    bool _subPipelineAttached = false;
     UnionWithStats _stats;
 };
 
@@ -48,6 +48,7 @@
 #include "mongo/db/pipeline/document_source_union_with.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/process_interface/stub_lookup_single_document_process_interface.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/intrusive_counter.h"
 
@@ -93,6 +94,36 @@ TEST_F(DocumentSourceUnionWithTest, BasicSerialUnions) {
     ASSERT_TRUE(unionWithTwo.getNext().isEOF());
 }
 
+TEST_F(DocumentSourceUnionWithTest, PrefetchingSubPipelineStillReturnsOuterResultsFirst) {
+    RAIIServerParameterControllerForTest controller("internalQueryUnionWithPrefetchSubPipeline",
+                                                    true);
+    const auto outerDocs = std::array{Document{{"a", 1}}, Document{{"a", 2}}};
+    const auto innerDocs = std::array{Document{{"b", 1}}, Document{{"b", 2}}};
+    const auto mock = DocumentSourceMock::createForTest(
+        std::deque<DocumentSource::GetNextResult>{Document{outerDocs[0]}, Document{outerDocs[1]}},
+        getExpCtx());
+    const auto mockDeque =
+        std::deque<DocumentSource::GetNextResult>{Document{innerDocs[0]}, Document{innerDocs[1]}};
+    const auto mockCtx = getExpCtx()->copyWith({});
+    mockCtx->mongoProcessInterface = std::make_unique<MockMongoInterface>(mockDeque);
+    auto unionWith = DocumentSourceUnionWith(
+        mockCtx, Pipeline::create(std::list<boost::intrusive_ptr<DocumentSource>>{}, getExpCtx()));
+    unionWith.setSource(mock.get());
+
+    for (const auto& doc : outerDocs) {
+        auto next = unionWith.getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.releaseDocument(), doc);
+    }
+    for (const auto& doc : innerDocs) {
+        auto next = unionWith.getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.releaseDocument(), doc);
+    }
+    ASSERT_TRUE(unionWith.getNext().isEOF());
+    ASSERT_TRUE(unionWith.getNext().isEOF());
+}
+
 TEST_F(DocumentSourceUnionWithTest, BasicNestedUnions) {
     const auto docs = std::array{Document{{"a", 1}}, Document{{"b", 1}}, Document{{"c", 1}}};
     const auto mock = DocumentSourceMock::createForTest(docs[0], getExpCtx());
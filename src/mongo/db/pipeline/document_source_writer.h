@@ -216,7 +216,7 @@ DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
                 batch.clear();
                 bufferedBytes = objSize;
             }
-            batch.push_back(obj);
+            batch.push_back(std::move(obj));
         }
         if (!batch.empty()) {
             spill(std::move(batch));
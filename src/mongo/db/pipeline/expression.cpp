@@ -51,6 +51,7 @@
 #include "mongo/db/stats/counters.h"
 #include "mongo/platform/bits.h"
 #include "mongo/platform/decimal128.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/regex_util.h"
 #include "mongo/util/str.h"
 #include "mongo/util/string_map.h"
@@ -7670,6 +7671,169 @@ REGISTER_EXPRESSION_WITH_MIN_VERSION(
     AllowedWithClientType::kAny,
     ServerGlobalParams::FeatureCompatibility::Version::kFullyDowngradedTo50);
 
+/* ------------------------- ExpressionSharedSubexpression ----------------------------- */
+
+namespace {
+/**
+ * Finds the subexpressions that can be shared across a set of expression trees, and replaces them.
+ * Subexpressions are identified by their serialization, so two subtrees are the same
+ * subexpression whenever they would be parsed back from the same BSON.
+ */
+class SubexpressionSharer {
+public:
+    void unshare(boost::intrusive_ptr<Expression>* slot) {
+        while (auto sharedExpr = dynamic_cast<ExpressionSharedSubexpression*>(slot->get())) {
+            auto child = sharedExpr->getChildren()[0];
+            *slot = std::move(child);
+        }
+        for (auto&& child : (*slot)->getChildren()) {
+            if (child) {
+                unshare(&child);
+            }
+        }
+    }
+
+    /**
+     * Counts the occurrences of every subexpression in the tree rooted at 'expr' that is eligible
+     * to be shared. Returns false if that tree calls into JavaScript, in which case neither it nor
+     * any of the trees containing it are eligible.
+     */
+    bool count(const Expression* expr) {
+        bool deterministic = true;
+        for (auto&& child : expr->getChildren()) {
+            if (child) {
+                deterministic = count(child.get()) && deterministic;
+            }
+        }
+        if (dynamic_cast<const ExpressionConstant*>(expr) ||
+            dynamic_cast<const ExpressionFieldPath*>(expr)) {
+            return deterministic;
+        }
+
+        BSONObjBuilder bob;
+        expr->serialize(false).addToBsonObj(&bob, ""_sd);
+        auto serialized = bob.obj();
+        if (auto elem = serialized.firstElement(); elem.type() == BSONType::Object) {
+            auto opName = elem.embeddedObject().firstElementFieldNameStringData();
+            deterministic = deterministic && opName != "$function"_sd &&
+                opName != "$_internalJsEmit"_sd;
+        }
+        if (!deterministic) {
+            return false;
+        }
+
+        // Variables defined by $let, $map and the like take a different value for each
+        // evaluation of the expression that defines them, even within a single document.
+        auto deps = expr->getDependencies();
+        if (!deps.vars.empty() || deps.needRandomGenerator) {
+            return true;
+        }
+
+        std::string key(serialized.objdata(), serialized.objsize());
+        ++_counts[key];
+        _keys.emplace(expr, std::move(key));
+        return true;
+    }
+
+    /**
+     * Only the first occurrence of a repeated subexpression will be evaluated, so the
+     * subexpressions nested in any other occurrence are not counted as repeated because of it.
+     */
+    void discountNestedRepeats(const Expression* expr) {
+        auto it = _keys.find(expr);
+        if (it != _keys.end() && _counts[it->second] > 1 && !_seen.insert(it->second).second) {
+            for (auto&& child : expr->getChildren()) {
+                if (child) {
+                    discount(child.get());
+                }
+            }
+            return;
+        }
+        for (auto&& child : expr->getChildren()) {
+            if (child) {
+                discountNestedRepeats(child.get());
+            }
+        }
+    }
+
+    void share(boost::intrusive_ptr<Expression>* slot) {
+        auto it = _keys.find(slot->get());
+        if (it == _keys.end() || _counts[it->second] <= 1) {
+            for (auto&& child : (*slot)->getChildren()) {
+                if (child) {
+                    share(&child);
+                }
+            }
+            return;
+        }
+
+        auto& sharedExpr = _shared[it->second];
+        if (!sharedExpr) {
+            if (!_scope) {
+                _scope = std::make_shared<ExpressionSharedSubexpression::Scope>();
+            }
+            for (auto&& child : (*slot)->getChildren()) {
+                if (child) {
+                    share(&child);
+                }
+            }
+            sharedExpr = make_intrusive<ExpressionSharedSubexpression>(
+                (*slot)->getExpressionContext(), *slot, _scope);
+        }
+        *slot = sharedExpr;
+    }
+
+    std::shared_ptr<ExpressionSharedSubexpression::Scope> releaseScope() {
+        return std::move(_scope);
+    }
+
+private:
+    void discount(const Expression* expr) {
+        if (auto it = _keys.find(expr); it != _keys.end()) {
+            --_counts[it->second];
+        }
+        for (auto&& child : expr->getChildren()) {
+            if (child) {
+                discount(child.get());
+            }
+        }
+    }
+
+    stdx::unordered_map<const Expression*, std::string> _keys;
+    StringMap<int> _counts;
+    StringSet _seen;
+    StringMap<boost::intrusive_ptr<ExpressionSharedSubexpression>> _shared;
+    std::shared_ptr<ExpressionSharedSubexpression::Scope> _scope;
+};
+}  // namespace
+
+std::shared_ptr<ExpressionSharedSubexpression::Scope>
+ExpressionSharedSubexpression::shareCommonSubexpressions(
+    const std::vector<boost::intrusive_ptr<Expression>*>& roots) {
+    SubexpressionSharer sharer;
+    for (auto&& root : roots) {
+        sharer.unshare(root);
+    }
+    for (auto&& root : roots) {
+        sharer.count(root->get());
+    }
+    for (auto&& root : roots) {
+        sharer.discountNestedRepeats(root->get());
+    }
+    for (auto&& root : roots) {
+        sharer.share(root);
+    }
+    return sharer.releaseScope();
+}
+
+Value ExpressionSharedSubexpression::evaluate(const Document& root, Variables* variables) const {
+    if (_cachedGeneration != _scope->generation()) {
+        _cachedValue = _children[0]->evaluate(root, variables);
+        _cachedGeneration = _scope->generation();
+    }
+    return _cachedValue;
+}
+
 MONGO_INITIALIZER_GROUP(BeginExpressionRegistration, ("default"), ("EndExpressionRegistration"))
 MONGO_INITIALIZER_GROUP(EndExpressionRegistration, ("BeginExpressionRegistration"), ())
 }  // namespace mongo
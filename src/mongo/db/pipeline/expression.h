@@ -35,6 +35,7 @@
 #include <boost/intrusive_ptr.hpp>
 #include <functional>
 #include <map>
+#include <memory>
 #include <pcre.h>
 #include <string>
 #include <utility>
@@ -4138,4 +4139,86 @@ public:
     }
 };
 
+/**
+ * Wraps a subexpression that occurs more than once across a set of expression trees which are
+ * evaluated against the same document, such as the computed fields of a projection. Every
+ * occurrence is replaced by the same ExpressionSharedSubexpression, which evaluates its child the
+ * first time it is reached for a document and returns the cached value for the other occurrences.
+ *
+ * The owner of the trees is responsible for calling Scope::newDocument() before it evaluates them
+ * against each new document. This node is transparent otherwise: it serializes as its child, so
+ * that a pipeline that is serialized and parsed again is shared again when it is optimized, and
+ * optimize() unwraps it so that the parent expressions can be optimized as if it was not there.
+ */
+class ExpressionSharedSubexpression final : public Expression {
+public:
+    /**
+     * Identifies the document that the shared subexpressions created by the same call to
+     * shareCommonSubexpressions() are being evaluated against.
+     */
+    class Scope {
+    public:
+        void newDocument() {
+            ++_generation;
+        }
+
+        uint64_t generation() const {
+            return _generation;
+        }
+
+    private:
+        uint64_t _generation = 1;
+    };
+
+    ExpressionSharedSubexpression(ExpressionContext* expCtx,
+                                  boost::intrusive_ptr<Expression> child,
+                                  std::shared_ptr<const Scope> scope)
+        : Expression(expCtx, {std::move(child)}), _scope(std::move(scope)) {}
+
+    /**
+     * Replaces every subexpression which occurs more than once among the trees rooted at 'roots'
+     * with a single ExpressionSharedSubexpression. Constants and field paths are cheaper to
+     * evaluate than to cache and are never shared, and neither are subexpressions that refer to
+     * a user-defined variable or that are not deterministic, such as $rand. Returns the scope of
+     * the new shared subexpressions, or nullptr if no subexpression was repeated.
+     */
+    static std::shared_ptr<Scope> shareCommonSubexpressions(
+        const std::vector<boost::intrusive_ptr<Expression>*>& roots);
+
+    Value evaluate(const Document& root, Variables* variables) const final;
+
+    boost::intrusive_ptr<Expression> optimize() final {
+        return _children[0]->optimize();
+    }
+
+    Value serialize(bool explain) const final {
+        return _children[0]->serialize(explain);
+    }
+
+    ComputedPaths getComputedPaths(const std::string& exprFieldPath,
+                                   Variables::Id renamingVar) const final {
+        return _children[0]->getComputedPaths(exprFieldPath, renamingVar);
+    }
+
+    void acceptVisitor(ExpressionMutableVisitor* visitor) final {
+        return visitor->visit(this);
+    }
+
+    void acceptVisitor(ExpressionConstVisitor* visitor) const final {
+        return visitor->visit(this);
+    }
+
+protected:
+    void _doAddDependencies(DepsTracker* deps) const final {
+        _children[0]->addDependencies(deps);
+    }
+
+private:
+    std::shared_ptr<const Scope> _scope;
+
+    // The value of the child for the document identified by '_cachedGeneration'.
+    mutable Value _cachedValue;
+    mutable uint64_t _cachedGeneration = 0;
+};
+
 }  // namespace mongo
@@ -40,7 +40,8 @@ namespace mongo {
 namespace {
 void benchmarkExpression(BSONObj expressionSpec,
                          benchmark::State& state,
-                         const std::vector<Document>& documents) {
+                         const std::vector<Document>& documents,
+                         bool shareCommonSubexpressions = false) {
     QueryTestServiceContext testServiceContext;
     auto opContext = testServiceContext.makeOperationContext();
     NamespaceString nss("test.bm");
@@ -51,17 +52,31 @@ void benchmarkExpression(BSONObj expressionSpec,
         exprContext.get(), expressionSpec, exprContext->variablesParseState);
 
     expression = expression->optimize();
+    std::shared_ptr<ExpressionSharedSubexpression::Scope> sharedSubexpressions;
+    if (shareCommonSubexpressions) {
+        sharedSubexpressions =
+            ExpressionSharedSubexpression::shareCommonSubexpressions({&expression});
+    }
 
     // Prepare parameters for the 'evaluate()' call.
     auto variables = &(exprContext->variables);
 
     // Run the test.
+    const auto numBufferAllocations = DocumentStorage::numBufferAllocations();
     for (auto keepRunning : state) {
         for (auto document : documents) {
+            if (sharedSubexpressions) {
+                sharedSubexpressions->newDocument();
+            }
             benchmark::DoNotOptimize(expression->evaluate(document, variables));
         }
         benchmark::ClobberMemory();
     }
+
+    // Report how many Document buffers each iteration had to get from the allocator.
+    state.counters["documentBufferAllocations"] =
+        benchmark::Counter(DocumentStorage::numBufferAllocations() - numBufferAllocations,
+                           benchmark::Counter::kAvgIterations);
 }
 
 void benchmarkExpression(BSONObj expressionSpec, benchmark::State& state) {
@@ -416,6 +431,25 @@ BENCHMARK(BM_SetFieldEvaluateExpression);
 BENCHMARK(BM_SetFieldWithRemoveExpression);
 BENCHMARK(BM_UnsetFieldEvaluateExpression);
 
+/**
+ * Tests performance of 'evaluate()' of an expression object computing ten fields from the fields of
+ * the input document, the way a $project or an $addFields stage does.
+ */
+void BM_ObjectExpressionTenFields(benchmark::State& state) {
+    BSONObjBuilder expressionBuilder;
+    MutableDocument document;
+    for (int i = 0; i < 10; ++i) {
+        const auto fieldName = "f" + std::to_string(i);
+        expressionBuilder << fieldName << BSON("$add" << BSON_ARRAY("$" + fieldName << 1));
+        document.addField(fieldName, Value(i));
+    }
+
+    std::vector<Document> documents(100, document.freeze());
+    benchmarkExpression(expressionBuilder.obj(), state, documents);
+}
+
+BENCHMARK(BM_ObjectExpressionTenFields);
+
 BSONArray randomBSONArray(int count, int max, int offset = 0) {
     BSONArrayBuilder builder;
     auto rng = PseudoRandom(std::random_device()());
@@ -503,5 +537,38 @@ BENCHMARK(BM_SetDifference);
 BENCHMARK(BM_SetEquals);
 BENCHMARK(BM_SetUnion);
 
+/**
+ * Tests performance of an expression which truncates the same date several times, as the
+ * computed fields of a projection often do, with and without sharing the repeated $dateTrunc.
+ */
+void testRepeatedSubexpression(benchmark::State& state, bool shareCommonSubexpressions) {
+    auto truncated = BSON("$dateTrunc" << BSON("date" << BSON("$toDate"
+                                                              << "$ts")
+                                                      << "unit"
+                                                      << "week"));
+    std::vector<Document> documents;
+    for (long long i = 0; i < 100; ++i) {
+        documents.push_back(Document{{"ts"_sd, 1605607121000LL + i * 86400000LL}});
+    }
+    benchmarkExpression(BSON("$sum" << BSON_ARRAY(BSON("$year" << truncated)
+                                                  << BSON("$month" << truncated)
+                                                  << BSON("$dayOfMonth" << truncated)
+                                                  << BSON("$hour" << truncated))),
+                        state,
+                        documents,
+                        shareCommonSubexpressions);
+}
+
+void BM_RepeatedSubexpression(benchmark::State& state) {
+    testRepeatedSubexpression(state, false);
+}
+
+void BM_RepeatedSubexpressionShared(benchmark::State& state) {
+    testRepeatedSubexpression(state, true);
+}
+
+BENCHMARK(BM_RepeatedSubexpression);
+BENCHMARK(BM_RepeatedSubexpressionShared);
+
 }  // namespace
 }  // namespace mongo
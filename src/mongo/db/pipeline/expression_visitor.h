@@ -174,6 +174,7 @@ class AccumulatorMergeObjects;
 
 class ExpressionTsSecond;
 class ExpressionTsIncrement;
+class ExpressionSharedSubexpression;
 
 template <typename AccumulatorState>
 class ExpressionFromAccumulator;
@@ -350,6 +351,8 @@ public:
     virtual void visit(expression_walker::MaybeConstPtr<IsConst, ExpressionSetField>) = 0;
     virtual void visit(expression_walker::MaybeConstPtr<IsConst, ExpressionTsSecond>) = 0;
     virtual void visit(expression_walker::MaybeConstPtr<IsConst, ExpressionTsIncrement>) = 0;
+    virtual void visit(
+        expression_walker::MaybeConstPtr<IsConst, ExpressionSharedSubexpression>) = 0;
 };
 
 using ExpressionMutableVisitor = ExpressionVisitor<false>;
@@ -34,12 +34,61 @@
 #include <iostream>
 
 #include "mongo/base/status_with.h"
+#include "mongo/db/auth/authorization_session.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 
 namespace {
 const auto getExec = OperationContext::declareDecoration<std::unique_ptr<JsExecution>>();
+
+// Scopes are not reused once they are this old, like the pooled scopes of the ScriptEngine.
+constexpr Seconds kMaxScopeReuseTime{10};
+
+/**
+ * The scope that the last JsExecution on this thread was done with, when it could be reused. A
+ * scope created by newScopeForCurrentThread() can only ever run on the thread that created it,
+ * and only one of them should exist on a thread at a time.
+ */
+struct IdleScope {
+    std::unique_ptr<Scope> scope;
+    std::string reuseKey;
+};
+thread_local IdleScope idleScope;
+
+/**
+ * Returns the key which an idle scope must have been released with to be reused by an operation
+ * with these parameters. Global variables set by one operation's JavaScript remain visible to the
+ * next, so scopes are only shared between operations on the same database and for the same users.
+ */
+std::string makeReuseKey(OperationContext* opCtx,
+                         StringData database,
+                         bool loadStoredProcedures,
+                         boost::optional<int> jsHeapLimitMB) {
+    StringBuilder sb;
+    sb << database << '\0' << loadStoredProcedures << '\0' << jsHeapLimitMB.value_or(-1);
+
+    auto as = AuthorizationSession::get(opCtx->getClient());
+    for (auto nameIter = as->getAuthenticatedUserNames(); nameIter.more(); nameIter.next()) {
+        // Using a NUL byte which isn't valid in usernames to separate them.
+        sb << '\0' << nameIter->getUnambiguousName();
+    }
+    return sb.str();
+}
+
+/**
+ * Takes this thread's idle scope if it was released with 'reuseKey'. Any other idle scope is
+ * destroyed, so that a new scope can be created for the current thread.
+ */
+std::unique_ptr<Scope> takeIdleScope(const std::string& reuseKey) {
+    auto scope = std::move(idleScope.scope);
+    if (scope &&
+        (idleScope.reuseKey != reuseKey ||
+         Date_t::now() - scope->getCreateTime() > kMaxScopeReuseTime)) {
+        scope.reset();
+    }
+    return scope;
+}
 }  // namespace
 
 JsExecution* JsExecution::get(OperationContext* opCtx,
@@ -49,7 +98,16 @@ JsExecution* JsExecution::get(OperationContext* opCtx,
                               boost::optional<int> jsHeapLimitMB) {
     auto& exec = getExec(opCtx);
     if (!exec) {
-        exec = std::make_unique<JsExecution>(opCtx, scope, jsHeapLimitMB);
+        std::string reuseKey;
+        std::unique_ptr<Scope> idle;
+        if (internalQueryJavaScriptReuseScopes.load()) {
+            reuseKey = makeReuseKey(opCtx, database, loadStoredProcedures, jsHeapLimitMB);
+            idle = takeIdleScope(reuseKey);
+        } else {
+            idleScope.scope.reset();
+        }
+        exec = std::make_unique<JsExecution>(opCtx, scope, jsHeapLimitMB, std::move(idle));
+        exec->_reuseKey = std::move(reuseKey);
         exec->getScope()->setLocalDB(database);
         if (loadStoredProcedures) {
             exec->getScope()->loadStored(opCtx, true);
@@ -63,6 +121,20 @@ JsExecution* JsExecution::get(OperationContext* opCtx,
     return exec.get();
 }
 
+JsExecution::~JsExecution() {
+    _scope->unregisterOperation();
+
+    // A scope with 'emit' installed can't be reused, since the native function refers to the
+    // stage that installed it.
+    if (_reuseKey.empty() || _emitCreated || _scope->hasOutOfMemoryException() ||
+        !_scope->getError().empty()) {
+        return;
+    }
+    _scope->reset();
+    idleScope.scope = std::move(_scope);
+    idleScope.reuseKey = std::move(_reuseKey);
+}
+
 Value JsExecution::callFunction(ScriptingFunction func,
                                 const BSONObj& params,
                                 const BSONObj& thisObj) {
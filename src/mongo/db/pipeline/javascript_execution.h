@@ -59,21 +59,26 @@ public:
                             bool loadStoredProcedures,
                             boost::optional<int> jsHeapLimitMB);
     /**
-     * Construct with a thread-local scope and initialize with the given scope variables.
+     * Construct with a thread-local scope and initialize with the given scope variables. Uses
+     * 'scope' if given, which must have been created for the current thread.
      */
     JsExecution(OperationContext* opCtx,
                 const BSONObj& scopeVars,
-                boost::optional<int> jsHeapLimitMB = boost::none)
-        : _scope(getGlobalScriptEngine()->newScopeForCurrentThread(jsHeapLimitMB)) {
+                boost::optional<int> jsHeapLimitMB = boost::none,
+                std::unique_ptr<Scope> scope = nullptr)
+        : _scope(scope ? std::move(scope)
+                       : std::unique_ptr<Scope>(
+                             getGlobalScriptEngine()->newScopeForCurrentThread(jsHeapLimitMB))) {
         _scopeVars = scopeVars.getOwned();
         _scope->init(&_scopeVars);
         _fnCallTimeoutMillis = internalQueryJavaScriptFnTimeoutMillis.load();
         _scope->registerOperation(opCtx);
     }
 
-    ~JsExecution() {
-        _scope->unregisterOperation();
-    };
+    /**
+     * Hands the scope over to the current thread for reuse if JsExecution::get() allowed it.
+     */
+    ~JsExecution();
 
     /**
      * Invokes the javascript function given by 'func' with the arguments 'params' and input object
@@ -122,6 +127,10 @@ private:
     bool _storedProceduresLoaded = false;
     int _fnCallTimeoutMillis;
 
+    // Identifies the operations which may reuse '_scope' once this one is done with it, or empty
+    // if it may not be reused.
+    std::string _reuseKey;
+
     Value doCallFunction(ScriptingFunction func,
                          const BSONObj& params,
                          const BSONObj& thisObj,
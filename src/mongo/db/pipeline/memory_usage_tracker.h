@@ -32,6 +32,7 @@
 #include <memory>
 #include <utility>
 
+#include "mongo/db/query/operation_memory_usage_tracker.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/str.h"
 
@@ -39,7 +40,8 @@ namespace mongo {
 
 /**
  * This is a utility class for tracking memory usage across multiple arbitrary operators or
- * functions, which are identified by their string names.
+ * functions, which are identified by their string names. The total is also reported to the
+ * OperationMemoryUsageTracker of the operation the tracker is attached to, if any.
  */
 class MemoryUsageTracker {
 public:
@@ -84,6 +86,38 @@ public:
     MemoryUsageTracker(bool allowDiskUse = false, size_t maxMemoryUsageBytes = 0)
         : _allowDiskUse(allowDiskUse), _maxAllowedMemoryUsageBytes(maxMemoryUsageBytes) {}
 
+    MemoryUsageTracker(const MemoryUsageTracker&) = delete;
+    MemoryUsageTracker& operator=(const MemoryUsageTracker&) = delete;
+
+    ~MemoryUsageTracker() {
+        setOperationTracker(nullptr);
+    }
+
+    /**
+     * Reports the total memory usage to 'operationTracker' from now on, moving the memory currently
+     * tracked away from the previous operation tracker, if any. Stages call this as they are
+     * attached to and detached from an operation, e.g. across getMores. May be null.
+     */
+    void setOperationTracker(OperationMemoryUsageTracker* operationTracker) {
+        if (_operationTracker) {
+            _operationTracker->update(-_memoryUsageBytes);
+        }
+        _operationTracker = operationTracker;
+        if (_operationTracker) {
+            _operationTracker->update(_memoryUsageBytes);
+        }
+    }
+
+    /**
+     * Returns true if the operation this tracker reports to, or the node, is over its memory limit
+     * and this tracker holds enough memory for freeing it to be worthwhile. Stages which can spill
+     * should do so when this returns true, as if they had exceeded their own limit.
+     */
+    bool operationMemoryLimitExceeded() const {
+        return _operationTracker && _memoryUsageBytes >= kMinMemoryBytesToFreeForOperationLimit &&
+            _operationTracker->exceedsLimit();
+    }
+
     /**
      * Sets the new total for 'name', and updates the current total memory usage.
      */
@@ -95,6 +129,9 @@ public:
      * Sets the new current memory usage in bytes.
      */
     void set(long long total) {
+        if (_operationTracker) {
+            _operationTracker->update(total - _memoryUsageBytes);
+        }
         _memoryUsageBytes = total;
         if (_memoryUsageBytes > _maxMemoryUsageBytes) {
             _maxMemoryUsageBytes = _memoryUsageBytes;
@@ -109,7 +146,7 @@ public:
         for (auto& [_, funcTracker] : _functionMemoryTracker) {
             funcTracker.set(0);
         }
-        _memoryUsageBytes = 0;
+        set(0);
     }
 
     /**
@@ -162,6 +199,10 @@ public:
     const size_t _maxAllowedMemoryUsageBytes;
 
 private:
+    // Below this, spilling a stage frees too little memory to help an operation or node that is
+    // over its limit, and would only produce many small spill files.
+    static constexpr long long kMinMemoryBytesToFreeForOperationLimit = 1024 * 1024;
+
     static absl::string_view _key(StringData s) {
         return {s.rawData(), s.size()};
     }
@@ -170,6 +211,8 @@ private:
     long long _memoryUsageBytes = 0;
     long long _maxMemoryUsageBytes = 0;
 
+    OperationMemoryUsageTracker* _operationTracker = nullptr;
+
     // Tracks memory consumption per function using the output field name as a key.
     stdx::unordered_map<std::string, PerFunctionMemoryTracker> _functionMemoryTracker;
 };
@@ -28,6 +28,7 @@
  */
 
 #include "mongo/db/pipeline/memory_usage_tracker.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 
@@ -119,5 +120,62 @@ DEATH_TEST_F(MemoryUsageTrackerTest,
     _funcTracker.update(-100);
 }
 
+TEST_F(MemoryUsageTrackerTest, ReportsTotalToOperationTracker) {
+    OperationMemoryUsageTracker operationTracker;
+    const auto globalBytesBefore = OperationMemoryUsageTracker::globalMemoryBytes();
+
+    _tracker.set(50LL);
+    _tracker.setOperationTracker(&operationTracker);
+    ASSERT_EQ(operationTracker.currentMemoryBytes(), 50LL);
+
+    _funcTracker.update(25);
+    ASSERT_EQ(operationTracker.currentMemoryBytes(), 75LL);
+    ASSERT_EQ(operationTracker.peakMemoryBytes(), 75LL);
+    ASSERT_EQ(OperationMemoryUsageTracker::globalMemoryBytes(), globalBytesBefore + 75);
+
+    _tracker.resetCurrent();
+    ASSERT_EQ(operationTracker.currentMemoryBytes(), 0LL);
+    ASSERT_EQ(operationTracker.peakMemoryBytes(), 75LL);
+    ASSERT_EQ(OperationMemoryUsageTracker::globalMemoryBytes(), globalBytesBefore);
+    _tracker.setOperationTracker(nullptr);
+}
+
+TEST_F(MemoryUsageTrackerTest, MovesMemoryBetweenOperationTrackers) {
+    OperationMemoryUsageTracker firstOperation;
+    OperationMemoryUsageTracker secondOperation;
+
+    _tracker.setOperationTracker(&firstOperation);
+    _tracker.set(100LL);
+    ASSERT_EQ(firstOperation.currentMemoryBytes(), 100LL);
+
+    _tracker.setOperationTracker(&secondOperation);
+    ASSERT_EQ(firstOperation.currentMemoryBytes(), 0LL);
+    ASSERT_EQ(firstOperation.peakMemoryBytes(), 100LL);
+    ASSERT_EQ(secondOperation.currentMemoryBytes(), 100LL);
+
+    _tracker.setOperationTracker(nullptr);
+    ASSERT_EQ(secondOperation.currentMemoryBytes(), 0LL);
+}
+
+TEST_F(MemoryUsageTrackerTest, OperationMemoryLimitExceeded) {
+    RAIIServerParameterControllerForTest maxOperationMemory{"internalQueryMaxOperationMemoryBytes",
+                                                            1024LL};
+    OperationMemoryUsageTracker operationTracker;
+    _tracker.setOperationTracker(&operationTracker);
+    ASSERT_FALSE(_tracker.operationMemoryLimitExceeded());
+
+    // The operation is over its limit, but this tracker holds too little to be worth freeing.
+    _tracker.set(2048LL);
+    ASSERT_TRUE(operationTracker.exceedsLimit());
+    ASSERT_FALSE(_tracker.operationMemoryLimitExceeded());
+
+    _tracker.set(2 * 1024 * 1024LL);
+    ASSERT_TRUE(_tracker.operationMemoryLimitExceeded());
+
+    _tracker.resetCurrent();
+    ASSERT_FALSE(operationTracker.exceedsLimit());
+    _tracker.setOperationTracker(nullptr);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,349 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/parallel_pipeline_prefix.h"
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+
+#include "mongo/base/counter.h"
+#include "mongo/base/string_data.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/pipeline/dependencies.h"
+#include "mongo/db/pipeline/document_source_cursor.h"
+#include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/document_source_queue.h"
+#include "mongo/db/pipeline/document_source_single_document_transformation.h"
+#include "mongo/db/query/internal_plans.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/service_context.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+Counter64 parallelAggregationsCounter;
+ServerStatusMetricField<Counter64> displayParallelAggregations("query.parallelAggregations",
+                                                               &parallelAggregationsCounter);
+
+/**
+ * Returns true if a $match in the parallel prefix would not have been able to use an index, so
+ * that running it on the workers after a collection scan loses nothing.
+ */
+bool matchCannotUseIndex(OperationContext* opCtx,
+                         const CollectionPtr& collection,
+                         DocumentSourceMatch* match) {
+    if (collection->getIndexCatalog()->numIndexesTotal(opCtx) > 1) {
+        return false;
+    }
+
+    DepsTracker deps;
+    match->getDependencies(&deps);
+    return std::none_of(deps.fields.begin(), deps.fields.end(), [](const std::string& field) {
+        return field == "_id" || str::startsWith(field, "_id.");
+    });
+}
+
+/**
+ * Runs the parsed shards half of the pipeline over the inclusive RecordId range ['min', 'max'] of
+ * the collection with UUID 'uuid' and returns its output.
+ */
+std::deque<DocumentSource::GetNextResult> runRange(
+    OperationContext* opCtx,
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& nss,
+    const UUID& uuid,
+    const std::vector<BSONObj>& shardStages,
+    const boost::optional<RecordId>& min,
+    const boost::optional<RecordId>& max) {
+    expCtx->opCtx = opCtx;
+    auto pipeline = Pipeline::parse(shardStages, expCtx);
+
+    {
+        AutoGetCollectionForRead autoColl(opCtx, {nss.db().toString(), uuid});
+        const auto& collection = autoColl.getCollection();
+        uassert(ErrorCodes::QueryPlanKilled,
+                str::stream() << "Collection " << nss
+                              << " was dropped or renamed during a parallel aggregation",
+                collection && collection->ns() == nss);
+
+        auto exec = InternalPlanner::collectionScan(opCtx,
+                                                    &collection,
+                                                    PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
+                                                    InternalPlanner::FORWARD,
+                                                    boost::none /* resumeAfterRecordId */,
+                                                    min,
+                                                    max);
+        pipeline->addInitialSource(DocumentSourceCursor::create(
+            collection, std::move(exec), expCtx, DocumentSourceCursor::CursorType::kRegular));
+    }
+
+    std::deque<DocumentSource::GetNextResult> results;
+    while (auto next = pipeline->getNext()) {
+        results.emplace_back(std::move(*next));
+    }
+    return results;
+}
+
+}  // namespace
+
+ParallelPipelinePrefix::ParallelPipelinePrefix(boost::intrusive_ptr<ExpressionContext> expCtx,
+                                               NamespaceString nss,
+                                               UUID uuid,
+                                               std::vector<BSONObj> shardStages,
+                                               std::vector<Range> ranges)
+    : _expCtx(std::move(expCtx)),
+      _nss(std::move(nss)),
+      _uuid(std::move(uuid)),
+      _shardStages(std::move(shardStages)),
+      _ranges(std::move(ranges)) {}
+
+boost::optional<ParallelPipelinePrefix> ParallelPipelinePrefix::splitIfEligible(
+    OperationContext* opCtx,
+    const CollectionPtr& collection,
+    const AggregateCommandRequest& request,
+    Pipeline* pipeline) {
+    const long long numThreads = internalQueryParallelAggregationThreads.load();
+    if (numThreads <= 1 || !collection) {
+        return boost::none;
+    }
+
+    // The workers read with their own snapshots and without any shard versioning, so only plain
+    // local reads on a single node qualify.
+    const auto& expCtx = pipeline->getContext();
+    if (expCtx->explain || expCtx->needsMerge || expCtx->fromMongos || expCtx->inMongos ||
+        expCtx->tailableMode != TailableModeEnum::kNormal || request.getExchange() ||
+        request.getRequestReshardingResumeToken() || opCtx->inMultiDocumentTransaction()) {
+        return boost::none;
+    }
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    if (readConcernArgs.getLevel() != repl::ReadConcernLevel::kLocalReadConcern ||
+        readConcernArgs.getArgsAfterClusterTime() || readConcernArgs.getArgsAtClusterTime()) {
+        return boost::none;
+    }
+
+    // Clustered collections and the oplog are not keyed by the integer RecordIds the ranges below
+    // are cut from.
+    if (collection->isClustered() || collection->ns().isOplog() ||
+        collection->numRecords(opCtx) < internalQueryParallelAggregationMinDocuments.load()) {
+        return boost::none;
+    }
+
+    const auto& sources = pipeline->getSources();
+    auto groupIt = std::find_if(sources.begin(), sources.end(), [](const auto& stage) {
+        return dynamic_cast<DocumentSourceGroup*>(stage.get()) != nullptr;
+    });
+    if (groupIt == sources.end()) {
+        return boost::none;
+    }
+    for (auto it = sources.begin(); it != groupIt; ++it) {
+        if (auto match = dynamic_cast<DocumentSourceMatch*>(it->get())) {
+            if (match->isTextQuery() || !matchCannotUseIndex(opCtx, collection, match)) {
+                return boost::none;
+            }
+        } else if (!dynamic_cast<DocumentSourceSingleDocumentTransformation*>(it->get())) {
+            return boost::none;
+        }
+    }
+
+    auto distributedPlanLogic = (*groupIt)->distributedPlanLogic();
+    if (!distributedPlanLogic || !distributedPlanLogic->shardsStage ||
+        !distributedPlanLogic->mergingStage || distributedPlanLogic->inputSortPattern) {
+        return boost::none;
+    }
+
+    auto first = collection->getCursor(opCtx, true /* forward */)->next();
+    auto last = collection->getCursor(opCtx, false /* forward */)->next();
+    if (!first || !last || !first->id.isLong() || !last->id.isLong()) {
+        return boost::none;
+    }
+    const int64_t minId = first->id.getLong();
+    const int64_t maxId = last->id.getLong();
+    const int64_t numRanges = std::min<int64_t>(numThreads, maxId - minId + 1);
+    if (numRanges <= 1) {
+        return boost::none;
+    }
+
+    const int64_t step = (maxId - minId) / numRanges + 1;
+    std::vector<Range> ranges(numRanges);
+    for (int64_t i = 0; i < numRanges; ++i) {
+        if (i > 0) {
+            ranges[i].min = RecordId(minId + i * step);
+        }
+        if (i < numRanges - 1) {
+            ranges[i].max = RecordId(minId + (i + 1) * step - 1);
+        }
+    }
+
+    // Move the prefix and the partial $group out of the pipeline, leaving the merging $group in
+    // their place.
+    std::vector<Value> serializedStages;
+    const auto prefixLength = std::distance(sources.begin(), groupIt);
+    for (long i = 0; i < prefixLength; ++i) {
+        pipeline->popFront()->serializeToArray(serializedStages);
+    }
+    pipeline->popFront();
+    distributedPlanLogic->shardsStage->serializeToArray(serializedStages);
+    pipeline->addInitialSource(distributedPlanLogic->mergingStage);
+
+    std::vector<BSONObj> shardStages;
+    for (auto&& stage : serializedStages) {
+        shardStages.push_back(stage.getDocument().toBson());
+    }
+
+    return ParallelPipelinePrefix(
+        expCtx, collection->ns(), collection->uuid(), std::move(shardStages), std::move(ranges));
+}
+
+boost::intrusive_ptr<DocumentSource> ParallelPipelinePrefix::run(OperationContext* opCtx) {
+    auto serviceContext = opCtx->getServiceContext();
+    const size_t numWorkers = _ranges.size();
+
+    // An ExpressionContext cannot be shared between threads. The workers produce partial results
+    // for the merging $group, as a shard would.
+    std::vector<boost::intrusive_ptr<ExpressionContext>> workerExpCtxs;
+    for (size_t i = 0; i < numWorkers; ++i) {
+        workerExpCtxs.push_back(_expCtx->copyWith(_nss, _uuid));
+        workerExpCtxs.back()->needsMerge = true;
+    }
+
+    std::vector<std::deque<DocumentSource::GetNextResult>> results(numWorkers);
+
+    auto mutex = MONGO_MAKE_LATCH("ParallelPipelinePrefix::mutex");
+    stdx::condition_variable cv;
+    size_t numFinished = 0;
+    Status status = Status::OK();
+    std::vector<OperationContext*> workerOpCtxs(numWorkers, nullptr);
+
+    auto runWorker = [&](size_t i) {
+        const std::string threadName = str::stream() << "ParallelAggregation-" << i;
+        ThreadClient tc(threadName, serviceContext);
+        auto workerOpCtx = tc->makeOperationContext();
+
+        Status workerStatus = Status::OK();
+        {
+            stdx::lock_guard<Latch> lk(mutex);
+            workerOpCtxs[i] = workerOpCtx.get();
+            workerStatus = status;
+        }
+        if (workerStatus.isOK()) {
+            try {
+                results[i] = runRange(workerOpCtx.get(),
+                                      workerExpCtxs[i],
+                                      _nss,
+                                      _uuid,
+                                      _shardStages,
+                                      _ranges[i].min,
+                                      _ranges[i].max);
+            } catch (const DBException& ex) {
+                workerStatus = ex.toStatus();
+            }
+        }
+
+        stdx::lock_guard<Latch> lk(mutex);
+        workerOpCtxs[i] = nullptr;
+        if (status.isOK() && !workerStatus.isOK()) {
+            status = workerStatus;
+        }
+        ++numFinished;
+        cv.notify_all();
+    };
+
+    std::vector<stdx::thread> workers;
+    ON_BLOCK_EXIT([&] {
+        for (auto&& worker : workers) {
+            worker.join();
+        }
+    });
+
+    parallelAggregationsCounter.increment();
+    LOGV2_DEBUG(5910927,
+                2,
+                "Running aggregation prefix in parallel",
+                "namespace"_attr = _nss,
+                "numWorkers"_attr = numWorkers);
+    for (size_t i = 0; i < numWorkers; ++i) {
+        workers.emplace_back(runWorker, i);
+    }
+
+    {
+        stdx::unique_lock<Latch> lk(mutex);
+        try {
+            opCtx->waitForConditionOrInterrupt(
+                cv, lk, [&] { return numFinished == numWorkers || !status.isOK(); });
+        } catch (const DBException& ex) {
+            if (status.isOK()) {
+                status = ex.toStatus();
+            }
+        }
+
+        // Stop the workers that are still running rather than waiting for them to finish work
+        // nobody will read.
+        if (!status.isOK()) {
+            for (auto workerOpCtx : workerOpCtxs) {
+                if (workerOpCtx) {
+                    stdx::lock_guard<Client> clientLock(*workerOpCtx->getClient());
+                    serviceContext->killOperation(clientLock, workerOpCtx);
+                }
+            }
+        }
+    }
+
+    for (auto&& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    uassertStatusOK(status);
+
+    // Queue the partial results in RecordId range order, so that order-sensitive accumulators such
+    // as $first see them in the order a single collection scan would have.
+    std::deque<DocumentSource::GetNextResult> partials;
+    for (auto&& rangeResults : results) {
+        std::move(rangeResults.begin(), rangeResults.end(), std::back_inserter(partials));
+    }
+    return make_intrusive<DocumentSourceQueue>(std::move(partials), _expCtx);
+}
+
+}  // namespace mongo
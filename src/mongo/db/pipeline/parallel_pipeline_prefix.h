@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/intrusive_ptr.hpp>
+#include <boost/optional.hpp>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/pipeline/aggregate_command_gen.h"
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/record_id.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class CollectionPtr;
+class OperationContext;
+
+/**
+ * Runs the leading part of an aggregation on several threads within a single mongod.
+ *
+ * A pipeline is eligible when everything before its first $group is a $match or a
+ * single-document transformation such as $project or $addFields. The pipeline is split at that
+ * $group with the same DistributedPlanLogic that mongos uses to split a pipeline between the shards
+ * and the merger: each worker thread runs the shards half (its own collection scan over a RecordId
+ * range, the per-document stages and a partial $group) and the original pipeline keeps the merging
+ * $group and everything after it, fed by the partial results of all the workers.
+ */
+class ParallelPipelinePrefix {
+public:
+    /**
+     * If the request, the collection and the optimized 'pipeline' allow it and
+     * 'internalQueryParallelAggregationThreads' is greater than one, removes the parallelizable
+     * prefix from 'pipeline', leaving its merging half in place, and returns the prefix. Otherwise
+     * returns boost::none and leaves 'pipeline' untouched.
+     *
+     * Must be called while holding a lock on 'collection'.
+     */
+    static boost::optional<ParallelPipelinePrefix> splitIfEligible(
+        OperationContext* opCtx,
+        const CollectionPtr& collection,
+        const AggregateCommandRequest& request,
+        Pipeline* pipeline);
+
+    /**
+     * Runs the prefix on its worker threads and waits for all of them, returning a stage which
+     * produces the partial results in RecordId range order so that it can be put at the front of
+     * the merging pipeline. Each worker takes its own collection lock, so the caller should not
+     * hold one. If 'opCtx' is interrupted or any worker fails, the remaining workers are killed
+     * and the error is thrown.
+     */
+    boost::intrusive_ptr<DocumentSource> run(OperationContext* opCtx);
+
+private:
+    struct Range {
+        boost::optional<RecordId> min;
+        boost::optional<RecordId> max;
+    };
+
+    ParallelPipelinePrefix(boost::intrusive_ptr<ExpressionContext> expCtx,
+                           NamespaceString nss,
+                           UUID uuid,
+                           std::vector<BSONObj> shardStages,
+                           std::vector<Range> ranges);
+
+    // The ExpressionContext of the merging pipeline, copied for each worker.
+    boost::intrusive_ptr<ExpressionContext> _expCtx;
+    NamespaceString _nss;
+    UUID _uuid;
+
+    // The serialized shards half of the pipeline, parsed again by every worker since stages cannot
+    // be shared between threads.
+    std::vector<BSONObj> _shardStages;
+
+    // One inclusive RecordId range per worker. The first and last ranges are unbounded below and
+    // above, respectively, so that no document is missed.
+    std::vector<Range> _ranges;
+};
+
+}  // namespace mongo
@@ -34,6 +34,8 @@
 
 #include "mongo/db/pipeline/pipeline_d.h"
 
+#include <algorithm>
+
 #include "mongo/base/exact_cast.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/catalog/collection.h"
@@ -42,6 +44,7 @@
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/exec/batched_random_record_cursor.h"
 #include "mongo/db/exec/collection_scan.h"
 #include "mongo/db/exec/fetch.h"
 #include "mongo/db/exec/multi_iterator.h"
@@ -74,6 +77,7 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/s/collection_sharding_state.h"
@@ -140,6 +144,23 @@ createRandomCursorExecutor(const CollectionPtr& coll,
         return std::pair{nullptr, false};
     }
 
+    // Outside of time-series collections, whose buckets are sampled individually, read the sample
+    // in sequential micro-batches starting at the random cursor's records if so configured.
+    const auto batchSize = static_cast<size_t>(internalQuerySampleFromRandomCursorBatchSize.load());
+    if (batchSize > 1 && !expCtx->ns.isTimeseriesBucketsCollection()) {
+        static const size_t kMaxRecordsPerRound = 1024;
+        const auto rangesPerRound =
+            std::clamp((static_cast<size_t>(sampleSize) + batchSize - 1) / batchSize,
+                       size_t{1},
+                       kMaxRecordsPerRound / batchSize);
+        rsRandCursor = std::make_unique<BatchedRandomRecordCursor>(
+            std::move(rsRandCursor),
+            coll->getRecordStore()->getCursor(opCtx),
+            batchSize,
+            rangesPerRound,
+            opCtx->getClient()->getPrng().nextInt64());
+    }
+
     // Build a MultiIteratorStage and pass it the random-sampling RecordCursor.
     auto ws = std::make_unique<WorkingSet>();
     std::unique_ptr<PlanStage> root =
@@ -282,7 +303,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
     const QueryMetadataBitSet& metadataRequested,
     BSONObj sortObj,
     SkipThenLimit skipThenLimit,
-    boost::optional<std::string> groupIdForDistinctScan,
+    boost::optional<std::vector<std::string>> groupIdsForDistinctScan,
     const AggregateCommandRequest* aggRequest,
     const size_t plannerOpts,
     const MatchExpressionParser::AllowedFeatureSet& matcherFeatures) {
@@ -336,13 +357,17 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
     // Mark the metadata that's requested by the pipeline on the CQ.
     cq.getValue()->requestAdditionalMetadata(metadataRequested);
 
-    if (groupIdForDistinctScan) {
-        // When the pipeline includes a $group that groups by a single field
-        // (groupIdForDistinctScan), we use getExecutorDistinct() to attempt to get an executor that
-        // uses a DISTINCT_SCAN to scan exactly one document for each group. When that's not
+    if (groupIdsForDistinctScan) {
+        // When the pipeline includes a $group that groups by one or more fields
+        // (groupIdsForDistinctScan), we use getExecutorDistinct() to attempt to get an executor
+        // that uses a DISTINCT_SCAN to scan exactly one document for each group. When that's not
         // possible, we return nullptr, and the caller is responsible for trying again without
-        // passing a 'groupIdForDistinctScan' value.
-        ParsedDistinct parsedDistinct(std::move(cq.getValue()), *groupIdForDistinctScan);
+        // passing a 'groupIdsForDistinctScan' value.
+        invariant(!groupIdsForDistinctScan->empty());
+        ParsedDistinct parsedDistinct(
+            std::move(cq.getValue()),
+            groupIdsForDistinctScan->front(),
+            {std::next(groupIdsForDistinctScan->begin()), groupIdsForDistinctScan->end()});
 
         // Note that we request a "strict" distinct plan because:
         // 1) We do not want to have to de-duplicate the results of the plan.
@@ -957,7 +982,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
                                                       deps.metadataDeps(),
                                                       sortObj,
                                                       SkipThenLimit{boost::none, boost::none},
-                                                      rewrittenGroupStage->groupId(),
+                                                      rewrittenGroupStage->groupIds(),
                                                       aggRequest,
                                                       plannerOpts,
                                                       matcherFeatures);
@@ -997,7 +1022,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
                                 deps.metadataDeps(),
                                 sortObj,
                                 skipThenLimit,
-                                boost::none, /* groupIdForDistinctScan */
+                                boost::none, /* groupIdsForDistinctScan */
                                 aggRequest,
                                 plannerOpts,
                                 matcherFeatures);
@@ -32,7 +32,9 @@
 #include "mongo/db/pipeline/plan_explainer_pipeline.h"
 
 #include "mongo/db/pipeline/document_source_cursor.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_lookup.h"
+#include "mongo/db/pipeline/document_source_set_window_fields.h"
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/document_source_union_with.h"
 #include "mongo/db/pipeline/plan_executor_pipeline.h"
@@ -80,8 +82,15 @@ void PlanExplainerPipeline::getSummaryStats(PlanSummaryStats* statsOut) const {
     for (auto&& source : _pipeline->getSources()) {
         statsOut->usedDisk = statsOut->usedDisk || source->usedDisk();
 
-        if (dynamic_cast<DocumentSourceSort*>(source.get())) {
-            statsOut->hasSortStage = true;
+        if (dynamic_cast<DocumentSourceSort*>(source.get()) ||
+            dynamic_cast<DocumentSourceGroup*>(source.get())) {
+            // Reports spilling, and sets 'hasSortStage' for $sort.
+            source->getSpecificStats()->accumulate(*statsOut);
+        } else if (auto docSourceSetWindowFields =
+                       dynamic_cast<DocumentSourceInternalSetWindowFields*>(source.get())) {
+            const auto& iterator = docSourceSetWindowFields->getPartitionIterator();
+            statsOut->spilledBytes += iterator.spilledBytes();
+            statsOut->spillTimeMicros += iterator.spillTimeMicros();
         } else if (auto docSourceLookUp = dynamic_cast<DocumentSourceLookUp*>(source.get())) {
             collectPlanSummaryStats<DocumentSourceLookUp, DocumentSourceLookupStats>(
                 *docSourceLookUp, statsOut);
@@ -48,6 +48,7 @@
 #include "mongo/db/curop.h"
 #include "mongo/db/cursor_manager.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/pipeline/document_source_cursor.h"
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
@@ -214,6 +215,12 @@ std::vector<Document> CommonMongodProcessInterface::getIndexStats(OperationConte
             doc["building"] = Value(true);
         }
 
+        BSONObjBuilder keyFilterStats;
+        if (entry->accessMethod()->getSortedDataInterface()->appendKeyFilterStats(
+                &keyFilterStats)) {
+            doc["keyFilter"] = Value(keyFilterStats.obj());
+        }
+
         indexStats.push_back(doc.freeze());
     }
     return indexStats;
@@ -77,6 +77,13 @@ std::vector<BSONObj> CommonProcessInterface::getCurrentOps(
          Client* client = cursor.next();) {
         invariant(client);
 
+        // Most connections are idle at any given time, so avoid taking their client lock (and
+        // contending with their next operation) when idle connections are not requested.
+        if (connMode == CurrentOpConnectionsMode::kExcludeIdle &&
+            !client->mayHaveActiveCurrentOp()) {
+            continue;
+        }
+
         stdx::lock_guard<Client> lk(*client);
 
         // If auth is disabled, ignore the allUsers parameter.
@@ -254,6 +254,22 @@ public:
                                                 const NamespaceString& ns,
                                                 const std::vector<BSONObj>& indexSpecs) = 0;
 
+    /**
+     * Returns true if createIndexesAfterLoad() can build indexes on 'ns' from this process, which
+     * requires that it be able to write to 'ns' locally.
+     */
+    virtual bool canCreateIndexesAfterLoad(OperationContext* opCtx,
+                                           const NamespaceString& ns) = 0;
+
+    /**
+     * Builds the given indexes on 'ns', which may already hold documents, the way an index build
+     * does: with one scan of the collection, feeding the keys through the external sorter. Must
+     * only be called if canCreateIndexesAfterLoad() returned true.
+     */
+    virtual void createIndexesAfterLoad(OperationContext* opCtx,
+                                        const NamespaceString& ns,
+                                        const std::vector<BSONObj>& indexSpecs) = 0;
+
     virtual void dropCollection(OperationContext* opCtx, const NamespaceString& collection) = 0;
 
     /**
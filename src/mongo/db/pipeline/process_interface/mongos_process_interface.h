@@ -143,6 +143,16 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    bool canCreateIndexesAfterLoad(OperationContext* opCtx, const NamespaceString& ns) final {
+        return false;
+    }
+
+    void createIndexesAfterLoad(OperationContext* opCtx,
+                                const NamespaceString& ns,
+                                const std::vector<BSONObj>& indexSpecs) final {
+        MONGO_UNREACHABLE;
+    }
+
     void dropCollection(OperationContext* opCtx, const NamespaceString& collection) final {
         MONGO_UNREACHABLE;
     }
@@ -179,6 +179,34 @@ void NonShardServerProcessInterface::createIndexesOnEmptyCollection(
             wuow.commit();
         });
 }
+
+void NonShardServerProcessInterface::createIndexesAfterLoad(
+    OperationContext* opCtx, const NamespaceString& ns, const std::vector<BSONObj>& indexSpecs) {
+    AutoGetCollection autoColl(opCtx, ns, MODE_X);
+    uassert(ErrorCodes::DatabaseDropPending,
+            str::stream() << "The database is in the process of being dropped " << ns.db(),
+            autoColl.getDb() && !autoColl.getDb()->isDropPending(opCtx));
+
+    const auto& collection = autoColl.getCollection();
+    uassert(ErrorCodes::NamespaceNotFound,
+            str::stream() << "Failed to create indexes for aggregation because collection "
+                             "does not exist: "
+                          << ns << ": " << BSON("indexes" << indexSpecs),
+            collection);
+
+    auto removeIndexBuildsToo = false;
+    auto filteredIndexes = collection->getIndexCatalog()->removeExistingIndexes(
+        opCtx, collection, indexSpecs, removeIndexBuildsToo);
+    if (filteredIndexes.empty()) {
+        return;
+    }
+
+    auto indexConstraints = IndexBuildsManager::IndexConstraints::kEnforce;
+    auto fromMigrate = false;
+    IndexBuildsCoordinator::get(opCtx)->createIndexes(
+        opCtx, collection->uuid(), filteredIndexes, indexConstraints, fromMigrate);
+}
+
 void NonShardServerProcessInterface::renameIfOptionsAndIndexesHaveNotChanged(
     OperationContext* opCtx,
     const BSONObj& renameCommandObj,
@@ -119,6 +119,14 @@ public:
                                         const NamespaceString& ns,
                                         const std::vector<BSONObj>& indexSpecs) override;
 
+    bool canCreateIndexesAfterLoad(OperationContext* opCtx, const NamespaceString& ns) override {
+        return true;
+    }
+
+    void createIndexesAfterLoad(OperationContext* opCtx,
+                                const NamespaceString& ns,
+                                const std::vector<BSONObj>& indexSpecs) override;
+
     void setExpectedShardVersion(OperationContext* opCtx,
                                  const NamespaceString& nss,
                                  boost::optional<ChunkVersion> chunkVersion) override {
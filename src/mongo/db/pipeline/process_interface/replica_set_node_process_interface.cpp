@@ -124,6 +124,13 @@ void ReplicaSetNodeProcessInterface::createIndexesOnEmptyCollection(
     uassertStatusOK(_executeCommandOnPrimary(opCtx, ns, cmd.obj()));
 }
 
+bool ReplicaSetNodeProcessInterface::canCreateIndexesAfterLoad(OperationContext* opCtx,
+                                                                const NamespaceString& ns) {
+    // Only the primary can build the indexes itself. Elsewhere the indexes must exist before the
+    // documents are written, since they are inserted remotely on the primary.
+    return _canWriteLocally(opCtx, ns);
+}
+
 void ReplicaSetNodeProcessInterface::renameIfOptionsAndIndexesHaveNotChanged(
     OperationContext* opCtx,
     const BSONObj& renameCommandObj,
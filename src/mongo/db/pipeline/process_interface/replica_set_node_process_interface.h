@@ -83,6 +83,7 @@ public:
     void createIndexesOnEmptyCollection(OperationContext* opCtx,
                                         const NamespaceString& ns,
                                         const std::vector<BSONObj>& indexSpecs);
+    bool canCreateIndexesAfterLoad(OperationContext* opCtx, const NamespaceString& ns);
 
 private:
     /**
@@ -46,6 +46,7 @@
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/s/sharding_state.h"
+#include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/s/cluster_commands_helpers.h"
 #include "mongo/s/cluster_write.h"
@@ -398,8 +399,90 @@ std::unique_ptr<Pipeline, PipelineDeleter>
 ShardServerProcessInterface::attachCursorSourceToPipeline(Pipeline* ownedPipeline,
                                                           ShardTargetingPolicy shardTargetingPolicy,
                                                           boost::optional<BSONObj> readConcern) {
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline(
+        ownedPipeline, PipelineDeleter(ownedPipeline->getContext()->opCtx));
+    if (shardTargetingPolicy == ShardTargetingPolicy::kAllowed && !readConcern) {
+        if (auto localPipeline = _attachCursorSourceToCollocatedPipeline(*pipeline)) {
+            return localPipeline;
+        }
+    }
     return sharded_agg_helpers::attachCursorToPipeline(
-        ownedPipeline, shardTargetingPolicy, std::move(readConcern));
+        pipeline.release(), shardTargetingPolicy, std::move(readConcern));
+}
+
+std::unique_ptr<Pipeline, PipelineDeleter>
+ShardServerProcessInterface::_attachCursorSourceToCollocatedPipeline(const Pipeline& pipeline) {
+    const auto& expCtx = pipeline.getContext();
+    auto opCtx = expCtx->opCtx;
+    const auto& nss = expCtx->ns;
+
+    // Only versioned sub-operations can be read locally, since the versions set below are what
+    // makes the local read check its routing information and filter out orphans.
+    if (!internalQueryEnableCollocatedSubPipelineReads.load() || !_opIsVersioned ||
+        opCtx->inMultiDocumentTransaction() || expCtx->explain ||
+        expCtx->isTailableAwaitData() || nss.isConfigDotCacheDotChunks()) {
+        return nullptr;
+    }
+
+    auto swCM = Grid::get(opCtx)->catalogCache()->getCollectionRoutingInfo(opCtx, nss);
+    if (!swCM.isOK()) {
+        return nullptr;
+    }
+    const auto& cm = swCM.getValue();
+    const auto thisShardId = ShardingState::get(opCtx)->shardId();
+
+    // The sub-pipeline is collocated with this shard if the routing table would send all of it
+    // here: either the collection is unsharded and this shard is the primary of its database, or
+    // the sub-pipeline's query only targets chunks this shard owns.
+    auto shardVersion = ChunkVersion::UNSHARDED();
+    boost::optional<DatabaseVersion> dbVersion;
+    if (cm.isSharded()) {
+        const auto shardIds = getTargetedShardsForQuery(
+            expCtx, cm, pipeline.getInitialQuery(), expCtx->getCollatorBSON());
+        if (shardIds != std::set<ShardId>{thisShardId} || pipeline.needsMongosMerger() ||
+            (pipeline.needsPrimaryShardMerger() && cm.dbPrimary() != thisShardId)) {
+            return nullptr;
+        }
+        shardVersion = cm.getVersion(thisShardId);
+    } else {
+        if (cm.dbPrimary() != thisShardId || pipeline.needsMongosMerger()) {
+            return nullptr;
+        }
+        dbVersion = cm.dbVersion();
+    }
+
+    // The versions expected for a namespace cannot change once the operation has checked them, so
+    // fall back to targeting if a different version has already been set for this operation.
+    auto& oss = OperationShardingState::get(opCtx);
+    if (oss.hasShardVersion(nss) && oss.getShardVersion(nss) != shardVersion) {
+        return nullptr;
+    }
+    if (auto existingDbVersion = oss.getDbVersion(nss.db()); dbVersion && existingDbVersion) {
+        if (*existingDbVersion != *dbVersion) {
+            return nullptr;
+        }
+        dbVersion = boost::none;
+    }
+    oss.initializeClientRoutingVersions(nss, shardVersion, dbVersion);
+
+    // If a migration or movePrimary has changed the placement of the data since the routing table
+    // was cached, the local read fails its version check and the sub-pipeline is targeted instead.
+    try {
+        return attachCursorSourceToPipelineForLocalRead(pipeline.clone().release());
+    } catch (const ExceptionForCat<ErrorCategory::StaleShardVersionError>& ex) {
+        LOGV2_DEBUG(5910930,
+                    3,
+                    "Targeting collocated sub-pipeline after its local read failed",
+                    "namespace"_attr = nss,
+                    "error"_attr = redact(ex.toStatus()));
+    } catch (const ExceptionFor<ErrorCodes::StaleDbVersion>& ex) {
+        LOGV2_DEBUG(5910931,
+                    3,
+                    "Targeting collocated sub-pipeline after its local read failed",
+                    "namespace"_attr = nss,
+                    "error"_attr = redact(ex.toStatus()));
+    }
+    return nullptr;
 }
 
 void ShardServerProcessInterface::setExpectedShardVersion(
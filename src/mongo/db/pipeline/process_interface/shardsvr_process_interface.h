@@ -122,6 +122,19 @@ public:
     void createIndexesOnEmptyCollection(OperationContext* opCtx,
                                         const NamespaceString& ns,
                                         const std::vector<BSONObj>& indexSpecs) final;
+
+    /**
+     * Indexes on a shard are created through the primary shard of the database, so they are
+     * never built here after the documents are loaded.
+     */
+    bool canCreateIndexesAfterLoad(OperationContext* opCtx, const NamespaceString& ns) final {
+        return false;
+    }
+    void createIndexesAfterLoad(OperationContext* opCtx,
+                                const NamespaceString& ns,
+                                const std::vector<BSONObj>& indexSpecs) final {
+        MONGO_UNREACHABLE;
+    }
     void dropCollection(OperationContext* opCtx, const NamespaceString& collection) final;
 
     /**
@@ -140,6 +153,15 @@ public:
                                  boost::optional<ChunkVersion> chunkVersion) final;
 
 private:
+    /**
+     * Returns a copy of 'pipeline' with a local cursor source attached if the routing table shows
+     * that all of its data lives on this shard, so that collocated sub-pipelines such as those of
+     * $lookup do not have to be dispatched through the shard targeting path. Returns nullptr if
+     * the pipeline must be targeted instead.
+     */
+    std::unique_ptr<Pipeline, PipelineDeleter> _attachCursorSourceToCollocatedPipeline(
+        const Pipeline& pipeline);
+
     // If the current operation is versioned, then we attach the DB version to the command object;
     // otherwise, it is returned unmodified. Used when running internal commands, as the parent
     // operation may be unversioned if run by a client connecting directly to the shard. If a shard
@@ -140,6 +140,14 @@ public:
                                         const std::vector<BSONObj>& indexSpecs) override {
         MONGO_UNREACHABLE;
     }
+    bool canCreateIndexesAfterLoad(OperationContext* opCtx, const NamespaceString& ns) override {
+        return false;
+    }
+    void createIndexesAfterLoad(OperationContext* opCtx,
+                                const NamespaceString& ns,
+                                const std::vector<BSONObj>& indexSpecs) override {
+        MONGO_UNREACHABLE;
+    }
     void dropCollection(OperationContext* opCtx, const NamespaceString& ns) override {
         MONGO_UNREACHABLE;
     }
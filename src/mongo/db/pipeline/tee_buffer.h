@@ -64,6 +64,9 @@ public:
      * consumer will not consume all input.
      */
     void dispose(size_t consumerId) {
+        if (_consumers[consumerId].nLeftToReturn > 0) {
+            --_nConsumersStillProcessingBatch;
+        }
         _consumers[consumerId].stillInUse = false;
         _consumers[consumerId].nLeftToReturn = 0;
         if (std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
@@ -103,5 +106,9 @@ private:
         int nLeftToReturn = 0;
     };
     std::vector<ConsumerInfo> _consumers;
+
+    // The number of consumers with a positive 'nLeftToReturn', so that getNext() does not have to
+    // look at every consumer to find out whether the batch has been fully consumed.
+    size_t _nConsumersStillProcessingBatch = 0;
 };
 }  // namespace mongo
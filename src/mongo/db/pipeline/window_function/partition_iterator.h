@@ -126,6 +126,14 @@ public:
         return _cache->usedDisk();
     }
 
+    uint64_t spilledBytes() const {
+        return _cache->spilledBytes();
+    }
+
+    uint64_t spillTimeMicros() const {
+        return _cache->spillTimeMicros();
+    }
+
     /**
      * Clean up all memory associated with the partition iterator. All calls requesting documents
      * are invalid after calling this.
@@ -33,6 +33,7 @@
 
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/record_data.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -102,8 +103,13 @@ void SpillableCache::writeBatchToDisk(std::vector<Record>& records) {
     // rather with the timestamp of the owning operation. We don't care about the timestamps.
     std::vector<Timestamp> timestamps(records.size());
 
+    Timer spillTimer;
     _expCtx->mongoProcessInterface->writeRecordsToRecordStore(
         _expCtx, _diskCache->rs(), &records, timestamps);
+    _spillTimeMicros += spillTimer.micros();
+    for (const auto& record : records) {
+        _spilledBytes += record.data.size();
+    }
 }
 void SpillableCache::spillToDisk() {
     if (!_diskCache) {
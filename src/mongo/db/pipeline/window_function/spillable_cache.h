@@ -107,6 +107,16 @@ public:
         return _usedDisk;
     }
 
+    /**
+     * The number of bytes of documents spilled to disk so far, and the time spent writing them.
+     */
+    uint64_t spilledBytes() const {
+        return _spilledBytes;
+    }
+    uint64_t spillTimeMicros() const {
+        return _spillTimeMicros;
+    }
+
     /**
      * Returns the id of the last document inserted.
      */
@@ -150,6 +160,8 @@ private:
 
     // Be able to report that disk was used after the cache has been finalized.
     bool _usedDisk = false;
+    uint64_t _spilledBytes = 0;
+    uint64_t _spillTimeMicros = 0;
 
     MemoryUsageTracker::PerFunctionMemoryTracker _memTracker;
 };
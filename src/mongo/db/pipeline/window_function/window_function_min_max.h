@@ -29,11 +29,21 @@
 
 #pragma once
 
+#include <deque>
+
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/window_function/window_function.h"
 
 namespace mongo {
 
+/**
+ * Removable $min/$max over a sliding window. Values are always removed in the order they were
+ * added, so instead of keeping every value in the window in sorted order we keep a monotonic deque
+ * of the values that can still become the result: each new value evicts the values at the back
+ * that it beats, since they leave the window before it does. The front of the deque is therefore
+ * the current result. Every value is pushed and popped at most once, which makes add() and
+ * remove() amortized constant time.
+ */
 template <AccumulatorMinMax::Sense sense>
 class WindowFunctionMinMax : public WindowFunctionState {
 public:
@@ -43,47 +53,66 @@ public:
         return std::make_unique<WindowFunctionMinMax<sense>>(expCtx);
     }
 
-    explicit WindowFunctionMinMax(ExpressionContext* const expCtx)
-        : WindowFunctionState(expCtx),
-          _values(_expCtx->getValueComparator().makeOrderedValueMultiset()) {
+    explicit WindowFunctionMinMax(ExpressionContext* const expCtx) : WindowFunctionState(expCtx) {
         _memUsageBytes = sizeof(*this);
     }
 
     void add(Value value) final {
+        // To satisfy "remove() undoes add() when called in FIFO order", ties must resolve the same
+        // way as if the whole window were sorted stably: $min returns the oldest of the equal
+        // values and $max the newest. So a new value evicts equal values only for $max.
+        const auto& comparator = _expCtx->getValueComparator();
+        while (!_candidates.empty()) {
+            int cmp = comparator.compare(_candidates.back().value, value);
+            bool beaten = sense == AccumulatorMinMax::Sense::kMin ? cmp > 0 : cmp <= 0;
+            if (!beaten)
+                break;
+            _memUsageBytes -= _candidates.back().value.getApproximateSize();
+            _candidates.pop_back();
+        }
         _memUsageBytes += value.getApproximateSize();
-        _values.insert(std::move(value));
+        _candidates.push_back({std::move(value), _numAdded++});
     }
 
     void remove(Value value) final {
-        // std::multiset::insert is guaranteed to put the element after any equal elements
-        // already in the container. So find() / erase() will remove the oldest equal element,
-        // which is what we want, to satisfy "remove() undoes add() when called in FIFO order".
-        auto iter = _values.find(std::move(value));
-        tassert(5371400, "Can't remove from an empty WindowFunctionMinMax", iter != _values.end());
-        _memUsageBytes -= iter->getApproximateSize();
-        _values.erase(iter);
+        tassert(5371400,
+                "Can't remove from an empty WindowFunctionMinMax",
+                _numRemoved < _numAdded);
+        // The removed value is the oldest one in the window. It is only still a candidate if no
+        // later value has evicted it, in which case it is at the front.
+        if (!_candidates.empty() && _candidates.front().position == _numRemoved) {
+            _memUsageBytes -= _candidates.front().value.getApproximateSize();
+            _candidates.pop_front();
+        }
+        ++_numRemoved;
     }
 
     void reset() final {
-        _values.clear();
+        _candidates.clear();
+        _numAdded = 0;
+        _numRemoved = 0;
         _memUsageBytes = sizeof(*this);
     }
 
     Value getValue() const final {
-        if (_values.empty())
+        if (_candidates.empty())
             return kDefault;
-        switch (sense) {
-            case AccumulatorMinMax::Sense::kMin:
-                return *_values.begin();
-            case AccumulatorMinMax::Sense::kMax:
-                return *_values.rbegin();
-        }
-        MONGO_UNREACHABLE_TASSERT(5371401);
+        return _candidates.front().value;
     }
 
 protected:
-    // Holds all the values in the window, in order, with constant-time access to both ends.
-    ValueMultiset _values;
+    struct Candidate {
+        Value value;
+        // The number of values added to the window before this one.
+        long long position;
+    };
+
+    // The values that will become the result once the values in front of them are removed, in the
+    // order they were added. They are non-decreasing for $min and strictly decreasing for $max,
+    // with the current result at the front.
+    std::deque<Candidate> _candidates;
+    long long _numAdded = 0;
+    long long _numRemoved = 0;
 };
 using WindowFunctionMin = WindowFunctionMinMax<AccumulatorMinMax::Sense::kMin>;
 using WindowFunctionMax = WindowFunctionMinMax<AccumulatorMinMax::Sense::kMax>;
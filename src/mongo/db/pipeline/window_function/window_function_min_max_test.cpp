@@ -151,5 +151,53 @@ TEST_F(WindowFunctionMinMaxTest, TracksMemoryUsageOnAddAndRemove) {
     ASSERT_EQ(min.getApproximateSize(), trackingSize);
 }
 
+TEST_F(WindowFunctionMinMaxTest, SlidingWindowMatchesSortedWindow) {
+    // Slide a window of 5 over values with plenty of repeats, and check every step against the
+    // ends of a sorted copy of the window.
+    std::deque<Value> window;
+    auto sorted = expCtx->getValueComparator().makeOrderedValueMultiset();
+    for (int i = 0; i < 100; ++i) {
+        auto value = Value{(i * 7919) % 13};
+        min.add(value);
+        max.add(value);
+        window.push_back(value);
+        sorted.insert(value);
+        if (window.size() > 5) {
+            min.remove(window.front());
+            max.remove(window.front());
+            sorted.erase(sorted.find(window.front()));
+            window.pop_front();
+        }
+        ASSERT_VALUE_EQ(min.getValue(), *sorted.begin());
+        ASSERT_VALUE_EQ(max.getValue(), *sorted.rbegin());
+    }
+
+    while (!window.empty()) {
+        min.remove(window.front());
+        max.remove(window.front());
+        window.pop_front();
+    }
+    ASSERT_VALUE_EQ(min.getValue(), Value{BSONNULL});
+    ASSERT_VALUE_EQ(max.getValue(), Value{BSONNULL});
+}
+
+TEST_F(WindowFunctionMinMaxTest, DoesNotHoldOnToValuesThatCannotBeTheResult) {
+    auto largeStr = Value{"this is quite a long string"_sd};
+    min.add(largeStr);
+    ASSERT_EQ(min.getApproximateSize(), sizeof(WindowFunctionMin) + largeStr.getApproximateSize());
+
+    // A smaller value leaves the window after 'largeStr', so 'largeStr' can never be the $min
+    // again.
+    min.add(Value{1});
+    ASSERT_EQ(min.getApproximateSize(), sizeof(WindowFunctionMin) + Value{1}.getApproximateSize());
+    ASSERT_VALUE_EQ(min.getValue(), Value{1});
+
+    min.remove(largeStr);
+    ASSERT_VALUE_EQ(min.getValue(), Value{1});
+    min.remove(Value{1});
+    ASSERT_VALUE_EQ(min.getValue(), Value{BSONNULL});
+    ASSERT_EQ(min.getApproximateSize(), sizeof(WindowFunctionMin));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,96 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/profile_buffer.h"
+
+#include "mongo/db/profile_buffer_gen.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getProfileBuffer = ServiceContext::declareDecoration<ProfileBuffer>();
+
+}  // namespace
+
+ProfileBuffer& ProfileBuffer::get(ServiceContext* serviceContext) {
+    return getProfileBuffer(serviceContext);
+}
+
+size_t ProfileBuffer::configuredCapacity() {
+    return static_cast<size_t>(gProfileBufferSizeRecords.load());
+}
+
+void ProfileBuffer::append(StringData dbName, BSONObj entry, size_t capacity) {
+    invariant(capacity > 0);
+    entry = entry.getOwned();
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_entries.size() != capacity) {
+        _entries.clear();
+        _entries.resize(capacity);
+        _next = 0;
+    }
+
+    auto& slot = _entries[_next];
+    slot.dbName = dbName.toString();
+    slot.obj = std::move(entry);
+    _next = (_next + 1) % capacity;
+    ++_totalAppended;
+}
+
+std::vector<BSONObj> ProfileBuffer::snapshot(StringData dbName) const {
+    std::vector<BSONObj> result;
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    result.reserve(_entries.size());
+    for (size_t i = 0; i < _entries.size(); ++i) {
+        const auto& slot = _entries[(_next + i) % _entries.size()];
+        if (slot.obj.isEmpty() || (!dbName.empty() && slot.dbName != dbName)) {
+            continue;
+        }
+        result.push_back(slot.obj);
+    }
+    return result;
+}
+
+void ProfileBuffer::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _entries.clear();
+    _next = 0;
+}
+
+long long ProfileBuffer::totalAppended() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _totalAppended;
+}
+
+}  // namespace mongo
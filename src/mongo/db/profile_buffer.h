@@ -0,0 +1,95 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * A fixed-capacity, in-memory ring of profiler entries. When the 'profileBufferSizeRecords'
+ * server parameter is non-zero, the profiler records entries here rather than inserting them into
+ * <db>.system.profile, which avoids taking collection locks and performing a storage write for
+ * every profiled operation. The oldest entry is overwritten once the ring is full.
+ */
+class ProfileBuffer {
+public:
+    static ProfileBuffer& get(ServiceContext* serviceContext);
+
+    /**
+     * Returns the configured capacity, or 0 if the in-memory profiler is disabled.
+     */
+    static size_t configuredCapacity();
+
+    /**
+     * Records 'entry' for database 'dbName', resizing the ring first if 'capacity' differs from
+     * its current capacity. Resizing discards all buffered entries.
+     */
+    void append(StringData dbName, BSONObj entry, size_t capacity);
+
+    /**
+     * Returns the buffered entries for 'dbName', oldest first. An empty 'dbName' returns the
+     * entries for all databases.
+     */
+    std::vector<BSONObj> snapshot(StringData dbName) const;
+
+    /**
+     * Discards all buffered entries.
+     */
+    void clear();
+
+    /**
+     * Returns the total number of entries appended, including those since overwritten.
+     */
+    long long totalAppended() const;
+
+private:
+    struct Entry {
+        std::string dbName;
+        BSONObj obj;
+    };
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ProfileBuffer::_mutex");
+
+    // Slots of the ring. Its size is the current capacity.
+    std::vector<Entry> _entries;
+
+    // Index of the slot the next entry is written to.
+    size_t _next = 0;
+
+    long long _totalAppended = 0;
+};
+
+}  // namespace mongo
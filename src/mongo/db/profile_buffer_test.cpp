@@ -0,0 +1,89 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/profile_buffer.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::vector<int> entryIds(const std::vector<BSONObj>& entries) {
+    std::vector<int> ids;
+    for (auto&& entry : entries) {
+        ids.push_back(entry["id"].numberInt());
+    }
+    return ids;
+}
+
+TEST(ProfileBufferTest, EmptyBufferReturnsNothing) {
+    ProfileBuffer buffer;
+    ASSERT(buffer.snapshot("").empty());
+    ASSERT_EQ(buffer.totalAppended(), 0);
+}
+
+TEST(ProfileBufferTest, OverwritesOldestEntriesWhenFull) {
+    ProfileBuffer buffer;
+    for (int i = 0; i < 5; ++i) {
+        buffer.append("test", BSON("id" << i), 3);
+    }
+
+    ASSERT(entryIds(buffer.snapshot("")) == std::vector<int>({2, 3, 4}));
+    ASSERT_EQ(buffer.totalAppended(), 5);
+}
+
+TEST(ProfileBufferTest, SnapshotFiltersByDatabase) {
+    ProfileBuffer buffer;
+    buffer.append("a", BSON("id" << 0), 4);
+    buffer.append("b", BSON("id" << 1), 4);
+    buffer.append("a", BSON("id" << 2), 4);
+
+    ASSERT(entryIds(buffer.snapshot("a")) == std::vector<int>({0, 2}));
+    ASSERT(entryIds(buffer.snapshot("b")) == std::vector<int>({1}));
+    ASSERT(buffer.snapshot("c").empty());
+    ASSERT_EQ(buffer.snapshot("").size(), 3U);
+}
+
+TEST(ProfileBufferTest, ChangingCapacityDiscardsEntries) {
+    ProfileBuffer buffer;
+    buffer.append("test", BSON("id" << 0), 2);
+    buffer.append("test", BSON("id" << 1), 2);
+    buffer.append("test", BSON("id" << 2), 4);
+
+    ASSERT(entryIds(buffer.snapshot("")) == std::vector<int>({2}));
+
+    buffer.clear();
+    ASSERT(buffer.snapshot("").empty());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,179 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/cardinality_estimator.h"
+
+#include <algorithm>
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_solution.h"
+
+namespace mongo {
+namespace {
+
+const auto getCollectionStatistics =
+    SharedCollectionDecorations::declareDecoration<CollectionStatistics>();
+
+/**
+ * Returns the index scan of 'solution' if the solution is made of a single index scan, optionally
+ * followed by a fetch and a projection. Otherwise returns nullptr.
+ */
+const IndexScanNode* getSingleIndexScan(const QuerySolution& solution) {
+    const QuerySolutionNode* node = solution.root();
+    while (node && isProjectionStageType(node->getType())) {
+        node = node->children.size() == 1 ? node->children[0] : nullptr;
+    }
+    if (node && node->getType() == STAGE_FETCH) {
+        node = node->children.size() == 1 ? node->children[0] : nullptr;
+    }
+    if (!node || node->getType() != STAGE_IXSCAN) {
+        return nullptr;
+    }
+    return static_cast<const IndexScanNode*>(node);
+}
+
+bool isFullRange(const OrderedIntervalList& oil) {
+    return oil.intervals.size() == 1 &&
+        (oil.intervals[0].isMinToMax() || oil.intervals[0].isMaxToMin());
+}
+
+/**
+ * Returns the estimated number of index keys examined by 'ixscan' on a collection of 'numRecords'
+ * documents, or boost::none if some of the bounds cannot be estimated from 'stats'.
+ */
+boost::optional<double> estimateKeysExamined(const CollectionStatistics& stats,
+                                             const IndexScanNode& ixscan,
+                                             long long numRecords) {
+    const auto& index = ixscan.index;
+    if (index.type != INDEX_BTREE || index.collator || index.filterExpr ||
+        ixscan.bounds.isSimpleRange) {
+        return boost::none;
+    }
+
+    // Assume that the fields are independent of each other.
+    double selectivity = 1.0;
+    for (auto&& oil : ixscan.bounds.fields) {
+        if (isFullRange(oil)) {
+            continue;
+        }
+
+        auto fieldStats = stats.getFieldStatistics(oil.name);
+        if (!fieldStats || fieldStats->histogram.getTotalCount() == 0) {
+            return boost::none;
+        }
+
+        // The statistics are too stale to be trusted once the collection has changed size a lot.
+        if (numRecords > 2 * fieldStats->numRecords || 2 * numRecords < fieldStats->numRecords) {
+            return boost::none;
+        }
+
+        // A multikey field has more sampled values than sampled documents, so the selectivity of
+        // the bounds is relative to the number of documents.
+        selectivity *= std::min(1.0,
+                                fieldStats->histogram.estimate(oil) /
+                                    std::max(1LL, fieldStats->numDocsSampled));
+    }
+    return selectivity * numRecords;
+}
+
+}  // namespace
+
+CollectionStatistics& CollectionStatistics::get(SharedCollectionDecorations* decorations) {
+    return getCollectionStatistics(decorations);
+}
+
+std::shared_ptr<const FieldStatistics> CollectionStatistics::getFieldStatistics(
+    StringData path) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _fields.find(path);
+    return it == _fields.end() ? nullptr : it->second;
+}
+
+void CollectionStatistics::setFieldStatistics(StringData path,
+                                              std::shared_ptr<const FieldStatistics> stats) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _fields[path] = std::move(stats);
+    _hasStatistics.store(true);
+}
+
+namespace cardinality_estimator {
+
+boost::optional<size_t> pickBestSolution(
+    OperationContext* opCtx,
+    const CollectionPtr& collection,
+    const CanonicalQuery& cq,
+    const std::vector<std::unique_ptr<QuerySolution>>& solutions) {
+    if (!internalQueryUseHistogramsForPlanSelection.load() || solutions.size() < 2 || !collection) {
+        return boost::none;
+    }
+
+    const auto& stats = CollectionStatistics::get(collection->getSharedDecorations());
+    if (stats.empty()) {
+        return boost::none;
+    }
+
+    // A plan which produces results in the requested order, or stops early because of a limit,
+    // may examine far fewer keys than its bounds suggest.
+    const auto& findCommand = cq.getFindCommandRequest();
+    if (cq.getCollator() || !findCommand.getSort().isEmpty() || findCommand.getLimit() ||
+        findCommand.getSkip()) {
+        return boost::none;
+    }
+
+    const auto numRecords = collection->numRecords(opCtx);
+    std::vector<double> estimates;
+    estimates.reserve(solutions.size());
+    for (auto&& solution : solutions) {
+        auto ixscan = getSingleIndexScan(*solution);
+        if (!ixscan) {
+            return boost::none;
+        }
+        auto estimate = estimateKeysExamined(stats, *ixscan, numRecords);
+        if (!estimate) {
+            return boost::none;
+        }
+        estimates.push_back(*estimate);
+    }
+
+    const size_t best = std::min_element(estimates.begin(), estimates.end()) - estimates.begin();
+    const double minRatio = internalQueryHistogramPlanSelectionMinRatio.load();
+    for (size_t i = 0; i < estimates.size(); ++i) {
+        if (i != best && estimates[i] < minRatio * std::max(estimates[best], 1.0)) {
+            return boost::none;
+        }
+    }
+    return best;
+}
+
+}  // namespace cardinality_estimator
+}  // namespace mongo
@@ -0,0 +1,120 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/db/query/histogram.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class CanonicalQuery;
+class CollectionPtr;
+class OperationContext;
+class QuerySolution;
+class SharedCollectionDecorations;
+
+/**
+ * Statistics about the values of a single field, gathered from a sample of the documents of a
+ * collection by the 'analyze' command.
+ */
+struct FieldStatistics {
+    Histogram histogram;
+
+    // The number of documents the histogram was built from.
+    long long numDocsSampled = 0;
+
+    // The number of records in the collection when the statistics were gathered.
+    long long numRecords = 0;
+
+    Date_t builtAt;
+};
+
+/**
+ * Field statistics of a collection. All Collection instances for the same collection share the
+ * same CollectionStatistics, see the Collection header file for more details.
+ *
+ * Statistics are only kept in memory. They are lost on restart and rebuilt by running 'analyze'
+ * again.
+ */
+class CollectionStatistics {
+public:
+    static CollectionStatistics& get(SharedCollectionDecorations* decorations);
+
+    /**
+     * Returns the statistics for the field 'path', or nullptr if it has not been analyzed.
+     */
+    std::shared_ptr<const FieldStatistics> getFieldStatistics(StringData path) const;
+
+    /**
+     * Replaces the statistics for the field 'path'.
+     */
+    void setFieldStatistics(StringData path, std::shared_ptr<const FieldStatistics> stats);
+
+    /**
+     * Returns true if no field of the collection has statistics, without acquiring the mutex.
+     */
+    bool empty() const {
+        return !_hasStatistics.load();
+    }
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("CollectionStatistics::_mutex");
+    StringMap<std::shared_ptr<const FieldStatistics>> _fields;
+    AtomicWord<bool> _hasStatistics{false};
+};
+
+namespace cardinality_estimator {
+
+/**
+ * Uses the field statistics of 'collection' to pick the winner among the candidate 'solutions'
+ * for 'cq' without running a trial period. Returns the index of the winning solution, or
+ * boost::none if the statistics do not identify a clear winner, in which case the candidates
+ * have to be multi-planned.
+ *
+ * Only solutions made of a single index scan, optionally followed by a fetch and a projection,
+ * are estimated. The winner's estimated number of keys examined must be lower than that of every
+ * other candidate by at least 'internalQueryHistogramPlanSelectionMinRatio'.
+ */
+boost::optional<size_t> pickBestSolution(
+    OperationContext* opCtx,
+    const CollectionPtr& collection,
+    const CanonicalQuery& cq,
+    const std::vector<std::unique_ptr<QuerySolution>>& solutions);
+
+}  // namespace cardinality_estimator
+}  // namespace mongo
@@ -39,8 +39,10 @@
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/client.h"
+#include "mongo/db/exec/and_bitmap.h"
 #include "mongo/db/exec/and_hash.h"
 #include "mongo/db/exec/and_sorted.h"
+#include "mongo/db/exec/batched_id_lookup.h"
 #include "mongo/db/exec/collection_scan.h"
 #include "mongo/db/exec/count_scan.h"
 #include "mongo/db/exec/distinct_scan.h"
@@ -62,10 +64,38 @@
 #include "mongo/db/exec/text_or.h"
 #include "mongo/db/index/fts_access_method.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/logv2/log.h"
 
 namespace mongo::stage_builder {
+namespace {
+
+/**
+ * Returns true if the FETCH node 'fn' fetches the result of a hash-based intersection of plain
+ * index scans, which an AND_BITMAP stage can perform on its own.
+ */
+bool canUseAndBitmap(const CollectionPtr& collection, const FetchNode* fn) {
+    if (!internalQueryExecUseBitmapIntersection.load() ||
+        fn->children[0]->getType() != STAGE_AND_HASH ||
+        collection->getRecordStore()->keyFormat() != KeyFormat::Long) {
+        return false;
+    }
+
+    // The index scans are checked again by bounds if a document changes during a yield, which
+    // rules out residual filters and bounds which are not expressed as intervals.
+    const auto& children = fn->children[0]->children;
+    return std::all_of(children.begin(), children.end(), [](const QuerySolutionNode* child) {
+        if (child->getType() != STAGE_IXSCAN) {
+            return false;
+        }
+        auto ixn = static_cast<const IndexScanNode*>(child);
+        return ixn->index.type == INDEX_BTREE && !ixn->filter && !ixn->bounds.isSimpleRange;
+    });
+}
+
+}  // namespace
+
 // Returns a non-null pointer to the root of a plan tree, or a non-OK status if the PlanStage tree
 // could not be constructed.
 std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* root) {
@@ -116,10 +146,28 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
         }
         case STAGE_FETCH: {
             const FetchNode* fn = static_cast<const FetchNode*>(root);
+            if (canUseAndBitmap(_collection, fn)) {
+                auto ret = std::make_unique<AndBitmapStage>(
+                    expCtx, _ws, fn->filter.get(), _collection);
+                for (auto&& child : fn->children[0]->children) {
+                    auto ixn = static_cast<const IndexScanNode*>(child);
+                    auto descriptor = _collection->getIndexCatalog()->findIndexByName(
+                        _opCtx, ixn->index.identifier.catalogName);
+                    invariant(descriptor);
+                    ret->addChild(build(child), {descriptor, ixn->bounds, ixn->direction});
+                }
+                return ret;
+            }
             auto childStage = build(fn->children[0]);
             return std::make_unique<FetchStage>(
                 expCtx, _ws, std::move(childStage), fn->filter.get(), _collection);
         }
+        case STAGE_BATCHED_ID_LOOKUP: {
+            auto bn = static_cast<const BatchedIdLookupNode*>(root);
+            auto childStage = build(bn->children[0]);
+            return std::make_unique<BatchedIdLookupStage>(
+                expCtx, _ws, std::move(childStage), bn->filter.get(), _collection);
+        }
         case STAGE_SORT_DEFAULT: {
             auto snDefault = static_cast<const SortNodeDefault*>(root);
             auto childStage = build(snDefault->children[0]);
@@ -399,6 +447,7 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             }
             return qds;
         }
+        case STAGE_AND_BITMAP:
         case STAGE_CACHED_PLAN:
         case STAGE_COUNT:
         case STAGE_DELETE:
@@ -33,10 +33,12 @@
 
 #include "mongo/db/query/collection_query_info.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/catalog/index_catalog_entry.h"
 #include "mongo/db/collection_index_usage_tracker.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/curop_metrics.h"
@@ -51,7 +53,9 @@
 #include "mongo/db/query/planner_ixselect.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/util/clock_source.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -79,8 +83,23 @@ CoreIndexInfo indexInfoFromIndexCatalogEntry(const IndexCatalogEntry& ice) {
 
 }  // namespace
 
+class CollectionQueryInfo::WildcardMultikeyPathCache {
+public:
+    struct Entry {
+        // The paths noted by writers and, once 'loaded', all the paths read from the index.
+        std::shared_ptr<const WildcardMultikeyPaths> paths =
+            std::make_shared<const WildcardMultikeyPaths>();
+        bool loaded = false;
+    };
+
+    Mutex mutex = MONGO_MAKE_LATCH("CollectionQueryInfo::WildcardMultikeyPathCache::mutex");
+    StringMap<Entry> entries;
+};
+
 CollectionQueryInfo::CollectionQueryInfo()
-    : _keysComputed(false), _planCache(std::make_shared<PlanCache>()) {}
+    : _keysComputed(false),
+      _planCache(std::make_shared<PlanCache>()),
+      _wildcardMultikeyPathCache(std::make_shared<WildcardMultikeyPathCache>()) {}
 
 const UpdateIndexData& CollectionQueryInfo::getIndexKeys(OperationContext* opCtx) const {
     invariant(_keysComputed);
@@ -227,6 +246,52 @@ void CollectionQueryInfo::updatePlanCacheIndexEntries(OperationContext* opCtx,
     _planCache->notifyOfIndexUpdates(indexCores);
 }
 
+std::shared_ptr<const CollectionQueryInfo::WildcardMultikeyPaths>
+CollectionQueryInfo::getWildcardMultikeyPaths(const IndexCatalogEntry& entry) const {
+    stdx::lock_guard<Latch> lk(_wildcardMultikeyPathCache->mutex);
+    auto it = _wildcardMultikeyPathCache->entries.find(entry.getIdent());
+    if (it == _wildcardMultikeyPathCache->entries.end() || !it->second.loaded) {
+        return nullptr;
+    }
+    return it->second.paths;
+}
+
+std::shared_ptr<const CollectionQueryInfo::WildcardMultikeyPaths>
+CollectionQueryInfo::cacheWildcardMultikeyPaths(const IndexCatalogEntry& entry,
+                                                WildcardMultikeyPaths paths) const {
+    stdx::lock_guard<Latch> lk(_wildcardMultikeyPathCache->mutex);
+    auto& cached = _wildcardMultikeyPathCache->entries[entry.getIdent()];
+    paths.insert(cached.paths->begin(), cached.paths->end());
+    cached.paths = std::make_shared<const WildcardMultikeyPaths>(std::move(paths));
+    cached.loaded = true;
+    return cached.paths;
+}
+
+void CollectionQueryInfo::noteWildcardMultikeyMetadataKeys(
+    const IndexCatalogEntry& entry, const KeyStringSet& multikeyMetadataKeys) const {
+    // Metadata keys have the form {"": 1, "": <multikey path>}.
+    std::vector<std::string> newPaths;
+    for (const auto& keyString : multikeyMetadataKeys) {
+        BSONObjIterator it(KeyString::toBson(keyString, entry.ordering()));
+        invariant(it.more());
+        it.next();
+        invariant(it.more());
+        newPaths.push_back(it.next().str());
+    }
+
+    stdx::lock_guard<Latch> lk(_wildcardMultikeyPathCache->mutex);
+    auto& cached = _wildcardMultikeyPathCache->entries[entry.getIdent()];
+    if (std::all_of(newPaths.begin(), newPaths.end(), [&](const auto& path) {
+            return cached.paths->count(path);
+        })) {
+        return;
+    }
+
+    auto paths = std::make_shared<WildcardMultikeyPaths>(*cached.paths);
+    paths->insert(newPaths.begin(), newPaths.end());
+    cached.paths = std::move(paths);
+}
+
 void CollectionQueryInfo::init(OperationContext* opCtx, const CollectionPtr& coll) {
     const bool includeUnfinishedIndexes = false;
     std::unique_ptr<IndexCatalog::IndexIterator> ii =
@@ -242,6 +307,7 @@ void CollectionQueryInfo::init(OperationContext* opCtx, const CollectionPtr& col
 
 void CollectionQueryInfo::rebuildIndexData(OperationContext* opCtx, const CollectionPtr& coll) {
     _planCache = std::make_shared<PlanCache>();
+    _wildcardMultikeyPathCache = std::make_shared<WildcardMultikeyPathCache>();
 
     _keysComputed = false;
     computeIndexKeys(opCtx, coll);
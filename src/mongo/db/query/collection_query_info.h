@@ -29,14 +29,19 @@
 
 #pragma once
 
+#include <set>
+#include <string>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/db/update_index_data.h"
 
 namespace mongo {
 
 class IndexDescriptor;
+class IndexCatalogEntry;
 class OperationContext;
 
 /**
@@ -98,7 +103,34 @@ public:
                        const CollectionPtr& coll,
                        const PlanSummaryStats& summaryStats) const;
 
+    using WildcardMultikeyPaths = std::set<std::string>;
+
+    /**
+     * Returns all the multikey paths of the wildcard index 'entry', or nullptr if they have not
+     * been cached yet.
+     */
+    std::shared_ptr<const WildcardMultikeyPaths> getWildcardMultikeyPaths(
+        const IndexCatalogEntry& entry) const;
+
+    /**
+     * Caches 'paths', the multikey paths read from the metadata keys of the wildcard index
+     * 'entry', merged with any paths noted by writers in the meantime. Returns the cached paths.
+     */
+    std::shared_ptr<const WildcardMultikeyPaths> cacheWildcardMultikeyPaths(
+        const IndexCatalogEntry& entry, WildcardMultikeyPaths paths) const;
+
+    /**
+     * Adds the paths of 'multikeyMetadataKeys', which are about to be inserted into the wildcard
+     * index 'entry', to its cached multikey paths. This must happen before the keys can commit, so
+     * that the cache never lacks a committed path. Paths whose insert is rolled back stay cached,
+     * which only makes plans on those paths more conservative.
+     */
+    void noteWildcardMultikeyMetadataKeys(const IndexCatalogEntry& entry,
+                                          const KeyStringSet& multikeyMetadataKeys) const;
+
 private:
+    class WildcardMultikeyPathCache;
+
     void computeIndexKeys(OperationContext* opCtx, const CollectionPtr& coll);
     void updatePlanCacheIndexEntries(OperationContext* opCtx, const CollectionPtr& coll);
 
@@ -108,6 +140,10 @@ private:
 
     // A cache for query plans. Shared across cloned Collection instances.
     std::shared_ptr<PlanCache> _planCache;
+
+    // The multikey paths of wildcard indexes, by index ident. Shared across cloned Collection
+    // instances.
+    std::shared_ptr<WildcardMultikeyPathCache> _wildcardMultikeyPathCache;
 };
 
 }  // namespace mongo
@@ -87,8 +87,19 @@ public:
         _numDocs++;
     }
 
+    /**
+     * Grows the reply buffer so that 'bytes' more bytes of documents can be appended without the
+     * batch built so far being reallocated and copied.
+     */
+    void reserveBytes(std::size_t bytes) {
+        invariant(_active);
+        _replyBuilder->reserveBytes(bytes);
+    }
+
     void setPostBatchResumeToken(BSONObj token) {
-        _postBatchResumeToken = token.getOwned();
+        // This is called for every document of the batch, and most executors do not produce a
+        // token, so avoid copying the empty object each time.
+        _postBatchResumeToken = token.isEmpty() ? BSONObj() : token.getOwned();
     }
 
     void setPartialResultsReturned(bool partialResults) {
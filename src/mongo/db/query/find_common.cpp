@@ -37,6 +37,7 @@
 #include "mongo/db/curop.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_request_helper.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
@@ -58,6 +59,42 @@ MONGO_FAIL_POINT_DEFINE(failGetMoreAfterCursorCheckout);
 const OperationContext::Decoration<AwaitDataState> awaitDataState =
     OperationContext::declareDecoration<AwaitDataState>();
 
+boost::optional<AdaptiveBatchSizer> AdaptiveBatchSizer::make(
+    boost::optional<long long> batchSize) {
+    if (batchSize.value_or(0) || !internalQueryEnableAdaptiveBatchSizing.load()) {
+        return boost::none;
+    }
+    return AdaptiveBatchSizer(Milliseconds(internalQueryAdaptiveBatchTargetMillis.load()),
+                              internalQueryAdaptiveBatchTargetBytes.load());
+}
+
+AdaptiveBatchSizer::AdaptiveBatchSizer(Microseconds targetTime, int targetBytes)
+    : _targetTime(targetTime), _targetBytes(targetBytes) {}
+
+bool AdaptiveBatchSizer::enough(long long numDocs, int bytesBuffered) {
+    if (!numDocs) {
+        return false;
+    }
+    if (bytesBuffered >= _targetBytes) {
+        return true;
+    }
+    if (numDocs < _nextTimeCheck) {
+        return false;
+    }
+
+    const auto elapsed = Microseconds(_timer.micros());
+    if (elapsed >= _targetTime) {
+        return true;
+    }
+
+    // Look at the clock again after about half of the documents which the cost per document so far
+    // predicts will fit in the remaining time.
+    const auto costPerDoc = std::max<std::int64_t>(elapsed.count() / numDocs, 1);
+    _nextTimeCheck =
+        numDocs + std::max<std::int64_t>((_targetTime - elapsed).count() / costPerDoc / 2, 1);
+    return false;
+}
+
 bool FindCommon::enoughForFirstBatch(const FindCommandRequest& findCommand, long long numDocs) {
     auto batchSize = findCommand.getBatchSize();
     tassert(5746104,
@@ -82,6 +119,23 @@ bool FindCommon::haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int
     return (bytesBuffered + nextDoc.objsize()) <= kMaxBytesToReturnToClientAtOnce;
 }
 
+std::size_t FindCommon::estimateRemainingFirstBatchBytes(const FindCommandRequest& findCommand,
+                                                         const BSONObj& firstDoc) {
+    std::int64_t numDocs =
+        findCommand.getBatchSize().value_or(query_request_helper::kDefaultBatchSize);
+    if (auto limit = findCommand.getLimit()) {
+        numDocs = std::min(numDocs, *limit);
+    }
+    if (numDocs <= 1) {
+        return 0;
+    }
+
+    // Each array element also carries a type byte and its index as a field name.
+    const std::int64_t bytesPerDoc = firstDoc.objsize() + 8;
+    return std::min(bytesPerDoc * (numDocs - 1),
+                    static_cast<std::int64_t>(kMaxBytesToReturnToClientAtOnce));
+}
+
 void FindCommon::waitInFindBeforeMakingBatch(OperationContext* opCtx, const CanonicalQuery& cq) {
     auto whileWaitingFunc = [&, hasLogged = false]() mutable {
         if (!std::exchange(hasLogged, true)) {
@@ -97,4 +151,22 @@ void FindCommon::waitInFindBeforeMakingBatch(OperationContext* opCtx, const Cano
                                                      std::move(whileWaitingFunc),
                                                      cq.nss());
 }
+
+void FindCommon::waitInFindBeforeMakingBatch(OperationContext* opCtx,
+                                             const NamespaceString& nss,
+                                             const BSONObj& filter) {
+    auto whileWaitingFunc = [&, hasLogged = false]() mutable {
+        if (!std::exchange(hasLogged, true)) {
+            LOGV2(5910903,
+                  "Waiting in find before making batch for query",
+                  "query"_attr = redact(filter));
+        }
+    };
+
+    CurOpFailpointHelpers::waitWhileFailPointEnabled(&mongo::waitInFindBeforeMakingBatch,
+                                                     opCtx,
+                                                     "waitInFindBeforeMakingBatch",
+                                                     std::move(whileWaitingFunc),
+                                                     nss);
+}
 }  // namespace mongo
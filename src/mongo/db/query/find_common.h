@@ -28,8 +28,10 @@
  */
 
 #include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -79,6 +81,42 @@ extern FailPoint waitBeforeUnpinningOrDeletingCursorAfterGetMoreBatch;
 // checked out its cursor and the originating command has been made available to CurOp.
 extern FailPoint failGetMoreAfterCursorCheckout;
 
+/**
+ * Decides when a find or getMore batch for which the client did not request a batchSize is
+ * complete, when the 'internalQueryEnableAdaptiveBatchSizing' mode is on. Instead of a fixed number
+ * of documents, such a batch ends once producing it has taken the wall-clock budget or its
+ * documents have reached the byte budget, so that cheap plans return large batches and expensive
+ * ones return early.
+ *
+ * The clock is consulted at intervals derived from the per-document cost observed so far in the
+ * batch, rather than once per document.
+ */
+class AdaptiveBatchSizer {
+public:
+    /**
+     * Returns a sizer for a batch with the requested 'batchSize', or boost::none if the batch must
+     * be sized by document count, either because 'batchSize' is set or because adaptive sizing is
+     * disabled. A zero 'batchSize' is treated as absent.
+     */
+    static boost::optional<AdaptiveBatchSizer> make(boost::optional<long long> batchSize);
+
+    /**
+     * Returns true if a batch holding 'numDocs' documents of 'bytesBuffered' total size has used up
+     * its budget. Always returns false for an empty batch so that progress is made.
+     */
+    bool enough(long long numDocs, int bytesBuffered);
+
+private:
+    AdaptiveBatchSizer(Microseconds targetTime, int targetBytes);
+
+    const Microseconds _targetTime;
+    const int _targetBytes;
+    Timer _timer;
+
+    // The document count at which the elapsed time is next compared with '_targetTime'.
+    long long _nextTimeCheck = 1;
+};
+
 /**
  * Suite of find/getMore related functions used in both the mongod and mongos query paths.
  */
@@ -120,6 +158,14 @@ public:
      */
     static bool haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int bytesBuffered);
 
+    /**
+     * Estimates how many more bytes the initial find batch will need once 'firstDoc' has been
+     * added to it, assuming the remaining documents are about the same size. The estimate honors
+     * the batchSize and limit of 'findCommand' and never exceeds the maximum batch size.
+     */
+    static std::size_t estimateRemainingFirstBatchBytes(const FindCommandRequest& findCommand,
+                                                        const BSONObj& firstDoc);
+
     /**
      * This function wraps waitWhileFailPointEnabled() on waitInFindBeforeMakingBatch.
      *
@@ -128,6 +174,13 @@ public:
      * failpoint is active.
      */
     static void waitInFindBeforeMakingBatch(OperationContext* opCtx, const CanonicalQuery& cq);
+
+    /**
+     * Same as above, for finds which are answered without a CanonicalQuery.
+     */
+    static void waitInFindBeforeMakingBatch(OperationContext* opCtx,
+                                            const NamespaceString& nss,
+                                            const BSONObj& filter);
 };
 
 }  // namespace mongo
@@ -0,0 +1,164 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace mongo {
+
+/**
+ * A probabilistic multiset that estimates how often a key was accessed recently, as used by the
+ * TinyLFU cache admission policy. Each key is mapped to four 4-bit counters of a count-min
+ * sketch, so estimates are never lower than the true count and saturate at 'kMaxFrequency'.
+ * The sketch keeps sixteen counters per tracked key to limit collisions. Once the number of
+ * recorded accesses reaches ten times the capacity of the sketch, every counter is halved so
+ * that old popularity fades away.
+ *
+ * Keys are identified by a hash computed by the caller. This class is NOT thread safe.
+ */
+class FrequencySketch {
+public:
+    static constexpr uint64_t kMaxFrequency = 15;
+
+    explicit FrequencySketch(size_t capacity = 0) {
+        ensureCapacity(capacity);
+    }
+
+    /**
+     * Grows the sketch so that it can track about 'capacity' distinct keys accurately. The sketch
+     * only grows by doubling its number of counters, and every counter of the larger table starts
+     * with the value of the counter it was split from, so no recorded access is lost.
+     */
+    void ensureCapacity(size_t capacity) {
+        if (_table.empty()) {
+            _table.assign(kMinWords, 0);
+        }
+
+        while (_table.size() < capacity) {
+            const auto numWords = _table.size();
+            _table.resize(2 * numWords);
+            std::copy_n(_table.begin(), numWords, _table.begin() + numWords);
+        }
+
+        _sampleSize = 10 * _table.size();
+    }
+
+    /**
+     * Records one access to the key with hash 'hash'.
+     */
+    void increment(uint64_t hash) {
+        bool added = false;
+        for (size_t row = 0; row < kNumRows; ++row) {
+            added |= _incrementAt(_counterIndex(hash, row));
+        }
+
+        if (added && ++_numAdditions >= _sampleSize) {
+            _halve();
+        }
+    }
+
+    /**
+     * Returns the estimated number of recent accesses to the key with hash 'hash'.
+     */
+    uint64_t frequency(uint64_t hash) const {
+        uint64_t frequency = kMaxFrequency;
+        for (size_t row = 0; row < kNumRows; ++row) {
+            frequency = std::min(frequency, _counterAt(_counterIndex(hash, row)));
+        }
+        return frequency;
+    }
+
+    /**
+     * Forgets all the recorded frequencies.
+     */
+    void clear() {
+        std::fill(_table.begin(), _table.end(), 0);
+        _numAdditions = 0;
+    }
+
+private:
+    static constexpr size_t kNumRows = 4;
+    static constexpr size_t kCountersPerWord = 16;
+    static constexpr size_t kMinWords = 8;
+    static constexpr std::array<uint64_t, kNumRows> kSeeds = {
+        0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL};
+
+    size_t _counterIndex(uint64_t hash, size_t row) const {
+        // Scramble the bits of the caller's hash first, since hashes of small integers are often
+        // the integers themselves.
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+
+        uint64_t h = (hash + kSeeds[row]) * kSeeds[row];
+        h += h >> 32;
+        return h & (_table.size() * kCountersPerWord - 1);
+    }
+
+    uint64_t _counterAt(size_t index) const {
+        return (_table[index / kCountersPerWord] >> _shift(index)) & kMaxFrequency;
+    }
+
+    bool _incrementAt(size_t index) {
+        auto& word = _table[index / kCountersPerWord];
+        const uint64_t mask = kMaxFrequency << _shift(index);
+        if ((word & mask) == mask) {
+            return false;
+        }
+        word += uint64_t{1} << _shift(index);
+        return true;
+    }
+
+    void _halve() {
+        for (auto& word : _table) {
+            word = (word >> 1) & 0x7777777777777777ULL;
+        }
+        _numAdditions /= 2;
+    }
+
+    static size_t _shift(size_t index) {
+        return (index % kCountersPerWord) * 4;
+    }
+
+    // Counters packed sixteen per word. The number of words is a power of two, and at least the
+    // number of keys the sketch tracks.
+    std::vector<uint64_t> _table;
+
+    // Number of counter increments after which all counters are halved.
+    size_t _sampleSize = 0;
+
+    // Number of counter increments since the counters were last halved.
+    size_t _numAdditions = 0;
+};
+
+}  // namespace mongo
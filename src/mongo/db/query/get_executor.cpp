@@ -33,6 +33,7 @@
 
 #include "mongo/db/query/get_executor.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
 #include <limits>
 #include <memory>
@@ -65,6 +66,7 @@
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/canonical_query_encoder.h"
+#include "mongo/db/query/cardinality_estimator.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/collection_query_info.h"
@@ -204,7 +206,38 @@ IndexEntry indexEntryFromIndexCatalogEntry(OperationContext* opCtx,
     if (desc->getIndexType() == IndexType::INDEX_WILDCARD) {
         auto wam = static_cast<const WildcardAccessMethod*>(accessMethod);
         wildcardProjection = wam->getWildcardProjection();
-        if (isMultikey) {
+        if (isMultikey && internalQueryCacheWildcardMultikeyPaths.load()) {
+            const auto& queryInfo = CollectionQueryInfo::get(collection);
+            auto multikeyPaths = queryInfo.getWildcardMultikeyPaths(ice);
+            if (!multikeyPaths) {
+                MultikeyMetadataAccessStats mkAccessStats;
+                CollectionQueryInfo::WildcardMultikeyPaths paths;
+                for (auto&& path : getWildcardMultikeyPathSet(wam, opCtx, &mkAccessStats)) {
+                    paths.insert(path.dottedField().toString());
+                }
+                multikeyPaths = queryInfo.cacheWildcardMultikeyPaths(ice, std::move(paths));
+
+                LOGV2_DEBUG(5910929,
+                            2,
+                            "Cached multikey path metadata of wildcard index",
+                            "index"_attr = desc->indexName(),
+                            "numPaths"_attr = multikeyPaths->size(),
+                            "keysExamined"_attr = mkAccessStats.keysExamined);
+            }
+
+            if (canonicalQuery) {
+                stdx::unordered_set<std::string> fields;
+                QueryPlannerIXSelect::getFields(canonicalQuery->root(), &fields);
+                const auto projectedFields = projection_executor_utils::applyProjectionToFields(
+                    wildcardProjection->exec(), fields);
+
+                multikeyPathSet = getWildcardMultikeyPathSet(*multikeyPaths, projectedFields);
+            } else {
+                for (auto&& path : *multikeyPaths) {
+                    multikeyPathSet.emplace(path);
+                }
+            }
+        } else if (isMultikey) {
             MultikeyMetadataAccessStats mkAccessStats;
 
             if (canonicalQuery) {
@@ -697,6 +730,24 @@ public:
             return std::move(result);
         }
 
+        if (auto winner =
+                cardinality_estimator::pickBestSolution(_opCtx, _collection, *_cq, solutions)) {
+            auto result = makeResult();
+            // The collection statistics clearly favor one of the plans. Run it without a trial
+            // period.
+            auto root = buildExecutableTree(*solutions[*winner]);
+            result->emplace(std::move(root), std::move(solutions[*winner]));
+
+            LOGV2_DEBUG(6000136,
+                        2,
+                        "Plan picked using collection statistics; it will be run but will not be "
+                        "cached",
+                        "query"_attr = redact(_cq->toStringShort()),
+                        "planSummary"_attr = result->getPlanSummary());
+
+            return std::move(result);
+        }
+
         return buildMultiPlan(std::move(solutions), plannerParams);
     }
 
@@ -990,7 +1041,8 @@ protected:
         const QueryPlannerParams& plannerParams,
         size_t decisionWorks) final {
         auto result = makeResult();
-        auto execTree = buildExecutableTree(*solution);
+        auto execTree = stage_builder::buildOrCloneSlotBasedExecutableTree(
+            _opCtx, _collection, *_cq, *solution, _yieldPolicy);
         result->emplace(std::move(execTree), std::move(solution));
         result->setDecisionWorks(decisionWorks);
         return result;
@@ -1175,7 +1227,15 @@ inline bool isQuerySbeCompatible(OperationContext* opCtx,
     const auto& sortPattern = cq->getSortPattern();
     const bool allExpressionsSupported = expCtx && expCtx->sbeCompatible;
     const bool isNotCount = !(plannerOptions & QueryPlannerParams::IS_COUNT);
-    const bool isNotOplog = !cq->nss().isOplog();
+    // The only oplog scans run in SBE are the tailable scans of change streams, which compile the
+    // filter rewritten from the user's $match on change events into the scan. These track the
+    // latest oplog timestamp for their resume tokens.
+    const auto& findCommand = cq->getFindCommandRequest();
+    const bool isChangeStreamOplogScan = internalQueryEnableSBEChangeStreamOplogScan.load() &&
+        (plannerOptions & QueryPlannerParams::TRACK_LATEST_OPLOG_TS) &&
+        findCommand.getTailable() && findCommand.getAwaitData() &&
+        findCommand.getResumeAfter().isEmpty();
+    const bool isNotOplog = !cq->nss().isOplog() || isChangeStreamOplogScan;
     const bool doesNotContainMetadataRequirements = cq->metadataDeps().none();
     const bool doesNotSortOnMetaOrPathWithNumericComponents =
         !sortPattern || std::all_of(sortPattern->begin(), sortPattern->end(), [](auto&& part) {
@@ -1953,7 +2013,8 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorCoun
 
 bool turnIxscanIntoDistinctIxscan(QuerySolution* soln,
                                   const std::string& field,
-                                  bool strictDistinctOnly) {
+                                  bool strictDistinctOnly,
+                                  const std::vector<std::string>& additionalFields) {
     auto root = soln->root();
 
     // We can attempt to convert a plan if it follows one of these patterns (starting from the
@@ -2029,16 +2090,56 @@ bool turnIxscanIntoDistinctIxscan(QuerySolution* soln,
         return false;
     }
 
-    // Figure out which field we're skipping to the next value of.
-    int fieldNo = 0;
-    BSONObjIterator it(indexScanNode->index.keyPattern);
-    while (it.more()) {
-        if (field == it.next().fieldName()) {
-            break;
+    // Figure out which field we're skipping to the next value of. When the results must be
+    // distinct on several fields, this is whichever of them comes last in the index, and the
+    // positions of the others are remembered so that they need not have point bounds below.
+    auto fieldPosition = [&](StringData fieldName) {
+        int position = 0;
+        for (auto&& elt : indexScanNode->index.keyPattern) {
+            if (fieldName == elt.fieldNameStringData()) {
+                return position;
+            }
+            ++position;
+        }
+        return -1;
+    };
+
+    int fieldNo = fieldPosition(field);
+    std::vector<int> distinctFieldPositions{fieldNo};
+    for (auto&& additionalField : additionalFields) {
+        distinctFieldPositions.push_back(fieldPosition(additionalField));
+    }
+    for (auto position : distinctFieldPositions) {
+        if (position < 0) {
+            // Every field we are distinct on must be part of the index.
+            return false;
+        }
+        fieldNo = std::max(fieldNo, position);
+    }
+
+    // A missing field and an explicit null both produce a null index key, yet a $group on several
+    // fields tells them apart. A DISTINCT_SCAN would return only one document for the two, so we
+    // require that the bounds on every field we are distinct on exclude null.
+    if (!additionalFields.empty()) {
+        const Interval nullInterval(BSON("" << BSONNULL << "" << BSONNULL), true, true);
+        for (auto position : distinctFieldPositions) {
+            for (auto&& interval : indexScanNode->bounds.fields[position].intervals) {
+                const auto ascending =
+                    interval.getDirection() == Interval::Direction::kDirectionDescending
+                    ? interval.reverseClone()
+                    : interval;
+                if (ascending.intersects(nullInterval)) {
+                    return false;
+                }
+            }
         }
-        ++fieldNo;
     }
 
+    auto isDistinctField = [&](int position) {
+        return std::find(distinctFieldPositions.begin(), distinctFieldPositions.end(), position) !=
+            distinctFieldPositions.end();
+    };
+
     if (strictDistinctOnly) {
         // If the "distinct" field is not the first field in the index bounds then the only way we
         // can guarantee that we'll never see duplicate values for the distinct field is to make
@@ -2046,9 +2147,13 @@ bool turnIxscanIntoDistinctIxscan(QuerySolution* soln,
         // DISTINCT_SCAN on 'b' over the {a: 1, b: 1} index will scan a particular 'b' value
         // multiple times if that 'b' value exists in documents with different 'a' values. The
         // equality bounds on 'a' prevent the scan from seeing duplicate 'b' values by ensuring the
-        // scan is limited to a single value for the 'a' field.
+        // scan is limited to a single value for the 'a' field. Fields which we are also distinct
+        // on are exempt, since a duplicate of the whole combination is never seen.
         for (size_t i = 0; i < static_cast<size_t>(fieldNo); ++i) {
             invariant(i < indexScanNode->bounds.size());
+            if (isDistinctField(static_cast<int>(i))) {
+                continue;
+            }
             if (indexScanNode->bounds.fields[i].intervals.size() != 1 ||
                 !indexScanNode->bounds.fields[i].intervals[0].isPoint()) {
                 return false;
@@ -2057,18 +2162,43 @@ bool turnIxscanIntoDistinctIxscan(QuerySolution* soln,
     }
 
     // We should not use a distinct scan if the field over which we are computing the distinct is
-    // multikey.
-    if (indexScanNode->index.multikey) {
+    // multikey, with one exception. When duplicates are tolerated, the plan fetches every document
+    // it returns, and the distinct field is the only multikey field of the index, each matching
+    // document has a key in bounds for every value of the field. A scan over all values of the
+    // field then reaches at least one matching document containing each value, and extracting all
+    // the field's values from the fetched documents produces the full result.
+    const auto distinctFieldPosition = fieldPosition(field);
+    const auto& distinctBounds = indexScanNode->bounds.fields[distinctFieldPosition];
+    const bool scansAllValuesOfField = distinctBounds.isMinToMax() ||
+        (distinctBounds.intervals.size() == 1 && distinctBounds.intervals[0].isMaxToMin());
+    auto onlyDistinctFieldIsMultikey = [&]() {
+        const auto& multikeyPaths = indexScanNode->index.multikeyPaths;
+        if (multikeyPaths.empty()) {
+            return false;
+        }
+        for (size_t i = 0; i < multikeyPaths.size(); ++i) {
+            if (static_cast<int>(i) != distinctFieldPosition && !multikeyPaths[i].empty()) {
+                return false;
+            }
+        }
+        return true;
+    };
+    const bool mayScanMultikeyField = !strictDistinctOnly && fetchNode &&
+        additionalFields.empty() && scansAllValuesOfField &&
+        indexScanNode->index.type != IndexType::INDEX_WILDCARD && onlyDistinctFieldIsMultikey();
+    if (indexScanNode->index.multikey && !mayScanMultikeyField) {
         const auto& multikeyPaths = indexScanNode->index.multikeyPaths;
         if (multikeyPaths.empty()) {
             // We don't have path-level multikey information available.
             return false;
         }
 
-        if (!multikeyPaths[fieldNo].empty()) {
-            // Path-level multikey information indicates that the distinct key contains at least one
-            // array component.
-            return false;
+        for (auto position : distinctFieldPositions) {
+            if (!multikeyPaths[position].empty()) {
+                // Path-level multikey information indicates that a distinct key contains at least
+                // one array component.
+                return false;
+            }
         }
     }
 
@@ -2121,7 +2251,15 @@ bool turnIxscanIntoDistinctIxscan(QuerySolution* soln,
 
 namespace {
 
-// Get the list of indexes that include the "distinct" field.
+// Returns the distinct key followed by any additional fields the results must be distinct on.
+std::vector<std::string> getDistinctKeys(const ParsedDistinct& parsedDistinct) {
+    std::vector<std::string> keys{parsedDistinct.getKey()};
+    const auto& additionalKeys = parsedDistinct.getAdditionalKeys();
+    keys.insert(keys.end(), additionalKeys.begin(), additionalKeys.end());
+    return keys;
+}
+
+// Get the list of indexes that include the "distinct" fields.
 QueryPlannerParams fillOutPlannerParamsForDistinct(OperationContext* opCtx,
                                                    const CollectionPtr& collection,
                                                    size_t plannerOptions,
@@ -2132,6 +2270,7 @@ QueryPlannerParams fillOutPlannerParamsForDistinct(OperationContext* opCtx,
     // If the caller did not request a "strict" distinct scan then we may choose a plan which
     // unwinds arrays and treats each element in an array as its own key.
     const bool mayUnwindArrays = !(plannerOptions & QueryPlannerParams::STRICT_DISTINCT_ONLY);
+    const auto distinctKeys = getDistinctKeys(parsedDistinct);
     std::unique_ptr<IndexCatalog::IndexIterator> ii =
         collection->getIndexCatalog()->getIndexIterator(opCtx, false);
     auto query = parsedDistinct.getQuery()->getFindCommandRequest().getFilter();
@@ -2142,12 +2281,16 @@ QueryPlannerParams fillOutPlannerParamsForDistinct(OperationContext* opCtx,
         // Skip the addition of hidden indexes to prevent use in query planning.
         if (desc->hidden())
             continue;
-        if (desc->keyPattern().hasField(parsedDistinct.getKey())) {
+        if (std::all_of(distinctKeys.begin(), distinctKeys.end(), [&](auto&& key) {
+                return desc->keyPattern().hasField(key);
+            })) {
             if (!mayUnwindArrays &&
-                isAnyComponentOfPathMultikey(desc->keyPattern(),
-                                             ice->isMultikey(opCtx, collection),
-                                             ice->getMultikeyPaths(opCtx, collection),
-                                             parsedDistinct.getKey())) {
+                std::any_of(distinctKeys.begin(), distinctKeys.end(), [&](auto&& key) {
+                    return isAnyComponentOfPathMultikey(desc->keyPattern(),
+                                                        ice->isMultikey(opCtx, collection),
+                                                        ice->getMultikeyPaths(opCtx, collection),
+                                                        key);
+                })) {
                 // If the caller requested "strict" distinct that does not "pre-unwind" arrays,
                 // then an index which is multikey on the distinct field may not be used. This is
                 // because when indexing an array each element gets inserted individually. Any plan
@@ -2157,7 +2300,8 @@ QueryPlannerParams fillOutPlannerParamsForDistinct(OperationContext* opCtx,
 
             plannerParams.indices.push_back(indexEntryFromIndexCatalogEntry(
                 opCtx, collection, *ice, parsedDistinct.getQuery()));
-        } else if (desc->getIndexType() == IndexType::INDEX_WILDCARD && !query.isEmpty()) {
+        } else if (desc->getIndexType() == IndexType::INDEX_WILDCARD && !query.isEmpty() &&
+                   parsedDistinct.getAdditionalKeys().empty()) {
             // Check whether the $** projection captures the field over which we are distinct-ing.
             auto* proj = static_cast<const WildcardAccessMethod*>(ice->accessMethod())
                              ->getWildcardProjection()
@@ -2218,9 +2362,13 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorForS
 
     // If there's no query, we can just distinct-scan one of the indices. Not every index in
     // plannerParams.indices may be suitable. Refer to getDistinctNodeIndex().
+    //
+    // A distinct over several fields is never "simple", since the bounds on those fields must
+    // exclude null. Refer to turnIxscanIntoDistinctIxscan().
     size_t distinctNodeIndex = 0;
     if (!parsedDistinct->getQuery()->getFindCommandRequest().getFilter().isEmpty() ||
         parsedDistinct->getQuery()->getSortPattern() ||
+        !parsedDistinct->getAdditionalKeys().empty() ||
         !getDistinctNodeIndex(
             plannerParams.indices, parsedDistinct->getKey(), collator, &distinctNodeIndex)) {
         // Not a "simple" DISTINCT_SCAN or no suitable index was found.
@@ -2296,8 +2444,10 @@ getExecutorDistinctFromIndexSolutions(OperationContext* opCtx,
 
     // We look for a solution that has an ixscan we can turn into a distinctixscan
     for (size_t i = 0; i < solutions.size(); ++i) {
-        if (turnIxscanIntoDistinctIxscan(
-                solutions[i].get(), parsedDistinct->getKey(), strictDistinctOnly)) {
+        if (turnIxscanIntoDistinctIxscan(solutions[i].get(),
+                                         parsedDistinct->getKey(),
+                                         strictDistinctOnly,
+                                         parsedDistinct->getAdditionalKeys())) {
             // Build and return the SSR over solutions[i].
             std::unique_ptr<WorkingSet> ws = std::make_unique<WorkingSet>();
             std::unique_ptr<QuerySolution> currentSolution = std::move(solutions[i]);
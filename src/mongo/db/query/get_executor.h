@@ -151,12 +151,17 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorFind
  * documents that need to be examined to compute the results of a distinct command, but it may not
  * guarantee that there are no duplicate values for the distinct field.
  *
+ * 'additionalFields' lists other fields which the results must also be distinct on, such as the
+ * remaining fields of a $group on several fields. The DISTINCT_SCAN then skips to the next value
+ * of the index prefix ending at whichever of these fields comes last in the index.
+ *
  * If the provided solution could be mutated successfully, returns true, otherwise returns
  * false.
  */
 bool turnIxscanIntoDistinctIxscan(QuerySolution* soln,
                                   const std::string& field,
-                                  bool strictDistinctOnly);
+                                  bool strictDistinctOnly,
+                                  const std::vector<std::string>& additionalFields = {});
 
 /**
  * Get an executor that potentially uses a DISTINCT_SCAN, intended for either a "distinct" command
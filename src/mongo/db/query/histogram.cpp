@@ -0,0 +1,190 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/histogram.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/query/index_bounds.h"
+
+namespace mongo {
+namespace {
+
+// Sampled values are compared the way index keys are, ignoring their field names.
+int compareValues(const BSONElement& lhs, const BSONElement& rhs) {
+    return lhs.woCompare(rhs, 0);
+}
+
+}  // namespace
+
+Histogram Histogram::make(std::vector<BSONElement> values, size_t maxBuckets) {
+    Histogram histogram;
+    if (values.empty() || maxBuckets == 0) {
+        return histogram;
+    }
+
+    std::sort(values.begin(), values.end(), [](const BSONElement& lhs, const BSONElement& rhs) {
+        return compareValues(lhs, rhs) < 0;
+    });
+
+    // Close a bucket whenever the values seen so far fill one more of the 'maxBuckets' equal
+    // shares of the sample. A run of equal values is never split across buckets.
+    BSONArrayBuilder bounds;
+    bounds.append(values.front());
+
+    const size_t numValues = values.size();
+    Bucket current;
+    size_t i = 0;
+    while (i < numValues) {
+        size_t j = i + 1;
+        while (j < numValues && compareValues(values[i], values[j]) == 0) {
+            ++j;
+        }
+        const double runCount = j - i;
+        ++histogram._distinctCount;
+
+        if (j == numValues || j * maxBuckets >= (histogram._buckets.size() + 1) * numValues) {
+            current.equalCount = runCount;
+            bounds.append(values[i]);
+            histogram._buckets.push_back(current);
+            current = Bucket{};
+        } else {
+            current.rangeCount += runCount;
+            ++current.rangeDistinct;
+        }
+        i = j;
+    }
+
+    histogram._totalCount = numValues;
+    histogram._bounds = bounds.obj();
+
+    BSONObjIterator it(histogram._bounds);
+    histogram._min = it.next();
+    for (auto&& bucket : histogram._buckets) {
+        bucket.upperBound = it.next();
+    }
+    return histogram;
+}
+
+double Histogram::estimate(const Interval& interval) const {
+    if (_buckets.empty()) {
+        return 0;
+    }
+
+    auto start = interval.start;
+    auto end = interval.end;
+    auto startInclusive = interval.startInclusive;
+    auto endInclusive = interval.endInclusive;
+    if (compareValues(start, end) > 0) {
+        std::swap(start, end);
+        std::swap(startInclusive, endInclusive);
+    }
+
+    auto contains = [&](const BSONElement& value) {
+        const int startCmp = compareValues(start, value);
+        const int endCmp = compareValues(value, end);
+        return (startCmp < 0 || (startCmp == 0 && startInclusive)) &&
+            (endCmp < 0 || (endCmp == 0 && endInclusive));
+    };
+
+    double count = 0;
+
+    // The range of the first bucket includes the smallest sampled value, the range of every other
+    // bucket starts right after the upper bound of the previous bucket.
+    BSONElement lower = _min;
+    bool lowerInclusive = true;
+    for (auto&& bucket : _buckets) {
+        if (contains(bucket.upperBound)) {
+            count += bucket.equalCount;
+        }
+
+        if (bucket.rangeCount > 0) {
+            const int startVsLower = compareValues(start, lower);
+            const int endVsLower = compareValues(end, lower);
+            const bool endsBeforeRange =
+                endVsLower < 0 || (endVsLower == 0 && !(endInclusive && lowerInclusive));
+            const bool startsAfterRange = compareValues(start, bucket.upperBound) >= 0;
+
+            if (!endsBeforeRange && !startsAfterRange) {
+                const bool coversLower =
+                    startVsLower < 0 || (startVsLower == 0 && (startInclusive || !lowerInclusive));
+                const bool coversUpper = compareValues(end, bucket.upperBound) >= 0;
+
+                if (coversLower && coversUpper) {
+                    count += bucket.rangeCount;
+                } else if (interval.isPoint()) {
+                    // Assume that the distinct values of the range are equally frequent.
+                    count += bucket.rangeCount / std::max(1.0, bucket.rangeDistinct);
+                } else {
+                    // Values of different types cannot be interpolated, so assume that a partially
+                    // covered range contributes half of its values.
+                    count += bucket.rangeCount / 2;
+                }
+            }
+        }
+
+        lower = bucket.upperBound;
+        lowerInclusive = false;
+    }
+
+    return count;
+}
+
+double Histogram::estimate(const OrderedIntervalList& oil) const {
+    double count = 0;
+    for (auto&& interval : oil.intervals) {
+        count += estimate(interval);
+    }
+    return std::min(count, _totalCount);
+}
+
+BSONObj Histogram::toBSON() const {
+    BSONObjBuilder builder;
+    builder.append("totalCount", _totalCount);
+    builder.append("distinctCount", _distinctCount);
+    if (!_min.eoo()) {
+        builder.appendAs(_min, "min");
+    }
+
+    BSONArrayBuilder buckets(builder.subarrayStart("buckets"));
+    for (auto&& bucket : _buckets) {
+        BSONObjBuilder bucketBuilder(buckets.subobjStart());
+        bucketBuilder.appendAs(bucket.upperBound, "upperBound");
+        bucketBuilder.append("equalCount", bucket.equalCount);
+        bucketBuilder.append("rangeCount", bucket.rangeCount);
+        bucketBuilder.append("rangeDistinct", bucket.rangeDistinct);
+    }
+    buckets.doneFast();
+    return builder.obj();
+}
+
+}  // namespace mongo
@@ -0,0 +1,115 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/query/interval.h"
+
+namespace mongo {
+
+class OrderedIntervalList;
+
+/**
+ * An equi-depth histogram of a sample of the values of a field. Values of all types are ordered as
+ * index keys are, i.e. by canonical type first, without a collation.
+ *
+ * Each bucket is summarized by its upper bound, the number of sampled values equal to that bound,
+ * and the number and distinct count of sampled values strictly between the upper bound of the
+ * previous bucket and its own. The first bucket also covers its lower bound, the smallest sampled
+ * value. A value frequent enough to fill a bucket on its own always ends up as an upper bound, so
+ * the frequency of the most common values is known exactly.
+ *
+ * Estimates are expressed in number of sampled values. It is up to the caller to scale them to the
+ * size of the collection.
+ */
+class Histogram {
+public:
+    struct Bucket {
+        // Points into the storage owned by the Histogram.
+        BSONElement upperBound;
+
+        // The number of sampled values equal to 'upperBound'.
+        double equalCount = 0;
+
+        // The number of sampled values strictly between the upper bound of the previous bucket
+        // and 'upperBound', and the number of distinct values among them.
+        double rangeCount = 0;
+        double rangeDistinct = 0;
+    };
+
+    /**
+     * Builds a histogram of 'values' with at most 'maxBuckets' buckets. The histogram does not
+     * refer to the storage of 'values' once built.
+     */
+    static Histogram make(std::vector<BSONElement> values, size_t maxBuckets);
+
+    Histogram() = default;
+
+    /**
+     * Returns the estimated number of sampled values which fall within 'interval', or within any
+     * of the intervals in 'oil'. The intervals may be ordered either way.
+     */
+    double estimate(const Interval& interval) const;
+    double estimate(const OrderedIntervalList& oil) const;
+
+    const std::vector<Bucket>& getBuckets() const {
+        return _buckets;
+    }
+
+    /**
+     * Returns the number of sampled values.
+     */
+    double getTotalCount() const {
+        return _totalCount;
+    }
+
+    /**
+     * Returns the number of distinct sampled values.
+     */
+    double getDistinctCount() const {
+        return _distinctCount;
+    }
+
+    BSONObj toBSON() const;
+
+private:
+    // Owns the smallest sampled value followed by the upper bounds of the buckets.
+    BSONObj _bounds;
+
+    BSONElement _min;
+    std::vector<Bucket> _buckets;
+    double _totalCount = 0;
+    double _distinctCount = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,200 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/histogram.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/query/index_bounds.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::vector<BSONElement> elements(const BSONObj& obj) {
+    std::vector<BSONElement> result;
+    for (auto&& elem : obj) {
+        result.push_back(elem);
+    }
+    return result;
+}
+
+/**
+ * Returns {0, 1, 1, 2, 2, 2, ..., n, ...}, i.e. value 'i' repeated 'i' times.
+ */
+BSONObj triangularValues(int n) {
+    BSONArrayBuilder builder;
+    for (int i = 1; i <= n; ++i) {
+        for (int j = 0; j < i; ++j) {
+            builder.append(i);
+        }
+    }
+    return builder.arr();
+}
+
+Interval interval(const BSONObj& bounds, bool startInclusive = true, bool endInclusive = true) {
+    return Interval(bounds, startInclusive, endInclusive);
+}
+
+TEST(HistogramTest, EmptySample) {
+    auto histogram = Histogram::make({}, 10);
+    ASSERT_EQ(histogram.getBuckets().size(), 0U);
+    ASSERT_EQ(histogram.getTotalCount(), 0);
+    ASSERT_EQ(histogram.estimate(interval(BSON("" << MINKEY << "" << MAXKEY))), 0);
+}
+
+TEST(HistogramTest, CountsAddUpToSampleSize) {
+    auto values = triangularValues(20);
+    auto histogram = Histogram::make(elements(values), 8);
+
+    ASSERT_LTE(histogram.getBuckets().size(), 8U);
+    ASSERT_EQ(histogram.getTotalCount(), 210);
+    ASSERT_EQ(histogram.getDistinctCount(), 20);
+
+    double total = 0;
+    double distinct = 0;
+    for (auto&& bucket : histogram.getBuckets()) {
+        total += bucket.equalCount + bucket.rangeCount;
+        distinct += 1 + bucket.rangeDistinct;
+    }
+    ASSERT_EQ(total, 210);
+    ASSERT_EQ(distinct, 20);
+    ASSERT_EQ(histogram.getBuckets().back().upperBound.numberInt(), 20);
+}
+
+TEST(HistogramTest, DoesNotReferToInputValues) {
+    Histogram histogram;
+    {
+        auto values = triangularValues(10);
+        histogram = Histogram::make(elements(values), 4);
+    }
+    ASSERT_EQ(histogram.getBuckets().back().upperBound.numberInt(), 10);
+    ASSERT_EQ(histogram.estimate(interval(BSON("" << 10 << "" << 10))), 10);
+}
+
+TEST(HistogramTest, FullRangeEstimatesEverything) {
+    auto values = triangularValues(20);
+    auto histogram = Histogram::make(elements(values), 5);
+    ASSERT_EQ(histogram.estimate(interval(BSON("" << MINKEY << "" << MAXKEY))), 210);
+    ASSERT_EQ(histogram.estimate(interval(BSON("" << MAXKEY << "" << MINKEY))), 210);
+    ASSERT_EQ(histogram.estimate(interval(BSON("" << 1 << "" << 20))), 210);
+
+    // The ends of the open interval fall within bucket ranges, which are only partially counted.
+    auto open = histogram.estimate(interval(BSON("" << 1 << "" << 20), false, false));
+    ASSERT_LT(open, 210);
+    ASSERT_GT(open, 150);
+}
+
+TEST(HistogramTest, FrequentValueIsEstimatedExactly) {
+    BSONArrayBuilder builder;
+    for (int i = 0; i < 100; ++i) {
+        builder.append(i);
+    }
+    for (int i = 0; i < 500; ++i) {
+        builder.append(42);
+    }
+    auto values = builder.arr();
+    auto histogram = Histogram::make(elements(values), 10);
+    ASSERT_EQ(histogram.estimate(interval(BSON("" << 42 << "" << 42))), 501);
+}
+
+TEST(HistogramTest, PointWithinRangeUsesDistinctCount) {
+    BSONArrayBuilder builder;
+    for (int i = 0; i < 1000; ++i) {
+        builder.append(i % 100);
+    }
+    auto values = builder.arr();
+    auto histogram = Histogram::make(elements(values), 10);
+    ASSERT_EQ(histogram.getDistinctCount(), 100);
+    for (int i : {0, 5, 55, 99}) {
+        ASSERT_EQ(histogram.estimate(interval(BSON("" << i << "" << i))), 10);
+    }
+}
+
+TEST(HistogramTest, ValuesOutsideOfSampleEstimateZero) {
+    auto values = triangularValues(10);
+    auto histogram = Histogram::make(elements(values), 4);
+    ASSERT_EQ(histogram.estimate(interval(BSON("" << 0 << "" << 0))), 0);
+    ASSERT_EQ(histogram.estimate(interval(BSON("" << 11 << "" << 100))), 0);
+    ASSERT_EQ(histogram.estimate(interval(BSON("" << MINKEY << "" << 1), true, false)), 0);
+    ASSERT_EQ(histogram.estimate(interval(BSON("" << "a"
+                                                  << ""
+                                                  << "z"))),
+              0);
+}
+
+TEST(HistogramTest, ValuesOfDifferentTypes) {
+    auto values = BSON_ARRAY(BSONNULL << BSONNULL << 1 << 2 << 3 << "a"
+                                      << "b"
+                                      << "c" << true);
+    auto histogram = Histogram::make(elements(values), 3);
+    ASSERT_EQ(histogram.estimate(interval(BSON("" << BSONNULL << "" << BSONNULL))), 2);
+    ASSERT_EQ(histogram.estimate(interval(BSON("" << MINKEY << "" << MAXKEY))), 9);
+
+    ASSERT_EQ(histogram.estimate(interval(BSON("" << MINKEY << "" << 1))), 3);
+    ASSERT_EQ(histogram.estimate(interval(BSON("" << true << "" << true))), 1);
+}
+
+TEST(HistogramTest, OrderedIntervalListSumsIntervals) {
+    BSONArrayBuilder builder;
+    for (int i = 0; i < 1000; ++i) {
+        builder.append(i % 100);
+    }
+    auto values = builder.arr();
+    auto histogram = Histogram::make(elements(values), 10);
+
+    OrderedIntervalList oil("a");
+    oil.intervals.push_back(interval(BSON("" << 1 << "" << 1)));
+    oil.intervals.push_back(interval(BSON("" << 7 << "" << 7)));
+    oil.intervals.push_back(interval(BSON("" << 500 << "" << 500)));
+    ASSERT_EQ(histogram.estimate(oil), 20);
+
+    OrderedIntervalList all("a");
+    all.intervals.push_back(interval(BSON("" << MINKEY << "" << MAXKEY)));
+    all.intervals.push_back(interval(BSON("" << MINKEY << "" << MAXKEY)));
+    ASSERT_EQ(histogram.estimate(all), 1000);
+}
+
+TEST(HistogramTest, ToBSON) {
+    auto values = BSON_ARRAY(1 << 1 << 2 << 3);
+    auto histogram = Histogram::make(elements(values), 2);
+    ASSERT_BSONOBJ_EQ(histogram.toBSON(),
+                      BSON("totalCount" << 4.0 << "distinctCount" << 3.0 << "min" << 1 << "buckets"
+                                        << BSON_ARRAY(BSON("upperBound" << 1 << "equalCount" << 2.0
+                                                                        << "rangeCount" << 0.0
+                                                                        << "rangeDistinct" << 0.0)
+                                                      << BSON("upperBound"
+                                                              << 3 << "equalCount" << 1.0
+                                                              << "rangeCount" << 1.0
+                                                              << "rangeDistinct" << 1.0))));
+}
+
+}  // namespace
+}  // namespace mongo
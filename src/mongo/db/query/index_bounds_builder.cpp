@@ -39,6 +39,7 @@
 #include "mongo/db/geo/geoconstants.h"
 #include "mongo/db/geo/s2.h"
 #include "mongo/db/index/expression_params.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/s2_common.h"
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/matcher/expression_internal_expr_comparison.h"
@@ -128,10 +129,26 @@ const Interval kHashedUndefinedInterval = IndexBoundsBuilder::makePointInterval(
 const Interval kHashedNullInterval =
     IndexBoundsBuilder::makePointInterval(ExpressionMapping::hash(kNullElementObj.firstElement()));
 
-Interval makeUndefinedPointInterval(bool isHashed) {
+/**
+ * Returns the hash function used by a hashed index.
+ */
+HashVersion getHashVersion(const IndexEntry& index) {
+    return static_cast<HashVersion>(
+        index.infoObj[IndexDescriptor::kHashVersionFieldName].numberInt());
+}
+
+Interval makeUndefinedPointInterval(const IndexEntry& index, bool isHashed) {
+    if (isHashed && getHashVersion(index) != HashVersion::kMD5) {
+        return IndexBoundsBuilder::makePointInterval(
+            ExpressionMapping::hash(kUndefinedElementObj.firstElement(), getHashVersion(index)));
+    }
     return isHashed ? kHashedUndefinedInterval : IndexBoundsBuilder::kUndefinedPointInterval;
 }
-Interval makeNullPointInterval(bool isHashed) {
+Interval makeNullPointInterval(const IndexEntry& index, bool isHashed) {
+    if (isHashed && getHashVersion(index) != HashVersion::kMD5) {
+        return IndexBoundsBuilder::makePointInterval(
+            ExpressionMapping::hash(kNullElementObj.firstElement(), getHashVersion(index)));
+    }
     return isHashed ? kHashedNullInterval : IndexBoundsBuilder::kNullPointInterval;
 }
 
@@ -144,8 +161,8 @@ void makeNullEqualityBounds(const IndexEntry& index,
     *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
 
     // There are two values that could possibly be equal to null in an index: undefined and null.
-    oil->intervals.push_back(makeUndefinedPointInterval(isHashed));
-    oil->intervals.push_back(makeNullPointInterval(isHashed));
+    oil->intervals.push_back(makeUndefinedPointInterval(index, isHashed));
+    oil->intervals.push_back(makeNullPointInterval(index, isHashed));
 
     // Just to be sure, make sure the bounds are in the right order if the hash values are opposite.
     IndexBoundsBuilder::unionize(oil);
@@ -558,7 +575,7 @@ void IndexBoundsBuilder::_translatePredicate(const MatchExpression* expr,
             // We should never try to use a sparse index for $exists:false.
             invariant(!index.sparse);
             // {$exists:false} is a point-interval on [null,null] that requires a fetch.
-            oilOut->intervals.push_back(makeNullPointInterval(isHashed));
+            oilOut->intervals.push_back(makeNullPointInterval(index, isHashed));
             *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
             return;
         }
@@ -1241,7 +1258,7 @@ void IndexBoundsBuilder::translateEquality(const BSONElement& data,
     if (BSONType::Array != data.type()) {
         BSONObj dataObj = objFromElement(data, index.collator);
         if (isHashed) {
-            dataObj = ExpressionMapping::hash(dataObj.firstElement());
+            dataObj = ExpressionMapping::hash(dataObj.firstElement(), getHashVersion(index));
         }
 
         verify(dataObj.isOwned());
@@ -85,7 +85,8 @@ std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> InternalPlanner::deleteWith
     PlanYieldPolicy::YieldPolicy yieldPolicy,
     Direction direction,
     boost::optional<RecordId> minRecord,
-    boost::optional<RecordId> maxRecord) {
+    boost::optional<RecordId> maxRecord,
+    const MatchExpression* filter) {
     const auto& collection = *coll;
     invariant(collection);
     auto ws = std::make_unique<WorkingSet>();
@@ -94,7 +95,7 @@ std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> InternalPlanner::deleteWith
         opCtx, std::unique_ptr<CollatorInterface>(nullptr), collection->ns());
 
     auto root = _collectionScan(
-        expCtx, ws.get(), &collection, direction, boost::none, minRecord, maxRecord);
+        expCtx, ws.get(), &collection, direction, boost::none, minRecord, maxRecord, filter);
 
     root = std::make_unique<DeleteStage>(
         expCtx.get(), std::move(params), ws.get(), collection, root.release());
@@ -229,7 +230,8 @@ std::unique_ptr<PlanStage> InternalPlanner::_collectionScan(
     Direction direction,
     boost::optional<RecordId> resumeAfterRecordId,
     boost::optional<RecordId> minRecord,
-    boost::optional<RecordId> maxRecord) {
+    boost::optional<RecordId> maxRecord,
+    const MatchExpression* filter) {
 
     const auto& collection = *coll;
     invariant(collection);
@@ -247,7 +249,7 @@ std::unique_ptr<PlanStage> InternalPlanner::_collectionScan(
         params.direction = CollectionScanParams::BACKWARD;
     }
 
-    return std::make_unique<CollectionScan>(expCtx.get(), collection, params, ws, nullptr);
+    return std::make_unique<CollectionScan>(expCtx.get(), collection, params, ws, filter);
 }
 
 std::unique_ptr<PlanStage> InternalPlanner::_indexScan(
@@ -41,6 +41,7 @@ class BSONObj;
 class Collection;
 class CollectionPtr;
 class IndexDescriptor;
+class MatchExpression;
 class OperationContext;
 class PlanStage;
 class WorkingSet;
@@ -81,7 +82,8 @@ public:
         boost::optional<RecordId> maxRecord = boost::none);
 
     /**
-     * Returns a FETCH => DELETE plan.
+     * Returns a FETCH => DELETE plan. If 'filter' is non-null, only the documents matching it are
+     * deleted; it must outlive the returned executor.
      */
     static std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> deleteWithCollectionScan(
         OperationContext* opCtx,
@@ -90,7 +92,8 @@ public:
         PlanYieldPolicy::YieldPolicy yieldPolicy,
         Direction direction = FORWARD,
         boost::optional<RecordId> minRecord = boost::none,
-        boost::optional<RecordId> maxRecord = boost::none);
+        boost::optional<RecordId> maxRecord = boost::none,
+        const MatchExpression* filter = nullptr);
 
     /**
      * Returns an index scan.  Caller owns returned pointer.
@@ -144,7 +147,8 @@ private:
         Direction direction,
         boost::optional<RecordId> resumeAfterRecordId = boost::none,
         boost::optional<RecordId> minRecord = boost::none,
-        boost::optional<RecordId> maxRecord = boost::none);
+        boost::optional<RecordId> maxRecord = boost::none,
+        const MatchExpression* filter = nullptr);
 
     /**
      * Returns a plan stage that is either an index scan or an index scan with a fetch stage.
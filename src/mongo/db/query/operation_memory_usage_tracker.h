@@ -0,0 +1,90 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/platform/atomic_word.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Tracks the memory used by the stages of one operation, and by all operations on the node
+ * together. Stages report their usage through a MemoryUsageTracker attached to the operation's
+ * tracker, and consult exceedsLimit() to spill before the 'internalQueryMaxOperationMemoryBytes'
+ * and 'internalQueryMaxGlobalMemoryBytes' limits are exceeded.
+ *
+ * Stages attach to the tracker of the operation they run in, and move their memory to the next
+ * operation's tracker when they are reattached, e.g. across getMores. Updates are made by the
+ * thread running the operation, but the counters may be read concurrently, for example by
+ * $currentOp.
+ */
+class OperationMemoryUsageTracker {
+public:
+    OperationMemoryUsageTracker() = default;
+    OperationMemoryUsageTracker(const OperationMemoryUsageTracker&) = delete;
+    OperationMemoryUsageTracker& operator=(const OperationMemoryUsageTracker&) = delete;
+
+    /**
+     * Releases any memory still tracked by this operation from the node-wide total.
+     */
+    ~OperationMemoryUsageTracker();
+
+    static OperationMemoryUsageTracker& get(OperationContext* opCtx);
+
+    /**
+     * Returns the memory currently tracked by all operations on this node.
+     */
+    static long long globalMemoryBytes();
+
+    /**
+     * Adds 'diff' to the memory tracked by this operation and by the node.
+     */
+    void update(long long diff);
+
+    /**
+     * Returns true if this operation or the node as a whole is over its memory limit.
+     */
+    bool exceedsLimit() const;
+
+    long long currentMemoryBytes() const {
+        return _currentMemoryBytes.load();
+    }
+
+    long long peakMemoryBytes() const {
+        return _peakMemoryBytes.load();
+    }
+
+private:
+    AtomicWord<long long> _currentMemoryBytes{0};
+    AtomicWord<long long> _peakMemoryBytes{0};
+};
+
+}  // namespace mongo
@@ -31,6 +31,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "mongo/base/status_with.h"
 #include "mongo/db/query/canonical_query.h"
@@ -52,8 +53,12 @@ public:
     static const char kCollationField[];
     static const char kCommentField[];
 
-    ParsedDistinct(std::unique_ptr<CanonicalQuery> query, const std::string key)
-        : _query(std::move(query)), _key(std::move(key)) {}
+    ParsedDistinct(std::unique_ptr<CanonicalQuery> query,
+                   const std::string key,
+                   std::vector<std::string> additionalKeys = {})
+        : _query(std::move(query)),
+          _key(std::move(key)),
+          _additionalKeys(std::move(additionalKeys)) {}
 
     const CanonicalQuery* getQuery() const {
         return _query.get();
@@ -71,6 +76,15 @@ public:
         return _key;
     }
 
+    /**
+     * Fields other than the key over which the results must also be distinct. This is only set
+     * when a $group on several fields is answered with a DISTINCT_SCAN, in which case a single
+     * document is wanted for each distinct combination of values of the key and these fields.
+     */
+    const std::vector<std::string>& getAdditionalKeys() const {
+        return _additionalKeys;
+    }
+
     /**
      * Convert this ParsedDistinct into an aggregation command object.
      */
@@ -92,6 +106,8 @@ private:
 
     // The field for which we are getting distinct values.
     const std::string _key;
+
+    const std::vector<std::string> _additionalKeys;
 };
 
 }  // namespace mongo
@@ -36,6 +36,7 @@
 #include <boost/iterator/transform_iterator.hpp>
 
 #include <algorithm>
+#include <array>
 #include <math.h>
 #include <memory>
 #include <vector>
@@ -63,6 +64,60 @@ namespace {
 ServerStatusMetricField<Counter64> totalPlanCacheSizeEstimateBytesMetric(
     "query.planCacheTotalSizeEstimateBytes", &PlanCacheEntry::planCacheTotalSizeEstimateBytes);
 
+// Number of plan cache entries evicted to keep the plan caches within their limits, including new
+// entries which were not admitted.
+Counter64 planCacheEvictions;
+ServerStatusMetricField<Counter64> planCacheEvictionsMetric("query.planCache.evictions",
+                                                            &planCacheEvictions);
+
+// Number of plan cache lookups which missed because the entry for the query shape had been
+// evicted. Each of them causes the query to be planned again.
+Counter64 planCacheMissesAfterEviction;
+ServerStatusMetricField<Counter64> planCacheMissesAfterEvictionMetric(
+    "query.planCache.missesAfterEviction", &planCacheMissesAfterEviction);
+
+// Source of the PlanCache epochs. Epochs are unique across all PlanCache instances.
+AtomicWord<uint64_t> nextPlanCacheEpoch{1};
+
+/**
+ * Reports how many plan cache entries currently exist, bucketed by their estimated size.
+ */
+class PlanCacheEntrySizeDistribution final : public ServerStatusMetric {
+public:
+    PlanCacheEntrySizeDistribution() : ServerStatusMetric("query.planCache.entrySizes") {}
+
+    void record(uint64_t sizeBytes, bool created) {
+        auto& bucket = _buckets[_bucketIndex(sizeBytes)];
+        if (created) {
+            bucket.increment();
+        } else {
+            bucket.decrement();
+        }
+    }
+
+    void appendAtLeaf(BSONObjBuilder& b) const final {
+        BSONObjBuilder sizesBob(b.subobjStart(_leafName));
+        for (size_t i = 0; i < kBucketNames.size(); ++i) {
+            sizesBob.append(kBucketNames[i], static_cast<long long>(_buckets[i].get()));
+        }
+        sizesBob.done();
+    }
+
+private:
+    // Upper bounds, exclusive, of all the buckets but the last one.
+    static constexpr std::array<uint64_t, 4> kBucketBounds = {
+        1024, 16 * 1024, 256 * 1024, 1024 * 1024};
+    static constexpr std::array<StringData, 5> kBucketNames = {
+        "lessThan1KB"_sd, "lessThan16KB"_sd, "lessThan256KB"_sd, "lessThan1MB"_sd, "atLeast1MB"_sd};
+
+    static size_t _bucketIndex(uint64_t sizeBytes) {
+        return std::upper_bound(kBucketBounds.begin(), kBucketBounds.end(), sizeBytes) -
+            kBucketBounds.begin();
+    }
+
+    std::array<Counter64, kBucketNames.size()> _buckets;
+} planCacheEntrySizeDistribution;
+
 // Delimiters for cache key encoding.
 const char kEncodeDiscriminatorsBegin = '<';
 const char kEncodeDiscriminatorsEnd = '>';
@@ -249,10 +304,12 @@ PlanCacheEntry::PlanCacheEntry(std::unique_ptr<const SolutionCacheData> plannerD
     // Account for the object in the global metric for estimating the server's total plan cache
     // memory consumption.
     planCacheTotalSizeEstimateBytes.increment(estimatedEntrySizeBytes);
+    planCacheEntrySizeDistribution.record(estimatedEntrySizeBytes, true /* created */);
 }
 
 PlanCacheEntry::~PlanCacheEntry() {
     planCacheTotalSizeEstimateBytes.decrement(estimatedEntrySizeBytes);
+    planCacheEntrySizeDistribution.record(estimatedEntrySizeBytes, false /* created */);
 }
 
 std::unique_ptr<PlanCacheEntry> PlanCacheEntry::clone() const {
@@ -419,6 +476,10 @@ std::string SolutionCacheData::toString() const {
                                  << "tree=" << this->tree->toString() << ")";
         case COLLSCAN_SOLN:
             return "(collection scan)";
+        case SKIP_SCAN_SOLN:
+            verify(this->tree.get());
+            return str::stream() << "(skip scan solution: "
+                                 << "tree=" << this->tree->toString() << ")";
         case USE_INDEX_TAGS_SOLN:
             verify(this->tree.get());
             return str::stream() << "(index-tagged expression tree: "
@@ -433,7 +494,11 @@ std::string SolutionCacheData::toString() const {
 
 PlanCache::PlanCache() : PlanCache(internalQueryCacheMaxEntriesPerCollection.load()) {}
 
-PlanCache::PlanCache(size_t size) : _cache(size) {}
+PlanCache::PlanCache(size_t size)
+    : PlanCache(size, internalQueryCacheMaxSizeBytesPerCollection.load()) {}
+
+PlanCache::PlanCache(size_t maxEntries, size_t maxSizeBytes)
+    : _cache(maxEntries, maxSizeBytes), _epoch(nextPlanCacheEpoch.fetchAndAdd(1)) {}
 
 PlanCache::~PlanCache() {}
 
@@ -624,12 +689,13 @@ Status PlanCache::set(const CanonicalQuery& query,
     auto newEntry(PlanCacheEntry::create(
         solns, std::move(why), query, queryHash, planCacheKey, now, isNewEntryActive, newWorks));
 
-    std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(key, newEntry.release());
+    auto evictedEntries = _cache.add(key, newEntry.release());
 
-    if (nullptr != evictedEntry.get()) {
+    planCacheEvictions.increment(evictedEntries.size());
+    for (auto&& evictedEntry : evictedEntries) {
         LOGV2_DEBUG(20942,
                     1,
-                    "Plan cache maximum size exceeded - removed least recently used entry",
+                    "Plan cache maximum size exceeded - removed least frequently used entry",
                     "namespace"_attr = query.nss(),
                     "evictedEntry"_attr = redact(evictedEntry->debugString()));
     }
@@ -666,6 +732,9 @@ PlanCache::GetResult PlanCache::get(const PlanCacheKey& key) const {
     Status cacheStatus = _cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         invariant(cacheStatus == ErrorCodes::NoSuchKey);
+        if (_cache.wasEvicted(key)) {
+            planCacheMissesAfterEviction.increment();
+        }
         return {CacheEntryState::kNotPresent, nullptr};
     }
     invariant(entry);
@@ -683,6 +752,7 @@ Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
 void PlanCache::clear() {
     stdx::lock_guard<Latch> cacheLock(_cacheMutex);
     _cache.clear();
+    _epoch.store(nextPlanCacheEpoch.fetchAndAdd(1));
 }
 
 PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
@@ -713,10 +783,9 @@ std::vector<std::unique_ptr<PlanCacheEntry>> PlanCache::getAllEntries() const {
     stdx::lock_guard<Latch> cacheLock(_cacheMutex);
     std::vector<std::unique_ptr<PlanCacheEntry>> entries;
 
-    for (auto&& cacheEntry : _cache) {
-        auto entry = cacheEntry.second;
-        entries.push_back(std::unique_ptr<PlanCacheEntry>(entry->clone()));
-    }
+    _cache.forEach([&](const PlanCacheKey&, const PlanCacheEntry& entry) {
+        entries.push_back(entry.clone());
+    });
 
     return entries;
 }
@@ -728,6 +797,7 @@ size_t PlanCache::size() const {
 
 void PlanCache::notifyOfIndexUpdates(const std::vector<CoreIndexInfo>& indexCores) {
     _indexabilityState.updateDiscriminators(indexCores);
+    _epoch.store(nextPlanCacheEpoch.fetchAndAdd(1));
 }
 
 std::vector<BSONObj> PlanCache::getMatchingStats(
@@ -736,13 +806,12 @@ std::vector<BSONObj> PlanCache::getMatchingStats(
     std::vector<BSONObj> results;
     stdx::lock_guard<Latch> cacheLock(_cacheMutex);
 
-    for (auto&& cacheEntry : _cache) {
-        const auto entry = cacheEntry.second;
-        auto serializedEntry = serializationFunc(*entry);
+    _cache.forEach([&](const PlanCacheKey&, const PlanCacheEntry& entry) {
+        auto serializedEntry = serializationFunc(entry);
         if (filterFunc(serializedEntry)) {
             results.push_back(serializedEntry);
         }
-    }
+    });
 
     return results;
 }
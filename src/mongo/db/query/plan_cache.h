@@ -35,10 +35,10 @@
 #include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/index_tag.h"
-#include "mongo/db/query/lru_key_value.h"
 #include "mongo/db/query/plan_cache_indexability.h"
 #include "mongo/db/query/plan_ranking_decision.h"
 #include "mongo/db/query/query_planner_params.h"
+#include "mongo/db/query/tiny_lfu_key_value.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/container_size_helper.h"
@@ -260,6 +260,10 @@ struct SolutionCacheData {
         // The cached plan is a collection scan.
         COLLSCAN_SOLN,
 
+        // The cached plan scans the index stored in 'tree' over all values of its leading field,
+        // with bounds on the trailing fields rebuilt from the query.
+        SKIP_SCAN_SOLN,
+
         // Build the solution by using 'tree'
         // to tag the match expression.
         USE_INDEX_TAGS_SOLN
@@ -438,6 +442,15 @@ private:
     uint64_t _estimateObjectSizeInBytes() const;
 };
 
+/**
+ * Charges each plan cache entry its estimated size in bytes, including the size of its key.
+ */
+struct PlanCacheEntryBudgetEstimator {
+    size_t operator()(const PlanCacheKey& key, const PlanCacheEntry& entry) const {
+        return key.stringData().size() + entry.estimatedEntrySizeBytes;
+    }
+};
+
 /**
  * Caches the best solution to a query.  Aside from the (CanonicalQuery -> QuerySolution)
  * mapping, the cache contains information on why that mapping was made and statistics on the
@@ -484,12 +497,16 @@ public:
     static bool shouldCacheQuery(const CanonicalQuery& query);
 
     /**
-     * If omitted, namespace set to empty string.
+     * The cache holds at most 'internalQueryCacheMaxEntriesPerCollection' entries, whose estimated
+     * sizes add up to at most 'internalQueryCacheMaxSizeBytesPerCollection' bytes. Entries are
+     * evicted according to how often and how recently their query shape was looked up.
      */
     PlanCache();
 
     PlanCache(size_t size);
 
+    PlanCache(size_t maxEntries, size_t maxSizeBytes);
+
     ~PlanCache();
 
     /**
@@ -600,6 +617,16 @@ public:
         const std::function<BSONObj(const PlanCacheEntry&)>& serializationFunc,
         const std::function<bool(const BSONObj&)>& filterFunc) const;
 
+    /**
+     * Returns a number which changes whenever this cache is cleared or the indexes it knows about
+     * are updated, and which is never shared with any other PlanCache instance. Caches of state
+     * derived from the indexes of the collection, such as compiled SBE plans, use it to tell
+     * whether that state is still current.
+     */
+    uint64_t getEpoch() const {
+        return _epoch.load();
+    }
+
 private:
     struct NewEntryState {
         bool shouldBeCreated = false;
@@ -613,7 +640,8 @@ private:
                                    size_t newWorks,
                                    double growthCoefficient);
 
-    LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> _cache;
+    TinyLFUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheEntryBudgetEstimator, PlanCacheKeyHasher>
+        _cache;
 
     // Protects _cache.
     mutable Mutex _cacheMutex = MONGO_MAKE_LATCH("PlanCache::_cacheMutex");
@@ -624,5 +652,7 @@ private:
     // Concurrent access is synchronized by the collection lock.  Multiple concurrent readers
     // are allowed.
     PlanCacheIndexabilityState _indexabilityState;
+
+    AtomicWord<uint64_t> _epoch;
 };
 }  // namespace mongo
@@ -163,6 +163,12 @@ size_t getDocsExamined(StageType type, const SpecificStats* specific) {
     if (STAGE_COLLSCAN == type) {
         const CollectionScanStats* spec = static_cast<const CollectionScanStats*>(specific);
         return spec->docsTested;
+    } else if (STAGE_AND_BITMAP == type) {
+        const AndBitmapStats* spec = static_cast<const AndBitmapStats*>(specific);
+        return spec->docsExamined;
+    } else if (STAGE_BATCHED_ID_LOOKUP == type) {
+        const BatchedIdLookupStats* spec = static_cast<const BatchedIdLookupStats*>(specific);
+        return spec->docsExamined;
     } else if (STAGE_FETCH == type) {
         const FetchStats* spec = static_cast<const FetchStats*>(specific);
         return spec->docsExamined;
@@ -219,6 +225,13 @@ void statsToBSON(const PlanStageStats& stats,
         if (stats.common.executionTimeMillis) {
             bob->appendNumber("executionTimeMillisEstimate", *stats.common.executionTimeMillis);
         }
+        if (stats.common.executionTimeNanos) {
+            bob->appendNumber("executionTimeNanos", *stats.common.executionTimeNanos);
+        }
+        if (stats.common.peakTrackedMemBytes) {
+            bob->appendNumber("peakTrackedMemBytes",
+                              static_cast<long long>(*stats.common.peakTrackedMemBytes));
+        }
 
         bob->appendNumber("works", static_cast<long long>(stats.common.works));
         bob->appendNumber("advanced", static_cast<long long>(stats.common.advanced));
@@ -232,7 +245,22 @@ void statsToBSON(const PlanStageStats& stats,
     }
 
     // Stage-specific stats
-    if (STAGE_AND_HASH == stats.stageType) {
+    if (STAGE_AND_BITMAP == stats.stageType) {
+        AndBitmapStats* spec = static_cast<AndBitmapStats*>(stats.specific.get());
+
+        if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+            bob->appendNumber("docsExamined", static_cast<long long>(spec->docsExamined));
+            bob->appendNumber("docsFailedRevalidation",
+                              static_cast<long long>(spec->docsFailedRevalidation));
+            bob->appendNumber("memUsage", static_cast<long long>(spec->memUsage));
+            bob->appendNumber("memLimit", static_cast<long long>(spec->memLimit));
+
+            for (size_t i = 0; i < spec->bitmapAfterChild.size(); ++i) {
+                bob->appendNumber(std::string(str::stream() << "bitmapAfterChild_" << i),
+                                  static_cast<long long>(spec->bitmapAfterChild[i]));
+            }
+        }
+    } else if (STAGE_AND_HASH == stats.stageType) {
         AndHashStats* spec = static_cast<AndHashStats*>(stats.specific.get());
 
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
@@ -253,6 +281,14 @@ void statsToBSON(const PlanStageStats& stats,
                                   static_cast<long long>(spec->failedAnd[i]));
             }
         }
+    } else if (STAGE_BATCHED_ID_LOOKUP == stats.stageType) {
+        BatchedIdLookupStats* spec = static_cast<BatchedIdLookupStats*>(stats.specific.get());
+
+        if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+            bob->appendNumber("recordIdsBuffered",
+                              static_cast<long long>(spec->recordIdsBuffered));
+            bob->appendNumber("docsExamined", static_cast<long long>(spec->docsExamined));
+        }
     } else if (STAGE_COLLSCAN == stats.stageType) {
         CollectionScanStats* spec = static_cast<CollectionScanStats*>(stats.specific.get());
         bob->append("direction", spec->direction > 0 ? "forward" : "backward");
@@ -450,6 +486,11 @@ void statsToBSON(const PlanStageStats& stats,
                               static_cast<long long>(spec->totalDataSizeBytes));
             bob->appendBool("usedDisk", (spec->spills > 0));
             bob->appendNumber("spills", static_cast<long long>(spec->spills));
+            if (spec->spills > 0) {
+                bob->appendNumber("spilledBytes", static_cast<long long>(spec->spilledBytes));
+                bob->appendNumber("spillTimeMicros",
+                                  static_cast<long long>(spec->spillTimeMicros));
+            }
         }
     } else if (STAGE_SORT_MERGE == stats.stageType) {
         MergeSortStats* spec = static_cast<MergeSortStats*>(stats.specific.get());
@@ -668,6 +709,7 @@ void PlanExplainerImpl::getSummaryStats(PlanSummaryStats* statsOut) const {
 
     statsOut->totalKeysExamined = 0;
     statsOut->totalDocsExamined = 0;
+    statsOut->stageExecutionSummary.clear();
 
     for (size_t i = 0; i < stages.size(); i++) {
         statsOut->totalKeysExamined +=
@@ -675,6 +717,13 @@ void PlanExplainerImpl::getSummaryStats(PlanSummaryStats* statsOut) const {
         statsOut->totalDocsExamined +=
             getDocsExamined(stages[i]->stageType(), stages[i]->getSpecificStats());
 
+        const CommonStats* stageCommon = stages[i]->getCommonStats();
+        if (stageCommon->executionTimeNanos) {
+            statsOut->appendStageExecutionStats(stageCommon->stageTypeStr,
+                                                *stageCommon->executionTimeNanos,
+                                                stageCommon->peakTrackedMemBytes);
+        }
+
         if (isSortStageType(stages[i]->stageType())) {
             statsOut->hasSortStage = true;
 
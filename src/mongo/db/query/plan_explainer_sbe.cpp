@@ -215,6 +215,13 @@ void statsToBSON(const sbe::PlanStageStats* stats,
     if (stats->common.executionTimeMillis) {
         bob->appendNumber("executionTimeMillisEstimate", *stats->common.executionTimeMillis);
     }
+    if (stats->common.executionTimeNanos) {
+        bob->appendNumber("executionTimeNanos", *stats->common.executionTimeNanos);
+    }
+    if (stats->common.peakTrackedMemBytes) {
+        bob->appendNumber("peakTrackedMemBytes",
+                          static_cast<long long>(*stats->common.peakTrackedMemBytes));
+    }
     bob->appendNumber("opens", static_cast<long long>(stats->common.opens));
     bob->appendNumber("closes", static_cast<long long>(stats->common.closes));
     bob->appendNumber("saveState", static_cast<long long>(stats->common.yields));
@@ -419,6 +426,7 @@ void PlanExplainerSBE::getSummaryStats(PlanSummaryStats* statsOut) const {
     statsOut->fromMultiPlanner = isMultiPlan();
     statsOut->totalKeysExamined = 0;
     statsOut->totalDocsExamined = 0;
+    statsOut->stageExecutionSummary.clear();
     statsOut->replanReason = _rootData->replanReason;
 
     // Collect cumulative execution stats for the plan.
@@ -92,9 +92,11 @@ public:
             std::min(1.0 / static_cast<double>(10 * (advances > 0 ? advances : 1)), 1e-4);
 
 
-        // We prefer queries that don't require a fetch stage.
+        // We prefer queries that don't require a fetch stage. The AND_BITMAP and BATCHED_ID_LOOKUP
+        // stages fetch the documents themselves.
         double noFetchBonus = epsilon;
-        if (hasStage(STAGE_FETCH, stats)) {
+        if (hasStage(STAGE_FETCH, stats) || hasStage(STAGE_AND_BITMAP, stats) ||
+            hasStage(STAGE_BATCHED_ID_LOOKUP, stats)) {
             noFetchBonus = 0;
         }
 
@@ -115,7 +117,8 @@ public:
         // allows us to examine fewer documents, the penalty given to ixisect
         // can be made up via the no fetch bonus.
         double noIxisectBonus = epsilon;
-        if (hasStage(STAGE_AND_HASH, stats) || hasStage(STAGE_AND_SORTED, stats)) {
+        if (hasStage(STAGE_AND_HASH, stats) || hasStage(STAGE_AND_SORTED, stats) ||
+            hasStage(STAGE_AND_BITMAP, stats)) {
             noIxisectBonus = 0;
         }
 
@@ -132,7 +135,8 @@ public:
                                     tieBreakers);
 
         if (internalQueryForceIntersectionPlans.load()) {
-            if (hasStage(STAGE_AND_HASH, stats) || hasStage(STAGE_AND_SORTED, stats)) {
+            if (hasStage(STAGE_AND_HASH, stats) || hasStage(STAGE_AND_SORTED, stats) ||
+                hasStage(STAGE_AND_BITMAP, stats)) {
                 // The boost should be >2.001 to make absolutely sure the ixisect plan will win due
                 // to the combination of 1) productivity, 2) eof bonus, and 3) no ixisect bonus.
                 score += 3;
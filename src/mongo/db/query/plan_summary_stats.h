@@ -32,7 +32,11 @@
 #include <optional>
 #include <string>
 
+#include <boost/optional.hpp>
+
+#include "mongo/base/string_data.h"
 #include "mongo/util/container_size_helper.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 
@@ -59,8 +63,31 @@ struct PlanSummaryStats {
         collectionScansNonTailable += statsIn.collectionScansNonTailable;
         hasSortStage |= statsIn.hasSortStage;
         usedDisk |= statsIn.usedDisk;
+        spilledBytes += statsIn.spilledBytes;
+        spillTimeMicros += statsIn.spillTimeMicros;
         planFailed |= statsIn.planFailed;
         indexesUsed.insert(statsIn.indexesUsed.begin(), statsIn.indexesUsed.end());
+        if (!statsIn.stageExecutionSummary.empty()) {
+            if (!stageExecutionSummary.empty()) {
+                stageExecutionSummary += ';';
+            }
+            stageExecutionSummary += statsIn.stageExecutionSummary;
+        }
+    }
+
+    /**
+     * Adds one stage to 'stageExecutionSummary'.
+     */
+    void appendStageExecutionStats(StringData stageType,
+                                   long long executionTimeNanos,
+                                   boost::optional<uint64_t> peakTrackedMemBytes) {
+        if (!stageExecutionSummary.empty()) {
+            stageExecutionSummary += ',';
+        }
+        stageExecutionSummary += str::stream() << stageType << ':' << executionTimeNanos << "ns";
+        if (peakTrackedMemBytes) {
+            stageExecutionSummary += str::stream() << ':' << *peakTrackedMemBytes << 'B';
+        }
     }
 
     uint64_t estimateObjectSizeInBytes() const {
@@ -71,7 +98,7 @@ struct PlanSummaryStats {
         return sizeof(*this) +
             container_size_helper::estimateObjectSizeInBytes(
                    indexesUsed, strSize, false /* includeShallowSize */) +
-            (replanReason ? strSize(*replanReason) : 0);
+            (replanReason ? strSize(*replanReason) : 0) + strSize(stageExecutionSummary);
     }
 
     // The number of results returned by the plan.
@@ -100,6 +127,11 @@ struct PlanSummaryStats {
     // Did this plan use disk space?
     bool usedDisk = false;
 
+    // The number of bytes that blocking stages of this plan spilled to disk, and the time they
+    // spent writing them.
+    uint64_t spilledBytes = 0;
+    uint64_t spillTimeMicros = 0;
+
     // Did this plan failed during execution?
     bool planFailed = false;
 
@@ -113,6 +145,11 @@ struct PlanSummaryStats {
     // Was a replan triggered during the execution of this query?
     std::optional<std::string> replanReason;
 
+    // The time spent in each stage of the plan, and the peak memory of the stages that track it,
+    // as comma separated "<stage>:<nanos>ns[:<bytes>B]" entries in pre-order. Only set when
+    // 'internalQueryCollectStageExecutionStats' is enabled.
+    std::string stageExecutionSummary;
+
     // Score calculated for the plan by PlanRanker. Only set if there were multiple candidate plans
     // and allPlansExecution verbosity mode is selected.
     boost::optional<double> score;
@@ -32,12 +32,22 @@
 #include "mongo/db/query/plan_yield_policy.h"
 
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/util/clock_source.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
+namespace {
+
+Counter64 yieldsSkippedCounter;
+ServerStatusMetricField<Counter64> yieldsSkippedMetric("query.yieldsSkipped",
+                                                       &yieldsSkippedCounter);
+
+}  // namespace
 
 PlanYieldPolicy::PlanYieldPolicy(YieldPolicy policy,
                                  ClockSource* cs,
@@ -48,7 +58,9 @@ PlanYieldPolicy::PlanYieldPolicy(YieldPolicy policy,
     : _policy(policy),
       _yieldable(yieldable),
       _callbacks(std::move(callbacks)),
-      _elapsedTracker(cs, yieldIterations, yieldPeriod) {}
+      _clockSource(cs),
+      _elapsedTracker(cs, yieldIterations, yieldPeriod),
+      _lastYield(cs->now()) {}
 
 bool PlanYieldPolicy::shouldYieldOrInterrupt(OperationContext* opCtx) {
     if (_policy == YieldPolicy::INTERRUPT_ONLY) {
@@ -85,7 +97,12 @@ Status PlanYieldPolicy::yieldOrInterrupt(OperationContext* opCtx,
     // again right away. We delay the resetTimer() call so that the clock doesn't start ticking
     // until after we return from the yield.
     ON_BLOCK_EXIT([this]() { resetTimer(); });
+    if (!_forceYield && canSkipYield(opCtx)) {
+        yieldsSkippedCounter.increment();
+        return opCtx->checkForInterruptNoAssert();
+    }
     _forceYield = false;
+    _lastYield = _clockSource->now();
 
     for (int attempt = 1; true; attempt++) {
         try {
@@ -126,6 +143,17 @@ Status PlanYieldPolicy::yieldOrInterrupt(OperationContext* opCtx,
     MONGO_UNREACHABLE;
 }
 
+bool PlanYieldPolicy::canSkipYield(OperationContext* opCtx) const {
+    if (!internalQueryExecYieldOnlyOnContention.load()) {
+        return false;
+    }
+    if (_clockSource->now() - _lastYield >=
+        Milliseconds(internalQueryExecMaxYieldSkipPeriodMS.load())) {
+        return false;
+    }
+    return !opCtx->lockState()->hasWaitersForHeldResources();
+}
+
 void PlanYieldPolicy::performYield(OperationContext* opCtx,
                                    const Yieldable* yieldable,
                                    std::function<void()> whileYieldingFn) {
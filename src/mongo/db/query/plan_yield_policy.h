@@ -294,12 +294,23 @@ private:
                       const Yieldable* yieldable,
                       std::function<void()> whileYieldingFn);
 
+    /**
+     * Returns true if a yield which is due can be skipped because no other operation is waiting
+     * on the locks or ticket held by this operation, and the storage snapshot has not been held
+     * for longer than 'internalQueryExecMaxYieldSkipPeriodMS'.
+     */
+    bool canSkipYield(OperationContext* opCtx) const;
+
     const YieldPolicy _policy;
     const Yieldable* _yieldable;
     std::unique_ptr<const YieldPolicyCallbacks> _callbacks;
 
     bool _forceYield = false;
+    ClockSource* const _clockSource;
     ElapsedTracker _elapsedTracker;
+
+    // The last time this policy actually released its locks or storage snapshot.
+    Date_t _lastYield;
 };
 
 }  // namespace mongo
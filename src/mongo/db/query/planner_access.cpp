@@ -1617,6 +1617,93 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::scanWholeIndex(
     return solnRoot;
 }
 
+std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::scanIndexSkippingLeadingField(
+    const IndexEntry& index, const CanonicalQuery& query, const QueryPlannerParams& params) {
+    if (index.type != INDEX_BTREE || index.sparse || index.filterExpr ||
+        index.keyPattern.nFields() < 2 ||
+        !CollatorInterface::collatorsMatch(index.collator, query.getCollator())) {
+        return nullptr;
+    }
+
+    // Only the top-level conjuncts of the query may contribute index bounds.
+    std::vector<const MatchExpression*> predicates;
+    const MatchExpression* root = query.root();
+    if (MatchExpression::AND == root->matchType()) {
+        for (size_t i = 0; i < root->numChildren(); ++i) {
+            predicates.push_back(root->getChild(i));
+        }
+    } else {
+        predicates.push_back(root);
+    }
+
+    auto canBoundField = [](const MatchExpression* expr) {
+        switch (expr->matchType()) {
+            case MatchExpression::EQ:
+            case MatchExpression::LT:
+            case MatchExpression::LTE:
+            case MatchExpression::GT:
+            case MatchExpression::GTE:
+            case MatchExpression::MATCH_IN:
+                return true;
+            default:
+                return false;
+        }
+    };
+
+    auto isn = std::make_unique<IndexScanNode>(index);
+    isn->addKeyMetadata = query.metadataDeps()[DocumentMetadataFields::kIndexKey];
+    isn->queryCollator = query.getCollator();
+    isn->bounds.fields.resize(index.keyPattern.nFields());
+
+    bool boundedAnyField = false;
+    size_t position = 0;
+    for (auto&& elt : index.keyPattern) {
+        OrderedIntervalList* oil = &isn->bounds.fields[position];
+        oil->name = elt.fieldName();
+
+        // Bounds from several predicates over a field can only be intersected if no document has
+        // an array along its path. Otherwise one predicate is used, and the filter does the rest.
+        const bool canIntersect = !index.multikey ||
+            (!index.multikeyPaths.empty() && index.multikeyPaths[position].empty());
+        bool bounded = false;
+        for (auto&& pred : predicates) {
+            if (pred->path() != elt.fieldNameStringData()) {
+                continue;
+            }
+            if (0 == position) {
+                return nullptr;
+            }
+            if (!canBoundField(pred)) {
+                continue;
+            }
+
+            IndexBoundsBuilder::BoundsTightness tightness;
+            if (!bounded) {
+                IndexBoundsBuilder::translate(pred, elt, index, oil, &tightness);
+                bounded = true;
+            } else if (canIntersect) {
+                IndexBoundsBuilder::translateAndIntersect(pred, elt, index, oil, &tightness);
+            }
+        }
+
+        if (!bounded) {
+            IndexBoundsBuilder::allValuesForField(elt, oil);
+        }
+        boundedAnyField = boundedAnyField || bounded;
+        ++position;
+    }
+
+    if (!boundedAnyField) {
+        return nullptr;
+    }
+    IndexBoundsBuilder::alignBounds(&isn->bounds, index.keyPattern);
+
+    auto fetch = std::make_unique<FetchNode>();
+    fetch->filter = query.root()->shallowClone();
+    fetch->children.push_back(isn.release());
+    return fetch;
+}
+
 void QueryPlannerAccess::addFilterToSolutionNode(QuerySolutionNode* node,
                                                  std::unique_ptr<MatchExpression> match,
                                                  MatchExpression::MatchType type) {
@@ -112,6 +112,19 @@ public:
                                                              const QueryPlannerParams& params,
                                                              int direction = 1);
 
+    /**
+     * Return a plan that scans 'index' with all values of its leading field, and with bounds on
+     * the trailing fields taken from the top-level predicates of 'query' over them. The index scan
+     * skips from each value of the leading field to the next one whose trailing fields may be in
+     * bounds, so when the leading field has few distinct values it reads far fewer keys than a
+     * full scan. The whole query is applied as a filter to the fetched documents.
+     *
+     * Returns nullptr if 'index' is not a plain btree index, if the query constrains its leading
+     * field (normal planning handles that case), or if no trailing field could be bounded.
+     */
+    static std::unique_ptr<QuerySolutionNode> scanIndexSkippingLeadingField(
+        const IndexEntry& index, const CanonicalQuery& query, const QueryPlannerParams& params);
+
     /**
      * Return a plan that scans the provided index from [startKey to endKey).
      */
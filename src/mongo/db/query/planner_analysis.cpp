@@ -37,9 +37,11 @@
 #include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/index/expression_params.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/s2_common.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_geo.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/logv2/log.h"
@@ -309,6 +311,47 @@ void replaceNodeInTree(QuerySolutionNode** root,
     }
 }
 
+/**
+ * Returns true if 'node' is a FETCH over a scan of at least 'internalQueryBatchedIdLookupMinKeys'
+ * points of the _id index, which a BATCHED_ID_LOOKUP can perform instead.
+ */
+bool isBatchableIdLookup(const QuerySolutionNode* node) {
+    const auto minKeys = internalQueryBatchedIdLookupMinKeys.load();
+    if (minKeys <= 0 || !isFetchNodeWithIndexScanChild(node)) {
+        return false;
+    }
+
+    auto ixn = static_cast<const IndexScanNode*>(node->children[0]);
+    if (ixn->index.type != INDEX_BTREE ||
+        !IndexDescriptor::isIdIndexPattern(ixn->index.keyPattern) || ixn->filter ||
+        ixn->addKeyMetadata || ixn->bounds.isSimpleRange) {
+        return false;
+    }
+
+    const auto& oil = ixn->bounds.fields[0];
+    return oil.intervals.size() >= static_cast<size_t>(minKeys) && isUnionOfPoints(oil);
+}
+
+/**
+ * Replaces every FETCH in the tree '*root' which looks up many _id values through the _id index
+ * with a BATCHED_ID_LOOKUP. The documents are then returned in record id order, so this is only
+ * valid if nothing above the FETCH depends on the order of the index scan.
+ */
+void batchIdLookups(QuerySolutionNode** root) {
+    if (isBatchableIdLookup(*root)) {
+        auto batchedLookup = new BatchedIdLookupNode();
+        batchedLookup->filter = std::move((*root)->filter);
+        batchedLookup->children.swap((*root)->children);
+        delete *root;
+        *root = batchedLookup;
+        return;
+    }
+
+    for (auto&& child : (*root)->children) {
+        batchIdLookups(&child);
+    }
+}
+
 void geoSkipValidationOn(const std::set<StringData>& twoDSphereFields,
                          QuerySolutionNode* solnRoot) {
     // If there is a GeoMatchExpression in the tree on a field with a 2dsphere index,
@@ -956,6 +999,19 @@ std::unique_ptr<QuerySolution> QueryPlannerAnalysis::analyzeDataAccess(
 
     solnRoot = tryPushdownProjectBeneathSort(std::move(solnRoot));
 
+    // Without a requested sort, the documents of a large number of _id values can be fetched in
+    // record id order, which is closer to the order they are stored in.
+    if (findCommand.getSort().isEmpty()) {
+        QuerySolutionNode* root = solnRoot.release();
+        batchIdLookups(&root);
+        solnRoot.reset(root);
+
+        if (solnRoot->hasNode(STAGE_BATCHED_ID_LOOKUP)) {
+            solnRoot->computeProperties();
+            soln->hasBlockingStage = true;
+        }
+    }
+
     soln->setRoot(std::move(solnRoot));
     return soln;
 }
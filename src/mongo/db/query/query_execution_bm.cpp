@@ -0,0 +1,273 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <set>
+
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/op_observer_registry.h"
+#include "mongo/db/query/cursor_response.h"
+#include "mongo/db/query/getmore_command_gen.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/service_context_d_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Benchmarks find and aggregate end to end: command parsing, canonicalization, planning,
+ * execution in either the classic or the slot based engine, and reply building, all driven through
+ * DBDirectClient against a WiredTiger storage engine in a temporary directory.
+ *
+ * Every benchmark takes two arguments: the number of documents in the collection it queries, and
+ * whether the slot based execution engine is enabled. Running the suite once therefore shows the
+ * classic and SBE numbers for each query side by side.
+ */
+
+constexpr auto kDbName = "query_execution_bm"_sd;
+constexpr int64_t kDatasetSizes[] = {1'000, 100'000};
+
+/**
+ * A standalone mongod with a single client, kept alive for the whole benchmark run so that each
+ * dataset is loaded only once.
+ */
+class QueryExecutionFixture : public ServiceContextMongoDTest {
+public:
+    QueryExecutionFixture() : ServiceContextMongoDTest("wiredTiger") {
+        // (Generic FCV reference): Initialize FCV.
+        serverGlobalParams.mutableFeatureCompatibility.setVersion(
+            ServerGlobalParams::FeatureCompatibility::kLatest);
+
+        auto service = getServiceContext();
+        service->setOpObserver(std::make_unique<OpObserverRegistry>());
+        repl::ReplicationCoordinator::set(
+            service,
+            std::make_unique<repl::ReplicationCoordinatorMock>(service, repl::ReplSettings()));
+
+        _opCtx = makeOperationContext();
+    }
+
+    ~QueryExecutionFixture() {
+        _opCtx.reset();
+        tearDown();
+    }
+
+    OperationContext* opCtx() {
+        return _opCtx.get();
+    }
+
+    /**
+     * Returns the name of the collection holding 'numDocs' documents, loading it on first use.
+     *
+     * Documents have the shape
+     *   {_id: i, a: <i % 1000>, b: <random int>, c: "str<i % 100>", d: {e: <i % 10>, f: [..]}}
+     * with an index on 'a'.
+     */
+    std::string loadDataset(int64_t numDocs) {
+        auto collName = "docs_" + std::to_string(numDocs);
+        NamespaceString nss(kDbName, collName);
+        if (_loaded.count(numDocs)) {
+            return collName;
+        }
+
+        DBDirectClient client(opCtx());
+        client.createIndex(nss.ns(), BSON("a" << 1));
+
+        std::mt19937_64 gen(numDocs);
+        std::uniform_int_distribution<int> bDist(0, 1'000'000);
+        constexpr int64_t kInsertBatchSize = 1'000;
+        std::vector<BSONObj> batch;
+        for (int64_t i = 0; i < numDocs; ++i) {
+            auto d = BSON("e" << i % 10 << "f" << BSON_ARRAY(i % 7 << i % 11));
+            batch.push_back(BSON("_id" << i << "a" << i % 1000 << "b" << bDist(gen) << "c"
+                                       << ("str" + std::to_string(i % 100)) << "d" << d));
+            if (static_cast<int64_t>(batch.size()) == kInsertBatchSize || i == numDocs - 1) {
+                auto reply = client.insertAcknowledged(nss.ns(), batch);
+                uassertStatusOK(getStatusFromWriteCommandReply(reply));
+                batch.clear();
+            }
+        }
+
+        _loaded.insert(numDocs);
+        return collName;
+    }
+
+    /**
+     * Runs a cursor-generating command, draining the cursor with getMores, and returns the number
+     * of documents it produced.
+     */
+    size_t runQuery(const BSONObj& cmdObj) {
+        DBDirectClient client(opCtx());
+        BSONObj reply;
+        client.runCommand(kDbName.toString(), cmdObj, reply);
+        auto response = uassertStatusOK(CursorResponse::parseFromBSON(reply));
+
+        auto numDocs = response.getBatch().size();
+        auto cursorId = response.getCursorId();
+        while (cursorId != 0) {
+            GetMoreCommandRequest getMore(cursorId, response.getNSS().coll().toString());
+            client.runCommand(kDbName.toString(), getMore.toBSON({}), reply);
+            response = uassertStatusOK(CursorResponse::parseFromBSON(reply));
+            numDocs += response.getBatch().size();
+            cursorId = response.getCursorId();
+        }
+        return numDocs;
+    }
+
+private:
+    ServiceContext::UniqueOperationContext _opCtx;
+    std::set<int64_t> _loaded;
+};
+
+QueryExecutionFixture& getFixture() {
+    static QueryExecutionFixture fixture;
+    return fixture;
+}
+
+/**
+ * Runs the command built by 'makeCommand' for the collection named by the benchmark arguments,
+ * reporting queries per second and documents returned per second.
+ */
+template <typename MakeCommand>
+void runQueryBenchmark(benchmark::State& state, MakeCommand makeCommand) {
+    auto& fixture = getFixture();
+    auto collName = fixture.loadDataset(state.range(0));
+    RAIIServerParameterControllerForTest engine("internalQueryEnableSlotBasedExecutionEngine",
+                                                static_cast<bool>(state.range(1)));
+    auto cmdObj = makeCommand(collName);
+
+    size_t docsReturned = 0;
+    for (auto _ : state) {
+        docsReturned += fixture.runQuery(cmdObj);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["docsReturned"] =
+        benchmark::Counter(static_cast<double>(docsReturned), benchmark::Counter::kIsRate);
+}
+
+void BM_FindById(benchmark::State& state) {
+    runQueryBenchmark(state, [&](const std::string& coll) {
+        return BSON("find" << coll << "filter" << BSON("_id" << state.range(0) / 2));
+    });
+}
+
+void BM_FindIndexedEquality(benchmark::State& state) {
+    runQueryBenchmark(state, [](const std::string& coll) {
+        return BSON("find" << coll << "filter" << BSON("a" << 7));
+    });
+}
+
+void BM_FindIndexedRange(benchmark::State& state) {
+    runQueryBenchmark(state, [](const std::string& coll) {
+        return BSON("find" << coll << "filter" << BSON("a" << BSON("$gte" << 100 << "$lt" << 200)));
+    });
+}
+
+void BM_FindCollScanFilter(benchmark::State& state) {
+    runQueryBenchmark(state, [](const std::string& coll) {
+        return BSON("find" << coll << "filter" << BSON("b" << BSON("$lt" << 10'000)));
+    });
+}
+
+void BM_FindSortLimit(benchmark::State& state) {
+    runQueryBenchmark(state, [](const std::string& coll) {
+        return BSON("find" << coll << "filter" << BSONObj() << "sort" << BSON("b" << 1) << "limit"
+                           << 10);
+    });
+}
+
+void BM_FindProjection(benchmark::State& state) {
+    runQueryBenchmark(state, [](const std::string& coll) {
+        return BSON("find" << coll << "filter" << BSON("d.e" << 3) << "projection"
+                           << BSON("_id" << 0 << "a" << 1 << "c" << 1));
+    });
+}
+
+void BM_AggregateMatchGroup(benchmark::State& state) {
+    runQueryBenchmark(state, [](const std::string& coll) {
+        return BSON("aggregate" << coll << "pipeline"
+                                << BSON_ARRAY(BSON("$match" << BSON("a" << BSON("$lt" << 500)))
+                                              << BSON("$group" << BSON("_id"
+                                                                       << "$d.e"
+                                                                       << "total"
+                                                                       << BSON("$sum"
+                                                                               << "$b"))))
+                                << "cursor" << BSONObj());
+    });
+}
+
+void BM_AggregateMatchSortLimit(benchmark::State& state) {
+    runQueryBenchmark(state, [](const std::string& coll) {
+        return BSON("aggregate" << coll << "pipeline"
+                                << BSON_ARRAY(BSON("$match" << BSON("c"
+                                                                    << "str5"))
+                                              << BSON("$sort" << BSON("b" << -1))
+                                              << BSON("$limit" << 20))
+                                << "cursor" << BSONObj());
+    });
+}
+
+void BM_AggregateProjectExpression(benchmark::State& state) {
+    runQueryBenchmark(state, [](const std::string& coll) {
+        return BSON("aggregate" << coll << "pipeline"
+                                << BSON_ARRAY(BSON("$match" << BSON("d.e" << 3))
+                                              << BSON("$project" << BSON(
+                                                          "sum" << BSON("$add" << BSON_ARRAY(
+                                                                            "$a"
+                                                                            << "$b")))))
+                                << "cursor" << BSONObj());
+    });
+}
+
+void QueryArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"docs", "sbe"});
+    for (auto numDocs : kDatasetSizes) {
+        b->Args({numDocs, 0});
+        b->Args({numDocs, 1});
+    }
+}
+
+BENCHMARK(BM_FindById)->Apply(QueryArgs);
+BENCHMARK(BM_FindIndexedEquality)->Apply(QueryArgs);
+BENCHMARK(BM_FindIndexedRange)->Apply(QueryArgs);
+BENCHMARK(BM_FindCollScanFilter)->Apply(QueryArgs);
+BENCHMARK(BM_FindSortLimit)->Apply(QueryArgs);
+BENCHMARK(BM_FindProjection)->Apply(QueryArgs);
+BENCHMARK(BM_AggregateMatchGroup)->Apply(QueryArgs);
+BENCHMARK(BM_AggregateMatchSortLimit)->Apply(QueryArgs);
+BENCHMARK(BM_AggregateProjectExpression)->Apply(QueryArgs);
+
+}  // namespace
+}  // namespace mongo
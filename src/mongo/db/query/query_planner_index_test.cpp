@@ -33,6 +33,7 @@
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -1501,5 +1502,94 @@ TEST_F(QueryPlannerTest, PlansForWholeIndexScanWithSortAreGenerated) {
         "{proj: {spec: {'b': 1, _id: 0}, node: {fetch: {node: {ixscan: {pattern: {a: 1}}}}}}}");
 }
 
+TEST_F(QueryPlannerTest, SkipScanOverUnconstrainedLeadingField) {
+    RAIIServerParameterControllerForTest controller("internalQueryPlannerEnableSkipScan", true);
+    addIndex(BSON("a" << 1 << "b" << 1));
+
+    runQuery(fromjson("{b: 5}"));
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {b: 5}}}");
+    assertSolutionExists(
+        "{fetch: {filter: {b: 5}, node: {ixscan: {pattern: {a: 1, b: 1}, bounds: "
+        "{a: [['MinKey', 'MaxKey', true, true]], b: [[5, 5, true, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanIntersectsAndAlignsTrailingFieldBounds) {
+    RAIIServerParameterControllerForTest controller("internalQueryPlannerEnableSkipScan", true);
+    addIndex(BSON("a" << 1 << "b" << 1 << "c" << -1));
+
+    runQuery(fromjson("{b: {$gt: 1, $lt: 5}, c: {$in: [1, 2]}, d: 3}"));
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: {b: {$gt: 1, $lt: 5}, c: {$in: [1, 2]}, d: 3}, node: {ixscan: "
+        "{pattern: {a: 1, b: 1, c: -1}, bounds: {a: [['MinKey', 'MaxKey', true, true]], "
+        "b: [[1, 5, false, false]], c: [[2, 2, true, true], [1, 1, true, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, NoSkipScanWhenLeadingFieldIsConstrained) {
+    RAIIServerParameterControllerForTest controller("internalQueryPlannerEnableSkipScan", true);
+    addIndex(BSON("a" << 1 << "b" << 1));
+
+    runQuery(fromjson("{a: {$gt: 1}, b: 5}"));
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {a: 1, b: 1}, bounds: "
+        "{a: [[1, Infinity, false, true]], b: [[5, 5, true, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, NoSkipScanWhenDisabled) {
+    RAIIServerParameterControllerForTest controller("internalQueryPlannerEnableSkipScan", false);
+    addIndex(BSON("a" << 1 << "b" << 1));
+
+    runQuery(fromjson("{b: 5}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {b: 5}}}");
+}
+
+TEST_F(QueryPlannerTest, BatchedIdLookupForManyIdValues) {
+    RAIIServerParameterControllerForTest controller("internalQueryBatchedIdLookupMinKeys", 3);
+    addIndex(BSON("_id" << 1));
+
+    runQuery(fromjson("{_id: {$in: [3, 1, 2]}}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{batchedIdLookup: {filter: null, node: {ixscan: {pattern: {_id: 1}, bounds: {_id: "
+        "[[1, 1, true, true], [2, 2, true, true], [3, 3, true, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, BatchedIdLookupKeepsResidualFilter) {
+    RAIIServerParameterControllerForTest controller("internalQueryBatchedIdLookupMinKeys", 3);
+    addIndex(BSON("_id" << 1));
+
+    runQuery(fromjson("{_id: {$in: [1, 2, 3]}, a: 5}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{batchedIdLookup: {filter: {a: 5}, node: {ixscan: {pattern: {_id: 1}}}}}");
+}
+
+TEST_F(QueryPlannerTest, NoBatchedIdLookupForFewIdValues) {
+    RAIIServerParameterControllerForTest controller("internalQueryBatchedIdLookupMinKeys", 4);
+    addIndex(BSON("_id" << 1));
+
+    runQuery(fromjson("{_id: {$in: [1, 2, 3]}}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{fetch: {filter: null, node: {ixscan: {pattern: {_id: 1}}}}}");
+}
+
+TEST_F(QueryPlannerTest, NoBatchedIdLookupWhenSortedOrRanged) {
+    RAIIServerParameterControllerForTest controller("internalQueryBatchedIdLookupMinKeys", 2);
+    addIndex(BSON("_id" << 1));
+
+    runQuerySortProj(fromjson("{_id: {$in: [1, 2, 3]}}"), fromjson("{_id: 1}"), BSONObj());
+    assertNumSolutions(1U);
+    assertSolutionExists("{fetch: {filter: null, node: {ixscan: {pattern: {_id: 1}}}}}");
+
+    runQuery(fromjson("{_id: {$in: [1, 2, 3, /^a/]}}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{fetch: {node: {ixscan: {pattern: {_id: 1}}}}}");
+}
+
 }  // namespace
 }  // namespace mongo
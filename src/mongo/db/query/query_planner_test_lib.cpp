@@ -709,6 +709,44 @@ Status QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
         }
         return solutionMatches(child.Obj(), fn->children[0], relaxBoundsCheck)
             .withContext("mismatch beneath fetch node");
+    } else if (STAGE_BATCHED_ID_LOOKUP == trueSoln->getType()) {
+        BSONElement el = testSoln["batchedIdLookup"];
+        if (el.eoo() || !el.isABSONObj()) {
+            return {ErrorCodes::Error{6000144},
+                    "found a BATCHED_ID_LOOKUP stage in the solution but no corresponding "
+                    "'batchedIdLookup' object in the provided JSON"};
+        }
+        BSONObj lookupObj = el.Obj();
+        invariant(bsonObjFieldsAreInSet(lookupObj, {"filter", "node"}));
+
+        BSONElement filter = lookupObj["filter"];
+        if (!filter.eoo()) {
+            if (filter.isNull()) {
+                if (nullptr != trueSoln->filter) {
+                    return {ErrorCodes::Error{6000145},
+                            str::stream() << "Expected a batchedIdLookup stage without a filter, "
+                                             "but found a filter: "
+                                          << trueSoln->filter->toString()};
+                }
+            } else if (!filter.isABSONObj()) {
+                return {ErrorCodes::Error{6000146},
+                        str::stream() << "Provided JSON gave a 'batchedIdLookup' stage with a "
+                                         "'filter', but the filter was not an object."
+                                      << filter};
+            } else if (auto filterStatus = filterMatches(filter.Obj(), BSONObj(), trueSoln);
+                       !filterStatus.isOK()) {
+                return filterStatus.withContext("mismatching 'filter' for 'batchedIdLookup' node");
+            }
+        }
+
+        BSONElement child = lookupObj["node"];
+        if (child.eoo() || !child.isABSONObj()) {
+            return {ErrorCodes::Error{6000147},
+                    "found a batchedIdLookup stage in the solution but no 'node' sub-object in "
+                    "the provided JSON"};
+        }
+        return solutionMatches(child.Obj(), trueSoln->children[0], relaxBoundsCheck)
+            .withContext("mismatch beneath batchedIdLookup node");
     } else if (STAGE_OR == trueSoln->getType()) {
         const OrNode* orn = static_cast<const OrNode*>(trueSoln);
         BSONElement el = testSoln["or"];
@@ -0,0 +1,343 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_result_cache.h"
+
+#include <boost/algorithm/string/trim.hpp>
+
+#include "mongo/db/commands/server_status.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_result_cache_gen.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/service_context.h"
+#include "mongo/idl/command_generic_argument.h"
+#include "mongo/util/str.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+namespace {
+
+const auto getQueryResultCache = ServiceContext::declareDecoration<QueryResultCache>();
+
+// The namespaces parsed from 'queryResultCacheNamespaces'. The flag allows writes to skip the
+// lookup entirely while the cache is disabled.
+Mutex namespacesMutex = MONGO_MAKE_LATCH("QueryResultCache::namespacesMutex");
+StringSet enabledNamespaces;
+AtomicWord<bool> anyNamespaceEnabled{false};
+
+// The find command arguments which can affect the result, in the order they are appended to the
+// cache key so that the order in which the client sends them does not matter.
+const std::vector<StringData> kKeyFields{"filter"_sd,
+                                         "projection"_sd,
+                                         "sort"_sd,
+                                         "hint"_sd,
+                                         "skip"_sd,
+                                         "limit"_sd,
+                                         "batchSize"_sd,
+                                         "singleBatch"_sd,
+                                         "collation"_sd};
+
+// Generic arguments which make the result depend on more than the contents of the collection.
+const StringDataSet kIneligibleGenericArgs{"shardVersion"_sd, "databaseVersion"_sd};
+
+/**
+ * Returns true if 'obj' uses an operator whose result is not a function of the documents alone,
+ * or refers to a variable such as $$NOW.
+ */
+bool hasNonDeterministicOperator(const BSONObj& obj) {
+    static const StringDataSet kOperators{
+        "$where"_sd, "$function"_sd, "$accumulator"_sd, "$rand"_sd, "$sampleRate"_sd};
+    for (auto&& elem : obj) {
+        if (kOperators.contains(elem.fieldNameStringData())) {
+            return true;
+        }
+        if (elem.type() == String && elem.valueStringData().startsWith("$$")) {
+            return true;
+        }
+        if (elem.isABSONObj() && hasNonDeterministicOperator(elem.embeddedObject())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+boost::optional<repl::OpTime> getCommittedSnapshot(OperationContext* opCtx) {
+    const auto level = repl::ReadConcernArgs::get(opCtx).getLevel();
+    if (level != repl::ReadConcernLevel::kMajorityReadConcern) {
+        return boost::none;
+    }
+    return repl::ReplicationCoordinator::get(opCtx)->getCurrentCommittedSnapshotOpTime();
+}
+
+}  // namespace
+
+QueryResultCache& QueryResultCache::get(ServiceContext* service) {
+    return getQueryResultCache(service);
+}
+
+QueryResultCache& QueryResultCache::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+bool QueryResultCache::isEnabledFor(const NamespaceString& nss) {
+    if (!anyNamespaceEnabled.loadRelaxed()) {
+        return false;
+    }
+    stdx::lock_guard<Latch> lk(namespacesMutex);
+    return enabledNamespaces.contains(nss.ns());
+}
+
+Status QueryResultCache::onUpdateNamespaces(const std::string& namespaces) {
+    StringSet parsed;
+    std::vector<std::string> names;
+    str::splitStringDelim(namespaces, &names, ',');
+    for (auto& name : names) {
+        boost::algorithm::trim(name);
+        if (name.empty()) {
+            continue;
+        }
+        NamespaceString nss(name);
+        if (!nss.isValid() || nss.coll().empty()) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "Invalid namespace for the query result cache: " << name};
+        }
+        parsed.insert(nss.ns());
+    }
+
+    {
+        stdx::lock_guard<Latch> lk(namespacesMutex);
+        enabledNamespaces = std::move(parsed);
+        anyNamespaceEnabled.store(!enabledNamespaces.empty());
+    }
+
+    // Results of namespaces which are no longer listed would otherwise linger until evicted.
+    if (hasGlobalServiceContext()) {
+        get(getGlobalServiceContext()).clear();
+    }
+    return Status::OK();
+}
+
+boost::optional<QueryResultCache::Lookup> QueryResultCache::prepare(OperationContext* opCtx,
+                                                                    const NamespaceString& nss,
+                                                                    const BSONObj& cmdObj) const {
+    if (!_writesObserved.load() || !isEnabledFor(nss) || gQueryResultCacheMaxBytes.load() == 0 ||
+        opCtx->inMultiDocumentTransaction()) {
+        return boost::none;
+    }
+
+    // Snapshot and linearizable reads, as well as reads at a point in time, must not be answered
+    // with a result read at a different point in time.
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    const auto level = readConcernArgs.getLevel();
+    if ((level != repl::ReadConcernLevel::kLocalReadConcern &&
+         level != repl::ReadConcernLevel::kAvailableReadConcern &&
+         level != repl::ReadConcernLevel::kMajorityReadConcern) ||
+        readConcernArgs.getArgsAtClusterTime() || readConcernArgs.isSpeculativeMajority()) {
+        return boost::none;
+    }
+
+    // The collection must be named rather than identified by UUID, since the cache is keyed and
+    // invalidated by namespace.
+    if (cmdObj.firstElement().type() != String) {
+        return boost::none;
+    }
+
+    for (auto&& elem : cmdObj) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (fieldName == cmdObj.firstElementFieldNameStringData()) {
+            continue;
+        }
+        if (isGenericArgument(fieldName)) {
+            if (kIneligibleGenericArgs.contains(fieldName)) {
+                return boost::none;
+            }
+            continue;
+        }
+        if (std::find(kKeyFields.begin(), kKeyFields.end(), fieldName) == kKeyFields.end()) {
+            return boost::none;
+        }
+    }
+
+    for (auto&& fieldName : {"filter"_sd, "projection"_sd}) {
+        auto elem = cmdObj[fieldName];
+        if (elem.isABSONObj() && hasNonDeterministicOperator(elem.embeddedObject())) {
+            return boost::none;
+        }
+    }
+
+    BSONObjBuilder keyBuilder;
+    keyBuilder.append("ns", nss.ns());
+    keyBuilder.append("level", repl::readConcernLevels::toString(level));
+    for (auto&& fieldName : kKeyFields) {
+        if (auto elem = cmdObj[fieldName]) {
+            keyBuilder.append(elem);
+        }
+    }
+    auto key = keyBuilder.done();
+
+    Lookup lookup;
+    lookup.nss = nss;
+    lookup.key.assign(key.objdata(), key.objsize());
+    lookup.epoch = _epoch.load();
+    lookup.committedSnapshot = getCommittedSnapshot(opCtx);
+    return lookup;
+}
+
+boost::optional<BSONObj> QueryResultCache::find(OperationContext* opCtx, const Lookup& lookup) {
+    const auto committedSnapshot = getCommittedSnapshot(opCtx);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _entries.find(lookup.key);
+    if (it == _entries.end()) {
+        _misses.fetchAndAddRelaxed(1);
+        return boost::none;
+    }
+
+    // The committed snapshot only moves forward, so a majority result read at an older one can
+    // never be returned again.
+    if (it->second.committedSnapshot != committedSnapshot) {
+        _erase(lk, it);
+        _misses.fetchAndAddRelaxed(1);
+        return boost::none;
+    }
+
+    _hits.fetchAndAddRelaxed(1);
+    return it->second.firstBatch;
+}
+
+void QueryResultCache::insert(OperationContext* opCtx,
+                              const Lookup& lookup,
+                              const BSONObj& firstBatch) {
+    const auto committedSnapshot = getCommittedSnapshot(opCtx);
+    if (committedSnapshot != lookup.committedSnapshot) {
+        return;
+    }
+
+    Entry entry;
+    entry.nss = lookup.nss;
+    entry.firstBatch = firstBatch.getOwned();
+    entry.committedSnapshot = committedSnapshot;
+    entry.bytes = lookup.key.size() + entry.firstBatch.objsize();
+
+    const auto maxBytes = static_cast<size_t>(gQueryResultCacheMaxBytes.load());
+    if (entry.bytes > maxBytes) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    // Checked under the mutex, which invalidation also takes after advancing the epoch, so that a
+    // result read before a write cannot be inserted after the write invalidated the namespace.
+    if (_epoch.load() != lookup.epoch) {
+        return;
+    }
+
+    if (auto it = _entries.find(lookup.key); it != _entries.end()) {
+        _erase(lk, it);
+    }
+
+    _bytes += entry.bytes;
+    _entries.add(lookup.key, std::move(entry));
+    _inserts.fetchAndAddRelaxed(1);
+
+    while (_bytes > maxBytes && !_entries.empty()) {
+        _erase(lk, std::prev(_entries.end()));
+        _evictions.fetchAndAddRelaxed(1);
+    }
+}
+
+template <typename Predicate>
+void QueryResultCache::_invalidateIf(Predicate pred) {
+    _epoch.fetchAndAdd(1);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        if (pred(it->second.nss)) {
+            it = _erase(lk, it);
+            _invalidations.fetchAndAddRelaxed(1);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void QueryResultCache::invalidate(const NamespaceString& nss) {
+    _invalidateIf([&](const NamespaceString& entryNss) { return entryNss == nss; });
+}
+
+void QueryResultCache::invalidateDatabase(StringData dbName) {
+    _invalidateIf([&](const NamespaceString& entryNss) { return entryNss.db() == dbName; });
+}
+
+void QueryResultCache::clear() {
+    _epoch.fetchAndAdd(1);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    _entries.clear();
+    _bytes = 0;
+}
+
+QueryResultCache::EntryMap::iterator QueryResultCache::_erase(WithLock, EntryMap::iterator it) {
+    _bytes -= it->second.bytes;
+    return _entries.erase(it);
+}
+
+void QueryResultCache::appendStats(BSONObjBuilder* builder) const {
+    builder->append("hits", _hits.load());
+    builder->append("misses", _misses.load());
+    builder->append("inserts", _inserts.load());
+    builder->append("invalidations", _invalidations.load());
+    builder->append("evictions", _evictions.load());
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    builder->appendNumber("entries", static_cast<long long>(_entries.size()));
+    builder->appendNumber("bytes", static_cast<long long>(_bytes));
+}
+
+namespace {
+
+class QueryResultCacheServerStatusSection final : public ServerStatusSection {
+public:
+    QueryResultCacheServerStatusSection() : ServerStatusSection("queryResultCache") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElem) const override {
+        BSONObjBuilder builder;
+        QueryResultCache::get(opCtx).appendStats(&builder);
+        return builder.obj();
+    }
+} queryResultCacheServerStatusSection;
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,166 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <limits>
+#include <string>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/repl/optime.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Caches the complete result of find commands against the namespaces listed in the
+ * 'queryResultCacheNamespaces' server parameter, so that identical finds against collections which
+ * are read far more often than they are written can be answered without planning or executing the
+ * query.
+ *
+ * Only finds whose result fits in the first batch are cached. Entries are keyed by the namespace,
+ * the read concern level and every command argument which can affect the result. Any write to a
+ * cached namespace, observed through QueryResultCacheOpObserver, removes all of its entries. A
+ * result produced by a find which was concurrent with such a write is never inserted: every
+ * invalidation advances an epoch, which is captured before the find opens its storage snapshot and
+ * compared again before the result is inserted.
+ *
+ * Results read at majority read concern are additionally tagged with the committed snapshot they
+ * were read at, and are only returned while that is still the current committed snapshot.
+ *
+ * The total size of the cached results is bounded by 'queryResultCacheMaxBytes'; the least
+ * recently used results are evicted first.
+ *
+ * This class is thread-safe.
+ */
+class QueryResultCache {
+public:
+    /**
+     * Describes a find which is eligible for caching. Obtained from prepare() before the find
+     * acquires its locks and storage snapshot.
+     */
+    struct Lookup {
+        NamespaceString nss;
+        std::string key;
+        uint64_t epoch = 0;
+        boost::optional<repl::OpTime> committedSnapshot;
+    };
+
+    static QueryResultCache& get(ServiceContext* service);
+    static QueryResultCache& get(OperationContext* opCtx);
+
+    /**
+     * Returns true if results of finds against 'nss' may be cached. Cheap enough to be called on
+     * every write.
+     */
+    static bool isEnabledFor(const NamespaceString& nss);
+
+    /**
+     * Called when 'queryResultCacheNamespaces' is set.
+     */
+    static Status onUpdateNamespaces(const std::string& namespaces);
+
+    /**
+     * Called once an OpObserver which invalidates this cache has been registered. Until then the
+     * cache is never used, since writes would not invalidate it.
+     */
+    void setWritesObserved() {
+        _writesObserved.store(true);
+    }
+
+    /**
+     * Returns a Lookup if the find command 'cmdObj' against 'nss' may be answered from, and its
+     * result stored in, the cache. Must be called before the find opens its storage snapshot.
+     */
+    boost::optional<Lookup> prepare(OperationContext* opCtx,
+                                    const NamespaceString& nss,
+                                    const BSONObj& cmdObj) const;
+
+    /**
+     * Returns the first batch cached for 'lookup', if any. The returned array is owned.
+     */
+    boost::optional<BSONObj> find(OperationContext* opCtx, const Lookup& lookup);
+
+    /**
+     * Caches 'firstBatch' as the complete result for 'lookup', unless a write to a cached
+     * namespace has been observed, or the committed snapshot has moved, since prepare() was called.
+     */
+    void insert(OperationContext* opCtx, const Lookup& lookup, const BSONObj& firstBatch);
+
+    /**
+     * Removes the entries of 'nss', or of every collection in 'dbName', and prevents the results
+     * of finds prepared before the call from being inserted.
+     */
+    void invalidate(const NamespaceString& nss);
+    void invalidateDatabase(StringData dbName);
+
+    /**
+     * Removes all entries.
+     */
+    void clear();
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    struct Entry {
+        NamespaceString nss;
+        BSONObj firstBatch;
+        boost::optional<repl::OpTime> committedSnapshot;
+        size_t bytes = 0;
+    };
+
+    using EntryMap = LRUCache<std::string, Entry>;
+
+    template <typename Predicate>
+    void _invalidateIf(Predicate pred);
+
+    EntryMap::iterator _erase(WithLock, EntryMap::iterator it);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("QueryResultCache::_mutex");
+    EntryMap _entries{std::numeric_limits<size_t>::max()};
+    size_t _bytes = 0;
+
+    AtomicWord<bool> _writesObserved{false};
+    AtomicWord<uint64_t> _epoch{0};
+
+    AtomicWord<long long> _hits{0};
+    AtomicWord<long long> _misses{0};
+    AtomicWord<long long> _inserts{0};
+    AtomicWord<long long> _invalidations{0};
+    AtomicWord<long long> _evictions{0};
+};
+
+}  // namespace mongo
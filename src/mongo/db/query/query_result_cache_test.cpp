@@ -0,0 +1,185 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_result_cache.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/query/query_result_cache_gen.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.coll");
+
+class QueryResultCacheTest : public ServiceContextTest {
+public:
+    void setUp() override {
+        ASSERT_OK(QueryResultCache::onUpdateNamespaces(kNss.ns()));
+        _cache.setWritesObserved();
+        _opCtx = makeOperationContext();
+    }
+
+    void tearDown() override {
+        ASSERT_OK(QueryResultCache::onUpdateNamespaces(""));
+        gQueryResultCacheMaxBytes.store(64 * 1024 * 1024);
+    }
+
+    boost::optional<QueryResultCache::Lookup> prepare(const std::string& cmdJson) {
+        return _cache.prepare(_opCtx.get(), kNss, fromjson(cmdJson));
+    }
+
+    BSONObj stats() const {
+        BSONObjBuilder builder;
+        _cache.appendStats(&builder);
+        return builder.obj();
+    }
+
+protected:
+    QueryResultCache _cache;
+    ServiceContext::UniqueOperationContext _opCtx;
+};
+
+TEST_F(QueryResultCacheTest, ReturnsInsertedResult) {
+    const auto batch = BSON_ARRAY(BSON("_id" << 1) << BSON("_id" << 2));
+
+    auto lookup = prepare("{find: 'coll', filter: {a: 1}}");
+    ASSERT(lookup);
+    ASSERT_FALSE(_cache.find(_opCtx.get(), *lookup));
+    _cache.insert(_opCtx.get(), *lookup, batch);
+
+    lookup = prepare("{find: 'coll', filter: {a: 1}}");
+    ASSERT(lookup);
+    auto cached = _cache.find(_opCtx.get(), *lookup);
+    ASSERT(cached);
+    ASSERT_BSONOBJ_EQ(*cached, batch);
+
+    auto s = stats();
+    ASSERT_EQ(s["hits"].numberLong(), 1);
+    ASSERT_EQ(s["misses"].numberLong(), 1);
+    ASSERT_EQ(s["inserts"].numberLong(), 1);
+    ASSERT_EQ(s["entries"].numberLong(), 1);
+}
+
+TEST_F(QueryResultCacheTest, KeyIgnoresArgumentOrderAndGenericArguments) {
+    auto first = prepare("{find: 'coll', filter: {a: 1}, sort: {b: 1}, comment: 'x'}");
+    auto second = prepare("{find: 'coll', sort: {b: 1}, filter: {a: 1}, maxTimeMS: 100}");
+    ASSERT(first);
+    ASSERT(second);
+    ASSERT_EQ(first->key, second->key);
+
+    auto other = prepare("{find: 'coll', filter: {a: 2}, sort: {b: 1}}");
+    ASSERT(other);
+    ASSERT_NE(first->key, other->key);
+}
+
+TEST_F(QueryResultCacheTest, IneligibleFinds) {
+    ASSERT_FALSE(prepare("{find: 'coll', filter: {a: 1}, tailable: true}"));
+    ASSERT_FALSE(prepare("{find: 'coll', filter: {a: 1}, let: {x: 1}}"));
+    ASSERT_FALSE(prepare("{find: 'coll', filter: {$where: 'true'}}"));
+    ASSERT_FALSE(prepare("{find: 'coll', filter: {$expr: {$lt: [{$rand: {}}, 0.5]}}}"));
+    ASSERT_FALSE(prepare("{find: 'coll', filter: {$expr: {$lt: ['$date', '$$NOW']}}}"));
+    ASSERT_FALSE(prepare("{find: 'coll', projection: {r: {$rand: {}}}}"));
+    ASSERT_FALSE(prepare("{find: 'coll', shardVersion: {}}"));
+    ASSERT_FALSE(_cache.prepare(
+        _opCtx.get(), NamespaceString("test.other"), fromjson("{find: 'other'}")));
+    ASSERT_FALSE(
+        _cache.prepare(_opCtx.get(), kNss, BSON("find" << UUID::gen() << "$db" << "test")));
+
+    repl::ReadConcernArgs::get(_opCtx.get()) =
+        repl::ReadConcernArgs(repl::ReadConcernLevel::kSnapshotReadConcern);
+    ASSERT_FALSE(prepare("{find: 'coll'}"));
+}
+
+TEST_F(QueryResultCacheTest, NotUsedUntilWritesAreObserved) {
+    QueryResultCache cache;
+    ASSERT_FALSE(cache.prepare(_opCtx.get(), kNss, fromjson("{find: 'coll'}")));
+}
+
+TEST_F(QueryResultCacheTest, InvalidationRemovesEntriesOfTheNamespace) {
+    auto lookup = prepare("{find: 'coll'}");
+    ASSERT(lookup);
+    _cache.insert(_opCtx.get(), *lookup, BSON_ARRAY(BSON("_id" << 1)));
+    ASSERT_EQ(stats()["entries"].numberLong(), 1);
+
+    _cache.invalidate(NamespaceString("test.other"));
+    ASSERT_EQ(stats()["entries"].numberLong(), 1);
+
+    _cache.invalidate(kNss);
+    ASSERT_EQ(stats()["entries"].numberLong(), 0);
+    ASSERT_EQ(stats()["invalidations"].numberLong(), 1);
+    ASSERT_FALSE(_cache.find(_opCtx.get(), *prepare("{find: 'coll'}")));
+}
+
+TEST_F(QueryResultCacheTest, ResultReadBeforeInvalidationIsNotInserted) {
+    auto lookup = prepare("{find: 'coll'}");
+    ASSERT(lookup);
+    _cache.invalidate(kNss);
+    _cache.insert(_opCtx.get(), *lookup, BSON_ARRAY(BSON("_id" << 1)));
+
+    ASSERT_EQ(stats()["inserts"].numberLong(), 0);
+    ASSERT_FALSE(_cache.find(_opCtx.get(), *prepare("{find: 'coll'}")));
+}
+
+TEST_F(QueryResultCacheTest, EvictsLeastRecentlyUsedResultsAboveMaxBytes) {
+    const auto batch = BSON_ARRAY(BSON("_id" << 1 << "pad" << std::string(100, 'x')));
+
+    auto first = prepare("{find: 'coll', filter: {a: 1}}");
+    _cache.insert(_opCtx.get(), *first, batch);
+    const auto entryBytes = stats()["bytes"].numberLong();
+    gQueryResultCacheMaxBytes.store(entryBytes * 2);
+
+    auto second = prepare("{find: 'coll', filter: {a: 2}}");
+    _cache.insert(_opCtx.get(), *second, batch);
+    ASSERT(_cache.find(_opCtx.get(), *first));
+
+    auto third = prepare("{find: 'coll', filter: {a: 3}}");
+    _cache.insert(_opCtx.get(), *third, batch);
+
+    ASSERT_EQ(stats()["evictions"].numberLong(), 1);
+    ASSERT_EQ(stats()["entries"].numberLong(), 2);
+    ASSERT(_cache.find(_opCtx.get(), *first));
+    ASSERT_FALSE(_cache.find(_opCtx.get(), *second));
+    ASSERT(_cache.find(_opCtx.get(), *third));
+}
+
+TEST_F(QueryResultCacheTest, RejectsInvalidNamespaces) {
+    ASSERT_EQ(QueryResultCache::onUpdateNamespaces("test").code(), ErrorCodes::BadValue);
+    ASSERT_OK(QueryResultCache::onUpdateNamespaces(" test.a , test.b "));
+    ASSERT(QueryResultCache::isEnabledFor(NamespaceString("test.a")));
+    ASSERT(QueryResultCache::isEnabledFor(NamespaceString("test.b")));
+    ASSERT_FALSE(QueryResultCache::isEnabledFor(kNss));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -469,6 +469,32 @@ QuerySolutionNode* FetchNode::clone() const {
     return copy;
 }
 
+//
+// BatchedIdLookupNode
+//
+
+void BatchedIdLookupNode::appendToString(str::stream* ss, int indent) const {
+    addIndent(ss, indent);
+    *ss << "BATCHED_ID_LOOKUP\n";
+    if (nullptr != filter) {
+        addIndent(ss, indent + 1);
+        StringBuilder sb;
+        *ss << "filter:\n";
+        filter->debugString(sb, indent + 2);
+        *ss << sb.str();
+    }
+    addCommon(ss, indent);
+    addIndent(ss, indent + 1);
+    *ss << "Child:" << '\n';
+    children[0]->appendToString(ss, indent + 2);
+}
+
+QuerySolutionNode* BatchedIdLookupNode::clone() const {
+    BatchedIdLookupNode* copy = new BatchedIdLookupNode();
+    cloneBaseData(copy);
+    return copy;
+}
+
 //
 // IndexScanNode
 //
@@ -345,7 +345,7 @@ public:
     /**
      * Output a human-readable std::string representing the plan.
      */
-    std::string toString() {
+    std::string toString() const {
         if (!_root) {
             return "empty query solution";
         }
@@ -644,6 +644,36 @@ struct FetchNode : public QuerySolutionNode {
     QuerySolutionNode* clone() const;
 };
 
+/**
+ * Fetches the documents found by its child, an index scan over many points of the _id index. All
+ * the record ids are read from the child and sorted before the first document is fetched, so the
+ * documents are returned in record id order rather than in _id order.
+ */
+struct BatchedIdLookupNode : public QuerySolutionNodeWithSortSet {
+    BatchedIdLookupNode() {}
+    BatchedIdLookupNode(std::unique_ptr<QuerySolutionNode> child)
+        : QuerySolutionNodeWithSortSet(std::move(child)) {}
+    virtual ~BatchedIdLookupNode() {}
+
+    virtual StageType getType() const {
+        return STAGE_BATCHED_ID_LOOKUP;
+    }
+
+    virtual void appendToString(str::stream* ss, int indent) const;
+
+    bool fetched() const {
+        return true;
+    }
+    FieldAvailability getFieldAvailability(const std::string& field) const {
+        return FieldAvailability::kFullyProvided;
+    }
+    bool sortedByDiskLoc() const {
+        return true;
+    }
+
+    QuerySolutionNode* clone() const;
+};
+
 struct IndexScanNode : public QuerySolutionNodeWithSortSet {
     IndexScanNode(IndexEntry index);
     virtual ~IndexScanNode() {}
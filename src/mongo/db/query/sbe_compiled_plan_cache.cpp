@@ -0,0 +1,185 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/sbe_compiled_plan_cache.h"
+
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/query/collection_query_info.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/sbe_stage_builder_helpers.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/str.h"
+
+namespace mongo::sbe {
+namespace {
+const auto getCompiledPlanCache = ServiceContext::declareDecoration<CompiledPlanCache>();
+
+Counter64 compiledPlanCacheHits;
+ServerStatusMetricField<Counter64> compiledPlanCacheHitsMetric("query.sbeCompiledPlanCache.hits",
+                                                               &compiledPlanCacheHits);
+
+Counter64 compiledPlanCacheMisses;
+ServerStatusMetricField<Counter64> compiledPlanCacheMissesMetric(
+    "query.sbeCompiledPlanCache.misses", &compiledPlanCacheMisses);
+
+void appendObj(StringBuilder* builder, const BSONObj& obj) {
+    // The binary encoding distinguishes literals which print the same, such as 1 and 1.0.
+    *builder << StringData{obj.objdata(), static_cast<size_t>(obj.objsize())} << '|';
+}
+
+/**
+ * Stores the values of the builtin variables of 'cq' into the slots of 'env' which were registered
+ * for them by makeRuntimeEnvironment(). Returns false if the variables of 'cq' do not map onto the
+ * slots of 'env'.
+ */
+bool bindBuiltinVariables(const CanonicalQuery& cq, RuntimeEnvironment* env) {
+    const auto& variables = cq.getExpCtx()->variables;
+    for (auto&& [id, name] : Variables::kIdToBuiltinVarName) {
+        if (id == Variables::kRootId || id == Variables::kRemoveId) {
+            continue;
+        }
+
+        auto slot = env->getSlotIfExists(name);
+        if (!variables.hasValue(id)) {
+            if (slot && id != Variables::kSearchMetaId) {
+                return false;
+            }
+            continue;
+        }
+        if (!slot) {
+            return false;
+        }
+
+        auto [tag, val] = stage_builder::makeValue(variables.getValue(id));
+        env->resetSlot(*slot, tag, val, true);
+    }
+    return true;
+}
+}  // namespace
+
+CompiledPlanCache& CompiledPlanCache::get(ServiceContext* serviceContext) {
+    return getCompiledPlanCache(serviceContext);
+}
+
+bool CompiledPlanCache::isEnabled() {
+    return internalQuerySBECompiledPlanCacheMaxEntries > 0;
+}
+
+boost::optional<std::string> CompiledPlanCache::computeKey(const CollectionPtr& collection,
+                                                           const CanonicalQuery& cq,
+                                                           const QuerySolution& solution) {
+    const auto& findCommand = cq.getFindCommandRequest();
+
+    // The collator and the 'let' variables are owned by the query and are referenced from the
+    // constants of the plan. Shard filters and text matchers are bound to the operation which
+    // built the plan, and parallel scans are built around the current parallelism degree.
+    if (cq.getCollator() || findCommand.getLet() ||
+        internalQuerySlotBasedExecutionParallelScanDegree.load() > 1 ||
+        solution.hasNode(STAGE_SHARDING_FILTER) || solution.hasNode(STAGE_TEXT_MATCH) ||
+        solution.hasNode(STAGE_TEXT_OR)) {
+        return boost::none;
+    }
+
+    StringBuilder builder;
+    builder << collection->uuid().toString() << '|'
+            << CollectionQueryInfo::get(collection).getPlanCache()->getEpoch() << '|';
+    appendObj(&builder, findCommand.getFilter());
+    appendObj(&builder, findCommand.getProjection());
+    appendObj(&builder, findCommand.getSort());
+    appendObj(&builder, findCommand.getMin());
+    appendObj(&builder, findCommand.getMax());
+    builder << findCommand.getReturnKey() << findCommand.getShowRecordId() << '|';
+
+    // The solution accounts for the indexes chosen by the plan cache entry and for everything the
+    // planner derived from the query, such as index bounds, limits and skips.
+    builder << solution.toString();
+    return builder.str();
+}
+
+TinyLFUKeyValue<std::string, CompiledPlanCache::Entry>* CompiledPlanCache::_getCache(WithLock) {
+    if (!_cache) {
+        const size_t maxEntries = internalQuerySBECompiledPlanCacheMaxEntries;
+        _cache = std::make_unique<TinyLFUKeyValue<std::string, Entry>>(maxEntries, maxEntries);
+    }
+    return _cache.get();
+}
+
+boost::optional<std::pair<std::unique_ptr<PlanStage>, stage_builder::PlanStageData>>
+CompiledPlanCache::lookup(const std::string& key, const CanonicalQuery& cq) {
+    std::shared_ptr<const CompiledPlan> plan;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        Entry* entry;
+        if (_getCache(lk)->get(key, &entry).isOK()) {
+            plan = entry->plan;
+        }
+    }
+
+    if (!plan) {
+        compiledPlanCacheMisses.increment();
+        return boost::none;
+    }
+
+    auto data = plan->data.makeCopy();
+    if (!bindBuiltinVariables(cq, data.env)) {
+        compiledPlanCacheMisses.increment();
+        return boost::none;
+    }
+
+    compiledPlanCacheHits.increment();
+    return {{plan->root->clone(), std::move(data)}};
+}
+
+void CompiledPlanCache::add(const std::string& key,
+                            const PlanStage& root,
+                            const stage_builder::PlanStageData& data) {
+    // Tailable and change stream plans keep track of positions in the runtime environment, which
+    // would carry over to the next operation using the plan.
+    if (data.shouldTrackLatestOplogTimestamp || data.shouldTrackResumeToken ||
+        data.shouldUseTailableScan) {
+        return;
+    }
+
+    auto plan = std::make_shared<CompiledPlan>(CompiledPlan{root.clone(), data.makeCopy()});
+
+    std::vector<std::unique_ptr<Entry>> evicted;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        evicted = _getCache(lk)->add(key, new Entry{std::move(plan)});
+    }
+    // The evicted plans, if no longer referenced by a lookup, are destroyed outside of the mutex.
+}
+
+size_t CompiledPlanCache::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _cache ? _cache->size() : 0;
+}
+}  // namespace mongo::sbe
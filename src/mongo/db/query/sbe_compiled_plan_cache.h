@@ -0,0 +1,124 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+#include <string>
+
+#include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/plan_yield_policy_sbe.h"
+#include "mongo/db/query/query_solution.h"
+#include "mongo/db/query/sbe_stage_builder.h"
+#include "mongo/db/query/tiny_lfu_key_value.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo {
+class ServiceContext;
+}  // namespace mongo
+
+namespace mongo::sbe {
+/**
+ * Keeps pristine clones of the SBE plan trees built for queries whose plan comes from the plan
+ * cache, so that the next run of the same query only needs to clone a tree rather than to build it
+ * from the QuerySolution again.
+ *
+ * The literals of a query are compiled into its SBE plan as constants, which is why a compiled
+ * plan can only be reused by a query with the same shape and the same literals. The state bound
+ * to a single operation, i.e. its yield policy, operation context and the values of the builtin
+ * variables held in the runtime environment, is rebound every time a plan is reused.
+ *
+ * Entries are keyed on the collection UUID and on the epoch of the collection's PlanCache, so an
+ * entry built before the indexes of the collection changed is never returned. Such entries are not
+ * removed eagerly, they age out of the cache like any entry which is not used anymore.
+ *
+ * This class is thread-safe.
+ */
+class CompiledPlanCache {
+public:
+    static CompiledPlanCache& get(ServiceContext* serviceContext);
+
+    /**
+     * Returns the key under which a plan built for 'cq' from 'solution' is cached, or boost::none
+     * if such a plan depends on the operation which built it in ways which cannot be rebound, in
+     * which case it must not be cached.
+     */
+    static boost::optional<std::string> computeKey(const CollectionPtr& collection,
+                                                   const CanonicalQuery& cq,
+                                                   const QuerySolution& solution);
+
+    /**
+     * Returns true if the compiled plan cache is configured to keep any entries.
+     */
+    static bool isEnabled();
+
+    /**
+     * If a plan is cached under 'key', returns a clone of it whose runtime environment holds the
+     * variable values of 'cq'. The clone still needs to be attached to the operation and to its
+     * yield policy before it can be executed.
+     */
+    boost::optional<std::pair<std::unique_ptr<PlanStage>, stage_builder::PlanStageData>> lookup(
+        const std::string& key, const CanonicalQuery& cq);
+
+    /**
+     * Caches a clone of the plan tree rooted at 'root', along with a copy of 'data', under 'key'.
+     * The tree must not have been prepared for execution yet. Plans which depend on state which
+     * cannot be rebound by a later operation are not cached.
+     */
+    void add(const std::string& key,
+             const PlanStage& root,
+             const stage_builder::PlanStageData& data);
+
+    /**
+     * Returns the number of cached plans. Used for testing.
+     */
+    size_t size() const;
+
+private:
+    struct CompiledPlan {
+        std::unique_ptr<PlanStage> root;
+        stage_builder::PlanStageData data;
+    };
+
+    // The kv-store owns its entries, while lookups hold on to a plan while cloning it outside of
+    // the mutex, hence the extra level of indirection.
+    struct Entry {
+        std::shared_ptr<const CompiledPlan> plan;
+    };
+
+    TinyLFUKeyValue<std::string, Entry>* _getCache(WithLock);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("CompiledPlanCache::_mutex");
+
+    // Created on first use, once the startup parameters sizing the cache have been parsed.
+    std::unique_ptr<TinyLFUKeyValue<std::string, Entry>> _cache;
+};
+}  // namespace mongo::sbe
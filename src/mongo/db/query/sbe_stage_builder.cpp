@@ -55,6 +55,8 @@
 #include "mongo/db/fts/fts_query_impl.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/index/fts_access_method.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_request_helper.h"
 #include "mongo/db/query/sbe_stage_builder_coll_scan.h"
 #include "mongo/db/query/sbe_stage_builder_filter.h"
 #include "mongo/db/query/sbe_stage_builder_index_scan.h"
@@ -388,6 +390,16 @@ PlanStageSlots::PlanStageSlots(const PlanStageReqs& reqs,
     }
 }
 
+PlanStageData PlanStageData::makeCopy() const {
+    PlanStageData copy{env->makeDeepCopy()};
+    copy.outputs = outputs;
+    copy.iamMap = iamMap;
+    copy.shouldTrackLatestOplogTimestamp = shouldTrackLatestOplogTimestamp;
+    copy.shouldTrackResumeToken = shouldTrackResumeToken;
+    copy.shouldUseTailableScan = shouldUseTailableScan;
+    return copy;
+}
+
 std::string PlanStageData::debugString() const {
     StringBuilder builder;
 
@@ -696,14 +708,35 @@ std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::build(const QuerySolution
     return std::move(stage);
 }
 
+bool SlotBasedStageBuilder::canUseParallelCollScan(const CollectionScanNode* csn,
+                                                   const PlanStageReqs& reqs) const {
+    // A parallel scan returns the documents in no particular order, so it cannot be used when the
+    // query asks for the natural order.
+    const auto& findCommand = _cq.getFindCommandRequest();
+    if (findCommand.getSort().hasField(query_request_helper::kNaturalSortField) ||
+        findCommand.getHint().hasField(query_request_helper::kNaturalSortField)) {
+        return false;
+    }
+
+    return csn->direction == CollectionScanParams::FORWARD && !csn->tailable &&
+        !reqs.getIsTailableCollScanResumeBranch() && !csn->resumeAfterRecordId &&
+        !csn->requestResumeToken && !csn->minRecord && !csn->maxRecord &&
+        !csn->shouldTrackLatestOplogTimestamp && !csn->shouldWaitForOplogVisibility &&
+        !_collection->ns().isOplog() && !_collection->isClustered() &&
+        !_opCtx->inMultiDocumentTransaction();
+}
+
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder::buildCollScan(
     const QuerySolutionNode* root, const PlanStageReqs& reqs) {
     invariant(!reqs.getIndexKeyBitset());
 
     auto csn = static_cast<const CollectionScanNode*>(root);
 
-    auto [stage, outputs] = generateCollScan(
-        _state, _collection, csn, _yieldPolicy, reqs.getIsTailableCollScanResumeBranch());
+    auto parallelScanDegree = internalQuerySlotBasedExecutionParallelScanDegree.load();
+    auto [stage, outputs] = parallelScanDegree > 1 && canUseParallelCollScan(csn, reqs)
+        ? generateParallelCollScan(_state, _collection, csn, _yieldPolicy, parallelScanDegree)
+        : generateCollScan(
+              _state, _collection, csn, _yieldPolicy, reqs.getIsTailableCollScanResumeBranch());
 
     if (reqs.has(kReturnKey)) {
         // Assign the 'returnKeySlot' to be the empty object.
@@ -909,7 +942,6 @@ SlotBasedStageBuilder::makeLoopJoinForFetch(std::unique_ptr<sbe::PlanStage> inpu
 
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder::buildFetch(
     const QuerySolutionNode* root, const PlanStageReqs& reqs) {
-    auto fn = static_cast<const FetchNode*>(root);
 
     // The child must produce all of the slots required by the parent of this FetchNode, except for
     // 'resultSlot' which will be produced by the call to makeLoopJoinForFetch() below. In addition
@@ -923,7 +955,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
                          .set(kIndexKey)
                          .set(kIndexKeyPattern);
 
-    auto [stage, outputs] = build(fn->children[0], childReqs);
+    auto [stage, outputs] = build(root->children[0], childReqs);
 
     auto iamMap = _data.iamMap;
     uassert(4822880, "RecordId slot is not defined", outputs.has(kRecordId));
@@ -934,6 +966,27 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
     uassert(5290711, "Index key slot is not defined", outputs.has(kIndexKey));
     uassert(5113713, "Index key pattern slot is not defined", outputs.has(kIndexKeyPattern));
 
+    if (root->getType() == STAGE_BATCHED_ID_LOOKUP) {
+        // Read all the record ids found in the _id index and sort them, along with the slots used
+        // to check the index key of each document, before fetching the first document.
+        auto sortedSlots = sbe::makeSV();
+        outputs.forEachSlot(childReqs.copy().clear(kRecordId),
+                            [&](auto&& slot) { sortedSlots.push_back(slot); });
+        if (auto indexKeySlots = outputs.getIndexKeySlots()) {
+            sortedSlots.insert(sortedSlots.end(), indexKeySlots->begin(), indexKeySlots->end());
+        }
+
+        stage = sbe::makeS<sbe::SortStage>(
+            std::move(stage),
+            sbe::makeSV(outputs.get(kRecordId)),
+            std::vector<sbe::value::SortDirection>{sbe::value::SortDirection::Ascending},
+            std::move(sortedSlots),
+            std::numeric_limits<std::size_t>::max(),
+            static_cast<size_t>(internalQueryMaxBlockingSortMemoryUsageBytes.load()),
+            _cq.getExpCtx()->allowDiskUse,
+            root->nodeId());
+    }
+
     auto forwardingReqs = reqs.copy().clear(kResult).clear(kRecordId);
 
     auto relevantSlots = sbe::makeSV();
@@ -959,7 +1012,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
     outputs.set(kResult, fetchResultSlot);
     outputs.set(kRecordId, fetchRecordIdSlot);
 
-    if (fn->filter) {
+    if (root->filter) {
         forwardingReqs = reqs.copy().set(kResult).set(kRecordId);
 
         relevantSlots = sbe::makeSV();
@@ -971,7 +1024,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
         }
 
         auto [_, outputStage] = generateFilter(_state,
-                                               fn->filter.get(),
+                                               root->filter.get(),
                                                {std::move(stage), std::move(relevantSlots)},
                                                outputs.get(kResult),
                                                root->nodeId());
@@ -2395,6 +2448,9 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
             {STAGE_VIRTUAL_SCAN, &SlotBasedStageBuilder::buildVirtualScan},
             {STAGE_IXSCAN, &SlotBasedStageBuilder::buildIndexScan},
             {STAGE_FETCH, &SlotBasedStageBuilder::buildFetch},
+            // In SBE BATCHED_ID_LOOKUP behaves like a FETCH which sorts the output of its child by
+            // record id.
+            {STAGE_BATCHED_ID_LOOKUP, &SlotBasedStageBuilder::buildFetch},
             {STAGE_LIMIT, &SlotBasedStageBuilder::buildLimit},
             {STAGE_SKIP, &SlotBasedStageBuilder::buildSkip},
             {STAGE_SORT_SIMPLE, &SlotBasedStageBuilder::buildSort},
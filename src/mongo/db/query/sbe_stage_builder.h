@@ -229,6 +229,13 @@ struct PlanStageData {
 
     std::string debugString() const;
 
+    /**
+     * Returns a copy of this object with its own deep copy of the RuntimeEnvironment, suitable to
+     * accompany a clone of the PlanStage tree this object was built with. The per-execution state,
+     * namely 'replanReason' and 'savedStatsOnEarlyExit', is not copied.
+     */
+    PlanStageData makeCopy() const;
+
     // This holds the output slots produced by SBE plan (resultSlot, recordIdSlot, etc).
     PlanStageSlots outputs;
 
@@ -351,6 +358,11 @@ private:
     std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> makeUnionForTailableCollScan(
         const QuerySolutionNode* root, const PlanStageReqs& reqs);
 
+    /**
+     * Returns true if the collection scan 'csn' can be executed by several threads in parallel.
+     */
+    bool canUseParallelCollScan(const CollectionScanNode* csn, const PlanStageReqs& reqs) const;
+
     std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildShardFilter(
         const QuerySolutionNode* root, const PlanStageReqs& reqs);
 
@@ -50,6 +50,18 @@ std::pair<std::vector<std::unique_ptr<sbe::EExpression>>, EvalStage> buildAccumu
     return {std::move(aggs), std::move(inputStage)};
 }
 
+std::vector<std::unique_ptr<sbe::EExpression>> buildCombinePartialAggsMin(
+    const AccumulationExpression& expr, const sbe::value::SlotVector& inputSlots) {
+    tassert(6000123,
+            str::stream() << "Expected one input slot for merging $min, got: "
+                          << inputSlots.size(),
+            inputSlots.size() == 1);
+
+    std::vector<std::unique_ptr<sbe::EExpression>> aggs;
+    aggs.push_back(buildAccumulatorMinMax("min", makeVariable(inputSlots[0])));
+    return aggs;
+}
+
 std::pair<std::unique_ptr<sbe::EExpression>, EvalStage> buildFinalizeMin(
     StageBuilderState& state,
     const AccumulationExpression& expr,
@@ -77,6 +89,18 @@ std::pair<std::vector<std::unique_ptr<sbe::EExpression>>, EvalStage> buildAccumu
     return {std::move(aggs), std::move(inputStage)};
 }
 
+std::vector<std::unique_ptr<sbe::EExpression>> buildCombinePartialAggsMax(
+    const AccumulationExpression& expr, const sbe::value::SlotVector& inputSlots) {
+    tassert(6000124,
+            str::stream() << "Expected one input slot for merging $max, got: "
+                          << inputSlots.size(),
+            inputSlots.size() == 1);
+
+    std::vector<std::unique_ptr<sbe::EExpression>> aggs;
+    aggs.push_back(buildAccumulatorMinMax("max", makeVariable(inputSlots[0])));
+    return aggs;
+}
+
 std::pair<std::unique_ptr<sbe::EExpression>, EvalStage> buildFinalizeMax(
     StageBuilderState& state,
     const AccumulationExpression& expr,
@@ -102,6 +126,19 @@ std::pair<std::vector<std::unique_ptr<sbe::EExpression>>, EvalStage> buildAccumu
     return {std::move(aggs), std::move(inputStage)};
 }
 
+std::vector<std::unique_ptr<sbe::EExpression>> buildCombinePartialAggsFirst(
+    const AccumulationExpression& expr, const sbe::value::SlotVector& inputSlots) {
+    tassert(6000125,
+            str::stream() << "Expected one input slot for merging $first, got: "
+                          << inputSlots.size(),
+            inputSlots.size() == 1);
+
+    // The partial aggregates are merged in input order, so the first one wins.
+    std::vector<std::unique_ptr<sbe::EExpression>> aggs;
+    aggs.push_back(makeFunction("first", makeVariable(inputSlots[0])));
+    return aggs;
+}
+
 std::pair<std::unique_ptr<sbe::EExpression>, EvalStage> buildFinalizeFirst(
     StageBuilderState& state,
     const AccumulationExpression& expr,
@@ -126,6 +163,18 @@ std::pair<std::vector<std::unique_ptr<sbe::EExpression>>, EvalStage> buildAccumu
     return {std::move(aggs), std::move(inputStage)};
 }
 
+std::vector<std::unique_ptr<sbe::EExpression>> buildCombinePartialAggsLast(
+    const AccumulationExpression& expr, const sbe::value::SlotVector& inputSlots) {
+    tassert(6000126,
+            str::stream() << "Expected one input slot for merging $last, got: "
+                          << inputSlots.size(),
+            inputSlots.size() == 1);
+
+    std::vector<std::unique_ptr<sbe::EExpression>> aggs;
+    aggs.push_back(makeFunction("last", makeVariable(inputSlots[0])));
+    return aggs;
+}
+
 std::pair<std::unique_ptr<sbe::EExpression>, EvalStage> buildFinalizeLast(
     StageBuilderState& state,
     const AccumulationExpression& expr,
@@ -153,6 +202,20 @@ std::pair<std::vector<std::unique_ptr<sbe::EExpression>>, EvalStage> buildAccumu
     return {std::move(aggs), std::move(inputStage)};
 }
 
+std::vector<std::unique_ptr<sbe::EExpression>> buildCombinePartialAggsAvg(
+    const AccumulationExpression& expr, const sbe::value::SlotVector& inputSlots) {
+    tassert(6000127,
+            str::stream() << "Expected two input slots for merging $avg, got: "
+                          << inputSlots.size(),
+            inputSlots.size() == 2);
+
+    // Both the partial sums and the partial counts are added up.
+    std::vector<std::unique_ptr<sbe::EExpression>> aggs;
+    aggs.push_back(makeFunction("sum", makeVariable(inputSlots[0])));
+    aggs.push_back(makeFunction("sum", makeVariable(inputSlots[1])));
+    return aggs;
+}
+
 std::pair<std::unique_ptr<sbe::EExpression>, EvalStage> buildFinalizeAvg(
     StageBuilderState& state,
     const AccumulationExpression& expr,
@@ -216,6 +279,26 @@ std::pair<std::vector<std::unique_ptr<sbe::EExpression>>, EvalStage> buildAccumu
                        planNodeId);
 }
 
+std::vector<std::unique_ptr<sbe::EExpression>> buildCombinePartialAggregates(
+    const AccumulationStatement& acc, const sbe::value::SlotVector& aggSlots) {
+    using BuildCombinePartialAggsFn = std::function<std::vector<std::unique_ptr<sbe::EExpression>>(
+        const AccumulationExpression&, const sbe::value::SlotVector&)>;
+
+    static const StringDataMap<BuildCombinePartialAggsFn> kAccumulatorBuilders = {
+        {AccumulatorMin::kName, &buildCombinePartialAggsMin},
+        {AccumulatorMax::kName, &buildCombinePartialAggsMax},
+        {AccumulatorFirst::kName, &buildCombinePartialAggsFirst},
+        {AccumulatorLast::kName, &buildCombinePartialAggsLast},
+        {AccumulatorAvg::kName, &buildCombinePartialAggsAvg}};
+
+    auto accExprName = acc.expr.name;
+    uassert(6000128,
+            str::stream() << "Unsupported Accumulator in SBE accumulator builder: " << accExprName,
+            kAccumulatorBuilders.find(accExprName) != kAccumulatorBuilders.end());
+
+    return std::invoke(kAccumulatorBuilders.at(accExprName), acc.expr, aggSlots);
+}
+
 std::pair<std::unique_ptr<sbe::EExpression>, EvalStage> buildFinalize(
     StageBuilderState& state,
     const AccumulationStatement& acc,
@@ -60,6 +60,15 @@ std::pair<std::vector<std::unique_ptr<sbe::EExpression>>, EvalStage> buildAccumu
     std::unique_ptr<sbe::EExpression> argExpr,
     PlanNodeId planNodeId);
 
+/**
+ * Translates an input AccumulationStatement into the SBE EExpressions which combine the partial
+ * aggregates produced by 'buildAccumulator()', e.g. when a HashAggStage merges the runs it has
+ * spilled to disk. Each expression reads a partial aggregate from the corresponding slot in
+ * 'aggSlots' and folds it into the accumulator of that same slot.
+ */
+std::vector<std::unique_ptr<sbe::EExpression>> buildCombinePartialAggregates(
+    const AccumulationStatement& acc, const sbe::value::SlotVector& aggSlots);
+
 /**
  * Translates an input AccumulationStatement into an SBE EExpression that represents an
  * AccumulationStatement's finalization step. The 'stage' parameter provides the input subtree to
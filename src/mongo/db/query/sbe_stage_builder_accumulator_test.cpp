@@ -27,6 +27,7 @@
  *    it in the license file.
  */
 
+#include "mongo/db/exec/sbe/stages/plan_stats.h"
 #include "mongo/db/exec/sbe/util/debug_print.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/query/canonical_query.h"
@@ -35,8 +36,12 @@
 #include "mongo/db/query/sbe_stage_builder_expression.h"
 #include "mongo/db/query/sbe_stage_builder_helpers.h"
 #include "mongo/db/query/sbe_stage_builder_test_fixture.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/platform/basic.h"
+#include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -53,6 +58,38 @@ protected:
         return AccumulationStatement::parseAccumulationStatement(expCtx, elem, vps);
     }
 
+    /**
+     * Adds to 'mergingExprs' the expressions which combine the partial aggregates of 'accStmt',
+     * held in 'aggSlots', once a HashAggStage has spilled them. Only needed if the group may use
+     * disk.
+     */
+    void addMergingExprs(const ExpressionContext& expCtx,
+                         const AccumulationStatement& accStmt,
+                         const sbe::value::SlotVector& aggSlots,
+                         sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>>* mergingExprs) {
+        if (!expCtx.allowDiskUse) {
+            return;
+        }
+        auto exprs = stage_builder::buildCombinePartialAggregates(accStmt, aggSlots);
+        for (size_t i = 0; i < aggSlots.size(); ++i) {
+            mergingExprs->emplace(aggSlots[i], std::move(exprs[i]));
+        }
+    }
+
+    /**
+     * Returns the number of times the HashAggStages in the tree described by 'stats' spilled.
+     */
+    size_t countSpills(const sbe::PlanStageStats& stats) {
+        size_t spills = 0;
+        if (auto hashAggStats = dynamic_cast<const sbe::HashAggStats*>(stats.specific.get())) {
+            spills += hashAggStats->spills;
+        }
+        for (auto&& child : stats.children) {
+            spills += countSpills(*child);
+        }
+        return spills;
+    }
+
     std::unique_ptr<CanonicalQuery> canonicalize(const char* queryStr) {
         BSONObj queryObj = fromjson(queryStr);
         auto findCommand = std::make_unique<FindCommandRequest>(kTestNss);
@@ -115,8 +152,15 @@ protected:
             aggSlots.push_back(slot);
             aggs[slot] = std::move(expr);
         }
-        auto groupStage = makeHashAgg(
-            std::move(accStage), sbe::makeSV(), std::move(aggs), boost::none, kEmptyPlanNodeId);
+        sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> mergingExprs;
+        addMergingExprs(expCtx, accStmt, aggSlots, &mergingExprs);
+        auto groupStage = makeHashAgg(std::move(accStage),
+                                      sbe::makeSV(),
+                                      std::move(aggs),
+                                      boost::none,
+                                      expCtx.allowDiskUse,
+                                      std::move(mergingExprs),
+                                      kEmptyPlanNodeId);
 
         auto [finalExpr, finalStage] = stage_builder::buildFinalize(
             state, accStmt, std::move(aggSlots), std::move(groupStage), kEmptyPlanNodeId);
@@ -134,12 +178,18 @@ protected:
         ASSERT_TRUE(valueEquals(resultsTag, resultsVal, expectedTag, expectedVal));
     }
 
-    void runAggregationWithGroupByTest(StringData queryStatement,
-                                       std::vector<BSONArray> docs,
-                                       std::vector<StringData> groupByFields,
-                                       const struct mongo::BSONArray& expectedValue) {
+    /**
+     * Returns the number of times the group spilled, which can only be non-zero if 'allowDiskUse'
+     * is true.
+     */
+    size_t runAggregationWithGroupByTest(StringData queryStatement,
+                                         std::vector<BSONArray> docs,
+                                         std::vector<StringData> groupByFields,
+                                         const struct mongo::BSONArray& expectedValue,
+                                         bool allowDiskUse = false) {
         // This test simulates translation a $group with group-by statements on groupByFields.
         auto expCtx = ExpressionContextForTest{};
+        expCtx.allowDiskUse = allowDiskUse;
 
         // Build the a VirtualScan input sub-tree to feed test docs into the argument expression.
         auto querySolution = makeQuerySolution(makeVirtualScanTree(docs));
@@ -187,10 +237,14 @@ protected:
             aggSlots.push_back(slot);
             aggs[slot] = std::move(expr);
         }
+        sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> mergingExprs;
+        addMergingExprs(expCtx, accStmt, aggSlots, &mergingExprs);
         auto groupStage = makeHashAgg(std::move(accStage),
                                       sbe::makeSV(groupBySlot),
                                       std::move(aggs),
                                       boost::none,
+                                      expCtx.allowDiskUse,
+                                      std::move(mergingExprs),
                                       kEmptyPlanNodeId);
 
         // Build the finalize stage over the collected accumulators.
@@ -212,6 +266,8 @@ protected:
         sbe::value::ValueGuard expectedGuard{expectedTag, expectedVal};
 
         ASSERT_TRUE(valueEquals(sortedResultsTag, sortedResultsVal, expectedTag, expectedVal));
+
+        return countSpills(*outStage.stage->getStats(false /* includeDebugInfo */));
     }
 
     std::pair<sbe::value::TypeTags, sbe::value::Value> sortResults(sbe::value::TypeTags tag,
@@ -453,8 +509,15 @@ TEST_F(SbeAccumulatorBuilderTest, AvgAccumulatorTranslation) {
         aggSlots.push_back(slot);
         aggs[slot] = std::move(expr);
     }
-    auto groupStage = makeHashAgg(
-        std::move(accStage), sbe::makeSV(), std::move(aggs), boost::none, kEmptyPlanNodeId);
+    sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> mergingExprs;
+    addMergingExprs(expCtx, accStmt, aggSlots, &mergingExprs);
+    auto groupStage = makeHashAgg(std::move(accStage),
+                                  sbe::makeSV(),
+                                  std::move(aggs),
+                                  boost::none,
+                                  expCtx.allowDiskUse,
+                                  std::move(mergingExprs),
+                                  kEmptyPlanNodeId);
 
     // The finalization step for $avg translation will produce a divide expression that takes
     // the two group-by slots as input and binds an 'outSlot' that will hold the result of the
@@ -497,6 +560,7 @@ TEST_F(SbeAccumulatorBuilderTest, TwoAvgAccumulatorTranslation) {
     std::unique_ptr<sbe::EExpression> argExpr;
     std::vector<std::unique_ptr<sbe::EExpression>> accExprs;
     sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> aggs;
+    sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> mergingExprs;
     std::vector<sbe::value::SlotVector> accAggSlots;
     std::vector<AccumulationStatement> accStmts;
     auto state = makeStageBuilderState();
@@ -526,11 +590,17 @@ TEST_F(SbeAccumulatorBuilderTest, TwoAvgAccumulatorTranslation) {
             aggSlots.push_back(slot);
             aggs[slot] = std::move(expr);
         }
+        addMergingExprs(expCtx, accStmt, aggSlots, &mergingExprs);
         accAggSlots.emplace_back(std::move(aggSlots));
     }
 
-    auto groupStage = makeHashAgg(
-        std::move(evalStage), sbe::makeSV(), std::move(aggs), boost::none, kEmptyPlanNodeId);
+    auto groupStage = makeHashAgg(std::move(evalStage),
+                                  sbe::makeSV(),
+                                  std::move(aggs),
+                                  boost::none,
+                                  expCtx.allowDiskUse,
+                                  std::move(mergingExprs),
+                                  kEmptyPlanNodeId);
 
     // Build the finalize stage over the collected accumulators.
     sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> projects;
@@ -615,10 +685,14 @@ TEST_F(SbeAccumulatorBuilderTest, AvgAccumulatorOneGroupByTranslation) {
         aggSlots.push_back(slot);
         aggs[slot] = std::move(expr);
     }
+    sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> mergingExprs;
+    addMergingExprs(expCtx, accStmt, aggSlots, &mergingExprs);
     auto groupStage = makeHashAgg(std::move(accStage),
                                   sbe::makeSV(groupBySlot),
                                   std::move(aggs),
                                   boost::none,
+                                  expCtx.allowDiskUse,
+                                  std::move(mergingExprs),
                                   kEmptyPlanNodeId);
 
 
@@ -645,4 +719,33 @@ TEST_F(SbeAccumulatorBuilderTest, AvgAccumulatorOneGroupByTranslation) {
 
     ASSERT_TRUE(valueEquals(sortedResultsTag, sortedResultsVal, expectedTag, expectedVal));
 }
+
+TEST_F(SbeAccumulatorBuilderTest, GroupBySpillsAndCombinesPartialAggregates) {
+    unittest::TempDir tempDir("SbeAccumulatorBuilderTest");
+    auto originalDbPath = storageGlobalParams.dbpath;
+    storageGlobalParams.dbpath = tempDir.path();
+    ON_BLOCK_EXIT([&] { storageGlobalParams.dbpath = originalDbPath; });
+
+    // Force the hash table to be spilled every time its size is checked.
+    RAIIServerParameterControllerForTest controller(
+        "internalQuerySBEAggApproxMemoryUseInBytesBeforeSpill", 1);
+
+    std::vector<BSONArray> docs;
+    for (int i = 0; i < 1000; ++i) {
+        docs.push_back(BSON_ARRAY(BSON("a" << i % 3 << "b" << i)));
+    }
+
+    ASSERT_GT(runAggregationWithGroupByTest("{x: {$min: '$b'}}",
+                                            docs,
+                                            {"$a"},
+                                            BSON_ARRAY(0 << 1 << 2),
+                                            true /* allowDiskUse */),
+              0U);
+    ASSERT_GT(runAggregationWithGroupByTest("{x: {$avg: '$b'}}",
+                                            docs,
+                                            {"$a"},
+                                            BSON_ARRAY(499 << 499.5 << 500),
+                                            true /* allowDiskUse */),
+              0U);
+}
 }  // namespace mongo
@@ -617,6 +617,62 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateGenericCollSc
 }
 }  // namespace
 
+std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateParallelCollScan(
+    StageBuilderState& state,
+    const CollectionPtr& collection,
+    const CollectionScanNode* csn,
+    PlanYieldPolicy* yieldPolicy,
+    size_t degree) {
+    invariant(csn->direction == CollectionScanParams::FORWARD);
+    invariant(!csn->resumeAfterRecordId && !csn->tailable);
+    invariant(!csn->shouldTrackLatestOplogTimestamp && !csn->shouldWaitForOplogVisibility);
+
+    auto resultSlot = state.slotId();
+    auto recordIdSlot = state.slotId();
+
+    // The producers run on their own threads and operation contexts. Passing the query's yield
+    // policy only marks the scan as yielding: each producer replaces it with its own.
+    std::unique_ptr<sbe::PlanStage> stage =
+        sbe::makeS<sbe::ParallelScanStage>(collection->uuid(),
+                                           resultSlot,
+                                           recordIdSlot,
+                                           boost::none /* snapshotIdSlot */,
+                                           boost::none /* indexIdSlot */,
+                                           boost::none /* indexKeySlot */,
+                                           boost::none /* keyPatternSlot */,
+                                           std::vector<std::string>{},
+                                           sbe::makeSV(),
+                                           yieldPolicy,
+                                           csn->nodeId(),
+                                           sbe::ScanCallbacks{});
+
+    // Apply the filter in the producers, so that only matching documents cross the exchange.
+    if (csn->filter) {
+        auto relevantSlots = sbe::makeSV(resultSlot, recordIdSlot);
+
+        auto [_, outputStage] = generateFilter(state,
+                                               csn->filter.get(),
+                                               {std::move(stage), std::move(relevantSlots)},
+                                               resultSlot,
+                                               csn->nodeId());
+        stage = std::move(outputStage.stage);
+    }
+
+    stage = sbe::makeS<sbe::ExchangeConsumer>(std::move(stage),
+                                              degree,
+                                              sbe::makeSV(resultSlot, recordIdSlot),
+                                              sbe::ExchangePolicy::roundrobin,
+                                              nullptr /* partition */,
+                                              nullptr /* orderLess */,
+                                              csn->nodeId());
+
+    PlanStageSlots outputs;
+    outputs.set(PlanStageSlots::kResult, resultSlot);
+    outputs.set(PlanStageSlots::kRecordId, recordIdSlot);
+
+    return {std::move(stage), std::move(outputs)};
+}
+
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
     StageBuilderState& state,
     const CollectionPtr& collection,
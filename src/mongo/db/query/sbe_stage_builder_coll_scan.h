@@ -59,4 +59,20 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
     PlanYieldPolicy* yieldPolicy,
     bool isTailableResumeBranch);
 
+/**
+ * Generates an SBE plan stage sub-tree implementing a parallel collection scan. The collection is
+ * split into RecordId ranges, which are read and filtered by 'degree' producer threads, and an
+ * exchange returns the matching documents to the calling thread in no particular order. Only
+ * forward, non-tailable scans outside of the oplog can be parallelized. Each producer yields its
+ * own locks on the schedule of 'yieldPolicy' and stops when the query is interrupted.
+ *
+ * The returned slots are the same as for generateCollScan(), without an oplog timestamp.
+ */
+std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateParallelCollScan(
+    StageBuilderState& state,
+    const CollectionPtr& collection,
+    const CollectionScanNode* csn,
+    PlanYieldPolicy* yieldPolicy,
+    size_t degree);
+
 }  // namespace mongo::stage_builder
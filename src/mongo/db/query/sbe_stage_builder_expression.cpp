@@ -460,6 +460,7 @@ public:
     void visit(const ExpressionSetField* expr) final {}
     void visit(const ExpressionTsSecond* expr) final {}
     void visit(const ExpressionTsIncrement* expr) final {}
+    void visit(const ExpressionSharedSubexpression* expr) final {}
 
 private:
     void visitMultiBranchLogicExpression(const Expression* expr, sbe::EPrimBinary::Op logicOp) {
@@ -665,6 +666,7 @@ public:
     void visit(const ExpressionSetField* expr) final {}
     void visit(const ExpressionTsSecond* expr) final {}
     void visit(const ExpressionTsIncrement* expr) final {}
+    void visit(const ExpressionSharedSubexpression* expr) final {}
 
 private:
     void visitMultiBranchLogicExpression(const Expression* expr, sbe::EPrimBinary::Op logicOp) {
@@ -697,6 +699,51 @@ struct DoubleBound {
     bool inclusive;
 };
 
+/**
+ * If the condition of the $filter 'expr' compares the current element to a numeric or date
+ * constant, e.g. {$filter: {input: "$a", cond: {$gt: ["$$this", 5]}}}, returns the name of the
+ * block builtin implementing the comparison along with the constant. Such a comparison ignores
+ * the collation, so the whole input array can be filtered in one builtin call.
+ */
+boost::optional<std::pair<StringData, Value>> getBlockFilterComparison(
+    const ExpressionFilter* expr) {
+    auto cmp = dynamic_cast<const ExpressionCompare*>(expr->getChildren()[1].get());
+    if (!cmp) {
+        return boost::none;
+    }
+
+    auto& operands = cmp->getChildren();
+    auto element = dynamic_cast<const ExpressionFieldPath*>(operands[0].get());
+    auto constant = dynamic_cast<const ExpressionConstant*>(operands[1].get());
+    if (!element || !constant || element->getVariableId() != expr->getVariableId() ||
+        element->getFieldPath().getPathLength() != 1) {
+        return boost::none;
+    }
+
+    auto value = constant->getValue();
+    if (!value.numeric() && value.getType() != BSONType::Date) {
+        return boost::none;
+    }
+
+    switch (cmp->getOp()) {
+        case ExpressionCompare::CmpOp::EQ:
+            return {{"blockEq"_sd, value}};
+        case ExpressionCompare::CmpOp::NE:
+            return {{"blockNeq"_sd, value}};
+        case ExpressionCompare::CmpOp::GT:
+            return {{"blockGt"_sd, value}};
+        case ExpressionCompare::CmpOp::GTE:
+            return {{"blockGte"_sd, value}};
+        case ExpressionCompare::CmpOp::LT:
+            return {{"blockLt"_sd, value}};
+        case ExpressionCompare::CmpOp::LTE:
+            return {{"blockLte"_sd, value}};
+        case ExpressionCompare::CmpOp::CMP:
+            return boost::none;
+    }
+    MONGO_UNREACHABLE;
+}
+
 class ExpressionPostVisitor final : public ExpressionConstVisitor {
 public:
     ExpressionPostVisitor(ExpressionVisitorContext* context) : _context{context} {}
@@ -1129,7 +1176,9 @@ public:
         auto limitNumChildren =
             makeLimitSkip(std::move(unionWithNullStage), _context->planNodeId, numChildren);
 
-        // Create a group stage to aggregate elements into a single array.
+        // Create a group stage to aggregate elements into a single array. Neither this group nor
+        // the one below has group-by keys, so their hash tables hold a single entry and are never
+        // spilled.
         auto collatorSlot = _context->state.env->getSlotIfExists("collator"_sd);
         auto addToArrayExpr =
             makeFunction("addToArray", sbe::makeE<sbe::EVariable>(unionWithNullSlot));
@@ -1138,6 +1187,8 @@ public:
                                       sbe::makeSV(),
                                       sbe::makeEM(groupSlot, std::move(addToArrayExpr)),
                                       collatorSlot,
+                                      false /* allowDiskUse */,
+                                      sbe::makeEM() /* mergingExprs */,
                                       _context->planNodeId);
 
         // Build subtree to handle nulls. If an input is null, return null. Otherwise, unwind the
@@ -1166,6 +1217,8 @@ public:
                         sbe::makeSV(),
                         sbe::makeEM(finalGroupSlot, std::move(finalAddToArrayExpr)),
                         collatorSlot,
+                        false /* allowDiskUse */,
+                        sbe::makeEM() /* mergingExprs */,
                         _context->planNodeId);
 
         // Create a branch stage to select between the branch that produces one null if any elements
@@ -1880,6 +1933,34 @@ public:
         auto inputArray =
             sbe::makeE<sbe::ELocalBind>(frameId, std::move(binds), std::move(checkInputArrayType));
 
+        if (auto blockComparison = getBlockFilterComparison(expr);
+            blockComparison && !filterStage.stage) {
+            // The predicate only compares each element to a constant, so instead of traversing
+            // the input array we build a mask for it with a block comparison and apply the mask
+            // with 'blockFilter':
+            //
+            // let inputArrayRef = inputArray
+            // in
+            //     if isNull(inputArrayRef) || !exists(inputArrayRef)
+            //       null
+            //     else
+            //       blockFilter(inputArrayRef, blockGt(inputArrayRef, constant))
+            auto blockFrameId = _context->state.frameId();
+            sbe::EVariable inputArrayRef(blockFrameId, 0);
+            auto [constantTag, constantVal] = makeValue(blockComparison->second);
+            auto mask = makeFunction(blockComparison->first,
+                                     inputArrayRef.clone(),
+                                     sbe::makeE<sbe::EConstant>(constantTag, constantVal));
+            auto filteredArray = sbe::makeE<sbe::EIf>(
+                generateNullOrMissing(inputArrayRef),
+                sbe::makeE<sbe::EConstant>(sbe::value::TypeTags::Null, 0),
+                makeFunction("blockFilter", inputArrayRef.clone(), std::move(mask)));
+
+            _context->pushExpr(sbe::makeE<sbe::ELocalBind>(
+                blockFrameId, sbe::makeEs(std::move(inputArray)), std::move(filteredArray)));
+            return;
+        }
+
         sbe::EVariable inputArrayVariable{inputArraySlot};
         auto projectInputArray = makeProject(_context->extractCurrentEvalStage(),
                                              _context->planNodeId,
@@ -2793,6 +2874,10 @@ public:
             _context->popExpr());
         _context->pushExpr(std::move(tsIncrementExpr));
     }
+    void visit(const ExpressionSharedSubexpression* expr) final {
+        // A shared subexpression only caches its child's value across the fields of one
+        // projection, so the child's translation left on the stack is already the result.
+    }
 
 private:
     /**
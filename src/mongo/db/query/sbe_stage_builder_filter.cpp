@@ -1461,6 +1461,9 @@ public:
             }
         }
 
+        // Share the lookup the classic matcher uses for the same equalities.
+        arrSet->setLookup(expr->getLookup());
+
         const auto traversalMode = hasArray ? LeafTraversalMode::kArrayAndItsElements
                                             : LeafTraversalMode::kArrayElementsOnly;
 
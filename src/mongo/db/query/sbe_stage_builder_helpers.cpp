@@ -459,6 +459,8 @@ EvalStage makeHashAgg(EvalStage stage,
                       sbe::value::SlotVector gbs,
                       sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> aggs,
                       boost::optional<sbe::value::SlotId> collatorSlot,
+                      bool allowDiskUse,
+                      sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> mergingExprs,
                       PlanNodeId planNodeId) {
     stage.outSlots = gbs;
     for (auto& [slot, _] : aggs) {
@@ -470,6 +472,8 @@ EvalStage makeHashAgg(EvalStage stage,
                                                 sbe::makeSV(),
                                                 true /* optimized close */,
                                                 collatorSlot,
+                                                allowDiskUse,
+                                                std::move(mergingExprs),
                                                 planNodeId);
     return stage;
 }
@@ -347,10 +347,17 @@ EvalStage makeUnion(std::vector<EvalStage> inputStages,
                     sbe::value::SlotVector outputVals,
                     PlanNodeId planNodeId);
 
+/**
+ * Creates a HashAggStage over 'stage'. If 'allowDiskUse' is true, the stage may spill its hash
+ * table and uses 'mergingExprs', e.g. as built by 'buildCombinePartialAggregates()', to combine the
+ * partial aggregates of the spilled runs.
+ */
 EvalStage makeHashAgg(EvalStage stage,
                       sbe::value::SlotVector gbs,
                       sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> aggs,
                       boost::optional<sbe::value::SlotId> collatorSlot,
+                      bool allowDiskUse,
+                      sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> mergingExprs,
                       PlanNodeId planNodeId);
 
 EvalStage makeMkBsonObj(EvalStage stage,
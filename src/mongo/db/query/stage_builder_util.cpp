@@ -33,10 +33,35 @@
 
 #include "mongo/db/query/classic_stage_builder.h"
 #include "mongo/db/query/plan_yield_policy.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/sbe_compiled_plan_cache.h"
 #include "mongo/db/query/sbe_stage_builder.h"
 #include "mongo/db/query/shard_filterer_factory_impl.h"
 
 namespace mongo::stage_builder {
+namespace {
+/**
+ * Attaches the SBE plan tree rooted at 'root' to 'opCtx' and registers it to yield according to
+ * 'yieldPolicy'.
+ */
+void attachSlotBasedExecutableTree(OperationContext* opCtx,
+                                   const CanonicalQuery& cq,
+                                   sbe::PlanStage* root,
+                                   PlanYieldPolicySBE* yieldPolicy) {
+    root->attachToOperationContext(opCtx);
+
+    auto expCtx = cq.getExpCtxRaw();
+    tassert(5327100, "No expression context", expCtx);
+    if (expCtx->explain || expCtx->mayDbProfile ||
+        internalQueryCollectStageExecutionStats.load()) {
+        root->markShouldCollectTimingInfo();
+    }
+
+    // Register this plan to yield according to the configured policy.
+    yieldPolicy->registerPlan(root);
+}
+}  // namespace
+
 std::unique_ptr<PlanStage> buildClassicExecutableTree(OperationContext* opCtx,
                                                       const CollectionPtr& collection,
                                                       const CanonicalQuery& cq,
@@ -76,17 +101,39 @@ buildSlotBasedExecutableTree(OperationContext* opCtx,
     auto root = builder->build(solution.root());
     auto data = builder->getPlanStageData();
 
-    root->attachToOperationContext(opCtx);
+    attachSlotBasedExecutableTree(opCtx, cq, root.get(), sbeYieldPolicy);
 
-    auto expCtx = cq.getExpCtxRaw();
-    tassert(5327100, "No expression context", expCtx);
-    if (expCtx->explain || expCtx->mayDbProfile) {
-        root->markShouldCollectTimingInfo();
+    return {std::move(root), std::move(data)};
+}
+
+std::pair<std::unique_ptr<sbe::PlanStage>, stage_builder::PlanStageData>
+buildOrCloneSlotBasedExecutableTree(OperationContext* opCtx,
+                                    const CollectionPtr& collection,
+                                    const CanonicalQuery& cq,
+                                    const QuerySolution& solution,
+                                    PlanYieldPolicy* yieldPolicy) {
+    if (!sbe::CompiledPlanCache::isEnabled()) {
+        return buildSlotBasedExecutableTree(opCtx, collection, cq, solution, yieldPolicy);
     }
 
-    // Register this plan to yield according to the configured policy.
-    sbeYieldPolicy->registerPlan(root.get());
+    auto key = sbe::CompiledPlanCache::computeKey(collection, cq, solution);
+    if (!key) {
+        return buildSlotBasedExecutableTree(opCtx, collection, cq, solution, yieldPolicy);
+    }
 
-    return {std::move(root), std::move(data)};
+    auto& compiledPlanCache = sbe::CompiledPlanCache::get(opCtx->getServiceContext());
+    if (auto plan = compiledPlanCache.lookup(*key, cq)) {
+        auto sbeYieldPolicy = dynamic_cast<PlanYieldPolicySBE*>(yieldPolicy);
+        invariant(sbeYieldPolicy);
+
+        auto root = plan->first.get();
+        root->attachNewYieldPolicy(sbeYieldPolicy);
+        attachSlotBasedExecutableTree(opCtx, cq, root, sbeYieldPolicy);
+        return std::move(*plan);
+    }
+
+    auto plan = buildSlotBasedExecutableTree(opCtx, collection, cq, solution, yieldPolicy);
+    compiledPlanCache.add(*key, *plan.first, plan.second);
+    return plan;
 }
 }  // namespace mongo::stage_builder
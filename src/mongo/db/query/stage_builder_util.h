@@ -57,4 +57,15 @@ buildSlotBasedExecutableTree(OperationContext* opCtx,
                              const QuerySolution& solution,
                              PlanYieldPolicy* yieldPolicy);
 
+/**
+ * Same as buildSlotBasedExecutableTree(), but reuses the plan compiled for an identical query from
+ * the SBE compiled plan cache if there is one, and otherwise caches the plan it builds.
+ */
+std::pair<std::unique_ptr<sbe::PlanStage>, stage_builder::PlanStageData>
+buildOrCloneSlotBasedExecutableTree(OperationContext* opCtx,
+                                    const CollectionPtr& collection,
+                                    const CanonicalQuery& cq,
+                                    const QuerySolution& solution,
+                                    PlanYieldPolicy* yieldPolicy);
+
 }  // namespace mongo::stage_builder
@@ -35,8 +35,10 @@
 namespace mongo {
 StringData stageTypeToString(StageType stageType) {
     static const stdx::unordered_map<StageType, StringData> kStageTypesMap = {
+        {STAGE_AND_BITMAP, "AND_BITMAP"_sd},
         {STAGE_AND_HASH, "AND_HASH"_sd},
         {STAGE_AND_SORTED, "AND_SORTED"_sd},
+        {STAGE_BATCHED_ID_LOOKUP, "BATCHED_ID_LOOKUP"_sd},
         {STAGE_CACHED_PLAN, "CACHED_PLAN"},
         {STAGE_COLLSCAN, "COLLSCAN"_sd},
         {STAGE_COUNT, "COUNT"_sd},
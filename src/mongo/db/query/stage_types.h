@@ -47,8 +47,10 @@ static constexpr PlanNodeId kEmptyPlanNodeId = 0u;
  * These map to implementations of the PlanStage interface, all of which live in db/exec/
  */
 enum StageType {
+    STAGE_AND_BITMAP,
     STAGE_AND_HASH,
     STAGE_AND_SORTED,
+    STAGE_BATCHED_ID_LOOKUP,
     STAGE_CACHED_PLAN,
     STAGE_COLLSCAN,
 
@@ -0,0 +1,348 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "mongo/base/status.h"
+#include "mongo/db/query/frequency_sketch.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+/**
+ * Budget estimator charging one unit per entry, so that the budget of a kv-store is its number of
+ * entries.
+ */
+template <class K, class V>
+struct UnitBudgetEstimator {
+    size_t operator()(const K&, const V&) const {
+        return 1;
+    }
+};
+
+/**
+ * A key-value store bounded both by its number of entries and by the total budget of its entries,
+ * as computed by 'BudgetEstimator', with a W-TinyLFU replacement policy:
+ *
+ *  - New entries are added to a small LRU "window" holding about 1% of the capacity, so that a
+ *    burst of new keys can build up some history before competing for a place in the store.
+ *  - Entries pushed out of the window are candidates for the LRU "main" segment, which holds the
+ *    rest. If the main segment is full, a candidate is only admitted if it was accessed more often
+ *    than the least recently used entry of the main segment, which is then evicted. Otherwise the
+ *    candidate itself is evicted.
+ *
+ * Access frequencies are estimated by a FrequencySketch, which records every add() and get(),
+ * including the lookups of missing keys. As a result, an entry which is large or accessed once
+ * cannot push many small, frequently accessed entries out of the store.
+ *
+ * The store also remembers the hashes of the keys it evicted recently, so that callers can tell
+ * whether a lookup missed because of an eviction.
+ *
+ * Caveat:
+ * This kv-store is NOT thread safe! The client to this utility is responsible for protecting
+ * concurrent access to the store if used in a threaded context.
+ *
+ * The keys of generic type K map to values of type V*. The V* pointers are owned by the kv-store.
+ */
+template <class K,
+          class V,
+          class BudgetEstimator = UnitBudgetEstimator<K, V>,
+          class KeyHasher = std::hash<K>>
+class TinyLFUKeyValue {
+public:
+    TinyLFUKeyValue(size_t maxEntries, size_t maxBudget)
+        : _window(_windowMaxEntries(maxEntries), _windowMaxBudget(maxEntries, maxBudget)),
+          _main(maxEntries - _window.maxEntries, maxBudget - _window.maxBudget),
+          _maxEvictedKeys(std::max<size_t>(1, maxEntries)) {}
+
+    ~TinyLFUKeyValue() {
+        clear();
+    }
+
+    TinyLFUKeyValue(const TinyLFUKeyValue&) = delete;
+    TinyLFUKeyValue& operator=(const TinyLFUKeyValue&) = delete;
+
+    /**
+     * Add an (K, V*) pair to the store, where 'key' can be used to retrieve value 'entry' from the
+     * store. Takes ownership of 'entry'. If 'key' already exists in the kv-store, 'entry' replaces
+     * what is already there.
+     *
+     * Returns the entries evicted to keep the store within its limits, possibly including 'entry'
+     * itself. The caller may use them before disposing of them.
+     */
+    std::vector<std::unique_ptr<V>> add(const K& key, V* entry) {
+        const auto hash = _hasher(key);
+        _sketch.increment(hash);
+        _evictedKeys.erase(hash);
+
+        auto i = _kvMap.find(key);
+        if (i != _kvMap.end()) {
+            auto found = i->second;
+            _segment(found->segment).budget -= found->budget;
+            delete found->value;
+            _segment(found->segment).entries.erase(found);
+            _kvMap.erase(i);
+        }
+
+        const size_t budget = _budgetEstimator(key, *entry);
+        _window.entries.push_front({key, entry, budget, SegmentId::kWindow});
+        _window.budget += budget;
+        _kvMap[key] = _window.entries.begin();
+        _sketch.ensureCapacity(_kvMap.size());
+
+        std::vector<std::unique_ptr<V>> evicted;
+        while (_window.isOverLimit()) {
+            _admitToMain(std::prev(_window.entries.end()), &evicted);
+        }
+        return evicted;
+    }
+
+    /**
+     * Retrieve the value associated with 'key' from the kv-store. The value is returned through
+     * the out-parameter 'entryOut'. The kv-store retains ownership of 'entryOut', so it should not
+     * be deleted by the caller.
+     *
+     * As a side effect, the access is recorded and the retrieved entry is promoted to the most
+     * recently used of its segment.
+     */
+    Status get(const K& key, V** entryOut) const {
+        _sketch.increment(_hasher(key));
+
+        auto i = _kvMap.find(key);
+        if (i == _kvMap.end()) {
+            return Status(ErrorCodes::NoSuchKey, "no such key in TinyLFU key-value store");
+        }
+
+        auto found = i->second;
+        auto& entries = _segment(found->segment).entries;
+        entries.splice(entries.begin(), entries, found);
+
+        *entryOut = found->value;
+        return Status::OK();
+    }
+
+    /**
+     * Remove the kv-store entry keyed by 'key'.
+     */
+    Status remove(const K& key) {
+        auto i = _kvMap.find(key);
+        if (i == _kvMap.end()) {
+            return Status(ErrorCodes::NoSuchKey, "no such key in TinyLFU key-value store");
+        }
+
+        auto found = i->second;
+        _segment(found->segment).budget -= found->budget;
+        delete found->value;
+        _segment(found->segment).entries.erase(found);
+        _kvMap.erase(i);
+        return Status::OK();
+    }
+
+    /**
+     * Deletes all entries in the kv-store, and forgets the access history and the evicted keys.
+     */
+    void clear() {
+        for (auto* segment : {&_window, &_main}) {
+            for (auto&& entry : segment->entries) {
+                delete entry.value;
+            }
+            segment->entries.clear();
+            segment->budget = 0;
+        }
+        _kvMap.clear();
+        _sketch.clear();
+        _evictedKeys.clear();
+        _evictionOrder.clear();
+    }
+
+    /**
+     * Returns true if entry is found in the kv-store.
+     */
+    bool hasKey(const K& key) const {
+        return _kvMap.find(key) != _kvMap.end();
+    }
+
+    /**
+     * Returns true if an entry keyed by 'key' was among the most recently evicted entries and
+     * the key has not been added again since.
+     */
+    bool wasEvicted(const K& key) const {
+        return _evictedKeys.find(_hasher(key)) != _evictedKeys.end();
+    }
+
+    /**
+     * Returns the number of entries currently in the kv-store.
+     */
+    size_t size() const {
+        return _kvMap.size();
+    }
+
+    /**
+     * Returns the total budget of the entries currently in the kv-store.
+     */
+    size_t budget() const {
+        return _window.budget + _main.budget;
+    }
+
+    /**
+     * Calls 'func' with the key and the value of every entry in the kv-store, without recording
+     * any access.
+     */
+    template <class Func>
+    void forEach(Func&& func) const {
+        for (const auto* segment : {&_window, &_main}) {
+            for (auto&& entry : segment->entries) {
+                func(entry.key, *entry.value);
+            }
+        }
+    }
+
+private:
+    enum class SegmentId { kWindow, kMain };
+
+    struct Entry {
+        K key;
+        V* value;
+        size_t budget;
+        SegmentId segment;
+    };
+
+    using EntryList = std::list<Entry>;
+    using EntryIt = typename EntryList::iterator;
+
+    /**
+     * An LRU list of entries, sorted from the most recently used to the least recently used.
+     */
+    struct Segment {
+        Segment(size_t maxEntries, size_t maxBudget)
+            : maxEntries(maxEntries), maxBudget(maxBudget) {}
+
+        bool isOverLimit() const {
+            return entries.size() > maxEntries || budget > maxBudget;
+        }
+
+        const size_t maxEntries;
+        const size_t maxBudget;
+        EntryList entries;
+        size_t budget = 0;
+    };
+
+    /**
+     * The window holds about 1% of the capacity of the store, with room for at least one entry
+     * of average budget.
+     */
+    static size_t _windowMaxEntries(size_t maxEntries) {
+        return maxEntries == 0 ? 0 : std::max<size_t>(1, maxEntries / 100);
+    }
+
+    static size_t _windowMaxBudget(size_t maxEntries, size_t maxBudget) {
+        return maxEntries == 0 ? 0 : std::max(maxBudget / 100, maxBudget / maxEntries);
+    }
+
+    Segment& _segment(SegmentId id) const {
+        return id == SegmentId::kWindow ? _window : _main;
+    }
+
+    /**
+     * Moves 'candidate', the least recently used entry of the window, to the main segment, then
+     * evicts from the main segment until it is within its limits again, either by evicting its
+     * least frequently accessed entries or the candidate itself.
+     */
+    void _admitToMain(EntryIt candidate, std::vector<std::unique_ptr<V>>* evicted) {
+        _window.budget -= candidate->budget;
+        _main.budget += candidate->budget;
+        _main.entries.splice(_main.entries.begin(), _window.entries, candidate);
+        candidate->segment = SegmentId::kMain;
+
+        const auto candidateFrequency = _sketch.frequency(_hasher(candidate->key));
+        while (_main.isOverLimit()) {
+            auto victim = std::prev(_main.entries.end());
+            if (victim == candidate ||
+                candidateFrequency <= _sketch.frequency(_hasher(victim->key))) {
+                _evict(candidate, evicted);
+                return;
+            }
+            _evict(victim, evicted);
+        }
+    }
+
+    void _evict(EntryIt it, std::vector<std::unique_ptr<V>>* evicted) {
+        auto& segment = _segment(it->segment);
+        segment.budget -= it->budget;
+        evicted->emplace_back(it->value);
+        _rememberEvictedKey(_hasher(it->key));
+        _kvMap.erase(it->key);
+        segment.entries.erase(it);
+    }
+
+    void _rememberEvictedKey(size_t hash) {
+        if (_maxEvictedKeys == 0) {
+            return;
+        }
+
+        if (_evictionOrder.size() == _maxEvictedKeys) {
+            auto [oldestHash, oldestEviction] = _evictionOrder.front();
+            if (auto it = _evictedKeys.find(oldestHash);
+                it != _evictedKeys.end() && it->second == oldestEviction) {
+                _evictedKeys.erase(it);
+            }
+            _evictionOrder.pop_front();
+        }
+
+        _evictedKeys[hash] = ++_numEvictions;
+        _evictionOrder.emplace_back(hash, _numEvictions);
+    }
+
+    BudgetEstimator _budgetEstimator;
+    KeyHasher _hasher;
+
+    mutable Segment _window;
+    mutable Segment _main;
+
+    // Maps from a key to the corresponding list entry, in either segment. Iterators stay valid
+    // when entries are moved between segments.
+    stdx::unordered_map<K, EntryIt, KeyHasher> _kvMap;
+
+    mutable FrequencySketch _sketch;
+
+    // Hashes of the keys of the last '_maxEvictedKeys' evicted entries, mapped to the sequence
+    // number of their eviction, and the evictions in the order they happened.
+    const size_t _maxEvictedKeys;
+    size_t _numEvictions = 0;
+    stdx::unordered_map<size_t, size_t> _evictedKeys;
+    std::deque<std::pair<size_t, size_t>> _evictionOrder;
+};
+
+}  // namespace mongo
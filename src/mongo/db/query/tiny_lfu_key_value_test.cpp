@@ -0,0 +1,273 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/db/query/tiny_lfu_key_value.h"
+
+#include "mongo/unittest/unittest.h"
+
+using namespace mongo;
+
+namespace {
+
+using Cache = TinyLFUKeyValue<int, int>;
+
+/**
+ * Charges each entry its value, so that tests can add entries of different sizes.
+ */
+struct ValueBudgetEstimator {
+    size_t operator()(int, int value) const {
+        return value;
+    }
+};
+
+//
+// Convenience functions
+//
+
+template <class KV>
+void assertInKVStore(KV& cache, int key, int value) {
+    int* cachedValue = nullptr;
+    ASSERT_TRUE(cache.hasKey(key));
+    Status s = cache.get(key, &cachedValue);
+    ASSERT_OK(s);
+    ASSERT_EQUALS(*cachedValue, value);
+}
+
+template <class KV>
+void assertNotInKVStore(KV& cache, int key) {
+    int* cachedValue = nullptr;
+    ASSERT_FALSE(cache.hasKey(key));
+    Status s = cache.get(key, &cachedValue);
+    ASSERT_NOT_OK(s);
+}
+
+template <class KV>
+void access(KV& cache, int key, int times) {
+    int* cachedValue = nullptr;
+    for (int i = 0; i < times; ++i) {
+        cache.get(key, &cachedValue).ignore();
+    }
+}
+
+TEST(FrequencySketchTest, EstimatesAccessCounts) {
+    FrequencySketch sketch(16);
+    for (int i = 0; i < 5; ++i) {
+        sketch.increment(42);
+    }
+    sketch.increment(7);
+
+    ASSERT_GTE(sketch.frequency(42), 5U);
+    ASSERT_GTE(sketch.frequency(7), 1U);
+    ASSERT_LT(sketch.frequency(7), sketch.frequency(42));
+}
+
+TEST(FrequencySketchTest, FrequencySaturates) {
+    FrequencySketch sketch(16);
+    for (int i = 0; i < 100; ++i) {
+        sketch.increment(42);
+    }
+    ASSERT_EQUALS(sketch.frequency(42), FrequencySketch::kMaxFrequency);
+}
+
+TEST(FrequencySketchTest, FrequenciesAgeOverTime) {
+    FrequencySketch sketch(16);
+    for (int i = 0; i < 100; ++i) {
+        sketch.increment(42);
+    }
+
+    // Accesses to other keys eventually halve all the counters.
+    bool aged = false;
+    for (int key = 1000; key < 2000 && !aged; ++key) {
+        sketch.increment(key);
+        aged = sketch.frequency(42) < FrequencySketch::kMaxFrequency;
+    }
+    ASSERT_TRUE(aged);
+}
+
+TEST(FrequencySketchTest, GrowingKeepsFrequencies) {
+    FrequencySketch sketch(16);
+    for (int i = 0; i < 5; ++i) {
+        sketch.increment(42);
+    }
+    sketch.ensureCapacity(1024);
+    ASSERT_GTE(sketch.frequency(42), 5U);
+}
+
+TEST(FrequencySketchTest, ClearForgetsFrequencies) {
+    FrequencySketch sketch(16);
+    sketch.increment(42);
+    sketch.clear();
+    ASSERT_EQUALS(sketch.frequency(42), 0U);
+}
+
+/**
+ * Test that we can add an entry and get it back out.
+ */
+TEST(TinyLFUKeyValueTest, BasicAddGet) {
+    Cache cache(100, 100);
+    ASSERT_TRUE(cache.add(1, new int(2)).empty());
+    assertInKVStore(cache, 1, 2);
+    ASSERT_EQUALS(cache.size(), 1U);
+    ASSERT_EQUALS(cache.budget(), 1U);
+}
+
+TEST(TinyLFUKeyValueTest, SizeZeroCache) {
+    Cache cache(0, 0);
+    auto evicted = cache.add(1, new int(2));
+    ASSERT_EQUALS(evicted.size(), 1U);
+    ASSERT_EQUALS(*evicted[0], 2);
+    assertNotInKVStore(cache, 1);
+    ASSERT_TRUE(cache.wasEvicted(1));
+}
+
+TEST(TinyLFUKeyValueTest, ReplaceKeyTest) {
+    Cache cache(10, 10);
+    cache.add(4, new int(4));
+    assertInKVStore(cache, 4, 4);
+    cache.add(4, new int(5));
+    assertInKVStore(cache, 4, 5);
+    ASSERT_EQUALS(cache.size(), 1U);
+}
+
+TEST(TinyLFUKeyValueTest, RemoveTest) {
+    Cache cache(10, 10);
+    cache.add(4, new int(4));
+    ASSERT_OK(cache.remove(4));
+    assertNotInKVStore(cache, 4);
+    ASSERT_NOT_OK(cache.remove(4));
+    ASSERT_FALSE(cache.wasEvicted(4));
+    ASSERT_EQUALS(cache.budget(), 0U);
+}
+
+/**
+ * Fill up the kv-store, access every entry except one, then add a new entry. The entry which was
+ * never accessed loses against the new one and is evicted.
+ */
+TEST(TinyLFUKeyValueTest, EvictsLeastFrequentlyUsedEntry) {
+    const int maxSize = 10;
+    Cache cache(maxSize, maxSize);
+    for (int i = 0; i < maxSize; ++i) {
+        ASSERT_TRUE(cache.add(i, new int(i)).empty());
+    }
+
+    const int evictKey = 5;
+    for (int i = 0; i < maxSize; ++i) {
+        if (i != evictKey) {
+            access(cache, i, 2);
+        }
+    }
+
+    // Accessing the new key before adding it makes it more popular than 'evictKey'.
+    access(cache, maxSize, 2);
+    auto evicted = cache.add(maxSize, new int(maxSize));
+    ASSERT_EQUALS(evicted.size(), 1U);
+    ASSERT_EQUALS(*evicted[0], evictKey);
+    ASSERT_EQUALS(cache.size(), static_cast<size_t>(maxSize));
+    ASSERT_TRUE(cache.wasEvicted(evictKey));
+
+    for (int i = 0; i <= maxSize; ++i) {
+        if (i == evictKey) {
+            assertNotInKVStore(cache, i);
+        } else {
+            assertInKVStore(cache, i, i);
+        }
+    }
+
+    // Adding the key back makes the store forget about its eviction.
+    cache.add(evictKey, new int(evictKey));
+    ASSERT_FALSE(cache.wasEvicted(evictKey));
+}
+
+/**
+ * Keys which are only seen once cannot push frequently accessed entries out of the kv-store.
+ */
+TEST(TinyLFUKeyValueTest, ScanDoesNotEvictFrequentlyUsedEntries) {
+    const int maxSize = 100;
+    Cache cache(maxSize, maxSize);
+    for (int i = 0; i < maxSize; ++i) {
+        cache.add(i, new int(i));
+        access(cache, i, 3);
+    }
+
+    for (int i = maxSize; i < 10 * maxSize; ++i) {
+        cache.add(i, new int(i));
+    }
+
+    // Apart from the window, which holds the most recently added entry, the kv-store still holds
+    // the frequently accessed entries.
+    ASSERT_EQUALS(cache.size(), static_cast<size_t>(maxSize));
+    size_t numFrequentlyUsed = 0;
+    cache.forEach([&](int key, int) { numFrequentlyUsed += key < maxSize; });
+    ASSERT_EQUALS(numFrequentlyUsed, static_cast<size_t>(maxSize - 1));
+}
+
+/**
+ * A large entry must not evict many small, frequently accessed entries.
+ */
+TEST(TinyLFUKeyValueTest, LargeEntryDoesNotEvictFrequentlyUsedEntries) {
+    TinyLFUKeyValue<int, int, ValueBudgetEstimator> cache(1000, 1000);
+    for (int i = 1; i <= 50; ++i) {
+        cache.add(i, new int(10));
+        access(cache, i, 3);
+    }
+    ASSERT_EQUALS(cache.budget(), 500U);
+
+    auto evicted = cache.add(1000, new int(900));
+    ASSERT_EQUALS(evicted.size(), 1U);
+    ASSERT_EQUALS(*evicted[0], 900);
+    ASSERT_EQUALS(cache.size(), 50U);
+    ASSERT_EQUALS(cache.budget(), 500U);
+}
+
+/**
+ * Once a large entry is accessed more often than the entries it would replace, it is admitted.
+ */
+TEST(TinyLFUKeyValueTest, FrequentlyUsedLargeEntryIsAdmitted) {
+    TinyLFUKeyValue<int, int, ValueBudgetEstimator> cache(1000, 1000);
+    for (int i = 1; i <= 50; ++i) {
+        cache.add(i, new int(10));
+    }
+
+    access(cache, 1000, 5);
+    auto evicted = cache.add(1000, new int(900));
+    assertInKVStore(cache, 1000, 900);
+    ASSERT_LTE(cache.budget(), 1000U);
+    ASSERT_EQUALS(cache.size() + evicted.size(), 51U);
+}
+
+TEST(TinyLFUKeyValueTest, ClearTest) {
+    Cache cache(0, 0);
+    cache.add(1, new int(1));
+    ASSERT_TRUE(cache.wasEvicted(1));
+    cache.clear();
+    ASSERT_FALSE(cache.wasEvicted(1));
+    ASSERT_EQUALS(cache.size(), 0U);
+}
+
+}  // namespace
@@ -205,6 +205,27 @@ std::set<FieldRef> getWildcardMultikeyPathSet(const WildcardAccessMethod* wam,
     return getWildcardMultikeyPathSetHelper(wam, opCtx, indexBounds, stats);
 }
 
+std::set<FieldRef> getWildcardMultikeyPathSet(const std::set<std::string>& multikeyPaths,
+                                              const stdx::unordered_set<std::string>& fieldSet) {
+    std::set<FieldRef> result;
+    for (const auto& field : fieldSet) {
+        for (const auto& interval : getMultikeyPathIndexIntervalsForField(FieldRef(field))) {
+            const auto start = interval.start.str();
+            const auto end = interval.end.str();
+            auto it = interval.startInclusive ? multikeyPaths.lower_bound(start)
+                                              : multikeyPaths.upper_bound(start);
+            for (; it != multikeyPaths.end(); ++it) {
+                const int cmp = it->compare(end);
+                if (cmp > 0 || (cmp == 0 && !interval.endInclusive)) {
+                    break;
+                }
+                result.emplace(*it);
+            }
+        }
+    }
+    return result;
+}
+
 std::set<FieldRef> getWildcardMultikeyPathSet(const WildcardAccessMethod* wam,
                                               OperationContext* opCtx,
                                               MultikeyMetadataAccessStats* stats) {
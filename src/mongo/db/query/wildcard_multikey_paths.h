@@ -59,6 +59,13 @@ std::set<FieldRef> getWildcardMultikeyPathSet(const WildcardAccessMethod* wam,
                                               const stdx::unordered_set<std::string>& fieldSet,
                                               MultikeyMetadataAccessStats* stats);
 
+/**
+ * Returns the intersection of 'fields' and 'multikeyPaths', the full set of multikey metadata
+ * paths of a wildcard index, selecting the same paths as the index scan above would.
+ */
+std::set<FieldRef> getWildcardMultikeyPathSet(const std::set<std::string>& multikeyPaths,
+                                              const stdx::unordered_set<std::string>& fieldSet);
+
 /**
  * Returns the set of all paths for which the wildcard index has multikey metadata keys.
  * Statistics reporting index seeks and keys examined are written to 'stats'.
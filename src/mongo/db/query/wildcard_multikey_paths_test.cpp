@@ -0,0 +1,69 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/wildcard_multikey_paths.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::set<FieldRef> toFieldRefs(std::initializer_list<std::string> paths) {
+    std::set<FieldRef> result;
+    for (auto&& path : paths) {
+        result.emplace(path);
+    }
+    return result;
+}
+
+const std::set<std::string> kMultikeyPaths{"a", "a.b", "a.b.c", "a.bc", "a.d", "ab", "b", "b.c"};
+
+TEST(WildcardMultikeyPathsTest, FilterSelectsEveryPrefixOfAField) {
+    ASSERT(getWildcardMultikeyPathSet(kMultikeyPaths, {"a.b.c"}) ==
+           toFieldRefs({"a", "a.b", "a.b.c"}));
+    ASSERT(getWildcardMultikeyPathSet(kMultikeyPaths, {"b.c", "ab.x"}) ==
+           toFieldRefs({"ab", "b", "b.c"}));
+}
+
+TEST(WildcardMultikeyPathsTest, FilterSelectsSubpathsOfNumericPathComponents) {
+    ASSERT(getWildcardMultikeyPathSet(kMultikeyPaths, {"a.0"}) ==
+           toFieldRefs({"a", "a.b", "a.b.c", "a.bc", "a.d"}));
+    ASSERT(getWildcardMultikeyPathSet(kMultikeyPaths, {"a.b.0.c"}) ==
+           toFieldRefs({"a", "a.b", "a.b.c"}));
+}
+
+TEST(WildcardMultikeyPathsTest, FilterReturnsNothingForUnrelatedFields) {
+    ASSERT(getWildcardMultikeyPathSet(kMultikeyPaths, {"c", "c.a"}).empty());
+    ASSERT(getWildcardMultikeyPathSet(std::set<std::string>{}, {"a.b"}).empty());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -53,6 +53,7 @@
 #include "mongo/db/repl/replication_consistency_markers_impl.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_coordinator_impl.h"
+#include "mongo/db/repl/replication_metrics.h"
 #include "mongo/db/repl/replication_process.h"
 #include "mongo/db/repl/rollback_source_impl.h"
 #include "mongo/db/repl/rs_rollback.h"
@@ -63,6 +64,7 @@
 #include "mongo/rpc/metadata/repl_set_metadata.h"
 #include "mongo/util/str.h"
 #include "mongo/util/testing_proctor.h"
+#include "mongo/util/timer.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -657,8 +659,12 @@ Status BackgroundSync::_enqueueDocuments(OplogFetcher::Documents::const_iterator
 
     auto opCtx = cc().makeOperationContext();
 
-    // Wait for enough space.
+    // Wait for enough space. Time spent here means the applier is the bottleneck.
+    Timer waitTimer;
     _oplogApplier->waitForSpace(opCtx.get(), info.toApplyDocumentBytes);
+    if (auto waited = Milliseconds(waitTimer.millis()); waited > Milliseconds(0)) {
+        ReplicationMetrics::get(opCtx.get()).recordOplogBufferWait(waited);
+    }
 
     {
         // Don't add more to the buffer if we are in shutdown. Continue holding the lock until we
@@ -679,6 +685,8 @@ Status BackgroundSync::_enqueueDocuments(OplogFetcher::Documents::const_iterator
                     "Batch resetting _lastOpTimeFetched",
                     "lastOpTimeFetched"_attr = _lastOpTimeFetched);
     }
+    ReplicationMetrics::get(opCtx.get())
+        .recordOplogBatchFetched(info.toApplyDocumentCount, info.toApplyDocumentBytes);
 
     // Check some things periodically (whenever we run out of items in the current cursor batch).
     if (!oplogFetcherUsesExhaust && info.networkDocumentBytes > 0 &&
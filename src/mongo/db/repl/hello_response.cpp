@@ -211,11 +211,22 @@ void HelloResponse::addToBSON(BSONObjBuilder* builder, bool useLegacyResponseFie
 }
 
 BSONObj HelloResponse::toBSON(bool useLegacyResponseFields) const {
+    if (_serializedFormsCached) {
+        return useLegacyResponseFields ? _serializedLegacy : _serialized;
+    }
+
     BSONObjBuilder builder;
     addToBSON(&builder, useLegacyResponseFields);
     return builder.obj();
 }
 
+void HelloResponse::cacheSerializedForms() {
+    _serializedFormsCached = false;
+    _serialized = toBSON(false /* useLegacyResponseFields */);
+    _serializedLegacy = toBSON(true /* useLegacyResponseFields */);
+    _serializedFormsCached = true;
+}
+
 Status HelloResponse::initialize(const BSONObj& doc) {
     Status status = bsonExtractBooleanField(doc, kIsMasterFieldName, &_isWritablePrimary);
     if (!status.isOK()) {
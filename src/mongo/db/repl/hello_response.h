@@ -32,6 +32,7 @@
 #include <string>
 #include <vector>
 
+#include "mongo/bson/bsonobj.h"
 #include "mongo/bson/oid.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/repl/optime_with.h"
@@ -42,7 +43,6 @@
 
 namespace mongo {
 
-class BSONObj;
 class BSONObjBuilder;
 class Status;
 
@@ -74,10 +74,20 @@ public:
 
     /**
      * Returns a BSONObj consisting the results of calling addToBSON on an otherwise empty
-     * BSONObjBuilder.
+     * BSONObjBuilder. After cacheSerializedForms() has been called, returns the cached object
+     * instead, which shares its buffer with every other caller.
      */
     BSONObj toBSON(bool useLegacyResponseFields = true) const;
 
+    /**
+     * Serializes this response in both its hello and its legacy isMaster form and keeps the
+     * results for toBSON() to hand out. Used for responses that are shared between all the
+     * awaitable hello requests woken up by a topology change, so that they are serialized once
+     * rather than once per request. Must be called after all fields are set and before the
+     * response is shared between threads.
+     */
+    void cacheSerializedForms();
+
 
     // ===================== Accessors for member variables ================================= //
 
@@ -294,6 +304,11 @@ private:
     // If _shutdownInProgress is true toBSON will return a set of hardcoded values to indicate
     // that we are mid shutdown
     bool _shutdownInProgress;
+
+    // Set by cacheSerializedForms(), after which toBSON() returns these instead of serializing.
+    bool _serializedFormsCached = false;
+    BSONObj _serialized;
+    BSONObj _serializedLegacy;
 };
 
 }  // namespace repl
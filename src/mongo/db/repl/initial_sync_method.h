@@ -0,0 +1,65 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "mongo/base/status.h"
+#include "mongo/base/string_data.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace repl {
+
+/**
+ * The values accepted by the 'initialSyncMethod' server parameter. The logical initial syncer
+ * clones every collection from the sync source and rebuilds its indexes. The file copy based
+ * initial syncer copies the sync source's storage files through a backup cursor instead, and is
+ * only registered with the InitialSyncerFactory in builds that provide backup cursors.
+ */
+constexpr StringData kLogicalInitialSyncMethod = "logical"_sd;
+constexpr StringData kFileCopyBasedInitialSyncMethod = "fileCopyBased"_sd;
+
+/**
+ * Rejects an 'initialSyncMethod' which names neither initial syncer, so that a misspelled method
+ * fails at startup rather than silently falling back to logical initial sync.
+ */
+inline Status validateInitialSyncMethod(const std::string& method) {
+    if (method != kLogicalInitialSyncMethod && method != kFileCopyBasedInitialSyncMethod) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "Invalid initialSyncMethod '" << method << "'. Valid options are: "
+                              << kFileCopyBasedInitialSyncMethod << ", "
+                              << kLogicalInitialSyncMethod};
+    }
+    return Status::OK();
+}
+
+}  // namespace repl
+}  // namespace mongo
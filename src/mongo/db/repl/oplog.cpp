@@ -125,6 +125,9 @@ MONGO_FAIL_POINT_DEFINE(sleepBetweenInsertOpTimeGenerationAndLogOp);
 // are visible, but before we have advanced 'lastApplied' for the write.
 MONGO_FAIL_POINT_DEFINE(hangBeforeLogOpAdvancesLastApplied);
 
+// Set while a TimestampGroupedWritesBlock is in scope.
+const auto timestampGroupedWrites = OperationContext::declareDecoration<bool>();
+
 void abortIndexBuilds(OperationContext* opCtx,
                       const OplogEntry::CommandType& commandType,
                       const NamespaceString& nss,
@@ -1090,6 +1093,19 @@ StatusWith<OplogApplication::Mode> OplogApplication::parseMode(const std::string
     MONGO_UNREACHABLE;
 }
 
+TimestampGroupedWritesBlock::TimestampGroupedWritesBlock(OperationContext* opCtx)
+    : _opCtx(opCtx), _wasActive(timestampGroupedWrites(opCtx)) {
+    timestampGroupedWrites(opCtx) = true;
+}
+
+TimestampGroupedWritesBlock::~TimestampGroupedWritesBlock() {
+    timestampGroupedWrites(_opCtx) = _wasActive;
+}
+
+bool TimestampGroupedWritesBlock::isActive(OperationContext* opCtx) {
+    return timestampGroupedWrites(opCtx);
+}
+
 // @return failure status if an update should have happened and the document DNE.
 // See replset initial sync code.
 Status applyOperation_inlock(OperationContext* opCtx,
@@ -1182,11 +1198,12 @@ Status applyOperation_inlock(OperationContext* opCtx,
             // of a non-atomic applyOps command, but we ignore it so that we don't violate oplog
             // ordering.
             return false;
-        } else if (haveWrappingWriteUnitOfWork) {
+        } else if (haveWrappingWriteUnitOfWork && !TimestampGroupedWritesBlock::isActive(opCtx)) {
             // We do not assign timestamps to non-replicated writes that have a wrapping
             // WriteUnitOfWork, as they will get the timestamp on that WUOW. Use cases include: (1)
             // Atomic applyOps (used by sharding). (2) Secondary oplog application of prepared
-            // transactions.
+            // transactions. Grouped updates and deletes of secondary oplog application are
+            // timestamped individually.
             return false;
         } else {
             switch (replMode) {
@@ -202,6 +202,30 @@ inline std::ostream& operator<<(std::ostream& s, OplogApplication::Mode mode) {
     return (s << OplogApplication::modeToString(mode));
 }
 
+/**
+ * While in scope, applyOperation_inlock() timestamps the writes of the CRUD oplog entries it
+ * applies even though they are wrapped in a WriteUnitOfWork. This allows secondary oplog
+ * application to apply several oplog entries in a single storage transaction, each of them at its
+ * own timestamp. The entries must be applied in timestamp order.
+ */
+class TimestampGroupedWritesBlock {
+    TimestampGroupedWritesBlock(const TimestampGroupedWritesBlock&) = delete;
+    TimestampGroupedWritesBlock& operator=(const TimestampGroupedWritesBlock&) = delete;
+
+public:
+    explicit TimestampGroupedWritesBlock(OperationContext* opCtx);
+    ~TimestampGroupedWritesBlock();
+
+    /**
+     * Returns true if a TimestampGroupedWritesBlock is in scope for 'opCtx'.
+     */
+    static bool isActive(OperationContext* opCtx);
+
+private:
+    OperationContext* const _opCtx;
+    const bool _wasActive;
+};
+
 /**
  * Used for applying from an oplog entry or grouped inserts.
  * @param opOrGroupedInserts a single oplog entry or grouped inserts to be applied.
@@ -0,0 +1,285 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <limits>
+
+#include "mongo/db/logical_session_id.h"
+#include "mongo/db/repl/oplog_applier_impl.h"
+#include "mongo/db/repl/oplog_applier_impl_test_fixture.h"
+#include "mongo/db/repl/oplog_buffer_blocking_queue.h"
+#include "mongo/db/repl/oplog_entry_test_helpers.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+/**
+ * Measures secondary oplog application throughput. Every iteration pushes one batch worth of
+ * synthetic oplog entries into an OplogBuffer and then runs the same steps as the steady state
+ * applier loop: OplogBatcher::getNextApplierBatch() followed by OplogApplierImpl::applyOplogBatch()
+ * against a WiredTiger storage engine.
+ *
+ * Besides entries per second, each benchmark reports the average time per batch spent in:
+ *   batcherMicros    - pulling the batch out of the buffer.
+ *   fillWriterMicros - assigning the batch to writer vectors, measured on a copy of the batch
+ *                      with the benchmark timer paused.
+ *   applyMicros      - applyOplogBatch(), which writes the batch to the oplog, fills the writer
+ *                      vectors again and applies them on the writer pool.
+ */
+
+const NamespaceString kNss("oplog_applier_bm.coll");
+constexpr int kPreloadedDocs = 10'000;
+constexpr int kOpsPerTransaction = 10;
+
+enum class Workload { kInsert, kUpdate, kDelete, kTransaction };
+
+class OplogApplierBenchmarkFixture : public OplogApplierImplTest {
+public:
+    OplogApplierBenchmarkFixture(int numIndexes, int writerThreads)
+        : OplogApplierImplTest("wiredTiger") {
+        setUp();
+        uassertStatusOK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+
+        _uuid = createCollectionWithUuid(_opCtx.get(), kNss);
+        createCollectionWithUuid(_opCtx.get(), NamespaceString::kSessionTransactionsTableNamespace);
+        for (int i = 0; i < numIndexes; ++i) {
+            auto field = "a" + std::to_string(i);
+            createIndex(_opCtx.get(),
+                        kNss,
+                        _uuid,
+                        BSON("v" << 2 << "key" << BSON(field << 1) << "name" << field + "_1"));
+        }
+
+        _writerPool = makeReplWriterPool(writerThreads);
+        _applier = std::make_unique<OplogApplierImpl>(
+            nullptr,  // executor
+            &_buffer,
+            &_observer,
+            getReplCoord(),
+            getConsistencyMarkers(),
+            getStorageInterface(),
+            OplogApplier::Options(OplogApplication::Mode::kSecondary),
+            _writerPool.get());
+    }
+
+    ~OplogApplierBenchmarkFixture() {
+        _applier.reset();
+        _writerPool->shutdown();
+        _writerPool->join();
+        tearDown();
+    }
+
+    OperationContext* opCtx() {
+        return _opCtx.get();
+    }
+
+    OplogApplierImpl* applier() {
+        return _applier.get();
+    }
+
+    /**
+     * Returns 'count' entries of the given workload with increasing optimes.
+     */
+    std::vector<OplogEntry> makeEntries(Workload workload, int count) {
+        std::vector<OplogEntry> entries;
+        entries.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            switch (workload) {
+                case Workload::kInsert:
+                    entries.push_back(
+                        makeInsertDocumentOplogEntry(_nextOpTime(), kNss, _makeDoc(_nextId++)));
+                    break;
+                case Workload::kUpdate: {
+                    auto id = _nextUpdateId++ % kPreloadedDocs;
+                    auto diff = BSON("$v" << 2 << "diff" << BSON("u" << BSON("a0" << _nextId++)));
+                    entries.push_back(makeUpdateDocumentOplogEntry(
+                        _nextOpTime(), kNss, BSON("_id" << id), diff));
+                    break;
+                }
+                case Workload::kDelete:
+                    entries.push_back(makeDeleteDocumentOplogEntry(
+                        _nextOpTime(), kNss, BSON("_id" << _nextDeleteId++)));
+                    break;
+                case Workload::kTransaction: {
+                    BSONArrayBuilder ops;
+                    for (int j = 0; j < kOpsPerTransaction; ++j) {
+                        ops.append(makeInsertApplyOpsEntry(kNss, _uuid, _makeDoc(_nextId++)));
+                    }
+                    entries.push_back(makeCommandOplogEntryWithSessionInfoAndStmtIds(
+                        _nextOpTime(),
+                        NamespaceString("admin.$cmd"),
+                        BSON("applyOps" << ops.arr()),
+                        makeLogicalSessionIdForTest(),
+                        1,
+                        {StmtId(0)}));
+                    break;
+                }
+            }
+        }
+        return entries;
+    }
+
+    /**
+     * Applies 'entries' outside of any measurement, e.g. to create the documents that updates and
+     * deletes target.
+     */
+    void applyUntimed(std::vector<OplogEntry> entries) {
+        uassertStatusOK(_applier->applyOplogBatch(opCtx(), std::move(entries)));
+    }
+
+    void enqueue(const std::vector<OplogEntry>& entries) {
+        _applier->enqueue(opCtx(), entries.begin(), entries.end());
+    }
+
+private:
+    OpTime _nextOpTime() {
+        return OpTime(Timestamp(Seconds(1), _nextOpTimeInc++), 1LL);
+    }
+
+    static BSONObj _makeDoc(long long id) {
+        BSONObjBuilder bob;
+        bob.append("_id", id);
+        for (int i = 0; i < 8; ++i) {
+            bob.append("a" + std::to_string(i), id * (i + 1));
+        }
+        return bob.obj();
+    }
+
+    UUID _uuid = UUID::gen();
+    OplogBufferBlockingQueue _buffer;
+    NoopOplogApplierObserver _observer;
+    std::unique_ptr<ThreadPool> _writerPool;
+    std::unique_ptr<OplogApplierImpl> _applier;
+
+    unsigned _nextOpTimeInc = 1;
+    long long _nextId = 0;
+    long long _nextUpdateId = 0;
+    long long _nextDeleteId = 0;
+};
+
+/**
+ * Runs 'workload' in batches of 'batchLimitOps' entries, using 'writerThreads' writer threads and
+ * a collection with 'numIndexes' secondary indexes.
+ */
+void runApplierBenchmark(benchmark::State& state,
+                         Workload workload,
+                         int numIndexes,
+                         int writerThreads,
+                         int batchLimitOps) {
+    OplogApplierBenchmarkFixture fixture(numIndexes, writerThreads);
+
+    if (workload == Workload::kUpdate) {
+        fixture.applyUntimed(fixture.makeEntries(Workload::kInsert, kPreloadedDocs));
+    }
+
+    OplogApplier::BatchLimits limits;
+    limits.ops = batchLimitOps;
+    limits.bytes = std::numeric_limits<std::size_t>::max();
+
+    long long entriesApplied = 0;
+    long long batcherMicros = 0;
+    long long fillWriterMicros = 0;
+    long long applyMicros = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        if (workload == Workload::kDelete) {
+            // Deletes need documents to remove. The inserts happen in their own batch, which is
+            // not measured.
+            fixture.applyUntimed(fixture.makeEntries(Workload::kInsert, batchLimitOps));
+        }
+        fixture.enqueue(fixture.makeEntries(workload, batchLimitOps));
+        state.ResumeTiming();
+
+        Timer batcherTimer;
+        auto batch =
+            uassertStatusOK(fixture.applier()->getNextApplierBatch(fixture.opCtx(), limits));
+        batcherMicros += batcherTimer.micros();
+
+        state.PauseTiming();
+        {
+            auto ops = batch;
+            std::vector<std::vector<const OplogEntry*>> writerVectors(writerThreads);
+            std::vector<std::vector<OplogEntry>> derivedOps;
+            Timer fillWriterTimer;
+            fixture.applier()->fillWriterVectors_forTest(
+                fixture.opCtx(), &ops, &writerVectors, &derivedOps);
+            fillWriterMicros += fillWriterTimer.micros();
+        }
+        state.ResumeTiming();
+
+        entriesApplied += batch.size();
+        Timer applyTimer;
+        uassertStatusOK(fixture.applier()->applyOplogBatch(fixture.opCtx(), std::move(batch)));
+        applyMicros += applyTimer.micros();
+    }
+
+    state.SetItemsProcessed(entriesApplied);
+    state.counters["batcherMicros"] =
+        benchmark::Counter(batcherMicros, benchmark::Counter::kAvgIterations);
+    state.counters["fillWriterMicros"] =
+        benchmark::Counter(fillWriterMicros, benchmark::Counter::kAvgIterations);
+    state.counters["applyMicros"] =
+        benchmark::Counter(applyMicros, benchmark::Counter::kAvgIterations);
+}
+
+void BM_ApplyInserts(benchmark::State& state) {
+    runApplierBenchmark(state, Workload::kInsert, state.range(0), state.range(1), state.range(2));
+}
+
+void BM_ApplyUpdates(benchmark::State& state) {
+    runApplierBenchmark(state, Workload::kUpdate, state.range(0), state.range(1), state.range(2));
+}
+
+void BM_ApplyDeletes(benchmark::State& state) {
+    runApplierBenchmark(state, Workload::kDelete, state.range(0), state.range(1), state.range(2));
+}
+
+void BM_ApplyTransactions(benchmark::State& state) {
+    runApplierBenchmark(
+        state, Workload::kTransaction, state.range(0), state.range(1), state.range(2));
+}
+
+void ApplierArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"indexes", "writers", "batchOps"});
+    b->ArgsProduct({{0, 2, 8}, {1, 4, 16}, {100, 5000}});
+}
+
+BENCHMARK(BM_ApplyInserts)->Apply(ApplierArgs)->UseRealTime();
+BENCHMARK(BM_ApplyUpdates)->Apply(ApplierArgs)->UseRealTime();
+BENCHMARK(BM_ApplyDeletes)->Apply(ApplierArgs)->UseRealTime();
+BENCHMARK(BM_ApplyTransactions)->Apply(ApplierArgs)->UseRealTime();
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
@@ -1961,6 +1961,102 @@ TEST_F(OplogApplierImplTest,
     ASSERT_EQUALS(1U, numFailedGroupedInserts);
 }
 
+TEST_F(OplogApplierImplTest,
+       OplogApplicationThreadFuncGroupsUpdatesAndDeletesOnSameNamespaceInOneWriteUnitOfWork) {
+    NamespaceString nss("test." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    createCollectionWithUuid(_opCtx.get(), nss);
+
+    int seconds = 1;
+    std::vector<OplogEntry> insertOps;
+    for (int i = 0; i < 4; ++i) {
+        insertOps.push_back(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(seconds++), 0), 1LL}, nss, BSON("_id" << i)));
+    }
+    ASSERT_OK(runOpsSteadyState(insertOps));
+
+    // {update_0}, {update_1}, {delete_2}, {delete_3}
+    std::vector<OplogEntry> operationsToApply;
+    for (int i = 0; i < 2; ++i) {
+        operationsToApply.push_back(
+            makeUpdateDocumentOplogEntry({Timestamp(Seconds(seconds++), 0), 1LL},
+                                         nss,
+                                         BSON("_id" << i),
+                                         BSON("_id" << i << "x" << 1)));
+    }
+    for (int i = 2; i < 4; ++i) {
+        operationsToApply.push_back(makeDeleteDocumentOplogEntry(
+            {Timestamp(Seconds(seconds++), 0), 1LL}, nss, BSON("_id" << i)));
+    }
+
+    // Record the storage snapshot each write was made in. The snapshot id changes whenever a
+    // top-level WriteUnitOfWork commits or aborts.
+    std::vector<SnapshotId> snapshotIds;
+    _opObserver->onUpdateFn = [&](OperationContext* opCtx, const OplogUpdateEntryArgs&) {
+        snapshotIds.push_back(opCtx->recoveryUnit()->getSnapshotId());
+    };
+    _opObserver->onDeleteFn = [&](OperationContext* opCtx,
+                                  const NamespaceString&,
+                                  OptionalCollectionUUID,
+                                  StmtId,
+                                  const OpObserver::OplogDeleteEntryArgs&) {
+        snapshotIds.push_back(opCtx->recoveryUnit()->getSnapshotId());
+    };
+
+    ASSERT_OK(runOpsSteadyState(operationsToApply));
+
+    ASSERT_EQUALS(operationsToApply.size(), snapshotIds.size());
+    for (const auto& snapshotId : snapshotIds) {
+        ASSERT(snapshotId == snapshotIds.front());
+    }
+
+    AutoGetCollectionForReadCommand autoColl(_opCtx.get(), nss);
+    ASSERT_EQUALS(2, autoColl.getCollection()->numRecords(_opCtx.get()));
+}
+
+TEST_F(OplogApplierImplTest,
+       OplogApplicationThreadFuncFallsBackOnApplyingUpdatesAndDeletesIndividuallyWhenGroupFails) {
+    NamespaceString nss("test." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    createCollectionWithUuid(_opCtx.get(), nss);
+
+    int seconds = 1;
+    std::vector<OplogEntry> insertOps;
+    for (int i = 0; i < 3; ++i) {
+        insertOps.push_back(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(seconds++), 0), 1LL}, nss, BSON("_id" << i)));
+    }
+    ASSERT_OK(runOpsSteadyState(insertOps));
+
+    std::vector<OplogEntry> operationsToApply;
+    for (int i = 0; i < 3; ++i) {
+        operationsToApply.push_back(makeDeleteDocumentOplogEntry(
+            {Timestamp(Seconds(seconds++), 0), 1LL}, nss, BSON("_id" << i)));
+    }
+
+    // Reject the first delete, which aborts the grouped write unit of work.
+    std::size_t numFailedDeletes = 0;
+    std::vector<SnapshotId> snapshotIds;
+    _opObserver->onDeleteFn = [&](OperationContext* opCtx,
+                                  const NamespaceString&,
+                                  OptionalCollectionUUID,
+                                  StmtId,
+                                  const OpObserver::OplogDeleteEntryArgs&) {
+        if (numFailedDeletes++ == 0) {
+            uasserted(ErrorCodes::OperationFailed, "grouped deletes not supported");
+        }
+        snapshotIds.push_back(opCtx->recoveryUnit()->getSnapshotId());
+    };
+
+    ASSERT_OK(runOpsSteadyState(operationsToApply));
+
+    // Every delete was applied again on its own, each in a separate write unit of work.
+    ASSERT_EQUALS(operationsToApply.size(), snapshotIds.size());
+    ASSERT(snapshotIds[0] != snapshotIds[1]);
+    ASSERT(snapshotIds[1] != snapshotIds[2]);
+
+    AutoGetCollectionForReadCommand autoColl(_opCtx.get(), nss);
+    ASSERT_EQUALS(0, autoColl.getCollection()->numRecords(_opCtx.get()));
+}
+
 TEST_F(OplogApplierImplTest, ApplyGroupIgnoresUpdateOperationIfDocumentIsMissingFromSyncSource) {
     TestApplyOplogGroupApplier oplogApplier(
         nullptr, nullptr, OplogApplier::Options(OplogApplication::Mode::kInitialSync));
@@ -223,6 +223,29 @@ TEST_F(OplogApplierTest, GetNextApplierBatchChecksBatchLimitsForNumberOfOperatio
     ASSERT_EQUALS(srcOps[4], batch[1]);
 }
 
+TEST_F(OplogApplierTest, GetNextApplierBatchDoesNotReuseDeferredOpAfterBufferIsCleared) {
+    std::vector<OplogEntry> srcOps;
+    srcOps.push_back(makeInsertOplogEntry(1, NamespaceString(dbName, "bar")));
+    srcOps.push_back(makeInsertOplogEntry(2, NamespaceString(dbName, "bar")));
+    _applier->enqueue(_opCtx.get(), srcOps.cbegin(), srcOps.cend());
+
+    // The second insert ends the first batch and stays in the buffer.
+    _limits.ops = 1U;
+    auto batch = unittest::assertGet(_applier->getNextApplierBatch(_opCtx.get(), _limits));
+    ASSERT_EQUALS(1U, batch.size()) << toString(batch);
+    ASSERT_EQUALS(srcOps[0], batch[0]);
+
+    // Replace the contents of the buffer. The next batch must be built from the new operation.
+    _buffer->clear(_opCtx.get());
+    std::vector<OplogEntry> newOps;
+    newOps.push_back(makeInsertOplogEntry(3, NamespaceString(dbName, "foo")));
+    _applier->enqueue(_opCtx.get(), newOps.cbegin(), newOps.cend());
+
+    batch = unittest::assertGet(_applier->getNextApplierBatch(_opCtx.get(), _limits));
+    ASSERT_EQUALS(1U, batch.size()) << toString(batch);
+    ASSERT_EQUALS(newOps[0], batch[0]);
+}
+
 TEST_F(OplogApplierTest, GetNextApplierBatchChecksBatchLimitsForSizeOfOperations) {
     std::vector<OplogEntry> srcOps;
     srcOps.push_back(makeInsertOplogEntry(1, NamespaceString(dbName, "bar")));
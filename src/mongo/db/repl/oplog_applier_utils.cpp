@@ -39,6 +39,7 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/repl/oplog_applier_utils.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/db/repl/update_delete_group.h"
 #include "mongo/db/stats/counters.h"
 
 #include "mongo/logv2/log.h"
@@ -289,6 +290,8 @@ Status OplogApplierUtils::applyOplogBatchCommon(
     stableSortByNamespace(ops);
     InsertGroup insertGroup(
         ops, opCtx, oplogApplicationMode, isDataConsistent, applyOplogEntryOrGroupedInserts);
+    UpdateDeleteGroup updateDeleteGroup(
+        ops, opCtx, oplogApplicationMode, isDataConsistent, applyOplogEntryOrGroupedInserts);
 
     for (auto it = ops->cbegin(); it != ops->cend(); ++it) {
         const OplogEntry& entry = **it;
@@ -301,6 +304,13 @@ Status OplogApplierUtils::applyOplogBatchCommon(
             continue;
         }
 
+        // Likewise for a group of updates and deletes.
+        groupResult = updateDeleteGroup.groupAndApplyUpdatesAndDeletes(it);
+        if (groupResult.isOK()) {
+            it = groupResult.getValue();
+            continue;
+        }
+
         // If we didn't create a group, try to apply the op individually.
         try {
             const Status status = applyOplogEntryOrGroupedInserts(
@@ -160,7 +160,7 @@ StatusWith<std::vector<OplogEntry>> OplogBatcher::getNextApplierBatch(
     std::vector<OplogEntry> ops;
     BSONObj op;
     while (_oplogBuffer->peek(opCtx, &op)) {
-        auto entry = OplogEntry(op);
+        auto entry = _parsePeekedOp(op);
 
         // Check for oplog version change.
         if (entry.getVersion() != OplogEntry::kOplogVersion) {
@@ -186,6 +186,7 @@ StatusWith<std::vector<OplogEntry>> OplogBatcher::getNextApplierBatch(
                     // reconfigs and shutdown to occur.
                     sleepsecs(1);
                 }
+                _deferredEntry = std::move(entry);
                 return std::move(ops);
             }
         }
@@ -197,6 +198,7 @@ StatusWith<std::vector<OplogEntry>> OplogBatcher::getNextApplierBatch(
             }
 
             // Otherwise, apply what we have so far and come back for this entry.
+            _deferredEntry = std::move(entry);
             return std::move(ops);
         }
 
@@ -205,6 +207,7 @@ StatusWith<std::vector<OplogEntry>> OplogBatcher::getNextApplierBatch(
         auto opBytes = entry.getRawObjSizeBytes();
         if (totalOps > 0) {
             if (totalOps + opCount > batchLimits.ops || totalBytes + opBytes > batchLimits.bytes) {
+                _deferredEntry = std::move(entry);
                 return std::move(ops);
             }
         }
@@ -213,6 +216,7 @@ StatusWith<std::vector<OplogEntry>> OplogBatcher::getNextApplierBatch(
         if (totalOps > 0 && !batchLimits.forceBatchBoundaryAfter.isNull() &&
             entry.getOpTime().getTimestamp() > batchLimits.forceBatchBoundaryAfter &&
             ops.back().getOpTime().getTimestamp() <= batchLimits.forceBatchBoundaryAfter) {
+            _deferredEntry = std::move(entry);
             return std::move(ops);
         }
 
@@ -251,6 +255,18 @@ void OplogBatcher::_consume(OperationContext* opCtx, OplogBuffer* oplogBuffer) {
     invariant(oplogBuffer->tryPop(opCtx, &opToPopAndDiscard) || _oplogApplier->inShutdown());
 }
 
+OplogEntry OplogBatcher::_parsePeekedOp(const BSONObj& op) {
+    auto deferredEntry = std::move(_deferredEntry);
+    _deferredEntry.reset();
+
+    // The deferred entry holds a reference to the document it was parsed from, so its buffer
+    // cannot have been reused for a different operation while it stayed in the OplogBuffer.
+    if (deferredEntry && deferredEntry->getEntry().getRaw().objdata() == op.objdata()) {
+        return std::move(*deferredEntry);
+    }
+    return OplogEntry(op);
+}
+
 void OplogBatcher::_run(StorageInterface* storageInterface) {
     Client::initThread("ReplBatcher");
 
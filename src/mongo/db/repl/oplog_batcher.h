@@ -197,6 +197,13 @@ private:
      */
     void _consume(OperationContext* opCtx, OplogBuffer* oplogBuffer);
 
+    /**
+     * Returns the parsed form of 'op', the operation at the front of the OplogBuffer. Reuses the
+     * entry kept by the previous call to getNextApplierBatch() if it was parsed from the same
+     * document and left in the buffer at a batch boundary.
+     */
+    OplogEntry _parsePeekedOp(const BSONObj& op);
+
     void _run(StorageInterface* storageInterface);
 
     OplogApplier* _oplogApplier;
@@ -210,6 +217,12 @@ private:
      */
     OplogBatch _ops;
 
+    /**
+     * The parsed operation that ended the last batch without being consumed. Only accessed by the
+     * thread calling getNextApplierBatch().
+     */
+    boost::optional<OplogEntry> _deferredEntry;
+
     std::unique_ptr<stdx::thread> _thread;
 };
 
@@ -113,11 +113,10 @@ bool OplogBufferBlockingQueue::tryPop(OperationContext*, Value* value) {
 }
 
 bool OplogBufferBlockingQueue::waitForData(Seconds waitDuration) {
-    Value ignored;
     stdx::unique_lock<Latch> lk(_notEmptyMutex);
     _notEmptyCv.wait_for(
-        lk, waitDuration.toSystemDuration(), [&] { return _drainMode || _queue.peek(ignored); });
-    return _queue.peek(ignored);
+        lk, waitDuration.toSystemDuration(), [&] { return _drainMode || !_queue.empty(); });
+    return !_queue.empty();
 }
 
 bool OplogBufferBlockingQueue::peek(OperationContext*, Value* value) {
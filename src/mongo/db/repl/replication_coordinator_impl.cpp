@@ -69,6 +69,7 @@
 #include "mongo/db/repl/check_quorum_for_config_change.h"
 #include "mongo/db/repl/data_replicator_external_state_initial_sync.h"
 #include "mongo/db/repl/hello_response.h"
+#include "mongo/db/repl/initial_sync_method.h"
 #include "mongo/db/repl/initial_syncer_factory.h"
 #include "mongo/db/repl/isself.h"
 #include "mongo/db/repl/last_vote.h"
@@ -93,6 +94,7 @@
 #include "mongo/db/server_options.h"
 #include "mongo/db/session_catalog.h"
 #include "mongo/db/shutdown_in_progress_quiesce_info.h"
+#include "mongo/db/stats/timer_stats.h"
 #include "mongo/db/storage/control/journal_flusher.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/vector_clock.h"
@@ -170,6 +172,15 @@ ServerStatusMetricField<Counter64> displayNumAutoReconfigs(
     "repl.reconfig.numAutoReconfigsForRemovalOfNewlyAddedFields",
     &numAutoReconfigsForRemovalOfNewlyAddedFields);
 
+// Tracks how many write concern and opTime waiters were signaled as satisfied, and how long they
+// waited to be signaled.
+TimerStats replicationWaiterStats;
+ServerStatusMetricField<TimerStats> displayReplicationWaiterStats("repl.waiters.replication",
+                                                                  &replicationWaiterStats);
+TimerStats opTimeWaiterStats;
+ServerStatusMetricField<TimerStats> displayOpTimeWaiterStats("repl.waiters.opTime",
+                                                             &opTimeWaiterStats);
+
 using namespace fmt::literals;
 
 using CallbackArgs = executor::TaskExecutor::CallbackArgs;
@@ -207,22 +218,43 @@ constexpr StringData kQuiesceModeShutdownMessage =
 
 }  // namespace
 
+ReplicationCoordinatorImpl::WaiterList::WaitConditionKey
+ReplicationCoordinatorImpl::WaiterList::_makeKey(const boost::optional<WriteConcernOptions>& wc) {
+    if (!wc) {
+        return {false, std::string(), 0, 0, 0};
+    }
+    return {true,
+            wc->wMode,
+            wc->wMode.empty() ? wc->wNumNodes : 0,
+            static_cast<int>(wc->syncMode),
+            static_cast<int>(wc->checkCondition)};
+}
+
 void ReplicationCoordinatorImpl::WaiterList::add_inlock(const OpTime& opTime,
                                                         SharedWaiterHandle waiter) {
-    _waiters.emplace(opTime, std::move(waiter));
+    _waiters[_makeKey(waiter->writeConcern)].emplace(opTime, std::move(waiter));
 }
 
 SharedSemiFuture<void> ReplicationCoordinatorImpl::WaiterList::add_inlock(
     const OpTime& opTime, boost::optional<WriteConcernOptions> wc) {
     auto pf = makePromiseFuture<void>();
-    _waiters.emplace(opTime, std::make_shared<Waiter>(std::move(pf.promise), std::move(wc)));
+    auto& group = _waiters[_makeKey(wc)];
+    group.emplace(opTime, std::make_shared<Waiter>(std::move(pf.promise), std::move(wc)));
     return std::move(pf.future);
 }
 
 bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(SharedWaiterHandle waiter) {
-    for (auto iter = _waiters.begin(); iter != _waiters.end(); iter++) {
+    auto groupIt = _waiters.find(_makeKey(waiter->writeConcern));
+    if (groupIt == _waiters.end()) {
+        return false;
+    }
+    auto& group = groupIt->second;
+    for (auto iter = group.begin(); iter != group.end(); iter++) {
         if (iter->second == waiter) {
-            _waiters.erase(iter);
+            group.erase(iter);
+            if (group.empty()) {
+                _waiters.erase(groupIt);
+            }
             return true;
         }
     }
@@ -232,33 +264,41 @@ bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(SharedWaiterHandle wa
 template <typename Func>
 void ReplicationCoordinatorImpl::WaiterList::setValueIf_inlock(Func&& func,
                                                                boost::optional<OpTime> opTime) {
-    for (auto it = _waiters.begin(); it != _waiters.end() && (!opTime || it->first <= *opTime);) {
-        const auto& waiter = it->second;
-        try {
-            if (func(it->first, waiter)) {
+    for (auto groupIt = _waiters.begin(); groupIt != _waiters.end();) {
+        auto& group = groupIt->second;
+        for (auto it = group.begin(); it != group.end() && (!opTime || it->first <= *opTime);) {
+            const auto& waiter = it->second;
+            try {
+                if (!func(it->first, waiter)) {
+                    // The waiters after this one in the group cannot be satisfied either.
+                    break;
+                }
                 waiter->promise.emplaceValue();
-                it = _waiters.erase(it);
-            } else {
-                ++it;
+                it = group.erase(it);
+            } catch (const DBException& e) {
+                waiter->promise.setError(e.toStatus());
+                it = group.erase(it);
             }
-        } catch (const DBException& e) {
-            waiter->promise.setError(e.toStatus());
-            it = _waiters.erase(it);
         }
+        groupIt = group.empty() ? _waiters.erase(groupIt) : std::next(groupIt);
     }
 }
 
 void ReplicationCoordinatorImpl::WaiterList::setValueAll_inlock() {
-    for (auto& [opTime, waiter] : _waiters) {
-        waiter->promise.emplaceValue();
+    for (auto& [key, group] : _waiters) {
+        for (auto& [opTime, waiter] : group) {
+            waiter->promise.emplaceValue();
+        }
     }
     _waiters.clear();
 }
 
 void ReplicationCoordinatorImpl::WaiterList::setErrorAll_inlock(Status status) {
     invariant(!status.isOK());
-    for (auto& [opTime, waiter] : _waiters) {
-        waiter->promise.setError(status);
+    for (auto& [key, group] : _waiters) {
+        for (auto& [opTime, waiter] : group) {
+            waiter->promise.setError(status);
+        }
     }
     _waiters.clear();
 }
@@ -802,17 +842,23 @@ void ReplicationCoordinatorImpl::_startDataReplication(OperationContext* opCtx,
             if (repl::feature_flags::gFileCopyBasedInitialSync.isEnabledAndIgnoreFCV()) {
                 auto swInitialSyncer = createInitialSyncer(initialSyncMethod);
                 if (swInitialSyncer.getStatus().code() == ErrorCodes::NotImplemented &&
-                    initialSyncMethod != "logical") {
+                    initialSyncMethod != kLogicalInitialSyncMethod) {
                     LOGV2_WARNING(58154,
                                   "No such initial sync method was available. Falling back to "
                                   "logical initial sync.",
                                   "initialSyncMethod"_attr = initialSyncMethod,
                                   "error"_attr = swInitialSyncer.getStatus().reason());
-                    swInitialSyncer = createInitialSyncer(std::string("logical"));
+                    swInitialSyncer = createInitialSyncer(kLogicalInitialSyncMethod.toString());
                 }
                 initialSyncerCopy = uassertStatusOK(swInitialSyncer);
             } else {
-                auto swInitialSyncer = createInitialSyncer(std::string("logical"));
+                if (initialSyncMethod != kLogicalInitialSyncMethod) {
+                    LOGV2_WARNING(6000149,
+                                  "File copy based initial sync is not enabled. Falling back to "
+                                  "logical initial sync.",
+                                  "initialSyncMethod"_attr = initialSyncMethod);
+                }
+                auto swInitialSyncer = createInitialSyncer(kLogicalInitialSyncMethod.toString());
                 initialSyncerCopy = uassertStatusOK(swInitialSyncer);
             }
             _initialSyncer = initialSyncerCopy;
@@ -1388,7 +1434,11 @@ void ReplicationCoordinatorImpl::_setMyLastAppliedOpTimeAndWallTime(
     // Signal anyone waiting on optime changes.
     _opTimeWaiterList.setValueIf_inlock(
         [opTime](const OpTime& waitOpTime, const SharedWaiterHandle& waiter) {
-            return waitOpTime <= opTime;
+            if (waitOpTime > opTime) {
+                return false;
+            }
+            opTimeWaiterStats.record(waiter->timer);
+            return true;
         },
         opTime);
 
@@ -2327,6 +2377,16 @@ std::shared_ptr<const HelloResponse> ReplicationCoordinatorImpl::awaitHelloRespo
     // A topology change has happened so we return a HelloResponse with the updated
     // topology version.
     uassertStatusOK(status);
+
+    // All the requests waiting on this topology change have been woken up at once. Spread their
+    // replies over a short window, derived from the operation id so that no shared state is
+    // touched, to keep them from all competing for the CPU in the same instant.
+    const auto maxStaggerMillis = helloResponseStaggerMaxMillis.load();
+    if (maxStaggerMillis > 0) {
+        const auto opIdHash = static_cast<unsigned long long>(opCtx->getOpID()) * 2654435761ULL;
+        opCtx->sleepFor(Milliseconds(static_cast<long long>(opIdHash % (maxStaggerMillis + 1))));
+    }
+
     return statusWithHello.getValue();
 }
 
@@ -3030,6 +3090,8 @@ Status ReplicationCoordinatorImpl::processReplSetGetStatus(
         ReplicationMetrics::get(getServiceContext()).getElectionCandidateMetricsBSON();
     BSONObj electionParticipantMetrics =
         ReplicationMetrics::get(getServiceContext()).getElectionParticipantMetricsBSON();
+    BSONObj oplogPipelineMetrics =
+        ReplicationMetrics::get(getServiceContext()).getOplogPipelineMetricsBSON();
 
     stdx::lock_guard<Latch> lk(_mutex);
     if (_inShutdown) {
@@ -3049,6 +3111,9 @@ Status ReplicationCoordinatorImpl::processReplSetGetStatus(
             _externalState->tooStale()},
         response,
         &result);
+    if (result.isOK()) {
+        response->append("oplogPipelineMetrics", oplogPipelineMetrics);
+    }
     return result;
 }
 
@@ -4132,6 +4197,9 @@ void ReplicationCoordinatorImpl::_fulfillTopologyChangePromise(WithLock lock) {
         } else {
             StringData horizonString = iter->first;
             auto response = _makeHelloResponse(horizonString, lock, hasValidConfig);
+            // Every waiter on this horizon replies with the same response, so serialize it once
+            // here rather than once per waiter.
+            response->cacheSerializedForms();
             // Fulfill the promise and replace with a new one for future waiters.
             iter->second->emplaceValue(response);
             iter->second = std::make_shared<SharedPromise<std::shared_ptr<const HelloResponse>>>();
@@ -4152,6 +4220,7 @@ void ReplicationCoordinatorImpl::_fulfillTopologyChangePromise(WithLock lock) {
             } else {
                 const auto horizon = sni.empty() ? SplitHorizon::kDefaultHorizon : iter->second;
                 const auto response = _makeHelloResponse(horizon, lock, hasValidConfig);
+                response->cacheSerializedForms();
                 promise->emplaceValue(response);
             }
         }
@@ -4741,7 +4810,11 @@ void ReplicationCoordinatorImpl::_wakeReadyWaiters(WithLock lk, boost::optional<
     _replicationWaiterList.setValueIf_inlock(
         [this](const OpTime& opTime, const SharedWaiterHandle& waiter) {
             invariant(waiter->writeConcern);
-            return _doneWaitingForReplication_inlock(opTime, waiter->writeConcern.get());
+            if (!_doneWaitingForReplication_inlock(opTime, waiter->writeConcern.get())) {
+                return false;
+            }
+            replicationWaiterStats.record(waiter->timer);
+            return true;
         },
         opTime);
 }
@@ -31,6 +31,7 @@
 
 #include <map>
 #include <memory>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -58,6 +59,7 @@
 #include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/future.h"
 #include "mongo/util/net/hostandport.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -679,6 +681,8 @@ private:
     struct Waiter {
         Promise<void> promise;
         boost::optional<WriteConcernOptions> writeConcern;
+        // Started when the waiter is created, to measure how long it waits to be signaled.
+        Timer timer;
         explicit Waiter(Promise<void> p, boost::optional<WriteConcernOptions> w = boost::none)
             : promise(std::move(p)), writeConcern(w) {}
     };
@@ -695,7 +699,9 @@ private:
         // Returns whether waiter is found and removed.
         bool remove_inlock(SharedWaiterHandle waiter);
         // Signals all waiters whose opTime is <= the given opTime (if any) that satisfy the
-        // condition in func.
+        // condition in func. Once func returns false for a waiter, it must also return false for
+        // every waiter with a later opTime and the same write concern; the rest of that write
+        // concern's waiters are then skipped, so only the satisfied waiters are visited.
         template <typename Func>
         void setValueIf_inlock(Func&& func, boost::optional<OpTime> opTime = boost::none);
         // Signals all waiters from the list and fulfills promises with OK status.
@@ -704,8 +710,13 @@ private:
         void setErrorAll_inlock(Status status);
 
     private:
-        // Waiters sorted by OpTime.
-        std::multimap<OpTime, SharedWaiterHandle> _waiters;
+        // The parts of a waiter's write concern that decide whether it has been satisfied. Waiters
+        // without a write concern all share the empty key.
+        using WaitConditionKey = std::tuple<bool, std::string, int, int, int>;
+        static WaitConditionKey _makeKey(const boost::optional<WriteConcernOptions>& wc);
+
+        // Waiters grouped by the condition they wait for, each group sorted by OpTime.
+        std::map<WaitConditionKey, std::multimap<OpTime, SharedWaiterHandle>> _waiters;
     };
 
     enum class HeartbeatState { kScheduled = 0, kSent = 1 };
@@ -1123,6 +1123,55 @@ TEST_F(ReplCoordTest, NodeReturnsOkWhenAWriteConcernWithNoTimeoutHasBeenSatisfie
     awaiter.reset();
 }
 
+TEST_F(ReplCoordTest, NodeSignalsWaitersOfEachWriteConcernIndependently) {
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version" << 2 << "members"
+                            << BSON_ARRAY(BSON("host"
+                                               << "node1:12345"
+                                               << "_id" << 0)
+                                          << BSON("host"
+                                                  << "node2:12345"
+                                                  << "_id" << 1)
+                                          << BSON("host"
+                                                  << "node3:12345"
+                                                  << "_id" << 2))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    replCoordSetMyLastAppliedOpTime(OpTimeWithTermOne(100, 1), Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(OpTimeWithTermOne(100, 1), Date_t() + Seconds(100));
+    simulateSuccessfulV1Election();
+
+    OpTimeWithTermOne time1(100, 1);
+    OpTimeWithTermOne time2(100, 2);
+    replCoordSetMyLastAppliedOpTime(time2, Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(time2, Date_t() + Seconds(100));
+
+    WriteConcernOptions writeConcernAllNodes;
+    writeConcernAllNodes.wTimeout = WriteConcernOptions::kNoTimeout;
+    writeConcernAllNodes.wNumNodes = 3;
+    WriteConcernOptions writeConcernTwoNodes = writeConcernAllNodes;
+    writeConcernTwoNodes.wNumNodes = 2;
+
+    // A waiter for all nodes at the earlier optime must not hold back a waiter for two nodes at
+    // the later optime.
+    ReplicationAwaiter allNodesAwaiter(getReplCoord(), getServiceContext());
+    allNodesAwaiter.setOpTime(time1);
+    allNodesAwaiter.setWriteConcern(writeConcernAllNodes);
+    allNodesAwaiter.start();
+
+    ReplicationAwaiter twoNodesAwaiter(getReplCoord(), getServiceContext());
+    twoNodesAwaiter.setOpTime(time2);
+    twoNodesAwaiter.setWriteConcern(writeConcernTwoNodes);
+    twoNodesAwaiter.start();
+
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time2));
+    ASSERT_OK(twoNodesAwaiter.getResult().status);
+
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 2, time1));
+    ASSERT_OK(allNodesAwaiter.getResult().status);
+}
+
 
 TEST_F(ReplCoordTest, NodeCalculatesDefaultWriteConcernOnStartupExistingLocalConfigMajority) {
     assertStartSuccess(BSON("_id"
@@ -3461,6 +3510,45 @@ TEST_F(ReplCoordTest, AwaitHelloResponseReturnsOnStepDown) {
     getHelloThread.join();
 }
 
+TEST_F(ReplCoordTest, AwaitHelloWaitersShareSerializedResponseOnTopologyChange) {
+    init();
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version" << 1 << "members"
+                            << BSON_ARRAY(BSON("host"
+                                               << "node1:12345"
+                                               << "_id" << 0))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+
+    auto currentTopologyVersion = getTopoCoord().getTopologyVersion();
+    auto deadline = getNet()->now() + Milliseconds(5000);
+
+    auto waitForHelloFailPoint = globalFailPointRegistry().find("waitForHelloResponse");
+    auto timesEnteredFailPoint = waitForHelloFailPoint->setMode(FailPoint::alwaysOn, 0);
+    ON_BLOCK_EXIT([&] { waitForHelloFailPoint->setMode(FailPoint::off, 0); });
+
+    std::shared_ptr<const HelloResponse> responses[2];
+    auto awaitHello = [&](size_t i) {
+        responses[i] = awaitHelloWithNewOpCtx(getReplCoord(), currentTopologyVersion, {}, deadline);
+    };
+    stdx::thread firstHelloThread([&] { awaitHello(0); });
+    stdx::thread secondHelloThread([&] { awaitHello(1); });
+
+    // Both requests wait on the same topology change.
+    waitForHelloFailPoint->waitForTimesEntered(timesEnteredFailPoint + 2);
+    getReplCoord()->incrementTopologyVersion();
+    firstHelloThread.join();
+    secondHelloThread.join();
+
+    // The waiters are handed one response, which was serialized once for all of them.
+    ASSERT_EQ(responses[0].get(), responses[1].get());
+    ASSERT_EQ(responses[0]->getTopologyVersion()->getCounter(),
+              currentTopologyVersion.getCounter() + 1);
+    ASSERT(responses[0]->toBSON(false).objdata() == responses[1]->toBSON(false).objdata());
+    ASSERT(responses[0]->toBSON(true).objdata() == responses[1]->toBSON(true).objdata());
+}
+
 TEST_F(ReplCoordTest, HelloReturnsErrorOnEnteringQuiesceMode) {
     init();
     assertStartSuccess(BSON("_id"
@@ -39,6 +39,7 @@
 #include "mongo/db/service_context_d_test_fixture.h"
 #include "mongo/executor/network_interface_mock.h"
 #include "mongo/executor/task_executor.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -337,6 +338,9 @@ private:
 
     ReplSettings _settings;
     bool _callShutdown = false;
+
+    // The clocks are mocked, so the replies to a topology change must not wait on them.
+    RAIIServerParameterControllerForTest _helloResponseStagger{"helloResponseStaggerMaxMillis", 0};
 };
 
 }  // namespace repl
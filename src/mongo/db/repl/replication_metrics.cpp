@@ -379,6 +379,34 @@ void ReplicationMetrics::clearParticipantNewTermDates() {
     _electionParticipantMetrics.setNewTermAppliedDate(boost::none);
 }
 
+void ReplicationMetrics::recordOplogBatchFetched(long long numOps, long long numBytes) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _oplogPipelineMetrics.setNumFetchedBatches(_oplogPipelineMetrics.getNumFetchedBatches() + 1);
+    _oplogPipelineMetrics.setNumFetchedOps(_oplogPipelineMetrics.getNumFetchedOps() + numOps);
+    _oplogPipelineMetrics.setFetchedBytes(_oplogPipelineMetrics.getFetchedBytes() + numBytes);
+}
+
+void ReplicationMetrics::recordOplogBufferWait(Milliseconds waited) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _oplogPipelineMetrics.setNumWaitsForBufferSpace(
+        _oplogPipelineMetrics.getNumWaitsForBufferSpace() + 1);
+    _oplogPipelineMetrics.setWaitForBufferSpaceMillis(
+        _oplogPipelineMetrics.getWaitForBufferSpaceMillis() + durationCount<Milliseconds>(waited));
+}
+
+void ReplicationMetrics::recordOplogBatchApplied(long long numOps, Milliseconds elapsed) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _oplogPipelineMetrics.setNumAppliedBatches(_oplogPipelineMetrics.getNumAppliedBatches() + 1);
+    _oplogPipelineMetrics.setNumAppliedOps(_oplogPipelineMetrics.getNumAppliedOps() + numOps);
+    _oplogPipelineMetrics.setApplyMillis(_oplogPipelineMetrics.getApplyMillis() +
+                                         durationCount<Milliseconds>(elapsed));
+}
+
+BSONObj ReplicationMetrics::getOplogPipelineMetricsBSON() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _oplogPipelineMetrics.toBSON();
+}
+
 void ReplicationMetrics::_updateAverageCatchUpOps(WithLock lk) {
     long numCatchUps = _electionMetrics.getNumCatchUps();
     if (numCatchUps > 0) {
@@ -119,6 +119,14 @@ public:
     void setParticipantNewTermDates(Date_t newTermStartDate, Date_t newTermAppliedDate);
     void clearParticipantNewTermDates();
 
+    // Oplog pipeline metrics
+
+    void recordOplogBatchFetched(long long numOps, long long numBytes);
+    void recordOplogBufferWait(Milliseconds waited);
+    void recordOplogBatchApplied(long long numOps, Milliseconds elapsed);
+
+    BSONObj getOplogPipelineMetricsBSON();
+
 
 private:
     class ElectionMetricsSSS;
@@ -129,6 +137,7 @@ private:
     ElectionMetrics _electionMetrics;
     ElectionCandidateMetrics _electionCandidateMetrics;
     ElectionParticipantMetrics _electionParticipantMetrics;
+    OplogPipelineMetrics _oplogPipelineMetrics;
 
     bool _nodeIsCandidateOrPrimary = false;
     bool _nodeHasVotedInElection = false;
@@ -53,6 +53,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/repl/apply_ops.h"
 #include "mongo/db/repl/drop_pending_collection_reaper.h"
+#include "mongo/db/repl/oplog_applier.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_process.h"
 #include "mongo/db/repl/roll_back_local_operations.h"
@@ -652,6 +653,23 @@ void RollbackImpl::_correctRecordStoreCounts(OperationContext* opCtx) {
     // This function explicitly does not check for shutdown since a clean shutdown post oplog
     // truncation is not allowed to occur until the record store counts are corrected.
     auto catalog = CollectionCatalog::get(opCtx);
+
+    // Scan the collections whose counts could not be determined from the oplog up front, so that
+    // the scans can run in parallel.
+    std::vector<UUID> uuidsToScan;
+    for (const auto& uiCount : _newCounts) {
+        if (kCollectionScanRequired != uiCount.second) {
+            continue;
+        }
+        const auto coll = catalog->lookupCollectionByUUID(opCtx, uiCount.first);
+        if (coll &&
+            !sizeRecoveryState(opCtx->getServiceContext())
+                 .collectionAlwaysNeedsSizeAdjustment(coll->getRecordStore()->getIdent())) {
+            uuidsToScan.push_back(uiCount.first);
+        }
+    }
+    const auto scannedCounts = _countCollectionsByScan(opCtx, uuidsToScan);
+
     for (const auto& uiCount : _newCounts) {
         const auto uuid = uiCount.first;
         const auto coll = catalog->lookupCollectionByUUID(opCtx, uuid);
@@ -686,42 +704,16 @@ void RollbackImpl::_correctRecordStoreCounts(OperationContext* opCtx) {
         }
 
         // If _findRecordStoreCounts() is unable to determine the correct count from the oplog
-        // (most likely due to a 4.0 drop oplog entry without the count information), we will
-        // determine the correct count here post-recovery using a collection scan.
+        // (most likely due to a 4.0 drop oplog entry without the count information), we have
+        // determined the correct count post-recovery using a collection scan.
         if (kCollectionScanRequired == newCount) {
-            LOGV2(21602,
-                  "Scanning collection {namespace} ({uuid}) to fix collection count.",
-                  "Scanning collection to fix collection count",
-                  "namespace"_attr = nss.ns(),
-                  "uuid"_attr = uuid.toString());
-            AutoGetCollectionForRead collToScan(opCtx, nss);
-            invariant(coll == collToScan.getCollection(),
-                      str::stream() << "Catalog returned invalid collection: " << nss.ns() << " ("
-                                    << uuid.toString() << ")");
-            auto exec = collToScan->makePlanExecutor(opCtx,
-                                                     collToScan.getCollection(),
-                                                     PlanYieldPolicy::YieldPolicy::INTERRUPT_ONLY,
-                                                     Collection::ScanDirection::kForward);
-            long long countFromScan = 0;
-            PlanExecutor::ExecState state;
-            while (PlanExecutor::ADVANCED ==
-                   (state = exec->getNext(static_cast<BSONObj*>(nullptr), nullptr))) {
-                ++countFromScan;
-            }
-            if (PlanExecutor::IS_EOF != state) {
-                // We ignore errors here because crashing or leaving rollback would only leave
-                // collection counts more inaccurate.
-                LOGV2_WARNING(21637,
-                              "Failed to set count of {namespace} ({uuid}) [{ident}] due to failed "
-                              "collection scan: {error}",
-                              "Failed to set count of namespace due to failed collection scan",
-                              "namespace"_attr = nss.ns(),
-                              "uuid"_attr = uuid.toString(),
-                              "ident"_attr = ident,
-                              "error"_attr = exec->stateToStr(state));
+            auto it = scannedCounts.find(uuid);
+            if (it == scannedCounts.end()) {
+                // The scan failed and was logged. We ignore this because crashing or leaving
+                // rollback would only leave collection counts more inaccurate.
                 continue;
             }
-            newCount = countFromScan;
+            newCount = it->second;
         }
 
         auto status =
@@ -751,6 +743,94 @@ void RollbackImpl::_correctRecordStoreCounts(OperationContext* opCtx) {
     }
 }
 
+stdx::unordered_map<UUID, long long, UUID::Hash> RollbackImpl::_countCollectionsByScan(
+    OperationContext* opCtx, const std::vector<UUID>& uuids) {
+    // Returns the number of documents in the collection, or boost::none if the scan failed.
+    auto scanCollection = [](OperationContext* opCtx,
+                             const UUID& uuid) -> boost::optional<long long> {
+        const auto coll = CollectionCatalog::get(opCtx)->lookupCollectionByUUID(opCtx, uuid);
+        invariant(coll,
+                  str::stream() << "The collection with UUID " << uuid
+                                << " is unexpectedly missing in the CollectionCatalog");
+        const auto nss = coll->ns();
+        const auto ident = coll->getRecordStore()->getIdent();
+        LOGV2(21602,
+              "Scanning collection {namespace} ({uuid}) to fix collection count.",
+              "Scanning collection to fix collection count",
+              "namespace"_attr = nss.ns(),
+              "uuid"_attr = uuid.toString());
+        AutoGetCollectionForRead collToScan(opCtx, nss);
+        invariant(coll == collToScan.getCollection(),
+                  str::stream() << "Catalog returned invalid collection: " << nss.ns() << " ("
+                                << uuid.toString() << ")");
+        auto exec = collToScan->makePlanExecutor(opCtx,
+                                                 collToScan.getCollection(),
+                                                 PlanYieldPolicy::YieldPolicy::INTERRUPT_ONLY,
+                                                 Collection::ScanDirection::kForward);
+        long long countFromScan = 0;
+        PlanExecutor::ExecState state;
+        while (PlanExecutor::ADVANCED ==
+               (state = exec->getNext(static_cast<BSONObj*>(nullptr), nullptr))) {
+            ++countFromScan;
+        }
+        if (PlanExecutor::IS_EOF != state) {
+            LOGV2_WARNING(21637,
+                          "Failed to set count of {namespace} ({uuid}) [{ident}] due to failed "
+                          "collection scan: {error}",
+                          "Failed to set count of namespace due to failed collection scan",
+                          "namespace"_attr = nss.ns(),
+                          "uuid"_attr = uuid.toString(),
+                          "ident"_attr = ident,
+                          "error"_attr = exec->stateToStr(state));
+            return boost::none;
+        }
+        return countFromScan;
+    };
+
+    std::vector<boost::optional<long long>> scannedCounts(uuids.size());
+    const auto numThreads =
+        std::min(static_cast<size_t>(gRollbackCountScanThreads.load()), uuids.size());
+    if (numThreads <= 1) {
+        for (size_t i = 0; i < uuids.size(); ++i) {
+            scannedCounts[i] = scanCollection(opCtx, uuids[i]);
+        }
+    } else {
+        LOGV2(5910924,
+              "Scanning collections in parallel to fix collection counts",
+              "numCollections"_attr = uuids.size(),
+              "numThreads"_attr = numThreads);
+        auto pool = makeReplWriterPool(static_cast<int>(numThreads), "rollbackCountScan");
+        Mutex mutex = MONGO_MAKE_LATCH("RollbackImpl::_countCollectionsByScan::mutex");
+        Status scanStatus = Status::OK();
+        for (size_t i = 0; i < uuids.size(); ++i) {
+            pool->schedule([&, i](Status status) {
+                try {
+                    uassertStatusOK(status);
+                    auto scanOpCtx = cc().makeOperationContext();
+                    scannedCounts[i] = scanCollection(scanOpCtx.get(), uuids[i]);
+                } catch (const DBException& ex) {
+                    stdx::lock_guard<Latch> lk(mutex);
+                    if (scanStatus.isOK()) {
+                        scanStatus = ex.toStatus();
+                    }
+                }
+            });
+        }
+        pool->shutdown();
+        pool->join();
+        // An error in a scan would have escaped rollback if the scans ran on this thread.
+        uassertStatusOK(scanStatus);
+    }
+
+    stdx::unordered_map<UUID, long long, UUID::Hash> counts;
+    for (size_t i = 0; i < uuids.size(); ++i) {
+        if (scannedCounts[i]) {
+            counts.emplace(uuids[i], *scannedCounts[i]);
+        }
+    }
+    return counts;
+}
+
 Status RollbackImpl::_findRecordStoreCounts(OperationContext* opCtx) {
     auto catalog = CollectionCatalog::get(opCtx);
     auto storageEngine = opCtx->getServiceContext()->getStorageEngine();
@@ -414,6 +414,14 @@ private:
      */
     void _correctRecordStoreCounts(OperationContext* opCtx);
 
+    /**
+     * Counts the documents of each collection in 'uuids' with a collection scan, running up to
+     * 'rollbackCountScanThreads' scans in parallel. Collections whose scan failed are left out of
+     * the result.
+     */
+    stdx::unordered_map<UUID, long long, UUID::Hash> _countCollectionsByScan(
+        OperationContext* opCtx, const std::vector<UUID>& uuids);
+
     /**
      * Called after we have successfully recovered to the stable timestamp and recovered from the
      * oplog. Triggers the replication rollback OpObserver method, notifying other server subsystems
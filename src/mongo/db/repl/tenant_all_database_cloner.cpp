@@ -55,10 +55,12 @@ TenantAllDatabaseCloner::TenantAllDatabaseCloner(TenantMigrationSharedData* shar
                                                  DBClientConnection* client,
                                                  StorageInterface* storageInterface,
                                                  ThreadPool* dbPool,
-                                                 StringData tenantId)
+                                                 StringData tenantId,
+                                                 CreateClientFn createClientFn)
     : TenantBaseCloner(
           "TenantAllDatabaseCloner"_sd, sharedData, source, client, storageInterface, dbPool),
       _tenantId(tenantId),
+      _createClientFn(std::move(createClientFn)),
       _listDatabasesStage("listDatabases", this, &TenantAllDatabaseCloner::listDatabasesStage),
       _listExistingDatabasesStage(
           "listExistingDatabases", this, &TenantAllDatabaseCloner::listExistingDatabasesStage),
@@ -269,7 +271,8 @@ void TenantAllDatabaseCloner::postStage() {
                                                                             getClient(),
                                                                             getStorageInterface(),
                                                                             getDBPool(),
-                                                                            _tenantId);
+                                                                            _tenantId,
+                                                                            _createClientFn);
         }
         auto dbStatus = _currentDatabaseCloner->run();
         if (dbStatus.isOK()) {
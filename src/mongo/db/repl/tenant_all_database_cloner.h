@@ -61,7 +61,8 @@ public:
                             DBClientConnection* client,
                             StorageInterface* storageInterface,
                             ThreadPool* dbPool,
-                            StringData tenantId);
+                            StringData tenantId,
+                            CreateClientFn createClientFn = {});
 
     virtual ~TenantAllDatabaseCloner() = default;
 
@@ -133,6 +134,9 @@ private:
     // The database name prefix of the tenant associated with this migration.
     std::string _tenantId;  // (R)
 
+    // Passed on to the TenantDatabaseCloners to clone collections in parallel.
+    CreateClientFn _createClientFn;  // (R)
+
     TenantAllDatabaseClonerStage _listDatabasesStage;          // (R)
     TenantAllDatabaseClonerStage _listExistingDatabasesStage;  // (R)
     TenantAllDatabaseClonerStage _initializeStatsStage;        // (R)
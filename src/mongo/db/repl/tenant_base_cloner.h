@@ -29,6 +29,9 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+
 #include "mongo/base/checked_cast.h"
 #include "mongo/db/repl/base_cloner.h"
 #include "mongo/db/repl/tenant_migration_shared_data.h"
@@ -38,6 +41,11 @@ namespace repl {
 
 class TenantBaseCloner : public BaseCloner {
 public:
+    /**
+     * Type of function that opens a new authenticated connection to the donor.
+     */
+    using CreateClientFn = std::function<std::unique_ptr<DBClientConnection>()>;
+
     TenantBaseCloner(StringData clonerName,
                      TenantMigrationSharedData* sharedData,
                      const HostAndPort& source,
@@ -54,6 +54,31 @@ namespace repl {
 namespace {
 const int kProgressMeterSecondsBetween = 60;
 const int kProgressMeterCheckInterval = 128;
+
+/**
+ * Paces the donor reads of all tenant collection cloners on this node to
+ * 'tenantMigrationClonerMaxBytesPerSec'. Each batch is charged when it arrives, and the cloner that
+ * received it waits until the batch fits in the budget before reading the next one.
+ */
+class DonorReadThrottle {
+public:
+    /**
+     * Charges 'bytes' against the budget and returns how long the caller must wait.
+     */
+    Milliseconds charge(long long bytes, long long maxBytesPerSec) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        const auto now = Date_t::now();
+        _budgetAvailableAt =
+            std::max(_budgetAvailableAt, now) + Milliseconds(bytes * 1000 / maxBytesPerSec);
+        return _budgetAvailableAt - now;
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("DonorReadThrottle::_mutex");
+    Date_t _budgetAvailableAt;
+};
+
+DonorReadThrottle donorReadThrottle;
 }  // namespace
 
 // Failpoint which causes the tenant database cloner to hang after it has successfully run
@@ -486,11 +511,13 @@ void TenantCollectionCloner::runQuery() {
 }
 
 void TenantCollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
+    long long batchBytes = 0;
     {
         stdx::lock_guard<Latch> lk(_mutex);
         _stats.receivedBatches++;
         while (iter.moreInCurrentBatch()) {
             _documentsToInsert.emplace_back(iter.nextSafe());
+            batchBytes += _documentsToInsert.back().objsize();
         }
     }
 
@@ -505,6 +532,14 @@ void TenantCollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter)
         uassertStatusOK(newStatus);
     }
 
+    // Wait for the donor read budget while the batch is inserted.
+    if (auto maxBytesPerSec = tenantMigrationClonerMaxBytesPerSec.load(); maxBytesPerSec > 0) {
+        const auto deadline = Date_t::now() + donorReadThrottle.charge(batchBytes, maxBytesPerSec);
+        for (auto now = Date_t::now(); now < deadline && !mustExit(); now = Date_t::now()) {
+            sleepFor(std::min(deadline - now, Milliseconds(100)));
+        }
+    }
+
     tenantMigrationHangCollectionClonerAfterHandlingBatchResponse.executeIf(
         [&](const BSONObj&) {
             while (
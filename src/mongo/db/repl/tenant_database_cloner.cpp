@@ -32,16 +32,21 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/base/string_data.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/list_collections_filter.h"
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/repl/cloner_utils.h"
 #include "mongo/db/repl/database_cloner_gen.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/tenant_collection_cloner.h"
 #include "mongo/db/repl/tenant_database_cloner.h"
 #include "mongo/db/repl/tenant_migration_decoration.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace repl {
@@ -56,10 +61,12 @@ TenantDatabaseCloner::TenantDatabaseCloner(const std::string& dbName,
                                            DBClientConnection* client,
                                            StorageInterface* storageInterface,
                                            ThreadPool* dbPool,
-                                           StringData tenantId)
+                                           StringData tenantId,
+                                           CreateClientFn createClientFn)
     : TenantBaseCloner(
           "TenantDatabaseCloner"_sd, sharedData, source, client, storageInterface, dbPool),
       _dbName(dbName),
+      _createClientFn(std::move(createClientFn)),
       _listCollectionsStage("listCollections", this, &TenantDatabaseCloner::listCollectionsStage),
       _listExistingCollectionsStage(
           "listExistingCollections", this, &TenantDatabaseCloner::listExistingCollectionsStage),
@@ -233,6 +240,18 @@ BaseCloner::AfterStageBehavior TenantDatabaseCloner::listExistingCollectionsStag
         return kContinueNormally;
     }
 
+    if (_getNumCollectionCloningWorkers() > 1) {
+        // Collections are cloned in parallel, so any collection we have on disk may be partially
+        // cloned. Run a cloner for every collection; each resumes from its last document.
+        LOGV2(5910920,
+              "Tenant DatabaseCloner resumes cloning all collections in parallel",
+              "migrationId"_attr = getSharedData()->getMigrationId(),
+              "tenantId"_attr = _tenantId,
+              "dbName"_attr = _dbName,
+              "existingCollections"_attr = clonedCollectionUUIDs.size());
+        return kContinueNormally;
+    }
+
     // We are resuming, restart from the collection whose UUID compared greater than or equal to
     // the last collection we have on disk.
     if (!clonedCollectionUUIDs.empty()) {
@@ -290,6 +309,14 @@ void TenantDatabaseCloner::postStage() {
             _stats.collectionStats.back().ns = coll.first.ns();
         }
     }
+    if (auto numWorkers = _getNumCollectionCloningWorkers(); numWorkers > 1) {
+        _cloneCollectionsInParallel(numWorkers);
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_stats.clonedCollections == _collections.size()) {
+            _stats.end = getSharedData()->getClock()->now();
+        }
+        return;
+    }
     for (const auto& coll : _collections) {
         auto& sourceNss = coll.first;
         auto& collectionOptions = coll.second;
@@ -340,6 +367,149 @@ void TenantDatabaseCloner::postStage() {
     _stats.end = getSharedData()->getClock()->now();
 }
 
+size_t TenantDatabaseCloner::_getNumCollectionCloningWorkers() const {
+    if (!_createClientFn) {
+        return 1;
+    }
+    return std::min(static_cast<size_t>(tenantMigrationCollectionClonerConcurrency),
+                    std::max(_collections.size(), size_t(1)));
+}
+
+void TenantDatabaseCloner::_cloneCollectionsInParallel(size_t numWorkers) {
+    LOGV2_DEBUG(5910921,
+                1,
+                "Tenant database cloner cloning collections in parallel",
+                "db"_attr = _dbName,
+                "numCollections"_attr = _collections.size(),
+                "numWorkers"_attr = numWorkers,
+                "tenantId"_attr = _tenantId);
+
+    AtomicWord<size_t> nextCollection{0};
+    std::vector<stdx::thread> workers;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _numRunningWorkers = numWorkers;
+    }
+    for (size_t i = 0; i < numWorkers; ++i) {
+        workers.emplace_back(
+            [this, i, &nextCollection] { _collectionCloningWorker(i, &nextCollection); });
+    }
+
+    {
+        stdx::unique_lock<Latch> lk(_mutex);
+        while (!_workerFinishedCond.wait_for(lk, Milliseconds(100).toSystemDuration(), [&] {
+            return _numRunningWorkers == 0;
+        })) {
+            lk.unlock();
+            const bool canceled = mustExit();
+            lk.lock();
+            if (canceled) {
+                // Interrupts the donor reads of the workers, as closing the cloner's own
+                // connection does for a sequential clone.
+                for (auto client : _workerClients) {
+                    client->shutdownAndDisallowReconnect();
+                }
+            }
+        }
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void TenantDatabaseCloner::_collectionCloningWorker(size_t workerNum,
+                                                    AtomicWord<size_t>* nextCollection) {
+    ON_BLOCK_EXIT([&] {
+        stdx::lock_guard<Latch> lk(_mutex);
+        --_numRunningWorkers;
+        _workerFinishedCond.notify_all();
+    });
+
+    const std::string threadName = str::stream() << "TenantCollectionCloner-" << workerNum;
+    Client::initThread(threadName);
+    AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+    {
+        stdx::lock_guard<Client> lk(cc());
+        cc().setSystemOperationKillableByStepdown(lk);
+    }
+
+    std::unique_ptr<DBClientConnection> client;
+    try {
+        client = _createClientFn();
+    } catch (const DBException& ex) {
+        setSyncFailedStatus(ex.toStatus().withContext(
+            str::stream() << "Error connecting to donor to clone collections of database '"
+                          << _dbName << "'"));
+        return;
+    }
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _workerClients.push_back(client.get());
+    }
+    ON_BLOCK_EXIT([&] {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _workerClients.erase(std::find(_workerClients.begin(), _workerClients.end(), client.get()));
+    });
+
+    while (!mustExit()) {
+        const auto index = nextCollection->fetchAndAdd(1);
+        if (index >= _collections.size()) {
+            return;
+        }
+        const auto& sourceNss = _collections[index].first;
+        const auto& collectionOptions = _collections[index].second;
+
+        TenantCollectionCloner* collectionCloner;
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            auto& entry = _parallelCollectionCloners[index];
+            entry = std::make_unique<TenantCollectionCloner>(sourceNss,
+                                                             collectionOptions,
+                                                             getSharedData(),
+                                                             getSource(),
+                                                             client.get(),
+                                                             getStorageInterface(),
+                                                             getDBPool(),
+                                                             _tenantId);
+            collectionCloner = entry.get();
+        }
+        auto collStatus = collectionCloner->run();
+        if (collStatus.isOK()) {
+            LOGV2_DEBUG(5910922,
+                        1,
+                        "Tenant collection clone finished",
+                        "namespace"_attr = sourceNss,
+                        "worker"_attr = workerNum,
+                        "tenantId"_attr = _tenantId);
+        } else {
+            LOGV2_ERROR(5910923,
+                        "Tenant collection clone failed",
+                        "namespace"_attr = sourceNss,
+                        "worker"_attr = workerNum,
+                        "error"_attr = collStatus.toString(),
+                        "tenantId"_attr = _tenantId);
+        }
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _stats.collectionStats[index] = collectionCloner->getStats();
+            _stats.approxTotalBytesCopied += _stats.collectionStats[index].approxTotalBytesCopied;
+            _parallelCollectionCloners.erase(index);
+            if (collStatus.isOK()) {
+                _stats.clonedCollections++;
+            }
+        }
+        if (!collStatus.isOK()) {
+            // Failing the clone makes the other workers stop after their current collection.
+            setSyncFailedStatus({collStatus.code(),
+                                 collStatus
+                                     .withContext(str::stream() << "Error cloning collection '"
+                                                                << sourceNss.toString() << "'")
+                                     .toString()});
+            return;
+        }
+    }
+}
+
 TenantDatabaseCloner::Stats TenantDatabaseCloner::getStats() const {
     stdx::lock_guard<Latch> lk(_mutex);
     TenantDatabaseCloner::Stats stats = _stats;
@@ -348,6 +518,10 @@ TenantDatabaseCloner::Stats TenantDatabaseCloner::getStats() const {
         stats.approxTotalBytesCopied +=
             stats.collectionStats[stats.clonedCollections].approxTotalBytesCopied;
     }
+    for (auto&& [index, collectionCloner] : _parallelCollectionCloners) {
+        stats.collectionStats[index] = collectionCloner->getStats();
+        stats.approxTotalBytesCopied += stats.collectionStats[index].approxTotalBytesCopied;
+    }
     return stats;
 }
 
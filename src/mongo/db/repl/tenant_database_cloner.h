@@ -29,12 +29,15 @@
 
 #pragma once
 
+#include <map>
 #include <vector>
 
 #include "mongo/db/repl/base_cloner.h"
 #include "mongo/db/repl/tenant_base_cloner.h"
 #include "mongo/db/repl/tenant_collection_cloner.h"
 #include "mongo/db/repl/tenant_migration_shared_data.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
 
 namespace mongo {
 namespace repl {
@@ -63,7 +66,8 @@ public:
                          DBClientConnection* client,
                          StorageInterface* storageInterface,
                          ThreadPool* dbPool,
-                         StringData tenantId);
+                         StringData tenantId,
+                         CreateClientFn createClientFn = {});
 
     virtual ~TenantDatabaseCloner() = default;
 
@@ -116,6 +120,24 @@ private:
      */
     void postStage() final;
 
+    /**
+     * Returns the number of workers that clone the collections of this database in parallel, or 1
+     * if they are cloned one after another on the cloner's own connection.
+     */
+    size_t _getNumCollectionCloningWorkers() const;
+
+    /**
+     * Clones '_collections' on 'numWorkers' threads, each with its own donor connection, and waits
+     * for all of them to finish. Closes the worker connections if the clone is canceled.
+     */
+    void _cloneCollectionsInParallel(size_t numWorkers);
+
+    /**
+     * Body of a parallel cloning worker. Claims collections from '*nextCollection' until there are
+     * none left or the clone fails.
+     */
+    void _collectionCloningWorker(size_t workerNum, AtomicWord<size_t>* nextCollection);
+
     // All member variables are labeled with one of the following codes indicating the
     // synchronization rules for accessing them.
     //
@@ -129,6 +151,18 @@ private:
     std::vector<std::pair<NamespaceString, CollectionOptions>> _collections;  // (X)
     std::unique_ptr<TenantCollectionCloner> _currentCollectionCloner;         // (MX)
 
+    // Opens the donor connections of the parallel cloning workers. When not set, collections are
+    // always cloned one after another.
+    CreateClientFn _createClientFn;  // (R)
+
+    // Collection cloners running on parallel cloning workers, by index into '_collections'.
+    std::map<size_t, std::unique_ptr<TenantCollectionCloner>> _parallelCollectionCloners;  // (M)
+
+    // Donor connections of the running parallel cloning workers, owned by the workers.
+    std::vector<DBClientConnection*> _workerClients;  // (M)
+    size_t _numRunningWorkers{0};                      // (M)
+    stdx::condition_variable _workerFinishedCond;      // (S)
+
     TenantDatabaseClonerStage _listCollectionsStage;          // (R)
     TenantDatabaseClonerStage _listExistingCollectionsStage;  // (R)
 
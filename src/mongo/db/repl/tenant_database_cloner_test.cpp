@@ -36,6 +36,7 @@
 #include "mongo/db/repl/tenant_database_cloner.h"
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/dbtests/mock/mock_dbclient_connection.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
 #include "mongo/util/concurrency/thread_pool.h"
@@ -58,6 +59,7 @@ protected:
         _storageInterface.createCollFn = [this](OperationContext* opCtx,
                                                 const NamespaceString& nss,
                                                 const CollectionOptions& options) -> Status {
+            stdx::lock_guard<Latch> lk(_collectionsMutex);
             const auto collInfo = &_collections[nss];
             collInfo->collCreated = true;
             collInfo->numDocsInserted = 0;
@@ -72,6 +74,7 @@ protected:
         _storageInterface.insertDocumentsFn = [this](OperationContext* opCtx,
                                                      const NamespaceStringOrUUID& nsOrUUID,
                                                      const std::vector<InsertStatement>& ops) {
+            stdx::lock_guard<Latch> lk(_collectionsMutex);
             const auto collInfo = &_collections[nsOrUUID.nss().get()];
             collInfo->numDocsInserted += ops.size();
             return Status::OK();
@@ -81,14 +84,16 @@ protected:
     }
 
     std::unique_ptr<TenantDatabaseCloner> makeDatabaseCloner(
-        TenantMigrationSharedData* sharedData = nullptr) {
+        TenantMigrationSharedData* sharedData = nullptr,
+        TenantDatabaseCloner::CreateClientFn createClientFn = {}) {
         return std::make_unique<TenantDatabaseCloner>(_dbName,
                                                       sharedData ? sharedData : getSharedData(),
                                                       _source,
                                                       _mockClient.get(),
                                                       &_storageInterface,
                                                       _dbWorkThreadPool.get(),
-                                                      _tenantId);
+                                                      _tenantId,
+                                                      std::move(createClientFn));
     }
 
     BSONObj createListCollectionsResponse(const std::vector<BSONObj>& collections) {
@@ -126,6 +131,8 @@ protected:
         return cloner->_collections;
     }
 
+    // Guards '_collections', which parallel cloning workers update concurrently.
+    Mutex _collectionsMutex = MONGO_MAKE_LATCH("TenantDatabaseClonerTest::_collectionsMutex");
     std::map<NamespaceString, TenantCollectionCloneInfo> _collections;
 
     const std::string _dbName = _tenantId + "_testDb";
@@ -531,6 +538,74 @@ TEST_F(TenantDatabaseClonerTest, CreateCollections) {
     ASSERT_EQUALS(0, collInfo.numDocsInserted);
 }
 
+TEST_F(TenantDatabaseClonerTest, CreateCollectionsInParallel) {
+    RAIIServerParameterControllerForTest concurrency("tenantMigrationCollectionClonerConcurrency",
+                                                     2);
+    const BSONObj idIndexSpec = BSON("v" << 1 << "key" << BSON("_id" << 1) << "name"
+                                         << "_id_");
+    std::vector<BSONObj> sourceInfos;
+    for (auto name : {"a", "b", "c"}) {
+        sourceInfos.push_back(BSON("name" << name << "type"
+                                          << "collection"
+                                          << "options" << BSONObj() << "info"
+                                          << BSON("readOnly" << false << "uuid" << UUID::gen())));
+    }
+    _mockServer->setCommandReply("listCollections", createListCollectionsResponse(sourceInfos));
+    _mockServer->setCommandReply("find", createFindResponse());
+    _mockServer->setCommandReply("count", createCountResponse(0));
+    _mockServer->setCommandReply("listIndexes",
+                                 createCursorResponse(_dbName + ".a", BSON_ARRAY(idIndexSpec)));
+
+    // Each worker clones over its own connection to the donor.
+    AtomicWord<int> numWorkerClients{0};
+    auto cloner = makeDatabaseCloner(nullptr, [&] {
+        numWorkerClients.fetchAndAdd(1);
+        return std::make_unique<MockDBClientConnection>(_mockServer.get());
+    });
+    ASSERT_OK(cloner->run());
+    ASSERT_EQ(2, numWorkerClients.load());
+
+    ASSERT_EQUALS(3U, _collections.size());
+    for (auto name : {"a", "b", "c"}) {
+        auto collInfo = _collections[NamespaceString{_dbName, name}];
+        ASSERT(collInfo.collCreated);
+        ASSERT_EQUALS(0, collInfo.numDocsInserted);
+    }
+
+    auto stats = cloner->getStats();
+    ASSERT_EQ(3, stats.collections);
+    ASSERT_EQ(3, stats.clonedCollections);
+    ASSERT_EQ(_dbName + ".a", stats.collectionStats[0].ns);
+    ASSERT_EQ(_dbName + ".c", stats.collectionStats[2].ns);
+    ASSERT_EQ(_clock.now(), stats.end);
+}
+
+TEST_F(TenantDatabaseClonerTest, ParallelCloningStopsOnCollectionFailure) {
+    RAIIServerParameterControllerForTest concurrency("tenantMigrationCollectionClonerConcurrency",
+                                                     2);
+    std::vector<BSONObj> sourceInfos;
+    for (auto name : {"a", "b", "c"}) {
+        sourceInfos.push_back(BSON("name" << name << "type"
+                                          << "collection"
+                                          << "options" << BSONObj() << "info"
+                                          << BSON("readOnly" << false << "uuid" << UUID::gen())));
+    }
+    _mockServer->setCommandReply("listCollections", createListCollectionsResponse(sourceInfos));
+    _mockServer->setCommandReply("find", createFindResponse());
+    _mockServer->setCommandReply("count", createCountResponse(0));
+    _mockServer->setCommandReply("listIndexes",
+                                 BSON("ok" << 0 << "errmsg"
+                                           << "fake message"
+                                           << "code" << ErrorCodes::CursorNotFound));
+
+    auto cloner = makeDatabaseCloner(
+        nullptr, [&] { return std::make_unique<MockDBClientConnection>(_mockServer.get()); });
+    auto status = cloner->run();
+    ASSERT_EQ(ErrorCodes::CursorNotFound, status.code());
+    ASSERT_EQ(0, cloner->getStats().clonedCollections);
+    ASSERT_NOT_OK(getSharedData()->getStatus(WithLock::withoutLock()));
+}
+
 TEST_F(TenantDatabaseClonerTest, DatabaseAndCollectionStats) {
     auto uuid1 = UUID::gen();
     auto uuid2 = UUID::gen();
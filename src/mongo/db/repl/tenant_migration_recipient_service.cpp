@@ -1525,7 +1525,14 @@ Future<void> TenantMigrationRecipientService::Instance::_startTenantAllDatabaseC
         _client.get(),
         repl::StorageInterface::get(cc().getServiceContext()),
         _writerPool.get(),
-        _tenantId);
+        _tenantId,
+        [this, donorHost = _client->getServerHostAndPort()] {
+            // Each connection used to clone collections in parallel is authenticated like the
+            // main cloner connection.
+            return _connectAndAuth(donorHost,
+                                   "TenantMigration_" + getTenantId() + "_" +
+                                       getMigrationUUID().toString() + "_cloner");
+        });
     LOGV2_DEBUG(4881100,
                 1,
                 "Starting TenantAllDatabaseCloner",
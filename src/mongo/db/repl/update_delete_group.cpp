@@ -0,0 +1,156 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kReplication
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/update_delete_group.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/repl/oplog.h"
+#include "mongo/db/repl/oplog_applier_utils.h"
+#include "mongo/db/repl/oplog_entry.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace repl {
+
+namespace {
+
+// Limit number of ops in a single group.
+constexpr auto kUpdateDeleteGroupMaxOpCount = 64;
+
+}  // namespace
+
+UpdateDeleteGroup::UpdateDeleteGroup(std::vector<const OplogEntry*>* ops,
+                                     OperationContext* opCtx,
+                                     Mode mode,
+                                     const bool isDataConsistent,
+                                     ApplyFunc applyOplogEntryOrGroupedInserts)
+    : _doNotGroupBeforePoint(ops->cbegin()),
+      _end(ops->cend()),
+      _opCtx(opCtx),
+      _mode(mode),
+      _isDataConsistent(isDataConsistent),
+      _applyOplogEntryOrGroupedInserts(applyOplogEntryOrGroupedInserts) {}
+
+bool UpdateDeleteGroup::_isGroupable(const OplogEntry& entry) {
+    // Retryable findAndModify images are upserted into 'config.image_collection', which may
+    // conflict with other writers and is retried separately, and a missing document in a capped
+    // collection is tolerated by the individual application only.
+    return (entry.getOpType() == OpTypeEnum::kUpdate ||
+            entry.getOpType() == OpTypeEnum::kDelete) &&
+        !entry.isForCappedCollection() && !entry.getNeedsRetryImage() &&
+        !entry.getNss().isSystemDotViews();
+}
+
+StatusWith<UpdateDeleteGroup::ConstIterator> UpdateDeleteGroup::groupAndApplyUpdatesAndDeletes(
+    ConstIterator it) noexcept {
+    const auto& entry = **it;
+
+    // The following conditions must be met before attempting to group the oplog entries starting
+    // at 'it':
+    // 1) We are applying oplog entries on a secondary in steady state;
+    // 2) The CRUD operation must be an update or a delete on a non-capped collection;
+    // 3) We have not attempted to group this op during a previous call to this function.
+    if (_mode != Mode::kSecondary || !oplogApplicationGroupUpdatesAndDeletes.load()) {
+        return Status(ErrorCodes::InvalidOptions,
+                      "Can only group updates and deletes in secondary oplog application.");
+    }
+    if (!_isGroupable(entry)) {
+        return Status(ErrorCodes::TypeMismatch, "Can only group update and delete operations.");
+    }
+    if (it < _doNotGroupBeforePoint) {
+        return Status(ErrorCodes::InvalidPath,
+                      "Cannot group an operation that we previously attempted to group.");
+    }
+
+    const auto& groupNamespace = entry.getNss();
+    auto opCount = std::vector<const OplogEntry*>::size_type(1);
+    auto endOfGroupableOpsIterator =
+        std::find_if(it + 1, _end, [&](const OplogEntry* nextEntry) -> bool {
+            opCount += 1;
+            return !_isGroupable(*nextEntry)                   // Must be an update or a delete.
+                || nextEntry->getNss() != groupNamespace       // Must be in the same namespace.
+                || opCount > kUpdateDeleteGroupMaxOpCount;     // Limit number of ops in a group.
+        });
+
+    // See if we were able to create a group that contains more than a single op.
+    if (std::distance(it, endOfGroupableOpsIterator) == 1) {
+        return Status(ErrorCodes::NoSuchKey,
+                      "Not able to create a group with more than a single operation");
+    }
+
+    try {
+        writeConflictRetry(_opCtx, "applyGroupedUpdatesAndDeletes", groupNamespace.ns(), [&] {
+            // Hold the collection lock for the whole group. The application of each operation
+            // takes it again recursively.
+            AutoGetCollection autoColl(
+                _opCtx, OplogApplierUtils::getNsOrUUID(groupNamespace, entry), MODE_IX);
+            TimestampGroupedWritesBlock timestampGroupedWrites(_opCtx);
+
+            WriteUnitOfWork wuow(_opCtx);
+            for (auto groupIt = it; groupIt != endOfGroupableOpsIterator; ++groupIt) {
+                uassertStatusOK(_applyOplogEntryOrGroupedInserts(
+                    _opCtx, *groupIt, _mode, _isDataConsistent));
+            }
+            wuow.commit();
+        });
+
+        // It succeeded, advance the iterator to the end of the group.
+        return endOfGroupableOpsIterator - 1;
+    } catch (...) {
+        // The group failed and was rolled back. Fall through to the application of individual
+        // ops, which handles the errors that are tolerated for some of them.
+        auto status = exceptionToStatus();
+        LOGV2_DEBUG(6000129,
+                    2,
+                    "Error applying updates and deletes as a group. Applying them individually",
+                    "error"_attr = redact(status),
+                    "namespace"_attr = groupNamespace,
+                    "firstOp"_attr = redact(entry.toBSONForLogging()));
+
+        // Avoid quadratic run time from failed group by not starting another group until we pass
+        // the ops of this one.
+        _doNotGroupBeforePoint = endOfGroupableOpsIterator;
+        return status;
+    }
+
+    MONGO_UNREACHABLE;
+}
+
+}  // namespace repl
+}  // namespace mongo
@@ -44,13 +44,19 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/logv2/log.h"
+#include "mongo/s/shard_key_pattern.h"
 
 namespace mongo {
 namespace {
 
 constexpr int estimatedAdditionalBytesPerItemInBSONArray{2};
 
+// Fewest sampled documents that must fall within the chunk for its split points to be picked from
+// the sample rather than from a scan of the shard key index
+constexpr long long kMinSampledDocsInChunk{100};
+
 BSONObj prettyKey(const BSONObj& keyPattern, const BSONObj& key) {
     return key.replaceFieldNames(keyPattern).clientReadable();
 }
@@ -121,6 +127,109 @@ bool maxKeyEqualToMinKey(OperationContext* opCtx,
     return false;
 }
 
+/*
+ * Picks the split points of the chunk [min, max) from a sample of random documents of the
+ * collection instead of walking its range of the shard key index. The fraction of the sample that
+ * falls within the chunk estimates the number of documents in the chunk, and the sorted shard keys
+ * of those documents are taken as evenly spaced quantiles of the chunk: one split point is taken
+ * every 'maxDocsPerSplittedChunk' estimated documents. With m documents of the sample in the chunk,
+ * each split point is off from its exact position by about 1/sqrt(m) of the chunk.
+ *
+ * Returns boost::none when sampling is disabled, unsupported by the storage engine, or the chunk
+ * is estimated to be small enough (or too few samples fell within it) that the exact scan should be
+ * used instead.
+ */
+boost::optional<std::vector<BSONObj>> sampleSplitPoints(
+    OperationContext* opCtx,
+    const CollectionPtr& collection,
+    const BSONObj& keyPattern,
+    const BSONObj& min,
+    const BSONObj& max,
+    long long totalLocalCollDocuments,
+    long long avgDocSize,
+    long long maxDocsPerSplittedChunk,
+    BSONObjSet& tooFrequentKeys) {
+    const long long sampleSize = autoSplitVectorSampleSize.load();
+    if (sampleSize == 0) {
+        return boost::none;
+    }
+
+    auto cursor = collection->getRecordStore()->getRandomCursor(opCtx);
+    if (!cursor) {
+        return boost::none;
+    }
+
+    const ShardKeyPattern shardKeyPattern(keyPattern);
+    auto keyIsInChunk = [&](const BSONObj& key) {
+        return key.woCompare(min, BSONObj(), false /* considerFieldName */) >= 0 &&
+            (max.isEmpty() || key.woCompare(max, BSONObj(), false /* considerFieldName */) < 0);
+    };
+
+    std::vector<BSONObj> sampledKeys;
+    long long numSampled = 0;
+    for (; numSampled < sampleSize; ++numSampled) {
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+
+        auto key = shardKeyPattern.extractShardKeyFromDoc(record->data.toBson());
+        if (!key.isEmpty() && keyIsInChunk(key)) {
+            sampledKeys.push_back(key.getOwned());
+        }
+    }
+
+    const long long numSampledInChunk = sampledKeys.size();
+    if (numSampledInChunk < kMinSampledDocsInChunk) {
+        return boost::none;
+    }
+
+    const double estimatedDocsPerSample = double(totalLocalCollDocuments) / numSampled;
+    if (numSampledInChunk * estimatedDocsPerSample * avgDocSize <
+        autoSplitVectorSamplingMinChunkSizeBytes.load()) {
+        return boost::none;
+    }
+
+    std::sort(sampledKeys.begin(),
+              sampledKeys.end(),
+              SimpleBSONObjComparator::kInstance.makeLessThan());
+
+    const size_t samplesPerSplittedChunk = std::max<long long>(
+        1, static_cast<long long>(maxDocsPerSplittedChunk / estimatedDocsPerSample));
+
+    std::vector<BSONObj> splitKeys;
+    std::size_t resultArraySize = 0;
+    BSONObj lastSplitPoint = sampledKeys.front();
+    for (size_t i = samplesPerSplittedChunk; i < sampledKeys.size(); i += samplesPerSplittedChunk) {
+        const auto& candidate = sampledKeys[i];
+        if (candidate.woCompare(lastSplitPoint) == 0) {
+            // Do not add again the same split point in case of frequent shard key.
+            tooFrequentKeys.insert(candidate);
+            continue;
+        }
+
+        const auto additionalKeySize =
+            candidate.objsize() + estimatedAdditionalBytesPerItemInBSONArray;
+        if (resultArraySize + additionalKeySize > BSONObjMaxUserSize) {
+            break;
+        }
+
+        resultArraySize += additionalKeySize;
+        splitKeys.push_back(candidate);
+        lastSplitPoint = candidate;
+    }
+
+    LOGV2_DEBUG(5865006,
+                2,
+                "Picked split points from a sample of the collection",
+                "namespace"_attr = collection->ns(),
+                "numSampled"_attr = numSampled,
+                "numSampledInChunk"_attr = numSampledInChunk,
+                "numSplits"_attr = splitKeys.size());
+
+    return splitKeys;
+}
+
 }  // namespace
 
 std::vector<BSONObj> autoSplitVector(OperationContext* opCtx,
@@ -215,8 +324,23 @@ std::vector<BSONObj> autoSplitVector(OperationContext* opCtx,
 
         Timer timer;  // To measure time elapsed while searching split points
 
+        // Large enough chunks get their split points from a sample of the collection rather than
+        // from the full scan of their range of the shard key index below.
+        auto sampledSplitKeys = sampleSplitPoints(opCtx,
+                                                  *collection,
+                                                  keyPattern,
+                                                  min,
+                                                  max,
+                                                  totalLocalCollDocuments,
+                                                  avgDocSize,
+                                                  maxDocsPerSplittedChunk,
+                                                  tooFrequentKeys);
+        if (sampledSplitKeys) {
+            splitKeys = std::move(*sampledSplitKeys);
+        }
+
         // Traverse the index and add the maxDocsPerSplittedChunk-th key to the result vector
-        while (exec->getNext(&currentKey, nullptr) == PlanExecutor::ADVANCED) {
+        while (!sampledSplitKeys && exec->getNext(&currentKey, nullptr) == PlanExecutor::ADVANCED) {
             numScannedKeys++;
 
             if (numScannedKeys > maxDocsPerSplittedChunk) {
@@ -35,7 +35,9 @@
 
 #include <random>
 
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/s/balancer/type_migration.h"
+#include "mongo/db/s/sharding_config_server_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/catalog/type_tags.h"
@@ -548,6 +550,16 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
             ;
     }
 
+    // 4) If the chunk counts are balanced, check for shards, which are written to much faster
+    if (migrations.empty() && balancerWriteLoadImbalanceThreshold.load() > 0) {
+        _singleWriteLoadBalance(shardStats,
+                                distribution,
+                                &migrations,
+                                usedShards,
+                                forceJumbo ? MoveChunkRequest::ForceJumbo::kForceBalancer
+                                           : MoveChunkRequest::ForceJumbo::kDoNotForce);
+    }
+
     return migrations;
 }
 
@@ -657,6 +669,96 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
     return false;
 }
 
+bool BalancerPolicy::_singleWriteLoadBalance(const ShardStatisticsVector& shardStats,
+                                             const DistributionStatus& distribution,
+                                             vector<MigrateInfo>* migrations,
+                                             set<ShardId>* usedShards,
+                                             MoveChunkRequest::ForceJumbo forceJumbo) {
+    if (shardStats.size() < 2)
+        return false;
+
+    double totalWriteBytesPerSec = 0;
+    const ClusterStatistics::ShardStatistics* donor = nullptr;
+    for (const auto& stat : shardStats) {
+        totalWriteBytesPerSec += stat.writeBytesPerSec;
+
+        if (stat.isDraining || usedShards->count(stat.shardId))
+            continue;
+
+        if (!donor || stat.writeBytesPerSec > donor->writeBytesPerSec) {
+            donor = &stat;
+        }
+    }
+
+    if (!donor)
+        return false;
+
+    const double averageWriteBytesPerSec = totalWriteBytesPerSec / shardStats.size();
+    const double threshold = balancerWriteLoadImbalanceThreshold.load();
+
+    if (donor->writeBytesPerSec < balancerWriteLoadMinBytesPerSecond.load() ||
+        donor->writeBytesPerSec <= threshold * averageWriteBytesPerSec)
+        return false;
+
+    const auto& chunks = distribution.getChunks(donor->shardId);
+
+    for (const auto& range : donor->hotRanges) {
+        if (range.nss != distribution.nss())
+            continue;
+
+        auto chunkIt = std::find_if(chunks.begin(), chunks.end(), [&](const ChunkType& chunk) {
+            return SimpleBSONObjComparator::kInstance.evaluate(chunk.getMin() == range.min) &&
+                SimpleBSONObjComparator::kInstance.evaluate(chunk.getMax() == range.max);
+        });
+        if (chunkIt == chunks.end() || chunkIt->getJumbo())
+            continue;
+
+        const string tag = distribution.getTagForChunk(*chunkIt);
+
+        const ClusterStatistics::ShardStatistics* receiver = nullptr;
+        for (const auto& stat : shardStats) {
+            if (stat.shardId == donor->shardId || usedShards->count(stat.shardId))
+                continue;
+
+            if (!isShardSuitableReceiver(stat, tag).isOK())
+                continue;
+
+            if (!receiver || stat.writeBytesPerSec < receiver->writeBytesPerSec) {
+                receiver = &stat;
+            }
+        }
+
+        if (!receiver)
+            return false;
+
+        // Moving a range which accounts for more than half of the difference would leave the
+        // receiver more loaded than the donor, which would then move it back
+        if (range.writeBytesPerSec > (donor->writeBytesPerSec - receiver->writeBytesPerSec) / 2)
+            continue;
+
+
+        LOGV2_DEBUG(6000152,
+                    1,
+                    "Balancing write load",
+                    "namespace"_attr = distribution.nss().ns(),
+                    "chunk"_attr = redact(chunkIt->toString()),
+                    "rangeWriteBytesPerSec"_attr = range.writeBytesPerSec,
+                    "fromShardId"_attr = donor->shardId,
+                    "fromShardWriteBytesPerSec"_attr = donor->writeBytesPerSec,
+                    "toShardId"_attr = receiver->shardId,
+                    "toShardWriteBytesPerSec"_attr = receiver->writeBytesPerSec,
+                    "averageWriteBytesPerSec"_attr = averageWriteBytesPerSec);
+
+        migrations->emplace_back(
+            receiver->shardId, *chunkIt, forceJumbo, MigrateInfo::writeLoadImbalance);
+        invariant(usedShards->insert(donor->shardId).second);
+        invariant(usedShards->insert(receiver->shardId).second);
+        return true;
+    }
+
+    return false;
+}
+
 ZoneRange::ZoneRange(const BSONObj& a_min, const BSONObj& a_max, const std::string& _zone)
     : min(a_min.getOwned()), max(a_max.getOwned()), zone(_zone) {}
 
@@ -54,7 +54,7 @@ struct ZoneRange {
 };
 
 struct MigrateInfo {
-    enum MigrationReason { drain, zoneViolation, chunksImbalance };
+    enum MigrationReason { drain, zoneViolation, chunksImbalance, writeLoadImbalance };
 
     MigrateInfo(const ShardId& a_to,
                 const ChunkType& a_chunk,
@@ -229,7 +229,9 @@ public:
      *
      * The balancing logic calculates the optimum number of chunks per shard for each zone and if
      * any of the shards have chunks, which are sufficiently higher than this number, suggests
-     * moving chunks to shards, which are under this number.
+     * moving chunks to shards, which are under this number. If the chunk counts are balanced and
+     * write load based balancing is enabled, it may instead suggest moving one of the most written
+     * chunks off a shard whose write rate is sufficiently higher than the average.
      *
      * The usedShards parameter is in/out and it contains the set of shards, which have already been
      * used for migrations. Used so we don't return multiple conflicting migrations for the same
@@ -286,6 +288,21 @@ private:
                                    std::vector<MigrateInfo>* migrations,
                                    std::set<ShardId>* usedShards,
                                    MoveChunkRequest::ForceJumbo forceJumbo);
+
+    /**
+     * Selects one of the most written chunks of the collection on the shard with the highest write
+     * rate to be moved to the shard with the lowest one, if the write rate of the former exceeds
+     * the average by more than balancerWriteLoadImbalanceThreshold. To avoid moving the same chunk
+     * back and forth, the chunk is only moved if, after the move, the receiver would still be
+     * written to no faster than the donor.
+     *
+     * Returns true if a migration was suggested, false otherwise.
+     */
+    static bool _singleWriteLoadBalance(const ShardStatisticsVector& shardStats,
+                                        const DistributionStatus& distribution,
+                                        std::vector<MigrateInfo>* migrations,
+                                        std::set<ShardId>* usedShards,
+                                        MoveChunkRequest::ForceJumbo forceJumbo);
 };
 
 }  // namespace mongo
@@ -33,6 +33,7 @@
 
 #include "mongo/db/keypattern.h"
 #include "mongo/db/s/balancer/balancer_policy.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/platform/random.h"
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/unittest/unittest.h"
@@ -692,6 +693,100 @@ TEST(BalancerPolicy, BalancerHandlesNoShardsWithTag) {
     ASSERT(balanceChunks(cluster.first, distribution, false, false).empty());
 }
 
+/**
+ * Generates a cluster of three shards with two chunks each, where kShardId0 is written to at 10MB/s
+ * on its two chunks, which are respectively written to at 'firstChunkRate' and 'secondChunkRate',
+ * and kShardId1 and kShardId2 are written to at 1MB/s and 2MB/s respectively.
+ */
+std::pair<ShardStatisticsVector, ShardToChunksMap> generateWriteLoadCluster(
+    double firstChunkRate, double secondChunkRate) {
+    const double kMB = 1024 * 1024;
+
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId1, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId2, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2}});
+
+    const auto& shard0Chunks = cluster.second[kShardId0];
+    auto& shard0Stats = cluster.first[0];
+    shard0Stats.writeBytesPerSec = 10 * kMB;
+    shard0Stats.hotRanges.push_back(
+        {kNamespace, shard0Chunks[0].getMin(), shard0Chunks[0].getMax(), firstChunkRate * kMB});
+    shard0Stats.hotRanges.push_back(
+        {kNamespace, shard0Chunks[1].getMin(), shard0Chunks[1].getMax(), secondChunkRate * kMB});
+    cluster.first[1].writeBytesPerSec = 1 * kMB;
+    cluster.first[2].writeBytesPerSec = 2 * kMB;
+
+    return cluster;
+}
+
+TEST(BalancerPolicy, WriteLoadBalancingDisabledByDefault) {
+    auto cluster = generateWriteLoadCluster(4, 3);
+
+    ASSERT(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false, false)
+            .empty());
+}
+
+TEST(BalancerPolicy, WriteLoadImbalanceMovesHotChunkToColdestShard) {
+    RAIIServerParameterControllerForTest threshold{"balancerWriteLoadImbalanceThreshold", 1.5};
+    auto cluster = generateWriteLoadCluster(4, 3);
+
+    const auto migrations(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false, false));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId1, migrations[0].to);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMin(), migrations[0].minKey);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMax(), migrations[0].maxKey);
+    ASSERT_EQ(MigrateInfo::writeLoadImbalance, migrations[0].reason);
+}
+
+TEST(BalancerPolicy, WriteLoadImbalanceSkipsChunkWhichWouldMakeReceiverOverloaded) {
+    RAIIServerParameterControllerForTest threshold{"balancerWriteLoadImbalanceThreshold", 1.5};
+    auto cluster = generateWriteLoadCluster(8, 2);
+
+    // Moving the first chunk would leave kShardId1 at 9MB/s and kShardId0 at 2MB/s
+    const auto migrations(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false, false));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId1, migrations[0].to);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][1].getMin(), migrations[0].minKey);
+    ASSERT_EQ(MigrateInfo::writeLoadImbalance, migrations[0].reason);
+}
+
+TEST(BalancerPolicy, WriteLoadImbalanceBelowThresholdDoesNotMove) {
+    RAIIServerParameterControllerForTest threshold{"balancerWriteLoadImbalanceThreshold", 3.0};
+    auto cluster = generateWriteLoadCluster(4, 3);
+
+    ASSERT(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false, false)
+            .empty());
+}
+
+TEST(BalancerPolicy, WriteLoadImbalanceBelowMinimumRateDoesNotMove) {
+    RAIIServerParameterControllerForTest threshold{"balancerWriteLoadImbalanceThreshold", 1.5};
+    RAIIServerParameterControllerForTest minRate{"balancerWriteLoadMinBytesPerSecond",
+                                                 20 * 1024 * 1024};
+    auto cluster = generateWriteLoadCluster(4, 3);
+
+    ASSERT(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false, false)
+            .empty());
+}
+
+TEST(BalancerPolicy, ChunkCountImbalanceTakesPrecedenceOverWriteLoad) {
+    RAIIServerParameterControllerForTest threshold{"balancerWriteLoadImbalanceThreshold", 1.5};
+    auto cluster = generateWriteLoadCluster(4, 3);
+    cluster.second[kShardId1].clear();
+
+    const auto migrations(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false, false));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(MigrateInfo::chunksImbalance, migrations[0].reason);
+}
+
 TEST(DistributionStatus, AddTagRangeOverlap) {
     DistributionStatus d(kNamespace, ShardToChunksMap{});
 
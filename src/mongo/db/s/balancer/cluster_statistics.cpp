@@ -73,6 +73,9 @@ BSONObj ClusterStatistics::ShardStatistics::toBSON() const {
     }
 
     builder.append("version", mongoVersion);
+    if (writeBytesPerSec > 0) {
+        builder.append("writeBytesPerSec", writeBytesPerSec);
+    }
     return builder.obj();
 }
 
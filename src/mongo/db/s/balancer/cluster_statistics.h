@@ -34,11 +34,12 @@
 #include <string>
 #include <vector>
 
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/s/client/shard.h"
 
 namespace mongo {
 
-class BSONObj;
 class OperationContext;
 template <typename T>
 class StatusWith;
@@ -58,6 +59,16 @@ public:
      */
     struct ShardStatistics {
     public:
+        /**
+         * Write rate observed on a single chunk range owned by the shard.
+         */
+        struct RangeWriteLoad {
+            NamespaceString nss;
+            BSONObj min;
+            BSONObj max;
+            double writeBytesPerSec{0};
+        };
+
         ShardStatistics(ShardId shardId,
                         uint64_t maxSizeMB,
                         uint64_t currSizeMB,
@@ -93,6 +104,13 @@ public:
 
         // Version of mongod, which runs on this shard's primary
         std::string mongoVersion;
+
+        // Rate at which documents in sharded collections are being written on this shard, derived
+        // from the chunk writes trackers. Zero if write load statistics are not being collected.
+        double writeBytesPerSec{0};
+
+        // The most written chunk ranges on this shard, in decreasing order of write rate
+        std::vector<RangeWriteLoad> hotRanges;
     };
 
     virtual ~ClusterStatistics();
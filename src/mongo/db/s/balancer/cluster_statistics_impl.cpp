@@ -38,27 +38,37 @@
 #include "mongo/base/status_with.h"
 #include "mongo/bson/util/bson_extract.h"
 #include "mongo/client/read_preference.h"
+#include "mongo/db/s/sharding_config_server_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
 #include "mongo/s/shard_util.h"
+#include "mongo/util/clock_source.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 namespace {
 
 const char kVersionField[] = "version";
+const char kWriteLoadField[] = "shardingWriteLoad";
+
+// Number of most written chunk ranges each shard is asked to report
+const int kWriteLoadNumRanges = 20;
+
+// Minimum interval between two write load samples of a shard for a rate to be derived from them
+const Milliseconds kMinWriteLoadSampleInterval{1000};
 
 /**
- * Executes the serverStatus command against the specified shard and obtains the version of the
- * running MongoD service.
+ * Executes the serverStatus command against the specified shard and returns its response. If
+ * 'includeWriteLoad' is true, the response also contains the shard's 'shardingWriteLoad' section.
  *
- * Returns the MongoD version in strig format or an error. Known error codes are:
+ * Known error codes are:
  *  ShardNotFound if shard by that id is not available on the registry
- *  NoSuchKey if the version could not be retrieved
  */
-StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, ShardId shardId) {
+StatusWith<BSONObj> retrieveShardServerStatus(OperationContext* opCtx,
+                                              ShardId shardId,
+                                              bool includeWriteLoad) {
     auto shardRegistry = Grid::get(opCtx)->shardRegistry();
     auto shardStatus = shardRegistry->getShard(opCtx, shardId);
     if (!shardStatus.isOK()) {
@@ -66,11 +76,17 @@ StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, Shar
     }
     auto shard = shardStatus.getValue();
 
+    BSONObjBuilder cmdBuilder;
+    cmdBuilder.append("serverStatus", 1);
+    if (includeWriteLoad) {
+        cmdBuilder.append(kWriteLoadField, BSON("numRanges" << kWriteLoadNumRanges));
+    }
+
     auto commandResponse =
         shard->runCommandWithFixedRetryAttempts(opCtx,
                                                 ReadPreferenceSetting{ReadPreference::PrimaryOnly},
                                                 "admin",
-                                                BSON("serverStatus" << 1),
+                                                cmdBuilder.obj(),
                                                 Shard::RetryPolicy::kIdempotent);
     if (!commandResponse.isOK()) {
         return commandResponse.getStatus();
@@ -79,15 +95,14 @@ StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, Shar
         return commandResponse.getValue().commandStatus;
     }
 
-    BSONObj serverStatus = std::move(commandResponse.getValue().response);
-
-    std::string version;
-    Status status = bsonExtractStringField(serverStatus, kVersionField, &version);
-    if (!status.isOK()) {
-        return status;
-    }
+    return std::move(commandResponse.getValue().response);
+}
 
-    return version;
+std::string makeRangeKey(StringData ns, const BSONObj& min) {
+    std::string key = ns.toString();
+    key.push_back('\0');
+    key.append(min.objdata(), min.objsize());
+    return key;
 }
 
 }  // namespace
@@ -116,6 +131,9 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
 
     std::vector<ShardStatistics> stats;
 
+    const bool includeWriteLoad = balancerWriteLoadImbalanceThreshold.load() > 0;
+    const auto now = opCtx->getServiceContext()->getFastClockSource()->now();
+
     for (const auto& shard : shards) {
         const auto shardSizeStatus = [&]() -> StatusWith<long long> {
             if (!shard.getMaxSizeMB()) {
@@ -134,18 +152,28 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
         }
 
         std::string mongoDVersion;
+        BSONObj writeLoad;
 
-        auto mongoDVersionStatus = retrieveShardMongoDVersion(opCtx, shard.getName());
-        if (mongoDVersionStatus.isOK()) {
-            mongoDVersion = std::move(mongoDVersionStatus.getValue());
-        } else {
+        auto mongoDVersionStatus = [&]() -> Status {
+            auto serverStatus =
+                retrieveShardServerStatus(opCtx, shard.getName(), includeWriteLoad);
+            if (!serverStatus.isOK()) {
+                return serverStatus.getStatus();
+            }
+            if (auto writeLoadElem = serverStatus.getValue()[kWriteLoadField];
+                writeLoadElem.type() == Object) {
+                writeLoad = writeLoadElem.Obj().getOwned();
+            }
+            return bsonExtractStringField(serverStatus.getValue(), kVersionField, &mongoDVersion);
+        }();
+        if (!mongoDVersionStatus.isOK()) {
             // Since the mongod version is only used for reporting, there is no need to fail the
             // entire round if it cannot be retrieved, so just leave it empty
             LOGV2(21895,
                   "Unable to obtain shard version for {shardId}: {error}",
                   "Unable to obtain shard version",
                   "shardId"_attr = shard.getName(),
-                  "error"_attr = mongoDVersionStatus.getStatus());
+                  "error"_attr = mongoDVersionStatus);
         }
 
         std::set<std::string> shardTags;
@@ -160,9 +188,79 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
                            shard.getDraining(),
                            std::move(shardTags),
                            std::move(mongoDVersion));
+
+        if (includeWriteLoad && !writeLoad.isEmpty()) {
+            _updateWriteLoad(shard.getName(), writeLoad, now, &stats.back());
+        }
     }
 
     return stats;
 }
 
+void ClusterStatisticsImpl::_updateWriteLoad(const ShardId& shardId,
+                                             const BSONObj& writeLoad,
+                                             Date_t now,
+                                             ShardStatistics* stats) {
+    WriteLoadSample sample;
+    sample.time = now;
+    sample.totalBytesWritten = writeLoad["totalBytesWritten"].safeNumberLong();
+
+    std::vector<ShardStatistics::RangeWriteLoad> ranges;
+    std::vector<long long> rangesBytesWritten;
+    for (const auto& rangeElem : writeLoad["ranges"].Array()) {
+        const auto range = rangeElem.Obj();
+        const auto ns = range["ns"].String();
+        const auto min = range["min"].Obj().getOwned();
+        const auto bytesWritten = range["bytesWritten"].safeNumberLong();
+
+        sample.rangesBytesWritten[makeRangeKey(ns, min)] = bytesWritten;
+        ranges.push_back({NamespaceString(ns), min, range["max"].Obj().getOwned(), 0});
+        rangesBytesWritten.push_back(bytesWritten);
+    }
+
+    stdx::lock_guard<Latch> lk(_writeLoadMutex);
+
+    auto it = _writeLoadSamples.find(shardId);
+    if (it == _writeLoadSamples.end()) {
+        _writeLoadSamples.emplace(shardId, std::move(sample));
+        return;
+    }
+
+    const auto& prevSample = it->second;
+    const auto elapsed = now - prevSample.time;
+    if (elapsed < kMinWriteLoadSampleInterval) {
+        // Too close to the previous sample to give a meaningful rate, so keep the previous sample
+        // to compare the next one against.
+        return;
+    }
+
+    const double elapsedSecs = durationCount<Milliseconds>(elapsed) / 1000.0;
+
+    // The counters are not persisted and only cover the chunks currently owned by the shard, so
+    // they go backwards when the shard restarts or donates chunks. No rate is reported for that
+    // sample.
+    if (sample.totalBytesWritten >= prevSample.totalBytesWritten) {
+        stats->writeBytesPerSec =
+            (sample.totalBytesWritten - prevSample.totalBytesWritten) / elapsedSecs;
+    }
+
+    for (size_t i = 0; i < ranges.size(); i++) {
+        auto prevIt =
+            prevSample.rangesBytesWritten.find(makeRangeKey(ranges[i].nss.ns(), ranges[i].min));
+        if (prevIt == prevSample.rangesBytesWritten.end() ||
+            rangesBytesWritten[i] <= prevIt->second)
+            continue;
+
+        ranges[i].writeBytesPerSec = (rangesBytesWritten[i] - prevIt->second) / elapsedSecs;
+        stats->hotRanges.push_back(std::move(ranges[i]));
+    }
+
+    auto& hotRanges = stats->hotRanges;
+    std::sort(hotRanges.begin(), hotRanges.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.writeBytesPerSec > rhs.writeBytesPerSec;
+    });
+
+    it->second = std::move(sample);
+}
+
 }  // namespace mongo
@@ -29,8 +29,13 @@
 
 #pragma once
 
+#include <map>
+
 #include "mongo/db/s/balancer/balancer_random.h"
 #include "mongo/db/s/balancer/cluster_statistics.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -47,8 +52,33 @@ public:
     StatusWith<std::vector<ShardStatistics>> getStats(OperationContext* opCtx) override;
 
 private:
+    /**
+     * Snapshot of the bytes written counters reported by a shard.
+     */
+    struct WriteLoadSample {
+        Date_t time;
+        long long totalBytesWritten{0};
+        StringMap<long long> rangesBytesWritten;
+    };
+
+    /**
+     * Derives the write rates of the shard and of its most written chunk ranges from the
+     * 'shardingWriteLoad' serverStatus section it reported and the sample taken in a previous
+     * round, and stores them in 'stats'.
+     */
+    void _updateWriteLoad(const ShardId& shardId,
+                          const BSONObj& writeLoad,
+                          Date_t now,
+                          ShardStatistics* stats);
+
     // Source of randomness when metadata needs to be randomized.
     BalancerRandomSource& _random;
+
+    // Protects _writeLoadSamples
+    Mutex _writeLoadMutex = MONGO_MAKE_LATCH("ClusterStatisticsImpl::_writeLoadMutex");
+
+    // Last write load sample of each shard
+    std::map<ShardId, WriteLoadSample> _writeLoadSamples;
 };
 
 }  // namespace mongo
@@ -168,6 +168,29 @@ RangeMap CollectionMetadata::getChunks() const {
     return chunksMap;
 }
 
+std::vector<ChunkRange> CollectionMetadata::getOwnedRanges() const {
+    invariant(isSharded());
+
+    std::vector<ChunkRange> ownedRanges;
+    bool previousChunkOwned = false;
+
+    // The chunks cover the entire shard key space, so an owned chunk which follows another owned
+    // chunk is always contiguous with it
+    _cm->forEachChunk([&](const auto& chunk) {
+        const bool owned = chunk.getShardId() == _thisShardId;
+        if (owned && previousChunkOwned) {
+            ownedRanges.back() = ChunkRange(ownedRanges.back().getMin(), chunk.getMax());
+        } else if (owned) {
+            ownedRanges.emplace_back(chunk.getMin(), chunk.getMax());
+        }
+
+        previousChunkOwned = owned;
+        return true;
+    });
+
+    return ownedRanges;
+}
+
 bool CollectionMetadata::getNextChunk(const BSONObj& lookupKey, ChunkType* chunk) const {
     invariant(isSharded());
 
@@ -247,6 +247,12 @@ public:
      */
     RangeMap getChunks() const;
 
+    /**
+     * Returns the ranges of the shard key space owned by this shard in increasing order, with any
+     * contiguous chunks merged into a single range.
+     */
+    std::vector<ChunkRange> getOwnedRanges() const;
+
     /**
      * BSON output of the chunks metadata into a BSONArray
      */
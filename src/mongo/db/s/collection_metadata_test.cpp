@@ -147,6 +147,10 @@ TEST_F(NoChunkFixture, KeyBelongsToMe) {
     ASSERT(!makeCollectionMetadata().keyBelongsToMe(BSONObj()));
 }
 
+TEST_F(NoChunkFixture, GetOwnedRanges) {
+    ASSERT(makeCollectionMetadata().getOwnedRanges().empty());
+}
+
 TEST_F(NoChunkFixture, IsValidKey) {
     ASSERT(makeCollectionMetadata().isValidKey(BSON("a"
                                                     << "abcde")));
@@ -386,6 +390,15 @@ TEST_F(ThreeChunkWithRangeGapFixture, KeyBelongsToMe) {
     ASSERT(!makeCollectionMetadata().keyBelongsToMe(BSONObj()));
 }
 
+TEST_F(ThreeChunkWithRangeGapFixture, GetOwnedRangesMergesContiguousChunks) {
+    const auto ownedRanges = makeCollectionMetadata().getOwnedRanges();
+    ASSERT_EQ(2U, ownedRanges.size());
+    ASSERT_BSONOBJ_EQ(BSON("a" << MINKEY), ownedRanges[0].getMin());
+    ASSERT_BSONOBJ_EQ(BSON("a" << 20), ownedRanges[0].getMax());
+    ASSERT_BSONOBJ_EQ(BSON("a" << 30), ownedRanges[1].getMin());
+    ASSERT_BSONOBJ_EQ(BSON("a" << MAXKEY), ownedRanges[1].getMax());
+}
+
 TEST_F(ThreeChunkWithRangeGapFixture, GetNextChunkFromBeginning) {
     ChunkType nextChunk;
     ASSERT(makeCollectionMetadata().getNextChunk(makeCollectionMetadata().getMinKey(), &nextChunk));
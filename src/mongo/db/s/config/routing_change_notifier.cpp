@@ -0,0 +1,118 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/s/config/routing_change_notifier.h"
+
+#include <algorithm>
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getRoutingChangeNotifier = ServiceContext::declareDecoration<RoutingChangeNotifier>();
+
+}  // namespace
+
+RoutingChangeNotifier::RoutingChangeNotifier() : _instanceId(OID::gen()) {}
+
+RoutingChangeNotifier* RoutingChangeNotifier::get(ServiceContext* serviceContext) {
+    return &getRoutingChangeNotifier(serviceContext);
+}
+
+RoutingChangeNotifier* RoutingChangeNotifier::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+void RoutingChangeNotifier::notifyChange(const NamespaceString& nss) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    _history.emplace_back(++_generation, nss);
+    if (_history.size() > kMaxHistorySize) {
+        _history.pop_front();
+    }
+
+    _changedCV.notify_all();
+}
+
+RoutingChangeNotifier::Changes RoutingChangeNotifier::waitForChanges(
+    OperationContext* opCtx,
+    const boost::optional<OID>& instanceId,
+    long long afterGeneration,
+    Date_t deadline) {
+    stdx::unique_lock<Latch> lk(_mutex);
+
+    Changes changes;
+    changes.instanceId = _instanceId;
+
+    // A caller which has never heard from this instance cannot know what it has missed
+    if (!instanceId || *instanceId != _instanceId || afterGeneration > _generation) {
+        changes.generation = _generation;
+        changes.historyLost = true;
+        return changes;
+    }
+
+    opCtx->waitForConditionOrInterruptUntil(
+        _changedCV, lk, deadline, [&] { return _generation > afterGeneration; });
+
+    changes.generation = _generation;
+    if (_generation == afterGeneration) {
+        return changes;
+    }
+
+    if (_history.empty() || _history.front().first > afterGeneration + 1) {
+        changes.historyLost = true;
+        return changes;
+    }
+
+    for (auto it = std::upper_bound(
+             _history.begin(),
+             _history.end(),
+             afterGeneration,
+             [](long long generation, const auto& entry) { return generation < entry.first; });
+         it != _history.end();
+         ++it) {
+        if (std::find(changes.namespaces.begin(), changes.namespaces.end(), it->second) ==
+            changes.namespaces.end()) {
+            changes.namespaces.push_back(it->second);
+        }
+    }
+
+    return changes;
+}
+
+long long RoutingChangeNotifier::getGeneration() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _generation;
+}
+
+}  // namespace mongo
@@ -0,0 +1,115 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include "mongo/bson/oid.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Keeps a bounded, in-memory log of the collections whose routing table was changed by chunk
+ * operations committed on this config server, so that routers can wait for changes instead of
+ * discovering them through stale config errors.
+ *
+ * Every change is assigned a generation number, which increases monotonically for the lifetime
+ * of the process. A router remembers the instance id and the last generation it has seen and asks
+ * for everything after it. When the instance id differs (the config server restarted or another
+ * node became primary) or the requested generation is no longer in the log, the response is
+ * marked with 'historyLost' and the router must assume any collection may have changed.
+ */
+class RoutingChangeNotifier {
+    RoutingChangeNotifier(const RoutingChangeNotifier&) = delete;
+    RoutingChangeNotifier& operator=(const RoutingChangeNotifier&) = delete;
+
+public:
+    static constexpr size_t kMaxHistorySize = 1000;
+
+    struct Changes {
+        OID instanceId;
+        long long generation{0};
+        std::vector<NamespaceString> namespaces;
+        bool historyLost{false};
+    };
+
+    RoutingChangeNotifier();
+
+    static RoutingChangeNotifier* get(ServiceContext* serviceContext);
+    static RoutingChangeNotifier* get(OperationContext* opCtx);
+
+    /**
+     * Records that the routing table of 'nss' has changed and wakes up all waiters.
+     */
+    void notifyChange(const NamespaceString& nss);
+
+    /**
+     * Returns the distinct namespaces changed after 'afterGeneration' of the given instance,
+     * blocking until at least one such change happens or 'deadline' is reached. Returns an empty
+     * set of namespaces on timeout. Throws if the operation gets interrupted.
+     */
+    Changes waitForChanges(OperationContext* opCtx,
+                           const boost::optional<OID>& instanceId,
+                           long long afterGeneration,
+                           Date_t deadline);
+
+    /**
+     * Returns the generation of the most recent change.
+     */
+    long long getGeneration() const;
+
+    const OID& getInstanceId() const {
+        return _instanceId;
+    }
+
+private:
+    const OID _instanceId;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("RoutingChangeNotifier::_mutex");
+
+    // Signalled every time a new change is recorded
+    stdx::condition_variable _changedCV;
+
+    // Generation of the most recent change, 0 if there were none
+    long long _generation{0};
+
+    // The most recent changes in increasing order of generation, at most kMaxHistorySize of them
+    std::deque<std::pair<long long, NamespaceString>> _history;
+};
+
+}  // namespace mongo
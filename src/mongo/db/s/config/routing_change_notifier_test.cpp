@@ -0,0 +1,127 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/s/config/routing_change_notifier.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss1("TestDB.Coll1");
+const NamespaceString kNss2("TestDB.Coll2");
+
+class RoutingChangeNotifierTest : public ServiceContextTest {
+protected:
+    RoutingChangeNotifier::Changes waitForChanges(const boost::optional<OID>& instanceId,
+                                                  long long afterGeneration,
+                                                  Milliseconds timeout = Milliseconds(0)) {
+        auto opCtx = makeOperationContext();
+        return _notifier.waitForChanges(
+            opCtx.get(), instanceId, afterGeneration, Date_t::now() + timeout);
+    }
+
+    RoutingChangeNotifier _notifier;
+};
+
+TEST_F(RoutingChangeNotifierTest, UnknownInstanceLosesHistory) {
+    _notifier.notifyChange(kNss1);
+
+    auto changes = waitForChanges(boost::none, 0);
+    ASSERT(changes.historyLost);
+    ASSERT_EQ(_notifier.getInstanceId(), changes.instanceId);
+    ASSERT_EQ(1, changes.generation);
+    ASSERT(changes.namespaces.empty());
+
+    changes = waitForChanges(OID::gen(), 0);
+    ASSERT(changes.historyLost);
+    ASSERT_EQ(_notifier.getInstanceId(), changes.instanceId);
+}
+
+TEST_F(RoutingChangeNotifierTest, ReturnsDistinctNamespacesAfterGeneration) {
+    _notifier.notifyChange(kNss1);
+    _notifier.notifyChange(kNss2);
+    _notifier.notifyChange(kNss1);
+
+    auto changes = waitForChanges(_notifier.getInstanceId(), 0);
+    ASSERT(!changes.historyLost);
+    ASSERT_EQ(3, changes.generation);
+    ASSERT_EQ(2U, changes.namespaces.size());
+    ASSERT_EQ(kNss1, changes.namespaces[0]);
+    ASSERT_EQ(kNss2, changes.namespaces[1]);
+
+    changes = waitForChanges(_notifier.getInstanceId(), 2);
+    ASSERT(!changes.historyLost);
+    ASSERT_EQ(1U, changes.namespaces.size());
+    ASSERT_EQ(kNss1, changes.namespaces[0]);
+}
+
+TEST_F(RoutingChangeNotifierTest, ReturnsNoChangesOnTimeout) {
+    _notifier.notifyChange(kNss1);
+
+    auto changes = waitForChanges(_notifier.getInstanceId(), 1, Milliseconds(10));
+    ASSERT(!changes.historyLost);
+    ASSERT_EQ(1, changes.generation);
+    ASSERT(changes.namespaces.empty());
+}
+
+TEST_F(RoutingChangeNotifierTest, EvictedChangesLoseHistory) {
+    for (size_t i = 0; i <= RoutingChangeNotifier::kMaxHistorySize; i++) {
+        _notifier.notifyChange(kNss1);
+    }
+
+    auto changes = waitForChanges(_notifier.getInstanceId(), 0);
+    ASSERT(changes.historyLost);
+    ASSERT(changes.namespaces.empty());
+
+    changes = waitForChanges(_notifier.getInstanceId(), 1);
+    ASSERT(!changes.historyLost);
+    ASSERT_EQ(1U, changes.namespaces.size());
+}
+
+TEST_F(RoutingChangeNotifierTest, WaiterIsWokenUpByChange) {
+    stdx::thread notifierThread([&] {
+        sleepmillis(10);
+        _notifier.notifyChange(kNss2);
+    });
+
+    auto changes = waitForChanges(_notifier.getInstanceId(), 0, Seconds(60));
+    notifierThread.join();
+
+    ASSERT(!changes.historyLost);
+    ASSERT_EQ(1, changes.generation);
+    ASSERT_EQ(1U, changes.namespaces.size());
+    ASSERT_EQ(kNss2, changes.namespaces[0]);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -45,6 +45,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/distinct_command_gen.h"
 #include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/s/config/routing_change_notifier.h"
 #include "mongo/db/s/sharding_logging.h"
 #include "mongo/db/s/sharding_util.h"
 #include "mongo/db/server_options.h"
@@ -724,6 +725,8 @@ StatusWith<BSONObj> ShardingCatalogManager::commitChunkSplit(
         }
     }
 
+    RoutingChangeNotifier::get(opCtx)->notifyChange(nss);
+
     BSONObjBuilder response;
     currentMaxVersion.appendWithField(&response, kCollectionVersionField);
     currentMaxVersion.appendWithField(&response, ChunkVersion::kShardVersionField);
@@ -853,6 +856,8 @@ StatusWith<BSONObj> ShardingCatalogManager::commitChunkMerge(
     ShardingLogging::get(opCtx)->logChange(
         opCtx, "merge", nss.ns(), logDetail.obj(), WriteConcernOptions());
 
+    RoutingChangeNotifier::get(opCtx)->notifyChange(nss);
+
     BSONObjBuilder response;
     mergeVersion.appendWithField(&response, kCollectionVersionField);
     mergeVersion.appendWithField(&response, ChunkVersion::kShardVersionField);
@@ -1014,6 +1019,8 @@ StatusWith<BSONObj> ShardingCatalogManager::commitChunksMerge(
     ShardingLogging::get(opCtx)->logChange(
         opCtx, "merge", nss.ns(), logDetail.obj(), WriteConcernOptions());
 
+    RoutingChangeNotifier::get(opCtx)->notifyChange(nss);
+
     BSONObjBuilder response;
     mergeVersion.appendWithField(&response, kCollectionVersionField);
     mergeVersion.appendWithField(&response, ChunkVersion::kShardVersionField);
@@ -1255,6 +1262,8 @@ StatusWith<BSONObj> ShardingCatalogManager::commitChunkMigration(
         return applyOpsCommandResponse.getValue().commandStatus;
     }
 
+    RoutingChangeNotifier::get(opCtx)->notifyChange(nss);
+
     BSONObjBuilder response;
     if (!newControlChunk) {
         // We migrated the last chunk from the donor shard.
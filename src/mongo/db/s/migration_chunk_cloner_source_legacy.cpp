@@ -655,38 +655,20 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
                            internalQueryExecYieldIterations.load(),
                            Milliseconds(internalQueryExecYieldPeriodMS.load()));
 
-    stdx::unique_lock<Latch> lk(_mutex);
-    auto iter = _cloneLocs.begin();
-
-    for (; iter != _cloneLocs.end(); ++iter) {
-        // We must always make progress in this method by at least one document because empty
-        // return indicates there is no more initial clone data.
-        if (arrBuilder->arrSize() && tracker.intervalHasElapsed()) {
-            break;
-        }
-
-        auto nextRecordId = *iter;
-
-        lk.unlock();
-
-        Snapshotted<BSONObj> doc;
-        if (collection->findDoc(opCtx, nextRecordId, &doc)) {
-            // Use the builder size instead of accumulating the document sizes directly so
-            // that we take into consideration the overhead of BSONArray indices.
-            if (arrBuilder->arrSize() &&
-                (arrBuilder->len() + doc.value().objsize() + 1024) > BSONObjMaxUserSize) {
-
-                break;
+    const auto numCloned = xferCloneLocs(
+        arrBuilder,
+        &_mutex,
+        &_cloneLocs,
+        [&] { return tracker.intervalHasElapsed(); },
+        [&](RecordId recordId, BSONObj* doc) {
+            Snapshotted<BSONObj> snapshottedDoc;
+            if (!collection->findDoc(opCtx, recordId, &snapshottedDoc)) {
+                return false;
             }
-
-            arrBuilder->append(doc.value());
-            ShardingStatistics::get(opCtx).countDocsClonedOnDonor.addAndFetch(1);
-        }
-
-        lk.lock();
-    }
-
-    _cloneLocs.erase(_cloneLocs.begin(), iter);
+            *doc = snapshottedDoc.value();
+            return true;
+        });
+    ShardingStatistics::get(opCtx).countDocsClonedOnDonor.addAndFetch(numCloned);
 }
 
 uint64_t MigrationChunkClonerSourceLegacy::getCloneBatchBufferAllocationSize() {
@@ -707,6 +689,7 @@ Status MigrationChunkClonerSourceLegacy::nextCloneBatch(OperationContext* opCtx,
     // attempt to move it, scan the collection directly.
     if (_jumboChunkCloneState && _forceJumbo) {
         try {
+            stdx::lock_guard<Latch> indexScanLock(_indexScanCloneMutex);
             _nextCloneBatchFromIndexScan(opCtx, collection, arrBuilder);
             return Status::OK();
         } catch (const DBException& ex) {
@@ -999,6 +982,48 @@ long long xferMods(BSONArrayBuilder* arr,
     return totalSize;
 }
 
+int xferCloneLocs(BSONArrayBuilder* arr,
+                  Latch* mutex,
+                  std::set<RecordId>* cloneLocs,
+                  std::function<bool()> shouldYieldFn,
+                  std::function<bool(RecordId, BSONObj*)> findDocFn) {
+    int numAppended = 0;
+
+    stdx::unique_lock<Latch> lk(*mutex);
+    while (!cloneLocs->empty()) {
+        // We must always make progress in this method by at least one document because empty
+        // return indicates there is no more initial clone data.
+        if (arr->arrSize() && shouldYieldFn()) {
+            break;
+        }
+
+        // Claim the record id before reading its document, so that a concurrent caller does not
+        // clone it as well.
+        const auto nextRecordId = *cloneLocs->begin();
+        cloneLocs->erase(cloneLocs->begin());
+
+        lk.unlock();
+
+        BSONObj doc;
+        if (findDocFn(nextRecordId, &doc)) {
+            // Use the builder size instead of accumulating the document sizes directly so
+            // that we take into consideration the overhead of BSONArray indices.
+            if (arr->arrSize() && (arr->len() + doc.objsize() + 1024) > BSONObjMaxUserSize) {
+                lk.lock();
+                cloneLocs->insert(nextRecordId);
+                break;
+            }
+
+            arr->append(doc);
+            ++numAppended;
+        }
+
+        lk.lock();
+    }
+
+    return numAppended;
+}
+
 Status MigrationChunkClonerSourceLegacy::_checkRecipientCloningStatus(OperationContext* opCtx,
                                                                       Milliseconds maxTimeToWait) {
     const auto startTime = Date_t::now();
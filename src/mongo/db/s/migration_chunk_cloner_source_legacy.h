@@ -385,6 +385,11 @@ private:
 
     // Set only once its discovered a chunk is jumbo
     boost::optional<JumboChunkCloneState> _jumboChunkCloneState;
+
+    // Serializes the _migrateClone requests which read from the jumbo chunk's index scan, since
+    // the recipient may issue several of them concurrently. Acquired before '_mutex'.
+    Mutex _indexScanCloneMutex =
+        MONGO_MAKE_LATCH("MigrationChunkClonerSourceLegacy::_indexScanCloneMutex");
 };
 
 /**
@@ -397,4 +402,17 @@ long long xferMods(BSONArrayBuilder* arr,
                    long long initialSize,
                    std::function<bool(BSONObj, BSONObj*)> extractDocToAppendFn);
 
+/**
+ * Appends to the builder the documents of the record ids at the front of 'cloneLocs', looked up
+ * with 'findDocFn', until 'shouldYieldFn' returns true or the next document does not fit. Each
+ * record id is removed from 'cloneLocs' under 'mutex' before its document is read, so concurrent
+ * callers never clone the same document. The record id of a document which does not fit is put
+ * back. Returns the number of documents appended.
+ */
+int xferCloneLocs(BSONArrayBuilder* arr,
+                  Latch* mutex,
+                  std::set<RecordId>* cloneLocs,
+                  std::function<bool()> shouldYieldFn,
+                  std::function<bool(RecordId, BSONObj*)> findDocFn);
+
 }  // namespace mongo
@@ -32,6 +32,7 @@
 #include <benchmark/benchmark.h>
 
 #include "migration_chunk_cloner_source_legacy.h"
+#include "mongo/stdx/thread.h"
 
 namespace mongo {
 namespace {
@@ -75,5 +76,51 @@ void BM_xferDeletes(benchmark::State& state) {
 
 BENCHMARK(BM_xferDeletes)->ArgsProduct({{0, 25, 50, 75, 100}, {1, 1024, 2048}});
 
+/**
+ * Drains 10,000 record ids with the given number of concurrent _migrateClone streams, each building
+ * batches the way the donor does.
+ */
+void BM_xferCloneLocs(benchmark::State& state) {
+    const int numStreams = state.range(0);
+    const int docSizeInBytes = state.range(1);
+    const int numDocs = 10000;
+    const auto doc = createCollectionDocumentWithSize(0, docSizeInBytes);
+
+    auto findDocFn = [&](RecordId, BSONObj* result) {
+        *result = doc;
+        return true;
+    };
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto mutex = MONGO_MAKE_LATCH();
+        std::set<RecordId> cloneLocs;
+        for (int i = 0; i < numDocs; ++i) {
+            cloneLocs.insert(RecordId(i));
+        }
+        state.ResumeTiming();
+
+        std::vector<stdx::thread> streams;
+        for (int i = 0; i < numStreams; ++i) {
+            streams.emplace_back([&] {
+                auto neverYield = [] { return false; };
+                while (true) {
+                    BSONArrayBuilder arr;
+                    if (!xferCloneLocs(&arr, &mutex, &cloneLocs, neverYield, findDocFn)) {
+                        return;
+                    }
+                    benchmark::DoNotOptimize(arr.arr());
+                }
+            });
+        }
+        for (auto&& stream : streams) {
+            stream.join();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numDocs);
+}
+
+BENCHMARK(BM_xferCloneLocs)->ArgsProduct({{1, 2, 4, 8}, {1024, 16 * 1024}})->UseRealTime();
+
 }  // namespace
 }  // namespace mongo
@@ -691,5 +691,42 @@ TEST_F(MigrationChunkClonerSourceLegacyTest, FailedToEngageRecipientShard) {
     cloner.cancelClone(operationContext());
 }
 
+TEST(XferCloneLocsTest, PutsBackRecordIdOfDocumentWhichDoesNotFit) {
+    auto mutex = MONGO_MAKE_LATCH();
+    std::set<RecordId> cloneLocs{RecordId(1), RecordId(2), RecordId(3)};
+
+    // Each document takes up a little over half of the maximum batch size.
+    const auto largeDoc = BSON("_id" << 0 << "X" << std::string(BSONObjMaxUserSize / 2, 'x'));
+    auto findDocFn = [&](RecordId, BSONObj* doc) {
+        *doc = largeDoc;
+        return true;
+    };
+    auto neverYield = [] { return false; };
+
+    BSONArrayBuilder arrBuilder;
+    ASSERT_EQ(1, xferCloneLocs(&arrBuilder, &mutex, &cloneLocs, neverYield, findDocFn));
+    ASSERT_EQ(1, arrBuilder.arrSize());
+    ASSERT_EQ(2U, cloneLocs.size());
+    ASSERT_EQ(RecordId(2), *cloneLocs.begin());
+}
+
+TEST(XferCloneLocsTest, SkipsRecordIdsWhoseDocumentWasDeleted) {
+    auto mutex = MONGO_MAKE_LATCH();
+    std::set<RecordId> cloneLocs{RecordId(1), RecordId(2), RecordId(3)};
+
+    auto findDocFn = [&](RecordId recordId, BSONObj* doc) {
+        if (recordId == RecordId(2)) {
+            return false;
+        }
+        *doc = BSON("_id" << recordId.getLong());
+        return true;
+    };
+    auto neverYield = [] { return false; };
+
+    BSONArrayBuilder arrBuilder;
+    ASSERT_EQ(2, xferCloneLocs(&arrBuilder, &mutex, &cloneLocs, neverYield, findDocFn));
+    ASSERT(cloneLocs.empty());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -520,6 +520,134 @@ repl::OpTime MigrationDestinationManager::fetchAndApplyBatch(
     return lastOpApplied;
 }
 
+repl::OpTime MigrationDestinationManager::fetchAndApplyBatchesConcurrently(
+    OperationContext* opCtx,
+    std::function<bool(OperationContext*, BSONObj)> applyBatchFn,
+    std::function<bool(OperationContext*, BSONObj*)> fetchBatchFn,
+    int concurrency) {
+    if (concurrency <= 1) {
+        return fetchAndApplyBatch(opCtx, applyBatchFn, fetchBatchFn);
+    }
+
+    MultiProducerMultiConsumerQueue<BSONObj>::Options options;
+    options.maxQueueDepth = concurrency;
+
+    MultiProducerMultiConsumerQueue<BSONObj> batches(options);
+
+    Mutex mutex = MONGO_MAKE_LATCH("MigrationDestinationManager::fetchAndApplyBatchesConcurrently");
+    repl::OpTime lastOpApplied;
+    Status fetchStatus = Status::OK();
+    AtomicWord<int> activeFetchers{concurrency};
+
+    auto executor = Grid::get(opCtx->getServiceContext())->getExecutorPool()->getFixedExecutor();
+
+    // Runs 'fn' on a new thread, with an operation context that is interrupted along with 'opCtx'.
+    auto makeThread = [&](std::string threadName, std::function<void(OperationContext*)> fn) {
+        return stdx::thread([&, threadName = std::move(threadName), fn = std::move(fn)] {
+            Client::initThread(threadName, opCtx->getServiceContext(), nullptr);
+            auto client = Client::getCurrent();
+            {
+                stdx::lock_guard lk(*client);
+                client->setSystemOperationKillableByStepdown(lk);
+            }
+            auto threadOpCtx = CancelableOperationContext(
+                cc().makeOperationContext(), opCtx->getCancellationToken(), executor);
+            fn(threadOpCtx.get());
+        });
+    };
+
+    auto isQueueClosed = [](const DBException& ex) {
+        return ex.code() == ErrorCodes::ProducerConsumerQueueEndClosed ||
+            ex.code() == ErrorCodes::ProducerConsumerQueueConsumed;
+    };
+
+    // Each fetcher requests batches until the donor returns an empty one. The donor hands every
+    // document to exactly one request, so the streams never fetch the same document twice.
+    auto fetchBatches = [&](OperationContext* fetchOpCtx) {
+        auto fetcherGuard = makeGuard([&] {
+            if (activeFetchers.subtractAndFetch(1) == 0) {
+                batches.closeProducerEnd();
+            }
+        });
+
+        try {
+            while (true) {
+                BSONObj nextBatch;
+                if (fetchBatchFn(fetchOpCtx, &nextBatch)) {
+                    return;
+                }
+                batches.push(nextBatch.getOwned(), fetchOpCtx);
+            }
+        } catch (const DBException& ex) {
+            if (isQueueClosed(ex)) {
+                return;
+            }
+
+            stdx::lock_guard<Latch> lk(mutex);
+            if (fetchStatus.isOK()) {
+                fetchStatus = ex.toStatus();
+            }
+            batches.closeConsumerEnd();
+        }
+    };
+
+    auto applyBatches = [&](OperationContext* applyOpCtx) {
+        auto applierGuard = makeGuard([&] {
+            stdx::lock_guard<Latch> lk(mutex);
+            const auto& appliedOpTime =
+                repl::ReplClientInfo::forClient(applyOpCtx->getClient()).getLastOp();
+            lastOpApplied = std::max(lastOpApplied, appliedOpTime);
+        });
+
+        try {
+            while (true) {
+                applyBatchFn(applyOpCtx, batches.pop(applyOpCtx));
+            }
+        } catch (const DBException& ex) {
+            if (isQueueClosed(ex)) {
+                return;
+            }
+
+            batches.closeConsumerEnd();
+            stdx::lock_guard<Client> lk(*opCtx->getClient());
+            opCtx->getServiceContext()->killOperation(lk, opCtx, ErrorCodes::Error(6100006));
+            LOGV2(6000151,
+                  "Concurrent batch application failed",
+                  "error"_attr = redact(ex.toStatus()));
+        }
+    };
+
+    std::vector<stdx::thread> threads;
+    auto joinGuard = makeGuard([&] {
+        batches.closeConsumerEnd();
+        for (auto&& thread : threads) {
+            thread.join();
+        }
+    });
+
+    for (int i = 0; i < concurrency; ++i) {
+        threads.push_back(makeThread(str::stream() << "batchApplier-" << i, applyBatches));
+    }
+    for (int i = 1; i < concurrency; ++i) {
+        threads.push_back(makeThread(str::stream() << "batchFetcher-" << i, fetchBatches));
+    }
+
+    // This thread is the first of the fetchers.
+    fetchBatches(opCtx);
+
+    // Once every fetcher is done, the appliers drain the queue and exit.
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+    joinGuard.dismiss();
+
+    uassertStatusOK(fetchStatus);
+    // The appliers use killOp to propagate their errors to this thread.
+    opCtx->checkForInterrupt();
+    return lastOpApplied;
+}
+
 Status MigrationDestinationManager::abort(const MigrationSessionId& sessionId) {
     stdx::lock_guard<Latch> sl(_mutex);
 
@@ -1100,6 +1228,8 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
             uassert(50748, "Migration aborted while copying documents", getState() != ABORT);
         };
 
+        Mutex secondaryThrottleMutex =
+            MONGO_MAKE_LATCH("MigrationDestinationManager::secondaryThrottleMutex");
         auto insertBatchFn = [&](OperationContext* opCtx, BSONObj nextBatch) {
             auto arr = nextBatch["objects"].Obj();
             if (arr.isEmpty()) {
@@ -1146,6 +1276,8 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
                     _clonedBytes += batchClonedBytes;
                 }
                 if (_writeConcern.needToWaitForOtherNodes()) {
+                    // The session of 'outerOpCtx' can only be checked in by one applier at a time.
+                    stdx::lock_guard<Latch> throttleLock(secondaryThrottleMutex);
                     runWithoutSession(outerOpCtx, [&] {
                         repl::ReplicationCoordinator::StatusAndDuration replStatus =
                             repl::ReplicationCoordinator::get(opCtx)->awaitReplication(
@@ -1186,7 +1318,15 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
 
         // If running on a replicated system, we'll need to flush the docs we cloned to the
         // secondaries
-        lastOpApplied = fetchAndApplyBatch(opCtx, insertBatchFn, fetchBatchFn);
+        // Donors only serve concurrent _migrateClone requests once the whole cluster runs a binary
+        // which gives each of their documents to a single request.
+        const int cloneConcurrency =
+            serverGlobalParams.featureCompatibility.isGreaterThanOrEqualTo(
+                ServerGlobalParams::FeatureCompatibility::Version::kVersion51)
+            ? migrateCloneConcurrency.load()
+            : 1;
+        lastOpApplied = fetchAndApplyBatchesConcurrently(
+            opCtx, insertBatchFn, fetchBatchFn, cloneConcurrency);
 
         timing.done(4);
         migrateThreadHangAtStep4.pauseWhileSet();
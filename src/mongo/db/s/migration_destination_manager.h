@@ -120,6 +120,17 @@ public:
         std::function<bool(OperationContext*, BSONObj)> applyBatchFn,
         std::function<bool(OperationContext*, BSONObj*)> fetchBatchFn);
 
+    /**
+     * Like fetchAndApplyBatch, but with 'concurrency' threads fetching batches and as many applying
+     * them. Each fetcher stops at the first empty batch it receives. Batches are applied in no
+     * particular order, so this is only suitable for the initial clone of the documents.
+     */
+    static repl::OpTime fetchAndApplyBatchesConcurrently(
+        OperationContext* opCtx,
+        std::function<bool(OperationContext*, BSONObj)> applyBatchFn,
+        std::function<bool(OperationContext*, BSONObj*)> fetchBatchFn,
+        int concurrency);
+
     /**
      * Idempotent method, which causes the current ongoing migration to abort only if it has the
      * specified session id. If the migration is already aborted, does nothing.
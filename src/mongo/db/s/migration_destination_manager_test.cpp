@@ -165,6 +165,98 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsCatchesInsertErrors) {
     ASSERT_EQ(operationContext()->getKillStatus(), 51008);
 }
 
+// Tests that concurrent streams apply every fetched batch exactly once, and that each stream stops
+// when it receives an empty batch.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsConcurrentlyAppliesEveryBatch) {
+    const int kNumBatches = 20;
+    const int kConcurrency = 4;
+
+    AtomicWord<int> nextBatch{0};
+    auto fetchBatchFn = [&](OperationContext* opCtx, BSONObj* batch) {
+        const int batchNum = nextBatch.fetchAndAdd(1);
+        BSONObjBuilder fetchBatchResultBuilder;
+        if (batchNum < kNumBatches) {
+            BSONArrayBuilder arrayBuilder(fetchBatchResultBuilder.subarrayStart("objects"));
+            arrayBuilder.append(createDocument(batchNum));
+            arrayBuilder.done();
+        } else {
+            fetchBatchResultBuilder.append("objects", BSONObj());
+        }
+
+        *batch = fetchBatchResultBuilder.obj();
+        return batch->getField("objects").Obj().isEmpty();
+    };
+
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<int> resultIds;
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        auto arr = docs["objects"].Obj();
+        ASSERT_FALSE(arr.isEmpty());
+        stdx::lock_guard<Latch> lk(mutex);
+        for (auto&& docToClone : arr) {
+            resultIds.push_back(docToClone.Obj()["_id"].numberInt());
+        }
+        return true;
+    };
+
+    MigrationDestinationManager::fetchAndApplyBatchesConcurrently(
+        operationContext(), insertBatchFn, fetchBatchFn, kConcurrency);
+
+    // Every stream fetched one empty batch.
+    ASSERT_EQ(kNumBatches + kConcurrency, nextBatch.load());
+
+    std::sort(resultIds.begin(), resultIds.end());
+    ASSERT_EQ(static_cast<size_t>(kNumBatches), resultIds.size());
+    for (int i = 0; i < kNumBatches; ++i) {
+        ASSERT_EQ(i, resultIds[i]);
+    }
+}
+
+// Tests that an exception in one of the concurrent fetch streams is thrown on the main thread.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsConcurrentlyThrowsFetchErrors) {
+    AtomicWord<int> numFetches{0};
+    auto fetchBatchFn = [&](OperationContext* opCtx, BSONObj* nextBatch) {
+        if (numFetches.fetchAndAdd(1) > 0) {
+            uasserted(ErrorCodes::NetworkTimeout, "network error");
+        }
+
+        BSONObjBuilder fetchBatchResultBuilder;
+        fetchBatchResultBuilder.append("objects", createDocumentsToCloneArray());
+        *nextBatch = fetchBatchResultBuilder.obj();
+        return nextBatch->getField("objects").Obj().isEmpty();
+    };
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) { return true; };
+
+    ASSERT_THROWS_CODE_AND_WHAT(MigrationDestinationManager::fetchAndApplyBatchesConcurrently(
+                                    operationContext(), insertBatchFn, fetchBatchFn, 2),
+                                DBException,
+                                ErrorCodes::NetworkTimeout,
+                                "network error");
+}
+
+// Tests that an exception in one of the concurrent appliers interrupts the main thread.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsConcurrentlyCatchesInsertErrors) {
+    auto fetchBatchFn = [&](OperationContext* opCtx, BSONObj* nextBatch) {
+        BSONObjBuilder fetchBatchResultBuilder;
+        fetchBatchResultBuilder.append("objects", createDocumentsToCloneArray());
+        *nextBatch = fetchBatchResultBuilder.obj();
+        return nextBatch->getField("objects").Obj().isEmpty();
+    };
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        uasserted(ErrorCodes::FailedToParse, "insertion error");
+        return false;
+    };
+
+    ASSERT_THROWS_CODE(MigrationDestinationManager::fetchAndApplyBatchesConcurrently(
+                           operationContext(), insertBatchFn, fetchBatchFn, 2),
+                       DBException,
+                       51008);
+
+    ASSERT_EQ(operationContext()->getKillStatus(), 51008);
+}
+
 using MigrationDestinationManagerNetworkTest = CatalogCacheTestFixture;
 
 // Verifies MigrationDestinationManager::getCollectionOptions() and
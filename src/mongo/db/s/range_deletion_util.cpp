@@ -47,15 +47,19 @@
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/keypattern.h"
+#include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/persistent_task_store.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_yield_policy.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/record_id_helpers.h"
 #include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/wait_for_majority_service.h"
 #include "mongo/db/s/migration_util.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/remove_saver.h"
@@ -72,6 +76,9 @@ const WriteConcernOptions kMajorityWriteConcern(WriteConcernOptions::kMajority,
                                                 WriteConcernOptions::SyncMode::UNSET,
                                                 WriteConcernOptions::kWriteConcernTimeoutSharding);
 
+// The longest a single batch deletion is delayed because of replication lag
+const Milliseconds kMaxReplicationLagDelay{1000};
+
 MONGO_FAIL_POINT_DEFINE(hangBeforeDoingDeletion);
 MONGO_FAIL_POINT_DEFINE(suspendRangeDeletion);
 MONGO_FAIL_POINT_DEFINE(throwWriteConflictExceptionInDeleteRange);
@@ -113,6 +120,64 @@ bool collectionUuidHasChanged(const NamespaceString& nss,
     return false;
 }
 
+/**
+ * Runs the delete plan 'exec' until it has deleted numDocsToRemovePerBatch documents or reached
+ * the end of the range [min, max). Returns the number of documents deleted.
+ */
+int deleteDocumentsInBatch(OperationContext* opCtx,
+                           PlanExecutor* exec,
+                           const NamespaceString& nss,
+                           const BSONObj& min,
+                           const BSONObj& max,
+                           int numDocsToRemovePerBatch) {
+    if (MONGO_unlikely(hangBeforeDoingDeletion.shouldFail())) {
+        LOGV2(23768, "Hit hangBeforeDoingDeletion failpoint");
+        hangBeforeDoingDeletion.pauseWhileSet(opCtx);
+    }
+
+    int numDeleted = 0;
+    do {
+        BSONObj deletedObj;
+
+        if (throwWriteConflictExceptionInDeleteRange.shouldFail()) {
+            throw WriteConflictException();
+        }
+
+        if (throwInternalErrorInDeleteRange.shouldFail()) {
+            uasserted(ErrorCodes::InternalError, "Failing for test");
+        }
+
+        PlanExecutor::ExecState state;
+        try {
+            state = exec->getNext(&deletedObj, nullptr);
+        } catch (const DBException& ex) {
+            auto&& explainer = exec->getPlanExplainer();
+            auto&& [stats, _] =
+                explainer.getWinningPlanStats(ExplainOptions::Verbosity::kExecStats);
+            LOGV2_WARNING(23776,
+                          "Cursor error while trying to delete {min} to {max} in {namespace}, "
+                          "stats: {stats}, error: {error}",
+                          "Cursor error while trying to delete range",
+                          "min"_attr = redact(min),
+                          "max"_attr = redact(max),
+                          "namespace"_attr = nss,
+                          "stats"_attr = redact(stats),
+                          "error"_attr = redact(ex.toStatus()));
+            throw;
+        }
+
+        if (state == PlanExecutor::IS_EOF) {
+            break;
+        }
+
+        invariant(PlanExecutor::ADVANCED == state);
+        ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(1);
+
+    } while (++numDeleted < numDocsToRemovePerBatch);
+
+    return numDeleted;
+}
+
 /**
  * Performs the deletion of up to numDocsToRemovePerBatch entries within the range in progress. Must
  * be called under the collection lock.
@@ -129,6 +194,45 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
 
     auto const nss = collection->ns();
 
+    auto deleteStageParams = std::make_unique<DeleteStageParams>();
+    deleteStageParams->fromMigrate = true;
+    deleteStageParams->isMulti = true;
+    deleteStageParams->returnDeleted = true;
+
+    if (serverGlobalParams.moveParanoia) {
+        deleteStageParams->removeSaver =
+            std::make_unique<RemoveSaver>("moveChunk", nss.ns(), "cleaning");
+    }
+
+    // A collection clustered by _id and sharded on {_id: 1} stores its documents in shard key
+    // order and has no _id index, so the range is deleted with a scan bounded on the record ids.
+    // The bounds of the scan are inclusive, so the filter excludes the upper bound of the range.
+    if (collection->isClustered() && IndexDescriptor::isIdIndexPattern(keyPattern)) {
+        const auto min = range.getMin().firstElement();
+        const auto max = range.getMax().firstElement();
+        const LTMatchExpression maxFilter(max.fieldNameStringData(), max);
+
+        LOGV2_DEBUG(6000153,
+                    1,
+                    "Begin removal of range using a bounded collection scan",
+                    "min"_attr = range.getMin(),
+                    "max"_attr = range.getMax(),
+                    "namespace"_attr = nss.ns());
+
+        auto exec =
+            InternalPlanner::deleteWithCollectionScan(opCtx,
+                                                      &collection,
+                                                      std::move(deleteStageParams),
+                                                      PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
+                                                      InternalPlanner::FORWARD,
+                                                      record_id_helpers::keyForElem(min),
+                                                      record_id_helpers::keyForElem(max),
+                                                      &maxFilter);
+
+        return deleteDocumentsInBatch(
+            opCtx, exec.get(), nss, range.getMin(), range.getMax(), numDocsToRemovePerBatch);
+    }
+
     // The IndexChunk has a keyPattern that may apply to more than one index - we need to
     // select the index and get the full index keyPattern here.
     auto catalog = collection->getIndexCatalog();
@@ -172,16 +276,6 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
                             "namespace"_attr = nss.ns());
     }
 
-    auto deleteStageParams = std::make_unique<DeleteStageParams>();
-    deleteStageParams->fromMigrate = true;
-    deleteStageParams->isMulti = true;
-    deleteStageParams->returnDeleted = true;
-
-    if (serverGlobalParams.moveParanoia) {
-        deleteStageParams->removeSaver =
-            std::make_unique<RemoveSaver>("moveChunk", nss.ns(), "cleaning");
-    }
-
     auto exec = InternalPlanner::deleteWithIndexScan(opCtx,
                                                      &collection,
                                                      std::move(deleteStageParams),
@@ -192,55 +286,48 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
                                                      PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
                                                      InternalPlanner::FORWARD);
 
-    if (MONGO_unlikely(hangBeforeDoingDeletion.shouldFail())) {
-        LOGV2(23768, "Hit hangBeforeDoingDeletion failpoint");
-        hangBeforeDoingDeletion.pauseWhileSet(opCtx);
-    }
-
-    int numDeleted = 0;
-    do {
-        BSONObj deletedObj;
-
-        if (throwWriteConflictExceptionInDeleteRange.shouldFail()) {
-            throw WriteConflictException();
-        }
+    return deleteDocumentsInBatch(opCtx, exec.get(), nss, min, max, numDocsToRemovePerBatch);
+}
 
-        if (throwInternalErrorInDeleteRange.shouldFail()) {
-            uasserted(ErrorCodes::InternalError, "Failing for test");
-        }
 
-        PlanExecutor::ExecState state;
-        try {
-            state = exec->getNext(&deletedObj, nullptr);
-        } catch (const DBException& ex) {
-            auto&& explainer = exec->getPlanExplainer();
-            auto&& [stats, _] =
-                explainer.getWinningPlanStats(ExplainOptions::Verbosity::kExecStats);
-            LOGV2_WARNING(23776,
-                          "Cursor error while trying to delete {min} to {max} in {namespace}, "
-                          "stats: {stats}, error: {error}",
-                          "Cursor error while trying to delete range",
-                          "min"_attr = redact(min),
-                          "max"_attr = redact(max),
-                          "namespace"_attr = nss,
-                          "stats"_attr = redact(stats),
-                          "error"_attr = redact(ex.toStatus()));
-            throw;
-        }
+/**
+ * If the majority commit point lags behind the last write applied on this node by more than
+ * rangeDeleterReplicationLagThresholdMS, sleeps for the excess, up to kMaxReplicationLagDelay, so
+ * that the deletions do not keep the secondaries from catching up. Must not be called under a
+ * lock.
+ */
+void throttleOnReplicationLag(OperationContext* opCtx) {
+    const Milliseconds threshold{rangeDeleterReplicationLagThresholdMS.load()};
+    if (threshold <= Milliseconds(0)) {
+        return;
+    }
 
-        if (state == PlanExecutor::IS_EOF) {
-            break;
-        }
+    auto const replCoord = repl::ReplicationCoordinator::get(opCtx);
+    if (!replCoord->isReplEnabled()) {
+        return;
+    }
 
-        invariant(PlanExecutor::ADVANCED == state);
-        ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(1);
+    const auto lastCommitted = replCoord->getLastCommittedOpTimeAndWallTime();
+    if (lastCommitted.opTime.isNull()) {
+        return;
+    }
 
-    } while (++numDeleted < numDocsToRemovePerBatch);
+    const auto lag =
+        replCoord->getMyLastAppliedOpTimeAndWallTime().wallTime - lastCommitted.wallTime;
+    if (lag <= threshold) {
+        return;
+    }
 
-    return numDeleted;
+    const auto delay = std::min(duration_cast<Milliseconds>(lag) - threshold,
+                                kMaxReplicationLagDelay);
+    LOGV2_DEBUG(6000154,
+                1,
+                "Delaying range deletion batch because of replication lag",
+                "lag"_attr = lag,
+                "delay"_attr = delay);
+    opCtx->sleepFor(delay);
 }
 
-
 template <typename Callable>
 auto withTemporaryOperationContext(Callable&& callable) {
     ThreadClient tc(migrationutil::kRangeDeletionThreadName, getGlobalServiceContext());
@@ -306,6 +393,8 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                                "numDocsToRemovePerBatch"_attr = numDocsToRemovePerBatch,
                                "delayBetweenBatches"_attr = delayBetweenBatches);
 
+                   throttleOnReplicationLag(opCtx);
+
                    if (migrationId) {
                        ensureRangeDeletionTaskStillExists(opCtx, *migrationId);
                    }
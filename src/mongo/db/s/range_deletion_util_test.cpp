@@ -254,6 +254,47 @@ TEST_F(RangeDeleterTest,
     ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 0);
 }
 
+TEST_F(RangeDeleterTest, RemoveDocumentsInRangeRemovesOnlyDocumentsInRangeOfClusteredCollection) {
+    // Collections clustered by _id have no _id index, so the range is deleted with a bounded
+    // collection scan.
+    const NamespaceString clusteredNss(kNss.db(), "system.buckets.clustered");
+    {
+        OperationShardingState::ScopedAllowImplicitCollectionCreate_UNSAFE unsafeCreateCollection(
+            operationContext());
+        uassertStatusOK(createCollection(
+            operationContext(),
+            clusteredNss.db().toString(),
+            BSON("create" << clusteredNss.coll() << "clusteredIndex" << true)));
+    }
+    const auto clusteredUuid = [&] {
+        AutoGetCollection autoColl(operationContext(), clusteredNss, MODE_IS);
+        return autoColl.getCollection()->uuid();
+    }();
+
+    DBDirectClient dbclient(operationContext());
+    for (auto i = 0; i < 15; ++i) {
+        dbclient.insert(clusteredNss.toString(), BSON(kShardKey << i));
+    }
+
+    auto cleanupComplete =
+        removeDocumentsInRange(executor(),
+                               SemiFuture<void>::makeReady(),
+                               clusteredNss,
+                               clusteredUuid,
+                               kShardKeyPattern,
+                               ChunkRange(BSON(kShardKey << 0), BSON(kShardKey << 10)),
+                               boost::none,
+                               3 /* numDocsToRemovePerBatch */,
+                               Seconds(0) /* delayForActiveQueriesOnSecondariesToComplete*/,
+                               Milliseconds(0) /* delayBetweenBatches */);
+
+    cleanupComplete.get();
+    ASSERT_EQUALS(dbclient.count(clusteredNss, BSONObj()), 5);
+    ASSERT_EQUALS(dbclient.count(clusteredNss, BSON(kShardKey << BSON("$gte" << 10))), 5);
+
+    dbclient.dropCollection(clusteredNss.ns());
+}
+
 TEST_F(RangeDeleterTest, RemoveDocumentsInRangeInsertsDocumentToNotifySecondariesOfRangeDeletion) {
     const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
     const int numDocsToRemovePerBatch = 10;
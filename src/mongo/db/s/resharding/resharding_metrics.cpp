@@ -56,9 +56,11 @@ constexpr auto kDocumentsCopied = "documentsCopied";
 constexpr auto kBytesToCopy = "approxBytesToCopy";
 constexpr auto kBytesCopied = "bytesCopied";
 constexpr auto kCopyTimeElapsed = "totalCopyTimeElapsedSecs";
+constexpr auto kDocumentsCopiedPerSec = "documentsCopiedPerSec";
 constexpr auto kOplogsFetched = "oplogEntriesFetched";
 constexpr auto kOplogsApplied = "oplogEntriesApplied";
 constexpr auto kApplyTimeElapsed = "totalApplyTimeElapsedSecs";
+constexpr auto kOplogsAppliedPerSec = "oplogEntriesAppliedPerSec";
 constexpr auto kWritesDuringCritialSection = "countWritesDuringCriticalSection";
 constexpr auto kCriticalSectionTimeElapsed = "totalCriticalSectionTimeElapsedSecs";
 constexpr auto kCoordinatorState = "coordinatorState";
@@ -289,6 +291,13 @@ void ReshardingMetrics::OperationMetrics::appendCurrentOpMetrics(BSONObjBuilder*
         return durationCount<Seconds>(interval.duration(now));
     };
 
+    // Reports the average rate at which work was done over the named section, or 0 if no time has
+    // been spent in it yet.
+    auto getThroughputPerSec = [&](int64_t work, const TimeInterval& interval) -> int64_t {
+        const auto elapsedMillis = durationCount<Milliseconds>(interval.duration(now));
+        return elapsedMillis > 0 ? work * 1000 / elapsedMillis : 0;
+    };
+
     const auto remainingMsec = remainingOperationTime(now);
 
     bob->append(kOpTimeElapsed, getElapsedTime(runningOperation));
@@ -310,10 +319,14 @@ void ReshardingMetrics::OperationMetrics::appendCurrentOpMetrics(BSONObjBuilder*
             bob->append(kBytesToCopy, bytesToCopy);
             bob->append(kBytesCopied, bytesCopied);
             bob->append(kCopyTimeElapsed, getElapsedTime(copyingDocuments));
+            bob->append(kDocumentsCopiedPerSec,
+                        getThroughputPerSec(documentsCopied, copyingDocuments));
 
             bob->append(kOplogsFetched, oplogEntriesFetched);
             bob->append(kOplogsApplied, oplogEntriesApplied);
             bob->append(kApplyTimeElapsed, getElapsedTime(applyingOplogEntries));
+            bob->append(kOplogsAppliedPerSec,
+                        getThroughputPerSec(oplogEntriesApplied, applyingOplogEntries));
             bob->append(kRecipientState,
                         serializeState(recipientState.get_value_or(RecipientStateEnum::kUnused)));
             bob->append(kOpStatus, ReshardingOperationStatus_serializer(opStatus));
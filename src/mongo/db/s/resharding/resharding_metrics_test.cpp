@@ -574,10 +574,12 @@ TEST_F(ReshardingMetricsTest, CurrentOpReportForRecipient) {
                              "approxBytesToCopy: {8},"
                              "bytesCopied: {9},"
                              "totalCopyTimeElapsedSecs: {10},"
+                             "documentsCopiedPerSec: {11},"
                              "oplogEntriesFetched: 0,"
                              "oplogEntriesApplied: 0,"
                              "totalApplyTimeElapsedSecs: 0,"
-                             "recipientState: \"{11}\","
+                             "oplogEntriesAppliedPerSec: 0,"
+                             "recipientState: \"{12}\","
                              "opStatus: \"running\" }}",
                              options.id.toString(),
                              options.nss.toString(),
@@ -590,6 +592,8 @@ TEST_F(ReshardingMetricsTest, CurrentOpReportForRecipient) {
                              kBytesToCopy,
                              kBytesCopied,
                              durationCount<Seconds>(kTimeSpentCloning),
+                             static_cast<int64_t>(kDocumentsCopied) /
+                                 durationCount<Seconds>(kTimeSpentCloning),
                              RecipientState_serializer(kRecipientState)));
 
     BSONObjBuilder expectedBuilder(std::move(expectedPrefix));
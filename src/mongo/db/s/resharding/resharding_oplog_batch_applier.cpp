@@ -63,13 +63,13 @@ SemiFuture<void> ReshardingOplogBatchApplier::applyBatch(
 
     return resharding::WithAutomaticRetry<unique_function<SemiFuture<void>()>>(
                [this, chainCtx, cancelToken, factory] {
-                   // Writing `auto& i = chainCtx->nextToApply` takes care of incrementing
-                   // chainCtx->nextToApply on each loop iteration.
-                   for (auto& i = chainCtx->nextToApply; i < chainCtx->batch.size(); ++i) {
-                       const auto& oplogEntry = *chainCtx->batch[i];
-                       auto opCtx = factory.makeOperationContext(&cc());
+                   if constexpr (IsForSessionApplication) {
+                       // Writing `auto& i = chainCtx->nextToApply` takes care of incrementing
+                       // chainCtx->nextToApply on each loop iteration.
+                       for (auto& i = chainCtx->nextToApply; i < chainCtx->batch.size(); ++i) {
+                           const auto& oplogEntry = *chainCtx->batch[i];
+                           auto opCtx = factory.makeOperationContext(&cc());
 
-                       if constexpr (IsForSessionApplication) {
                            auto hitPreparedTxn =
                                _sessionApplication.tryApplyOperation(opCtx.get(), oplogEntry);
 
@@ -77,7 +77,15 @@ SemiFuture<void> ReshardingOplogBatchApplier::applyBatch(
                                return future_util::withCancellation(std::move(*hitPreparedTxn),
                                                                     cancelToken);
                            }
-                       } else {
+                       }
+                   } else {
+                       // Each CRUD operation is applied in its own storage transaction, so the
+                       // entries of the writer vector can share a single operation context rather
+                       // than paying for the setup of a new one on every entry.
+                       auto opCtx = factory.makeOperationContext(&cc());
+
+                       for (auto& i = chainCtx->nextToApply; i < chainCtx->batch.size(); ++i) {
+                           const auto& oplogEntry = *chainCtx->batch[i];
                            uassertStatusOK(
                                _crudApplication.applyOperation(opCtx.get(), oplogEntry));
                        }
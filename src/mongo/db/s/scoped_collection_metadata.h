@@ -120,6 +120,10 @@ public:
     bool keyBelongsToMe(const BSONObj& key) const {
         return _impl->get().keyBelongsToMe(key);
     }
+
+    std::vector<ChunkRange> getOwnedRanges() const {
+        return _impl->get().getOwnedRanges();
+    }
 };
 
 }  // namespace mongo
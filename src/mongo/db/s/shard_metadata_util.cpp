@@ -33,6 +33,7 @@
 
 #include "mongo/db/s/shard_metadata_util.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/dbdirectclient.h"
@@ -56,6 +57,11 @@ const WriteConcernOptions kLocalWriteConcern(1,
                                              WriteConcernOptions::SyncMode::UNSET,
                                              Milliseconds(0));
 
+// Bounds the size of the batched writes to config.cache.chunks so that each write command, along
+// with the array overhead of each of its entries, stays within the maximum user BSON object size.
+const int kMaxWriteCommandBatchBytes = BSONObjMaxUserSize - 16 * 1024;
+const int kWriteCommandEntryOverhead = 64;
+
 /**
  * Processes a command result for errors, including write concern errors.
  */
@@ -363,36 +369,88 @@ Status updateShardChunks(OperationContext* opCtx,
          * {_id: 19, max: 22, version 2.0}
          *
          */
-        for (auto& chunk : chunks) {
+
+        // The chunks in 'chunks' never overlap each other, so all the overlapping ranges can be
+        // deleted before any of the new chunks is inserted. Overlapping chunks will have a min
+        // value ("_id") in [chunk.min, chunk.max), and the ranges of chunks that are contiguous in
+        // shard key order are coalesced into a single delete, which turns the many chunks produced
+        // by a split or a refine into a handful of range deletes.
+        std::vector<const ChunkType*> chunksByMin;
+        chunksByMin.reserve(chunks.size());
+        for (const auto& chunk : chunks) {
             invariant(chunk.getVersion().epoch() == currEpoch);
+            chunksByMin.push_back(&chunk);
+        }
+        std::sort(chunksByMin.begin(), chunksByMin.end(), [](const auto* lhs, const auto* rhs) {
+            return lhs->getMin().woCompare(rhs->getMin()) < 0;
+        });
+
+        std::vector<std::pair<BSONObj, BSONObj>> deleteRanges;
+        for (const auto* chunk : chunksByMin) {
+            if (!deleteRanges.empty() &&
+                deleteRanges.back().second.woCompare(chunk->getMin()) == 0) {
+                deleteRanges.back().second = chunk->getMax();
+            } else {
+                deleteRanges.emplace_back(chunk->getMin(), chunk->getMax());
+            }
+        }
 
-            // Delete any overlapping chunk ranges. Overlapping chunks will have a min value
-            // ("_id") between (chunk.min, chunk.max].
-            //
-            // query: { "_id" : {"$gte": chunk.min, "$lt": chunk.max}}
-            auto deleteCommandResponse = client.runCommand([&] {
-                write_ops::DeleteCommandRequest deleteOp(chunksNss);
-                deleteOp.setDeletes({[&] {
-                    write_ops::DeleteOpEntry entry;
-                    entry.setQ(BSON(ChunkType::minShardID
-                                    << BSON("$gte" << chunk.getMin() << "$lt" << chunk.getMax())));
-                    entry.setMulti(true);
-                    return entry;
-                }()});
-                return deleteOp.serialize({});
-            }());
+        std::vector<write_ops::DeleteOpEntry> deletes;
+        int deletesBytes = 0;
+        auto flushDeletes = [&] {
+            if (deletes.empty()) {
+                return;
+            }
+            write_ops::DeleteCommandRequest deleteOp(chunksNss);
+            deleteOp.setDeletes(std::move(deletes));
+            auto deleteCommandResponse = client.runCommand(deleteOp.serialize({}));
             uassertStatusOK(
                 getStatusFromWriteCommandResponse(deleteCommandResponse->getCommandReply()));
+            deletes.clear();
+            deletesBytes = 0;
+        };
+        for (const auto& [min, max] : deleteRanges) {
+            const int entryBytes = min.objsize() + max.objsize() + kWriteCommandEntryOverhead;
+            if (deletes.size() >= write_ops::kMaxWriteBatchSize ||
+                deletesBytes + entryBytes > kMaxWriteCommandBatchBytes) {
+                flushDeletes();
+            }
 
-            // Now the document can be expected to cleanly insert without overlap
-            auto insertCommandResponse = client.runCommand([&] {
-                write_ops::InsertCommandRequest insertOp(chunksNss);
-                insertOp.setDocuments({chunk.toShardBSON()});
-                return insertOp.serialize({});
-            }());
+            write_ops::DeleteOpEntry entry;
+            entry.setQ(BSON(ChunkType::minShardID << BSON("$gte" << min << "$lt" << max)));
+            entry.setMulti(true);
+            deletes.push_back(std::move(entry));
+            deletesBytes += entryBytes;
+        }
+        flushDeletes();
+
+        // Now the documents can be expected to cleanly insert without overlap.
+        std::vector<BSONObj> inserts;
+        int insertsBytes = 0;
+        auto flushInserts = [&] {
+            if (inserts.empty()) {
+                return;
+            }
+            write_ops::InsertCommandRequest insertOp(chunksNss);
+            insertOp.setDocuments(std::move(inserts));
+            auto insertCommandResponse = client.runCommand(insertOp.serialize({}));
             uassertStatusOK(
                 getStatusFromWriteCommandResponse(insertCommandResponse->getCommandReply()));
+            inserts.clear();
+            insertsBytes = 0;
+        };
+        for (const auto& chunk : chunks) {
+            auto doc = chunk.toShardBSON();
+            const int entryBytes = doc.objsize() + kWriteCommandEntryOverhead;
+            if (inserts.size() >= write_ops::kMaxWriteBatchSize ||
+                insertsBytes + entryBytes > kMaxWriteCommandBatchBytes) {
+                flushInserts();
+            }
+
+            inserts.push_back(std::move(doc));
+            insertsBytes += entryBytes;
         }
+        flushInserts();
 
         return Status::OK();
     } catch (const DBException& ex) {
@@ -179,8 +179,8 @@ StatusWith<std::vector<ChunkType>> readShardChunks(OperationContext* opCtx,
 
 /**
  * Takes a vector of 'chunks' and updates the shard's chunks collection for 'nss' or 'uuid'. Any
- * chunk documents in config.cache.chunks.nssOrUuid that overlap with a chunk in 'chunks' is removed
- * as the updated chunk document is inserted. If the epoch of a chunk in 'chunks' does not match
+ * chunk documents in config.cache.chunks.nssOrUuid that overlap with a chunk in 'chunks' are removed
+ * with batched range deletes, after which the updated chunk documents are bulk inserted. If the epoch of a chunk in 'chunks' does not match
  * 'currEpoch', a ConflictingOperationInProgress error is returned and no more updates are applied.
  *
  * Note: two threads running this function in parallel for the same collection can corrupt the
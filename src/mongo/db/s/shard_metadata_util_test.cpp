@@ -326,6 +326,40 @@ TEST_F(ShardMetadataUtilTest, UpdateWithWriteNewChunks) {
     checkChunks(chunks);
 }
 
+TEST_F(ShardMetadataUtilTest, UpdateWithManySplitAndMergedChunks) {
+    std::vector<ChunkType> chunks = makeFourChunks();
+    setUpChunks(chunks);
+
+    // Split the chunk [10, 50) into one chunk per shard key value and merge the chunks [50, 100)
+    // and [100, MaxKey) into a single chunk.
+    std::vector<ChunkType> newChunks;
+    for (int i = 10; i < 50; ++i) {
+        maxCollVersion.incMinor();
+        newChunks.push_back(assertGet(ChunkType::fromShardBSON(
+            BSON(ChunkType::minShardID(BSON("a" << i))
+                 << ChunkType::max(BSON("a" << i + 1)) << ChunkType::shard(kShardId.toString())
+                 << ChunkType::lastmod(Date_t::fromMillisSinceEpoch(maxCollVersion.toLong()))),
+            maxCollVersion.epoch(),
+            maxCollVersion.getTimestamp())));
+    }
+    maxCollVersion.incMinor();
+    newChunks.push_back(assertGet(ChunkType::fromShardBSON(
+        BSON(ChunkType::minShardID(BSON("a" << 50))
+             << ChunkType::max(BSON("a" << MAXKEY)) << ChunkType::shard(kShardId.toString())
+             << ChunkType::lastmod(Date_t::fromMillisSinceEpoch(maxCollVersion.toLong()))),
+        maxCollVersion.epoch(),
+        maxCollVersion.getTimestamp())));
+
+    setUpChunks(newChunks);
+
+    newChunks.push_back(chunks.front());
+    checkChunks(newChunks);
+
+    DBDirectClient client(operationContext());
+    ASSERT_EQUALS(newChunks.size(),
+                  client.count(NamespaceString{ChunkType::ShardNSPrefix + uuid.toString()}));
+}
+
 TEST_F(ShardMetadataUtilTest, DropChunksAndDeleteCollectionsEntry) {
     setUpShardChunkMetadata();
     ASSERT_OK(dropChunksAndDeleteCollectionsEntry(operationContext(), kNss));
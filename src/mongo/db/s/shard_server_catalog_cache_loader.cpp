@@ -48,6 +48,7 @@
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/shard_metadata_util.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/type_shard_collection.h"
 #include "mongo/db/s/type_shard_database.h"
@@ -353,8 +354,11 @@ StatusWith<CollectionAndChangedChunks> getIncompletePersistedMetadataSinceVersio
 /**
  * Sends _flushRoutingTableCacheUpdates to the primary to force it to refresh its routing table for
  * collection 'nss' and then waits for the refresh to replicate to this node.
+ *
+ * If 'shardSecondaryRoutingTableRefreshMaxReplicationWaitMS' is set and the refresh has not
+ * replicated within that time, returns false instead of waiting any further.
  */
-void forcePrimaryCollectionRefreshAndWaitForReplication(OperationContext* opCtx,
+bool forcePrimaryCollectionRefreshAndWaitForReplication(OperationContext* opCtx,
                                                         const NamespaceString& nss) {
     auto const shardingState = ShardingState::get(opCtx);
     invariant(shardingState->enabled());
@@ -372,8 +376,27 @@ void forcePrimaryCollectionRefreshAndWaitForReplication(OperationContext* opCtx,
 
     uassertStatusOK(cmdResponse.commandStatus);
 
-    uassertStatusOK(repl::ReplicationCoordinator::get(opCtx)->waitUntilOpTimeForRead(
-        opCtx, {LogicalTime::fromOperationTime(cmdResponse.response), boost::none}));
+    const auto waitForReplication = [&] {
+        uassertStatusOK(repl::ReplicationCoordinator::get(opCtx)->waitUntilOpTimeForRead(
+            opCtx, {LogicalTime::fromOperationTime(cmdResponse.response), boost::none}));
+    };
+
+    const auto maxReplicationWait =
+        Milliseconds(shardSecondaryRoutingTableRefreshMaxReplicationWaitMS.load());
+    if (maxReplicationWait == Milliseconds::zero()) {
+        waitForReplication();
+        return true;
+    }
+
+    try {
+        opCtx->runWithDeadline(opCtx->getServiceContext()->getFastClockSource()->now() +
+                                   maxReplicationWait,
+                               ErrorCodes::ExceededTimeLimit,
+                               waitForReplication);
+        return true;
+    } catch (const ExceptionFor<ErrorCodes::ExceededTimeLimit>&) {
+        return false;
+    }
 }
 
 /**
@@ -701,7 +724,19 @@ StatusWith<CollectionAndChangedChunks> ShardServerCatalogCacheLoader::_runSecond
     const NamespaceString& nss,
     const ChunkVersion& catalogCacheSinceVersion) {
 
-    forcePrimaryCollectionRefreshAndWaitForReplication(opCtx, nss);
+    if (!forcePrimaryCollectionRefreshAndWaitForReplication(opCtx, nss)) {
+        // The persisted cache lags behind the primary's refresh, so rather than keep the caller
+        // blocked on replication, load the routing table from the config server directly.
+        LOGV2_FOR_CATALOG_REFRESH(
+            5910928,
+            1,
+            "Persisted routing table cache on this secondary is lagging, loading the routing table "
+            "from the config server instead",
+            "namespace"_attr = nss,
+            "sinceVersion"_attr = catalogCacheSinceVersion);
+        return _configServerLoader->getChunksSince(nss, catalogCacheSinceVersion)
+            .getNoThrow(opCtx);
+    }
 
     // Read the local metadata.
 
@@ -31,7 +31,10 @@
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/commands/server_status.h"
+#include <algorithm>
+
 #include "mongo/db/s/active_migrations_registry.h"
+#include "mongo/db/s/collection_sharding_runtime.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/resharding/resharding_metrics.h"
 #include "mongo/db/s/sharding_state.h"
@@ -39,6 +42,7 @@
 #include "mongo/db/vector_clock.h"
 #include "mongo/s/balancer_configuration.h"
 #include "mongo/s/catalog_cache.h"
+#include "mongo/s/chunk_writes_tracker.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
 #include "mongo/s/is_mongos.h"
@@ -134,5 +138,89 @@ public:
 
 } shardingStatisticsServerStatus;
 
+/**
+ * Reports the bytes written to the chunks owned by this shard, as tracked by their
+ * ChunkWritesTracker, so that the balancer can derive the write load of the shard and of its most
+ * written chunk ranges. Only included when explicitly requested, e.g.
+ * {serverStatus: 1, shardingWriteLoad: {numRanges: 20}}.
+ */
+class ShardingWriteLoadServerStatus final : public ServerStatusSection {
+public:
+    static constexpr int kDefaultNumRanges = 10;
+
+    ShardingWriteLoadServerStatus() : ServerStatusSection("shardingWriteLoad") {}
+
+    bool includeByDefault() const override {
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        if (!isClusterNode())
+            return {};
+
+        auto const shardingState = ShardingState::get(opCtx);
+        if (!shardingState->enabled())
+            return {};
+
+        int numRanges = kDefaultNumRanges;
+        if (configElement.type() == Object) {
+            if (auto numRangesElem = configElement.Obj()["numRanges"]; numRangesElem.isNumber()) {
+                numRanges = std::max(0, numRangesElem.numberInt());
+            }
+        }
+
+        struct RangeBytesWritten {
+            NamespaceString nss;
+            BSONObj min;
+            BSONObj max;
+            long long bytesWritten;
+        };
+
+        const auto thisShardId = shardingState->shardId();
+        long long totalBytesWritten = 0;
+        std::vector<RangeBytesWritten> ranges;
+
+        for (const auto& nss : CollectionShardingState::getCollectionNames(opCtx)) {
+            auto css = CollectionShardingState::getSharedForLockFreeReads(opCtx, nss);
+            auto optMetadata =
+                CollectionShardingRuntime::get(css.get())->getCurrentMetadataIfKnown();
+            if (!optMetadata || !optMetadata->isSharded())
+                continue;
+
+            optMetadata->getChunkManager()->forEachChunk([&](const Chunk& chunk) {
+                if (chunk.getShardId() != thisShardId)
+                    return true;
+
+                const long long bytesWritten = chunk.getWritesTracker()->getTotalBytesWritten();
+                if (bytesWritten > 0) {
+                    totalBytesWritten += bytesWritten;
+                    ranges.push_back({nss, chunk.getMin(), chunk.getMax(), bytesWritten});
+                }
+                return true;
+            });
+        }
+
+        const auto rangesEnd = ranges.begin() + std::min<size_t>(numRanges, ranges.size());
+        std::partial_sort(
+            ranges.begin(), rangesEnd, ranges.end(), [](const auto& lhs, const auto& rhs) {
+                return lhs.bytesWritten > rhs.bytesWritten;
+            });
+
+        BSONObjBuilder result;
+        result.append("totalBytesWritten", totalBytesWritten);
+        {
+            BSONArrayBuilder rangesBuilder(result.subarrayStart("ranges"));
+            for (auto it = ranges.begin(); it != rangesEnd; ++it) {
+                rangesBuilder.append(BSON("ns" << it->nss.ns() << "min" << it->min << "max"
+                                               << it->max << "bytesWritten" << it->bytesWritten));
+            }
+        }
+
+        return result.obj();
+    }
+
+} shardingWriteLoadServerStatus;
+
 }  // namespace
 }  // namespace mongo
@@ -39,6 +39,7 @@
 #include "mongo/db/s/transaction_coordinator_document_gen.h"
 #include "mongo/db/s/transaction_coordinator_metrics_observer.h"
 #include "mongo/db/s/transaction_coordinator_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/unittest/log_test.h"
 #include "mongo/unittest/unittest.h"
@@ -818,6 +819,64 @@ TEST_F(TransactionCoordinatorDriverPersistenceTest,
     assertDocumentMatches(allCoordinatorDocs[0], _lsid, txnNumber2, _participants);
 }
 
+TEST_F(TransactionCoordinatorDriverPersistenceTest,
+       BatchedWritesFromConcurrentCoordinatorsPersistAndDeleteEveryDocument) {
+    RAIIServerParameterControllerForTest batchWrites{"transactionCoordinatorBatchDocumentWrites",
+                                                     true};
+    const int kNumSessions = 10;
+
+    std::vector<LogicalSessionId> lsids;
+    for (int i = 0; i < kNumSessions; i++) {
+        lsids.push_back(makeLogicalSessionIdForTest());
+    }
+
+    std::vector<Future<repl::OpTime>> futures;
+    for (const auto& lsid : lsids) {
+        futures.push_back(txn::persistParticipantsList(*_aws, lsid, _txnNumber, _participants));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+    ASSERT_EQUALS(txn::readAllCoordinatorDocs(operationContext()).size(), size_t(kNumSessions));
+
+    futures.clear();
+    for (const auto& lsid : lsids) {
+        futures.push_back(txn::persistDecision(*_aws, lsid, _txnNumber, _participants, [&] {
+            txn::CoordinatorCommitDecision decision(txn::CommitDecision::kCommit);
+            decision.setCommitTimestamp(_commitTimestamp);
+            return decision;
+        }()));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    auto allCoordinatorDocs = txn::readAllCoordinatorDocs(operationContext());
+    ASSERT_EQUALS(allCoordinatorDocs.size(), size_t(kNumSessions));
+    for (const auto& doc : allCoordinatorDocs) {
+        ASSERT(doc.getDecision());
+        ASSERT(doc.getDecision()->getDecision() == txn::CommitDecision::kCommit);
+    }
+
+    std::vector<Future<void>> deleteFutures;
+    for (const auto& lsid : lsids) {
+        deleteFutures.push_back(txn::deleteCoordinatorDoc(*_aws, lsid, _txnNumber));
+    }
+    for (auto& future : deleteFutures) {
+        future.get();
+    }
+    ASSERT_EQUALS(txn::readAllCoordinatorDocs(operationContext()).size(), size_t(0));
+}
+
+TEST_F(TransactionCoordinatorDriverPersistenceTest,
+       BatchedDeleteCoordinatorDocWhenDocumentExistsWithoutDecisionFails) {
+    RAIIServerParameterControllerForTest batchWrites{"transactionCoordinatorBatchDocumentWrites",
+                                                     true};
+    persistParticipantListExpectSuccess(operationContext(), _lsid, _txnNumber, _participants);
+    ASSERT_THROWS_CODE(
+        txn::deleteCoordinatorDoc(*_aws, _lsid, _txnNumber).get(), AssertionException, 51027);
+}
+
 
 using TransactionCoordinatorTest = TransactionCoordinatorTestBase;
 
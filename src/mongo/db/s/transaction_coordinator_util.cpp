@@ -41,12 +41,16 @@
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/s/transaction_coordinator_futures_util.h"
+#include "mongo/db/s/transaction_coordinator_params_gen.h"
 #include "mongo/db/s/transaction_coordinator_worker_curop_repository.h"
 #include "mongo/db/storage/flow_control.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/functional.h"
 
 namespace mongo {
 namespace txn {
@@ -99,25 +103,181 @@ bool shouldRetryPersistingCoordinatorState(const StatusWith<T>& responseStatus)
         responseStatus != ErrorCodes::TransactionCoordinatorSteppingDown;
 }
 
-}  // namespace
+OpMsgRequest makeBatchedWriteCommand(std::vector<write_ops::UpdateOpEntry> updates) {
+    write_ops::UpdateCommandRequest updateOp(NamespaceString::kTransactionCoordinatorsNamespace);
+    updateOp.getWriteCommandRequestBase().setOrdered(false);
+    updateOp.setUpdates(std::move(updates));
+    return updateOp.serialize({});
+}
 
-namespace {
-repl::OpTime persistParticipantListBlocking(OperationContext* opCtx,
-                                            const LogicalSessionId& lsid,
-                                            TxnNumber txnNumber,
-                                            const std::vector<ShardId>& participantList) {
-    LOGV2_DEBUG(22463,
-                3,
-                "{sessionId}:{txnNumber} Going to write participant list",
-                "Going to write participant list",
-                "sessionId"_attr = lsid.getId(),
-                "txnNumber"_attr = txnNumber);
+OpMsgRequest makeBatchedWriteCommand(std::vector<write_ops::DeleteOpEntry> deletes) {
+    write_ops::DeleteCommandRequest deleteOp(NamespaceString::kTransactionCoordinatorsNamespace);
+    deleteOp.getWriteCommandRequestBase().setOrdered(false);
+    deleteOp.setDeletes(std::move(deletes));
+    return deleteOp.serialize({});
+}
 
-    if (MONGO_unlikely(hangBeforeWritingParticipantList.shouldFail())) {
-        LOGV2(22464, "Hit hangBeforeWritingParticipantList failpoint");
-        hangBeforeWritingParticipantList.pauseWhileSet(opCtx);
+/**
+ * Group commit for the writes that the coordinators on this node make to
+ * config.transaction_coordinators. Concurrent writers queue their op entries and whichever of them
+ * finds no batch in flight becomes the leader: it issues up to kMaxWritesPerBatch of the queued
+ * entries as a single unordered write command on its own operation context, and hands the
+ * resulting optime, which covers every entry of the batch, to the writers waiting on it.
+ *
+ * A batch is only acknowledged as a whole if it applied cleanly to exactly one document per entry.
+ * Otherwise each entry is redone through its 'writeAlone' function so that every writer observes
+ * the same error it would have gotten from an individual write. Redoing an entry which the batch
+ * did apply has no effect other than matching the document again, because every coordinator write
+ * is conditioned on the state that it leaves the document in.
+ */
+template <typename OpEntry>
+class CoordinatorDocWriteGroup {
+public:
+    /**
+     * Writes the entry on its own, throwing on failure. The boolean indicates whether a batch
+     * containing the entry has already been attempted.
+     */
+    using WriteAloneFn = unique_function<void(OperationContext*, bool)>;
+
+    repl::OpTime write(OperationContext* opCtx, OpEntry entry, WriteAloneFn writeAlone) {
+        auto pending = std::make_shared<PendingWrite>(std::move(entry), std::move(writeAlone));
+
+        stdx::unique_lock<Latch> lk(_mutex);
+        _queue.push_back(pending);
+
+        while (true) {
+            // If this opCtx is interrupted while waiting, the entry stays queued and will still be
+            // written by a later leader, which is indistinguishable from a write whose response
+            // was lost.
+            opCtx->waitForConditionOrInterrupt(
+                _batchDone, lk, [&] { return pending->result || !_flushing; });
+            if (pending->result) {
+                return uassertStatusOK(*pending->result);
+            }
+
+            _flushing = true;
+            const auto batchEnd =
+                _queue.begin() + std::min<size_t>(_queue.size(), kMaxWritesPerBatch);
+            std::vector<std::shared_ptr<PendingWrite>> batch(_queue.begin(), batchEnd);
+            _queue.erase(_queue.begin(), batchEnd);
+            lk.unlock();
+
+            auto results = _flush(opCtx, batch);
+
+            lk.lock();
+            for (size_t i = 0; i < batch.size(); ++i) {
+                batch[i]->result.emplace(std::move(results[i]));
+            }
+            _flushing = false;
+            _batchDone.notify_all();
+        }
     }
 
+private:
+    static constexpr size_t kMaxWritesPerBatch = 500;
+
+    struct PendingWrite {
+        PendingWrite(OpEntry entry, WriteAloneFn writeAlone)
+            : entry(std::move(entry)), writeAlone(std::move(writeAlone)) {}
+
+        const OpEntry entry;
+        WriteAloneFn writeAlone;
+
+        // Set by the leader which wrote the entry, under the group's mutex
+        boost::optional<StatusWith<repl::OpTime>> result;
+    };
+
+    std::vector<StatusWith<repl::OpTime>> _flush(
+        OperationContext* opCtx, const std::vector<std::shared_ptr<PendingWrite>>& batch) {
+        const bool isBatched = batch.size() > 1;
+
+        if (isBatched) {
+            try {
+                std::vector<OpEntry> entries;
+                entries.reserve(batch.size());
+                for (const auto& pending : batch) {
+                    entries.push_back(pending->entry);
+                }
+
+                DBDirectClient client(opCtx);
+                const auto commandResponse =
+                    client.runCommand(makeBatchedWriteCommand(std::move(entries)));
+                const auto commandReply = commandResponse->getCommandReply();
+
+                if (getStatusFromWriteCommandReply(commandReply).isOK() &&
+                    commandReply.getIntField("n") == static_cast<int>(batch.size())) {
+                    const auto& lastOp =
+                        repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp();
+                    return std::vector<StatusWith<repl::OpTime>>(batch.size(), lastOp);
+                }
+            } catch (const DBException& ex) {
+                return std::vector<StatusWith<repl::OpTime>>(batch.size(), ex.toStatus());
+            }
+        }
+
+        std::vector<StatusWith<repl::OpTime>> results;
+        results.reserve(batch.size());
+        for (const auto& pending : batch) {
+            try {
+                pending->writeAlone(opCtx, isBatched);
+                results.emplace_back(
+                    repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp());
+            } catch (const DBException& ex) {
+                results.emplace_back(ex.toStatus());
+            }
+        }
+        return results;
+    }
+
+    Mutex _mutex = MONGO_MAKE_LATCH("CoordinatorDocWriteGroup::_mutex");
+
+    // Signalled every time a leader finishes writing a batch
+    stdx::condition_variable _batchDone;
+
+    // Whether some writer is currently writing a batch
+    bool _flushing{false};
+
+    std::deque<std::shared_ptr<PendingWrite>> _queue;
+};
+
+const auto getCoordinatorDocUpdateGroup =
+    ServiceContext::declareDecoration<CoordinatorDocWriteGroup<write_ops::UpdateOpEntry>>();
+
+const auto getCoordinatorDocDeleteGroup =
+    ServiceContext::declareDecoration<CoordinatorDocWriteGroup<write_ops::DeleteOpEntry>>();
+
+}  // namespace
+
+namespace {
+write_ops::UpdateOpEntry makeParticipantListUpdate(const OperationSessionInfo& sessionInfo,
+                                                    const std::vector<ShardId>& participantList) {
+    write_ops::UpdateOpEntry entry;
+
+    // Ensure that the document for the (lsid, txnNumber) either has no participant list or has the
+    // same participant list. The document may have the same participant list if an earlier attempt
+    // to write the participant list failed waiting for writeConcern.
+    BSONObj noParticipantList =
+        BSON(TransactionCoordinatorDocument::kParticipantsFieldName << BSON("$exists" << false));
+    BSONObj sameParticipantList =
+        BSON("$and" << buildParticipantListMatchesConditions(participantList));
+    entry.setQ(BSON(TransactionCoordinatorDocument::kIdFieldName
+                    << sessionInfo.toBSON() << "$or"
+                    << BSON_ARRAY(noParticipantList << sameParticipantList)));
+
+    // Update with participant list.
+    TransactionCoordinatorDocument doc;
+    doc.setId(sessionInfo);
+    doc.setParticipants(participantList);
+    entry.setU(write_ops::UpdateModification::parseFromClassicUpdate(doc.toBSON()));
+
+    entry.setUpsert(true);
+    return entry;
+}
+
+void writeParticipantListAlone(OperationContext* opCtx,
+                               const LogicalSessionId& lsid,
+                               TxnNumber txnNumber,
+                               const std::vector<ShardId>& participantList) {
     OperationSessionInfo sessionInfo;
     sessionInfo.setSessionId(lsid);
     sessionInfo.setTxnNumber(txnNumber);
@@ -128,29 +288,7 @@ repl::OpTime persistParticipantListBlocking(OperationContext* opCtx,
     const auto commandResponse = client.runCommand([&] {
         write_ops::UpdateCommandRequest updateOp(
             NamespaceString::kTransactionCoordinatorsNamespace);
-        updateOp.setUpdates({[&] {
-            write_ops::UpdateOpEntry entry;
-
-            // Ensure that the document for the (lsid, txnNumber) either has no participant list or
-            // has the same participant list. The document may have the same participant list if an
-            // earlier attempt to write the participant list failed waiting for writeConcern.
-            BSONObj noParticipantList = BSON(TransactionCoordinatorDocument::kParticipantsFieldName
-                                             << BSON("$exists" << false));
-            BSONObj sameParticipantList =
-                BSON("$and" << buildParticipantListMatchesConditions(participantList));
-            entry.setQ(BSON(TransactionCoordinatorDocument::kIdFieldName
-                            << sessionInfo.toBSON() << "$or"
-                            << BSON_ARRAY(noParticipantList << sameParticipantList)));
-
-            // Update with participant list.
-            TransactionCoordinatorDocument doc;
-            doc.setId(std::move(sessionInfo));
-            doc.setParticipants(std::move(participantList));
-            entry.setU(write_ops::UpdateModification::parseFromClassicUpdate(doc.toBSON()));
-
-            entry.setUpsert(true);
-            return entry;
-        }()});
+        updateOp.setUpdates({makeParticipantListUpdate(sessionInfo, participantList)});
         return updateOp.serialize({});
     }());
 
@@ -173,6 +311,40 @@ repl::OpTime persistParticipantListBlocking(OperationContext* opCtx,
 
     // Throw any other error.
     uassertStatusOK(upsertStatus);
+}
+
+repl::OpTime persistParticipantListBlocking(OperationContext* opCtx,
+                                            const LogicalSessionId& lsid,
+                                            TxnNumber txnNumber,
+                                            const std::vector<ShardId>& participantList) {
+    LOGV2_DEBUG(22463,
+                3,
+                "{sessionId}:{txnNumber} Going to write participant list",
+                "Going to write participant list",
+                "sessionId"_attr = lsid.getId(),
+                "txnNumber"_attr = txnNumber);
+
+    if (MONGO_unlikely(hangBeforeWritingParticipantList.shouldFail())) {
+        LOGV2(22464, "Hit hangBeforeWritingParticipantList failpoint");
+        hangBeforeWritingParticipantList.pauseWhileSet(opCtx);
+    }
+
+    repl::OpTime opTime;
+    if (transactionCoordinatorBatchDocumentWrites.load()) {
+        OperationSessionInfo sessionInfo;
+        sessionInfo.setSessionId(lsid);
+        sessionInfo.setTxnNumber(txnNumber);
+
+        opTime = getCoordinatorDocUpdateGroup(opCtx->getServiceContext())
+                     .write(opCtx,
+                            makeParticipantListUpdate(sessionInfo, participantList),
+                            [lsid, txnNumber, participantList](OperationContext* opCtx, bool) {
+                                writeParticipantListAlone(opCtx, lsid, txnNumber, participantList);
+                            });
+    } else {
+        writeParticipantListAlone(opCtx, lsid, txnNumber, participantList);
+        opTime = repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp();
+    }
 
     LOGV2_DEBUG(22465,
                 3,
@@ -180,7 +352,7 @@ repl::OpTime persistParticipantListBlocking(OperationContext* opCtx,
                 "sessionId"_attr = lsid.getId(),
                 "txnNumber"_attr = txnNumber);
 
-    return repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp();
+    return opTime;
 }
 }  // namespace
 
@@ -306,23 +478,42 @@ Future<PrepareVoteConsensus> sendPrepare(ServiceContext* service,
 }
 
 namespace {
-repl::OpTime persistDecisionBlocking(OperationContext* opCtx,
-                                     const LogicalSessionId& lsid,
-                                     TxnNumber txnNumber,
-                                     const std::vector<ShardId>& participantList,
-                                     const txn::CoordinatorCommitDecision& decision) {
-    const bool isCommit = decision.getDecision() == txn::CommitDecision::kCommit;
-    LOGV2_DEBUG(22467,
-                3,
-                "{sessionId}:{txnNumber} Going to write decision {decision}",
-                "sessionId"_attr = lsid.getId(),
-                "txnNumber"_attr = txnNumber,
-                "decision"_attr = (isCommit ? "commit" : "abort"));
+write_ops::UpdateOpEntry makeDecisionUpdate(const OperationSessionInfo& sessionInfo,
+                                             const std::vector<ShardId>& participantList,
+                                             const txn::CoordinatorCommitDecision& decision) {
+    write_ops::UpdateOpEntry entry;
+
+    // Ensure that the document for the (lsid, txnNumber) has the same participant list and either
+    // has no decision or the same decision. The document may have the same decision if an earlier
+    // attempt to write the decision failed waiting for writeConcern.
+    BSONObj noDecision =
+        BSON(TransactionCoordinatorDocument::kDecisionFieldName << BSON("$exists" << false));
+    BSONObj sameDecision =
+        BSON(TransactionCoordinatorDocument::kDecisionFieldName << decision.toBSON());
+
+    entry.setQ(BSON(TransactionCoordinatorDocument::kIdFieldName
+                    << sessionInfo.toBSON() << "$and"
+                    << buildParticipantListMatchesConditions(participantList) << "$or"
+                    << BSON_ARRAY(noDecision << sameDecision)));
+
+    entry.setUpsert(true);
+    entry.setU(write_ops::UpdateModification::parseFromClassicUpdate([&] {
+        TransactionCoordinatorDocument doc;
+        doc.setId(sessionInfo);
+        doc.setParticipants(participantList);
+        doc.setDecision(decision);
+        return doc.toBSON();
+    }()));
+
+    return entry;
+}
 
-    if (MONGO_unlikely(hangBeforeWritingDecision.shouldFail())) {
-        LOGV2(22468, "Hit hangBeforeWritingDecision failpoint");
-        hangBeforeWritingDecision.pauseWhileSet(opCtx);
-    }
+void writeDecisionAlone(OperationContext* opCtx,
+                        const LogicalSessionId& lsid,
+                        TxnNumber txnNumber,
+                        const std::vector<ShardId>& participantList,
+                        const txn::CoordinatorCommitDecision& decision) {
+    const bool isCommit = decision.getDecision() == txn::CommitDecision::kCommit;
 
     OperationSessionInfo sessionInfo;
     sessionInfo.setSessionId(lsid);
@@ -334,33 +525,7 @@ repl::OpTime persistDecisionBlocking(OperationContext* opCtx,
     const auto commandResponse = client.runCommand([&] {
         write_ops::UpdateCommandRequest updateOp(
             NamespaceString::kTransactionCoordinatorsNamespace);
-        updateOp.setUpdates({[&] {
-            write_ops::UpdateOpEntry entry;
-
-            // Ensure that the document for the (lsid, txnNumber) has the same participant list and
-            // either has no decision or the same decision. The document may have the same decision
-            // if an earlier attempt to write the decision failed waiting for writeConcern.
-            BSONObj noDecision = BSON(TransactionCoordinatorDocument::kDecisionFieldName
-                                      << BSON("$exists" << false));
-            BSONObj sameDecision =
-                BSON(TransactionCoordinatorDocument::kDecisionFieldName << decision.toBSON());
-
-            entry.setQ(BSON(TransactionCoordinatorDocument::kIdFieldName
-                            << sessionInfo.toBSON() << "$and"
-                            << buildParticipantListMatchesConditions(participantList) << "$or"
-                            << BSON_ARRAY(noDecision << sameDecision)));
-
-            entry.setUpsert(true);
-            entry.setU(write_ops::UpdateModification::parseFromClassicUpdate([&] {
-                TransactionCoordinatorDocument doc;
-                doc.setId(sessionInfo);
-                doc.setParticipants(std::move(participantList));
-                doc.setDecision(decision);
-                return doc.toBSON();
-            }()));
-
-            return entry;
-        }()});
+        updateOp.setUpdates({makeDecisionUpdate(sessionInfo, participantList, decision)});
         return updateOp.serialize({});
     }());
 
@@ -385,6 +550,43 @@ repl::OpTime persistDecisionBlocking(OperationContext* opCtx,
                                    "or commitTimestamp: "
                                 << doc);
     }
+}
+
+repl::OpTime persistDecisionBlocking(OperationContext* opCtx,
+                                     const LogicalSessionId& lsid,
+                                     TxnNumber txnNumber,
+                                     const std::vector<ShardId>& participantList,
+                                     const txn::CoordinatorCommitDecision& decision) {
+    const bool isCommit = decision.getDecision() == txn::CommitDecision::kCommit;
+    LOGV2_DEBUG(22467,
+                3,
+                "{sessionId}:{txnNumber} Going to write decision {decision}",
+                "sessionId"_attr = lsid.getId(),
+                "txnNumber"_attr = txnNumber,
+                "decision"_attr = (isCommit ? "commit" : "abort"));
+
+    if (MONGO_unlikely(hangBeforeWritingDecision.shouldFail())) {
+        LOGV2(22468, "Hit hangBeforeWritingDecision failpoint");
+        hangBeforeWritingDecision.pauseWhileSet(opCtx);
+    }
+
+    repl::OpTime opTime;
+    if (transactionCoordinatorBatchDocumentWrites.load()) {
+        OperationSessionInfo sessionInfo;
+        sessionInfo.setSessionId(lsid);
+        sessionInfo.setTxnNumber(txnNumber);
+
+        opTime =
+            getCoordinatorDocUpdateGroup(opCtx->getServiceContext())
+                .write(opCtx,
+                       makeDecisionUpdate(sessionInfo, participantList, decision),
+                       [lsid, txnNumber, participantList, decision](OperationContext* opCtx, bool) {
+                           writeDecisionAlone(opCtx, lsid, txnNumber, participantList, decision);
+                       });
+    } else {
+        writeDecisionAlone(opCtx, lsid, txnNumber, participantList, decision);
+        opTime = repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp();
+    }
 
     LOGV2_DEBUG(22469,
                 3,
@@ -394,7 +596,7 @@ repl::OpTime persistDecisionBlocking(OperationContext* opCtx,
                 "txnNumber"_attr = txnNumber,
                 "decision"_attr = (isCommit ? "commit" : "abort"));
 
-    return repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp();
+    return opTime;
 }
 }  // namespace
 
@@ -487,47 +689,43 @@ Future<void> sendAbort(ServiceContext* service,
 }
 
 namespace {
-void deleteCoordinatorDocBlocking(OperationContext* opCtx,
-                                  const LogicalSessionId& lsid,
-                                  TxnNumber txnNumber) {
-    LOGV2_DEBUG(22472,
-                3,
-                "{sessionId}:{txnNumber} Going to delete coordinator doc",
-                "Going to delete coordinator doc",
-                "sessionId"_attr = lsid.getId(),
-                "txnNumber"_attr = txnNumber);
+write_ops::DeleteOpEntry makeCoordinatorDocDelete(const OperationSessionInfo& sessionInfo) {
+    write_ops::DeleteOpEntry entry;
 
-    if (MONGO_unlikely(hangBeforeDeletingCoordinatorDoc.shouldFail())) {
-        LOGV2(22473, "Hit hangBeforeDeletingCoordinatorDoc failpoint");
-        hangBeforeDeletingCoordinatorDoc.pauseWhileSet(opCtx);
-    }
+    // Ensure the document is only deleted after a decision has been made.
+    entry.setQ(BSON(TransactionCoordinatorDocument::kIdFieldName
+                    << sessionInfo.toBSON() << TransactionCoordinatorDocument::kDecisionFieldName
+                    << BSON("$exists" << true)));
+
+    entry.setMulti(false);
+    return entry;
+}
 
+void deleteCoordinatorDocAlone(OperationContext* opCtx,
+                               const LogicalSessionId& lsid,
+                               TxnNumber txnNumber,
+                               bool retryingBatchedDelete) {
     OperationSessionInfo sessionInfo;
     sessionInfo.setSessionId(lsid);
     sessionInfo.setTxnNumber(txnNumber);
 
     DBDirectClient client(opCtx);
 
+    // Unlike the updates, a delete which the batch applied cannot simply be redone, so only redo
+    // the ones whose document is still there.
+    if (retryingBatchedDelete &&
+        client
+            .findOne(NamespaceString::kTransactionCoordinatorsNamespace.toString(),
+                     QUERY(TransactionCoordinatorDocument::kIdFieldName << sessionInfo.toBSON()))
+            .isEmpty()) {
+        return;
+    }
+
     // Throws if serializing the request or deserializing the response fails.
     auto commandResponse = client.runCommand([&] {
         write_ops::DeleteCommandRequest deleteOp(
             NamespaceString::kTransactionCoordinatorsNamespace);
-        deleteOp.setDeletes({[&] {
-            write_ops::DeleteOpEntry entry;
-
-            // Ensure the document is only deleted after a decision has been made.
-            BSONObj abortDecision =
-                BSON(TransactionCoordinatorDocument::kDecisionFieldName << "abort");
-            BSONObj commitDecision =
-                BSON(TransactionCoordinatorDocument::kDecisionFieldName << "commit");
-            entry.setQ(BSON(TransactionCoordinatorDocument::kIdFieldName
-                            << sessionInfo.toBSON()
-                            << TransactionCoordinatorDocument::kDecisionFieldName
-                            << BSON("$exists" << true)));
-
-            entry.setMulti(false);
-            return entry;
-        }()});
+        deleteOp.setDeletes({makeCoordinatorDocDelete(sessionInfo)});
         return deleteOp.serialize({});
     }());
 
@@ -550,6 +748,37 @@ void deleteCoordinatorDocBlocking(OperationContext* opCtx,
                                    "document existed without a decision: "
                                 << doc);
     }
+}
+
+void deleteCoordinatorDocBlocking(OperationContext* opCtx,
+                                  const LogicalSessionId& lsid,
+                                  TxnNumber txnNumber) {
+    LOGV2_DEBUG(22472,
+                3,
+                "{sessionId}:{txnNumber} Going to delete coordinator doc",
+                "Going to delete coordinator doc",
+                "sessionId"_attr = lsid.getId(),
+                "txnNumber"_attr = txnNumber);
+
+    if (MONGO_unlikely(hangBeforeDeletingCoordinatorDoc.shouldFail())) {
+        LOGV2(22473, "Hit hangBeforeDeletingCoordinatorDoc failpoint");
+        hangBeforeDeletingCoordinatorDoc.pauseWhileSet(opCtx);
+    }
+
+    if (transactionCoordinatorBatchDocumentWrites.load()) {
+        OperationSessionInfo sessionInfo;
+        sessionInfo.setSessionId(lsid);
+        sessionInfo.setTxnNumber(txnNumber);
+
+        getCoordinatorDocDeleteGroup(opCtx->getServiceContext())
+            .write(opCtx,
+                   makeCoordinatorDocDelete(sessionInfo),
+                   [lsid, txnNumber](OperationContext* opCtx, bool retryingBatchedDelete) {
+                       deleteCoordinatorDocAlone(opCtx, lsid, txnNumber, retryingBatchedDelete);
+                   });
+    } else {
+        deleteCoordinatorDocAlone(opCtx, lsid, txnNumber, false /* retryingBatchedDelete */);
+    }
 
     LOGV2_DEBUG(22474,
                 3,
@@ -82,6 +82,7 @@
 #include "mongo/db/session_catalog_mongod.h"
 #include "mongo/db/stats/api_version_metrics.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/db/stats/query_shape_stats.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
 #include "mongo/db/stats/server_read_concern_metrics.h"
 #include "mongo/db/stats/top.h"
@@ -1271,8 +1272,7 @@ void ExecCommandDatabase::_initiateCommand() {
     auto& apiParams = APIParameters::get(opCtx);
     auto& apiVersionMetrics = APIVersionMetrics::get(opCtx->getServiceContext());
     if (auto clientMetadata = ClientMetadata::get(client)) {
-        auto appName = clientMetadata->getApplicationName().toString();
-        apiVersionMetrics.update(appName, apiParams);
+        apiVersionMetrics.update(client, clientMetadata->getApplicationName(), apiParams);
     }
 
     sleepMillisAfterCommandExecutionBegins.execute([&](const BSONObj& data) {
@@ -2064,6 +2064,7 @@ void HandleRequest::completeOperation(DbResponse& response) {
             opCtx,
             durationCount<Microseconds>(currentOp.elapsedTimeExcludingPauses()),
             currentOp.getReadWriteType());
+    QueryShapeStatsStore::recordOperation(opCtx, currentOp);
 
     if (shouldProfile) {
         // Performance profiling is on
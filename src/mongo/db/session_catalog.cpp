@@ -52,17 +52,21 @@ const auto operationSessionDecoration =
 }  // namespace
 
 SessionCatalog::~SessionCatalog() {
-    stdx::lock_guard<Latch> lg(_mutex);
-    for (const auto& entry : _sessions) {
-        ObservableSession session(lg, entry.second->session);
-        invariant(!session.hasCurrentOperation());
-        invariant(!session._killed());
+    for (auto& stripe : _stripes) {
+        stdx::lock_guard<Latch> lg(stripe.mutex);
+        for (const auto& entry : stripe.sessions) {
+            ObservableSession session(lg, entry.second->session);
+            invariant(!session.hasCurrentOperation());
+            invariant(!session._killed());
+        }
     }
 }
 
 void SessionCatalog::reset_forTest() {
-    stdx::lock_guard<Latch> lg(_mutex);
-    _sessions.clear();
+    for (auto& stripe : _stripes) {
+        stdx::lock_guard<Latch> lg(stripe.mutex);
+        stripe.sessions.clear();
+    }
 }
 
 SessionCatalog* SessionCatalog::get(OperationContext* opCtx) {
@@ -87,10 +91,11 @@ SessionCatalog::ScopedCheckedOutSession SessionCatalog::_checkOutSessionWithPare
         invariant(opCtx->getLogicalSessionId() == lsid);
     }
 
-    stdx::unique_lock<Latch> ul(_mutex);
+    auto& stripe = _getStripe(lsid);
+    stdx::unique_lock<Latch> ul(stripe.mutex);
 
-    auto parentSri = _getOrCreateSessionRuntimeInfo(ul, *getParentSessionId(lsid));
-    auto childSri = _getOrCreateSessionRuntimeInfo(ul, lsid);
+    auto parentSri = _getOrCreateSessionRuntimeInfo(ul, stripe, *getParentSessionId(lsid));
+    auto childSri = _getOrCreateSessionRuntimeInfo(ul, stripe, lsid);
 
     if (killToken) {
         invariant(ObservableSession(ul, childSri->session)._killed());
@@ -142,9 +147,10 @@ SessionCatalog::ScopedCheckedOutSession SessionCatalog::_checkOutSessionWithoutP
         invariant(opCtx->getLogicalSessionId() == lsid);
     }
 
-    stdx::unique_lock<Latch> ul(_mutex);
+    auto& stripe = _getStripe(lsid);
+    stdx::unique_lock<Latch> ul(stripe.mutex);
 
-    auto sri = _getOrCreateSessionRuntimeInfo(ul, lsid);
+    auto sri = _getOrCreateSessionRuntimeInfo(ul, stripe, lsid);
     if (killToken) {
         invariant(ObservableSession(ul, sri->session)._killed());
     }
@@ -200,16 +206,17 @@ void SessionCatalog::scanSession(const LogicalSessionId& lsid,
     std::unique_ptr<SessionRuntimeInfo> sessionToReap;
 
     {
-        stdx::lock_guard<Latch> lg(_mutex);
-        auto it = _sessions.find(lsid);
-        if (it != _sessions.end()) {
+        auto& stripe = _getStripe(lsid);
+        stdx::lock_guard<Latch> lg(stripe.mutex);
+        auto it = stripe.sessions.find(lsid);
+        if (it != stripe.sessions.end()) {
             auto& sri = it->second;
             ObservableSession osession(lg, sri->session);
             workerFn(osession);
 
             if (osession._shouldBeReaped(sri->numWaitingToCheckOut)) {
                 sessionToReap = std::move(sri);
-                _sessions.erase(it);
+                stripe.sessions.erase(it);
             }
         }
     }
@@ -219,16 +226,18 @@ void SessionCatalog::scanSessions(const SessionKiller::Matcher& matcher,
                                   const ScanSessionsCallbackFn& workerFn) {
     std::vector<std::unique_ptr<SessionRuntimeInfo>> sessionsToReap;
 
-    {
-        stdx::lock_guard<Latch> lg(_mutex);
+    LOGV2_DEBUG(21976,
+                2,
+                "Scanning {sessionCount} sessions",
+                "Scanning sessions",
+                "sessionCount"_attr = size());
 
-        LOGV2_DEBUG(21976,
-                    2,
-                    "Scanning {sessionCount} sessions",
-                    "Scanning sessions",
-                    "sessionCount"_attr = _sessions.size());
+    // Each stripe is scanned under its own mutex, so that concurrent check-outs of sessions in
+    // other stripes are not blocked for the duration of the whole scan
+    for (auto& stripe : _stripes) {
+        stdx::lock_guard<Latch> lg(stripe.mutex);
 
-        for (auto it = _sessions.begin(); it != _sessions.end(); ++it) {
+        for (auto it = stripe.sessions.begin(); it != stripe.sessions.end(); ++it) {
             if (matcher.match(it->first)) {
                 auto& sri = it->second;
                 ObservableSession osession(lg, sri->session);
@@ -237,7 +246,7 @@ void SessionCatalog::scanSessions(const SessionKiller::Matcher& matcher,
 
                 if (osession._shouldBeReaped(sri->numWaitingToCheckOut)) {
                     sessionsToReap.emplace_back(std::move(sri));
-                    _sessions.erase(it++);
+                    stripe.sessions.erase(it++);
                 }
             }
         }
@@ -245,45 +254,57 @@ void SessionCatalog::scanSessions(const SessionKiller::Matcher& matcher,
 }
 
 SessionCatalog::KillToken SessionCatalog::killSession(const LogicalSessionId& lsid) {
-    stdx::lock_guard<Latch> lg(_mutex);
+    auto& stripe = _getStripe(lsid);
+    stdx::lock_guard<Latch> lg(stripe.mutex);
 
-    auto sri = _getSessionRuntimeInfo(lg, lsid);
+    auto sri = _getSessionRuntimeInfo(lg, stripe, lsid);
     uassert(ErrorCodes::NoSuchSession, "Session not found", sri);
     return ObservableSession(lg, sri->session).kill();
 }
 
 size_t SessionCatalog::size() const {
-    stdx::lock_guard<Latch> lg(_mutex);
-    return _sessions.size();
+    size_t total = 0;
+    for (const auto& stripe : _stripes) {
+        stdx::lock_guard<Latch> lg(stripe.mutex);
+        total += stripe.sessions.size();
+    }
+    return total;
+}
+
+SessionCatalog::Stripe& SessionCatalog::_getStripe(const LogicalSessionId& lsid) {
+    // Only the parent session's id takes part in the hash, so that a child session and its parent
+    // are always placed in the same stripe
+    return _stripes[UUID::Hash()(lsid.getId()) % kNumStripes];
 }
 
 SessionCatalog::SessionRuntimeInfo* SessionCatalog::_getSessionRuntimeInfo(
-    WithLock, const LogicalSessionId& lsid) {
-    auto it = _sessions.find(lsid);
-    if (it == _sessions.end()) {
+    WithLock, Stripe& stripe, const LogicalSessionId& lsid) {
+    auto it = stripe.sessions.find(lsid);
+    if (it == stripe.sessions.end()) {
         return nullptr;
     }
     return it->second.get();
 }
 
 SessionCatalog::SessionRuntimeInfo* SessionCatalog::_getOrCreateSessionRuntimeInfo(
-    WithLock lk, const LogicalSessionId& lsid) {
-    if (auto sri = _getSessionRuntimeInfo(lk, lsid)) {
+    WithLock lk, Stripe& stripe, const LogicalSessionId& lsid) {
+    if (auto sri = _getSessionRuntimeInfo(lk, stripe, lsid)) {
         return sri;
     }
 
-    auto it = _sessions.emplace(lsid, std::make_unique<SessionRuntimeInfo>(lsid)).first;
+    auto it = stripe.sessions.emplace(lsid, std::make_unique<SessionRuntimeInfo>(lsid)).first;
     return it->second.get();
 }
 
 void SessionCatalog::_releaseSession(SessionRuntimeInfo* sri,
                                      SessionRuntimeInfo* parentSri,
                                      boost::optional<KillToken> killToken) {
-    stdx::lock_guard<Latch> lg(_mutex);
+    auto& stripe = _getStripe(sri->session.getSessionId());
+    stdx::lock_guard<Latch> lg(stripe.mutex);
 
     // Make sure we have exactly the same session on the map and that it is still associated with an
     // operation context (meaning checked-out)
-    invariant(_sessions[sri->session.getSessionId()].get() == sri);
+    invariant(stripe.sessions[sri->session.getSessionId()].get() == sri);
     invariant(sri->session._checkoutOpCtx);
     if (killToken) {
         invariant(killToken->lsidToKill == sri->session.getSessionId());
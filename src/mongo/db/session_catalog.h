@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <boost/optional.hpp>
 #include <vector>
 
@@ -92,11 +93,12 @@ public:
     SessionToKill checkOutSessionForKill(OperationContext* opCtx, KillToken killToken);
 
     /**
-     * Iterates through the SessionCatalog under the SessionCatalog mutex and applies 'workerFn' to
-     * each Session which matches the specified 'matcher'.
+     * Iterates through the SessionCatalog stripe by stripe, under each stripe's mutex, and applies
+     * 'workerFn' to each Session which matches the specified 'matcher'. Sessions in different
+     * stripes are not observed atomically with respect to each other.
      *
-     * NOTE: Since this method runs with the session catalog mutex, the work done by 'workerFn' is
-     * not allowed to block, perform I/O or acquire any lock manager locks.
+     * NOTE: Since this method runs with a session catalog stripe mutex, the work done by 'workerFn'
+     * is not allowed to block, perform I/O or acquire any lock manager locks.
      * Iterates through the SessionCatalog and applies 'workerFn' to each Session. This locks the
      * SessionCatalog.
      */
@@ -136,6 +138,28 @@ private:
     };
     using SessionRuntimeInfoMap = LogicalSessionIdMap<std::unique_ptr<SessionRuntimeInfo>>;
 
+    /**
+     * One shard of the session map. Checking out a session only contends with sessions which hash
+     * to the same stripe. A child session always lives in the same stripe as its parent (the
+     * stripe is chosen by the parent session's id), so checking out both of them only requires a
+     * single stripe mutex.
+     */
+    struct Stripe {
+        // Protects the state below
+        mutable Mutex mutex =
+            MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(4), "SessionCatalog::Stripe::mutex");
+
+        // Owns the Session objects for all current Sessions in this stripe.
+        SessionRuntimeInfoMap sessions;
+    };
+
+    static constexpr size_t kNumStripes = 16;
+
+    /**
+     * Returns the stripe which owns 'lsid' and, if it has one, its parent session.
+     */
+    Stripe& _getStripe(const LogicalSessionId& lsid);
+
     /**
      * Blocking method, which checks-out the session with the given 'lsid'.
      */
@@ -153,16 +177,21 @@ private:
     ScopedCheckedOutSession _checkOutSession(OperationContext* opCtx);
 
     /**
-     * Returns the session runtime info for 'lsid' from the '_sessions' map. The returned pointer
-     * is guaranteed to be linked on the map for as long as the mutex is held.
+     * Returns the session runtime info for 'lsid' from the stripe's session map. The returned
+     * pointer is guaranteed to be linked on the map for as long as the stripe mutex is held.
      */
-    SessionRuntimeInfo* _getSessionRuntimeInfo(WithLock lk, const LogicalSessionId& lsid);
+    SessionRuntimeInfo* _getSessionRuntimeInfo(WithLock lk,
+                                               Stripe& stripe,
+                                               const LogicalSessionId& lsid);
 
     /**
-     * Creates or returns the session runtime info for 'lsid' from the '_sessions' map. The
-     * returned pointer is guaranteed to be linked on the map for as long as the mutex is held.
+     * Creates or returns the session runtime info for 'lsid' from the stripe's session map. The
+     * returned pointer is guaranteed to be linked on the map for as long as the stripe mutex is
+     * held.
      */
-    SessionRuntimeInfo* _getOrCreateSessionRuntimeInfo(WithLock lk, const LogicalSessionId& lsid);
+    SessionRuntimeInfo* _getOrCreateSessionRuntimeInfo(WithLock lk,
+                                                       Stripe& stripe,
+                                                       const LogicalSessionId& lsid);
 
     /**
      * Makes a session, previously checked out through 'checkoutSession', available again.
@@ -171,12 +200,8 @@ private:
                          SessionRuntimeInfo* parentSri,
                          boost::optional<KillToken> killToken);
 
-    // Protects the state below
-    mutable Mutex _mutex =
-        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(4), "SessionCatalog::_mutex");
-
-    // Owns the Session objects for all current Sessions.
-    SessionRuntimeInfoMap _sessions;
+    // Owns the Session objects for all current Sessions, sharded by parent session id.
+    std::array<Stripe, kNumStripes> _stripes;
 };
 
 /**
@@ -274,7 +299,7 @@ using SessionToKill = SessionCatalog::SessionToKill;
 /**
  * This type represents access to a session inside of a scanSessions loop.
  * If you have one of these, you're in a scanSessions callback context, and so
- * have locked the whole catalog and, if the observed session is bound to an operation context,
+ * have locked the catalog stripe which owns the session and, if the observed session is bound to an operation context,
  * you hold that operation context's client's mutex, as well.
  */
 class ObservableSession {
@@ -59,11 +59,16 @@
 #include "mongo/db/storage/encryption_hooks.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/s/is_mongos.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/destructor_guard.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -86,6 +91,87 @@ void checkNoExternalSortOnMongos(const SortOptions& opts) {
             !(isMongos() && opts.extSortAllowed));
 }
 
+// Below this many elements per thread, sorting on several threads costs more than it saves.
+constexpr size_t kMinElementsPerSortThread = 16 * 1024;
+
+/**
+ * Runs 'task(i)' for every i in [0, numTasks), each on its own thread except the first, which runs
+ * on the calling thread. Rethrows the first exception thrown by any of the tasks once they have
+ * all finished.
+ */
+template <typename Task>
+void runConcurrently(size_t numTasks, const Task& task) {
+    std::vector<std::exception_ptr> errors(numTasks);
+    auto runTask = [&](size_t i) {
+        try {
+            task(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    std::vector<stdx::thread> threads;
+    {
+        ON_BLOCK_EXIT([&] {
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        });
+        for (size_t i = 1; i < numTasks; ++i) {
+            threads.emplace_back(runTask, i);
+        }
+        runTask(0);
+    }
+
+    for (auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/**
+ * Stably sorts [begin, end) by splitting it into up to 'numThreads' contiguous runs which are
+ * sorted concurrently, and then merging adjacent runs pairwise, also concurrently, until a single
+ * run remains. Inputs too small to benefit are sorted on the calling thread.
+ */
+template <typename It, typename Less>
+void parallelStableSort(It begin, It end, const Less& less, size_t numThreads) {
+    const size_t size = std::distance(begin, end);
+    numThreads = std::min(numThreads, size / kMinElementsPerSortThread);
+    if (numThreads <= 1) {
+        std::stable_sort(begin, end, less);
+        return;
+    }
+
+    // Offsets from 'begin' of the boundaries between runs, including both ends.
+    std::vector<size_t> bounds;
+    for (size_t i = 0; i <= numThreads; ++i) {
+        bounds.push_back(size * i / numThreads);
+    }
+
+    runConcurrently(numThreads, [&](size_t i) {
+        std::stable_sort(begin + bounds[i], begin + bounds[i + 1], less);
+    });
+
+    while (bounds.size() > 2) {
+        runConcurrently((bounds.size() - 1) / 2, [&](size_t i) {
+            std::inplace_merge(
+                begin + bounds[2 * i], begin + bounds[2 * i + 1], begin + bounds[2 * i + 2], less);
+        });
+
+        // Every other boundary disappears, except the end of an odd run out.
+        std::vector<size_t> merged;
+        for (size_t i = 0; i < bounds.size(); i += 2) {
+            merged.push_back(bounds[i]);
+        }
+        if (merged.back() != bounds.back()) {
+            merged.push_back(bounds.back());
+        }
+        bounds = std::move(merged);
+    }
+}
+
 /**
  * Returns the current EncryptionHooks registered with the global service context.
  * Returns nullptr if the service context is not available; or if the EncyptionHooks
@@ -607,7 +693,7 @@ private:
 
     void sort() {
         STLComparator less(_comp);
-        std::stable_sort(_data.begin(), _data.end(), less);
+        parallelStableSort(_data.begin(), _data.end(), less, this->_opts.numSortThreads);
         this->_numSorted += _data.size();
     }
 
@@ -1010,6 +1096,7 @@ void Sorter<Key, Value>::File::read(std::streamoff offset, std::streamsize size,
 
     _file.seekg(offset);
     _file.read(reinterpret_cast<char*>(out), size);
+    _stats.bytesRead.fetchAndAdd(size);
 
     uassert(16817,
             str::stream() << "Error reading file " << _path.string() << ": "
@@ -1033,6 +1120,7 @@ void Sorter<Key, Value>::File::write(const char* data, std::streamsize size) {
     try {
         _file.write(data, size);
         _offset += size;
+        _stats.bytesWritten.fetchAndAdd(size);
     } catch (const std::system_error& ex) {
         if (ex.code() == std::errc::no_space_on_device) {
             uasserted(ErrorCodes::OutOfDiskSpace,
@@ -1088,6 +1176,98 @@ void Sorter<Key, Value>::File::_ensureOpenForWriting() {
 // SortedFileWriter
 //
 
+/**
+ * Double buffers the blocks of a SortedFileWriter: while the caller fills the next block, the
+ * previous one is compressed, encrypted and written out on a dedicated thread. Errors hit while
+ * writing are rethrown to the caller on its next call to submit() or flush().
+ */
+template <typename Key, typename Value>
+class SortedFileWriter<Key, Value>::AsyncWriter {
+public:
+    explicit AsyncWriter(const SortedFileWriter* writer)
+        : _writer(writer), _thread([this] { _run(); }) {}
+
+    ~AsyncWriter() {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _shuttingDown = true;
+        }
+        _cv.notify_all();
+        _thread.join();
+    }
+
+    /**
+     * Waits for the previous block to be written out, then takes ownership of the contents of
+     * 'buffer' to write them out next, leaving 'buffer' empty.
+     */
+    void submit(BufBuilder* buffer) {
+        stdx::unique_lock<Latch> lk(_mutex);
+        _waitForPendingWrite(lk);
+
+        std::swap(*buffer, _block);
+        buffer->reset();
+        _pending = true;
+        _cv.notify_all();
+    }
+
+    /**
+     * Waits for all submitted blocks to be written out.
+     */
+    void flush() {
+        stdx::unique_lock<Latch> lk(_mutex);
+        _waitForPendingWrite(lk);
+    }
+
+private:
+    void _waitForPendingWrite(stdx::unique_lock<Latch>& lk) {
+        _cv.wait(lk, [&] { return !_pending; });
+        if (_error) {
+            std::rethrow_exception(_error);
+        }
+    }
+
+    void _run() {
+        stdx::unique_lock<Latch> lk(_mutex);
+        while (true) {
+            _cv.wait(lk, [&] { return _pending || _shuttingDown; });
+            if (!_pending) {
+                return;
+            }
+
+            // '_block' is not touched by the caller until '_pending' is reset.
+            lk.unlock();
+            std::exception_ptr error;
+            try {
+                _writer->_writeBlock(_block);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lk.lock();
+
+            if (error && !_error) {
+                _error = error;
+            }
+            _pending = false;
+            _cv.notify_all();
+        }
+    }
+
+    const SortedFileWriter* const _writer;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("SortedFileWriter::AsyncWriter::_mutex");
+    stdx::condition_variable _cv;
+
+    // The block being written out, valid while '_pending' is true.
+    BufBuilder _block;
+    bool _pending = false;
+    bool _shuttingDown = false;
+
+    // The first error hit while writing a block out.
+    std::exception_ptr _error;
+
+    stdx::thread _thread;
+};
+
 template <typename Key, typename Value>
 SortedFileWriter<Key, Value>::SortedFileWriter(
     const SortOptions& opts,
@@ -1104,8 +1284,15 @@ SortedFileWriter<Key, Value>::SortedFileWriter(
     uassert(17148,
             "Attempting to use external sort without setting SortOptions::tempDir",
             !opts.tempDir.empty());
+
+    if (opts.asyncSpillWrites) {
+        _asyncWriter = std::make_unique<AsyncWriter>(this);
+    }
 }
 
+template <typename Key, typename Value>
+SortedFileWriter<Key, Value>::~SortedFileWriter() = default;
+
 template <typename Key, typename Value>
 void SortedFileWriter<Key, Value>::addAlreadySorted(const Key& key, const Value& val) {
 
@@ -1127,20 +1314,39 @@ void SortedFileWriter<Key, Value>::addAlreadySorted(const Key& key, const Value&
 
 template <typename Key, typename Value>
 void SortedFileWriter<Key, Value>::spill() {
-    int32_t size = _buffer.len();
-    char* outBuffer = _buffer.buf();
+    if (_buffer.len() == 0)
+        return;
 
-    if (size == 0)
+    if (_asyncWriter) {
+        _asyncWriter->submit(&_buffer);
         return;
+    }
+
+    _writeBlock(_buffer);
+    _buffer.reset();
+}
+
+template <typename Key, typename Value>
+void SortedFileWriter<Key, Value>::_writeBlock(const BufBuilder& buffer) const {
+    Timer spillTimer;
+    ON_BLOCK_EXIT([&] { _file->stats().spillMicros.fetchAndAdd(spillTimer.micros()); });
+
+    int32_t size = buffer.len();
+    const char* outBuffer = buffer.buf();
 
     std::string compressed;
     snappy::Compress(outBuffer, size, &compressed);
     verify(compressed.size() <= size_t(std::numeric_limits<int32_t>::max()));
 
-    const bool shouldCompress = compressed.size() < size_t(_buffer.len() / 10 * 9);
+    auto& stats = _file->stats();
+    stats.blocksSpilled.fetchAndAdd(1);
+    stats.bytesSpilledUncompressed.fetchAndAdd(size);
+
+    const bool shouldCompress = compressed.size() < size_t(buffer.len() / 10 * 9);
     if (shouldCompress) {
         size = compressed.size();
-        outBuffer = const_cast<char*>(compressed.data());
+        outBuffer = compressed.data();
+        stats.blocksCompressed.fetchAndAdd(1);
     }
 
     std::unique_ptr<char[]> out;
@@ -1165,13 +1371,14 @@ void SortedFileWriter<Key, Value>::spill() {
     size = shouldCompress ? -size : size;
     _file->write(reinterpret_cast<const char*>(&size), sizeof(size));
     _file->write(outBuffer, std::abs(size));
-
-    _buffer.reset();
 }
 
 template <typename Key, typename Value>
 SortIteratorInterface<Key, Value>* SortedFileWriter<Key, Value>::done() {
     spill();
+    if (_asyncWriter) {
+        _asyncWriter->flush();
+    }
 
     return new sorter::FileIterator<Key, Value>(
         _file, _fileStartOffset, _file->currentOffset(), _settings, _dbName, _checksum);
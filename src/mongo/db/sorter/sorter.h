@@ -41,6 +41,7 @@
 
 #include "mongo/bson/util/builder.h"
 #include "mongo/db/sorter/sorter_gen.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/util/bufreader.h"
 
 /**
@@ -119,11 +120,21 @@ struct SortOptions {
     // instead of copying.
     bool moveSortedDataIntoIterator;
 
+    // The maximum number of threads used to sort the data held in memory, before it is spilled or
+    // returned. The comparator must be safe to call concurrently if this is greater than 1.
+    size_t numSortThreads;
+
+    // If set to true, blocks spilled to disk are compressed, encrypted and written out on a
+    // background thread while the next block is being filled.
+    bool asyncSpillWrites;
+
     SortOptions()
         : limit(0),
           maxMemoryUsageBytes(64 * 1024 * 1024),
           extSortAllowed(false),
-          moveSortedDataIntoIterator(false) {}
+          moveSortedDataIntoIterator(false),
+          numSortThreads(1),
+          asyncSpillWrites(false) {}
 
     // Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -156,6 +167,16 @@ struct SortOptions {
         moveSortedDataIntoIterator = newMoveSortedDataIntoIterator;
         return *this;
     }
+
+    SortOptions& NumSortThreads(size_t newNumSortThreads) {
+        numSortThreads = newNumSortThreads;
+        return *this;
+    }
+
+    SortOptions& AsyncSpillWrites(bool newAsyncSpillWrites = true) {
+        asyncSpillWrites = newAsyncSpillWrites;
+        return *this;
+    }
 };
 
 /**
@@ -219,6 +240,27 @@ protected:
     SortIteratorInterface() {}  // can only be constructed as a base
 };
 
+/**
+ * Statistics about the data spilled to and read back from the file of a Sorter. These may be
+ * updated from the background thread writing spills out, hence the atomics.
+ */
+struct SorterFileStats {
+    // Number of blocks spilled, and how many of them were stored compressed.
+    AtomicWord<unsigned long long> blocksSpilled;
+    AtomicWord<unsigned long long> blocksCompressed;
+
+    // Size of the spilled data as serialized, before compression and encryption.
+    AtomicWord<unsigned long long> bytesSpilledUncompressed;
+
+    // Number of bytes actually written to and read from the file.
+    AtomicWord<unsigned long long> bytesWritten;
+    AtomicWord<unsigned long long> bytesRead;
+
+    // Time spent compressing, encrypting and writing spilled blocks, whether on the thread adding
+    // data or on the background writer.
+    AtomicWord<unsigned long long> spillMicros;
+};
+
 /**
  * This is the way to input data to the sorting framework.
  *
@@ -290,6 +332,10 @@ public:
          */
         std::streamoff currentOffset();
 
+        SorterFileStats& stats() {
+            return _stats;
+        }
+
     private:
         void _open();
 
@@ -304,6 +350,8 @@ public:
 
         // Whether to keep the on-disk file even after this in-memory object has been destructed.
         bool _keep = false;
+
+        SorterFileStats _stats;
     };
 
     explicit Sorter(const SortOptions& opts);
@@ -348,6 +396,14 @@ public:
         return _totalDataSizeSorted;
     }
 
+    /**
+     * Returns statistics about the data spilled so far, or nullptr if external sorting is not
+     * allowed.
+     */
+    const SorterFileStats* fileStats() const {
+        return _file ? &_file->stats() : nullptr;
+    }
+
     PersistedState persistDataForShutdown();
 
 protected:
@@ -384,6 +440,8 @@ public:
                               std::shared_ptr<typename Sorter<Key, Value>::File> file,
                               const Settings& settings = Settings());
 
+    ~SortedFileWriter();
+
     void addAlreadySorted(const Key&, const Value&);
 
     /**
@@ -395,8 +453,16 @@ public:
     Iterator* done();
 
 private:
+    class AsyncWriter;
+
     void spill();
 
+    /**
+     * Compresses and encrypts the contents of 'buffer', then appends them to the file as one block.
+     * Only reads state that is fixed at construction, so that it can run on the AsyncWriter.
+     */
+    void _writeBlock(const BufBuilder& buffer) const;
+
     const Settings _settings;
     std::shared_ptr<typename Sorter<Key, Value>::File> _file;
     BufBuilder _buffer;
@@ -410,6 +476,10 @@ private:
     std::streamoff _fileStartOffset;
 
     boost::optional<std::string> _dbName;
+
+    // Writes blocks out in the background when SortOptions::asyncSpillWrites is set. Declared last
+    // so that any write still in progress is finished before the state it reads is destroyed.
+    std::unique_ptr<AsyncWriter> _asyncWriter;
 };
 }  // namespace mongo
 
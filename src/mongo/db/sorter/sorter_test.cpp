@@ -651,6 +651,44 @@ class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     }
     enum { MEM_LIMIT = 32 * 1024 };
 };
+
+template <bool Random = true>
+class LotsOfDataParallelSort : public LotsOfDataLittleMemory<Random> {
+    typedef LotsOfDataLittleMemory<Random> Parent;
+    SortOptions adjustSortOptions(SortOptions opts) override {
+        // Spill a few times, but keep enough data in memory between spills for it to be sorted on
+        // every thread.
+        MONGO_STATIC_ASSERT(MEM_LIMIT / sizeof(IWPair) > NUM_THREADS * 16 * 1024);
+        MONGO_STATIC_ASSERT((Parent::NUM_ITEMS * sizeof(IWPair)) / MEM_LIMIT > 1);
+
+        return opts.MaxMemoryUsageBytes(MEM_LIMIT).ExtSortAllowed().NumSortThreads(NUM_THREADS);
+    }
+    size_t correctNumRanges() const override {
+        return Parent::NUM_ITEMS * sizeof(IWPair) / MEM_LIMIT + 1;
+    }
+    enum {
+        MEM_LIMIT = 1536 * 1024,
+        NUM_THREADS = 3,
+    };
+};
+
+template <bool Random = true>
+class LotsOfDataAsyncSpill : public LotsOfDataLittleMemory<Random> {
+    typedef LotsOfDataLittleMemory<Random> Parent;
+    SortOptions adjustSortOptions(SortOptions opts) override {
+        return Parent::adjustSortOptions(opts).AsyncSpillWrites();
+    }
+};
+
+template <bool Random = true>
+class LotsOfDataParallelSortInMemory : public LotsOfDataLittleMemory<Random> {
+    SortOptions adjustSortOptions(SortOptions opts) override {
+        return opts.MaxMemoryUsageBytes(64 * 1024 * 1024).NumSortThreads(4);
+    }
+    size_t correctNumRanges() const override {
+        return 0;
+    }
+};
 }  // namespace SorterTests
 
 class SorterSuite : public mongo::unittest::OldStyleSuiteSpecification {
@@ -669,6 +707,11 @@ public:
         add<SorterTests::Dupes>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/false>>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/true>>();
+        add<SorterTests::LotsOfDataParallelSort</*random=*/false>>();
+        add<SorterTests::LotsOfDataParallelSort</*random=*/true>>();
+        add<SorterTests::LotsOfDataParallelSortInMemory</*random=*/true>>();
+        add<SorterTests::LotsOfDataAsyncSpill</*random=*/false>>();
+        add<SorterTests::LotsOfDataAsyncSpill</*random=*/true>>();
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/false>>();     // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/true>>();      // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/false>>();   // fits in mem
@@ -866,6 +909,38 @@ TEST_F(SorterMakeFromExistingRangesTest, RoundTrip) {
     }
 }
 
+TEST(SorterFileStatsTest, TracksSpilledAndReadBackData) {
+    for (bool asyncSpillWrites : {false, true}) {
+        unittest::TempDir tempDir("sorterFileStatsTests");
+        const int numItems = 100 * 1000;
+        auto opts = SortOptions()
+                        .ExtSortAllowed()
+                        .TempDir(tempDir.path())
+                        .MaxMemoryUsageBytes(64 * 1024)
+                        .AsyncSpillWrites(asyncSpillWrites);
+        auto sorter = std::unique_ptr<IWSorter>(IWSorter::make(opts, IWComparator(ASC)));
+
+        ASSERT(sorter->fileStats());
+        ASSERT_EQ(0ULL, sorter->fileStats()->bytesWritten.load());
+
+        for (int i = numItems - 1; i >= 0; i--) {
+            sorter->add(i, -i);
+        }
+        auto iter = std::unique_ptr<IWIterator>(sorter->done());
+        ASSERT_GT(sorter->numSpills(), 1U);
+
+        const auto& stats = *sorter->fileStats();
+        ASSERT_GTE(stats.blocksSpilled.load(), sorter->numSpills());
+        ASSERT_LTE(stats.blocksCompressed.load(), stats.blocksSpilled.load());
+        ASSERT_EQ(numItems * 2 * sizeof(int), stats.bytesSpilledUncompressed.load());
+        ASSERT_GT(stats.bytesWritten.load(), 0ULL);
+
+        ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(std::move(iter)),
+                                    std::make_shared<IntIterator>(0, numItems));
+        ASSERT_EQ(stats.bytesWritten.load(), stats.bytesRead.load());
+    }
+}
+
 }  // namespace
 }  // namespace sorter
 }  // namespace mongo
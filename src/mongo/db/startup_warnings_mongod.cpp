@@ -44,6 +44,7 @@
 #include "mongo/db/startup_warnings_common.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/logv2/log.h"
+#include "mongo/util/numa_affinity.h"
 #include "mongo/util/processinfo.h"
 #include "mongo/util/str.h"
 #include "mongo/util/version.h"
@@ -169,7 +170,8 @@ void logMongodStartupWarnings(const StorageGlobalParams& storageParams,
                               "path"_attr = e.path1().string(),
                               "error"_attr = e.code().message());
     }
-    if (hasMultipleNumaNodes) {
+    // Threads bound to NUMA nodes allocate their memory locally, so interleaving is not suggested.
+    if (hasMultipleNumaNodes && !numa::isThreadAffinityEnabled()) {
         // We are on a box with a NUMA enabled kernel and more than 1 numa node (they start at
         // node0)
         // Now we look at the first line of /proc/self/numa_maps
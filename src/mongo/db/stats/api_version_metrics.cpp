@@ -36,6 +36,20 @@
 namespace mongo {
 namespace {
 static const auto handle = ServiceContext::declareDecoration<APIVersionMetrics>();
+
+// The last update made on behalf of a client, used to skip redundant per-command updates.
+struct LastClientUpdate {
+    std::string appName;
+    std::string apiVersion;
+    Date_t when;
+};
+const auto lastClientUpdate = Client::declareDecoration<LastClientUpdate>();
+
+constexpr auto kDefaultAPIVersion = "default"_sd;
+
+StringData apiVersionOrDefault(const APIParameters& apiParams) {
+    return apiParams.getAPIVersion() ? StringData(*apiParams.getAPIVersion()) : kDefaultAPIVersion;
+}
 }  // namespace
 
 APIVersionMetrics& APIVersionMetrics::get(ServiceContext* svc) {
@@ -43,13 +57,32 @@ APIVersionMetrics& APIVersionMetrics::get(ServiceContext* svc) {
 }
 
 void APIVersionMetrics::update(std::string appName, const APIParameters& apiParams) {
-    Date_t now = getGlobalServiceContext()->getFastClockSource()->now();
-    stdx::lock_guard<Latch> lk(_mutex);
-    if (apiParams.getAPIVersion()) {
-        _apiVersionMetrics[appName][*apiParams.getAPIVersion()] = now;
-    } else {
-        _apiVersionMetrics[appName]["default"] = now;
+    _update(std::move(appName),
+            apiVersionOrDefault(apiParams),
+            getGlobalServiceContext()->getFastClockSource()->now());
+}
+
+void APIVersionMetrics::update(Client* client,
+                               StringData appName,
+                               const APIParameters& apiParams) {
+    const auto apiVersion = apiVersionOrDefault(apiParams);
+    const auto now = client->getServiceContext()->getFastClockSource()->now();
+
+    auto& last = lastClientUpdate(client);
+    if (now - last.when < kClientUpdateInterval && last.appName == appName &&
+        last.apiVersion == apiVersion) {
+        return;
     }
+
+    last.appName = appName.toString();
+    last.apiVersion = apiVersion.toString();
+    last.when = now;
+    _update(last.appName, apiVersion, now);
+}
+
+void APIVersionMetrics::_update(std::string appName, StringData apiVersion, Date_t now) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _apiVersionMetrics[appName][apiVersion.toString()] = now;
 }
 
 void APIVersionMetrics::_removeStaleTimestamps(WithLock lk, Date_t now) {
@@ -51,9 +51,19 @@ public:
 
     APIVersionMetrics() = default;
 
+    // Commands from a client that keeps using the same application name and API version refresh
+    // the shared timestamps at most this often. Timestamps only expire after a day.
+    static constexpr Minutes kClientUpdateInterval{1};
+
     // Update the timestamp for the API version used by the application.
     void update(std::string appName, const APIParameters& apiParams);
 
+    // Update the timestamp for the API version used by the application on behalf of a command run
+    // by 'client'. This is called for every command, so while the client's application name and
+    // API version are unchanged and its last update is recent, it returns without taking the
+    // shared mutex or copying the application name.
+    void update(Client* client, StringData appName, const APIParameters& apiParams);
+
     void appendAPIVersionMetricsInfo(BSONObjBuilder* b);
 
     APIVersionMetricsMap getAPIVersionMetrics_forTest();
@@ -61,6 +71,8 @@ public:
 private:
     class APIVersionMetricsSSM;
 
+    void _update(std::string appName, StringData apiVersion, Date_t now);
+
     void _removeStaleTimestamps(WithLock lk, Date_t now);
 
     mutable Mutex _mutex = MONGO_MAKE_LATCH("APIVersionMetrics::_mutex");
@@ -147,5 +147,32 @@ TEST_F(APIVersionMetricsTest, RemovesStaleMetrics) {
     ASSERT(metricsMap.find(appName) == metricsMap.end());
 }
 
+TEST_F(APIVersionMetricsTest, ClientUpdatesAreThrottledWhileUnchanged) {
+    auto client = getServiceContext()->makeClient("apiVersionMetricsTest");
+    auto timestampFor = [&](StringData version) {
+        auto metricsMap = getMetrics().getAPIVersionMetrics_forTest();
+        return metricsMap[appName][version.toString()];
+    };
+
+    getMetrics().update(client.get(), appName, apiParams);
+    const auto first = timestampFor("default");
+
+    // A repeat within the update interval leaves the shared timestamp alone.
+    advanceTime(Milliseconds(1000));
+    getMetrics().update(client.get(), appName, apiParams);
+    ASSERT_EQ(timestampFor("default"), first);
+
+    // A different API version is recorded immediately.
+    apiParams.setAPIVersion("1");
+    getMetrics().update(client.get(), appName, apiParams);
+    assertShouldExistInMap(getMetrics().getAPIVersionMetrics_forTest(), "1");
+
+    // Once the interval has passed, the timestamp is refreshed again.
+    apiParams = APIParameters();
+    advanceTime(APIVersionMetrics::kClientUpdateInterval);
+    getMetrics().update(client.get(), appName, apiParams);
+    ASSERT_GT(timestampFor("default"), first);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -154,6 +154,14 @@ void NetworkCounter::hitLogicalOut(long long bytes) {
     }
 }
 
+void NetworkCounter::incrementMessageBuffersAllocated() {
+    _messageBuffersAllocated.fetchAndAddRelaxed(1);
+}
+
+void NetworkCounter::incrementMessageBuffersReused() {
+    _messageBuffersReused.fetchAndAddRelaxed(1);
+}
+
 void NetworkCounter::incrementNumSlowDNSOperations() {
     _numSlowDNSOperations.fetchAndAdd(1);
 }
@@ -175,6 +183,11 @@ void NetworkCounter::append(BSONObjBuilder& b) {
     b.append("numSlowSSLOperations", static_cast<long long>(_numSlowSSLOperations.loadRelaxed()));
     b.append("numRequests", static_cast<long long>(_together.requests.loadRelaxed()));
 
+    BSONObjBuilder messageBuffers;
+    messageBuffers.append("allocated", _messageBuffersAllocated.loadRelaxed());
+    messageBuffers.append("reused", _messageBuffersReused.loadRelaxed());
+    b.append("messageBuffers", messageBuffers.obj());
+
     BSONObjBuilder tfo;
 #ifdef __linux__
     tfo.append("kernelSetting", _tfo.kernelSetting);
@@ -313,6 +326,7 @@ NetworkCounter networkCounter;
 AuthCounter authCounter;
 AggStageCounters aggStageCounters;
 DotsAndDollarsFieldsCounters dotsAndDollarsFieldsCounters;
+RegexCounters regexCounters;
 OperatorCountersExpressions operatorCountersExpressions;
 OperatorCountersMatchExpressions operatorCountersMatchExpressions;
 }  // namespace mongo
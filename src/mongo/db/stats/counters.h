@@ -187,6 +187,11 @@ public:
     void hitLogicalIn(long long bytes);
     void hitLogicalOut(long long bytes);
 
+    // Increment the counters for how ingress message buffers were obtained: freshly allocated, or
+    // reused from the session's previous request.
+    void incrementMessageBuffersAllocated();
+    void incrementMessageBuffersReused();
+
     // Increment the counter for the number of slow dns resolution operations.
     void incrementNumSlowDNSOperations();
 
@@ -226,6 +231,9 @@ private:
 
     CacheAligned<AtomicWord<long long>> _logicalBytesOut{0};
 
+    CacheAligned<AtomicWord<long long>> _messageBuffersAllocated{0};
+    CacheAligned<AtomicWord<long long>> _messageBuffersReused{0};
+
     CacheAligned<AtomicWord<long long>> _numSlowDNSOperations{0};
     CacheAligned<AtomicWord<long long>> _numSlowSSLOperations{0};
 
@@ -336,6 +344,25 @@ public:
 
 extern DotsAndDollarsFieldsCounters dotsAndDollarsFieldsCounters;
 
+class RegexCounters {
+public:
+    RegexCounters()
+        : compileCacheHitsMetric("query.regex.compileCacheHits", &compileCacheHits),
+          prefilterRejectedMetric("query.regex.prefilterRejected", &prefilterRejected) {}
+
+    // Regexes of match expressions which were found already compiled.
+    Counter64 compileCacheHits;
+
+    // Strings which a regex rejected without running the regex engine, because they do not
+    // contain a literal which every match contains.
+    Counter64 prefilterRejected;
+
+    ServerStatusMetricField<Counter64> compileCacheHitsMetric;
+    ServerStatusMetricField<Counter64> prefilterRejectedMetric;
+};
+
+extern RegexCounters regexCounters;
+
 class OperatorCountersExpressions {
 private:
     struct ExprCounter {
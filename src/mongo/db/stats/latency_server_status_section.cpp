@@ -32,6 +32,7 @@
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/stats/query_shape_stats.h"
 #include "mongo/db/stats/top.h"
 
 namespace mongo {
@@ -60,5 +61,24 @@ public:
         return latencyBuilder.obj();
     }
 } globalHistogramServerStatusSection;
+
+/**
+ * Appends the totals of the per query shape statistics store. The entries themselves are only
+ * available through the $queryShapeStats aggregation stage.
+ */
+class QueryShapeStatsServerStatusSection final : public ServerStatusSection {
+public:
+    QueryShapeStatsServerStatusSection() : ServerStatusSection("queryShapeStats") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElem) const override {
+        BSONObjBuilder builder;
+        QueryShapeStatsStore::get(opCtx->getServiceContext()).appendTotals(&builder);
+        return builder.obj();
+    }
+} queryShapeStatsServerStatusSection;
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,170 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_stats.h"
+
+#include <algorithm>
+
+#include "mongo/db/curop.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/stats/resource_consumption_metrics.h"
+#include "mongo/util/hex.h"
+
+namespace mongo {
+namespace {
+
+const auto getQueryShapeStatsStore =
+    ServiceContext::declareDecoration<std::unique_ptr<QueryShapeStatsStore>>();
+
+ServiceContext::ConstructorActionRegisterer queryShapeStatsStoreRegisterer{
+    "QueryShapeStatsStore", [](ServiceContext* service) {
+        getQueryShapeStatsStore(service) = std::make_unique<QueryShapeStatsStore>(
+            static_cast<size_t>(std::max(internalQueryShapeStatsMaxEntries, 0)));
+    }};
+
+}  // namespace
+
+QueryShapeStatsStore& QueryShapeStatsStore::get(ServiceContext* service) {
+    return *getQueryShapeStatsStore(service);
+}
+
+void QueryShapeStatsStore::recordOperation(OperationContext* opCtx, CurOp& curOp) {
+    auto& store = get(opCtx->getServiceContext());
+    const auto& debug = curOp.debug();
+    if (!store.isEnabled() || !debug.queryHash || opCtx->getClient()->isInDirectClient()) {
+        return;
+    }
+
+    // Explained queries report a shape but are not executions of it.
+    auto command = curOp.getCommand();
+    if (command && command->getName() == "explain") {
+        return;
+    }
+
+    Sample sample;
+    sample.queryHash = *debug.queryHash;
+    sample.nss = curOp.getNSS();
+    if (command) {
+        sample.command = command->getName();
+    }
+    sample.readWriteType = curOp.getReadWriteType();
+    sample.latency = debug.executionTime;
+    sample.docsExamined = debug.additiveMetrics.docsExamined.value_or(0);
+    sample.keysExamined = debug.additiveMetrics.keysExamined.value_or(0);
+    sample.nreturned = std::max(debug.nreturned, 0LL);
+    sample.spilledBytes = debug.spilledBytes.value_or(0);
+    sample.now = opCtx->getServiceContext()->getFastClockSource()->now();
+
+    // CPU time is only measured when resource consumption metrics are being collected.
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(opCtx);
+    if (metricsCollector.hasCollectedMetrics()) {
+        if (auto cpuTimer = metricsCollector.getMetrics().cpuTimer) {
+            sample.cpuTime = cpuTimer->getElapsed();
+        }
+    }
+
+    store.record(sample);
+}
+
+void QueryShapeStatsStore::record(const Sample& sample) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    ++_numRecorded;
+
+    auto it = _entries.find(sample.queryHash);
+    if (it == _entries.end()) {
+        Entry entry;
+        entry.firstSeen = sample.now;
+        if (_entries.add(sample.queryHash, std::move(entry))) {
+            ++_numEvicted;
+        }
+        it = _entries.begin();
+    }
+
+    auto& entry = it->second;
+    entry.nss = sample.nss;
+    entry.command = sample.command;
+    entry.latencies.increment(durationCount<Microseconds>(sample.latency), sample.readWriteType);
+    ++entry.execCount;
+    entry.docsExamined += sample.docsExamined;
+    entry.keysExamined += sample.keysExamined;
+    entry.nreturned += sample.nreturned;
+    entry.cpuNanos += durationCount<Nanoseconds>(sample.cpuTime);
+    entry.spilledBytes += sample.spilledBytes;
+    entry.lastSeen = sample.now;
+}
+
+std::vector<BSONObj> QueryShapeStatsStore::getEntries() const {
+    std::vector<BSONObj> entries;
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    entries.reserve(_entries.size());
+    for (const auto& [queryHash, entry] : _entries) {
+        BSONObjBuilder builder;
+        builder.append("queryHash", zeroPaddedHex(queryHash));
+        builder.append("ns", entry.nss.ns());
+        builder.append("command", entry.command);
+        builder.appendNumber("execCount", entry.execCount);
+        builder.appendNumber("docsExamined", entry.docsExamined);
+        builder.appendNumber("keysExamined", entry.keysExamined);
+        builder.appendNumber("nreturned", entry.nreturned);
+        builder.appendNumber("cpuNanos", entry.cpuNanos);
+        builder.appendNumber("spilledBytes", entry.spilledBytes);
+        builder.append("firstSeen", entry.firstSeen);
+        builder.append("lastSeen", entry.lastSeen);
+        {
+            BSONObjBuilder latencyBuilder(builder.subobjStart("latencies"));
+            entry.latencies.append(true /* includeHistograms */, false, &latencyBuilder);
+        }
+        entries.push_back(builder.obj());
+    }
+    return entries;
+}
+
+void QueryShapeStatsStore::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _entries.clear();
+}
+
+void QueryShapeStatsStore::appendTotals(BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    builder->appendNumber("maxEntries", static_cast<long long>(_maxEntries));
+    builder->appendNumber("numEntries", static_cast<long long>(_entries.size()));
+    builder->appendNumber("numRecorded", _numRecorded);
+    builder->appendNumber("numEvicted", _numEvicted);
+}
+
+}  // namespace mongo
@@ -0,0 +1,137 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/stats/operation_latency_histogram.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class CurOp;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Bounded, in-memory store of execution statistics aggregated per query shape. Entries are keyed
+ * by the 'queryHash' computed by the canonical query encoder, so that every execution of the same
+ * shape, regardless of the constants used, is accumulated into the same entry. When the store is
+ * full the least recently executed shape is evicted.
+ *
+ * The store is only populated when 'internalQueryShapeStatsMaxEntries' is greater than zero. Its
+ * contents are returned by the $queryShapeStats aggregation stage, and the totals are reported in
+ * the 'queryShapeStats' serverStatus section, which FTDC samples periodically.
+ *
+ * This class is thread-safe.
+ */
+class QueryShapeStatsStore {
+public:
+    /**
+     * The metrics of a single completed operation which are folded into the entry of its shape.
+     */
+    struct Sample {
+        uint32_t queryHash = 0;
+        NamespaceString nss;
+        std::string command;
+        Command::ReadWriteType readWriteType = Command::ReadWriteType::kRead;
+        Microseconds latency{0};
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long nreturned = 0;
+        Nanoseconds cpuTime{0};
+        long long spilledBytes = 0;
+        Date_t now;
+    };
+
+    static QueryShapeStatsStore& get(ServiceContext* service);
+
+    /**
+     * Records the metrics of the operation that is completing on 'opCtx', if it ran a query with a
+     * shape and the store is enabled.
+     */
+    static void recordOperation(OperationContext* opCtx, CurOp& curOp);
+
+    explicit QueryShapeStatsStore(size_t maxEntries)
+        : _maxEntries(maxEntries), _entries(maxEntries) {}
+
+    bool isEnabled() const {
+        return _maxEntries > 0;
+    }
+
+    /**
+     * Folds 'sample' into the entry of its shape, creating the entry if needed.
+     */
+    void record(const Sample& sample);
+
+    /**
+     * Returns one document per shape, most recently executed shape first.
+     */
+    std::vector<BSONObj> getEntries() const;
+
+    /**
+     * Removes all entries. The totals reported by appendTotals() are preserved.
+     */
+    void clear();
+
+    /**
+     * Appends the number of tracked shapes along with store-wide counters.
+     */
+    void appendTotals(BSONObjBuilder* builder) const;
+
+private:
+    struct Entry {
+        NamespaceString nss;
+        std::string command;
+        OperationLatencyHistogram latencies;
+        long long execCount = 0;
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long nreturned = 0;
+        long long cpuNanos = 0;
+        long long spilledBytes = 0;
+        Date_t firstSeen;
+        Date_t lastSeen;
+    };
+
+    const size_t _maxEntries;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("QueryShapeStatsStore::_mutex");
+    LRUCache<uint32_t, Entry> _entries;
+    long long _numRecorded = 0;
+    long long _numEvicted = 0;
+};
+
+}  // namespace mongo
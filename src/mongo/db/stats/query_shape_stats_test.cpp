@@ -0,0 +1,110 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_stats.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+QueryShapeStatsStore::Sample makeSample(uint32_t queryHash, Microseconds latency) {
+    QueryShapeStatsStore::Sample sample;
+    sample.queryHash = queryHash;
+    sample.nss = NamespaceString("test.coll");
+    sample.command = "find";
+    sample.latency = latency;
+    sample.docsExamined = 10;
+    sample.keysExamined = 5;
+    sample.nreturned = 2;
+    sample.cpuTime = Nanoseconds(100);
+    sample.now = Date_t::fromMillisSinceEpoch(1000);
+    return sample;
+}
+
+TEST(QueryShapeStatsStoreTest, DisabledStoreRecordsNothing) {
+    QueryShapeStatsStore store(0);
+    ASSERT_FALSE(store.isEnabled());
+    store.record(makeSample(1, Microseconds(10)));
+    ASSERT(store.getEntries().empty());
+}
+
+TEST(QueryShapeStatsStoreTest, AccumulatesExecutionsOfTheSameShape) {
+    QueryShapeStatsStore store(10);
+    store.record(makeSample(1, Microseconds(10)));
+    store.record(makeSample(1, Microseconds(30)));
+
+    auto entries = store.getEntries();
+    ASSERT_EQ(entries.size(), 1U);
+    const auto& entry = entries.front();
+    ASSERT_EQ(entry["queryHash"].str(), "00000001");
+    ASSERT_EQ(entry["ns"].str(), "test.coll");
+    ASSERT_EQ(entry["execCount"].numberLong(), 2);
+    ASSERT_EQ(entry["docsExamined"].numberLong(), 20);
+    ASSERT_EQ(entry["keysExamined"].numberLong(), 10);
+    ASSERT_EQ(entry["nreturned"].numberLong(), 4);
+    ASSERT_EQ(entry["cpuNanos"].numberLong(), 200);
+    ASSERT_EQ(entry["latencies"]["reads"]["latency"].numberLong(), 40);
+    ASSERT_EQ(entry["latencies"]["reads"]["ops"].numberLong(), 2);
+}
+
+TEST(QueryShapeStatsStoreTest, EvictsLeastRecentlyExecutedShape) {
+    QueryShapeStatsStore store(2);
+    store.record(makeSample(1, Microseconds(10)));
+    store.record(makeSample(2, Microseconds(10)));
+    store.record(makeSample(1, Microseconds(10)));
+    store.record(makeSample(3, Microseconds(10)));
+
+    auto entries = store.getEntries();
+    ASSERT_EQ(entries.size(), 2U);
+    ASSERT_EQ(entries[0]["queryHash"].str(), "00000003");
+    ASSERT_EQ(entries[1]["queryHash"].str(), "00000001");
+
+    BSONObjBuilder totals;
+    store.appendTotals(&totals);
+    auto totalsObj = totals.obj();
+    ASSERT_EQ(totalsObj["numEntries"].numberLong(), 2);
+    ASSERT_EQ(totalsObj["numRecorded"].numberLong(), 4);
+    ASSERT_EQ(totalsObj["numEvicted"].numberLong(), 1);
+}
+
+TEST(QueryShapeStatsStoreTest, ClearRemovesEntriesButKeepsTotals) {
+    QueryShapeStatsStore store(2);
+    store.record(makeSample(1, Microseconds(10)));
+    store.clear();
+    ASSERT(store.getEntries().empty());
+
+    BSONObjBuilder totals;
+    store.appendTotals(&totals);
+    ASSERT_EQ(totals.obj()["numRecorded"].numberLong(), 1);
+}
+
+}  // namespace
+}  // namespace mongo
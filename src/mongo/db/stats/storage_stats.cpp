@@ -33,6 +33,7 @@
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/index/index_access_method.h"
@@ -163,6 +164,12 @@ Status appendCollectionStorageStats(OperationContext* opCtx,
     result->appendNumber("totalIndexSize", indexSize / scale);
     result->appendNumber("totalSize", (storageSize + indexSize) / scale);
     result->append("indexSizes", indexSizes.obj());
+
+    if (!collection->getValidatorDoc().isEmpty()) {
+        BSONObjBuilder validatorStats(result->subobjStart("documentValidation"));
+        DocumentValidationStats::get(collection->getSharedDecorations()).append(&validatorStats);
+    }
+
     result->append("scaleFactor", scale);
 
     return Status::OK();
@@ -0,0 +1,180 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/backup_block_stream.h"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+#include "mongo/config.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/file.h"
+#include "mongo/util/str.h"
+
+#ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
+#include <wiredtiger.h>
+#endif
+
+namespace mongo {
+
+std::vector<std::vector<StorageEngine::BackupBlock>> partitionBackupBlocks(
+    const std::vector<StorageEngine::BackupBlock>& blocks,
+    std::size_t numStreams,
+    std::uint64_t maxChunkBytes) {
+    invariant(numStreams > 0);
+    invariant(maxChunkBytes > 0);
+
+    std::vector<std::vector<StorageEngine::BackupBlock>> streams(numStreams);
+
+    // Min-heap of (bytes assigned, stream index). Ties go to the lowest stream index.
+    using StreamLoad = std::pair<std::uint64_t, std::size_t>;
+    std::priority_queue<StreamLoad, std::vector<StreamLoad>, std::greater<StreamLoad>> loads;
+    for (std::size_t i = 0; i < numStreams; ++i) {
+        loads.emplace(0, i);
+    }
+
+    auto assign = [&](StorageEngine::BackupBlock chunk) {
+        auto [bytes, stream] = loads.top();
+        loads.pop();
+        loads.emplace(bytes + chunk.length, stream);
+        streams[stream].push_back(std::move(chunk));
+    };
+
+    for (const auto& block : blocks) {
+        if (block.length == 0) {
+            assign(block);
+            continue;
+        }
+
+        for (std::uint64_t offset = 0; offset < block.length; offset += maxChunkBytes) {
+            StorageEngine::BackupBlock chunk = block;
+            chunk.offset = block.offset + offset;
+            chunk.length = std::min(maxChunkBytes, block.length - offset);
+            assign(std::move(chunk));
+        }
+    }
+
+    return streams;
+}
+
+std::vector<std::vector<StorageEngine::BackupBlock>> partitionBackupBlocks(
+    const std::vector<StorageEngine::BackupBlock>& blocks, std::size_t numStreams) {
+    const std::uint64_t maxChunkBytes =
+        static_cast<std::uint64_t>(gBackupStreamChunkSizeMB.load()) * 1024 * 1024;
+    return partitionBackupBlocks(blocks, numStreams, maxChunkBytes);
+}
+
+std::uint32_t computeBackupBlockChecksum(const char* data, std::size_t len) {
+#ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
+    return wiredtiger_crc32c_func()(data, len);
+#else
+    return 0;
+#endif
+}
+
+void BackupBlockThrottle::awaitIfNeeded(OperationContext* opCtx, std::int64_t dataSize) {
+    const std::int64_t maxBytesPerSec =
+        static_cast<std::int64_t>(gBackupStreamMaxMBPerSec.load()) * 1024 * 1024;
+    if (maxBytesPerSec == 0 || dataSize <= 0) {
+        return;
+    }
+
+    const Date_t now = opCtx->getServiceContext()->getFastClockSource()->now();
+    Date_t readTime;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        readTime = std::max(now, _nextReadTime);
+        _nextReadTime = readTime + Milliseconds(dataSize * 1000 / maxBytesPerSec);
+    }
+
+    if (readTime > now) {
+        opCtx->sleepUntil(readTime);
+    }
+}
+
+StatusWith<BackupBlockData> readBackupBlock(OperationContext* opCtx,
+                                            const StorageEngine::BackupBlock& block,
+                                            BackupBlockThrottle* throttle) {
+    if (block.length > std::numeric_limits<unsigned>::max()) {
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "Backup block of " << block.length << " bytes from '"
+                                    << block.filename << "' is too large to read at once");
+    }
+
+    if (throttle) {
+        throttle->awaitIfNeeded(opCtx, block.length);
+    }
+
+    BackupBlockData blockData;
+    blockData.block = block;
+    if (block.length > 0) {
+        File file;
+        file.open(block.filename.c_str(), /*readOnly=*/true);
+        if (!file.is_open() || file.bad()) {
+            return Status(ErrorCodes::FileOpenFailed,
+                          str::stream() << "Failed to open backup file '" << block.filename << "'");
+        }
+
+        blockData.data.resize(block.length);
+        try {
+            file.read(block.offset, &blockData.data[0], block.length);
+        } catch (const DBException& ex) {
+            return ex.toStatus();
+        }
+        if (file.bad()) {
+            return Status(ErrorCodes::FileStreamFailed,
+                          str::stream() << "Failed to read " << block.length
+                                        << " bytes at offset " << block.offset
+                                        << " from backup file '" << block.filename << "'");
+        }
+    }
+
+    blockData.checksum = computeBackupBlockChecksum(blockData.data.data(), blockData.data.size());
+    return blockData;
+}
+
+Status verifyBackupBlockChecksum(const BackupBlockData& blockData) {
+    const auto checksum = computeBackupBlockChecksum(blockData.data.data(), blockData.data.size());
+    if (checksum != blockData.checksum) {
+        return Status(ErrorCodes::DataCorruptionDetected,
+                      str::stream() << "Checksum mismatch for " << blockData.data.size()
+                                    << " bytes at offset " << blockData.block.offset
+                                    << " of backup file '" << blockData.block.filename
+                                    << "': expected " << blockData.checksum << ", got "
+                                    << checksum);
+    }
+    return Status::OK();
+}
+
+}  // namespace mongo
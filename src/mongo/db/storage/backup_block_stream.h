@@ -0,0 +1,115 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mongo/base/status_with.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Splits the blocks returned by a backup cursor into 'numStreams' lists that can be sent over
+ * parallel streams. Blocks larger than 'maxChunkBytes' are split into chunks of at most that size,
+ * and each chunk is assigned to the stream with the fewest bytes assigned so far, so the streams
+ * finish at roughly the same time. Chunks of the same file keep their offset order within a stream.
+ *
+ * Blocks with a length of zero carry no data, but are still assigned to a stream so that consumers
+ * learn about every file the backup cursor returned.
+ */
+std::vector<std::vector<StorageEngine::BackupBlock>> partitionBackupBlocks(
+    const std::vector<StorageEngine::BackupBlock>& blocks,
+    std::size_t numStreams,
+    std::uint64_t maxChunkBytes);
+
+/**
+ * Same as above, with chunks of at most 'backupStreamChunkSizeMB'.
+ */
+std::vector<std::vector<StorageEngine::BackupBlock>> partitionBackupBlocks(
+    const std::vector<StorageEngine::BackupBlock>& blocks, std::size_t numStreams);
+
+/**
+ * Returns the CRC32C checksum of 'len' bytes starting at 'data'. This is the checksum sent with
+ * each chunk of a streaming backup, and is always 0 in builds without WiredTiger.
+ */
+std::uint32_t computeBackupBlockChecksum(const char* data, std::size_t len);
+
+/**
+ * Limits the rate at which the parallel streams of one backup read data to the value of the
+ * 'backupStreamMaxMBPerSec' server parameter, summed across all the streams sharing the throttle.
+ * A value of 0 disables throttling.
+ */
+class BackupBlockThrottle {
+public:
+    /**
+     * Reserves the next 'dataSize' bytes of the throttle's budget and waits until they may be
+     * read. The wait is interruptible.
+     */
+    void awaitIfNeeded(OperationContext* opCtx, std::int64_t dataSize);
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("BackupBlockThrottle::_mutex");
+
+    // The earliest time at which the next reservation may start.
+    Date_t _nextReadTime;
+};
+
+/**
+ * A chunk of a backup file read for streaming, together with the checksum of its data.
+ */
+struct BackupBlockData {
+    StorageEngine::BackupBlock block;
+    std::string data;
+    std::uint32_t checksum = 0;
+};
+
+/**
+ * Reads the byte range described by 'block' from its file, waiting on 'throttle' first, and
+ * computes the checksum of the data read. Returns an error if the file cannot be opened or is
+ * shorter than the range.
+ */
+StatusWith<BackupBlockData> readBackupBlock(OperationContext* opCtx,
+                                            const StorageEngine::BackupBlock& block,
+                                            BackupBlockThrottle* throttle);
+
+/**
+ * Recomputes the checksum of 'blockData' and returns DataCorruptionDetected if it does not match
+ * the checksum the data was sent with.
+ */
+Status verifyBackupBlockChecksum(const BackupBlockData& blockData);
+
+}  // namespace mongo
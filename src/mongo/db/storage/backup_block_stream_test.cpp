@@ -0,0 +1,144 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <fstream>
+
+#include "mongo/config.h"
+#include "mongo/db/storage/backup_block_stream.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using BackupBlock = StorageEngine::BackupBlock;
+
+std::uint64_t totalLength(const std::vector<BackupBlock>& stream) {
+    std::uint64_t total = 0;
+    for (const auto& block : stream) {
+        total += block.length;
+    }
+    return total;
+}
+
+TEST(BackupBlockStreamTest, PartitionSplitsLargeBlocksIntoChunks) {
+    std::vector<BackupBlock> blocks{{"a.wt", 100, 25, 1000}};
+    auto streams = partitionBackupBlocks(blocks, 1, 10);
+    ASSERT_EQ(1U, streams.size());
+    ASSERT_EQ(3U, streams[0].size());
+    ASSERT_EQ(100U, streams[0][0].offset);
+    ASSERT_EQ(10U, streams[0][0].length);
+    ASSERT_EQ(110U, streams[0][1].offset);
+    ASSERT_EQ(10U, streams[0][1].length);
+    ASSERT_EQ(120U, streams[0][2].offset);
+    ASSERT_EQ(5U, streams[0][2].length);
+    for (const auto& chunk : streams[0]) {
+        ASSERT_EQ("a.wt", chunk.filename);
+        ASSERT_EQ(1000U, chunk.fileSize);
+    }
+}
+
+TEST(BackupBlockStreamTest, PartitionBalancesBytesAcrossStreams) {
+    std::vector<BackupBlock> blocks{
+        {"a.wt", 0, 40, 40}, {"b.wt", 0, 10, 10}, {"c.wt", 0, 10, 10}, {"d.wt", 0, 20, 20}};
+    auto streams = partitionBackupBlocks(blocks, 2, 10);
+    ASSERT_EQ(2U, streams.size());
+    ASSERT_EQ(40U, totalLength(streams[0]));
+    ASSERT_EQ(40U, totalLength(streams[1]));
+}
+
+TEST(BackupBlockStreamTest, PartitionKeepsZeroLengthBlocks) {
+    std::vector<BackupBlock> blocks{{"a.wt", 0, 0, 100}, {"b.wt", 0, 0, 200}};
+    auto streams = partitionBackupBlocks(blocks, 4, 10);
+    std::size_t numBlocks = 0;
+    for (const auto& stream : streams) {
+        numBlocks += stream.size();
+        ASSERT_EQ(0U, totalLength(stream));
+    }
+    ASSERT_EQ(2U, numBlocks);
+}
+
+TEST(BackupBlockStreamTest, PartitionWithMoreStreamsThanChunksLeavesStreamsEmpty) {
+    std::vector<BackupBlock> blocks{{"a.wt", 0, 5, 5}};
+    auto streams = partitionBackupBlocks(blocks, 3, 10);
+    ASSERT_EQ(3U, streams.size());
+    ASSERT_EQ(1U, streams[0].size());
+    ASSERT(streams[1].empty());
+    ASSERT(streams[2].empty());
+}
+
+TEST(BackupBlockStreamTest, ReadBlockReturnsRangeAndChecksum) {
+    unittest::TempDir tempDir("backup_block_stream_test");
+    const std::string filename = tempDir.path() + "/file.wt";
+    {
+        std::ofstream out(filename, std::ios::binary);
+        out << "0123456789abcdef";
+    }
+
+    auto swBlockData = readBackupBlock(nullptr, {filename, 4, 6, 16}, nullptr);
+    ASSERT_OK(swBlockData.getStatus());
+    auto blockData = std::move(swBlockData.getValue());
+    ASSERT_EQ("456789", blockData.data);
+    ASSERT_EQ(4U, blockData.block.offset);
+    ASSERT_EQ(computeBackupBlockChecksum("456789", 6), blockData.checksum);
+    ASSERT_OK(verifyBackupBlockChecksum(blockData));
+
+#ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
+    blockData.data[0] = 'x';
+    ASSERT_EQ(ErrorCodes::DataCorruptionDetected, verifyBackupBlockChecksum(blockData));
+#endif
+}
+
+TEST(BackupBlockStreamTest, ReadZeroLengthBlockReturnsNoData) {
+    auto swBlockData = readBackupBlock(nullptr, {"does_not_exist.wt", 0, 0, 100}, nullptr);
+    ASSERT_OK(swBlockData.getStatus());
+    ASSERT(swBlockData.getValue().data.empty());
+}
+
+TEST(BackupBlockStreamTest, ReadPastEndOfFileFails) {
+    unittest::TempDir tempDir("backup_block_stream_test");
+    const std::string filename = tempDir.path() + "/file.wt";
+    {
+        std::ofstream out(filename, std::ios::binary);
+        out << "0123";
+    }
+
+    ASSERT_NOT_OK(readBackupBlock(nullptr, {filename, 2, 10, 4}, nullptr).getStatus());
+}
+
+#ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
+TEST(BackupBlockStreamTest, ChecksumIsCrc32c) {
+    ASSERT_EQ(0xE3069283U, computeBackupBlockChecksum("123456789", 9));
+}
+#endif
+
+}  // namespace
+}  // namespace mongo
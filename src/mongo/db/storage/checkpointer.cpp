@@ -33,9 +33,11 @@
 
 #include "mongo/db/storage/checkpointer.h"
 
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/kv/kv_engine.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/fail_point.h"
@@ -48,6 +50,24 @@ const auto getCheckpointer = ServiceContext::declareDecoration<std::unique_ptr<C
 
 MONGO_FAIL_POINT_DEFINE(pauseCheckpointThread);
 
+class CheckpointerServerStatusSection : public ServerStatusSection {
+public:
+    CheckpointerServerStatusSection() : ServerStatusSection("checkpointer") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        if (auto checkpointer = Checkpointer::get(opCtx)) {
+            checkpointer->appendStats(&builder);
+        }
+        return builder.obj();
+    }
+} checkpointerServerStatusSection;
+
 }  // namespace
 
 Checkpointer* Checkpointer::get(ServiceContext* serviceCtx) {
@@ -71,19 +91,39 @@ void Checkpointer::run() {
     ThreadClient tc(name(), getGlobalServiceContext());
     LOGV2_DEBUG(22307, 1, "Starting thread", "threadName"_attr = name());
 
+    Date_t lastCheckpoint = Date_t::now();
     while (true) {
         auto opCtx = tc->makeOperationContext();
+        bool paced = false;
 
         {
             stdx::unique_lock<Latch> lock(_mutex);
             MONGO_IDLE_THREAD_BLOCK;
 
             // Wait for 'storageGlobalParams.checkpointDelaySecs' seconds; or until either shutdown
-            // is signaled or a checkpoint is triggered.
-            _sleepCV.wait_for(lock,
-                              stdx::chrono::seconds(static_cast<std::int64_t>(
-                                  storageGlobalParams.checkpointDelaySecs)),
-                              [&] { return _shuttingDown || _triggerCheckpoint; });
+            // is signaled or a checkpoint is triggered. With checkpoint pacing enabled, wake up
+            // every second to check whether enough modified data has accumulated to checkpoint
+            // early.
+            const auto deadline = Date_t::now() +
+                Seconds(static_cast<std::int64_t>(storageGlobalParams.checkpointDelaySecs));
+            while (!_shuttingDown && !_triggerCheckpoint) {
+                const auto now = Date_t::now();
+                if (now >= deadline) {
+                    break;
+                }
+                const auto wakeup = gCheckpointPacingDirtyMB.load() > 0
+                    ? std::min(deadline, now + Seconds(1))
+                    : deadline;
+                if (_sleepCV.wait_until(lock, wakeup.toSystemTimePoint(), [&] {
+                        return _shuttingDown || _triggerCheckpoint;
+                    })) {
+                    break;
+                }
+                if (_shouldTakePacedCheckpoint(lastCheckpoint)) {
+                    paced = true;
+                    break;
+                }
+            }
 
             // If the checkpointDelaySecs is set to 0, that means we should skip checkpointing.
             // However, checkpointDelaySecs is adjustable by a runtime server parameter, so we
@@ -111,21 +151,60 @@ void Checkpointer::run() {
 
         pauseCheckpointThread.pauseWhileSet();
 
-        const Date_t startTime = Date_t::now();
+        _checkpoint(paced);
+        lastCheckpoint = Date_t::now();
+    }
+}
 
-        // TODO SERVER-50861: Access the storage engine via the ServiceContext.
-        _kvEngine->checkpoint();
+bool Checkpointer::_shouldTakePacedCheckpoint(Date_t lastCheckpoint) const {
+    const long long dirtyMB = gCheckpointPacingDirtyMB.load();
+    if (dirtyMB == 0 ||
+        Date_t::now() - lastCheckpoint < Seconds(gCheckpointPacingMinIntervalSecs.load())) {
+        return false;
+    }
 
-        const auto secondsElapsed = durationCount<Seconds>(Date_t::now() - startTime);
-        if (secondsElapsed >= 30) {
-            LOGV2_DEBUG(22308,
-                        1,
-                        "Checkpoint was slow to complete",
-                        "secondsElapsed"_attr = secondsElapsed);
-        }
+    // TODO SERVER-50861: Access the storage engine via the ServiceContext.
+    auto dirtyBytes = _kvEngine->getCheckpointDirtyBytes();
+    return dirtyBytes && *dirtyBytes >= dirtyMB * 1024 * 1024;
+}
+
+void Checkpointer::_checkpoint(bool paced) {
+    const Date_t startTime = Date_t::now();
+    const auto bytesWrittenBefore = _kvEngine->getCheckpointBytesWritten();
+
+    // TODO SERVER-50861: Access the storage engine via the ServiceContext.
+    _kvEngine->checkpoint();
+
+    const auto elapsed = Date_t::now() - startTime;
+    _numCheckpoints.fetchAndAdd(1);
+    if (paced) {
+        _numPacedCheckpoints.fetchAndAdd(1);
+    }
+    _durationMillis.increment(durationCount<Milliseconds>(elapsed));
+
+    const auto bytesWrittenAfter = _kvEngine->getCheckpointBytesWritten();
+    if (bytesWrittenBefore && bytesWrittenAfter && elapsed > Milliseconds(0)) {
+        const auto bytesWritten = *bytesWrittenAfter - *bytesWrittenBefore;
+        _writeMBPerSec.increment(bytesWritten * 1000 / durationCount<Milliseconds>(elapsed) /
+                                 (1024 * 1024));
+    }
+
+    const auto secondsElapsed = durationCount<Seconds>(elapsed);
+    if (secondsElapsed >= 30) {
+        LOGV2_DEBUG(22308,
+                    1,
+                    "Checkpoint was slow to complete",
+                    "secondsElapsed"_attr = secondsElapsed);
     }
 }
 
+void Checkpointer::appendStats(BSONObjBuilder* builder) const {
+    builder->append("checkpoints", _numCheckpoints.load());
+    builder->append("pacedCheckpoints", _numPacedCheckpoints.load());
+    _durationMillis.append(*builder, true);
+    _writeMBPerSec.append(*builder, true);
+}
+
 void Checkpointer::triggerFirstStableCheckpoint(Timestamp prevStable,
                                                 Timestamp initialData,
                                                 Timestamp currStable) {
@@ -29,9 +29,11 @@
 
 #pragma once
 
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/util/background.h"
+#include "mongo/util/integer_histogram.h"
 
 namespace mongo {
 
@@ -87,7 +89,23 @@ public:
      */
     void shutdown(const Status& reason);
 
+    /**
+     * Appends checkpoint counts and duration and write throughput histograms for serverStatus.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
 private:
+    /**
+     * Returns true if checkpoint pacing is enabled and enough modified data has accumulated since
+     * the last checkpoint to take the next one early.
+     */
+    bool _shouldTakePacedCheckpoint(Date_t lastCheckpoint) const;
+
+    /**
+     * Takes a checkpoint and records its duration and write throughput.
+     */
+    void _checkpoint(bool paced);
+
     // A pointer to the KVEngine is maintained only due to unit testing limitations that don't fully
     // setup the ServiceContext.
     // TODO SERVER-50861: Remove this pointer.
@@ -109,6 +127,12 @@ private:
 
     // This flag allows the checkpoint thread to wake up early when _sleepCV is signaled.
     bool _triggerCheckpoint;
+
+    AtomicWord<long long> _numCheckpoints{0};
+    AtomicWord<long long> _numPacedCheckpoints{0};
+    IntegerHistogram<7> _durationMillis{"durationMillis",
+                                        {100, 500, 1000, 5000, 15000, 30000, 60000}};
+    IntegerHistogram<7> _writeMBPerSec{"writeMBPerSec", {1, 10, 50, 100, 250, 500, 1000}};
 };
 
 }  // namespace mongo
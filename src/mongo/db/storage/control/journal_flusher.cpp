@@ -34,13 +34,18 @@
 #include "mongo/db/storage/control/journal_flusher.h"
 
 #include "mongo/db/client.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/future.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -51,6 +56,35 @@ const auto getJournalFlusher = ServiceContext::declareDecoration<std::unique_ptr
 MONGO_FAIL_POINT_DEFINE(pauseJournalFlusherBeforeFlush);
 MONGO_FAIL_POINT_DEFINE(pauseJournalFlusherThread);
 
+// Weight given to the latest sample in the flush latency and arrival interval moving averages.
+const double kGroupCommitEwmaAlpha = 0.2;
+
+// Caps a single arrival interval sample so that an idle period is quickly forgotten once callers
+// start arriving again.
+const unsigned long long kMaxArrivalIntervalSampleMicros = 1000 * 1000;
+
+double updateEwma(double avg, double sample) {
+    return avg == 0 ? sample : avg + kGroupCommitEwmaAlpha * (sample - avg);
+}
+
+class JournalFlusherServerStatusSection : public ServerStatusSection {
+public:
+    JournalFlusherServerStatusSection() : ServerStatusSection("journalFlusher") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        if (auto& journalFlusher = getJournalFlusher(opCtx->getServiceContext())) {
+            journalFlusher->appendGroupCommitStats(&builder);
+        }
+        return builder.obj();
+    }
+} journalFlusherServerStatusSection;
+
 }  // namespace
 
 JournalFlusher* JournalFlusher::get(ServiceContext* serviceCtx) {
@@ -111,7 +145,17 @@ void JournalFlusher::run() {
                 _uniqueCtx->get()->setShouldParticipateInFlowControl(false);
             });
 
+            Timer flushTimer;
             _uniqueCtx->get()->recoveryUnit()->waitUntilDurable(_uniqueCtx->get());
+            const auto flushMicros = flushTimer.micros();
+
+            {
+                stdx::lock_guard<Latch> lk(_stateMutex);
+                _avgFlushMicros = updateEwma(_avgFlushMicros, flushMicros);
+                if (_numWaitersForCurrentFlush > 0) {
+                    _groupCommitBatchSize.increment(_numWaitersForCurrentFlush);
+                }
+            }
 
             // Signal the waiters that a round completed.
             _currentSharedPromise->emplaceValue();
@@ -169,6 +213,10 @@ void JournalFlusher::run() {
             _stateChangeCV.notify_all();
         }
 
+        if (_flushJournalNow && !_shuttingDown) {
+            _delayForGroupCommit(lk);
+        }
+
         _flushJournalNow = false;
 
         if (_shuttingDown) {
@@ -187,6 +235,7 @@ void JournalFlusher::run() {
         // Take the next promise as current and reset the next promise.
         _currentSharedPromise =
             std::exchange(_nextSharedPromise, std::make_unique<SharedPromise<void>>());
+        _numWaitersForCurrentFlush = std::exchange(_numWaitersForNextFlush, 0);
     }
 }
 
@@ -253,17 +302,72 @@ void JournalFlusher::interruptJournalFlusherForReplStateChange() {
     }
 }
 
+void JournalFlusher::appendGroupCommitStats(BSONObjBuilder* builder) const {
+    {
+        stdx::lock_guard<Latch> lk(_stateMutex);
+        builder->append("avgFlushMicros", static_cast<long long>(_avgFlushMicros));
+        builder->append("avgArrivalIntervalMicros",
+                        static_cast<long long>(_avgArrivalIntervalMicros));
+    }
+    _groupCommitBatchSize.append(*builder, true);
+    _groupCommitDelayMicros.append(*builder, true);
+    _waitMicros.append(*builder, true);
+}
+
 void JournalFlusher::_waitForJournalFlushNoRetry() {
     auto myFuture = [&]() {
         stdx::unique_lock<Latch> lk(_stateMutex);
+        const auto now = curTimeMicros64();
+        if (_lastArrivalMicros != 0 && now > _lastArrivalMicros) {
+            _avgArrivalIntervalMicros =
+                updateEwma(_avgArrivalIntervalMicros,
+                           std::min(now - _lastArrivalMicros, kMaxArrivalIntervalSampleMicros));
+        }
+        _lastArrivalMicros = now;
+
+        ++_numWaitersForNextFlush;
         if (!_flushJournalNow) {
             _flushJournalNow = true;
             _flushJournalNowCV.notify_one();
+        } else if (_groupCommitTargetWaiters &&
+                   _numWaitersForNextFlush >= _groupCommitTargetWaiters) {
+            _flushJournalNowCV.notify_one();
         }
         return _nextSharedPromise->getFuture();
     }();
+
+    Timer waitTimer;
+    ON_BLOCK_EXIT([&] { _waitMicros.increment(waitTimer.micros()); });
     // Throws on error if the flusher round is interrupted or the flusher thread is shutdown.
     myFuture.get();
 }
 
+void JournalFlusher::_delayForGroupCommit(stdx::unique_lock<Latch>& lk) {
+    const auto maxDelayMicros = gJournalGroupCommitMaxDelayMicros.load();
+    if (maxDelayMicros <= 0 || _avgFlushMicros == 0 || _avgArrivalIntervalMicros == 0) {
+        return;
+    }
+
+    // Never hold a flush back for more than half of what the flush itself costs, so that waiters'
+    // latency grows by less than what sharing the flush saves them. Only wait at all if another
+    // waiter is expected to arrive within that time.
+    const auto delayMicros = std::min<double>(maxDelayMicros, _avgFlushMicros / 2);
+    if (_avgArrivalIntervalMicros > delayMicros) {
+        return;
+    }
+
+    // Stop waiting once as many callers are waiting as are expected to arrive during one flush.
+    _groupCommitTargetWaiters =
+        std::max<int64_t>(2, static_cast<int64_t>(_avgFlushMicros / _avgArrivalIntervalMicros));
+    ON_BLOCK_EXIT([&] { _groupCommitTargetWaiters = 0; });
+
+    Timer delayTimer;
+    _flushJournalNowCV.wait_for(
+        lk, stdx::chrono::microseconds(static_cast<int64_t>(delayMicros)), [&] {
+            return _needToPause || _shuttingDown ||
+                _numWaitersForNextFlush >= _groupCommitTargetWaiters;
+        });
+    _groupCommitDelayMicros.increment(delayTimer.micros());
+}
+
 }  // namespace mongo
@@ -33,6 +33,7 @@
 #include "mongo/platform/mutex.h"
 #include "mongo/util/background.h"
 #include "mongo/util/future.h"
+#include "mongo/util/integer_histogram.h"
 
 namespace mongo {
 
@@ -49,6 +50,10 @@ class OperationContext;
  *    reducing i/o load on the system and improving write performance. This thread groups both the
  *    periodic flushes and immediate flush requests from the rest of the system.
  *
+ * Explicitly requested flushes may be held back briefly to group them with more durability waiters
+ * when the observed rate of requests suggests more are about to arrive, see
+ * 'journalGroupCommitMaxDelayMicros'.
+ *
  * And incidentally helpful for another reason:
  *  - waitUntilDurable() calls update the replication JournalListener, so more frequent calls may be
  *    helpful to unblock replication related operations more quickly.
@@ -121,6 +126,11 @@ public:
      */
     void interruptJournalFlusherForReplStateChange();
 
+    /**
+     * Appends flush latency, waiter arrival rate, and group commit histograms for serverStatus.
+     */
+    void appendGroupCommitStats(BSONObjBuilder* builder) const;
+
 private:
     // Journal flusher internal states.
     enum class States {
@@ -137,6 +147,13 @@ private:
      */
     void _waitForJournalFlushNoRetry();
 
+    /**
+     * Holds back the next flush while more waiters are expected to arrive before it would be worth
+     * starting it, given the average flush latency and waiter arrival interval. Returns early on
+     * pause or shutdown, or once the expected batch of waiters has arrived.
+     */
+    void _delayForGroupCommit(stdx::unique_lock<Latch>& lk);
+
     // Serializes setting/resetting _uniqueCtx and marking _uniqueCtx killed.
     mutable Mutex _opCtxMutex = MONGO_MAKE_LATCH("JournalFlusherOpCtxMutex");
 
@@ -170,6 +187,28 @@ private:
     std::unique_ptr<SharedPromise<void>> _nextSharedPromise =
         std::make_unique<SharedPromise<void>>();
 
+    // Number of callers waiting on _currentSharedPromise and _nextSharedPromise respectively.
+    int64_t _numWaitersForCurrentFlush = 0;
+    int64_t _numWaitersForNextFlush = 0;
+
+    // Non-zero while _delayForGroupCommit() waits for this many callers of the next flush. Callers
+    // signal _flushJournalNowCV once it is reached.
+    int64_t _groupCommitTargetWaiters = 0;
+
+    // Exponential moving averages of the duration of a flush and the time between consecutive
+    // callers requesting one, in microseconds. Used to size group commit delays.
+    double _avgFlushMicros = 0;
+    double _avgArrivalIntervalMicros = 0;
+    unsigned long long _lastArrivalMicros = 0;
+
+    // Number of callers sharing each flush, how long flushes were held back to group them, and how
+    // long callers waited in total.
+    IntegerHistogram<8> _groupCommitBatchSize{"batchSize", {1, 2, 4, 8, 16, 32, 64, 128}};
+    IntegerHistogram<7> _groupCommitDelayMicros{"delayMicros",
+                                                {0, 50, 100, 250, 500, 1000, 10000}};
+    IntegerHistogram<8> _waitMicros{"waitMicros",
+                                    {0, 100, 250, 500, 1000, 5000, 10000, 100000}};
+
     // Controls whether to ignore the 'storageGlobalParams.journalCommitIntervalMs' setting. If set,
     // data flushes will only be executed upon explicit request, no longer periodically in addition
     // to upon request.
@@ -31,8 +31,9 @@
 #include "mongo/db/storage/storage_parameters_gen.h"
 
 namespace mongo {
-const OperationContext::Decoration<StorageExecutionContext> StorageExecutionContext::get =
-    OperationContext::declareDecoration<StorageExecutionContext>();
+// Only operations which write to or build indexes use this, so it is not constructed up front.
+const OperationContext::LazyDecoration<StorageExecutionContext> StorageExecutionContext::get =
+    OperationContext::declareLazyDecoration<StorageExecutionContext>();
 
 StorageExecutionContext::StorageExecutionContext()
     : _pooledBufferBuilder(
@@ -43,7 +43,7 @@ namespace mongo {
  */
 class StorageExecutionContext {
 public:
-    static const OperationContext::Decoration<StorageExecutionContext> get;
+    static const OperationContext::LazyDecoration<StorageExecutionContext> get;
 
     StorageExecutionContext();
 
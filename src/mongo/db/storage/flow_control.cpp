@@ -222,6 +222,13 @@ BSONObj FlowControl::generateSection(OperationContext* opCtx,
     bob.append("isLaggedCount", _isLaggedCount.load());
     bob.append("isLaggedTimeMicros", _isLaggedTimeMicros.load());
 
+    const auto controller = gFlowControlController.get();
+    bob.append("controller", controller);
+    if (controller == kFlowControlPredictiveController) {
+        BSONObjBuilder predictiveBuilder(bob.subobjStart("predictiveController"));
+        _predictiveController.appendStats(&predictiveBuilder);
+    }
+
     return bob.obj();
 }
 
@@ -244,13 +251,9 @@ void FlowControl::_updateTopologyData() {
               });
 }
 
-int FlowControl::_calculateNewTicketsForLag(const std::vector<repl::MemberData>& prevMemberData,
-                                            const std::vector<repl::MemberData>& currMemberData,
-                                            std::int64_t locksUsedLastPeriod,
-                                            double locksPerOp,
-                                            std::uint64_t lagMillis,
-                                            std::uint64_t thresholdLagMillis) {
-    invariant(lagMillis >= thresholdLagMillis);
+std::int64_t FlowControl::_approximateSustainerAppliedCount(
+    const std::vector<repl::MemberData>& prevMemberData,
+    const std::vector<repl::MemberData>& currMemberData) {
     using namespace fmt::literals;
 
     const auto currSustainerAppliedTs = getMedianAppliedTimestamp(currMemberData);
@@ -285,6 +288,19 @@ int FlowControl::_calculateNewTicketsForLag(const std::vector<repl::MemberData>&
     }
 
     _lastSustainerAppliedCount.store(static_cast<int>(sustainerAppliedCount));
+    return sustainerAppliedCount;
+}
+
+int FlowControl::_calculateNewTicketsForLag(const std::vector<repl::MemberData>& prevMemberData,
+                                            const std::vector<repl::MemberData>& currMemberData,
+                                            std::int64_t locksUsedLastPeriod,
+                                            double locksPerOp,
+                                            std::uint64_t lagMillis,
+                                            std::uint64_t thresholdLagMillis) {
+    invariant(lagMillis >= thresholdLagMillis);
+
+    const std::int64_t sustainerAppliedCount =
+        _approximateSustainerAppliedCount(prevMemberData, currMemberData);
     if (sustainerAppliedCount == -1) {
         // We don't know how many ops the sustainer applied. Hand out less tickets than were
         // used in the last period.
@@ -326,6 +342,46 @@ int FlowControl::_calculateNewTicketsForLag(const std::vector<repl::MemberData>&
     return multiplyWithOverflowCheck(locksPerOp, sustainerAppliedPenalty, kMaxTickets);
 }
 
+int FlowControl::_calculatePredictiveTicketsForLag(
+    const std::vector<repl::MemberData>& prevMemberData,
+    const std::vector<repl::MemberData>& currMemberData,
+    std::int64_t locksUsedLastPeriod,
+    double locksPerOp,
+    std::uint64_t lagMillis,
+    std::uint64_t thresholdLagMillis,
+    std::int64_t opsLagged) {
+    invariant(lagMillis >= thresholdLagMillis);
+
+    const std::int64_t sustainerAppliedCount =
+        _approximateSustainerAppliedCount(prevMemberData, currMemberData);
+    if (sustainerAppliedCount == -1) {
+        // Without the sustainer's rate there is nothing to forecast from. Hand out less tickets
+        // than were used in the last period, like the heuristic controller.
+        return std::min(static_cast<int>(locksUsedLastPeriod / 2.0), kMaxTickets);
+    }
+
+    FlowControlPredictiveController::Inputs inputs;
+    inputs.opsLagged = opsLagged;
+    inputs.lagMillis = lagMillis;
+    inputs.thresholdLagMillis = thresholdLagMillis;
+    inputs.sustainerAppliedCount = sustainerAppliedCount;
+    inputs.primaryAppliedCount =
+        static_cast<std::int64_t>(static_cast<double>(locksUsedLastPeriod) / locksPerOp);
+    const auto opsAllowed = _predictiveController.calculateOpsAllowed(inputs);
+
+    LOGV2_DEBUG(6000150,
+                DEBUG_LOG_LEVEL,
+                "Flow control predictive controller",
+                "sustainerAppliedCount"_attr = sustainerAppliedCount,
+                "primaryAppliedCount"_attr = inputs.primaryAppliedCount,
+                "opsLagged"_attr = opsLagged,
+                "lagMillis"_attr = lagMillis,
+                "thresholdLagMillis"_attr = thresholdLagMillis,
+                "opsAllowed"_attr = opsAllowed);
+
+    return multiplyWithOverflowCheck(locksPerOp, opsAllowed, kMaxTickets);
+}
+
 int FlowControl::getNumTickets(Date_t now) {
     // Flow control can be disabled until a certain deadline is passed.
     const Date_t disabledUntil = _disableUntil.load();
@@ -383,6 +439,7 @@ int FlowControl::getNumTickets(Date_t now) {
                                         gFlowControlTicketMultiplierConstant.load(),
                                         kMaxTickets);
         _lastTimeSustainerAdvanced = Date_t::now();
+        _predictiveController.reset();
         if (_isLagged.load()) {
             _isLagged.store(false);
             auto waitTime = curTimeMicros64() - _startWaitTime;
@@ -391,13 +448,26 @@ int FlowControl::getNumTickets(Date_t now) {
     } else if (!ignoreWallTimes && sustainerAdvanced(_prevMemberData, _currMemberData)) {
         // Expected case where flow control has meaningful data from the last period to make a new
         // calculation.
-        ret =
-            _calculateNewTicketsForLag(_prevMemberData,
-                                       _currMemberData,
-                                       locksUsedLastPeriod,
-                                       locksPerOp,
-                                       getLagMillis(myLastApplied.wallTime, lastCommitted.wallTime),
-                                       thresholdLagMillis);
+        const auto lagMillis = getLagMillis(myLastApplied.wallTime, lastCommitted.wallTime);
+        if (gFlowControlController.get() == kFlowControlPredictiveController) {
+            ret = _calculatePredictiveTicketsForLag(
+                _prevMemberData,
+                _currMemberData,
+                locksUsedLastPeriod,
+                locksPerOp,
+                lagMillis,
+                thresholdLagMillis,
+                _approximateOpsBetween(lastCommitted.opTime.getTimestamp(),
+                                       myLastApplied.opTime.getTimestamp()));
+        } else {
+            _predictiveController.reset();
+            ret = _calculateNewTicketsForLag(_prevMemberData,
+                                             _currMemberData,
+                                             locksUsedLastPeriod,
+                                             locksPerOp,
+                                             lagMillis,
+                                             thresholdLagMillis);
+        }
         if (!_isLagged.load()) {
             _isLagged.store(true);
             _isLaggedCount.fetchAndAddRelaxed(1);
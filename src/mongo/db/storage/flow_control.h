@@ -36,6 +36,7 @@
 #include "mongo/db/repl/member_data.h"
 #include "mongo/db/repl/replication_coordinator_fwd.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/flow_control_controller.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 
@@ -126,12 +127,22 @@ public:
     std::int64_t _approximateOpsBetween(Timestamp prevTs, Timestamp currTs);
 
     void _updateTopologyData();
+    std::int64_t _approximateSustainerAppliedCount(
+        const std::vector<repl::MemberData>& prevMemberData,
+        const std::vector<repl::MemberData>& currMemberData);
     int _calculateNewTicketsForLag(const std::vector<repl::MemberData>& prevMemberData,
                                    const std::vector<repl::MemberData>& currMemberData,
                                    std::int64_t locksUsedLastPeriod,
                                    double locksPerOp,
                                    std::uint64_t lagMillis,
                                    std::uint64_t thresholdLagMillis);
+    int _calculatePredictiveTicketsForLag(const std::vector<repl::MemberData>& prevMemberData,
+                                          const std::vector<repl::MemberData>& currMemberData,
+                                          std::int64_t locksUsedLastPeriod,
+                                          double locksPerOp,
+                                          std::uint64_t lagMillis,
+                                          std::uint64_t thresholdLagMillis,
+                                          std::int64_t opsLagged);
     void _trimSamples(Timestamp trimSamplesTo);
 
     // Sample of (timestamp, ops, lock acquisitions) where ops and lock acquisitions are
@@ -169,6 +180,8 @@ private:
 
     Date_t _lastTimeSustainerAdvanced;
 
+    FlowControlPredictiveController _predictiveController;
+
     // This value is used for calculating server status metrics.
     std::uint64_t _startWaitTime = 0;
 
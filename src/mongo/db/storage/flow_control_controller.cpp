@@ -0,0 +1,95 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/flow_control_controller.h"
+
+#include <algorithm>
+
+#include "mongo/db/storage/flow_control_parameters_gen.h"
+
+namespace mongo {
+
+std::int64_t FlowControlPredictiveController::calculateOpsAllowed(const Inputs& inputs) {
+    const double opsLagged = std::max(inputs.opsLagged, std::int64_t(0));
+    const double sustainerAppliedCount = std::max(inputs.sustainerAppliedCount, std::int64_t(0));
+
+    // Operations are assumed to be spread evenly over the lagged time, which gives the backlog
+    // that corresponds to the threshold lag.
+    const double opsPerMilli =
+        inputs.lagMillis > 0 ? opsLagged / static_cast<double>(inputs.lagMillis) : 0.0;
+    const double targetOpsLagged = opsPerMilli * inputs.thresholdLagMillis;
+    const double error = targetOpsLagged - opsLagged;
+
+    // The error only says something about the forecast if the primary used the rate it was given
+    // in the last period. Otherwise the writes, not the controller, limited the backlog's growth.
+    if (_lastOpsAllowed < 0 || inputs.primaryAppliedCount >= _lastOpsAllowed) {
+        const double maxIntegralOps = std::max(opsLagged, targetOpsLagged);
+        _integralOps = std::clamp(_integralOps + error, -maxIntegralOps, maxIntegralOps);
+    }
+
+    const double opsAllowed = std::max(
+        sustainerAppliedCount + error / gFlowControlPredictiveHorizonPeriods.load() +
+            gFlowControlPredictiveIntegralGain.load() * _integralOps,
+        0.0);
+    _lastOpsAllowed = static_cast<std::int64_t>(opsAllowed);
+
+    // The lag expected at the end of the next period if the sustainer keeps its rate and the
+    // primary accepts every operation it is allowed.
+    const double forecastOpsLagged = std::max(opsLagged + opsAllowed - sustainerAppliedCount, 0.0);
+    const double forecastLagMillis =
+        opsPerMilli > 0.0 ? forecastOpsLagged / opsPerMilli : inputs.lagMillis;
+
+    _lastOpsLagged.store(static_cast<long long>(opsLagged));
+    _lastTargetOpsLagged.store(static_cast<long long>(targetOpsLagged));
+    _lastForecastLagMillis.store(static_cast<long long>(forecastLagMillis));
+    _lastPrimaryAppliedCount.store(inputs.primaryAppliedCount);
+    _lastOpsAllowedStat.store(_lastOpsAllowed);
+    _lastIntegralOps.store(_integralOps);
+
+    return _lastOpsAllowed;
+}
+
+void FlowControlPredictiveController::reset() {
+    _integralOps = 0.0;
+    _lastOpsAllowed = -1;
+    _lastIntegralOps.store(0.0);
+}
+
+void FlowControlPredictiveController::appendStats(BSONObjBuilder* builder) const {
+    builder->append("opsLagged", _lastOpsLagged.load());
+    builder->append("targetOpsLagged", _lastTargetOpsLagged.load());
+    builder->append("forecastLagMillis", _lastForecastLagMillis.load());
+    builder->append("primaryAppliedCount", _lastPrimaryAppliedCount.load());
+    builder->append("opsAllowed", _lastOpsAllowedStat.load());
+    builder->append("integralOps", _lastIntegralOps.load());
+}
+
+}  // namespace mongo
@@ -0,0 +1,112 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "mongo/base/status.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+/**
+ * The values accepted by the 'flowControlController' server parameter. The heuristic controller
+ * scales the sustainer's apply rate down exponentially as the commit point lag grows past the
+ * threshold. The predictive controller plans the write rate from a forecast of the lag, see
+ * FlowControlPredictiveController.
+ */
+constexpr StringData kFlowControlHeuristicController = "heuristic"_sd;
+constexpr StringData kFlowControlPredictiveController = "predictive"_sd;
+
+inline Status validateFlowControlController(const std::string& controller) {
+    if (controller != kFlowControlHeuristicController &&
+        controller != kFlowControlPredictiveController) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "Invalid flowControlController '" << controller
+                              << "'. Valid options are: " << kFlowControlHeuristicController
+                              << ", " << kFlowControlPredictiveController};
+    }
+    return Status::OK();
+}
+
+/**
+ * Plans how many operations a lagged primary may accept in the next flow control period.
+ *
+ * The commit point lag is modeled as a backlog of operations, which grows by the writes the primary
+ * accepts and shrinks by the operations the sustainer applies in each period. The controller
+ * permits the sustainer's rate plus the share of the gap between the target backlog and the
+ * current one that closes it within 'flowControlPredictiveHorizonPeriods' periods, so the lag
+ * settles at the threshold rather than swinging around it. An integral term corrects for a
+ * sustainer that is persistently slower or faster than its last period suggests.
+ *
+ * Only appendStats() may be called concurrently with the other methods.
+ */
+class FlowControlPredictiveController {
+public:
+    struct Inputs {
+        // Number of operations between the commit point and the primary's last applied optime.
+        std::int64_t opsLagged = 0;
+        std::uint64_t lagMillis = 0;
+        std::uint64_t thresholdLagMillis = 0;
+        // Number of operations the sustainer applied and the primary accepted in the last period.
+        std::int64_t sustainerAppliedCount = 0;
+        std::int64_t primaryAppliedCount = 0;
+    };
+
+    /**
+     * Returns the number of operations the primary should accept in the next period.
+     */
+    std::int64_t calculateOpsAllowed(const Inputs& inputs);
+
+    /**
+     * Forgets the accumulated error. Called when the commit point is no longer lagged.
+     */
+    void reset();
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    double _integralOps = 0.0;
+    std::int64_t _lastOpsAllowed = -1;
+
+    // These values are updated with each calculation and are surfaced in server status.
+    AtomicWord<long long> _lastOpsLagged{0};
+    AtomicWord<long long> _lastTargetOpsLagged{0};
+    AtomicWord<long long> _lastForecastLagMillis{0};
+    AtomicWord<long long> _lastPrimaryAppliedCount{0};
+    AtomicWord<long long> _lastOpsAllowedStat{0};
+    AtomicWord<double> _lastIntegralOps{0.0};
+};
+
+}  // namespace mongo
@@ -38,6 +38,7 @@
 #include "mongo/db/service_context_d_test_fixture.h"
 #include "mongo/db/storage/flow_control.h"
 #include "mongo/db/storage/flow_control_parameters_gen.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/logv2/log_debug.h"
 #include "mongo/unittest/unittest.h"
 
@@ -266,6 +267,70 @@ TEST_F(FlowControlTest, CalculatingTickets) {
                                                       thresholdLag));
 }
 
+TEST_F(FlowControlTest, PredictiveControllerPlansLagBackToThreshold) {
+    // The commit point lags 2,000 operations behind, twice the threshold, and the sustainer applied
+    // 1,000 operations in the last period. Closing the 1,000 operation gap over five periods
+    // allows 1,000 - 1,000 / 5 = 800 operations in the next one.
+    RAIIServerParameterControllerForTest horizon("flowControlPredictiveHorizonPeriods", 5);
+    RAIIServerParameterControllerForTest integralGain("flowControlPredictiveIntegralGain", 0.0);
+
+    FlowControlPredictiveController controller;
+    FlowControlPredictiveController::Inputs inputs;
+    inputs.opsLagged = 2000;
+    inputs.lagMillis = 2000;
+    inputs.thresholdLagMillis = 1000;
+    inputs.sustainerAppliedCount = 1000;
+    inputs.primaryAppliedCount = 1000;
+    ASSERT_EQ(800, controller.calculateOpsAllowed(inputs));
+
+    BSONObjBuilder bob;
+    controller.appendStats(&bob);
+    auto stats = bob.obj();
+    ASSERT_EQ(1000, stats["targetOpsLagged"].numberLong()) << stats;
+    // The sustainer is forecast to shrink the backlog by 200 operations.
+    ASSERT_EQ(1800, stats["forecastLagMillis"].numberLong()) << stats;
+}
+
+TEST_F(FlowControlTest, PredictiveControllerAccumulatesErrorOnlyWhileRateIsUsed) {
+    RAIIServerParameterControllerForTest horizon("flowControlPredictiveHorizonPeriods", 5);
+    RAIIServerParameterControllerForTest integralGain("flowControlPredictiveIntegralGain", 0.1);
+
+    FlowControlPredictiveController controller;
+    FlowControlPredictiveController::Inputs inputs;
+    inputs.opsLagged = 2000;
+    inputs.lagMillis = 2000;
+    inputs.thresholdLagMillis = 1000;
+    inputs.sustainerAppliedCount = 1000;
+    inputs.primaryAppliedCount = 1000;
+
+    // The -1,000 operation error is accumulated once: 1,000 - 200 - 100.
+    ASSERT_EQ(700, controller.calculateOpsAllowed(inputs));
+
+    // The primary accepted fewer writes than it was allowed, so the error is not accumulated.
+    inputs.primaryAppliedCount = 500;
+    ASSERT_EQ(700, controller.calculateOpsAllowed(inputs));
+
+    // Once the primary uses its rate again, the lag that remains lowers the rate further.
+    inputs.primaryAppliedCount = 700;
+    ASSERT_EQ(600, controller.calculateOpsAllowed(inputs));
+
+    controller.reset();
+    ASSERT_EQ(700, controller.calculateOpsAllowed(inputs));
+}
+
+TEST_F(FlowControlTest, ServerStatusReportsController) {
+    BSONElement noopVar;
+    auto section = flowControl->generateSection(opCtx.get(), noopVar);
+    ASSERT_EQ(kFlowControlHeuristicController, section["controller"].str());
+    ASSERT_FALSE(section.hasField("predictiveController")) << section;
+
+    RAIIServerParameterControllerForTest controller("flowControlController",
+                                                   kFlowControlPredictiveController.toString());
+    section = flowControl->generateSection(opCtx.get(), noopVar);
+    ASSERT_EQ(kFlowControlPredictiveController, section["controller"].str());
+    ASSERT_TRUE(section["predictiveController"].isABSONObj()) << section;
+}
+
 TEST_F(FlowControlTest, DisableUntil) {
     const int ticketOverride = 52319;
 
@@ -215,6 +215,30 @@ public:
 
     virtual void checkpoint() {}
 
+    /**
+     * Returns the number of bytes of modified data that the next checkpoint would write, or
+     * boost::none if the engine cannot estimate it.
+     */
+    virtual boost::optional<int64_t> getCheckpointDirtyBytes() const {
+        return boost::none;
+    }
+
+    /**
+     * Returns the total number of bytes written by checkpoints since startup, or boost::none if the
+     * engine does not track it.
+     */
+    virtual boost::optional<int64_t> getCheckpointBytesWritten() const {
+        return boost::none;
+    }
+
+    /**
+     * Returns whether the engine's cache is full or dirty enough that background work should back
+     * off. Engines without a cache always return false.
+     */
+    virtual bool isCacheUnderPressure() const {
+        return false;
+    }
+
     virtual bool isDurable() const = 0;
 
     /**
@@ -148,6 +148,13 @@ public:
                                    BSONObjBuilder* output,
                                    double scale) const = 0;
 
+    /**
+     * Appends statistics about the in-memory filter the index uses to answer lookups for missing
+     * keys without searching, if it has one. Returns false if it does not.
+     */
+    virtual bool appendKeyFilterStats(BSONObjBuilder* output) const {
+        return false;
+    }
 
     /**
      * Return the number of bytes consumed by 'this' index.
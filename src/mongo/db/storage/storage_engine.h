@@ -483,6 +483,12 @@ public:
      */
     virtual void checkpoint() = 0;
 
+    /**
+     * Returns whether the storage engine's cache is full or dirty enough that background work, such
+     * as dbCheck, should back off to leave room for user operations.
+     */
+    virtual bool isCacheUnderPressure() const = 0;
+
     /**
      * Recovers the storage engine state to the last stable timestamp. "Stable" in this case
      * refers to a timestamp that is guaranteed to never be rolled back. The stable timestamp
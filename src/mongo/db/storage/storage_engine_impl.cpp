@@ -52,6 +52,7 @@
 #include "mongo/db/storage/two_phase_index_build_knobs_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/stdx/unordered_set.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
@@ -190,12 +191,13 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, LastShutdownState l
         // a repair context, if we can't find an ident in the catalog, we generate a catalog entry
         // 'local.orphan.xxxxx' for it. However, in a nonrepair context, the orphaned idents
         // will be dropped in reconcileCatalogAndIdents().
+        stdx::unordered_set<std::string> catalogIdents;
+        for (const auto& entry : catalogEntries) {
+            catalogIdents.insert(entry.ident);
+        }
         for (const auto& ident : identsKnownToStorageEngine) {
             if (_catalog->isCollectionIdent(ident)) {
-                bool isOrphan = !std::any_of(
-                    catalogEntries.begin(),
-                    catalogEntries.end(),
-                    [this, &ident](DurableCatalog::Entry entry) { return entry.ident == ident; });
+                bool isOrphan = !catalogIdents.contains(ident);
                 if (isOrphan) {
                     // If the catalog does not have information about this
                     // collection, we create an new entry for it.
@@ -1075,6 +1077,10 @@ void StorageEngineImpl::checkpoint() {
     _engine->checkpoint();
 }
 
+bool StorageEngineImpl::isCacheUnderPressure() const {
+    return _engine->isCacheUnderPressure();
+}
+
 void StorageEngineImpl::_onMinOfCheckpointAndOldestTimestampChanged(const Timestamp& timestamp) {
     // No drop-pending idents present if getEarliestDropTimestamp() returns boost::none.
     if (auto earliestDropTimestamp = _dropPendingIdentReaper.getEarliestDropTimestamp()) {
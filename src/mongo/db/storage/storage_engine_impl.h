@@ -319,6 +319,8 @@ public:
 
     void checkpoint() override;
 
+    bool isCacheUnderPressure() const override;
+
     StatusWith<ReconcileResult> reconcileCatalogAndIdents(
         OperationContext* opCtx, LastShutdownState lastShutdownState) override;
 
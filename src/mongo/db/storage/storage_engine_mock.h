@@ -170,6 +170,9 @@ public:
                              std::shared_ptr<Ident> ident,
                              DropIdentCallback&& onDrop) final {}
     void checkpoint() final {}
+    bool isCacheUnderPressure() const final {
+        return false;
+    }
 
     int64_t sizeOnDiskForDb(OperationContext* opCtx, StringData dbName) final {
         return 0;
@@ -51,6 +51,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor_helpers.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -60,6 +61,7 @@
 #include "mongo/util/hex.h"
 #include "mongo/util/str.h"
 #include "mongo/util/testing_proctor.h"
+#include "mongo/util/timer.h"
 
 #define TRACING_ENABLED 0
 
@@ -256,6 +258,64 @@ NamespaceString WiredTigerIndex::getCollectionNamespace(OperationContext* opCtx)
     return _desc->getEntry()->getNSSFromCatalog(opCtx);
 }
 
+const WiredTigerIndexKeyFilter* WiredTigerIndex::keyFilterFor(OperationContext* opCtx) const {
+    if (!_keyFilter || !_keyFilter->isUsable()) {
+        return nullptr;
+    }
+    if (opCtx->recoveryUnit()->getTimestampReadSource() != RecoveryUnit::ReadSource::kNoTimestamp) {
+        return nullptr;
+    }
+    return _keyFilter.get();
+}
+
+void WiredTigerIndex::_initKeyFilter(OperationContext* opCtx) {
+    const auto sizeMB = gWiredTigerUniqueIndexKeyFilterSizeMB;
+    if (sizeMB == 0) {
+        return;
+    }
+
+    _keyFilter = std::make_unique<WiredTigerIndexKeyFilter>(static_cast<size_t>(sizeMB) << 20);
+
+    // Scan the index in whatever snapshot the caller has open, or in a snapshot of our own that
+    // is released afterwards. No other operation can write to the index while it is being opened.
+    auto ru = WiredTigerRecoveryUnit::get(opCtx);
+    const bool releaseSnapshot = !ru->isActive() && !opCtx->lockState()->inAWriteUnitOfWork();
+    Timer timer;
+    long long numKeys = 0;
+    try {
+        auto cursor = newCursor(opCtx, true);
+        while (auto entry = cursor->nextKeyString()) {
+            const auto& keyString = entry->keyString;
+            _keyFilter->add(keyString.getBuffer(),
+                            KeyString::sizeWithoutRecordIdLongAtEnd(keyString.getBuffer(),
+                                                                    keyString.getSize()));
+            ++numKeys;
+        }
+    } catch (const DBException& ex) {
+        LOGV2_WARNING(6000134,
+                      "Failed to build the key filter of an index, lookups will search the index",
+                      "index"_attr = _indexName,
+                      "uri"_attr = _uri,
+                      "error"_attr = ex.toStatus());
+        _keyFilter.reset();
+    }
+    if (releaseSnapshot) {
+        ru->abandonSnapshot();
+    }
+    if (!_keyFilter) {
+        return;
+    }
+
+    _keyFilter->markReady();
+    LOGV2_DEBUG(6000135,
+                1,
+                "Built the key filter of an index",
+                "index"_attr = _indexName,
+                "uri"_attr = _uri,
+                "numKeys"_attr = numKeys,
+                "duration"_attr = timer.elapsed());
+}
+
 namespace {
 void dassertRecordIdAtEnd(const KeyString::Value& keyString, KeyFormat keyFormat) {
     if (!kDebugBuild) {
@@ -396,6 +456,14 @@ bool WiredTigerIndex::appendCustomStats(OperationContext* opCtx,
     return true;
 }
 
+bool WiredTigerIndex::appendKeyFilterStats(BSONObjBuilder* output) const {
+    if (!_keyFilter) {
+        return false;
+    }
+    _keyFilter->appendStats(output);
+    return true;
+}
+
 Status WiredTigerIndex::dupKeyCheck(OperationContext* opCtx, const KeyString::Value& key) {
     invariant(unique());
 
@@ -481,7 +549,9 @@ Status WiredTigerIndex::compact(OperationContext* opCtx) {
     if (!cache->isEphemeral()) {
         WT_SESSION* s = WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession();
         opCtx->recoveryUnit()->abandonSnapshot();
-        int ret = s->compact(s, uri().c_str(), "timeout=0");
+        const auto timeSliceSecs = gWiredTigerCompactTimeSliceSecs.load();
+        const std::string config = str::stream() << "timeout=" << timeSliceSecs;
+        int ret = s->compact(s, uri().c_str(), config.c_str());
         if (MONGO_unlikely(WTCompactIndexEBUSY.shouldFail())) {
             ret = EBUSY;
         }
@@ -491,6 +561,11 @@ Status WiredTigerIndex::compact(OperationContext* opCtx) {
                           str::stream() << "Compaction interrupted on " << uri().c_str()
                                         << " due to cache eviction pressure");
         }
+        if (ret == ETIMEDOUT) {
+            return Status(ErrorCodes::ExceededTimeLimit,
+                          str::stream() << "Compaction of " << uri().c_str() << " stopped after its "
+                                        << timeSliceSecs << " second time slice");
+        }
         invariantWTOK(ret);
     }
     return Status::OK();
@@ -691,6 +766,9 @@ public:
 
         _cursor->set_value(_cursor, valueItem.Get());
 
+        _idx->_addToKeyFilter(newKeyString.getBuffer(),
+                              KeyString::sizeWithoutRecordIdLongAtEnd(newKeyString.getBuffer(),
+                                                                      newKeyString.getSize()));
         invariantWTOK(wiredTigerCursorInsert(_opCtx, _cursor));
 
         auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
@@ -743,6 +821,7 @@ public:
         setKey(_cursor, keyItem.Get());
         _cursor->set_value(_cursor, valueItem.Get());
 
+        _idx->_addToKeyFilter(newKeyString.getBuffer(), sizeWithoutRecordId);
         invariantWTOK(wiredTigerCursorInsert(_opCtx, _cursor));
 
         auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
@@ -845,6 +924,16 @@ public:
                     key.getBuffer(), key.getSize(), _idx.getOrdering(), key.getTypeBits()) ==
                 KeyString::Discriminator::kInclusive);
 
+        // The key ends with a kEnd byte where index entries have their RecordId, if any.
+        auto keyFilter = _idx.keyFilterFor(_opCtx);
+        if (keyFilter && !keyFilter->mayContain(key.getBuffer(), key.getSize() - 1)) {
+            // Leave the cursor as a search that found nothing would.
+            _cursorAtEof = true;
+            _lastMoveSkippedKey = false;
+            _eof = true;
+            return {};
+        }
+
         auto ksEntry = [&]() {
             if (_forward) {
                 return seekForKeyString(key);
@@ -863,17 +952,18 @@ public:
             return seekForKeyString(keyCopy.getValueCopy());
         }();
 
-        if (!ksEntry) {
-            return {};
-        }
-
-        if (KeyString::compare(ksEntry->keyString.getBuffer(),
+        if (ksEntry &&
+            KeyString::compare(ksEntry->keyString.getBuffer(),
                                key.getBuffer(),
                                KeyString::sizeWithoutRecordIdLongAtEnd(
                                    ksEntry->keyString.getBuffer(), ksEntry->keyString.getSize()),
                                key.getSize()) == 0) {
             return KeyStringEntry(ksEntry->keyString, ksEntry->loc);
         }
+
+        if (keyFilter) {
+            keyFilter->recordFalsePositive();
+        }
         return {};
     }
 
@@ -890,8 +980,13 @@ public:
 
     void save() override {
         try {
-            if (_cursor)
+            if (_cursor) {
+                // The type bits can no longer be read once the cursor is reset.
+                if (!_eof) {
+                    loadTypeBitsIfNeeded();
+                }
                 _cursor->reset();
+            }
         } catch (const WriteConflictException&) {
             // Ignore since this is only called when we are about to kill our transaction
             // anyway.
@@ -950,6 +1045,19 @@ protected:
             _id = KeyString::decodeRecordIdStrAtEnd(_key.getBuffer(), _key.getSize());
         }
 
+        // The type bits are stored in the value and are only needed to rebuild the key, so defer
+        // reading them. Scans that only want RecordIds, like counts over the long runs of entries
+        // sharing a key in a low-cardinality index, then never read the value at all.
+        _typeBitsNeedLoading = true;
+    }
+
+    // Reads the type bits of the current entry if updateIdAndTypeBits() deferred it. Must be called
+    // while the cursor is still positioned on that entry.
+    void loadTypeBitsIfNeeded() const {
+        if (!_typeBitsNeedLoading) {
+            return;
+        }
+
         WT_CURSOR* c = _cursor->get();
         WT_ITEM item;
         // Can't get WT_ROLLBACK and hence won't throw an exception.
@@ -959,6 +1067,7 @@ protected:
         invariantWTOK(ret);
         BufReader br(item.data, item.size);
         _typeBits.resetFromBuffer(&br);
+        _typeBitsNeedLoading = false;
     }
 
     void setKey(WT_CURSOR* cursor, const WT_ITEM* item) {
@@ -981,6 +1090,7 @@ protected:
 
         BSONObj bson;
         if (TRACING_ENABLED || (parts & kWantKey)) {
+            loadTypeBitsIfNeeded();
             bson =
                 KeyString::toBson(_key.getBuffer(), _key.getSize(), _idx.getOrdering(), _typeBits);
 
@@ -1184,6 +1294,8 @@ protected:
     }
 
     KeyStringEntry getKeyStringEntry() {
+        loadTypeBitsIfNeeded();
+
         // Most keys will have a RecordId appended to the end, with the exception of the _id index
         // and timestamp unsafe unique indexes. The contract of this function is to always return a
         // KeyString with a RecordId, so append one if it does not exists already.
@@ -1219,10 +1331,13 @@ protected:
     // These are where this cursor instance is. They are not changed in the face of a failing
     // next().
     KeyString::Builder _key;
-    KeyString::TypeBits _typeBits;
+    mutable KeyString::TypeBits _typeBits;
     RecordId _id;
     bool _eof = true;
 
+    // Whether '_typeBits' still needs to be read from the value of the current entry.
+    mutable bool _typeBitsNeedLoading = false;
+
     // This differs from _eof in that it always reflects the result of the most recent call to
     // reposition _cursor.
     bool _cursorAtEof = false;
@@ -1319,6 +1434,7 @@ private:
         BufReader br(item.data, item.size);
         _id = KeyString::decodeRecordIdLong(&br);
         _typeBits.resetFromBuffer(&br);
+        _typeBitsNeedLoading = false;
 
         if (!br.atEof()) {
             LOGV2_FATAL(28608,
@@ -1375,6 +1491,7 @@ WiredTigerIndexUnique::WiredTigerIndexUnique(OperationContext* ctx,
     invariant(!isIdIndex());
     // All unique indexes should be in the timestamp-safe format version as of version 4.2.
     invariant(isTimestampSafeUniqueIdx());
+    _initKeyFilter(ctx);
 }
 
 std::unique_ptr<SortedDataInterface::Cursor> WiredTigerIndexUnique::newCursor(
@@ -1479,6 +1596,7 @@ WiredTigerIdIndex::WiredTigerIdIndex(OperationContext* ctx,
                                      bool isReadOnly)
     : WiredTigerIndex(ctx, uri, ident, KeyFormat::Long, desc, isReadOnly) {
     invariant(isIdIndex());
+    _initKeyFilter(ctx);
 }
 
 std::unique_ptr<SortedDataInterface::Cursor> WiredTigerIdIndex::newCursor(OperationContext* opCtx,
@@ -1505,6 +1623,7 @@ Status WiredTigerIdIndex::_insert(OperationContext* opCtx,
         value.appendTypeBits(typeBits);
 
     WiredTigerItem valueItem(value.getBuffer(), value.getSize());
+    _addToKeyFilter(keyString.getBuffer(), sizeWithoutRecordId);
     setKey(c, keyItem.Get());
     c->set_value(c, valueItem.Get());
     int ret = WT_OP_CHECK(wiredTigerCursorInsert(opCtx, c));
@@ -1563,8 +1682,12 @@ Status WiredTigerIndexUnique::_insert(OperationContext* opCtx,
         ret = WT_OP_CHECK(wiredTigerCursorRemove(opCtx, c));
         invariantWTOK(ret);
 
-        // Second phase looks up for existence of key to avoid insertion of duplicate key
-        if (_keyExists(opCtx, c, keyString.getBuffer(), sizeWithoutRecordId)) {
+        // Second phase looks up for existence of key to avoid insertion of duplicate key. The
+        // search can be skipped when the key filter proves the key was never inserted.
+        auto keyFilter = keyFilterFor(opCtx);
+        const bool mayExist =
+            !keyFilter || keyFilter->mayContain(keyString.getBuffer(), sizeWithoutRecordId);
+        if (mayExist && _keyExists(opCtx, c, keyString.getBuffer(), sizeWithoutRecordId)) {
             auto key = KeyString::toBson(
                 keyString.getBuffer(), sizeWithoutRecordId, _ordering, keyString.getTypeBits());
             auto entry = _desc->getEntry();
@@ -1575,8 +1698,15 @@ Status WiredTigerIndexUnique::_insert(OperationContext* opCtx,
                                           _keyPattern,
                                           _collation);
         }
+        if (keyFilter && mayExist) {
+            keyFilter->recordFalsePositive();
+        }
     }
 
+    _addToKeyFilter(
+        keyString.getBuffer(),
+        KeyString::sizeWithoutRecordIdLongAtEnd(keyString.getBuffer(), keyString.getSize()));
+
     // Now create the table key/value, the actual data record.
     WiredTigerItem keyItem(keyString.getBuffer(), keyString.getSize());
 
@@ -35,6 +35,7 @@
 #include "mongo/db/storage/index_entry_comparison.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/sorted_data_interface.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_index_key_filter.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 
@@ -113,6 +114,7 @@ public:
     virtual bool appendCustomStats(OperationContext* opCtx,
                                    BSONObjBuilder* output,
                                    double scale) const;
+    bool appendKeyFilterStats(BSONObjBuilder* output) const override;
     virtual Status dupKeyCheck(OperationContext* opCtx, const KeyString::Value& keyString);
 
     virtual bool isEmpty(OperationContext* opCtx);
@@ -155,6 +157,13 @@ public:
     virtual bool unique() const = 0;
     virtual bool isTimestampSafeUniqueIdx() const = 0;
 
+    /**
+     * Returns the key filter of this index if 'opCtx' may rely on it, or nullptr. The filter only
+     * knows about keys present since the index was opened, so reads at a timestamp, which may see
+     * entries removed before then, must search the table.
+     */
+    const WiredTigerIndexKeyFilter* keyFilterFor(OperationContext* opCtx) const;
+
 protected:
     virtual Status _insert(OperationContext* opCtx,
                            WT_CURSOR* c,
@@ -169,6 +178,22 @@ protected:
     void setKey(WT_CURSOR* cursor, const WT_ITEM* item);
     void getKey(OperationContext* opCtx, WT_CURSOR* cursor, WT_ITEM* key);
 
+    /**
+     * Creates '_keyFilter' and adds every key already in the index to it, if key filters are
+     * enabled. Called by the constructors of unique and _id indexes.
+     */
+    void _initKeyFilter(OperationContext* opCtx);
+
+    /**
+     * Adds a key, without its RecordId, to the key filter if there is one. Must be called before
+     * the entry for that key becomes visible to other transactions.
+     */
+    void _addToKeyFilter(const char* buffer, size_t size) {
+        if (_keyFilter) {
+            _keyFilter->add(buffer, size);
+        }
+    }
+
     /*
      * Determines the data format version from application metadata and verifies compatibility.
      * Returns the corresponding KeyString version.
@@ -194,6 +219,9 @@ protected:
     const std::string _indexName;
     const BSONObj _keyPattern;
     const BSONObj _collation;
+
+    // Only set for unique and _id indexes when wiredTigerUniqueIndexKeyFilterSizeMB is non-zero.
+    std::unique_ptr<WiredTigerIndexKeyFilter> _keyFilter;
 };
 
 class WiredTigerIndexUnique : public WiredTigerIndex {
@@ -0,0 +1,99 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_index_key_filter.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "third_party/murmurhash3/MurmurHash3.h"
+
+namespace mongo {
+namespace {
+
+struct KeyHash {
+    uint64_t h1;
+    uint64_t h2;
+};
+
+KeyHash hashKey(const char* key, size_t size) {
+    uint64_t hash[2];
+    MurmurHash3_x64_128(key, size, 0, hash);
+    // Probe positions are h1 + i * h2, so keep h2 odd to never probe the same bit twice.
+    return {hash[0], hash[1] | 1};
+}
+
+}  // namespace
+
+WiredTigerIndexKeyFilter::WiredTigerIndexKeyFilter(size_t sizeBytes)
+    : _numWords(std::max<size_t>(sizeBytes / sizeof(uint64_t), 1)),
+      _numBits(_numWords * 64),
+      _capacity(static_cast<long long>(_numBits / kBitsPerKey)),
+      _words(new AtomicWord<uint64_t>[_numWords]) {}
+
+void WiredTigerIndexKeyFilter::add(const char* key, size_t size) {
+    // Once full the filter no longer answers lookups, so there is no point setting more bits.
+    if (_numKeys.fetchAndAddRelaxed(1) >= _capacity) {
+        return;
+    }
+
+    const auto hash = hashKey(key, size);
+    for (int i = 0; i < kNumProbes; ++i) {
+        const uint64_t bit = (hash.h1 + i * hash.h2) % _numBits;
+        _words[bit / 64].fetchAndBitOr(uint64_t{1} << (bit % 64));
+    }
+}
+
+bool WiredTigerIndexKeyFilter::mayContain(const char* key, size_t size) const {
+    _numLookups.fetchAndAddRelaxed(1);
+
+    const auto hash = hashKey(key, size);
+    for (int i = 0; i < kNumProbes; ++i) {
+        const uint64_t bit = (hash.h1 + i * hash.h2) % _numBits;
+        if (!(_words[bit / 64].load() & (uint64_t{1} << (bit % 64)))) {
+            _numNegatives.fetchAndAddRelaxed(1);
+            return false;
+        }
+    }
+    return true;
+}
+
+void WiredTigerIndexKeyFilter::appendStats(BSONObjBuilder* builder) const {
+    builder->append("sizeBytes", static_cast<long long>(_numWords * sizeof(uint64_t)));
+    builder->append("keys", std::min(_numKeys.loadRelaxed(), _capacity));
+    builder->append("capacity", _capacity);
+    builder->append("usable", isUsable());
+    builder->append("lookups", _numLookups.loadRelaxed());
+    builder->append("negatives", _numNegatives.loadRelaxed());
+    builder->append("falsePositives", _numFalsePositives.loadRelaxed());
+}
+
+}  // namespace mongo
@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "mongo/platform/atomic_word.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * An in-memory Bloom filter over the keys of a unique index, without their RecordIds. Duplicate key
+ * checks and point lookups for a key the filter has never seen can skip searching the table.
+ *
+ * Keys are only ever added: an entry removed from the index stays in the filter, which costs no
+ * more than a false positive. The filter is sized once and stops answering lookups once it holds
+ * more keys than it was sized for, as its false positive rate would otherwise keep climbing. It is
+ * built from scratch every time the index is opened.
+ *
+ * All methods are thread-safe.
+ */
+class WiredTigerIndexKeyFilter {
+public:
+    explicit WiredTigerIndexKeyFilter(size_t sizeBytes);
+
+    WiredTigerIndexKeyFilter(const WiredTigerIndexKeyFilter&) = delete;
+    WiredTigerIndexKeyFilter& operator=(const WiredTigerIndexKeyFilter&) = delete;
+
+    void add(const char* key, size_t size);
+
+    /**
+     * Returns false if 'key' was definitely never added. Must only be called while isUsable().
+     */
+    bool mayContain(const char* key, size_t size) const;
+
+    /**
+     * Marks the filter as holding every key of the index, after which it may answer lookups.
+     */
+    void markReady() {
+        _ready.store(true);
+    }
+
+    /**
+     * Returns true if the filter is ready and has not outgrown its size.
+     */
+    bool isUsable() const {
+        return _ready.load() && _numKeys.loadRelaxed() <= _capacity;
+    }
+
+    /**
+     * Records that a key reported by mayContain() turned out not to be in the index.
+     */
+    void recordFalsePositive() const {
+        _numFalsePositives.fetchAndAddRelaxed(1);
+    }
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    // Together these give a false positive rate of about 1% at capacity.
+    static constexpr size_t kBitsPerKey = 10;
+    static constexpr int kNumProbes = 7;
+
+    const size_t _numWords;
+    const size_t _numBits;
+    const long long _capacity;
+    std::unique_ptr<AtomicWord<uint64_t>[]> _words;
+
+    AtomicWord<bool> _ready{false};
+    AtomicWord<long long> _numKeys{0};
+
+    mutable AtomicWord<long long> _numLookups{0};
+    mutable AtomicWord<long long> _numNegatives{0};
+    mutable AtomicWord<long long> _numFalsePositives{0};
+};
+
+}  // namespace mongo
@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_index_key_filter.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+bool mayContain(const WiredTigerIndexKeyFilter& filter, int i) {
+    auto key = std::to_string(i);
+    return filter.mayContain(key.data(), key.size());
+}
+
+void add(WiredTigerIndexKeyFilter& filter, int i) {
+    auto key = std::to_string(i);
+    filter.add(key.data(), key.size());
+}
+
+TEST(WiredTigerIndexKeyFilterTest, NotUsableUntilReady) {
+    WiredTigerIndexKeyFilter filter(1024);
+    add(filter, 1);
+    ASSERT_FALSE(filter.isUsable());
+    filter.markReady();
+    ASSERT_TRUE(filter.isUsable());
+}
+
+TEST(WiredTigerIndexKeyFilterTest, NoFalseNegatives) {
+    WiredTigerIndexKeyFilter filter(1024);
+    filter.markReady();
+    for (int i = 0; i < 800; ++i) {
+        add(filter, i);
+    }
+    ASSERT_TRUE(filter.isUsable());
+    for (int i = 0; i < 800; ++i) {
+        ASSERT_TRUE(mayContain(filter, i)) << i;
+    }
+}
+
+TEST(WiredTigerIndexKeyFilterTest, FalsePositiveRateAtCapacity) {
+    WiredTigerIndexKeyFilter filter(8 * 1024);
+    filter.markReady();
+    // 8KB holds 6553 keys at 10 bits per key.
+    for (int i = 0; i < 6500; ++i) {
+        add(filter, i);
+    }
+
+    int falsePositives = 0;
+    for (int i = 100000; i < 110000; ++i) {
+        if (mayContain(filter, i)) {
+            ++falsePositives;
+        }
+    }
+    // Around 1% is expected.
+    ASSERT_LT(falsePositives, 300);
+}
+
+TEST(WiredTigerIndexKeyFilterTest, StopsAnsweringWhenFull) {
+    WiredTigerIndexKeyFilter filter(8);
+    filter.markReady();
+    // 64 bits hold 6 keys.
+    for (int i = 0; i < 6; ++i) {
+        add(filter, i);
+    }
+    ASSERT_TRUE(filter.isUsable());
+    add(filter, 6);
+    ASSERT_FALSE(filter.isUsable());
+}
+
+TEST(WiredTigerIndexKeyFilterTest, Stats) {
+    WiredTigerIndexKeyFilter filter(1024);
+    filter.markReady();
+    add(filter, 1);
+    ASSERT_TRUE(mayContain(filter, 1));
+    filter.recordFalsePositive();
+
+    BSONObjBuilder builder;
+    filter.appendStats(&builder);
+    auto stats = builder.obj();
+    ASSERT_EQ(stats["sizeBytes"].numberLong(), 1024);
+    ASSERT_EQ(stats["keys"].numberLong(), 1);
+    ASSERT_EQ(stats["capacity"].numberLong(), 819);
+    ASSERT_TRUE(stats["usable"].trueValue());
+    ASSERT_EQ(stats["lookups"].numberLong(), 1);
+    ASSERT_EQ(stats["negatives"].numberLong(), 0);
+    ASSERT_EQ(stats["falsePositives"].numberLong(), 1);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -261,6 +261,30 @@ std::string toString(const StorageEngine::OldestActiveTransactionTimestampResult
 namespace {
 TicketHolder openWriteTransaction(128);
 TicketHolder openReadTransaction(128);
+
+// Ticket pool sizes as configured through the server parameters. Cache admission control sizes the
+// pools as a percentage of these.
+AtomicWord<int> configuredWriteTickets{128};
+AtomicWord<int> configuredReadTickets{128};
+
+// Percentage of the configured tickets currently handed out by cache admission control.
+AtomicWord<int> admissionTicketsPercent{100};
+AtomicWord<long long> admissionThrottledSeconds{0};
+
+Mutex ticketResizeMutex = MONGO_MAKE_LATCH("WiredTigerKVEngine::ticketResizeMutex");
+
+Status resizeTicketHolders() {
+    stdx::lock_guard<Latch> lk(ticketResizeMutex);
+    const int percent = admissionTicketsPercent.load();
+    auto scaled = [&](int configured) {
+        return percent == 100 ? configured : std::max(5, configured * percent / 100);
+    };
+    auto status = openWriteTransaction.resize(scaled(configuredWriteTickets.load()));
+    if (!status.isOK()) {
+        return status;
+    }
+    return openReadTransaction.resize(scaled(configuredReadTickets.load()));
+}
 }  // namespace
 
 OpenWriteTransactionParam::OpenWriteTransactionParam(StringData name, ServerParameterType spt)
@@ -269,7 +293,7 @@ OpenWriteTransactionParam::OpenWriteTransactionParam(StringData name, ServerPara
 void OpenWriteTransactionParam::append(OperationContext* opCtx,
                                        BSONObjBuilder& b,
                                        const std::string& name) {
-    b.append(name, _data->outof());
+    b.append(name, configuredWriteTickets.load());
 }
 
 Status OpenWriteTransactionParam::setFromString(const std::string& str) {
@@ -281,7 +305,12 @@ Status OpenWriteTransactionParam::setFromString(const std::string& str) {
     if (num <= 0) {
         return {ErrorCodes::BadValue, str::stream() << name() << " has to be > 0"};
     }
-    return _data->resize(num);
+    const int previous = configuredWriteTickets.swap(num);
+    status = resizeTicketHolders();
+    if (!status.isOK()) {
+        configuredWriteTickets.store(previous);
+    }
+    return status;
 }
 
 OpenReadTransactionParam::OpenReadTransactionParam(StringData name, ServerParameterType spt)
@@ -290,7 +319,7 @@ OpenReadTransactionParam::OpenReadTransactionParam(StringData name, ServerParame
 void OpenReadTransactionParam::append(OperationContext* opCtx,
                                       BSONObjBuilder& b,
                                       const std::string& name) {
-    b.append(name, _data->outof());
+    b.append(name, configuredReadTickets.load());
 }
 
 Status OpenReadTransactionParam::setFromString(const std::string& str) {
@@ -302,8 +331,142 @@ Status OpenReadTransactionParam::setFromString(const std::string& str) {
     if (num <= 0) {
         return {ErrorCodes::BadValue, str::stream() << name() << " has to be > 0"};
     }
-    return _data->resize(num);
+    const int previous = configuredReadTickets.swap(num);
+    status = resizeTicketHolders();
+    if (!status.isOK()) {
+        configuredReadTickets.store(previous);
+    }
+    return status;
+}
+
+namespace {
+/**
+ * Returns whether the used or dirty fraction of the WiredTiger cache has reached the cache
+ * admission control thresholds.
+ */
+bool isCacheFillAboveThresholds(WT_SESSION* session) {
+    auto stat = [&](int key) -> int64_t {
+        auto value =
+            WiredTigerUtil::getStatisticsValue(session, "statistics:", "statistics=(fast)", key);
+        return value.isOK() ? value.getValue() : 0;
+    };
+
+    const int64_t maxBytes = stat(WT_STAT_CONN_CACHE_BYTES_MAX);
+    if (maxBytes <= 0) {
+        return false;
+    }
+    const int64_t usedPercent = stat(WT_STAT_CONN_CACHE_BYTES_INUSE) * 100 / maxBytes;
+    const int64_t dirtyPercent = stat(WT_STAT_CONN_CACHE_BYTES_DIRTY) * 100 / maxBytes;
+    return usedPercent >= gWiredTigerAdmissionCacheUsedPercent.load() ||
+        dirtyPercent >= gWiredTigerAdmissionCacheDirtyPercent.load();
 }
+}  // namespace
+
+/**
+ * Shrinks the ticket pools while the WiredTiger cache is under eviction pressure, so fewer
+ * operations compete to fill the cache, and grows them back once the pressure subsides. The cache
+ * is under pressure when its dirty or used fraction exceeds the configured thresholds, or when
+ * application threads were drawn into eviction because the eviction workers could not keep up.
+ */
+class WiredTigerKVEngine::WiredTigerCacheAdmissionController : public BackgroundJob {
+public:
+    explicit WiredTigerCacheAdmissionController(WT_CONNECTION* conn)
+        : BackgroundJob(false /* deleteSelf */), _conn(conn) {}
+
+    virtual string name() const {
+        return "WTCacheAdmissionController";
+    }
+
+    virtual void run() {
+        ThreadClient tc(name(), getGlobalServiceContext());
+        LOGV2_DEBUG(5910906, 1, "starting {name} thread", "name"_attr = name());
+
+        while (!_shuttingDown.load()) {
+            {
+                stdx::unique_lock<Latch> lock(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+                _condvar.wait_for(lock, stdx::chrono::seconds(1));
+            }
+            if (_shuttingDown.load()) {
+                break;
+            }
+
+            if (gWiredTigerCacheAdmissionControl.load()) {
+                _adjustTickets(_isCacheUnderPressure());
+            } else if (admissionTicketsPercent.load() != 100) {
+                _setTicketsPercent(100);
+            }
+        }
+        LOGV2_DEBUG(5910907, 1, "stopping {name} thread", "name"_attr = name());
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        {
+            stdx::unique_lock<Latch> lock(_mutex);
+            _condvar.notify_one();
+        }
+        wait();
+        Locker::setDeprioritizeLongRunningOperations(false);
+    }
+
+private:
+    bool _isCacheUnderPressure() {
+        WiredTigerSession session(_conn);
+        auto appEvictions = WiredTigerUtil::getStatisticsValue(session.getSession(),
+                                                               "statistics:",
+                                                               "statistics=(fast)",
+                                                               WT_STAT_CONN_CACHE_EVICTION_APP);
+        const int64_t appEvictionsValue = appEvictions.isOK() ? appEvictions.getValue() : 0;
+        const bool appThreadsEvicting =
+            _lastAppEvictions >= 0 && appEvictionsValue > _lastAppEvictions;
+        _lastAppEvictions = appEvictionsValue;
+
+        return appThreadsEvicting || isCacheFillAboveThresholds(session.getSession());
+    }
+
+    void _adjustTickets(bool underPressure) {
+        const int current = admissionTicketsPercent.load();
+        if (underPressure) {
+            admissionThrottledSeconds.fetchAndAdd(1);
+            const int floor = gWiredTigerAdmissionMinTicketsPercent.load();
+            _setTicketsPercent(std::max(floor, std::min(current, current * 3 / 4)));
+        } else if (current < 100) {
+            _setTicketsPercent(std::min(100, current + 10));
+        }
+    }
+
+    void _setTicketsPercent(int percent) {
+        const int previous = admissionTicketsPercent.swap(percent);
+        Locker::setDeprioritizeLongRunningOperations(percent < 100);
+        if (percent == previous) {
+            return;
+        }
+
+        LOGV2_DEBUG(5910908,
+                    1,
+                    "Resizing ticket pools for WiredTiger cache admission control",
+                    "previousPercent"_attr = previous,
+                    "percent"_attr = percent);
+        auto status = resizeTicketHolders();
+        if (!status.isOK()) {
+            LOGV2_WARNING(5910909,
+                          "Failed to resize ticket pools for WiredTiger cache admission control",
+                          "error"_attr = status);
+        }
+    }
+
+    WT_CONNECTION* _conn;
+    AtomicWord<bool> _shuttingDown{false};
+
+    // Statistic values are cumulative, so eviction by application threads is detected from the
+    // change since the previous check.
+    int64_t _lastAppEvictions = -1;
+
+    Mutex _mutex =
+        MONGO_MAKE_LATCH("WiredTigerCacheAdmissionController::_mutex");  // protects _condvar
+    stdx::condition_variable _condvar;
+};
 
 StringData WiredTigerKVEngine::kTableUriPrefix = "table:"_sd;
 
@@ -516,6 +679,11 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     _sessionSweeper = std::make_unique<WiredTigerSessionSweeper>(_sessionCache.get());
     _sessionSweeper->go();
 
+    if (!_readOnly) {
+        _cacheAdmissionController = std::make_unique<WiredTigerCacheAdmissionController>(_conn);
+        _cacheAdmissionController->go();
+    }
+
     // Until the Replication layer installs a real callback, prevent truncating the oplog.
     setOldestActiveTransactionTimestampCallback(
         [](Timestamp) { return StatusWith(boost::make_optional(Timestamp::min())); });
@@ -604,6 +772,7 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openWriteTransaction.used());
         bbb.append("available", openWriteTransaction.available());
         bbb.append("totalTickets", openWriteTransaction.outof());
+        openWriteTransaction.appendStats(bbb);
         bbb.done();
     }
     {
@@ -611,6 +780,14 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openReadTransaction.used());
         bbb.append("available", openReadTransaction.available());
         bbb.append("totalTickets", openReadTransaction.outof());
+        openReadTransaction.appendStats(bbb);
+        bbb.done();
+    }
+    {
+        BSONObjBuilder bbb(bb.subobjStart("admissionControl"));
+        bbb.append("enabled", gWiredTigerCacheAdmissionControl.load());
+        bbb.append("ticketsPercent", admissionTicketsPercent.load());
+        bbb.append("throttledSeconds", admissionThrottledSeconds.load());
         bbb.done();
     }
     bb.done();
@@ -718,6 +895,9 @@ void WiredTigerKVEngine::cleanShutdown() {
 
     // these must be the last things we do before _conn->close();
     haltOplogManager(/*oplogRecordStore=*/nullptr, /*shuttingDown=*/true);
+    if (_cacheAdmissionController) {
+        _cacheAdmissionController->shutdown();
+    }
     if (_sessionSweeper) {
         LOGV2(22318, "Shutting down session sweeper thread");
         _sessionSweeper->shutdown();
@@ -1804,6 +1984,18 @@ void WiredTigerKVEngine::checkpoint() {
     const Timestamp stableTimestamp = getStableTimestamp();
     const Timestamp initialDataTimestamp = getInitialDataTimestamp();
 
+    // Spread the checkpoint's writes out to the configured rate, and lift the limit once the
+    // checkpoint completes so that other I/O is not throttled in between checkpoints.
+    const long long maxWriteMBPerSec = gWiredTigerCheckpointMaxWriteMBPerSec.load();
+    if (maxWriteMBPerSec > 0) {
+        _setIOCapacity(maxWriteMBPerSec * 1024 * 1024);
+    }
+    ON_BLOCK_EXIT([&] {
+        if (maxWriteMBPerSec > 0) {
+            _setIOCapacity(0);
+        }
+    });
+
     // The amount of oplog to keep is primarily dictated by a user setting. However, in unexpected
     // cases, durable, recover to a timestamp storage engines may need to play forward from an oplog
     // entry that would otherwise be truncated by the user setting. Furthermore, the entries in
@@ -1871,6 +2063,44 @@ void WiredTigerKVEngine::checkpoint() {
     }
 }
 
+void WiredTigerKVEngine::_setIOCapacity(long long bytesPerSec) {
+    const std::string config = "io_capacity=(total={})"_format(bytesPerSec);
+    if (int ret = _conn->reconfigure(_conn, config.c_str())) {
+        LOGV2_WARNING(5910918,
+                      "Failed to reconfigure WiredTiger I/O capacity",
+                      "config"_attr = config,
+                      "error"_attr = wtRCToStatus(ret));
+    }
+}
+
+boost::optional<int64_t> WiredTigerKVEngine::getCheckpointDirtyBytes() const {
+    WiredTigerSession session(_conn);
+    auto dirtyBytes = WiredTigerUtil::getStatisticsValue(
+        session.getSession(), "statistics:", "statistics=(fast)", WT_STAT_CONN_CACHE_BYTES_DIRTY);
+    if (!dirtyBytes.isOK()) {
+        return boost::none;
+    }
+    return dirtyBytes.getValue();
+}
+
+bool WiredTigerKVEngine::isCacheUnderPressure() const {
+    WiredTigerSession session(_conn);
+    return isCacheFillAboveThresholds(session.getSession());
+}
+
+boost::optional<int64_t> WiredTigerKVEngine::getCheckpointBytesWritten() const {
+    WiredTigerSession session(_conn);
+    auto bytesWritten =
+        WiredTigerUtil::getStatisticsValue(session.getSession(),
+                                           "statistics:",
+                                           "statistics=(fast)",
+                                           WT_STAT_CONN_BLOCK_BYTE_WRITE_CHECKPOINT);
+    if (!bytesWritten.isOK()) {
+        return boost::none;
+    }
+    return bytesWritten.getValue();
+}
+
 bool WiredTigerKVEngine::hasIdent(OperationContext* opCtx, StringData ident) const {
     return _hasUri(WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession(), _uri(ident));
 }
@@ -2504,6 +2734,20 @@ Timestamp WiredTigerKVEngine::getCheckpointTimestamp() const {
     return Timestamp(_getCheckpointTimestamp());
 }
 
+boost::optional<Timestamp> WiredTigerKVEngine::getOldestActiveReadTimestamp() const {
+    char buf[(2 * 8 /*bytes in hex*/) + 1 /*nul terminator*/];
+    auto wtStatus = _conn->query_timestamp(_conn, buf, "get=oldest_reader");
+    if (wtStatus == WT_NOTFOUND) {
+        // No transaction or checkpoint is reading at a timestamp.
+        return boost::none;
+    }
+    invariantWTOK(wtStatus);
+
+    std::uint64_t tmp;
+    fassert(6100005, NumberParser().base(16)(buf, &tmp));
+    return Timestamp(tmp);
+}
+
 std::uint64_t WiredTigerKVEngine::_getCheckpointTimestamp() const {
     char buf[(2 * 8 /*bytes in hex*/) + 1 /*nul terminator*/];
     invariantWTOK(_conn->query_timestamp(_conn, buf, "get=last_checkpoint"));
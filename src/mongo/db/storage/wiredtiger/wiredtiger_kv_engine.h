@@ -113,6 +113,12 @@ public:
 
     void checkpoint() override;
 
+    boost::optional<int64_t> getCheckpointDirtyBytes() const override;
+
+    boost::optional<int64_t> getCheckpointBytesWritten() const override;
+
+    bool isCacheUnderPressure() const override;
+
     bool isDurable() const override {
         return _durable;
     }
@@ -303,6 +309,13 @@ public:
     Timestamp getOldestTimestamp() const override;
     Timestamp getCheckpointTimestamp() const override;
 
+    /**
+     * Returns the oldest read timestamp of the active transactions and any running checkpoint, or
+     * boost::none if none of them reads at a timestamp. History newer than this timestamp cannot be
+     * discarded while they run.
+     */
+    boost::optional<Timestamp> getOldestActiveReadTimestamp() const;
+
     /**
      * Returns the data file path associated with an ident on disk. Returns boost::none if the data
      * file can not be found. This will attempt to locate a file even if the storage engine's own
@@ -362,6 +375,7 @@ public:
 
 private:
     class WiredTigerSessionSweeper;
+    class WiredTigerCacheAdmissionController;
 
     struct IdentToDrop {
         std::string uri;
@@ -391,6 +405,12 @@ private:
 
     bool _hasUri(WT_SESSION* session, const std::string& uri) const;
 
+    /**
+     * Limits the bytes per second WiredTiger reads and writes in total, or lifts the limit if
+     * 'bytesPerSec' is 0.
+     */
+    void _setIOCapacity(long long bytesPerSec);
+
     std::string _uri(StringData ident) const;
 
     /**
@@ -455,6 +475,7 @@ private:
     const bool _keepDataHistory = true;
 
     std::unique_ptr<WiredTigerSessionSweeper> _sessionSweeper;
+    std::unique_ptr<WiredTigerCacheAdmissionController> _cacheAdmissionController;
 
     std::string _rsOptions;
     std::string _indexOptions;
@@ -77,10 +77,12 @@ void WiredTigerOplogManager::startVisibilityThread(OperationContext* opCtx,
     // Need to obtain the mutex before starting the thread, as otherwise it may race ahead
     // see _shuttingDown as true and quit prematurely.
     stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+    _sessionCache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
+    _oplogRecordStore = oplogRecordStore;
     _oplogVisibilityThread = stdx::thread(&WiredTigerOplogManager::_updateOplogVisibilityLoop,
                                           this,
-                                          WiredTigerRecoveryUnit::get(opCtx)->getSessionCache(),
-                                          oplogRecordStore);
+                                          _sessionCache,
+                                          _oplogRecordStore);
 
     _isRunning = true;
     _shuttingDown = false;
@@ -88,7 +90,7 @@ void WiredTigerOplogManager::startVisibilityThread(OperationContext* opCtx,
 
 void WiredTigerOplogManager::haltVisibilityThread() {
     {
-        stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+        stdx::unique_lock<Latch> lk(_oplogVisibilityStateMutex);
         if (!_isRunning) {
             // This is called from two places; on clean shutdown and when the record store for the
             // oplog is destroyed. We will perform the actual shutdown on the first call and the
@@ -102,6 +104,12 @@ void WiredTigerOplogManager::haltVisibilityThread() {
 
         _shuttingDown = true;
         _isRunning = false;
+
+        // Writers updating visibility inline use the oplog record store, which may be destroyed
+        // as soon as we return.
+        _inlineVisibilityUpdatersCV.wait(lk, [&] { return _inlineVisibilityUpdaters == 0; });
+        _sessionCache = nullptr;
+        _oplogRecordStore = nullptr;
     }
 
     if (_oplogVisibilityThread.joinable()) {
@@ -111,11 +119,80 @@ void WiredTigerOplogManager::haltVisibilityThread() {
 }
 
 void WiredTigerOplogManager::triggerOplogVisibilityUpdate() {
-    stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
-    if (!_triggerOplogVisibilityUpdate) {
-        _triggerOplogVisibilityUpdate = true;
-        _oplogVisibilityThreadCV.notify_one();
+    {
+        stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+        // Only update visibility on the committing thread when someone is waiting for it. With no
+        // waiters, leave it to the visibility thread, which batches updates to reduce load.
+        const bool updateInline = _isRunning && !_shuttingDown &&
+            (_opsWaitingForOplogVisibilityUpdate || _oplogRecordStore->haveCappedWaiters()) &&
+            !MONGO_unlikely(WTPauseOplogVisibilityUpdateLoop.shouldFail());
+        if (!updateInline) {
+            if (!_triggerOplogVisibilityUpdate) {
+                _triggerOplogVisibilityUpdate = true;
+                _oplogVisibilityThreadCV.notify_one();
+            }
+            return;
+        }
+        ++_inlineVisibilityUpdaters;
+    }
+
+    ON_BLOCK_EXIT([&] {
+        stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+        if (--_inlineVisibilityUpdaters == 0) {
+            _inlineVisibilityUpdatersCV.notify_all();
+        }
+    });
+    _updateOplogReadTimestampInline();
+}
+
+void WiredTigerOplogManager::_updateOplogReadTimestampInline() {
+    _inlineVisibilityUpdateRequested.store(true);
+    do {
+        if (_inlineVisibilityUpdateInProgress.swap(true)) {
+            // The writer already updating will see our request and update again.
+            return;
+        }
+        while (_inlineVisibilityUpdateRequested.swap(false)) {
+            _updateOplogReadTimestamp(_sessionCache, _oplogRecordStore);
+        }
+        _inlineVisibilityUpdateInProgress.store(false);
+        // A request may have arrived after we last checked but before we stopped updating.
+    } while (_inlineVisibilityUpdateRequested.load());
+}
+
+bool WiredTigerOplogManager::_updateOplogReadTimestamp(WiredTigerSessionCache* sessionCache,
+                                                       WiredTigerRecordStore* oplogRecordStore) {
+    // Fetch the all_durable timestamp from the storage engine, which is guaranteed not to have
+    // any holes behind it in-memory.
+    const uint64_t newTimestamp = sessionCache->getKVEngine()->getAllDurableTimestamp().asULL();
+
+    // The newTimestamp may actually go backward during secondary batch application,
+    // where we commit data file changes separately from oplog changes, so ignore
+    // a non-incrementing timestamp.
+    if (newTimestamp <= _oplogReadTimestamp.load()) {
+        LOGV2_DEBUG(22373,
+                    2,
+                    "No new oplog entries became visible.",
+                    "aNoHolesOplogTimestamp"_attr = Timestamp(newTimestamp));
+        return false;
     }
+
+    {
+        stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+        // Publish the new timestamp value. Avoid going backward.
+        auto currentVisibleTimestamp = getOplogReadTimestamp();
+        if (newTimestamp > currentVisibleTimestamp) {
+            _setOplogReadTimestamp(lk, newTimestamp);
+        }
+    }
+
+    // Wake up any awaitData cursors and tell them more data might be visible now.
+    //
+    // We normally notify waiters on capped collection inserts/updates, but oplog entries will
+    // not become visible immediately upon insert, so we notify waiters here as well, when new
+    // oplog entries actually become visible to cursors.
+    oplogRecordStore->notifyCappedWaitersIfNeeded();
+    return true;
 }
 
 void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
@@ -150,10 +227,11 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     invariant(_opsWaitingForOplogVisibilityUpdate > 0);
     auto exitGuard = makeGuard([&] { --_opsWaitingForOplogVisibilityUpdate; });
 
-    // Out of order writes to the oplog always call triggerOplogVisibilityUpdate() on commit to
-    // prompt the OplogVisibilityThread to run and update the oplog visibility. We simply need to
-    // wait until all of the writes behind and including 'waitingFor' commit so there are no oplog
-    // holes.
+    // Out of order writes to the oplog always call triggerOplogVisibilityUpdate() on commit, which
+    // updates the oplog visibility inline while we are registered as a waiter. Writes that
+    // committed before we registered prompted the OplogVisibilityThread, which stops delaying its
+    // update now that there is a waiter. We simply need to wait until all of the writes behind and
+    // including 'waitingFor' commit so there are no oplog holes.
     opCtx->waitForConditionOrInterrupt(_oplogEntriesBecameVisibleCV, lk, [&] {
         auto newLatestVisibleTimestamp = getOplogReadTimestamp();
         if (newLatestVisibleTimestamp < currentLatestVisibleTimestamp) {
@@ -233,35 +311,7 @@ void WiredTigerOplogManager::_updateOplogVisibilityLoop(WiredTigerSessionCache*
 
         lk.unlock();
 
-        // Fetch the all_durable timestamp from the storage engine, which is guaranteed not to have
-        // any holes behind it in-memory.
-        const uint64_t newTimestamp = sessionCache->getKVEngine()->getAllDurableTimestamp().asULL();
-
-        // The newTimestamp may actually go backward during secondary batch application,
-        // where we commit data file changes separately from oplog changes, so ignore
-        // a non-incrementing timestamp.
-        if (newTimestamp <= _oplogReadTimestamp.load()) {
-            LOGV2_DEBUG(22373,
-                        2,
-                        "No new oplog entries became visible.",
-                        "aNoHolesOplogTimestamp"_attr = Timestamp(newTimestamp));
-            continue;
-        }
-
-        lk.lock();
-        // Publish the new timestamp value. Avoid going backward.
-        auto currentVisibleTimestamp = getOplogReadTimestamp();
-        if (newTimestamp > currentVisibleTimestamp) {
-            _setOplogReadTimestamp(lk, newTimestamp);
-        }
-        lk.unlock();
-
-        // Wake up any awaitData cursors and tell them more data might be visible now.
-        //
-        // We normally notify waiters on capped collection inserts/updates, but oplog entries will
-        // not become visible immediately upon insert, so we notify waiters here as well, when new
-        // oplog entries actually become visible to cursors.
-        oplogRecordStore->notifyCappedWaitersIfNeeded();
+        _updateOplogReadTimestamp(sessionCache, oplogRecordStore);
     }
 }
 
@@ -44,7 +44,9 @@ class WiredTigerSessionCache;
  * Manages oplog visibility.
  *
  * On demand, queries WiredTiger's all_durable timestamp value and updates the oplog read timestamp.
- * This is done asynchronously on a thread that startVisibilityThread() will set up.
+ * When readers are waiting for oplog entries to become visible, this is done inline by the writer
+ * whose commit prompted the update. Otherwise it is done asynchronously, and batched, on a thread
+ * that startVisibilityThread() will set up.
  *
  * The WT all_durable timestamp is the in-memory timestamp behind which there are no oplog holes
  * in-memory. Note, all_durable is the timestamp that has no holes in-memory, which may NOT be
@@ -75,7 +77,8 @@ public:
     }
 
     /**
-     * Signals the oplog visibility thread to update the oplog read timestamp.
+     * Updates the oplog read timestamp on the calling thread if any readers are waiting for more of
+     * the oplog to become visible, otherwise signals the oplog visibility thread to do so.
      */
     void triggerOplogVisibilityUpdate();
 
@@ -106,6 +109,20 @@ private:
     void _updateOplogVisibilityLoop(WiredTigerSessionCache* sessionCache,
                                     WiredTigerRecordStore* oplogRecordStore);
 
+    /**
+     * Advances the oplog read timestamp to the all_durable timestamp and wakes any awaitData
+     * cursors if new oplog entries became visible. Returns whether the timestamp moved forward.
+     */
+    bool _updateOplogReadTimestamp(WiredTigerSessionCache* sessionCache,
+                                   WiredTigerRecordStore* oplogRecordStore);
+
+    /**
+     * Called by committing writers when readers are waiting on oplog visibility. Only one writer
+     * queries the all_durable timestamp at a time; a writer that finds an update in progress
+     * leaves a request for the running one to update again once it is done.
+     */
+    void _updateOplogReadTimestampInline();
+
     void _setOplogReadTimestamp(WithLock, uint64_t newTimestamp);
 
     AtomicWord<unsigned long long> _oplogReadTimestamp{0};
@@ -125,6 +142,20 @@ private:
     bool _isRunning = false;
     bool _shuttingDown = false;
 
+    // Set while the visibility thread is running. Used by writers updating visibility inline.
+    WiredTigerSessionCache* _sessionCache = nullptr;
+    WiredTigerRecordStore* _oplogRecordStore = nullptr;
+
+    // Number of writers currently updating oplog visibility inline. haltVisibilityThread() waits
+    // for this to drop to zero before the oplog record store can go away.
+    int64_t _inlineVisibilityUpdaters = 0;
+    stdx::condition_variable _inlineVisibilityUpdatersCV;
+
+    // Hand-off between writers updating oplog visibility inline, see
+    // _updateOplogReadTimestampInline().
+    AtomicWord<bool> _inlineVisibilityUpdateInProgress{false};
+    AtomicWord<bool> _inlineVisibilityUpdateRequested{false};
+
     // Triggers an oplog visibility update -- can be delayed if no callers are waiting for an
     // update, per the _opsWaitingForOplogVisibility counter.
     bool _triggerOplogVisibilityUpdate = false;
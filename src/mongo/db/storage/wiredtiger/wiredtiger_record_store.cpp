@@ -38,6 +38,8 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 
+#include <algorithm>
+#include <map>
 #include <memory>
 
 #include "mongo/base/checked_cast.h"
@@ -60,8 +62,10 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -107,6 +111,9 @@ MONGO_STATIC_ASSERT(kCurrentRecordStoreVersion <= kMaximumRecordStoreVersion);
 
 const double kNumMSInHour = 1000 * 60 * 60;
 
+// Suffix appended to the oplog's URI to form the size storer key of its persisted oplog stones.
+constexpr StringData kPersistedOplogStonesKeySuffix = "?oplogStones"_sd;
+
 void checkOplogFormatVersion(OperationContext* opCtx, const std::string& uri) {
     StatusWith<BSONObj> appMetadata = WiredTigerUtil::getApplicationMetadata(opCtx, uri);
     fassert(39999, appMetadata);
@@ -157,6 +164,7 @@ public:
 
         _oplogStones->_currentRecords.addAndFetch(_countInserted);
         int64_t newCurrentBytes = _oplogStones->_currentBytes.addAndFetch(_bytesInserted);
+        _oplogStones->_advanceLastRecord(_recordId);
         if (_wall != Date_t() && newCurrentBytes >= _oplogStones->_minBytesPerStone) {
             // When other InsertChanges commit concurrently, an uninitialized wallTime may delay the
             // creation of a new stone. This delay is limited to the number of concurrently running
@@ -186,6 +194,8 @@ public:
 
         stdx::lock_guard<Latch> lk(_oplogStones->_mutex);
         _oplogStones->_stones.clear();
+        _oplogStones->_lastRecord.store(0);
+        _oplogStones->_persistStones_inlock();
     }
 
     void rollback() final {}
@@ -219,6 +229,7 @@ WiredTigerRecordStore::OplogStones::OplogStones(OperationContext* opCtx, WiredTi
     invariant(_minBytesPerStone > 0);
 
     _calculateStones(opCtx, numStonesToKeep);
+    _persistStones_inlock();
     _pokeReclaimThreadIfNeeded();  // Reclaim stones if over the limit.
 }
 
@@ -309,6 +320,7 @@ WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
 void WiredTigerRecordStore::OplogStones::popOldestStone() {
     stdx::lock_guard<Latch> lk(_mutex);
     _stones.pop_front();
+    _persistStones_inlock();
 }
 
 void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(OperationContext* opCtx,
@@ -358,6 +370,7 @@ void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(OperationContext
                 "wallTime"_attr = stone.wallTime,
                 "numStones"_attr = _stones.size());
 
+    _persistStones_inlock();
     _pokeReclaimThreadIfNeeded();
 }
 
@@ -401,6 +414,10 @@ void WiredTigerRecordStore::OplogStones::updateStonesAfterCappedTruncateAfter(
     // being filled.
     _currentRecords.addAndFetch(recordsInStonesToRemove - recordsRemoved);
     _currentBytes.addAndFetch(bytesInStonesToRemove - bytesRemoved);
+
+    _lastRecord.store(
+        std::min(_lastRecord.load(), static_cast<long long>(firstRemovedId.getLong() - 1)));
+    _persistStones_inlock();
 }
 
 void WiredTigerRecordStore::OplogStones::setMinBytesPerStone(int64_t size) {
@@ -442,6 +459,10 @@ void WiredTigerRecordStore::OplogStones::_calculateStones(OperationContext* opCt
         return;
     }
 
+    if (_loadPersistedStones(opCtx)) {
+        return;
+    }
+
     // Only use sampling to estimate where to place the oplog stones if the number of samples drawn
     // is less than 5% of the collection.
     const uint64_t kMinSampleRatioForRandCursor = 20;
@@ -473,20 +494,7 @@ void WiredTigerRecordStore::OplogStones::_calculateStonesByScanning(OperationCon
 
     auto cursor = _rs->getCursor(opCtx, true);
     while (auto record = cursor->next()) {
-        _currentRecords.addAndFetch(1);
-        int64_t newCurrentBytes = _currentBytes.addAndFetch(record->data.size());
-        if (newCurrentBytes >= _minBytesPerStone) {
-            BSONObj obj = record->data.toBson();
-            auto wallTime = obj.hasField("wall") ? obj["wall"].Date() : obj["ts"].timestampTime();
-
-            LOGV2_DEBUG(22385,
-                        1,
-                        "Marking oplog entry as a potential future oplog truncation point",
-                        "wall"_attr = wallTime);
-
-            _stones.emplace_back(
-                _currentRecords.swap(0), _currentBytes.swap(0), record->id, wallTime);
-        }
+        _accountForRecord(*record);
 
         numRecords++;
         dataSize += record->data.size();
@@ -495,6 +503,140 @@ void WiredTigerRecordStore::OplogStones::_calculateStonesByScanning(OperationCon
     _rs->updateStatsAfterRepair(opCtx, numRecords, dataSize);
 }
 
+void WiredTigerRecordStore::OplogStones::_accountForRecord(const Record& record) {
+    _currentRecords.addAndFetch(1);
+    int64_t newCurrentBytes = _currentBytes.addAndFetch(record.data.size());
+    if (newCurrentBytes >= _minBytesPerStone) {
+        BSONObj obj = record.data.toBson();
+        auto wallTime = obj.hasField("wall") ? obj["wall"].Date() : obj["ts"].timestampTime();
+
+        LOGV2_DEBUG(22385,
+                    1,
+                    "Marking oplog entry as a potential future oplog truncation point",
+                    "wall"_attr = wallTime);
+
+        _stones.emplace_back(_currentRecords.swap(0), _currentBytes.swap(0), record.id, wallTime);
+    }
+    _advanceLastRecord(record.id);
+}
+
+bool WiredTigerRecordStore::OplogStones::_loadPersistedStones(OperationContext* opCtx) {
+    if (!_rs->_sizeStorer || !gPersistOplogTruncationPoints) {
+        return false;
+    }
+
+    BSONObj persisted = _rs->_sizeStorer->loadMetadata(_persistedStonesKey());
+    if (persisted.isEmpty()) {
+        return false;
+    }
+
+    auto fallBack = [&](StringData reason) {
+        LOGV2(6000132,
+              "Ignoring the persisted oplog truncation points",
+              "reason"_attr = reason,
+              "persisted"_attr = redact(persisted));
+        _stones.clear();
+        _currentRecords.store(0);
+        _currentBytes.store(0);
+        _lastRecord.store(0);
+        return false;
+    };
+
+    RecordId lastRecord;
+    try {
+        for (auto&& elem : persisted["stones"].Obj()) {
+            BSONObj stone = elem.Obj();
+            RecordId stoneLastRecord(stone["lastRecord"].Long());
+            if (!_stones.empty() && stoneLastRecord <= _stones.back().lastRecord) {
+                return fallBack("Truncation points are out of order");
+            }
+            _stones.emplace_back(stone["records"].Long(),
+                                 stone["bytes"].Long(),
+                                 stoneLastRecord,
+                                 stone["wallTime"].Date());
+        }
+        _currentRecords.store(persisted["currentRecords"].Long());
+        _currentBytes.store(persisted["currentBytes"].Long());
+        lastRecord = RecordId(persisted["lastRecord"].Long());
+    } catch (const DBException& ex) {
+        return fallBack(ex.reason());
+    }
+
+    if (!_stones.empty() && _stones.back().lastRecord > lastRecord) {
+        return fallBack("Truncation points are past the last record accounted for");
+    }
+
+    auto newest = _rs->getCursor(opCtx, /*forward=*/false)->next();
+    if (!newest || newest->id < lastRecord) {
+        // The oplog lost entries since the stones were persisted, and no longer contains the
+        // records they were computed from.
+        return fallBack("Truncation points are past the end of the oplog");
+    }
+
+    // Stones that end before the start of the oplog were truncated after being persisted.
+    auto oldest = _rs->getCursor(opCtx, /*forward=*/true)->next();
+    invariant(oldest);
+    while (!_stones.empty() && _stones.front().lastRecord < oldest->id) {
+        _stones.pop_front();
+    }
+
+    // Account for the records inserted after the stones were persisted.
+    int64_t numTailRecords = 0;
+    _lastRecord.store(lastRecord.getLong());
+    auto cursor = _rs->getCursor(opCtx, /*forward=*/true);
+    for (auto record = cursor->seekNear(lastRecord); record; record = cursor->next()) {
+        if (record->id <= lastRecord) {
+            continue;
+        }
+        _accountForRecord(*record);
+        ++numTailRecords;
+    }
+
+    _processBySampling.store(false);
+    _loadedPersistedStones.store(true);
+    LOGV2(6000133,
+          "Loaded the persisted oplog truncation points",
+          "numStones"_attr = _stones.size(),
+          "lastRecord"_attr = lastRecord,
+          "numRecordsScanned"_attr = numTailRecords);
+    return true;
+}
+
+void WiredTigerRecordStore::OplogStones::_advanceLastRecord(const RecordId& id) {
+    auto current = _lastRecord.load();
+    while (current < id.getLong() && !_lastRecord.compareAndSwap(&current, id.getLong())) {
+    }
+}
+
+void WiredTigerRecordStore::OplogStones::persistStones() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _persistStones_inlock();
+}
+
+void WiredTigerRecordStore::OplogStones::_persistStones_inlock() {
+    if (!_rs->_sizeStorer || !gPersistOplogTruncationPoints) {
+        return;
+    }
+
+    BSONObjBuilder builder;
+    {
+        BSONArrayBuilder stonesBuilder(builder.subarrayStart("stones"));
+        for (auto&& stone : _stones) {
+            stonesBuilder.append(BSON("records" << stone.records << "bytes" << stone.bytes
+                                                << "lastRecord" << stone.lastRecord.getLong()
+                                                << "wallTime" << stone.wallTime));
+        }
+    }
+    builder.append("currentRecords", _currentRecords.load());
+    builder.append("currentBytes", _currentBytes.load());
+    builder.append("lastRecord", _lastRecord.load());
+    _rs->_sizeStorer->storeMetadata(_persistedStonesKey(), builder.obj());
+}
+
+std::string WiredTigerRecordStore::OplogStones::_persistedStonesKey() const {
+    return _rs->getURI() + kPersistedOplogStonesKeySuffix.toString();
+}
+
 void WiredTigerRecordStore::OplogStones::_calculateStonesBySampling(OperationContext* opCtx,
                                                                     int64_t estRecordsPerStone,
                                                                     int64_t estBytesPerStone) {
@@ -531,6 +673,7 @@ void WiredTigerRecordStore::OplogStones::_calculateStonesBySampling(OperationCon
             return;
         }
         latestOpTime = Timestamp(record->id.getLong());
+        _advanceLastRecord(record->id);
     }
 
     LOGV2(22389,
@@ -833,6 +976,63 @@ StatusWith<std::string> WiredTigerRecordStore::generateCreateString(
     return StatusWith<std::string>(ss);
 }
 
+/**
+ * Makes inserts into a capped collection which the caller does not serialize commit in RecordId
+ * order, so that every snapshot, and therefore every forward cursor, sees a prefix of the
+ * collection just as if the inserts were serialized.
+ *
+ * Before committing, a WriteUnitOfWork waits until no other WriteUnitOfWork holds uncommitted
+ * RecordIds lower than its own. Each insert reserves its RecordIds as one contiguous range, so this
+ * holds for all WriteUnitOfWorks which insert into the collection once. One which inserts into it
+ * several times only waits for RecordIds lower than its first range, as waiting for those below
+ * its later ranges could deadlock with the WriteUnitOfWorks reserving RecordIds in between.
+ */
+class WiredTigerRecordStore::CappedInsertOrder {
+public:
+    /**
+     * Registers the range of RecordIds starting at 'first' as reserved by the WriteUnitOfWork of
+     * 'opCtx' until it commits or rolls back.
+     */
+    void registerRange(OperationContext* opCtx, const RecordId& first) {
+        auto ru = opCtx->recoveryUnit();
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            const bool alreadyRegistered =
+                std::any_of(_uncommitted.begin(), _uncommitted.end(), [&](const auto& range) {
+                    return range.second == ru;
+                });
+            _uncommitted.emplace(first, ru);
+            if (alreadyRegistered) {
+                return;
+            }
+        }
+
+        ru->registerPreCommitHook([this, ru](OperationContext* opCtx) {
+            stdx::unique_lock<Latch> lk(_mutex);
+            opCtx->waitForConditionOrInterrupt(
+                _cv, lk, [&] { return _uncommitted.begin()->second == ru; });
+        });
+        ru->onCommit([this, ru](boost::optional<Timestamp>) { _finish(ru); });
+        ru->onRollback([this, ru] { _finish(ru); });
+    }
+
+private:
+    void _finish(RecoveryUnit* ru) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (auto it = _uncommitted.begin(); it != _uncommitted.end();) {
+            it = it->second == ru ? _uncommitted.erase(it) : std::next(it);
+        }
+        _cv.notify_all();
+    }
+
+    Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerRecordStore::CappedInsertOrder::_mutex");
+    stdx::condition_variable _cv;
+
+    // The first RecordId of each range reserved by a WriteUnitOfWork which has not committed or
+    // rolled back yet, and the recovery unit of that WriteUnitOfWork.
+    std::map<RecordId, RecoveryUnit*> _uncommitted;
+};
+
 WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
                                              OperationContext* ctx,
                                              Params params)
@@ -880,6 +1080,11 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
         uassertStatusOK(WiredTigerUtil::setTableLogging(ctx, _uri, _isLogged));
     }
 
+    if (_isCapped && !_isOplog && _keyFormat == KeyFormat::Long &&
+        gCappedCollectionConcurrentInserts) {
+        _cappedInsertOrder = std::make_unique<CappedInsertOrder>();
+    }
+
     if (_isOplog) {
         invariant(_keyFormat == KeyFormat::Long);
         checkOplogFormatVersion(ctx, _uri);
@@ -913,6 +1118,7 @@ WiredTigerRecordStore::~WiredTigerRecordStore() {
     }
 
     if (_oplogStones) {
+        _oplogStones->persistStones();
         _oplogStones->kill();
     }
 
@@ -1275,6 +1481,21 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
     invariant(nRecords != 0);
 
     if (_keyFormat == KeyFormat::Long) {
+        // Reserve the RecordIds this insert generates as one contiguous range, so that concurrent
+        // inserts into a capped collection can be ordered against each other as a whole.
+        const auto numIdsToReserve = _isOplog
+            ? 0
+            : std::count_if(records, records + nRecords, [](const auto& record) {
+                  return record.id.isNull();
+              });
+        int64_t nextId = 0;
+        if (numIdsToReserve > 0) {
+            nextId = _nextId(opCtx, numIdsToReserve).getLong();
+            if (_cappedInsertOrder && opCtx->lockState()->inAWriteUnitOfWork()) {
+                _cappedInsertOrder->registerRange(opCtx, RecordId(nextId));
+            }
+        }
+
         // Non-clustered record stores will extract the RecordId key for the oplog and generate
         // unique int64_t RecordIds if RecordIds are not set.
         for (size_t i = 0; i < nRecords; i++) {
@@ -1289,7 +1510,7 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
                 // Some RecordStores, like TemporaryRecordStores, may want to set their own
                 // RecordIds.
                 if (record.id.isNull()) {
-                    record.id = _nextId(opCtx);
+                    record.id = RecordId(nextId++);
                 }
             }
             dassert(record.id > highestIdRecord.id);
@@ -1605,7 +1826,9 @@ Status WiredTigerRecordStore::compact(OperationContext* opCtx) {
     if (!cache->isEphemeral()) {
         WT_SESSION* s = WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession();
         opCtx->recoveryUnit()->abandonSnapshot();
-        int ret = s->compact(s, getURI().c_str(), "timeout=0");
+        const auto timeSliceSecs = gWiredTigerCompactTimeSliceSecs.load();
+        const std::string config = str::stream() << "timeout=" << timeSliceSecs;
+        int ret = s->compact(s, getURI().c_str(), config.c_str());
         if (MONGO_unlikely(WTCompactRecordStoreEBUSY.shouldFail())) {
             ret = EBUSY;
         }
@@ -1615,6 +1838,11 @@ Status WiredTigerRecordStore::compact(OperationContext* opCtx) {
                           str::stream() << "Compaction interrupted on " << getURI().c_str()
                                         << " due to cache eviction pressure");
         }
+        if (ret == ETIMEDOUT) {
+            return Status(ErrorCodes::ExceededTimeLimit,
+                          str::stream() << "Compaction of " << getURI().c_str() << " stopped after its "
+                                        << timeSliceSecs << " second time slice");
+        }
         invariantWTOK(ret);
     }
     return Status::OK();
@@ -1777,14 +2005,16 @@ void WiredTigerRecordStore::_initNextIdIfNeeded(OperationContext* opCtx) {
     _nextIdNum.store(nextId);
 }
 
-RecordId WiredTigerRecordStore::_nextId(OperationContext* opCtx) {
+RecordId WiredTigerRecordStore::_nextId(OperationContext* opCtx, int64_t count) {
     // Clustered record stores do not generate unique ObjectId's for RecordId's as the expectation
     // is for the caller to set the RecordId using the server generated ObjectId.
     invariant(_keyFormat == KeyFormat::Long);
     invariant(!_isOplog);
+    invariant(count > 0);
     _initNextIdIfNeeded(opCtx);
-    RecordId out = RecordId(_nextIdNum.fetchAndAdd(1));
+    RecordId out = RecordId(_nextIdNum.fetchAndAdd(count));
     invariant(out.isValid());
+    invariant(RecordId(out.getLong() + count - 1).isValid());
     return out;
 }
 
@@ -281,13 +281,17 @@ private:
 
     class NumRecordsChange;
     class DataSizeChange;
+    class CappedInsertOrder;
 
     Status _insertRecords(OperationContext* opCtx,
                           Record* records,
                           const Timestamp* timestamps,
                           size_t nRecords);
 
-    RecordId _nextId(OperationContext* opCtx);
+    /**
+     * Reserves 'count' contiguous RecordIds and returns the first of them.
+     */
+    RecordId _nextId(OperationContext* opCtx, int64_t count = 1);
     RecordData _getData(const WiredTigerCursor& cursor) const;
 
 
@@ -351,6 +355,10 @@ private:
     mutable Mutex _initNextIdMutex = MONGO_MAKE_LATCH("WiredTigerRecordStore::_initNextIdMutex");
     AtomicWord<long long> _nextIdNum{0};
 
+    // Non-null if this record store is capped, is not the oplog and its inserts are not serialized
+    // by the caller. Makes those inserts commit in RecordId order.
+    std::unique_ptr<CappedInsertOrder> _cappedInsertOrder;
+
     WiredTigerSizeStorer* _sizeStorer;  // not owned, can be NULL
     std::shared_ptr<WiredTigerSizeStorer::SizeInfo> _sizeInfo;
     bool _tracksSizeAdjustments;
@@ -67,7 +67,10 @@ public:
 
     void getOplogStonesStats(BSONObjBuilder& builder) const {
         builder.append("totalTimeProcessingMicros", _totalTimeProcessing.load());
-        builder.append("processingMethod", _processBySampling.load() ? "sampling" : "scanning");
+        builder.append("processingMethod",
+                       _loadedPersistedStones.load()
+                           ? "persisted"
+                           : (_processBySampling.load() ? "sampling" : "scanning"));
         if (auto oplogMinRetentionHours = storageGlobalParams.oplogMinRetentionHours.load()) {
             builder.append("oplogMinRetentionHours", oplogMinRetentionHours);
         }
@@ -94,6 +97,10 @@ public:
     // Resize oplog size
     void adjust(int64_t maxSize);
 
+    // Buffers the current stones in the size storer, to be written out by its next flush, so that
+    // they do not need to be recomputed on the next startup. A no-op without a size storer.
+    void persistStones();
+
     // The start point of where to truncate next. Used by the background reclaim thread to
     // efficiently truncate records with WiredTiger by skipping over tombstones, etc.
     RecordId firstRecord;
@@ -121,6 +128,10 @@ public:
         return _processBySampling.load();
     }
 
+    bool loadedPersistedStones() const {
+        return _loadedPersistedStones.load();
+    }
+
 private:
     class InsertChange;
     class TruncateChange;
@@ -131,6 +142,21 @@ private:
                                     int64_t estRecordsPerStone,
                                     int64_t estBytesPerStone);
 
+    // Restores the stones last persisted in the size storer and accounts for the records inserted
+    // after they were persisted. Returns false, leaving the stones empty, if nothing was persisted
+    // or if the persisted stones do not match the contents of the oplog.
+    bool _loadPersistedStones(OperationContext* opCtx);
+
+    // Adds 'record' to the stone being filled, creating a new stone once it is large enough.
+    void _accountForRecord(const Record& record);
+
+    // Raises '_lastRecord' to 'id' unless it is already at or past it.
+    void _advanceLastRecord(const RecordId& id);
+
+    void _persistStones_inlock();
+
+    std::string _persistedStonesKey() const;
+
     void _pokeReclaimThreadIfNeeded();
 
     static const uint64_t kRandomSamplesPerStone = 10;
@@ -153,6 +179,12 @@ private:
     AtomicWord<int64_t> _totalTimeProcessing;  // Amount of time spent scanning and/or sampling the
                                                // oplog during start up, if any.
     AtomicWord<bool> _processBySampling;       // Whether the oplog was sampled or scanned.
+    AtomicWord<bool> _loadedPersistedStones;   // Whether the stones were loaded from disk.
+
+    // Highest RecordId whose size has been accounted for in either '_stones' or the stone being
+    // filled. Persisted along with the stones so that only the records after it need to be scanned
+    // when the stones are loaded at startup.
+    AtomicWord<long long> _lastRecord;
 
     // Protects against concurrent access to the deque of oplog stones.
     mutable Mutex _mutex = MONGO_MAKE_LATCH("OplogStones::_mutex");
@@ -916,6 +916,62 @@ TEST(WiredTigerRecordStoreTest, OplogStones_Duplicates) {
     }
 }
 
+// Ensure that oplog stones persisted in the size storer are restored on the next startup, and that
+// only the records inserted after they were persisted are accounted for again.
+TEST(WiredTigerRecordStoreTest, OplogStones_LoadPersistedStones) {
+    std::unique_ptr<RecordStoreHarnessHelper> harnessHelper = newRecordStoreHarnessHelper();
+    auto wtHarnessHelper = dynamic_cast<WiredTigerHarnessHelper*>(harnessHelper.get());
+    WiredTigerSizeStorer sizeStorer(wtHarnessHelper->conn(),
+                                    WiredTigerKVEngine::kTableUriPrefix + "sizeStorer");
+    ON_BLOCK_EXIT([&] { sizeStorer.flush(false); });
+
+    {
+        std::unique_ptr<RecordStore> rs(wtHarnessHelper->newOplogRecordStoreNoInit(&sizeStorer));
+        WiredTigerRecordStore* wtrs = static_cast<WiredTigerRecordStore*>(rs.get());
+
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        wtrs->postConstructorInit(opCtx.get());
+
+        WiredTigerRecordStore::OplogStones* oplogStones = wtrs->oplogStones();
+        ASSERT_FALSE(oplogStones->loadedPersistedStones());
+        oplogStones->setMinBytesPerStone(100);
+
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 1), 100), RecordId(1, 1));
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 2), 100), RecordId(1, 2));
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 3), 50), RecordId(1, 3));
+        ASSERT_EQ(2U, oplogStones->numStones());
+        ASSERT_EQ(1, oplogStones->currentRecords());
+        ASSERT_EQ(50, oplogStones->currentBytes());
+
+        // Destroying the record store persists the stone being filled.
+    }
+
+    std::unique_ptr<RecordStore> rs(wtHarnessHelper->newOplogRecordStoreNoInit(&sizeStorer));
+    WiredTigerRecordStore* wtrs = static_cast<WiredTigerRecordStore*>(rs.get());
+
+    {
+        // Insert a record that the persisted stones do not know about before initializing the
+        // stones.
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 4), 60), RecordId(1, 4));
+    }
+
+    auto wtKvEngine = dynamic_cast<WiredTigerKVEngine*>(harnessHelper->getEngine());
+    wtKvEngine->getOplogManager()->setOplogReadTimestamp(Timestamp(1, 4));
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        wtrs->postConstructorInit(opCtx.get());
+    }
+
+    WiredTigerRecordStore::OplogStones* oplogStones = wtrs->oplogStones();
+    ASSERT(oplogStones->loadedPersistedStones());
+    ASSERT_FALSE(oplogStones->processedBySampling());
+    ASSERT_EQ(2U, oplogStones->numStones());
+    ASSERT_EQ(2, oplogStones->currentRecords());
+    ASSERT_EQ(110, oplogStones->currentBytes());
+}
+
 TEST(WiredTigerRecordStoreTest, GetLatestOplogTest) {
     unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newOplogRecordStore());
@@ -63,9 +63,11 @@ public:
     std::unique_ptr<RecoveryUnit> newRecoveryUnit();
 
     /**
-     * Create an oplog record store without calling postConstructorInit().
+     * Create an oplog record store without calling postConstructorInit(). The record store keeps
+     * its size information in 'sizeStorer', if provided.
      */
-    std::unique_ptr<RecordStore> newOplogRecordStoreNoInit();
+    std::unique_ptr<RecordStore> newOplogRecordStoreNoInit(
+        WiredTigerSizeStorer* sizeStorer = nullptr);
 
     WT_CONNECTION* conn() {
         return _engine.getConnection();
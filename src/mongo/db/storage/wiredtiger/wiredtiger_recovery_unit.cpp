@@ -177,6 +177,7 @@ void WiredTigerRecoveryUnit::_commit() {
     auto commitTime = _commitTimestamp.isNull() ? _lastTimestampSet : _commitTimestamp;
 
     bool notifyDone = !_prepareTimestamp.isNull();
+    const auto preparedId = _preparedUnitOfWorkId;
     if (_session && _isActive()) {
         _txnClose(true);
     }
@@ -187,7 +188,7 @@ void WiredTigerRecoveryUnit::_commit() {
     }
 
     if (notifyDone) {
-        _sessionCache->notifyPreparedUnitOfWorkHasCommittedOrAborted();
+        _sessionCache->notifyPreparedUnitOfWorkHasCommittedOrAborted(preparedId);
     }
 
     commitRegisteredChanges(commitTime);
@@ -196,13 +197,14 @@ void WiredTigerRecoveryUnit::_commit() {
 
 void WiredTigerRecoveryUnit::_abort() {
     bool notifyDone = !_prepareTimestamp.isNull();
+    const auto preparedId = _preparedUnitOfWorkId;
     if (_session && _isActive()) {
         _txnClose(false);
     }
     _setState(State::kAborting);
 
     if (notifyDone || MONGO_unlikely(WTAlwaysNotifyPrepareConflictWaiters.shouldFail())) {
-        _sessionCache->notifyPreparedUnitOfWorkHasCommittedOrAborted();
+        _sessionCache->notifyPreparedUnitOfWorkHasCommittedOrAborted(preparedId);
     }
 
     abortRegisteredChanges();
@@ -231,6 +233,9 @@ void WiredTigerRecoveryUnit::prepareUnitOfWork() {
                 "prepareTimestamp"_attr = _prepareTimestamp);
 
     const std::string conf = "prepare_timestamp=" + unsignedHex(_prepareTimestamp.asULL());
+    // Take the id before preparing, so that any operation that conflicts with this transaction
+    // sees an id at least as large.
+    _preparedUnitOfWorkId = _sessionCache->newPreparedUnitOfWorkId();
     // Prepare the transaction.
     invariantWTOK(s->prepare_transaction(s, conf.c_str()));
 }
@@ -487,6 +492,7 @@ void WiredTigerRecoveryUnit::_txnClose(bool commit) {
     _lastTimestampSet = boost::none;
     _multiTimestampConstraintTracker = MultiTimestampConstraintTracker();
     _prepareTimestamp = Timestamp();
+    _preparedUnitOfWorkId = 0;
     _durableTimestamp = Timestamp();
     _catalogConflictTimestamp = Timestamp();
     _roundUpPreparedTimestamps = RoundUpPreparedTimestamps::kNoRound;
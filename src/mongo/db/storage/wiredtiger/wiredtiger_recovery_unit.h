@@ -296,6 +296,8 @@ private:
     Timestamp _commitTimestamp;
     Timestamp _durableTimestamp;
     Timestamp _prepareTimestamp;
+    // Set by prepareUnitOfWork() from WiredTigerSessionCache::newPreparedUnitOfWorkId().
+    std::uint64_t _preparedUnitOfWorkId = 0;
     boost::optional<Timestamp> _lastTimestampSet;
     Timestamp _readAtTimestamp;
     Timestamp _catalogConflictTimestamp;
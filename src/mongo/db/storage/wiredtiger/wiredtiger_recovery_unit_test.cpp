@@ -39,10 +39,12 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 namespace {
@@ -314,6 +316,35 @@ TEST_F(WiredTigerRecoveryUnitTestFixture,
     ru2->abortUnitOfWork();
 }
 
+TEST_F(WiredTigerRecoveryUnitTestFixture, PrepareConflictWaiterIgnoresLaterPreparedUnitsOfWork) {
+    auto sessionCache = ru1->getSessionCache();
+    auto opCtx = clientAndCtx2.second.get();
+
+    // The waiter conflicts with a unit of work prepared before it starts waiting.
+    const auto earlierId = sessionCache->newPreparedUnitOfWorkId();
+    const auto lastCount = sessionCache->getPrepareCommitOrAbortCount();
+    AtomicWord<bool> woken{false};
+    stdx::thread waiter([&] {
+        sessionCache->waitUntilPreparedUnitOfWorkCommitsOrAborts(opCtx, lastCount);
+        woken.store(true);
+    });
+    while (sessionCache->getNumPrepareConflictWaitersForTest() == 0) {
+        sleepmillis(1);
+    }
+
+    // Ending a unit of work prepared after the waiter hit its conflict does not wake it.
+    const auto laterId = sessionCache->newPreparedUnitOfWorkId();
+    sessionCache->notifyPreparedUnitOfWorkHasCommittedOrAborted(laterId);
+    sleepmillis(50);
+    ASSERT_FALSE(woken.load());
+    ASSERT_EQ(1U, sessionCache->getNumPrepareConflictWaitersForTest());
+
+    sessionCache->notifyPreparedUnitOfWorkHasCommittedOrAborted(earlierId);
+    waiter.join();
+    ASSERT_TRUE(woken.load());
+    ASSERT_EQ(0U, sessionCache->getNumPrepareConflictWaitersForTest());
+}
+
 TEST_F(WiredTigerRecoveryUnitTestFixture, WriteAllowedWhileIgnorePrepareFalse) {
     // Prepare but don't commit a transaction
     ru1->beginUnitOfWork(clientAndCtx1.second.get());
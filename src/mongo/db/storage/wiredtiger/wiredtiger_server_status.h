@@ -44,6 +44,7 @@ public:
     bool includeByDefault() const override;
     BSONObj generateSection(OperationContext* opCtx,
                             const BSONElement& configElement) const override;
+    Milliseconds getMaxStaleness() const override;
 
 private:
     WiredTigerKVEngine* _engine;
@@ -33,8 +33,13 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
+#include <algorithm>
 #include <memory>
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 #include "mongo/base/error_codes.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/global_settings.h"
@@ -45,6 +50,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -112,6 +118,10 @@ void _openCursor(WT_SESSION* session,
 }  // namespace
 
 WT_CURSOR* WiredTigerSession::getCachedCursor(uint64_t id, const std::string& config) {
+    if (gWiredTigerHotCursorsPerSession.loadRelaxed() > 0) {
+        ++_tableCursorRequests[id];
+    }
+
     // Find the most recently used cursor
     for (CursorCache::iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
         // Ensure that all properties of this cursor are identical to avoid mixing cursor
@@ -121,9 +131,11 @@ WT_CURSOR* WiredTigerSession::getCachedCursor(uint64_t id, const std::string& co
             WT_CURSOR* c = i->_cursor;
             _cursors.erase(i);
             _cursorsOut++;
+            _cursorCacheHits++;
             return c;
         }
     }
+    _cursorCacheMisses++;
     return nullptr;
 }
 
@@ -176,6 +188,45 @@ void WiredTigerSession::closeAllCursors(const std::string& uri) {
     }
 }
 
+void WiredTigerSession::closeColdCursors(size_t numHotTables) {
+    invariant(_session);
+
+    // Pick the most requested tables that currently have a cached cursor.
+    std::vector<std::pair<uint32_t, uint64_t>> candidates;
+    for (const auto& cached : _cursors) {
+        auto it = _tableCursorRequests.find(cached._id);
+        if (it != _tableCursorRequests.end() && it->second > 1) {
+            candidates.emplace_back(it->second, cached._id);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), std::greater<>());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    if (candidates.size() > numHotTables) {
+        candidates.resize(numHotTables);
+    }
+
+    for (auto i = _cursors.begin(); i != _cursors.end();) {
+        const bool hot = std::any_of(candidates.begin(), candidates.end(), [&](auto&& candidate) {
+            return candidate.second == i->_id;
+        });
+        if (hot) {
+            ++i;
+            continue;
+        }
+        invariantWTOK(i->_cursor->close(i->_cursor));
+        i = _cursors.erase(i);
+    }
+
+    for (auto it = _tableCursorRequests.begin(); it != _tableCursorRequests.end();) {
+        it->second /= 2;
+        if (it->second == 0) {
+            _tableCursorRequests.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void WiredTigerSession::closeCursorsForQueuedDrops(WiredTigerKVEngine* engine) {
     invariant(_session);
 
@@ -200,11 +251,26 @@ uint64_t WiredTigerSession::genTableId() {
 
 // -----------------------
 
+namespace {
+
+/**
+ * The idle session pool has one partition per available core, up to a limit past which the
+ * partitions would mostly hold sessions no thread checks out.
+ */
+size_t numSessionCachePartitions() {
+    constexpr size_t kMaxPartitions = 64;
+    return std::clamp<size_t>(ProcessInfo::getNumAvailableCores(), 1, kMaxPartitions);
+}
+
+}  // namespace
+
 WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
     : _engine(engine),
       _conn(engine->getConnection()),
       _clockSource(_engine->getClockSource()),
       _shuttingDown(0),
+      _numPartitions(numSessionCachePartitions()),
+      _partitions(std::make_unique<CacheAligned<SessionCachePartition>[]>(_numPartitions)),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource* cs)
@@ -212,6 +278,8 @@ WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource*
       _conn(conn),
       _clockSource(cs),
       _shuttingDown(0),
+      _numPartitions(numSessionCachePartitions()),
+      _partitions(std::make_unique<CacheAligned<SessionCachePartition>[]>(_numPartitions)),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
@@ -362,40 +430,69 @@ void WiredTigerSessionCache::waitUntilPreparedUnitOfWorkCommitsOrAborts(Operatio
                                                                         std::uint64_t lastCount) {
     invariant(opCtx);
     stdx::unique_lock<Latch> lk(_prepareCommittedOrAbortedMutex);
-    if (lastCount == _prepareCommitOrAbortCounter.loadRelaxed()) {
-        opCtx->waitForConditionOrInterrupt(_prepareCommittedOrAbortedCond, lk, [&] {
-            return _prepareCommitOrAbortCounter.loadRelaxed() > lastCount;
-        });
+    if (lastCount != _prepareCommitOrAbortCounter.loadRelaxed()) {
+        return;
     }
+
+    // Whatever this operation conflicted with was prepared before the conflict, so its id is no
+    // greater than the last one handed out by now.
+    PrepareConflictWaiter waiter{_lastPreparedUnitOfWorkId.load()};
+    auto it = _prepareConflictWaiters.insert(_prepareConflictWaiters.end(), &waiter);
+    ON_BLOCK_EXIT([&] { _prepareConflictWaiters.erase(it); });
+    opCtx->waitForConditionOrInterrupt(waiter.cond, lk, [&] { return waiter.notified; });
 }
 
-void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
+void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted(
+    std::uint64_t preparedId) {
     stdx::unique_lock<Latch> lk(_prepareCommittedOrAbortedMutex);
     _prepareCommitOrAbortCounter.fetchAndAdd(1);
-    _prepareCommittedOrAbortedCond.notify_all();
+    for (auto waiter : _prepareConflictWaiters) {
+        // A unit of work prepared after a waiter hit its conflict cannot be what it waits for.
+        if (!waiter->notified && waiter->lastPreparedId >= preparedId) {
+            waiter->notified = true;
+            waiter->cond.notify_one();
+        }
+    }
 }
 
 
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        auto& partition = _partitions[i];
+        stdx::lock_guard<Latch> lock(partition.mutex);
+        for (auto session : partition.sessions) {
+            session->closeAllCursors(uri);
+        }
     }
 }
 
+void WiredTigerSessionCache::appendCursorCacheStats(BSONObjBuilder* builder) const {
+    builder->append("hits", static_cast<long long>(_cursorCacheHits.load()));
+    builder->append("misses", static_cast<long long>(_cursorCacheMisses.load()));
+    builder->append("hotCursorsKept", static_cast<long long>(_hotCursorsKept.load()));
+}
+
 void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        auto& partition = _partitions[i];
+        stdx::lock_guard<Latch> lock(partition.mutex);
+        for (auto session : partition.sessions) {
+            session->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 size_t WiredTigerSessionCache::getIdleSessionsCount() {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    return _sessions.size();
+    size_t count = 0;
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        auto& partition = _partitions[i];
+        stdx::lock_guard<Latch> lock(partition.mutex);
+        count += partition.sessions.size();
+    }
+    return count;
 }
 
 void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
@@ -407,14 +504,15 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     auto cutoffTime = _clockSource->now() - Milliseconds(idleTimeMillis);
     SessionCache sessionsToClose;
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        auto& partition = _partitions[i];
+        stdx::lock_guard<Latch> lock(partition.mutex);
         // Discard all sessions that became idle before the cutoff time
-        for (auto it = _sessions.begin(); it != _sessions.end();) {
+        for (auto it = partition.sessions.begin(); it != partition.sessions.end();) {
             auto session = *it;
             invariant(session->getIdleExpireTime() != Date_t::min());
             if (session->getIdleExpireTime() < cutoffTime) {
-                it = _sessions.erase(it);
+                it = partition.sessions.erase(it);
                 sessionsToClose.push_back(session);
             } else {
                 ++it;
@@ -430,13 +528,17 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
 }
 
 void WiredTigerSessionCache::closeAll() {
-    // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+    // Increment the epoch as we are now closing all sessions with this epoch. This happens before
+    // any partition is emptied, so a session released into a partition after it was emptied sees
+    // the new epoch under the partition mutex and is closed instead of cached.
+    _epoch.fetchAndAdd(1);
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
+    SessionCache swap;
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        auto& partition = _partitions[i];
+        stdx::lock_guard<Latch> lock(partition.mutex);
+        swap.insert(swap.end(), partition.sessions.begin(), partition.sessions.end());
+        partition.sessions.clear();
     }
 
     for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
@@ -453,16 +555,32 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
+    auto takeCachedSession = [](SessionCache& sessions) {
+        // Get the most recently used session so that if we discard sessions, we're
+        // discarding older ones
+        WiredTigerSession* cachedSession = sessions.back();
+        sessions.pop_back();
+        // Reset the idle time
+        cachedSession->setIdleExpireTime(Date_t::min());
+        return UniqueWiredTigerSession(cachedSession);
+    };
+
+    const size_t home = _homePartitionIndex();
     {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        if (!_sessions.empty()) {
-            // Get the most recently used session so that if we discard sessions, we're
-            // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
-            // Reset the idle time
-            cachedSession->setIdleExpireTime(Date_t::min());
-            return UniqueWiredTigerSession(cachedSession);
+        auto& partition = _partitions[home];
+        stdx::lock_guard<Latch> lock(partition.mutex);
+        if (!partition.sessions.empty()) {
+            return takeCachedSession(partition.sessions);
+        }
+    }
+
+    // Take an idle session from another partition rather than opening a new one. Partitions busy
+    // with their own threads are skipped.
+    for (size_t offset = 1; offset < _numPartitions; ++offset) {
+        auto& partition = _partitions[(home + offset) % _numPartitions];
+        stdx::unique_lock<Latch> lock(partition.mutex, stdx::try_to_lock);
+        if (lock.owns_lock() && !partition.sessions.empty()) {
+            return takeCachedSession(partition.sessions);
         }
     }
 
@@ -499,13 +617,24 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
 
         // Release resources in the session we're about to cache.
         // If we are using hybrid caching, then close cursors now and let them
-        // be cached at the WiredTiger level.
+        // be cached at the WiredTiger level, except for the cursors of the session's hot tables
+        // if we are configured to keep those.
         if (gWiredTigerCursorCacheSize.load() < 0) {
-            session->closeAllCursors("");
+            const auto numHotTables = gWiredTigerHotCursorsPerSession.load();
+            if (numHotTables > 0) {
+                session->closeColdCursors(numHotTables);
+                _hotCursorsKept.fetchAndAdd(session->cachedCursors());
+            } else {
+                session->closeAllCursors("");
+                session->_tableCursorRequests.clear();
+            }
         }
         invariantWTOK(ss->reset(ss));
     }
 
+    _cursorCacheHits.fetchAndAdd(std::exchange(session->_cursorCacheHits, 0));
+    _cursorCacheMisses.fetchAndAdd(std::exchange(session->_cursorCacheMisses, 0));
+
     // If the cursor epoch has moved on, close all cursors in the session.
     uint64_t cursorEpoch = _cursorEpoch.load();
     if (session->_getCursorEpoch() != cursorEpoch)
@@ -521,10 +650,11 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->setIdleExpireTime(_clockSource->now());
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<Latch> lock(_cacheLock);
+        auto& partition = _partitions[_homePartitionIndex()];
+        stdx::lock_guard<Latch> lock(partition.mutex);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            partition.sessions.push_back(session);
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
@@ -537,6 +667,18 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
 }
 
 
+size_t WiredTigerSessionCache::_homePartitionIndex() const {
+#if defined(__linux__)
+    if (int cpu = sched_getcpu(); cpu >= 0) {
+        return static_cast<size_t>(cpu) % _numPartitions;
+    }
+#endif
+    // Without a CPU number, spread threads over the partitions in the order they first get here.
+    static AtomicWord<unsigned> nextThreadPartition{0};
+    thread_local const unsigned threadPartition = nextThreadPartition.fetchAndAdd(1);
+    return threadPartition % _numPartitions;
+}
+
 void WiredTigerSessionCache::setJournalListener(JournalListener* jl) {
     stdx::unique_lock<Latch> lk(_journalListenerMutex);
 
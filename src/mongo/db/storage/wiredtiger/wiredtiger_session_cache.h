@@ -30,7 +30,9 @@
 #pragma once
 
 #include <list>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <wiredtiger.h>
 
@@ -38,7 +40,9 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -140,6 +144,13 @@ public:
      */
     void closeAllCursors(const std::string& uri);
 
+    /**
+     * Closes all cached cursors except those of the 'numHotTables' tables whose cursors were
+     * requested most often on this session, then halves the request counts so that tables that
+     * are no longer used stop being kept. Only tables requested more than once are kept.
+     */
+    void closeColdCursors(size_t numHotTables);
+
     int cursorsOut() const {
         return _cursorsOut;
     }
@@ -204,6 +215,15 @@ private:
     int _cursorsOut;
     bool _dropQueuedIdentsAtSessionEnd = true;
     Date_t _idleExpireTime;
+
+    // Cursor cache lookups since the session was last released to the session cache, which folds
+    // them into its totals.
+    uint64_t _cursorCacheHits = 0;
+    uint64_t _cursorCacheMisses = 0;
+
+    // Decaying count of cursor requests per table id, maintained while hot cursors are kept
+    // across session releases.
+    stdx::unordered_map<uint64_t, uint32_t> _tableCursorRequests;
 };
 
 /**
@@ -284,6 +304,12 @@ public:
      */
     void closeAllCursors(const std::string& uri);
 
+    /**
+     * Appends cursor cache hit and miss counts of released sessions, and the number of hot cursors
+     * kept open across session releases.
+     */
+    void appendCursorCacheStats(BSONObjBuilder* builder) const;
+
     /**
      * Transitions the cache to shutting down mode. Any already released sessions are freed and
      * any sessions released subsequently are leaked. Must be called while holding the global
@@ -322,12 +348,21 @@ public:
      */
     void waitUntilDurable(OperationContext* opCtx, Fsync syncType, UseJournalListener useListener);
 
+    /**
+     * Returns a new id for a unit of work that is about to be prepared. Ids increase with every
+     * call, which lets waiters on prepare conflicts ignore units of work prepared after their
+     * conflict.
+     */
+    std::uint64_t newPreparedUnitOfWorkId() {
+        return _lastPreparedUnitOfWorkId.addAndFetch(1);
+    }
+
     /**
      * Waits until a prepared unit of work has ended (either been commited or aborted). This
      * should be used when encountering WT_PREPARE_CONFLICT errors. The caller is required to retry
      * the conflicting WiredTiger API operation. A return from this function does not guarantee that
-     * the conflicting transaction has ended, only that one prepared unit of work in the process has
-     * signaled that it has ended.
+     * the conflicting transaction has ended, only that one prepared unit of work in the process
+     * that was prepared before the conflict has signaled that it has ended.
      * Accepts an OperationContext that will throw an AssertionException when interrupted.
      *
      * This method is provided in WiredTigerSessionCache and not RecoveryUnit because all recovery
@@ -338,9 +373,15 @@ public:
 
     /**
      * Notifies waiters that the caller's perpared unit of work has ended (either committed or
-     * aborted).
+     * aborted). Only wakes the waiters whose conflict could have been caused by the unit of work
+     * with id 'preparedId', as returned by newPreparedUnitOfWorkId(). An id of 0 wakes all waiters.
      */
-    void notifyPreparedUnitOfWorkHasCommittedOrAborted();
+    void notifyPreparedUnitOfWorkHasCommittedOrAborted(std::uint64_t preparedId);
+
+    size_t getNumPrepareConflictWaitersForTest() {
+        stdx::lock_guard<Latch> lk(_prepareCommittedOrAbortedMutex);
+        return _prepareConflictWaiters.size();
+    }
 
     WT_CONNECTION* conn() const {
         return _conn;
@@ -379,9 +420,26 @@ private:
     AtomicWord<unsigned> _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    Mutex _cacheLock = MONGO_MAKE_LATCH("WiredTigerSessionCache::_cacheLock");
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+
+    /**
+     * One partition of the idle session pool. A thread releases sessions to, and checks them out
+     * from, the partition of the CPU it runs on, so threads on different CPUs rarely contend for
+     * the same mutex. A thread whose partition is empty takes a session from another partition
+     * before opening a new one.
+     */
+    struct SessionCachePartition {
+        Mutex mutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::SessionCachePartition::mutex");
+        SessionCache sessions;
+    };
+
+    /**
+     * Returns the partition for the CPU the calling thread runs on.
+     */
+    size_t _homePartitionIndex() const;
+
+    const size_t _numPartitions;
+    std::unique_ptr<CacheAligned<SessionCachePartition>[]> _partitions;
 
     // Bumped when all open sessions need to be closed
     AtomicWord<unsigned long long> _epoch;  // atomic so we can check it outside of the lock
@@ -389,15 +447,29 @@ private:
     // Bumped when all open cursors need to be closed
     AtomicWord<unsigned long long> _cursorEpoch;  // atomic so we can check it outside of the lock
 
+    // Cursor cache statistics, folded in from sessions as they are released.
+    AtomicWord<unsigned long long> _cursorCacheHits{0};
+    AtomicWord<unsigned long long> _cursorCacheMisses{0};
+    AtomicWord<unsigned long long> _hotCursorsKept{0};
+
     // Counter and critical section mutex for waitUntilDurable
     AtomicWord<unsigned> _lastSyncTime;
     Mutex _lastSyncMutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::_lastSyncMutex");
 
-    // Mutex and cond var for waiting on prepare commit or abort.
+    // An operation waiting for a prepared unit of work to commit or abort.
+    struct PrepareConflictWaiter {
+        // The last prepared unit of work id handed out when the operation hit its conflict.
+        const std::uint64_t lastPreparedId;
+        stdx::condition_variable cond;
+        bool notified = false;
+    };
+
+    // Mutex and waiters for waiting on prepare commit or abort.
     Mutex _prepareCommittedOrAbortedMutex =
         MONGO_MAKE_LATCH("WiredTigerSessionCache::_prepareCommittedOrAbortedMutex");
-    stdx::condition_variable _prepareCommittedOrAbortedCond;
+    std::list<PrepareConflictWaiter*> _prepareConflictWaiters;
     AtomicWord<std::uint64_t> _prepareCommitOrAbortCounter{0};
+    AtomicWord<std::uint64_t> _lastPreparedUnitOfWorkId{0};
 
     // Protects getting and setting the _journalListener below.
     Mutex _journalListenerMutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::_journalListenerMutex");
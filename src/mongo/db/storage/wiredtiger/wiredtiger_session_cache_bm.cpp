@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/util/system_clock_source.h"
+
+namespace mongo {
+namespace {
+
+const int kMaxPerfThreads = 16;  // max number of threads checking out sessions concurrently
+
+class WiredTigerConnection {
+public:
+    WiredTigerConnection(StringData dbpath, StringData extraStrings) : _conn(nullptr) {
+        std::stringstream ss;
+        ss << "create,";
+        ss << extraStrings;
+        std::string config = ss.str();
+        int ret = wiredtiger_open(dbpath.toString().c_str(), nullptr, config.c_str(), &_conn);
+        invariant(wtRCToStatus(ret).isOK());
+    }
+    ~WiredTigerConnection() {
+        _conn->close(_conn, nullptr);
+    }
+    WT_CONNECTION* getConnection() const {
+        return _conn;
+    }
+
+private:
+    WT_CONNECTION* _conn;
+};
+
+class WiredTigerSessionCacheHelper {
+public:
+    WiredTigerSessionCacheHelper()
+        : _dbpath("wt_test"),
+          _connection(_dbpath.path(), ""),
+          _sessionCache(_connection.getConnection(), &_clockSource) {}
+
+    WiredTigerSessionCache* getSessionCache() {
+        return &_sessionCache;
+    }
+
+private:
+    unittest::TempDir _dbpath;
+    WiredTigerConnection _connection;
+    SystemClockSource _clockSource;
+    WiredTigerSessionCache _sessionCache;
+};
+
+// Shared by all the threads of a benchmark run. Created and destroyed by the first thread, which
+// the benchmark library synchronizes with the others at the start and the end of the timed loop.
+std::unique_ptr<WiredTigerSessionCacheHelper> helper;
+
+/**
+ * Measures checking out a cached session and releasing it back to the cache, the work done for
+ * every operation that reads or writes through WiredTiger.
+ */
+void BM_WiredTigerSessionCheckout(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        helper = std::make_unique<WiredTigerSessionCacheHelper>();
+    }
+
+    for (auto _ : state) {
+        UniqueWiredTigerSession session = helper->getSessionCache()->getSession();
+        benchmark::DoNotOptimize(session.get());
+    }
+
+    if (state.thread_index == 0) {
+        helper.reset();
+    }
+}
+
+/**
+ * Same as above, with each thread holding on to a second session, so the cache is checked out
+ * more deeply, as with operations that open a separate session for a side transaction.
+ */
+void BM_WiredTigerSessionCheckoutNested(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        helper = std::make_unique<WiredTigerSessionCacheHelper>();
+    }
+
+    for (auto _ : state) {
+        UniqueWiredTigerSession outer = helper->getSessionCache()->getSession();
+        UniqueWiredTigerSession inner = helper->getSessionCache()->getSession();
+        benchmark::DoNotOptimize(inner.get());
+    }
+
+    if (state.thread_index == 0) {
+        helper.reset();
+    }
+}
+
+BENCHMARK(BM_WiredTigerSessionCheckout)->ThreadRange(1, kMaxPerfThreads);
+BENCHMARK(BM_WiredTigerSessionCheckoutNested)->ThreadRange(1, kMaxPerfThreads);
+
+}  // namespace
+}  // namespace mongo
@@ -34,10 +34,13 @@
 
 #include "mongo/base/string_data.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/system_clock_source.h"
 
 namespace mongo {
@@ -114,4 +117,96 @@ TEST(WiredTigerSessionCacheTest, CheckSessionCacheCleanup) {
     ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
 }
 
+TEST(WiredTigerSessionCacheTest, ReleasedSessionIsReusedByAnotherThread) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    // The session is released to the partition of whichever CPU the other thread ran on.
+    WT_SESSION* released = nullptr;
+    stdx::thread([&] {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        released = session->getSession();
+    }).join();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 1U);
+
+    UniqueWiredTigerSession session = sessionCache->getSession();
+    ASSERT_EQUALS(session->getSession(), released);
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+}
+
+TEST(WiredTigerSessionCacheTest, CloseAllDiscardsSessionsCheckedOutBefore) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+    {
+        UniqueWiredTigerSession checkedOut = sessionCache->getSession();
+        {
+            UniqueWiredTigerSession idle = sessionCache->getSession();
+        }
+        ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 1U);
+
+        sessionCache->closeAll();
+        ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+    }
+
+    // The session checked out before closeAll belongs to an old epoch and is not cached again.
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+}
+
+TEST(WiredTigerSessionCacheTest, HybridCachingKeepsOnlyHotCursorsAcrossSessionRelease) {
+    ASSERT_LT(gWiredTigerCursorCacheSize.load(), 0);
+    const auto originalHotCursors = gWiredTigerHotCursorsPerSession.load();
+    ON_BLOCK_EXIT([&] { gWiredTigerHotCursorsPerSession.store(originalHotCursors); });
+    gWiredTigerHotCursorsPerSession.store(1);
+
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+    const std::string hotUri = "table:hot";
+    const std::string coldUri = "table:cold";
+    const uint64_t hotId = WiredTigerSession::genTableId();
+    const uint64_t coldId = WiredTigerSession::genTableId();
+
+    auto useCursor = [](WiredTigerSession* session, uint64_t id, const std::string& uri) {
+        WT_CURSOR* cursor = session->getCachedCursor(id, "");
+        if (!cursor) {
+            cursor = session->getNewCursor(uri);
+        }
+        session->releaseCursor(id, cursor, "");
+    };
+
+    {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        WT_SESSION* wtSession = session->getSession();
+        ASSERT_OK(wtRCToStatus(wtSession->create(wtSession, hotUri.c_str(), nullptr)));
+        ASSERT_OK(wtRCToStatus(wtSession->create(wtSession, coldUri.c_str(), nullptr)));
+
+        useCursor(session.get(), hotId, hotUri);
+        useCursor(session.get(), hotId, hotUri);
+        useCursor(session.get(), coldId, coldUri);
+        ASSERT_EQUALS(session->cachedCursors(), 2);
+    }
+
+    {
+        // Only the cursor of the table requested more than once survived the release.
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        ASSERT_EQUALS(session->cachedCursors(), 1);
+        WT_CURSOR* cursor = session->getCachedCursor(hotId, "");
+        ASSERT(cursor);
+        session->releaseCursor(hotId, cursor, "");
+        ASSERT_FALSE(session->getCachedCursor(coldId, ""));
+    }
+
+    BSONObjBuilder builder;
+    sessionCache->appendCursorCacheStats(&builder);
+    BSONObj stats = builder.obj();
+    ASSERT_EQUALS(stats["hits"].numberLong(), 2);
+    ASSERT_EQUALS(stats["misses"].numberLong(), 3);
+    ASSERT_EQUALS(stats["hotCursorsKept"].numberLong(), 2);
+
+    // With no hot cursors configured, releasing the session closes every cursor again.
+    gWiredTigerHotCursorsPerSession.store(0);
+    { UniqueWiredTigerSession session = sessionCache->getSession(); }
+    UniqueWiredTigerSession session = sessionCache->getSession();
+    ASSERT_EQUALS(session->cachedCursors(), 0);
+}
+
 }  // namespace mongo
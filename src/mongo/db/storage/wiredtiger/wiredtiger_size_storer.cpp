@@ -100,6 +100,36 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Strin
             return it->second;
     }
 
+    BSONObj data = _readFromTable(uri);
+    if (data.isEmpty())
+        return std::make_shared<SizeInfo>();
+
+    LOGV2_DEBUG(
+        22424, 2, "WiredTigerSizeStorer::load", "uri"_attr = uri, "data"_attr = redact(data));
+    return std::make_shared<SizeInfo>(data["numRecords"].safeNumberLong(),
+                                      data["dataSize"].safeNumberLong());
+}
+
+void WiredTigerSizeStorer::storeMetadata(StringData key, BSONObj data) {
+    if (_readOnly)
+        return;
+
+    stdx::lock_guard<Latch> lk(_bufferMutex);
+    _metadataBuffer[key] = data.getOwned();
+}
+
+BSONObj WiredTigerSizeStorer::loadMetadata(StringData key) const {
+    {
+        stdx::lock_guard<Latch> bufferLock(_bufferMutex);
+        auto it = _metadataBuffer.find(key);
+        if (it != _metadataBuffer.end())
+            return it->second;
+    }
+
+    return _readFromTable(key);
+}
+
+BSONObj WiredTigerSizeStorer::_readFromTable(StringData key) const {
     stdx::lock_guard<Latch> cursorLock(_cursorMutex);
     // Intentionally ignoring return value.
     ON_BLOCK_EXIT([&] { _cursor->reset(_cursor); });
@@ -107,44 +137,43 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Strin
     _cursor->reset(_cursor);
 
     {
-        WT_ITEM key = {uri.rawData(), uri.size()};
-        _cursor->set_key(_cursor, &key);
+        WT_ITEM item = {key.rawData(), key.size()};
+        _cursor->set_key(_cursor, &item);
         int ret = _cursor->search(_cursor);
         if (ret == WT_NOTFOUND)
-            return std::make_shared<SizeInfo>();
+            return BSONObj();
         invariantWTOK(ret);
     }
 
     WT_ITEM value;
     invariantWTOK(_cursor->get_value(_cursor, &value));
-    BSONObj data(reinterpret_cast<const char*>(value.data));
-
-    LOGV2_DEBUG(
-        22424, 2, "WiredTigerSizeStorer::load", "uri"_attr = uri, "data"_attr = redact(data));
-    return std::make_shared<SizeInfo>(data["numRecords"].safeNumberLong(),
-                                      data["dataSize"].safeNumberLong());
+    return BSONObj(reinterpret_cast<const char*>(value.data)).getOwned();
 }
 
 void WiredTigerSizeStorer::flush(bool syncToDisk) {
     Buffer buffer;
+    MetadataBuffer metadataBuffer;
     {
         stdx::lock_guard<Latch> bufferLock(_bufferMutex);
         _buffer.swap(buffer);
+        _metadataBuffer.swap(metadataBuffer);
     }
 
-    if (buffer.empty())
+    if (buffer.empty() && metadataBuffer.empty())
         return;  // Nothing to do.
 
     Timer t;
     stdx::lock_guard<Latch> cursorLock(_cursorMutex);
     {
         // On failure, place entries back into the map, unless a newer value already exists.
-        ON_BLOCK_EXIT([this, &buffer]() {
+        ON_BLOCK_EXIT([this, &buffer, &metadataBuffer]() {
             this->_cursor->reset(this->_cursor);
-            if (!buffer.empty()) {
+            if (!buffer.empty() || !metadataBuffer.empty()) {
                 stdx::lock_guard<Latch> bufferLock(this->_bufferMutex);
                 for (auto& it : buffer)
                     this->_buffer.try_emplace(it.first, it.second);
+                for (auto& it : metadataBuffer)
+                    this->_metadataBuffer.try_emplace(it.first, it.second);
             }
         });
 
@@ -173,9 +202,18 @@ void WiredTigerSizeStorer::flush(bool syncToDisk) {
             _cursor->set_value(_cursor, value.Get());
             invariantWTOK(_cursor->insert(_cursor));
         }
+
+        for (auto&& [key, data] : metadataBuffer) {
+            WiredTigerItem keyItem(key.c_str(), key.size());
+            WiredTigerItem value(data.objdata(), data.objsize());
+            _cursor->set_key(_cursor, keyItem.Get());
+            _cursor->set_value(_cursor, value.Get());
+            invariantWTOK(_cursor->insert(_cursor));
+        }
         txnOpen.done();
         invariantWTOK(session->commit_transaction(session, nullptr));
         buffer.clear();
+        metadataBuffer.clear();
     }
 
     LOGV2_DEBUG(22426,
@@ -34,6 +34,7 @@
 #include <wiredtiger.h>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
@@ -87,6 +88,18 @@ public:
 
     std::shared_ptr<SizeInfo> load(StringData uri) const;
 
+    /**
+     * Buffers 'data' to be written under 'key' by the next call to flush, replacing any value still
+     * pending for the same key. This is meant for small pieces of metadata that, like the size
+     * information, only need to be persisted periodically. The key must not be the URI of a table.
+     */
+    void storeMetadata(StringData key, BSONObj data);
+
+    /**
+     * Returns the pending or stored metadata for 'key', or an empty object if there is none.
+     */
+    BSONObj loadMetadata(StringData key) const;
+
     /**
      * Writes all changes to the underlying table.
      */
@@ -100,9 +113,14 @@ private:
     WT_CURSOR* _cursor;  // pointer is const after constructor
 
     using Buffer = StringMap<std::shared_ptr<SizeInfo>>;
+    using MetadataBuffer = StringMap<BSONObj>;
+
+    // Looks up the stored value for 'key' in the table, returning an empty object if not found.
+    BSONObj _readFromTable(StringData key) const;
 
-    mutable Mutex _bufferMutex =
-        MONGO_MAKE_LATCH("WiredTigerSessionStorer::_bufferMutex");  // Guards _buffer
+    mutable Mutex _bufferMutex = MONGO_MAKE_LATCH(
+        "WiredTigerSessionStorer::_bufferMutex");  // Guards _buffer and _metadataBuffer
     Buffer _buffer;
+    MetadataBuffer _metadataBuffer;
 };
 }  // namespace mongo
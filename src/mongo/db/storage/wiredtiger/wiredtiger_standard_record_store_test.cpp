@@ -200,5 +200,24 @@ TEST_F(SizeStorerUpdateTest, Basic) {
     ASSERT_EQUALS(getDataSize(), val);
 }
 
+// Metadata is served from the write buffer until flushed, and from the table afterwards.
+TEST_F(SizeStorerUpdateTest, Metadata) {
+    const std::string key = uri + "?metadata";
+    ASSERT_BSONOBJ_EQ(sizeStorer->loadMetadata(key), BSONObj());
+
+    sizeStorer->storeMetadata(key, BSON("a" << 1));
+    sizeStorer->storeMetadata(key, BSON("a" << 2));
+    ASSERT_BSONOBJ_EQ(sizeStorer->loadMetadata(key), BSON("a" << 2));
+
+    sizeStorer->flush(false);
+    WiredTigerSizeStorer otherSizeStorer(harnessHelper->conn(),
+                                         WiredTigerKVEngine::kTableUriPrefix + "sizeStorer");
+    ASSERT_BSONOBJ_EQ(otherSizeStorer.loadMetadata(key), BSON("a" << 2));
+
+    // The metadata does not affect the size information stored for the record store.
+    ASSERT_EQUALS(getNumRecords(), 0);
+    ASSERT_EQUALS(getDataSize(), 0);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -33,6 +33,7 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 
+#include <algorithm>
 #include <limits>
 
 #include <boost/filesystem.hpp>
@@ -699,7 +700,23 @@ bool WiredTigerUtil::useTableLogging(NamespaceString ns, bool replEnabled) {
     return true;
 }
 
+bool WiredTigerUtil::_canSkipTableLoggingCheckAtStartup(WithLock) {
+    return _tableLoggingInfo.isInitializing && !_tableLoggingInfo.isFirstTable &&
+        !_tableLoggingInfo.changeTableLogging &&
+        !_tableLoggingInfo.hasPreviouslyIncompleteTableChecks && !storageGlobalParams.repair;
+}
+
 Status WiredTigerUtil::setTableLogging(OperationContext* opCtx, const std::string& uri, bool on) {
+    {
+        // Every table is checked while the catalog is loaded at start up. In the common case no
+        // table needs to be modified, so avoid closing cursors across the session cache and
+        // opening a dedicated session for each of them.
+        stdx::lock_guard<Latch> lk(_tableLoggingInfoMutex);
+        if (_canSkipTableLoggingCheckAtStartup(lk)) {
+            return Status::OK();
+        }
+    }
+
     // Try to close as much as possible to avoid EBUSY errors.
     WiredTigerRecoveryUnit::get(opCtx)->getSession()->closeAllCursors(uri);
     WiredTigerSessionCache* sessionCache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
@@ -748,15 +765,16 @@ Status WiredTigerUtil::setTableLogging(WT_SESSION* session, const std::string& u
         return _setTableLogging(session, uri, on);
     }
 
-    if (!_tableLoggingInfo.isFirstTable) {
-        if (_tableLoggingInfo.changeTableLogging) {
-            return _setTableLogging(session, uri, on);
-        }
-
+    if (_canSkipTableLoggingCheckAtStartup(lk)) {
         // The table logging settings do not need to be modified.
         return Status::OK();
     }
 
+    if (!_tableLoggingInfo.isFirstTable) {
+        invariant(_tableLoggingInfo.changeTableLogging);
+        return _setTableLogging(session, uri, on);
+    }
+
     invariant(_tableLoggingInfo.isFirstTable);
     invariant(!_tableLoggingInfo.hasPreviouslyIncompleteTableChecks);
 
@@ -990,6 +1008,16 @@ void WiredTigerUtil::appendSnapshotWindowSettings(WiredTigerKVEngine* engine,
         minPinned = std::min(minPinned, it.second);
     }
     settings.append("min pinned timestamp", minPinned);
+
+    // Readers at a timestamp, such as snapshot reads on secondaries, keep the history they need
+    // pinned in addition to the history window.
+    if (auto oldestReader = engine->getOldestActiveReadTimestamp()) {
+        settings.append("oldest active read timestamp", oldestReader->toStringPretty());
+        const long long pinnedSecs = static_cast<long long>(stableTimestamp.getSecs()) -
+            static_cast<long long>(oldestReader->getSecs());
+        settings.append("seconds of history pinned by the oldest active read",
+                        std::max(pinnedSecs, 0LL));
+    }
 }
 
 }  // namespace mongo
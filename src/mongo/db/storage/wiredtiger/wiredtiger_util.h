@@ -37,6 +37,7 @@
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/with_lock.h"
 
 namespace mongo {
 
@@ -310,6 +311,13 @@ private:
 
     static Status _setTableLogging(WT_SESSION* session, const std::string& uri, bool on);
 
+    /**
+     * Returns true if, during start up, the logging settings of the first table showed that no
+     * other table needs its settings checked or modified. Must be called with
+     * _tableLoggingInfoMutex held.
+     */
+    static bool _canSkipTableLoggingCheckAtStartup(WithLock);
+
     // Used to keep track of the table logging setting modifications during start up. The mutex must
     // be held prior to accessing any of the member variables in the struct.
     static Mutex _tableLoggingInfoMutex;
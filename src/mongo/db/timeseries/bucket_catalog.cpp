@@ -177,7 +177,7 @@ BSONObj BucketCatalog::getMetadata(Bucket* ptr) const {
     return bucket->_metadata.toBSON();
 }
 
-StatusWith<std::shared_ptr<BucketCatalog::WriteBatch>> BucketCatalog::insert(
+StatusWith<BucketCatalog::InsertResult> BucketCatalog::insert(
     OperationContext* opCtx,
     const NamespaceString& ns,
     const StringData::ComparatorInterface* comparator,
@@ -204,7 +204,8 @@ StatusWith<std::shared_ptr<BucketCatalog::WriteBatch>> BucketCatalog::insert(
 
     auto time = timeElem.Date();
 
-    BucketAccess bucket{this, key, options, stats.get(), time};
+    ClosedBuckets closedBuckets;
+    BucketAccess bucket{this, key, options, stats.get(), &closedBuckets, time};
     invariant(bucket);
 
     NewFieldNames newFieldNamesToBeInserted;
@@ -238,8 +239,29 @@ StatusWith<std::shared_ptr<BucketCatalog::WriteBatch>> BucketCatalog::insert(
         return false;
     };
 
+    auto canReopen = [&](Bucket* archived) -> bool {
+        auto archivedTime = archived->id().asDateT();
+        if (time < archivedTime ||
+            time - archivedTime >= Seconds(*options.getBucketMaxSpanSeconds())) {
+            return false;
+        }
+        if (archived->_numMeasurements >= static_cast<std::uint64_t>(gTimeseriesBucketMaxCount)) {
+            return false;
+        }
+        NewFieldNames archivedNewFieldNames;
+        uint32_t archivedNewFieldNamesSize = 0;
+        uint32_t archivedSizeToBeAdded = 0;
+        archived->_calculateBucketFieldsAndSizeChange(doc,
+                                                      options.getMetaField(),
+                                                      &archivedNewFieldNames,
+                                                      &archivedNewFieldNamesSize,
+                                                      &archivedSizeToBeAdded);
+        return archived->_size + archivedSizeToBeAdded <=
+            static_cast<std::uint64_t>(gTimeseriesBucketMaxSize);
+    };
+
     if (!bucket->_ns.isEmpty() && isBucketFull(&bucket)) {
-        bucket.rollover(isBucketFull);
+        bucket.rollover(isBucketFull, canReopen);
         bucket->_calculateBucketFieldsAndSizeChange(doc,
                                                     options.getMetaField(),
                                                     &newFieldNamesToBeInserted,
@@ -259,6 +281,7 @@ StatusWith<std::shared_ptr<BucketCatalog::WriteBatch>> BucketCatalog::insert(
     if (bucket->_ns.isEmpty()) {
         // The namespace and metadata only need to be set if this bucket was newly created.
         bucket->_ns = ns;
+        bucket->_timeField = options.getTimeField().toString();
         key.metadata.normalize();
         bucket->_metadata = key.metadata;
 
@@ -273,7 +296,7 @@ StatusWith<std::shared_ptr<BucketCatalog::WriteBatch>> BucketCatalog::insert(
     }
     _memoryUsage.fetchAndAdd(bucket->_memoryUsage);
 
-    return batch;
+    return InsertResult{batch, std::move(closedBuckets)};
 }
 
 bool BucketCatalog::prepareCommit(std::shared_ptr<WriteBatch> batch) {
@@ -302,10 +325,13 @@ bool BucketCatalog::prepareCommit(std::shared_ptr<WriteBatch> batch) {
     return true;
 }
 
-void BucketCatalog::finish(std::shared_ptr<WriteBatch> batch, const CommitInfo& info) {
+boost::optional<BucketCatalog::ClosedBucket> BucketCatalog::finish(
+    std::shared_ptr<WriteBatch> batch, const CommitInfo& info) {
     invariant(!batch->finished());
     invariant(!batch->active());
 
+    boost::optional<ClosedBucket> closedBucket;
+
     Bucket* ptr(batch->bucket());
     batch->_finish(info);
 
@@ -342,6 +368,7 @@ void BucketCatalog::finish(std::shared_ptr<WriteBatch> batch, const CommitInfo&
             // Everything in the bucket has been committed, and nothing more will be added since the
             // bucket is full. Thus, we can remove it.
             _memoryUsage.fetchAndSubtract(bucket->_memoryUsage);
+            closedBucket = ClosedBucket{ptr->_id, ptr->_timeField, ptr->_numMeasurements};
 
             bucket.release();
             auto lk = _lockExclusive();
@@ -359,6 +386,7 @@ void BucketCatalog::finish(std::shared_ptr<WriteBatch> batch, const CommitInfo&
             _markBucketIdle(bucket);
         }
     }
+    return closedBucket;
 }
 
 void BucketCatalog::abort(std::shared_ptr<WriteBatch> batch,
@@ -438,6 +466,8 @@ void BucketCatalog::appendExecutionStats(const NamespaceString& ns, BSONObjBuild
                           stats->numBucketsClosedDueToTimeBackward.load());
     builder->appendNumber("numBucketsClosedDueToMemoryThreshold",
                           stats->numBucketsClosedDueToMemoryThreshold.load());
+    builder->appendNumber("numBucketsArchived", stats->numBucketsArchived.load());
+    builder->appendNumber("numBucketsReopened", stats->numBucketsReopened.load());
     auto commits = stats->numCommits.load();
     builder->appendNumber("numCommits", commits);
     builder->appendNumber("numWaits", stats->numWaits.load());
@@ -504,7 +534,12 @@ bool BucketCatalog::_removeBucket(Bucket* bucket, bool expiringBuckets) {
     _memoryUsage.fetchAndSubtract(bucket->_memoryUsage);
     _markBucketNotIdle(bucket, expiringBuckets /* locked */);
     _removeNonNormalizedKeysForBucket(bucket);
-    _openBuckets.erase({bucket->_ns, bucket->_metadata});
+    if (bucket->_archived) {
+        _removeArchivedBucket(bucket);
+    } else if (auto openIt = _openBuckets.find({bucket->_ns, bucket->_metadata});
+               openIt != _openBuckets.end() && openIt->second == bucket) {
+        _openBuckets.erase(openIt);
+    }
     {
         stdx::lock_guard statesLk{_statesMutex};
         _bucketStates.erase(bucket->_id);
@@ -514,10 +549,64 @@ bool BucketCatalog::_removeBucket(Bucket* bucket, bool expiringBuckets) {
     return true;
 }
 
+void BucketCatalog::_archiveBucket(Bucket* bucket,
+                                   ExecutionStats* stats,
+                                   ClosedBuckets* closedBuckets) {
+    // Must hold an exclusive lock on _bucketMutex from outside.
+    BucketKey key{bucket->_ns, bucket->_metadata};
+    auto& archived = _archivedBuckets[key];
+    archived.push_back(bucket);
+    bucket->_archived = true;
+    stats->numBucketsArchived.fetchAndAddRelaxed(1);
+
+    // Close the oldest archived buckets once we have too many. Buckets with uncommitted batches
+    // are marked full so they are closed as soon as their last batch finishes.
+    auto maxArchived = static_cast<std::size_t>(gTimeseriesMaxArchivedBucketsPerKey.load());
+    while (archived.size() > maxArchived) {
+        Bucket* oldest = archived.front();
+        archived.erase(archived.begin());
+        oldest->_archived = false;
+
+        stdx::unique_lock blk{oldest->_mutex};
+        if (oldest->allCommitted()) {
+            blk.unlock();
+            _recordClosedBucket(oldest, closedBuckets);
+            [[maybe_unused]] bool removed = _removeBucket(oldest, false /* expiringBuckets */);
+        } else {
+            oldest->_full = true;
+        }
+    }
+
+    if (archived.empty()) {
+        _archivedBuckets.erase(key);
+    }
+}
+
+void BucketCatalog::_removeArchivedBucket(Bucket* bucket) {
+    auto it = _archivedBuckets.find({bucket->_ns, bucket->_metadata});
+    invariant(it != _archivedBuckets.end());
+    auto& archived = it->second;
+    archived.erase(std::remove(archived.begin(), archived.end(), bucket), archived.end());
+    if (archived.empty()) {
+        _archivedBuckets.erase(it);
+    }
+    bucket->_archived = false;
+}
+
+void BucketCatalog::_recordClosedBucket(const Bucket* bucket, ClosedBuckets* closedBuckets) {
+    if (closedBuckets && bucket->_numCommittedMeasurements > 0) {
+        closedBuckets->push_back(
+            ClosedBucket{bucket->_id, bucket->_timeField, bucket->_numMeasurements});
+    }
+}
+
 void BucketCatalog::_removeNonNormalizedKeysForBucket(Bucket* bucket) {
     auto comparator = bucket->_metadata.getComparator();
     for (auto&& metadata : bucket->_nonNormalizedKeyMetadatas) {
-        _openBuckets.erase({bucket->_ns, {metadata.firstElement(), metadata, comparator}});
+        auto it = _openBuckets.find({bucket->_ns, {metadata.firstElement(), metadata, comparator}});
+        if (it != _openBuckets.end() && it->second == bucket) {
+            _openBuckets.erase(it);
+        }
     }
 }
 
@@ -578,7 +667,7 @@ void BucketCatalog::_verifyBucketIsUnused(Bucket* bucket) const {
     stdx::lock_guard<Mutex> lk{bucket->_mutex};
 }
 
-void BucketCatalog::_expireIdleBuckets(ExecutionStats* stats) {
+void BucketCatalog::_expireIdleBuckets(ExecutionStats* stats, ClosedBuckets* closedBuckets) {
     // Must hold an exclusive lock on _bucketMutex from outside.
     stdx::lock_guard lk{_idleMutex};
 
@@ -588,6 +677,7 @@ void BucketCatalog::_expireIdleBuckets(ExecutionStats* stats) {
                static_cast<std::uint64_t>(gTimeseriesIdleBucketExpiryMemoryUsageThreshold)) {
         Bucket* bucket = _idleBuckets.back();
         _verifyBucketIsUnused(bucket);
+        _recordClosedBucket(bucket, closedBuckets);
         if (_removeBucket(bucket, true /* expiringBuckets */)) {
             stats->numBucketsClosedDueToMemoryThreshold.fetchAndAddRelaxed(1);
         }
@@ -603,8 +693,9 @@ BucketCatalog::Bucket* BucketCatalog::_allocateBucket(const BucketKey& key,
                                                       const Date_t& time,
                                                       const TimeseriesOptions& options,
                                                       ExecutionStats* stats,
+                                                      ClosedBuckets* closedBuckets,
                                                       bool openedDuetoMetadata) {
-    _expireIdleBuckets(stats);
+    _expireIdleBuckets(stats, closedBuckets);
 
     auto [it, inserted] = _allBuckets.insert(std::make_unique<Bucket>());
     Bucket* bucket = it->get();
@@ -817,8 +908,14 @@ BucketCatalog::BucketAccess::BucketAccess(BucketCatalog* catalog,
                                           BucketKey& key,
                                           const TimeseriesOptions& options,
                                           ExecutionStats* stats,
+                                          ClosedBuckets* closedBuckets,
                                           const Date_t& time)
-    : _catalog(catalog), _key(&key), _options(&options), _stats(stats), _time(&time) {
+    : _catalog(catalog),
+      _key(&key),
+      _options(&options),
+      _stats(stats),
+      _closedBuckets(closedBuckets),
+      _time(&time) {
 
     auto bucketFound = [](BucketState bucketState) {
         return bucketState == BucketState::kNormal || bucketState == BucketState::kPrepared;
@@ -1013,8 +1110,8 @@ void BucketCatalog::BucketAccess::_create(const HashedBucketKey& normalizedKey,
                                           const HashedBucketKey& nonNormalizedKey,
                                           bool openedDuetoMetadata) {
     invariant(_options);
-    _bucket =
-        _catalog->_allocateBucket(normalizedKey, *_time, *_options, _stats, openedDuetoMetadata);
+    _bucket = _catalog->_allocateBucket(
+        normalizedKey, *_time, *_options, _stats, _closedBuckets, openedDuetoMetadata);
     _catalog->_openBuckets[nonNormalizedKey] = _bucket;
     _bucket->_nonNormalizedKeyMetadatas.push_back(nonNormalizedKey.key->metadata.toBSON());
     _acquire();
@@ -1043,7 +1140,8 @@ BucketCatalog::BucketAccess::operator BucketCatalog::Bucket*() const {
     return _bucket;
 }
 
-void BucketCatalog::BucketAccess::rollover(const std::function<bool(BucketAccess*)>& isBucketFull) {
+void BucketCatalog::BucketAccess::rollover(const std::function<bool(BucketAccess*)>& isBucketFull,
+                                           const std::function<bool(Bucket*)>& canReopen) {
     invariant(isLocked());
     invariant(_key);
     invariant(_time);
@@ -1067,11 +1165,20 @@ void BucketCatalog::BucketAccess::rollover(const std::function<bool(BucketAccess
         oldBucket == _bucket;  // Only record stats if bucket has changed, don't double-count.
     if (sameBucket || isBucketFull(this)) {
         // The bucket is indeed full, so create a new one.
-        if (_bucket->allCommitted()) {
+        if (_isArchivable()) {
+            // The bucket still has room for measurements in its own time range, so keep it around
+            // in case late measurements arrive for it.
+            _catalog->_removeNonNormalizedKeysForBucket(_bucket);
+            _bucket->_nonNormalizedKeyMetadatas.clear();
+            oldBucket = _bucket;
+            release();
+            _catalog->_archiveBucket(oldBucket, _stats, _closedBuckets);
+        } else if (_bucket->allCommitted()) {
             // The bucket does not contain any measurements that are yet to be committed, so we can
             // remove it now. Otherwise, we must keep the bucket around until it is committed.
             oldBucket = _bucket;
             release();
+            _recordClosedBucket(oldBucket, _closedBuckets);
             bool removed = _catalog->_removeBucket(oldBucket, false /* expiringBuckets */);
             invariant(removed);
         } else {
@@ -1083,10 +1190,69 @@ void BucketCatalog::BucketAccess::rollover(const std::function<bool(BucketAccess
             release();
         }
 
+        if (_reopenArchivedBucket(hashedNormalizedKey, hashedKey, canReopen)) {
+            return;
+        }
+
         _create(hashedNormalizedKey, hashedKey, false /* openedDueToMetadata */);
     }
 }
 
+bool BucketCatalog::BucketAccess::_isArchivable() const {
+    invariant(isLocked());
+    if (gTimeseriesMaxArchivedBucketsPerKey.load() == 0) {
+        return false;
+    }
+    if (_bucket->_numMeasurements >= static_cast<std::uint64_t>(gTimeseriesBucketMaxCount) ||
+        _bucket->_size >= static_cast<std::uint64_t>(gTimeseriesBucketMaxSize)) {
+        return false;
+    }
+    auto bucketTime = getTime();
+    return *_time < bucketTime ||
+        *_time - bucketTime >= Seconds(*_options->getBucketMaxSpanSeconds());
+}
+
+bool BucketCatalog::BucketAccess::_reopenArchivedBucket(
+    const HashedBucketKey& normalizedKey,
+    const HashedBucketKey& nonNormalizedKey,
+    const std::function<bool(Bucket*)>& canReopen) {
+    invariant(!isLocked());
+    auto it = _catalog->_archivedBuckets.find(normalizedKey);
+    if (it == _catalog->_archivedBuckets.end()) {
+        return false;
+    }
+
+    // Prefer the most recently archived bucket, which is the most likely to cover late data.
+    auto& archived = it->second;
+    for (auto bucketIt = archived.rbegin(); bucketIt != archived.rend(); ++bucketIt) {
+        _bucket = *bucketIt;
+        _acquire();
+
+        bool usable = false;
+        {
+            stdx::lock_guard statesLk{_catalog->_statesMutex};
+            auto statesIt = _catalog->_bucketStates.find(_bucket->_id);
+            usable = statesIt != _catalog->_bucketStates.end() &&
+                (statesIt->second == BucketState::kNormal ||
+                 statesIt->second == BucketState::kPrepared);
+        }
+        if (!usable || !canReopen(_bucket)) {
+            release();
+            continue;
+        }
+
+        _catalog->_removeArchivedBucket(_bucket);
+        _catalog->_markBucketNotIdle(_bucket, false /* locked */);
+        _catalog->_openBuckets[normalizedKey] = _bucket;
+        _catalog->_openBuckets[nonNormalizedKey] = _bucket;
+        _bucket->_nonNormalizedKeyMetadatas.push_back(nonNormalizedKey.key->metadata.toBSON());
+        _stats->numBucketsReopened.fetchAndAddRelaxed(1);
+        return true;
+    }
+
+    return false;
+}
+
 Date_t BucketCatalog::BucketAccess::getTime() const {
     return _bucket->id().asDateT();
 }
@@ -1184,6 +1350,7 @@ void BucketCatalog::WriteBatch::_prepareCommit() {
         }
 
         _bucket->_fieldNames.emplace(fieldName);
+        _bucket->_memoryUsage += sizeof(std::string) + fieldName.key().size();
         ++it;
     }
 
@@ -1199,12 +1366,14 @@ void BucketCatalog::WriteBatch::_prepareCommit() {
     } else {
         _min = _bucket->_minmax.min();
         _max = _bucket->_minmax.max();
-
-        // Approximate minmax memory usage by taking sizes of initial commit. Subsequent updates may
-        // add fields but are most likely just to update values.
-        _bucket->_memoryUsage += _min.objsize();
-        _bucket->_memoryUsage += _max.objsize();
     }
+
+    // Track the actual footprint of the min/max store, which keeps growing as new fields are
+    // added to the bucket and is typically several times larger than its BSON serialization.
+    auto minmaxMemoryUsage = _bucket->_minmax.calculateMemUsage();
+    _bucket->_memoryUsage -= _bucket->_minmaxMemoryUsage;
+    _bucket->_memoryUsage += minmaxMemoryUsage;
+    _bucket->_minmaxMemoryUsage = minmaxMemoryUsage;
 }
 
 void BucketCatalog::WriteBatch::_finish(const CommitInfo& info) {
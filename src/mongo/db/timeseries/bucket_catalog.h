@@ -65,6 +65,18 @@ public:
         boost::optional<OID> electionId;
     };
 
+    /**
+     * Information of a bucket that was closed when performing an operation with this
+     * BucketCatalog. All measurements of a closed bucket have been committed and no more will be
+     * inserted into it, so it is eligible for compression.
+     */
+    struct ClosedBucket {
+        OID bucketId;
+        std::string timeField;
+        uint32_t numMeasurements;
+    };
+    using ClosedBuckets = std::vector<ClosedBucket>;
+
     /**
      * The basic unit of work for a bucket. Each insert will return a shared_ptr to a WriteBatch.
      * When a writer is finished with all their insertions, they should then take steps to ensure
@@ -182,12 +194,17 @@ public:
      */
     BSONObj getMetadata(Bucket* bucket) const;
 
+    struct InsertResult {
+        std::shared_ptr<WriteBatch> batch;
+        ClosedBuckets closedBuckets;
+    };
+
     /**
-     * Returns the WriteBatch into which the document was inserted. Any caller who receives the same
-     * batch may commit or abort the batch after claiming commit rights. See WriteBatch for more
-     * details.
+     * Returns the WriteBatch into which the document was inserted and any buckets that were closed
+     * in order to make space to insert the document. Any caller who receives the same batch may
+     * commit or abort the batch after claiming commit rights. See WriteBatch for more details.
      */
-    StatusWith<std::shared_ptr<WriteBatch>> insert(
+    StatusWith<InsertResult> insert(
         OperationContext* opCtx,
         const NamespaceString& ns,
         const StringData::ComparatorInterface* comparator,
@@ -205,8 +222,11 @@ public:
     /**
      * Records the result of a batch commit. Caller must already have commit rights on batch, and
      * batch must have been previously prepared.
+     *
+     * Returns bucket information of a bucket if one was closed.
      */
-    void finish(std::shared_ptr<WriteBatch> batch, const CommitInfo& info);
+    boost::optional<ClosedBucket> finish(std::shared_ptr<WriteBatch> batch,
+                                         const CommitInfo& info);
 
     /**
      * Aborts the given write batch and any other outstanding batches on the same bucket. Caller
@@ -378,6 +398,9 @@ public:
         // The namespace that this bucket is used for.
         NamespaceString _ns;
 
+        // The name of the time field of the measurements in this bucket.
+        std::string _timeField;
+
         // The metadata of the data that this bucket contains.
         BucketMetadata _metadata;
 
@@ -420,8 +443,15 @@ public:
         // If the bucket is in _idleBuckets, then its position is recorded here.
         boost::optional<IdleList::iterator> _idleListEntry = boost::none;
 
+        // Whether the bucket has been rolled over and is kept in _archivedBuckets rather than
+        // _openBuckets.
+        bool _archived = false;
+
         // Approximate memory usage of this bucket.
         uint64_t _memoryUsage = sizeof(*this);
+
+        // The part of _memoryUsage that is attributed to _minmax, as of the last prepared commit.
+        uint64_t _minmaxMemoryUsage = 0;
     };
 
 private:
@@ -434,6 +464,8 @@ private:
         AtomicWord<long long> numBucketsClosedDueToTimeForward;
         AtomicWord<long long> numBucketsClosedDueToTimeBackward;
         AtomicWord<long long> numBucketsClosedDueToMemoryThreshold;
+        AtomicWord<long long> numBucketsArchived;
+        AtomicWord<long long> numBucketsReopened;
         AtomicWord<long long> numCommits;
         AtomicWord<long long> numWaits;
         AtomicWord<long long> numMeasurementsCommitted;
@@ -549,6 +581,7 @@ private:
                      BucketKey& key,
                      const TimeseriesOptions& options,
                      ExecutionStats* stats,
+                     ClosedBuckets* closedBuckets,
                      const Date_t& time);
         BucketAccess(BucketCatalog* catalog,
                      Bucket* bucket,
@@ -568,8 +601,14 @@ private:
          * Parameter is a function which should check that the bucket is indeed still full after
          * reacquiring the necessary locks. The first parameter will give the function access to
          * this BucketAccess instance, with the bucket locked.
+         *
+         * If the bucket was rolled over only because the measurement falls outside of its time
+         * range, it is archived instead of closed. Before a new bucket is created, any archived
+         * bucket for the same metadata for which 'canReopen' returns true is made the open bucket
+         * again. 'canReopen' is called with the candidate bucket locked.
          */
-        void rollover(const std::function<bool(BucketAccess*)>& isBucketFull);
+        void rollover(const std::function<bool(BucketAccess*)>& isBucketFull,
+                      const std::function<bool(Bucket*)>& canReopen);
 
         // Retrieve the time associated with the bucket (id)
         Date_t getTime() const;
@@ -604,6 +643,16 @@ private:
         void _findOrCreateOpenBucketThenLock(const HashedBucketKey& normalizedKey,
                                              const HashedBucketKey& key);
 
+        // Whether the locked bucket may be archived on rollover rather than closed, i.e. it has
+        // room left and only the time of the incoming measurement is out of its range.
+        bool _isArchivable() const;
+
+        // Helper to find an archived bucket for the given metadata accepted by 'canReopen', make
+        // it the open bucket again, and lock it. Requires an exclusive lock on the catalog.
+        bool _reopenArchivedBucket(const HashedBucketKey& normalizedKey,
+                                   const HashedBucketKey& key,
+                                   const std::function<bool(Bucket*)>& canReopen);
+
         // Lock _bucket.
         void _acquire();
 
@@ -617,6 +666,7 @@ private:
         BucketKey* _key = nullptr;
         const TimeseriesOptions* _options = nullptr;
         ExecutionStats* _stats = nullptr;
+        ClosedBuckets* _closedBuckets = nullptr;
         const Date_t* _time = nullptr;
 
         Bucket* _bucket = nullptr;
@@ -635,6 +685,23 @@ private:
      */
     bool _removeBucket(Bucket* bucket, bool expiringBuckets);
 
+    /**
+     * Moves a rolled over bucket into _archivedBuckets, closing the oldest archived buckets for
+     * the same metadata beyond 'timeseriesMaxArchivedBucketsPerKey'. The closed buckets are
+     * appended to 'closedBuckets'. Requires an exclusive lock on the catalog.
+     */
+    void _archiveBucket(Bucket* bucket, ExecutionStats* stats, ClosedBuckets* closedBuckets);
+
+    /**
+     * Removes the given bucket from _archivedBuckets.
+     */
+    void _removeArchivedBucket(Bucket* bucket);
+
+    /**
+     * Records the given bucket as closed if it has measurements stored on disk.
+     */
+    static void _recordClosedBucket(const Bucket* bucket, ClosedBuckets* closedBuckets);
+
     /**
      * Removes extra non-normalized BucketKey's for the given bucket from the
      * bucket catalog's internal data structures.
@@ -669,8 +736,9 @@ private:
 
     /**
      * Expires idle buckets until the bucket catalog's memory usage is below the expiry threshold.
+     * The expired buckets are appended to 'closedBuckets'.
      */
-    void _expireIdleBuckets(ExecutionStats* stats);
+    void _expireIdleBuckets(ExecutionStats* stats, ClosedBuckets* closedBuckets);
 
     std::size_t _numberOfIdleBuckets() const;
 
@@ -679,6 +747,7 @@ private:
                             const Date_t& time,
                             const TimeseriesOptions& options,
                             ExecutionStats* stats,
+                            ClosedBuckets* closedBuckets,
                             bool openedDuetoMetadata);
 
     std::shared_ptr<ExecutionStats> _getExecutionStats(const NamespaceString& ns);
@@ -697,7 +766,8 @@ private:
     boost::optional<BucketState> _setBucketState(const OID& id, BucketState target);
 
     /**
-     * You must hold a lock on _bucketMutex when accessing _allBuckets or _openBuckets.
+     * You must hold a lock on _bucketMutex when accessing _allBuckets, _openBuckets or
+     * _archivedBuckets.
      * While holding a lock on _bucketMutex, you can take a lock on an individual bucket, then
      * release _bucketMutex. Any iterators on the protected structures should be considered invalid
      * once the lock is released. Any subsequent access to the structures requires relocking
@@ -720,6 +790,10 @@ private:
     // The current open bucket for each namespace and metadata pair.
     stdx::unordered_map<BucketKey, Bucket*, BucketHasher, BucketEq> _openBuckets;
 
+    // Buckets which were rolled over due to time but still have room, for each namespace and
+    // normalized metadata pair, oldest first. Late measurements may reopen them.
+    stdx::unordered_map<BucketKey, std::vector<Bucket*>, BucketHasher, BucketEq> _archivedBuckets;
+
     // Bucket state
     mutable Mutex _statesMutex = MONGO_MAKE_LATCH("BucketCatalog::_statesMutex");
     stdx::unordered_map<OID, BucketState, OID::Hasher> _bucketStates;
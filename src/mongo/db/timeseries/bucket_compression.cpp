@@ -0,0 +1,144 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_compression.h"
+
+#include "mongo/base/parse_number.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/util/bsoncolumnbuilder.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+#include "mongo/util/decimal_counter.h"
+
+namespace mongo {
+namespace timeseries {
+
+namespace {
+/**
+ * Appends the row-keyed object 'column' to 'builder' as a BSONColumn binary. Missing rows are
+ * stored as skips. Returns false if the row keys are not ascending indexes below
+ * 'numMeasurements'.
+ */
+bool appendCompressedColumn(BSONObjBuilder* builder,
+                            const BSONElement& column,
+                            uint32_t numMeasurements) {
+    if (column.type() != BSONType::Object) {
+        return false;
+    }
+
+    BSONColumnBuilder columnBuilder(column.fieldNameStringData());
+    uint32_t row = 0;
+    for (auto&& elem : column.Obj()) {
+        uint32_t index;
+        if (!NumberParser{}(elem.fieldNameStringData(), &index).isOK() || index < row ||
+            index >= numMeasurements) {
+            return false;
+        }
+        for (; row < index; ++row) {
+            columnBuilder.skip();
+        }
+        columnBuilder.append(elem);
+        ++row;
+    }
+
+    builder->append(column.fieldNameStringData(), columnBuilder.finalize());
+    return true;
+}
+}  // namespace
+
+boost::optional<BSONObj> compressBucket(const BSONObj& bucketDoc, StringData timeFieldName) try {
+    auto control = bucketDoc.getField(kBucketControlFieldName);
+    auto data = bucketDoc.getField(kBucketDataFieldName);
+    if (control.type() != BSONType::Object || data.type() != BSONType::Object) {
+        return boost::none;
+    }
+
+    auto version = control.Obj().getField(kBucketControlVersionFieldName);
+    if (!version.isNumber() || version.numberInt() != kTimeseriesControlDefaultVersion) {
+        return boost::none;
+    }
+
+    // The time column holds a value for every measurement, keyed by consecutive row indexes. All
+    // other columns are keyed by the same indexes but may have missing rows.
+    auto timeColumn = data.Obj().getField(timeFieldName);
+    if (timeColumn.type() != BSONType::Object) {
+        return boost::none;
+    }
+    DecimalCounter<uint32_t> numMeasurements;
+    for (auto&& elem : timeColumn.Obj()) {
+        if (elem.fieldNameStringData() != StringData(numMeasurements)) {
+            return boost::none;
+        }
+        ++numMeasurements;
+    }
+
+    BSONObjBuilder builder;
+    for (auto&& elem : bucketDoc) {
+        auto fieldName = elem.fieldNameStringData();
+        if (fieldName == kBucketControlFieldName) {
+            BSONObjBuilder controlBuilder(builder.subobjStart(kBucketControlFieldName));
+            for (auto&& controlElem : control.Obj()) {
+                if (controlElem.fieldNameStringData() == kBucketControlVersionFieldName) {
+                    controlBuilder.append(kBucketControlVersionFieldName,
+                                          kTimeseriesControlCompressedVersion);
+                } else {
+                    controlBuilder.append(controlElem);
+                }
+            }
+            controlBuilder.append(kBucketControlCountFieldName,
+                                  static_cast<int32_t>(numMeasurements));
+        } else if (fieldName == kBucketDataFieldName) {
+            BSONObjBuilder dataBuilder(builder.subobjStart(kBucketDataFieldName));
+            for (auto&& column : data.Obj()) {
+                if (!appendCompressedColumn(&dataBuilder, column, numMeasurements)) {
+                    return boost::none;
+                }
+            }
+        } else {
+            builder.append(elem);
+        }
+    }
+
+    return builder.obj();
+} catch (const DBException&) {
+    return boost::none;
+}
+
+bool isCompressedBucket(const BSONObj& bucketDoc) {
+    auto control = bucketDoc.getField(kBucketControlFieldName);
+    if (control.type() != BSONType::Object) {
+        return false;
+    }
+    auto version = control.Obj().getField(kBucketControlVersionFieldName);
+    return version.isNumber() && version.numberInt() == kTimeseriesControlCompressedVersion;
+}
+
+}  // namespace timeseries
+}  // namespace mongo
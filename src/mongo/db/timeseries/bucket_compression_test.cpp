@@ -0,0 +1,137 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/bson/util/bsoncolumn.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::timeseries {
+namespace {
+
+BSONObj uncompressedBucket() {
+    return fromjson(R"({
+    _id: {$oid: "629e1e680958e279dc29a517"},
+    control: {version: 1, min: {time: {$date: "2022-06-06T15:34:00.000Z"}, a: 1},
+              max: {time: {$date: "2022-06-06T15:34:30.000Z"}, a: 3}},
+    meta: "m",
+    data: {
+        time: {"0": {$date: "2022-06-06T15:34:00.000Z"},
+               "1": {$date: "2022-06-06T15:34:10.000Z"},
+               "2": {$date: "2022-06-06T15:34:30.000Z"}},
+        a: {"0": 1, "2": 3},
+        b: {"1": {c: "x"}}
+    }
+})");
+}
+
+// Returns all values of 'column' in order, with EOO for skipped rows.
+std::vector<BSONElement> decompressColumn(BSONColumn& column) {
+    std::vector<BSONElement> values;
+    for (auto&& elem : column) {
+        values.push_back(elem);
+    }
+    return values;
+}
+
+TEST(BucketCompressionTest, CompressesEveryColumn) {
+    auto bucket = uncompressedBucket();
+    auto compressed = compressBucket(bucket, "time"_sd);
+    ASSERT(compressed);
+    ASSERT(isCompressedBucket(*compressed));
+    ASSERT_FALSE(isCompressedBucket(bucket));
+
+    // Everything outside of the data region is preserved apart from the version.
+    ASSERT_EQ((*compressed)[kBucketIdFieldName].OID(),
+              bucket[kBucketIdFieldName].OID());
+    ASSERT_EQ((*compressed)[kBucketMetaFieldName].String(), "m");
+    auto control = (*compressed)[kBucketControlFieldName].Obj();
+    ASSERT_EQ(control[kBucketControlVersionFieldName].numberInt(),
+              kTimeseriesControlCompressedVersion);
+    ASSERT_EQ(control[kBucketControlCountFieldName].numberInt(), 3);
+    ASSERT_BSONOBJ_EQ(control[kBucketControlMinFieldName].Obj(),
+                      bucket[kBucketControlFieldName][kBucketControlMinFieldName].Obj());
+
+    auto data = (*compressed)[kBucketDataFieldName].Obj();
+    for (auto&& column : data) {
+        ASSERT_EQ(column.type(), BSONType::BinData);
+        ASSERT_EQ(column.binDataType(), BinDataType::Column);
+    }
+
+    BSONColumn time(data["time"]);
+    auto timeValues = decompressColumn(time);
+    ASSERT_EQ(timeValues.size(), 3);
+    ASSERT_EQ(timeValues[2].date(),
+              bucket[kBucketDataFieldName]["time"]["2"].date());
+
+    BSONColumn a(data["a"]);
+    auto aValues = decompressColumn(a);
+    ASSERT_EQ(aValues.size(), 3);
+    ASSERT_EQ(aValues[0].numberInt(), 1);
+    ASSERT(aValues[1].eoo());
+    ASSERT_EQ(aValues[2].numberInt(), 3);
+
+    BSONColumn b(data["b"]);
+    auto bValues = decompressColumn(b);
+    ASSERT_EQ(bValues.size(), 2);
+    ASSERT(bValues[0].eoo());
+    ASSERT_BSONOBJ_EQ(bValues[1].Obj(), BSON("c"
+                                             << "x"));
+}
+
+TEST(BucketCompressionTest, AlreadyCompressedBucketIsNotCompressedAgain) {
+    auto compressed = compressBucket(uncompressedBucket(), "time"_sd);
+    ASSERT(compressed);
+    ASSERT_FALSE(compressBucket(*compressed, "time"_sd));
+}
+
+TEST(BucketCompressionTest, InvalidRowKeysAreRejected) {
+    // Time column with a gap in its row keys.
+    ASSERT_FALSE(compressBucket(fromjson(R"({control: {version: 1}, data: {
+        time: {"0": {$date: "2022-06-06T15:34:00.000Z"}, "2": {$date: "2022-06-06T15:34:00.000Z"}}
+    }})"),
+                                "time"_sd));
+
+    // Measurement column referencing a row that is not in the time column.
+    ASSERT_FALSE(compressBucket(fromjson(R"({control: {version: 1}, data: {
+        time: {"0": {$date: "2022-06-06T15:34:00.000Z"}},
+        a: {"1": 1}
+    }})"),
+                                "time"_sd));
+
+    // Missing time column.
+    ASSERT_FALSE(compressBucket(fromjson(R"({control: {version: 1}, data: {a: {"0": 1}}})"),
+                                "time"_sd));
+}
+
+}  // namespace
+}  // namespace mongo::timeseries
@@ -315,6 +315,23 @@ MinMaxStore::MinMaxStore() {
     entry._element._max._type = Type::kObject;
 }
 
+uint64_t MinMaxStore::calculateMemUsage() const {
+    uint64_t usage = sizeof(Entry) * entries.capacity();
+    for (const auto& entry : entries) {
+        const auto& element = entry._element;
+        if (element._fieldName.capacity() > std::string().capacity()) {
+            // Only count field names that do not fit in the small string buffer.
+            usage += element._fieldName.capacity();
+        }
+        usage += element._min._value.size + element._max._value.size;
+        if (entry._fieldNameToIndex) {
+            usage += sizeof(StringMap<uint32_t>) +
+                entry._fieldNameToIndex->size() * sizeof(StringMap<uint32_t>::value_type);
+        }
+    }
+    return usage;
+}
+
 template <typename SkipFieldFn>
 void MinMax::_updateObj(MinMaxStore::Obj& obj,
                         const BSONObj& doc,
@@ -305,6 +305,12 @@ public:
         return {entries, entries.begin()};
     }
 
+    /**
+     * Approximate number of bytes of heap memory held by this store: the entries and their field
+     * names, values and lookup maps.
+     */
+    uint64_t calculateMemUsage() const;
+
 private:
     Entries entries;
 };
@@ -334,6 +340,13 @@ public:
     BSONObj minUpdates();
     BSONObj maxUpdates();
 
+    /**
+     * Approximate number of bytes of heap memory held by this MinMax.
+     */
+    uint64_t calculateMemUsage() const {
+        return _store.calculateMemUsage();
+    }
+
 private:
     // Helper for update() above to provide recursion of MinMax element together with a BSONElement
     std::pair<MinMaxStore::Iterator, MinMaxStore::Iterator> _update(
@@ -147,6 +147,25 @@ TEST(MinMax, MinMaxMixedUpdates) {
     ASSERT_BSONOBJ_EQ(minMaxObj.maxUpdates(), BSON("u" << BSON("a" << 5)));
 }
 
+TEST(MinMax, MemUsageGrowsWithFieldsAndValues) {
+    MinMax minMaxObj;
+    const auto* strCmp = &SimpleStringDataComparator::kInstance;
+    auto initial = minMaxObj.calculateMemUsage();
+
+    minMaxObj.update(BSON("a" << 1), boost::none, strCmp);
+    auto oneField = minMaxObj.calculateMemUsage();
+    ASSERT_GT(oneField, initial);
+
+    // Updating an existing value of the same size does not change the footprint.
+    minMaxObj.update(BSON("a" << 2), boost::none, strCmp);
+    ASSERT_EQ(minMaxObj.calculateMemUsage(), oneField);
+
+    // Long field names and values are accounted for.
+    std::string longName(100, 'x');
+    minMaxObj.update(BSON(longName << std::string(200, 'y')), boost::none, strCmp);
+    ASSERT_GTE(minMaxObj.calculateMemUsage(), oneField + 100 + 2 * 200);
+}
+
 TEST(MinMax, SubObjInsert) {
     MinMaxStore minmax;
     auto obj = minmax.root();
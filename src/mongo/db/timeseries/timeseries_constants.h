@@ -45,6 +45,13 @@ static constexpr StringData kBucketControlMinFieldName = "min"_sd;
 static constexpr StringData kBucketControlMaxFieldName = "max"_sd;
 static constexpr StringData kControlMaxFieldNamePrefix = "control.max."_sd;
 static constexpr StringData kControlMinFieldNamePrefix = "control.min."_sd;
+static constexpr StringData kBucketControlVersionFieldName = "version"_sd;
+static constexpr StringData kBucketControlCountFieldName = "count"_sd;
+
+// control.version of a bucket storing measurements as plain BSON objects.
+static constexpr int kTimeseriesControlDefaultVersion = 1;
+// control.version of a bucket storing measurements in BSONColumn binaries.
+static constexpr int kTimeseriesControlCompressedVersion = 2;
 
 // These are hard-coded field names in create collection for time-series collections.
 static constexpr StringData kTimeFieldName = "timeField"_sd;
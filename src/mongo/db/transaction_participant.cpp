@@ -38,6 +38,7 @@
 
 #include <fmt/format.h>
 
+#include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog/local_oplog_info.h"
@@ -265,13 +266,11 @@ void updateSessionEntry(OperationContext* opCtx, const UpdateRequest& updateRequ
     auto originalRecordData = collection->getRecordStore()->dataFor(opCtx, recordId);
     auto originalDoc = originalRecordData.toBson();
 
+    // The query is an equality on the _id, so rather than parsing it into a matcher on every
+    // write, compare the _id directly. The collection has no default collation.
     invariant(collection->getDefaultCollator() == nullptr);
-    boost::intrusive_ptr<ExpressionContext> expCtx(
-        new ExpressionContext(opCtx, nullptr, updateRequest.getNamespaceString()));
-
-    auto matcher =
-        fassert(40673, MatchExpressionParser::parse(updateRequest.getQuery(), std::move(expCtx)));
-    if (!matcher->matchesBSON(originalDoc)) {
+    dassert(updateRequest.getQuery().nFields() == 1);
+    if (!SimpleBSONElementComparator::kInstance.evaluate(originalDoc["_id"] == idToFetch)) {
         // Document no longer match what we expect so throw WCE to make the caller re-examine.
         throw WriteConflictException();
     }
@@ -1317,7 +1316,9 @@ void TransactionParticipant::Participant::commitUnpreparedTransaction(OperationC
             "commitTransaction must provide commitTimestamp to prepared transaction.",
             !o().txnState.isPrepared());
 
-    auto txnOps = retrieveCompletedTransactionOperations(opCtx);
+    // The operations are handed to the OpObserver in place. Copying them would double the memory
+    // held by a large transaction for the duration of the commit.
+    auto& txnOps = retrieveCompletedTransactionOperations(opCtx);
     auto opObserver = opCtx->getServiceContext()->getOpObserver();
     invariant(opObserver);
 
@@ -45,7 +45,8 @@ using namespace fmt::literals;
 
 namespace {
 
-const StringMap<int> retryableWriteCommands = {{"delete", 1},
+const StringMap<int> retryableWriteCommands = {{"bulkWrite", 1},
+                                               {"delete", 1},
                                                {"findandmodify", 1},
                                                {"findAndModify", 1},
                                                {"insert", 1},
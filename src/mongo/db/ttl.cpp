@@ -78,9 +78,16 @@ MONGO_FAIL_POINT_DEFINE(hangTTLMonitorWithLock);
 Counter64 ttlPasses;
 Counter64 ttlDeletedDocuments;
 
+Counter64 ttlClusteredDeleteBatches;
+Counter64 ttlDeferredForReplicationLag;
+
 ServerStatusMetricField<Counter64> ttlPassesDisplay("ttl.passes", &ttlPasses);
 ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocuments",
                                                               &ttlDeletedDocuments);
+ServerStatusMetricField<Counter64> ttlClusteredDeleteBatchesDisplay("ttl.clusteredDeleteBatches",
+                                                                    &ttlClusteredDeleteBatches);
+ServerStatusMetricField<Counter64> ttlDeferredForReplicationLagDisplay(
+    "ttl.deferredForReplicationLag", &ttlDeferredForReplicationLag);
 using MtabType = TenantMigrationAccessBlocker::BlockerType;
 
 class TTLMonitor : public BackgroundJob {
@@ -282,6 +289,11 @@ private:
             return;
         }
 
+        if (replicationLagExceedsLimit(opCtx)) {
+            ttlDeferredForReplicationLag.increment();
+            return;
+        }
+
         ResourceConsumption::ScopedMetricsCollector scopedMetrics(opCtx, nss.db().toString());
 
         const auto& collection = coll.getCollection();
@@ -296,6 +308,41 @@ private:
             info);
     }
 
+    /**
+     * Returns true if the majority commit point lags behind this node's last applied write by more
+     * than 'ttlMonitorMaxReplicationLagSecs', in which case deletes should wait for a later pass
+     * rather than add to the replication backlog.
+     */
+    bool replicationLagExceedsLimit(OperationContext* opCtx) const {
+        const auto maxLag = Seconds(ttlMonitorMaxReplicationLagSecs.load());
+        if (maxLag == Seconds(0)) {
+            return false;
+        }
+
+        auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+        if (!replCoord->isReplEnabled()) {
+            return false;
+        }
+
+        const auto lastApplied = replCoord->getMyLastAppliedOpTimeAndWallTime().wallTime;
+        const auto lastCommitted = replCoord->getLastCommittedOpTimeAndWallTime().wallTime;
+        if (lastApplied == Date_t() || lastCommitted == Date_t()) {
+            return false;
+        }
+
+        const auto lag = lastApplied - lastCommitted;
+        if (lag <= maxLag) {
+            return false;
+        }
+
+        LOGV2_DEBUG(5910900,
+                    1,
+                    "Deferring TTL deletes because of replication lag",
+                    "lag"_attr = duration_cast<Seconds>(lag),
+                    "maxLag"_attr = maxLag);
+        return true;
+    }
+
     /**
      * Generate the safe expiration date for a given collection and user-configured
      * expireAfterSeconds value.
@@ -474,24 +521,43 @@ private:
 
         const auto endId = record_id_helpers::keyForOID(endOID);
 
-        auto params = std::make_unique<DeleteStageParams>();
-        params->isMulti = true;
-
-        // Deletes records using a bounded collection scan from the beginning of time to the
-        // expiration time (inclusive).
+        // Deletes records in contiguous RecordId ranges from the beginning of time to the
+        // expiration time (inclusive). Since the RecordId of a collection clustered by _id orders
+        // records by creation time, each range starts at the oldest remaining record and spans at
+        // most 'ttlClusteredDeleteBatchSpanSecs'. Replication lag is checked between ranges.
         Timer timer;
-        auto exec =
-            InternalPlanner::deleteWithCollectionScan(opCtx,
-                                                      &collection,
-                                                      std::move(params),
-                                                      PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
-                                                      InternalPlanner::Direction::FORWARD,
-                                                      boost::none /* minRecord */,
-                                                      endId);
-
+        long long numDeleted = 0;
         try {
-            const auto numDeleted = exec->executeDelete();
-            ttlDeletedDocuments.increment(numDeleted);
+            while (true) {
+                const auto batchEndId = clusteredDeleteBatchEnd(opCtx, collection, endOID);
+
+                auto params = std::make_unique<DeleteStageParams>();
+                params->isMulti = true;
+
+                auto exec = InternalPlanner::deleteWithCollectionScan(
+                    opCtx,
+                    &collection,
+                    std::move(params),
+                    PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
+                    InternalPlanner::Direction::FORWARD,
+                    boost::none /* minRecord */,
+                    batchEndId ? *batchEndId : endId);
+
+                const auto numDeletedInBatch = exec->executeDelete();
+                numDeleted += numDeletedInBatch;
+                ttlDeletedDocuments.increment(numDeletedInBatch);
+                ttlClusteredDeleteBatches.increment();
+
+                if (!batchEndId) {
+                    break;
+                }
+
+                opCtx->checkForInterrupt();
+                if (replicationLagExceedsLimit(opCtx)) {
+                    ttlDeferredForReplicationLag.increment();
+                    break;
+                }
+            }
 
             const auto duration = Milliseconds(timer.millis());
             if (shouldLogSlowOpWithSampling(opCtx,
@@ -511,6 +577,41 @@ private:
         }
     }
 
+    /**
+     * Returns the upper bound of the next range of expired records to delete from a collection
+     * clustered by _id, or boost::none if the remaining expired records, up to 'endOID', should be
+     * deleted as a single range. Ranges are only bounded when the oldest record has an ObjectId
+     * _id, whose timestamp gives the position of the range in time.
+     */
+    boost::optional<RecordId> clusteredDeleteBatchEnd(OperationContext* opCtx,
+                                                       const CollectionPtr& collection,
+                                                       const OID& endOID) const {
+        const auto batchSpan = Seconds(ttlClusteredDeleteBatchSpanSecs.load());
+        if (batchSpan == Seconds(0)) {
+            return boost::none;
+        }
+
+        auto cursor = collection->getCursor(opCtx);
+        auto oldest = cursor->next();
+        if (!oldest) {
+            return boost::none;
+        }
+
+        const auto oldestId = record_id_helpers::toBSONAs(oldest->id, "");
+        if (oldestId.firstElement().type() != BSONType::jstOID) {
+            return boost::none;
+        }
+
+        const auto batchEndDate = oldestId.firstElement().OID().asDateT() + batchSpan;
+        if (batchEndDate >= endOID.asDateT()) {
+            return boost::none;
+        }
+
+        auto batchEndOID = OID();
+        batchEndOID.init(batchEndDate, true /* max */);
+        return record_id_helpers::keyForOID(batchEndOID);
+    }
+
     // Protects the state below.
     mutable Mutex _stateMutex = MONGO_MAKE_LATCH("TTLMonitorStateMutex");
 
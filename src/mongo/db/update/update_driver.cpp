@@ -30,6 +30,7 @@
 #include "mongo/db/update/update_driver.h"
 
 
+#include "mongo/base/checked_cast.h"
 #include "mongo/base/error_codes.h"
 #include "mongo/base/string_data.h"
 #include "mongo/bson/mutable/algorithm.h"
@@ -39,15 +40,19 @@
 #include "mongo/db/field_ref.h"
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/update/delta_executor.h"
 #include "mongo/db/update/modifier_table.h"
 #include "mongo/db/update/object_replace_executor.h"
 #include "mongo/db/update/path_support.h"
 #include "mongo/db/update/storage_validation.h"
+#include "mongo/db/update/update_leaf_node.h"
 #include "mongo/db/update/update_oplog_entry_version.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/stdx/variant.h"
 #include "mongo/util/embedded_builder.h"
+#include "mongo/util/lru_cache.h"
 #include "mongo/util/str.h"
 #include "mongo/util/visit_helper.h"
 
@@ -117,6 +122,125 @@ bool parseUpdateExpression(
     return positional;
 }
 
+/**
+ * Returns a key identifying the modifiers and paths of 'updateExpr' if its parsed form only depends
+ * on them, and boost::none otherwise. Two updates with the same key parse to trees of the same
+ * shape, whose leaves differ only in the value they were initialized with.
+ */
+boost::optional<std::string> getCacheableUpdateShape(const BSONObj& updateExpr) {
+    StringBuilder shape;
+    for (auto&& mod : updateExpr) {
+        if (mod.type() != BSONType::Object) {
+            return boost::none;
+        }
+        switch (modifiertable::getType(mod.fieldName())) {
+            case modifiertable::MOD_CURRENTDATE:
+            case modifiertable::MOD_INC:
+            case modifiertable::MOD_MAX:
+            case modifiertable::MOD_MIN:
+            case modifiertable::MOD_MUL:
+            case modifiertable::MOD_SET:
+            case modifiertable::MOD_SET_ON_INSERT:
+            case modifiertable::MOD_UNSET:
+                break;
+            default:
+                return boost::none;
+        }
+
+        shape << mod.fieldNameStringData() << '\0';
+        for (auto&& field : mod.Obj()) {
+            // Positional and array filter paths depend on the query and the array filters.
+            auto path = field.fieldNameStringData();
+            if (path.empty() || path.find('$') != std::string::npos) {
+                return boost::none;
+            }
+            shape << path << '\0';
+        }
+        shape << '\0';
+    }
+    return shape.str();
+}
+
+/**
+ * Re-initializes each leaf of 'root', which was parsed from an update with the same shape as
+ * 'updateExpr', with the corresponding value of 'updateExpr'.
+ */
+void bindUpdateValues(UpdateObjectNode* root,
+                      const BSONObj& updateExpr,
+                      const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    for (auto&& mod : updateExpr) {
+        for (auto&& field : mod.Obj()) {
+            FieldRef path(field.fieldNameStringData());
+            UpdateNode* node = root;
+            for (FieldIndex i = 0; i < path.numParts(); ++i) {
+                invariant(node->type == UpdateNode::Type::Object);
+                node = static_cast<UpdateObjectNode*>(node)->getChild(path.getPart(i).toString());
+                invariant(node);
+            }
+            invariant(node->type == UpdateNode::Type::Leaf);
+            uassertStatusOK(static_cast<UpdateLeafNode*>(node)->init(field, expCtx));
+        }
+    }
+}
+
+/**
+ * A process-wide cache of parsed update trees, keyed by getCacheableUpdateShape(). Each entry owns
+ * a copy of the update it was parsed from, so that the leaves of the cached tree stay valid.
+ */
+class ParsedUpdateCache {
+public:
+    static constexpr size_t kMaxEntries = 1000;
+
+    /**
+     * Returns a copy of the tree cached for 'shape', bound to the values of 'updateExpr', or
+     * nullptr if there is none.
+     */
+    std::unique_ptr<UpdateObjectNode> get(const std::string& shape,
+                                          const BSONObj& updateExpr,
+                                          const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+        std::unique_ptr<UpdateNode> root;
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            auto it = _entries.find(shape);
+            if (it == _entries.end()) {
+                return nullptr;
+            }
+            _entries.promote(it);
+            root = it->second.root->clone();
+        }
+        auto objectRoot = std::unique_ptr<UpdateObjectNode>(
+            checked_cast<UpdateObjectNode*>(root.release()));
+        bindUpdateValues(objectRoot.get(), updateExpr, expCtx);
+        return objectRoot;
+    }
+
+    /**
+     * Caches a copy of 'root', which was parsed from 'updateExpr', under 'shape'.
+     */
+    void add(std::string shape,
+             const BSONObj& updateExpr,
+             const UpdateObjectNode& root,
+             const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+        Entry entry{updateExpr.getOwned(), root.clone()};
+        bindUpdateValues(
+            checked_cast<UpdateObjectNode*>(entry.root.get()), entry.updateExpr, expCtx);
+
+        stdx::lock_guard<Latch> lk(_mutex);
+        _entries.add(std::move(shape), std::move(entry));
+    }
+
+private:
+    struct Entry {
+        BSONObj updateExpr;
+        std::unique_ptr<UpdateNode> root;
+    };
+
+    Mutex _mutex = MONGO_MAKE_LATCH("ParsedUpdateCache::_mutex");
+    LRUCache<std::string, Entry> _entries{kMaxEntries};
+};
+
+ParsedUpdateCache parsedUpdateCache;
+
 }  // namespace
 
 UpdateDriver::UpdateDriver(const boost::intrusive_ptr<ExpressionContext>& expCtx)
@@ -184,8 +308,23 @@ void UpdateDriver::parse(
                   static_cast<int>(UpdateOplogEntryVersion::kUpdateNodeV1));
     }
 
+    boost::optional<std::string> shape;
+    if (internalQueryCacheParsedUpdates.load() && arrayFilters.empty() && !versionElement) {
+        shape = getCacheableUpdateShape(updateExpr);
+    }
+    if (shape) {
+        if (auto root = parsedUpdateCache.get(*shape, updateExpr, _expCtx)) {
+            _updateExecutor = std::make_unique<UpdateTreeExecutor>(std::move(root));
+            return;
+        }
+    }
+
     auto root = std::make_unique<UpdateObjectNode>();
     _positional = parseUpdateExpression(updateExpr, root.get(), _expCtx, arrayFilters);
+    if (shape) {
+        invariant(!_positional);
+        parsedUpdateCache.add(std::move(*shape), updateExpr, *root, _expCtx);
+    }
     _updateExecutor = std::make_unique<UpdateTreeExecutor>(std::move(root));
 }
 
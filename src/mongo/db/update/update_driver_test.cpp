@@ -45,6 +45,7 @@
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/db/update_index_data.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 
 #define ASSERT_DOES_NOT_THROW(EXPRESSION)                                          \
@@ -203,6 +204,40 @@ TEST(Collator, SetCollationUpdatesModifierInterfaces) {
     ASSERT_TRUE(modified);
 }
 
+TEST(Parse, CachedUpdateIsBoundToTheValuesOfEachUpdate) {
+    RAIIServerParameterControllerForTest controller("internalQueryCacheParsedUpdates", true);
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+
+    auto applyUpdate = [&](const BSONObj& updateDocument) {
+        UpdateDriver driver(expCtx);
+        driver.parse(makeUpdateMod(updateDocument), arrayFilters);
+        mutablebson::Document doc(fromjson("{a: 1, b: {c: 10}, d: 'x'}"));
+        bool modified = false;
+        ASSERT_OK(driver.update(expCtx->opCtx,
+                                StringData(),
+                                &doc,
+                                true /* validateForStorage */,
+                                FieldRefSet(),
+                                false /* isInsert */,
+                                nullptr,
+                                &modified));
+        return doc.getObject();
+    };
+
+    // The second and third updates have the same shape as the first, and reuse its parsed form.
+    ASSERT_BSONOBJ_EQ(fromjson("{a: 2, b: {c: 13}}"),
+                      applyUpdate(fromjson("{$set: {a: 2}, $inc: {'b.c': 3}, $unset: {d: 1}}")));
+    ASSERT_BSONOBJ_EQ(fromjson("{a: 'y', b: {c: 5}}"),
+                      applyUpdate(fromjson("{$set: {a: 'y'}, $inc: {'b.c': -5}, $unset: {d: 1}}")));
+
+    // Each reuse still validates its own values.
+    ASSERT_THROWS_CODE(
+        applyUpdate(fromjson("{$set: {a: 3}, $inc: {'b.c': 'z'}, $unset: {d: 1}}")),
+        DBException,
+        ErrorCodes::TypeMismatch);
+}
+
 //
 // Tests of creating a base for an upsert from a query document
 // $or, $and, $all get special handling, as does the _id field
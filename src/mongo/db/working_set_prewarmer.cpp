@@ -0,0 +1,487 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/working_set_prewarmer.h"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+#include "mongo/base/data_range.h"
+#include "mongo/base/data_type_validated.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands/server_status.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/query/collection_index_usage_tracker_decoration.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/stats/top.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/db/working_set_prewarmer_gen.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/background.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+
+class WorkingSetPrewarmer;
+
+namespace {
+
+const auto getWorkingSetPrewarmer =
+    ServiceContext::declareDecoration<std::unique_ptr<WorkingSetPrewarmer>>();
+
+const std::string kWorkingSetFileName = "hotWorkingSet.bson";
+
+// Locks are released and the read rate is throttled after reading this much data.
+constexpr long long kChunkBytes = 1024 * 1024;
+
+struct PrewarmStats {
+    AtomicWord<bool> inProgress{false};
+    AtomicWord<long long> collectionsTotal{0};
+    AtomicWord<long long> collectionsWarmed{0};
+    AtomicWord<long long> bytesRead{0};
+    AtomicWord<long long> lastRecordedMillis{0};
+} prewarmStats;
+
+class WorkingSetPrewarmServerStatusSection : public ServerStatusSection {
+public:
+    WorkingSetPrewarmServerStatusSection() : ServerStatusSection("workingSetPrewarm") {}
+
+    bool includeByDefault() const override {
+        return gWorkingSetPrewarmOnStartup || gWorkingSetRecordIntervalSecs.load() > 0;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        builder.append("inProgress", prewarmStats.inProgress.load());
+        builder.append("collectionsTotal", prewarmStats.collectionsTotal.load());
+        builder.append("collectionsWarmed", prewarmStats.collectionsWarmed.load());
+        builder.append("bytesRead", prewarmStats.bytesRead.load());
+        if (auto lastRecorded = prewarmStats.lastRecordedMillis.load()) {
+            builder.appendDate("lastRecorded", Date_t::fromMillisSinceEpoch(lastRecorded));
+        }
+        return builder.obj();
+    }
+} workingSetPrewarmServerStatusSection;
+
+boost::filesystem::path workingSetFilePath() {
+    return boost::filesystem::path(storageGlobalParams.dbpath) / kWorkingSetFileName;
+}
+
+StatusWith<BSONObj> readWorkingSetFile() {
+    const auto path = workingSetFilePath();
+    std::vector<char> buffer;
+    try {
+        if (!boost::filesystem::exists(path)) {
+            return {ErrorCodes::NonExistentPath,
+                    str::stream() << "Working set file " << path.string() << " not found"};
+        }
+        buffer.resize(boost::filesystem::file_size(path));
+        std::ifstream ifs(path.c_str(), std::ios_base::in | std::ios_base::binary);
+        if (buffer.empty() || !ifs.read(buffer.data(), buffer.size())) {
+            return {ErrorCodes::FileStreamFailed,
+                    str::stream() << "Unable to read BSON data from " << path.string()};
+        }
+    } catch (const std::exception& ex) {
+        return {ErrorCodes::FileStreamFailed,
+                str::stream() << "Unexpected error reading " << path.string() << ": "
+                              << ex.what()};
+    }
+
+    auto swObj = ConstDataRange(buffer.data(), buffer.size()).readNoThrow<Validated<BSONObj>>();
+    if (!swObj.isOK()) {
+        return swObj.getStatus();
+    }
+    return swObj.getValue().val.getOwned();
+}
+
+Status writeWorkingSetFile(const BSONObj& obj) {
+    const auto path = workingSetFilePath();
+    const auto tempPath = boost::filesystem::path(path.string() + ".tmp");
+    try {
+        {
+            std::ofstream ofs(tempPath.c_str(), std::ios_base::out | std::ios_base::binary);
+            if (!ofs.write(obj.objdata(), obj.objsize())) {
+                return {ErrorCodes::FileStreamFailed,
+                        str::stream() << "Failed to write BSON data to " << tempPath.string()
+                                      << ": " << errnoWithDescription()};
+            }
+        }
+        // The file is only a hint for the next startup, so it is not flushed to disk.
+        boost::filesystem::rename(tempPath, path);
+    } catch (const std::exception& ex) {
+        return {ErrorCodes::FileRenameFailed,
+                str::stream() << "Unexpected error writing " << path.string() << ": "
+                              << ex.what()};
+    }
+    return Status::OK();
+}
+
+}  // namespace
+
+/**
+ * Keeps the hottest collections and indexes, ranked by how many operations used them with older
+ * usage decaying each interval, in a file in the dbpath. On startup, reads them back in order of
+ * hotness so that the storage engine cache holds the working set sooner than if it were filled by
+ * user reads alone.
+ */
+class WorkingSetPrewarmer : public BackgroundJob {
+public:
+    WorkingSetPrewarmer() : BackgroundJob(false /* selfDelete */) {}
+
+    static WorkingSetPrewarmer* get(ServiceContext* serviceCtx) {
+        return getWorkingSetPrewarmer(serviceCtx).get();
+    }
+
+    static void set(ServiceContext* serviceCtx, std::unique_ptr<WorkingSetPrewarmer> prewarmer) {
+        auto& workingSetPrewarmer = getWorkingSetPrewarmer(serviceCtx);
+        if (workingSetPrewarmer) {
+            invariant(!workingSetPrewarmer->running(),
+                      "Tried to reset the WorkingSetPrewarmer without shutting down the original "
+                      "instance.");
+        }
+
+        invariant(prewarmer);
+        workingSetPrewarmer = std::move(prewarmer);
+    }
+
+    std::string name() const {
+        return "WorkingSetPrewarmer";
+    }
+
+    void run() {
+        ThreadClient tc(name(), getGlobalServiceContext());
+        AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+
+        if (gWorkingSetPrewarmOnStartup) {
+            prewarm();
+        }
+
+        while (true) {
+            // Recording may be enabled at runtime, so the parameter is rechecked every so often
+            // while it is disabled.
+            const auto interval = gWorkingSetRecordIntervalSecs.load();
+            if (!waitFor(Seconds(interval > 0 ? interval : 10))) {
+                break;
+            }
+            if (interval > 0 && !storageGlobalParams.readOnly) {
+                record();
+            }
+        }
+
+        // Record once more on shutdown, so the next startup prewarms the latest working set.
+        if (gWorkingSetRecordIntervalSecs.load() > 0 && !storageGlobalParams.readOnly) {
+            record();
+        }
+    }
+
+    /**
+     * Signals the thread to quit and then waits until it does.
+     */
+    void shutdown() {
+        {
+            stdx::lock_guard<Latch> lk(_stateMutex);
+            _shuttingDown = true;
+            _shuttingDownCV.notify_one();
+        }
+        wait();
+    }
+
+private:
+    /**
+     * Waits for 'duration' and returns true, or returns false as soon as shutdown is requested.
+     */
+    bool waitFor(Milliseconds duration) {
+        stdx::unique_lock<Latch> lk(_stateMutex);
+        MONGO_IDLE_THREAD_BLOCK;
+        _shuttingDownCV.wait_for(lk, duration.toSystemDuration(), [&] { return _shuttingDown; });
+        return !_shuttingDown;
+    }
+
+    void record() {
+        const auto opCtx = cc().makeOperationContext();
+
+        Top::UsageMap usage;
+        Top::get(opCtx->getServiceContext()).cloneMap(usage);
+
+        // Usage decays by half every interval, so collections used recently rank first.
+        for (auto it = _hotness.begin(); it != _hotness.end();) {
+            if ((it->second /= 2) == 0) {
+                _hotness.erase(it++);
+            } else {
+                ++it;
+            }
+        }
+        for (auto&& [ns, data] : usage) {
+            auto& lastCount = _lastUsageCounts[ns];
+            _hotness[ns] += std::max(0LL, data.total.count - lastCount);
+            lastCount = data.total.count;
+        }
+
+        std::vector<std::pair<long long, std::string>> ranked;
+        for (auto&& [ns, hotness] : _hotness) {
+            if (hotness > 0) {
+                ranked.emplace_back(hotness, ns);
+            }
+        }
+        std::sort(ranked.begin(), ranked.end(), std::greater<>());
+
+        const auto catalog = CollectionCatalog::get(opCtx.get());
+        const size_t maxCollections = gWorkingSetRecordMaxCollections.load();
+        BSONObjBuilder builder;
+        builder.appendDate("recorded", Date_t::now());
+        BSONArrayBuilder collectionsBuilder(builder.subarrayStart("collections"));
+        size_t numCollections = 0;
+        for (auto&& [hotness, ns] : ranked) {
+            if (numCollections == maxCollections) {
+                break;
+            }
+
+            const NamespaceString nss(ns);
+            if (nss.isOnInternalDb()) {
+                continue;
+            }
+            auto collection = catalog->lookupCollectionByNamespaceForRead(opCtx.get(), nss);
+            if (!collection) {
+                continue;
+            }
+
+            // Indexes are ranked by how many operations used them since the collection was loaded.
+            std::vector<std::pair<long long, std::string>> indexes;
+            auto indexUsage =
+                CollectionIndexUsageTrackerDecoration::get(collection->getSharedDecorations())
+                    .getUsageStats();
+            for (auto&& [indexName, stats] : *indexUsage) {
+                if (auto accesses = stats->accesses.load()) {
+                    indexes.emplace_back(accesses, indexName);
+                }
+            }
+            std::sort(indexes.begin(), indexes.end(), std::greater<>());
+
+            BSONObjBuilder collectionBuilder(collectionsBuilder.subobjStart());
+            collectionBuilder.append("ns", ns);
+            collection->uuid().appendToBuilder(&collectionBuilder, "uuid");
+            collectionBuilder.append("hotness", hotness);
+            BSONArrayBuilder indexesBuilder(collectionBuilder.subarrayStart("indexes"));
+            for (auto&& index : indexes) {
+                indexesBuilder.append(index.second);
+            }
+            indexesBuilder.done();
+            collectionBuilder.done();
+            ++numCollections;
+        }
+        collectionsBuilder.done();
+
+        auto status = writeWorkingSetFile(builder.obj());
+        if (!status.isOK()) {
+            LOGV2_WARNING(5910912, "Failed to record the working set", "error"_attr = status);
+            return;
+        }
+        prewarmStats.lastRecordedMillis.store(Date_t::now().toMillisSinceEpoch());
+    }
+
+    void prewarm() {
+        auto swWorkingSet = readWorkingSetFile();
+        if (!swWorkingSet.isOK()) {
+            LOGV2(5910913,
+                  "Not prewarming the working set",
+                  "reason"_attr = swWorkingSet.getStatus());
+            return;
+        }
+
+        const auto collections = swWorkingSet.getValue()["collections"];
+        if (collections.type() != Array) {
+            return;
+        }
+
+        prewarmStats.inProgress.store(true);
+        ON_BLOCK_EXIT([&] { prewarmStats.inProgress.store(false); });
+        prewarmStats.collectionsTotal.store(collections.Obj().nFields());
+
+        LOGV2(5910914,
+              "Prewarming the working set",
+              "collections"_attr = collections.Obj().nFields());
+        const auto opCtx = cc().makeOperationContext();
+        for (auto&& entry : collections.Obj()) {
+            if (_isShuttingDown() || _budgetExhausted()) {
+                break;
+            }
+            if (entry.type() != Object) {
+                continue;
+            }
+
+            const auto ns = entry["ns"];
+            auto uuid = UUID::parse(entry["uuid"]);
+            if (ns.type() != String || !uuid.isOK()) {
+                continue;
+            }
+
+            const NamespaceString nss(ns.valueStringData());
+            const NamespaceStringOrUUID nsOrUUID(nss.db().toString(), uuid.getValue());
+            try {
+                for (auto&& indexName : entry["indexes"].Array()) {
+                    _prewarmIndex(opCtx.get(), nsOrUUID, indexName.String());
+                }
+                _prewarmRecords(opCtx.get(), nsOrUUID);
+            } catch (const DBException& ex) {
+                LOGV2_DEBUG(5910915,
+                            1,
+                            "Skipping prewarming of collection",
+                            "namespace"_attr = ns.valueStringData(),
+                            "error"_attr = ex.toStatus());
+            }
+            prewarmStats.collectionsWarmed.fetchAndAdd(1);
+        }
+
+        LOGV2(5910916,
+              "Finished prewarming the working set",
+              "collectionsWarmed"_attr = prewarmStats.collectionsWarmed.load(),
+              "bytesRead"_attr = prewarmStats.bytesRead.load());
+    }
+
+    void _prewarmIndex(OperationContext* opCtx,
+                       const NamespaceStringOrUUID& nsOrUUID,
+                       const std::string& indexName) {
+        boost::optional<KeyString::Value> resumeKey;
+        bool exhausted = false;
+        while (!exhausted && !_isShuttingDown() && !_budgetExhausted()) {
+            long long chunkBytes = 0;
+            {
+                AutoGetCollection coll(opCtx, nsOrUUID, MODE_IS);
+                if (!coll) {
+                    return;
+                }
+                auto indexCatalog = coll->getIndexCatalog();
+                auto desc = indexCatalog->findIndexByName(opCtx, indexName);
+                if (!desc) {
+                    return;
+                }
+
+                auto sdi = indexCatalog->getEntry(desc)->accessMethod()->getSortedDataInterface();
+                if (!resumeKey) {
+                    resumeKey = KeyString::Builder(sdi->getKeyStringVersion(),
+                                                   BSONObj(),
+                                                   sdi->getOrdering(),
+                                                   KeyString::Discriminator::kExclusiveBefore)
+                                    .getValueCopy();
+                }
+
+                auto cursor = sdi->newCursor(opCtx);
+                auto entry = cursor->seekForKeyString(*resumeKey);
+                for (; entry && chunkBytes < kChunkBytes; entry = cursor->nextKeyString()) {
+                    chunkBytes += entry->keyString.getSize();
+                    resumeKey = entry->keyString;
+                }
+                exhausted = !entry;
+            }
+            _finishChunk(opCtx, chunkBytes);
+        }
+    }
+
+    void _prewarmRecords(OperationContext* opCtx, const NamespaceStringOrUUID& nsOrUUID) {
+        boost::optional<RecordId> resumeId;
+        bool exhausted = false;
+        while (!exhausted && !_isShuttingDown() && !_budgetExhausted()) {
+            long long chunkBytes = 0;
+            {
+                AutoGetCollection coll(opCtx, nsOrUUID, MODE_IS);
+                if (!coll) {
+                    return;
+                }
+
+                auto cursor = coll->getCursor(opCtx);
+                auto record = resumeId ? cursor->seekNear(*resumeId) : cursor->next();
+                for (; record && chunkBytes < kChunkBytes; record = cursor->next()) {
+                    chunkBytes += record->data.size();
+                    resumeId = record->id;
+                }
+                exhausted = !record;
+            }
+            _finishChunk(opCtx, chunkBytes);
+        }
+    }
+
+    /**
+     * Releases the snapshot of a chunk read without holding locks and waits long enough to keep to
+     * the configured read rate.
+     */
+    void _finishChunk(OperationContext* opCtx, long long chunkBytes) {
+        opCtx->recoveryUnit()->abandonSnapshot();
+        prewarmStats.bytesRead.fetchAndAdd(chunkBytes);
+        waitFor(Milliseconds(chunkBytes * 1000 / gWorkingSetPrewarmMaxBytesPerSec.load()));
+    }
+
+    bool _budgetExhausted() const {
+        return prewarmStats.bytesRead.load() >= gWorkingSetPrewarmMaxMB.load() * 1024 * 1024;
+    }
+
+    bool _isShuttingDown() {
+        stdx::lock_guard<Latch> lk(_stateMutex);
+        return _shuttingDown;
+    }
+
+    // Protects the state below.
+    Mutex _stateMutex = MONGO_MAKE_LATCH("WorkingSetPrewarmer::_stateMutex");
+
+    // The prewarmer thread idles on this condition variable between chunks and recordings. It can
+    // be triggered early to expedite shutdown.
+    stdx::condition_variable _shuttingDownCV;
+    bool _shuttingDown = false;
+
+    // Only accessed by the prewarmer thread.
+    StringMap<long long> _hotness;
+    StringMap<long long> _lastUsageCounts;
+};
+
+void startWorkingSetPrewarmer(ServiceContext* serviceContext) {
+    auto prewarmer = std::make_unique<WorkingSetPrewarmer>();
+    prewarmer->go();
+    WorkingSetPrewarmer::set(serviceContext, std::move(prewarmer));
+}
+
+void shutdownWorkingSetPrewarmer(ServiceContext* serviceContext) {
+    // The prewarmer may not be set if shutdown occurs before it has been started.
+    if (auto prewarmer = WorkingSetPrewarmer::get(serviceContext)) {
+        prewarmer->shutdown();
+    }
+}
+
+}  // namespace mongo
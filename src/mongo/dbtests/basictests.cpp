@@ -33,6 +33,7 @@
 
 #include "mongo/db/client.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/base64.h"
 #include "mongo/util/queue.h"
 #include "mongo/util/str.h"
@@ -334,6 +335,35 @@ public:
     }
 };
 
+class QueueWaitForSpaceTest {
+public:
+    void run() {
+        BlockingQueue<int> q(3);
+        std::vector<int> batch{1, 2, 3};
+        q.pushAllBlocking(batch.begin(), batch.end());
+
+        // The producer needs room for two items, so it must not finish until two have been popped.
+        AtomicWord<bool> pushed{false};
+        stdx::thread producer([&] {
+            std::vector<int> next{4, 5};
+            q.pushAllBlocking(next.begin(), next.end());
+            pushed.store(true);
+        });
+
+        int x;
+        ASSERT(q.tryPop(x));
+        ASSERT_EQUALS(1, x);
+        sleepmillis(50);
+        ASSERT(!pushed.load());
+
+        ASSERT(q.tryPop(x));
+        ASSERT_EQUALS(2, x);
+        producer.join();
+        ASSERT(pushed.load());
+        ASSERT_EQUALS(3u, q.count());
+    }
+};
+
 class StrTests {
 public:
     void run() {
@@ -375,6 +405,7 @@ public:
         add<IsValidUTF8Test>();
 
         add<QueueTest>();
+        add<QueueWaitForSpaceTest>();
 
         add<StrTests>();
 
@@ -44,6 +44,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbdirectclient.h"
+#include "mongo/db/exec/and_bitmap.h"
 #include "mongo/db/exec/and_hash.h"
 #include "mongo/db/exec/and_sorted.h"
 #include "mongo/db/exec/fetch.h"
@@ -82,6 +83,34 @@ public:
         return indexes[0];
     }
 
+    /**
+     * Returns the bounds of a scan over the values of 'field' within [lower, upper].
+     */
+    IndexBounds makeIntervalBounds(StringData field, int lower, int upper) {
+        OrderedIntervalList oil(field.toString());
+        oil.intervals.push_back(Interval(BSON("" << lower << "" << upper), true, true));
+        IndexBounds bounds;
+        bounds.fields.push_back(oil);
+        return bounds;
+    }
+
+    /**
+     * Adds a scan of the index on 'field' over [lower, upper] to 'ab'.
+     */
+    void addBitmapChild(AndBitmapStage* ab,
+                        WorkingSet* ws,
+                        const CollectionPtr& coll,
+                        StringData field,
+                        int lower,
+                        int upper) {
+        auto descriptor = getIndex(BSON(field << 1), coll);
+        IndexScanParams params(&_opCtx, coll, descriptor);
+        params.bounds = makeIntervalBounds(field, lower, upper);
+        auto bounds = params.bounds;
+        ab->addChild(std::make_unique<IndexScan>(_expCtx.get(), coll, params, ws, nullptr),
+                     {descriptor, std::move(bounds), 1});
+    }
+
     IndexScanParams makeIndexScanParams(OperationContext* opCtx,
                                         const CollectionPtr& collection,
                                         const IndexDescriptor* descriptor) {
@@ -108,6 +137,10 @@ public:
         _client.remove(ns(), obj);
     }
 
+    void update(const BSONObj& query, const BSONObj& updateSpec) {
+        _client.update(ns(), query, updateSpec);
+    }
+
     /**
      * Executes plan stage until EOF.  Returns number of results seen if execution reaches EOF
      * successfully. Throws on stage failure.
@@ -1323,6 +1356,158 @@ public:
 };
 
 
+//
+// Bitmap AND tests
+//
+
+// An AND_BITMAP fetches the documents produced by all of its children.
+class QueryStageAndBitmapTwoLeaf : public QueryStageAndBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+        Database* db = ctx.db();
+        CollectionPtr coll = ctx.getCollection();
+        if (!coll) {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll = db->createCollection(&_opCtx, nss());
+            wuow.commit();
+        }
+
+        for (int i = 0; i < 50; ++i) {
+            insert(BSON("foo" << i << "bar" << i));
+        }
+
+        addIndex(BSON("foo" << 1));
+        addIndex(BSON("bar" << 1));
+
+        WorkingSet ws;
+        auto ab = std::make_unique<AndBitmapStage>(_expCtx.get(), &ws, nullptr, coll);
+
+        // foo in [0, 20] and bar in [10, 49].
+        addBitmapChild(ab.get(), &ws, coll, "foo", 0, 20);
+        addBitmapChild(ab.get(), &ws, coll, "bar", 10, 49);
+
+        set<int> seen;
+        while (!ab->isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            if (PlanStage::ADVANCED != ab->work(&id)) {
+                continue;
+            }
+            WorkingSetMember* member = ws.get(id);
+            ASSERT_TRUE(member->hasObj());
+            auto doc = member->doc.value().toBson();
+            ASSERT_EQUALS(doc["foo"].numberInt(), doc["bar"].numberInt());
+            seen.insert(doc["foo"].numberInt());
+        }
+
+        ASSERT_EQUALS(11U, seen.size());
+        ASSERT_EQUALS(10, *seen.begin());
+        ASSERT_EQUALS(20, *seen.rbegin());
+
+        auto stats = static_cast<const AndBitmapStats*>(ab->getSpecificStats());
+        ASSERT_EQUALS(2U, stats->bitmapAfterChild.size());
+        ASSERT_EQUALS(21U, stats->bitmapAfterChild[0]);
+        ASSERT_EQUALS(11U, stats->bitmapAfterChild[1]);
+        ASSERT_EQUALS(11U, stats->docsExamined);
+        ASSERT_EQUALS(0U, stats->docsFailedRevalidation);
+    }
+};
+
+// An AND_BITMAP whose intersection is empty after the first children doesn't read the others.
+class QueryStageAndBitmapProducesNothing : public QueryStageAndBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+        Database* db = ctx.db();
+        CollectionPtr coll = ctx.getCollection();
+        if (!coll) {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll = db->createCollection(&_opCtx, nss());
+            wuow.commit();
+        }
+
+        for (int i = 0; i < 50; ++i) {
+            insert(BSON("foo" << i << "bar" << i << "baz" << i));
+        }
+
+        addIndex(BSON("foo" << 1));
+        addIndex(BSON("bar" << 1));
+        addIndex(BSON("baz" << 1));
+
+        WorkingSet ws;
+        auto ab = std::make_unique<AndBitmapStage>(_expCtx.get(), &ws, nullptr, coll);
+
+        addBitmapChild(ab.get(), &ws, coll, "foo", 0, 9);
+        addBitmapChild(ab.get(), &ws, coll, "bar", 10, 19);
+        addBitmapChild(ab.get(), &ws, coll, "baz", 0, 49);
+
+        ASSERT_EQUALS(0, countResults(ab.get()));
+
+        auto stats = ab->getStats();
+        auto specific = static_cast<const AndBitmapStats*>(stats->specific.get());
+        ASSERT_EQUALS(2U, specific->bitmapAfterChild.size());
+        ASSERT_EQUALS(0U, specific->bitmapAfterChild[1]);
+        ASSERT_EQUALS(0U, stats->children[2]->common.advanced);
+    }
+};
+
+// A document which no longer matches the bounds of a child after a yield is not returned.
+class QueryStageAndBitmapUpdateDuringYield : public QueryStageAndBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+        Database* db = ctx.db();
+        CollectionPtr coll = ctx.getCollection();
+        if (!coll) {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll = db->createCollection(&_opCtx, nss());
+            wuow.commit();
+        }
+
+        for (int i = 0; i < 50; ++i) {
+            insert(BSON("foo" << i << "bar" << i));
+        }
+
+        addIndex(BSON("foo" << 1));
+        addIndex(BSON("bar" << 1));
+
+        WorkingSet ws;
+        auto ab = std::make_unique<AndBitmapStage>(_expCtx.get(), &ws, nullptr, coll);
+
+        // foo in [0, 20] and bar in [10, 49].
+        addBitmapChild(ab.get(), &ws, coll, "foo", 0, 20);
+        addBitmapChild(ab.get(), &ws, coll, "bar", 10, 49);
+
+        // Read both children without fetching anything.
+        auto stats = static_cast<const AndBitmapStats*>(ab->getSpecificStats());
+        while (stats->bitmapAfterChild.size() < 2) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            ASSERT_EQUALS(PlanStage::NEED_TIME, ab->work(&id));
+        }
+
+        // Yield, and move one of the buffered documents out of the bounds of the scan over foo.
+        ab->saveState();
+        _opCtx.recoveryUnit()->abandonSnapshot();
+        update(BSON("foo" << 15), BSON("$set" << BSON("foo" << 100)));
+        ab->restoreState(&coll);
+
+        set<int> seen;
+        while (!ab->isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            if (PlanStage::ADVANCED != ab->work(&id)) {
+                continue;
+            }
+            seen.insert(ws.get(id)->doc.value().toBson()["bar"].numberInt());
+        }
+
+        ASSERT_EQUALS(10U, seen.size());
+        ASSERT_EQUALS(0U, seen.count(15));
+        ASSERT_EQUALS(11U, stats->docsExamined);
+        ASSERT_EQUALS(1U, stats->docsFailedRevalidation);
+    }
+};
+
+
 class All : public OldStyleSuiteSpecification {
 public:
     All() : OldStyleSuiteSpecification("query_stage_and") {}
@@ -1340,6 +1525,9 @@ public:
         add<QueryStageAndHashFirstChildFetched>();
         add<QueryStageAndHashSecondChildFetched>();
         add<QueryStageAndHashDeadChild>();
+        add<QueryStageAndBitmapTwoLeaf>();
+        add<QueryStageAndBitmapProducesNothing>();
+        add<QueryStageAndBitmapUpdateDuringYield>();
         add<QueryStageAndSortedDeleteDuringYield>();
         add<QueryStageAndSortedThreeLeaf>();
         add<QueryStageAndSortedWithNothing>();
@@ -789,4 +789,50 @@ TEST_F(QueryStageCollectionScanTest, QueryTestCollscanClusteredInnerRangeExclusi
 
     ASSERT_EQ(count, expectedIds.size());
 }
+
+TEST_F(QueryStageCollectionScanTest, QueryTestCollscanInnerRangeForward) {
+    vector<RecordId> recordIds;
+    {
+        AutoGetCollectionForRead autoColl(&_opCtx, nss);
+        getRecordIds(autoColl.getCollection(), CollectionScanParams::FORWARD, &recordIds);
+    }
+    ASSERT_EQ(recordIds.size(), numObj());
+
+    // Remove the records at both bounds, so that the scan has to seek to a RecordId which no longer
+    // exists and must not return the record just before it.
+    const int startOffset = 10;
+    const int endOffset = 20;
+    remove(BSON("foo" << startOffset));
+    remove(BSON("foo" << endOffset));
+
+    AutoGetCollectionForRead autoColl(&_opCtx, nss);
+    const CollectionPtr& coll = autoColl.getCollection();
+    ASSERT(!coll->isClustered());
+
+    CollectionScanParams params;
+    params.direction = CollectionScanParams::FORWARD;
+    params.tailable = false;
+    params.minRecord = recordIds[startOffset];
+    params.maxRecord = recordIds[endOffset];
+
+    WorkingSet ws;
+    auto scan = std::make_unique<CollectionScan>(_expCtx.get(), coll, params, &ws, nullptr);
+
+    std::vector<RecordId> expectedIds{recordIds.begin() + startOffset + 1,
+                                      recordIds.begin() + endOffset};
+    int count = 0;
+    while (!scan->isEOF()) {
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        PlanStage::StageState state = scan->work(&id);
+        if (PlanStage::ADVANCED == state) {
+            WorkingSetMember* member = ws.get(id);
+            ASSERT(member->hasRecordId());
+            ASSERT_LT(count, expectedIds.size());
+            ASSERT_EQ(member->recordId, expectedIds[count]);
+            count++;
+        }
+    }
+
+    ASSERT_EQ(count, expectedIds.size());
+}
 }  // namespace query_stage_collection_scan
@@ -322,6 +322,19 @@ public:
      */
     size_t requestsPending() const;
 
+    /**
+     * Returns how long the requests served by this pool waited for their connection.
+     */
+    const ConnectionWaitTimeHistogram& acquisitionWaitTimes() const {
+        return _acquisitionWaitTimes;
+    }
+
+    /**
+     * Marks the pool as active without any request, so that it keeps the connections targeted by
+     * its controller until the host timeout passes.
+     */
+    void markActive();
+
     /**
      * Returns the HostAndPort for this pool.
      */
@@ -354,10 +367,14 @@ private:
     using OwnedConnection = std::shared_ptr<ConnectionInterface>;
     using OwnershipPool = stdx::unordered_map<ConnectionInterface*, OwnedConnection>;
     using LRUOwnershipPool = LRUCache<OwnershipPool::key_type, OwnershipPool::mapped_type>;
-    using Request = std::pair<Date_t, Promise<ConnectionHandle>>;
+    struct Request {
+        Date_t expiration;
+        Date_t requestedAt;
+        Promise<ConnectionHandle> promise;
+    };
     struct RequestComparator {
         bool operator()(const Request& a, const Request& b) {
-            return a.first > b.first;
+            return a.expiration > b.expiration;
         }
     };
 
@@ -428,6 +445,8 @@ private:
 
     size_t _created = 0;
 
+    ConnectionWaitTimeHistogram _acquisitionWaitTimes;
+
     transport::Session::TagMask _tags = transport::Session::kPending;
 
     HostHealth _health;
@@ -484,6 +503,7 @@ void ConnectionPool::shutdown() {
     // Grab all current pools (under the lock)
     auto pools = [&] {
         stdx::lock_guard lk(_mutex);
+        _isShutdown = true;
         return _pools;
     }();
 
@@ -551,6 +571,23 @@ void ConnectionPool::get_forTest(const HostAndPort& hostAndPort,
     _factory->getExecutor()->schedule(std::move(getConnectionFunc));
 }
 
+void ConnectionPool::prewarm(const HostAndPort& hostAndPort, transport::ConnectSSLMode sslMode) {
+    stdx::lock_guard lk(_mutex);
+    if (_isShutdown) {
+        return;
+    }
+
+    auto& pool = _pools[hostAndPort];
+    if (pool) {
+        return;
+    }
+
+    LOGV2_DEBUG(6000130, 2, "Prewarming connection pool", "hostAndPort"_attr = hostAndPort);
+    pool = SpecificPool::make(shared_from_this(), hostAndPort, sslMode);
+    pool->markActive();
+    pool->updateState();
+}
+
 SemiFuture<ConnectionPool::ConnectionHandle> ConnectionPool::get(const HostAndPort& hostAndPort,
                                                                  transport::ConnectSSLMode sslMode,
                                                                  Milliseconds timeout) {
@@ -583,6 +620,7 @@ void ConnectionPool::appendConnectionStats(ConnectionPoolStats* stats) const {
                                      pool->availableConnections(),
                                      pool->createdConnections(),
                                      pool->refreshingConnections()};
+        hostStats.acquisitionWaitTimes = pool->acquisitionWaitTimes();
         stats->updateStatsForHost(_name, host, hostStats);
     }
 }
@@ -642,6 +680,10 @@ size_t ConnectionPool::SpecificPool::requestsPending() const {
     return _requests.size();
 }
 
+void ConnectionPool::SpecificPool::markActive() {
+    _lastActiveTime = _parent->_factory->now();
+}
+
 Future<ConnectionPool::ConnectionHandle> ConnectionPool::SpecificPool::getConnection(
     Milliseconds timeout) {
 
@@ -659,6 +701,7 @@ Future<ConnectionPool::ConnectionHandle> ConnectionPool::SpecificPool::getConnec
                         "Using existing idle connection to {hostAndPort}",
                         "Using existing idle connection",
                         "hostAndPort"_attr = _hostAndPort);
+            _acquisitionWaitTimes.increment(Milliseconds(0));
             return Future<ConnectionPool::ConnectionHandle>::makeReady(std::move(conn));
         }
     }
@@ -677,7 +720,7 @@ Future<ConnectionPool::ConnectionHandle> ConnectionPool::SpecificPool::getConnec
     const auto expiration = now + timeout;
     auto pf = makePromiseFuture<ConnectionHandle>();
 
-    _requests.push_back(make_pair(expiration, std::move(pf.promise)));
+    _requests.push_back(Request{expiration, now, std::move(pf.promise)});
     std::push_heap(begin(_requests), end(_requests), RequestComparator{});
 
     return std::move(pf.future);
@@ -954,7 +997,7 @@ void ConnectionPool::SpecificPool::processFailure(const Status& status) {
     }
 
     for (auto& request : _requests) {
-        request.second.setError(status);
+        request.promise.setError(status);
     }
 
     LOGV2_DEBUG(22573,
@@ -969,7 +1012,8 @@ void ConnectionPool::SpecificPool::processFailure(const Status& status) {
 void ConnectionPool::SpecificPool::fulfillRequests() {
     while (_requests.size()) {
         // Marking this as our newest active time
-        _lastActiveTime = _parent->_factory->now();
+        const auto now = _parent->_factory->now();
+        _lastActiveTime = now;
 
         // Caution: If this returns with a value, it's important that we not throw until we've
         // emplaced the promise (as returning a connection would attempt to take the lock and would
@@ -983,7 +1027,9 @@ void ConnectionPool::SpecificPool::fulfillRequests() {
         }
 
         // Grab the request and callback
-        auto promise = std::move(_requests.front().second);
+        auto promise = std::move(_requests.front().promise);
+        _acquisitionWaitTimes.increment(
+            duration_cast<Milliseconds>(now - _requests.front().requestedAt));
         std::pop_heap(begin(_requests), end(_requests), RequestComparator{});
         _requests.pop_back();
 
@@ -1117,8 +1163,8 @@ void ConnectionPool::SpecificPool::updateEventTimer() {
     }
 
     // If a request would timeout before the next event, then it is the next event
-    if (_requests.size() && (_requests.front().first < nextEventTime)) {
-        nextEventTime = _requests.front().first;
+    if (_requests.size() && (_requests.front().expiration < nextEventTime)) {
+        nextEventTime = _requests.front().expiration;
     }
 
     // If our timer is already set to the next event, then we're done
@@ -1138,12 +1184,12 @@ void ConnectionPool::SpecificPool::updateEventTimer() {
 
         _health.isFailed = false;
 
-        while (_requests.size() && (_requests.front().first <= now)) {
+        while (_requests.size() && (_requests.front().expiration <= now)) {
             std::pop_heap(begin(_requests), end(_requests), RequestComparator{});
 
             auto& request = _requests.back();
-            request.second.setError(Status(ErrorCodes::NetworkInterfaceExceededTimeLimit,
-                                           "Couldn't get a connection within the time limit"));
+            request.promise.setError(Status(ErrorCodes::NetworkInterfaceExceededTimeLimit,
+                                            "Couldn't get a connection within the time limit"));
             _requests.pop_back();
 
             // Since we've failed a request, we've interacted with external users
@@ -255,6 +255,13 @@ public:
     SemiFuture<ConnectionHandle> get(const HostAndPort& hostAndPort,
                                      transport::ConnectSSLMode sslMode,
                                      Milliseconds timeout);
+    /**
+     * Creates the pool for 'hostAndPort' if it does not exist yet, so that it establishes the
+     * connections targeted by its controller before the first request for it arrives. Does
+     * nothing once this ConnectionPool has been shut down.
+     */
+    void prewarm(const HostAndPort& hostAndPort, transport::ConnectSSLMode sslMode);
+
     void get_forTest(const HostAndPort& hostAndPort,
                      Milliseconds timeout,
                      GetConnectionCallback cb);
@@ -280,6 +287,7 @@ private:
         MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(1), "ExecutorConnectionPool::_mutex");
     PoolId _nextPoolId = 0;
     stdx::unordered_map<HostAndPort, std::shared_ptr<SpecificPool>> _pools;
+    bool _isShutdown = false;
 
     EgressTagCloserManager* _manager;
 };
@@ -31,11 +31,42 @@
 
 #include "mongo/executor/connection_pool_stats.h"
 
+#include <algorithm>
+#include <fmt/format.h>
+
 #include "mongo/bson/bsonobjbuilder.h"
 
 namespace mongo {
 namespace executor {
 
+using namespace fmt::literals;
+
+void ConnectionWaitTimeHistogram::increment(Milliseconds waitTime) {
+    auto it = std::upper_bound(kBucketUpperBounds.begin(), kBucketUpperBounds.end(), waitTime);
+    ++_counts[it - kBucketUpperBounds.begin()];
+}
+
+ConnectionWaitTimeHistogram& ConnectionWaitTimeHistogram::operator+=(
+    const ConnectionWaitTimeHistogram& other) {
+    for (size_t bucket = 0; bucket < kNumBuckets; ++bucket) {
+        _counts[bucket] += other._counts[bucket];
+    }
+    return *this;
+}
+
+void ConnectionWaitTimeHistogram::appendToBSON(BSONObjBuilder& builder) const {
+    Milliseconds lowerBound{0};
+    for (size_t bucket = 0; bucket < kNumBuckets; ++bucket) {
+        auto name = bucket < kBucketUpperBounds.size()
+            ? "{}-{}ms"_format(lowerBound.count(), kBucketUpperBounds[bucket].count())
+            : "{}ms+"_format(lowerBound.count());
+        builder.appendNumber(name, static_cast<long long>(_counts[bucket]));
+        if (bucket < kBucketUpperBounds.size()) {
+            lowerBound = kBucketUpperBounds[bucket];
+        }
+    }
+}
+
 ConnectionStatsPer::ConnectionStatsPer(size_t nInUse,
                                        size_t nAvailable,
                                        size_t nCreated,
@@ -49,6 +80,7 @@ ConnectionStatsPer& ConnectionStatsPer::operator+=(const ConnectionStatsPer& oth
     available += other.available;
     created += other.created;
     refreshing += other.refreshing;
+    acquisitionWaitTimes += other.acquisitionWaitTimes;
 
     return *this;
 }
@@ -111,6 +143,10 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result, bool forFT
             poolInfo.appendNumber("poolAvailable", static_cast<long long>(poolStats.available));
             poolInfo.appendNumber("poolCreated", static_cast<long long>(poolStats.created));
             poolInfo.appendNumber("poolRefreshing", static_cast<long long>(poolStats.refreshing));
+            {
+                BSONObjBuilder waitTimesBuilder(poolInfo.subobjStart("acquisitionWaitTimes"));
+                poolStats.acquisitionWaitTimes.appendToBSON(waitTimesBuilder);
+            }
 
             for (const auto& host : poolStats.statsByHost) {
                 BSONObjBuilder hostInfo(poolInfo.subobjStart(host.first.toString()));
@@ -131,6 +167,8 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result, bool forFT
             hostInfo.appendNumber("available", static_cast<long long>(hostStats.available));
             hostInfo.appendNumber("created", static_cast<long long>(hostStats.created));
             hostInfo.appendNumber("refreshing", static_cast<long long>(hostStats.refreshing));
+            BSONObjBuilder waitTimesBuilder(hostInfo.subobjStart("acquisitionWaitTimes"));
+            hostStats.acquisitionWaitTimes.appendToBSON(waitTimesBuilder);
         }
     }
 }
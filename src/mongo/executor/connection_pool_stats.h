@@ -29,13 +29,51 @@
 
 #pragma once
 
+#include <array>
+
 #include "mongo/s/sharding_task_executor_pool_controller.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/util/duration.h"
 #include "mongo/util/net/hostandport.h"
 
 namespace mongo {
 namespace executor {
 
+/**
+ * Counts the connection requests of a pool by how long they waited for a connection to be handed
+ * out. Requests served by an idle connection fall in the first bucket.
+ */
+class ConnectionWaitTimeHistogram {
+public:
+    // Exclusive upper bounds of the buckets. The last bucket has no upper bound.
+    static constexpr std::array<Milliseconds, 9> kBucketUpperBounds{Milliseconds(1),
+                                                                    Milliseconds(5),
+                                                                    Milliseconds(10),
+                                                                    Milliseconds(20),
+                                                                    Milliseconds(50),
+                                                                    Milliseconds(100),
+                                                                    Milliseconds(200),
+                                                                    Milliseconds(500),
+                                                                    Milliseconds(1000)};
+    static constexpr size_t kNumBuckets = kBucketUpperBounds.size() + 1;
+
+    void increment(Milliseconds waitTime);
+
+    ConnectionWaitTimeHistogram& operator+=(const ConnectionWaitTimeHistogram& other);
+
+    size_t getCount(size_t bucket) const {
+        return _counts[bucket];
+    }
+
+    /**
+     * Appends one field per bucket, named after the range it covers (e.g. "5-10ms").
+     */
+    void appendToBSON(BSONObjBuilder& builder) const;
+
+private:
+    std::array<size_t, kNumBuckets> _counts{};
+};
+
 /**
  * Holds connection information for a specific pool or remote host. These objects are maintained by
  * a parent ConnectionPoolStats object and should not need to be created directly.
@@ -51,6 +89,7 @@ struct ConnectionStatsPer {
     size_t available = 0u;
     size_t created = 0u;
     size_t refreshing = 0u;
+    ConnectionWaitTimeHistogram acquisitionWaitTimes;
 };
 
 /**
@@ -41,6 +41,7 @@
 #include <fmt/ostream.h>
 
 #include "mongo/executor/connection_pool.h"
+#include "mongo/executor/connection_pool_stats.h"
 #include "mongo/stdx/future.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/scopeguard.h"
@@ -84,6 +85,16 @@ protected:
             .semi();
     }
 
+    /**
+     * Prewarm the pool for the given host with out-of-line execution, for the same reason as
+     * getFromPool().
+     */
+    void prewarmPool(const HostAndPort& hostAndPort) {
+        ExecutorFuture(_executor).getAsync([pool = _pool, hostAndPort](auto) {
+            pool->prewarm(hostAndPort, transport::kGlobalSSLMode);
+        });
+    }
+
     void doneWith(ConnectionPool::ConnectionHandle& conn) {
         dynamic_cast<ConnectionImpl*>(conn.get())->indicateSuccess();
 
@@ -1518,6 +1529,89 @@ TEST_F(ConnectionPoolTest, AsyncGet) {
     }
 }
 
+/**
+ * Verify that prewarming a host establishes its minimum connections before any request, and that
+ * the first request is then served by one of them.
+ */
+TEST_F(ConnectionPoolTest, PrewarmSpawnsMinConnections) {
+    ConnectionPool::Options options;
+    options.minConnections = 2;
+    auto pool = makePool(options);
+
+    PoolImpl::setNow(Date_t::now());
+
+    size_t setups = 0;
+    for (int i = 0; i < 3; ++i) {
+        ConnectionImpl::pushSetup([&]() {
+            ++setups;
+            return Status::OK();
+        });
+    }
+
+    prewarmPool(HostAndPort());
+    ASSERT_EQ(setups, 2u);
+    ASSERT_EQ(pool->getNumConnectionsPerHost(HostAndPort()), 2u);
+
+    // Prewarming an existing pool does nothing
+    prewarmPool(HostAndPort());
+    ASSERT_EQ(setups, 2u);
+
+    auto connFuture = getFromPool(HostAndPort(), transport::kGlobalSSLMode, Seconds(1));
+    ASSERT_TRUE(connFuture.isReady());
+    auto conn = std::move(connFuture).get();
+    doneWith(conn);
+    ASSERT_EQ(setups, 2u);
+}
+
+/**
+ * Verify that prewarming is a no-op once the pool has been shut down.
+ */
+TEST_F(ConnectionPoolTest, PrewarmAfterShutdown) {
+    auto pool = makePool();
+    pool->shutdown();
+
+    prewarmPool(HostAndPort());
+    ASSERT_EQ(pool->getNumConnectionsPerHost(HostAndPort()), 0u);
+}
+
+/**
+ * Verify that the time requests wait for a connection is recorded in the pool stats.
+ */
+TEST_F(ConnectionPoolTest, AcquisitionWaitTimesAreRecorded) {
+    auto pool = makePool();
+
+    auto now = Date_t::now();
+    PoolImpl::setNow(now);
+
+    // The first request waits for the connection to be set up
+    auto connFuture = getFromPool(HostAndPort(), transport::kGlobalSSLMode, Seconds(1));
+    PoolImpl::setNow(now + Milliseconds(7));
+    ConnectionImpl::pushSetup(Status::OK());
+    auto conn = std::move(connFuture).get();
+    doneWith(conn);
+
+    // The second one is served by the now idle connection
+    connFuture = getFromPool(HostAndPort(), transport::kGlobalSSLMode, Seconds(1));
+    conn = std::move(connFuture).get();
+    doneWith(conn);
+
+    ConnectionPoolStats stats;
+    pool->appendConnectionStats(&stats);
+    const auto& waitTimes = stats.statsByHost[HostAndPort()].acquisitionWaitTimes;
+    for (size_t bucket = 0; bucket < ConnectionWaitTimeHistogram::kNumBuckets; ++bucket) {
+        // Buckets 0 and 2 cover [0ms, 1ms) and [5ms, 10ms)
+        size_t expected = (bucket == 0 || bucket == 2) ? 1 : 0;
+        ASSERT_EQ(waitTimes.getCount(bucket), expected);
+    }
+
+    BSONObjBuilder builder;
+    waitTimes.appendToBSON(builder);
+    ASSERT_BSONOBJ_EQ(builder.obj(),
+                      BSON("0-1ms" << 1 << "1-5ms" << 0 << "5-10ms" << 1 << "10-20ms" << 0
+                                   << "20-50ms" << 0 << "50-100ms" << 0 << "100-200ms" << 0
+                                   << "200-500ms" << 0 << "500-1000ms" << 0 << "1000ms+" << 0));
+}
+
 TEST_F(ConnectionPoolTest, ReturnAfterShutdown) {
     auto pool = makePool();
 
@@ -828,14 +828,21 @@ void NetworkInterfaceTL::RequestState::resolve(Future<RemoteCommandResponse> fut
     auto& reactor = interface()->_reactor;
     auto& baton = cmdState->baton;
 
-    // Convert the RemoteCommandResponse to a RemoteCommandOnAnyResponse and wrap any error
+    // Convert the RemoteCommandResponse to a RemoteCommandOnAnyResponse and wrap any error. The
+    // connection is handed back to the pool here, as soon as the reply has been read, rather than
+    // after switching to the baton: a baton whose operation is busy elsewhere would otherwise keep
+    // an idle connection checked out and force the pool to grow under fan-out.
     auto anyFuture =
         std::move(future)
             .then([this, anchor = shared_from_this()](RemoteCommandResponse response) {
+                returnConnection(response.status);
+
                 // The RCRq ran successfully, wrap the result with the host in question
                 return RemoteCommandOnAnyResponse(host, std::move(response));
             })
             .onError([this, anchor = shared_from_this()](Status error) {
+                returnConnection(error);
+
                 // The RCRq failed, wrap the error into a RCRsp with the host and duration
                 return RemoteCommandOnAnyResponse(host, std::move(error), stopwatch.elapsed());
             });
@@ -844,9 +851,6 @@ void NetworkInterfaceTL::RequestState::resolve(Future<RemoteCommandResponse> fut
         .thenRunOn(makeGuaranteedExecutor(baton, reactor))  // Switch to the baton/reactor.
         .getAsync([ this, anchor = shared_from_this() ](auto swr) noexcept {
             auto response = uassertStatusOK(swr);
-            auto status = response.status;
-
-            returnConnection(status);
 
             const auto commandStatus = getStatusFromCommandResult(response.data);
             if (isHedge) {
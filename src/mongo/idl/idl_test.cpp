@@ -454,6 +454,31 @@ TEST(IDLOneTypeTests, TestObjectType) {
 }
 
 
+// Positive: strings of an unowned_strings struct point into the parsed document
+TEST(IDLStructTests, TestUnownedStrings) {
+    IDLParserErrorContext ctxt("root");
+
+    auto testDoc = BSON("name"
+                        << "foo"
+                        << "optional_name"
+                        << "bar"
+                        << "names" << BSON_ARRAY("baz"));
+    auto testStruct = UnownedStringsStruct::parse(ctxt, testDoc);
+
+    ASSERT_EQUALS(testStruct.getName(), "foo");
+    ASSERT_EQUALS(testStruct.getName().rawData(), testDoc["name"].valueStringData().rawData());
+    ASSERT_EQUALS(*testStruct.getOptional_name(), "bar");
+    ASSERT_EQUALS(testStruct.getOptional_name()->rawData(),
+                  testDoc["optional_name"].valueStringData().rawData());
+    ASSERT_EQUALS(testStruct.getNames().size(), 1UL);
+    ASSERT_EQUALS(testStruct.getNames()[0], "baz");
+
+    BSONObjBuilder builder;
+    testStruct.serialize(&builder);
+    ASSERT_BSONOBJ_EQ(testDoc, builder.obj());
+}
+
+
 // Negative: Test object type
 TEST(IDLOneTypeTests, TestObjectTypeNegative) {
     IDLParserErrorContext ctxt("root");
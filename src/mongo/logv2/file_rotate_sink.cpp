@@ -30,16 +30,25 @@
 #include "mongo/logv2/file_rotate_sink.h"
 
 #include <boost/exception/diagnostic_information.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/iterator/filter_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 #include <boost/make_shared.hpp>
 #include <fmt/format.h>
 #include <fstream>
+#include <utility>
+#include <vector>
 
+#include "mongo/logv2/attributes.h"
 #include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log_detail.h"
 #include "mongo/logv2/shared_access_fstream.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/thread_name.h"
 #include "mongo/util/quick_exit.h"
 #include "mongo/util/stacktrace.h"
 #include "mongo/util/string_map.h"
@@ -70,21 +79,184 @@ StatusWith<boost::shared_ptr<stream_t>> openFile(const std::string& filename, bo
         file->put('\n');
     return file;
 }
+
+using Files = StringMap<boost::shared_ptr<stream_t>>;
+
+std::string formatLine(LogTimestampFormat timestampFormat,
+                       LogSeverity severity,
+                       int32_t id,
+                       StringData message,
+                       const DynamicAttributes& attrs) {
+    fmt::memory_buffer buffer;
+    JSONFormatter(nullptr, timestampFormat)
+        .format(buffer,
+                severity,
+                LogComponent::kControl,
+                Date_t::now(),
+                id,
+                getThreadName(),
+                message,
+                TypeErasedAttributeStorage(attrs),
+                LogTag::kNone,
+                LogTruncation::Disabled);
+    return fmt::to_string(buffer);
+}
+
+void abortIfWritingFailed(const Files& files, LogTimestampFormat timestampFormat) {
+    auto isFailed = [](const auto& file) { return file.second->fail(); };
+    if (std::none_of(files.begin(), files.end(), isFailed))
+        return;
+
+    try {
+        auto failedBegin = boost::make_filter_iterator(isFailed, files.begin(), files.end());
+        auto failedEnd = boost::make_filter_iterator(isFailed, files.end(), files.end());
+
+        auto getFilename = [](const auto& file) -> const auto& {
+            return file.first;
+        };
+        auto begin = boost::make_transform_iterator(failedBegin, getFilename);
+        auto end = boost::make_transform_iterator(failedEnd, getFilename);
+        auto sequence = logv2::seqLog(begin, end);
+
+        DynamicAttributes attrs;
+        attrs.add("files", sequence);
+
+        // Commented out log line below to get validation of the log id with the errorcodes
+        // linter LOGV2(4522200, "Writing to log file failed, aborting application");
+        std::cerr << formatLine(timestampFormat,
+                                LogSeverity::Severe(),
+                                4522200,
+                                "Writing to log file failed, aborting application",
+                                attrs)
+                  << std::endl;
+    } catch (const std::exception& ex) {
+        std::cerr << "Caught std::exception of type " << demangleName(typeid(ex)) << ": "
+                  << ex.what() << std::endl;
+    } catch (const boost::exception& ex) {
+        std::cerr << "Caught boost::exception of type " << demangleName(typeid(ex)) << ": "
+                  << boost::diagnostic_information(ex) << std::endl;
+    } catch (...) {
+        std::cerr << "Caught unidentified exception" << std::endl;
+    }
+
+    printStackTrace(std::cerr);
+    quickExitWithoutLogging(EXIT_FAILURE);
+}
 }  // namespace
 
 struct FileRotateSink::Impl {
-    Impl(LogTimestampFormat tsFormat) : timestampFormat(tsFormat) {}
-    StringMap<boost::shared_ptr<stream_t>> files;
+    Impl(LogTimestampFormat tsFormat, size_t queueSize, bool dropWhenFull)
+        : timestampFormat(tsFormat), asyncQueueSize(queueSize), asyncDropWhenFull(dropWhenFull) {}
+
+    void startWriter() {
+        writer = stdx::thread([this] {
+            setThreadName("LogWriter");
+            writerLoop();
+        });
+    }
+
+    void stopWriter() {
+        {
+            stdx::lock_guard lk(queueMutex);
+            shuttingDown = true;
+        }
+        queueCV.notify_one();
+        writer.join();
+    }
+
+    void writerLoop() {
+        stdx::unique_lock lk(queueMutex);
+        while (true) {
+            queueCV.wait(lk, [&] { return shuttingDown || !queue.empty() || droppedPending; });
+            if (queue.empty() && !droppedPending)
+                return;
+
+            std::vector<std::string> batch;
+            batch.swap(queue);
+            auto dropped = std::exchange(droppedPending, 0);
+            writing = true;
+            lk.unlock();
+            spaceCV.notify_all();
+
+            writeBatch(batch, dropped);
+
+            lk.lock();
+            writing = false;
+            drainedCV.notify_all();
+        }
+    }
+
+    void writeBatch(const std::vector<std::string>& batch, uint64_t dropped) {
+        std::string droppedLine;
+        if (dropped) {
+            DynamicAttributes attrs;
+            attrs.add("dropped", static_cast<long long>(dropped));
+            attrs.add("totalDropped", static_cast<long long>(droppedTotal.load()));
+            droppedLine =
+                formatLine(timestampFormat,
+                           LogSeverity::Warning(),
+                           5910701,
+                           "Dropped log records because the log writer queue was full",
+                           attrs);
+            // Commented out log line below to get validation of the log id with the errorcodes
+            // linter LOGV2(5910701, "Dropped log records because the log writer queue was full");
+        }
+
+        stdx::lock_guard lk(filesMutex);
+        for (auto& file : files) {
+            if (!droppedLine.empty())
+                *file.second << droppedLine << '\n';
+            for (auto& record : batch)
+                *file.second << record << '\n';
+            file.second->flush();
+        }
+        abortIfWritingFailed(files, timestampFormat);
+    }
+
+    // Waits until every record queued so far has been written.
+    void waitForDrain() {
+        stdx::unique_lock lk(queueMutex);
+        drainedCV.wait(lk, [&] { return queue.empty() && !droppedPending && !writing; });
+    }
+
+    Files files;
     LogTimestampFormat timestampFormat;
+
+    // Held while writing to or replacing the streams in 'files' in asynchronous mode.
+    stdx::mutex filesMutex;  // NOLINT
+
+    // Asynchronous mode state, unused when 'asyncQueueSize' is zero.
+    const size_t asyncQueueSize;
+    const bool asyncDropWhenFull;
+    stdx::mutex queueMutex;  // NOLINT
+    stdx::condition_variable queueCV;    // Records were queued or the writer should stop.
+    stdx::condition_variable spaceCV;    // The writer took the queued records.
+    stdx::condition_variable drainedCV;  // The writer finished writing a batch.
+    std::vector<std::string> queue;
+    uint64_t droppedPending = 0;
+    AtomicWord<uint64_t> droppedTotal{0};
+    bool writing = false;
+    bool shuttingDown = false;
+    stdx::thread writer;
 };
 
-FileRotateSink::FileRotateSink(LogTimestampFormat timestampFormat)
-    : _impl(std::make_unique<Impl>(timestampFormat)) {}
-FileRotateSink::~FileRotateSink() {}
+FileRotateSink::FileRotateSink(LogTimestampFormat timestampFormat,
+                               size_t asyncQueueSize,
+                               bool asyncDropWhenFull)
+    : _impl(std::make_unique<Impl>(timestampFormat, asyncQueueSize, asyncDropWhenFull)) {
+    if (_impl->asyncQueueSize)
+        _impl->startWriter();
+}
+
+FileRotateSink::~FileRotateSink() {
+    if (_impl->asyncQueueSize)
+        _impl->stopWriter();
+}
 
 Status FileRotateSink::addFile(const std::string& filename, bool append) {
     auto statusWithFile = openFile(filename, append);
     if (statusWithFile.isOK()) {
+        stdx::lock_guard lk(_impl->filesMutex);
         add_stream(statusWithFile.getValue());
         _impl->files[filename] = statusWithFile.getValue();
     }
@@ -92,6 +264,7 @@ Status FileRotateSink::addFile(const std::string& filename, bool append) {
     return statusWithFile.getStatus().withContext("Can't initialize rotatable log file");
 }
 void FileRotateSink::removeFile(const std::string& filename) {
+    stdx::lock_guard lk(_impl->filesMutex);
     auto it = _impl->files.find(filename);
     if (it != _impl->files.cend()) {
         remove_stream(it->second);
@@ -149,6 +322,7 @@ Status FileRotateSink::rotate(bool rename,
 
         auto newFile = openFile(filename, false);
         if (newFile.isOK()) {
+            stdx::lock_guard lk(_impl->filesMutex);
             invariant(file.second);
             remove_stream(file.second);
             file.second->close();
@@ -163,53 +337,47 @@ Status FileRotateSink::rotate(bool rename,
 
 void FileRotateSink::consume(const boost::log::record_view& rec,
                              const string_type& formatted_string) {
-    auto isFailed = [](const auto& file) { return file.second->fail(); };
-    boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
-    if (std::any_of(_impl->files.begin(), _impl->files.end(), isFailed)) {
-        try {
-            auto failedBegin =
-                boost::make_filter_iterator(isFailed, _impl->files.begin(), _impl->files.end());
-            auto failedEnd =
-                boost::make_filter_iterator(isFailed, _impl->files.end(), _impl->files.end());
-
-            auto getFilename = [](const auto& file) -> const auto& {
-                return file.first;
-            };
-            auto begin = boost::make_transform_iterator(failedBegin, getFilename);
-            auto end = boost::make_transform_iterator(failedEnd, getFilename);
-            auto sequence = logv2::seqLog(begin, end);
+    if (!_impl->asyncQueueSize) {
+        boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
+        abortIfWritingFailed(_impl->files, _impl->timestampFormat);
+        return;
+    }
 
-            DynamicAttributes attrs;
-            attrs.add("files", sequence);
-
-            fmt::memory_buffer buffer;
-            JSONFormatter(nullptr, _impl->timestampFormat)
-                .format(buffer,
-                        LogSeverity::Severe(),
-                        LogComponent::kControl,
-                        Date_t::now(),
-                        4522200,
-                        getThreadName(),
-                        "Writing to log file failed, aborting application",
-                        TypeErasedAttributeStorage(attrs),
-                        LogTag::kNone,
-                        LogTruncation::Disabled);
-            // Commented out log line below to get validation of the log id with the errorcodes
-            // linter LOGV2(4522200, "Writing to log file failed, aborting application");
-            std::cerr << StringData(buffer.data(), buffer.size()) << std::endl;
-        } catch (const std::exception& ex) {
-            std::cerr << "Caught std::exception of type " << demangleName(typeid(ex)) << ": "
-                      << ex.what() << std::endl;
-        } catch (const boost::exception& ex) {
-            std::cerr << "Caught boost::exception of type " << demangleName(typeid(ex)) << ": "
-                      << boost::diagnostic_information(ex) << std::endl;
-        } catch (...) {
-            std::cerr << "Caught unidentified exception" << std::endl;
-        }
+    // Write severe records directly, after everything queued before them, in case the process is
+    // about to terminate.
+    auto severity = boost::log::extract<LogSeverity>(attributes::severity(), rec);
+    if (severity && severity.get() >= LogSeverity::Severe()) {
+        _impl->waitForDrain();
+        stdx::lock_guard lk(_impl->filesMutex);
+        boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
+        abortIfWritingFailed(_impl->files, _impl->timestampFormat);
+        return;
+    }
 
-        printStackTrace(std::cerr);
-        quickExitWithoutLogging(EXIT_FAILURE);
+    {
+        stdx::unique_lock lk(_impl->queueMutex);
+        if (_impl->queue.size() >= _impl->asyncQueueSize) {
+            if (_impl->asyncDropWhenFull) {
+                ++_impl->droppedPending;
+                _impl->droppedTotal.addAndFetch(1);
+                return;
+            }
+            _impl->spaceCV.wait(lk, [&] { return _impl->queue.size() < _impl->asyncQueueSize; });
+        }
+        _impl->queue.push_back(formatted_string);
     }
+    _impl->queueCV.notify_one();
+}
+
+void FileRotateSink::flush() {
+    if (_impl->asyncQueueSize)
+        _impl->waitForDrain();
+    stdx::lock_guard lk(_impl->filesMutex);
+    boost::log::sinks::text_ostream_backend::flush();
+}
+
+uint64_t FileRotateSink::droppedRecords() const {
+    return _impl->droppedTotal.load();
 }
 
 }  // namespace mongo::logv2
@@ -40,9 +40,17 @@ namespace mongo::logv2 {
 // boost::log backend sink to provide MongoDB style file rotation.
 // Uses custom stream type to open log files with shared access on Windows, somthing the built-in
 // boost file rotation sink does not do.
+//
+// When 'asyncQueueSize' is not zero, formatted records are queued and written to the files by a
+// background thread so that logging threads do not wait on the disk. Once 'asyncQueueSize' records
+// are pending, logging threads either wait for the writer or, with 'asyncDropWhenFull', drop the
+// record; the writer notes the number of dropped records in the log. Severe records flush the queue
+// and are written synchronously, so nothing logged before a fatal error is lost.
 class FileRotateSink : public boost::log::sinks::text_ostream_backend {
 public:
-    FileRotateSink(LogTimestampFormat timestampFormat);
+    FileRotateSink(LogTimestampFormat timestampFormat,
+                   size_t asyncQueueSize = 0,
+                   bool asyncDropWhenFull = false);
     ~FileRotateSink();
 
     Status addFile(const std::string& filename, bool append);
@@ -52,6 +60,12 @@ public:
 
     void consume(const boost::log::record_view& rec, const string_type& formatted_string);
 
+    // Waits for all queued records to be written and flushes the files.
+    void flush();
+
+    // Number of records dropped because the asynchronous queue was full.
+    uint64_t droppedRecords() const;
+
 private:
     struct Impl;
     std::unique_ptr<Impl> _impl;
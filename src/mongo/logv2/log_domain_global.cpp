@@ -75,6 +75,7 @@ struct LogDomainGlobal::Impl {
     Impl(LogDomainGlobal& parent);
     Status configure(LogDomainGlobal::ConfigurationOptions const& options);
     Status rotate(bool rename, StringData renameSuffix, std::function<void(Status)> onMinorError);
+    void flush();
 
     const ConfigurationOptions& config() const;
 
@@ -162,7 +163,8 @@ Status LogDomainGlobal::Impl::configure(LogDomainGlobal::ConfigurationOptions co
 
     if (options.fileEnabled) {
         auto backend = boost::make_shared<RotatableFileBackend>(
-            boost::make_shared<FileRotateSink>(options.timestampFormat),
+            boost::make_shared<FileRotateSink>(
+                options.timestampFormat, options.fileAsyncQueueSize, options.fileAsyncDropWhenFull),
             boost::make_shared<RamLogSink>(RamLog::get("global")),
             boost::make_shared<RamLogSink>(RamLog::get("startupWarnings")),
             boost::make_shared<UserAssertSink>());
@@ -242,6 +244,11 @@ Status LogDomainGlobal::Impl::rotate(bool rename,
     return result;
 }
 
+void LogDomainGlobal::Impl::flush() {
+    if (_rotatableFileSink)
+        _rotatableFileSink->flush();
+}
+
 LogSource& LogDomainGlobal::Impl::source() {
     // Use a thread_local logger so we don't need to have locking. thread_locals are destroyed
     // before statics so keep track of number of thread_locals we have active and if this code
@@ -297,6 +304,10 @@ Status LogDomainGlobal::rotate(bool rename,
     return _impl->rotate(rename, renameSuffix, onMinorError);
 }
 
+void LogDomainGlobal::flush() {
+    _impl->flush();
+}
+
 LogComponentSettings& LogDomainGlobal::settings() {
     return _impl->_settings;
 }
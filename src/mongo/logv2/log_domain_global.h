@@ -50,6 +50,10 @@ public:
         int syslogFacility{-1};  // invalid facility by default, must be set
         LogFormat format{LogFormat::kDefault};
         const AtomicWord<int32_t>* maxAttributeSizeKB = nullptr;
+        // When not zero, the log file is written by a background thread that buffers up to this
+        // many records. See FileRotateSink.
+        size_t fileAsyncQueueSize{0};
+        bool fileAsyncDropWhenFull{false};
 
         void makeDisabled();
     };
@@ -62,6 +66,9 @@ public:
     Status configure(ConfigurationOptions const& options);
     Status rotate(bool rename, StringData renameSuffix, std::function<void(Status)> onMinorError);
 
+    // Writes out records buffered by the log file sink.
+    void flush();
+
     const ConfigurationOptions& config() const;
 
     LogComponentSettings& settings();
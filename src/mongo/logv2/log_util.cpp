@@ -32,6 +32,8 @@
 #include "mongo/logv2/log_util.h"
 
 #include "mongo/logv2/log.h"
+#include "mongo/logv2/log_domain_global.h"
+#include "mongo/logv2/log_manager.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/util/time_support.h"
 
@@ -49,6 +51,10 @@ void addLogRotator(StringData logType, LogRotateCallback cb) {
     logRotateCallbacks.emplace(logType, std::move(cb));
 }
 
+void flushLogs() {
+    LogManager::global().getGlobalDomainInternal().flush();
+}
+
 bool rotateLogs(bool renameFiles,
                 boost::optional<StringData> logType,
                 std::function<void(Status)> onMinorError) {
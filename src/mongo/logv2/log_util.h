@@ -63,6 +63,12 @@ bool rotateLogs(bool renameFiles,
                 boost::optional<StringData> logType,
                 std::function<void(Status)> onMinorError);
 
+/**
+ * Waits for log records that are buffered for asynchronous writing to reach the log file. Called
+ * on process exit so that the last records logged are not lost.
+ */
+void flushLogs();
+
 /**
  * Returns true if system logs should be redacted.
  */
@@ -29,7 +29,9 @@
 
 #define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/logv2/component_settings_filter.h"
+#include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log.h"
 #include "mongo/logv2/log_domain_global.h"
 #include "mongo/logv2/text_formatter.h"
@@ -55,10 +57,10 @@ boost::shared_ptr<std::ostream> makeNullStream() {
 // RAII style helper class for init/deinit new log system
 class ScopedLogV2Bench {
 public:
-    ScopedLogV2Bench(benchmark::State& state) {
+    ScopedLogV2Bench(benchmark::State& state, bool json = false) {
         _shouldInit = state.thread_index == 0;
         if (_shouldInit) {
-            setupAppender();
+            setupAppender(json);
         }
     }
 
@@ -69,7 +71,7 @@ public:
     }
 
 private:
-    void setupAppender() {
+    void setupAppender(bool json) {
         logv2::LogDomainGlobal::ConfigurationOptions config;
         config.makeDisabled();
         invariant(logv2::LogManager::global().getGlobalDomainInternal().configure(config).isOK());
@@ -83,7 +85,10 @@ private:
         _sink->set_filter(
             logv2::ComponentSettingsFilter(logv2::LogManager::global().getGlobalDomain(),
                                            logv2::LogManager::global().getGlobalSettings()));
-        _sink->set_formatter(logv2::TextFormatter());
+        if (json)
+            _sink->set_formatter(logv2::JSONFormatter());
+        else
+            _sink->set_formatter(logv2::TextFormatter());
         boost::log::core::get()->add_sink(_sink);
     }
 
@@ -150,6 +155,27 @@ void BM_EnabledLogV2ManySmallArg(benchmark::State& state) {
     }
 }
 
+// Resembles the command attribute of a slow query log line for a large find.
+BSONObj createLargeCommand() {
+    BSONObjBuilder builder;
+    builder.append("find", "collection");
+    BSONObjBuilder filter(builder.subobjStart("filter"));
+    for (int i = 0; i < 100; ++i)
+        filter.append(fmt::format("field{}", i), fmt::format("value {} {:a<50s}", i, ""));
+    filter.done();
+    builder.append("comment", "a \"quoted\" comment with a \\ backslash");
+    builder.append("$db", "test");
+    return builder.obj();
+}
+
+void BM_EnabledLogV2JSONLargeAttr(benchmark::State& state) {
+    ScopedLogV2Bench init(state, true);
+    const auto command = createLargeCommand();
+
+    for (auto _ : state)
+        LOGV2(5910700, "enabled log", "command"_attr = command);
+}
+
 void ThreadCounts(benchmark::internal::Benchmark* b) {
     int tc[] = {1, 2, 4, 8};
     for (int t : tc)
@@ -161,6 +187,7 @@ BENCHMARK(BM_NoopLogV2Arg)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2ExpensiveArg)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2ManySmallArg)->Apply(ThreadCounts);
+BENCHMARK(BM_EnabledLogV2JSONLargeAttr)->Apply(ThreadCounts);
 
 }  // namespace
 }  // namespace mongo
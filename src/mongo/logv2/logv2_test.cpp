@@ -44,6 +44,7 @@
 #include "mongo/logv2/component_settings_filter.h"
 #include "mongo/logv2/composite_backend.h"
 #include "mongo/logv2/constants.h"
+#include "mongo/logv2/file_rotate_sink.h"
 #include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log.h"
 #include "mongo/logv2/log_capture_backend.h"
@@ -1711,6 +1712,39 @@ TEST_F(LogV2Test, FileLogging) {
     ASSERT(before_rotation == after_rotation);
 }
 
+TEST_F(LogV2Test, AsyncFileRotateSink) {
+    auto logv2_dir = std::make_unique<mongo::unittest::TempDir>("logv2");
+    std::string file_name = logv2_dir->path() + "/file.log";
+
+    auto readFile = [&] {
+        std::vector<std::string> lines;
+        std::ifstream file(file_name);
+        for (std::string line; std::getline(file, line, '\n');)
+            lines.push_back(std::move(line));
+        return lines;
+    };
+
+    auto backend = boost::make_shared<FileRotateSink>(
+        LogTimestampFormat::kISO8601UTC, /*asyncQueueSize*/ 4, /*asyncDropWhenFull*/ false);
+    ASSERT_OK(backend->addFile(file_name, false));
+    auto sink = wrapInUnlockedSink(backend);
+    applyDefaultFilterToSink(sink);
+    sink->set_formatter(PlainFormatter());
+    attachSink(sink);
+
+    // More records than the queue holds: the logging thread waits for the writer, so nothing is
+    // dropped.
+    for (int i = 0; i < 100; ++i)
+        LOGV2(5910702, "async {i}", "i"_attr = i);
+    backend->flush();
+
+    auto lines = readFile();
+    ASSERT_EQ(lines.size(), 100u);
+    for (int i = 0; i < 100; ++i)
+        ASSERT_EQ(lines[i], fmt::format("async {}", i));
+    ASSERT_EQ(backend->droppedRecords(), 0u);
+}
+
 TEST_F(LogV2Test, UserAssert) {
     std::vector<std::string> lines;
     auto sink = wrapInSynchronousSink(wrapInCompositeBackend(
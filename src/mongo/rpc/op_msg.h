@@ -223,6 +223,14 @@ public:
         skipHeaderAndFlags();
     }
 
+    /**
+     * Starts with a buffer of 'initialBufferSize' bytes, for callers that know roughly how large
+     * the message will be.
+     */
+    explicit OpMsgBuilder(size_t initialBufferSize) : _buf(initialBufferSize) {
+        skipHeaderAndFlags();
+    }
+
     /**
      * See the documentation for DocSequenceBuilder below.
      */
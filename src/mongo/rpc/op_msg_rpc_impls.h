@@ -53,6 +53,8 @@ private:
 
 class OpMsgReplyBuilder final : public rpc::ReplyBuilderInterface {
 public:
+    OpMsgReplyBuilder() : _builder(_sizeHint().get()) {}
+
     ReplyBuilderInterface& setRawCommandReply(const BSONObj& reply) override {
         _builder.beginBody().appendElements(reply);
         return *this;
@@ -73,7 +75,9 @@ public:
         _builder.reset();
     }
     Message done() override {
-        return _builder.finish();
+        auto message = _builder.finish();
+        _sizeHint().record(message.size());
+        return message;
     }
     void reserveBytes(const std::size_t bytes) override {
         _builder.reserveBytes(bytes);
@@ -83,6 +87,13 @@ public:
     }
 
 private:
+    // Replies on a given thread tend to come from the same connection and workload, so a
+    // per-thread hint avoids both regrowing the reply buffer and sharing a cache line.
+    static BufBuilderSizeHint& _sizeHint() {
+        thread_local BufBuilderSizeHint hint;
+        return hint;
+    }
+
     OpMsgBuilder _builder;
 };
 
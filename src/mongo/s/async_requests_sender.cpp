@@ -43,6 +43,8 @@
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
 #include "mongo/s/hedge_options_util.h"
+#include "mongo/s/mongos_server_parameters_gen.h"
+#include "mongo/s/replica_latency_tracker.h"
 #include "mongo/transport/baton.h"
 #include "mongo/transport/transport_layer.h"
 #include "mongo/util/assert_util.h"
@@ -212,6 +214,20 @@ auto AsyncRequestsSender::RemoteData::scheduleRemoteCommand(std::vector<HostAndP
         });
 
     auto hedgeOptions = extractHedgeOptions(_cmdObj, _ars->_readPreference);
+
+    // Prefer the hosts which are expected to answer first and track the requests outstanding
+    // against the host which receives the original request.
+    ReplicaLatencyTracker* latencyTracker = nullptr;
+    if (gEnableAdaptiveReplicaSelection.load() && !hostAndPorts.empty()) {
+        latencyTracker = ReplicaLatencyTracker::get(_ars->_opCtx);
+        latencyTracker->sortByExpectedCompletion(&hostAndPorts);
+        if (hedgeOptions) {
+            capHedgeOptionsAtLatencyPercentile(hostAndPorts, *latencyTracker, &*hedgeOptions);
+        }
+        latencyTracker->onRequestStarted(hostAndPorts.front());
+    }
+    auto firstHost = latencyTracker ? hostAndPorts.front() : HostAndPort();
+
     executor::RemoteCommandRequestOnAny request(std::move(hostAndPorts),
                                                 _ars->_db,
                                                 _cmdObj,
@@ -224,13 +240,28 @@ auto AsyncRequestsSender::RemoteData::scheduleRemoteCommand(std::vector<HostAndP
     auto [p, f] = makePromiseFuture<RemoteCommandOnAnyCallbackArgs>();
 
     // Failures to schedule skip the retry loop
-    uassertStatusOK(_ars->_subExecutor->scheduleRemoteCommandOnAny(
+    auto swHandle = _ars->_subExecutor->scheduleRemoteCommandOnAny(
         request,
         // We have to make a shared_ptr<Promise> here because scheduleRemoteCommand requires
         // copyable callbacks
-        [p = std::make_shared<Promise<RemoteCommandOnAnyCallbackArgs>>(std::move(p))](
-            const RemoteCommandOnAnyCallbackArgs& cbData) { p->emplaceValue(cbData); },
-        *_ars->_subBaton));
+        [p = std::make_shared<Promise<RemoteCommandOnAnyCallbackArgs>>(std::move(p)),
+         latencyTracker,
+         firstHost](const RemoteCommandOnAnyCallbackArgs& cbData) {
+            if (latencyTracker) {
+                // Only responses which made it back over the network say anything about the
+                // latency of their host.
+                latencyTracker->onRequestFinished(
+                    firstHost,
+                    cbData.response.target,
+                    cbData.response.isOK() ? cbData.response.elapsed : boost::none);
+            }
+            p->emplaceValue(cbData);
+        },
+        *_ars->_subBaton);
+    if (!swHandle.isOK() && latencyTracker) {
+        latencyTracker->onRequestFinished(firstHost, boost::none, boost::none);
+    }
+    uassertStatusOK(swHandle);
 
     return std::move(f).semi();
 }
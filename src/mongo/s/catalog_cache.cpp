@@ -388,6 +388,17 @@ void CatalogCache::invalidateShardOrEntireCollectionEntryForShardedCollection(
     }
 }
 
+Status CatalogCache::onRoutingChangeNotification(OperationContext* opCtx,
+                                                const NamespaceString& nss) {
+    const auto collectionEntry = _collectionCache.peekLatestCached(nss);
+    if (!collectionEntry || !collectionEntry->optRt) {
+        return Status::OK();
+    }
+
+    _stats.countRefreshesFromNotifications.addAndFetch(1);
+    return getCollectionRoutingInfoWithRefresh(opCtx, nss).getStatus();
+}
+
 void CatalogCache::invalidateEntriesThatReferenceShard(const ShardId& shardId) {
     LOGV2_DEBUG(4997600,
                 1,
@@ -487,6 +498,7 @@ void CatalogCache::invalidateCollectionEntry_LINEARIZABLE(const NamespaceString&
 
 void CatalogCache::Stats::report(BSONObjBuilder* builder) const {
     builder->append("countStaleConfigErrors", countStaleConfigErrors.load());
+    builder->append("countRefreshesFromNotifications", countRefreshesFromNotifications.load());
 
     builder->append("totalRefreshWaitTimeMicros", totalRefreshWaitTimeMicros.load());
 
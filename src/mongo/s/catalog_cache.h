@@ -289,6 +289,13 @@ public:
      */
     void invalidateCollectionEntry_LINEARIZABLE(const NamespaceString& nss);
 
+    /**
+     * To be called when the config server reports that the routing table of 'nss' has changed.
+     * Refreshes the cached entry ahead of any operation finding it stale and waits for the refresh
+     * to complete. Does nothing if the collection is not cached as sharded on this node.
+     */
+    Status onRoutingChangeNotification(OperationContext* opCtx, const NamespaceString& nss);
+
 private:
     class DatabaseCache : public DatabaseTypeCache {
     public:
@@ -374,6 +381,10 @@ private:
         // refreshes)
         AtomicWord<long long> countStaleConfigErrors{0};
 
+        // Counts how many sharded collection entries were refreshed because the config server
+        // notified of a change to their routing table, rather than because of a stale config error
+        AtomicWord<long long> countRefreshesFromNotifications{0};
+
         // Cumulative, always-increasing counter of how much time threads waiting for refresh
         // combined
         AtomicWord<long long> totalRefreshWaitTimeMicros{0};
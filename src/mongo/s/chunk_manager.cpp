@@ -33,6 +33,7 @@
 
 #include "mongo/s/chunk_manager.h"
 
+#include "mongo/base/data_view.h"
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
@@ -76,6 +77,61 @@ void appendChunkTo(std::vector<std::shared_ptr<ChunkInfo>>& chunks,
     }
 }
 
+// Returns the leading 8 bytes of 'keyString' as a big-endian integer, zero padded if the key is
+// shorter. Ordering such prefixes as integers matches the byte-wise ordering of the KeyStrings
+// they came from, except that equal prefixes say nothing about the remaining bytes.
+uint64_t keyStringPrefix(StringData keyString) {
+    char buf[sizeof(uint64_t)] = {};
+    std::memcpy(buf, keyString.rawData(), std::min(keyString.size(), sizeof(buf)));
+    return ConstDataView(buf).read<BigEndian<uint64_t>>();
+}
+
+// Returns the first index in [0, count) at which 'compareAt' reports an element greater than (or
+// equal to, if 'isMaxInclusive' is false) the searched key, or 'count' if there is none.
+// 'compareAt' must be ordered, returning a negative value for the elements before the key.
+template <typename CompareAtFn>
+size_t findFirstAfter(size_t count, bool isMaxInclusive, CompareAtFn&& compareAt) {
+    size_t first = 0;
+    while (count > 0) {
+        const size_t step = count / 2;
+        const int cmp = compareAt(first + step);
+        if (cmp < 0 || (isMaxInclusive && cmp == 0)) {
+            first += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+
+    return first;
+}
+
+void updateMaxVersion(stdx::unordered_map<ShardId, ChunkVersion, ShardId::Hasher>& versions,
+                      const ShardId& shardId,
+                      const ChunkVersion& version) {
+    auto [it, inserted] = versions.emplace(shardId, version);
+    if (!inserted && it->second.isOlderThan(version))
+        it->second = version;
+}
+
+void checkContinuity(const ChunkInfo& prevChunk, const ChunkInfo& nextChunk) {
+    const auto& prevMax = prevChunk.getMax();
+    const auto& nextMin = nextChunk.getMin();
+    if (SimpleBSONObjComparator::kInstance.evaluate(prevMax == nextMin))
+        return;
+
+    if (SimpleBSONObjComparator::kInstance.evaluate(prevMax < nextMin))
+        uasserted(ErrorCodes::ConflictingOperationInProgress,
+                  str::stream() << "Gap exists in the routing table between chunks "
+                                << prevChunk.getRange().toString() << " and "
+                                << nextChunk.getRange().toString());
+    else
+        uasserted(ErrorCodes::ConflictingOperationInProgress,
+                  str::stream() << "Overlap exists in the routing table between chunks "
+                                << prevChunk.getRange().toString() << " and "
+                                << nextChunk.getRange().toString());
+}
+
 // This function processes the passed in chunks by removing the older versions of any overlapping
 // chunks. The resulting chunks must be ordered by the maximum bound and not have any
 // overlapping chunks. In order to process the original set of chunks correctly which may have
@@ -115,97 +171,146 @@ std::vector<std::shared_ptr<ChunkInfo>> flatten(const std::vector<ChunkType>& ch
 
 ShardVersionMap ChunkMap::constructShardVersionMap() const {
     ShardVersionMap shardVersions;
-    ChunkVector::const_iterator current = _chunkMap.cbegin();
-
-    boost::optional<BSONObj> firstMin = boost::none;
-    boost::optional<BSONObj> lastMax = boost::none;
-
-    while (current != _chunkMap.cend()) {
-        const auto& firstChunkInRange = *current;
-        const auto& currentRangeShardId = firstChunkInRange->getShardIdAt(boost::none);
-
-        // Tracks the max shard version for the shard on which the current range will reside
-        auto shardVersionIt = shardVersions.find(currentRangeShardId);
-        if (shardVersionIt == shardVersions.end()) {
-            shardVersionIt = shardVersions
-                                 .emplace(std::piecewise_construct,
-                                          std::forward_as_tuple(currentRangeShardId),
-                                          std::forward_as_tuple(_collectionVersion.epoch(),
-                                                                _collectionVersion.getTimestamp()))
-                                 .first;
-        }
+    std::shared_ptr<ChunkInfo> lastChunk;
+
+    for (const auto& block : _blocks) {
+        const auto& firstChunk = block->front();
+        if (lastChunk &&
+            lastChunk->getShardIdAt(boost::none) != firstChunk->getShardIdAt(boost::none))
+            checkContinuity(*lastChunk, *firstChunk);
+
+        // Discontinuities within a block are recorded as the block is built so that the blocks
+        // shared with a previous map do not need to be scanned again
+        if (const auto& discontinuity = block->getFirstDiscontinuity())
+            checkContinuity(*(*block)[*discontinuity - 1], *(*block)[*discontinuity]);
+
+        for (const auto& [shardId, blockShardVersion] : block->getShardVersions()) {
+            // Tracks the max shard version for the shard on which the current range will reside
+            auto shardVersionIt = shardVersions.find(shardId);
+            if (shardVersionIt == shardVersions.end()) {
+                shardVersionIt =
+                    shardVersions
+                        .emplace(std::piecewise_construct,
+                                 std::forward_as_tuple(shardId),
+                                 std::forward_as_tuple(_collectionVersion.epoch(),
+                                                       _collectionVersion.getTimestamp()))
+                        .first;
+            }
 
-        auto& maxShardVersion = shardVersionIt->second.shardVersion;
+            auto& maxShardVersion = shardVersionIt->second.shardVersion;
+            if (maxShardVersion.isOlderThan(blockShardVersion))
+                maxShardVersion = blockShardVersion;
+        }
 
-        current =
-            std::find_if(current,
-                         _chunkMap.cend(),
-                         [&currentRangeShardId, &maxShardVersion](const auto& currentChunk) {
-                             if (currentChunk->getShardIdAt(boost::none) != currentRangeShardId)
-                                 return true;
+        lastChunk = block->back();
+    }
 
-                             if (maxShardVersion.isOlderThan(currentChunk->getLastmod()))
-                                 maxShardVersion = currentChunk->getLastmod();
+    // If a shard has chunks it must have a shard version, otherwise we have an invalid chunk
+    // somewhere, which should have been caught at chunk load time
+    for (const auto& [shardId, targetingInfo] : shardVersions) {
+        invariant(targetingInfo.shardVersion.isSet());
+    }
 
-                             return false;
-                         });
+    if (_size > 0) {
+        invariant(!shardVersions.empty());
 
-        const auto rangeLast = *std::prev(current);
+        checkAllElementsAreOfType(MinKey, _blocks.front()->front()->getMin());
+        checkAllElementsAreOfType(MaxKey, _blocks.back()->back()->getMax());
+    }
 
-        const auto& rangeMin = firstChunkInRange->getMin();
-        const auto& rangeMax = rangeLast->getMax();
+    return shardVersions;
+}
 
-        // Check the continuity of the chunks map
-        if (lastMax && !SimpleBSONObjComparator::kInstance.evaluate(*lastMax == rangeMin)) {
-            if (SimpleBSONObjComparator::kInstance.evaluate(*lastMax < rangeMin))
-                uasserted(ErrorCodes::ConflictingOperationInProgress,
-                          str::stream() << "Gap exists in the routing table between chunks "
-                                        << findIntersectingChunk(*lastMax)->getRange().toString()
-                                        << " and " << rangeLast->getRange().toString());
-            else
-                uasserted(ErrorCodes::ConflictingOperationInProgress,
-                          str::stream() << "Overlap exists in the routing table between chunks "
-                                        << findIntersectingChunk(*lastMax)->getRange().toString()
-                                        << " and " << rangeLast->getRange().toString());
-        }
+StringData ChunkMap::ChunkBlock::maxKeyString(size_t i) const {
+    const auto begin = _maxKeyOffsets[i];
+    const auto end = i + 1 < _maxKeyOffsets.size() ? _maxKeyOffsets[i + 1] : _maxKeyArena.size();
+    return StringData(_maxKeyArena.data() + begin, end - begin);
+}
 
-        if (!firstMin)
-            firstMin = rangeMin;
+size_t ChunkMap::ChunkBlock::findIndexByMaxKey(StringData keyString,
+                                               uint64_t prefix,
+                                               bool isMaxInclusive) const {
+    return findFirstAfter(_chunks.size(), isMaxInclusive, [&](size_t i) {
+        const auto keyPrefix = _maxKeyPrefixes[i];
+        if (keyPrefix != prefix)
+            return keyPrefix < prefix ? -1 : 1;
+        return maxKeyString(i).compare(keyString);
+    });
+}
 
-        lastMax = rangeMax;
+void ChunkMap::ChunkBlock::pushBack(const std::shared_ptr<ChunkInfo>& chunk) {
+    const auto& shardId = chunk->getShardIdAt(boost::none);
 
-        // If a shard has chunks it must have a shard version, otherwise we have an invalid chunk
-        // somewhere, which should have been caught at chunk load time
-        invariant(maxShardVersion.isSet());
+    if (!_chunks.empty() && !_firstDiscontinuity) {
+        const auto& prevChunk = _chunks.back();
+        if (prevChunk->getShardIdAt(boost::none) != shardId &&
+            !SimpleBSONObjComparator::kInstance.evaluate(prevChunk->getMax() == chunk->getMin()))
+            _firstDiscontinuity = _chunks.size();
     }
 
-    if (!_chunkMap.empty()) {
-        invariant(!shardVersions.empty());
-        invariant(firstMin.is_initialized());
-        invariant(lastMax.is_initialized());
+    const auto& maxKeyString = chunk->getMaxKeyString();
+    invariant(_maxKeyArena.size() + maxKeyString.size() <= std::numeric_limits<uint32_t>::max());
+    _maxKeyOffsets.push_back(static_cast<uint32_t>(_maxKeyArena.size()));
+    _maxKeyPrefixes.push_back(keyStringPrefix(maxKeyString));
+    _maxKeyArena.append(maxKeyString);
 
-        checkAllElementsAreOfType(MinKey, firstMin.get());
-        checkAllElementsAreOfType(MaxKey, lastMax.get());
-    }
+    const auto chunkVersion = chunk->getLastmod();
+    if (_chunks.empty() || _maxVersion.isOlderThan(chunkVersion))
+        _maxVersion = chunkVersion;
+    updateMaxVersion(_shardVersions, shardId, chunkVersion);
 
-    return shardVersions;
+    _chunks.push_back(chunk);
+}
+
+void ChunkMap::ChunkBlock::popBack() {
+    const auto chunk = std::move(_chunks.back());
+    _chunks.pop_back();
+
+    _maxKeyArena.resize(_maxKeyOffsets.back());
+    _maxKeyOffsets.pop_back();
+    _maxKeyPrefixes.pop_back();
+
+    if (_firstDiscontinuity && *_firstDiscontinuity == _chunks.size())
+        _firstDiscontinuity = boost::none;
+
+    // The removed chunk is always replaced by a newer one, so '_maxVersion' stays valid, but the
+    // version of its shard has to be recomputed from the chunks which are left
+    const auto& shardId = chunk->getShardIdAt(boost::none);
+    _shardVersions.erase(shardId);
+    for (const auto& remainingChunk : _chunks) {
+        if (remainingChunk->getShardIdAt(boost::none) == shardId)
+            updateMaxVersion(_shardVersions, shardId, remainingChunk->getLastmod());
+    }
 }
 
 void ChunkMap::appendChunk(const std::shared_ptr<ChunkInfo>& chunk) {
-    appendChunkTo(_chunkMap, chunk);
-    const auto chunkVersion = chunk->getLastmod();
-    if (_collectionVersion.isOlderThan(chunkVersion)) {
-        _collectionVersion = ChunkVersion(chunkVersion.majorVersion(),
-                                          chunkVersion.minorVersion(),
-                                          chunkVersion.epoch(),
-                                          _collTimestamp);
+    if (_size > 0 && chunk->getRange().overlaps(_blocks.back()->back()->getRange())) {
+        if (_blocks.back()->back()->getLastmod().isOlderThan(chunk->getLastmod())) {
+            auto& block = _mutableLastBlock();
+            block.popBack();
+            block.pushBack(chunk);
+            _blockMaxKeyPrefixes.back() = block.lastMaxKeyPrefix();
+        }
+    } else {
+        // Blocks shared with another map are never appended to
+        if (_blocks.empty() || _blocks.back().use_count() > 1 ||
+            _blocks.back()->size() >= kMaxChunksPerBlock) {
+            _blocks.push_back(std::make_shared<ChunkBlock>());
+            _blockMaxKeyPrefixes.push_back(0);
+        }
+
+        _blocks.back()->pushBack(chunk);
+        _blockMaxKeyPrefixes.back() = _blocks.back()->lastMaxKeyPrefix();
+        ++_size;
     }
+
+    _updateCollectionVersion(chunk->getLastmod());
 }
 
 std::shared_ptr<ChunkInfo> ChunkMap::findIntersectingChunk(const BSONObj& shardKey) const {
     const auto it = _findIntersectingChunk(shardKey);
 
-    if (it != _chunkMap.end())
+    if (it != _end())
         return *it;
 
     return std::shared_ptr<ChunkInfo>();
@@ -222,38 +327,67 @@ void validateChunk(const std::shared_ptr<ChunkInfo>& chunk, const ChunkVersion&
 
 ChunkMap ChunkMap::createMerged(
     const std::vector<std::shared_ptr<ChunkInfo>>& changedChunks) const {
-    size_t chunkMapIndex = 0;
+    size_t blockIndex = 0;
+    size_t chunkIndex = 0;
     size_t changedChunkIndex = 0;
 
     ChunkMap updatedChunkMap(
-        getVersion().epoch(), getVersion().getTimestamp(), _chunkMap.size() + changedChunks.size());
+        getVersion().epoch(), getVersion().getTimestamp(), _size + changedChunks.size());
+
+    // Returns whether the block at 'blockIndex' can be taken over as a whole, which is the case
+    // when neither the next changed chunk nor the last chunk appended so far reach into it.
+    auto canShareBlock = [&](const ChunkBlock& block) {
+        if (changedChunkIndex < changedChunks.size() &&
+            changedChunks[changedChunkIndex]->getMin().woCompare(block.back()->getMax()) < 0)
+            return false;
+
+        return updatedChunkMap._size == 0 ||
+            !updatedChunkMap._blocks.back()->back()->getRange().overlaps(
+                block.front()->getRange());
+    };
+
+    auto advance = [&] {
+        if (++chunkIndex == _blocks[blockIndex]->size()) {
+            ++blockIndex;
+            chunkIndex = 0;
+        }
+    };
 
-    while (chunkMapIndex < _chunkMap.size() || changedChunkIndex < changedChunks.size()) {
-        if (chunkMapIndex >= _chunkMap.size()) {
+    while (blockIndex < _blocks.size() || changedChunkIndex < changedChunks.size()) {
+        if (blockIndex >= _blocks.size()) {
             validateChunk(changedChunks[changedChunkIndex], getVersion());
             updatedChunkMap.appendChunk(changedChunks[changedChunkIndex++]);
             continue;
         }
 
+        const auto& block = _blocks[blockIndex];
+        if (chunkIndex == 0 && canShareBlock(*block)) {
+            updatedChunkMap._appendBlock(block);
+            ++blockIndex;
+            continue;
+        }
+
+        const auto& chunkInfo = (*block)[chunkIndex];
+
         if (changedChunkIndex >= changedChunks.size()) {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+            updatedChunkMap.appendChunk(chunkInfo);
+            advance();
             continue;
         }
 
-        auto overlap = _chunkMap[chunkMapIndex]->getRange().overlaps(
-            changedChunks[changedChunkIndex]->getRange());
+        auto overlap = chunkInfo->getRange().overlaps(changedChunks[changedChunkIndex]->getRange());
 
         if (overlap) {
             auto& changedChunk = changedChunks[changedChunkIndex++];
-            auto& chunkInfo = _chunkMap[chunkMapIndex];
 
-            auto bytesInReplacedChunk = chunkInfo->getWritesTracker()->getBytesWritten();
-            changedChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
+            changedChunk->getWritesTracker()->inheritBytesWritten(
+                *chunkInfo->getWritesTracker());
 
             validateChunk(changedChunk, getVersion());
             updatedChunkMap.appendChunk(changedChunk);
         } else {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+            updatedChunkMap.appendChunk(chunkInfo);
+            advance();
         }
     }
 
@@ -264,50 +398,103 @@ BSONObj ChunkMap::toBSON() const {
     BSONObjBuilder builder;
 
     builder.append("startingVersion"_sd, getVersion().toBSON());
-    builder.append("chunkCount", static_cast<int64_t>(_chunkMap.size()));
+    builder.append("chunkCount", static_cast<int64_t>(_size));
 
     {
         BSONArrayBuilder arrayBuilder(builder.subarrayStart("chunks"_sd));
-        for (const auto& chunk : _chunkMap) {
+        forEach([&](const auto& chunk) {
             arrayBuilder.append(chunk->toString());
-        }
+            return true;
+        });
     }
 
     return builder.obj();
 }
 
-ChunkMap::ChunkVector::const_iterator ChunkMap::_findIntersectingChunk(const BSONObj& shardKey,
-                                                                       bool isMaxInclusive) const {
-    auto shardKeyString = ShardKeyPattern::toKeyString(shardKey);
+bool ChunkMap::sharesBlockWith_forTest(const ChunkMap& other, const BSONObj& shardKey) const {
+    const auto shardKeyString = ShardKeyPattern::toKeyString(shardKey);
+    const auto prefix = keyStringPrefix(shardKeyString);
 
-    if (!isMaxInclusive) {
-        return std::lower_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const auto& chunkInfo, const BSONObj& shardKey) {
-                                    return chunkInfo->getMaxKeyString() < shardKeyString;
-                                });
-    } else {
-        return std::upper_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const BSONObj& shardKey, const auto& chunkInfo) {
-                                    return shardKeyString < chunkInfo->getMaxKeyString();
-                                });
-    }
+    const auto blockIndex = _findBlockIndexByMaxKey(shardKeyString, prefix, true);
+    const auto otherBlockIndex = other._findBlockIndexByMaxKey(shardKeyString, prefix, true);
+    if (blockIndex == _blocks.size() || otherBlockIndex == other._blocks.size())
+        return false;
+
+    return _blocks[blockIndex] == other._blocks[otherBlockIndex];
 }
 
-std::pair<ChunkMap::ChunkVector::const_iterator, ChunkMap::ChunkVector::const_iterator>
-ChunkMap::_overlappingBounds(const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
+ChunkMap::Iterator ChunkMap::_findIntersectingChunk(const BSONObj& shardKey,
+                                                    bool isMaxInclusive) const {
+    const auto shardKeyString = ShardKeyPattern::toKeyString(shardKey);
+    const auto prefix = keyStringPrefix(shardKeyString);
+
+    const auto blockIndex = _findBlockIndexByMaxKey(shardKeyString, prefix, isMaxInclusive);
+    if (blockIndex == _blocks.size())
+        return _end();
+
+    return Iterator(
+        _blocks,
+        blockIndex,
+        _blocks[blockIndex]->findIndexByMaxKey(shardKeyString, prefix, isMaxInclusive));
+}
+
+std::pair<ChunkMap::Iterator, ChunkMap::Iterator> ChunkMap::_overlappingBounds(
+    const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
     const auto itMin = _findIntersectingChunk(min);
     const auto itMax = [&]() {
         auto it = _findIntersectingChunk(max, isMaxInclusive);
-        return it == _chunkMap.end() ? it : ++it;
+        return it == _end() ? it : ++it;
     }();
 
     return {itMin, itMax};
 }
 
+size_t ChunkMap::_findBlockIndexByMaxKey(StringData keyString,
+                                         uint64_t prefix,
+                                         bool isMaxInclusive) const {
+    return findFirstAfter(_blocks.size(), isMaxInclusive, [&](size_t i) {
+        const auto keyPrefix = _blockMaxKeyPrefixes[i];
+        if (keyPrefix != prefix)
+            return keyPrefix < prefix ? -1 : 1;
+
+        const auto& block = *_blocks[i];
+        return block.maxKeyString(block.size() - 1).compare(keyString);
+    });
+}
+
+ChunkMap::ChunkBlock& ChunkMap::_mutableLastBlock() {
+    auto& block = _blocks.back();
+    if (block.use_count() > 1)
+        block = std::make_shared<ChunkBlock>(*block);
+    return *block;
+}
+
+void ChunkMap::_appendBlock(const std::shared_ptr<ChunkBlock>& block) {
+    // Rather than leaving a partially filled block behind, fold the chunks into it if they fit, so
+    // that repeated refreshes of the same range do not fragment the map into small blocks
+    if (_size > 0 && _blocks.back().use_count() == 1 &&
+        _blocks.back()->size() + block->size() <= kMaxChunksPerBlock) {
+        for (size_t i = 0; i < block->size(); ++i) {
+            appendChunk((*block)[i]);
+        }
+        return;
+    }
+
+    _blocks.push_back(block);
+    _blockMaxKeyPrefixes.push_back(block->lastMaxKeyPrefix());
+    _size += block->size();
+    _updateCollectionVersion(block->getMaxVersion());
+}
+
+void ChunkMap::_updateCollectionVersion(const ChunkVersion& chunkVersion) {
+    if (_collectionVersion.isOlderThan(chunkVersion)) {
+        _collectionVersion = ChunkVersion(chunkVersion.majorVersion(),
+                                          chunkVersion.minorVersion(),
+                                          chunkVersion.epoch(),
+                                          _collTimestamp);
+    }
+}
+
 ShardVersionTargetingInfo::ShardVersionTargetingInfo(const OID& epoch,
                                                      const boost::optional<Timestamp>& timestamp)
     : shardVersion(0, 0, epoch, timestamp) {}
@@ -333,7 +520,8 @@ RoutingTableHistory::RoutingTableHistory(
       _maxChunkSizeBytes(maxChunkSizeBytes),
       _allowMigrations(allowMigrations),
       _chunkMap(std::move(chunkMap)),
-      _shardVersions(_chunkMap.constructShardVersionMap()) {}
+      _shardVersions(_chunkMap.constructShardVersionMap()),
+      _targetingCache(std::make_shared<ShardKeyTargetingCache>()) {}
 
 void RoutingTableHistory::setShardStale(const ShardId& shardId) {
     if (gEnableFinerGrainedCatalogCacheRefresh) {
@@ -419,6 +607,23 @@ void ChunkManager::getShardIdsForQuery(boost::intrusive_ptr<ExpressionContext> e
         expCtx->setCollator(defaultCollator->clone());
     }
 
+    // Queries whose shape was already seen bind their shard key straight out of the filter and
+    // skip canonicalization altogether.
+    const auto shapeKey = ShardKeyTargetingCache::computeShapeKey(query);
+    if (shapeKey) {
+        auto boundShardKey = _rt->optRt->_targetingCache->bind(
+            _rt->optRt->getShardKeyPattern(), *shapeKey, query);
+        if (!boundShardKey.isEmpty()) {
+            try {
+                auto chunk = findIntersectingChunk(boundShardKey, collation);
+                shardIds->insert(chunk.getShardId());
+                return;
+            } catch (const DBException&) {
+                // The query uses multiple shards
+            }
+        }
+    }
+
     auto cq = uassertStatusOK(
         CanonicalQuery::canonicalize(expCtx->opCtx,
                                      std::move(findCommand),
@@ -430,6 +635,11 @@ void ChunkManager::getShardIdsForQuery(boost::intrusive_ptr<ExpressionContext> e
     // Fast path for targeting equalities on the shard key.
     auto shardKeyToFind = _rt->optRt->getShardKeyPattern().extractShardKeyFromQuery(*cq);
     if (!shardKeyToFind.isEmpty()) {
+        if (shapeKey) {
+            _rt->optRt->_targetingCache->learn(
+                _rt->optRt->getShardKeyPattern(), *shapeKey, query, shardKeyToFind);
+        }
+
         try {
             auto chunk = findIntersectingChunk(shardKeyToFind, collation);
             shardIds->insert(chunk.getShardId());
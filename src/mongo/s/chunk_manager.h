@@ -42,6 +42,7 @@
 #include "mongo/s/database_version.h"
 #include "mongo/s/resharding/type_collection_fields_gen.h"
 #include "mongo/s/shard_key_pattern.h"
+#include "mongo/s/shard_key_targeting_cache.h"
 #include "mongo/s/type_collection_common_types_gen.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/ticketholder.h"
@@ -76,16 +77,133 @@ class ChunkMap {
     // Vector of chunks ordered by max key.
     using ChunkVector = std::vector<std::shared_ptr<ChunkInfo>>;
 
+    /**
+     * A run of consecutive chunks of the map, ordered by max key. Once a block is referenced by
+     * more than one ChunkMap it is never modified again, which allows the map produced by an
+     * incremental refresh to share every block the refresh did not touch with the map it was
+     * derived from (and with any ChunkManager snapshot still holding on to that map).
+     */
+    class ChunkBlock {
+    public:
+        size_t size() const {
+            return _chunks.size();
+        }
+
+        const std::shared_ptr<ChunkInfo>& operator[](size_t i) const {
+            return _chunks[i];
+        }
+
+        const std::shared_ptr<ChunkInfo>& front() const {
+            return _chunks.front();
+        }
+
+        const std::shared_ptr<ChunkInfo>& back() const {
+            return _chunks.back();
+        }
+
+        StringData maxKeyString(size_t i) const;
+
+        uint64_t lastMaxKeyPrefix() const {
+            return _maxKeyPrefixes.back();
+        }
+
+        /**
+         * Returns the index of the first chunk whose max key is greater than (or, if
+         * 'isMaxInclusive' is false, greater than or equal to) 'keyString', whose leading bytes
+         * are passed in as 'prefix'.
+         */
+        size_t findIndexByMaxKey(StringData keyString, uint64_t prefix, bool isMaxInclusive) const;
+
+        void pushBack(const std::shared_ptr<ChunkInfo>& chunk);
+        void popBack();
+
+        // Max version across all chunks of the block.
+        const ChunkVersion& getMaxVersion() const {
+            return _maxVersion;
+        }
+
+        // Max version of each shard which owns chunks of the block.
+        const stdx::unordered_map<ShardId, ChunkVersion, ShardId::Hasher>& getShardVersions()
+            const {
+            return _shardVersions;
+        }
+
+        // Index of the first chunk which belongs to a different shard than its predecessor and
+        // whose min does not match the max of that predecessor, if any.
+        const boost::optional<size_t>& getFirstDiscontinuity() const {
+            return _firstDiscontinuity;
+        }
+
+    private:
+        ChunkVector _chunks;
+
+        // Max key KeyStrings of the chunks, stored back-to-back so that targeting can binary
+        // search over contiguous memory rather than chase a ChunkInfo pointer at every step. The
+        // i-th key starts at '_maxKeyOffsets[i]' and ends where the next one starts, or at the end
+        // of '_maxKeyArena' for the last chunk. '_maxKeyPrefixes[i]' holds the leading 8 bytes of
+        // the same key as a big-endian integer (zero padded), which settles most comparisons with
+        // a single integer compare and without touching the arena.
+        std::string _maxKeyArena;
+        std::vector<uint32_t> _maxKeyOffsets;
+        std::vector<uint64_t> _maxKeyPrefixes;
+
+        ChunkVersion _maxVersion;
+        stdx::unordered_map<ShardId, ChunkVersion, ShardId::Hasher> _shardVersions;
+        boost::optional<size_t> _firstDiscontinuity;
+    };
+
+    using ChunkBlockVector = std::vector<std::shared_ptr<ChunkBlock>>;
+
+    /**
+     * Forward iterator over the chunks of the map, in max key order.
+     */
+    class Iterator {
+    public:
+        Iterator(const ChunkBlockVector& blocks, size_t blockIndex, size_t chunkIndex)
+            : _blocks(&blocks), _blockIndex(blockIndex), _chunkIndex(chunkIndex) {}
+
+        const std::shared_ptr<ChunkInfo>& operator*() const {
+            return (*(*_blocks)[_blockIndex])[_chunkIndex];
+        }
+
+        Iterator& operator++() {
+            if (++_chunkIndex == (*_blocks)[_blockIndex]->size()) {
+                ++_blockIndex;
+                _chunkIndex = 0;
+            }
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return _blockIndex == other._blockIndex && _chunkIndex == other._chunkIndex;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        const ChunkBlockVector* _blocks;
+        size_t _blockIndex;
+        size_t _chunkIndex;
+    };
+
 public:
+    // Maximum number of chunks stored in a single block. Bounds the amount of work an incremental
+    // refresh spends on each block it touches; the blocks it does not touch cost one pointer copy.
+    static constexpr size_t kMaxChunksPerBlock = 256;
+
     explicit ChunkMap(OID epoch,
                       const boost::optional<Timestamp>& timestamp,
                       size_t initialCapacity = 0)
         : _collectionVersion(0, 0, epoch, timestamp), _collTimestamp(timestamp) {
-        _chunkMap.reserve(initialCapacity);
+        const auto initialBlocks = initialCapacity / kMaxChunksPerBlock + 1;
+        _blocks.reserve(initialBlocks);
+        _blockMaxKeyPrefixes.reserve(initialBlocks);
     }
 
     size_t size() const {
-        return _chunkMap.size();
+        return _size;
     }
 
     ChunkVersion getVersion() const {
@@ -94,9 +212,9 @@ public:
 
     template <typename Callable>
     void forEach(Callable&& handler, const BSONObj& shardKey = BSONObj()) const {
-        auto it = shardKey.isEmpty() ? _chunkMap.begin() : _findIntersectingChunk(shardKey);
+        auto it = shardKey.isEmpty() ? _begin() : _findIntersectingChunk(shardKey);
 
-        for (; it != _chunkMap.end(); ++it) {
+        for (const auto end = _end(); it != end; ++it) {
             if (!handler(*it))
                 break;
         }
@@ -120,17 +238,66 @@ public:
 
     void appendChunk(const std::shared_ptr<ChunkInfo>& chunk);
 
+    /**
+     * Returns a map with 'changedChunks' applied on top of this one. Blocks of chunks which none of
+     * the changed chunks overlap are shared between the two maps rather than copied, so the cost
+     * of the merge is proportional to the number of changed chunks rather than to the size of the
+     * map.
+     */
     ChunkMap createMerged(const std::vector<std::shared_ptr<ChunkInfo>>& changedChunks) const;
 
     BSONObj toBSON() const;
 
+    /**
+     * Returns the number of blocks the chunks of this map are split into. Only used for testing.
+     */
+    size_t numBlocks_forTest() const {
+        return _blocks.size();
+    }
+
+    /**
+     * Returns whether this map and 'other' share the block containing 'shardKey'. Only used for
+     * testing.
+     */
+    bool sharesBlockWith_forTest(const ChunkMap& other, const BSONObj& shardKey) const;
+
 private:
-    ChunkVector::const_iterator _findIntersectingChunk(const BSONObj& shardKey,
-                                                       bool isMaxInclusive = true) const;
-    std::pair<ChunkVector::const_iterator, ChunkVector::const_iterator> _overlappingBounds(
-        const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const;
+    Iterator _begin() const {
+        return Iterator(_blocks, 0, 0);
+    }
+
+    Iterator _end() const {
+        return Iterator(_blocks, _blocks.size(), 0);
+    }
+
+    Iterator _findIntersectingChunk(const BSONObj& shardKey, bool isMaxInclusive = true) const;
+    std::pair<Iterator, Iterator> _overlappingBounds(const BSONObj& min,
+                                                     const BSONObj& max,
+                                                     bool isMaxInclusive) const;
 
-    ChunkVector _chunkMap;
+    // Returns the index of the first block whose last max key is greater than (or, if
+    // 'isMaxInclusive' is false, greater than or equal to) 'keyString'.
+    size_t _findBlockIndexByMaxKey(StringData keyString,
+                                   uint64_t prefix,
+                                   bool isMaxInclusive) const;
+
+    // Returns the last block, after making sure it is owned by this map alone and so can be
+    // modified in place.
+    ChunkBlock& _mutableLastBlock();
+
+    // Appends all the chunks of 'block', sharing it with the map it comes from when possible.
+    void _appendBlock(const std::shared_ptr<ChunkBlock>& block);
+
+    void _updateCollectionVersion(const ChunkVersion& chunkVersion);
+
+    ChunkBlockVector _blocks;
+
+    // Leading bytes of the last max key of each block, see ChunkBlock::_maxKeyPrefixes. Kept
+    // alongside '_blocks' so that locating the block to search does not touch the blocks.
+    std::vector<uint64_t> _blockMaxKeyPrefixes;
+
+    // Total number of chunks across all blocks
+    size_t _size{0};
 
     // Max version across all chunks
     ChunkVersion _collectionVersion;
@@ -383,6 +550,10 @@ private:
     // Note: this declaration must not be moved before _chunkMap since it is initialized by using
     // the _chunkMap instance.
     ShardVersionMap _shardVersions;
+
+    // Plans for binding the shard key of repeated query shapes. Every instance starts with an empty
+    // cache, so plans learned against an older routing table never outlive it.
+    std::shared_ptr<ShardKeyTargetingCache> _targetingCache;
 };
 
 /**
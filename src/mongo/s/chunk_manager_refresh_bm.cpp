@@ -288,6 +288,39 @@ void BM_FindIntersectingChunk(benchmark::State& state,
     state.SetItemsProcessed(state.iterations());
 }
 
+// Measures targeting latency on a routing table which was produced by an incremental refresh rather
+// than a full build, and so also covers the cost of the lookup structures the merge constructs.
+void BM_FindIntersectingChunkAfterIncrementalRefresh(benchmark::State& state) {
+    const int nShards = state.range(0);
+    const int nChunks = state.range(1);
+    auto metadata = makeChunkManagerWithPessimalBalancedDistribution(nShards, nChunks);
+
+    auto postMoveVersion = metadata.getChunkManager()->getVersion();
+    std::vector<ChunkType> newChunks;
+    postMoveVersion.incMajor();
+    newChunks.emplace_back(kNss, getRangeForChunk(1, nChunks), postMoveVersion, ShardId("shard0"));
+    postMoveVersion.incMajor();
+    newChunks.emplace_back(kNss, getRangeForChunk(3, nChunks), postMoveVersion, ShardId("shard1"));
+
+    auto refreshedMetadata = runIncrementalUpdate(metadata, newChunks);
+    auto keys = makeKeys(nChunks);
+    auto keysIter = makeCircularIterator(keys);
+
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(
+            refreshedMetadata.getChunkManager()->findIntersectingChunkWithSimpleCollation(
+                *keysIter));
+        ++keysIter;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_FindIntersectingChunkAfterIncrementalRefresh)
+    ->Args({2, 50000})
+    ->Args({2, 250000})
+    ->Args({2, 500000});
+
 template <typename CollectionMetadataBuilderFn>
 void BM_GetShardIdsForRange(benchmark::State& state,
                             CollectionMetadataBuilderFn makeCollectionMetadata) {
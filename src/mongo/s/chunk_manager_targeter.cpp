@@ -315,33 +315,37 @@ BSONObj ChunkManagerTargeter::extractBucketsShardKeyFromTimeseriesDoc(
     return pattern.extractShardKeyFromDoc(docWithShardKey);
 }
 
-ShardEndpoint ChunkManagerTargeter::targetInsert(OperationContext* opCtx,
-                                                 const BSONObj& doc) const {
-    BSONObj shardKey;
+BSONObj ChunkManagerTargeter::_extractShardKeyForInsert(const BSONObj& doc) const {
+    invariant(_cm->isSharded());
 
-    if (_cm->isSharded()) {
-        const auto& shardKeyPattern = _cm->getShardKeyPattern();
-        if (_nss.isTimeseriesBucketsCollection()) {
-            auto tsFields = _cm->getTimeseriesFields();
-            tassert(5743701, "Missing timeseriesFields on buckets collection", tsFields);
-            shardKey = extractBucketsShardKeyFromTimeseriesDoc(
-                doc, shardKeyPattern, tsFields->getTimeseriesOptions());
-        } else {
-            shardKey = shardKeyPattern.extractShardKeyFromDoc(doc);
-        }
+    BSONObj shardKey;
+    const auto& shardKeyPattern = _cm->getShardKeyPattern();
+    if (_nss.isTimeseriesBucketsCollection()) {
+        auto tsFields = _cm->getTimeseriesFields();
+        tassert(5743701, "Missing timeseriesFields on buckets collection", tsFields);
+        shardKey = extractBucketsShardKeyFromTimeseriesDoc(
+            doc, shardKeyPattern, tsFields->getTimeseriesOptions());
+    } else {
+        shardKey = shardKeyPattern.extractShardKeyFromDoc(doc);
+    }
+
+    // The shard key would only be empty after extraction if we encountered an error case, such
+    // as the shard key possessing an array value or array descendants. If the shard key
+    // presented to the targeter was empty, we would emplace the missing fields, and the
+    // extracted key here would *not* be empty.
+    uassert(ErrorCodes::ShardKeyNotFound,
+            "Shard key cannot contain array values or array descendants.",
+            !shardKey.isEmpty());
 
-        // The shard key would only be empty after extraction if we encountered an error case, such
-        // as the shard key possessing an array value or array descendants. If the shard key
-        // presented to the targeter was empty, we would emplace the missing fields, and the
-        // extracted key here would *not* be empty.
-        uassert(ErrorCodes::ShardKeyNotFound,
-                "Shard key cannot contain array values or array descendants.",
-                !shardKey.isEmpty());
-    }
+    return shardKey;
+}
 
+ShardEndpoint ChunkManagerTargeter::targetInsert(OperationContext* opCtx,
+                                                 const BSONObj& doc) const {
     // Target the shard key or database primary
-    if (!shardKey.isEmpty()) {
-        return uassertStatusOK(_targetShardKey(shardKey, CollationSpec::kSimpleSpec));
+    if (_cm->isSharded()) {
+        return uassertStatusOK(
+            _targetShardKey(_extractShardKeyForInsert(doc), CollationSpec::kSimpleSpec));
     }
 
     // TODO (SERVER-51070): Remove the boost::none when the config server can support shardVersion
@@ -352,6 +356,64 @@ ShardEndpoint ChunkManagerTargeter::targetInsert(OperationContext* opCtx,
         _nss.isOnInternalDb() ? boost::optional<DatabaseVersion>() : _cm->dbVersion());
 }
 
+std::vector<StatusWith<ShardEndpoint>> ChunkManagerTargeter::targetInserts(
+    OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+    std::vector<StatusWith<ShardEndpoint>> endpoints;
+    endpoints.reserve(docs.size());
+
+    if (!_cm->isSharded()) {
+        for (const auto& doc : docs) {
+            endpoints.emplace_back(targetInsert(opCtx, doc));
+        }
+        return endpoints;
+    }
+
+    // Extract the shard keys up front, keeping the error of the documents that don't have one
+    std::vector<boost::optional<StatusWith<ShardEndpoint>>> results(docs.size());
+    std::vector<BSONObj> shardKeys(docs.size());
+    std::vector<size_t> sortedIndexes;
+    sortedIndexes.reserve(docs.size());
+    for (size_t i = 0; i < docs.size(); ++i) {
+        try {
+            shardKeys[i] = _extractShardKeyForInsert(docs[i]);
+            sortedIndexes.push_back(i);
+        } catch (const DBException& ex) {
+            results[i].emplace(ex.toStatus());
+        }
+    }
+
+    // Chunks are ordered by their shard key ranges, so once the keys are sorted, consecutive keys
+    // mostly fall in the same chunk and the chunk only needs to be looked up again when a key
+    // falls past its upper bound.
+    std::sort(sortedIndexes.begin(), sortedIndexes.end(), [&](size_t lhs, size_t rhs) {
+        return shardKeys[lhs].woCompare(shardKeys[rhs]) < 0;
+    });
+
+    boost::optional<Chunk> chunk;
+    boost::optional<ShardEndpoint> chunkEndpoint;
+    for (const auto i : sortedIndexes) {
+        if (!chunk || !chunk->containsKey(shardKeys[i])) {
+            try {
+                chunk.emplace(_cm->findIntersectingChunkWithSimpleCollation(shardKeys[i]));
+                chunkEndpoint.emplace(
+                    chunk->getShardId(), _cm->getVersion(chunk->getShardId()), boost::none);
+            } catch (const DBException& ex) {
+                chunk = boost::none;
+                results[i].emplace(ex.toStatus());
+                continue;
+            }
+        }
+
+        results[i].emplace(*chunkEndpoint);
+    }
+
+    for (auto& result : results) {
+        endpoints.push_back(std::move(*result));
+    }
+
+    return endpoints;
+}
+
 std::vector<ShardEndpoint> ChunkManagerTargeter::targetUpdate(OperationContext* opCtx,
                                                               const BatchItemRef& itemRef) const {
     // If the update is replacement-style:
@@ -79,6 +79,13 @@ public:
 
     ShardEndpoint targetInsert(OperationContext* opCtx, const BSONObj& doc) const override;
 
+    /**
+     * Extracts the shard keys of all the documents, sorts them and looks up the chunk owning each
+     * of them in a single pass, so that each chunk is looked up at most once.
+     */
+    std::vector<StatusWith<ShardEndpoint>> targetInserts(
+        OperationContext* opCtx, const std::vector<BSONObj>& docs) const override;
+
     std::vector<ShardEndpoint> targetUpdate(OperationContext* opCtx,
                                             const BatchItemRef& itemRef) const override;
 
@@ -118,6 +125,13 @@ public:
 private:
     void _init(OperationContext* opCtx);
 
+    /**
+     * Returns the shard key which an insert of 'doc' must be routed with, or throws
+     * ShardKeyNotFound if 'doc' is malformed with respect to the shard key pattern. Must only be
+     * called if the collection is sharded.
+     */
+    BSONObj _extractShardKeyForInsert(const BSONObj& doc) const;
+
     /**
      * Returns a vector of ShardEndpoints for a potentially multi-shard query.
      *
@@ -120,6 +120,38 @@ TEST_F(ChunkManagerTargeterTest, TargetInsertWithRangePrefixHashedShardKey) {
                        ErrorCodes::ShardKeyNotFound);
 }
 
+TEST_F(ChunkManagerTargeterTest, TargetInsertsMatchesTargetInsertForEachDocument) {
+    // Create 5 chunks and 5 shards such that shardId '0' has chunk [MinKey, null), '1' has chunk
+    // [null, -100), '2' has chunk [-100, 0), '3' has chunk ['0', 100) and '4' has chunk
+    // [100, MaxKey).
+    std::vector<BSONObj> splitPoints = {
+        BSON("a" << BSONNULL), BSON("a" << -100), BSON("a" << 0), BSON("a" << 100)};
+    auto cmTargeter = prepare(BSON("a" << 1), splitPoints);
+
+    // Documents out of shard key order, several per chunk, and ones without a valid shard key.
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 50; ++i) {
+        docs.push_back(BSON("a" << (i * 37) % 500 - 250));
+    }
+    docs.push_back(BSONObj());
+    docs.push_back(fromjson("{a: [1, 2]}"));
+    docs.push_back(BSON("a" << 50));
+
+    const auto endpoints = cmTargeter.targetInserts(operationContext(), docs);
+    ASSERT_EQUALS(docs.size(), endpoints.size());
+    for (size_t i = 0; i < docs.size(); ++i) {
+        try {
+            const auto expected = cmTargeter.targetInsert(operationContext(), docs[i]);
+            ASSERT_OK(endpoints[i].getStatus());
+            ASSERT_EQUALS(expected.shardName, endpoints[i].getValue().shardName);
+            ASSERT_EQUALS(*expected.shardVersion, *endpoints[i].getValue().shardVersion);
+        } catch (const DBException& ex) {
+            ASSERT_EQUALS(ex.code(), endpoints[i].getStatus().code());
+        }
+    }
+    ASSERT_EQUALS(ErrorCodes::ShardKeyNotFound, endpoints[docs.size() - 2].getStatus());
+}
+
 TEST_F(ChunkManagerTargeterTest, TargetInsertsWithVaryingHashedPrefixAndConstantRangedSuffix) {
     // Create 4 chunks and 4 shards such that shardId '0' has chunk [MinKey, -2^62), '1' has chunk
     // [-2^62, 0), '2' has chunk ['0', 2^62) and '3' has chunk [2^62, MaxKey).
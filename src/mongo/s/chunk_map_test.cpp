@@ -45,6 +45,24 @@ public:
         return _shardKeyPattern;
     }
 
+    /**
+     * Returns 'nChunks' chunks covering the whole key space, split at multiples of 'step' and with
+     * every chunk at 'version' on shard 'kThisShard'.
+     */
+    std::vector<std::shared_ptr<ChunkInfo>> makeChunks(int nChunks,
+                                                       const ChunkVersion& version,
+                                                       int step = 10) const {
+        std::vector<std::shared_ptr<ChunkInfo>> chunks;
+        for (int i = 0; i < nChunks; ++i) {
+            auto min = i == 0 ? getShardKeyPattern().globalMin() : BSON("a" << i * step);
+            auto max =
+                i + 1 == nChunks ? getShardKeyPattern().globalMax() : BSON("a" << (i + 1) * step);
+            chunks.push_back(std::make_shared<ChunkInfo>(
+                ChunkType{kNss, ChunkRange{std::move(min), std::move(max)}, version, kThisShard}));
+        }
+        return chunks;
+    }
+
 private:
     KeyPattern _shardKeyPattern{BSON("a" << 1)};
 };
@@ -165,4 +183,222 @@ TEST_F(ChunkMapTest, TestEnumerateOverlappingChunks) {
     ASSERT_EQ(count, 3);
 }
 
+TEST_F(ChunkMapTest, TestIntersectingChunkWithBoundsSharingLongPrefix) {
+    const OID epoch = OID::gen();
+    ChunkMap chunkMap{epoch, boost::none /* timestamp */};
+    ChunkVersion version{1, 0, epoch, boost::none /* timestamp */};
+
+    // All the bounds share a prefix which is longer than the part of the key that the chunk map
+    // compares without looking at the full KeyString.
+    const std::string prefix = "commonShardKeyPrefix_";
+    auto boundAt = [&](int i) { return BSON("a" << (prefix + std::to_string(i * 10))); };
+
+    std::vector<std::shared_ptr<ChunkInfo>> chunks;
+    chunks.push_back(std::make_shared<ChunkInfo>(ChunkType{
+        kNss, ChunkRange{getShardKeyPattern().globalMin(), boundAt(1)}, version, kThisShard}));
+    for (int i = 1; i < 9; ++i) {
+        chunks.push_back(std::make_shared<ChunkInfo>(
+            ChunkType{kNss, ChunkRange{boundAt(i), boundAt(i + 1)}, version, kThisShard}));
+    }
+    chunks.push_back(std::make_shared<ChunkInfo>(ChunkType{
+        kNss, ChunkRange{boundAt(9), getShardKeyPattern().globalMax()}, version, kThisShard}));
+
+    auto newChunkMap = chunkMap.createMerged(chunks);
+    ASSERT_EQ(newChunkMap.size(), chunks.size());
+
+    for (int i = 1; i < 10; ++i) {
+        // A chunk's min is inclusive, so a key equal to a bound belongs to the chunk on its right.
+        auto atBound = newChunkMap.findIntersectingChunk(boundAt(i));
+        ASSERT(atBound);
+        ASSERT_BSONOBJ_EQ(atBound->getMin(), boundAt(i));
+
+        auto pastBound =
+            newChunkMap.findIntersectingChunk(BSON("a" << (prefix + std::to_string(i * 10) + "5")));
+        ASSERT(pastBound);
+        ASSERT_BSONOBJ_EQ(pastBound->getMin(), boundAt(i));
+    }
+
+    auto first = newChunkMap.findIntersectingChunk(BSON("a" << prefix));
+    ASSERT(first);
+    ASSERT_BSONOBJ_EQ(first->getMin(), getShardKeyPattern().globalMin());
+}
+
+TEST_F(ChunkMapTest, TestIntersectingChunkAfterMergingSplitChunks) {
+    const OID epoch = OID::gen();
+    ChunkMap chunkMap{epoch, boost::none /* timestamp */};
+    ChunkVersion version{1, 0, epoch, boost::none /* timestamp */};
+
+    auto chunkMapBeforeSplit = chunkMap.createMerged(
+        {std::make_shared<ChunkInfo>(
+             ChunkType{kNss,
+                       ChunkRange{getShardKeyPattern().globalMin(), BSON("a" << 0)},
+                       version,
+                       kThisShard}),
+
+         std::make_shared<ChunkInfo>(
+             ChunkType{kNss, ChunkRange{BSON("a" << 0), BSON("a" << 100)}, version, kThisShard}),
+
+         std::make_shared<ChunkInfo>(ChunkType{
+             kNss,
+             ChunkRange{BSON("a" << 100), getShardKeyPattern().globalMax()},
+             version,
+             kThisShard})});
+
+    version.incMajor();
+    auto chunkMapAfterSplit = chunkMapBeforeSplit.createMerged(
+        {std::make_shared<ChunkInfo>(
+             ChunkType{kNss, ChunkRange{BSON("a" << 0), BSON("a" << 50)}, version, kThisShard}),
+         std::make_shared<ChunkInfo>(ChunkType{
+             kNss, ChunkRange{BSON("a" << 50), BSON("a" << 100)}, version, kThisShard})});
+
+    ASSERT_EQ(chunkMapAfterSplit.size(), 4);
+
+    auto left = chunkMapAfterSplit.findIntersectingChunk(BSON("a" << 25));
+    ASSERT(left);
+    ASSERT_BSONOBJ_EQ(left->getMax(), BSON("a" << 50));
+
+    auto right = chunkMapAfterSplit.findIntersectingChunk(BSON("a" << 50));
+    ASSERT(right);
+    ASSERT_BSONOBJ_EQ(right->getMax(), BSON("a" << 100));
+
+    auto last = chunkMapAfterSplit.findIntersectingChunk(BSON("a" << 100));
+    ASSERT(last);
+    ASSERT_BSONOBJ_EQ(last->getMax(), getShardKeyPattern().globalMax());
+
+    int count = 0;
+    chunkMapAfterSplit.forEachOverlappingChunk(
+        BSON("a" << 10), BSON("a" << 50), false, [&](const auto& chunk) {
+            count++;
+            return true;
+        });
+    ASSERT_EQ(count, 1);
+}
+
+TEST_F(ChunkMapTest, TestIncrementalMergeSharesUntouchedBlocks) {
+    const OID epoch = OID::gen();
+    ChunkVersion version{1, 0, epoch, boost::none /* timestamp */};
+
+    const int nChunks = 4 * ChunkMap::kMaxChunksPerBlock;
+    const auto chunkMap = ChunkMap{epoch, boost::none /* timestamp */}.createMerged(
+        makeChunks(nChunks, version));
+    ASSERT_EQ(chunkMap.size(), nChunks);
+    ASSERT_EQ(chunkMap.numBlocks_forTest(), 4);
+
+    // Split a chunk in the middle of the third block.
+    const int splitChunk = 2 * ChunkMap::kMaxChunksPerBlock + 10;
+    version.incMajor();
+    auto left = std::make_shared<ChunkInfo>(ChunkType{
+        kNss,
+        ChunkRange{BSON("a" << splitChunk * 10), BSON("a" << splitChunk * 10 + 5)},
+        version,
+        kThisShard});
+    version.incMinor();
+    auto right = std::make_shared<ChunkInfo>(ChunkType{
+        kNss,
+        ChunkRange{BSON("a" << splitChunk * 10 + 5), BSON("a" << (splitChunk + 1) * 10)},
+        version,
+        kThisShard});
+
+    const auto mergedChunkMap = chunkMap.createMerged({left, right});
+    ASSERT_EQ(mergedChunkMap.size(), nChunks + 1);
+    ASSERT_EQ(mergedChunkMap.getVersion(), version);
+
+    ASSERT(mergedChunkMap.sharesBlockWith_forTest(chunkMap, BSON("a" << 0)));
+    ASSERT(mergedChunkMap.sharesBlockWith_forTest(chunkMap, BSON("a" << nChunks / 4 * 10)));
+    ASSERT_FALSE(mergedChunkMap.sharesBlockWith_forTest(chunkMap, BSON("a" << splitChunk * 10)));
+    ASSERT(mergedChunkMap.sharesBlockWith_forTest(chunkMap, BSON("a" << (nChunks - 1) * 10)));
+
+    ASSERT_EQ(mergedChunkMap.findIntersectingChunk(BSON("a" << splitChunk * 10 + 7)), right);
+    ASSERT_EQ(mergedChunkMap.findIntersectingChunk(BSON("a" << splitChunk * 10 + 2)), left);
+
+    // The map the merge was derived from is left as it was.
+    ASSERT_EQ(chunkMap.size(), nChunks);
+    auto oldChunk = chunkMap.findIntersectingChunk(BSON("a" << splitChunk * 10 + 7));
+    ASSERT_BSONOBJ_EQ(oldChunk->getMin(), BSON("a" << splitChunk * 10));
+    ASSERT_BSONOBJ_EQ(oldChunk->getMax(), BSON("a" << (splitChunk + 1) * 10));
+
+    int count = 0;
+    auto lastMax = getShardKeyPattern().globalMin();
+    mergedChunkMap.forEach([&](const auto& chunkInfo) {
+        ASSERT_BSONOBJ_EQ(chunkInfo->getMin(), lastMax);
+        lastMax = chunkInfo->getMax();
+        count++;
+        return true;
+    });
+    ASSERT_EQ(count, nChunks + 1);
+
+    auto shardVersions = mergedChunkMap.constructShardVersionMap();
+    ASSERT_EQ(shardVersions.size(), 1);
+    ASSERT_EQ(shardVersions.at(kThisShard).shardVersion, version);
+}
+
+TEST_F(ChunkMapTest, TestRepeatedIncrementalMergesDoNotFragmentBlocks) {
+    const OID epoch = OID::gen();
+    ChunkVersion version{1, 0, epoch, boost::none /* timestamp */};
+
+    const int nChunks = 4 * ChunkMap::kMaxChunksPerBlock;
+    const int step = 1000;
+    auto chunkMap = ChunkMap{epoch, boost::none /* timestamp */}.createMerged(
+        makeChunks(nChunks, version, step));
+
+    // Keep carving the lowest key off the same chunk, so that every refresh touches the same block
+    // and adds one chunk to it, until the block has to grow past its maximum size.
+    const int nSplits = ChunkMap::kMaxChunksPerBlock + ChunkMap::kMaxChunksPerBlock / 2;
+    const int chunkMax = 2 * ChunkMap::kMaxChunksPerBlock * step + step;
+    for (int splitMin = chunkMax - step; splitMin < chunkMax - step + nSplits; ++splitMin) {
+        version.incMajor();
+        chunkMap = chunkMap.createMerged(
+            {std::make_shared<ChunkInfo>(
+                 ChunkType{kNss,
+                           ChunkRange{BSON("a" << splitMin), BSON("a" << splitMin + 1)},
+                           version,
+                           kThisShard}),
+             std::make_shared<ChunkInfo>(
+                 ChunkType{kNss,
+                           ChunkRange{BSON("a" << splitMin + 1), BSON("a" << chunkMax)},
+                           version,
+                           kThisShard})});
+    }
+
+    ASSERT_EQ(chunkMap.size(), nChunks + nSplits);
+    ASSERT_EQ(chunkMap.constructShardVersionMap().at(kThisShard).shardVersion, version);
+    ASSERT_LTE(chunkMap.numBlocks_forTest(),
+               2 * chunkMap.size() / ChunkMap::kMaxChunksPerBlock + 1);
+}
+
+TEST_F(ChunkMapTest, TestGapBetweenBlocksIsDetected) {
+    const OID epoch = OID::gen();
+    ChunkVersion version{1, 0, epoch, boost::none /* timestamp */};
+
+    // Leave a gap right at the boundary between the first two blocks, with the chunks on either
+    // side of it owned by different shards.
+    const int boundary = ChunkMap::kMaxChunksPerBlock;
+    std::vector<std::shared_ptr<ChunkInfo>> chunks;
+    for (const auto& chunk : makeChunks(2 * ChunkMap::kMaxChunksPerBlock, version)) {
+        if (chunk->getMin().woCompare(BSON("a" << boundary * 10)) < 0) {
+            chunks.push_back(chunk);
+            continue;
+        }
+
+        if (SimpleBSONObjComparator::kInstance.evaluate(chunk->getMin() ==
+                                                        BSON("a" << boundary * 10))) {
+            chunks.push_back(std::make_shared<ChunkInfo>(ChunkType{
+                kNss,
+                ChunkRange{BSON("a" << boundary * 10 + 5), chunk->getMax()},
+                version,
+                ShardId("otherShard")}));
+            continue;
+        }
+
+        chunks.push_back(std::make_shared<ChunkInfo>(
+            ChunkType{kNss, chunk->getRange(), version, ShardId("otherShard")}));
+    }
+
+    const auto chunkMap = ChunkMap{epoch, boost::none /* timestamp */}.createMerged(chunks);
+    ASSERT_EQ(chunkMap.numBlocks_forTest(), 2);
+    ASSERT_THROWS_CODE(chunkMap.constructShardVersionMap(),
+                       DBException,
+                       ErrorCodes::ConflictingOperationInProgress);
+}
+
 }  // namespace mongo
@@ -42,6 +42,11 @@ uint64_t ChunkWritesTracker::clearBytesWritten() {
     return _bytesWritten.swap(0);
 }
 
+void ChunkWritesTracker::inheritBytesWritten(ChunkWritesTracker& other) {
+    _bytesWritten.fetchAndAdd(other.getBytesWritten());
+    _totalBytesWritten.fetchAndAdd(other.getTotalBytesWritten());
+}
+
 bool ChunkWritesTracker::shouldSplit(uint64_t maxChunkSize) {
     if (_isLockedForSplitting) {
         return false;
@@ -47,6 +47,7 @@ public:
      */
     void addBytesWritten(uint64_t bytesWritten) {
         _bytesWritten.fetchAndAdd(bytesWritten);
+        _totalBytesWritten.fetchAndAdd(bytesWritten);
     }
 
     /**
@@ -62,6 +63,22 @@ public:
      */
     uint64_t clearBytesWritten();
 
+    /**
+     * Returns the number of bytes that have been written to the chunk since the tracker was
+     * created, including the bytes carried over from the chunks it replaced. Unlike
+     * getBytesWritten, this counter is not reset by clearBytesWritten and so can be sampled to
+     * compute the rate at which the chunk is being written.
+     */
+    uint64_t getTotalBytesWritten() {
+        return _totalBytesWritten.loadRelaxed();
+    }
+
+    /**
+     * Carries over the bytes written to 'other', which is being replaced by the chunk this tracker
+     * belongs to after a routing table refresh.
+     */
+    void inheritBytesWritten(ChunkWritesTracker& other);
+
     /**
      * Returns whether or not this chunk is ready to be split based on the
      * maximum allowable size of a chunk.
@@ -86,6 +103,12 @@ private:
      */
     AtomicWord<unsigned long long> _bytesWritten{0};
 
+    /**
+     * The number of bytes that have been written to this chunk, never cleared. May be modified
+     * concurrently by several threads.
+     */
+    AtomicWord<unsigned long long> _totalBytesWritten{0};
+
     /**
      * Protects _splitState when starting a split.
      */
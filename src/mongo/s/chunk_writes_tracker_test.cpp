@@ -64,6 +64,28 @@ TEST(ChunkWritesTrackerTest, ClearBytesWrittenReturnsBytesWrittenBeforeClearing)
     ASSERT_EQ(previousBytesWritten, bytesToAdd);
 }
 
+TEST(ChunkWritesTrackerTest, ClearBytesWrittenDoesNotClearTotalBytesWritten) {
+    ChunkWritesTracker wt;
+    wt.addBytesWritten(4ull);
+    wt.clearBytesWritten();
+    wt.addBytesWritten(2ull);
+    ASSERT_EQ(wt.getBytesWritten(), 2ull);
+    ASSERT_EQ(wt.getTotalBytesWritten(), 6ull);
+}
+
+TEST(ChunkWritesTrackerTest, InheritBytesWrittenCarriesOverBothCounters) {
+    ChunkWritesTracker replaced;
+    replaced.addBytesWritten(4ull);
+    replaced.clearBytesWritten();
+    replaced.addBytesWritten(3ull);
+
+    ChunkWritesTracker wt;
+    wt.addBytesWritten(1ull);
+    wt.inheritBytesWritten(replaced);
+    ASSERT_EQ(wt.getBytesWritten(), 4ull);
+    ASSERT_EQ(wt.getTotalBytesWritten(), 8ull);
+}
+
 TEST(ChunkWritesTrackerTest, ShouldSplitReturnsTrueWithBytesWrittenAndMaxChunkSizeZero) {
     ChunkWritesTracker wt;
     wt.addBytesWritten(4ull);
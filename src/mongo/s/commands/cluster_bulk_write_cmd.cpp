@@ -0,0 +1,152 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/commands.h"
+#include "mongo/db/commands/write_commands_common.h"
+#include "mongo/db/not_primary_error_tracker.h"
+#include "mongo/db/ops/write_ops.h"
+#include "mongo/s/cluster_write.h"
+#include "mongo/s/transaction_router.h"
+#include "mongo/s/write_ops/batched_command_request.h"
+#include "mongo/s/write_ops/batched_command_response.h"
+#include "mongo/util/visit_helper.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Executes the write commands of a bulkWrite command one after the other, each with a single pass
+ * of the batch write executor, and replies with each write command's reply.
+ */
+class ClusterBulkWriteCmd final : public TypedCommand<ClusterBulkWriteCmd> {
+public:
+    using Request = write_ops::BulkWriteCommandRequest;
+    using Reply = write_ops::BulkWriteCommandReply;
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const final {
+        return AllowedOnSecondary::kNever;
+    }
+
+    std::string help() const final {
+        return "execute insert, update and delete commands on one or more collections";
+    }
+
+    ReadWriteType getReadWriteType() const final {
+        return Command::ReadWriteType::kWrite;
+    }
+
+    class Invocation final : public InvocationBase {
+    public:
+        Invocation(OperationContext* opCtx,
+                   const Command* command,
+                   const OpMsgRequest& opMsgRequest)
+            : InvocationBase(opCtx, command, opMsgRequest),
+              _writeCommands(BulkWriteOp::parse(request(), opCtx->getTxnNumber().has_value())) {}
+
+        bool supportsWriteConcern() const final {
+            return true;
+        }
+
+        NamespaceString ns() const final {
+            return NamespaceString(request().getDbName());
+        }
+
+        Reply typedRun(OperationContext* opCtx) {
+            std::vector<BSONObj> results;
+            for (auto& writeCommand : _writeCommands) {
+                auto batchedRequest = stdx::visit(
+                    visit_helper::Overloaded{
+                        [](write_ops::InsertCommandRequest& op) {
+                            return BatchedCommandRequest::cloneInsertWithIds(
+                                BatchedCommandRequest(std::move(op)));
+                        },
+                        [](write_ops::UpdateCommandRequest& op) {
+                            return BatchedCommandRequest(std::move(op));
+                        },
+                        [](write_ops::DeleteCommandRequest& op) {
+                            return BatchedCommandRequest(std::move(op));
+                        }},
+                    writeCommand);
+
+                // Like the individual write commands, use the client's write concern unless it
+                // was defaulted, and never send one inside a transaction.
+                if (TransactionRouter::get(opCtx)) {
+                    batchedRequest.unsetWriteConcern();
+                } else if (opCtx->getWriteConcern().usedDefaultConstructedWC) {
+                    batchedRequest.setWriteConcern(BSONObj());
+                } else {
+                    batchedRequest.setWriteConcern(opCtx->getWriteConcern().toBSON());
+                }
+
+                BatchWriteExecStats stats;
+                BatchedCommandResponse response;
+                cluster::write(opCtx, batchedRequest, &stats, &response);
+
+                const bool failed = !response.getOk() || response.isErrDetailsSet();
+                results.push_back(response.toBSON());
+                if (failed && request().getOrdered()) {
+                    break;
+                }
+            }
+
+            Reply reply;
+            reply.setResults(std::move(results));
+            return reply;
+        }
+
+    private:
+        void doCheckAuthorization(OperationContext* opCtx) const final {
+            auto authSession = AuthorizationSession::get(opCtx->getClient());
+            for (const auto& writeCommand : _writeCommands) {
+                stdx::visit(
+                    visit_helper::Overloaded{
+                        [&](const write_ops::InsertCommandRequest& op) {
+                            auth::checkAuthForInsertCommand(
+                                authSession, op.getBypassDocumentValidation(), op);
+                        },
+                        [&](const write_ops::UpdateCommandRequest& op) {
+                            auth::checkAuthForUpdateCommand(
+                                authSession, op.getBypassDocumentValidation(), op);
+                        },
+                        [&](const write_ops::DeleteCommandRequest& op) {
+                            auth::checkAuthForDeleteCommand(
+                                authSession, op.getBypassDocumentValidation(), op);
+                        }},
+                    writeCommand);
+            }
+        }
+
+        std::vector<BulkWriteOp::WriteCommandRequest> _writeCommands;
+    };
+} clusterBulkWriteCmd;
+
+}  // namespace
+}  // namespace mongo
@@ -610,8 +610,7 @@ Status ParseAndRunCommand::RunInvocation::_setup() {
     auto& apiParams = APIParameters::get(opCtx);
     auto& apiVersionMetrics = APIVersionMetrics::get(opCtx->getServiceContext());
     if (auto clientMetadata = ClientMetadata::get(opCtx->getClient())) {
-        auto appName = clientMetadata->getApplicationName().toString();
-        apiVersionMetrics.update(appName, apiParams);
+        apiVersionMetrics.update(opCtx->getClient(), clientMetadata->getApplicationName(), apiParams);
     }
 
     rpc::readRequestMetadata(opCtx, request, command->requiresAuth());
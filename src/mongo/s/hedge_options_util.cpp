@@ -45,6 +45,10 @@ const std::set<std::string> supportedCmds{"collStats",
                                           "listCollections",
                                           "listIndexes",
                                           "planCacheListFilters"};
+
+// Hedged requests which run for longer than this percentile of their target's recent latencies
+// are unlikely to return before the original request.
+constexpr double kHedgeLatencyPercentile = 0.95;
 }  // namespace
 
 boost::optional<executor::RemoteCommandRequestOnAny::HedgeOptions> extractHedgeOptions(
@@ -63,4 +67,24 @@ boost::optional<executor::RemoteCommandRequestOnAny::HedgeOptions> extractHedgeO
     return boost::none;
 }
 
+void capHedgeOptionsAtLatencyPercentile(
+    const std::vector<HostAndPort>& hosts,
+    const ReplicaLatencyTracker& tracker,
+    executor::RemoteCommandRequestOnAny::HedgeOptions* hedgeOptions) {
+    boost::optional<Milliseconds> budget;
+    for (size_t idx = 1; idx < hosts.size() && idx <= hedgeOptions->count; ++idx) {
+        auto percentile = tracker.getLatencyPercentile(hosts[idx], kHedgeLatencyPercentile);
+        if (!percentile) {
+            // Without a latency estimate for this target keep the configured maxTimeMS, which
+            // then also bounds the hedges sent to the other targets.
+            return;
+        }
+        budget = budget ? std::max(*budget, *percentile) : *percentile;
+    }
+
+    if (budget && *budget < Milliseconds(hedgeOptions->maxTimeMSForHedgedReads)) {
+        hedgeOptions->maxTimeMSForHedgedReads = durationCount<Milliseconds>(*budget);
+    }
+}
+
 }  // namespace mongo
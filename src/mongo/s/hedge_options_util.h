@@ -32,6 +32,7 @@
 
 #include "mongo/client/read_preference.h"
 #include "mongo/executor/remote_command_request.h"
+#include "mongo/s/replica_latency_tracker.h"
 
 namespace mongo {
 
@@ -42,4 +43,16 @@ namespace mongo {
 boost::optional<executor::RemoteCommandRequestOnAny::HedgeOptions> extractHedgeOptions(
     const BSONObj& cmdObj, const ReadPreferenceSetting& readPref);
 
+/**
+ * Lowers the maxTimeMS of the hedged requests described by 'hedgeOptions' to the highest 95th
+ * percentile latency, as observed by 'tracker', among the hosts they will be sent to. 'hosts' are
+ * the targets of the request in the order in which they will be tried; the first one receives the
+ * original request and the following 'hedgeOptions.count' ones receive the hedges. Leaves the
+ * options unchanged if any of the hedge targets does not have enough latency samples yet.
+ */
+void capHedgeOptionsAtLatencyPercentile(
+    const std::vector<HostAndPort>& hosts,
+    const ReplicaLatencyTracker& tracker,
+    executor::RemoteCommandRequestOnAny::HedgeOptions* hedgeOptions);
+
 }  // namespace mongo
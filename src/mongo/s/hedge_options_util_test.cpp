@@ -191,5 +191,30 @@ TEST_F(HedgeOptionsUtilTestFixture, MaxTimeMSForHedgedReads) {
     checkHedgeOptions(parameters, cmdObj, rspObj, true, 100);
 }
 
+TEST_F(HedgeOptionsUtilTestFixture, CapMaxTimeMSAtHedgeTargetLatencyPercentile) {
+    const HostAndPort primary("primary", 27017);
+    const HostAndPort secondary("secondary", 27017);
+
+    ReplicaLatencyTracker tracker;
+    executor::RemoteCommandRequestOnAny::HedgeOptions hedgeOptions{1, 100};
+
+    // Without latency samples for the hedge target the configured maxTimeMS is kept.
+    capHedgeOptionsAtLatencyPercentile({primary, secondary}, tracker, &hedgeOptions);
+    ASSERT_EQ(hedgeOptions.maxTimeMSForHedgedReads, 100);
+
+    for (uint32_t i = 0; i < ReplicaLatencyTracker::kMinSamplesForPercentile; ++i) {
+        tracker.onRequestStarted(secondary);
+        tracker.onRequestFinished(secondary, secondary, Microseconds(Milliseconds(8)));
+    }
+    capHedgeOptionsAtLatencyPercentile({primary, secondary}, tracker, &hedgeOptions);
+    ASSERT_GTE(hedgeOptions.maxTimeMSForHedgedReads, 8);
+    ASSERT_LT(hedgeOptions.maxTimeMSForHedgedReads, 100);
+
+    // The percentile never raises the configured maxTimeMS.
+    executor::RemoteCommandRequestOnAny::HedgeOptions lowHedgeOptions{1, 5};
+    capHedgeOptionsAtLatencyPercentile({primary, secondary}, tracker, &lowHedgeOptions);
+    ASSERT_EQ(lowHedgeOptions.maxTimeMSForHedgedReads, 5);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -76,6 +76,14 @@ public:
      */
     virtual ShardEndpoint targetInsert(OperationContext* opCtx, const BSONObj& doc) const = 0;
 
+    /**
+     * Returns, for each of the documents in 'docs', the ShardEndpoint targetInsert would return
+     * for it or the error it would throw. Targeting is done for the whole batch at once, which is
+     * cheaper than targeting the documents one by one.
+     */
+    virtual std::vector<StatusWith<ShardEndpoint>> targetInserts(
+        OperationContext* opCtx, const std::vector<BSONObj>& docs) const = 0;
+
     /**
      * Returns a vector of ShardEndpoints for a potentially multi-shard update or throws
      * ShardKeyNotFound if 'updateOp' misses a shard key, but the type of update requires it.
@@ -107,8 +107,7 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
       // since that is not supported we treat boost::none (unspecified) to mean 'kNormal'.
       _tailableMode(params.getTailableMode().value_or(TailableModeEnum::kNormal)),
       _params(std::move(params)),
-      _mergeQueue(MergingComparator(
-          _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey())),
+      _mergeQueue(_params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey()),
       _promisedMinSortKeys(PromisedMinSortKeyComparator(_params.getSort().value_or(BSONObj()))) {
     if (params.getTxnNumber()) {
         invariant(params.getSessionId());
@@ -176,6 +175,11 @@ bool AsyncResultsMerger::_remotesExhausted(WithLock) const {
     return true;
 }
 
+void AsyncResultsMerger::setDocsNeeded(long long docsNeeded) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _docsNeededLimit = _numResultsReturned + docsNeeded;
+}
+
 Status AsyncResultsMerger::setAwaitDataTimeout(Milliseconds awaitDataTimeout) {
     stdx::lock_guard<Latch> lk(_mutex);
 
@@ -360,7 +364,11 @@ StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
         return {ClusterQueryResult()};
     }
 
-    return _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
+    auto result = _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
+    if (!result.isEOF()) {
+        ++_numResultsReturned;
+    }
+    return {std::move(result)};
 }
 
 ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
@@ -372,7 +380,6 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     }
 
     size_t smallestRemote = _mergeQueue.top();
-    _mergeQueue.pop();
 
     invariant(!_remotes[smallestRemote].docBuffer.empty());
     invariant(_remotes[smallestRemote].status.isOK());
@@ -383,7 +390,10 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
     // next result.
     if (!_remotes[smallestRemote].docBuffer.empty()) {
-        _mergeQueue.push(smallestRemote);
+        _mergeQueue.setHead(smallestRemote,
+                            *_remotes[smallestRemote].docBuffer.front().getResult());
+    } else {
+        _mergeQueue.removeHead(smallestRemote);
     }
 
     // For sorted tailable awaitData cursors, update the high water mark to the document's sort key.
@@ -443,6 +453,16 @@ Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
         adjustedBatchSize = *_params.getBatchSize() - remote.fetchedCount;
     }
 
+    // Don't make the remote produce and ship more results than the caller is still going to
+    // consume.
+    if (_docsNeededLimit) {
+        const long long docsStillNeeded =
+            std::max(1LL, *_docsNeededLimit - _numResultsReturned);
+        if (!adjustedBatchSize || *adjustedBatchSize > docsStillNeeded) {
+            adjustedBatchSize = docsStillNeeded;
+        }
+    }
+
     GetMoreCommandRequest getMoreRequest(remote.cursorId, remote.cursorNss.coll().toString());
     getMoreRequest.setBatchSize(adjustedBatchSize);
     if (_awaitDataTimeout) {
@@ -736,6 +756,7 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
         remote.partialResultsReturned = (remote.status != ErrorCodes::ExchangePassthrough);
         std::queue<ClusterQueryResult> emptyBuffer;
         std::swap(remote.docBuffer, emptyBuffer);
+        _mergeQueue.removeHead(remoteIndex);
         remote.status = Status::OK();
         remote.cursorId = 0;
     }
@@ -818,7 +839,7 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
     // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
     // queue.
     if (_params.getSort() && !response.getBatch().empty()) {
-        _mergeQueue.push(remoteIndex);
+        _mergeQueue.setHead(remoteIndex, *remote.docBuffer.front().getResult());
     }
     return true;
 }
@@ -921,18 +942,9 @@ bool AsyncResultsMerger::RemoteCursorData::exhausted() const {
 }
 
 //
-// AsyncResultsMerger::MergingComparator
+// AsyncResultsMerger::PromisedMinSortKeyComparator
 //
 
-bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
-    const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
-    const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
-
-    return compareSortKeys(extractSortKey(*leftDoc.getResult(), _compareWholeSortKey),
-                           extractSortKey(*rightDoc.getResult(), _compareWholeSortKey),
-                           _sort) > 0;
-}
-
 bool AsyncResultsMerger::PromisedMinSortKeyComparator::operator()(
     const MinSortKeyRemoteIdPair& lhs, const MinSortKeyRemoteIdPair& rhs) const {
     auto sortKeyComp = compareSortKeys(lhs.first, rhs.first, _sort);
@@ -40,6 +40,7 @@
 #include "mongo/platform/mutex.h"
 #include "mongo/s/query/async_results_merger_params_gen.h"
 #include "mongo/s/query/cluster_query_result.h"
+#include "mongo/s/query/results_merge_tree.h"
 #include "mongo/stdx/future.h"
 #include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/net/hostandport.h"
@@ -113,6 +114,15 @@ public:
      */
     bool remotesExhausted() const;
 
+    /**
+     * Informs the ARM that its caller will consume at most 'docsNeeded' more results, for example
+     * because the merged stream feeds a limit. From then on, getMore requests never ask a remote
+     * for more results than are still needed; this bounds the batch of every remote whether or not
+     * the merge is sorted, since in the worst case all of the remaining results come from one of
+     * them.
+     */
+    void setDocsNeeded(long long docsNeeded);
+
     /**
      * Sets the maxTimeMS value that the ARM should forward with any internally issued getMore
      * requests.
@@ -321,26 +331,6 @@ private:
         bool invalidated = false;
     };
 
-    class MergingComparator {
-    public:
-        MergingComparator(const std::vector<RemoteCursorData>& remotes,
-                          const BSONObj& sort,
-                          bool compareWholeSortKey)
-            : _remotes(remotes), _sort(sort), _compareWholeSortKey(compareWholeSortKey) {}
-
-        bool operator()(const size_t& lhs, const size_t& rhs);
-
-    private:
-        const std::vector<RemoteCursorData>& _remotes;
-
-        const BSONObj _sort;
-
-        // When '_compareWholeSortKey' is true, $sortKey is a scalar value, rather than an object.
-        // We extract the sort key {$sortKey: <value>}. The sort key pattern '_sort' is verified to
-        // be {$sortKey: 1}.
-        const bool _compareWholeSortKey;
-    };
-
     using MinSortKeyRemoteIdPair = std::pair<BSONObj, size_t>;
 
     class PromisedMinSortKeyComparator {
@@ -493,9 +483,9 @@ private:
     // Data tracking the state of our communication with each of the remote nodes.
     std::vector<RemoteCursorData> _remotes;
 
-    // The top of this priority queue is the index into '_remotes' for the remote host that has the
+    // The top of this merge tree is the index into '_remotes' for the remote host that has the
     // next document to return, according to the sort order. Used only if there is a sort.
-    std::priority_queue<size_t, std::vector<size_t>, MergingComparator> _mergeQueue;
+    ResultsMergeTree _mergeQueue;
 
     // The index into '_remotes' for the remote from which we are currently retrieving results.
     // Used only if there is *not* a sort.
@@ -511,6 +501,12 @@ private:
 
     boost::optional<Milliseconds> _awaitDataTimeout;
 
+    // The number of results returned by nextReady() so far.
+    long long _numResultsReturned = 0;
+
+    // If set, the caller stops consuming results once '_numResultsReturned' reaches this value.
+    boost::optional<long long> _docsNeededLimit;
+
     // An ordered set of (promisedMinSortKey, remoteIndex) pairs received from the shards. The first
     // element in the set will be the lowest sort key across all shards.
     std::set<MinSortKeyRemoteIdPair, PromisedMinSortKeyComparator> _promisedMinSortKeys;
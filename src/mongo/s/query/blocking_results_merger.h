@@ -52,6 +52,10 @@ public:
      */
     StatusWith<ClusterQueryResult> next(OperationContext*);
 
+    void setDocsNeeded(long long docsNeeded) {
+        _arm.setDocsNeeded(docsNeeded);
+    }
+
     Status setAwaitDataTimeout(Milliseconds awaitDataTimeout) {
         return _arm.setAwaitDataTimeout(awaitDataTimeout);
     }
@@ -84,6 +88,10 @@ public:
         _arm.addNewShardCursors(std::move(newCursors));
     }
 
+    Status scheduleGetMores() {
+        return _arm.scheduleGetMores();
+    }
+
     /**
      * Blocks until '_arm' has been killed, which involves cleaning up any remote cursors managed
      * by this results merger.
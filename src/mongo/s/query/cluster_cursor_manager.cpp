@@ -34,6 +34,7 @@
 #include "mongo/s/query/cluster_client_cursor_impl.h"
 #include "mongo/s/query/cluster_cursor_manager.h"
 
+#include <algorithm>
 #include <set>
 
 #include "mongo/db/kill_sessions_common.h"
@@ -157,12 +158,15 @@ ClusterCursorManager::ClusterCursorManager(ClockSource* clockSource)
 ClusterCursorManager::~ClusterCursorManager() {
     invariant(_cursorIdPrefixToNamespaceMap.empty());
     invariant(_namespaceToContainerMap.empty());
+    for (const auto& partition : _partitions) {
+        invariant(partition.entryMap.empty());
+    }
 }
 
 void ClusterCursorManager::shutdown(OperationContext* opCtx) {
     {
-        stdx::lock_guard<Latch> lk(_mutex);
-        _inShutdown = true;
+        stdx::lock_guard<Latch> lk(_namespaceMutex);
+        _inShutdown.store(true);
     }
     killAllCursors(opCtx);
 }
@@ -177,10 +181,9 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
     // Read the clock out of the lock.
     const auto now = _clockSource->now();
 
-    stdx::unique_lock<Latch> lk(_mutex);
-    _log.push({LogEvent::Type::kRegisterAttempt, boost::none, now, nss});
+    stdx::unique_lock<Latch> lk(_namespaceMutex);
 
-    if (_inShutdown) {
+    if (_inShutdown.load()) {
         lk.unlock();
         cursor->kill(opCtx);
         return Status(ErrorCodes::ShutdownInProgress,
@@ -190,7 +193,7 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
     invariant(cursor);
     cursor->setLeftoverMaxTimeMicros(opCtx->getRemainingMaxTimeMicros());
 
-    // Find the CursorEntryContainer for this namespace.  If none exists, create one.
+    // Find the NamespaceEntry for this namespace.  If none exists, create one.
     auto nsToContainerIt = _namespaceToContainerMap.find(nss);
     if (nsToContainerIt == _namespaceToContainerMap.end()) {
         uint32_t containerPrefix = 0;
@@ -207,35 +210,45 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
         } while (_cursorIdPrefixToNamespaceMap.count(containerPrefix) > 0);
         _cursorIdPrefixToNamespaceMap[containerPrefix] = nss;
 
-        auto emplaceResult =
-            _namespaceToContainerMap.emplace(nss, CursorEntryContainer(containerPrefix));
+        auto emplaceResult = _namespaceToContainerMap.emplace(nss, NamespaceEntry(containerPrefix));
         invariant(emplaceResult.second);
         invariant(_namespaceToContainerMap.size() == _cursorIdPrefixToNamespaceMap.size());
 
         nsToContainerIt = emplaceResult.first;
     } else {
-        invariant(!nsToContainerIt->second.entryMap.empty());  // If exists, shouldn't be empty.
+        invariant(nsToContainerIt->second.numCursors > 0);  // If exists, shouldn't be empty.
     }
-    CursorEntryContainer& container = nsToContainerIt->second;
+    NamespaceEntry& container = nsToContainerIt->second;
 
-    // Generate a CursorId (which can't be the invalid value zero).
-    CursorEntryMap& entryMap = container.entryMap;
+    // Generate a CursorId (which can't be the invalid value zero). The namespace mutex is held
+    // until the cursor is in its partition, so no other thread can pick the same id meanwhile.
     CursorId cursorId = 0;
     do {
         const uint32_t cursorSuffix = static_cast<uint32_t>(_pseudoRandom.nextInt32());
         cursorId = createCursorId(container.containerPrefix, cursorSuffix);
-    } while (cursorId == 0 || entryMap.count(cursorId) > 0);
-
-    // Create a new CursorEntry and register it in the CursorEntryContainer's map.
-    auto emplaceResult = entryMap.emplace(cursorId,
-                                          CursorEntry(std::move(cursor),
-                                                      cursorType,
-                                                      cursorLifetime,
-                                                      now,
-                                                      authenticatedUsers,
-                                                      opCtx->getOperationKey()));
+    } while (cursorId == 0 || [&] {
+        auto& partition = _getPartition(cursorId);
+        stdx::lock_guard<Latch> partitionLk(partition.mutex);
+        return partition.entryMap.count(cursorId) > 0;
+    }());
+
+    ++container.numCursors;
+
+    // Create a new CursorEntry and register it in the partition of its cursor id.
+    auto& partition = _getPartition(cursorId);
+    stdx::lock_guard<Latch> partitionLk(partition.mutex);
+    partition.log.push({LogEvent::Type::kRegisterAttempt, cursorId, now, nss});
+
+    auto emplaceResult = partition.entryMap.emplace(cursorId,
+                                                    CursorEntry(std::move(cursor),
+                                                                nss,
+                                                                cursorType,
+                                                                cursorLifetime,
+                                                                now,
+                                                                authenticatedUsers,
+                                                                opCtx->getOperationKey()));
     invariant(emplaceResult.second);
-    _log.push({LogEvent::Type::kRegisterComplete, cursorId, now, nss});
+    partition.log.push({LogEvent::Type::kRegisterComplete, cursorId, now, nss});
 
     return cursorId;
 }
@@ -248,15 +261,16 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
     AuthCheck checkSessionAuth) {
     const auto now = _clockSource->now();
 
-    stdx::lock_guard<Latch> lk(_mutex);
-    _log.push({LogEvent::Type::kCheckoutAttempt, cursorId, now, nss});
+    auto& partition = _getPartition(cursorId);
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    partition.log.push({LogEvent::Type::kCheckoutAttempt, cursorId, now, nss});
 
-    if (_inShutdown) {
+    if (_inShutdown.load()) {
         return Status(ErrorCodes::ShutdownInProgress,
                       "Cannot check out cursor as we are in the process of shutting down");
     }
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -293,7 +307,7 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
     }
     cursorGuard->reattachToOperationContext(opCtx);
 
-    _log.push({LogEvent::Type::kCheckoutComplete, cursorId, now, nss});
+    partition.log.push({LogEvent::Type::kCheckoutComplete, cursorId, now, nss});
     return PinnedCursor(this, std::move(cursorGuard), nss, cursorId);
 }
 
@@ -311,10 +325,11 @@ void ClusterCursorManager::checkInCursor(std::unique_ptr<ClusterClientCursor> cu
     cursor->detachFromOperationContext();
     cursor->setLastUseDate(now);
 
-    stdx::unique_lock<Latch> lk(_mutex);
-    _log.push({LogEvent::Type::kCheckInAttempt, cursorId, now, nss});
+    auto& partition = _getPartition(cursorId);
+    stdx::unique_lock<Latch> lk(partition.mutex);
+    partition.log.push({LogEvent::Type::kCheckInAttempt, cursorId, now, nss});
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     invariant(entry);
 
     // killPending will be true if killCursor() was called while the cursor was in use.
@@ -324,22 +339,23 @@ void ClusterCursorManager::checkInCursor(std::unique_ptr<ClusterClientCursor> cu
     entry->returnCursor(std::move(cursor));
 
     if (cursorState == CursorState::NotExhausted && !killPending) {
-        _log.push({LogEvent::Type::kCheckInCompleteCursorSaved, cursorId, now, nss});
+        partition.log.push({LogEvent::Type::kCheckInCompleteCursorSaved, cursorId, now, nss});
         // The caller may need the cursor again.
         return;
     }
 
     // After detaching the cursor, the entry will be destroyed.
     entry = nullptr;
-    detachAndKillCursor(std::move(lk), opCtx, nss, cursorId);
+    detachAndKillCursor(std::move(lk), partition, opCtx, nss, cursorId);
 }
 
 Status ClusterCursorManager::checkAuthForKillCursors(OperationContext* opCtx,
                                                      const NamespaceString& nss,
                                                      CursorId cursorId,
                                                      AuthzCheckFn authChecker) {
-    stdx::lock_guard<Latch> lk(_mutex);
-    auto entry = _getEntry(lk, nss, cursorId);
+    auto& partition = _getPartition(cursorId);
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    auto entry = _getEntry(lk, partition, nss, cursorId);
 
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
@@ -367,11 +383,12 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
     invariant(opCtx);
 
     const auto now = _clockSource->now();
-    stdx::unique_lock<Latch> lk(_mutex);
+    auto& partition = _getPartition(cursorId);
+    stdx::unique_lock<Latch> lk(partition.mutex);
 
-    _log.push({LogEvent::Type::kKillCursorAttempt, cursorId, now, nss});
+    partition.log.push({LogEvent::Type::kKillCursorAttempt, cursorId, now, nss});
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -386,7 +403,7 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
     }
 
     // No one is using the cursor, so we destroy it.
-    detachAndKillCursor(std::move(lk), opCtx, nss, cursorId);
+    detachAndKillCursor(std::move(lk), partition, opCtx, nss, cursorId);
 
     // We no longer hold the lock here.
 
@@ -394,21 +411,22 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
 }
 
 void ClusterCursorManager::detachAndKillCursor(stdx::unique_lock<Latch> lk,
+                                               Partition& partition,
                                                OperationContext* opCtx,
                                                const NamespaceString& nss,
                                                CursorId cursorId) {
-    auto detachedCursorGuard = _detachCursor(lk, opCtx, nss, cursorId);
+    auto detachedCursorGuard = _detachCursor(lk, partition, opCtx, nss, cursorId);
     invariant(detachedCursorGuard.getStatus());
 
     // Deletion of the cursor can happen out of the lock.
     lk.unlock();
+    _releaseNamespace(nss);
     detachedCursorGuard.getValue()->kill(opCtx);
 }
 
 std::size_t ClusterCursorManager::killMortalCursorsInactiveSince(OperationContext* opCtx,
                                                                  Date_t cutoff) {
     const auto now = _clockSource->now();
-    stdx::unique_lock<Latch> lk(_mutex);
 
     auto pred = [cutoff](CursorId cursorId, const CursorEntry& entry) -> bool {
         bool res = entry.getLifetimeType() == CursorLifetime::Mortal && !entry.getLsid() &&
@@ -424,33 +442,30 @@ std::size_t ClusterCursorManager::killMortalCursorsInactiveSince(OperationContex
         return res;
     };
 
-    return killCursorsSatisfying(std::move(lk), opCtx, std::move(pred), now);
+    return killCursorsSatisfying(opCtx, std::move(pred), now);
 }
 
 void ClusterCursorManager::killAllCursors(OperationContext* opCtx) {
     const auto now = _clockSource->now();
-    stdx::unique_lock<Latch> lk(_mutex);
     auto pred = [](CursorId, const CursorEntry&) -> bool { return true; };
 
-    killCursorsSatisfying(std::move(lk), opCtx, std::move(pred), now);
+    killCursorsSatisfying(opCtx, std::move(pred), now);
 }
 
 std::size_t ClusterCursorManager::killCursorsSatisfying(
-    stdx::unique_lock<Latch> lk,
-    OperationContext* opCtx,
-    std::function<bool(CursorId, const CursorEntry&)> pred,
-    Date_t now) {
+    OperationContext* opCtx, std::function<bool(CursorId, const CursorEntry&)> pred, Date_t now) {
     invariant(opCtx);
-    invariant(lk.owns_lock());
     std::size_t nKilled = 0;
 
-    _log.push(
-        {LogEvent::Type::kRemoveCursorsSatisfyingPredicateAttempt, boost::none, now, boost::none});
+    std::vector<std::pair<NamespaceString, ClusterClientCursorGuard>> cursorsToDestroy;
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        partition.log.push({LogEvent::Type::kRemoveCursorsSatisfyingPredicateAttempt,
+                            boost::none,
+                            now,
+                            boost::none});
 
-    std::vector<ClusterClientCursorGuard> cursorsToDestroy;
-    auto nsContainerIt = _namespaceToContainerMap.begin();
-    while (nsContainerIt != _namespaceToContainerMap.end()) {
-        auto&& entryMap = nsContainerIt->second.entryMap;
+        auto&& entryMap = partition.entryMap;
         auto cursorIdEntryIt = entryMap.begin();
         while (cursorIdEntryIt != entryMap.end()) {
             auto cursorId = cursorIdEntryIt->first;
@@ -470,41 +485,36 @@ std::size_t ClusterCursorManager::killCursorsSatisfying(
                 continue;
             }
 
-            _log.push({LogEvent::Type::kCursorMarkedForDeletionBySatisfyingPredicate,
-                       cursorId,
-                       // While we collected 'now' above, we ran caller-provided predicates which
-                       // may have been expensive. To avoid re-reading from the clock while the
-                       // lock is held, we do not provide a value for 'now' in this log entry.
-                       boost::none,
-                       nsContainerIt->first});
+            partition.log.push({LogEvent::Type::kCursorMarkedForDeletionBySatisfyingPredicate,
+                                cursorId,
+                                // While we collected 'now' above, we ran caller-provided
+                                // predicates which may have been expensive. To avoid re-reading
+                                // from the clock while the lock is held, we do not provide a value
+                                // for 'now' in this log entry.
+                                boost::none,
+                                entry.getNamespace()});
 
-            cursorsToDestroy.push_back(entry.releaseCursor(opCtx));
+            cursorsToDestroy.emplace_back(entry.getNamespace(), entry.releaseCursor(opCtx));
 
             // Destroy the entry and set the iterator to the next element.
             entryMap.erase(cursorIdEntryIt++);
         }
 
-        if (entryMap.empty()) {
-            nsContainerIt = eraseContainer(nsContainerIt);
-        } else {
-            ++nsContainerIt;
-        }
+        partition.log.push({LogEvent::Type::kRemoveCursorsSatisfyingPredicateComplete,
+                            boost::none,
+                            // While we collected 'now' above, we ran caller-provided predicates
+                            // which may have been expensive. To avoid re-reading from the clock
+                            // while the lock is held, we do not provide a value for 'now' in this
+                            // log entry.
+                            boost::none,
+                            boost::none});
     }
 
-    _log.push({LogEvent::Type::kRemoveCursorsSatisfyingPredicateComplete,
-               boost::none,
-               // While we collected 'now' above, we ran caller-provided predicates which may have
-               // been expensive. To avoid re-reading from the clock while the lock is held, we do
-               // not provide a value for 'now' in this log entry.
-               boost::none,
-               boost::none});
-
     // Ensure cursors are killed outside the lock, as killing may require waiting for callbacks to
     // finish.
-    lk.unlock();
-
-    for (auto&& cursorGuard : cursorsToDestroy) {
+    for (auto&& [nss, cursorGuard] : cursorsToDestroy) {
         invariant(cursorGuard);
+        _releaseNamespace(nss);
         cursorGuard->kill(opCtx);
     }
 
@@ -512,12 +522,11 @@ std::size_t ClusterCursorManager::killCursorsSatisfying(
 }
 
 ClusterCursorManager::Stats ClusterCursorManager::stats() const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     Stats stats;
 
-    for (auto& nsContainerPair : _namespaceToContainerMap) {
-        for (auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (auto& cursorIdEntryPair : partition.entryMap) {
             const CursorEntry& entry = cursorIdEntryPair.second;
 
             if (entry.isKillPending()) {
@@ -545,10 +554,9 @@ ClusterCursorManager::Stats ClusterCursorManager::stats() const {
 }
 
 void ClusterCursorManager::appendActiveSessions(LogicalSessionIdSet* lsids) const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
-    for (const auto& nsContainerPair : _namespaceToContainerMap) {
-        for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (const auto& cursorIdEntryPair : partition.entryMap) {
             const CursorEntry& entry = cursorIdEntryPair.second;
 
             if (entry.isKillPending()) {
@@ -564,12 +572,11 @@ void ClusterCursorManager::appendActiveSessions(LogicalSessionIdSet* lsids) cons
     }
 }
 
-GenericCursor ClusterCursorManager::CursorEntry::cursorToGenericCursor(
-    CursorId cursorId, const NamespaceString& ns) const {
+GenericCursor ClusterCursorManager::CursorEntry::cursorToGenericCursor(CursorId cursorId) const {
     invariant(_cursor);
     GenericCursor gc;
     gc.setCursorId(cursorId);
-    gc.setNs(ns);
+    gc.setNs(_nss);
     gc.setCreatedDate(_cursor->getCreatedDate());
     gc.setLastAccessDate(_cursor->getLastUseDate());
     gc.setLsid(_cursor->getLsid());
@@ -586,12 +593,11 @@ std::vector<GenericCursor> ClusterCursorManager::getIdleCursors(
     const OperationContext* opCtx, MongoProcessInterface::CurrentOpUserMode userMode) const {
     std::vector<GenericCursor> cursors;
 
-    stdx::lock_guard<Latch> lk(_mutex);
-
     AuthorizationSession* ctxAuth = AuthorizationSession::get(opCtx->getClient());
 
-    for (const auto& nsContainerPair : _namespaceToContainerMap) {
-        for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (const auto& cursorIdEntryPair : partition.entryMap) {
 
             const CursorEntry& entry = cursorIdEntryPair.second;
             // If auth is enabled, and userMode is allUsers, check if the current user has
@@ -606,8 +612,7 @@ std::vector<GenericCursor> ClusterCursorManager::getIdleCursors(
                 continue;
             }
 
-            cursors.emplace_back(
-                entry.cursorToGenericCursor(cursorIdEntryPair.first, nsContainerPair.first));
+            cursors.emplace_back(entry.cursorToGenericCursor(cursorIdEntryPair.first));
         }
     }
 
@@ -635,12 +640,11 @@ std::pair<Status, int> ClusterCursorManager::killCursorsWithMatchingSessions(
 
 stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForSession(
     LogicalSessionId lsid) const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     stdx::unordered_set<CursorId> cursorIds;
 
-    for (auto&& nsContainerPair : _namespaceToContainerMap) {
-        for (auto&& [cursorId, entry] : nsContainerPair.second.entryMap) {
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (auto&& [cursorId, entry] : partition.entryMap) {
             if (entry.isKillPending()) {
                 // Don't include sessions for killed cursors.
                 continue;
@@ -658,24 +662,21 @@ stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForSession(
 
 stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForOpKeys(
     std::vector<OperationKey> opKeys) const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     stdx::unordered_set<CursorId> cursorIds;
 
     // While we could maintain a cached mapping of OperationKey to CursorID to increase performance,
     // this approach was chosen given that 1) mongos will not have as many open cursors as a shard
     // and 2) mongos performance has historically not been a bottleneck.
-    for (auto&& opKey : opKeys) {
-        for (auto&& nsContainerPair : _namespaceToContainerMap) {
-            for (auto&& [cursorId, entry] : nsContainerPair.second.entryMap) {
-                if (entry.isKillPending()) {
-                    // Don't include any killed cursors.
-                    continue;
-                }
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (auto&& [cursorId, entry] : partition.entryMap) {
+            if (entry.isKillPending()) {
+                // Don't include any killed cursors.
+                continue;
+            }
 
-                if (opKey == entry.getOperationKey()) {
-                    cursorIds.insert(cursorId);
-                }
+            if (std::find(opKeys.begin(), opKeys.end(), entry.getOperationKey()) != opKeys.end()) {
+                cursorIds.insert(cursorId);
             }
         }
     }
@@ -685,8 +686,16 @@ stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForOpKeys(
 
 boost::optional<NamespaceString> ClusterCursorManager::getNamespaceForCursorId(
     CursorId cursorId) const {
-    stdx::lock_guard<Latch> lk(_mutex);
+    {
+        // Registered cursors are found in their partition, without touching the namespace state.
+        const auto& partition = _getPartition(cursorId);
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        if (auto it = partition.entryMap.find(cursorId); it != partition.entryMap.end()) {
+            return it->second.getNamespace();
+        }
+    }
 
+    stdx::lock_guard<Latch> lk(_namespaceMutex);
     const auto it = _cursorIdPrefixToNamespaceMap.find(extractPrefixFromCursorId(cursorId));
     if (it == _cursorIdPrefixToNamespaceMap.end()) {
         return boost::none;
@@ -694,27 +703,28 @@ boost::optional<NamespaceString> ClusterCursorManager::getNamespaceForCursorId(
     return it->second;
 }
 
-auto ClusterCursorManager::_getEntry(WithLock, NamespaceString const& nss, CursorId cursorId)
-    -> CursorEntry* {
-
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    if (nsToContainerIt == _namespaceToContainerMap.end()) {
-        return nullptr;
-    }
-    CursorEntryMap& entryMap = nsToContainerIt->second.entryMap;
-    auto entryMapIt = entryMap.find(cursorId);
-    if (entryMapIt == entryMap.end()) {
+auto ClusterCursorManager::_getEntry(WithLock,
+                                     Partition& partition,
+                                     NamespaceString const& nss,
+                                     CursorId cursorId) -> CursorEntry* {
+    auto entryMapIt = partition.entryMap.find(cursorId);
+    if (entryMapIt == partition.entryMap.end() || entryMapIt->second.getNamespace() != nss) {
         return nullptr;
     }
 
     return &entryMapIt->second;
 }
 
-auto ClusterCursorManager::eraseContainer(NssToCursorContainerMap::iterator it)
-    -> NssToCursorContainerMap::iterator {
+void ClusterCursorManager::_releaseNamespace(const NamespaceString& nss) {
+    stdx::lock_guard<Latch> lk(_namespaceMutex);
+
+    auto it = _namespaceToContainerMap.find(nss);
+    invariant(it != _namespaceToContainerMap.end());
     auto&& container = it->second;
-    auto&& entryMap = container.entryMap;
-    invariant(entryMap.empty());
+    invariant(container.numCursors > 0);
+    if (--container.numCursors > 0) {
+        return;
+    }
 
     // This was the last cursor remaining in the given namespace.  Erase all state associated
     // with this namespace.
@@ -730,26 +740,22 @@ auto ClusterCursorManager::eraseContainer(NssToCursorContainerMap::iterator it)
             "nss"_attr = it->first,
             "prefix"_attr = container.containerPrefix,
             "actualNumDeleted"_attr = numDeleted);
-        logCursorManagerInfo();
+        logCursorManagerInfo(lk);
         MONGO_UNREACHABLE;
     }
-    const auto nssRemoved = it->first;
-    _namespaceToContainerMap.erase(it++);
-    _log.push({LogEvent::Type::kNamespaceEntryMapErased,
-               boost::none,
-               boost::none,
-               std::move(nssRemoved)});
+    _namespaceToContainerMap.erase(it);
+    _namespaceLog.push({LogEvent::Type::kNamespaceEntryMapErased, boost::none, boost::none, nss});
 
     invariant(_namespaceToContainerMap.size() == _cursorIdPrefixToNamespaceMap.size());
-    return it;
 }
 
 StatusWith<ClusterClientCursorGuard> ClusterCursorManager::_detachCursor(WithLock lk,
+                                                                         Partition& partition,
                                                                          OperationContext* opCtx,
                                                                          const NamespaceString& nss,
                                                                          CursorId cursorId) {
-    _log.push({LogEvent::Type::kDetachAttempt, cursorId, boost::none, nss});
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    partition.log.push({LogEvent::Type::kDetachAttempt, cursorId, boost::none, nss});
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -762,21 +768,15 @@ StatusWith<ClusterClientCursorGuard> ClusterCursorManager::_detachCursor(WithLoc
     ClusterClientCursorGuard cursor = entry->releaseCursor(opCtx);
 
     // Destroy the entry.
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    invariant(nsToContainerIt != _namespaceToContainerMap.end());
-    CursorEntryMap& entryMap = nsToContainerIt->second.entryMap;
-    size_t eraseResult = entryMap.erase(cursorId);
+    size_t eraseResult = partition.entryMap.erase(cursorId);
     invariant(1 == eraseResult);
-    if (entryMap.empty()) {
-        eraseContainer(nsToContainerIt);
-    }
 
-    _log.push({LogEvent::Type::kDetachComplete, cursorId, boost::none, nss});
+    partition.log.push({LogEvent::Type::kDetachComplete, cursorId, boost::none, nss});
 
     return std::move(cursor);
 }
 
-void ClusterCursorManager::logCursorManagerInfo() const {
+void ClusterCursorManager::logCursorManagerInfo(WithLock lk) const {
     LOGV2_ERROR_OPTIONS(4786900,
                         logv2::LogTruncation::Disabled,
                         "Dumping cursor manager contents. "
@@ -784,9 +784,9 @@ void ClusterCursorManager::logCursorManagerInfo() const {
                         "Cursor ID Prefix -> NSS map: {cursorIdToNss} "
                         "Internal log: {internalLog}",
                         "Dumping cursor manager contents.",
-                        "{nssToContainer}"_attr = dumpNssToContainerMap(),
-                        "{cursorIdToNss}"_attr = dumpCursorIdToNssMap(),
-                        "{internalLog}"_attr = dumpInternalLog());
+                        "{nssToContainer}"_attr = dumpNssToContainerMap(lk),
+                        "{cursorIdToNss}"_attr = dumpCursorIdToNssMap(lk),
+                        "{internalLog}"_attr = dumpInternalLog(lk));
 }
 
 std::string ClusterCursorManager::LogEvent::typeToString(ClusterCursorManager::LogEvent::Type t) {
@@ -811,7 +811,7 @@ std::string ClusterCursorManager::LogEvent::typeToString(ClusterCursorManager::L
     return "unknown " + std::to_string(static_cast<int>(t));
 }
 
-BSONObj ClusterCursorManager::dumpNssToContainerMap() const {
+BSONObj ClusterCursorManager::dumpNssToContainerMap(WithLock) const {
     BSONObjBuilder bob;
     // Record an object for the NSS -> Container map.
     {
@@ -820,18 +820,25 @@ BSONObj ClusterCursorManager::dumpNssToContainerMap() const {
             BSONObjBuilder nssBob(nssToContainer.subobjStart(nss.toString()));
             nssBob.appendNumber("containerPrefix",
                                 static_cast<long long>(cursorContainer.containerPrefix));
+            nssBob.appendNumber("numCursors", static_cast<long long>(cursorContainer.numCursors));
             BSONArrayBuilder cursors(nssBob.subarrayStart("cursors"));
-            for (auto&& [cursorId, cursorEntry] : cursorContainer.entryMap) {
-                BSONObjBuilder cursorBob(cursors.subobjStart());
-                cursorBob.appendNumber("id", cursorId);
-                cursorBob.append("lastActive", cursorEntry.getLastActive());
+            for (const auto& partition : _partitions) {
+                stdx::lock_guard<Latch> partitionLk(partition.mutex);
+                for (auto&& [cursorId, cursorEntry] : partition.entryMap) {
+                    if (cursorEntry.getNamespace() != nss) {
+                        continue;
+                    }
+                    BSONObjBuilder cursorBob(cursors.subobjStart());
+                    cursorBob.appendNumber("id", cursorId);
+                    cursorBob.append("lastActive", cursorEntry.getLastActive());
+                }
             }
         }
     }
     return bob.obj();
 }
 
-BSONObj ClusterCursorManager::dumpCursorIdToNssMap() const {
+BSONObj ClusterCursorManager::dumpCursorIdToNssMap(WithLock) const {
     BSONObjBuilder bob;
 
     // Record an array for the Cursor ID Prefix -> NSS map.
@@ -847,15 +854,15 @@ BSONObj ClusterCursorManager::dumpCursorIdToNssMap() const {
     return bob.obj();
 }
 
-BSONObj ClusterCursorManager::dumpInternalLog() const {
+BSONObj ClusterCursorManager::dumpInternalLog(WithLock) const {
     BSONObjBuilder bob;
-    // Dump the internal log maintained by the ClusterCursorManager.
-    {
-        BSONArrayBuilder logBuilder(bob.subarrayStart("log"));
-        size_t i = _log.start;
-        while (i != _log.end) {
-            BSONObjBuilder bob(logBuilder.subobjStart());
-            const auto& logEntry = _log.events[i];
+    // Dump the internal logs maintained by the ClusterCursorManager, the namespace one first and
+    // then the one of each partition.
+    auto dumpLog = [](const CircularLogQueue& log, BSONArrayBuilder* logBuilder) {
+        size_t i = log.start;
+        while (i != log.end) {
+            BSONObjBuilder bob(logBuilder->subobjStart());
+            const auto& logEntry = log.events[i];
             if (logEntry.cursorId) {
                 bob.appendNumber("cursorId", *logEntry.cursorId);
             }
@@ -869,7 +876,16 @@ BSONObj ClusterCursorManager::dumpInternalLog() const {
                 bob.append("nss", logEntry.nss->toString());
             }
 
-            i = (i + 1) % _log.events.size();
+            i = (i + 1) % log.events.size();
+        }
+    };
+
+    {
+        BSONArrayBuilder logBuilder(bob.subarrayStart("log"));
+        dumpLog(_namespaceLog, &logBuilder);
+        for (const auto& partition : _partitions) {
+            stdx::lock_guard<Latch> partitionLk(partition.mutex);
+            dumpLog(partition.log, &logBuilder);
         }
     }
     return bob.obj();
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -38,6 +39,7 @@
 #include "mongo/db/kill_sessions.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/session_killer.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/platform/random.h"
 #include "mongo/s/query/cluster_client_cursor.h"
@@ -69,6 +71,12 @@ class StatusWith;
  * with the kill*() suite of methods.
  *
  * No public methods throw exceptions, and all public methods are thread-safe.
+ *
+ * The registered cursors are spread over a fixed number of partitions by the low bits of their
+ * cursor id, each with its own mutex, so that checking cursors out and in for getMores on different
+ * cursors does not contend on a single lock. Only registering a cursor and destroying one take the
+ * manager-wide lock protecting the per-namespace state, and operations over all cursors (kills,
+ * reaping, stats) visit the partitions one after the other.
  */
 class ClusterCursorManager {
     ClusterCursorManager(const ClusterCursorManager&) = delete;
@@ -388,9 +396,13 @@ public:
 
 private:
     class CursorEntry;
-    struct CursorEntryContainer;
+    struct NamespaceEntry;
+    struct Partition;
     using CursorEntryMap = stdx::unordered_map<CursorId, CursorEntry>;
-    using NssToCursorContainerMap = stdx::unordered_map<NamespaceString, CursorEntryContainer>;
+    using NssToNamespaceEntryMap = stdx::unordered_map<NamespaceString, NamespaceEntry>;
+
+    // Number of partitions of the cursor registry. Must be a power of two.
+    static constexpr size_t kNumPartitions = 16;
 
     // Internal, fixed size log of events cursor manager. This has been added to help diagnose
     // SERVER-27796.
@@ -440,7 +452,7 @@ private:
         // boost::none for log entries that don't have an associated cursor ID.
         boost::optional<CursorId> cursorId;
 
-        // Time is not always provided to avoid having to read the clock while the mutex is held.
+        // Time is not always provided to avoid having to read the clock while a mutex is held.
         boost::optional<Date_t> time;
         boost::optional<NamespaceString> nss;
     };
@@ -477,20 +489,35 @@ private:
                        CursorState cursorState);
 
     /**
-     * Will detach a cursor, release the lock and then call kill() on it.
+     * Will detach a cursor, release the lock of its partition and then call kill() on it.
      */
     void detachAndKillCursor(stdx::unique_lock<Latch> lk,
+                             Partition& partition,
                              OperationContext* opCtx,
                              const NamespaceString& nss,
                              CursorId cursorId);
 
+    /**
+     * Returns the partition which holds the cursor with the given id.
+     */
+    Partition& _getPartition(CursorId cursorId) {
+        return _partitions[static_cast<uint64_t>(cursorId) & (kNumPartitions - 1)];
+    }
+
+    const Partition& _getPartition(CursorId cursorId) const {
+        return _partitions[static_cast<uint64_t>(cursorId) & (kNumPartitions - 1)];
+    }
+
     /**
      * Returns a pointer to the CursorEntry for the given cursor.  If the given cursor is not
-     * registered, returns null.
+     * registered on the given namespace, returns null.
      *
-     * Not thread-safe.
+     * Must be called with the mutex of 'partition' held.
      */
-    CursorEntry* _getEntry(WithLock, NamespaceString const& nss, CursorId cursorId);
+    CursorEntry* _getEntry(WithLock,
+                           Partition& partition,
+                           NamespaceString const& nss,
+                           CursorId cursorId);
 
     /**
      * De-registers the given cursor, and returns an owned pointer to the underlying
@@ -499,26 +526,33 @@ private:
      * If the given cursor is pinned, returns an error Status with code CursorInUse.  If the given
      * cursor is not registered, returns an error Status with code CursorNotFound.
      *
-     * Not thread-safe.
+     * Must be called with the mutex of 'partition' held. The caller is responsible for calling
+     * _releaseNamespace() for 'nss' once the partition is unlocked.
      */
     StatusWith<ClusterClientCursorGuard> _detachCursor(WithLock,
+                                                       Partition& partition,
                                                        OperationContext* opCtx,
                                                        const NamespaceString& nss,
                                                        CursorId cursorId);
 
+    /**
+     * Accounts for the destruction of one cursor on 'nss', erasing the state associated with the
+     * namespace if it was the last one. Must be called without any partition mutex held.
+     */
+    void _releaseNamespace(const NamespaceString& nss);
+
     /**
      * Flags the OperationContext that's using the given cursor as interrupted.
      */
     void killOperationUsingCursor(WithLock, CursorEntry* entry);
 
     /**
-     * Kill the cursors satisfying the given predicate. Assumes that 'lk' is held upon entry. The
-     * 'now' parameter is only used for the internal logging mechansim.
+     * Kill the cursors satisfying the given predicate, visiting one partition at a time. The 'now'
+     * parameter is only used for the internal logging mechansim.
      *
      * Returns the number of cursors killed.
      */
-    std::size_t killCursorsSatisfying(stdx::unique_lock<Latch> lk,
-                                      OperationContext* opCtx,
+    std::size_t killCursorsSatisfying(OperationContext* opCtx,
                                       std::function<bool(CursorId, const CursorEntry&)> pred,
                                       Date_t now);
 
@@ -533,12 +567,14 @@ private:
         CursorEntry() = default;
 
         CursorEntry(std::unique_ptr<ClusterClientCursor> cursor,
+                    const NamespaceString& nss,
                     CursorType cursorType,
                     CursorLifetime cursorLifetime,
                     Date_t lastActive,
                     UserNameIterator authenticatedUsersIter,
                     boost::optional<OperationKey> opKey)
             : _cursor(std::move(cursor)),
+              _nss(nss),
               _cursorType(cursorType),
               _cursorLifetime(cursorLifetime),
               _lastActive(lastActive),
@@ -564,6 +600,10 @@ private:
             return _operationUsingCursor->isKillPending();
         }
 
+        const NamespaceString& getNamespace() const {
+            return _nss;
+        }
+
         CursorType getCursorType() const {
             return _cursorType;
         }
@@ -602,11 +642,11 @@ private:
 
         /**
          * Creates a generic cursor from the cursor inside this entry. Should only be called on
-         * idle cursors. The caller must supply the cursorId and namespace because the CursorEntry
-         * does not have access to them.  Cannot be called if this CursorEntry does not own an
-         * underlying ClusterClientCursor.
+         * idle cursors. The caller must supply the cursorId because the CursorEntry does not have
+         * access to it.  Cannot be called if this CursorEntry does not own an underlying
+         * ClusterClientCursor.
          */
-        GenericCursor cursorToGenericCursor(CursorId cursorId, const NamespaceString& ns) const;
+        GenericCursor cursorToGenericCursor(CursorId cursorId) const;
 
         OperationContext* getOperationUsingCursor() const {
             return _operationUsingCursor;
@@ -635,6 +675,7 @@ private:
 
     private:
         std::unique_ptr<ClusterClientCursor> _cursor;
+        NamespaceString _nss;
         CursorType _cursorType = CursorType::SingleTarget;
         CursorLifetime _cursorLifetime = CursorLifetime::Mortal;
         Date_t _lastActive;
@@ -651,53 +692,58 @@ private:
     };
 
     /**
-     * CursorEntryContainer is a moveable, non-copyable container for a set of cursors, where all
-     * contained cursors share the same 32-bit prefix of their cursor id.
+     * State shared by all the cursors registered on a namespace.
      */
-    struct CursorEntryContainer {
-        CursorEntryContainer(const CursorEntryContainer&) = delete;
-        CursorEntryContainer& operator=(const CursorEntryContainer&) = delete;
-
-        CursorEntryContainer(uint32_t containerPrefix) : containerPrefix(containerPrefix) {}
+    struct NamespaceEntry {
+        NamespaceEntry(uint32_t containerPrefix) : containerPrefix(containerPrefix) {}
 
-        CursorEntryContainer(CursorEntryContainer&& other) = default;
-        CursorEntryContainer& operator=(CursorEntryContainer&& other) = default;
-
-        // Common cursor id prefix for all cursors in this container.
+        // Common cursor id prefix for all cursors on this namespace.
         uint32_t containerPrefix;
 
-        // Map from cursor id to cursor entry.
-        CursorEntryMap entryMap;
+        // Number of registered cursors on this namespace, including the ones being destroyed
+        // which have not yet called _releaseNamespace().
+        size_t numCursors{0};
     };
 
     /**
-     * Erase the container that 'it' points to and return an iterator to the next one. Assumes 'it'
-     * is an iterator in '_namespaceToContainerMap'.
+     * One partition of the cursor registry.
      */
-    NssToCursorContainerMap::iterator eraseContainer(NssToCursorContainerMap::iterator it);
+    struct Partition {
+        // Synchronizes access to the members below.
+        mutable Mutex mutex = MONGO_MAKE_LATCH("ClusterCursorManager::Partition::mutex");
+
+        // Map from cursor id to cursor entry, for the cursors whose id maps to this partition.
+        CursorEntryMap entryMap;
+
+        // The latest cursor events of this partition.
+        CircularLogQueue log;
+    };
 
     /**
      * Functions which dump the state/history of the cursor manager into a BSONObj for debug
-     * purposes.
+     * purposes. Must be called with '_namespaceMutex' held.
      */
-    BSONObj dumpCursorIdToNssMap() const;
-    BSONObj dumpNssToContainerMap() const;
-    BSONObj dumpInternalLog() const;
+    BSONObj dumpCursorIdToNssMap(WithLock) const;
+    BSONObj dumpNssToContainerMap(WithLock) const;
+    BSONObj dumpInternalLog(WithLock) const;
 
     /**
      * Logs objects which summarize the current state of the cursor manager as well as its recent
-     * history.
+     * history. Must be called with '_namespaceMutex' held.
      */
-    void logCursorManagerInfo() const;
+    void logCursorManagerInfo(WithLock) const;
 
     // Clock source.  Used when the 'last active' time for a cursor needs to be set/updated.  May be
     // concurrently accessed by multiple threads.
     ClockSource* _clockSource;
 
-    // Synchronizes access to all private state variables below.
-    mutable Mutex _mutex = MONGO_MAKE_LATCH("ClusterCursorManager::_mutex");
+    // Synchronizes access to the namespace state variables below. Registering and destroying a
+    // cursor take it, but checking a cursor out and in does not.
+    mutable Mutex _namespaceMutex = MONGO_MAKE_LATCH("ClusterCursorManager::_namespaceMutex");
 
-    bool _inShutdown{false};
+    // Only written with '_namespaceMutex' held, so that no cursor can be registered after
+    // shutdown() has started killing all cursors.
+    AtomicWord<bool> _inShutdown{false};
 
     // Randomness source.  Used for cursor id generation.
     const int64_t _randomSeed;
@@ -715,15 +761,20 @@ private:
     // when the last cursor on the given namespace is destroyed.
     stdx::unordered_map<uint32_t, NamespaceString> _cursorIdPrefixToNamespaceMap;
 
-    // Map from namespace to the CursorEntryContainer for that namespace.
+    // Map from namespace to the NamespaceEntry for that namespace.
     //
     // Entries are added when the first cursor on the given namespace is registered, and removed
     // when the last cursor on the given namespace is destroyed.
-    NssToCursorContainerMap _namespaceToContainerMap;
+    NssToNamespaceEntryMap _namespaceToContainerMap;
 
-    size_t _cursorsTimedOut = 0;
+    // The latest namespace events, protected by '_namespaceMutex'.
+    CircularLogQueue _namespaceLog;
+
+    // The registered cursors, partitioned by the low bits of their cursor id. Lock ordering:
+    // '_namespaceMutex' may be acquired before a partition mutex, but never after one.
+    std::array<Partition, kNumPartitions> _partitions;
 
-    CircularLogQueue _log;
+    size_t _cursorsTimedOut = 0;
 };
 
 }  // namespace mongo
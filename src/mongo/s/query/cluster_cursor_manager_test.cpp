@@ -539,6 +539,38 @@ TEST_F(ClusterCursorManagerTest, KillAllCursors) {
     }
 }
 
+// Test that the namespace of cursors spread over different partitions of the manager stays known
+// until the last cursor on that namespace is destroyed.
+TEST_F(ClusterCursorManagerTest, NamespaceReleasedWithLastCursorAcrossPartitions) {
+    const size_t numCursors = 100;
+    std::vector<CursorId> cursorIds;
+    for (size_t i = 0; i < numCursors; ++i) {
+        cursorIds.push_back(
+            assertGet(getManager()->registerCursor(_opCtx.get(),
+                                                   allocateMockCursor(),
+                                                   nss,
+                                                   ClusterCursorManager::CursorType::SingleTarget,
+                                                   ClusterCursorManager::CursorLifetime::Mortal,
+                                                   UserNameIterator())));
+    }
+
+    for (size_t i = 0; i < numCursors; ++i) {
+        auto pinnedCursor = assertGet(
+            getManager()->checkOutCursor(nss, cursorIds[i], _opCtx.get(), successAuthChecker));
+        pinnedCursor.returnCursor(ClusterCursorManager::CursorState::Exhausted);
+        ASSERT(isMockCursorKilled(i));
+
+        auto cursorNamespace = getManager()->getNamespaceForCursorId(cursorIds[0]);
+        if (i + 1 < numCursors) {
+            ASSERT(cursorNamespace);
+            ASSERT_EQ(nss, *cursorNamespace);
+        } else {
+            ASSERT_FALSE(cursorNamespace);
+        }
+    }
+    ASSERT_EQ(0U, getManager()->stats().cursorsSingleTarget);
+}
+
 // Test that a new ClusterCursorManager's stats() is initially zero for the cursor counts.
 TEST_F(ClusterCursorManagerTest, StatsInitAsZero) {
     ASSERT_EQ(0U, getManager()->stats().cursorsMultiTarget);
@@ -323,10 +323,16 @@ CursorId runQueryWithoutRetrying(OperationContext* opCtx,
     auto cursorState = ClusterCursorManager::CursorState::NotExhausted;
     int bytesBuffered = 0;
 
+    auto adaptiveBatch = AdaptiveBatchSizer::make(findCommand.getBatchSize());
+    auto enoughForFirstBatch = [&] {
+        return adaptiveBatch ? adaptiveBatch->enough(results->size(), bytesBuffered)
+                             : FindCommon::enoughForFirstBatch(findCommand, results->size());
+    };
+
     // This loop will not result in actually calling getMore against shards, but just loading
     // results from the initial batches (that were obtained while establishing cursors) into
     // 'results'.
-    while (!FindCommon::enoughForFirstBatch(findCommand, results->size())) {
+    while (!enoughForFirstBatch()) {
         auto next = uassertStatusOK(ccc->next());
 
         if (next.isEOF()) {
@@ -753,7 +759,13 @@ StatusWith<CursorResponse> ClusterFind::runGetMore(OperationContext* opCtx,
                                                          "waitWithPinnedCursorDuringGetMoreBatch");
     }
 
-    while (!FindCommon::enoughForGetMore(batchSize, batch.size())) {
+    auto adaptiveBatch = AdaptiveBatchSizer::make(batchSize);
+    auto enoughForGetMore = [&] {
+        return adaptiveBatch ? adaptiveBatch->enough(batch.size(), bytesBuffered)
+                             : FindCommon::enoughForGetMore(batchSize, batch.size());
+    };
+
+    while (!enoughForGetMore()) {
         StatusWith<ClusterQueryResult> next =
             Status{ErrorCodes::InternalError, "uninitialized cluster query result"};
         try {
@@ -140,6 +140,19 @@ public:
         _blockingResultsMerger->addNewShardCursors(std::move(newCursors));
     }
 
+    /**
+     * Asks every remote cursor without buffered results for its next batch, without waiting for the
+     * responses, so that the results are fetched in the background until this stage is iterated.
+     * Calling this method causes the underlying BlockingResultsMerger to be populated and assumes
+     * ownership of the remote cursors.
+     */
+    void prefetch() {
+        if (!_blockingResultsMerger) {
+            populateMerger();
+        }
+        uassertStatusOK(_blockingResultsMerger->scheduleGetMores());
+    }
+
     /**
      * Marks the remote cursors as unowned, meaning that they won't be killed upon disposing of this
      * DocumentSource.
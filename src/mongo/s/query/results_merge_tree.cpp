@@ -0,0 +1,136 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/query/results_merge_tree.h"
+
+#include "mongo/db/storage/key_string.h"
+#include "mongo/s/query/async_results_merger.h"
+
+namespace mongo {
+ResultsMergeTree::ResultsMergeTree(BSONObj sortPattern, bool compareWholeSortKey)
+    : _sortPattern(std::move(sortPattern)), _compareWholeSortKey(compareWholeSortKey) {
+    if (static_cast<size_t>(_sortPattern.nFields()) <= Ordering::kMaxCompoundIndexKeys)
+        _ordering = Ordering::make(_sortPattern);
+}
+
+size_t ResultsMergeTree::top() const {
+    invariant(!empty());
+    return _winners[1];
+}
+
+void ResultsMergeTree::setHead(size_t streamIndex, const BSONObj& doc) {
+    if (streamIndex >= _heads.size())
+        _grow(streamIndex + 1);
+
+    auto& head = _heads[streamIndex];
+    if (!head.present) {
+        head.present = true;
+        ++_numHeads;
+    }
+
+    auto key = doc[AsyncResultsMerger::kSortKeyField];
+    invariant(key);
+    if (_compareWholeSortKey) {
+        head.sortKey = key.wrap();
+    } else {
+        invariant(key.type() == BSONType::Array);
+        head.sortKey = key.embeddedObject();
+    }
+
+    if (_ordering) {
+        KeyString::Builder builder(KeyString::Version::V1, *_ordering);
+        for (auto&& elem : head.sortKey) {
+            builder.appendBSONElement(elem);
+        }
+        // Without the end byte, a key whose encoding is a prefix of another would sort first even
+        // for a descending component.
+        builder.appendDiscriminator(KeyString::Discriminator::kInclusive);
+        head.keyString.assign(builder.getBuffer(), builder.getSize());
+    }
+
+    _replay(streamIndex);
+}
+
+void ResultsMergeTree::removeHead(size_t streamIndex) {
+    if (streamIndex >= _heads.size() || !_heads[streamIndex].present)
+        return;
+
+    auto& head = _heads[streamIndex];
+    head.present = false;
+    head.sortKey = BSONObj();
+    --_numHeads;
+
+    _replay(streamIndex);
+}
+
+bool ResultsMergeTree::_less(size_t lhs, size_t rhs) const {
+    const auto& left = _heads[lhs];
+    const auto& right = _heads[rhs];
+    if (!left.present || !right.present)
+        return left.present && !right.present;
+
+    if (_ordering)
+        return left.keyString < right.keyString;
+
+    // This does not need to sort with a collator, since mongod has already mapped strings to their
+    // ICU comparison keys as part of the $sortKey meta projection.
+    const BSONObj::ComparisonRulesSet rules = 0;  // 'considerFieldNames' flag is not set.
+    return left.sortKey.woCompare(right.sortKey, _sortPattern, rules) < 0;
+}
+
+void ResultsMergeTree::_replay(size_t streamIndex) {
+    for (size_t node = (_heads.size() + streamIndex) / 2; node > 0; node /= 2) {
+        const auto leftWinner = _winners[2 * node];
+        const auto rightWinner = _winners[2 * node + 1];
+        _winners[node] = _less(rightWinner, leftWinner) ? rightWinner : leftWinner;
+    }
+}
+
+void ResultsMergeTree::_grow(size_t numStreams) {
+    size_t numLeaves = 1;
+    while (numLeaves < numStreams) {
+        numLeaves *= 2;
+    }
+
+    _heads.resize(numLeaves);
+    _winners.resize(2 * numLeaves);
+
+    for (size_t i = 0; i < numLeaves; ++i) {
+        _winners[numLeaves + i] = i;
+    }
+    for (size_t node = numLeaves - 1; node > 0; --node) {
+        const auto leftWinner = _winners[2 * node];
+        const auto rightWinner = _winners[2 * node + 1];
+        _winners[node] = _less(rightWinner, leftWinner) ? rightWinner : leftWinner;
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,126 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/ordering.h"
+
+namespace mongo {
+
+/**
+ * Tournament tree which tracks the head document of each of the sorted result streams merged by an
+ * AsyncResultsMerger and reports which stream holds the document that sorts first.
+ *
+ * The sort key of each head document is encoded as a KeyString once, when the document becomes the
+ * head of its stream, so that the comparisons made on every tree update are plain memcmp calls
+ * rather than BSON comparisons against the sort pattern. KeyStrings order exactly like the BSON
+ * sort keys they encode.
+ *
+ * Replacing or removing the head of any stream costs O(log n) comparisons for n streams, and ties
+ * between equal sort keys are broken in favour of the stream with the lower index.
+ *
+ * Not thread safe.
+ */
+class ResultsMergeTree {
+public:
+    /**
+     * 'sortPattern' describes the direction of each sort key component. When 'compareWholeSortKey'
+     * is true, the sort key of a document is the value of its $sortKey field as a whole, and
+     * 'sortPattern' must be {$sortKey: 1}.
+     */
+    ResultsMergeTree(BSONObj sortPattern, bool compareWholeSortKey);
+
+    /**
+     * Returns whether no stream has a head document.
+     */
+    bool empty() const {
+        return _numHeads == 0;
+    }
+
+    /**
+     * Returns the index of the stream whose head document sorts first. The tree must not be empty.
+     */
+    size_t top() const;
+
+    /**
+     * Makes 'doc', which must contain a $sortKey field, the head document of stream 'streamIndex'.
+     * The tree grows as needed to accommodate the stream. 'doc' must stay valid until the head of
+     * the stream is replaced or removed.
+     */
+    void setHead(size_t streamIndex, const BSONObj& doc);
+
+    /**
+     * Removes the head document of stream 'streamIndex', if it has one.
+     */
+    void removeHead(size_t streamIndex);
+
+private:
+    struct Head {
+        bool present = false;
+
+        // Sort key of the head document, in the form expected by BSONObj::woCompare().
+        BSONObj sortKey;
+
+        // KeyString encoding of 'sortKey', only used if the tree has an '_ordering'.
+        std::string keyString;
+    };
+
+    // Returns whether the head of stream 'lhs' sorts strictly before the head of stream 'rhs'.
+    // Streams without a head sort after all the others.
+    bool _less(size_t lhs, size_t rhs) const;
+
+    // Recomputes the winners along the path from the leaf of 'streamIndex' to the root.
+    void _replay(size_t streamIndex);
+
+    // Grows the tree so that it has a leaf for at least 'numStreams' streams.
+    void _grow(size_t numStreams);
+
+    const BSONObj _sortPattern;
+    const bool _compareWholeSortKey;
+
+    // Direction of each sort key component, used to encode the KeyStrings. Not set if the sort
+    // pattern has too many components to be encoded, in which case all comparisons use BSON.
+    boost::optional<Ordering> _ordering;
+
+    // One entry per leaf of the tree.
+    std::vector<Head> _heads;
+
+    // Stream winning each subtree, laid out as a binary heap: node 1 is the root, the children of
+    // node i are nodes 2i and 2i+1, and the leaf of stream i is node '_heads.size() + i'.
+    std::vector<size_t> _winners;
+
+    size_t _numHeads = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,153 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <queue>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/random.h"
+#include "mongo/s/query/results_merge_tree.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+constexpr int kDocsPerStream = 256;
+
+// Builds 'nStreams' synthetic shard result streams, each sorted according to {a: 1, b: -1}, with
+// the documents of the streams interleaving randomly as they would for a collection sharded on a
+// field other than the sort field.
+std::vector<std::vector<BSONObj>> makeStreams(int nStreams, bool stringSortKey) {
+    PseudoRandom rand(12345);
+    std::vector<std::vector<BSONObj>> streams(nStreams);
+
+    for (auto& stream : streams) {
+        int64_t a = 0;
+        for (int i = 0; i < kDocsPerStream; ++i) {
+            a += rand.nextInt32(1000);
+            BSONObjBuilder bob;
+            bob.append("_id", OID::gen());
+            bob.append("payload", std::string(64, 'x'));
+            {
+                BSONArrayBuilder sortKey(bob.subarrayStart("$sortKey"));
+                if (stringSortKey) {
+                    sortKey.append(str::stream() << "customer-" << (1000000000 + a));
+                } else {
+                    sortKey.append(a);
+                }
+                sortKey.append(rand.nextInt32());
+            }
+            stream.push_back(bob.obj());
+        }
+    }
+
+    return streams;
+}
+
+const BSONObj kSortPattern = BSON("a" << 1 << "b" << -1);
+
+void BM_MergeWithResultsMergeTree(benchmark::State& state, bool stringSortKey) {
+    const auto streams = makeStreams(state.range(0), stringSortKey);
+
+    for (auto keepRunning : state) {
+        ResultsMergeTree tree(kSortPattern, false);
+        std::vector<size_t> positions(streams.size(), 0);
+        for (size_t i = 0; i < streams.size(); ++i) {
+            tree.setHead(i, streams[i][0]);
+        }
+
+        while (!tree.empty()) {
+            const auto stream = tree.top();
+            benchmark::DoNotOptimize(streams[stream][positions[stream]]);
+            if (++positions[stream] < streams[stream].size())
+                tree.setHead(stream, streams[stream][positions[stream]]);
+            else
+                tree.removeHead(stream);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * streams.size() * kDocsPerStream);
+}
+
+// Reference merge through a binary heap which compares the BSON sort keys of the stream heads on
+// every operation.
+void BM_MergeWithPriorityQueue(benchmark::State& state, bool stringSortKey) {
+    const auto streams = makeStreams(state.range(0), stringSortKey);
+
+    for (auto keepRunning : state) {
+        std::vector<size_t> positions(streams.size(), 0);
+        auto headSortKey = [&](size_t stream) {
+            return streams[stream][positions[stream]]["$sortKey"].embeddedObject();
+        };
+        auto comparator = [&](size_t lhs, size_t rhs) {
+            const BSONObj::ComparisonRulesSet rules = 0;
+            return headSortKey(lhs).woCompare(headSortKey(rhs), kSortPattern, rules) > 0;
+        };
+        std::priority_queue<size_t, std::vector<size_t>, decltype(comparator)> queue(comparator);
+        for (size_t i = 0; i < streams.size(); ++i) {
+            queue.push(i);
+        }
+
+        while (!queue.empty()) {
+            const auto stream = queue.top();
+            queue.pop();
+            benchmark::DoNotOptimize(streams[stream][positions[stream]]);
+            if (++positions[stream] < streams[stream].size())
+                queue.push(stream);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * streams.size() * kDocsPerStream);
+}
+
+BENCHMARK_CAPTURE(BM_MergeWithResultsMergeTree, NumericSortKey, false)
+    ->Arg(2)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(500);
+BENCHMARK_CAPTURE(BM_MergeWithResultsMergeTree, StringSortKey, true)
+    ->Arg(2)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(500);
+BENCHMARK_CAPTURE(BM_MergeWithPriorityQueue, NumericSortKey, false)
+    ->Arg(2)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(500);
+BENCHMARK_CAPTURE(BM_MergeWithPriorityQueue, StringSortKey, true)
+    ->Arg(2)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(500);
+
+}  // namespace
+}  // namespace mongo
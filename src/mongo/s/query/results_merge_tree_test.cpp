@@ -0,0 +1,222 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/query/results_merge_tree.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Merges 'streams' through a ResultsMergeTree the way AsyncResultsMerger does, and returns the
+ * documents in the order the tree produced them.
+ */
+std::vector<BSONObj> mergeStreams(const std::vector<std::vector<BSONObj>>& streams,
+                                  const BSONObj& sortPattern,
+                                  bool compareWholeSortKey = false) {
+    ResultsMergeTree tree(sortPattern, compareWholeSortKey);
+    std::vector<size_t> positions(streams.size(), 0);
+    for (size_t i = 0; i < streams.size(); ++i) {
+        if (!streams[i].empty())
+            tree.setHead(i, streams[i][0]);
+    }
+
+    std::vector<BSONObj> merged;
+    while (!tree.empty()) {
+        const auto stream = tree.top();
+        merged.push_back(streams[stream][positions[stream]++]);
+        if (positions[stream] < streams[stream].size())
+            tree.setHead(stream, streams[stream][positions[stream]]);
+        else
+            tree.removeHead(stream);
+    }
+    return merged;
+}
+
+void assertMergedEquals(const std::vector<BSONObj>& merged, const std::vector<BSONObj>& expected) {
+    ASSERT_EQ(merged.size(), expected.size());
+    for (size_t i = 0; i < merged.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(merged[i], expected[i]);
+    }
+}
+
+TEST(ResultsMergeTreeTest, EmptyTree) {
+    ResultsMergeTree tree(BSON("a" << 1), false);
+    ASSERT_TRUE(tree.empty());
+
+    tree.removeHead(3);
+    ASSERT_TRUE(tree.empty());
+}
+
+TEST(ResultsMergeTreeTest, MergesAscendingStreams) {
+    auto merged = mergeStreams({{fromjson("{$sortKey: [1]}"), fromjson("{$sortKey: [4]}")},
+                                {fromjson("{$sortKey: [2]}"), fromjson("{$sortKey: [3]}")},
+                                {},
+                                {fromjson("{$sortKey: [0]}"), fromjson("{$sortKey: [5]}")}},
+                               BSON("a" << 1));
+
+    assertMergedEquals(merged,
+                       {fromjson("{$sortKey: [0]}"),
+                        fromjson("{$sortKey: [1]}"),
+                        fromjson("{$sortKey: [2]}"),
+                        fromjson("{$sortKey: [3]}"),
+                        fromjson("{$sortKey: [4]}"),
+                        fromjson("{$sortKey: [5]}")});
+}
+
+TEST(ResultsMergeTreeTest, MergesCompoundSortKeysWithMixedDirections) {
+    auto merged = mergeStreams(
+        {{fromjson("{$sortKey: [1, 'c']}"), fromjson("{$sortKey: [2, 'z']}")},
+         {fromjson("{$sortKey: [1, 'b']}"), fromjson("{$sortKey: [2, 'a']}")},
+         {fromjson("{$sortKey: [1.5, 'q']}")}},
+        BSON("a" << 1 << "b" << -1));
+
+    assertMergedEquals(merged,
+                       {fromjson("{$sortKey: [1, 'c']}"),
+                        fromjson("{$sortKey: [1, 'b']}"),
+                        fromjson("{$sortKey: [1.5, 'q']}"),
+                        fromjson("{$sortKey: [2, 'z']}"),
+                        fromjson("{$sortKey: [2, 'a']}")});
+}
+
+TEST(ResultsMergeTreeTest, ComparesNumbersOfDifferentTypesByValue) {
+    auto merged = mergeStreams(
+        {{BSON("$sortKey" << BSON_ARRAY(1LL)), BSON("$sortKey" << BSON_ARRAY(3.5))},
+         {BSON("$sortKey" << BSON_ARRAY(2.0)),
+          BSON("$sortKey" << BSON_ARRAY(Decimal128("4")))}},
+        BSON("a" << 1));
+
+    assertMergedEquals(merged,
+                       {BSON("$sortKey" << BSON_ARRAY(1LL)),
+                        BSON("$sortKey" << BSON_ARRAY(2.0)),
+                        BSON("$sortKey" << BSON_ARRAY(3.5)),
+                        BSON("$sortKey" << BSON_ARRAY(Decimal128("4")))});
+}
+
+TEST(ResultsMergeTreeTest, BreaksTiesInFavourOfLowerStreamIndex) {
+    auto merged = mergeStreams({{fromjson("{$sortKey: [1], s: 0}")},
+                                {fromjson("{$sortKey: [1], s: 1}")},
+                                {fromjson("{$sortKey: [1], s: 2}")}},
+                               BSON("a" << 1));
+
+    assertMergedEquals(merged,
+                       {fromjson("{$sortKey: [1], s: 0}"),
+                        fromjson("{$sortKey: [1], s: 1}"),
+                        fromjson("{$sortKey: [1], s: 2}")});
+}
+
+TEST(ResultsMergeTreeTest, ComparesEmbeddedObjectsByFieldNameBeforeValue) {
+    auto merged = mergeStreams({{fromjson("{$sortKey: [{a: 2}], s: 0}")},
+                                {fromjson("{$sortKey: [{z: 1}], s: 1}")},
+                                {fromjson("{$sortKey: [0], s: 2}")}},
+                               BSON("a" << 1));
+
+    assertMergedEquals(merged,
+                       {fromjson("{$sortKey: [0], s: 2}"),
+                        fromjson("{$sortKey: [{a: 2}], s: 0}"),
+                        fromjson("{$sortKey: [{z: 1}], s: 1}")});
+}
+
+TEST(ResultsMergeTreeTest, ComparesWholeSortKey) {
+    auto merged = mergeStreams({{fromjson("{$sortKey: 'b'}"), fromjson("{$sortKey: 'd'}")},
+                                {fromjson("{$sortKey: 'a'}"), fromjson("{$sortKey: 'c'}")}},
+                               BSON("$sortKey" << 1),
+                               true /* compareWholeSortKey */);
+
+    assertMergedEquals(merged,
+                       {fromjson("{$sortKey: 'a'}"),
+                        fromjson("{$sortKey: 'b'}"),
+                        fromjson("{$sortKey: 'c'}"),
+                        fromjson("{$sortKey: 'd'}")});
+}
+
+TEST(ResultsMergeTreeTest, GrowsWhenStreamsAreAdded) {
+    ResultsMergeTree tree(BSON("a" << 1), false);
+    const auto first = fromjson("{$sortKey: [5]}");
+    tree.setHead(0, first);
+    ASSERT_EQ(tree.top(), 0);
+
+    const auto second = fromjson("{$sortKey: [3]}");
+    tree.setHead(6, second);
+    ASSERT_EQ(tree.top(), 6);
+
+    const auto third = fromjson("{$sortKey: [4]}");
+    tree.setHead(2, third);
+    ASSERT_EQ(tree.top(), 6);
+
+    tree.removeHead(6);
+    ASSERT_EQ(tree.top(), 2);
+    tree.removeHead(2);
+    ASSERT_EQ(tree.top(), 0);
+    tree.removeHead(0);
+    ASSERT_TRUE(tree.empty());
+}
+
+TEST(ResultsMergeTreeTest, MergesSortKeysWithTooManyComponentsForKeyString) {
+    BSONObjBuilder sortPattern;
+    BSONArrayBuilder low, high;
+    for (size_t i = 0; i <= Ordering::kMaxCompoundIndexKeys; ++i) {
+        sortPattern.append(std::to_string(i), 1);
+        low.append(0);
+        high.append(i == Ordering::kMaxCompoundIndexKeys ? 1 : 0);
+    }
+    const auto lowDoc = BSON("$sortKey" << low.arr());
+    const auto highDoc = BSON("$sortKey" << high.arr());
+
+    auto merged = mergeStreams({{highDoc}, {lowDoc}}, sortPattern.obj());
+    assertMergedEquals(merged, {lowDoc, highDoc});
+}
+
+TEST(ResultsMergeTreeTest, MergesManyStreams) {
+    // Stream i holds the multiples of 'kNumStreams' offset by i in descending order, so the merge
+    // yields every number from the largest down.
+    const int kNumStreams = 100;
+    const int kDocsPerStream = 20;
+    std::vector<std::vector<BSONObj>> streams(kNumStreams);
+    for (int i = 0; i < kNumStreams; ++i) {
+        for (int j = 0; j < kDocsPerStream; ++j) {
+            const int value = (kDocsPerStream - 1 - j) * kNumStreams + i;
+            streams[i].push_back(BSON("$sortKey" << BSON_ARRAY(value)));
+        }
+    }
+
+    auto merged = mergeStreams(streams, BSON("a" << -1 << "b" << 1));
+    ASSERT_EQ(merged.size(), kNumStreams * kDocsPerStream);
+    for (size_t i = 0; i < merged.size(); ++i) {
+        ASSERT_EQ(merged[i]["$sortKey"].Obj().firstElement().numberInt(),
+                  static_cast<int>(merged.size() - 1 - i));
+    }
+}
+
+}  // namespace
+}  // namespace mongo
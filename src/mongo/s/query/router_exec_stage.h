@@ -124,6 +124,17 @@ public:
         return doSetAwaitDataTimeout(awaitDataTimeout);
     }
 
+    /**
+     * Informs the stage that its parent will consume at most 'docsNeeded' more of its results, so
+     * that the stages below can avoid fetching results which will never be returned. The default
+     * implementation forwards the hint to the stage's child, if any.
+     */
+    virtual void setDocsNeeded(long long docsNeeded) {
+        if (_child) {
+            _child->setDocsNeeded(docsNeeded);
+        }
+    }
+
     /**
      * Returns the postBatchResumeToken if this RouterExecStage tree is executing a $changeStream;
      * otherwise, returns an empty BSONObj. Default implementation forwards to the stage's child.
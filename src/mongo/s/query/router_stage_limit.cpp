@@ -40,6 +40,7 @@ RouterStageLimit::RouterStageLimit(OperationContext* opCtx,
                                    long long limit)
     : RouterExecStage(opCtx, std::move(child)), _limit(limit) {
     invariant(limit > 0);
+    getChildStage()->setDocsNeeded(_limit);
 }
 
 StatusWith<ClusterQueryResult> RouterStageLimit::next() {
@@ -58,4 +59,8 @@ StatusWith<ClusterQueryResult> RouterStageLimit::next() {
     return childResult;
 }
 
+void RouterStageLimit::setDocsNeeded(long long docsNeeded) {
+    getChildStage()->setDocsNeeded(std::min(docsNeeded, _limit - _returnedSoFar));
+}
+
 }  // namespace mongo
@@ -44,6 +44,8 @@ public:
 
     StatusWith<ClusterQueryResult> next() final;
 
+    void setDocsNeeded(long long docsNeeded) final;
+
 private:
     long long _limit;
 
@@ -59,6 +59,10 @@ public:
         _resultsMerger.kill(opCtx);
     }
 
+    void setDocsNeeded(long long docsNeeded) final {
+        _resultsMerger.setDocsNeeded(docsNeeded);
+    }
+
     bool remotesExhausted() final {
         return _resultsMerger.remotesExhausted();
     }
@@ -59,4 +59,9 @@ StatusWith<ClusterQueryResult> RouterStageSkip::next() {
     return getChildStage()->next();
 }
 
+void RouterStageSkip::setDocsNeeded(long long docsNeeded) {
+    // The results still to be skipped are consumed from the child in addition to those needed.
+    getChildStage()->setDocsNeeded(docsNeeded + (_skip - _skippedSoFar));
+}
+
 }  // namespace mongo
@@ -0,0 +1,192 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/replica_latency_tracker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "mongo/db/operation_context.h"
+#include "mongo/platform/bits.h"
+
+namespace mongo {
+
+namespace {
+const auto replicaLatencyTrackerDecoration =
+    ServiceContext::declareDecoration<ReplicaLatencyTracker>();
+}  // namespace
+
+ReplicaLatencyTracker* ReplicaLatencyTracker::get(ServiceContext* service) {
+    return &replicaLatencyTrackerDecoration(service);
+}
+
+ReplicaLatencyTracker* ReplicaLatencyTracker::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+void ReplicaLatencyTracker::onRequestStarted(const HostAndPort& host) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    ++_hosts[host].inFlight;
+}
+
+void ReplicaLatencyTracker::onRequestFinished(const HostAndPort& host,
+                                              const boost::optional<HostAndPort>& responder,
+                                              boost::optional<Microseconds> elapsed) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    auto& stats = _hosts[host];
+    if (stats.inFlight > 0) {
+        --stats.inFlight;
+    }
+
+    if (responder && elapsed) {
+        _recordSample(lk, *responder == host ? stats : _hosts[*responder], *elapsed);
+    }
+}
+
+void ReplicaLatencyTracker::sortByExpectedCompletion(std::vector<HostAndPort>* hosts) const {
+    if (hosts->size() < 2) {
+        return;
+    }
+
+    std::vector<std::pair<double, HostAndPort>> costs;
+    costs.reserve(hosts->size());
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (auto& host : *hosts) {
+            auto it = _hosts.find(host);
+            double cost = 0;
+            if (it != _hosts.end() && it->second.hasSamples) {
+                cost = it->second.ewmaMicros * (it->second.inFlight + 1);
+            }
+            costs.emplace_back(cost, std::move(host));
+        }
+    }
+
+    std::stable_sort(costs.begin(), costs.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    for (size_t i = 0; i < costs.size(); ++i) {
+        (*hosts)[i] = std::move(costs[i].second);
+    }
+}
+
+boost::optional<Milliseconds> ReplicaLatencyTracker::getLatencyPercentile(
+    const HostAndPort& host, double percentile) const {
+    invariant(percentile > 0 && percentile <= 1);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _hosts.find(host);
+    if (it == _hosts.end() || it->second.histogramCount < kMinSamplesForPercentile) {
+        return boost::none;
+    }
+
+    const auto& stats = it->second;
+    const auto target = static_cast<uint64_t>(std::ceil(percentile * stats.histogramCount));
+
+    uint64_t seen = 0;
+    size_t bucket = 0;
+    for (; bucket < kNumBuckets - 1; ++bucket) {
+        seen += stats.histogram[bucket];
+        if (seen >= target) {
+            break;
+        }
+    }
+
+    // Report the upper bound of the bucket, rounded up to the next millisecond, so that the
+    // percentile is never underestimated.
+    const auto upperBound = _bucketUpperBound(bucket);
+    if (upperBound == std::numeric_limits<int64_t>::max()) {
+        return Milliseconds::max();
+    }
+    return Milliseconds((upperBound + 999) / 1000);
+}
+
+boost::optional<Microseconds> ReplicaLatencyTracker::getAverageLatency(
+    const HostAndPort& host) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _hosts.find(host);
+    if (it == _hosts.end() || !it->second.hasSamples) {
+        return boost::none;
+    }
+    return Microseconds(static_cast<int64_t>(it->second.ewmaMicros));
+}
+
+size_t ReplicaLatencyTracker::_bucketFor(int64_t micros) {
+    constexpr int64_t kLinearLimit = 1 << kSubBucketBits;
+    if (micros < kLinearLimit) {
+        return std::max<int64_t>(micros, 0);
+    }
+
+    const size_t msb = 63 - countLeadingZeros64(micros);
+    const size_t sub = (micros >> (msb - kSubBucketBits)) & (kLinearLimit - 1);
+    return ((msb - kSubBucketBits + 1) << kSubBucketBits) + sub;
+}
+
+int64_t ReplicaLatencyTracker::_bucketUpperBound(size_t bucket) {
+    constexpr size_t kLinearLimit = 1 << kSubBucketBits;
+    if (bucket < kLinearLimit) {
+        return bucket + 1;
+    }
+
+    const size_t shift = (bucket >> kSubBucketBits) - 1;
+    const size_t sub = bucket & (kLinearLimit - 1);
+    if (shift + kSubBucketBits + 1 >= 63) {
+        return std::numeric_limits<int64_t>::max();
+    }
+    return static_cast<int64_t>(kLinearLimit + sub + 1) << shift;
+}
+
+void ReplicaLatencyTracker::_recordSample(WithLock, HostStats& stats, Microseconds elapsed) {
+    const auto micros = durationCount<Microseconds>(elapsed);
+
+    if (stats.hasSamples) {
+        stats.ewmaMicros += kEwmaWeight * (micros - stats.ewmaMicros);
+    } else {
+        stats.ewmaMicros = micros;
+        stats.hasSamples = true;
+    }
+
+    if (stats.histogramCount >= kHistogramDecayWindow) {
+        stats.histogramCount = 0;
+        for (auto& count : stats.histogram) {
+            count /= 2;
+            stats.histogramCount += count;
+        }
+    }
+
+    ++stats.histogram[_bucketFor(micros)];
+    ++stats.histogramCount;
+}
+
+}  // namespace mongo
@@ -0,0 +1,129 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "mongo/db/service_context.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/net/hostandport.h"
+
+namespace mongo {
+
+/**
+ * Keeps live per-host latency statistics for the remote commands sent through the
+ * AsyncRequestsSender and uses them to choose among the hosts which satisfy a read preference.
+ *
+ * For every host it maintains an exponentially weighted moving average of the observed round
+ * trip time, the number of requests currently outstanding against it and a log-linear histogram
+ * of recent latencies. The histogram is periodically halved so that the percentiles follow the
+ * current behaviour of the host rather than its whole history.
+ *
+ * This class is thread-safe.
+ */
+class ReplicaLatencyTracker {
+    ReplicaLatencyTracker(const ReplicaLatencyTracker&) = delete;
+    ReplicaLatencyTracker& operator=(const ReplicaLatencyTracker&) = delete;
+
+public:
+    // Weight of the newest sample in the moving average.
+    static constexpr double kEwmaWeight = 0.2;
+
+    // Number of samples after which the histogram counts are halved.
+    static constexpr uint32_t kHistogramDecayWindow = 1024;
+
+    // Minimum number of samples in the histogram before its percentiles are trusted.
+    static constexpr uint32_t kMinSamplesForPercentile = 20;
+
+    ReplicaLatencyTracker() = default;
+
+    static ReplicaLatencyTracker* get(ServiceContext* service);
+    static ReplicaLatencyTracker* get(OperationContext* opCtx);
+
+    /**
+     * Records that a request is about to be sent to 'host'. Must be paired with a call to
+     * onRequestFinished for the same host.
+     */
+    void onRequestStarted(const HostAndPort& host);
+
+    /**
+     * Records that a request started against 'host' has completed. If the response came back
+     * over the network, 'elapsed' is the round trip time observed against 'responder', which
+     * may differ from 'host' when the request was hedged.
+     */
+    void onRequestFinished(const HostAndPort& host,
+                           const boost::optional<HostAndPort>& responder,
+                           boost::optional<Microseconds> elapsed);
+
+    /**
+     * Stable-sorts 'hosts' by the expected completion time of a new request, which is the
+     * moving average latency scaled by the number of requests already outstanding. Hosts
+     * without any samples sort first so that they get explored.
+     */
+    void sortByExpectedCompletion(std::vector<HostAndPort>* hosts) const;
+
+    /**
+     * Returns the 'percentile' (in the range (0, 1]) latency of 'host', or boost::none if not
+     * enough samples have been collected for it.
+     */
+    boost::optional<Milliseconds> getLatencyPercentile(const HostAndPort& host,
+                                                       double percentile) const;
+
+    /**
+     * Returns the moving average latency of 'host', or boost::none if it has never responded.
+     */
+    boost::optional<Microseconds> getAverageLatency(const HostAndPort& host) const;
+
+private:
+    // Four buckets per power of two of microseconds, up to 2^63.
+    static constexpr size_t kSubBucketBits = 2;
+    static constexpr size_t kNumBuckets = 64 << kSubBucketBits;
+
+    struct HostStats {
+        double ewmaMicros = 0;
+        bool hasSamples = false;
+        int64_t inFlight = 0;
+        uint32_t histogramCount = 0;
+        std::array<uint32_t, kNumBuckets> histogram{};
+    };
+
+    static size_t _bucketFor(int64_t micros);
+    static int64_t _bucketUpperBound(size_t bucket);
+
+    void _recordSample(WithLock, HostStats& stats, Microseconds elapsed);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ReplicaLatencyTracker::_mutex");
+    stdx::unordered_map<HostAndPort, HostStats> _hosts;
+};
+
+}  // namespace mongo
@@ -0,0 +1,164 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/replica_latency_tracker.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const HostAndPort kHost1("host1", 27017);
+const HostAndPort kHost2("host2", 27017);
+const HostAndPort kHost3("host3", 27017);
+
+void recordLatency(ReplicaLatencyTracker& tracker, const HostAndPort& host, Microseconds elapsed) {
+    tracker.onRequestStarted(host);
+    tracker.onRequestFinished(host, host, elapsed);
+}
+
+TEST(ReplicaLatencyTrackerTest, NoStatisticsForUnknownHost) {
+    ReplicaLatencyTracker tracker;
+    ASSERT_FALSE(tracker.getAverageLatency(kHost1));
+    ASSERT_FALSE(tracker.getLatencyPercentile(kHost1, 0.95));
+}
+
+TEST(ReplicaLatencyTrackerTest, AverageFollowsRecentSamples) {
+    ReplicaLatencyTracker tracker;
+    recordLatency(tracker, kHost1, Microseconds(1000));
+    ASSERT_EQ(*tracker.getAverageLatency(kHost1), Microseconds(1000));
+
+    for (int i = 0; i < 100; ++i) {
+        recordLatency(tracker, kHost1, Microseconds(5000));
+    }
+    auto average = *tracker.getAverageLatency(kHost1);
+    ASSERT_GT(average, Microseconds(4990));
+    ASSERT_LTE(average, Microseconds(5000));
+}
+
+TEST(ReplicaLatencyTrackerTest, PercentileRequiresEnoughSamples) {
+    ReplicaLatencyTracker tracker;
+    for (uint32_t i = 1; i < ReplicaLatencyTracker::kMinSamplesForPercentile; ++i) {
+        recordLatency(tracker, kHost1, Milliseconds(1));
+    }
+    ASSERT_FALSE(tracker.getLatencyPercentile(kHost1, 0.95));
+
+    recordLatency(tracker, kHost1, Milliseconds(1));
+    ASSERT_TRUE(tracker.getLatencyPercentile(kHost1, 0.95));
+}
+
+TEST(ReplicaLatencyTrackerTest, PercentileIsNotUnderestimated) {
+    ReplicaLatencyTracker tracker;
+    for (int i = 0; i < 90; ++i) {
+        recordLatency(tracker, kHost1, Milliseconds(2));
+    }
+    for (int i = 0; i < 10; ++i) {
+        recordLatency(tracker, kHost1, Milliseconds(40));
+    }
+
+    // Buckets are a quarter of a power of two wide, so percentiles are rounded up by at most 25%.
+    auto p50 = *tracker.getLatencyPercentile(kHost1, 0.5);
+    ASSERT_GTE(p50, Milliseconds(2));
+    ASSERT_LTE(p50, Milliseconds(3));
+
+    auto p95 = *tracker.getLatencyPercentile(kHost1, 0.95);
+    ASSERT_GTE(p95, Milliseconds(40));
+    ASSERT_LTE(p95, Milliseconds(50));
+}
+
+TEST(ReplicaLatencyTrackerTest, PercentileForgetsOldSamples) {
+    ReplicaLatencyTracker tracker;
+    for (uint32_t i = 0; i < ReplicaLatencyTracker::kHistogramDecayWindow; ++i) {
+        recordLatency(tracker, kHost1, Milliseconds(100));
+    }
+    ASSERT_GTE(*tracker.getLatencyPercentile(kHost1, 0.95), Milliseconds(100));
+
+    // Every decay window halves the weight of the older samples, so after a few windows of fast
+    // responses the slow ones fall out of the 95th percentile.
+    for (uint32_t i = 0; i < 5 * ReplicaLatencyTracker::kHistogramDecayWindow; ++i) {
+        recordLatency(tracker, kHost1, Milliseconds(1));
+    }
+    ASSERT_LTE(*tracker.getLatencyPercentile(kHost1, 0.95), Milliseconds(2));
+}
+
+TEST(ReplicaLatencyTrackerTest, SortsByAverageLatency) {
+    ReplicaLatencyTracker tracker;
+    recordLatency(tracker, kHost1, Milliseconds(30));
+    recordLatency(tracker, kHost2, Milliseconds(10));
+    recordLatency(tracker, kHost3, Milliseconds(20));
+
+    std::vector<HostAndPort> hosts{kHost1, kHost2, kHost3};
+    tracker.sortByExpectedCompletion(&hosts);
+    ASSERT_EQ(hosts[0], kHost2);
+    ASSERT_EQ(hosts[1], kHost3);
+    ASSERT_EQ(hosts[2], kHost1);
+}
+
+TEST(ReplicaLatencyTrackerTest, SortsHostsWithoutSamplesFirstAndKeepsTheirOrder) {
+    ReplicaLatencyTracker tracker;
+    recordLatency(tracker, kHost1, Milliseconds(1));
+
+    std::vector<HostAndPort> hosts{kHost1, kHost3, kHost2};
+    tracker.sortByExpectedCompletion(&hosts);
+    ASSERT_EQ(hosts[0], kHost3);
+    ASSERT_EQ(hosts[1], kHost2);
+    ASSERT_EQ(hosts[2], kHost1);
+}
+
+TEST(ReplicaLatencyTrackerTest, OutstandingRequestsIncreaseExpectedCompletion) {
+    ReplicaLatencyTracker tracker;
+    recordLatency(tracker, kHost1, Milliseconds(10));
+    recordLatency(tracker, kHost2, Milliseconds(15));
+
+    std::vector<HostAndPort> hosts{kHost2, kHost1};
+    tracker.sortByExpectedCompletion(&hosts);
+    ASSERT_EQ(hosts[0], kHost1);
+
+    // A host queueing a request behind another one is expected to take twice its latency.
+    tracker.onRequestStarted(kHost1);
+    tracker.sortByExpectedCompletion(&hosts);
+    ASSERT_EQ(hosts[0], kHost2);
+
+    tracker.onRequestFinished(kHost1, boost::none, boost::none);
+    tracker.sortByExpectedCompletion(&hosts);
+    ASSERT_EQ(hosts[0], kHost1);
+}
+
+TEST(ReplicaLatencyTrackerTest, HedgedResponseIsAttributedToResponder) {
+    ReplicaLatencyTracker tracker;
+    tracker.onRequestStarted(kHost1);
+    tracker.onRequestFinished(kHost1, kHost2, Microseconds(5000));
+
+    ASSERT_FALSE(tracker.getAverageLatency(kHost1));
+    ASSERT_EQ(*tracker.getAverageLatency(kHost2), Microseconds(5000));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kSharding
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/routing_change_subscriber.h"
+
+#include "mongo/db/client.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/logv2/log.h"
+#include "mongo/s/catalog_cache.h"
+#include "mongo/s/client/shard_registry.h"
+#include "mongo/s/grid.h"
+#include "mongo/s/request_types/wait_for_routing_change_gen.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/exit.h"
+
+namespace mongo {
+namespace {
+
+// How long the config server holds the request open when there are no changes
+const Milliseconds kMaxAwaitTime(30 * 1000);
+
+// Extra time given to the request over kMaxAwaitTime, so that it does not time out on the network
+const Milliseconds kNetworkTimeoutSlack(10 * 1000);
+
+// How long to wait before retrying after the config server could not be reached
+const Seconds kRetryInterval(1);
+
+}  // namespace
+
+RoutingChangeSubscriber::RoutingChangeSubscriber() = default;
+
+RoutingChangeSubscriber::~RoutingChangeSubscriber() {
+    // The thread must not be running when this object is destroyed
+    invariant(!_thread.joinable());
+}
+
+void RoutingChangeSubscriber::startThread() {
+    invariant(!_thread.joinable());
+
+    _thread = stdx::thread([] {
+        Client::initThread("RoutingChangeSubscriber");
+
+        boost::optional<OID> instanceId;
+        long long generation = 0;
+
+        while (!globalInShutdownDeprecated()) {
+            try {
+                auto opCtx = cc().makeOperationContext();
+
+                ConfigsvrWaitForRoutingChange request;
+                request.setDbName(NamespaceString::kAdminDb);
+                request.setInstanceId(instanceId);
+                request.setAfterGeneration(generation);
+                request.setMaxAwaitTimeMS(durationCount<Milliseconds>(kMaxAwaitTime));
+
+                auto configShard = Grid::get(opCtx.get())->shardRegistry()->getConfigShard();
+                auto cmdResponse = [&] {
+                    MONGO_IDLE_THREAD_BLOCK;
+                    return uassertStatusOK(
+                        configShard->runCommand(opCtx.get(),
+                                                ReadPreferenceSetting{ReadPreference::PrimaryOnly},
+                                                NamespaceString::kAdminDb.toString(),
+                                                request.toBSON({}),
+                                                kMaxAwaitTime + kNetworkTimeoutSlack,
+                                                Shard::RetryPolicy::kIdempotent));
+                }();
+                uassertStatusOK(cmdResponse.commandStatus);
+
+                const auto response = WaitForRoutingChangeResponse::parse(
+                    IDLParserErrorContext("WaitForRoutingChangeResponse"), cmdResponse.response);
+
+                // Changes which were missed are left to the stale config protocol, the history is
+                // only expected to be lost on the first request and after config server failovers
+                if (response.getHistoryLost() && instanceId) {
+                    LOGV2_DEBUG(6000155,
+                                1,
+                                "Missed routing changes from the config server",
+                                "instanceId"_attr = response.getInstanceId(),
+                                "generation"_attr = response.getGeneration());
+                }
+
+                instanceId = response.getInstanceId();
+                generation = response.getGeneration();
+
+                auto catalogCache = Grid::get(opCtx.get())->catalogCache();
+                for (const auto& nss : response.getNamespaces()) {
+                    auto status = catalogCache->onRoutingChangeNotification(opCtx.get(), nss);
+                    if (!status.isOK()) {
+                        LOGV2_DEBUG(6000156,
+                                    1,
+                                    "Failed to refresh the routing table after a change "
+                                    "notification",
+                                    "namespace"_attr = nss,
+                                    "error"_attr = redact(status));
+                    }
+                }
+
+                continue;
+            } catch (const DBException& ex) {
+                LOGV2_DEBUG(6000157,
+                            1,
+                            "Failed to wait for routing changes on the config server",
+                            "error"_attr = redact(ex));
+            }
+
+            MONGO_IDLE_THREAD_BLOCK;
+            sleepFor(kRetryInterval);
+        }
+    });
+}
+
+}  // namespace mongo
@@ -0,0 +1,208 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/shard_key_targeting_cache.h"
+
+#include "mongo/db/hasher.h"
+#include "mongo/s/mongod_and_mongos_server_parameters_gen.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+// Filters larger than this are not worth the cost of computing their shape.
+constexpr int kMaxCacheableQuerySize = 4 * 1024;
+
+/**
+ * Returns whether 'el' is a value which a top-level equality can be bound to. Arrays, objects,
+ * regular expressions and null have matching semantics which differ from a plain comparison of the
+ * shard key, so they are always left to the full targeting path.
+ */
+bool isBindableValue(const BSONElement& el) {
+    switch (el.type()) {
+        case NumberInt:
+        case NumberLong:
+        case NumberDouble:
+        case NumberDecimal:
+        case String:
+        case jstOID:
+        case Bool:
+        case Date:
+        case bsonTimestamp:
+        case BinData:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void appendElementShape(const BSONElement& el, std::string* shape) {
+    // Field names cannot contain a NUL byte, which makes it a safe terminator.
+    shape->append(el.fieldName(), el.fieldNameSize());
+    shape->push_back(static_cast<char>(el.type()));
+}
+
+}  // namespace
+
+boost::optional<std::string> ShardKeyTargetingCache::computeShapeKey(const BSONObj& query) {
+    if (query.objsize() > kMaxCacheableQuerySize)
+        return boost::none;
+
+    std::string shape;
+    shape.reserve(query.objsize());
+    for (const auto& el : query) {
+        appendElementShape(el, &shape);
+        if (el.type() != Object)
+            continue;
+
+        shape.push_back('{');
+        for (const auto& child : el.Obj()) {
+            appendElementShape(child, &shape);
+        }
+        shape.push_back('}');
+    }
+    return shape;
+}
+
+BSONObj ShardKeyTargetingCache::bind(const ShardKeyPattern& shardKeyPattern,
+                                     const std::string& shapeKey,
+                                     const BSONObj& query) const {
+    Plan plan;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _plans.find(shapeKey);
+        if (it == _plans.end())
+            return BSONObj();
+        plan = it->second;
+    }
+
+    return _bindWithPlan(shardKeyPattern, plan, query);
+}
+
+void ShardKeyTargetingCache::learn(const ShardKeyPattern& shardKeyPattern,
+                                   const std::string& shapeKey,
+                                   const BSONObj& query,
+                                   const BSONObj& extractedShardKey) {
+    const auto maxEntries = static_cast<size_t>(gRoutingTableTargetingCacheMaxEntries.load());
+    if (maxEntries == 0 || extractedShardKey.isEmpty())
+        return;
+
+    auto plan = _derivePlan(shardKeyPattern, query);
+    if (!plan)
+        return;
+
+    if (!_bindWithPlan(shardKeyPattern, *plan, query).binaryEqual(extractedShardKey))
+        return;
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_plans.size() >= maxEntries)
+        _plans.clear();
+    _plans.emplace(shapeKey, std::move(*plan));
+}
+
+size_t ShardKeyTargetingCache::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _plans.size();
+}
+
+boost::optional<ShardKeyTargetingCache::Plan> ShardKeyTargetingCache::_derivePlan(
+    const ShardKeyPattern& shardKeyPattern, const BSONObj& query) {
+    Plan plan;
+    for (const auto& patternPath : shardKeyPattern.getKeyPatternFields()) {
+        const auto fieldName = patternPath->dottedField();
+
+        boost::optional<Binding> binding;
+        size_t position = 0;
+        for (const auto& el : query) {
+            if (el.fieldNameStringData() == fieldName) {
+                // A field which appears more than once is left to the full targeting path.
+                if (binding)
+                    return boost::none;
+
+                if (isBindableValue(el)) {
+                    binding = Binding{position, false};
+                } else if (el.type() == Object && el.Obj().nFields() == 1 &&
+                           el.Obj().firstElement().fieldNameStringData() == "$eq"_sd &&
+                           isBindableValue(el.Obj().firstElement())) {
+                    binding = Binding{position, true};
+                } else {
+                    return boost::none;
+                }
+            }
+            ++position;
+        }
+
+        if (!binding)
+            return boost::none;
+        plan.push_back(*binding);
+    }
+    return plan;
+}
+
+BSONObj ShardKeyTargetingCache::_bindWithPlan(const ShardKeyPattern& shardKeyPattern,
+                                              const Plan& plan,
+                                              const BSONObj& query) {
+    std::vector<BSONElement> elements;
+    query.elems(elements);
+
+    const auto& patternPaths = shardKeyPattern.getKeyPatternFields();
+    invariant(patternPaths.size() == plan.size());
+
+    const auto hashedField = shardKeyPattern.isHashedPattern()
+        ? shardKeyPattern.getHashedField().fieldNameStringData()
+        : StringData();
+
+    BSONObjBuilder keyBuilder;
+    for (size_t i = 0; i < plan.size(); ++i) {
+        if (plan[i].position >= elements.size())
+            return BSONObj();
+
+        auto value = elements[plan[i].position];
+        if (plan[i].unwrapEq) {
+            if (value.type() != Object)
+                return BSONObj();
+            value = value.Obj().firstElement();
+        }
+        if (!isBindableValue(value))
+            return BSONObj();
+
+        const auto fieldName = patternPaths[i]->dottedField();
+        if (!hashedField.empty() && hashedField == fieldName) {
+            keyBuilder.append(
+                fieldName, BSONElementHasher::hash64(value, BSONElementHasher::DEFAULT_HASH_SEED));
+        } else {
+            keyBuilder.appendAs(value, fieldName);
+        }
+    }
+    return keyBuilder.obj();
+}
+
+}  // namespace mongo
@@ -0,0 +1,113 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/s/shard_key_pattern.h"
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+/**
+ * Remembers, per query shape, how to bind the shard key of a query directly out of its filter so
+ * that repeated queries of the same shape can be targeted to a single chunk without being
+ * canonicalized.
+ *
+ * A query shape is made of the top-level field names of the filter, the BSON types of their values
+ * and, for object values, the names and types of their immediate children. The values themselves
+ * are not part of the shape. A plan is only remembered for a shape after binding it has produced
+ * exactly the shard key which the full targeting path extracted from the canonical query, and
+ * binding is restricted to top-level equalities on each shard key field, which are implicitly
+ * ANDed with the rest of the filter and therefore confine every matching document to that key.
+ *
+ * One instance is owned by each RoutingTableHistory, so every routing table change starts with an
+ * empty cache. All methods are thread-safe.
+ */
+class ShardKeyTargetingCache {
+    ShardKeyTargetingCache(const ShardKeyTargetingCache&) = delete;
+    ShardKeyTargetingCache& operator=(const ShardKeyTargetingCache&) = delete;
+
+public:
+    ShardKeyTargetingCache() = default;
+
+    /**
+     * Returns the shape key of 'query', or boost::none if the filter is too large to be worth
+     * caching.
+     */
+    static boost::optional<std::string> computeShapeKey(const BSONObj& query);
+
+    /**
+     * Binds the shard key of 'query' using the plan remembered for 'shapeKey'. Returns an empty
+     * object if there is no plan for the shape or if the query cannot be bound with it.
+     */
+    BSONObj bind(const ShardKeyPattern& shardKeyPattern,
+                 const std::string& shapeKey,
+                 const BSONObj& query) const;
+
+    /**
+     * Derives a plan for 'shapeKey' from 'query' and remembers it if binding 'query' with it
+     * produces 'extractedShardKey', the shard key extracted from the canonical form of 'query'.
+     */
+    void learn(const ShardKeyPattern& shardKeyPattern,
+               const std::string& shapeKey,
+               const BSONObj& query,
+               const BSONObj& extractedShardKey);
+
+    size_t size() const;
+
+private:
+    // Where to find the value of one shard key field among the top-level elements of the filter.
+    struct Binding {
+        size_t position;
+
+        // Whether the element is of the form {$eq: <value>} rather than the value itself.
+        bool unwrapEq;
+    };
+
+    // One binding per shard key field, in shard key order.
+    using Plan = std::vector<Binding>;
+
+    static boost::optional<Plan> _derivePlan(const ShardKeyPattern& shardKeyPattern,
+                                             const BSONObj& query);
+
+    static BSONObj _bindWithPlan(const ShardKeyPattern& shardKeyPattern,
+                                 const Plan& plan,
+                                 const BSONObj& query);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ShardKeyTargetingCache::_mutex");
+
+    stdx::unordered_map<std::string, Plan> _plans;
+};
+
+}  // namespace mongo
@@ -0,0 +1,139 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/hasher.h"
+#include "mongo/db/json.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/s/shard_key_targeting_cache.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::string shapeOf(const BSONObj& query) {
+    auto shapeKey = ShardKeyTargetingCache::computeShapeKey(query);
+    ASSERT(shapeKey);
+    return *shapeKey;
+}
+
+TEST(ShardKeyTargetingCacheTest, ShapeIgnoresValues) {
+    ASSERT_EQ(shapeOf(fromjson("{a: 1, b: 'x'}")), shapeOf(fromjson("{a: 2, b: 'y'}")));
+    ASSERT_EQ(shapeOf(fromjson("{a: {$eq: 1}}")), shapeOf(fromjson("{a: {$eq: 2}}")));
+}
+
+TEST(ShardKeyTargetingCacheTest, ShapeDistinguishesFieldsTypesAndOperators) {
+    ASSERT_NE(shapeOf(fromjson("{a: 1}")), shapeOf(fromjson("{b: 1}")));
+    ASSERT_NE(shapeOf(fromjson("{a: 1}")), shapeOf(fromjson("{a: 'x'}")));
+    ASSERT_NE(shapeOf(fromjson("{a: 1, b: 1}")), shapeOf(fromjson("{b: 1, a: 1}")));
+    ASSERT_NE(shapeOf(fromjson("{a: {$eq: 1}}")), shapeOf(fromjson("{a: {$gt: 1}}")));
+    ASSERT_NE(shapeOf(fromjson("{a: {$eq: 1}}")), shapeOf(fromjson("{a: {$eq: [1]}}")));
+}
+
+TEST(ShardKeyTargetingCacheTest, LargeQueriesHaveNoShape) {
+    ASSERT_FALSE(ShardKeyTargetingCache::computeShapeKey(BSON("a" << std::string(8192, 'x'))));
+}
+
+TEST(ShardKeyTargetingCacheTest, BindsLearnedShape) {
+    const ShardKeyPattern pattern(BSON("a" << 1 << "b" << 1));
+    ShardKeyTargetingCache cache;
+
+    const auto query = fromjson("{c: 5, b: {$eq: 'x'}, a: 1}");
+    const auto shapeKey = shapeOf(query);
+    ASSERT_BSONOBJ_EQ(BSONObj(), cache.bind(pattern, shapeKey, query));
+
+    cache.learn(pattern, shapeKey, query, fromjson("{a: 1, b: 'x'}"));
+    ASSERT_EQ(1U, cache.size());
+
+    const auto other = fromjson("{c: 6, b: {$eq: 'y'}, a: 2}");
+    ASSERT_EQ(shapeKey, shapeOf(other));
+    ASSERT_BSONOBJ_EQ(fromjson("{a: 2, b: 'y'}"), cache.bind(pattern, shapeKey, other));
+}
+
+TEST(ShardKeyTargetingCacheTest, BindsHashedShardKey) {
+    const ShardKeyPattern pattern(BSON("a"
+                                       << "hashed"));
+    ShardKeyTargetingCache cache;
+
+    const auto hashOf = [](const BSONObj& obj) {
+        return BSON("a" << BSONElementHasher::hash64(obj["a"],
+                                                     BSONElementHasher::DEFAULT_HASH_SEED));
+    };
+
+    const auto query = BSON("a" << 10);
+    const auto shapeKey = shapeOf(query);
+    cache.learn(pattern, shapeKey, query, hashOf(query));
+    ASSERT_EQ(1U, cache.size());
+
+    const auto other = BSON("a" << 20);
+    ASSERT_BSONOBJ_EQ(hashOf(other), cache.bind(pattern, shapeKey, other));
+}
+
+TEST(ShardKeyTargetingCacheTest, DoesNotLearnWhenBindingDisagrees) {
+    const ShardKeyPattern pattern(BSON("a" << 1));
+    ShardKeyTargetingCache cache;
+
+    const auto query = fromjson("{a: 1}");
+    cache.learn(pattern, shapeOf(query), query, fromjson("{a: 2}"));
+    ASSERT_EQ(0U, cache.size());
+}
+
+TEST(ShardKeyTargetingCacheTest, DoesNotLearnUnbindableShapes) {
+    const ShardKeyPattern pattern(BSON("a" << 1));
+    ShardKeyTargetingCache cache;
+
+    for (const auto& query : {fromjson("{a: {$gte: 1, $lte: 1}}"),
+                              fromjson("{a: null}"),
+                              fromjson("{a: 1, a: 1}"),
+                              fromjson("{$and: [{a: 1}]}")}) {
+        cache.learn(pattern, shapeOf(query), query, fromjson("{a: 1}"));
+    }
+    ASSERT_EQ(0U, cache.size());
+}
+
+TEST(ShardKeyTargetingCacheTest, BoundedByMaxEntries) {
+    RAIIServerParameterControllerForTest maxEntries("routingTableTargetingCacheMaxEntries", 2);
+    const ShardKeyPattern pattern(BSON("a" << 1));
+    ShardKeyTargetingCache cache;
+
+    for (const auto& query :
+         {fromjson("{a: 1}"), fromjson("{a: 1, b: 1}"), fromjson("{a: 1, c: 1}")}) {
+        cache.learn(pattern, shapeOf(query), query, fromjson("{a: 1}"));
+    }
+    ASSERT_EQ(1U, cache.size());
+
+    RAIIServerParameterControllerForTest disabled("routingTableTargetingCacheMaxEntries", 0);
+    const auto query = fromjson("{a: 1, d: 1}");
+    cache.learn(pattern, shapeOf(query), query, fromjson("{a: 1}"));
+    ASSERT_EQ(1U, cache.size());
+}
+
+}  // namespace
+}  // namespace mongo
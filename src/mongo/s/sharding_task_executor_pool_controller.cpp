@@ -31,6 +31,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <cmath>
+
 #include "mongo/client/replica_set_monitor.h"
 #include "mongo/executor/connection_pool_stats.h"
 #include "mongo/s/is_mongos.h"
@@ -156,6 +158,53 @@ void ShardingTaskExecutorPoolController::_removeGroup(WithLock, const std::strin
     _groupDatas.erase(it);
 }
 
+size_t ShardingTaskExecutorPoolController::_updateDemandForecast(WithLock,
+                                                                 const HostAndPort& host,
+                                                                 size_t demand) {
+    const auto halfLifeMS = gParameters.demandForecastHalfLifeMS.load();
+    if (halfLifeMS <= 0) {
+        _demandForecasts.erase(host);
+        return 0;
+    }
+
+    const auto now = Date_t::now();
+    auto& forecast = _demandForecasts[host];
+    if (forecast.lastUpdate == Date_t()) {
+        forecast.value = demand;
+    } else {
+        const auto elapsedMS = durationCount<Milliseconds>(now - forecast.lastUpdate);
+        const auto decay = std::exp2(-static_cast<double>(elapsedMS) / halfLifeMS);
+        forecast.value = forecast.lastDemand + (forecast.value - forecast.lastDemand) * decay;
+    }
+    forecast.lastDemand = demand;
+    forecast.lastUpdate = now;
+
+    return std::lround(forecast.value);
+}
+
+void ShardingTaskExecutorPoolController::_pruneDemandForecasts(WithLock) {
+    for (auto it = _demandForecasts.begin(); it != _demandForecasts.end();) {
+        if (_groupAndIds.count(it->first)) {
+            ++it;
+        } else {
+            _demandForecasts.erase(it++);
+        }
+    }
+}
+
+void ShardingTaskExecutorPoolController::_prewarm(const std::vector<HostAndPort>& hosts) {
+    // The pool may be in the middle of its construction or destruction, in which case there is
+    // nothing to prewarm.
+    auto pool = _pool->weak_from_this().lock();
+    if (!pool) {
+        return;
+    }
+
+    for (const auto& host : hosts) {
+        pool->prewarm(host, transport::kGlobalSSLMode);
+    }
+}
+
 class ShardingTaskExecutorPoolController::ReplicaSetChangeListener final
     : public ReplicaSetChangeNotifier::Listener {
 public:
@@ -167,10 +216,21 @@ public:
     }
 
     void onConfirmedSet(const State& state) noexcept override {
-        stdx::lock_guard lk(_controller->_mutex);
+        std::vector<HostAndPort> hostsToPrewarm;
+        {
+            stdx::lock_guard lk(_controller->_mutex);
+
+            _controller->_removeGroup(lk, state.connStr.getSetName());
+            _controller->_addGroup(lk, state);
+            _controller->_pruneDemandForecasts(lk);
+
+            if (gParameters.prewarmConnections.load()) {
+                hostsToPrewarm =
+                    _controller->_groupDatas.at(state.connStr.getSetName())->members;
+            }
+        }
 
-        _controller->_removeGroup(lk, state.connStr.getSetName());
-        _controller->_addGroup(lk, state);
+        _controller->_prewarm(hostsToPrewarm);
     }
 
     void onPossibleSet(const State& state) noexcept override {
@@ -181,6 +241,7 @@ public:
         stdx::lock_guard lk(_controller->_mutex);
 
         _controller->_removeGroup(lk, key);
+        _controller->_pruneDemandForecasts(lk);
     }
 
 private:
@@ -224,7 +285,8 @@ auto ShardingTaskExecutorPoolController::updateHost(PoolId id, const HostState&
     const size_t maxConns = gParameters.maxConnections.load();
 
     // Update the target for just the pool first
-    poolData.target = stats.requests + stats.active;
+    const size_t demand = stats.requests + stats.active;
+    poolData.target = std::max(demand, _updateDemandForecast(lk, poolData.host, demand));
 
     if (poolData.target < minConns) {
         poolData.target = minConns;
@@ -287,6 +349,7 @@ void ShardingTaskExecutorPoolController::removeHost(PoolId id) {
         invariant(groupAndId.groupData->poolIds.erase(id));
     } else {
         invariant(_groupAndIds.erase(poolData.host));
+        _demandForecasts.erase(poolData.host);
     }
 
     _poolDatas.erase(it);
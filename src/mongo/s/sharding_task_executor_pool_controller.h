@@ -59,6 +59,16 @@ namespace mongo {
  * When the MatchingStrategy is kMatchBusiestNode, it operates like kMatchPrimaryNode, but any pool
  * can be responsible for increasing the targetConnections of each member of its set.
  *
+ * When a demand forecast half-life is set, the target of each pool is the larger of its current
+ * demand (requests plus active connections) and a moving forecast of that demand, which decays
+ * towards the current demand with the given half-life. The forecast is kept per host for as long
+ * as the host has a pool or belongs to a known replica set, so a pool recreated after it expired
+ * or after a failover starts out at its learned size.
+ *
+ * When prewarming is enabled, a pool is created for every member of a replica set as soon as the
+ * ReplicaSetChangeListener is told about it, so that connections are established before the first
+ * request rather than by it.
+ *
  * Note that, in essence, there are three outside elements that can mutate the state of this class:
  * * The ReplicaSetChangeNotifier can notify the listener which updates the host groups
  * * The ServerParameters can update the Parameters which will used in the next update
@@ -102,6 +112,9 @@ public:
 
         synchronized_value<std::string> matchingStrategyString;
         AtomicWord<MatchingStrategy> matchingStrategy;
+
+        AtomicWord<int> demandForecastHalfLifeMS;
+        AtomicWord<bool> prewarmConnections;
     };
 
     static inline Parameters gParameters;
@@ -148,6 +161,23 @@ private:
     void _addGroup(WithLock, const ReplicaSetChangeNotifier::State& state);
     void _removeGroup(WithLock, const std::string& key);
 
+    /**
+     * Folds the current 'demand' of 'host' into its forecast and returns the number of
+     * connections the forecast calls for. Returns 0 if forecasting is disabled.
+     */
+    size_t _updateDemandForecast(WithLock, const HostAndPort& host, size_t demand);
+
+    /**
+     * Drops the forecasts of the hosts which have neither a pool nor a replica set anymore.
+     */
+    void _pruneDemandForecasts(WithLock);
+
+    /**
+     * Asks the ConnectionPool to create pools for 'hosts'. Must be called without holding _mutex,
+     * since the ConnectionPool calls back into this controller.
+     */
+    void _prewarm(const std::vector<HostAndPort>& hosts);
+
     /**
      * GroupData is a shared state for a set of hosts (a replica set).
      *
@@ -208,6 +238,18 @@ private:
         boost::optional<PoolId> maybeId;
     };
 
+    /**
+     * DemandForecast is an exponentially decaying forecast of the demand on a host.
+     *
+     * The demand reported by the last updateHost is assumed to have held since then, so the
+     * forecast moves towards it by the fraction of the half-life which has elapsed.
+     */
+    struct DemandForecast {
+        double value = 0;
+        size_t lastDemand = 0;
+        Date_t lastUpdate;
+    };
+
     std::shared_ptr<ReplicaSetChangeNotifier::Listener> _listener;
 
     Mutex _mutex = MONGO_MAKE_LATCH("ShardingTaskExecutorPoolController::_mutex");
@@ -223,5 +265,9 @@ private:
     // together a pool and a group based on a HostAndPort. It is hopefully used once, because a
     // PoolId is much cheaper to index than a HostAndPort.
     stdx::unordered_map<HostAndPort, GroupAndId> _groupAndIds;
+
+    // Entries to _demandForecasts are added by updateHost() and removed once their host is no
+    // longer in _groupAndIds.
+    stdx::unordered_map<HostAndPort, DemandForecast> _demandForecasts;
 };
 }  // namespace mongo
@@ -310,6 +310,27 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
     const size_t numWriteOps = _clientRequest.sizeWriteOps();
 
+    // The documents of an unordered insert are all targeted upfront in one pass over the routing
+    // table. Ordered batches are not, because they only send the writes up to the first one which
+    // goes to a different shard, and would retarget the rest of the documents on every round.
+    std::vector<boost::optional<StatusWith<ShardEndpoint>>> insertEndpoints;
+    if (!ordered && _clientRequest.getBatchType() == BatchedCommandRequest::BatchType_Insert) {
+        std::vector<size_t> readyOpIndexes;
+        std::vector<BSONObj> docs;
+        for (size_t i = 0; i < numWriteOps; ++i) {
+            if (_writeOps[i].getWriteState() == WriteOpState_Ready) {
+                readyOpIndexes.push_back(i);
+                docs.push_back(_writeOps[i].getWriteItem().getDocument());
+            }
+        }
+
+        auto endpoints = targeter.targetInserts(_opCtx, docs);
+        insertEndpoints.resize(numWriteOps);
+        for (size_t i = 0; i < readyOpIndexes.size(); ++i) {
+            insertEndpoints[readyOpIndexes[i]].emplace(std::move(endpoints[i]));
+        }
+    }
+
     for (size_t i = 0; i < numWriteOps; ++i) {
         WriteOp& writeOp = _writeOps[i];
 
@@ -327,7 +348,13 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
         Status targetStatus = Status::OK();
         try {
-            writeOp.targetWrites(_opCtx, targeter, &writes);
+            if (!insertEndpoints.empty()) {
+                auto& swEndpoint = *insertEndpoints[i];
+                uassertStatusOK(swEndpoint.getStatus());
+                writeOp.targetWrites(_opCtx, std::move(swEndpoint.getValue()), &writes);
+            } else {
+                writeOp.targetWrites(_opCtx, targeter, &writes);
+            }
         } catch (const DBException& ex) {
             targetStatus = ex.toStatus();
         }
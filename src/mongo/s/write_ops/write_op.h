@@ -123,6 +123,14 @@ public:
                       const NSTargeter& targeter,
                       std::vector<TargetedWrite*>* targetedWrites);
 
+    /**
+     * Same as above, but for an insert whose ShardEndpoint has already been determined by
+     * NSTargeter::targetInserts.
+     */
+    void targetWrites(OperationContext* opCtx,
+                      ShardEndpoint endpoint,
+                      std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Returns the number of child writes that were last targeted.
      */
@@ -161,6 +169,14 @@ public:
     void setOpError(const WriteErrorDetail& error);
 
 private:
+    /**
+     * Creates a TargetedWrite for each of the 'endpoints' on which the operation has not already
+     * succeeded.
+     */
+    void _targetEndpoints(OperationContext* opCtx,
+                          std::vector<ShardEndpoint> endpoints,
+                          std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Updates the op state after new information is received.
      */
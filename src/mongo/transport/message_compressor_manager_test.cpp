@@ -261,6 +261,36 @@ TEST(ZstdMessageCompressor, Fidelity) {
     checkFidelity(testMessage, std::make_unique<ZstdMessageCompressor>());
 }
 
+TEST(ZstdDictMessageCompressor, Fidelity) {
+    auto testMessage = buildMessage();
+    checkFidelity(testMessage, std::make_unique<ZstdDictMessageCompressor>("Hello, world!"));
+}
+
+TEST(ZstdDictMessageCompressor, DictionaryShrinksSmallMessages) {
+    const std::string data = "{find: \"orders\", filter: {customerId: 12345}, limit: 1}";
+    const std::string dictionary = "{find: \"orders\", filter: {customerId: }, limit: 1}";
+    ConstDataRange input(data.data(), data.size());
+
+    ZstdMessageCompressor plain;
+    ZstdDictMessageCompressor withDict(dictionary);
+
+    std::vector<char> plainBuffer(plain.getMaxCompressedSize(data.size()));
+    auto plainSize = plain.compressData(input, DataRange(plainBuffer.data(), plainBuffer.size()));
+    ASSERT_OK(plainSize);
+
+    std::vector<char> dictBuffer(withDict.getMaxCompressedSize(data.size()));
+    auto dictSize = withDict.compressData(input, DataRange(dictBuffer.data(), dictBuffer.size()));
+    ASSERT_OK(dictSize);
+    ASSERT_LT(dictSize.getValue(), plainSize.getValue());
+
+    std::vector<char> roundTrip(data.size());
+    auto decompressed =
+        withDict.decompressData(ConstDataRange(dictBuffer.data(), dictSize.getValue()),
+                                DataRange(roundTrip.data(), roundTrip.size()));
+    ASSERT_OK(decompressed);
+    ASSERT_EQ(std::string(roundTrip.data(), decompressed.getValue()), data);
+}
+
 TEST(SnappyMessageCompressor, Overflow) {
     checkOverflow(std::make_unique<SnappyMessageCompressor>());
 }
@@ -273,6 +303,10 @@ TEST(ZstdMessageCompressor, Overflow) {
     checkOverflow(std::make_unique<ZstdMessageCompressor>());
 }
 
+TEST(ZstdDictMessageCompressor, Overflow) {
+    checkOverflow(std::make_unique<ZstdDictMessageCompressor>("We embrace reality."));
+}
+
 TEST(MessageCompressorManager, SERVER_28008) {
 
     // Create a client and server that will negotiate the same compressors,
@@ -27,17 +27,77 @@
  *    it in the license file.
  */
 
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kNetwork
+
 #include "mongo/platform/basic.h"
 
+#include <fstream>
 #include <memory>
+#include <sstream>
 
 #include <zstd.h>
 
 #include "mongo/base/init.h"
+#include "mongo/logv2/log.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_zstd.h"
+#include "mongo/transport/message_compressor_zstd_gen.h"
+#include "mongo/util/assert_util.h"
 
 namespace mongo {
+namespace {
+
+/*
+ * Compression and decompression contexts owned by the calling thread. Creating a context per
+ * message (as the one-shot ZSTD_compress/ZSTD_decompress do internally) allocates and zeroes
+ * several hundred KB of match tables on every call; reusing them keeps the per-message cost
+ * proportional to the message itself.
+ */
+class ZstdThreadContexts {
+public:
+    ZstdThreadContexts() : _cctx(ZSTD_createCCtx()), _dctx(ZSTD_createDCtx()) {
+        invariant(_cctx);
+        invariant(_dctx);
+    }
+
+    ~ZstdThreadContexts() {
+        ZSTD_freeCCtx(_cctx);
+        ZSTD_freeDCtx(_dctx);
+    }
+
+    static ZstdThreadContexts& get() {
+        static thread_local ZstdThreadContexts contexts;
+        return contexts;
+    }
+
+    ZSTD_CCtx* cctx() {
+        return _cctx;
+    }
+
+    ZSTD_DCtx* dctx() {
+        return _dctx;
+    }
+
+private:
+    ZSTD_CCtx* _cctx;
+    ZSTD_DCtx* _dctx;
+};
+
+std::string loadDictionaryFile(const std::string& path) {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    uassert(ErrorCodes::FileOpenFailed,
+            str::stream() << "Could not open zstd message compressor dictionary " << path,
+            file.is_open());
+
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    uassert(ErrorCodes::FileStreamFailed,
+            str::stream() << "Could not read zstd message compressor dictionary " << path,
+            !file.bad());
+    return contents.str();
+}
+
+}  // namespace
 
 ZstdMessageCompressor::ZstdMessageCompressor() : MessageCompressorBase(MessageCompressor::kZstd) {}
 
@@ -47,11 +107,12 @@ std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
 
 StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input,
                                                             DataRange output) {
-    size_t ret = ZSTD_compress(const_cast<char*>(output.data()),
-                               output.length(),
-                               input.data(),
-                               input.length(),
-                               ZSTD_CLEVEL_DEFAULT);
+    size_t ret = ZSTD_compressCCtx(ZstdThreadContexts::get().cctx(),
+                                   const_cast<char*>(output.data()),
+                                   output.length(),
+                                   input.data(),
+                                   input.length(),
+                                   ZSTD_CLEVEL_DEFAULT);
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -63,8 +124,77 @@ StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input
 
 StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange input,
                                                               DataRange output) {
-    size_t ret = ZSTD_decompress(
-        const_cast<char*>(output.data()), output.length(), input.data(), input.length());
+    size_t ret = ZSTD_decompressDCtx(ZstdThreadContexts::get().dctx(),
+                                     const_cast<char*>(output.data()),
+                                     output.length(),
+                                     input.data(),
+                                     input.length());
+
+    if (ZSTD_isError(ret)) {
+        return Status{ErrorCodes::BadValue,
+                      str::stream() << "Could not decompress message: " << ZSTD_getErrorName(ret)};
+    }
+
+    counterHitDecompress(input.length(), ret);
+    return {ret};
+}
+
+ZstdDictMessageCompressor::ZstdDictMessageCompressor(std::string dictionary)
+    : MessageCompressorBase(MessageCompressor::kZstdDict),
+      _dictionary(std::move(dictionary)),
+      _dictId(ZSTD_getDictID_fromDict(_dictionary.data(), _dictionary.size())),
+      _cdict(ZSTD_createCDict(_dictionary.data(), _dictionary.size(), ZSTD_CLEVEL_DEFAULT)),
+      _ddict(ZSTD_createDDict(_dictionary.data(), _dictionary.size())) {
+    uassert(ErrorCodes::BadValue,
+            "Could not load zstd message compressor dictionary",
+            _cdict && _ddict);
+}
+
+ZstdDictMessageCompressor::~ZstdDictMessageCompressor() {
+    ZSTD_freeCDict(_cdict);
+    ZSTD_freeDDict(_ddict);
+}
+
+std::size_t ZstdDictMessageCompressor::getMaxCompressedSize(size_t inputSize) {
+    return ZSTD_compressBound(inputSize);
+}
+
+StatusWith<std::size_t> ZstdDictMessageCompressor::compressData(ConstDataRange input,
+                                                                DataRange output) {
+    size_t ret = ZSTD_compress_usingCDict(ZstdThreadContexts::get().cctx(),
+                                          const_cast<char*>(output.data()),
+                                          output.length(),
+                                          input.data(),
+                                          input.length(),
+                                          _cdict);
+
+    if (ZSTD_isError(ret)) {
+        return Status{ErrorCodes::BadValue,
+                      str::stream() << "Could not compress input: " << ZSTD_getErrorName(ret)};
+    }
+    counterHitCompress(input.length(), ret);
+    return {ret};
+}
+
+StatusWith<std::size_t> ZstdDictMessageCompressor::decompressData(ConstDataRange input,
+                                                                  DataRange output) {
+    if (_dictId != 0) {
+        auto frameDictId = ZSTD_getDictID_fromFrame(input.data(), input.length());
+        if (frameDictId != _dictId) {
+            return Status{ErrorCodes::BadValue,
+                          str::stream() << "Could not decompress message: compressed with zstd "
+                                           "dictionary "
+                                        << frameDictId << " but dictionary " << _dictId
+                                        << " is loaded"};
+        }
+    }
+
+    size_t ret = ZSTD_decompress_usingDDict(ZstdThreadContexts::get().dctx(),
+                                            const_cast<char*>(output.data()),
+                                            output.length(),
+                                            input.data(),
+                                            input.length(),
+                                            _ddict);
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -82,5 +212,15 @@ MONGO_INITIALIZER_GENERAL(ZstdMessageCompressorInit,
 (InitializerContext* context) {
     auto& compressorRegistry = MessageCompressorRegistry::get();
     compressorRegistry.registerImplementation(std::make_unique<ZstdMessageCompressor>());
+
+    if (!gZstdMessageCompressorDictionaryFile.empty()) {
+        auto compressor = std::make_unique<ZstdDictMessageCompressor>(
+            loadDictionaryFile(gZstdMessageCompressorDictionaryFile));
+        LOGV2(5910500,
+              "Loaded zstd message compressor dictionary",
+              "path"_attr = gZstdMessageCompressorDictionaryFile,
+              "dictionaryId"_attr = compressor->getDictionaryId());
+        compressorRegistry.registerImplementation(std::move(compressor));
+    }
 }
 }  // namespace mongo
@@ -27,8 +27,13 @@
  *    it in the license file.
  */
 
+#include <string>
+
 #include "mongo/transport/message_compressor_base.h"
 
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
 namespace mongo {
 class ZstdMessageCompressor final : public MessageCompressorBase {
 public:
@@ -41,5 +46,39 @@ public:
     StatusWith<std::size_t> decompressData(ConstDataRange input, DataRange output) override;
 };
 
+/*
+ * A zstd compressor that primes every frame with a shared dictionary. Small OP_MSG payloads
+ * (point reads, acks, getMore replies) have too little history for plain zstd to find matches;
+ * a dictionary trained on representative traffic supplies that history up front.
+ *
+ * The dictionary is loaded once and its digested compression/decompression tables are shared by
+ * all threads. If the dictionary carries a zstd dictionary ID, incoming frames whose ID does not
+ * match are rejected rather than decompressed into garbage.
+ */
+class ZstdDictMessageCompressor final : public MessageCompressorBase {
+public:
+    explicit ZstdDictMessageCompressor(std::string dictionary);
+    ~ZstdDictMessageCompressor();
+
+    /*
+     * Returns the zstd dictionary ID of the loaded dictionary, or 0 for a raw-content dictionary.
+     */
+    unsigned getDictionaryId() const {
+        return _dictId;
+    }
+
+    std::size_t getMaxCompressedSize(size_t inputSize) override;
+
+    StatusWith<std::size_t> compressData(ConstDataRange input, DataRange output) override;
+
+    StatusWith<std::size_t> decompressData(ConstDataRange input, DataRange output) override;
+
+private:
+    const std::string _dictionary;
+    const unsigned _dictId;
+    ZSTD_CDict_s* _cdict;
+    ZSTD_DDict_s* _ddict;
+};
+
 
 }  // namespace mongo
@@ -31,12 +31,17 @@
 
 #include "mongo/transport/service_executor_fixed.h"
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #include "mongo/base/error_codes.h"
 #include "mongo/logv2/log.h"
 #include "mongo/transport/service_executor_gen.h"
 #include "mongo/transport/session.h"
 #include "mongo/transport/transport_layer.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/errno_util.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/testing_proctor.h"
 #include "mongo/util/thread_safety_context.h"
@@ -48,6 +53,31 @@ MONGO_FAIL_POINT_DEFINE(hangBeforeSchedulingServiceExecutorFixedTask);
 MONGO_FAIL_POINT_DEFINE(hangAfterServiceExecutorFixedExecutorThreadsStart);
 MONGO_FAIL_POINT_DEFINE(hangBeforeServiceExecutorFixedLastExecutorThreadReturns);
 
+/**
+ * Returns the CPUs the calling thread may run on, or an empty vector if that cannot be determined
+ * on this platform.
+ */
+std::vector<int> getAvailableCores() {
+    std::vector<int> cores;
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        LOGV2_WARNING(5910600,
+                      "Could not read CPU affinity; executor threads will not be pinned",
+                      "error"_attr = errnoWithDescription());
+        return cores;
+    }
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &allowed))
+            cores.push_back(cpu);
+    }
+#else
+    LOGV2_WARNING(5910601, "Pinning executor threads to cores is only supported on Linux");
+#endif
+    return cores;
+}
+
 Status inShutdownStatus() {
     return Status(ErrorCodes::ServiceExecutorInShutdown, "ServiceExecutorFixed is not running");
 }
@@ -185,11 +215,38 @@ ServiceExecutorFixed::ServiceExecutorFixed(ServiceContext* ctx, ThreadPool::Limi
           ThreadPool::Options opt(std::move(limits));
           opt.poolName = "ServiceExecutorFixed";
           opt.onCreateThread = [this](const auto&) {
+              _pinThreadToNextCore();
               _executorContext = std::make_unique<ExecutorThreadContext>(this);
           };
           return opt;
       }()},
-      _threadPool{std::make_shared<ThreadPool>(_options)} {}
+      _threadPool{std::make_shared<ThreadPool>(_options)} {
+    // Capture the process-wide CPU set here rather than in each new thread: pool threads may be
+    // spawned by other pool threads, which would only see the single core they are pinned to.
+    if (fixedServiceExecutorPinThreadsToCores) {
+        _cores = getAvailableCores();
+    }
+}
+
+void ServiceExecutorFixed::_pinThreadToNextCore() {
+    if (_cores.size() < 2)
+        return;
+
+#ifdef __linux__
+    const auto cpu = _cores[_nextCore.fetchAndAdd(1) % _cores.size()];
+    cpu_set_t target;
+    CPU_ZERO(&target);
+    CPU_SET(cpu, &target);
+    if (sched_setaffinity(0, sizeof(target), &target) != 0) {
+        LOGV2_WARNING(5910602,
+                      "Could not pin executor thread to core",
+                      "cpu"_attr = cpu,
+                      "error"_attr = errnoWithDescription());
+        return;
+    }
+    LOGV2_DEBUG(5910603, kDiagnosticLogLevel, "Pinned executor thread to core", "cpu"_attr = cpu);
+#endif
+}
 
 ServiceExecutorFixed::~ServiceExecutorFixed() {
     _finalize();
@@ -31,6 +31,7 @@
 
 #include <boost/optional.hpp>
 #include <memory>
+#include <vector>
 
 #include "mongo/base/status.h"
 #include "mongo/db/service_context.h"
@@ -114,6 +115,12 @@ private:
     /** Requires `_mutex` locked by `lk`. */
     bool _waitForStop(stdx::unique_lock<Mutex>& lk, boost::optional<Milliseconds> timeout);
 
+    /**
+     * Pins the calling executor thread to the next entry of `_cores`, round-robin. A no-op when
+     * pinning is disabled or unsupported.
+     */
+    void _pinThreadToNextCore();
+
     /** `_state` transitions: kNotStarted -> kRunning -> kStopping -> kStopped */
     State _state = State::kNotStarted;
 
@@ -131,6 +138,11 @@ private:
 
     std::list<Waiter> _waiters;
 
+    // The CPUs available to the process when this executor was created, used to pin executor
+    // threads when `fixedServiceExecutorPinThreadsToCores` is set. Empty when pinning is off.
+    std::vector<int> _cores;
+    AtomicWord<size_t> _nextCore{0};
+
     static thread_local std::unique_ptr<ExecutorThreadContext> _executorContext;
 };
 
@@ -37,6 +37,7 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/service_context_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/transport/mock_session.h"
 #include "mongo/transport/service_executor_fixed.h"
@@ -55,6 +56,10 @@
 
 #include <asio.hpp>
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 namespace mongo::transport {
 namespace {
 
@@ -203,6 +208,35 @@ TEST_F(ServiceExecutorFixedTest, BasicTaskRuns) {
     barrier.countDownAndWait();
 }
 
+#ifdef __linux__
+TEST_F(ServiceExecutorFixedTest, ThreadsArePinnedToCoresWhenEnabled) {
+    cpu_set_t processCores;
+    CPU_ZERO(&processCores);
+    ASSERT_EQ(sched_getaffinity(0, sizeof(processCores), &processCores), 0);
+    if (CPU_COUNT(&processCores) < 2) {
+        return;  // Nothing to pin to on a single-core host.
+    }
+
+    RAIIServerParameterControllerForTest pinThreads{"fixedServiceExecutorPinThreadsToCores", true};
+    unittest::Barrier barrier(2);
+    Handle handle;
+    handle.start();
+
+    int pinnedCores = 0;
+    ASSERT_OK(handle->scheduleTask(
+        [&] {
+            cpu_set_t threadCores;
+            CPU_ZERO(&threadCores);
+            if (sched_getaffinity(0, sizeof(threadCores), &threadCores) == 0)
+                pinnedCores = CPU_COUNT(&threadCores);
+            barrier.countDownAndWait();
+        },
+        {}));
+    barrier.countDownAndWait();
+    ASSERT_EQ(pinnedCores, 1);
+}
+#endif
+
 TEST_F(ServiceExecutorFixedTest, RecursiveTask) {
     unittest::Barrier barrier(2);
     Handle handle;
@@ -42,6 +42,7 @@
 #include "mongo/transport/service_executor.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/debug_util.h"
+#include "mongo/util/numa_affinity.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/thread_safety_context.h"
 
@@ -61,6 +62,9 @@ namespace {
 void* runFunc(void* ctx) {
     auto taskPtr =
         std::unique_ptr<unique_function<void()>>(static_cast<unique_function<void()>*>(ctx));
+    // The worker serves a single connection for its lifetime, so binding the worker also keeps
+    // the connection on one NUMA node.
+    numa::bindCurrentThreadToNode();
     (*taskPtr)();
 
     return nullptr;
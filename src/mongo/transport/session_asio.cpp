@@ -82,6 +82,29 @@ private:
     TimeoutType _timeout;
 };
 
+constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+
+/**
+ * Checks the message length read from a message header.
+ */
+Status checkMessageLength(size_t msgLen) {
+    if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
+        StringBuilder sb;
+        sb << "recv(): message msgLen " << msgLen << " is invalid. "
+           << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
+        const auto str = sb.str();
+        LOGV2(4615638,
+              "recv(): message msgLen {msgLen} is invalid. Min: {min} Max: {max}",
+              "recv(): message mstLen is invalid.",
+              "msgLen"_attr = msgLen,
+              "min"_attr = kHeaderSize,
+              "max"_attr = MaxMessageSizeBytes);
+
+        return Status(ErrorCodes::ProtocolError, str);
+    }
+    return Status::OK();
+}
+
 }  // namespace
 
 
@@ -165,6 +188,9 @@ Future<Message> TransportLayerASIO::ASIOSession::asyncSourceMessage(
 
 Status TransportLayerASIO::ASIOSession::waitForData() noexcept try {
     ensureSync();
+    if (bytesBuffered() > 0) {
+        return Status::OK();
+    }
     asio::error_code ec;
     getSocket().wait(asio::ip::tcp::socket::wait_read, ec);
     return errorCodeToStatus(ec);
@@ -174,6 +200,9 @@ Status TransportLayerASIO::ASIOSession::waitForData() noexcept try {
 
 Future<void> TransportLayerASIO::ASIOSession::asyncWaitForData() noexcept try {
     ensureAsync();
+    if (bytesBuffered() > 0) {
+        return Future<void>::makeReady();
+    }
     return getSocket().async_wait(asio::ip::tcp::socket::wait_read, UseFuture{});
 } catch (const DBException& ex) {
     return ex.toStatus();
@@ -366,7 +395,9 @@ auto TransportLayerASIO::ASIOSession::getSocket() -> GenericSocket& {
 }
 
 Future<Message> TransportLayerASIO::ASIOSession::sourceMessageImpl(const BatonHandle& baton) {
-    static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+    if (canUseReadBuffer()) {
+        return sourceMessageBuffered(baton);
+    }
 
     auto headerBuffer = SharedBuffer::allocate(kHeaderSize);
     auto ptr = headerBuffer.get();
@@ -377,19 +408,8 @@ Future<Message> TransportLayerASIO::ASIOSession::sourceMessageImpl(const BatonHa
             }
 
             const auto msgLen = size_t(MSGHEADER::View(headerBuffer.get()).getMessageLength());
-            if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
-                StringBuilder sb;
-                sb << "recv(): message msgLen " << msgLen << " is invalid. "
-                   << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
-                const auto str = sb.str();
-                LOGV2(4615638,
-                      "recv(): message msgLen {msgLen} is invalid. Min: {min} Max: {max}",
-                      "recv(): message mstLen is invalid.",
-                      "msgLen"_attr = msgLen,
-                      "min"_attr = kHeaderSize,
-                      "max"_attr = MaxMessageSizeBytes);
-
-                return Future<Message>::makeReady(Status(ErrorCodes::ProtocolError, str));
+            if (auto status = checkMessageLength(msgLen); !status.isOK()) {
+                return Future<Message>::makeReady(std::move(status));
             }
 
             if (msgLen == kHeaderSize) {
@@ -400,7 +420,7 @@ Future<Message> TransportLayerASIO::ASIOSession::sourceMessageImpl(const BatonHa
                 return Future<Message>::makeReady(Message(std::move(headerBuffer)));
             }
 
-            auto buffer = SharedBuffer::allocate(msgLen);
+            auto buffer = allocateMessageBuffer(msgLen);
             memcpy(buffer.get(), headerBuffer.get(), kHeaderSize);
 
             MsgData::View msgView(buffer.get());
@@ -414,6 +434,138 @@ Future<Message> TransportLayerASIO::ASIOSession::sourceMessageImpl(const BatonHa
         });
 }
 
+bool TransportLayerASIO::ASIOSession::canUseReadBuffer() {
+    // Bytes already buffered must be consumed before reading from the socket again.
+    if (bytesBuffered() > 0) {
+        return true;
+    }
+#ifdef MONGO_CONFIG_SSL
+    // The TLS stream reads whole records into a buffer of its own, and the first read of an
+    // ingress session goes through read() to detect a TLS handshake.
+    if (_sslSocket || !_ranHandshake) {
+        return false;
+    }
+#endif
+    // Short reads are injected in opportunisticRead().
+    return !MONGO_unlikely(transportLayerASIOshortOpportunisticReadWrite.shouldFail());
+}
+
+Future<Message> TransportLayerASIO::ASIOSession::sourceMessageBuffered(const BatonHandle& baton) {
+    return fillReadBuffer(kHeaderSize, baton).then([this, baton]() -> Future<Message> {
+        const char* header = _readBuffer.get() + _readBufferBegin;
+        if (checkForHTTPRequest(asio::buffer(header, kHeaderSize))) {
+            return sendHTTPResponse(baton);
+        }
+
+        const auto msgLen = size_t(MSGHEADER::ConstView(header).getMessageLength());
+        if (auto status = checkMessageLength(msgLen); !status.isOK()) {
+            return Future<Message>::makeReady(std::move(status));
+        }
+
+        auto onMessageRead = [this, msgLen](SharedBuffer buffer) {
+            if (_isIngressSession) {
+                networkCounter.hitPhysicalIn(msgLen);
+            }
+            return Message(std::move(buffer));
+        };
+
+        if (msgLen > kReadBufferSize) {
+            // Move what is buffered into the message and read the rest of it directly.
+            auto buffer = allocateMessageBuffer(msgLen);
+            const auto buffered = bytesBuffered();
+            memcpy(buffer.get(), header, buffered);
+            _readBufferBegin = _readBufferEnd = 0;
+
+            auto remainder = asio::buffer(buffer.get() + buffered, msgLen - buffered);
+            return read(remainder, baton).then(
+                [buffer = std::move(buffer), onMessageRead]() mutable {
+                    return onMessageRead(std::move(buffer));
+                });
+        }
+
+        return fillReadBuffer(msgLen, baton).then([this, msgLen, onMessageRead] {
+            auto buffer = allocateMessageBuffer(msgLen);
+            memcpy(buffer.get(), _readBuffer.get() + _readBufferBegin, msgLen);
+            _readBufferBegin += msgLen;
+            return onMessageRead(std::move(buffer));
+        });
+    });
+}
+
+SharedBuffer TransportLayerASIO::ASIOSession::allocateMessageBuffer(size_t size) {
+    // A buffer that is not shared has no outstanding Message or BSONObj views into it, so it can
+    // be handed out again.
+    if (_recycledMessageBuffer && !_recycledMessageBuffer.isShared() &&
+        _recycledMessageBuffer.capacity() >= size) {
+        if (_isIngressSession) {
+            networkCounter.incrementMessageBuffersReused();
+        }
+        return _recycledMessageBuffer;
+    }
+
+    if (_isIngressSession) {
+        networkCounter.incrementMessageBuffersAllocated();
+    }
+    auto buffer = SharedBuffer::allocate(size);
+    if (size <= kMaxRecycledMessageBufferSize) {
+        _recycledMessageBuffer = buffer;
+    }
+    return buffer;
+}
+
+Future<void> TransportLayerASIO::ASIOSession::fillReadBuffer(size_t minBytes,
+                                                             const BatonHandle& baton) {
+    invariant(minBytes <= kReadBufferSize);
+    if (!_readBuffer) {
+        _readBuffer = std::make_unique<char[]>(kReadBufferSize);
+    }
+
+    if (bytesBuffered() == 0) {
+        _readBufferBegin = _readBufferEnd = 0;
+    } else if (kReadBufferSize - _readBufferBegin < minBytes) {
+        // Make room for the rest of the message after the bytes already buffered.
+        memmove(_readBuffer.get(), _readBuffer.get() + _readBufferBegin, bytesBuffered());
+        _readBufferEnd -= _readBufferBegin;
+        _readBufferBegin = 0;
+    }
+
+    while (bytesBuffered() < minBytes) {
+        std::error_code ec;
+        size_t size;
+        auto freeSpace =
+            asio::buffer(_readBuffer.get() + _readBufferEnd, kReadBufferSize - _readBufferEnd);
+        do {
+            size = getSocket().read_some(freeSpace, ec);
+        } while (ec == asio::error::interrupted);  // retry syscall EINTR
+        _readBufferEnd += size;
+
+        if (((ec == asio::error::would_block) || (ec == asio::error::try_again)) &&
+            (_blockingMode == Async)) {
+            if (auto networkingBaton = baton ? baton->networking() : nullptr;
+                networkingBaton && networkingBaton->canWait()) {
+                return networkingBaton->addSession(*this, NetworkingBaton::Type::In)
+                    .onError([](Status error) {
+                        if (ErrorCodes::isShutdownError(error)) {
+                            // If the baton has detached, it will cancel its polling. Keep reading
+                            // without it, as opportunisticRead() does.
+                            return Status::OK();
+                        }
+
+                        return error;
+                    })
+                    .then([this, minBytes, baton] { return fillReadBuffer(minBytes, baton); });
+            }
+
+            return getSocket()
+                .async_wait(asio::ip::tcp::socket::wait_read, UseFuture{})
+                .then([this, minBytes, baton] { return fillReadBuffer(minBytes, baton); });
+        } else if (ec) {
+            return futurize(ec);
+        }
+    }
+    return Future<void>::makeReady();
+}
+
 template <typename MutableBufferSequence>
 Future<void> TransportLayerASIO::ASIOSession::read(const MutableBufferSequence& buffers,
                                                    const BatonHandle& baton) {
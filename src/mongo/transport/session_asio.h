@@ -165,6 +165,34 @@ private:
 
     Future<Message> sourceMessageImpl(const BatonHandle& baton = nullptr);
 
+    /**
+     * Returns true if the next message should be sourced through '_readBuffer'.
+     */
+    bool canUseReadBuffer();
+
+    /**
+     * Sources a message through '_readBuffer'. Reading more than was asked for lets a small
+     * message usually arrive with its header in a single read. Bytes read past the end of the
+     * message stay buffered for the next one.
+     */
+    Future<Message> sourceMessageBuffered(const BatonHandle& baton);
+
+    /**
+     * Reads from the socket into '_readBuffer' until at least 'minBytes' are buffered.
+     */
+    Future<void> fillReadBuffer(size_t minBytes, const BatonHandle& baton);
+
+    size_t bytesBuffered() const {
+        return _readBufferEnd - _readBufferBegin;
+    }
+
+    /**
+     * Returns a buffer of at least 'size' bytes for an incoming message. The buffer of the
+     * previous message is reused when nothing references it any longer, which is the common
+     * case once its command has completed.
+     */
+    SharedBuffer allocateMessageBuffer(size_t size);
+
     template <typename MutableBufferSequence>
     Future<void> read(const MutableBufferSequence& buffers, const BatonHandle& baton = nullptr);
 
@@ -252,6 +280,19 @@ private:
     std::shared_ptr<const SSLConnectionContext> _sslContext;
 #endif
 
+    // Receive buffer for sessions not using TLS, allocated on the first buffered read. Messages
+    // larger than the buffer are read directly into their own buffer past the first read.
+    static constexpr size_t kReadBufferSize = 4 * 1024;
+    std::unique_ptr<char[]> _readBuffer;
+    size_t _readBufferBegin = 0;
+    size_t _readBufferEnd = 0;
+
+    // The buffer of the most recently sourced message, kept for reuse by the next one. Only
+    // messages up to 'kMaxRecycledMessageBufferSize' are kept so that one large request does
+    // not pin memory for the rest of the session.
+    static constexpr size_t kMaxRecycledMessageBufferSize = 64 * 1024;
+    SharedBuffer _recycledMessageBuffer;
+
     TransportLayerASIO* const _tl;
     bool _isIngressSession;
 };
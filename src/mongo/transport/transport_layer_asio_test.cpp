@@ -285,6 +285,25 @@ public:
         ASSERT_FALSE(ec);
     }
 
+    /**
+     * Sends 'count' pings, with increasing values starting from 1, in a single write.
+     */
+    void sendPipelinedMessages(int count) {
+        std::string pipelined;
+        for (int i = 1; i <= count; ++i) {
+            OpMsgBuilder builder;
+            builder.setBody(BSON("ping" << i));
+            Message msg = builder.finish();
+            msg.header().setResponseToMsgId(0);
+            msg.header().setId(i);
+            pipelined.append(msg.buf(), msg.size());
+        }
+
+        std::error_code ec;
+        asio::write(_sock, asio::buffer(pipelined), ec);
+        ASSERT_FALSE(ec);
+    }
+
 private:
     asio::io_context _ctx;
     asio::ip::tcp::socket _sock;
@@ -382,5 +401,78 @@ TEST(TransportLayerASIO, SwitchTimeoutModes) {
     tla->shutdown();
 }
 
+/* check that messages arriving together in one read are all sourced, in order */
+class PipelinedSEP : public TimeoutSEP {
+public:
+    static constexpr int kNumMessages = 3;
+
+    void startSession(transport::SessionHandle session) override {
+        startWorkerThread([this, session = std::move(session)]() mutable {
+            for (int i = 1; i <= kNumMessages; ++i) {
+                auto swMessage = session->sourceMessage();
+                ASSERT_OK(swMessage.getStatus());
+                ASSERT_EQ(OpMsg::parse(swMessage.getValue()).body["ping"].numberInt(), i);
+            }
+
+            session.reset();
+            notifyComplete();
+        });
+    }
+};
+
+TEST(TransportLayerASIO, SourcePipelinedMessages) {
+    PipelinedSEP sep;
+    auto tla = makeAndStartTL(&sep);
+
+    TimeoutConnector connector(tla->listenerPort(), false);
+    connector.sendPipelinedMessages(PipelinedSEP::kNumMessages);
+
+    ASSERT_TRUE(sep.waitForTimeout());
+    tla->shutdown();
+}
+
+class MessageBufferReuseSEP : public TimeoutSEP {
+public:
+    static constexpr int kNumMessages = 3;
+
+    void startSession(transport::SessionHandle session) override {
+        startWorkerThread([this, session = std::move(session)]() mutable {
+            auto sourcePing = [&](int expected) {
+                auto swMessage = session->sourceMessage();
+                ASSERT_OK(swMessage.getStatus());
+                ASSERT_EQ(OpMsg::parse(swMessage.getValue()).body["ping"].numberInt(), expected);
+                return std::move(swMessage.getValue());
+            };
+
+            // The first message is still referenced while the second one is sourced, so the
+            // second must get a buffer of its own.
+            auto first = sourcePing(1);
+            auto second = sourcePing(2);
+            ASSERT_NE(first.buf(), second.buf());
+
+            // Once released, the buffer of the previous message is handed out again.
+            const char* secondBuf = second.buf();
+            first.reset();
+            second.reset();
+            auto third = sourcePing(3);
+            ASSERT_EQ(third.buf(), secondBuf);
+
+            session.reset();
+            notifyComplete();
+        });
+    }
+};
+
+TEST(TransportLayerASIO, SourcedMessagesReuseReleasedBuffers) {
+    MessageBufferReuseSEP sep;
+    auto tla = makeAndStartTL(&sep);
+
+    TimeoutConnector connector(tla->listenerPort(), false);
+    connector.sendPipelinedMessages(MessageBufferReuseSEP::kNumMessages);
+
+    ASSERT_TRUE(sep.waitForTimeout());
+    tla->shutdown();
+}
+
 }  // namespace
 }  // namespace mongo
@@ -48,6 +48,7 @@
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/concurrency/thread_name.h"
 #include "mongo/util/hierarchical_acquisition.h"
+#include "mongo/util/numa_affinity.h"
 
 namespace mongo {
 
@@ -213,6 +214,9 @@ private:
     // Count of idle threads.
     size_t _numIdleThreads = 0;
 
+    // Count of idle threads blocked waiting on _workAvailable.
+    size_t _numWaitingThreads = 0;
+
     // Id counter for assigning thread names
     size_t _nextThreadId = 0;
 
@@ -363,7 +367,16 @@ void ThreadPool::Impl::schedule(Task task) {
     if (_numIdleThreads <= _pendingTasks.size()) {
         _lastFullUtilizationDate = Date_t::now();
     }
-    _workAvailable.notify_one();
+
+    // Only signal when a worker is actually blocked on _workAvailable; a worker that is running a
+    // task or is on its way to wait will find the new task when it next inspects the queue. The
+    // signal is sent after releasing the mutex so the woken worker does not immediately block on
+    // it again.
+    const bool shouldNotify = _numWaitingThreads > 0;
+    lk.unlock();
+    if (shouldNotify) {
+        _workAvailable.notify_one();
+    }
 }
 
 void ThreadPool::Impl::waitForIdle() {
@@ -392,6 +405,7 @@ ThreadPool::Stats ThreadPool::Impl::getStats() const {
 
 void ThreadPool::Impl::_workerThreadBody(const std::string& threadName) noexcept {
     setThreadName(threadName);
+    numa::bindCurrentThreadToNode();
     if (_options.onCreateThread)
         _options.onCreateThread(threadName);
     LOGV2_DEBUG(23104,
@@ -465,11 +479,13 @@ void ThreadPool::Impl::_consumeTasks() {
 
         auto wake = [&] { return _state != running || !_pendingTasks.empty(); };
         MONGO_IDLE_THREAD_BLOCK;
+        ++_numWaitingThreads;
         if (waitDeadline) {
             _workAvailable.wait_until(lk, waitDeadline->toSystemTimePoint(), wake);
         } else {
             _workAvailable.wait(lk, wake);
         }
+        --_numWaitingThreads;
     }
 
     // We still hold the lock, but this thread is retiring. If the whole pool is shutting down, this
@@ -0,0 +1,102 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/thread_pool.h"
+
+namespace mongo {
+namespace {
+
+constexpr int kTasksPerIteration = 1000;
+
+ThreadPool::Options makeOptions(size_t numThreads) {
+    ThreadPool::Options options;
+    options.poolName = "ThreadPoolBM";
+    options.minThreads = numThreads;
+    options.maxThreads = numThreads;
+    return options;
+}
+
+/**
+ * One submitter schedules a burst of trivial tasks and waits for the pool to drain them. This
+ * mostly measures the cost of the shared queue and of waking workers.
+ */
+void BM_scheduleBurst(benchmark::State& state) {
+    ThreadPool pool(makeOptions(state.range(0)));
+    pool.startup();
+
+    AtomicWord<int64_t> tasksRun{0};
+    for (auto _ : state) {
+        for (int i = 0; i < kTasksPerIteration; ++i) {
+            pool.schedule([&](Status) { tasksRun.fetchAndAddRelaxed(1); });
+        }
+        pool.waitForIdle();
+    }
+
+    pool.shutdown();
+    pool.join();
+    state.SetItemsProcessed(tasksRun.load());
+}
+
+/**
+ * Several submitters share one pool, as executors backed by the pool do when many operations
+ * schedule continuations at once.
+ */
+void BM_scheduleConcurrentSubmitters(benchmark::State& state) {
+    static ThreadPool* pool;
+    static AtomicWord<int64_t> tasksRun;
+    if (state.thread_index == 0) {
+        tasksRun.store(0);
+        pool = new ThreadPool(makeOptions(state.range(0)));
+        pool->startup();
+    }
+
+    for (auto _ : state) {
+        for (int i = 0; i < kTasksPerIteration; ++i) {
+            pool->schedule([](Status) { tasksRun.fetchAndAddRelaxed(1); });
+        }
+    }
+
+    if (state.thread_index == 0) {
+        pool->shutdown();
+        pool->join();
+        delete pool;
+        state.SetItemsProcessed(tasksRun.load());
+    }
+}
+
+BENCHMARK(BM_scheduleBurst)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
+BENCHMARK(BM_scheduleConcurrentSubmitters)->Arg(4)->Arg(16)->ThreadRange(1, 16)->UseRealTime();
+
+}  // namespace
+}  // namespace mongo
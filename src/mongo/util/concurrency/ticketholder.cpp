@@ -27,110 +27,70 @@
  *    it in the license file.
  */
 
-#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
-
 #include "mongo/platform/basic.h"
 
 #include "mongo/util/concurrency/ticketholder.h"
 
-#include <iostream>
+#include <algorithm>
 
-#include "mongo/logv2/log.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
-
-#if defined(__linux__)
 namespace {
 
-/**
- * Accepts an errno code, prints its error message, and exits.
- */
-void failWithErrno(int err) {
-    LOGV2_FATAL(28604,
-                "error in Ticketholder: {errnoWithDescription_err}",
-                "errnoWithDescription_err"_attr = errnoWithDescription(err));
-}
+// Upper bounds, exclusive, of all the queue time buckets but the last one.
+constexpr std::array<Microseconds, 5> kQueueTimeBucketBounds = {
+    Microseconds(100), Milliseconds(1), Milliseconds(10), Milliseconds(100), Seconds(1)};
+constexpr std::array<StringData, 6> kQueueTimeBucketNames = {"lessThan100us"_sd,
+                                                             "lessThan1ms"_sd,
+                                                             "lessThan10ms"_sd,
+                                                             "lessThan100ms"_sd,
+                                                             "lessThan1s"_sd,
+                                                             "atLeast1s"_sd};
 
-/*
- * Checks the return value from a Linux semaphore function call, and fails with the set errno if the
- * call was unsucessful.
- */
-void check(int ret) {
-    if (ret == 0)
-        return;
-    failWithErrno(errno);
-}
+constexpr std::array<StringData, TicketHolder::kNumPriorities> kLaneNames = {
+    "low"_sd, "normal"_sd, "high"_sd};
 
-/**
- * Takes a Date_t deadline and sets the appropriate values in a timespec structure.
- */
-void tsFromDate(const Date_t& deadline, struct timespec& ts) {
-    ts.tv_sec = deadline.toTimeT();
-    ts.tv_nsec = (deadline.toMillisSinceEpoch() % 1000) * 1'000'000;
-}
 }  // namespace
 
-TicketHolder::TicketHolder(int num) : _outof(num) {
-    check(sem_init(&_sem, 0, num));
+void TicketHolder::LaneStats::recordQueueTime(Microseconds queueTime) {
+    totalQueueTimeMicros.increment(durationCount<Microseconds>(queueTime));
+    auto bucket = std::upper_bound(
+                      kQueueTimeBucketBounds.begin(), kQueueTimeBucketBounds.end(), queueTime) -
+        kQueueTimeBucketBounds.begin();
+    queueTimeBuckets[bucket].increment();
 }
 
-TicketHolder::~TicketHolder() {
-    check(sem_destroy(&_sem));
-}
+TicketHolder::TicketHolder(int num) : _available(num), _outof(num) {}
+
+TicketHolder::~TicketHolder() = default;
 
 bool TicketHolder::tryAcquire() {
-    while (0 != sem_trywait(&_sem)) {
-        if (errno == EAGAIN)
-            return false;
-        if (errno != EINTR)
-            failWithErrno(errno);
-    }
-    return true;
+    return _tryAcquireWithoutQueueing();
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    waitForTicketUntil(opCtx, Date_t::max());
+void TicketHolder::waitForTicket(OperationContext* opCtx, Priority priority) {
+    invariant(waitForTicketUntil(opCtx, Date_t::max(), priority));
 }
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    // Attempt to get a ticket without waiting in order to avoid expensive time calculations.
-    if (sem_trywait(&_sem) == 0) {
+bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until, Priority priority) {
+    if (_tryAcquireWithoutQueueing()) {
         return true;
     }
-
-    const Milliseconds intervalMs(500);
-    struct timespec ts;
-
-    // To support interrupting ticket acquisition while still benefiting from semaphores, we do a
-    // timed wait on an interval to periodically check for interrupts.
-    // The wait period interval is the smaller of the default interval and the provided
-    // deadline.
-    Date_t deadline = std::min(until, Date_t::now() + intervalMs);
-    tsFromDate(deadline, ts);
-
-    while (0 != sem_timedwait(&_sem, &ts)) {
-        if (errno == ETIMEDOUT) {
-            // If we reached the deadline without being interrupted, we have completely timed out.
-            if (deadline == until)
-                return false;
-
-            deadline = std::min(until, Date_t::now() + intervalMs);
-            tsFromDate(deadline, ts);
-        } else if (errno != EINTR) {
-            failWithErrno(errno);
-        }
-
-        // To correctly handle errors from sem_timedwait, we should check for interrupts last.
-        // It is possible to unset 'errno' after a call to checkForInterrupt().
-        if (opCtx)
-            opCtx->checkForInterrupt();
-    }
-    return true;
+    return _waitInQueue(opCtx, until, priority);
 }
 
 void TicketHolder::release() {
-    check(sem_post(&_sem));
+    _available.fetchAndAdd(1);
+
+    // A request may have queued after it last looked at '_available'. Both counters are
+    // sequentially consistent, so either it sees the ticket just released or we see it queued.
+    if (_numWaiters.load() > 0) {
+        stdx::lock_guard<Latch> lk(_queueMutex);
+        _grantToWaiters(lk);
+    }
 }
 
 Status TicketHolder::resize(int newSize) {
@@ -140,18 +100,14 @@ Status TicketHolder::resize(int newSize) {
         return Status(ErrorCodes::BadValue,
                       str::stream() << "Minimum value for semaphore is 5; given " << newSize);
 
-    if (newSize > SEM_VALUE_MAX)
-        return Status(ErrorCodes::BadValue,
-                      str::stream() << "Maximum value for semaphore is " << SEM_VALUE_MAX
-                                    << "; given " << newSize);
-
     while (_outof.load() < newSize) {
         release();
         _outof.fetchAndAdd(1);
     }
 
+    // Retiring a ticket waits for it like any other request, but ahead of user operations.
     while (_outof.load() > newSize) {
-        waitForTicket();
+        waitForTicket(nullptr, Priority::kHigh);
         _outof.subtractAndFetch(1);
     }
 
@@ -160,9 +116,7 @@ Status TicketHolder::resize(int newSize) {
 }
 
 int TicketHolder::available() const {
-    int val = 0;
-    check(sem_getvalue(&_sem, &val));
-    return val;
+    return _available.load();
 }
 
 int TicketHolder::used() const {
@@ -173,90 +127,120 @@ int TicketHolder::outof() const {
     return _outof.load();
 }
 
-#else
-
-TicketHolder::TicketHolder(int num) : _outof(num), _num(num) {}
-
-TicketHolder::~TicketHolder() = default;
-
-bool TicketHolder::tryAcquire() {
-    stdx::lock_guard<Latch> lk(_mutex);
-    return _tryAcquire();
-}
-
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (opCtx) {
-        opCtx->waitForConditionOrInterrupt(_newTicket, lk, [this] { return _tryAcquire(); });
-    } else {
-        _newTicket.wait(lk, [this] { return _tryAcquire(); });
+int TicketHolder::queued(Priority priority) const {
+    return _laneStats[static_cast<size_t>(priority)].queued.load();
+}
+
+void TicketHolder::appendStats(BSONObjBuilder& b) const {
+    BSONObjBuilder lanesBob(b.subobjStart("lanes"));
+    for (size_t lane = 0; lane < kNumPriorities; ++lane) {
+        const auto& stats = _laneStats[lane];
+        BSONObjBuilder laneBob(lanesBob.subobjStart(kLaneNames[lane]));
+        laneBob.append("queueLength", stats.queued.load());
+        laneBob.append("totalQueued", static_cast<long long>(stats.totalQueued.get()));
+        laneBob.append("totalTimedOutOrInterrupted",
+                       static_cast<long long>(stats.totalTimedOutOrInterrupted.get()));
+        laneBob.append("totalQueueTimeMicros",
+                       static_cast<long long>(stats.totalQueueTimeMicros.get()));
+        {
+            BSONObjBuilder histogramBob(laneBob.subobjStart("queueTimeMicros"));
+            for (size_t i = 0; i < kQueueTimeBucketNames.size(); ++i) {
+                histogramBob.append(kQueueTimeBucketNames[i],
+                                    static_cast<long long>(stats.queueTimeBuckets[i].get()));
+            }
+        }
     }
 }
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (opCtx) {
-        return opCtx->waitForConditionOrInterruptUntil(
-            _newTicket, lk, until, [this] { return _tryAcquire(); });
-    } else {
-        return _newTicket.wait_until(
-            lk, until.toSystemTimePoint(), [this] { return _tryAcquire(); });
+bool TicketHolder::_tryAcquireWithoutQueueing() {
+    // Do not take a ticket ahead of requests that are already queued for one.
+    if (_numWaiters.load() > 0) {
+        return false;
     }
-}
 
-void TicketHolder::release() {
-    {
-        stdx::lock_guard<Latch> lk(_mutex);
-        _num++;
+    auto available = _available.load();
+    while (available > 0) {
+        if (_available.compareAndSwap(&available, available - 1)) {
+            return true;
+        }
     }
-    _newTicket.notify_one();
+    return false;
 }
 
-Status TicketHolder::resize(int newSize) {
-    stdx::lock_guard<Latch> lk(_mutex);
+bool TicketHolder::_waitInQueue(OperationContext* opCtx, Date_t until, Priority priority) {
+    auto& stats = _laneStats[static_cast<size_t>(priority)];
+    auto& queue = _queues[static_cast<size_t>(priority)];
+    Interruptible* interruptible = opCtx ? opCtx : Interruptible::notInterruptible();
 
-    int used = _outof.load() - _num;
-    if (used > newSize) {
-        std::stringstream ss;
-        ss << "can't resize since we're using (" << used << ") "
-           << "more than newSize(" << newSize << ")";
+    Waiter waiter;
+    Timer queueTimer;
+    stdx::unique_lock<Latch> lk(_queueMutex);
 
-        std::string errmsg = ss.str();
-        LOGV2(23120, "{errmsg}", "errmsg"_attr = errmsg);
-        return Status(ErrorCodes::BadValue, errmsg);
-    }
-
-    _outof.store(newSize);
-    _num = _outof.load() - used;
+    queue.push_back(&waiter);
+    _numWaiters.fetchAndAdd(1);
+    stats.queued.fetchAndAdd(1);
+    stats.totalQueued.increment();
 
-    // Potentially wasteful, but easier to see is correct
-    _newTicket.notify_all();
-    return Status::OK();
-}
+    // A ticket may have been released before we were queued.
+    _grantToWaiters(lk);
 
-int TicketHolder::available() const {
-    return _num;
-}
+    auto leaveQueue = [&] {
+        if (!lk.owns_lock()) {
+            lk.lock();
+        }
+        if (waiter.granted) {
+            return true;
+        }
+        queue.erase(std::find(queue.begin(), queue.end(), &waiter));
+        _numWaiters.subtractAndFetch(1);
+        stats.queued.subtractAndFetch(1);
+        stats.totalTimedOutOrInterrupted.increment();
+        return false;
+    };
+
+    bool granted;
+    try {
+        granted = interruptible->waitForConditionOrInterruptUntil(
+            waiter.cv, lk, until, [&] { return waiter.granted; });
+    } catch (const DBException&) {
+        // The ticket may have been handed to us just as we were interrupted. Give it to the next
+        // request in line rather than leaking it.
+        if (leaveQueue()) {
+            _available.fetchAndAdd(1);
+            _grantToWaiters(lk);
+        }
+        throw;
+    }
 
-int TicketHolder::used() const {
-    return outof() - _num;
+    if (!granted) {
+        granted = leaveQueue();
+    }
+    if (granted) {
+        stats.recordQueueTime(Microseconds(queueTimer.micros()));
+    }
+    return granted;
 }
 
-int TicketHolder::outof() const {
-    return _outof.load();
-}
+void TicketHolder::_grantToWaiters(WithLock) {
+    auto available = _available.load();
+    while (_numWaiters.load() > 0 && available > 0) {
+        if (!_available.compareAndSwap(&available, available - 1)) {
+            continue;
+        }
+        available--;
 
-bool TicketHolder::_tryAcquire() {
-    if (_num <= 0) {
-        if (_num < 0) {
-            std::cerr << "DISASTER! in TicketHolder" << std::endl;
+        // Lanes are ordered by increasing priority.
+        size_t lane = kNumPriorities;
+        while (_queues[--lane].empty()) {
         }
-        return false;
+
+        auto waiter = _queues[lane].front();
+        _queues[lane].pop_front();
+        _numWaiters.subtractAndFetch(1);
+        _laneStats[lane].queued.subtractAndFetch(1);
+
+        waiter->granted = true;
+        waiter->cv.notify_one();
     }
-    _num--;
-    return true;
 }
-#endif
 }  // namespace mongo
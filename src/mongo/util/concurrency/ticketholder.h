@@ -28,24 +28,48 @@
  */
 #pragma once
 
-#if defined(__linux__)
-#include <semaphore.h>
-#endif
+#include <array>
+#include <deque>
 
+#include "mongo/base/counter.h"
+#include "mongo/base/status.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
-#include "mongo/util/concurrency/mutex.h"
+#include "mongo/stdx/new.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/hierarchical_acquisition.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
+
+/**
+ * A counting semaphore handing out a fixed number of tickets.
+ *
+ * Acquiring and releasing a ticket while no one is queued only touches an atomic counter. Once
+ * the pool is exhausted, requests queue in one of the priority lanes below. A released ticket is
+ * handed directly to the oldest request in the highest non-empty lane, so requests are granted in
+ * arrival order within a lane, and new arrivals cannot overtake a request that is already queued.
+ */
 class TicketHolder {
     TicketHolder(const TicketHolder&) = delete;
     TicketHolder& operator=(const TicketHolder&) = delete;
 
 public:
+    /**
+     * Lanes a ticket request can queue in. A request in a higher lane is always granted a
+     * released ticket before any request in a lower lane.
+     */
+    enum class Priority {
+        kLow,
+        kNormal,
+        kHigh,
+    };
+    static constexpr size_t kNumPriorities = 3;
+
     explicit TicketHolder(int num);
     ~TicketHolder();
 
@@ -56,7 +80,7 @@ public:
      * 'opCtx' is killed, throwing an AssertionException.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    void waitForTicket(OperationContext* opCtx);
+    void waitForTicket(OperationContext* opCtx, Priority priority = Priority::kNormal);
     void waitForTicket() {
         waitForTicket(nullptr);
     }
@@ -68,7 +92,9 @@ public:
      * proceed.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    bool waitForTicketUntil(OperationContext* opCtx, Date_t until);
+    bool waitForTicketUntil(OperationContext* opCtx,
+                            Date_t until,
+                            Priority priority = Priority::kNormal);
     bool waitForTicketUntil(Date_t until) {
         return waitForTicketUntil(nullptr, until);
     }
@@ -82,22 +108,64 @@ public:
 
     int outof() const;
 
+    /**
+     * Returns the number of requests currently queued in the lane for 'priority'.
+     */
+    int queued(Priority priority) const;
+
+    /**
+     * Appends the queue statistics of every lane, including a histogram of the time requests
+     * spent queued.
+     */
+    void appendStats(BSONObjBuilder& b) const;
+
 private:
-#if defined(__linux__)
-    mutable sem_t _sem;
+    /**
+     * A request queued for a ticket. Lives on the stack of the waiting thread.
+     */
+    struct Waiter {
+        stdx::condition_variable cv;
+        bool granted = false;
+    };
+
+    struct LaneStats {
+        void recordQueueTime(Microseconds queueTime);
+
+        AtomicWord<int> queued{0};
+        Counter64 totalQueued;
+        Counter64 totalTimedOutOrInterrupted;
+        Counter64 totalQueueTimeMicros;
+        std::array<Counter64, 6> queueTimeBuckets;
+    };
+
+    bool _tryAcquireWithoutQueueing();
+
+    bool _waitInQueue(OperationContext* opCtx, Date_t until, Priority priority);
+
+    /**
+     * Hands available tickets to queued requests, highest lane first, in arrival order.
+     */
+    void _grantToWaiters(WithLock);
+
+    // Tickets that are neither held nor handed to a queued request. Updated by every acquisition
+    // and release, so it is kept on its own cache line.
+    alignas(stdx::hardware_destructive_interference_size) AtomicWord<int> _available;
+
+    // Number of requests queued across all lanes. While nonzero, a ticket can only be granted
+    // through the queue.
+    alignas(stdx::hardware_destructive_interference_size) AtomicWord<int> _numWaiters{0};
 
     // You can read _outof without a lock, but have to hold _resizeMutex to change.
-    AtomicWord<int> _outof;
+    alignas(stdx::hardware_destructive_interference_size) AtomicWord<int> _outof;
     Mutex _resizeMutex =
-        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_resizeMutex");
-#else
-    bool _tryAcquire();
-
-    AtomicWord<int> _outof;
-    int _num;
-    Mutex _mutex = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_mutex");
-    stdx::condition_variable _newTicket;
-#endif
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(1), "TicketHolder::_resizeMutex");
+
+    // Protects the lane queues and the 'granted' flag of every queued Waiter.
+    Mutex _queueMutex =
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_queueMutex");
+    std::array<std::deque<Waiter*>, kNumPriorities> _queues;
+
+    std::array<LaneStats, kNumPriorities> _laneStats;
 };
 
 class ScopedTicket {
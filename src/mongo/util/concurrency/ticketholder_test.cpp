@@ -32,8 +32,14 @@
 
 #include "mongo/platform/basic.h"
 
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/time_support.h"
 
 namespace {
 using namespace mongo;
@@ -72,4 +78,143 @@ TEST(TicketholderTest, BasicTimeout) {
     holder.release();
     ASSERT_EQ(holder.used(), 0);
 }
+
+/**
+ * Waits until 'n' requests are queued in the lane for 'priority'.
+ */
+void waitUntilQueued(TicketHolder& holder, TicketHolder::Priority priority, int n) {
+    while (holder.queued(priority) < n) {
+        sleepmillis(1);
+    }
+}
+
+/**
+ * Starts a thread that waits for a ticket, records 'name' once it has one and releases it.
+ */
+stdx::thread startWaiter(TicketHolder& holder,
+                         TicketHolder::Priority priority,
+                         std::string name,
+                         Mutex& mutex,
+                         std::vector<std::string>& grantOrder) {
+    return stdx::thread([&holder, priority, name = std::move(name), &mutex, &grantOrder] {
+        holder.waitForTicket(nullptr, priority);
+        {
+            stdx::lock_guard<Latch> lk(mutex);
+            grantOrder.push_back(name);
+        }
+        holder.release();
+    });
+}
+
+TEST(TicketholderTest, QueuedRequestsAreGrantedInArrivalOrder) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<std::string> grantOrder;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < 3; ++i) {
+        threads.push_back(startWaiter(
+            holder, TicketHolder::Priority::kNormal, std::to_string(i), mutex, grantOrder));
+        waitUntilQueued(holder, TicketHolder::Priority::kNormal, i + 1);
+    }
+
+    // A new request must not overtake the ones already queued.
+    ASSERT_FALSE(holder.tryAcquire());
+
+    holder.release();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT(grantOrder == std::vector<std::string>({"0", "1", "2"}));
+    ASSERT_EQ(holder.available(), 1);
+    ASSERT_EQ(holder.queued(TicketHolder::Priority::kNormal), 0);
+}
+
+TEST(TicketholderTest, HighPriorityRequestsAreGrantedFirst) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<std::string> grantOrder;
+    auto normal =
+        startWaiter(holder, TicketHolder::Priority::kNormal, "normal", mutex, grantOrder);
+    waitUntilQueued(holder, TicketHolder::Priority::kNormal, 1);
+    auto high = startWaiter(holder, TicketHolder::Priority::kHigh, "high", mutex, grantOrder);
+    waitUntilQueued(holder, TicketHolder::Priority::kHigh, 1);
+
+    holder.release();
+    normal.join();
+    high.join();
+
+    ASSERT(grantOrder == std::vector<std::string>({"high", "normal"}));
+    ASSERT_EQ(holder.available(), 1);
+}
+
+TEST(TicketholderTest, LowPriorityRequestsAreGrantedLast) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<std::string> grantOrder;
+    auto low = startWaiter(holder, TicketHolder::Priority::kLow, "low", mutex, grantOrder);
+    waitUntilQueued(holder, TicketHolder::Priority::kLow, 1);
+    auto normal =
+        startWaiter(holder, TicketHolder::Priority::kNormal, "normal", mutex, grantOrder);
+    waitUntilQueued(holder, TicketHolder::Priority::kNormal, 1);
+
+    holder.release();
+    low.join();
+    normal.join();
+
+    ASSERT(grantOrder == std::vector<std::string>({"normal", "low"}));
+    ASSERT_EQ(holder.available(), 1);
+}
+
+TEST(TicketholderTest, TimedOutRequestLeavesQueue) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    ASSERT_FALSE(holder.waitForTicketUntil(
+        nullptr, Date_t::now() + Milliseconds(5), TicketHolder::Priority::kHigh));
+    ASSERT_EQ(holder.queued(TicketHolder::Priority::kHigh), 0);
+
+    // The released ticket is not handed to the request that gave up.
+    holder.release();
+    ASSERT_EQ(holder.available(), 1);
+
+    BSONObjBuilder bob;
+    holder.appendStats(bob);
+    auto stats = bob.obj();
+    ASSERT_EQ(stats["lanes"]["high"]["totalQueued"].numberLong(), 1);
+    ASSERT_EQ(stats["lanes"]["high"]["totalTimedOutOrInterrupted"].numberLong(), 1);
+    ASSERT_EQ(stats["lanes"]["normal"]["totalQueued"].numberLong(), 0);
+}
+
+TEST(TicketholderTest, QueueTimeIsRecordedPerLane) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<std::string> grantOrder;
+    auto waiter =
+        startWaiter(holder, TicketHolder::Priority::kNormal, "normal", mutex, grantOrder);
+    waitUntilQueued(holder, TicketHolder::Priority::kNormal, 1);
+    holder.release();
+    waiter.join();
+
+    BSONObjBuilder bob;
+    holder.appendStats(bob);
+    auto normalStats = bob.obj()["lanes"]["normal"].Obj();
+    ASSERT_EQ(normalStats["queueLength"].numberInt(), 0);
+    ASSERT_EQ(normalStats["totalQueued"].numberLong(), 1);
+    ASSERT_EQ(normalStats["totalTimedOutOrInterrupted"].numberLong(), 0);
+
+    long long recorded = 0;
+    for (auto&& bucket : normalStats["queueTimeMicros"].Obj()) {
+        recorded += bucket.numberLong();
+    }
+    ASSERT_EQ(recorded, 1);
+}
 }  // namespace
@@ -127,11 +127,61 @@ public:
         typename DecorationContainer<D>::template DecorationDescriptorWithType<T> _raw;
     };
 
+    /**
+     * A decoration which is only constructed the first time it is accessed. See
+     * DecorationRegistry::declareLazyDecoration() for the restrictions that come with that.
+     */
+    template <typename T>
+    class LazyDecoration {
+    public:
+        LazyDecoration() = delete;
+
+        T& operator()(D& d) const {
+            return static_cast<Decorable&>(d)._decorations.getLazyDecoration(this->_raw);
+        }
+
+        T& operator()(D* const d) const {
+            return (*this)(*d);
+        }
+
+        // Accessing the decoration through a const reference still constructs it on first use.
+        const T& operator()(const D& d) const {
+            return (*this)(const_cast<D&>(d));
+        }
+
+        const T& operator()(const D* const d) const {
+            return (*this)(*d);
+        }
+
+        /**
+         * Returns true if the decoration has been constructed on 'd', so that callers which only
+         * want to read it can avoid constructing it.
+         */
+        bool isConstructed(const D& d) const {
+            return static_cast<const Decorable&>(d)._decorations.isConstructed(
+                this->_raw._presence);
+        }
+
+    private:
+        friend class Decorable;
+
+        explicit LazyDecoration(
+            typename DecorationContainer<D>::template LazyDecorationDescriptorWithType<T> raw)
+            : _raw(std::move(raw)) {}
+
+        typename DecorationContainer<D>::template LazyDecorationDescriptorWithType<T> _raw;
+    };
+
     template <typename T>
     static Decoration<T> declareDecoration() {
         return Decoration<T>(getRegistry()->template declareDecoration<T>());
     }
 
+    template <typename T>
+    static LazyDecoration<T> declareLazyDecoration() {
+        return LazyDecoration<T>(getRegistry()->template declareLazyDecoration<T>());
+    }
+
 protected:
     Decorable() : _decorations(this, getRegistry()) {}
     ~Decorable() = default;
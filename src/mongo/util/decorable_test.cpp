@@ -302,5 +302,85 @@ TEST(DecorableTest, DecorableCopyableType) {
     }
 }
 
+TEST(DecorableTest, LazyDecoration) {
+    numConstructedAs = 0;
+    numDestructedAs = 0;
+    DecorationRegistry<MyDecorable> registry;
+    const auto eager = registry.declareDecoration<A>();
+    const auto lazy1 = registry.declareLazyDecoration<A>();
+    const auto lazy2 = registry.declareLazyDecoration<A>();
+
+    {
+        MyDecorable* decorablePtr = nullptr;
+        DecorationContainer<MyDecorable> decorable(decorablePtr, &registry);
+        ASSERT_EQ(1, numConstructedAs);
+        ASSERT_EQ(0, decorable.getDecoration(eager).value);
+
+        ASSERT_EQ(0, decorable.getLazyDecoration(lazy1).value);
+        ASSERT_EQ(2, numConstructedAs);
+        decorable.getLazyDecoration(lazy1).value = 1;
+        ASSERT_EQ(1, decorable.getLazyDecoration(lazy1).value);
+        ASSERT_EQ(2, numConstructedAs);
+    }
+    // The lazy decoration which was never accessed is not destroyed.
+    ASSERT_EQ(2, numDestructedAs);
+}
+
+TEST(DecorableTest, ManyLazyDecorations) {
+    numConstructedAs = 0;
+    numDestructedAs = 0;
+    DecorationRegistry<MyDecorable> registry;
+    std::vector<DecorationContainer<MyDecorable>::LazyDecorationDescriptorWithType<A>> lazy;
+    for (int i = 0; i < 150; ++i) {
+        lazy.push_back(registry.declareLazyDecoration<A>());
+        registry.declareDecoration<char>();
+    }
+
+    {
+        MyDecorable* decorablePtr = nullptr;
+        DecorationContainer<MyDecorable> decorable(decorablePtr, &registry);
+        for (int i = 0; i < 150; i += 7) {
+            decorable.getLazyDecoration(lazy[i]).value = i;
+        }
+        for (int i = 0; i < 150; ++i) {
+            ASSERT_EQ(i % 7 == 0 ? i : 0, decorable.getLazyDecoration(lazy[i]).value);
+        }
+        ASSERT_EQ(150, numConstructedAs);
+    }
+    ASSERT_EQ(150, numDestructedAs);
+}
+
+TEST(DecorableTest, ThrowingLazyConstructor) {
+    DecorationRegistry<MyDecorable> registry;
+    const auto lazy = registry.declareLazyDecoration<ThrowA>();
+
+    MyDecorable* decorablePtr = nullptr;
+    DecorationContainer<MyDecorable> decorable(decorablePtr, &registry);
+    ASSERT_THROWS_CODE(
+        decorable.getLazyDecoration(lazy), AssertionException, ErrorCodes::Unauthorized);
+    ASSERT_THROWS_CODE(
+        decorable.getLazyDecoration(lazy), AssertionException, ErrorCodes::Unauthorized);
+}
+
+class MyLazilyDecorated : public Decorable<MyLazilyDecorated> {};
+
+TEST(DecorableTest, LazyDecorationOnDecorableType) {
+    numConstructedAs = 0;
+    numDestructedAs = 0;
+    const auto dd = MyLazilyDecorated::declareLazyDecoration<A>();
+    {
+        MyLazilyDecorated decorable;
+        ASSERT_FALSE(dd.isConstructed(decorable));
+        ASSERT_EQ(0, numConstructedAs);
+
+        dd(decorable).value = 1;
+        ASSERT_TRUE(dd.isConstructed(decorable));
+        const MyLazilyDecorated& constDecorable = decorable;
+        ASSERT_EQ(1, dd(constDecorable).value);
+        ASSERT_EQ(1, numConstructedAs);
+    }
+    ASSERT_EQ(1, numDestructedAs);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -31,6 +31,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <new>
 
 namespace mongo {
 
@@ -92,6 +93,45 @@ public:
         DecorationDescriptor _raw;
     };
 
+    /**
+     * Opaque location of the bit that records whether a lazily constructed decoration has been
+     * constructed yet. Up to 64 such bits share one word of the decoration buffer.
+     */
+    class PresenceBit {
+    public:
+        PresenceBit() = default;
+
+    private:
+        friend DecorationContainer;
+        friend DecorationRegistry<DecoratedType>;
+
+        PresenceBit(DecorationDescriptor word, uint64_t mask)
+            : _word(std::move(word)), _mask(mask) {}
+
+        DecorationDescriptor _word;
+        uint64_t _mask = 0;
+    };
+
+    /**
+     * Opaque description of a lazily constructed decoration of type T.
+     */
+    template <typename T>
+    class LazyDecorationDescriptorWithType {
+    public:
+        LazyDecorationDescriptorWithType() = default;
+
+    private:
+        friend DecorationContainer;
+        friend DecorationRegistry<DecoratedType>;
+        friend Decorable<DecoratedType>;
+
+        LazyDecorationDescriptorWithType(DecorationDescriptor raw, PresenceBit presence)
+            : _raw(std::move(raw)), _presence(std::move(presence)) {}
+
+        DecorationDescriptor _raw;
+        PresenceBit _presence;
+    };
+
     /**
      * Constructs a decorable built based on the given "registry."
      *
@@ -191,7 +231,33 @@ public:
         return *static_cast<const T*>(getDecoration(descriptor._raw));
     }
 
+    /**
+     * Gets the lazily constructed decoration for the given typed descriptor, default constructing
+     * it first if this is the first access.
+     */
+    template <typename T>
+    T& getLazyDecoration(LazyDecorationDescriptorWithType<T> descriptor) {
+        void* const location = getDecoration(descriptor._raw);
+        if (!isConstructed(descriptor._presence)) {
+            new (location) T();
+            _getPresenceWord(descriptor._presence) |= descriptor._presence._mask;
+        }
+        return *static_cast<T*>(location);
+    }
+
+    /**
+     * Returns true if the lazily constructed decoration with the given presence bit has been
+     * constructed.
+     */
+    bool isConstructed(PresenceBit presence) const {
+        return *static_cast<const uint64_t*>(getDecoration(presence._word)) & presence._mask;
+    }
+
 private:
+    uint64_t& _getPresenceWord(PresenceBit presence) {
+        return *static_cast<uint64_t*>(getDecoration(presence._word));
+    }
+
     const DecorationRegistry<DecoratedType>* const _registry;
     const std::unique_ptr<unsigned char[]> _decorationData;
 };
@@ -99,6 +99,36 @@ public:
                                             &destroyAt<T>)));
     }
 
+    /**
+     * Declares a decoration of type T which is only constructed, with T's default constructor,
+     * the first time it is accessed, and returns a descriptor for accessing that decoration.
+     * Decorations which most instances of the decorated type never touch should be lazy, so that
+     * creating an instance does not pay for them.
+     *
+     * Whether the decoration has been constructed is tracked in a bitmap in the decoration buffer,
+     * which is not synchronized. The first access must therefore not race with any other access,
+     * which in practice means the decoration should only be used by the thread which owns the
+     * decorated object. Lazy decorations cannot be copied.
+     *
+     * NOTE: T's destructor must not throw exceptions.
+     */
+    template <typename T>
+    auto declareLazyDecoration() {
+        MONGO_STATIC_ASSERT_MSG(std::is_nothrow_destructible<T>::value,
+                                "Decorations must be nothrow destructible");
+        auto presence = declarePresenceBit();
+        auto descriptor = declareDecoration(sizeof(T),
+                                            std::alignment_of<T>::value,
+                                            nullptr,
+                                            nullptr,
+                                            nullptr,
+                                            &destroyAt<T>);
+        _decorationInfo.back().presence = presence;
+        return typename DecorationContainer<DecoratedType>::
+            template LazyDecorationDescriptorWithType<T>(std::move(descriptor),
+                                                         std::move(presence));
+    }
+
     size_t getDecorationBufferSizeBytes() const {
         return _totalSizeBytes;
     }
@@ -112,6 +142,10 @@ public:
     void construct(DecorationContainer<DecoratedType>* const container) const {
         using std::cbegin;
 
+        for (const auto& word : _presenceWords) {
+            *static_cast<uint64_t*>(container->getDecoration(word)) = 0;
+        }
+
         auto iter = cbegin(_decorationInfo);
 
         auto cleanupFunction = [&iter, container, this ]() noexcept->void {
@@ -119,6 +153,9 @@ public:
             std::for_each(std::make_reverse_iterator(iter),
                           crend(this->_decorationInfo),
                           [&](auto&& decoration) {
+                              if (decoration.isLazy()) {
+                                  return;
+                              }
                               decoration.destructor(
                                   container->getDecoration(decoration.descriptor));
                           });
@@ -129,6 +166,9 @@ public:
         using std::cend;
 
         for (; iter != cend(_decorationInfo); ++iter) {
+            if (iter->isLazy()) {
+                continue;
+            }
             iter->constructor(container->getDecoration(iter->descriptor));
         }
 
@@ -196,6 +236,9 @@ public:
      */
     void destroy(DecorationContainer<DecoratedType>* const container) const noexcept try {
         std::for_each(_decorationInfo.rbegin(), _decorationInfo.rend(), [&](auto&& decoration) {
+            if (decoration.isLazy() && !container->isConstructed(decoration.presence)) {
+                return;
+            }
             decoration.destructor(container->getDecoration(decoration.descriptor));
         });
     } catch (...) {
@@ -237,11 +280,18 @@ private:
               copyAssignment(std::move(inCopyAssignment)),
               destructor(std::move(inDestructor)) {}
 
+        bool isLazy() const {
+            return !constructor;
+        }
+
         typename DecorationContainer<DecoratedType>::DecorationDescriptor descriptor;
         DecorationConstructorFn constructor;
         DecorationCopyConstructorFn copyConstructor;
         DecorationCopyAssignmentFn copyAssignment;
         DecorationDestructorFn destructor;
+
+        // Only set for lazily constructed decorations.
+        typename DecorationContainer<DecoratedType>::PresenceBit presence;
     };
 
     using DecorationInfoVector = std::vector<DecorationInfo>;
@@ -290,8 +340,33 @@ private:
         return result;
     }
 
+    /**
+     * Reserves the bit that tracks whether a lazily constructed decoration has been constructed,
+     * adding a word to the decoration buffer for every 64 lazy decorations.
+     */
+    typename DecorationContainer<DecoratedType>::PresenceBit declarePresenceBit() {
+        constexpr size_t kBitsPerWord = 64;
+        if (_numLazyDecorations % kBitsPerWord == 0) {
+            const size_t misalignment = _totalSizeBytes % alignof(uint64_t);
+            if (misalignment) {
+                _totalSizeBytes += alignof(uint64_t) - misalignment;
+            }
+            _presenceWords.push_back(
+                typename DecorationContainer<DecoratedType>::DecorationDescriptor(
+                    _totalSizeBytes));
+            _totalSizeBytes += sizeof(uint64_t);
+        }
+        const uint64_t mask = uint64_t{1} << (_numLazyDecorations++ % kBitsPerWord);
+        return typename DecorationContainer<DecoratedType>::PresenceBit(_presenceWords.back(),
+                                                                        mask);
+    }
+
     DecorationInfoVector _decorationInfo;
     size_t _totalSizeBytes{sizeof(void*)};
+
+    // The words of the decoration buffer which hold the presence bits of lazy decorations.
+    std::vector<typename DecorationContainer<DecoratedType>::DecorationDescriptor> _presenceWords;
+    size_t _numLazyDecorations = 0;
 };
 
 }  // namespace mongo
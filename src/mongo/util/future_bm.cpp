@@ -30,6 +30,7 @@
 #include "mongo/platform/basic.h"
 
 #include <benchmark/benchmark.h>
+#include <memory>
 
 #include "mongo/util/future.h"
 
@@ -198,6 +199,27 @@ void BM_futureInt4xDeferredThenChained(benchmark::State& state) {
     }
 }
 
+/**
+ * Mirrors the continuations NetworkInterfaceTL attaches to a remote command before its reply
+ * arrives: a metadata hook, wrapping the response and any error with the target host, returning
+ * the connection, and delivering the result. Each continuation holds a shared anchor, as the
+ * network interface does to keep its request state alive.
+ */
+void BM_futureRemoteCommandChain(benchmark::State& state) {
+    auto anchor = std::make_shared<int>(0);
+    for (auto _ : state) {
+        auto pf = makePromiseFuture<int>();
+        int result = 0;
+        std::move(pf.future)
+            .then([anchor](int i) { return i + 1; })
+            .then([anchor](int i) { return i + 1; })
+            .onError([anchor](Status) { return 0; })
+            .then([anchor](int i) { return i + *anchor; })
+            .getAsync([&result, anchor](StatusWith<int> swi) { result = swi.getValue(); });
+        pf.promise.emplaceValue(1);
+        benchmark::DoNotOptimize(result);
+    }
+}
 
 BENCHMARK(BM_plainIntReady);
 BENCHMARK(BM_futureIntReady);
@@ -212,5 +234,6 @@ BENCHMARK(BM_futureInt3xDeferredThenNested);
 BENCHMARK(BM_futureInt3xDeferredThenChained);
 BENCHMARK(BM_futureInt4xDeferredThenNested);
 BENCHMARK(BM_futureInt4xDeferredThenChained);
+BENCHMARK(BM_futureRemoteCommandChain);
 
 }  // namespace mongo
@@ -31,7 +31,9 @@
 
 #include <boost/intrusive_ptr.hpp>
 #include <boost/optional.hpp>
+#include <cstddef>
 #include <forward_list>
+#include <new>
 #include <type_traits>
 
 #include "mongo/base/checked_cast.h"
@@ -359,6 +361,75 @@ enum class SSBState : uint8_t {
     kFinished,
 };
 
+class SharedStateBase;
+
+/**
+ * Type-erased holder for SharedStateBase::callback.
+ *
+ * Every deferred continuation (then(), onError(), getAsync(), ...) installs one of these, and a
+ * typical remote command chains several. The callables are almost always a small lambda holding
+ * the user's functor, so they are constructed directly in inline storage rather than in the heap
+ * allocation a unique_function would make for each one. Callables that do not fit fall back to a
+ * unique_function held in the same storage.
+ *
+ * A callback is assigned at most once and lives until its SharedState is destroyed, so this type
+ * is neither copyable nor movable.
+ */
+class SharedStateCallback {
+public:
+    static constexpr size_t kInlineSize = 6 * sizeof(void*);
+
+    SharedStateCallback() = default;
+    SharedStateCallback(const SharedStateCallback&) = delete;
+    SharedStateCallback& operator=(const SharedStateCallback&) = delete;
+
+    ~SharedStateCallback() {
+        if (_ops)
+            _ops->destroy(&_storage);
+    }
+
+    template <typename Func>
+    SharedStateCallback& operator=(Func&& func) {
+        invariant(!_ops);
+        using Fn = std::decay_t<Func>;
+        if constexpr (sizeof(Fn) <= kInlineSize && alignof(Fn) <= alignof(Storage)) {
+            new (&_storage) Fn(std::forward<Func>(func));
+            _ops = &kOps<Fn>;
+        } else {
+            using Boxed = unique_function<void(SharedStateBase*)>;
+            new (&_storage) Boxed(std::forward<Func>(func));
+            _ops = &kOps<Boxed>;
+        }
+        return *this;
+    }
+
+    void operator()(SharedStateBase* input) {
+        invariant(_ops);
+        _ops->call(&_storage, input);
+    }
+
+    explicit operator bool() const noexcept {
+        return _ops;
+    }
+
+private:
+    using Storage = std::aligned_storage_t<kInlineSize, alignof(std::max_align_t)>;
+
+    struct Ops {
+        void (*call)(void* storage, SharedStateBase* input);
+        void (*destroy)(void* storage);
+    };
+
+    template <typename Fn>
+    static constexpr Ops kOps = {
+        [](void* storage, SharedStateBase* input) { (*static_cast<Fn*>(storage))(input); },
+        [](void* storage) { static_cast<Fn*>(storage)->~Fn(); },
+    };
+
+    const Ops* _ops = nullptr;
+    Storage _storage;
+};
+
 class SharedStateBase : public RefCountable {
 public:
     using Children = std::forward_list<boost::intrusive_ptr<SharedStateBase>>;
@@ -493,7 +564,7 @@ public:
     boost::intrusive_ptr<SharedStateBase> continuation;  // F
 
     // Takes this as argument and usually writes to continuation.
-    unique_function<void(SharedStateBase* input)> callback;  // F
+    SharedStateCallback callback;  // F
 
     // These are only used to signal completion to blocking waiters. Benchmarks showed that it was
     // worth deferring the construction of cv, so it can be avoided when it isn't necessary.
@@ -31,6 +31,9 @@
 
 #include "mongo/util/future.h"
 
+#include <array>
+#include <memory>
+
 #include "mongo/stdx/thread.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
@@ -342,6 +345,27 @@ TEST(Future_EdgeCases, SharedPromise_CompleteWithUnreadyFuture) {
     sf.get();
 }
 
+TEST(Future_EdgeCases, DeferredContinuationsOfAnySizeRunAndReleaseCaptures) {
+    // Small captures are stored inline in the shared state, large ones are boxed. Both must run
+    // exactly once and release what they captured when the chain is destroyed.
+    auto tracker = std::make_shared<int>(0);
+    std::array<char, 256> large{};
+    large[0] = 1;
+
+    {
+        auto [promise, future] = makePromiseFuture<int>();
+        auto fut = std::move(future)
+                       .then([tracker](int i) { return i + 1; })
+                       .then([tracker, large](int i) { return i + large[0]; });
+        ASSERT_GT(tracker.use_count(), 1);
+
+        promise.emplaceValue(1);
+        ASSERT_EQ(std::move(fut).get(), 3);
+    }
+
+    ASSERT_EQ(tracker.use_count(), 1);
+}
+
 // Make sure we actually die if someone throws from the getAsync callback.
 //
 // With gcc 5.8 we terminate, but print "terminate() called. No exception is active". This works in
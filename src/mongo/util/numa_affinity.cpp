@@ -0,0 +1,231 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kControl
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/numa_affinity.h"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <cctype>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "mongo/base/parse_number.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/numa_affinity_gen.h"
+
+namespace mongo {
+namespace numa {
+namespace {
+
+const std::string kNodeDirectory = "/sys/devices/system/node";
+
+struct Node {
+    int id;
+    std::vector<int> cpus;
+    AtomicWord<long long> threadsBound{0};
+};
+
+/**
+ * The NUMA nodes of the host which have CPUs, in order of node id. Empty if the host has a single
+ * node or its topology cannot be read.
+ */
+class Topology {
+public:
+    Topology() {
+#ifdef __linux__
+        try {
+            if (!boost::filesystem::exists(kNodeDirectory)) {
+                return;
+            }
+            for (auto&& entry : boost::filesystem::directory_iterator(kNodeDirectory)) {
+                const auto name = entry.path().filename().string();
+                int id;
+                if (name.compare(0, 4, "node") != 0 ||
+                    !NumberParser{}(StringData(name).substr(4), &id).isOK()) {
+                    continue;
+                }
+
+                std::ifstream cpuList((entry.path() / "cpulist").string());
+                std::string line;
+                if (!std::getline(cpuList, line)) {
+                    continue;
+                }
+                auto cpus = parseCpuList(line);
+                if (!cpus.empty()) {
+                    _nodes.push_back(std::make_unique<Node>());
+                    _nodes.back()->id = id;
+                    _nodes.back()->cpus = std::move(cpus);
+                }
+            }
+        } catch (const boost::filesystem::filesystem_error& e) {
+            LOGV2_WARNING(5910910,
+                          "Cannot read the NUMA topology of the host",
+                          "path"_attr = e.path1().string(),
+                          "error"_attr = e.code().message());
+            _nodes.clear();
+        }
+
+        std::sort(_nodes.begin(), _nodes.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs->id < rhs->id;
+        });
+        if (_nodes.size() < 2) {
+            _nodes.clear();
+        }
+#endif
+    }
+
+    const std::vector<std::unique_ptr<Node>>& nodes() const {
+        return _nodes;
+    }
+
+    Node& nextNode() {
+        return *_nodes[_nextNode.fetchAndAdd(1) % _nodes.size()];
+    }
+
+private:
+    std::vector<std::unique_ptr<Node>> _nodes;
+    AtomicWord<unsigned long long> _nextNode{0};
+};
+
+Topology& getTopology() {
+    static auto topology = new Topology();
+    return *topology;
+}
+
+/**
+ * Reads the "Node <id> MemTotal: <n> kB" and "Node <id> MemFree: <n> kB" lines of a node's meminfo.
+ */
+void appendNodeMemory(int id, BSONObjBuilder* builder) {
+    std::ifstream meminfo(kNodeDirectory + "/node" + std::to_string(id) + "/meminfo");
+    std::string line;
+    while (std::getline(meminfo, line)) {
+        std::istringstream fields(line);
+        std::string nodeLabel, nodeId, key;
+        long long kb;
+        if (!(fields >> nodeLabel >> nodeId >> key >> kb)) {
+            continue;
+        }
+        if (key == "MemTotal:") {
+            builder->append("memTotalMB", kb / 1024);
+        } else if (key == "MemFree:") {
+            builder->append("memFreeMB", kb / 1024);
+        }
+    }
+}
+
+}  // namespace
+
+bool isThreadAffinityEnabled() {
+    return gNumaThreadAffinity && !getTopology().nodes().empty();
+}
+
+int bindCurrentThreadToNode() {
+    if (!isThreadAffinityEnabled()) {
+        return -1;
+    }
+
+#ifdef __linux__
+    auto& node = getTopology().nextNode();
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (int cpu : node.cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpuSet);
+        }
+    }
+
+    if (int err = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet)) {
+        LOGV2_WARNING(5910911,
+                      "Failed to bind thread to NUMA node",
+                      "node"_attr = node.id,
+                      "error"_attr = errnoWithDescription(err));
+        return -1;
+    }
+    node.threadsBound.fetchAndAdd(1);
+    return node.id;
+#else
+    return -1;
+#endif
+}
+
+void appendStats(BSONObjBuilder* builder) {
+    builder->append("threadAffinity", isThreadAffinityEnabled());
+    BSONArrayBuilder nodesBuilder(builder->subarrayStart("nodes"));
+    for (auto&& node : getTopology().nodes()) {
+        BSONObjBuilder nodeBuilder(nodesBuilder.subobjStart());
+        nodeBuilder.append("id", node->id);
+        nodeBuilder.append("cpus", static_cast<int>(node->cpus.size()));
+        nodeBuilder.append("threadsBound", node->threadsBound.load());
+        appendNodeMemory(node->id, &nodeBuilder);
+    }
+}
+
+std::vector<int> parseCpuList(StringData cpuList) {
+    std::vector<int> cpus;
+    while (!cpuList.empty()) {
+        auto comma = cpuList.find(',');
+        auto range = cpuList.substr(0, comma);
+        cpuList = comma == std::string::npos ? StringData() : cpuList.substr(comma + 1);
+
+        while (!range.empty() && std::isspace(range[range.size() - 1])) {
+            range = range.substr(0, range.size() - 1);
+        }
+
+        auto dash = range.find('-');
+        int first, last;
+        if (!NumberParser{}(range.substr(0, dash), &first).isOK()) {
+            continue;
+        }
+        if (dash == std::string::npos) {
+            last = first;
+        } else if (!NumberParser{}(range.substr(dash + 1), &last).isOK() || last < first) {
+            continue;
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+}  // namespace numa
+}  // namespace mongo
@@ -0,0 +1,70 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+
+/**
+ * Optional placement of worker threads on NUMA nodes. When the numaThreadAffinity startup
+ * parameter is set on a Linux host with more than one NUMA node, worker threads bind themselves to
+ * the CPUs of one node as they start, with nodes assigned in turn. Memory the thread touches first
+ * is then allocated on its own node, and every connection served by the thread stays there.
+ */
+namespace numa {
+
+/**
+ * Returns true if worker threads are being bound to NUMA nodes.
+ */
+bool isThreadAffinityEnabled();
+
+/**
+ * Binds the calling thread to the CPUs of the next NUMA node in turn and returns the node's id, or
+ * returns -1 without changing the thread's affinity if thread affinity is not enabled.
+ */
+int bindCurrentThreadToNode();
+
+/**
+ * Appends the CPUs, bound thread count and memory of each NUMA node.
+ */
+void appendStats(BSONObjBuilder* builder);
+
+/**
+ * Parses a Linux CPU list, such as "0-3,8,10-11", into the CPUs it names. Malformed ranges are
+ * skipped.
+ */
+std::vector<int> parseCpuList(StringData cpuList);
+
+}  // namespace numa
+}  // namespace mongo
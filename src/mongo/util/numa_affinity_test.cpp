@@ -0,0 +1,56 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/numa_affinity.h"
+
+namespace mongo {
+namespace {
+
+TEST(NumaAffinityTest, ParsesSingleCpusAndRanges) {
+    ASSERT_EQ(std::vector<int>({0}), numa::parseCpuList("0"));
+    ASSERT_EQ(std::vector<int>({0, 1, 2, 3}), numa::parseCpuList("0-3"));
+    ASSERT_EQ(std::vector<int>({0, 1, 2, 3, 8, 10, 11}), numa::parseCpuList("0-3,8,10-11"));
+    ASSERT_EQ(std::vector<int>({24, 25, 72, 73}), numa::parseCpuList("24-25,72-73\n"));
+}
+
+TEST(NumaAffinityTest, SkipsMalformedRanges) {
+    ASSERT_EQ(std::vector<int>(), numa::parseCpuList(""));
+    ASSERT_EQ(std::vector<int>({4}), numa::parseCpuList("x,3-1,4,5-"));
+}
+
+TEST(NumaAffinityTest, DoesNotBindThreadsWhenDisabled) {
+    ASSERT_FALSE(numa::isThreadAffinityEnabled());
+    ASSERT_EQ(-1, numa::bindCurrentThreadToNode());
+}
+
+}  // namespace
+}  // namespace mongo
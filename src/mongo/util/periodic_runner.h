@@ -40,6 +40,7 @@
 
 namespace mongo {
 
+class BSONObjBuilder;
 class Client;
 class PeriodicJobAnchor;
 
@@ -60,8 +61,11 @@ public:
     using JobAnchor = PeriodicJobAnchor;
 
     struct PeriodicJob {
-        PeriodicJob(std::string name, Job callable, Milliseconds period)
-            : name(std::move(name)), job(std::move(callable)), interval(period) {}
+        PeriodicJob(std::string name,
+                    Job callable,
+                    Milliseconds period,
+                    Milliseconds jitter = Milliseconds{0})
+            : name(std::move(name)), job(std::move(callable)), interval(period), jitter(jitter) {}
 
         /**
          * name of the job
@@ -77,6 +81,12 @@ public:
          * An interval at which the job should be run.
          */
         Milliseconds interval;
+
+        /**
+         * An upper bound on a random delay added to each interval, so that jobs which share a
+         * period do not all wake up at the same moment.
+         */
+        Milliseconds jitter;
     };
 
     /**
@@ -131,6 +141,12 @@ public:
      * is interested in observing and controlling the job execution state.
      */
     virtual JobAnchor makeJob(PeriodicJob job) = 0;
+
+    /**
+     * Appends per-job execution statistics, keyed by job name. Implementations which do not track
+     * statistics append nothing.
+     */
+    virtual void appendStats(BSONObjBuilder* bob) const {}
 };
 
 /**
@@ -32,12 +32,14 @@
 #include "mongo/util/periodic_runner_factory.h"
 
 #include "mongo/db/service_context.h"
+#include "mongo/util/periodic_runner_factory_gen.h"
 #include "mongo/util/periodic_runner_impl.h"
 
 namespace mongo {
 
 std::unique_ptr<PeriodicRunner> makePeriodicRunner(ServiceContext* svc) {
-    return std::make_unique<PeriodicRunnerImpl>(svc, svc->getPreciseClockSource());
+    return std::make_unique<PeriodicRunnerImpl>(
+        svc, svc->getPreciseClockSource(), gPeriodicRunnerSchedulerThreads);
 }
 
 }  // namespace mongo
@@ -33,30 +33,124 @@
 
 #include "mongo/util/periodic_runner_impl.h"
 
+#include <algorithm>
+
 #include "mongo/base/error_codes.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/client.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/clock_source.h"
+#include "mongo/util/concurrency/thread_name.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 
-PeriodicRunnerImpl::PeriodicRunnerImpl(ServiceContext* svc, ClockSource* clockSource)
-    : _svc(svc), _clockSource(clockSource) {}
+PeriodicRunnerImpl::PeriodicRunnerImpl(ServiceContext* svc,
+                                       ClockSource* clockSource,
+                                       size_t schedulerThreads)
+    : _svc(svc), _clockSource(clockSource) {
+    if (schedulerThreads > 0) {
+        _scheduler = std::make_shared<Scheduler>(clockSource, schedulerThreads);
+        _scheduler->startup();
+    }
+}
+
+PeriodicRunnerImpl::~PeriodicRunnerImpl() {
+    if (_scheduler) {
+        _scheduler->shutdown();
+    }
+}
 
 auto PeriodicRunnerImpl::makeJob(PeriodicJob job) -> JobAnchor {
-    auto impl = std::make_shared<PeriodicJobImpl>(std::move(job), this->_clockSource, this->_svc);
+    std::shared_ptr<JobImplBase> impl;
+    if (_scheduler) {
+        impl = std::make_shared<ScheduledJobImpl>(
+            std::move(job), this->_clockSource, this->_svc, _scheduler);
+    } else {
+        impl = std::make_shared<PeriodicJobImpl>(std::move(job), this->_clockSource, this->_svc);
+    }
+
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _jobs.erase(std::remove_if(_jobs.begin(),
+                                   _jobs.end(),
+                                   [](const auto& weakJob) { return weakJob.expired(); }),
+                    _jobs.end());
+        _jobs.push_back(impl);
+    }
 
     JobAnchor anchor(std::move(impl));
     return anchor;
 }
 
+void PeriodicRunnerImpl::appendStats(BSONObjBuilder* bob) const {
+    std::vector<std::shared_ptr<JobImplBase>> jobs;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (const auto& weakJob : _jobs) {
+            if (auto job = weakJob.lock()) {
+                jobs.push_back(std::move(job));
+            }
+        }
+    }
+
+    for (const auto& job : jobs) {
+        job->appendStats(bob);
+    }
+}
+
+PeriodicRunnerImpl::JobImplBase::JobImplBase(PeriodicJob job,
+                                             ClockSource* source,
+                                             ServiceContext* svc)
+    : _job(std::move(job)),
+      _clockSource(source),
+      _serviceContext(svc),
+      _random(SecureRandom().nextInt64()) {}
+
+Milliseconds PeriodicRunnerImpl::JobImplBase::getPeriod() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _job.interval;
+}
+
+void PeriodicRunnerImpl::JobImplBase::appendStats(BSONObjBuilder* bob) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    BSONObjBuilder sub(bob->subobjStart(_job.name));
+    sub.append("periodMillis", durationCount<Milliseconds>(_job.interval));
+    sub.append("runs", _runs);
+    sub.append("totalRunMillis", durationCount<Milliseconds>(_totalRunTime));
+    sub.append("maxRunMillis", durationCount<Milliseconds>(_maxRunTime));
+    sub.append("totalLatenessMillis", durationCount<Milliseconds>(_totalLateness));
+    sub.append("maxLatenessMillis", durationCount<Milliseconds>(_maxLateness));
+}
+
+Milliseconds PeriodicRunnerImpl::JobImplBase::_nextJitter(WithLock) {
+    if (_job.jitter <= Milliseconds{0}) {
+        return Milliseconds{0};
+    }
+    return Milliseconds{_random.nextInt64(durationCount<Milliseconds>(_job.jitter) + 1)};
+}
+
+void PeriodicRunnerImpl::JobImplBase::_recordRun(WithLock,
+                                                 Date_t scheduled,
+                                                 Date_t start,
+                                                 Date_t end) {
+    auto runTime = end - start;
+    auto lateness = std::max(start - scheduled, Milliseconds{0});
+
+    ++_runs;
+    _totalRunTime += runTime;
+    _maxRunTime = std::max(_maxRunTime, runTime);
+    _totalLateness += lateness;
+    _maxLateness = std::max(_maxLateness, lateness);
+}
+
 PeriodicRunnerImpl::PeriodicJobImpl::PeriodicJobImpl(PeriodicJob job,
                                                      ClockSource* source,
                                                      ServiceContext* svc)
-    : _job(std::move(job)), _clockSource(source), _serviceContext(svc), _client(nullptr) {}
+    : JobImplBase(std::move(job), source, svc), _client(nullptr) {}
 
 void PeriodicRunnerImpl::PeriodicJobImpl::_run() {
     {
@@ -89,9 +183,14 @@ void PeriodicRunnerImpl::PeriodicJobImpl::_run() {
             startPromise.emplaceValue();
 
             stdx::unique_lock<Latch> lk(_mutex);
+            auto scheduled = _clockSource->now();
             while (_execStatus != ExecutionStatus::CANCELED) {
-                // Wait until it's unpaused or canceled
-                _condvar.wait(lk, [&] { return _execStatus != ExecutionStatus::PAUSED; });
+                // Wait until it's unpaused or canceled. Time spent paused does not count as
+                // lateness.
+                if (_execStatus == ExecutionStatus::PAUSED) {
+                    _condvar.wait(lk, [&] { return _execStatus != ExecutionStatus::PAUSED; });
+                    scheduled = _clockSource->now();
+                }
                 if (_execStatus == ExecutionStatus::CANCELED) {
                     return;
                 }
@@ -103,7 +202,10 @@ void PeriodicRunnerImpl::PeriodicJobImpl::_run() {
                 _job.job(client.get());
                 lk.lock();
 
-                auto getDeadlineFromInterval = [&] { return start + _job.interval; };
+                _recordRun(lk, scheduled, start, _clockSource->now());
+
+                auto jitter = _nextJitter(lk);
+                auto getDeadlineFromInterval = [&] { return start + _job.interval + jitter; };
 
                 do {
                     auto deadline = getDeadlineFromInterval();
@@ -117,6 +219,7 @@ void PeriodicRunnerImpl::PeriodicJobImpl::_run() {
                         }
                     }
                 } while (_clockSource->now() < getDeadlineFromInterval());
+                scheduled = getDeadlineFromInterval();
             }
         }
     });
@@ -188,11 +291,6 @@ void PeriodicRunnerImpl::PeriodicJobImpl::stop() {
     stopFuture.get();
 }
 
-Milliseconds PeriodicRunnerImpl::PeriodicJobImpl::getPeriod() {
-    stdx::lock_guard<Latch> lk(_mutex);
-    return _job.interval;
-}
-
 void PeriodicRunnerImpl::PeriodicJobImpl::setPeriod(Milliseconds ms) {
     stdx::lock_guard<Latch> lk(_mutex);
     _job.interval = ms;
@@ -202,4 +300,200 @@ void PeriodicRunnerImpl::PeriodicJobImpl::setPeriod(Milliseconds ms) {
     }
 }
 
+PeriodicRunnerImpl::ScheduledJobImpl::ScheduledJobImpl(PeriodicJob job,
+                                                       ClockSource* source,
+                                                       ServiceContext* svc,
+                                                       std::shared_ptr<Scheduler> scheduler)
+    : JobImplBase(std::move(job), source, svc), _scheduler(std::move(scheduler)) {}
+
+void PeriodicRunnerImpl::ScheduledJobImpl::start() {
+    LOGV2_DEBUG(5910925, 2, "Starting scheduled periodic job", "jobName"_attr = _job.name);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (MONGO_unlikely(_execStatus == ExecutionStatus::CANCELED))
+        uasserted(ErrorCodes::PeriodicJobIsStopped, "Attempted to start an already stopped job");
+    invariant(_execStatus == ExecutionStatus::NOT_SCHEDULED);
+
+    _client = _serviceContext->makeClient(_job.name);
+    _clientPtr = _client.get();
+    _execStatus = ExecutionStatus::RUNNING;
+
+    // Like a job on its own thread, the first run happens as soon as the job starts.
+    _scheduleAt(lk, _clockSource->now());
+}
+
+void PeriodicRunnerImpl::ScheduledJobImpl::pause() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (MONGO_unlikely(_execStatus == ExecutionStatus::CANCELED))
+        uasserted(ErrorCodes::PeriodicJobIsStopped, "Attempted to pause an already stopped job");
+    invariant(_execStatus == ExecutionStatus::RUNNING);
+    _execStatus = ExecutionStatus::PAUSED;
+}
+
+void PeriodicRunnerImpl::ScheduledJobImpl::resume() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (MONGO_unlikely(_execStatus == ExecutionStatus::CANCELED))
+        uasserted(ErrorCodes::PeriodicJobIsStopped, "Attempted to resume an already stopped job");
+    invariant(_execStatus == ExecutionStatus::PAUSED);
+    _execStatus = ExecutionStatus::RUNNING;
+
+    if (_missedWhilePaused) {
+        _missedWhilePaused = false;
+        _scheduleAt(lk, _clockSource->now());
+    }
+}
+
+void PeriodicRunnerImpl::ScheduledJobImpl::stop() {
+    ServiceContext::UniqueClient client;
+    {
+        stdx::unique_lock<Latch> lk(_mutex);
+        auto lastExecStatus = std::exchange(_execStatus, ExecutionStatus::CANCELED);
+
+        // If we never started, then nobody should wait
+        if (lastExecStatus == ExecutionStatus::NOT_SCHEDULED) {
+            return;
+        }
+
+        if (lastExecStatus != ExecutionStatus::CANCELED) {
+            LOGV2_DEBUG(
+                5910926, 2, "Stopping scheduled periodic job", "jobName"_attr = _job.name);
+            ++_generation;
+
+            // Kill the client and its opCtx (if any) so that a run in progress returns promptly.
+            if (_isRunning) {
+                _clientPtr->setKilled();
+            }
+        }
+
+        _runFinishedCond.wait(lk, [&] { return !_isRunning; });
+        client = std::move(_client);
+    }
+}
+
+void PeriodicRunnerImpl::ScheduledJobImpl::setPeriod(Milliseconds ms) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _job.interval = ms;
+
+    // A run in progress picks up the new period when it finishes. Otherwise move the outstanding
+    // timer so that the next run is due 'ms' after the last one started.
+    if ((_execStatus == ExecutionStatus::RUNNING || _execStatus == ExecutionStatus::PAUSED) &&
+        !_isRunning && !_missedWhilePaused && _lastStart) {
+        ++_generation;
+        _scheduleAt(lk, *_lastStart + ms + _lastJitter);
+    }
+}
+
+void PeriodicRunnerImpl::ScheduledJobImpl::_runOnce(uint64_t generation, Date_t deadline) {
+    stdx::unique_lock<Latch> lk(_mutex);
+    if (generation != _generation) {
+        return;
+    }
+    if (_execStatus == ExecutionStatus::PAUSED) {
+        _missedWhilePaused = true;
+        return;
+    }
+    if (_execStatus != ExecutionStatus::RUNNING) {
+        return;
+    }
+
+    _isRunning = true;
+    auto client = std::move(_client);
+    lk.unlock();
+
+    auto start = _clockSource->now();
+    setThreadName(_job.name);
+    Client::setCurrent(std::move(client));
+    _job.job(_clientPtr);
+    client = Client::releaseCurrent();
+    auto end = _clockSource->now();
+
+    lk.lock();
+    _client = std::move(client);
+    _isRunning = false;
+    _recordRun(lk, deadline, start, end);
+
+    if (_execStatus == ExecutionStatus::RUNNING || _execStatus == ExecutionStatus::PAUSED) {
+        _lastStart = start;
+        _lastJitter = _nextJitter(lk);
+        _scheduleAt(lk, start + _job.interval + _lastJitter);
+    }
+    _runFinishedCond.notify_all();
+}
+
+void PeriodicRunnerImpl::ScheduledJobImpl::_scheduleAt(WithLock, Date_t deadline) {
+    _scheduler->schedule(weak_from_this(), _generation, deadline);
+}
+
+PeriodicRunnerImpl::Scheduler::Scheduler(ClockSource* clockSource, size_t numThreads)
+    : _clockSource(clockSource), _numThreads(numThreads), _wheel(clockSource->now()) {}
+
+void PeriodicRunnerImpl::Scheduler::startup() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    invariant(_threads.empty());
+    for (size_t i = 0; i < _numThreads; ++i) {
+        _threads.emplace_back([this, i] { _workerLoop(i); });
+    }
+}
+
+void PeriodicRunnerImpl::Scheduler::shutdown() {
+    std::vector<stdx::thread> threads;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _inShutdown = true;
+        threads = std::move(_threads);
+    }
+    _cond.notify_all();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void PeriodicRunnerImpl::Scheduler::schedule(std::weak_ptr<ScheduledJobImpl> job,
+                                             uint64_t generation,
+                                             Date_t deadline) {
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_inShutdown) {
+            return;
+        }
+        _wheel.insert(deadline, Timer{std::move(job), generation, deadline});
+    }
+    _cond.notify_one();
+}
+
+void PeriodicRunnerImpl::Scheduler::_workerLoop(size_t id) {
+    const std::string threadName = str::stream() << "PeriodicRunner-" << id;
+    setThreadName(threadName);
+
+    stdx::unique_lock<Latch> lk(_mutex);
+    while (!_inShutdown) {
+        if (_ready.empty()) {
+            std::vector<Timer> expired;
+            _wheel.advance(_clockSource->now(), &expired);
+            std::move(expired.begin(), expired.end(), std::back_inserter(_ready));
+        }
+
+        if (_ready.empty()) {
+            _clockSource->waitForConditionUntil(
+                _cond, lk, _wheel.nextDeadline().value_or(Date_t::max()));
+            continue;
+        }
+
+        auto timer = std::move(_ready.front());
+        _ready.pop_front();
+        if (!_ready.empty()) {
+            // Hand the rest of the due jobs to another thread.
+            _cond.notify_one();
+        }
+
+        lk.unlock();
+        if (auto job = timer.job.lock()) {
+            job->_runOnce(timer.generation, timer.deadline);
+        }
+        setThreadName(threadName);
+        lk.lock();
+    }
+}
+
 }  // namespace mongo
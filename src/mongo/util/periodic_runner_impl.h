@@ -29,36 +29,97 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
 #include <vector>
 
+#include "mongo/db/service_context.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/platform/random.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/util/clock_source.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/future.h"
 #include "mongo/util/periodic_runner.h"
+#include "mongo/util/timer_wheel.h"
 
 namespace mongo {
 
 class Client;
-class ServiceContext;
 
 /**
- * An implementation of the PeriodicRunner which uses a thread per job and condvar waits on those
- * threads to independently sleep.
+ * An implementation of the PeriodicRunner which by default uses a thread per job and condvar waits
+ * on those threads to independently sleep.
+ *
+ * When constructed with a non-zero number of scheduler threads, jobs instead share a timer wheel
+ * and that many threads, which wake up only when some job is due. Each job keeps its own Client,
+ * which is bound to whichever scheduler thread runs it. A job that blocks for a long time delays
+ * the other jobs waiting for a scheduler thread, so jobs run this way should be short.
  */
 class PeriodicRunnerImpl : public PeriodicRunner {
 public:
-    PeriodicRunnerImpl(ServiceContext* svc, ClockSource* clockSource);
+    PeriodicRunnerImpl(ServiceContext* svc, ClockSource* clockSource, size_t schedulerThreads = 0);
+    ~PeriodicRunnerImpl();
 
     JobAnchor makeJob(PeriodicJob job) override;
 
+    void appendStats(BSONObjBuilder* bob) const override;
+
 private:
-    class PeriodicJobImpl : public ControllableJob {
-        PeriodicJobImpl(const PeriodicJobImpl&) = delete;
-        PeriodicJobImpl& operator=(const PeriodicJobImpl&) = delete;
+    class Scheduler;
+
+    /**
+     * State and statistics shared by both kinds of job.
+     */
+    class JobImplBase : public ControllableJob {
+        JobImplBase(const JobImplBase&) = delete;
+        JobImplBase& operator=(const JobImplBase&) = delete;
 
+    public:
+        JobImplBase(PeriodicJob job, ClockSource* source, ServiceContext* svc);
+
+        Milliseconds getPeriod() override;
+
+        void appendStats(BSONObjBuilder* bob);
+
+        enum class ExecutionStatus { NOT_SCHEDULED, RUNNING, PAUSED, CANCELED };
+
+    protected:
+        /**
+         * Returns a random delay of up to the job's jitter to add to its next interval.
+         */
+        Milliseconds _nextJitter(WithLock);
+
+        /**
+         * Records a run which was due at 'scheduled' and ran from 'start' to 'end'.
+         */
+        void _recordRun(WithLock, Date_t scheduled, Date_t start, Date_t end);
+
+        PeriodicJob _job;
+        ClockSource* _clockSource;
+        ServiceContext* _serviceContext;
+
+        Mutex _mutex = MONGO_MAKE_LATCH("PeriodicJobImpl::_mutex");
+        /**
+         * The current execution status of the job.
+         */
+        ExecutionStatus _execStatus{ExecutionStatus::NOT_SCHEDULED};
+
+    private:
+        PseudoRandom _random;
+
+        long long _runs = 0;
+        Milliseconds _totalRunTime{0};
+        Milliseconds _maxRunTime{0};
+        Milliseconds _totalLateness{0};
+        Milliseconds _maxLateness{0};
+    };
+
+    /**
+     * A job which runs on its own thread.
+     */
+    class PeriodicJobImpl : public JobImplBase {
     public:
         friend class PeriodicRunnerImpl;
         PeriodicJobImpl(PeriodicJob job, ClockSource* source, ServiceContext* svc);
@@ -67,34 +128,111 @@ private:
         void pause() override;
         void resume() override;
         void stop() override;
-        Milliseconds getPeriod() override;
         void setPeriod(Milliseconds ms) override;
 
-        enum class ExecutionStatus { NOT_SCHEDULED, RUNNING, PAUSED, CANCELED };
-
     private:
         void _run();
 
-        PeriodicJob _job;
-        ClockSource* _clockSource;
-        ServiceContext* _serviceContext;
-
         Client* _client;
         stdx::thread _thread;
         SharedPromise<void> _stopPromise;
 
-        Mutex _mutex = MONGO_MAKE_LATCH("PeriodicJobImpl::_mutex");
         stdx::condition_variable _condvar;
+    };
+
+    /**
+     * A job which runs on the threads of a shared Scheduler.
+     */
+    class ScheduledJobImpl : public JobImplBase,
+                             public std::enable_shared_from_this<ScheduledJobImpl> {
+    public:
+        ScheduledJobImpl(PeriodicJob job,
+                         ClockSource* source,
+                         ServiceContext* svc,
+                         std::shared_ptr<Scheduler> scheduler);
+
+        void start() override;
+        void pause() override;
+        void resume() override;
+        void stop() override;
+        void setPeriod(Milliseconds ms) override;
+
+    private:
+        friend class Scheduler;
+
         /**
-         * The current execution status of the job.
+         * Called on a scheduler thread when a timer set by _scheduleAt() for 'deadline' fires.
+         * Timers from an older generation than the job's current one are ignored.
          */
-        ExecutionStatus _execStatus{ExecutionStatus::NOT_SCHEDULED};
+        void _runOnce(uint64_t generation, Date_t deadline);
+
+        void _scheduleAt(WithLock, Date_t deadline);
+
+        std::shared_ptr<Scheduler> _scheduler;
+
+        // The job's Client. It is handed to the scheduler thread for the duration of each run,
+        // and '_client' is empty in the meantime.
+        ServiceContext::UniqueClient _client;
+        Client* _clientPtr = nullptr;
+
+        // Bumped whenever the outstanding timer should no longer run the job.
+        uint64_t _generation = 0;
+
+        bool _isRunning = false;
+        stdx::condition_variable _runFinishedCond;
+
+        // Set when the timer fired while the job was paused, so that resume() runs it right away.
+        bool _missedWhilePaused = false;
+
+        boost::optional<Date_t> _lastStart;
+        Milliseconds _lastJitter{0};
     };
 
-    std::shared_ptr<PeriodicRunnerImpl::PeriodicJobImpl> createAndAddJob(PeriodicJob job);
+    /**
+     * Drives ScheduledJobImpls from a timer wheel on a fixed set of threads.
+     */
+    class Scheduler {
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+    public:
+        Scheduler(ClockSource* clockSource, size_t numThreads);
+
+        void startup();
+
+        /**
+         * Joins the scheduler threads. Jobs scheduled afterwards never run.
+         */
+        void shutdown();
+
+        void schedule(std::weak_ptr<ScheduledJobImpl> job, uint64_t generation, Date_t deadline);
+
+    private:
+        struct Timer {
+            std::weak_ptr<ScheduledJobImpl> job;
+            uint64_t generation;
+            Date_t deadline;
+        };
+
+        void _workerLoop(size_t id);
+
+        ClockSource* const _clockSource;
+        const size_t _numThreads;
+
+        Mutex _mutex = MONGO_MAKE_LATCH("PeriodicRunnerImpl::Scheduler::_mutex");
+        stdx::condition_variable _cond;
+        TimerWheel<Timer> _wheel;
+        std::deque<Timer> _ready;
+        std::vector<stdx::thread> _threads;
+        bool _inShutdown = false;
+    };
 
     ServiceContext* _svc;
     ClockSource* _clockSource;
+    std::shared_ptr<Scheduler> _scheduler;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("PeriodicRunnerImpl::_mutex");
+    std::vector<std::weak_ptr<JobImplBase>> _jobs;
 };
 
 }  // namespace mongo
@@ -29,7 +29,10 @@
 
 #include <boost/optional.hpp>
 
+#include <algorithm>
+
 #include "mongo/base/error_codes.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/basic.h"
 
@@ -53,7 +56,8 @@ class PeriodicRunnerImplTestNoSetup : public ServiceContextTest {
 public:
     void setUp() override {
         _clockSource = std::make_unique<ClockSourceMock>();
-        _runner = std::make_unique<PeriodicRunnerImpl>(getServiceContext(), _clockSource.get());
+        _runner = std::make_unique<PeriodicRunnerImpl>(
+            getServiceContext(), _clockSource.get(), _schedulerThreads);
     }
 
     ClockSourceMock& clockSource() {
@@ -64,6 +68,9 @@ public:
         return *_runner;
     }
 
+protected:
+    size_t _schedulerThreads = 0;
+
 private:
     std::unique_ptr<ClockSourceMock> _clockSource;
     std::unique_ptr<PeriodicRunner> _runner;
@@ -84,6 +91,61 @@ public:
     }
 };
 
+/**
+ * Runs jobs on a shared timer wheel and a couple of scheduler threads.
+ */
+class PeriodicRunnerImplSchedulerTest : public PeriodicRunnerImplTest {
+public:
+    PeriodicRunnerImplSchedulerTest() {
+        _schedulerThreads = 2;
+    }
+};
+
+/**
+ * Runs a job which advances the clock by 'runTime' each time, makes its second run 'lateBy' late,
+ * and returns the resulting stats once that run has been recorded.
+ */
+BSONObj runJobAndGetStats(PeriodicRunner& runner,
+                          ClockSourceMock& clockSource,
+                          Milliseconds runTime,
+                          Milliseconds lateBy) {
+    int count = 0;
+    Milliseconds interval{5};
+
+    auto mutex = MONGO_MAKE_LATCH();
+    stdx::condition_variable cv;
+
+    PeriodicRunner::PeriodicJob job("statsJob",
+                                    [&](Client*) {
+                                        clockSource.advance(runTime);
+                                        {
+                                            stdx::unique_lock<Latch> lk(mutex);
+                                            count++;
+                                        }
+                                        cv.notify_all();
+                                    },
+                                    interval);
+
+    auto jobAnchor = runner.makeJob(std::move(job));
+    jobAnchor.start();
+
+    for (int i = 0; i < 3; i++) {
+        {
+            stdx::unique_lock<Latch> lk(mutex);
+            cv.wait(lk, [&] { return count > i; });
+        }
+        if (i < 2) {
+            clockSource.advance(i == 0 ? interval + lateBy : interval);
+        }
+    }
+
+    // The first two runs are recorded before the third one starts.
+    BSONObjBuilder bob;
+    runner.appendStats(&bob);
+    jobAnchor.stop();
+    return bob.obj().getObjectField("statsJob").getOwned();
+}
+
 TEST_F(PeriodicRunnerImplTest, OneJobTest) {
     int count = 0;
     Milliseconds interval{5};
@@ -504,5 +566,223 @@ TEST_F(PeriodicRunnerImplTest, ThrowsErrorOnceStopped) {
     jobAnchor.stop();
 }
 
+TEST_F(PeriodicRunnerImplTest, RecordsRunTimeAndLateness) {
+    auto stats = runJobAndGetStats(runner(), clockSource(), Milliseconds(3), Milliseconds(20));
+    ASSERT_GTE(stats["runs"].numberLong(), 2);
+    ASSERT_GTE(stats["totalRunMillis"].numberLong(), 6);
+    ASSERT_GTE(stats["maxRunMillis"].numberLong(), 3);
+    ASSERT_GTE(stats["maxLatenessMillis"].numberLong(), 18);
+    ASSERT_EQ(stats["periodMillis"].numberLong(), 5);
+}
+
+TEST_F(PeriodicRunnerImplTest, JitterDelaysNextRun) {
+    int count = 0;
+    Milliseconds interval{5};
+    Milliseconds jitter{20};
+
+    auto mutex = MONGO_MAKE_LATCH();
+    stdx::condition_variable cv;
+
+    PeriodicRunner::PeriodicJob job("job",
+                                    [&count, &mutex, &cv](Client*) {
+                                        {
+                                            stdx::unique_lock<Latch> lk(mutex);
+                                            count++;
+                                        }
+                                        cv.notify_all();
+                                    },
+                                    interval,
+                                    jitter);
+
+    auto jobAnchor = runner().makeJob(std::move(job));
+    jobAnchor.start();
+
+    // Each run is due somewhere between one interval and one interval plus the jitter later.
+    for (int i = 0; i < 10; i++) {
+        {
+            stdx::unique_lock<Latch> lk(mutex);
+            cv.wait(lk, [&] { return count > i; });
+        }
+        clockSource().advance(interval - Milliseconds(1));
+        {
+            stdx::unique_lock<Latch> lk(mutex);
+            ASSERT_EQ(count, i + 1);
+        }
+        clockSource().advance(jitter + Milliseconds(1));
+    }
+
+    tearDown();
+}
+
+TEST_F(PeriodicRunnerImplSchedulerTest, OneJobTest) {
+    int count = 0;
+    Milliseconds interval{5};
+
+    auto mutex = MONGO_MAKE_LATCH();
+    stdx::condition_variable cv;
+
+    PeriodicRunner::PeriodicJob job("job",
+                                    [&count, &mutex, &cv](Client*) {
+                                        {
+                                            stdx::unique_lock<Latch> lk(mutex);
+                                            count++;
+                                        }
+                                        cv.notify_all();
+                                    },
+                                    interval);
+
+    auto jobAnchor = runner().makeJob(std::move(job));
+    jobAnchor.start();
+
+    // Fast forward ten times, we should run all ten times.
+    for (int i = 0; i < 10; i++) {
+        clockSource().advance(interval);
+        {
+            stdx::unique_lock<Latch> lk(mutex);
+            cv.wait(lk, [&count, &i] { return count > i; });
+        }
+    }
+
+    tearDown();
+}
+
+TEST_F(PeriodicRunnerImplSchedulerTest, ManyJobsShareTheSchedulerThreads) {
+    const int numJobs = 10;
+    std::vector<int> counts(numJobs, 0);
+    Milliseconds interval{5};
+
+    auto mutex = MONGO_MAKE_LATCH();
+    stdx::condition_variable cv;
+
+    std::vector<PeriodicJobAnchor> jobAnchors;
+    for (int j = 0; j < numJobs; j++) {
+        PeriodicRunner::PeriodicJob job("job" + std::to_string(j),
+                                        [&counts, &mutex, &cv, j](Client*) {
+                                            {
+                                                stdx::unique_lock<Latch> lk(mutex);
+                                                counts[j]++;
+                                            }
+                                            cv.notify_all();
+                                        },
+                                        interval * (j % 3 + 1));
+        jobAnchors.push_back(runner().makeJob(std::move(job)));
+        jobAnchors.back().start();
+    }
+
+    for (int i = 0; i < 10; i++) {
+        clockSource().advance(interval * 3);
+        stdx::unique_lock<Latch> lk(mutex);
+        cv.wait(lk, [&] {
+            return std::all_of(counts.begin(), counts.end(), [&](int c) { return c > i; });
+        });
+    }
+
+    for (auto& jobAnchor : jobAnchors) {
+        jobAnchor.stop();
+    }
+
+    tearDown();
+}
+
+TEST_F(PeriodicRunnerImplSchedulerTest, PausedJobResumesCorrectly) {
+    int count = 0;
+    Milliseconds interval{5};
+
+    auto mutex = MONGO_MAKE_LATCH();
+    stdx::condition_variable cv;
+
+    PeriodicRunner::PeriodicJob job("job",
+                                    [&count, &mutex, &cv](Client*) {
+                                        {
+                                            stdx::unique_lock<Latch> lk(mutex);
+                                            count++;
+                                        }
+                                        cv.notify_all();
+                                    },
+                                    interval);
+
+    auto jobAnchor = runner().makeJob(std::move(job));
+    jobAnchor.start();
+    {
+        stdx::unique_lock<Latch> lk(mutex);
+        cv.wait(lk, [&] { return count == 1; });
+    }
+
+    jobAnchor.pause();
+
+    // Fast forward ten times, we shouldn't run anymore.
+    for (int i = 0; i < 10; i++) {
+        clockSource().advance(interval);
+    }
+    ASSERT_EQ(count, 1);
+
+    // The run missed while paused happens as soon as the job resumes.
+    jobAnchor.resume();
+    {
+        stdx::unique_lock<Latch> lk(mutex);
+        cv.wait(lk, [&] { return count > 1; });
+    }
+
+    tearDown();
+}
+
+TEST_F(PeriodicRunnerImplSchedulerTest, StopProperlyInterruptsOpCtx) {
+    Milliseconds interval{5};
+    unittest::Barrier barrier(2);
+    AtomicWord<bool> killed{false};
+
+    PeriodicRunner::PeriodicJob job(
+        "job",
+        [&barrier, &killed](Client* client) {
+            stdx::condition_variable cv;
+            auto mutex = MONGO_MAKE_LATCH();
+            barrier.countDownAndWait();
+
+            try {
+                auto opCtx = client->makeOperationContext();
+                stdx::unique_lock<Latch> lk(mutex);
+                opCtx->waitForConditionOrInterrupt(cv, lk, [] { return false; });
+            } catch (const ExceptionForCat<ErrorCategory::Interruption>& e) {
+                ASSERT_EQ(e.code(), ErrorCodes::ClientMarkedKilled);
+                killed.store(true);
+                return;
+            }
+
+            MONGO_UNREACHABLE;
+        },
+        interval);
+
+    auto jobAnchor = runner().makeJob(std::move(job));
+    jobAnchor.start();
+
+    barrier.countDownAndWait();
+
+    jobAnchor.stop();
+    ASSERT(killed.load());
+
+    tearDown();
+}
+
+TEST_F(PeriodicRunnerImplSchedulerTest, RecordsRunTimeAndLateness) {
+    auto stats = runJobAndGetStats(runner(), clockSource(), Milliseconds(3), Milliseconds(20));
+    ASSERT_GTE(stats["runs"].numberLong(), 2);
+    ASSERT_GTE(stats["totalRunMillis"].numberLong(), 6);
+    ASSERT_GTE(stats["maxRunMillis"].numberLong(), 3);
+    ASSERT_GTE(stats["maxLatenessMillis"].numberLong(), 18);
+}
+
+TEST_F(PeriodicRunnerImplSchedulerTest, ThrowsErrorOnceStopped) {
+    auto jobAnchor = makeStoppedJob();
+    ASSERT_THROWS_CODE_AND_WHAT(jobAnchor.start(),
+                                AssertionException,
+                                ErrorCodes::PeriodicJobIsStopped,
+                                "Attempted to start an already stopped job");
+    ASSERT_THROWS_CODE_AND_WHAT(jobAnchor.pause(),
+                                AssertionException,
+                                ErrorCodes::PeriodicJobIsStopped,
+                                "Attempted to pause an already stopped job");
+    jobAnchor.stop();
+}
+
 }  // namespace
 }  // namespace mongo
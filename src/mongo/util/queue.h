@@ -152,7 +152,7 @@ public:
         t = _queue.front();
         _queue.pop();
         _currentSize -= _getSize(t);
-        _cvNoLongerFull.notify_one();
+        _notifyIfSpaceAvailable_inlock();
 
         return true;
     }
@@ -169,7 +169,7 @@ public:
         T t = _queue.front();
         _queue.pop();
         _currentSize -= _getSize(t);
-        _cvNoLongerFull.notify_one();
+        _notifyIfSpaceAvailable_inlock();
 
         return t;
     }
@@ -196,7 +196,7 @@ public:
         t = _queue.front();
         _queue.pop();
         _currentSize -= _getSize(t);
-        _cvNoLongerFull.notify_one();
+        _notifyIfSpaceAvailable_inlock();
         return true;
     }
 
@@ -248,14 +248,29 @@ private:
      */
     void _waitForSpace_inlock(size_t size, stdx::unique_lock<Latch>& lk) {
         while (_currentSize + size > _maxSize) {
+            _spaceNeeded = size;
             _cvNoLongerFull.wait(lk);
         }
+        _spaceNeeded = 0;
+    }
+
+    /**
+     * Wakes the producer blocked in _waitForSpace_inlock(), if any, once the space it waits for is
+     * available. Waking it on every pop would have it re-check and go back to sleep once per item
+     * consumed from a full queue.
+     */
+    void _notifyIfSpaceAvailable_inlock() {
+        if (_spaceNeeded && _currentSize + _spaceNeeded <= _maxSize) {
+            _cvNoLongerFull.notify_one();
+        }
     }
 
     mutable Mutex _lock = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "BlockingQueue::_lock");
     std::queue<T> _queue;
     const size_t _maxSize;
     size_t _currentSize = 0;
+    // The space a producer blocked in _waitForSpace_inlock() is waiting for, or 0 if there is none.
+    size_t _spaceNeeded = 0;
     GetSizeFn _getSize;
     bool _clearing = false;
 
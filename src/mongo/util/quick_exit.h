@@ -27,6 +27,7 @@
  *    it in the license file.
  */
 
+#include "mongo/logv2/log_util.h"
 #include "mongo/platform/compiler.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/testing_proctor.h"
@@ -53,6 +54,7 @@ MONGO_COMPILER_NORETURN inline void quickExit(int code) {
     if (code == EXIT_CLEAN) {
         TestingProctor::instance().exitAbruptlyIfDeferredErrors(false);
     }
+    logv2::flushLogs();
     quickExitWithoutLogging(code);
 }
 
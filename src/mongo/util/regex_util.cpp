@@ -30,6 +30,10 @@
 
 #include "mongo/util/regex_util.h"
 
+#include <boost/optional.hpp>
+#include <cctype>
+#include <cstring>
+
 #include "mongo/base/error_codes.h"
 #include "mongo/util/str.h"
 
@@ -64,5 +68,96 @@ pcrecpp::RE_Options flagsToPcreOptions(StringData optionFlags, StringData opName
     }
     return opt;
 }
+
+std::string getRequiredLiteral(StringData regex, StringData optionFlags) {
+    if (optionFlags.find('i') != std::string::npos || optionFlags.find('x') != std::string::npos) {
+        return {};
+    }
+
+    std::string longest;
+    std::string current;
+    auto endRun = [&] {
+        if (current.size() > longest.size()) {
+            longest = current;
+        }
+        current.clear();
+    };
+
+    int depth = 0;
+    size_t i = 0;
+    while (i < regex.size()) {
+        const char c = regex[i];
+        boost::optional<char> literal;
+        size_t next = i + 1;
+
+        if (c == '\\') {
+            if (next == regex.size()) {
+                return {};
+            }
+            // An escaped punctuation character is that character. Escaped alphanumeric characters
+            // are classes, assertions, back references or multi-character escapes.
+            auto escaped = static_cast<unsigned char>(regex[next]);
+            if (std::isalnum(escaped) || escaped >= 0x80) {
+                return {};
+            }
+            literal = regex[next];
+            next++;
+        } else if (c == '[') {
+            if (next < regex.size() && regex[next] == '^') {
+                next++;
+            }
+            // A ']' right after the opening bracket is a member of the class.
+            if (next < regex.size() && regex[next] == ']') {
+                next++;
+            }
+            while (next < regex.size() && regex[next] != ']') {
+                if (regex[next] == '\\') {
+                    next++;
+                } else if (regex[next] == '[' && next + 1 < regex.size() &&
+                           std::strchr(":.=", regex[next + 1])) {
+                    // POSIX classes contain their own closing bracket.
+                    return {};
+                }
+                next++;
+            }
+            if (next >= regex.size()) {
+                return {};
+            }
+            next++;
+        } else if (c == '(') {
+            // Inline options, lookarounds and verbs can change how the rest of the pattern
+            // matches.
+            if (next < regex.size() && (regex[next] == '?' || regex[next] == '*')) {
+                return {};
+            }
+            depth++;
+        } else if (c == ')') {
+            if (--depth < 0) {
+                return {};
+            }
+        } else if (c == '|') {
+            if (depth == 0) {
+                return {};
+            }
+        } else if (static_cast<unsigned char>(c) < 0x80 && !std::strchr("^$.?*+{}", c)) {
+            literal = c;
+        }
+
+        if (!literal || depth > 0) {
+            endRun();
+        } else if (next < regex.size() && std::strchr("?*{", regex[next])) {
+            // The character may be repeated zero times.
+            endRun();
+        } else {
+            current.push_back(*literal);
+            if (next < regex.size() && regex[next] == '+') {
+                endRun();
+            }
+        }
+        i = next;
+    }
+    endRun();
+    return longest;
+}
 }  // namespace regex_util
 }  // namespace mongo
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <pcrecpp.h>
+#include <string>
 
 #include "mongo/base/string_data.h"
 
@@ -40,5 +41,17 @@ namespace regex_util {
  * throws uassert on invalid flags.
  */
 pcrecpp::RE_Options flagsToPcreOptions(StringData optionFlags, StringData opName = "");
+
+/**
+ * Returns a literal string which every match of 'regex' under the options 'optionFlags' contains,
+ * or an empty string if none is found. Strings which do not contain the literal cannot match, so
+ * searching for it is a cheap way to reject most non-matching inputs before running the regex.
+ *
+ * The literal is the longest run of plain or escaped punctuation characters which are neither
+ * optional nor inside a group. Patterns with top-level alternation, with inline options or with
+ * escapes other than escaped punctuation, and patterns matched case-insensitively or in extended
+ * mode, have no required literal.
+ */
+std::string getRequiredLiteral(StringData regex, StringData optionFlags);
 }  // namespace regex_util
 }  // namespace mongo
@@ -31,12 +31,30 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <iterator>
 
 namespace mongo::str {
 namespace {
 constexpr char kHexChar[] = "0123456789abcdef";
 
+// Returns true if none of the eight bytes starting at 'ptr' can need escaping, that is, they are all
+// printable ASCII other than the double quote and backslash. This lets escape() skip over long runs
+// of plain text a word at a time instead of dispatching on every byte.
+bool isPlainAsciiWord(const char* ptr) {
+    constexpr uint64_t kOnes = 0x0101010101010101ULL;
+    constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+    auto hasZeroByte = [](uint64_t word) {
+        return (word - kOnes) & ~word & kHighBits;
+    };
+
+    uint64_t word;
+    std::memcpy(&word, ptr, sizeof(word));
+    return !((word & kHighBits) | ((word - kOnes * 0x20) & ~word & kHighBits) |
+             hasZeroByte(word ^ (kOnes * 0x7f)) | hasZeroByte(word ^ (kOnes * '"')) |
+             hasZeroByte(word ^ (kOnes * '\\')));
+}
+
 // 'singleHandler' Function to write a valid single byte UTF-8 sequence with desired escaping.
 // 'invalidByteHandler' Function to write a byte of invalid UTF-8 encoding
 // 'twoEscaper' Function to write a valid two byte UTF-8 sequence with desired escaping, for C1
@@ -99,6 +117,11 @@ void escape(fmt::memory_buffer& buffer,
 
 
     while (it != end) {
+        if (end - it >= static_cast<ptrdiff_t>(sizeof(uint64_t)) && isPlainAsciiWord(it)) {
+            it += sizeof(uint64_t);
+            continue;
+        }
+
         uint8_t c = *it;
         bool bit7 = (c >> 7) & 1;
         if (MONGO_likely(!bit7)) {
@@ -0,0 +1,374 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+/**
+ * Maps whose copies share their storage. A map is split into blocks held by shared_ptr; copying
+ * the map copies only the block pointers, and a modification copies the single block it touches
+ * if that block is still shared with another copy. This makes copy-then-modify cost proportional
+ * to the block size rather than the size of the map, while lookups stay as cheap as in a plain
+ * map.
+ *
+ * Like the standard containers, a map must not be modified concurrently with any other access to
+ * that same map, including copying it. Distinct copies may be read and modified independently.
+ */
+
+/**
+ * An unordered map split into a fixed number of shards by key hash.
+ */
+template <typename Key, typename Value, typename Hasher = stdx::DefaultHasher<Key>>
+class StructurallySharedHashMap {
+    using Shard = stdx::unordered_map<Key, Value, Hasher>;
+
+    static constexpr int kNumShardsLog2 = 8;
+    static constexpr size_t kNumShards = size_t{1} << kNumShardsLog2;
+
+public:
+    /**
+     * Returns a pointer to the value for 'key', or nullptr if there is none.
+     */
+    const Value* find(const Key& key) const {
+        const auto& shard = _shards[_shardIndex(key)];
+        if (!shard) {
+            return nullptr;
+        }
+        auto it = shard->find(key);
+        return it == shard->end() ? nullptr : &it->second;
+    }
+
+    bool contains(const Key& key) const {
+        return find(key) != nullptr;
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    void insert_or_assign(const Key& key, Value value) {
+        if (_mutableShard(_shardIndex(key)).insert_or_assign(key, std::move(value)).second) {
+            ++_size;
+        }
+    }
+
+    /**
+     * Removes 'key' and returns the number of entries removed.
+     */
+    size_t erase(const Key& key) {
+        auto index = _shardIndex(key);
+        if (!_shards[index] || !_shards[index]->contains(key)) {
+            return 0;
+        }
+
+        auto& shard = _mutableShard(index);
+        shard.erase(key);
+        if (shard.empty()) {
+            _shards[index].reset();
+        }
+        --_size;
+        return 1;
+    }
+
+    void clear() {
+        for (auto& shard : _shards) {
+            shard.reset();
+        }
+        _size = 0;
+    }
+
+    /**
+     * Invokes 'callback(key, value)' for every entry, in unspecified order.
+     */
+    template <typename Callback>
+    void forEach(Callback&& callback) const {
+        for (const auto& shard : _shards) {
+            if (!shard) {
+                continue;
+            }
+            for (const auto& [key, value] : *shard) {
+                callback(key, value);
+            }
+        }
+    }
+
+private:
+    static size_t _shardIndex(const Key& key) {
+        // Fibonacci hashing picks the shard from the high bits of the product, so it stays
+        // independent of the bits the shard's own hash table uses.
+        return (static_cast<uint64_t>(Hasher{}(key)) * 0x9E3779B97F4A7C15ULL) >>
+            (64 - kNumShardsLog2);
+    }
+
+    Shard& _mutableShard(size_t index) {
+        auto& shard = _shards[index];
+        if (!shard) {
+            shard = std::make_shared<Shard>();
+        } else if (shard.use_count() > 1) {
+            shard = std::make_shared<Shard>(*shard);
+        }
+        return *shard;
+    }
+
+    std::array<std::shared_ptr<Shard>, kNumShards> _shards;
+    size_t _size = 0;
+};
+
+/**
+ * An ordered map stored as a sorted sequence of sorted chunks of bounded size, in effect a
+ * two-level B-tree.
+ *
+ * Iterators hold a reference to the chunk they point into, so they remain valid and keep
+ * returning the entries of that chunk even if the map is modified. On leaving a chunk, an
+ * iterator continues from the first key greater than the last key of that chunk in the map's
+ * current contents.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class StructurallySharedOrderedMap {
+public:
+    using value_type = std::pair<Key, Value>;
+
+private:
+    using Chunk = std::vector<value_type>;
+
+    static constexpr size_t kMaxChunkSize = 128;
+
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = StructurallySharedOrderedMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator() = default;
+
+        reference operator*() const {
+            return (*_chunk)[_pos];
+        }
+
+        pointer operator->() const {
+            return &(*_chunk)[_pos];
+        }
+
+        const_iterator& operator++() {
+            if (++_pos == _chunk->size()) {
+                *this = _map->upper_bound(_chunk->back().first);
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return _chunk == other._chunk && _pos == other._pos;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        friend class StructurallySharedOrderedMap;
+
+        const_iterator(const StructurallySharedOrderedMap* map,
+                       std::shared_ptr<const Chunk> chunk,
+                       size_t pos)
+            : _map(map), _chunk(std::move(chunk)), _pos(pos) {}
+
+        const StructurallySharedOrderedMap* _map = nullptr;
+
+        // Null for the end iterator.
+        std::shared_ptr<const Chunk> _chunk;
+        size_t _pos = 0;
+    };
+
+    const_iterator begin() const {
+        return _chunks.empty() ? end() : const_iterator(this, _chunks.front(), 0);
+    }
+
+    const_iterator end() const {
+        return const_iterator();
+    }
+
+    const_iterator lower_bound(const Key& key) const {
+        auto index = _chunkIndex(key, false);
+        if (index == _chunks.size()) {
+            return end();
+        }
+        const auto& chunk = _chunks[index];
+        auto pos = std::lower_bound(chunk->begin(), chunk->end(), key, _entryLess);
+        return const_iterator(this, chunk, pos - chunk->begin());
+    }
+
+    const_iterator upper_bound(const Key& key) const {
+        auto index = _chunkIndex(key, true);
+        if (index == _chunks.size()) {
+            return end();
+        }
+        const auto& chunk = _chunks[index];
+        auto pos = std::upper_bound(chunk->begin(), chunk->end(), key, _keyLess);
+        return const_iterator(this, chunk, pos - chunk->begin());
+    }
+
+    const_iterator find(const Key& key) const {
+        auto it = lower_bound(key);
+        if (it != end() && !Compare{}(key, it->first)) {
+            return it;
+        }
+        return end();
+    }
+
+    bool contains(const Key& key) const {
+        return find(key) != end();
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    void insert_or_assign(const Key& key, Value value) {
+        if (_chunks.empty()) {
+            _chunks.push_back(std::make_shared<Chunk>());
+            _chunks.back()->emplace_back(key, std::move(value));
+            ++_size;
+            return;
+        }
+
+        // Keys greater than every existing key go into the last chunk.
+        auto index = std::min(_chunkIndex(key, false), _chunks.size() - 1);
+        auto& chunk = _mutableChunk(index);
+        auto pos = std::lower_bound(chunk.begin(), chunk.end(), key, _entryLess);
+        if (pos != chunk.end() && !Compare{}(key, pos->first)) {
+            pos->second = std::move(value);
+            return;
+        }
+
+        chunk.emplace(pos, key, std::move(value));
+        ++_size;
+
+        if (chunk.size() > kMaxChunkSize) {
+            auto middle = chunk.begin() + chunk.size() / 2;
+            auto upperHalf = std::make_shared<Chunk>(std::make_move_iterator(middle),
+                                                     std::make_move_iterator(chunk.end()));
+            chunk.erase(middle, chunk.end());
+            _chunks.insert(_chunks.begin() + index + 1, std::move(upperHalf));
+        }
+    }
+
+    /**
+     * Removes 'key' and returns the number of entries removed.
+     */
+    size_t erase(const Key& key) {
+        auto index = _chunkIndex(key, false);
+        if (index == _chunks.size()) {
+            return 0;
+        }
+
+        const auto& shared = *_chunks[index];
+        auto found = std::lower_bound(shared.begin(), shared.end(), key, _entryLess);
+        if (found == shared.end() || Compare{}(key, found->first)) {
+            return 0;
+        }
+        auto offset = found - shared.begin();
+
+        auto& chunk = _mutableChunk(index);
+        chunk.erase(chunk.begin() + offset);
+        if (chunk.empty()) {
+            _chunks.erase(_chunks.begin() + index);
+        }
+        --_size;
+        return 1;
+    }
+
+    void clear() {
+        _chunks.clear();
+        _size = 0;
+    }
+
+private:
+    static bool _entryLess(const value_type& entry, const Key& key) {
+        return Compare{}(entry.first, key);
+    }
+
+    static bool _keyLess(const Key& key, const value_type& entry) {
+        return Compare{}(key, entry.first);
+    }
+
+    /**
+     * Returns the index of the first chunk whose last key is not less than 'key', or greater than
+     * 'key' if 'upper' is set. Returns the number of chunks if there is none.
+     */
+    size_t _chunkIndex(const Key& key, bool upper) const {
+        auto it = std::partition_point(_chunks.begin(), _chunks.end(), [&](const auto& chunk) {
+            const auto& last = chunk->back().first;
+            return upper ? !Compare{}(key, last) : Compare{}(last, key);
+        });
+        return it - _chunks.begin();
+    }
+
+    Chunk& _mutableChunk(size_t index) {
+        auto& chunk = _chunks[index];
+        if (chunk.use_count() > 1) {
+            chunk = std::make_shared<Chunk>(*chunk);
+        }
+        return *chunk;
+    }
+
+    // Non-empty chunks, each sorted, with every key of a chunk less than every key of the next.
+    std::vector<std::shared_ptr<Chunk>> _chunks;
+    size_t _size = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,166 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <map>
+
+#include "mongo/platform/random.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/structurally_shared_map.h"
+
+namespace mongo {
+namespace {
+
+template <typename Map>
+std::map<int, int> toStdMap(const Map& map) {
+    return std::map<int, int>(map.begin(), map.end());
+}
+
+std::map<int, int> toStdMap(const StructurallySharedHashMap<int, int>& map) {
+    std::map<int, int> result;
+    map.forEach([&](int key, int value) { result.emplace(key, value); });
+    return result;
+}
+
+TEST(StructurallySharedHashMapTest, InsertFindErase) {
+    StructurallySharedHashMap<int, int> map;
+    ASSERT(map.empty());
+    ASSERT(!map.find(1));
+
+    map.insert_or_assign(1, 10);
+    map.insert_or_assign(2, 20);
+    map.insert_or_assign(1, 11);
+    ASSERT_EQ(map.size(), 2U);
+    ASSERT_EQ(*map.find(1), 11);
+    ASSERT(map.contains(2));
+
+    ASSERT_EQ(map.erase(1), 1U);
+    ASSERT_EQ(map.erase(1), 0U);
+    ASSERT_EQ(map.size(), 1U);
+    ASSERT(!map.find(1));
+
+    map.clear();
+    ASSERT(map.empty());
+    ASSERT(!map.contains(2));
+}
+
+TEST(StructurallySharedHashMapTest, CopiesAreIndependent) {
+    StructurallySharedHashMap<int, int> original;
+    for (int i = 0; i < 1000; ++i) {
+        original.insert_or_assign(i, i);
+    }
+
+    auto copy = original;
+    copy.insert_or_assign(5, -5);
+    copy.erase(6);
+    copy.insert_or_assign(1000, 1000);
+
+    ASSERT_EQ(*original.find(5), 5);
+    ASSERT(original.contains(6));
+    ASSERT(!original.contains(1000));
+    ASSERT_EQ(original.size(), 1000U);
+
+    ASSERT_EQ(*copy.find(5), -5);
+    ASSERT(!copy.contains(6));
+    ASSERT_EQ(copy.size(), 1000U);
+}
+
+TEST(StructurallySharedOrderedMapTest, MatchesStdMap) {
+    PseudoRandom random(1);
+    StructurallySharedOrderedMap<int, int> map;
+    std::map<int, int> expected;
+    std::vector<std::pair<StructurallySharedOrderedMap<int, int>, std::map<int, int>>> snapshots;
+
+    for (int i = 0; i < 20000; ++i) {
+        int key = random.nextInt32(2000);
+        if (random.nextInt32(3) < 2) {
+            map.insert_or_assign(key, i);
+            expected[key] = i;
+        } else {
+            ASSERT_EQ(map.erase(key), expected.erase(key));
+        }
+
+        if (i % 1000 == 0) {
+            snapshots.emplace_back(map, expected);
+        }
+    }
+
+    ASSERT_EQ(map.size(), expected.size());
+    ASSERT(toStdMap(map) == expected);
+
+    for (int key = -1; key <= 2001; ++key) {
+        auto lower = map.lower_bound(key);
+        auto expectedLower = expected.lower_bound(key);
+        ASSERT_EQ(lower == map.end(), expectedLower == expected.end());
+        if (expectedLower != expected.end()) {
+            ASSERT_EQ(lower->first, expectedLower->first);
+        }
+
+        auto upper = map.upper_bound(key);
+        auto expectedUpper = expected.upper_bound(key);
+        ASSERT_EQ(upper == map.end(), expectedUpper == expected.end());
+        if (expectedUpper != expected.end()) {
+            ASSERT_EQ(upper->first, expectedUpper->first);
+        }
+
+        ASSERT_EQ(map.contains(key), expected.count(key) > 0);
+    }
+
+    // Modifying the map after taking a copy must not have changed the copy.
+    for (const auto& [snapshot, snapshotExpected] : snapshots) {
+        ASSERT(toStdMap(snapshot) == snapshotExpected);
+    }
+}
+
+TEST(StructurallySharedOrderedMapTest, IteratorSurvivesModification) {
+    StructurallySharedOrderedMap<int, int> map;
+    for (int i = 0; i < 1000; ++i) {
+        map.insert_or_assign(i, i);
+    }
+
+    auto it = map.lower_bound(500);
+    map.erase(500);
+    map.erase(501);
+    map.insert_or_assign(499, -1);
+
+    // The iterator still sees the entry it pointed to and continues within its chunk from the
+    // contents at the time it was created.
+    ASSERT_EQ(it->first, 500);
+
+    int last = it->first;
+    for (++it; it != map.end(); ++it) {
+        ASSERT_GT(it->first, last);
+        last = it->first;
+    }
+    ASSERT_EQ(last, 999);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,196 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <boost/optional.hpp>
+#include <iterator>
+#include <vector>
+
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+/**
+ * A hierarchical timer wheel with millisecond resolution.
+ *
+ * The wheel has four levels of 64 slots each. A slot on level N spans 64^N milliseconds, so the
+ * levels together cover a little over four and a half hours ahead of the current time. Timers
+ * further out than that are parked on an overflow list until the wheel gets close enough to them.
+ * A timer lives on the lowest level that can hold it, and moves down a level each time the wheel
+ * reaches its slot, so inserting is constant time and advancing costs at most one pass over each
+ * level no matter how far the wheel moves.
+ *
+ * Timers cannot be removed. Callers that need cancellation should carry enough state in 'T' to
+ * recognize a stale timer when it expires.
+ *
+ * This class is not thread safe.
+ */
+template <typename T>
+class TimerWheel {
+public:
+    explicit TimerWheel(Date_t now) : _now(now.toMillisSinceEpoch()) {}
+
+    /**
+     * Adds a timer which expires at 'deadline'. A deadline at or before the current time of the
+     * wheel expires on the next call to advance().
+     */
+    void insert(Date_t deadline, T value) {
+        _place(Timer{deadline.toMillisSinceEpoch(), std::move(value)});
+        ++_size;
+    }
+
+    /**
+     * Moves the wheel forward to 'now' and appends every timer whose deadline is at or before 'now'
+     * to 'expired'. Expired timers are not appended in any particular order. Moving the wheel
+     * backwards only expires timers that were inserted with a deadline that had already passed.
+     */
+    void advance(Date_t now, std::vector<T>* expired) {
+        auto newNow = now.toMillisSinceEpoch();
+
+        std::vector<Timer> pulled = std::move(_due);
+        _due.clear();
+        if (newNow > _now) {
+            for (int level = 0; level < kLevels; ++level) {
+                auto from = _slotNumber(level, _now);
+                auto to = _slotNumber(level, newNow);
+                auto count = std::min<long long>(to - from, kSlotsPerLevel);
+                for (long long i = 1; i <= count; ++i) {
+                    auto& slot = _slots[level][(from + i) & kSlotMask];
+                    std::move(slot.begin(), slot.end(), std::back_inserter(pulled));
+                    slot.clear();
+                }
+                if (level == kLevels - 1 && count > 0) {
+                    std::move(_overflow.begin(), _overflow.end(), std::back_inserter(pulled));
+                    _overflow.clear();
+                }
+            }
+            _now = newNow;
+        }
+
+        for (auto& timer : pulled) {
+            if (timer.deadline <= _now) {
+                expired->push_back(std::move(timer.value));
+                --_size;
+            } else {
+                _place(std::move(timer));
+            }
+        }
+    }
+
+    /**
+     * Returns the earliest deadline of any timer in the wheel, or boost::none if it is empty.
+     */
+    boost::optional<Date_t> nextDeadline() const {
+        boost::optional<long long> earliest;
+        auto consider = [&](const std::vector<Timer>& timers) {
+            for (const auto& timer : timers) {
+                if (!earliest || timer.deadline < *earliest) {
+                    earliest = timer.deadline;
+                }
+            }
+        };
+
+        consider(_due);
+        for (int level = 0; level < kLevels; ++level) {
+            // Slots on a level hold disjoint, increasing ranges of deadlines starting just after
+            // the current slot, so only the first occupied one matters.
+            auto from = _slotNumber(level, _now);
+            for (long long i = 1; i <= kSlotsPerLevel; ++i) {
+                const auto& slot = _slots[level][(from + i) & kSlotMask];
+                if (!slot.empty()) {
+                    consider(slot);
+                    break;
+                }
+            }
+        }
+        if (!earliest) {
+            consider(_overflow);
+        }
+
+        if (!earliest) {
+            return boost::none;
+        }
+        return Date_t::fromMillisSinceEpoch(*earliest);
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+private:
+    static constexpr int kLevels = 4;
+    static constexpr int kSlotBits = 6;
+    static constexpr long long kSlotsPerLevel = 1 << kSlotBits;
+    static constexpr long long kSlotMask = kSlotsPerLevel - 1;
+
+    struct Timer {
+        long long deadline;
+        T value;
+    };
+
+    static long long _slotNumber(int level, long long millis) {
+        return millis >> (kSlotBits * level);
+    }
+
+    void _place(Timer timer) {
+        if (timer.deadline <= _now) {
+            _due.push_back(std::move(timer));
+            return;
+        }
+
+        for (int level = 0; level < kLevels; ++level) {
+            auto slotNumber = _slotNumber(level, timer.deadline);
+            if (slotNumber - _slotNumber(level, _now) < kSlotsPerLevel) {
+                _slots[level][slotNumber & kSlotMask].push_back(std::move(timer));
+                return;
+            }
+        }
+        _overflow.push_back(std::move(timer));
+    }
+
+    std::array<std::array<std::vector<Timer>, kSlotsPerLevel>, kLevels> _slots;
+
+    // Timers whose deadline had already passed when they were placed.
+    std::vector<Timer> _due;
+
+    // Timers too far in the future for the top level.
+    std::vector<Timer> _overflow;
+
+    long long _now;
+    size_t _size = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/timer_wheel.h"
+
+namespace mongo {
+namespace {
+
+const Date_t kStart = Date_t::fromMillisSinceEpoch(1000000);
+
+std::vector<int> advanceTo(TimerWheel<int>& wheel, Date_t now) {
+    std::vector<int> expired;
+    wheel.advance(now, &expired);
+    std::sort(expired.begin(), expired.end());
+    return expired;
+}
+
+TEST(TimerWheelTest, EmptyWheelHasNoDeadline) {
+    TimerWheel<int> wheel(kStart);
+    ASSERT(wheel.empty());
+    ASSERT_FALSE(wheel.nextDeadline());
+    ASSERT(advanceTo(wheel, kStart + Hours(10)).empty());
+}
+
+TEST(TimerWheelTest, ExpiresTimersAtTheirDeadline) {
+    TimerWheel<int> wheel(kStart);
+    wheel.insert(kStart + Milliseconds(5), 1);
+    wheel.insert(kStart + Milliseconds(10), 2);
+    ASSERT_EQ(wheel.size(), 2u);
+    ASSERT_EQ(*wheel.nextDeadline(), kStart + Milliseconds(5));
+
+    ASSERT(advanceTo(wheel, kStart + Milliseconds(4)).empty());
+    ASSERT_EQ(advanceTo(wheel, kStart + Milliseconds(5)), std::vector<int>{1});
+    ASSERT_EQ(*wheel.nextDeadline(), kStart + Milliseconds(10));
+    ASSERT_EQ(advanceTo(wheel, kStart + Milliseconds(20)), std::vector<int>{2});
+    ASSERT(wheel.empty());
+}
+
+TEST(TimerWheelTest, PastDeadlineExpiresOnNextAdvance) {
+    TimerWheel<int> wheel(kStart);
+    wheel.insert(kStart - Seconds(1), 1);
+    wheel.insert(kStart, 2);
+    ASSERT_EQ(*wheel.nextDeadline(), kStart - Seconds(1));
+    ASSERT_EQ(advanceTo(wheel, kStart), (std::vector<int>{1, 2}));
+}
+
+TEST(TimerWheelTest, CascadesTimersFromUpperLevels) {
+    TimerWheel<int> wheel(kStart);
+    wheel.insert(kStart + Milliseconds(100), 1);
+    wheel.insert(kStart + Seconds(30), 2);
+    wheel.insert(kStart + Minutes(20), 3);
+    wheel.insert(kStart + Hours(30), 4);
+
+    Date_t now = kStart;
+    std::vector<int> expired;
+    while (expired.size() < 4) {
+        auto next = wheel.nextDeadline();
+        ASSERT(next);
+        ASSERT_GT(*next, now);
+        // Step forward in small increments so that each level cascades on its own.
+        now = std::min(*next, now + Seconds(7));
+        auto batch = advanceTo(wheel, now);
+        expired.insert(expired.end(), batch.begin(), batch.end());
+        for (auto value : batch) {
+            ASSERT_EQ(value, static_cast<int>(expired.size()));
+        }
+    }
+    ASSERT(wheel.empty());
+}
+
+TEST(TimerWheelTest, LargeJumpExpiresEverything) {
+    TimerWheel<int> wheel(kStart);
+    for (int i = 0; i < 100; ++i) {
+        wheel.insert(kStart + Milliseconds(i * 997), i);
+    }
+    wheel.insert(kStart + Hours(48), 100);
+
+    auto expired = advanceTo(wheel, kStart + Hours(24));
+    ASSERT_EQ(expired.size(), 100u);
+    ASSERT_EQ(*wheel.nextDeadline(), kStart + Hours(48));
+    ASSERT_EQ(advanceTo(wheel, kStart + Hours(48)), std::vector<int>{100});
+}
+
+}  // namespace
+}  // namespace mongo